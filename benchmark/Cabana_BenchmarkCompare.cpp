@@ -0,0 +1,385 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+//---------------------------------------------------------------------------//
+// Compare fresh benchmark results against a stored baseline of the same
+// machine. Both files are JSON output of the benchmark targets (an output
+// file name ending in .json). Every timer data point present in both files
+// is compared with a one-sided Mann-Whitney U test over the run samples. A
+// data point regresses if the fresh samples are significantly slower and
+// the median time grew by more than the threshold. The exit code is the
+// number of regressions (capped at 255) so the comparison can gate an
+// upgrade in scripts or CI. If the baseline does not exist the fresh results
+// are stored as the new baseline.
+//---------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+//---------------------------------------------------------------------------//
+// A record of a JSON output file: the scalar fields as text and the run
+// samples of timer records.
+struct Record
+{
+    std::map<std::string, std::string> fields;
+    std::vector<double> samples;
+
+    std::string field( const std::string& key ) const
+    {
+        auto it = fields.find( key );
+        return ( it == fields.end() ) ? std::string() : it->second;
+    }
+};
+
+//---------------------------------------------------------------------------//
+// Parse one line of the JSON output. The benchmarks write flat objects of
+// strings and numbers and one array of numbers, which is all this parser
+// accepts.
+class RecordParser
+{
+  public:
+    RecordParser( const std::string& line )
+        : _line( line )
+        , _pos( 0 )
+    {
+    }
+
+    Record parse()
+    {
+        Record record;
+        expect( '{' );
+        if ( peek() == '}' )
+            return record;
+        while ( true )
+        {
+            std::string key = parseString();
+            expect( ':' );
+            if ( peek() == '"' )
+                record.fields[key] = parseString();
+            else if ( peek() == '[' )
+                record.samples = parseArray();
+            else
+                record.fields[key] = parseToken( '}' );
+            char c = next();
+            if ( '}' == c )
+                break;
+            if ( ',' != c )
+                error();
+        }
+        return record;
+    }
+
+  private:
+    void skipSpace()
+    {
+        while ( _pos < _line.size() &&
+                std::isspace( static_cast<unsigned char>( _line[_pos] ) ) )
+            ++_pos;
+    }
+
+    char peek()
+    {
+        skipSpace();
+        if ( _pos >= _line.size() )
+            error();
+        return _line[_pos];
+    }
+
+    char next()
+    {
+        char c = peek();
+        ++_pos;
+        return c;
+    }
+
+    void expect( const char c )
+    {
+        if ( next() != c )
+            error();
+    }
+
+    std::string parseString()
+    {
+        expect( '"' );
+        std::string value;
+        while ( _pos < _line.size() && _line[_pos] != '"' )
+        {
+            if ( '\\' == _line[_pos] )
+                ++_pos;
+            if ( _pos < _line.size() )
+                value += _line[_pos++];
+        }
+        expect( '"' );
+        return value;
+    }
+
+    // Parse a number up to the next separator or the given end character.
+    std::string parseToken( const char end )
+    {
+        skipSpace();
+        auto begin = _pos;
+        while ( _pos < _line.size() && _line[_pos] != ',' &&
+                _line[_pos] != end &&
+                !std::isspace( static_cast<unsigned char>( _line[_pos] ) ) )
+            ++_pos;
+        if ( begin == _pos )
+            error();
+        return _line.substr( begin, _pos - begin );
+    }
+
+    std::vector<double> parseArray()
+    {
+        std::vector<double> values;
+        expect( '[' );
+        if ( peek() == ']' )
+        {
+            ++_pos;
+            return values;
+        }
+        while ( true )
+        {
+            values.push_back( std::stod( parseToken( ']' ) ) );
+            char c = next();
+            if ( ']' == c )
+                break;
+            if ( ',' != c )
+                error();
+        }
+        return values;
+    }
+
+    void error() const
+    {
+        throw std::runtime_error( "Malformed benchmark record: " + _line );
+    }
+
+    const std::string& _line;
+    std::size_t _pos;
+};
+
+//---------------------------------------------------------------------------//
+// Results of a file: the metadata and the timer records by name, data point
+// and number of ranks.
+struct Results
+{
+    using key_type = std::tuple<std::string, std::string, std::string>;
+    std::vector<Record> metadata;
+    std::map<key_type, Record> timers;
+};
+
+Results readResults( const std::string& filename )
+{
+    std::ifstream file( filename );
+    if ( !file )
+        throw std::runtime_error( "Could not open " + filename );
+    Results results;
+    std::string line;
+    while ( std::getline( file, line ) )
+    {
+        if ( line.empty() )
+            continue;
+        if ( line[0] != '{' )
+            throw std::runtime_error(
+                filename + " is not JSON benchmark output; write the results "
+                           "to a file ending in .json" );
+        auto record = RecordParser( line ).parse();
+        if ( "metadata" == record.field( "type" ) )
+            results.metadata.push_back( record );
+        else if ( "timer" == record.field( "type" ) )
+            results.timers[std::make_tuple( record.field( "name" ),
+                                            record.field( "data_point" ),
+                                            record.field( "num_rank" ) )] =
+                record;
+    }
+    return results;
+}
+
+//---------------------------------------------------------------------------//
+// Median of samples.
+double median( std::vector<double> samples )
+{
+    std::sort( samples.begin(), samples.end() );
+    auto n = samples.size();
+    return ( n % 2 ) ? samples[n / 2]
+                     : 0.5 * ( samples[n / 2 - 1] + samples[n / 2] );
+}
+
+//---------------------------------------------------------------------------//
+// One-sided Mann-Whitney U test of whether the fresh samples are larger
+// (slower) than the baseline samples. Returns the p-value from the normal
+// approximation with tie correction.
+double mannWhitneyGreater( const std::vector<double>& baseline,
+                           const std::vector<double>& fresh )
+{
+    // Rank the pooled samples with average ranks for ties.
+    std::vector<std::pair<double, int>> pooled;
+    for ( auto s : baseline )
+        pooled.emplace_back( s, 0 );
+    for ( auto s : fresh )
+        pooled.emplace_back( s, 1 );
+    std::sort( pooled.begin(), pooled.end() );
+    double n = pooled.size();
+    double rank_sum = 0.0;
+    double tie_sum = 0.0;
+    for ( std::size_t i = 0; i < pooled.size(); )
+    {
+        std::size_t j = i;
+        while ( j < pooled.size() && pooled[j].first == pooled[i].first )
+            ++j;
+        double rank = 0.5 * ( i + 1 + j );
+        double t = j - i;
+        tie_sum += t * t * t - t;
+        for ( auto k = i; k < j; ++k )
+            if ( 1 == pooled[k].second )
+                rank_sum += rank;
+        i = j;
+    }
+
+    double n0 = baseline.size();
+    double n1 = fresh.size();
+    double u = rank_sum - 0.5 * n1 * ( n1 + 1.0 );
+    double mean = 0.5 * n0 * n1;
+    double variance =
+        n0 * n1 / 12.0 * ( ( n + 1.0 ) - tie_sum / ( n * ( n - 1.0 ) ) );
+    if ( variance <= 0.0 )
+        return ( u > mean ) ? 0.0 : 1.0;
+
+    // Continuity corrected normal approximation.
+    double z = ( u - mean - 0.5 ) / std::sqrt( variance );
+    return 0.5 * std::erfc( z / std::sqrt( 2.0 ) );
+}
+
+//---------------------------------------------------------------------------//
+// Print the build of a results file.
+void printBuild( const std::string& label, const Results& results )
+{
+    for ( auto& m : results.metadata )
+        std::cout << label << ": " << m.field( "benchmark" ) << " "
+                  << m.field( "cabana_version" ) << " ("
+                  << m.field( "git_hash" ) << "), Kokkos "
+                  << m.field( "kokkos_version" ) << ", "
+                  << m.field( "kokkos_backends" ) << std::endl;
+}
+
+//---------------------------------------------------------------------------//
+// main
+int main( int argc, char* argv[] )
+{
+    // Check arguments.
+    if ( argc < 3 )
+        throw std::runtime_error( "Incorrect number of arguments. \n \
+             First argument - baseline results of this machine (.json) \n \
+             Second argument - fresh results of the same benchmark (.json) \n \
+             Optional third argument - relative median slowdown reported as \n \
+             a regression (default 0.05) \n \
+             Optional fourth argument - significance level of the test \n \
+             (default 0.01) \n \
+             \n \
+             Example: \n \
+             $/: ./BenchmarkCompare baseline.json results.json 0.1 0.01\n" );
+
+    std::string baseline_file = argv[1];
+    std::string fresh_file = argv[2];
+    double threshold = ( argc > 3 ) ? std::atof( argv[3] ) : 0.05;
+    double alpha = ( argc > 4 ) ? std::atof( argv[4] ) : 0.01;
+
+    // Store the fresh results as the baseline if there is none.
+    if ( !std::ifstream( baseline_file ) )
+    {
+        readResults( fresh_file );
+        std::ifstream src( fresh_file, std::ios::binary );
+        std::ofstream dst( baseline_file, std::ios::binary );
+        dst << src.rdbuf();
+        std::cout << "Stored " << fresh_file << " as the new baseline "
+                  << baseline_file << std::endl;
+        return 0;
+    }
+
+    auto baseline = readResults( baseline_file );
+    auto fresh = readResults( fresh_file );
+    printBuild( "baseline", baseline );
+    printBuild( "fresh", fresh );
+
+    // Compare every data point present in both files.
+    int num_compared = 0;
+    int num_regression = 0;
+    int num_improvement = 0;
+    std::cout << std::endl
+              << "status name data_point num_rank baseline_median "
+                 "fresh_median change p_value"
+              << std::endl;
+    for ( auto& entry : fresh.timers )
+    {
+        auto base_it = baseline.timers.find( entry.first );
+        if ( base_it == baseline.timers.end() )
+            continue;
+        auto& base_samples = base_it->second.samples;
+        auto& fresh_samples = entry.second.samples;
+        if ( base_samples.empty() || fresh_samples.empty() )
+            continue;
+        ++num_compared;
+
+        double base_median = median( base_samples );
+        double fresh_median = median( fresh_samples );
+        double change = fresh_median / base_median - 1.0;
+        double p_slower = mannWhitneyGreater( base_samples, fresh_samples );
+        double p_faster = mannWhitneyGreater( fresh_samples, base_samples );
+
+        std::string status;
+        double p_value = p_slower;
+        if ( p_slower < alpha && change > threshold )
+        {
+            status = "REGRESSION";
+            ++num_regression;
+        }
+        else if ( p_faster < alpha && -change > threshold )
+        {
+            status = "improvement";
+            p_value = p_faster;
+            ++num_improvement;
+        }
+        else
+            continue;
+
+        std::cout << status << " " << std::get<0>( entry.first ) << " "
+                  << std::get<1>( entry.first ) << " "
+                  << std::get<2>( entry.first ) << " " << base_median << " "
+                  << fresh_median << " " << std::showpos << std::fixed
+                  << std::setprecision( 1 ) << 100.0 * change << "%"
+                  << std::noshowpos << std::defaultfloat
+                  << std::setprecision( 6 ) << " " << p_value << std::endl;
+    }
+
+    int num_missing = baseline.timers.size() - num_compared;
+    std::cout << std::endl
+              << num_compared << " data points compared, " << num_regression
+              << " regressions, " << num_improvement << " improvements";
+    if ( num_missing > 0 )
+        std::cout << ", " << num_missing
+                  << " baseline data points without fresh results";
+    std::cout << " (threshold " << threshold << ", significance " << alpha
+              << ")" << std::endl;
+
+    return std::min( num_regression, 255 );
+}
+
+//---------------------------------------------------------------------------//
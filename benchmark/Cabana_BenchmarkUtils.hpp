@@ -15,25 +15,125 @@
 #include <chrono>
 #include <cstdlib>
 #include <iostream>
+#include <limits>
 #include <numeric>
 #include <random>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #ifdef Cabana_ENABLE_MPI
 #include <mpi.h>
 #endif
 
+#ifdef Cabana_BENCHMARK_ENABLE_PAPI
+#include <papi.h>
+#endif
+
 namespace Cabana
 {
 namespace Benchmark
 {
 //---------------------------------------------------------------------------//
+// Hardware counters of the host. When the benchmarks are built with PAPI
+// (Cabana_ENABLE_PAPI) the double precision operations and the last level
+// cache misses of the calling thread are counted over every timed run. The
+// cache misses times the cache line size estimate the DRAM traffic. Only one
+// timer counts at a time; timers started while another is counting only
+// measure time.
+//
+// Only the calling thread is counted, so the counters are only used when the
+// default execution space runs kernels on the calling host thread, i.e. a
+// serial host space. Threaded host spaces would be undercounted by the
+// number of threads and device spaces would count the host thread instead of
+// the kernels.
+class HardwareCounters
+{
+  public:
+    // Get the counters of the process.
+    static HardwareCounters& get()
+    {
+        static HardwareCounters counters;
+        return counters;
+    }
+
+    // Whether the counters are supported by the build and the hardware and
+    // count the kernels of the default execution space.
+    bool available() const { return _available && serialExecution(); }
+
+    // Start counting. Returns false if the counters are unavailable or
+    // already counting.
+    bool start()
+    {
+        if ( !available() || _running )
+            return false;
+#ifdef Cabana_BENCHMARK_ENABLE_PAPI
+        if ( PAPI_OK != PAPI_start( _event_set ) )
+            return false;
+#endif
+        _running = true;
+        return true;
+    }
+
+    // Stop counting and get the counted operations and DRAM bytes.
+    void stop( double& flops, double& bytes )
+    {
+        flops = 0.0;
+        bytes = 0.0;
+        if ( !_running )
+            return;
+        _running = false;
+#ifdef Cabana_BENCHMARK_ENABLE_PAPI
+        long long values[2] = { 0, 0 };
+        if ( PAPI_OK != PAPI_stop( _event_set, values ) )
+            return;
+        flops = values[0];
+        bytes = values[1] * _cache_line_bytes;
+#endif
+    }
+
+  private:
+    // Whether the kernels of the default execution space run on the calling
+    // host thread.
+    static bool serialExecution()
+    {
+        return std::is_same<Kokkos::DefaultExecutionSpace,
+                            Kokkos::DefaultHostExecutionSpace>::value &&
+               1 == Kokkos::DefaultExecutionSpace().concurrency();
+    }
+
+    HardwareCounters()
+    {
+#ifdef Cabana_BENCHMARK_ENABLE_PAPI
+        if ( PAPI_VER_CURRENT != PAPI_library_init( PAPI_VER_CURRENT ) )
+            return;
+        if ( PAPI_OK != PAPI_create_eventset( &_event_set ) )
+            return;
+        if ( PAPI_OK != PAPI_add_event( _event_set, PAPI_DP_OPS ) ||
+             PAPI_OK != PAPI_add_event( _event_set, PAPI_L3_TCM ) )
+            return;
+        _available = true;
+#endif
+    }
+
+    bool _available = false;
+    bool _running = false;
+    int _event_set = -1;
+    double _cache_line_bytes = 64.0;
+};
+
+//---------------------------------------------------------------------------//
+//---------------------------------------------------------------------------//
 // Local timer. Carries multiple data points (the independent variable in
 // the parameter sweep) for each timer to allow for parametric sweeps. Each
 // timer can do multiple runs over each data point in the parameter sweep. The
 // name of the data point and its values can then be injected into the output
-// table.
+// table. A timer can optionally carry the work done in one run at each data
+// point (e.g. bytes moved, pairs evaluated, or particles sorted) such that
+// the achieved throughput, and its fraction of a peak throughput, is
+// reported with the times. Likewise the floating point operations and DRAM
+// bytes of a run, from hardware counters or a model, give the roofline
+// coordinates of each data point.
 class Timer
 {
   public:
@@ -43,7 +143,78 @@ class Timer
         , _starts( num_data )
         , _data( num_data )
         , _is_stopped( num_data, true )
+        , _work( num_data, 0.0 )
+        , _peak_rate( 0.0 )
+        , _model_flops( num_data, 0.0 )
+        , _model_bytes( num_data, 0.0 )
+        , _counted( num_data, false )
+        , _counter_flops( num_data, 0.0 )
+        , _counter_bytes( num_data, 0.0 )
+        , _counter_runs( num_data, 0 )
+    {
+    }
+
+    // Create the timer with the unit of the work done in each run (e.g.
+    // "bytes", "pairs", or "particles").
+    Timer( const std::string& name, const int num_data,
+           const std::string& work_unit )
+        : Timer( name, num_data )
+    {
+        _work_unit = work_unit;
+    }
+
+    // Set the work done in one run at the given data point.
+    void setWork( const int data_point, const double work )
+    {
+        _work[data_point] = work;
+    }
+
+    // Set the peak throughput (work per second) of a single process, e.g.
+    // from streamBandwidth() for timers measuring bytes.
+    void setPeakRate( const double peak_rate ) { _peak_rate = peak_rate; }
+
+    // Whether the timer reports throughput.
+    bool hasWork() const { return !_work_unit.empty(); }
+
+    // Set the floating point operations and DRAM bytes of one run at the
+    // given data point as counted by a model of the kernel. The timer then
+    // reports the roofline coordinates of the data point. The model takes
+    // precedence over hardware counts, which only cover serial execution.
+    void setRoofline( const int data_point, const double flops,
+                      const double bytes )
+    {
+        _model_flops[data_point] = flops;
+        _model_bytes[data_point] = bytes;
+    }
+
+    // Get the operations and DRAM bytes of one run at the given data point
+    // and their source: "model" for counts set with setRoofline(), "papi"
+    // for hardware counts of serial runs averaged over the runs, or empty if
+    // neither is available.
+    std::string rooflineCounts( const int data_point, double& flops,
+                                double& bytes ) const
+    {
+        flops = _model_flops[data_point];
+        bytes = _model_bytes[data_point];
+        if ( flops > 0.0 || bytes > 0.0 )
+            return "model";
+        if ( _counter_runs[data_point] > 0 )
+        {
+            flops = _counter_flops[data_point] / _counter_runs[data_point];
+            bytes = _counter_bytes[data_point] / _counter_runs[data_point];
+            return "papi";
+        }
+        return "";
+    }
+
+    // Whether the timer reports roofline coordinates.
+    bool hasRoofline() const
     {
+        double flops, bytes;
+        for ( int n = 0; n < static_cast<int>( _data.size() ); ++n )
+            if ( !rooflineCounts( n, flops, bytes ).empty() )
+                return true;
+        return false;
     }
 
     // Start the timer for the given data point.
@@ -51,6 +222,12 @@ class Timer
     {
         if ( !_is_stopped[data_point] )
             throw std::logic_error( "attempted to start a running timer" );
+
+        // The run is a Kokkos profiling region named after the timer so
+        // Kokkos Tools connectors collecting device metrics (e.g. through
+        // CUPTI or rocprofiler) can attribute them to the timer.
+        Kokkos::Profiling::pushRegion( _name );
+        _counted[data_point] = HardwareCounters::get().start();
         _starts[data_point] = std::chrono::high_resolution_clock::now();
         _is_stopped[data_point] = false;
     }
@@ -65,6 +242,24 @@ class Timer
             now - _starts[data_point];
         _data[data_point].push_back( fp_micro.count() );
         _is_stopped[data_point] = true;
+        if ( _counted[data_point] )
+        {
+            double flops, bytes;
+            HardwareCounters::get().stop( flops, bytes );
+            _counter_flops[data_point] += flops;
+            _counter_bytes[data_point] += bytes;
+            ++_counter_runs[data_point];
+        }
+        Kokkos::Profiling::popRegion();
+    }
+
+    // Record a time in microseconds measured outside of the timer at the
+    // given data point.
+    void record( const int data_point, const double time )
+    {
+        if ( !_is_stopped[data_point] )
+            throw std::logic_error( "attempted to record on a running timer" );
+        _data[data_point].push_back( time );
     }
 
   public:
@@ -72,8 +267,343 @@ class Timer
     std::vector<std::chrono::high_resolution_clock::time_point> _starts;
     std::vector<std::vector<double>> _data;
     std::vector<bool> _is_stopped;
+    std::string _work_unit;
+    std::vector<double> _work;
+    double _peak_rate;
+    std::vector<double> _model_flops;
+    std::vector<double> _model_bytes;
+    std::vector<bool> _counted;
+    std::vector<double> _counter_flops;
+    std::vector<double> _counter_bytes;
+    std::vector<int> _counter_runs;
+};
+
+//---------------------------------------------------------------------------//
+// Measure the sustainable memory bandwidth of a device in bytes per second
+// with the STREAM triad a(i) = b(i) + s * c(i), counting two reads and one
+// write per element. The best of several runs is returned for use as the
+// peak rate of bandwidth bound timers.
+template <class Device>
+double streamBandwidth( const std::size_t size = 1 << 25,
+                        const int num_run = 10 )
+{
+    using exec_space = typename Device::execution_space;
+    Kokkos::View<double*, Device> a( "stream_a", size );
+    Kokkos::View<double*, Device> b( "stream_b", size );
+    Kokkos::View<double*, Device> c( "stream_c", size );
+    Kokkos::deep_copy( b, 1.0 );
+    Kokkos::deep_copy( c, 2.0 );
+    double scalar = 3.0;
+
+    double best = std::numeric_limits<double>::max();
+    for ( int t = 0; t < num_run; ++t )
+    {
+        Kokkos::fence();
+        auto start = std::chrono::high_resolution_clock::now();
+        Kokkos::parallel_for(
+            "Cabana::Benchmark::stream_triad",
+            Kokkos::RangePolicy<exec_space>( 0, size ),
+            KOKKOS_LAMBDA( const std::size_t i ) {
+                a( i ) = b( i ) + scalar * c( i );
+            } );
+        Kokkos::fence();
+        std::chrono::duration<double> elapsed =
+            std::chrono::high_resolution_clock::now() - start;
+        best = std::min( best, elapsed.count() );
+    }
+    return 3.0 * sizeof( double ) * size / best;
+}
+
+//---------------------------------------------------------------------------//
+// Achieved throughput of a data point: the work done in one run, the work
+// per second at the average time, and the fraction of the peak rate (zero if
+// no peak rate was given).
+struct Throughput
+{
+    std::string unit;
+    double work = 0.0;
+    double rate = 0.0;
+    double peak_fraction = 0.0;
+
+    // Roofline coordinates: the operations and DRAM bytes of one run, the
+    // achieved FLOP/s, and the arithmetic intensity in FLOP per byte. The
+    // source of the counts is empty if there are none.
+    std::string counter_source;
+    double flops = 0.0;
+    double bytes = 0.0;
+    double flop_rate = 0.0;
+    double intensity = 0.0;
+};
+
+// Compute the throughput of all processes at a data point given the total
+// work of one run, the average run time in microseconds, and the number of
+// processes sharing the peak rate.
+inline Throughput throughput( const Timer& timer, const double work,
+                              const double average, const int num_rank )
+{
+    Throughput result;
+    result.unit = timer._work_unit;
+    result.work = work;
+    result.rate = work / ( 1.0e-6 * average );
+    if ( timer._peak_rate > 0.0 )
+        result.peak_fraction = result.rate / ( timer._peak_rate * num_rank );
+    return result;
+}
+
+// Add the roofline coordinates of a data point given the source, the total
+// operations and DRAM bytes of one run, and the average run time in
+// microseconds.
+inline void addRoofline( Throughput& tp, const std::string& source,
+                         const double flops, const double bytes,
+                         const double average )
+{
+    tp.counter_source = source;
+    tp.flops = flops;
+    tp.bytes = bytes;
+    tp.flop_rate = flops / ( 1.0e-6 * average );
+    tp.intensity = ( bytes > 0.0 ) ? flops / bytes : 0.0;
+}
+
+//---------------------------------------------------------------------------//
+// Output formats. Results are written as whitespace separated tables by
+// default. JSON output writes one object per line (JSON Lines) and CSV
+// output writes one row per data point so results can be loaded directly
+// into analysis tools and dashboards.
+enum class OutputFormat
+{
+    Table,
+    JSON,
+    CSV
+};
+
+// Output format used by all results of the benchmark.
+inline OutputFormat& outputFormat()
+{
+    static OutputFormat format = OutputFormat::Table;
+    return format;
+}
+
+// Select the output format from the extension of the output file: ".json"
+// and ".jsonl" give JSON, ".csv" gives CSV, and anything else a table.
+inline void setOutputFormat( const std::string& filename )
+{
+    auto has_extension = [&]( const std::string& ext ) {
+        return filename.size() >= ext.size() &&
+               0 == filename.compare( filename.size() - ext.size(),
+                                      ext.size(), ext );
+    };
+    if ( has_extension( ".json" ) || has_extension( ".jsonl" ) )
+        outputFormat() = OutputFormat::JSON;
+    else if ( has_extension( ".csv" ) )
+        outputFormat() = OutputFormat::CSV;
+    else
+        outputFormat() = OutputFormat::Table;
+}
+
+//---------------------------------------------------------------------------//
+// Quote a string for JSON output.
+inline std::string jsonString( const std::string& value )
+{
+    std::string quoted = "\"";
+    for ( auto c : value )
+    {
+        if ( '"' == c || '\\' == c )
+            quoted += '\\';
+        if ( static_cast<unsigned char>( c ) >= 0x20 )
+            quoted += c;
+    }
+    return quoted + "\"";
+}
+
+//---------------------------------------------------------------------------//
+// Benchmark metadata: build, Kokkos backends, and hardware. Each entry is a
+// key, a value, and whether the value is a string (as opposed to a number).
+struct MetadataEntry
+{
+    std::string key;
+    std::string value;
+    bool is_string;
 };
 
+inline std::vector<MetadataEntry>
+benchmarkMetadata( const std::string& benchmark_name, const int num_rank )
+{
+    std::vector<MetadataEntry> metadata;
+    auto add = [&]( const std::string& key, const std::string& value,
+                    const bool is_string ) {
+        metadata.push_back( { key, value, is_string } );
+    };
+    add( "benchmark", benchmark_name, true );
+    add( "cabana_version", Cabana::version(), true );
+    add( "git_hash", Cabana::git_commit_hash(), true );
+    add( "kokkos_version", std::to_string( KOKKOS_VERSION ), false );
+    add( "num_rank", std::to_string( num_rank ), false );
+    add( "host_concurrency",
+         std::to_string( Kokkos::DefaultHostExecutionSpace::concurrency() ),
+         false );
+
+    std::string backends;
+#ifdef KOKKOS_ENABLE_SERIAL
+    backends += "serial ";
+    add( "serial_vector_length",
+         std::to_string(
+             Cabana::Impl::PerformanceTraits<Kokkos::Serial>::vector_length ),
+         false );
+#endif
+#ifdef KOKKOS_ENABLE_OPENMP
+    backends += "openmp ";
+    add( "openmp_vector_length",
+         std::to_string(
+             Cabana::Impl::PerformanceTraits<Kokkos::OpenMP>::vector_length ),
+         false );
+    add( "openmp_concurrency",
+         std::to_string( Kokkos::OpenMP::concurrency() ), false );
+#endif
+#ifdef KOKKOS_ENABLE_CUDA
+    backends += "cuda ";
+    add( "cuda_vector_length",
+         std::to_string(
+             Cabana::Impl::PerformanceTraits<Kokkos::Cuda>::vector_length ),
+         false );
+    int cuda_device = 0;
+    cudaGetDevice( &cuda_device );
+    cudaDeviceProp cuda_prop;
+    cudaGetDeviceProperties( &cuda_prop, cuda_device );
+    add( "cuda_device", cuda_prop.name, true );
+#endif
+    if ( !backends.empty() )
+        backends.pop_back();
+    add( "kokkos_backends", backends, true );
+
+    return metadata;
+}
+
+// Write metadata entries. In CSV format this also writes the header of the
+// result rows and must therefore precede any results.
+inline void writeMetadata( std::ostream& stream,
+                           const std::vector<MetadataEntry>& metadata )
+{
+    if ( OutputFormat::JSON == outputFormat() )
+    {
+        stream << "{\"type\": \"metadata\"";
+        for ( auto& m : metadata )
+            stream << ", " << jsonString( m.key ) << ": "
+                   << ( m.is_string ? jsonString( m.value ) : m.value );
+        stream << "}\n";
+    }
+    else
+    {
+        for ( auto& m : metadata )
+            stream << "# " << m.key << ": " << m.value << "\n";
+        if ( OutputFormat::CSV == outputFormat() )
+            stream << "name,data_point_name,data_point,num_rank,min,max,ave,"
+                      "work_unit,work,rate,peak_fraction,counter_source,"
+                      "flops,dram_bytes,flop_rate,intensity,samples\n";
+    }
+}
+
+// Write the benchmark metadata.
+inline void outputMetadata( std::ostream& stream,
+                            const std::string& benchmark_name )
+{
+    writeMetadata( stream, benchmarkMetadata( benchmark_name, 1 ) );
+}
+
+// Write the benchmark metadata on rank 0. This function does collective
+// communication.
+#ifdef Cabana_ENABLE_MPI
+inline void outputMetadata( std::ostream& stream,
+                            const std::string& benchmark_name, MPI_Comm comm )
+{
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+    if ( 0 == comm_rank )
+        writeMetadata( stream, benchmarkMetadata( benchmark_name, comm_size ) );
+}
+#endif
+
+//---------------------------------------------------------------------------//
+// Write the statistics and samples of one data point of a timer as a JSON
+// object or CSV row.
+template <class Scalar>
+void writeRecord( std::ostream& stream, const std::string& timer_name,
+                  const std::string& data_point_name, const Scalar& data_point,
+                  const int num_rank, const double min, const double max,
+                  const double ave, const std::vector<double>& samples,
+                  const Throughput& tp = Throughput() )
+{
+    bool has_work = !tp.unit.empty();
+    if ( OutputFormat::JSON == outputFormat() )
+    {
+        stream << "{\"type\": \"timer\", \"name\": " << jsonString( timer_name )
+               << ", \"data_point_name\": " << jsonString( data_point_name )
+               << ", \"data_point\": " << data_point
+               << ", \"num_rank\": " << num_rank << ", \"min\": " << min
+               << ", \"max\": " << max << ", \"ave\": " << ave;
+        if ( has_work )
+            stream << ", \"work_unit\": " << jsonString( tp.unit )
+                   << ", \"work\": " << tp.work << ", \"rate\": " << tp.rate
+                   << ", \"peak_fraction\": " << tp.peak_fraction;
+        if ( !tp.counter_source.empty() )
+            stream << ", \"counter_source\": "
+                   << jsonString( tp.counter_source )
+                   << ", \"flops\": " << tp.flops
+                   << ", \"dram_bytes\": " << tp.bytes
+                   << ", \"flop_rate\": " << tp.flop_rate
+                   << ", \"intensity\": " << tp.intensity;
+        stream << ", \"samples\": [";
+        for ( std::size_t i = 0; i < samples.size(); ++i )
+            stream << ( i > 0 ? ", " : "" ) << samples[i];
+        stream << "]}\n";
+    }
+    else
+    {
+        stream << timer_name << "," << data_point_name << "," << data_point
+               << "," << num_rank << "," << min << "," << max << "," << ave
+               << ",";
+        if ( has_work )
+            stream << tp.unit << "," << tp.work << "," << tp.rate << ","
+                   << tp.peak_fraction;
+        else
+            stream << ",,,";
+        stream << ",";
+        if ( !tp.counter_source.empty() )
+            stream << tp.counter_source << "," << tp.flops << "," << tp.bytes
+                   << "," << tp.flop_rate << "," << tp.intensity;
+        else
+            stream << ",,,,";
+        stream << ",";
+        for ( std::size_t i = 0; i < samples.size(); ++i )
+            stream << ( i > 0 ? ";" : "" ) << samples[i];
+        stream << "\n";
+    }
+}
+
+// Write the throughput columns of a table header.
+inline void writeThroughputHeader( std::ostream& stream, const Timer& timer )
+{
+    if ( timer.hasWork() )
+        stream << " " << timer._work_unit << "_per_sec";
+    if ( timer.hasWork() && timer._peak_rate > 0.0 )
+        stream << " peak_fraction";
+    if ( timer.hasRoofline() )
+        stream << " flops_per_sec flops_per_byte";
+}
+
+// Write the throughput columns of a table row.
+inline void writeThroughputRow( std::ostream& stream, const Timer& timer,
+                                const Throughput& tp )
+{
+    if ( timer.hasWork() )
+        stream << " " << tp.rate;
+    if ( timer.hasWork() && timer._peak_rate > 0.0 )
+        stream << " " << tp.peak_fraction;
+    if ( timer.hasRoofline() )
+        stream << " " << tp.flop_rate << " " << tp.intensity;
+}
+
 //---------------------------------------------------------------------------//
 // Local output.
 // Write timer results. Provide the values of the data points so
@@ -84,10 +614,15 @@ void outputResults( std::ostream& stream, const std::string& data_point_name,
                     const Timer& timer )
 {
     // Write the data header.
-    stream << "\n";
-    stream << timer._name << "\n";
-    stream << data_point_name << " min max ave"
-           << "\n";
+    bool is_table = ( OutputFormat::Table == outputFormat() );
+    if ( is_table )
+    {
+        stream << "\n";
+        stream << timer._name << "\n";
+        stream << data_point_name << " min max ave";
+        writeThroughputHeader( stream, timer );
+        stream << "\n";
+    }
 
     // Write out each data point
     for ( std::size_t n = 0; n < timer._data.size(); ++n )
@@ -109,9 +644,31 @@ void outputResults( std::ostream& stream, const std::string& data_point_name,
                                             timer._data[n].end(), 0.0 );
         double average = local_sum / timer._data[n].size();
 
+        // Compute the throughput.
+        Throughput tp;
+        if ( timer.hasWork() )
+            tp = throughput( timer, timer._work[n], average, 1 );
+
+        // Compute the roofline coordinates.
+        double flops, bytes;
+        auto source = timer.rooflineCounts( n, flops, bytes );
+        if ( !source.empty() )
+            addRoofline( tp, source, flops, bytes, average );
+
         // Output.
-        stream << data_point_vals[n] << " " << local_min << " " << local_max
-               << " " << average << "\n";
+        if ( is_table )
+        {
+            stream << data_point_vals[n] << " " << local_min << " "
+                   << local_max << " " << average;
+            writeThroughputRow( stream, timer, tp );
+            stream << "\n";
+        }
+        else
+        {
+            writeRecord( stream, timer._name, data_point_name,
+                         data_point_vals[n], 1, local_min, local_max, average,
+                         timer._data[n], tp );
+        }
     }
 }
 
@@ -119,7 +676,9 @@ void outputResults( std::ostream& stream, const std::string& data_point_name,
 // Parallel output.
 // Write timer results on rank 0. Provide the values of the data points so
 // they can be injected into the table. This function does collective
-// communication.
+// communication. The samples of JSON and CSV output are the times of the
+// slowest rank in each run. The throughput is the work summed over all
+// ranks at the average time and its peak is the peak rate of every rank.
 #ifdef Cabana_ENABLE_MPI
 template <class Scalar>
 void outputResults( std::ostream& stream, const std::string& data_point_name,
@@ -135,12 +694,14 @@ void outputResults( std::ostream& stream, const std::string& data_point_name,
     MPI_Comm_size( comm, &comm_size );
 
     // Write the data header.
-    if ( 0 == comm_rank )
+    bool is_table = ( OutputFormat::Table == outputFormat() );
+    if ( 0 == comm_rank && is_table )
     {
         stream << "\n";
         stream << timer._name << "\n";
-        stream << "num_rank " << data_point_name << " min max ave"
-               << "\n";
+        stream << "num_rank " << data_point_name << " min max ave";
+        writeThroughputHeader( stream, timer );
+        stream << "\n";
     }
 
     // Write out each data point
@@ -169,16 +730,60 @@ void outputResults( std::ostream& stream, const std::string& data_point_name,
         MPI_Reduce( &local_sum, &average, 1, MPI_DOUBLE, MPI_SUM, 0, comm );
         average /= timer._data[n].size() * comm_size;
 
+        // Compute the throughput.
+        Throughput tp;
+        if ( timer.hasWork() )
+        {
+            double global_work = 0.0;
+            MPI_Reduce( &timer._work[n], &global_work, 1, MPI_DOUBLE, MPI_SUM,
+                        0, comm );
+            tp = throughput( timer, global_work, average, comm_size );
+        }
+
+        // Compute the roofline coordinates from the counts of all ranks.
+        // Hardware counts are only used if every rank has them.
+        double local_counts[2];
+        auto source = timer.rooflineCounts( n, local_counts[0],
+                                            local_counts[1] );
+        int local_papi = ( "papi" == source ) ? 1 : 0;
+        int all_papi = 0;
+        MPI_Allreduce( &local_papi, &all_papi, 1, MPI_INT, MPI_MIN, comm );
+        if ( local_papi && !all_papi )
+        {
+            local_counts[0] = timer._model_flops[n];
+            local_counts[1] = timer._model_bytes[n];
+        }
+        double global_counts[2] = { 0.0, 0.0 };
+        MPI_Reduce( local_counts, global_counts, 2, MPI_DOUBLE, MPI_SUM, 0,
+                    comm );
+        if ( global_counts[0] > 0.0 || global_counts[1] > 0.0 )
+            addRoofline( tp, all_papi ? "papi" : "model", global_counts[0],
+                         global_counts[1], average );
+
         // Output on rank 0.
-        if ( 0 == comm_rank )
+        if ( is_table )
         {
-            stream << comm_size << " " << data_point_vals[n] << " "
-                   << global_min << " " << global_max << " " << average << "\n";
+            if ( 0 == comm_rank )
+            {
+                stream << comm_size << " " << data_point_vals[n] << " "
+                       << global_min << " " << global_max << " " << average;
+                writeThroughputRow( stream, timer, tp );
+                stream << "\n";
+            }
+        }
+        else
+        {
+            std::vector<double> samples( timer._data[n].size() );
+            MPI_Reduce( timer._data[n].data(), samples.data(),
+                        samples.size(), MPI_DOUBLE, MPI_MAX, 0, comm );
+            if ( 0 == comm_rank )
+                writeRecord( stream, timer._name, data_point_name,
+                             data_point_vals[n], comm_size, global_min,
+                             global_max, average, samples, tp );
         }
     }
 }
 #endif
-
 //---------------------------------------------------------------------------//
 
 //---------------------------------------------------------------------------//
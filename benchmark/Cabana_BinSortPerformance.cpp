@@ -57,6 +57,14 @@ void performanceTest( std::ostream& stream, const std::string& test_prefix )
     using member_types = Cabana::MemberTypes<double[3], double[3], double, int>;
     using aosoa_type = Cabana::AoSoA<member_types, Device>;
 
+    // Bytes read and written per particle by permutations of the aosoa and
+    // of the first slice.
+    double aosoa_bytes = 2.0 * ( 7 * sizeof( double ) + sizeof( int ) );
+    double slice_bytes = 2.0 * 3 * sizeof( double );
+
+    // Peak memory bandwidth for the permutations.
+    double peak_bandwidth = Cabana::Benchmark::streamBandwidth<Device>();
+
     // Create aosoas.
     std::vector<aosoa_type> aosoas( num_problem_size );
     for ( int i = 0; i < num_problem_size; ++i )
@@ -78,17 +86,19 @@ void performanceTest( std::ostream& stream, const std::string& test_prefix )
         std::stringstream create_time_name;
         create_time_name << test_prefix << "bin_create_" << num_bins[b];
         Cabana::Benchmark::Timer create_timer( create_time_name.str(),
-                                               bin_num_problem );
+                                               bin_num_problem, "particles" );
         std::stringstream aosoa_permute_time_name;
         aosoa_permute_time_name << test_prefix << "bin_aosoa_permute_"
                                 << num_bins[b];
         Cabana::Benchmark::Timer aosoa_permute_timer(
-            aosoa_permute_time_name.str(), bin_num_problem );
+            aosoa_permute_time_name.str(), bin_num_problem, "bytes" );
+        aosoa_permute_timer.setPeakRate( peak_bandwidth );
         std::stringstream slice_permute_time_name;
         slice_permute_time_name << test_prefix << "bin_slice_permute_"
                                 << num_bins[b];
         Cabana::Benchmark::Timer slice_permute_timer(
-            slice_permute_time_name.str(), bin_num_problem );
+            slice_permute_time_name.str(), bin_num_problem, "bytes" );
+        slice_permute_timer.setPeakRate( peak_bandwidth );
 
         // Loop over the problem sizes.
         int pid = 0;
@@ -101,6 +111,11 @@ void performanceTest( std::ostream& stream, const std::string& test_prefix )
             {
                 // Track the problem size.
                 psizes.push_back( problem_sizes[p] );
+                create_timer.setWork( pid, problem_sizes[p] );
+                aosoa_permute_timer.setWork( pid,
+                                             aosoa_bytes * problem_sizes[p] );
+                slice_permute_timer.setWork( pid,
+                                             slice_bytes * problem_sizes[p] );
 
                 // Run tests and time the ensemble
                 for ( int t = 0; t < num_run; ++t )
@@ -140,15 +155,21 @@ void performanceTest( std::ostream& stream, const std::string& test_prefix )
 
     // Create sorting timers.
     Cabana::Benchmark::Timer create_timer( test_prefix + "sort_create",
-                                           num_problem_size );
+                                           num_problem_size, "particles" );
     Cabana::Benchmark::Timer aosoa_permute_timer(
-        test_prefix + "sort_aosoa_permute", num_problem_size );
+        test_prefix + "sort_aosoa_permute", num_problem_size, "bytes" );
+    aosoa_permute_timer.setPeakRate( peak_bandwidth );
     Cabana::Benchmark::Timer slice_permute_timer(
-        test_prefix + "sort_slice_permute", num_problem_size );
+        test_prefix + "sort_slice_permute", num_problem_size, "bytes" );
+    slice_permute_timer.setPeakRate( peak_bandwidth );
 
     // Loop over the problem sizes.
     for ( int p = 0; p < num_problem_size; ++p )
     {
+        create_timer.setWork( p, problem_sizes[p] );
+        aosoa_permute_timer.setWork( p, aosoa_bytes * problem_sizes[p] );
+        slice_permute_timer.setWork( p, slice_bytes * problem_sizes[p] );
+
         // Run tests and time the ensemble
         for ( int t = 0; t < num_run; ++t )
         {
@@ -188,17 +209,20 @@ int main( int argc, char* argv[] )
     // Check arguments.
     if ( argc < 2 )
         throw std::runtime_error( "Incorrect number of arguments. \n \
-             First argument -  file name for output \n \
+             First argument - file name for output (.json or .csv for \n \
+             machine-readable output) \n \
              \n \
              Example: \n \
              $/: ./BinSortPerformance test_results.txt\n" );
 
     // Get the name of the output file.
     std::string filename = argv[1];
+    Cabana::Benchmark::setOutputFormat( filename );
 
     // Open the output file on rank 0.
     std::fstream file;
     file.open( filename, std::fstream::out );
+    Cabana::Benchmark::outputMetadata( file, "BinSortPerformance" );
 
     // Run the tests.
 #ifdef KOKKOS_ENABLE_SERIAL
@@ -386,7 +386,8 @@ int main( int argc, char* argv[] )
     if ( argc < 3 )
         throw std::runtime_error( "Incorrect number of arguments. \n \
              First argument - integer number of particles per MPI rank \n \
-             Second argument - file name for output \n \
+             Second argument - file name for output (.json or .csv for \n \
+             machine-readable output) \n \
              \n \
              Example: \n \
              $/: ./CommPerformance 100000 test_results.txt\n" );
@@ -396,6 +397,7 @@ int main( int argc, char* argv[] )
 
     // Get the name of the output file.
     std::string filename = argv[2];
+    Cabana::Benchmark::setOutputFormat( filename );
 
     // Barier before continuing.
     MPI_Barrier( MPI_COMM_WORLD );
@@ -412,6 +414,8 @@ int main( int argc, char* argv[] )
     std::fstream file;
     if ( 0 == comm_rank )
         file.open( filename, std::fstream::out );
+    Cabana::Benchmark::outputMetadata( file, "CommPerformance",
+                                       MPI_COMM_WORLD );
 
     // Output problem details.
     if ( 0 == comm_rank )
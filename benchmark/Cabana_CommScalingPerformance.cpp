@@ -0,0 +1,398 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "Cabana_BenchmarkUtils.hpp"
+
+#include <Cabana_Core.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <mpi.h>
+
+//---------------------------------------------------------------------------//
+// Phase timing. Halo and distributor operations mark their pack, MPI wait,
+// and unpack phases with Kokkos profiling regions. The time spent in each
+// region is accumulated through the Kokkos Tools region callbacks.
+//---------------------------------------------------------------------------//
+#if KOKKOS_VERSION >= 30300
+#define CABANA_COMM_SCALING_REGION_TIMING
+#endif
+
+using clock_type = std::chrono::high_resolution_clock;
+
+// Accumulated time in microseconds of each region since the last reset.
+std::map<std::string, double>& regionTimes()
+{
+    static std::map<std::string, double> times;
+    return times;
+}
+
+// Currently open regions.
+std::vector<std::pair<std::string, clock_type::time_point>>& regionStack()
+{
+    static std::vector<std::pair<std::string, clock_type::time_point>> stack;
+    return stack;
+}
+
+void pushRegionCallback( const char* name )
+{
+    regionStack().emplace_back( name, clock_type::now() );
+}
+
+void popRegionCallback()
+{
+    if ( regionStack().empty() )
+        return;
+    std::chrono::duration<double, std::micro> elapsed =
+        clock_type::now() - regionStack().back().second;
+    regionTimes()[regionStack().back().first] += elapsed.count();
+    regionStack().pop_back();
+}
+
+// Reset the accumulated region times.
+void resetRegionTimes() { regionTimes().clear(); }
+
+// Get the accumulated time of a region. Missing regions took no time.
+double regionTime( const std::string& name )
+{
+    auto it = regionTimes().find( name );
+    return ( it == regionTimes().end() ) ? 0.0 : it->second;
+}
+
+//---------------------------------------------------------------------------//
+// Performance test.
+template <class Device>
+void performanceTest( std::ostream& stream, const bool weak_scaling,
+                      const std::size_t num_particle,
+                      const std::string& test_prefix )
+{
+    using memory_space = typename Device::memory_space;
+
+    // PROBLEM SETUP
+    // -------------
+
+    // Get comm size;
+    int comm_size;
+    MPI_Comm_size( MPI_COMM_WORLD, &comm_size );
+
+    // Partition the domain in 3 dimensions with periodic boundaries.
+    const int space_dim = 3;
+    std::vector<int> ranks_per_dim( space_dim, 0 );
+    MPI_Dims_create( comm_size, space_dim, ranks_per_dim.data() );
+    std::vector<int> periodic_dims( space_dim, 1 );
+    MPI_Comm cart_comm;
+    MPI_Cart_create( MPI_COMM_WORLD, space_dim, ranks_per_dim.data(),
+                     periodic_dims.data(), 1, &cart_comm );
+    int linear_rank;
+    MPI_Comm_rank( cart_comm, &linear_rank );
+    std::vector<int> cart_rank( space_dim );
+    MPI_Cart_coords( cart_comm, linear_rank, space_dim, cart_rank.data() );
+
+    // Compute the rank of each of the 27 neighboring subdomains, indexed by
+    // the offset ( i + 1 ) + 3 * ( j + 1 ) + 9 * ( k + 1 ).
+    std::vector<int> neighbor_ranks( 27 );
+    for ( int k = -1; k < 2; ++k )
+        for ( int j = -1; j < 2; ++j )
+            for ( int i = -1; i < 2; ++i )
+            {
+                std::vector<int> ncr = { cart_rank[0] + i, cart_rank[1] + j,
+                                         cart_rank[2] + k };
+                MPI_Cart_rank( cart_comm, ncr.data(),
+                               &neighbor_ranks[( i + 1 ) + 3 * ( j + 1 ) +
+                                               9 * ( k + 1 )] );
+            }
+    std::vector<int> unique_neighbors( neighbor_ranks );
+    std::sort( unique_neighbors.begin(), unique_neighbors.end() );
+    unique_neighbors.erase(
+        std::unique( unique_neighbors.begin(), unique_neighbors.end() ),
+        unique_neighbors.end() );
+
+    // Each subdomain is a unit cube in local coordinates. Particles within
+    // the ghost width of a face, edge, or corner are ghosted to the
+    // subdomains across it (about 27% of the particles for a width of
+    // 0.05). Particles move up to the displacement in each dimension
+    // between redistributions (about 14% of the particles leave).
+    const double ghost_width = 0.05;
+    const double max_displacement = 0.05;
+
+    // Particle sizes to sweep. Weak scaling fixes the number of particles
+    // per rank and strong scaling fixes the global number of particles.
+    std::vector<std::size_t> problem_sizes = {
+        num_particle / 100, num_particle / 10, num_particle };
+    int num_problem_size = problem_sizes.size();
+
+    // Number of runs in the test loops.
+    int num_run = 10;
+
+    // Define the aosoa.
+    using member_types = Cabana::MemberTypes<double[3], double[3], int>;
+    using aosoa_type = Cabana::AoSoA<member_types, memory_space>;
+    using aosoa_host_type = Cabana::AoSoA<member_types, Kokkos::HostSpace>;
+
+    // Create the phase timers.
+    auto create_timer = [&]( const std::string& name ) {
+        return Cabana::Benchmark::Timer( test_prefix + name, num_problem_size );
+    };
+    auto halo_create = create_timer( "halo_create" );
+    auto gather_pack = create_timer( "halo_gather_pack" );
+    auto gather_wait = create_timer( "halo_gather_wait" );
+    auto gather_unpack = create_timer( "halo_gather_unpack" );
+    auto scatter_pack = create_timer( "halo_scatter_pack" );
+    auto scatter_wait = create_timer( "halo_scatter_wait" );
+    auto scatter_unpack = create_timer( "halo_scatter_unpack" );
+    auto distributor_create = create_timer( "distributor_create" );
+    auto migrate_pack = create_timer( "distributor_migrate_pack" );
+    auto migrate_wait = create_timer( "distributor_migrate_wait" );
+    auto migrate_unpack = create_timer( "distributor_migrate_unpack" );
+
+    std::minstd_rand0 generator( 3439203991 + linear_rank );
+    std::uniform_real_distribution<double> position_dist( 0.0, 1.0 );
+    std::uniform_real_distribution<double> displacement_dist(
+        -max_displacement, max_displacement );
+
+    for ( int p = 0; p < num_problem_size; ++p )
+    {
+        std::size_t num_local = ( weak_scaling )
+                                    ? problem_sizes[p]
+                                    : problem_sizes[p] / comm_size;
+
+        // Create particles at random positions in the subdomain with random
+        // displacements.
+        aosoa_host_type particles_host( "particles_host", num_local );
+        auto x_host = Cabana::slice<0>( particles_host );
+        auto dx_host = Cabana::slice<1>( particles_host );
+        auto id_host = Cabana::slice<2>( particles_host );
+        for ( std::size_t n = 0; n < num_local; ++n )
+        {
+            for ( int d = 0; d < space_dim; ++d )
+            {
+                x_host( n, d ) = position_dist( generator );
+                dx_host( n, d ) = displacement_dist( generator );
+            }
+            id_host( n ) = n;
+        }
+
+        // Export every particle near a boundary of the subdomain to each
+        // subdomain across it.
+        std::vector<int> ghost_ids;
+        std::vector<int> ghost_ranks;
+        for ( std::size_t n = 0; n < num_local; ++n )
+        {
+            int side[3];
+            for ( int d = 0; d < space_dim; ++d )
+                side[d] = ( x_host( n, d ) < ghost_width )
+                              ? -1
+                              : ( ( x_host( n, d ) > 1.0 - ghost_width ) ? 1
+                                                                         : 0 );
+            for ( int k = std::min( side[2], 0 ); k <= std::max( side[2], 0 );
+                  ++k )
+                for ( int j = std::min( side[1], 0 );
+                      j <= std::max( side[1], 0 ); ++j )
+                    for ( int i = std::min( side[0], 0 );
+                          i <= std::max( side[0], 0 ); ++i )
+                        if ( !( i == 0 && j == 0 && k == 0 ) )
+                        {
+                            ghost_ids.push_back( n );
+                            ghost_ranks.push_back(
+                                neighbor_ranks[( i + 1 ) + 3 * ( j + 1 ) +
+                                               9 * ( k + 1 )] );
+                        }
+        }
+        Kokkos::View<int*, Kokkos::HostSpace,
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged>>
+            ghost_ids_host( ghost_ids.data(), ghost_ids.size() );
+        Kokkos::View<int*, Kokkos::HostSpace,
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged>>
+            ghost_ranks_host( ghost_ranks.data(), ghost_ranks.size() );
+        auto export_ids = Kokkos::create_mirror_view_and_copy(
+            memory_space(), ghost_ids_host );
+        auto export_ranks = Kokkos::create_mirror_view_and_copy(
+            memory_space(), ghost_ranks_host );
+
+        // Send every particle that moved out of the subdomain to the
+        // subdomain it moved into.
+        Kokkos::View<int*, Kokkos::HostSpace> destinations_host(
+            "destinations", num_local );
+        for ( std::size_t n = 0; n < num_local; ++n )
+        {
+            int offset[3];
+            for ( int d = 0; d < space_dim; ++d )
+            {
+                double x = x_host( n, d ) + dx_host( n, d );
+                offset[d] = ( x < 0.0 ) ? -1 : ( ( x >= 1.0 ) ? 1 : 0 );
+            }
+            destinations_host( n ) =
+                neighbor_ranks[( offset[0] + 1 ) + 3 * ( offset[1] + 1 ) +
+                               9 * ( offset[2] + 1 )];
+        }
+        auto destinations = Kokkos::create_mirror_view_and_copy(
+            memory_space(), destinations_host );
+
+        // Run tests and time the ensemble.
+        for ( int t = 0; t < num_run; ++t )
+        {
+            aosoa_type particles( "particles", num_local );
+            Cabana::deep_copy( particles, particles_host );
+
+            // HALO
+            // ----
+            MPI_Barrier( cart_comm );
+            halo_create.start( p );
+            Cabana::Halo<memory_space> halo( cart_comm, num_local, export_ids,
+                                             export_ranks, unique_neighbors );
+            halo_create.stop( p );
+
+            particles.resize( halo.numLocal() + halo.numGhost() );
+
+            // Gather. The pack is timed directly and the MPI wait and
+            // unpack phases through their profiling regions.
+            MPI_Barrier( cart_comm );
+            gather_pack.start( p );
+            auto request = Cabana::gatherStart( halo, particles );
+            gather_pack.stop( p );
+            resetRegionTimes();
+            request.finish();
+            gather_wait.record( p, regionTime( "Cabana::Halo::wait" ) );
+            gather_unpack.record( p, regionTime( "Cabana::Halo::unpack" ) );
+
+            // Scatter the displacements back to their owners.
+            MPI_Barrier( cart_comm );
+            auto dx = Cabana::slice<1>( particles );
+            resetRegionTimes();
+            Cabana::scatter( halo, dx );
+            scatter_pack.record( p, regionTime( "Cabana::scatter::pack" ) );
+            scatter_wait.record( p, regionTime( "Cabana::scatter::wait" ) );
+            scatter_unpack.record( p,
+                                   regionTime( "Cabana::scatter::unpack" ) );
+
+            // DISTRIBUTOR
+            // -----------
+            particles.resize( num_local );
+
+            MPI_Barrier( cart_comm );
+            distributor_create.start( p );
+            Cabana::Distributor<memory_space> distributor(
+                cart_comm, destinations, unique_neighbors );
+            distributor_create.stop( p );
+
+            MPI_Barrier( cart_comm );
+            resetRegionTimes();
+            Cabana::migrate( distributor, particles );
+            migrate_pack.record( p, regionTime( "Cabana::migrate::pack" ) );
+            migrate_wait.record( p, regionTime( "Cabana::migrate::wait" ) );
+            migrate_unpack.record( p,
+                                   regionTime( "Cabana::migrate::unpack" ) );
+        }
+    }
+
+    // Output results.
+    std::string data_point_name =
+        ( weak_scaling ) ? "particles_per_rank" : "global_particles";
+    for ( auto timer :
+          { &halo_create, &gather_pack, &gather_wait, &gather_unpack,
+            &scatter_pack, &scatter_wait, &scatter_unpack,
+            &distributor_create, &migrate_pack, &migrate_wait,
+            &migrate_unpack } )
+        outputResults( stream, data_point_name, problem_sizes, *timer,
+                       cart_comm );
+
+    MPI_Comm_free( &cart_comm );
+}
+
+//---------------------------------------------------------------------------//
+// main
+int main( int argc, char* argv[] )
+{
+    // Initialize environment
+    MPI_Init( &argc, &argv );
+    Kokkos::initialize( argc, argv );
+
+    // Check arguments.
+    if ( argc < 4 )
+        throw std::runtime_error( "Incorrect number of arguments. \n \
+             First argument - scaling type: weak or strong \n \
+             Second argument - largest number of particles per rank (weak) \n \
+             or globally (strong) \n \
+             Third argument - file name for output (.json or .csv for \n \
+             machine-readable output) \n \
+             \n \
+             Example: \n \
+             $/: ./CommScalingPerformance weak 1000000 test_results.txt\n" );
+
+    // Get the scaling type.
+    std::string scaling = argv[1];
+    if ( scaling != "weak" && scaling != "strong" )
+        throw std::runtime_error( "Scaling type must be weak or strong" );
+
+    // Get the largest number of particles.
+    std::size_t num_particle = std::atol( argv[2] );
+
+    // Get the name of the output file.
+    std::string filename = argv[3];
+    Cabana::Benchmark::setOutputFormat( filename );
+
+    // Time the phases of the halo and distributor.
+#ifdef CABANA_COMM_SCALING_REGION_TIMING
+    Kokkos::Tools::Experimental::set_push_region_callback( pushRegionCallback );
+    Kokkos::Tools::Experimental::set_pop_region_callback( popRegionCallback );
+#endif
+
+    // Get comm rank;
+    int comm_rank;
+    MPI_Comm_rank( MPI_COMM_WORLD, &comm_rank );
+
+    // Open the output file on rank 0.
+    std::fstream file;
+    if ( 0 == comm_rank )
+        file.open( filename, std::fstream::out );
+    Cabana::Benchmark::outputMetadata( file, "CommScalingPerformance",
+                                       MPI_COMM_WORLD );
+
+    // Run the tests.
+#ifdef KOKKOS_ENABLE_SERIAL
+    using SerialDevice = Kokkos::Device<Kokkos::Serial, Kokkos::HostSpace>;
+    performanceTest<SerialDevice>( file, "weak" == scaling, num_particle,
+                                   "serial_" );
+#endif
+
+#ifdef KOKKOS_ENABLE_OPENMP
+    using OpenMPDevice = Kokkos::Device<Kokkos::OpenMP, Kokkos::HostSpace>;
+    performanceTest<OpenMPDevice>( file, "weak" == scaling, num_particle,
+                                   "openmp_" );
+#endif
+
+#ifdef KOKKOS_ENABLE_CUDA
+    using CudaDevice = Kokkos::Device<Kokkos::Cuda, Kokkos::CudaSpace>;
+    performanceTest<CudaDevice>( file, "weak" == scaling, num_particle,
+                                 "cuda_" );
+#endif
+
+    // Close the output file on rank 0.
+    if ( 0 == comm_rank )
+        file.close();
+
+    // Finalize
+    Kokkos::finalize();
+    MPI_Finalize();
+    return 0;
+}
+
+//---------------------------------------------------------------------------//
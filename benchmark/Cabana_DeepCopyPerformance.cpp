@@ -0,0 +1,229 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "Cabana_BenchmarkUtils.hpp"
+
+#include <Cabana_Core.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+//---------------------------------------------------------------------------//
+// Member sets of increasing size. The first member of every set is the one
+// copied by the slice copies.
+using OneMember = Cabana::MemberTypes<double[3]>;
+using ThreeMembers = Cabana::MemberTypes<double[3], double[3], double>;
+using SixMembers = Cabana::MemberTypes<double[3], double[3], double[3],
+                                       double, double, int>;
+
+// Bytes of one particle of a member set.
+template <class Types>
+double particleBytes()
+{
+    using soa_type = Cabana::SoA<Types, 1>;
+    return sizeof( soa_type );
+}
+
+//---------------------------------------------------------------------------//
+// Reference copy of the same number of bytes with Kokkos::deep_copy. The
+// throughput of all copies is the number of bytes copied per second.
+template <class DstDevice, class SrcDevice, class Types>
+void kokkosCopyTest( std::ostream& stream, const std::string& name,
+                     const std::vector<int>& problem_sizes,
+                     const int num_run )
+{
+    int num_problem_size = problem_sizes.size();
+    Cabana::Benchmark::Timer timer( name + "_kokkos_deep_copy",
+                                    num_problem_size, "bytes" );
+    for ( int p = 0; p < num_problem_size; ++p )
+    {
+        std::size_t num_bytes = particleBytes<Types>() * problem_sizes[p];
+        timer.setWork( p, num_bytes );
+        Kokkos::View<char*, DstDevice> dst( "dst", num_bytes );
+        Kokkos::View<char*, SrcDevice> src( "src", num_bytes );
+        for ( int t = 0; t < num_run; ++t )
+        {
+            timer.start( p );
+            Kokkos::deep_copy( dst, src );
+            Kokkos::fence();
+            timer.stop( p );
+        }
+    }
+    outputResults( stream, "problem_size", problem_sizes, timer );
+}
+
+//---------------------------------------------------------------------------//
+// Copies between AoSoAs of the given vector lengths. AoSoA copies of equal
+// vector lengths are byte-wise copies, otherwise they convert the layout.
+// Mirrors are only created for equal vector lengths in different spaces as
+// they keep the layout of the source.
+template <class DstDevice, class SrcDevice, class Types, int DstVectorLength,
+          int SrcVectorLength>
+void aosoaCopyTest( std::ostream& stream, const std::string& prefix,
+                    const std::vector<int>& problem_sizes, const int num_run )
+{
+    using dst_aosoa = Cabana::AoSoA<Types, DstDevice, DstVectorLength>;
+    using src_aosoa = Cabana::AoSoA<Types, SrcDevice, SrcVectorLength>;
+    using dst_memory_space = typename DstDevice::memory_space;
+    using src_memory_space = typename SrcDevice::memory_space;
+    const bool test_mirror =
+        ( DstVectorLength == SrcVectorLength ) &&
+        !std::is_same<dst_memory_space, src_memory_space>::value;
+
+    std::stringstream name;
+    name << prefix << "_vl_" << SrcVectorLength << "_to_" << DstVectorLength;
+    int num_problem_size = problem_sizes.size();
+    Cabana::Benchmark::Timer aosoa_timer( name.str() + "_aosoa_deep_copy",
+                                          num_problem_size, "bytes" );
+    Cabana::Benchmark::Timer mirror_timer( name.str() + "_mirror_and_copy",
+                                           num_problem_size, "bytes" );
+    Cabana::Benchmark::Timer slice_timer( name.str() + "_slice_deep_copy",
+                                          num_problem_size, "bytes" );
+    for ( int p = 0; p < num_problem_size; ++p )
+    {
+        double num_bytes = particleBytes<Types>() * problem_sizes[p];
+        aosoa_timer.setWork( p, num_bytes );
+        mirror_timer.setWork( p, num_bytes );
+        slice_timer.setWork( p, 3 * sizeof( double ) * problem_sizes[p] );
+
+        dst_aosoa dst( "dst", problem_sizes[p] );
+        src_aosoa src( "src", problem_sizes[p] );
+        auto src_slice = Cabana::slice<0>( src );
+        auto dst_slice = Cabana::slice<0>( dst );
+        Cabana::deep_copy( src_slice, 1.0 );
+
+        for ( int t = 0; t < num_run; ++t )
+        {
+            aosoa_timer.start( p );
+            Cabana::deep_copy( dst, src );
+            Kokkos::fence();
+            aosoa_timer.stop( p );
+
+            if ( test_mirror )
+            {
+                mirror_timer.start( p );
+                auto mirror = Cabana::create_mirror_view_and_copy(
+                    dst_memory_space(), src );
+                Kokkos::fence();
+                mirror_timer.stop( p );
+            }
+
+            slice_timer.start( p );
+            Cabana::deep_copy( dst_slice, src_slice );
+            Kokkos::fence();
+            slice_timer.stop( p );
+        }
+    }
+    outputResults( stream, "problem_size", problem_sizes, aosoa_timer );
+    if ( test_mirror )
+        outputResults( stream, "problem_size", problem_sizes, mirror_timer );
+    outputResults( stream, "problem_size", problem_sizes, slice_timer );
+}
+
+//---------------------------------------------------------------------------//
+// Sweep the vector lengths of a member set between two devices.
+template <class DstDevice, class SrcDevice, class Types>
+void memberTest( std::ostream& stream, const std::string& prefix,
+                 const std::vector<int>& problem_sizes, const int num_run )
+{
+    kokkosCopyTest<DstDevice, SrcDevice, Types>( stream, prefix,
+                                                 problem_sizes, num_run );
+
+    // Equal vector lengths.
+    aosoaCopyTest<DstDevice, SrcDevice, Types, 1, 1>( stream, prefix,
+                                                      problem_sizes, num_run );
+    aosoaCopyTest<DstDevice, SrcDevice, Types, 16, 16>(
+        stream, prefix, problem_sizes, num_run );
+    aosoaCopyTest<DstDevice, SrcDevice, Types, 64, 64>(
+        stream, prefix, problem_sizes, num_run );
+
+    // Layout conversions.
+    aosoaCopyTest<DstDevice, SrcDevice, Types, 1, 16>( stream, prefix,
+                                                       problem_sizes, num_run );
+    aosoaCopyTest<DstDevice, SrcDevice, Types, 16, 1>( stream, prefix,
+                                                       problem_sizes, num_run );
+    aosoaCopyTest<DstDevice, SrcDevice, Types, 64, 16>(
+        stream, prefix, problem_sizes, num_run );
+}
+
+//---------------------------------------------------------------------------//
+// Performance test of the copies from a source device to a destination
+// device.
+template <class DstDevice, class SrcDevice>
+void performanceTest( std::ostream& stream, const std::string& test_prefix )
+{
+    // Declare problem sizes.
+    std::vector<int> problem_sizes = { 1000, 10000, 100000, 1000000,
+                                       10000000 };
+
+    // Number of runs in the test loops.
+    int num_run = 10;
+
+    memberTest<DstDevice, SrcDevice, OneMember>(
+        stream, test_prefix + "members_1", problem_sizes, num_run );
+    memberTest<DstDevice, SrcDevice, ThreeMembers>(
+        stream, test_prefix + "members_3", problem_sizes, num_run );
+    memberTest<DstDevice, SrcDevice, SixMembers>(
+        stream, test_prefix + "members_6", problem_sizes, num_run );
+}
+
+//---------------------------------------------------------------------------//
+// main
+int main( int argc, char* argv[] )
+{
+    // Initialize environment
+    Kokkos::initialize( argc, argv );
+
+    // Check arguments.
+    if ( argc < 2 )
+        throw std::runtime_error( "Incorrect number of arguments. \n \
+             First argument - file name for output (.json or .csv for \n \
+             machine-readable output) \n \
+             \n \
+             Example: \n \
+             $/: ./DeepCopyPerformance test_results.txt\n" );
+
+    // Get the name of the output file.
+    std::string filename = argv[1];
+    Cabana::Benchmark::setOutputFormat( filename );
+
+    // Open the output file on rank 0.
+    std::fstream file;
+    file.open( filename, std::fstream::out );
+    Cabana::Benchmark::outputMetadata( file, "DeepCopyPerformance" );
+
+    // Run the tests.
+    using HostDevice = Kokkos::Device<Kokkos::DefaultHostExecutionSpace,
+                                      Kokkos::HostSpace>;
+    performanceTest<HostDevice, HostDevice>( file, "host_to_host_" );
+
+#ifdef KOKKOS_ENABLE_CUDA
+    using CudaDevice = Kokkos::Device<Kokkos::Cuda, Kokkos::CudaSpace>;
+    performanceTest<CudaDevice, HostDevice>( file, "host_to_cuda_" );
+    performanceTest<HostDevice, CudaDevice>( file, "cuda_to_host_" );
+    performanceTest<CudaDevice, CudaDevice>( file, "cuda_to_cuda_" );
+#endif
+
+    // Close the output file on rank 0.
+    file.close();
+
+    // Finalize
+    Kokkos::finalize();
+    return 0;
+}
+
+//---------------------------------------------------------------------------//
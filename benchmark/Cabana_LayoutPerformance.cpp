@@ -0,0 +1,347 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "Cabana_BenchmarkUtils.hpp"
+
+#include <Cabana_Core.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+//---------------------------------------------------------------------------//
+// Every particle has a position, a velocity, and a mass. The access patterns
+// are:
+//
+// stream - every particle is moved by its velocity.
+// gather - every particle reads the position and mass of a random particle.
+// neighbor - every particle accumulates the mass weighted distances to a
+// fixed number of nearby particles into its velocity, as in a neighbor list
+// of spatially sorted particles.
+constexpr int num_neighbor = 16;
+constexpr int neighbor_window = 64;
+
+// Bytes read and written per particle by each pattern.
+constexpr double stream_bytes = 9 * sizeof( double );
+constexpr double gather_bytes = 5 * sizeof( double ) + sizeof( int );
+constexpr double neighbor_bytes =
+    ( 4 * num_neighbor + 9 ) * sizeof( double ) + num_neighbor * sizeof( int );
+
+// Floating point operations per particle by each pattern.
+constexpr double stream_flops = 6;
+constexpr double gather_flops = 3;
+constexpr double neighbor_flops = 9 * num_neighbor + 6;
+
+//---------------------------------------------------------------------------//
+// Timers of the access patterns of a layout.
+struct PatternTimers
+{
+    PatternTimers( const std::string& name, const int num_data,
+                   const double peak_bandwidth )
+        : stream( name + "_stream", num_data, "bytes" )
+        , gather( name + "_gather", num_data, "bytes" )
+        , neighbor( name + "_neighbor", num_data, "bytes" )
+    {
+        stream.setPeakRate( peak_bandwidth );
+        gather.setPeakRate( peak_bandwidth );
+        neighbor.setPeakRate( peak_bandwidth );
+    }
+
+    void setWork( const int pid, const int num_particle )
+    {
+        stream.setWork( pid, stream_bytes * num_particle );
+        gather.setWork( pid, gather_bytes * num_particle );
+        neighbor.setWork( pid, neighbor_bytes * num_particle );
+        stream.setRoofline( pid, stream_flops * num_particle,
+                            stream_bytes * num_particle );
+        gather.setRoofline( pid, gather_flops * num_particle,
+                            gather_bytes * num_particle );
+        neighbor.setRoofline( pid, neighbor_flops * num_particle,
+                              neighbor_bytes * num_particle );
+    }
+
+    void output( std::ostream& out, const std::vector<int>& problem_sizes )
+    {
+        outputResults( out, "problem_size", problem_sizes, stream );
+        outputResults( out, "problem_size", problem_sizes, gather );
+        outputResults( out, "problem_size", problem_sizes, neighbor );
+    }
+
+    Cabana::Benchmark::Timer stream;
+    Cabana::Benchmark::Timer gather;
+    Cabana::Benchmark::Timer neighbor;
+};
+
+//---------------------------------------------------------------------------//
+// Run the access patterns on the positions, velocities, and masses of a
+// layout. Views and slices are both accessed with (particle, component).
+template <class ExecutionSpace, class PositionType, class VelocityType,
+          class MassType, class IdView, class OffsetView, class OutView>
+void runPatterns( PatternTimers& timers, const int pid, const int num_run,
+                  const int num_particle, PositionType x, VelocityType v,
+                  MassType m, const IdView& gather_ids,
+                  const OffsetView& neighbor_offsets, const OutView& out )
+{
+    Kokkos::RangePolicy<ExecutionSpace> policy( 0, num_particle );
+    const double dt = 1.0e-3;
+    for ( int t = 0; t < num_run; ++t )
+    {
+        timers.stream.start( pid );
+        Kokkos::parallel_for(
+            "stream", policy, KOKKOS_LAMBDA( const int i ) {
+                for ( int d = 0; d < 3; ++d )
+                    x( i, d ) += dt * v( i, d );
+            } );
+        Kokkos::fence();
+        timers.stream.stop( pid );
+
+        timers.gather.start( pid );
+        Kokkos::parallel_for(
+            "gather", policy, KOKKOS_LAMBDA( const int i ) {
+                int j = gather_ids( i ) % num_particle;
+                out( i ) = m( j ) * ( x( j, 0 ) + x( j, 1 ) + x( j, 2 ) );
+            } );
+        Kokkos::fence();
+        timers.gather.stop( pid );
+
+        timers.neighbor.start( pid );
+        Kokkos::parallel_for(
+            "neighbor", policy, KOKKOS_LAMBDA( const int i ) {
+                double f[3] = { 0.0, 0.0, 0.0 };
+                for ( int n = 0; n < num_neighbor; ++n )
+                {
+                    int j = ( i + neighbor_offsets( i, n ) + num_particle ) %
+                            num_particle;
+                    for ( int d = 0; d < 3; ++d )
+                        f[d] += m( j ) * ( x( j, d ) - x( i, d ) );
+                }
+                for ( int d = 0; d < 3; ++d )
+                    v( i, d ) += dt * f[d];
+            } );
+        Kokkos::fence();
+        timers.neighbor.stop( pid );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Kokkos::View layouts. LayoutRight keeps the members of a particle together
+// (AoS) and LayoutLeft keeps each member of all particles together (SoA).
+template <class Device, class Layout, class IdView, class OffsetView,
+          class OutView>
+void viewTest( std::ostream& stream, const std::string& name,
+               const std::vector<int>& problem_sizes, const int num_run,
+               const double peak_bandwidth, const IdView& gather_ids,
+               const OffsetView& neighbor_offsets, const OutView& out )
+{
+    using execution_space = typename Device::execution_space;
+    int num_problem_size = problem_sizes.size();
+    PatternTimers timers( name, num_problem_size, peak_bandwidth );
+    for ( int p = 0; p < num_problem_size; ++p )
+    {
+        timers.setWork( p, problem_sizes[p] );
+        Kokkos::View<double* [7], Layout, Device> data( "data",
+                                                        problem_sizes[p] );
+        Kokkos::deep_copy( data, 1.0 );
+        auto x = Kokkos::subview( data, Kokkos::ALL(),
+                                  Kokkos::pair<int, int>( 0, 3 ) );
+        auto v = Kokkos::subview( data, Kokkos::ALL(),
+                                  Kokkos::pair<int, int>( 3, 6 ) );
+        auto m = Kokkos::subview( data, Kokkos::ALL(), 6 );
+        runPatterns<execution_space>( timers, p, num_run, problem_sizes[p], x,
+                                      v, m, gather_ids, neighbor_offsets,
+                                      out );
+    }
+    timers.output( stream, problem_sizes );
+}
+
+//---------------------------------------------------------------------------//
+// AoSoA layout with a given vector length. The stream pattern is also run
+// with a SIMD policy vectorizing over the inner array of each SoA.
+template <class Device, int VectorLength, class IdView, class OffsetView,
+          class OutView>
+void aosoaTest( std::ostream& stream, const std::string& test_prefix,
+                const std::vector<int>& problem_sizes, const int num_run,
+                const double peak_bandwidth, const IdView& gather_ids,
+                const OffsetView& neighbor_offsets, const OutView& out )
+{
+    using execution_space = typename Device::execution_space;
+    using member_types = Cabana::MemberTypes<double[3], double[3], double>;
+    using aosoa_type = Cabana::AoSoA<member_types, Device, VectorLength>;
+
+    std::stringstream name;
+    name << test_prefix << "aosoa_" << VectorLength;
+    int num_problem_size = problem_sizes.size();
+    PatternTimers timers( name.str(), num_problem_size, peak_bandwidth );
+    Cabana::Benchmark::Timer simd_timer( name.str() + "_stream_simd",
+                                         num_problem_size, "bytes" );
+    simd_timer.setPeakRate( peak_bandwidth );
+    for ( int p = 0; p < num_problem_size; ++p )
+    {
+        timers.setWork( p, problem_sizes[p] );
+        simd_timer.setWork( p, stream_bytes * problem_sizes[p] );
+        simd_timer.setRoofline( p, stream_flops * problem_sizes[p],
+                                stream_bytes * problem_sizes[p] );
+        aosoa_type aosoa( "aosoa", problem_sizes[p] );
+        auto x = Cabana::slice<0>( aosoa );
+        auto v = Cabana::slice<1>( aosoa );
+        auto m = Cabana::slice<2>( aosoa );
+        Cabana::deep_copy( x, 1.0 );
+        Cabana::deep_copy( v, 1.0 );
+        Cabana::deep_copy( m, 1.0 );
+        runPatterns<execution_space>( timers, p, num_run, problem_sizes[p], x,
+                                      v, m, gather_ids, neighbor_offsets,
+                                      out );
+
+        Cabana::SimdPolicy<VectorLength, execution_space> simd_policy(
+            0, problem_sizes[p] );
+        const double dt = 1.0e-3;
+        for ( int t = 0; t < num_run; ++t )
+        {
+            simd_timer.start( p );
+            Cabana::simd_parallel_for(
+                simd_policy,
+                KOKKOS_LAMBDA( const int s, const int a ) {
+                    for ( int d = 0; d < 3; ++d )
+                        x.access( s, a, d ) += dt * v.access( s, a, d );
+                },
+                "stream_simd" );
+            Kokkos::fence();
+            simd_timer.stop( p );
+        }
+    }
+    timers.output( stream, problem_sizes );
+    outputResults( stream, "problem_size", problem_sizes, simd_timer );
+}
+
+//---------------------------------------------------------------------------//
+// Sweep the AoSoA vector lengths.
+template <class Device, int... VectorLengths, class IdView, class OffsetView,
+          class OutView>
+void aosoaSweep( std::ostream& stream, const std::string& test_prefix,
+                 const std::vector<int>& problem_sizes, const int num_run,
+                 const double peak_bandwidth, const IdView& gather_ids,
+                 const OffsetView& neighbor_offsets, const OutView& out,
+                 std::integer_sequence<int, VectorLengths...> )
+{
+    int expand[] = { 0, ( aosoaTest<Device, VectorLengths>(
+                              stream, test_prefix, problem_sizes, num_run,
+                              peak_bandwidth, gather_ids, neighbor_offsets,
+                              out ),
+                          0 )... };
+    (void)expand;
+}
+
+//---------------------------------------------------------------------------//
+// Performance test.
+template <class Device>
+void performanceTest( std::ostream& stream, const std::string& test_prefix )
+{
+    // Declare problem sizes.
+    std::vector<int> problem_sizes = { 10000, 100000, 1000000, 10000000 };
+    int max_size = problem_sizes.back();
+
+    // Number of runs in the test loops.
+    int num_run = 10;
+
+    // Generate the random gather indices and the neighbor offsets.
+    Kokkos::View<int*, Kokkos::HostSpace> host_ids(
+        Kokkos::ViewAllocateWithoutInitializing( "host_ids" ), max_size );
+    Kokkos::View<int**, Kokkos::HostSpace> host_offsets(
+        Kokkos::ViewAllocateWithoutInitializing( "host_offsets" ), max_size,
+        num_neighbor );
+    std::minstd_rand0 generator( 3439203991 );
+    std::uniform_int_distribution<int> id_dist( 0, max_size - 1 );
+    std::uniform_int_distribution<int> offset_dist( -neighbor_window,
+                                                    neighbor_window );
+    for ( int i = 0; i < max_size; ++i )
+    {
+        host_ids( i ) = id_dist( generator );
+        for ( int n = 0; n < num_neighbor; ++n )
+            host_offsets( i, n ) = offset_dist( generator );
+    }
+    auto gather_ids =
+        Kokkos::create_mirror_view_and_copy( Device(), host_ids );
+    auto neighbor_offsets =
+        Kokkos::create_mirror_view_and_copy( Device(), host_offsets );
+    Kokkos::View<double*, Device> out( "out", max_size );
+
+    // Peak memory bandwidth.
+    double peak_bandwidth = Cabana::Benchmark::streamBandwidth<Device>();
+
+    // Compare the Kokkos::View layouts and the AoSoA vector lengths.
+    viewTest<Device, Kokkos::LayoutRight>(
+        stream, test_prefix + "aos", problem_sizes, num_run, peak_bandwidth,
+        gather_ids, neighbor_offsets, out );
+    viewTest<Device, Kokkos::LayoutLeft>(
+        stream, test_prefix + "soa", problem_sizes, num_run, peak_bandwidth,
+        gather_ids, neighbor_offsets, out );
+    aosoaSweep<Device>( stream, test_prefix, problem_sizes, num_run,
+                        peak_bandwidth, gather_ids, neighbor_offsets, out,
+                        std::integer_sequence<int, 1, 2, 4, 8, 16, 32, 64,
+                                              128, 256>() );
+}
+
+//---------------------------------------------------------------------------//
+// main
+int main( int argc, char* argv[] )
+{
+    // Initialize environment
+    Kokkos::initialize( argc, argv );
+
+    // Check arguments.
+    if ( argc < 2 )
+        throw std::runtime_error( "Incorrect number of arguments. \n \
+             First argument - file name for output (.json or .csv for \n \
+             machine-readable output) \n \
+             \n \
+             Example: \n \
+             $/: ./LayoutPerformance test_results.txt\n" );
+
+    // Get the name of the output file.
+    std::string filename = argv[1];
+    Cabana::Benchmark::setOutputFormat( filename );
+
+    // Open the output file on rank 0.
+    std::fstream file;
+    file.open( filename, std::fstream::out );
+    Cabana::Benchmark::outputMetadata( file, "LayoutPerformance" );
+
+    // Run the tests.
+#ifdef KOKKOS_ENABLE_SERIAL
+    using SerialDevice = Kokkos::Device<Kokkos::Serial, Kokkos::HostSpace>;
+    performanceTest<SerialDevice>( file, "serial_" );
+#endif
+
+#ifdef KOKKOS_ENABLE_OPENMP
+    using OpenMPDevice = Kokkos::Device<Kokkos::OpenMP, Kokkos::HostSpace>;
+    performanceTest<OpenMPDevice>( file, "openmp_" );
+#endif
+
+#ifdef KOKKOS_ENABLE_CUDA
+    using CudaDevice = Kokkos::Device<Kokkos::Cuda, Kokkos::CudaSpace>;
+    performanceTest<CudaDevice>( file, "cuda_" );
+#endif
+
+    // Close the output file on rank 0.
+    file.close();
+
+    // Finalize
+    Kokkos::finalize();
+    return 0;
+}
+
+//---------------------------------------------------------------------------//
@@ -64,6 +64,11 @@ void performanceTest( std::ostream& stream, const std::string& test_prefix )
         Cabana::deep_copy( aosoas[p], create_aosoa );
     }
 
+    // Bytes read and written per particle by the sort and the peak memory
+    // bandwidth.
+    double particle_bytes = 2.0 * 3 * sizeof( double );
+    double peak_bandwidth = Cabana::Benchmark::streamBandwidth<Device>();
+
     // Loop over number of ratios (neighbors per particle).
     for ( int c = 0; c < cutoff_ratios_size; ++c )
     {
@@ -74,11 +79,12 @@ void performanceTest( std::ostream& stream, const std::string& test_prefix )
         create_time_name << test_prefix << "linkedcell_create_"
                          << cutoff_ratios[c];
         Cabana::Benchmark::Timer create_timer( create_time_name.str(),
-                                               num_problem_size );
+                                               num_problem_size, "particles" );
         std::stringstream sort_time_name;
         sort_time_name << test_prefix << "linkedcell_sort_" << cutoff_ratios[c];
         Cabana::Benchmark::Timer sort_timer( sort_time_name.str(),
-                                             num_problem_size );
+                                             num_problem_size, "bytes" );
+        sort_timer.setPeakRate( peak_bandwidth );
 
         // Loop over the problem sizes.
         std::vector<int> psizes;
@@ -90,6 +96,8 @@ void performanceTest( std::ostream& stream, const std::string& test_prefix )
 
             // Track the problem size.
             psizes.push_back( problem_sizes[p] );
+            create_timer.setWork( p, num_p );
+            sort_timer.setWork( p, particle_bytes * num_p );
 
             // Create the linked cell list.
             auto x = Cabana::slice<0>( aosoas[p], "position" );
@@ -131,17 +139,20 @@ int main( int argc, char* argv[] )
     // Check arguments.
     if ( argc < 2 )
         throw std::runtime_error( "Incorrect number of arguments. \n \
-             First argument -  file name for output \n \
+             First argument - file name for output (.json or .csv for \n \
+             machine-readable output) \n \
              \n \
              Example: \n \
              $/: ./LinkedCellPerformance test_results.txt\n" );
 
     // Get the name of the output file.
     std::string filename = argv[1];
+    Cabana::Benchmark::setOutputFormat( filename );
 
     // Open the output file on rank 0.
     std::fstream file;
     file.open( filename, std::fstream::out );
+    Cabana::Benchmark::outputMetadata( file, "LinkedCellPerformance" );
 
     // Run the tests.
 #ifdef KOKKOS_ENABLE_SERIAL
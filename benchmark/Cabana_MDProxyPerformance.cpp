@@ -0,0 +1,579 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "Cabana_BenchmarkUtils.hpp"
+
+#include <Cabana_Core.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <mpi.h>
+
+//---------------------------------------------------------------------------//
+// Lennard-Jones molecular dynamics proxy. Every timestep runs the phases of
+// a production MD code on an AoSoA:
+//
+//   initial integrate -> rebuild check -> (migrate -> halo create -> Verlet
+//   build) or halo gather -> forces -> halo scatter -> final integrate
+//
+// The domain is periodic and decomposed over a 3D Cartesian rank grid. Each
+// rank owns a cube [0,L)^3 in its own frame. Ghosts are communicated one
+// dimension at a time such that edge and corner ghosts are forwarded by the
+// later dimensions, and forces on ghosts are scattered back to their owners
+// using Newton's third law with a half neighbor list.
+//---------------------------------------------------------------------------//
+
+// Particle fields.
+enum ParticleFields
+{
+    Position = 0,
+    Velocity = 1,
+    Force = 2,
+    ReferencePosition = 3
+};
+
+//---------------------------------------------------------------------------//
+// Wrap migrating positions into the frame of their destination rank as they
+// are packed.
+struct PeriodicShift
+{
+    double box_length;
+
+    template <class Tuple>
+    KOKKOS_INLINE_FUNCTION void operator()( const std::size_t,
+                                            Tuple& tpl ) const
+    {
+        for ( int d = 0; d < 3; ++d )
+        {
+            double& x = Cabana::get<Position>( tpl, d );
+            if ( x < 0.0 )
+                x += box_length;
+            else if ( x >= box_length )
+                x -= box_length;
+        }
+    }
+};
+
+//---------------------------------------------------------------------------//
+// Performance test.
+template <class Device>
+void performanceTest( std::ostream& stream, const int cells_per_rank,
+                      const int num_step, const std::string& test_prefix )
+{
+    using exec_space = typename Device::execution_space;
+    using memory_space = typename Device::memory_space;
+
+    // LJ parameters in reduced units for the liquid state used by the
+    // standard LJ benchmarks.
+    const double density = 0.8442;
+    const double temperature = 1.44;
+    const double cutoff = 2.5;
+    const double skin = 0.3;
+    const double dt = 0.005;
+    const double neighbor_radius = cutoff + skin;
+    const double cutoff_sqr = cutoff * cutoff;
+
+    // Each rank owns a cube of FCC unit cells.
+    const double lattice = std::pow( 4.0 / density, 1.0 / 3.0 );
+    const double box = cells_per_rank * lattice;
+    if ( box <= 2.0 * neighbor_radius )
+        throw std::runtime_error(
+            "Rank subdomain must be larger than twice the neighbor radius" );
+
+    // Partition the domain in 3 dimensions with periodic boundaries.
+    int comm_size;
+    MPI_Comm_size( MPI_COMM_WORLD, &comm_size );
+    std::vector<int> ranks_per_dim( 3, 0 );
+    MPI_Dims_create( comm_size, 3, ranks_per_dim.data() );
+    std::vector<int> periodic_dims( 3, 1 );
+    MPI_Comm cart_comm;
+    MPI_Cart_create( MPI_COMM_WORLD, 3, ranks_per_dim.data(),
+                     periodic_dims.data(), 1, &cart_comm );
+    int linear_rank;
+    MPI_Comm_rank( cart_comm, &linear_rank );
+    std::vector<int> cart_rank( 3 );
+    MPI_Cart_coords( cart_comm, linear_rank, 3, cart_rank.data() );
+
+    // Compute the rank of each of the 27 neighboring subdomains, indexed by
+    // the offset ( i + 1 ) + 3 * ( j + 1 ) + 9 * ( k + 1 ).
+    Kokkos::View<int[27], Kokkos::HostSpace> neighbor_ranks_host(
+        "neighbor_ranks" );
+    for ( int k = -1; k < 2; ++k )
+        for ( int j = -1; j < 2; ++j )
+            for ( int i = -1; i < 2; ++i )
+            {
+                std::vector<int> ncr = { cart_rank[0] + i, cart_rank[1] + j,
+                                         cart_rank[2] + k };
+                MPI_Cart_rank( cart_comm, ncr.data(),
+                               &neighbor_ranks_host( ( i + 1 ) + 3 * ( j + 1 ) +
+                                                     9 * ( k + 1 ) ) );
+            }
+    auto neighbor_ranks = Kokkos::create_mirror_view_and_copy(
+        memory_space(), neighbor_ranks_host );
+    std::vector<int> migrate_topology( neighbor_ranks_host.data(),
+                                       neighbor_ranks_host.data() + 27 );
+    std::sort( migrate_topology.begin(), migrate_topology.end() );
+    migrate_topology.erase(
+        std::unique( migrate_topology.begin(), migrate_topology.end() ),
+        migrate_topology.end() );
+
+    // Lower and upper neighbors in each dimension for the ghost exchange.
+    std::vector<int> rank_lo( 3 );
+    std::vector<int> rank_hi( 3 );
+    std::vector<std::vector<int>> halo_topology( 3 );
+    for ( int d = 0; d < 3; ++d )
+    {
+        MPI_Cart_shift( cart_comm, d, 1, &rank_lo[d], &rank_hi[d] );
+        halo_topology[d] = { linear_rank, rank_lo[d], rank_hi[d] };
+        std::sort( halo_topology[d].begin(), halo_topology[d].end() );
+        halo_topology[d].erase( std::unique( halo_topology[d].begin(),
+                                             halo_topology[d].end() ),
+                                halo_topology[d].end() );
+    }
+
+    // Create the particles on an FCC lattice with random velocities at the
+    // target temperature.
+    using member_types =
+        Cabana::MemberTypes<double[3], double[3], double[3], double[3]>;
+    using aosoa_type = Cabana::AoSoA<member_types, memory_space>;
+    using aosoa_host_type = Cabana::AoSoA<member_types, Kokkos::HostSpace>;
+    const int num_particle = 4 * cells_per_rank * cells_per_rank *
+                             cells_per_rank;
+    aosoa_host_type particles_host( "particles_host", num_particle );
+    auto x_host = Cabana::slice<Position>( particles_host );
+    auto v_host = Cabana::slice<Velocity>( particles_host );
+    const double basis[4][3] = {
+        { 0.0, 0.0, 0.0 }, { 0.5, 0.5, 0.0 }, { 0.5, 0.0, 0.5 },
+        { 0.0, 0.5, 0.5 } };
+    std::minstd_rand0 generator( 3439203991 + linear_rank );
+    std::uniform_real_distribution<double> velocity_dist( -0.5, 0.5 );
+    const double velocity_scale = std::sqrt( 12.0 * temperature );
+    int n = 0;
+    for ( int k = 0; k < cells_per_rank; ++k )
+        for ( int j = 0; j < cells_per_rank; ++j )
+            for ( int i = 0; i < cells_per_rank; ++i )
+                for ( int b = 0; b < 4; ++b, ++n )
+                {
+                    x_host( n, 0 ) = ( i + basis[b][0] ) * lattice;
+                    x_host( n, 1 ) = ( j + basis[b][1] ) * lattice;
+                    x_host( n, 2 ) = ( k + basis[b][2] ) * lattice;
+                    for ( int d = 0; d < 3; ++d )
+                        v_host( n, d ) =
+                            velocity_scale * velocity_dist( generator );
+                }
+    aosoa_type particles( "particles", num_particle );
+    Cabana::deep_copy( particles, particles_host );
+
+    // Create the phase timers. Each phase is sampled on every step it runs.
+    auto create_timer = [&]( const std::string& name ) {
+        return Cabana::Benchmark::Timer( test_prefix + name, 1 );
+    };
+    Cabana::Benchmark::Timer step_timer( test_prefix + "md_timestep", 1,
+                                         "particle_steps" );
+    step_timer.setWork( 0, num_particle );
+    auto initial_integrate_timer = create_timer( "md_initial_integrate" );
+    auto rebuild_check_timer = create_timer( "md_rebuild_check" );
+    auto migrate_timer = create_timer( "md_migrate" );
+    auto halo_create_timer = create_timer( "md_halo_create" );
+    auto neighbor_timer = create_timer( "md_neighbor_build" );
+    auto gather_timer = create_timer( "md_halo_gather" );
+    auto force_timer = create_timer( "md_force" );
+    auto scatter_timer = create_timer( "md_halo_scatter" );
+    auto final_integrate_timer = create_timer( "md_final_integrate" );
+
+    // Communication plans and the neighbor list persist between rebuilds.
+    using halo_type = Cabana::Halo<memory_space>;
+    std::vector<halo_type> halos;
+    using list_type =
+        Cabana::VerletList<memory_space, Cabana::HalfNeighborTag,
+                           Cabana::VerletLayout2D, Cabana::TeamVectorOpTag>;
+    list_type nlist;
+    int num_local = num_particle;
+    int num_rebuild = 0;
+
+    // Shift the ghosts received in a dimension into the local frame. Ghosts
+    // in the upper half of the box came from the lower neighbor.
+    auto shift_ghosts = [&]( const halo_type& halo, const int d ) {
+        auto x = Cabana::slice<Position>( particles );
+        Kokkos::parallel_for(
+            "md_proxy::shift_ghosts",
+            Kokkos::RangePolicy<exec_space>(
+                halo.numLocal(), halo.numLocal() + halo.numGhost() ),
+            KOKKOS_LAMBDA( const int i ) {
+                x( i, d ) += ( x( i, d ) > 0.5 * box ) ? -box : box;
+            } );
+    };
+
+    // Gather the ghost positions one dimension at a time.
+    auto gather_positions = [&]( const halo_type& halo, const int d ) {
+        particles.resize( halo.numLocal() + halo.numGhost() );
+        auto x = Cabana::slice<Position>( particles );
+        Cabana::gather( halo, x );
+        shift_ghosts( halo, d );
+    };
+
+    // Export views for the ghost exchange.
+    Kokkos::View<int*, memory_space> export_ids( "export_ids", 0 );
+    Kokkos::View<int*, memory_space> export_ranks( "export_ranks", 0 );
+    Kokkos::View<int, memory_space> num_export( "num_export" );
+
+    // Half of the force computation before the first step.
+    bool rebuild = true;
+
+    for ( int step = 0; step <= num_step; ++step )
+    {
+        step_timer.start( 0 );
+
+        // INITIAL INTEGRATE
+        // -----------------
+        // Half kick and drift of the owned particles. The zeroth step only
+        // computes the initial forces.
+        if ( step > 0 )
+        {
+            initial_integrate_timer.start( 0 );
+            auto x = Cabana::slice<Position>( particles );
+            auto v = Cabana::slice<Velocity>( particles );
+            auto f = Cabana::slice<Force>( particles );
+            Kokkos::parallel_for(
+                "md_proxy::initial_integrate",
+                Kokkos::RangePolicy<exec_space>( 0, num_local ),
+                KOKKOS_LAMBDA( const int i ) {
+                    for ( int d = 0; d < 3; ++d )
+                    {
+                        v( i, d ) += 0.5 * dt * f( i, d );
+                        x( i, d ) += dt * v( i, d );
+                    }
+                } );
+            Kokkos::fence();
+            initial_integrate_timer.stop( 0 );
+
+            // Rebuild once any particle moved more than half the skin since
+            // the last rebuild.
+            rebuild_check_timer.start( 0 );
+            auto x0 = Cabana::slice<ReferencePosition>( particles );
+            double max_dist_sqr = 0.0;
+            Kokkos::parallel_reduce(
+                "md_proxy::max_displacement",
+                Kokkos::RangePolicy<exec_space>( 0, num_local ),
+                KOKKOS_LAMBDA( const int i, double& result ) {
+                    double dist_sqr = 0.0;
+                    for ( int d = 0; d < 3; ++d )
+                        dist_sqr += ( x( i, d ) - x0( i, d ) ) *
+                                    ( x( i, d ) - x0( i, d ) );
+                    if ( dist_sqr > result )
+                        result = dist_sqr;
+                },
+                Kokkos::Max<double>( max_dist_sqr ) );
+            MPI_Allreduce( MPI_IN_PLACE, &max_dist_sqr, 1, MPI_DOUBLE,
+                           MPI_MAX, cart_comm );
+            rebuild = ( 4.0 * max_dist_sqr > skin * skin );
+            rebuild_check_timer.stop( 0 );
+        }
+
+        if ( rebuild )
+        {
+            ++num_rebuild;
+
+            // MIGRATE
+            // -------
+            // Send every owned particle that left the subdomain to the
+            // subdomain it moved into, shifting it into the frame of that
+            // subdomain as it is packed.
+            migrate_timer.start( 0 );
+            particles.resize( num_local );
+            Kokkos::View<int*, memory_space> destinations(
+                Kokkos::ViewAllocateWithoutInitializing( "destinations" ),
+                num_local );
+            auto x = Cabana::slice<Position>( particles );
+            Kokkos::parallel_for(
+                "md_proxy::destinations",
+                Kokkos::RangePolicy<exec_space>( 0, num_local ),
+                KOKKOS_LAMBDA( const int i ) {
+                    int offset[3];
+                    for ( int d = 0; d < 3; ++d )
+                        offset[d] = ( x( i, d ) < 0.0 )
+                                        ? 0
+                                        : ( ( x( i, d ) >= box ) ? 2 : 1 );
+                    destinations( i ) = neighbor_ranks(
+                        offset[0] + 3 * offset[1] + 9 * offset[2] );
+                } );
+            Cabana::Distributor<memory_space> distributor(
+                cart_comm, destinations, migrate_topology );
+            Cabana::migrate( distributor, particles, PeriodicShift{ box } );
+            num_local = particles.size();
+            Kokkos::fence();
+            migrate_timer.stop( 0 );
+
+            // HALO CREATE
+            // -----------
+            // Ghost every particle within the neighbor radius of a face,
+            // including the ghosts of previous dimensions.
+            halo_create_timer.start( 0 );
+            halos.clear();
+            for ( int d = 0; d < 3; ++d )
+            {
+                int num_candidate = particles.size();
+                if ( export_ids.extent( 0 ) <
+                     static_cast<std::size_t>( 2 * num_candidate ) )
+                {
+                    Kokkos::realloc( export_ids, 2 * num_candidate );
+                    Kokkos::realloc( export_ranks, 2 * num_candidate );
+                }
+                Kokkos::deep_copy( num_export, 0 );
+                auto xd = Cabana::slice<Position>( particles );
+                auto ids = export_ids;
+                auto ranks = export_ranks;
+                auto count = num_export;
+                int lo = rank_lo[d];
+                int hi = rank_hi[d];
+                Kokkos::parallel_for(
+                    "md_proxy::halo_exports",
+                    Kokkos::RangePolicy<exec_space>( 0, num_candidate ),
+                    KOKKOS_LAMBDA( const int i ) {
+                        if ( xd( i, d ) < neighbor_radius )
+                        {
+                            int e = Kokkos::atomic_fetch_add( &count(), 1 );
+                            ids( e ) = i;
+                            ranks( e ) = lo;
+                        }
+                        if ( xd( i, d ) >= box - neighbor_radius )
+                        {
+                            int e = Kokkos::atomic_fetch_add( &count(), 1 );
+                            ids( e ) = i;
+                            ranks( e ) = hi;
+                        }
+                    } );
+                int num_ghost_export = 0;
+                Kokkos::deep_copy( num_ghost_export, num_export );
+                auto export_range = Kokkos::make_pair( 0, num_ghost_export );
+                halos.push_back( halo_type(
+                    cart_comm, num_candidate,
+                    Kokkos::subview( export_ids, export_range ),
+                    Kokkos::subview( export_ranks, export_range ),
+                    halo_topology[d] ) );
+                gather_positions( halos.back(), d );
+            }
+            Kokkos::fence();
+            halo_create_timer.stop( 0 );
+
+            // NEIGHBOR BUILD
+            // --------------
+            // Build the half list of the owned particles with the skin and
+            // save the owned positions to check for the next rebuild.
+            neighbor_timer.start( 0 );
+            double grid_min[3] = { -neighbor_radius, -neighbor_radius,
+                                   -neighbor_radius };
+            double grid_max[3] = { box + neighbor_radius,
+                                   box + neighbor_radius,
+                                   box + neighbor_radius };
+            auto x_all = Cabana::slice<Position>( particles );
+            nlist.build( x_all, 0, num_local, neighbor_radius, 1.0, grid_min,
+                         grid_max );
+            auto x0 = Cabana::slice<ReferencePosition>( particles );
+            Kokkos::parallel_for(
+                "md_proxy::save_positions",
+                Kokkos::RangePolicy<exec_space>( 0, num_local ),
+                KOKKOS_LAMBDA( const int i ) {
+                    for ( int d = 0; d < 3; ++d )
+                        x0( i, d ) = x_all( i, d );
+                } );
+            Kokkos::fence();
+            neighbor_timer.stop( 0 );
+        }
+        else
+        {
+            // HALO GATHER
+            // -----------
+            gather_timer.start( 0 );
+            for ( int d = 0; d < 3; ++d )
+                gather_positions( halos[d], d );
+            Kokkos::fence();
+            gather_timer.stop( 0 );
+        }
+
+        // FORCE
+        // -----
+        // Each pair is stored once so both particles are updated, including
+        // ghosts whose forces are scattered back to their owners.
+        force_timer.start( 0 );
+        auto x = Cabana::slice<Position>( particles );
+        auto f = Cabana::slice<Force>( particles );
+        Cabana::deep_copy( f, 0.0 );
+        auto force_op = KOKKOS_LAMBDA( const int i, const int j )
+        {
+            double dx[3];
+            double r_sqr = 0.0;
+            for ( int d = 0; d < 3; ++d )
+            {
+                dx[d] = x( i, d ) - x( j, d );
+                r_sqr += dx[d] * dx[d];
+            }
+            if ( r_sqr < cutoff_sqr )
+            {
+                double r2i = 1.0 / r_sqr;
+                double r6i = r2i * r2i * r2i;
+                double fpair = 48.0 * r6i * ( r6i - 0.5 ) * r2i;
+                for ( int d = 0; d < 3; ++d )
+                {
+                    Kokkos::atomic_add( &f( i, d ), fpair * dx[d] );
+                    Kokkos::atomic_add( &f( j, d ), -fpair * dx[d] );
+                }
+            }
+        };
+        Cabana::neighbor_parallel_for(
+            Kokkos::RangePolicy<exec_space>( 0, num_local ), force_op, nlist,
+            Cabana::FirstNeighborsTag(), Cabana::SerialOpTag(),
+            "md_proxy::force" );
+        Kokkos::fence();
+        force_timer.stop( 0 );
+
+        // HALO SCATTER
+        // ------------
+        // Sum the ghost forces into their owners in the reverse order of
+        // the gathers so forces on forwarded ghosts reach their owners.
+        scatter_timer.start( 0 );
+        for ( int d = 2; d >= 0; --d )
+        {
+            particles.resize( halos[d].numLocal() + halos[d].numGhost() );
+            auto f_halo = Cabana::slice<Force>( particles );
+            Cabana::scatter( halos[d], f_halo );
+        }
+        Kokkos::fence();
+        scatter_timer.stop( 0 );
+
+        // FINAL INTEGRATE
+        // ---------------
+        if ( step > 0 )
+        {
+            final_integrate_timer.start( 0 );
+            auto v = Cabana::slice<Velocity>( particles );
+            auto f_owned = Cabana::slice<Force>( particles );
+            Kokkos::parallel_for(
+                "md_proxy::final_integrate",
+                Kokkos::RangePolicy<exec_space>( 0, num_local ),
+                KOKKOS_LAMBDA( const int i ) {
+                    for ( int d = 0; d < 3; ++d )
+                        v( i, d ) += 0.5 * dt * f_owned( i, d );
+                } );
+            Kokkos::fence();
+            final_integrate_timer.stop( 0 );
+        }
+
+        step_timer.stop( 0 );
+    }
+
+    // Report the final temperature as a sanity check of the dynamics.
+    auto v = Cabana::slice<Velocity>( particles );
+    double sums[2] = { 0.0, static_cast<double>( num_local ) };
+    Kokkos::parallel_reduce(
+        "md_proxy::kinetic_energy",
+        Kokkos::RangePolicy<exec_space>( 0, num_local ),
+        KOKKOS_LAMBDA( const int i, double& result ) {
+            for ( int d = 0; d < 3; ++d )
+                result += v( i, d ) * v( i, d );
+        },
+        sums[0] );
+    MPI_Allreduce( MPI_IN_PLACE, sums, 2, MPI_DOUBLE, MPI_SUM, cart_comm );
+    if ( 0 == linear_rank )
+        std::cout << test_prefix << "md_proxy: " << num_step << " steps, "
+                  << num_rebuild << " rebuilds, final temperature "
+                  << sums[0] / ( 3.0 * sums[1] ) << std::endl;
+
+    // Output results.
+    std::vector<int> particles_per_rank = { num_particle };
+    for ( auto timer :
+          { &step_timer, &initial_integrate_timer, &rebuild_check_timer,
+            &migrate_timer, &halo_create_timer, &neighbor_timer,
+            &gather_timer, &force_timer, &scatter_timer,
+            &final_integrate_timer } )
+        if ( !timer->_data[0].empty() )
+            outputResults( stream, "particles_per_rank", particles_per_rank,
+                           *timer, cart_comm );
+
+    MPI_Comm_free( &cart_comm );
+}
+
+//---------------------------------------------------------------------------//
+// main
+int main( int argc, char* argv[] )
+{
+    // Initialize environment
+    MPI_Init( &argc, &argv );
+    Kokkos::initialize( argc, argv );
+
+    // Check arguments.
+    if ( argc < 4 )
+        throw std::runtime_error( "Incorrect number of arguments. \n \
+             First argument - number of FCC unit cells per rank in each \n \
+             dimension (4 particles per cell, at least 4) \n \
+             Second argument - number of timesteps \n \
+             Third argument - file name for output (.json or .csv for \n \
+             machine-readable output) \n \
+             \n \
+             Example: \n \
+             $/: ./MDProxyPerformance 20 100 test_results.txt\n" );
+
+    // Get the problem size.
+    int cells_per_rank = std::atoi( argv[1] );
+    int num_step = std::atoi( argv[2] );
+
+    // Get the name of the output file.
+    std::string filename = argv[3];
+    Cabana::Benchmark::setOutputFormat( filename );
+
+    // Get comm rank;
+    int comm_rank;
+    MPI_Comm_rank( MPI_COMM_WORLD, &comm_rank );
+
+    // Open the output file on rank 0.
+    std::fstream file;
+    if ( 0 == comm_rank )
+        file.open( filename, std::fstream::out );
+    Cabana::Benchmark::outputMetadata( file, "MDProxyPerformance",
+                                       MPI_COMM_WORLD );
+
+    // Run the tests.
+#ifdef KOKKOS_ENABLE_SERIAL
+    using SerialDevice = Kokkos::Device<Kokkos::Serial, Kokkos::HostSpace>;
+    performanceTest<SerialDevice>( file, cells_per_rank, num_step,
+                                   "serial_" );
+#endif
+
+#ifdef KOKKOS_ENABLE_OPENMP
+    using OpenMPDevice = Kokkos::Device<Kokkos::OpenMP, Kokkos::HostSpace>;
+    performanceTest<OpenMPDevice>( file, cells_per_rank, num_step,
+                                   "openmp_" );
+#endif
+
+#ifdef KOKKOS_ENABLE_CUDA
+    using CudaDevice = Kokkos::Device<Kokkos::Cuda, Kokkos::CudaSpace>;
+    performanceTest<CudaDevice>( file, cells_per_rank, num_step, "cuda_" );
+#endif
+
+    // Close the output file on rank 0.
+    if ( 0 == comm_rank )
+        file.close();
+
+    // Finalize
+    Kokkos::finalize();
+    MPI_Finalize();
+    return 0;
+}
+
+//---------------------------------------------------------------------------//
@@ -98,12 +98,12 @@ void performanceTest( std::ostream& stream, const std::string& test_prefix,
         std::stringstream create_time_name;
         create_time_name << test_prefix << "neigh_create_" << cutoff_ratios[c];
         Cabana::Benchmark::Timer create_timer( create_time_name.str(),
-                                               num_problem_size );
+                                               num_problem_size, "particles" );
         std::stringstream iteration_time_name;
         iteration_time_name << test_prefix << "neigh_iteration_"
                             << cutoff_ratios[c];
-        Cabana::Benchmark::Timer iteration_timer( iteration_time_name.str(),
-                                                  num_problem_size );
+        Cabana::Benchmark::Timer iteration_timer(
+            iteration_time_name.str(), num_problem_size, "pairs" );
 
         // Loop over the problem sizes.
         int pid = 0;
@@ -116,6 +116,7 @@ void performanceTest( std::ostream& stream, const std::string& test_prefix,
 
             // Track the problem size.
             psizes.push_back( problem_sizes[p] );
+            create_timer.setWork( pid, num_p );
 
             // Setup for neighbor iteration.
             Kokkos::View<int*, memory_space> per_particle_result( "result",
@@ -145,6 +146,21 @@ void performanceTest( std::ostream& stream, const std::string& test_prefix,
                                                IterTag(), "test_iteration" );
                 Kokkos::fence();
                 iteration_timer.stop( pid );
+
+                // Count the neighbor pairs once per system.
+                if ( t == 0 )
+                {
+                    using list_traits =
+                        Cabana::NeighborList<std::decay_t<decltype( nlist )>>;
+                    std::size_t total_neigh = 0;
+                    Kokkos::parallel_reduce(
+                        "Cabana::countSum", policy,
+                        KOKKOS_LAMBDA( const int i, std::size_t& nsum ) {
+                            nsum += list_traits::numNeighbor( nlist, i );
+                        },
+                        total_neigh );
+                    iteration_timer.setWork( pid, total_neigh );
+                }
             }
 
             // Increment the problem id.
@@ -167,17 +183,20 @@ int main( int argc, char* argv[] )
     // Check arguments.
     if ( argc < 2 )
         throw std::runtime_error( "Incorrect number of arguments. \n \
-             First argument -  file name for output \n \
+             First argument - file name for output (.json or .csv for \n \
+             machine-readable output) \n \
              \n \
              Example: \n \
              $/: ./NeighborArborXPerformance test_results.txt\n" );
 
     // Get the name of the output file.
     std::string filename = argv[1];
+    Cabana::Benchmark::setOutputFormat( filename );
 
     // Open the output file on rank 0.
     std::fstream file;
     file.open( filename, std::fstream::out );
+    Cabana::Benchmark::outputMetadata( file, "NeighborArborXPerformance" );
 
     // Run the tests.
 #ifdef KOKKOS_ENABLE_SERIAL
@@ -0,0 +1,484 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "Cabana_BenchmarkUtils.hpp"
+
+#include <Cabana_Core.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+//---------------------------------------------------------------------------//
+// Timers of the neighbor traversal strategies. First neighbor kernels are
+// timed in pairs and second neighbor kernels in triplets per second.
+struct TraversalTimers
+{
+    TraversalTimers( const std::string& name, const int num_data )
+    {
+        for ( std::string op : { "serial", "team", "pair" } )
+        {
+            first_for.emplace_back( name + "_for_" + op, num_data, "pairs" );
+            first_reduce.emplace_back( name + "_reduce_" + op, num_data,
+                                       "pairs" );
+        }
+        for ( std::string op : { "serial", "team", "team_vector" } )
+        {
+            second_for.emplace_back( name + "_for_second_" + op, num_data,
+                                     "triplets" );
+            second_reduce.emplace_back( name + "_reduce_second_" + op,
+                                        num_data, "triplets" );
+        }
+    }
+
+    void setWork( const int pid, const double num_pair,
+                  const double num_triplet )
+    {
+        for ( auto& timer : first_for )
+            timer.setWork( pid, num_pair );
+        for ( auto& timer : first_reduce )
+            timer.setWork( pid, num_pair );
+        for ( auto& timer : second_for )
+            timer.setWork( pid, num_triplet );
+        for ( auto& timer : second_reduce )
+            timer.setWork( pid, num_triplet );
+    }
+
+    void output( std::ostream& stream, const std::vector<int>& psizes,
+                 const bool second )
+    {
+        for ( auto& timer : first_for )
+            outputResults( stream, "problem_size", psizes, timer );
+        for ( auto& timer : first_reduce )
+            outputResults( stream, "problem_size", psizes, timer );
+        if ( !second )
+            return;
+        for ( auto& timer : second_for )
+            outputResults( stream, "problem_size", psizes, timer );
+        for ( auto& timer : second_reduce )
+            outputResults( stream, "problem_size", psizes, timer );
+    }
+
+    std::vector<Cabana::Benchmark::Timer> first_for;
+    std::vector<Cabana::Benchmark::Timer> first_reduce;
+    std::vector<Cabana::Benchmark::Timer> second_for;
+    std::vector<Cabana::Benchmark::Timer> second_reduce;
+};
+
+//---------------------------------------------------------------------------//
+// Time a kernel.
+template <class Kernel>
+void timeKernel( Cabana::Benchmark::Timer& timer, const int pid,
+                 const Kernel& kernel )
+{
+    timer.start( pid );
+    kernel();
+    Kokkos::fence();
+    timer.stop( pid );
+}
+
+//---------------------------------------------------------------------------//
+// Cosine of the angle between the neighbors j and k of particle i.
+template <class PositionSlice>
+KOKKOS_INLINE_FUNCTION double angleCos( const PositionSlice& x, const int i,
+                                        const int j, const int k )
+{
+    double dot = 0.0;
+    double n_ij = 0.0;
+    double n_ik = 0.0;
+    for ( int d = 0; d < 3; ++d )
+    {
+        double r_ij = x( j, d ) - x( i, d );
+        double r_ik = x( k, d ) - x( i, d );
+        dot += r_ij * r_ik;
+        n_ij += r_ij * r_ij;
+        n_ik += r_ik * r_ik;
+    }
+    return dot / sqrt( n_ij * n_ik );
+}
+
+//---------------------------------------------------------------------------//
+// Run a Lennard-Jones force and energy kernel over the first neighbors and a
+// three-body angle kernel over the second neighbors with every strategy.
+// Forces are accumulated atomically as concurrent updates of a particle
+// happen with the team and pair strategies and, for half lists, with all
+// strategies. Second neighbor kernels need a full list.
+template <class ExecutionSpace, class ListType, class PositionSlice,
+          class ForceView>
+void runTraversal( TraversalTimers& timers, const int pid, const int num_run,
+                   const ListType& nlist, const PositionSlice& x,
+                   const ForceView& f, const double cutoff, const bool half,
+                   const bool second )
+{
+    Kokkos::RangePolicy<ExecutionSpace> policy( 0, x.size() );
+    const double cutoff_sqr = cutoff * cutoff;
+
+    // Pairs of half lists are stored once and contribute their full energy.
+    const double energy_weight = half ? 1.0 : 0.5;
+
+    auto force_op = KOKKOS_LAMBDA( const int i, const int j )
+    {
+        double dx[3] = { x( i, 0 ) - x( j, 0 ), x( i, 1 ) - x( j, 1 ),
+                         x( i, 2 ) - x( j, 2 ) };
+        double r2 = dx[0] * dx[0] + dx[1] * dx[1] + dx[2] * dx[2];
+        if ( r2 < cutoff_sqr )
+        {
+            double inv_r2 = 1.0 / r2;
+            double inv_r6 = inv_r2 * inv_r2 * inv_r2;
+            double fpair = 24.0 * inv_r6 * ( 2.0 * inv_r6 - 1.0 ) * inv_r2;
+            for ( int d = 0; d < 3; ++d )
+            {
+                Kokkos::atomic_add( &f( i, d ), fpair * dx[d] );
+                if ( half )
+                    Kokkos::atomic_add( &f( j, d ), -fpair * dx[d] );
+            }
+        }
+    };
+    auto energy_op = KOKKOS_LAMBDA( const int i, const int j, double& energy )
+    {
+        double r2 = 0.0;
+        for ( int d = 0; d < 3; ++d )
+            r2 += ( x( i, d ) - x( j, d ) ) * ( x( i, d ) - x( j, d ) );
+        if ( r2 < cutoff_sqr )
+        {
+            double inv_r6 = 1.0 / ( r2 * r2 * r2 );
+            energy += energy_weight * 4.0 * inv_r6 * ( inv_r6 - 1.0 );
+        }
+    };
+    auto angle_op = KOKKOS_LAMBDA( const int i, const int j, const int k )
+    {
+        Kokkos::atomic_add( &f( i, 0 ), angleCos( x, i, j, k ) );
+    };
+    auto angle_energy_op =
+        KOKKOS_LAMBDA( const int i, const int j, const int k, double& energy )
+    {
+        double c = angleCos( x, i, j, k );
+        energy += c * c;
+    };
+
+    Cabana::FirstNeighborsTag first_tag;
+    Cabana::SecondNeighborsTag second_tag;
+    for ( int t = 0; t < num_run; ++t )
+    {
+        double energy = 0.0;
+
+        timeKernel( timers.first_for[0], pid, [&]() {
+            Cabana::neighbor_parallel_for( policy, force_op, nlist, first_tag,
+                                           Cabana::SerialOpTag(), "for" );
+        } );
+        timeKernel( timers.first_for[1], pid, [&]() {
+            Cabana::neighbor_parallel_for( policy, force_op, nlist, first_tag,
+                                           Cabana::TeamOpTag(), "for" );
+        } );
+        timeKernel( timers.first_for[2], pid, [&]() {
+            Cabana::neighbor_parallel_for( policy, force_op, nlist, first_tag,
+                                           Cabana::PairOpTag(), "for" );
+        } );
+
+        timeKernel( timers.first_reduce[0], pid, [&]() {
+            Cabana::neighbor_parallel_reduce( policy, energy_op, nlist,
+                                              first_tag, Cabana::SerialOpTag(),
+                                              energy, "reduce" );
+        } );
+        timeKernel( timers.first_reduce[1], pid, [&]() {
+            Cabana::neighbor_parallel_reduce( policy, energy_op, nlist,
+                                              first_tag, Cabana::TeamOpTag(),
+                                              energy, "reduce" );
+        } );
+        timeKernel( timers.first_reduce[2], pid, [&]() {
+            Cabana::neighbor_parallel_reduce( policy, energy_op, nlist,
+                                              first_tag, Cabana::PairOpTag(),
+                                              energy, "reduce" );
+        } );
+
+        if ( !second )
+            continue;
+
+        timeKernel( timers.second_for[0], pid, [&]() {
+            Cabana::neighbor_parallel_for( policy, angle_op, nlist,
+                                           second_tag, Cabana::SerialOpTag(),
+                                           "for_second" );
+        } );
+        timeKernel( timers.second_for[1], pid, [&]() {
+            Cabana::neighbor_parallel_for( policy, angle_op, nlist,
+                                           second_tag, Cabana::TeamOpTag(),
+                                           "for_second" );
+        } );
+        timeKernel( timers.second_for[2], pid, [&]() {
+            Cabana::neighbor_parallel_for( policy, angle_op, nlist,
+                                           second_tag,
+                                           Cabana::TeamVectorOpTag(),
+                                           "for_second" );
+        } );
+
+        timeKernel( timers.second_reduce[0], pid, [&]() {
+            Cabana::neighbor_parallel_reduce(
+                policy, angle_energy_op, nlist, second_tag,
+                Cabana::SerialOpTag(), energy, "reduce_second" );
+        } );
+        timeKernel( timers.second_reduce[1], pid, [&]() {
+            Cabana::neighbor_parallel_reduce(
+                policy, angle_energy_op, nlist, second_tag,
+                Cabana::TeamOpTag(), energy, "reduce_second" );
+        } );
+        timeKernel( timers.second_reduce[2], pid, [&]() {
+            Cabana::neighbor_parallel_reduce(
+                policy, angle_energy_op, nlist, second_tag,
+                Cabana::TeamVectorOpTag(), energy, "reduce_second" );
+        } );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Count the stored pairs and the second neighbor triplets of a list.
+template <class ExecutionSpace, class ListType>
+void countWork( const ListType& nlist, const int num_p, double& num_pair,
+                double& num_triplet )
+{
+    using list_traits = Cabana::NeighborList<ListType>;
+    Kokkos::RangePolicy<ExecutionSpace> policy( 0, num_p );
+    num_pair = 0.0;
+    Kokkos::parallel_reduce(
+        "Cabana::countPairs", policy,
+        KOKKOS_LAMBDA( const int i, double& sum ) {
+            sum += list_traits::numNeighbor( nlist, i );
+        },
+        num_pair );
+    num_triplet = 0.0;
+    Kokkos::parallel_reduce(
+        "Cabana::countTriplets", policy,
+        KOKKOS_LAMBDA( const int i, double& sum ) {
+            double nn = list_traits::numNeighbor( nlist, i );
+            sum += 0.5 * nn * ( nn - 1.0 );
+        },
+        num_triplet );
+    Kokkos::fence();
+}
+
+//---------------------------------------------------------------------------//
+// Traverse the lists of one layout over all densities and problem sizes. The
+// list is built with make_list( positions, num_p, cutoff, grid_min,
+// grid_max ).
+template <class Device, class AoSoA, class MakeList>
+void layoutTest( std::ostream& stream, const std::string& name,
+                 std::vector<AoSoA>& aosoas,
+                 const std::vector<int>& problem_sizes,
+                 const std::vector<double>& x_max,
+                 const std::vector<double>& cutoff_ratios,
+                 const double min_dist, const int num_run, const bool half,
+                 const MakeList& make_list )
+{
+    using exec_space = typename Device::execution_space;
+    using memory_space = typename Device::memory_space;
+
+    int num_problem_size = problem_sizes.size();
+    int cutoff_ratios_size = cutoff_ratios.size();
+    for ( int c = 0; c < cutoff_ratios_size; ++c )
+    {
+        // Second neighbor kernels scale with the square of the neighbor
+        // count and are only run at the lowest density.
+        bool second = !half && ( 0 == c );
+
+        std::stringstream timer_name;
+        timer_name << name << "_" << cutoff_ratios[c];
+        TraversalTimers timers( timer_name.str(), num_problem_size );
+
+        for ( int p = 0; p < num_problem_size; ++p )
+        {
+            int num_p = problem_sizes[p];
+            std::cout << "Running " << timer_name.str() << " for " << num_p
+                      << " total particles" << std::endl;
+
+            double grid_min[3] = { 0.0, 0.0, 0.0 };
+            double grid_max[3] = { x_max[p], x_max[p], x_max[p] };
+            double cutoff = cutoff_ratios[c] * min_dist;
+            auto x = Cabana::slice<0>( aosoas[p], "position" );
+            auto nlist = make_list( x, num_p, cutoff, grid_min, grid_max );
+
+            double num_pair = 0.0;
+            double num_triplet = 0.0;
+            countWork<exec_space>( nlist, num_p, num_pair, num_triplet );
+            timers.setWork( p, num_pair, num_triplet );
+            std::cout << "List avg neighbors: " << num_pair / num_p
+                      << std::endl;
+
+            Kokkos::View<double* [3], memory_space> f( "forces", num_p );
+            runTraversal<exec_space>( timers, p, num_run, nlist, x, f, cutoff,
+                                      half, second );
+        }
+
+        timers.output( stream, problem_sizes, second );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Performance test.
+template <class Device>
+void performanceTest( std::ostream& stream, const std::string& test_prefix )
+{
+    using memory_space = typename Device::memory_space;
+
+    // Declare problem sizes.
+    double min_dist = 1.0;
+    std::vector<int> problem_sizes = { 1000, 10000, 100000, 1000000 };
+    int num_problem_size = problem_sizes.size();
+    std::vector<double> x_max( num_problem_size );
+
+    // Declare the cutoff ratios. The number of neighbors per particle, and
+    // therefore the density of particles within the cutoff, grows with the
+    // cube of the ratio.
+    std::vector<double> cutoff_ratios = { 2.0, 3.0, 4.0 };
+
+    // Number of runs in the test loops.
+    int num_run = 10;
+
+    // Create the particles sorted for spatial locality as in a simulation.
+    using member_types = Cabana::MemberTypes<double[3]>;
+    using aosoa_type = Cabana::AoSoA<member_types, Device>;
+    using aosoa_host_type = Cabana::AoSoA<member_types, Kokkos::HostSpace>;
+    std::vector<aosoa_type> aosoas( num_problem_size );
+    for ( int p = 0; p < num_problem_size; ++p )
+    {
+        int num_p = problem_sizes[p];
+        aosoa_host_type create_aosoa( "host_aosoa", num_p );
+        x_max[p] = 1.3 * min_dist * std::pow( num_p, 1.0 / 3.0 );
+        aosoas[p].resize( num_p );
+        auto x_host = Cabana::slice<0>( create_aosoa, "position" );
+        Cabana::Benchmark::createParticles( x_host, 0.0, x_max[p], min_dist );
+        Cabana::deep_copy( aosoas[p], create_aosoa );
+
+        double cutoff = cutoff_ratios.front() * min_dist;
+        double sort_delta[3] = { cutoff, cutoff, cutoff };
+        double grid_min[3] = { 0.0, 0.0, 0.0 };
+        double grid_max[3] = { x_max[p], x_max[p], x_max[p] };
+        auto x = Cabana::slice<0>( aosoas[p], "position" );
+        Cabana::LinkedCellList<Device> linked_cell_list( x, sort_delta,
+                                                         grid_min, grid_max );
+        Cabana::permute( linked_cell_list, aosoas[p] );
+    }
+
+    // Verlet lists.
+    auto make_verlet = [&]( auto list_tag, auto layout_tag ) {
+        using list_tag_type = decltype( list_tag );
+        using layout_tag_type = decltype( layout_tag );
+        return []( const auto& x, const int num_p, const double cutoff,
+                   const double* grid_min, const double* grid_max ) {
+            using build_tag = Cabana::TeamVectorOpTag;
+            return Cabana::VerletList<memory_space, list_tag_type,
+                                      layout_tag_type, build_tag>(
+                x, 0, num_p, cutoff, 1.0, grid_min, grid_max );
+        };
+    };
+    layoutTest<Device>(
+        stream, test_prefix + "verlet_csr_full", aosoas, problem_sizes, x_max,
+        cutoff_ratios, min_dist, num_run, false,
+        make_verlet( Cabana::FullNeighborTag(), Cabana::VerletLayoutCSR() ) );
+    layoutTest<Device>(
+        stream, test_prefix + "verlet_csr_half", aosoas, problem_sizes, x_max,
+        cutoff_ratios, min_dist, num_run, true,
+        make_verlet( Cabana::HalfNeighborTag(), Cabana::VerletLayoutCSR() ) );
+    layoutTest<Device>(
+        stream, test_prefix + "verlet_2d_full", aosoas, problem_sizes, x_max,
+        cutoff_ratios, min_dist, num_run, false,
+        make_verlet( Cabana::FullNeighborTag(), Cabana::VerletLayout2D() ) );
+    layoutTest<Device>(
+        stream, test_prefix + "verlet_2d_half", aosoas, problem_sizes, x_max,
+        cutoff_ratios, min_dist, num_run, true,
+        make_verlet( Cabana::HalfNeighborTag(), Cabana::VerletLayout2D() ) );
+
+#ifdef Cabana_ENABLE_ARBORX
+    // ArborX CrsGraph and dense lists.
+    auto make_arborx_crs = [&]( auto list_tag ) {
+        return [=]( const auto& x, const int num_p, const double cutoff,
+                    const double*, const double* ) {
+            return Cabana::Experimental::makeNeighborList<Device>(
+                list_tag, x, 0, num_p, cutoff );
+        };
+    };
+    auto make_arborx_dense = [&]( auto list_tag ) {
+        return [=]( const auto& x, const int num_p, const double cutoff,
+                    const double*, const double* ) {
+            return Cabana::Experimental::make2DNeighborList<Device>(
+                list_tag, x, 0, num_p, cutoff );
+        };
+    };
+    layoutTest<Device>( stream, test_prefix + "arborx_crs_full", aosoas,
+                        problem_sizes, x_max, cutoff_ratios, min_dist, num_run,
+                        false, make_arborx_crs( Cabana::FullNeighborTag() ) );
+    layoutTest<Device>( stream, test_prefix + "arborx_crs_half", aosoas,
+                        problem_sizes, x_max, cutoff_ratios, min_dist, num_run,
+                        true, make_arborx_crs( Cabana::HalfNeighborTag() ) );
+    layoutTest<Device>( stream, test_prefix + "arborx_dense_full", aosoas,
+                        problem_sizes, x_max, cutoff_ratios, min_dist, num_run,
+                        false,
+                        make_arborx_dense( Cabana::FullNeighborTag() ) );
+    layoutTest<Device>( stream, test_prefix + "arborx_dense_half", aosoas,
+                        problem_sizes, x_max, cutoff_ratios, min_dist, num_run,
+                        true, make_arborx_dense( Cabana::HalfNeighborTag() ) );
+#endif
+}
+
+//---------------------------------------------------------------------------//
+// main
+int main( int argc, char* argv[] )
+{
+    // Initialize environment
+    Kokkos::initialize( argc, argv );
+
+    // Check arguments.
+    if ( argc < 2 )
+        throw std::runtime_error( "Incorrect number of arguments. \n \
+             First argument - file name for output (.json or .csv for \n \
+             machine-readable output) \n \
+             \n \
+             Example: \n \
+             $/: ./NeighborTraversalPerformance test_results.txt\n" );
+
+    // Get the name of the output file.
+    std::string filename = argv[1];
+    Cabana::Benchmark::setOutputFormat( filename );
+
+    // Open the output file on rank 0.
+    std::fstream file;
+    file.open( filename, std::fstream::out );
+    Cabana::Benchmark::outputMetadata( file, "NeighborTraversalPerformance" );
+
+    // Run the tests.
+#ifdef KOKKOS_ENABLE_SERIAL
+    using SerialDevice = Kokkos::Device<Kokkos::Serial, Kokkos::HostSpace>;
+    performanceTest<SerialDevice>( file, "serial_" );
+#endif
+
+#ifdef KOKKOS_ENABLE_OPENMP
+    using OpenMPDevice = Kokkos::Device<Kokkos::OpenMP, Kokkos::HostSpace>;
+    performanceTest<OpenMPDevice>( file, "openmp_" );
+#endif
+
+#ifdef KOKKOS_ENABLE_CUDA
+    using CudaDevice = Kokkos::Device<Kokkos::Cuda, Kokkos::CudaSpace>;
+    performanceTest<CudaDevice>( file, "cuda_" );
+#endif
+
+    // Close the output file on rank 0.
+    file.close();
+
+    // Finalize
+    Kokkos::finalize();
+    return 0;
+}
+
+//---------------------------------------------------------------------------//
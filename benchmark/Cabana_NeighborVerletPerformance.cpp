@@ -106,13 +106,13 @@ void performanceTest( std::ostream& stream, const std::string& test_prefix,
             std::stringstream create_time_name;
             create_time_name << test_prefix << "neigh_create_"
                              << cutoff_ratios[c0] << "_" << cell_ratios[c1];
-            Cabana::Benchmark::Timer create_timer( create_time_name.str(),
-                                                   num_problem_size );
+            Cabana::Benchmark::Timer create_timer(
+                create_time_name.str(), num_problem_size, "particles" );
             std::stringstream iteration_time_name;
             iteration_time_name << test_prefix << "neigh_iteration_"
                                 << cutoff_ratios[c0] << "_" << cell_ratios[c1];
-            Cabana::Benchmark::Timer iteration_timer( iteration_time_name.str(),
-                                                      num_problem_size );
+            Cabana::Benchmark::Timer iteration_timer(
+                iteration_time_name.str(), num_problem_size, "pairs" );
 
             // Loop over the problem sizes.
             int pid = 0;
@@ -126,6 +126,7 @@ void performanceTest( std::ostream& stream, const std::string& test_prefix,
 
                 // Track the problem size.
                 psizes.push_back( problem_sizes[p] );
+                create_timer.setWork( pid, num_p );
 
                 // Setup for Verlet list.
                 double grid_min[3] = { x_min[p], x_min[p], x_min[p] };
@@ -185,6 +186,7 @@ void performanceTest( std::ostream& stream, const std::string& test_prefix,
                             },
                             total_neigh );
                         Kokkos::fence();
+                        iteration_timer.setWork( pid, total_neigh );
                         std::cout
                             << "List avg neighbors: " << total_neigh / num_p
                             << std::endl;
@@ -213,17 +215,20 @@ int main( int argc, char* argv[] )
     // Check arguments.
     if ( argc < 2 )
         throw std::runtime_error( "Incorrect number of arguments. \n \
-             First argument -  file name for output \n \
+             First argument - file name for output (.json or .csv for \n \
+             machine-readable output) \n \
              \n \
              Example: \n \
              $/: ./NeighborVerletPerformance test_results.txt\n" );
 
     // Get the name of the output file.
     std::string filename = argv[1];
+    Cabana::Benchmark::setOutputFormat( filename );
 
     // Open the output file on rank 0.
     std::fstream file;
     file.open( filename, std::fstream::out );
+    Cabana::Benchmark::outputMetadata( file, "NeighborVerletPerformance" );
 
     // Run the tests.
 #ifdef KOKKOS_ENABLE_SERIAL
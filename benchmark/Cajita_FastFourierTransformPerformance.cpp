@@ -0,0 +1,150 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "Cabana_BenchmarkUtils.hpp"
+
+#include <Cajita.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <array>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <mpi.h>
+
+//---------------------------------------------------------------------------//
+// Performance test.
+template <class Device>
+void performanceTest( std::ostream& stream, const std::string& test_prefix )
+{
+    // Global problem sizes to sweep.
+    std::vector<int> cells_per_dim = { 16, 32, 64, 128 };
+    int num_size = cells_per_dim.size();
+
+    // Number of runs in the test loops.
+    int num_run = 10;
+
+    // Create the timers.
+    Cabana::Benchmark::Timer forward_timer( test_prefix + "fft_forward",
+                                            num_size );
+    Cabana::Benchmark::Timer reverse_timer( test_prefix + "fft_reverse",
+                                            num_size );
+
+    std::array<double, 3> global_low_corner = { 0.0, 0.0, 0.0 };
+    std::array<double, 3> global_high_corner = { 1.0, 1.0, 1.0 };
+    std::array<bool, 3> is_dim_periodic = { true, true, true };
+    Cajita::DimBlockPartitioner<3> partitioner;
+
+    for ( int n = 0; n < num_size; ++n )
+    {
+        // Create the grid.
+        std::array<int, 3> global_num_cell = {
+            cells_per_dim[n], cells_per_dim[n], cells_per_dim[n] };
+        auto global_mesh = Cajita::createUniformGlobalMesh(
+            global_low_corner, global_high_corner, global_num_cell );
+        auto global_grid = Cajita::createGlobalGrid(
+            MPI_COMM_WORLD, global_mesh, is_dim_periodic, partitioner );
+        auto local_grid = Cajita::createLocalGrid( global_grid, 0 );
+
+        // Create a complex field (real and imaginary components).
+        auto layout =
+            Cajita::createArrayLayout( local_grid, 2, Cajita::Node() );
+        auto field = Cajita::createArray<double, Device>( "field", layout );
+        Cajita::ArrayOp::assign( *field, 1.0, Cajita::Own() );
+
+        auto fft =
+            Cajita::Experimental::createHeffteFastFourierTransform<double,
+                                                                   Device>(
+                *layout );
+
+        for ( int t = 0; t < num_run; ++t )
+        {
+            forward_timer.start( n );
+            fft->forward( *field, Cajita::Experimental::FFTScaleFull() );
+            Kokkos::fence();
+            forward_timer.stop( n );
+
+            reverse_timer.start( n );
+            fft->reverse( *field, Cajita::Experimental::FFTScaleNone() );
+            Kokkos::fence();
+            reverse_timer.stop( n );
+        }
+    }
+
+    // Output results.
+    outputResults( stream, "cells_per_dim", cells_per_dim, forward_timer,
+                   MPI_COMM_WORLD );
+    outputResults( stream, "cells_per_dim", cells_per_dim, reverse_timer,
+                   MPI_COMM_WORLD );
+}
+
+//---------------------------------------------------------------------------//
+// main
+int main( int argc, char* argv[] )
+{
+    // Initialize environment
+    MPI_Init( &argc, &argv );
+    Kokkos::initialize( argc, argv );
+
+    // Check arguments.
+    if ( argc < 2 )
+        throw std::runtime_error( "Incorrect number of arguments. \n \
+             First argument - file name for output (.json or .csv for \n \
+             machine-readable output) \n \
+             \n \
+             Example: \n \
+             $/: ./FastFourierTransformPerformance test_results.txt\n" );
+
+    // Get the name of the output file.
+    std::string filename = argv[1];
+    Cabana::Benchmark::setOutputFormat( filename );
+
+    // Get comm rank;
+    int comm_rank;
+    MPI_Comm_rank( MPI_COMM_WORLD, &comm_rank );
+
+    // Open the output file on rank 0.
+    std::fstream file;
+    if ( 0 == comm_rank )
+        file.open( filename, std::fstream::out );
+    Cabana::Benchmark::outputMetadata( file, "FastFourierTransformPerformance",
+                                       MPI_COMM_WORLD );
+
+    // Run the tests.
+#ifdef KOKKOS_ENABLE_SERIAL
+    using SerialDevice = Kokkos::Device<Kokkos::Serial, Kokkos::HostSpace>;
+    performanceTest<SerialDevice>( file, "serial_" );
+#endif
+
+#ifdef KOKKOS_ENABLE_OPENMP
+    using OpenMPDevice = Kokkos::Device<Kokkos::OpenMP, Kokkos::HostSpace>;
+    performanceTest<OpenMPDevice>( file, "openmp_" );
+#endif
+
+#ifdef KOKKOS_ENABLE_CUDA
+    using CudaDevice = Kokkos::Device<Kokkos::Cuda, Kokkos::CudaSpace>;
+    performanceTest<CudaDevice>( file, "cuda_" );
+#endif
+
+    // Close the output file on rank 0.
+    if ( 0 == comm_rank )
+        file.close();
+
+    // Finalize
+    Kokkos::finalize();
+    MPI_Finalize();
+    return 0;
+}
+
+//---------------------------------------------------------------------------//
@@ -0,0 +1,162 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "Cabana_BenchmarkUtils.hpp"
+
+#include <Cajita.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <array>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <mpi.h>
+
+//---------------------------------------------------------------------------//
+// Performance test.
+template <class Device>
+void performanceTest( std::ostream& stream, const int num_cell_per_dim,
+                      const std::string& test_prefix )
+{
+    using exec_space = typename Device::execution_space;
+
+    // Create the global grid. The grid is periodic such that every rank
+    // exchanges the same amount of data.
+    std::array<int, 3> global_num_cell = { num_cell_per_dim, num_cell_per_dim,
+                                           num_cell_per_dim };
+    std::array<double, 3> global_low_corner = { 0.0, 0.0, 0.0 };
+    std::array<double, 3> global_high_corner = { 1.0, 1.0, 1.0 };
+    auto global_mesh = Cajita::createUniformGlobalMesh(
+        global_low_corner, global_high_corner, global_num_cell );
+    Cajita::DimBlockPartitioner<3> partitioner;
+    std::array<bool, 3> is_dim_periodic = { true, true, true };
+    auto global_grid = Cajita::createGlobalGrid(
+        MPI_COMM_WORLD, global_mesh, is_dim_periodic, partitioner );
+
+    // Halo widths and degrees of freedom to sweep.
+    std::vector<int> halo_widths = { 1, 2, 3 };
+    std::vector<int> num_dofs = { 1, 3, 9 };
+    int num_dof_size = num_dofs.size();
+
+    // Number of runs in the test loops.
+    int num_run = 10;
+
+    for ( auto halo_width : halo_widths )
+    {
+        auto local_grid = Cajita::createLocalGrid( global_grid, halo_width );
+
+        // Create the timers.
+        std::stringstream gather_name;
+        gather_name << test_prefix << "halo_gather_width_" << halo_width;
+        Cabana::Benchmark::Timer gather_timer( gather_name.str(),
+                                               num_dof_size );
+        std::stringstream scatter_name;
+        scatter_name << test_prefix << "halo_scatter_width_" << halo_width;
+        Cabana::Benchmark::Timer scatter_timer( scatter_name.str(),
+                                                num_dof_size );
+
+        for ( int d = 0; d < num_dof_size; ++d )
+        {
+            auto layout = Cajita::createArrayLayout( local_grid, num_dofs[d],
+                                                     Cajita::Node() );
+            auto array = Cajita::createArray<double, Device>( "array", layout );
+            Cajita::ArrayOp::assign( *array, 1.0, Cajita::Ghost() );
+            auto halo = Cajita::createHalo(
+                *array, Cajita::NodeHaloPattern<3>(), halo_width );
+
+            for ( int t = 0; t < num_run; ++t )
+            {
+                gather_timer.start( d );
+                halo->gather( exec_space(), *array );
+                gather_timer.stop( d );
+
+                scatter_timer.start( d );
+                halo->scatter( exec_space(), Cajita::ScatterReduce::Sum(),
+                               *array );
+                scatter_timer.stop( d );
+            }
+        }
+
+        // Output results.
+        outputResults( stream, "num_dof", num_dofs, gather_timer,
+                       MPI_COMM_WORLD );
+        outputResults( stream, "num_dof", num_dofs, scatter_timer,
+                       MPI_COMM_WORLD );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// main
+int main( int argc, char* argv[] )
+{
+    // Initialize environment
+    MPI_Init( &argc, &argv );
+    Kokkos::initialize( argc, argv );
+
+    // Check arguments.
+    if ( argc < 3 )
+        throw std::runtime_error( "Incorrect number of arguments. \n \
+             First argument - number of global cells in each dimension \n \
+             Second argument - file name for output (.json or .csv for \n \
+             machine-readable output) \n \
+             \n \
+             Example: \n \
+             $/: ./HaloPerformance 128 test_results.txt\n" );
+
+    // Number of cells in each dimension.
+    int num_cell_per_dim = std::atoi( argv[1] );
+
+    // Get the name of the output file.
+    std::string filename = argv[2];
+    Cabana::Benchmark::setOutputFormat( filename );
+
+    // Get comm rank;
+    int comm_rank;
+    MPI_Comm_rank( MPI_COMM_WORLD, &comm_rank );
+
+    // Open the output file on rank 0.
+    std::fstream file;
+    if ( 0 == comm_rank )
+        file.open( filename, std::fstream::out );
+    Cabana::Benchmark::outputMetadata( file, "HaloPerformance",
+                                       MPI_COMM_WORLD );
+
+    // Run the tests.
+#ifdef KOKKOS_ENABLE_SERIAL
+    using SerialDevice = Kokkos::Device<Kokkos::Serial, Kokkos::HostSpace>;
+    performanceTest<SerialDevice>( file, num_cell_per_dim, "serial_" );
+#endif
+
+#ifdef KOKKOS_ENABLE_OPENMP
+    using OpenMPDevice = Kokkos::Device<Kokkos::OpenMP, Kokkos::HostSpace>;
+    performanceTest<OpenMPDevice>( file, num_cell_per_dim, "openmp_" );
+#endif
+
+#ifdef KOKKOS_ENABLE_CUDA
+    using CudaDevice = Kokkos::Device<Kokkos::Cuda, Kokkos::CudaSpace>;
+    performanceTest<CudaDevice>( file, num_cell_per_dim, "cuda_" );
+#endif
+
+    // Close the output file on rank 0.
+    if ( 0 == comm_rank )
+        file.close();
+
+    // Finalize
+    Kokkos::finalize();
+    MPI_Finalize();
+    return 0;
+}
+
+//---------------------------------------------------------------------------//
@@ -0,0 +1,254 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "Cabana_BenchmarkUtils.hpp"
+
+#include <Cajita.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <array>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <mpi.h>
+
+//---------------------------------------------------------------------------//
+// Time scalar and vector p2g and g2p for one spline order over a sweep of
+// particles per cell.
+template <int SplineOrder, class Device, class LocalGridType>
+void splineTest( std::ostream& stream, const LocalGridType& local_grid,
+                 const std::vector<int>& particles_per_cell,
+                 const std::string& test_prefix )
+{
+    using memory_space = typename Device::memory_space;
+
+    int num_ppc = particles_per_cell.size();
+    int num_run = 10;
+
+    // Create the timers.
+    auto timer_name = [&]( const std::string& name ) {
+        std::stringstream full_name;
+        full_name << test_prefix << name << "_spline_" << SplineOrder;
+        return full_name.str();
+    };
+    Cabana::Benchmark::Timer scalar_p2g_timer( timer_name( "p2g_scalar" ),
+                                               num_ppc, "particles" );
+    Cabana::Benchmark::Timer vector_p2g_timer( timer_name( "p2g_vector" ),
+                                               num_ppc, "particles" );
+    Cabana::Benchmark::Timer scalar_g2p_timer( timer_name( "g2p_scalar" ),
+                                               num_ppc, "particles" );
+    Cabana::Benchmark::Timer vector_g2p_timer( timer_name( "g2p_vector" ),
+                                               num_ppc, "particles" );
+
+    // Create the grid fields.
+    auto scalar_layout =
+        Cajita::createArrayLayout( local_grid, 1, Cajita::Node() );
+    auto scalar_field =
+        Cajita::createArray<double, Device>( "scalar", scalar_layout );
+    auto scalar_halo =
+        Cajita::createHalo( *scalar_field, Cajita::NodeHaloPattern<3>() );
+    auto vector_layout =
+        Cajita::createArrayLayout( local_grid, 3, Cajita::Node() );
+    auto vector_field =
+        Cajita::createArray<double, Device>( "vector", vector_layout );
+    auto vector_halo =
+        Cajita::createHalo( *vector_field, Cajita::NodeHaloPattern<3>() );
+
+    auto owned_cells = local_grid->indexSpace( Cajita::Own(), Cajita::Cell(),
+                                               Cajita::Local() );
+    auto local_mesh = Cajita::createLocalMesh<Kokkos::HostSpace>( *local_grid );
+    double cell_size =
+        local_grid->globalGrid().globalMesh().cellSize( Cajita::Dim::I );
+
+    for ( int n = 0; n < num_ppc; ++n )
+    {
+        // Create particles at random positions in every owned cell.
+        int ppc = particles_per_cell[n];
+        int num_point = owned_cells.size() * ppc;
+        scalar_p2g_timer.setWork( n, num_point );
+        vector_p2g_timer.setWork( n, num_point );
+        scalar_g2p_timer.setWork( n, num_point );
+        vector_g2p_timer.setWork( n, num_point );
+        Kokkos::View<double* [3], Kokkos::HostSpace> points_host(
+            Kokkos::ViewAllocateWithoutInitializing( "points" ), num_point );
+        std::minstd_rand0 generator( 3439203991 );
+        std::uniform_real_distribution<double> distribution( 0.0, 1.0 );
+        int pid = 0;
+        for ( int i = owned_cells.min( 0 ); i < owned_cells.max( 0 ); ++i )
+            for ( int j = owned_cells.min( 1 ); j < owned_cells.max( 1 ); ++j )
+                for ( int k = owned_cells.min( 2 ); k < owned_cells.max( 2 );
+                      ++k )
+                {
+                    int index[3] = { i, j, k };
+                    double low[3];
+                    local_mesh.coordinates( Cajita::Node(), index, low );
+                    for ( int p = 0; p < ppc; ++p, ++pid )
+                        for ( int d = 0; d < 3; ++d )
+                            points_host( pid, d ) =
+                                low[d] + cell_size * distribution( generator );
+                }
+        auto points =
+            Kokkos::create_mirror_view_and_copy( memory_space(), points_host );
+
+        // Create the particle fields.
+        Kokkos::View<double*, memory_space> scalar_point( "scalar_point",
+                                                          num_point );
+        Kokkos::View<double* [3], memory_space> vector_point( "vector_point",
+                                                              num_point );
+        Kokkos::deep_copy( scalar_point, 1.0 );
+        Kokkos::deep_copy( vector_point, 1.0 );
+
+        auto scalar_p2g = Cajita::createScalarValueP2G( scalar_point, 1.0 );
+        auto vector_p2g = Cajita::createVectorValueP2G( vector_point, 1.0 );
+        auto scalar_g2p = Cajita::createScalarValueG2P( scalar_point, 1.0 );
+        auto vector_g2p = Cajita::createVectorValueG2P( vector_point, 1.0 );
+
+        for ( int t = 0; t < num_run; ++t )
+        {
+            Cajita::ArrayOp::assign( *scalar_field, 0.0, Cajita::Ghost() );
+            scalar_p2g_timer.start( n );
+            Cajita::p2g( scalar_p2g, points, num_point,
+                         Cajita::Spline<SplineOrder>(), *scalar_halo,
+                         *scalar_field );
+            Kokkos::fence();
+            scalar_p2g_timer.stop( n );
+
+            Cajita::ArrayOp::assign( *vector_field, 0.0, Cajita::Ghost() );
+            vector_p2g_timer.start( n );
+            Cajita::p2g( vector_p2g, points, num_point,
+                         Cajita::Spline<SplineOrder>(), *vector_halo,
+                         *vector_field );
+            Kokkos::fence();
+            vector_p2g_timer.stop( n );
+
+            scalar_g2p_timer.start( n );
+            Cajita::g2p( *scalar_field, *scalar_halo, points, num_point,
+                         Cajita::Spline<SplineOrder>(), scalar_g2p );
+            Kokkos::fence();
+            scalar_g2p_timer.stop( n );
+
+            vector_g2p_timer.start( n );
+            Cajita::g2p( *vector_field, *vector_halo, points, num_point,
+                         Cajita::Spline<SplineOrder>(), vector_g2p );
+            Kokkos::fence();
+            vector_g2p_timer.stop( n );
+        }
+    }
+
+    // Output results.
+    outputResults( stream, "particles_per_cell", particles_per_cell,
+                   scalar_p2g_timer, MPI_COMM_WORLD );
+    outputResults( stream, "particles_per_cell", particles_per_cell,
+                   vector_p2g_timer, MPI_COMM_WORLD );
+    outputResults( stream, "particles_per_cell", particles_per_cell,
+                   scalar_g2p_timer, MPI_COMM_WORLD );
+    outputResults( stream, "particles_per_cell", particles_per_cell,
+                   vector_g2p_timer, MPI_COMM_WORLD );
+}
+
+//---------------------------------------------------------------------------//
+// Performance test.
+template <class Device>
+void performanceTest( std::ostream& stream, const int num_cell_per_dim,
+                      const std::string& test_prefix )
+{
+    // Create the global grid.
+    std::array<int, 3> global_num_cell = { num_cell_per_dim, num_cell_per_dim,
+                                           num_cell_per_dim };
+    std::array<double, 3> global_low_corner = { 0.0, 0.0, 0.0 };
+    std::array<double, 3> global_high_corner = { 1.0, 1.0, 1.0 };
+    auto global_mesh = Cajita::createUniformGlobalMesh(
+        global_low_corner, global_high_corner, global_num_cell );
+    Cajita::DimBlockPartitioner<3> partitioner;
+    std::array<bool, 3> is_dim_periodic = { true, true, true };
+    auto global_grid = Cajita::createGlobalGrid(
+        MPI_COMM_WORLD, global_mesh, is_dim_periodic, partitioner );
+
+    // The halo must hold the support of the widest spline.
+    auto local_grid = Cajita::createLocalGrid( global_grid, 2 );
+
+    std::vector<int> particles_per_cell = { 1, 8, 27, 64 };
+    splineTest<1, Device>( stream, local_grid, particles_per_cell,
+                           test_prefix );
+    splineTest<2, Device>( stream, local_grid, particles_per_cell,
+                           test_prefix );
+    splineTest<3, Device>( stream, local_grid, particles_per_cell,
+                           test_prefix );
+}
+
+//---------------------------------------------------------------------------//
+// main
+int main( int argc, char* argv[] )
+{
+    // Initialize environment
+    MPI_Init( &argc, &argv );
+    Kokkos::initialize( argc, argv );
+
+    // Check arguments.
+    if ( argc < 3 )
+        throw std::runtime_error( "Incorrect number of arguments. \n \
+             First argument - number of global cells in each dimension \n \
+             Second argument - file name for output (.json or .csv for \n \
+             machine-readable output) \n \
+             \n \
+             Example: \n \
+             $/: ./InterpolationPerformance 64 test_results.txt\n" );
+
+    // Number of cells in each dimension.
+    int num_cell_per_dim = std::atoi( argv[1] );
+
+    // Get the name of the output file.
+    std::string filename = argv[2];
+    Cabana::Benchmark::setOutputFormat( filename );
+
+    // Get comm rank;
+    int comm_rank;
+    MPI_Comm_rank( MPI_COMM_WORLD, &comm_rank );
+
+    // Open the output file on rank 0.
+    std::fstream file;
+    if ( 0 == comm_rank )
+        file.open( filename, std::fstream::out );
+    Cabana::Benchmark::outputMetadata( file, "InterpolationPerformance",
+                                       MPI_COMM_WORLD );
+
+    // Run the tests.
+#ifdef KOKKOS_ENABLE_SERIAL
+    using SerialDevice = Kokkos::Device<Kokkos::Serial, Kokkos::HostSpace>;
+    performanceTest<SerialDevice>( file, num_cell_per_dim, "serial_" );
+#endif
+
+#ifdef KOKKOS_ENABLE_OPENMP
+    using OpenMPDevice = Kokkos::Device<Kokkos::OpenMP, Kokkos::HostSpace>;
+    performanceTest<OpenMPDevice>( file, num_cell_per_dim, "openmp_" );
+#endif
+
+#ifdef KOKKOS_ENABLE_CUDA
+    using CudaDevice = Kokkos::Device<Kokkos::Cuda, Kokkos::CudaSpace>;
+    performanceTest<CudaDevice>( file, num_cell_per_dim, "cuda_" );
+#endif
+
+    // Close the output file on rank 0.
+    if ( 0 == comm_rank )
+        file.close();
+
+    // Finalize
+    Kokkos::finalize();
+    MPI_Finalize();
+    return 0;
+}
+
+//---------------------------------------------------------------------------//
@@ -0,0 +1,357 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "Cabana_BenchmarkUtils.hpp"
+
+#include <Cabana_Core.hpp>
+#include <Cajita.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ScatterView.hpp>
+
+#include <array>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <mpi.h>
+
+//---------------------------------------------------------------------------//
+// Particle-in-cell proxy. Every timestep runs the phases of a production
+// PIC/MPM code on a periodic Cajita grid:
+//
+//   particle-grid migrate -> P2G mass and momentum with a ScatterView ->
+//   halo scatter-sum -> grid velocity update -> halo gather -> G2P
+//   velocity and position update
+//
+// Particles carry a uniform drift so they keep crossing rank boundaries.
+//---------------------------------------------------------------------------//
+
+// Particle fields.
+enum ParticleFields
+{
+    Position = 0,
+    Velocity = 1,
+    Mass = 2
+};
+
+//---------------------------------------------------------------------------//
+// Performance test.
+template <class Device>
+void performanceTest( std::ostream& stream, const bool weak_scaling,
+                      const int num_cell_per_dim, const int ppc,
+                      const int num_step, const std::string& test_prefix )
+{
+    using exec_space = typename Device::execution_space;
+    using memory_space = typename Device::memory_space;
+
+    // Create the global grid. Weak scaling fixes the number of cells per
+    // rank in each dimension and strong scaling the global number of cells.
+    Cajita::DimBlockPartitioner<3> partitioner;
+    std::array<int, 3> global_num_cell = { num_cell_per_dim, num_cell_per_dim,
+                                           num_cell_per_dim };
+    if ( weak_scaling )
+    {
+        auto ranks_per_dim =
+            partitioner.ranksPerDimension( MPI_COMM_WORLD, global_num_cell );
+        for ( int d = 0; d < 3; ++d )
+            global_num_cell[d] *= ranks_per_dim[d];
+    }
+    const double cell_size = 1.0 / num_cell_per_dim;
+    std::array<double, 3> global_low_corner = { 0.0, 0.0, 0.0 };
+    std::array<double, 3> global_high_corner = {
+        global_num_cell[0] * cell_size, global_num_cell[1] * cell_size,
+        global_num_cell[2] * cell_size };
+    auto global_mesh = Cajita::createUniformGlobalMesh(
+        global_low_corner, global_high_corner, global_num_cell );
+    std::array<bool, 3> is_dim_periodic = { true, true, true };
+    auto global_grid = Cajita::createGlobalGrid(
+        MPI_COMM_WORLD, global_mesh, is_dim_periodic, partitioner );
+
+    // Particles may leave the owned cells by up to the migration width
+    // before being migrated. The halo holds their linear spline support.
+    const int min_halo_width = 1;
+    auto local_grid = Cajita::createLocalGrid( global_grid, 2 );
+    auto local_mesh = Cajita::createLocalMesh<Device>( *local_grid );
+    auto local_mesh_host =
+        Cajita::createLocalMesh<Kokkos::HostSpace>( *local_grid );
+    const double cell_volume = cell_size * cell_size * cell_size;
+
+    // Particles move less than a tenth of a cell per step.
+    const double dt = 0.1 * cell_size;
+    const double drift[3] = { 0.5, 0.25, 0.125 };
+
+    // Create the grid fields.
+    auto node_scalar_layout =
+        Cajita::createArrayLayout( local_grid, 1, Cajita::Node() );
+    auto node_vector_layout =
+        Cajita::createArrayLayout( local_grid, 3, Cajita::Node() );
+    auto mass =
+        Cajita::createArray<double, Device>( "mass", node_scalar_layout );
+    auto momentum =
+        Cajita::createArray<double, Device>( "momentum", node_vector_layout );
+    auto velocity =
+        Cajita::createArray<double, Device>( "velocity", node_vector_layout );
+    auto p2g_halo = Cajita::createHalo( Cajita::NodeHaloPattern<3>(), -1,
+                                        *mass, *momentum );
+    auto g2p_halo =
+        Cajita::createHalo( *velocity, Cajita::NodeHaloPattern<3>() );
+
+    // Create particles at random positions in every owned cell with the
+    // drift velocity plus a random perturbation.
+    auto owned_cells = local_grid->indexSpace( Cajita::Own(), Cajita::Cell(),
+                                               Cajita::Local() );
+    int num_particle = owned_cells.size() * ppc;
+    using member_types = Cabana::MemberTypes<double[3], double[3], double>;
+    using aosoa_type = Cabana::AoSoA<member_types, memory_space>;
+    using aosoa_host_type = Cabana::AoSoA<member_types, Kokkos::HostSpace>;
+    aosoa_host_type particles_host( "particles_host", num_particle );
+    auto x_host = Cabana::slice<Position>( particles_host );
+    auto v_host = Cabana::slice<Velocity>( particles_host );
+    auto m_host = Cabana::slice<Mass>( particles_host );
+    int comm_rank;
+    MPI_Comm_rank( MPI_COMM_WORLD, &comm_rank );
+    std::minstd_rand0 generator( 3439203991 + comm_rank );
+    std::uniform_real_distribution<double> distribution( 0.0, 1.0 );
+    int pid = 0;
+    for ( int i = owned_cells.min( 0 ); i < owned_cells.max( 0 ); ++i )
+        for ( int j = owned_cells.min( 1 ); j < owned_cells.max( 1 ); ++j )
+            for ( int k = owned_cells.min( 2 ); k < owned_cells.max( 2 ); ++k )
+            {
+                int index[3] = { i, j, k };
+                double low[3];
+                local_mesh_host.coordinates( Cajita::Node(), index, low );
+                for ( int p = 0; p < ppc; ++p, ++pid )
+                {
+                    for ( int d = 0; d < 3; ++d )
+                    {
+                        x_host( pid, d ) =
+                            low[d] + cell_size * distribution( generator );
+                        v_host( pid, d ) =
+                            drift[d] + 0.5 * ( distribution( generator ) -
+                                               0.5 );
+                    }
+                    m_host( pid ) = cell_volume / ppc;
+                }
+            }
+    aosoa_type particles( "particles", num_particle );
+    Cabana::deep_copy( particles, particles_host );
+
+    // Create the phase timers. Each phase is sampled on every step.
+    auto create_timer = [&]( const std::string& name ) {
+        return Cabana::Benchmark::Timer( test_prefix + name, 1 );
+    };
+    Cabana::Benchmark::Timer step_timer( test_prefix + "pic_timestep", 1,
+                                         "particle_steps" );
+    auto migrate_timer = create_timer( "pic_migrate" );
+    auto p2g_timer = create_timer( "pic_p2g" );
+    auto scatter_timer = create_timer( "pic_halo_scatter" );
+    auto grid_update_timer = create_timer( "pic_grid_update" );
+    auto gather_timer = create_timer( "pic_halo_gather" );
+    auto g2p_timer = create_timer( "pic_g2p" );
+
+    using sd_type = Cajita::SplineData<double, 1, 3, Cajita::Node>;
+
+    for ( int step = 0; step < num_step; ++step )
+    {
+        step_timer.start( 0 );
+
+        // MIGRATE
+        // -------
+        migrate_timer.start( 0 );
+        auto x_migrate = Cabana::slice<Position>( particles );
+        Cajita::particleGridMigrate( *local_grid, x_migrate, particles,
+                                     min_halo_width );
+        Kokkos::fence();
+        migrate_timer.stop( 0 );
+        num_particle = particles.size();
+
+        auto x = Cabana::slice<Position>( particles );
+        auto v = Cabana::slice<Velocity>( particles );
+        auto m = Cabana::slice<Mass>( particles );
+
+        // P2G
+        // ---
+        // Interpolate particle mass and momentum to the nodes.
+        p2g_timer.start( 0 );
+        Cajita::ArrayOp::assign( *mass, 0.0, Cajita::Ghost() );
+        Cajita::ArrayOp::assign( *momentum, 0.0, Cajita::Ghost() );
+        auto mass_view = mass->view();
+        auto momentum_view = momentum->view();
+        auto mass_sv = Cajita::P2G::createScatterView( mass_view );
+        auto momentum_sv = Cajita::P2G::createScatterView( momentum_view );
+        Kokkos::parallel_for(
+            "pic_proxy::p2g",
+            Kokkos::RangePolicy<exec_space>( 0, num_particle ),
+            KOKKOS_LAMBDA( const int p ) {
+                double px[3] = { x( p, 0 ), x( p, 1 ), x( p, 2 ) };
+                sd_type sd;
+                Cajita::evaluateSpline( local_mesh, px, sd );
+                double pm = m( p );
+                double pmv[3] = { pm * v( p, 0 ), pm * v( p, 1 ),
+                                  pm * v( p, 2 ) };
+                Cajita::P2G::value( pm, sd, mass_sv );
+                Cajita::P2G::value( pmv, sd, momentum_sv );
+            } );
+        Kokkos::Experimental::contribute( mass_view, mass_sv );
+        Kokkos::Experimental::contribute( momentum_view, momentum_sv );
+        Kokkos::fence();
+        p2g_timer.stop( 0 );
+
+        // HALO SCATTER
+        // ------------
+        // Sum the ghost node contributions into their owners.
+        scatter_timer.start( 0 );
+        p2g_halo->scatter( exec_space(), Cajita::ScatterReduce::Sum(), *mass,
+                           *momentum );
+        scatter_timer.stop( 0 );
+
+        // GRID UPDATE
+        // -----------
+        // Compute the node velocities from the momentum.
+        grid_update_timer.start( 0 );
+        auto velocity_view = velocity->view();
+        Cajita::grid_parallel_for(
+            "pic_proxy::grid_update", exec_space(), *local_grid, Cajita::Own(),
+            Cajita::Node(),
+            KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+                double node_mass = mass_view( i, j, k, 0 );
+                for ( int d = 0; d < 3; ++d )
+                    velocity_view( i, j, k, d ) =
+                        ( node_mass > 0.0 )
+                            ? momentum_view( i, j, k, d ) / node_mass
+                            : 0.0;
+            } );
+        Kokkos::fence();
+        grid_update_timer.stop( 0 );
+
+        // HALO GATHER
+        // -----------
+        gather_timer.start( 0 );
+        g2p_halo->gather( exec_space(), *velocity );
+        gather_timer.stop( 0 );
+
+        // G2P
+        // ---
+        // Interpolate the node velocities to the particles and move them.
+        g2p_timer.start( 0 );
+        Kokkos::parallel_for(
+            "pic_proxy::g2p",
+            Kokkos::RangePolicy<exec_space>( 0, num_particle ),
+            KOKKOS_LAMBDA( const int p ) {
+                double px[3] = { x( p, 0 ), x( p, 1 ), x( p, 2 ) };
+                sd_type sd;
+                Cajita::evaluateSpline( local_mesh, px, sd );
+                double pv[3];
+                Cajita::G2P::value( velocity_view, sd, pv );
+                for ( int d = 0; d < 3; ++d )
+                {
+                    v( p, d ) = pv[d];
+                    x( p, d ) += dt * pv[d];
+                }
+            } );
+        Kokkos::fence();
+        g2p_timer.stop( 0 );
+
+        step_timer.stop( 0 );
+    }
+    step_timer.setWork( 0, num_particle );
+
+    // Output results.
+    std::string data_point_name =
+        ( weak_scaling ) ? "cells_per_rank_per_dim" : "global_cells_per_dim";
+    std::vector<int> cells = { num_cell_per_dim };
+    for ( auto timer : { &step_timer, &migrate_timer, &p2g_timer,
+                         &scatter_timer, &grid_update_timer, &gather_timer,
+                         &g2p_timer } )
+        outputResults( stream, data_point_name, cells, *timer,
+                       MPI_COMM_WORLD );
+}
+
+//---------------------------------------------------------------------------//
+// main
+int main( int argc, char* argv[] )
+{
+    // Initialize environment
+    MPI_Init( &argc, &argv );
+    Kokkos::initialize( argc, argv );
+
+    // Check arguments.
+    if ( argc < 6 )
+        throw std::runtime_error( "Incorrect number of arguments. \n \
+             First argument - scaling type: weak or strong \n \
+             Second argument - number of cells in each dimension per rank \n \
+             (weak) or globally (strong) \n \
+             Third argument - number of particles per cell \n \
+             Fourth argument - number of timesteps \n \
+             Fifth argument - file name for output (.json or .csv for \n \
+             machine-readable output) \n \
+             \n \
+             Example: \n \
+             $/: ./PICProxyPerformance weak 32 8 100 test_results.txt\n" );
+
+    // Get the scaling type.
+    std::string scaling = argv[1];
+    if ( scaling != "weak" && scaling != "strong" )
+        throw std::runtime_error( "Scaling type must be weak or strong" );
+
+    // Get the problem size.
+    int num_cell_per_dim = std::atoi( argv[2] );
+    int ppc = std::atoi( argv[3] );
+    int num_step = std::atoi( argv[4] );
+
+    // Get the name of the output file.
+    std::string filename = argv[5];
+    Cabana::Benchmark::setOutputFormat( filename );
+
+    // Get comm rank;
+    int comm_rank;
+    MPI_Comm_rank( MPI_COMM_WORLD, &comm_rank );
+
+    // Open the output file on rank 0.
+    std::fstream file;
+    if ( 0 == comm_rank )
+        file.open( filename, std::fstream::out );
+    Cabana::Benchmark::outputMetadata( file, "PICProxyPerformance",
+                                       MPI_COMM_WORLD );
+
+    // Run the tests.
+#ifdef KOKKOS_ENABLE_SERIAL
+    using SerialDevice = Kokkos::Device<Kokkos::Serial, Kokkos::HostSpace>;
+    performanceTest<SerialDevice>( file, "weak" == scaling, num_cell_per_dim,
+                                   ppc, num_step, "serial_" );
+#endif
+
+#ifdef KOKKOS_ENABLE_OPENMP
+    using OpenMPDevice = Kokkos::Device<Kokkos::OpenMP, Kokkos::HostSpace>;
+    performanceTest<OpenMPDevice>( file, "weak" == scaling, num_cell_per_dim,
+                                   ppc, num_step, "openmp_" );
+#endif
+
+#ifdef KOKKOS_ENABLE_CUDA
+    using CudaDevice = Kokkos::Device<Kokkos::Cuda, Kokkos::CudaSpace>;
+    performanceTest<CudaDevice>( file, "weak" == scaling, num_cell_per_dim,
+                                 ppc, num_step, "cuda_" );
+#endif
+
+    // Close the output file on rank 0.
+    if ( 0 == comm_rank )
+        file.close();
+
+    // Finalize
+    Kokkos::finalize();
+    MPI_Finalize();
+    return 0;
+}
+
+//---------------------------------------------------------------------------//
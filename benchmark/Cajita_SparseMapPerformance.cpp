@@ -0,0 +1,175 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "Cabana_BenchmarkUtils.hpp"
+
+#include <Cajita.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+//---------------------------------------------------------------------------//
+// Performance test.
+template <class Device>
+void performanceTest( std::ostream& stream, const int num_cell_per_dim,
+                      const std::string& test_prefix )
+{
+    using exec_space = typename Device::execution_space;
+    using memory_space = typename Device::memory_space;
+
+    // Create the global mesh.
+    std::array<int, 3> global_num_cell = { num_cell_per_dim, num_cell_per_dim,
+                                           num_cell_per_dim };
+    std::array<double, 3> global_low_corner = { 0.0, 0.0, 0.0 };
+    std::array<double, 3> global_high_corner = { 1.0, 1.0, 1.0 };
+    auto global_mesh = Cajita::createSparseGlobalMesh(
+        global_low_corner, global_high_corner, global_num_cell );
+
+    // Fractions of the grid cells to register.
+    std::vector<double> occupancy = { 0.01, 0.05, 0.1, 0.25, 0.5, 1.0 };
+    int num_occupancy = occupancy.size();
+
+    // Generate a random ordering of all cells on the host.
+    int num_cell = num_cell_per_dim * num_cell_per_dim * num_cell_per_dim;
+    int num_tile_per_dim = ( num_cell_per_dim + 3 ) / 4;
+    int num_tile = num_tile_per_dim * num_tile_per_dim * num_tile_per_dim;
+    Kokkos::View<int* [3], Kokkos::HostSpace> cells_host(
+        Kokkos::ViewAllocateWithoutInitializing( "cells_host" ), num_cell );
+    std::vector<int> cell_order( num_cell );
+    for ( int c = 0; c < num_cell; ++c )
+        cell_order[c] = c;
+    std::minstd_rand0 generator( 3439203991 );
+    std::shuffle( cell_order.begin(), cell_order.end(), generator );
+    for ( int c = 0; c < num_cell; ++c )
+    {
+        int id = cell_order[c];
+        cells_host( c, 0 ) = id / ( num_cell_per_dim * num_cell_per_dim );
+        cells_host( c, 1 ) = ( id / num_cell_per_dim ) % num_cell_per_dim;
+        cells_host( c, 2 ) = id % num_cell_per_dim;
+    }
+    auto cells =
+        Kokkos::create_mirror_view_and_copy( memory_space(), cells_host );
+
+    // Number of runs in the test loops.
+    int num_run = 10;
+
+    // Create the timers.
+    Cabana::Benchmark::Timer insert_timer( test_prefix + "sparse_map_insert",
+                                           num_occupancy, "cells" );
+    Cabana::Benchmark::Timer query_timer( test_prefix + "sparse_map_query",
+                                          num_occupancy, "cells" );
+
+    // Query results.
+    Kokkos::View<int*, memory_space> tile_ids( "tile_ids", num_cell );
+
+    for ( int o = 0; o < num_occupancy; ++o )
+    {
+        int num_insert = occupancy[o] * num_cell;
+        insert_timer.setWork( o, num_insert );
+        query_timer.setWork( o, num_insert );
+
+        for ( int t = 0; t < num_run; ++t )
+        {
+            // Preallocate every tile of the grid as insertion on the device
+            // can not grow the map.
+            auto sis =
+                Cajita::createSparseMap<exec_space>( global_mesh, num_tile );
+
+            insert_timer.start( o );
+            Kokkos::parallel_for(
+                "sparse_map_insert",
+                Kokkos::RangePolicy<exec_space>( 0, num_insert ),
+                KOKKOS_LAMBDA( const int c ) {
+                    sis.insertCell( cells( c, 0 ), cells( c, 1 ),
+                                    cells( c, 2 ) );
+                } );
+            Kokkos::fence();
+            insert_timer.stop( o );
+
+            query_timer.start( o );
+            Kokkos::parallel_for(
+                "sparse_map_query",
+                Kokkos::RangePolicy<exec_space>( 0, num_insert ),
+                KOKKOS_LAMBDA( const int c ) {
+                    tile_ids( c ) = sis.queryCell( cells( c, 0 ), cells( c, 1 ),
+                                                   cells( c, 2 ) );
+                } );
+            Kokkos::fence();
+            query_timer.stop( o );
+        }
+    }
+
+    // Output results.
+    outputResults( stream, "occupancy", occupancy, insert_timer );
+    outputResults( stream, "occupancy", occupancy, query_timer );
+}
+
+//---------------------------------------------------------------------------//
+// main
+int main( int argc, char* argv[] )
+{
+    // Initialize environment
+    Kokkos::initialize( argc, argv );
+
+    // Check arguments.
+    if ( argc < 3 )
+        throw std::runtime_error( "Incorrect number of arguments. \n \
+             First argument - number of cells in each dimension \n \
+             Second argument - file name for output (.json or .csv for \n \
+             machine-readable output) \n \
+             \n \
+             Example: \n \
+             $/: ./SparseMapPerformance 128 test_results.txt\n" );
+
+    // Number of cells in each dimension.
+    int num_cell_per_dim = std::atoi( argv[1] );
+
+    // Get the name of the output file.
+    std::string filename = argv[2];
+    Cabana::Benchmark::setOutputFormat( filename );
+
+    // Open the output file.
+    std::fstream file;
+    file.open( filename, std::fstream::out );
+    Cabana::Benchmark::outputMetadata( file, "SparseMapPerformance" );
+
+    // Run the tests.
+#ifdef KOKKOS_ENABLE_SERIAL
+    using SerialDevice = Kokkos::Device<Kokkos::Serial, Kokkos::HostSpace>;
+    performanceTest<SerialDevice>( file, num_cell_per_dim, "serial_" );
+#endif
+
+#ifdef KOKKOS_ENABLE_OPENMP
+    using OpenMPDevice = Kokkos::Device<Kokkos::OpenMP, Kokkos::HostSpace>;
+    performanceTest<OpenMPDevice>( file, num_cell_per_dim, "openmp_" );
+#endif
+
+#ifdef KOKKOS_ENABLE_CUDA
+    using CudaDevice = Kokkos::Device<Kokkos::Cuda, Kokkos::CudaSpace>;
+    performanceTest<CudaDevice>( file, num_cell_per_dim, "cuda_" );
+#endif
+
+    // Close the output file.
+    file.close();
+
+    // Finalize
+    Kokkos::finalize();
+    return 0;
+}
+
+//---------------------------------------------------------------------------//
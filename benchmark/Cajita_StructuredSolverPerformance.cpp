@@ -0,0 +1,228 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "Cabana_BenchmarkUtils.hpp"
+
+#include <Cajita.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <array>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <mpi.h>
+
+//---------------------------------------------------------------------------//
+// Performance test.
+template <class Device>
+void performanceTest( std::ostream& stream, const std::string& test_prefix )
+{
+    using exec_space = typename Device::execution_space;
+
+    // Global problem sizes to sweep.
+    std::vector<int> cells_per_dim = { 16, 32, 64, 128 };
+    int num_size = cells_per_dim.size();
+
+    // Number of runs in the test loops.
+    int num_run = 10;
+
+    // Create the timer and the iteration counts of each problem size.
+    Cabana::Benchmark::Timer solve_timer( test_prefix + "cg_solve", num_size );
+    std::vector<int> num_iter( num_size, 0 );
+
+    std::array<double, 3> global_low_corner = { 0.0, 0.0, 0.0 };
+    std::array<double, 3> global_high_corner = { 1.0, 1.0, 1.0 };
+    std::array<bool, 3> is_dim_periodic = { false, false, false };
+    Cajita::DimBlockPartitioner<3> partitioner;
+
+    // 7-point 3d laplacian stencil.
+    std::vector<std::array<int, 3>> stencil = {
+        { 0, 0, 0 }, { -1, 0, 0 }, { 1, 0, 0 }, { 0, -1, 0 },
+        { 0, 1, 0 }, { 0, 0, -1 }, { 0, 0, 1 } };
+    std::vector<std::array<int, 3>> diag_stencil = { { 0, 0, 0 } };
+
+    for ( int n = 0; n < num_size; ++n )
+    {
+        // Create the grid.
+        std::array<int, 3> global_num_cell = {
+            cells_per_dim[n], cells_per_dim[n], cells_per_dim[n] };
+        auto global_mesh = Cajita::createUniformGlobalMesh(
+            global_low_corner, global_high_corner, global_num_cell );
+        auto global_grid = Cajita::createGlobalGrid(
+            MPI_COMM_WORLD, global_mesh, is_dim_periodic, partitioner );
+        auto local_grid = Cajita::createLocalGrid( global_grid, 1 );
+        auto owned_space = local_grid->indexSpace(
+            Cajita::Own(), Cajita::Cell(), Cajita::Local() );
+        auto global_space = local_grid->indexSpace(
+            Cajita::Own(), Cajita::Cell(), Cajita::Global() );
+
+        // Create the solver vectors.
+        auto vector_layout =
+            Cajita::createArrayLayout( local_grid, 1, Cajita::Cell() );
+        auto rhs = Cajita::createArray<double, Device>( "rhs", vector_layout );
+        Cajita::ArrayOp::assign( *rhs, 1.0, Cajita::Own() );
+        auto lhs = Cajita::createArray<double, Device>( "lhs", vector_layout );
+
+        // Create the solver. Couplings to cells outside of the domain are
+        // dropped (homogeneous Dirichlet boundaries).
+        auto solver =
+            Cajita::createReferenceConjugateGradient<double, Device>(
+                *vector_layout );
+        solver->setMatrixStencil( stencil );
+        auto matrix_view = solver->getMatrixValues().view();
+        int ncell = cells_per_dim[n];
+        Kokkos::parallel_for(
+            "fill_matrix_entries",
+            Cajita::createExecutionPolicy( owned_space, exec_space() ),
+            KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+                int g[3] = {
+                    i + global_space.min( 0 ) - owned_space.min( 0 ),
+                    j + global_space.min( 1 ) - owned_space.min( 1 ),
+                    k + global_space.min( 2 ) - owned_space.min( 2 ) };
+                matrix_view( i, j, k, 0 ) = 6.0;
+                for ( int d = 0; d < 3; ++d )
+                {
+                    matrix_view( i, j, k, 2 * d + 1 ) =
+                        ( g[d] > 0 ) ? -1.0 : 0.0;
+                    matrix_view( i, j, k, 2 * d + 2 ) =
+                        ( g[d] < ncell - 1 ) ? -1.0 : 0.0;
+                }
+            } );
+
+        // Jacobi preconditioner.
+        solver->setPreconditionerStencil( diag_stencil );
+        auto preconditioner_view = solver->getPreconditionerValues().view();
+        Kokkos::parallel_for(
+            "fill_preconditioner_entries",
+            Cajita::createExecutionPolicy( owned_space, exec_space() ),
+            KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+                preconditioner_view( i, j, k, 0 ) = 1.0 / 6.0;
+            } );
+
+        solver->setTolerance( 1.0e-8 );
+        solver->setMaxIter( 10000 );
+        solver->setup();
+
+        for ( int t = 0; t < num_run; ++t )
+        {
+            Cajita::ArrayOp::assign( *lhs, 0.0, Cajita::Own() );
+            solve_timer.start( n );
+            solver->solve( *rhs, *lhs );
+            Kokkos::fence();
+            solve_timer.stop( n );
+        }
+        num_iter[n] = solver->getNumIter();
+    }
+
+    // Output results.
+    outputResults( stream, "cells_per_dim", cells_per_dim, solve_timer,
+                   MPI_COMM_WORLD );
+
+    // Output the iteration throughput of the slowest rank.
+    int comm_rank;
+    MPI_Comm_rank( MPI_COMM_WORLD, &comm_rank );
+    int comm_size;
+    MPI_Comm_size( MPI_COMM_WORLD, &comm_size );
+    bool is_table = ( Cabana::Benchmark::OutputFormat::Table ==
+                      Cabana::Benchmark::outputFormat() );
+    std::string ips_name = test_prefix + "cg_iterations_per_second";
+    if ( 0 == comm_rank && is_table )
+        stream << "\n"
+               << ips_name << "\n"
+               << "cells_per_dim num_iter iterations_per_second\n";
+    for ( int n = 0; n < num_size; ++n )
+    {
+        // Average solve time in microseconds over the runs.
+        const auto& run_times = solve_timer._data[n];
+        double local_time =
+            std::accumulate( run_times.begin(), run_times.end(), 0.0 ) /
+            run_times.size();
+        double max_time = 0.0;
+        MPI_Reduce( &local_time, &max_time, 1, MPI_DOUBLE, MPI_MAX, 0,
+                    MPI_COMM_WORLD );
+        if ( 0 != comm_rank )
+            continue;
+        double ips = 1.0e6 * num_iter[n] / max_time;
+        if ( is_table )
+            stream << cells_per_dim[n] << " " << num_iter[n] << " " << ips
+                   << "\n";
+        else
+            Cabana::Benchmark::writeRecord( stream, ips_name, "cells_per_dim",
+                                            cells_per_dim[n], comm_size, ips,
+                                            ips, ips, { ips } );
+    }
+    if ( 0 == comm_rank )
+        stream << std::flush;
+}
+
+//---------------------------------------------------------------------------//
+// main
+int main( int argc, char* argv[] )
+{
+    // Initialize environment
+    MPI_Init( &argc, &argv );
+    Kokkos::initialize( argc, argv );
+
+    // Check arguments.
+    if ( argc < 2 )
+        throw std::runtime_error( "Incorrect number of arguments. \n \
+             First argument - file name for output (.json or .csv for \n \
+             machine-readable output) \n \
+             \n \
+             Example: \n \
+             $/: ./StructuredSolverPerformance test_results.txt\n" );
+
+    // Get the name of the output file.
+    std::string filename = argv[1];
+    Cabana::Benchmark::setOutputFormat( filename );
+
+    // Get comm rank;
+    int comm_rank;
+    MPI_Comm_rank( MPI_COMM_WORLD, &comm_rank );
+
+    // Open the output file on rank 0.
+    std::fstream file;
+    if ( 0 == comm_rank )
+        file.open( filename, std::fstream::out );
+    Cabana::Benchmark::outputMetadata( file, "StructuredSolverPerformance",
+                                       MPI_COMM_WORLD );
+
+    // Run the tests.
+#ifdef KOKKOS_ENABLE_SERIAL
+    using SerialDevice = Kokkos::Device<Kokkos::Serial, Kokkos::HostSpace>;
+    performanceTest<SerialDevice>( file, "serial_" );
+#endif
+
+#ifdef KOKKOS_ENABLE_OPENMP
+    using OpenMPDevice = Kokkos::Device<Kokkos::OpenMP, Kokkos::HostSpace>;
+    performanceTest<OpenMPDevice>( file, "openmp_" );
+#endif
+
+#ifdef KOKKOS_ENABLE_CUDA
+    using CudaDevice = Kokkos::Device<Kokkos::Cuda, Kokkos::CudaSpace>;
+    performanceTest<CudaDevice>( file, "cuda_" );
+#endif
+
+    // Close the output file on rank 0.
+    if ( 0 == comm_rank )
+        file.close();
+
+    // Finalize
+    Kokkos::finalize();
+    MPI_Finalize();
+    return 0;
+}
+
+//---------------------------------------------------------------------------//
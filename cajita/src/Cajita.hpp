@@ -18,24 +18,35 @@
 
 #include <Cajita_Config.hpp>
 
+#include <Cajita_AdaptiveMesh.hpp>
 #include <Cajita_Array.hpp>
 #include <Cajita_BovWriter.hpp>
+#include <Cajita_Checkpoint.hpp>
 #include <Cajita_GlobalGrid.hpp>
 #include <Cajita_GlobalMesh.hpp>
 #include <Cajita_Halo.hpp>
 #include <Cajita_IndexConversion.hpp>
 #include <Cajita_IndexSpace.hpp>
 #include <Cajita_Interpolation.hpp>
+#include <Cajita_LoadBalancer.hpp>
 #include <Cajita_LocalGrid.hpp>
 #include <Cajita_LocalMesh.hpp>
 #include <Cajita_ManualPartitioner.hpp>
 #include <Cajita_MpiTraits.hpp>
+#include <Cajita_OccupancyHalo.hpp>
 #include <Cajita_Parallel.hpp>
 #include <Cajita_ParticleGridDistributor.hpp>
+#include <Cajita_ParticleGridHalo.hpp>
 #include <Cajita_Partitioner.hpp>
+#include <Cajita_ReferenceBatchedSolver.hpp>
+#include <Cajita_ReferenceMultigrid.hpp>
 #include <Cajita_ReferenceStructuredSolver.hpp>
+#include <Cajita_SolverTelemetry.hpp>
+#include <Cajita_SparseArray.hpp>
+#include <Cajita_SparseCurvePartitioner.hpp>
 #include <Cajita_SparseDimPartitioner.hpp>
 #include <Cajita_SparseIndexSpace.hpp>
+#include <Cajita_SparseInterpolation.hpp>
 #include <Cajita_Splines.hpp>
 #include <Cajita_Types.hpp>
 #include <Cajita_UniformDimPartitioner.hpp>
@@ -47,7 +58,17 @@
 #ifdef Cabana_ENABLE_HEFFTE
 #ifndef KOKKOS_ENABLE_HIP // FIXME_HIP
 #include <Cajita_FastFourierTransform.hpp>
+#include <Cajita_PPPMSolver.hpp>
+#include <Cajita_SpectralPoissonSolver.hpp>
 #endif
 #endif
 
+#ifdef Cabana_ENABLE_HDF5
+#include <Cajita_HDF5ArrayIO.hpp>
+#endif
+
+#ifdef Cabana_ENABLE_CONDUIT
+#include <Cajita_ConduitBlueprint.hpp>
+#endif
+
 #endif // end CAJITA_HPP
@@ -0,0 +1,668 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cajita_AdaptiveMesh.hpp
+  \brief Block-structured adaptive mesh refinement on sparse tiles
+*/
+#ifndef CAJITA_ADAPTIVEMESH_HPP
+#define CAJITA_ADAPTIVEMESH_HPP
+
+#include <Cajita_GlobalGrid.hpp>
+#include <Cajita_GlobalMesh.hpp>
+#include <Cajita_LocalGrid.hpp>
+#include <Cajita_ManualPartitioner.hpp>
+#include <Cajita_Partitioner.hpp>
+#include <Cajita_SparseArray.hpp>
+#include <Cajita_SparseIndexSpace.hpp>
+#include <Cajita_Types.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <array>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Cajita
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief Hierarchy of refinement levels of a three dimensional mesh.
+
+  \tparam MemorySpace Memory space of the sparse maps.
+  \tparam CellPerTileDim Number of cells in each tile per dimension.
+
+  Every level covers the same domain and halves the cell size of the level
+  below it. The refined regions of a level are the tiles registered in its
+  sparse map: the coarsest level registers all owned tiles and finer levels
+  only the tiles activated by refine(). The blocks of a finer level are the
+  refined blocks of the coarsest level, so every rank owns the same region
+  of the domain on all levels and the levels stay nested on each rank.
+
+  The blocks of the coarsest level must align with the tiles.
+*/
+template <class MemorySpace, unsigned long long CellPerTileDim = 4>
+class AdaptiveMesh
+{
+  public:
+    //! Kokkos memory space.
+    using memory_space = MemorySpace;
+    //! Default execution space.
+    using execution_space = typename memory_space::execution_space;
+    //! Mesh type of each level.
+    using mesh_type = SparseMesh<double, 3>;
+    //! Local grid type of each level.
+    using local_grid_type = LocalGrid<mesh_type>;
+    //! Sparse map type of each level.
+    using sparse_map_type = SparseMap<MemorySpace, CellPerTileDim>;
+    //! Ratio of the cell sizes of successive levels.
+    static constexpr int refinement_ratio = 2;
+    //! Number of bits indexing the cells inside a tile per dimension.
+    static constexpr int cell_bits_per_tile_dim =
+        sparse_map_type::cell_bits_per_tile_dim;
+    //! Number of cells inside a tile per dimension.
+    static constexpr int cell_num_per_tile_dim =
+        sparse_map_type::cell_num_per_tile_dim;
+
+    /*!
+      \brief Constructor.
+      \param comm The communicator over which to define the mesh.
+      \param global_low_corner The low corner of the domain.
+      \param global_high_corner The high corner of the domain.
+      \param global_num_cell The number of cells of the coarsest level.
+      \param periodic Whether each logical dimension is periodic.
+      \param partitioner The partitioner of the coarsest level.
+      \param num_level The number of levels, including the coarsest.
+      \param pre_alloc_size Expected number of tiles of each level.
+    */
+    AdaptiveMesh( MPI_Comm comm,
+                  const std::array<double, 3>& global_low_corner,
+                  const std::array<double, 3>& global_high_corner,
+                  const std::array<int, 3>& global_num_cell,
+                  const std::array<bool, 3>& periodic,
+                  const BlockPartitioner<3>& partitioner, const int num_level,
+                  const int pre_alloc_size = 64 )
+    {
+        if ( num_level < 1 )
+            throw std::runtime_error( "AdaptiveMesh requires a level" );
+
+        // Coarsest level.
+        auto coarse_mesh = createSparseGlobalMesh(
+            global_low_corner, global_high_corner, global_num_cell );
+        auto coarse_grid =
+            createGlobalGrid( comm, coarse_mesh, periodic, partitioner );
+        std::array<int, 3> ranks_per_dim;
+        std::array<int, 3> num_cell;
+        std::array<int, 3> offset;
+        for ( int d = 0; d < 3; ++d )
+        {
+            ranks_per_dim[d] = coarse_grid->dimNumBlock( d );
+            num_cell[d] = coarse_grid->ownedNumCell( d );
+            offset[d] = coarse_grid->globalOffset( d );
+            if ( num_cell[d] % cell_num_per_tile_dim ||
+                 offset[d] % cell_num_per_tile_dim )
+                throw std::runtime_error(
+                    "AdaptiveMesh blocks must align with the tiles" );
+        }
+        _local_grids.push_back(
+            createLocalGrid( coarse_grid, cell_num_per_tile_dim ) );
+
+        // Finer levels refine the blocks of the coarsest level.
+        ManualPartitioner level_partitioner( ranks_per_dim );
+        for ( int l = 1; l < num_level; ++l )
+        {
+            std::array<int, 3> level_num_cell;
+            for ( int d = 0; d < 3; ++d )
+            {
+                level_num_cell[d] = global_num_cell[d] * ( 1 << l );
+                num_cell[d] *= refinement_ratio;
+                offset[d] *= refinement_ratio;
+            }
+            auto mesh = createSparseGlobalMesh(
+                global_low_corner, global_high_corner, level_num_cell );
+            auto grid = createGlobalGrid( coarse_grid->comm(), mesh, periodic,
+                                          level_partitioner );
+            for ( int d = 0; d < 3; ++d )
+                if ( grid->dimBlockId( d ) != coarse_grid->dimBlockId( d ) )
+                    throw std::runtime_error(
+                        "AdaptiveMesh levels have different rank layouts" );
+            grid->setNumCellAndOffset( num_cell, offset );
+            _local_grids.push_back(
+                createLocalGrid( grid, cell_num_per_tile_dim ) );
+        }
+
+        // Create the sparse map of each level.
+        for ( int l = 0; l < num_level; ++l )
+        {
+            std::array<int, 3> size;
+            for ( int d = 0; d < 3; ++d )
+                size[d] = global_num_cell[d] * ( 1 << l );
+            _maps.push_back(
+                std::make_shared<sparse_map_type>( size, pre_alloc_size ) );
+        }
+
+        // The coarsest level covers the owned blocks.
+        Kokkos::Array<int, 3> tile_offset;
+        Kokkos::Array<int, 3> num_tile;
+        for ( int d = 0; d < 3; ++d )
+        {
+            tile_offset[d] = coarse_grid->globalOffset( d ) >>
+                             cell_bits_per_tile_dim;
+            num_tile[d] = coarse_grid->ownedNumCell( d ) >>
+                          cell_bits_per_tile_dim;
+        }
+        int total_tile = num_tile[0] * num_tile[1] * num_tile[2];
+        _maps[0]->reserve( total_tile );
+        auto map = *_maps[0];
+        Kokkos::parallel_for(
+            "Cajita::AdaptiveMesh::insertCoarse",
+            Kokkos::RangePolicy<execution_space>( 0, total_tile ),
+            KOKKOS_LAMBDA( const int n ) {
+                map.insertTile( tile_offset[0] + n % num_tile[0],
+                                tile_offset[1] + ( n / num_tile[0] ) %
+                                                     num_tile[1],
+                                tile_offset[2] +
+                                    n / ( num_tile[0] * num_tile[1] ) );
+            } );
+        Kokkos::fence();
+    }
+
+    //! Get the number of levels.
+    int numLevel() const { return _maps.size(); }
+
+    //! Get the local grid of a level.
+    const std::shared_ptr<local_grid_type>& localGrid( const int level ) const
+    {
+        return _local_grids[level];
+    }
+
+    //! Get the sparse map registering the tiles of a level.
+    const std::shared_ptr<sparse_map_type>& map( const int level ) const
+    {
+        return _maps[level];
+    }
+
+    //! Get the low corner of the domain in a given dimension.
+    double lowCorner( const int dim ) const
+    {
+        return _local_grids[0]->globalGrid().globalMesh().lowCorner( dim );
+    }
+
+    //! Get the cell size of a level in a given dimension.
+    double cellSize( const int level, const int dim ) const
+    {
+        return _local_grids[level]->globalGrid().globalMesh().cellSize( dim );
+    }
+
+    /*!
+      \brief Refine cells of a level.
+
+      The tiles of the next finer level covering the children of the cells
+      are activated. The tiles of the intermediate levels containing the
+      cells are activated as well such that the levels stay nested.
+
+      \param exec_space Execution space.
+      \param level The level of the cells. Must be coarser than the finest
+      level.
+      \param cells Global indices of the cells on the level, (cell, dim).
+      The cells should be owned by this rank.
+    */
+    template <class ExecutionSpace, class CellView>
+    void refine( const ExecutionSpace& exec_space, const int level,
+                 const CellView& cells )
+    {
+        if ( level < 0 || level + 1 >= numLevel() )
+            throw std::runtime_error( "Cannot refine the finest level" );
+
+        // The index of a cell on level l is the index of its first child on
+        // level + 1 shifted by the difference of the levels.
+        int num_cell = cells.extent( 0 );
+        for ( int l = level + 1; l > 0; --l )
+        {
+            _maps[l]->reserve( _maps[l]->size() + num_cell );
+            auto map = *_maps[l];
+            int shift = level + 1 - l;
+            Kokkos::parallel_for(
+                "Cajita::AdaptiveMesh::refine",
+                Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_cell ),
+                KOKKOS_LAMBDA( const int n ) {
+                    map.insertCell( ( refinement_ratio * cells( n, 0 ) ) >>
+                                        shift,
+                                    ( refinement_ratio * cells( n, 1 ) ) >>
+                                        shift,
+                                    ( refinement_ratio * cells( n, 2 ) ) >>
+                                        shift );
+                } );
+        }
+        exec_space.fence();
+    }
+
+  private:
+    std::vector<std::shared_ptr<local_grid_type>> _local_grids;
+    std::vector<std::shared_ptr<sparse_map_type>> _maps;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create an adaptive mesh.
+  \param comm The communicator over which to define the mesh.
+  \param global_low_corner The low corner of the domain.
+  \param global_high_corner The high corner of the domain.
+  \param global_num_cell The number of cells of the coarsest level.
+  \param periodic Whether each logical dimension is periodic.
+  \param partitioner The partitioner of the coarsest level.
+  \param num_level The number of levels, including the coarsest.
+  \param pre_alloc_size Expected number of tiles of each level.
+*/
+template <class MemorySpace, unsigned long long CellPerTileDim = 4>
+std::shared_ptr<AdaptiveMesh<MemorySpace, CellPerTileDim>>
+createAdaptiveMesh( MPI_Comm comm,
+                    const std::array<double, 3>& global_low_corner,
+                    const std::array<double, 3>& global_high_corner,
+                    const std::array<int, 3>& global_num_cell,
+                    const std::array<bool, 3>& periodic,
+                    const BlockPartitioner<3>& partitioner,
+                    const int num_level, const int pre_alloc_size = 64 )
+{
+    return std::make_shared<AdaptiveMesh<MemorySpace, CellPerTileDim>>(
+        comm, global_low_corner, global_high_corner, global_num_cell, periodic,
+        partitioner, num_level, pre_alloc_size );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Field data on all levels of an adaptive mesh.
+
+  \tparam Scalar Field value type.
+  \tparam DeviceType Device type the data is allocated on.
+  \tparam AdaptiveMeshType Adaptive mesh type.
+
+  Each level is a sparse array on the sparse map of the level. After
+  refining the mesh the array must be resized to allocate the new tiles.
+*/
+template <class Scalar, class DeviceType, class AdaptiveMeshType>
+class AdaptiveArray
+{
+  public:
+    //! Value type.
+    using value_type = Scalar;
+    //! Kokkos memory space.
+    using memory_space = typename DeviceType::memory_space;
+    //! Adaptive mesh type.
+    using mesh_type = AdaptiveMeshType;
+    //! Sparse array type of each level.
+    using array_type =
+        SparseArray<Scalar, DeviceType,
+                    typename AdaptiveMeshType::sparse_map_type>;
+
+    /*!
+      \brief Constructor.
+      \param label Array label.
+      \param mesh Adaptive mesh.
+      \param dofs_per_cell Number of degrees of freedom in each cell.
+    */
+    AdaptiveArray( const std::string& label,
+                   const std::shared_ptr<mesh_type>& mesh,
+                   const int dofs_per_cell )
+        : _mesh( mesh )
+    {
+        for ( int l = 0; l < _mesh->numLevel(); ++l )
+            _levels.push_back( std::make_shared<array_type>(
+                label + "_level_" + std::to_string( l ), _mesh->map( l ),
+                dofs_per_cell ) );
+    }
+
+    //! Get the adaptive mesh.
+    const std::shared_ptr<mesh_type>& mesh() const { return _mesh; }
+
+    //! Get the number of levels.
+    int numLevel() const { return _levels.size(); }
+
+    //! Get the sparse array of a level.
+    array_type& level( const int level ) { return *_levels[level]; }
+
+    //! Get the sparse array of a level.
+    const array_type& level( const int level ) const
+    {
+        return *_levels[level];
+    }
+
+    //! Allocate the tiles activated on any level since the last resize.
+    void resize()
+    {
+        for ( auto& array : _levels )
+            array->resize();
+    }
+
+  private:
+    std::shared_ptr<mesh_type> _mesh;
+    std::vector<std::shared_ptr<array_type>> _levels;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create an adaptive array.
+  \param label Array label.
+  \param mesh Adaptive mesh.
+  \param dofs_per_cell Number of degrees of freedom in each cell.
+*/
+template <class Scalar, class DeviceType, class AdaptiveMeshType>
+std::shared_ptr<AdaptiveArray<Scalar, DeviceType, AdaptiveMeshType>>
+createAdaptiveArray( const std::string& label,
+                     const std::shared_ptr<AdaptiveMeshType>& mesh,
+                     const int dofs_per_cell )
+{
+    return std::make_shared<
+        AdaptiveArray<Scalar, DeviceType, AdaptiveMeshType>>( label, mesh,
+                                                              dofs_per_cell );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Halo exchange of the ghost tiles of every level of an adaptive
+  array.
+*/
+template <class AdaptiveArrayType>
+class AdaptiveHalo
+{
+  public:
+    //! Adaptive array type.
+    using array_type = AdaptiveArrayType;
+    //! Sparse halo type of each level.
+    using halo_type =
+        SparseHalo<typename array_type::value_type,
+                   typename array_type::array_type::device_type,
+                   typename array_type::array_type::sparse_map_type>;
+
+    /*!
+      \brief Constructor.
+      \param mesh The adaptive mesh the arrays are defined on.
+    */
+    AdaptiveHalo( const typename array_type::mesh_type& mesh )
+    {
+        for ( int l = 0; l < mesh.numLevel(); ++l )
+            _halos.push_back(
+                std::make_shared<halo_type>( *mesh.localGrid( l ) ) );
+    }
+
+    /*!
+      \brief Gather the ghost tiles of every level.
+      \param exec_space The execution space to use for packing.
+      \param array The array to gather. Received ghost tiles are registered
+      in the sparse map of their level.
+    */
+    template <class ExecutionSpace>
+    void gather( const ExecutionSpace& exec_space, array_type& array ) const
+    {
+        for ( int l = 0; l < array.numLevel(); ++l )
+            _halos[l]->gather( exec_space, array.level( l ) );
+    }
+
+  private:
+    std::vector<std::shared_ptr<halo_type>> _halos;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create a halo for adaptive arrays.
+  \param array An adaptive array the halo will exchange.
+*/
+template <class Scalar, class DeviceType, class AdaptiveMeshType>
+std::shared_ptr<
+    AdaptiveHalo<AdaptiveArray<Scalar, DeviceType, AdaptiveMeshType>>>
+createAdaptiveHalo(
+    const AdaptiveArray<Scalar, DeviceType, AdaptiveMeshType>& array )
+{
+    return std::make_shared<
+        AdaptiveHalo<AdaptiveArray<Scalar, DeviceType, AdaptiveMeshType>>>(
+        *array.mesh() );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Restrict a level onto the next coarser level.
+
+  Every coarse cell with refined children is set to the average of its
+  children. Other coarse cells are unchanged.
+
+  \param exec_space Execution space.
+  \param array The adaptive array.
+  \param level The fine level. Must be finer than the coarsest level.
+*/
+template <class ExecutionSpace, class AdaptiveArrayType>
+void restrictLevel( const ExecutionSpace& exec_space,
+                    AdaptiveArrayType& array, const int level )
+{
+    constexpr int cell_bits =
+        AdaptiveArrayType::mesh_type::cell_bits_per_tile_dim;
+    constexpr int ratio = AdaptiveArrayType::mesh_type::refinement_ratio;
+    auto fine = array.level( level ).sparseView();
+    auto coarse = array.level( level - 1 ).sparseView();
+    int dofs = array.level( level ).dofsPerCell();
+    double scale = 1.0 / ( ratio * ratio * ratio );
+    sparse_grid_parallel_for(
+        "Cajita::restrictLevel", exec_space, coarse.map,
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            int fi = ratio * i;
+            int fj = ratio * j;
+            int fk = ratio * k;
+            if ( !fine.map.tileExists( fi >> cell_bits, fj >> cell_bits,
+                                       fk >> cell_bits ) )
+                return;
+            for ( int d = 0; d < dofs; ++d )
+            {
+                typename AdaptiveArrayType::value_type sum = 0;
+                for ( int ci = 0; ci < ratio; ++ci )
+                    for ( int cj = 0; cj < ratio; ++cj )
+                        for ( int ck = 0; ck < ratio; ++ck )
+                            sum += fine( fi + ci, fj + cj, fk + ck, d );
+                coarse( i, j, k, d ) = scale * sum;
+            }
+        } );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Prolong the next coarser level onto a level.
+
+  Every cell of the active tiles of the level takes the value of its parent
+  (piecewise constant). Cells whose parent tile is not present, e.g. ghost
+  tiles at the edge of the coarse ghost region, are unchanged.
+
+  \param exec_space Execution space.
+  \param array The adaptive array.
+  \param level The fine level. Must be finer than the coarsest level.
+*/
+template <class ExecutionSpace, class AdaptiveArrayType>
+void prolongLevel( const ExecutionSpace& exec_space, AdaptiveArrayType& array,
+                   const int level )
+{
+    constexpr int cell_bits =
+        AdaptiveArrayType::mesh_type::cell_bits_per_tile_dim;
+    constexpr int ratio = AdaptiveArrayType::mesh_type::refinement_ratio;
+    auto fine = array.level( level ).sparseView();
+    auto coarse = array.level( level - 1 ).sparseView();
+    int dofs = array.level( level ).dofsPerCell();
+    sparse_grid_parallel_for(
+        "Cajita::prolongLevel", exec_space, fine.map,
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            int ci = i / ratio;
+            int cj = j / ratio;
+            int ck = k / ratio;
+            if ( !coarse.map.tileExists( ci >> cell_bits, cj >> cell_bits,
+                                         ck >> cell_bits ) )
+                return;
+            for ( int d = 0; d < dofs; ++d )
+                fine( i, j, k, d ) = coarse( ci, cj, ck, d );
+        } );
+}
+
+namespace Impl
+{
+//! \cond Impl
+// Geometry of a level needed to locate particles on the device.
+struct AdaptiveLevelGeometry
+{
+    Kokkos::Array<double, 3> low_corner;
+    Kokkos::Array<double, 3> inv_cell_size;
+    Kokkos::Array<int, 3> num_cell;
+    Kokkos::Array<bool, 3> periodic;
+};
+
+template <class AdaptiveMeshType>
+AdaptiveLevelGeometry adaptiveLevelGeometry( const AdaptiveMeshType& mesh,
+                                             const int level )
+{
+    AdaptiveLevelGeometry geom;
+    const auto& global_grid = mesh.localGrid( level )->globalGrid();
+    for ( int d = 0; d < 3; ++d )
+    {
+        geom.low_corner[d] = mesh.lowCorner( d );
+        geom.inv_cell_size[d] = 1.0 / mesh.cellSize( level, d );
+        geom.num_cell[d] = global_grid.globalNumEntity( Cell(), d );
+        geom.periodic[d] = global_grid.isPeriodic( d );
+    }
+    return geom;
+}
+
+// Global cell of a particle on a level. Cells across a periodic boundary
+// are wrapped to the indices of their owner. Returns false for positions
+// outside the domain.
+template <class PositionType>
+KOKKOS_INLINE_FUNCTION bool
+adaptiveParticleCell( const PositionType& positions, const int p,
+                      const AdaptiveLevelGeometry& geom, int cell[3] )
+{
+    for ( int d = 0; d < 3; ++d )
+    {
+        double x =
+            ( positions( p, d ) - geom.low_corner[d] ) * geom.inv_cell_size[d];
+        cell[d] = static_cast<int>( x );
+        if ( cell[d] > x )
+            --cell[d];
+        if ( cell[d] < 0 || cell[d] >= geom.num_cell[d] )
+        {
+            if ( !geom.periodic[d] )
+                return false;
+            cell[d] = ( cell[d] % geom.num_cell[d] + geom.num_cell[d] ) %
+                      geom.num_cell[d];
+        }
+    }
+    return true;
+}
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Deposit a particle quantity onto the finest level covering each
+  particle.
+
+  Each particle adds its value to the cell containing it on the finest level
+  with an active tile at its position (nearest grid point). Particles should
+  be owned by this rank such that their cells are owned as well.
+
+  \param exec_space Execution space.
+  \param positions Particle positions, (particle, dim).
+  \param values Particle values, (particle).
+  \param array The adaptive array receiving the deposit.
+  \param dof The degree of freedom of the array to deposit into.
+*/
+template <class ExecutionSpace, class PositionType, class ValueType,
+          class AdaptiveArrayType>
+void adaptiveP2G( const ExecutionSpace& exec_space,
+                  const PositionType& positions, const ValueType& values,
+                  AdaptiveArrayType& array, const int dof = 0 )
+{
+    constexpr int cell_bits =
+        AdaptiveArrayType::mesh_type::cell_bits_per_tile_dim;
+    int num_p = values.size();
+    Kokkos::View<int*, typename AdaptiveArrayType::memory_space> placed(
+        "placed", num_p );
+    for ( int l = array.numLevel() - 1; l >= 0; --l )
+    {
+        auto level = array.level( l ).sparseView();
+        auto geom = Impl::adaptiveLevelGeometry( *array.mesh(), l );
+        Kokkos::parallel_for(
+            "Cajita::adaptiveP2G",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_p ),
+            KOKKOS_LAMBDA( const int p ) {
+                int c[3];
+                if ( placed( p ) ||
+                     !Impl::adaptiveParticleCell( positions, p, geom, c ) ||
+                     !level.map.tileExists( c[0] >> cell_bits,
+                                            c[1] >> cell_bits,
+                                            c[2] >> cell_bits ) )
+                    return;
+                Kokkos::atomic_add( &level( c[0], c[1], c[2], dof ),
+                                    values( p ) );
+                placed( p ) = 1;
+            } );
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Interpolate a grid quantity to particles from the finest level
+  covering each particle.
+
+  Each particle takes the value of the cell containing it on the finest
+  level with an active tile at its position (nearest grid point). Ghost
+  tiles are read, so the array should be gathered first.
+
+  \param exec_space Execution space.
+  \param array The adaptive array to interpolate.
+  \param positions Particle positions, (particle, dim).
+  \param values Particle values, (particle).
+  \param dof The degree of freedom of the array to interpolate.
+*/
+template <class ExecutionSpace, class AdaptiveArrayType, class PositionType,
+          class ValueType>
+void adaptiveG2P( const ExecutionSpace& exec_space,
+                  const AdaptiveArrayType& array,
+                  const PositionType& positions, const ValueType& values,
+                  const int dof = 0 )
+{
+    constexpr int cell_bits =
+        AdaptiveArrayType::mesh_type::cell_bits_per_tile_dim;
+    int num_p = values.size();
+    Kokkos::View<int*, typename AdaptiveArrayType::memory_space> placed(
+        "placed", num_p );
+    for ( int l = array.numLevel() - 1; l >= 0; --l )
+    {
+        auto level = array.level( l ).sparseView();
+        auto geom = Impl::adaptiveLevelGeometry( *array.mesh(), l );
+        Kokkos::parallel_for(
+            "Cajita::adaptiveG2P",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_p ),
+            KOKKOS_LAMBDA( const int p ) {
+                int c[3];
+                if ( placed( p ) ||
+                     !Impl::adaptiveParticleCell( positions, p, geom, c ) ||
+                     !level.map.tileExists( c[0] >> cell_bits,
+                                            c[1] >> cell_bits,
+                                            c[2] >> cell_bits ) )
+                    return;
+                values( p ) = level( c[0], c[1], c[2], dof );
+                placed( p ) = 1;
+            } );
+    }
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cajita
+
+#endif // end CAJITA_ADAPTIVEMESH_HPP
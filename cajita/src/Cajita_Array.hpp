@@ -25,6 +25,7 @@
 
 #include <cmath>
 #include <memory>
+#include <string>
 #include <type_traits>
 #include <vector>
 
@@ -211,6 +212,61 @@ createArrayLayout( const std::shared_ptr<GlobalGrid<MeshType>>& global_grid,
         createLocalGrid( global_grid, halo_cell_width ), dofs_per_entity );
 }
 
+//---------------------------------------------------------------------------//
+// Array degree-of-freedom layouts.
+//---------------------------------------------------------------------------//
+//! View layout of arrays storing the degrees of freedom of each entity
+//! innermost, interleaving the components of a field.
+using DofInnermost = Kokkos::LayoutRight;
+
+//! View layout of arrays storing the degrees of freedom outermost. The
+//! entities of each degree of freedom are contiguous in LayoutRight order.
+using DofOutermost = Kokkos::LayoutStride;
+
+//! \cond Impl
+namespace Impl
+{
+// Create the view of an array over an index space.
+template <class ViewType, class Scalar, class... Params, long N>
+std::enable_if_t<!std::is_same<typename ViewType::array_layout,
+                               Kokkos::LayoutStride>::value,
+                 ViewType>
+createArrayView( const std::string& label, const IndexSpace<N>& space )
+{
+    return createView<Scalar, Params...>( label, space );
+}
+
+// Create the view of an array storing the degrees of freedom outermost.
+template <class ViewType, class Scalar, class... Params, long N>
+std::enable_if_t<std::is_same<typename ViewType::array_layout,
+                              Kokkos::LayoutStride>::value,
+                 ViewType>
+createArrayView( const std::string& label, const IndexSpace<N>& space )
+{
+    // Order the dimensions by increasing stride.
+    int order[N];
+    long extents[N];
+    for ( long d = 0; d < N - 1; ++d )
+        order[d] = N - 2 - d;
+    order[N - 1] = N - 1;
+    for ( long d = 0; d < N; ++d )
+        extents[d] = space.extent( d );
+    return ViewType(
+        Kokkos::ViewAllocateWithoutInitializing( label ),
+        Kokkos::LayoutStride::order_dimensions( N, order, extents ) );
+}
+
+// Whether the view of an array stores the degrees of freedom outermost.
+template <class ViewType>
+bool dofsOutermost( const ViewType& view )
+{
+    return ( view.extent( ViewType::rank - 1 ) > 1 &&
+             view.stride( ViewType::rank - 1 ) >
+                 view.stride( ViewType::rank - 2 ) );
+}
+} // end namespace Impl
+//! \endcond
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Array of field data on the local mesh.
@@ -218,7 +274,11 @@ createArrayLayout( const std::shared_ptr<GlobalGrid<MeshType>>& global_grid,
   \tparam Scalar Scalar type.
   \tparam EntityType Array entity type (node, cell, face, edge).
   \tparam MeshType Mesh type (uniform, non-uniform, sparse).
-  \tparam Params Kokkos View parameters.
+  \tparam Params Kokkos View parameters. The view layout selects the storage
+  order of the degrees of freedom: DofInnermost (Kokkos::LayoutRight) stores
+  the degrees of freedom of each entity together while DofOutermost stores
+  each degree of freedom as a contiguous block over the entities, which suits
+  component-wise kernels.
 */
 template <class Scalar, class EntityType, class MeshType, class... Params>
 class Array
@@ -263,7 +323,7 @@ class Array
     Array( const std::string& label,
            const std::shared_ptr<array_layout>& layout )
         : _layout( layout )
-        , _data( createView<value_type, Params...>(
+        , _data( Impl::createArrayView<view_type, value_type, Params...>(
               label, layout->indexSpace( Ghost(), Local() ) ) )
     {
     }
@@ -294,6 +354,9 @@ class Array
     //! Get the array label.
     std::string label() const { return _data.label(); }
 
+    //! Whether the degrees of freedom are stored outermost.
+    bool dofsOutermost() const { return Impl::dofsOutermost( _data ); }
+
   private:
     std::shared_ptr<array_layout> _layout;
     view_type _data;
@@ -693,6 +756,148 @@ update( Array_t& a, const typename Array_t::value_type alpha, const Array_t& b,
         } );
 }
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief Handle for a non-blocking global reduction of array values.
+
+  Returned by the split-phase array reductions (e.g. dotStart). The local
+  contribution has been computed and the global reduction posted with
+  MPI_Iallreduce when the request is returned, such that kernels launched
+  before calling wait() overlap with the reduction latency.
+
+  \note Requests may be moved but not copied. A request that is destroyed
+  before it is complete waits for the reduction in its destructor.
+*/
+template <class Scalar>
+class ReductionRequest
+{
+  public:
+    //! Value type.
+    using value_type = Scalar;
+
+    //! Default constructor. Creates an inactive request.
+    ReductionRequest()
+        : _request( MPI_REQUEST_NULL )
+        , _sqrt( false )
+        , _active( false )
+    {
+    }
+
+    /*!
+      \brief Constructor. Posts the reduction.
+
+      \param values The local values to reduce. Replaced by the global
+      values when the reduction completes.
+
+      \param op The reduction operation.
+
+      \param comm The communicator over which to reduce.
+
+      \param take_sqrt If true the square root of each reduced value is taken
+      when the reduction completes.
+    */
+    ReductionRequest( std::vector<Scalar>&& values, MPI_Op op, MPI_Comm comm,
+                      const bool take_sqrt = false )
+        : _values( std::move( values ) )
+        , _request( MPI_REQUEST_NULL )
+        , _sqrt( take_sqrt )
+        , _active( true )
+    {
+        MPI_Iallreduce( MPI_IN_PLACE, _values.data(), _values.size(),
+                        MpiTraits<Scalar>::type(), op, comm, &_request );
+    }
+
+    //! Move constructor.
+    ReductionRequest( ReductionRequest&& other )
+        : _values( std::move( other._values ) )
+        , _request( other._request )
+        , _sqrt( other._sqrt )
+        , _active( other._active )
+    {
+        other._request = MPI_REQUEST_NULL;
+        other._active = false;
+    }
+
+    //! Move assignment.
+    ReductionRequest& operator=( ReductionRequest&& other )
+    {
+        if ( this != &other )
+        {
+            if ( _active )
+                wait();
+            _values = std::move( other._values );
+            _request = other._request;
+            _sqrt = other._sqrt;
+            _active = other._active;
+            other._request = MPI_REQUEST_NULL;
+            other._active = false;
+        }
+        return *this;
+    }
+
+    ReductionRequest( const ReductionRequest& ) = delete;
+    ReductionRequest& operator=( const ReductionRequest& ) = delete;
+
+    //! Destructor. Completes the reduction if it is still in flight.
+    ~ReductionRequest()
+    {
+        if ( _active )
+            wait();
+    }
+
+    //! Determine if the reduction is still in flight.
+    bool active() const { return _active; }
+
+    /*!
+      \brief Check for completion of the reduction without blocking.
+
+      \return True if the reduction is complete and values() may be read.
+    */
+    bool test()
+    {
+        if ( !_active )
+            return true;
+        int flag = 0;
+        MPI_Test( &_request, &flag, MPI_STATUS_IGNORE );
+        if ( flag )
+            complete();
+        return !_active;
+    }
+
+    /*!
+      \brief Wait for the reduction to complete.
+
+      \return The reduced value of each entity degree-of-freedom.
+    */
+    const std::vector<Scalar>& wait()
+    {
+        if ( _active )
+        {
+            MPI_Wait( &_request, MPI_STATUS_IGNORE );
+            complete();
+        }
+        return _values;
+    }
+
+    //! Get the reduced values. Only valid once the reduction is complete.
+    const std::vector<Scalar>& values() const { return _values; }
+
+  private:
+    void complete()
+    {
+        if ( _sqrt )
+            for ( auto& v : _values )
+                v = std::sqrt( v );
+        _active = false;
+    }
+
+  private:
+    std::vector<Scalar> _values;
+    MPI_Request _request;
+    bool _sqrt;
+    bool _active;
+};
+
 //---------------------------------------------------------------------------//
 //! Dot product functor
 template <class ViewType, std::size_t NumSpaceDim>
@@ -761,17 +966,21 @@ struct DotFunctor
   array. This vector should be pre-sized to the number of degrees-of-freedom
   per entity.
 */
+/*!
+  \brief Start a non-blocking dot product of the owned space of two arrays.
+  \param a The first array in the dot product.
+  \param b The second array in the dot product.
+  \return A request holding the dot product of each entity degree-of-freedom
+  in the array once complete.
+*/
 template <class Array_t>
-void dot( const Array_t& a, const Array_t& b,
-          std::vector<typename Array_t::value_type>& products )
+ReductionRequest<typename Array_t::value_type> dotStart( const Array_t& a,
+                                                         const Array_t& b )
 {
     static_assert( is_array<Array_t>::value, "Cajita::Array required" );
-    if ( products.size() !=
-         static_cast<unsigned>( a.layout()->dofsPerEntity() ) )
-        throw std::runtime_error( "Incorrect vector size" );
 
-    for ( auto& p : products )
-        p = 0.0;
+    std::vector<typename Array_t::value_type> products(
+        a.layout()->dofsPerEntity(), 0.0 );
 
     DotFunctor<typename Array_t::view_type, Array_t::num_space_dim> functor(
         a.view(), b.view() );
@@ -781,9 +990,21 @@ void dot( const Array_t& a, const Array_t& b,
                                typename Array_t::execution_space() ),
         functor, products.data() );
 
-    MPI_Allreduce( MPI_IN_PLACE, products.data(), products.size(),
-                   MpiTraits<typename Array_t::value_type>::type(), MPI_SUM,
-                   a.layout()->localGrid()->globalGrid().comm() );
+    return ReductionRequest<typename Array_t::value_type>(
+        std::move( products ), MPI_SUM,
+        a.layout()->localGrid()->globalGrid().comm() );
+}
+
+template <class Array_t>
+void dot( const Array_t& a, const Array_t& b,
+          std::vector<typename Array_t::value_type>& products )
+{
+    static_assert( is_array<Array_t>::value, "Cajita::Array required" );
+    if ( products.size() !=
+         static_cast<unsigned>( a.layout()->dofsPerEntity() ) )
+        throw std::runtime_error( "Incorrect vector size" );
+
+    products = dotStart( a, b ).wait();
 }
 
 //---------------------------------------------------------------------------//
@@ -849,22 +1070,20 @@ struct NormInfFunctor
 };
 
 /*!
-  \brief Calculate the infinity-norm of the owned elements of the array.
+  \brief Start a non-blocking calculation of the infinity-norm of the owned
+  elements of the array.
   \param array The array to compute the norm for.
-  \param norms The norms for each degree-of-freedom in the array. This vector
-  should be pre-sized to the number of degrees-of-freedom per entity.
+  \return A request holding the norms for each degree-of-freedom in the
+  array once complete.
 */
 template <class Array_t>
-void normInf( const Array_t& array,
-              std::vector<typename Array_t::value_type>& norms )
+ReductionRequest<typename Array_t::value_type>
+normInfStart( const Array_t& array )
 {
     static_assert( is_array<Array_t>::value, "Cajita::Array required" );
-    if ( norms.size() !=
-         static_cast<unsigned>( array.layout()->dofsPerEntity() ) )
-        throw std::runtime_error( "Incorrect vector size" );
 
-    for ( auto& n : norms )
-        n = 0.0;
+    std::vector<typename Array_t::value_type> norms(
+        array.layout()->dofsPerEntity(), 0.0 );
 
     NormInfFunctor<typename Array_t::view_type, Array_t::num_space_dim> functor(
         array.view() );
@@ -874,9 +1093,27 @@ void normInf( const Array_t& array,
                                typename Array_t::execution_space() ),
         functor, norms.data() );
 
-    MPI_Allreduce( MPI_IN_PLACE, norms.data(), norms.size(),
-                   MpiTraits<typename Array_t::value_type>::type(), MPI_MAX,
-                   array.layout()->localGrid()->globalGrid().comm() );
+    return ReductionRequest<typename Array_t::value_type>(
+        std::move( norms ), MPI_MAX,
+        array.layout()->localGrid()->globalGrid().comm() );
+}
+
+/*!
+  \brief Calculate the infinity-norm of the owned elements of the array.
+  \param array The array to compute the norm for.
+  \param norms The norms for each degree-of-freedom in the array. This vector
+  should be pre-sized to the number of degrees-of-freedom per entity.
+*/
+template <class Array_t>
+void normInf( const Array_t& array,
+              std::vector<typename Array_t::value_type>& norms )
+{
+    static_assert( is_array<Array_t>::value, "Cajita::Array required" );
+    if ( norms.size() !=
+         static_cast<unsigned>( array.layout()->dofsPerEntity() ) )
+        throw std::runtime_error( "Incorrect vector size" );
+
+    norms = normInfStart( array ).wait();
 }
 
 //---------------------------------------------------------------------------//
@@ -937,22 +1174,20 @@ struct Norm1Functor
 };
 
 /*!
-  \brief Calculate the one-norm of the owned elements of the array.
+  \brief Start a non-blocking calculation of the one-norm of the owned
+  elements of the array.
   \param array The array to compute the norm for.
-  \param norms The norms for each degree-of-freedom in the array. This vector
-  should be pre-sized to the number of degrees-of-freedom per entity.
+  \return A request holding the norms for each degree-of-freedom in the
+  array once complete.
 */
 template <class Array_t>
-void norm1( const Array_t& array,
-            std::vector<typename Array_t::value_type>& norms )
+ReductionRequest<typename Array_t::value_type>
+norm1Start( const Array_t& array )
 {
     static_assert( is_array<Array_t>::value, "Cajita::Array required" );
-    if ( norms.size() !=
-         static_cast<unsigned>( array.layout()->dofsPerEntity() ) )
-        throw std::runtime_error( "Incorrect vector size" );
 
-    for ( auto& n : norms )
-        n = 0.0;
+    std::vector<typename Array_t::value_type> norms(
+        array.layout()->dofsPerEntity(), 0.0 );
 
     Norm1Functor<typename Array_t::view_type, Array_t::num_space_dim> functor(
         array.view() );
@@ -962,9 +1197,27 @@ void norm1( const Array_t& array,
                                typename Array_t::execution_space() ),
         functor, norms.data() );
 
-    MPI_Allreduce( MPI_IN_PLACE, norms.data(), norms.size(),
-                   MpiTraits<typename Array_t::value_type>::type(), MPI_SUM,
-                   array.layout()->localGrid()->globalGrid().comm() );
+    return ReductionRequest<typename Array_t::value_type>(
+        std::move( norms ), MPI_SUM,
+        array.layout()->localGrid()->globalGrid().comm() );
+}
+
+/*!
+  \brief Calculate the one-norm of the owned elements of the array.
+  \param array The array to compute the norm for.
+  \param norms The norms for each degree-of-freedom in the array. This vector
+  should be pre-sized to the number of degrees-of-freedom per entity.
+*/
+template <class Array_t>
+void norm1( const Array_t& array,
+            std::vector<typename Array_t::value_type>& norms )
+{
+    static_assert( is_array<Array_t>::value, "Cajita::Array required" );
+    if ( norms.size() !=
+         static_cast<unsigned>( array.layout()->dofsPerEntity() ) )
+        throw std::runtime_error( "Incorrect vector size" );
+
+    norms = norm1Start( array ).wait();
 }
 
 //---------------------------------------------------------------------------//
@@ -1024,6 +1277,35 @@ struct Norm2Functor
     }
 };
 
+/*!
+  \brief Start a non-blocking calculation of the two-norm of the owned
+  elements of the array.
+  \param array The array to compute the norm for.
+  \return A request holding the norms for each degree-of-freedom in the
+  array once complete.
+*/
+template <class Array_t>
+ReductionRequest<typename Array_t::value_type>
+norm2Start( const Array_t& array )
+{
+    static_assert( is_array<Array_t>::value, "Cajita::Array required" );
+
+    std::vector<typename Array_t::value_type> norms(
+        array.layout()->dofsPerEntity(), 0.0 );
+
+    Norm2Functor<typename Array_t::view_type, Array_t::num_space_dim> functor(
+        array.view() );
+    Kokkos::parallel_reduce(
+        "ArrayOp::norm2",
+        createExecutionPolicy( array.layout()->indexSpace( Own(), Local() ),
+                               typename Array_t::execution_space() ),
+        functor, norms.data() );
+
+    return ReductionRequest<typename Array_t::value_type>(
+        std::move( norms ), MPI_SUM,
+        array.layout()->localGrid()->globalGrid().comm(), true );
+}
+
 /*!
   \brief Calculate the two-norm of the owned elements of the array.
   \param array The array to compute the norm for.
@@ -1039,24 +1321,272 @@ void norm2( const Array_t& array,
          static_cast<unsigned>( array.layout()->dofsPerEntity() ) )
         throw std::runtime_error( "Incorrect vector size" );
 
-    for ( auto& n : norms )
-        n = 0.0;
+    norms = norm2Start( array ).wait();
+}
 
-    Norm2Functor<typename Array_t::view_type, Array_t::num_space_dim> functor(
-        array.view() );
+//---------------------------------------------------------------------------//
+//! Fused update and dot product functor
+template <class ViewType, std::size_t NumSpaceDim>
+struct UpdateDotFunctor
+{
+    //! Spatial dimension.
+    static constexpr std::size_t num_space_dim = NumSpaceDim;
+    //! Value type.
+    typedef typename ViewType::value_type value_type[];
+    //! Scalar type.
+    typedef typename ViewType::value_type scalar_type;
+    //! Size type.
+    typedef typename ViewType::size_type size_type;
+    //! Size of the array.
+    size_type value_count;
+    //! The array that is updated.
+    ViewType _a;
+    //! The array added to the updated array.
+    ViewType _b;
+    //! The array in the dot product with the updated array.
+    ViewType _c;
+    //! The value to scale the updated array by.
+    scalar_type _alpha;
+    //! The value to scale the added array by.
+    scalar_type _beta;
+
+    //! Constructor.
+    UpdateDotFunctor( const ViewType& a, const scalar_type alpha,
+                      const ViewType& b, const scalar_type beta,
+                      const ViewType& c )
+        : value_count( a.extent( NumSpaceDim ) )
+        , _a( a )
+        , _b( b )
+        , _c( c )
+        , _alpha( alpha )
+        , _beta( beta )
+    {
+    }
+
+    //! 3d update and dot product operation. The dot product is computed
+    //! with the updated value which is also used if c is the updated array.
+    template <std::size_t NSD = num_space_dim>
+    KOKKOS_INLINE_FUNCTION std::enable_if_t<3 == NSD, void>
+    operator()( const size_type i, const size_type j, const size_type k,
+                const size_type l, value_type sum ) const
+    {
+        _a( i, j, k, l ) = _alpha * _a( i, j, k, l ) + _beta * _b( i, j, k, l );
+        sum[l] += _a( i, j, k, l ) * _c( i, j, k, l );
+    }
+
+    //! 2d update and dot product operation.
+    template <std::size_t NSD = num_space_dim>
+    KOKKOS_INLINE_FUNCTION std::enable_if_t<2 == NSD, void>
+    operator()( const size_type i, const size_type j, const size_type l,
+                value_type sum ) const
+    {
+        _a( i, j, l ) = _alpha * _a( i, j, l ) + _beta * _b( i, j, l );
+        sum[l] += _a( i, j, l ) * _c( i, j, l );
+    }
+
+    //! Join operation.
+    KOKKOS_INLINE_FUNCTION
+    void join( volatile value_type dst, const volatile value_type src ) const
+    {
+        for ( size_type j = 0; j < value_count; ++j )
+            dst[j] += src[j];
+    }
+
+    //! Zero initialization.
+    KOKKOS_INLINE_FUNCTION void init( value_type sum ) const
+    {
+        for ( size_type j = 0; j < value_count; ++j )
+            sum[j] = 0.0;
+    }
+};
+
+/*!
+  \brief Update the owned space of an array such that a = alpha * a + beta * b
+  and compute the dot product of the updated array with another array in a
+  single pass.
+
+  This replaces an update() followed by a dot() with one kernel and one
+  reduction over the grid communicator. Only the owned entities of a are
+  updated.
+
+  \param a The array that will be updated.
+  \param alpha The value to scale a by.
+  \param b The array to add to a.
+  \param beta The value to scale b by.
+  \param c The array in the dot product with the updated a. May be a.
+  \param products The dot product of each entity degree-of-freedom in the
+  array. This vector should be pre-sized to the number of degrees-of-freedom
+  per entity.
+*/
+template <class Array_t>
+void updateAndDot( Array_t& a, const typename Array_t::value_type alpha,
+                   const Array_t& b, const typename Array_t::value_type beta,
+                   const Array_t& c,
+                   std::vector<typename Array_t::value_type>& products )
+{
+    static_assert( is_array<Array_t>::value, "Cajita::Array required" );
+    if ( products.size() !=
+         static_cast<unsigned>( a.layout()->dofsPerEntity() ) )
+        throw std::runtime_error( "Incorrect vector size" );
+
+    for ( auto& p : products )
+        p = 0.0;
+
+    UpdateDotFunctor<typename Array_t::view_type, Array_t::num_space_dim>
+        functor( a.view(), alpha, b.view(), beta, c.view() );
     Kokkos::parallel_reduce(
-        "ArrayOp::norm2",
-        createExecutionPolicy( array.layout()->indexSpace( Own(), Local() ),
+        "ArrayOp::updateAndDot",
+        createExecutionPolicy( a.layout()->indexSpace( Own(), Local() ),
                                typename Array_t::execution_space() ),
-        functor, norms.data() );
+        functor, products.data() );
 
-    MPI_Allreduce( MPI_IN_PLACE, norms.data(), norms.size(),
+    MPI_Allreduce( MPI_IN_PLACE, products.data(), products.size(),
                    MpiTraits<typename Array_t::value_type>::type(), MPI_SUM,
-                   array.layout()->localGrid()->globalGrid().comm() );
+                   a.layout()->localGrid()->globalGrid().comm() );
+}
+
+/*!
+  \brief Update the owned space of an array such that a = alpha * a + beta * b
+  and compute the two-norm of the updated array in a single pass.
 
+  \param a The array that will be updated.
+  \param alpha The value to scale a by.
+  \param b The array to add to a.
+  \param beta The value to scale b by.
+  \param norms The norms for each entity degree-of-freedom in the updated
+  array. This vector should be pre-sized to the number of degrees-of-freedom
+  per entity.
+
+  \see updateAndDot
+*/
+template <class Array_t>
+void updateAndNorm2( Array_t& a, const typename Array_t::value_type alpha,
+                     const Array_t& b, const typename Array_t::value_type beta,
+                     std::vector<typename Array_t::value_type>& norms )
+{
+    updateAndDot( a, alpha, b, beta, a, norms );
     for ( auto& n : norms )
         n = std::sqrt( n );
 }
+
+//---------------------------------------------------------------------------//
+//! Paired dot product functor
+template <class ViewType, std::size_t NumSpaceDim>
+struct DotPairFunctor
+{
+    //! Spatial dimension.
+    static constexpr std::size_t num_space_dim = NumSpaceDim;
+    //! Value type.
+    typedef typename ViewType::value_type value_type[];
+    //! Size type.
+    typedef typename ViewType::size_type size_type;
+    //! Size of the reduction. Both products of each degree-of-freedom.
+    size_type value_count;
+    //! Number of degrees-of-freedom per entity.
+    size_type _num_dof;
+    //! The first array in the first dot product.
+    ViewType _a;
+    //! The second array in the first dot product.
+    ViewType _b;
+    //! The first array in the second dot product.
+    ViewType _c;
+    //! The second array in the second dot product.
+    ViewType _d;
+
+    //! Constructor.
+    DotPairFunctor( const ViewType& a, const ViewType& b, const ViewType& c,
+                    const ViewType& d )
+        : value_count( 2 * a.extent( NumSpaceDim ) )
+        , _num_dof( a.extent( NumSpaceDim ) )
+        , _a( a )
+        , _b( b )
+        , _c( c )
+        , _d( d )
+    {
+    }
+
+    //! 3d paired dot product operation.
+    template <std::size_t NSD = num_space_dim>
+    KOKKOS_INLINE_FUNCTION std::enable_if_t<3 == NSD, void>
+    operator()( const size_type i, const size_type j, const size_type k,
+                const size_type l, value_type sum ) const
+    {
+        sum[l] += _a( i, j, k, l ) * _b( i, j, k, l );
+        sum[_num_dof + l] += _c( i, j, k, l ) * _d( i, j, k, l );
+    }
+
+    //! 2d paired dot product operation.
+    template <std::size_t NSD = num_space_dim>
+    KOKKOS_INLINE_FUNCTION std::enable_if_t<2 == NSD, void>
+    operator()( const size_type i, const size_type j, const size_type l,
+                value_type sum ) const
+    {
+        sum[l] += _a( i, j, l ) * _b( i, j, l );
+        sum[_num_dof + l] += _c( i, j, l ) * _d( i, j, l );
+    }
+
+    //! Join operation.
+    KOKKOS_INLINE_FUNCTION
+    void join( volatile value_type dst, const volatile value_type src ) const
+    {
+        for ( size_type j = 0; j < value_count; ++j )
+            dst[j] += src[j];
+    }
+
+    //! Zero initialization.
+    KOKKOS_INLINE_FUNCTION void init( value_type sum ) const
+    {
+        for ( size_type j = 0; j < value_count; ++j )
+            sum[j] = 0.0;
+    }
+};
+
+/*!
+  \brief Compute two dot products of the owned space of four arrays in a
+  single pass with a single reduction over the grid communicator.
+  \param a The first array in the first dot product.
+  \param b The second array in the first dot product.
+  \param c The first array in the second dot product.
+  \param d The second array in the second dot product.
+  \param products_ab The dot product of a and b for each entity
+  degree-of-freedom. This vector should be pre-sized to the number of
+  degrees-of-freedom per entity.
+  \param products_cd The dot product of c and d for each entity
+  degree-of-freedom. This vector should be pre-sized to the number of
+  degrees-of-freedom per entity.
+*/
+template <class Array_t>
+void dot( const Array_t& a, const Array_t& b, const Array_t& c,
+          const Array_t& d,
+          std::vector<typename Array_t::value_type>& products_ab,
+          std::vector<typename Array_t::value_type>& products_cd )
+{
+    static_assert( is_array<Array_t>::value, "Cajita::Array required" );
+    const std::size_t num_dof = a.layout()->dofsPerEntity();
+    if ( products_ab.size() != num_dof || products_cd.size() != num_dof )
+        throw std::runtime_error( "Incorrect vector size" );
+
+    std::vector<typename Array_t::value_type> products( 2 * num_dof, 0.0 );
+
+    DotPairFunctor<typename Array_t::view_type, Array_t::num_space_dim>
+        functor( a.view(), b.view(), c.view(), d.view() );
+    Kokkos::parallel_reduce(
+        "ArrayOp::dotPair",
+        createExecutionPolicy( a.layout()->indexSpace( Own(), Local() ),
+                               typename Array_t::execution_space() ),
+        functor, products.data() );
+
+    MPI_Allreduce( MPI_IN_PLACE, products.data(), products.size(),
+                   MpiTraits<typename Array_t::value_type>::type(), MPI_SUM,
+                   a.layout()->localGrid()->globalGrid().comm() );
+
+    for ( std::size_t n = 0; n < num_dof; ++n )
+    {
+        products_ab[n] = products[n];
+        products_cd[n] = products[num_dof + n];
+    }
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace ArrayOp
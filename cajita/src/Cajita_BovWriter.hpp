@@ -26,11 +26,18 @@
 
 #include <mpi.h>
 
+#include <algorithm>
 #include <array>
+#include <condition_variable>
+#include <deque>
 #include <fstream>
+#include <functional>
 #include <iomanip>
+#include <mutex>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <type_traits>
 
 namespace Cajita
@@ -164,10 +171,30 @@ reorderView( TargetView& target, const SourceView& source,
 
 //---------------------------------------------------------------------------//
 /*!
-  \brief Write a grid array to a VisIt BOV.
+  \brief Snapshot of the owned data of a grid array and its BOV metadata,
+  ready to be written independently of the array.
+*/
+template <class Scalar>
+struct BovSnapshot
+{
+    //! Owned data in KJI order in host memory.
+    Kokkos::View<Scalar*, Kokkos::HostSpace> data;
+    //! Committed MPI subarray type of the owned data in the global data.
+    MPI_Datatype subarray;
+    //! Data file name.
+    std::string data_file_name;
+    //! Header file name.
+    std::string header_file_name;
+    //! Header contents. Only set on rank 0.
+    std::string header;
+};
 
-  This version writes a single output and does not use bricklets. We will do
-  this in the future to improve parallel visualization.
+//---------------------------------------------------------------------------//
+/*!
+  \brief Take a snapshot of a grid array for BOV output.
+
+  The owned array data is gathered, reordered, and copied into host memory
+  so the array may be modified as soon as this returns.
 
   \param time_step_index The index of the time step we are writing.
   \param time The current time
@@ -176,8 +203,9 @@ reorderView( TargetView& target, const SourceView& source,
   consistent.
 */
 template <class Array_t>
-void writeTimeStep( const int time_step_index, const double time,
-                    const Array_t& array, const bool gather_array = true )
+BovSnapshot<typename Array_t::value_type>
+createSnapshot( const int time_step_index, const double time,
+                const Array_t& array, const bool gather_array = true )
 {
     static_assert( isUniformMesh<typename Array_t::mesh_type>::value,
                    "ViSIT BOV writer can only be used with uniform mesh" );
@@ -281,29 +309,22 @@ void writeTimeStep( const int time_step_index, const double time,
     file_name << "grid_" << array.label() << "_" << std::setfill( '0' )
               << std::setw( 6 ) << time_step_index;
 
-    // Open a binary data file.
-    std::string data_file_name = file_name.str() + ".dat";
-    MPI_File data_file;
-    MPI_File_open( global_grid.comm(), data_file_name.c_str(),
-                   MPI_MODE_WRONLY | MPI_MODE_CREATE, MPI_INFO_NULL,
-                   &data_file );
-
-    // Create the global subarray in which we are writing the local data.
-    auto subarray = createSubarray( array, owned_extents, global_extents );
-    MPI_Type_commit( &subarray );
+    BovSnapshot<value_type> snapshot;
+    snapshot.data_file_name = file_name.str() + ".dat";
+    snapshot.header_file_name = file_name.str() + ".bov";
 
-    // Set the data in the file this process is going to write to.
-    MPI_File_set_view( data_file, 0, MpiTraits<value_type>::type(), subarray,
-                       "native", MPI_INFO_NULL );
-
-    // Write the view to binary.
-    MPI_Status status;
-    MPI_File_write_all( data_file, owned_view.data(), owned_view.size(),
-                        MpiTraits<value_type>::type(), &status );
+    // Copy the reordered data to the host.
+    snapshot.data = Kokkos::View<value_type*, Kokkos::HostSpace>(
+        Kokkos::ViewAllocateWithoutInitializing( array.label() ),
+        owned_view.size() );
+    Kokkos::deep_copy(
+        snapshot.data,
+        Kokkos::View<value_type*, device_type, Kokkos::MemoryUnmanaged>(
+            owned_view.data(), owned_view.size() ) );
 
-    // Clean up.
-    MPI_File_close( &data_file );
-    MPI_Type_free( &subarray );
+    // Create the global subarray in which we are writing the local data.
+    snapshot.subarray = createSubarray( array, owned_extents, global_extents );
+    MPI_Type_commit( &snapshot.subarray );
 
     // Create a VisIt BOV header with global data. Only create the header
     // on rank 0.
@@ -311,16 +332,13 @@ void writeTimeStep( const int time_step_index, const double time,
     MPI_Comm_rank( global_grid.comm(), &rank );
     if ( 0 == rank )
     {
-        // Open a file for writing.
-        std::string header_file_name = file_name.str() + ".bov";
-        std::fstream header;
-        header.open( header_file_name, std::fstream::out );
+        std::stringstream header;
 
         // Write the current time.
         header << "TIME: " << time << std::endl;
 
         // Data file name.
-        header << "DATA_FILE: " << data_file_name << std::endl;
+        header << "DATA_FILE: " << snapshot.data_file_name << std::endl;
 
         // Global data size.
         header << "DATA_SIZE: ";
@@ -379,11 +397,230 @@ void writeTimeStep( const int time_step_index, const double time,
         header << "DATA_COMPONENTS: " << global_extents[num_space_dim]
                << std::endl;
 
-        // Close the header.
+        snapshot.header = header.str();
+    }
+
+    return snapshot;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Write a snapshot to a VisIt BOV. All ranks of the communicator
+  must write their snapshot of the same time step.
+
+  \param comm The communicator of the grid the snapshot was taken on.
+  \param snapshot The snapshot to write. Its subarray type is freed.
+*/
+template <class Scalar>
+void writeSnapshot( MPI_Comm comm, BovSnapshot<Scalar>& snapshot )
+{
+    // Open a binary data file.
+    MPI_File data_file;
+    MPI_File_open( comm, snapshot.data_file_name.c_str(),
+                   MPI_MODE_WRONLY | MPI_MODE_CREATE, MPI_INFO_NULL,
+                   &data_file );
+
+    // Set the data in the file this process is going to write to.
+    MPI_File_set_view( data_file, 0, MpiTraits<Scalar>::type(),
+                       snapshot.subarray, "native", MPI_INFO_NULL );
+
+    // Write the view to binary.
+    MPI_Status status;
+    MPI_File_write_all( data_file, snapshot.data.data(),
+                        snapshot.data.size(), MpiTraits<Scalar>::type(),
+                        &status );
+
+    // Clean up.
+    MPI_File_close( &data_file );
+    MPI_Type_free( &snapshot.subarray );
+
+    // Write the header.
+    if ( !snapshot.header.empty() )
+    {
+        std::fstream header;
+        header.open( snapshot.header_file_name, std::fstream::out );
+        header << snapshot.header;
         header.close();
     }
 }
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief Write a grid array to a VisIt BOV.
+
+  This version writes a single output and does not use bricklets. We will do
+  this in the future to improve parallel visualization.
+
+  \param time_step_index The index of the time step we are writing.
+  \param time The current time
+  \param array The array to write
+  \param gather_array Gather the array before writing to make parallel
+  consistent.
+*/
+template <class Array_t>
+void writeTimeStep( const int time_step_index, const double time,
+                    const Array_t& array, const bool gather_array = true )
+{
+    auto snapshot =
+        createSnapshot( time_step_index, time, array, gather_array );
+    writeSnapshot( array.layout()->localGrid()->globalGrid().comm(),
+                   snapshot );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Asynchronous VisIt BOV writer.
+
+  writeTimeStep snapshots the owned array data into host memory and returns
+  while a background thread writes the snapshot. At most a bounded number of
+  snapshots are outstanding; further writes wait for the oldest to finish.
+  Every rank of a grid must write the same time steps in the same order.
+
+  Writes are made on a duplicate of the grid communicator so they do not
+  interfere with communication on the grid. Writing from a background thread
+  requires MPI_THREAD_MULTIPLE; with lower MPI thread support the writer
+  writes synchronously.
+*/
+class AsyncWriter
+{
+  public:
+    /*!
+      \brief Constructor.
+      \param max_pending The maximum number of outstanding snapshots. The
+      default double-buffers output.
+    */
+    explicit AsyncWriter( const int max_pending = 2 )
+        : _max_pending( std::max( max_pending, 1 ) )
+        , _num_pending( 0 )
+        , _stop( false )
+    {
+        int provided;
+        MPI_Query_thread( &provided );
+        _async = ( MPI_THREAD_MULTIPLE == provided );
+        if ( _async )
+            _thread = std::thread( &AsyncWriter::run, this );
+    }
+
+    //! Destructor. Completes all outstanding writes.
+    ~AsyncWriter()
+    {
+        if ( _async )
+        {
+            {
+                std::lock_guard<std::mutex> lock( _mutex );
+                _stop = true;
+            }
+            _cv.notify_all();
+            _thread.join();
+        }
+    }
+
+    AsyncWriter( const AsyncWriter& ) = delete;
+    AsyncWriter& operator=( const AsyncWriter& ) = delete;
+
+    //! Whether writes are made in the background.
+    bool isAsync() const { return _async; }
+
+    /*!
+      \brief Write a grid array to a VisIt BOV in the background.
+
+      \param time_step_index The index of the time step we are writing.
+      \param time The current time
+      \param array The array to write. It may be modified as soon as this
+      returns.
+      \param gather_array Gather the array before writing to make parallel
+      consistent.
+    */
+    template <class Array_t>
+    void writeTimeStep( const int time_step_index, const double time,
+                        const Array_t& array, const bool gather_array = true )
+    {
+        if ( !_async )
+        {
+            BovWriter::writeTimeStep( time_step_index, time, array,
+                                      gather_array );
+            return;
+        }
+
+        // Bound the outstanding snapshots. The slot is reserved before the
+        // snapshot is taken so that the snapshot memory is bounded too.
+        {
+            std::unique_lock<std::mutex> lock( _mutex );
+            _cv.wait( lock, [this] { return _num_pending < _max_pending; } );
+            ++_num_pending;
+        }
+
+        // Release the slot again if the write could not be queued.
+        try
+        {
+            auto snapshot =
+                createSnapshot( time_step_index, time, array, gather_array );
+            MPI_Comm comm;
+            if ( MPI_SUCCESS !=
+                 MPI_Comm_dup( array.layout()->localGrid()->globalGrid().comm(),
+                               &comm ) )
+                throw std::runtime_error(
+                    "Failed to duplicate the grid communicator" );
+
+            std::lock_guard<std::mutex> lock( _mutex );
+            _jobs.push_back( [comm, snapshot]() mutable {
+                writeSnapshot( comm, snapshot );
+                MPI_Comm_free( &comm );
+            } );
+        }
+        catch ( ... )
+        {
+            {
+                std::lock_guard<std::mutex> lock( _mutex );
+                --_num_pending;
+            }
+            _cv.notify_all();
+            throw;
+        }
+        _cv.notify_all();
+    }
+
+    //! Wait for all outstanding writes to complete.
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock( _mutex );
+        _cv.wait( lock, [this] { return 0 == _num_pending; } );
+    }
+
+  private:
+    // Background thread writing snapshots in order.
+    void run()
+    {
+        while ( true )
+        {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock( _mutex );
+                _cv.wait( lock, [this] { return _stop || !_jobs.empty(); } );
+                if ( _jobs.empty() )
+                    return;
+                job = std::move( _jobs.front() );
+                _jobs.pop_front();
+            }
+            job();
+            {
+                std::lock_guard<std::mutex> lock( _mutex );
+                --_num_pending;
+            }
+            _cv.notify_all();
+        }
+    }
+
+    int _max_pending;
+    int _num_pending;
+    bool _stop;
+    bool _async;
+    std::thread _thread;
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::deque<std::function<void()>> _jobs;
+};
+
 //---------------------------------------------------------------------------//
 
 } // end namespace BovWriter
@@ -0,0 +1,159 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cajita_Checkpoint.hpp
+  \brief Raw binary checkpoint and restart of grid arrays
+*/
+#ifndef CAJITA_CHECKPOINT_HPP
+#define CAJITA_CHECKPOINT_HPP
+
+#include <Cajita_Array.hpp>
+
+#include <Cabana_Checkpoint.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace Cajita
+{
+namespace Impl
+{
+//! \cond Impl
+//---------------------------------------------------------------------------//
+// Array checkpoint file header. The local view data following the header is
+// written exactly as it is laid out in memory, including the ghosts.
+struct ArrayCheckpointHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t rank;
+    std::uint64_t signature;
+    std::uint64_t extents[4];
+    std::uint64_t strides[4];
+    std::uint64_t bytes;
+};
+
+constexpr char array_checkpoint_magic[8] = { 'C', 'A', 'J', 'I',
+                                             'T', 'A', 'C', 'P' };
+constexpr std::uint32_t array_checkpoint_version = 1;
+
+// Create the header describing the memory layout of an array view.
+template <class View>
+ArrayCheckpointHeader arrayCheckpointHeader( const View& view )
+{
+    if ( !view.span_is_contiguous() )
+        throw std::runtime_error(
+            "Array checkpoints require contiguous array data" );
+
+    ArrayCheckpointHeader header;
+    std::memset( &header, 0, sizeof( header ) );
+    std::memcpy( header.magic, array_checkpoint_magic,
+                 sizeof( header.magic ) );
+    header.version = array_checkpoint_version;
+    header.rank = View::rank;
+    header.signature = Cabana::Impl::memberSignature<
+        typename View::non_const_value_type>( Cabana::Impl::signature_seed );
+    for ( std::size_t d = 0; d < View::rank; ++d )
+    {
+        header.extents[d] = view.extent( d );
+        header.strides[d] = view.stride( d );
+    }
+    header.bytes = view.span() * sizeof( typename View::value_type );
+    return header;
+}
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Write the local data of an array to a checkpoint file.
+
+  The local view, including its ghosts, is written exactly as laid out in
+  memory after a small header recording the value type, extents, and strides
+  of the view. Host arrays are written without any copy; other memory spaces
+  are staged through a host mirror.
+
+  \param array The array to write.
+  \param path The checkpoint file path, e.g. one per rank.
+*/
+template <class Array_t>
+void checkpoint( const Array_t& array, const std::string& path )
+{
+    static_assert( is_array<Array_t>::value, "Cajita::Array required" );
+
+    auto view = array.view();
+    auto header = Impl::arrayCheckpointHeader( view );
+    auto host_view =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), view );
+
+    std::ofstream file( path, std::ios::binary | std::ios::trunc );
+    if ( !file )
+        throw std::runtime_error( "Could not open checkpoint " + path );
+    file.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+    file.write( reinterpret_cast<const char*>( host_view.data() ),
+                header.bytes );
+    if ( !file )
+        throw std::runtime_error( "Could not write checkpoint " + path );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Restore the local data of an array from a checkpoint file written
+  by checkpoint().
+
+  The array must have been created on the same local grid as the
+  checkpointed array such that the value type, extents, and strides of its
+  view match those of the checkpoint. The data is read directly into the
+  view if it is host accessible, otherwise through a host mirror.
+
+  \param array The array to restore.
+  \param path The checkpoint file path.
+*/
+template <class Array_t>
+void restart( Array_t& array, const std::string& path )
+{
+    static_assert( is_array<Array_t>::value, "Cajita::Array required" );
+
+    auto view = array.view();
+    auto expected = Impl::arrayCheckpointHeader( view );
+
+    std::ifstream file( path, std::ios::binary );
+    if ( !file )
+        throw std::runtime_error( "Could not open checkpoint " + path );
+    Impl::ArrayCheckpointHeader header;
+    file.read( reinterpret_cast<char*>( &header ), sizeof( header ) );
+    if ( !file ||
+         0 != std::memcmp( header.magic, Impl::array_checkpoint_magic,
+                           sizeof( header.magic ) ) ||
+         Impl::array_checkpoint_version != header.version )
+        throw std::runtime_error( path + " is not a Cajita array checkpoint" );
+    if ( 0 != std::memcmp( &header, &expected, sizeof( header ) ) )
+        throw std::runtime_error( "Checkpoint " + path +
+                                  " does not match the restart array layout" );
+
+    auto host_view = Kokkos::create_mirror_view( Kokkos::HostSpace(), view );
+    file.read( reinterpret_cast<char*>( host_view.data() ), header.bytes );
+    if ( !file )
+        throw std::runtime_error( "Could not read checkpoint " + path );
+    Kokkos::deep_copy( view, host_view );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cajita
+
+#endif // end CAJITA_CHECKPOINT_HPP
@@ -0,0 +1,315 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cajita_ConduitBlueprint.hpp
+  \brief Conduit Blueprint grid meshes for in-situ analysis
+*/
+#ifndef CAJITA_CONDUITBLUEPRINT_HPP
+#define CAJITA_CONDUITBLUEPRINT_HPP
+
+#include <Cajita_Array.hpp>
+#include <Cajita_IndexSpace.hpp>
+#include <Cajita_LocalMesh.hpp>
+#include <Cajita_Types.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <conduit.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace Cajita
+{
+namespace Experimental
+{
+namespace ConduitBlueprint
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief Publish grid arrays as a Conduit Blueprint mesh without copying.
+
+  The ghosted local block of the array layout is described once, at
+  construction, as an unstructured quad (2D) or hex (3D) mesh whose
+  vertices and elements are numbered in the LayoutRight order of the grid
+  indices. Array data is then published by reference: every degree of
+  freedom of an array becomes a strided component of a field named by the
+  array label, so arrays stored with either DofInnermost or DofOutermost
+  layouts are handed to Ascent or Catalyst directly from their (possibly
+  device-resident) memory. Cell arrays are element fields and node arrays
+  are vertex fields. Ghost elements are flagged in an integer element field
+  (1 for ghosts) so analyses only count owned entities.
+
+  Published arrays must remain alive and unresized while the node is in use.
+
+  \tparam EntityType Array entity type (Cell or Node).
+  \tparam MeshType Mesh type (uniform or non-uniform).
+  \tparam MemorySpace Memory space of the published arrays.
+*/
+template <class EntityType, class MeshType, class MemorySpace>
+class ArrayAdapter
+{
+  public:
+    //! Entity type.
+    using entity_type = EntityType;
+
+    //! Mesh type.
+    using mesh_type = MeshType;
+
+    //! Memory space.
+    using memory_space = MemorySpace;
+
+    //! Spatial dimension.
+    static constexpr std::size_t num_space_dim = mesh_type::num_space_dim;
+
+    //! Array layout type.
+    using array_layout = ArrayLayout<entity_type, mesh_type>;
+
+    //! Coordinate scalar type.
+    using scalar_type = typename mesh_type::scalar_type;
+
+    static_assert( std::is_same<entity_type, Cell>::value ||
+                       std::is_same<entity_type, Node>::value,
+                   "Blueprint arrays must be cell or node arrays" );
+
+    /*!
+      \brief Constructor.
+      \param layout The layout of the arrays to publish.
+      \param mesh_name Name of the Blueprint topology and coordinate set
+      prefix.
+      \param ghost_name Name of the ghost element field.
+    */
+    ArrayAdapter( const std::shared_ptr<array_layout>& layout,
+                  const std::string& mesh_name = "grid",
+                  const std::string& ghost_name = "ascent_ghosts" )
+        : _layout( layout )
+        , _mesh_name( mesh_name )
+        , _ghost_name( ghost_name )
+    {
+        const auto& local_grid = *( layout->localGrid() );
+        auto local_mesh = createLocalMesh<Kokkos::HostSpace>( local_grid );
+        auto entity_space = local_grid.indexSpace( Ghost(), entity_type(),
+                                                   Local() );
+        auto own_space = local_grid.indexSpace( Own(), entity_type(),
+                                                Local() );
+
+        // Vertex and element blocks of the ghosted entities. Cell arrays are
+        // the elements of their surrounding nodes; node arrays are the
+        // vertices of the cells between them.
+        long vertex_min[num_space_dim];
+        long num_vertex[num_space_dim];
+        long num_element[num_space_dim];
+        _num_vertex = 1;
+        _num_element = 1;
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+        {
+            vertex_min[d] = entity_space.min( d );
+            num_vertex[d] = entity_space.extent( d ) + ( is_cell() ? 1 : 0 );
+            num_element[d] = num_vertex[d] - 1;
+            _num_vertex *= num_vertex[d];
+            _num_element *= num_element[d];
+        }
+
+        // Vertex coordinates, component-major.
+        Kokkos::View<scalar_type*, Kokkos::HostSpace> coords(
+            "blueprint_coords", num_space_dim * _num_vertex );
+        for ( std::size_t v = 0; v < _num_vertex; ++v )
+        {
+            int index[num_space_dim];
+            std::size_t rem = v;
+            for ( int d = num_space_dim - 1; d >= 0; --d )
+            {
+                index[d] = vertex_min[d] + rem % num_vertex[d];
+                rem /= num_vertex[d];
+            }
+            scalar_type x[num_space_dim];
+            local_mesh.coordinates( Node(), index, x );
+            for ( std::size_t d = 0; d < num_space_dim; ++d )
+                coords( d * _num_vertex + v ) = x[d];
+        }
+
+        // Element connectivity in VTK quad/hex order and ghost flags. A node
+        // array element is owned if its low corner node is owned.
+        constexpr std::size_t num_corner = 1 << num_space_dim;
+        const int corner_offsets[8][3] = { { 0, 0, 0 }, { 1, 0, 0 },
+                                           { 1, 1, 0 }, { 0, 1, 0 },
+                                           { 0, 0, 1 }, { 1, 0, 1 },
+                                           { 1, 1, 1 }, { 0, 1, 1 } };
+        Kokkos::View<int*, Kokkos::HostSpace> connectivity(
+            "blueprint_connectivity", num_corner * _num_element );
+        Kokkos::View<int*, Kokkos::HostSpace> ghosts( "blueprint_ghosts",
+                                                      _num_element );
+        for ( std::size_t e = 0; e < _num_element; ++e )
+        {
+            long index[num_space_dim];
+            std::size_t rem = e;
+            for ( int d = num_space_dim - 1; d >= 0; --d )
+            {
+                index[d] = rem % num_element[d];
+                rem /= num_element[d];
+            }
+
+            for ( std::size_t c = 0; c < num_corner; ++c )
+            {
+                long vertex = 0;
+                for ( std::size_t d = 0; d < num_space_dim; ++d )
+                    vertex =
+                        vertex * num_vertex[d] + index[d] +
+                        corner_offsets[c][d];
+                connectivity( e * num_corner + c ) = vertex;
+            }
+
+            bool owned = true;
+            for ( std::size_t d = 0; d < num_space_dim; ++d )
+            {
+                long entity = vertex_min[d] + index[d];
+                owned = owned && entity >= own_space.min( d ) &&
+                        entity < own_space.max( d );
+            }
+            ghosts( e ) = owned ? 0 : 1;
+        }
+
+        _coords = Kokkos::create_mirror_view_and_copy( memory_space(),
+                                                       coords );
+        _connectivity = Kokkos::create_mirror_view_and_copy( memory_space(),
+                                                             connectivity );
+        _ghosts = Kokkos::create_mirror_view_and_copy( memory_space(),
+                                                       ghosts );
+    }
+
+    /*!
+      \brief Publish the mesh and arrays into a Conduit node.
+      \param node The Blueprint mesh node to fill.
+      \param arrays Labeled arrays on the adapter layout.
+    */
+    template <class... ArrayTypes>
+    void publish( conduit::Node& node, const ArrayTypes&... arrays ) const
+    {
+        std::string coords = _mesh_name + "_coords";
+        const char* axes[3] = { "x", "y", "z" };
+        node["coordsets/" + coords + "/type"] = "explicit";
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+            node["coordsets/" + coords + "/values/" + axes[d]].set_external(
+                _coords.data() + d * _num_vertex, _num_vertex );
+
+        std::string topo = "topologies/" + _mesh_name;
+        node[topo + "/type"] = "unstructured";
+        node[topo + "/coordset"] = coords;
+        node[topo + "/elements/shape"] =
+            ( 3 == num_space_dim ) ? "hex" : "quad";
+        node[topo + "/elements/connectivity"].set_external(
+            _connectivity.data(), _connectivity.size() );
+
+        std::string ghost_path = "fields/" + _ghost_name;
+        node[ghost_path + "/association"] = "element";
+        node[ghost_path + "/topology"] = _mesh_name;
+        node[ghost_path + "/values"].set_external( _ghosts.data(),
+                                                   _num_element );
+
+        publishArrays( node, arrays... );
+    }
+
+  private:
+    void publishArrays( conduit::Node& ) const {}
+
+    template <class Array_t, class... ArrayTypes>
+    void publishArrays( conduit::Node& node, const Array_t& array,
+                        const ArrayTypes&... arrays ) const
+    {
+        static_assert( std::is_same<typename Array_t::entity_type,
+                                    entity_type>::value,
+                       "Blueprint arrays must match the adapter entity" );
+        static_assert( std::is_same<typename Array_t::memory_space,
+                                    memory_space>::value,
+                       "Blueprint arrays must match the adapter memory" );
+        using value_type = typename Array_t::value_type;
+
+        std::string name = array.label();
+        if ( name.empty() )
+            throw std::logic_error( "Blueprint arrays require labels" );
+        if ( array.layout()->localGrid() != _layout->localGrid() )
+            throw std::logic_error( "Blueprint array " + name +
+                                    " is not on the adapter grid" );
+
+        // The entities of each degree of freedom must be uniformly strided
+        // in LayoutRight order, which holds for both dof layouts.
+        auto view = array.view();
+        for ( std::size_t d = 0; d + 1 < num_space_dim; ++d )
+            if ( view.stride( d ) !=
+                 view.stride( d + 1 ) * view.extent( d + 1 ) )
+                throw std::logic_error( "Blueprint array " + name +
+                                        " entities are not uniformly strided" );
+        std::size_t stride = view.stride( num_space_dim - 1 );
+        std::size_t num_dof = view.extent( num_space_dim );
+        std::size_t num_entity = is_cell() ? _num_element : _num_vertex;
+
+        std::string path = "fields/" + name;
+        node[path + "/association"] = is_cell() ? "element" : "vertex";
+        node[path + "/topology"] = _mesh_name;
+        for ( std::size_t n = 0; n < num_dof; ++n )
+        {
+            auto& values = ( 1 == num_dof )
+                               ? node[path + "/values"]
+                               : node[path + "/values/" + std::to_string( n )];
+            values.set_external( view.data(), num_entity,
+                                 n * view.stride( num_space_dim ) *
+                                     sizeof( value_type ),
+                                 stride * sizeof( value_type ) );
+        }
+
+        publishArrays( node, arrays... );
+    }
+
+    static constexpr bool is_cell()
+    {
+        return std::is_same<entity_type, Cell>::value;
+    }
+
+  private:
+    std::shared_ptr<array_layout> _layout;
+    std::string _mesh_name;
+    std::string _ghost_name;
+    std::size_t _num_vertex;
+    std::size_t _num_element;
+    Kokkos::View<scalar_type*, memory_space> _coords;
+    Kokkos::View<int*, memory_space> _connectivity;
+    Kokkos::View<int*, memory_space> _ghosts;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create a Blueprint adapter for arrays on a layout.
+  \param layout The layout of the arrays to publish.
+  \param mesh_name Name of the Blueprint topology.
+  \param ghost_name Name of the ghost element field.
+  \return Shared pointer to the adapter.
+*/
+template <class MemorySpace, class EntityType, class MeshType>
+std::shared_ptr<ArrayAdapter<EntityType, MeshType, MemorySpace>>
+createArrayAdapter(
+    const std::shared_ptr<ArrayLayout<EntityType, MeshType>>& layout,
+    const std::string& mesh_name = "grid",
+    const std::string& ghost_name = "ascent_ghosts" )
+{
+    return std::make_shared<ArrayAdapter<EntityType, MeshType, MemorySpace>>(
+        layout, mesh_name, ghost_name );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace ConduitBlueprint
+} // end namespace Experimental
+} // end namespace Cajita
+
+#endif // end CAJITA_CONDUITBLUEPRINT_HPP
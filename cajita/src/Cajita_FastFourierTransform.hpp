@@ -17,14 +17,18 @@
 #define CAJITA_FASTFOURIERTRANSFORM_HPP
 
 #include <Cajita_Array.hpp>
+#include <Cajita_IndexSpace.hpp>
 #include <Cajita_Types.hpp>
 
 #include <Kokkos_Core.hpp>
 
 #include <heffte_fft3d.h>
 
+#include <mpi.h>
+
 #include <array>
 #include <memory>
+#include <stdexcept>
 #include <type_traits>
 
 namespace Cajita
@@ -101,6 +105,7 @@ class FastFourierTransformParams
     bool alltoall = true;
     bool pencils = true;
     bool reorder = true;
+    bool spectral_pencils = false;
 
   public:
     /*!
@@ -119,6 +124,12 @@ class FastFourierTransformParams
       Contiguous layout requires tensor transposition; strided layout does not.
     */
     void setReorder( bool value ) { reorder = value; }
+    /*!
+      \brief setSpectralPencils Set persistent pencil spectral data.
+      \param value Keep a persistent pencil-decomposed spectral array (true)
+      which data is transformed into and out of with a single reshape each way.
+    */
+    void setSpectralPencils( bool value ) { spectral_pencils = value; }
     /*!
       \brief getAllToAll Get MPI communication.
       \return Using all to all MPI communication or not.
@@ -135,6 +146,11 @@ class FastFourierTransformParams
       Contiguous layout requires tensor transposition; strided layout does not.
     */
     bool getReorder() const { return reorder; }
+    /*!
+      \brief getSpectralPencils Get persistent pencil spectral data.
+      \return Keeping a persistent pencil-decomposed spectral array or not.
+    */
+    bool getSpectralPencils() const { return spectral_pencils; }
 };
 
 //---------------------------------------------------------------------------//
@@ -193,14 +209,52 @@ class FastFourierTransform
     }
 
     /*!
-      \brief Ensure the FFT compute array has the correct DoFs.
+      \brief Ensure the FFT compute array has the correct DoFs. Arrays with
+      more than one complex value per entity are transformed as a batch of
+      fields, one per complex value.
       \param dof Degrees of freedom of array.
     */
     inline void checkArrayDofs( const int dof )
     {
-        if ( 2 != dof )
+        if ( dof < 2 || 0 != dof % 2 )
             throw std::logic_error(
-                "Only 1 complex value per entity allowed in FFT" );
+                "Only complex values (an even number of DoFs) per entity "
+                "allowed in FFT" );
+    }
+
+    /*!
+      \brief Create an unmanaged view of batched local FFT data, indexed by
+      field, local entity index, and real/imaginary part.
+    */
+    template <class IndexSpaceType, std::size_t NSD = num_space_dim>
+    std::enable_if_t<
+        3 == NSD,
+        Kokkos::View<value_type*****, Kokkos::LayoutRight, device_type,
+                     Kokkos::MemoryUnmanaged>>
+    createLocalView( const IndexSpaceType own_space, const int batch,
+                     value_type* data )
+    {
+        return Kokkos::View<value_type*****, Kokkos::LayoutRight, device_type,
+                            Kokkos::MemoryUnmanaged>(
+            data, batch, own_space.extent( Dim::I ),
+            own_space.extent( Dim::J ), own_space.extent( Dim::K ), 2 );
+    }
+
+    /*!
+      \brief Create an unmanaged view of batched local FFT data, indexed by
+      field, local entity index, and real/imaginary part.
+    */
+    template <class IndexSpaceType, std::size_t NSD = num_space_dim>
+    std::enable_if_t<
+        2 == NSD, Kokkos::View<value_type****, Kokkos::LayoutRight, device_type,
+                               Kokkos::MemoryUnmanaged>>
+    createLocalView( const IndexSpaceType own_space, const int batch,
+                     value_type* data )
+    {
+        return Kokkos::View<value_type****, Kokkos::LayoutRight, device_type,
+                            Kokkos::MemoryUnmanaged>(
+            data, batch, own_space.extent( Dim::I ),
+            own_space.extent( Dim::J ), 2 );
     }
 
     /*!
@@ -243,6 +297,47 @@ class FastFourierTransform
         static_cast<Derived*>( this )->reverseImpl( x, scaling );
     }
 
+    /*!
+      \brief Do a forward FFT into the persistent spectral data.
+      \param x The array on which to perform the forward transform. It is not
+      modified.
+      \param scaling Method of scaling data.
+    */
+    template <class Array_t, class ScaleType>
+    void forwardToSpectral(
+        const Array_t& x, const ScaleType scaling,
+        typename std::enable_if<
+            ( is_array<Array_t>::value &&
+              is_matching_array<
+                  typename Array_t::entity_type, typename Array_t::mesh_type,
+                  typename Array_t::device_type, typename Array_t::value_type,
+                  entity_type, mesh_type, device_type, value_type>::value ),
+            int>::type* = 0 )
+    {
+        checkArrayDofs( x.layout()->dofsPerEntity() );
+        static_cast<Derived*>( this )->forwardToSpectralImpl( x, scaling );
+    }
+
+    /*!
+      \brief Do a reverse FFT from the persistent spectral data.
+      \param x The array in which to write the result of the reverse transform.
+      \param scaling Method of scaling data.
+    */
+    template <class Array_t, class ScaleType>
+    void reverseFromSpectral(
+        const Array_t& x, const ScaleType scaling,
+        typename std::enable_if<
+            ( is_array<Array_t>::value &&
+              is_matching_array<
+                  typename Array_t::entity_type, typename Array_t::mesh_type,
+                  typename Array_t::device_type, typename Array_t::value_type,
+                  entity_type, mesh_type, device_type, value_type>::value ),
+            int>::type* = 0 )
+    {
+        checkArrayDofs( x.layout()->dofsPerEntity() );
+        static_cast<Derived*>( this )->reverseFromSpectralImpl( x, scaling );
+    }
+
     /*!
       \brief Copy owned data for FFT.
     */
@@ -259,8 +354,11 @@ class FastFourierTransform
                 auto iw = i - own_space.min( Dim::I );
                 auto jw = j - own_space.min( Dim::J );
                 auto kw = k - own_space.min( Dim::K );
-                l_view( iw, jw, kw, 0 ) = lg_view( i, j, k, 0 );
-                l_view( iw, jw, kw, 1 ) = lg_view( i, j, k, 1 );
+                for ( std::size_t b = 0; b < l_view.extent( 0 ); ++b )
+                {
+                    l_view( b, iw, jw, kw, 0 ) = lg_view( i, j, k, 2 * b );
+                    l_view( b, iw, jw, kw, 1 ) = lg_view( i, j, k, 2 * b + 1 );
+                }
             } );
     }
 
@@ -279,8 +377,11 @@ class FastFourierTransform
             KOKKOS_LAMBDA( const int i, const int j ) {
                 auto iw = i - own_space.min( Dim::I );
                 auto jw = j - own_space.min( Dim::J );
-                l_view( iw, jw, 0 ) = lg_view( i, j, 0 );
-                l_view( iw, jw, 1 ) = lg_view( i, j, 1 );
+                for ( std::size_t b = 0; b < l_view.extent( 0 ); ++b )
+                {
+                    l_view( b, iw, jw, 0 ) = lg_view( i, j, 2 * b );
+                    l_view( b, iw, jw, 1 ) = lg_view( i, j, 2 * b + 1 );
+                }
             } );
     }
 
@@ -300,8 +401,11 @@ class FastFourierTransform
                 auto iw = i - own_space.min( Dim::I );
                 auto jw = j - own_space.min( Dim::J );
                 auto kw = k - own_space.min( Dim::K );
-                lg_view( i, j, k, 0 ) = l_view( iw, jw, kw, 0 );
-                lg_view( i, j, k, 1 ) = l_view( iw, jw, kw, 1 );
+                for ( std::size_t b = 0; b < l_view.extent( 0 ); ++b )
+                {
+                    lg_view( i, j, k, 2 * b ) = l_view( b, iw, jw, kw, 0 );
+                    lg_view( i, j, k, 2 * b + 1 ) = l_view( b, iw, jw, kw, 1 );
+                }
             } );
     }
 
@@ -320,8 +424,11 @@ class FastFourierTransform
             KOKKOS_LAMBDA( const int i, const int j ) {
                 auto iw = i - own_space.min( Dim::I );
                 auto jw = j - own_space.min( Dim::J );
-                lg_view( i, j, 0 ) = l_view( iw, jw, 0 );
-                lg_view( i, j, 1 ) = l_view( iw, jw, 1 );
+                for ( std::size_t b = 0; b < l_view.extent( 0 ); ++b )
+                {
+                    lg_view( i, j, 2 * b ) = l_view( b, iw, jw, 0 );
+                    lg_view( i, j, 2 * b + 1 ) = l_view( b, iw, jw, 1 );
+                }
             } );
     }
 };
@@ -426,6 +533,15 @@ class HeffteFastFourierTransform
         typename Impl::HeffteBackendTraits<exec_space,
                                            backend_type>::backend_type;
 
+    //! Spectral data view type. Indexed locally from the spectral index space
+    //! minimum with the real and imaginary parts in the last dimension.
+    using spectral_view_type =
+        typename std::conditional<3 == num_space_dim,
+                                  Kokkos::View<Scalar****, Kokkos::LayoutRight,
+                                               DeviceType>,
+                                  Kokkos::View<Scalar***, Kokkos::LayoutRight,
+                                               DeviceType>>::type;
+
     /*!
       \brief Constructor
       \param layout The array layout defining the vector space of the transform.
@@ -455,6 +571,7 @@ class HeffteFastFourierTransform
             heffte_params );
 
         int fftsize = std::max( _fft->size_outbox(), _fft->size_inbox() );
+        _fft_size = fftsize;
 
         // Check the size.
         auto entity_space =
@@ -466,6 +583,76 @@ class HeffteFastFourierTransform
         _fft_work = Kokkos::View<Scalar*, DeviceType>(
             Kokkos::ViewAllocateWithoutInitializing( "fft_work" ),
             2 * fftsize );
+
+        // Optionally keep the spectral data in a pencil decomposition with
+        // the pencils along the contiguous heFFTe dimension. Transforms
+        // to/from it need a single reshape instead of the two of an
+        // in-place transform pair.
+        if ( params.getSpectralPencils() )
+        {
+            const auto& global_grid = layout.localGrid()->globalGrid();
+            int comm_size, comm_rank;
+            MPI_Comm_size( global_grid.comm(), &comm_size );
+            MPI_Comm_rank( global_grid.comm(), &comm_rank );
+
+            std::array<int, num_space_dim> world_low;
+            std::array<int, num_space_dim> world_high;
+            for ( std::size_t d = 0; d < num_space_dim; ++d )
+            {
+                world_low[d] = 0;
+                world_high[d] = global_grid.globalNumEntity(
+                                    EntityType(), num_space_dim - d - 1 ) -
+                                1;
+            }
+            heffte::box3d world = { world_low, world_high };
+            std::array<int, 3> proc_grid = { 1, comm_size, 1 };
+            if ( 3 == num_space_dim )
+            {
+                auto pencil_grid = heffte::make_procgrid( comm_size );
+                proc_grid = { 1, pencil_grid[0], pencil_grid[1] };
+            }
+            auto spectral_box =
+                heffte::split_world( world, proc_grid )[comm_rank];
+
+            _spectral_fft =
+                std::make_shared<heffte::fft3d<heffte_backend_type>>(
+                    inbox, spectral_box, global_grid.comm(), heffte_params );
+
+            // heFFTe orders the box dimensions fastest first.
+            std::array<long, num_space_dim> spectral_min;
+            std::array<long, num_space_dim> spectral_max;
+            for ( std::size_t d = 0; d < num_space_dim; ++d )
+            {
+                spectral_min[d] = spectral_box.low[num_space_dim - d - 1];
+                spectral_max[d] = spectral_box.high[num_space_dim - d - 1] + 1;
+            }
+            _spectral_space =
+                IndexSpace<num_space_dim>( spectral_min, spectral_max );
+            _spectral_data = createView<Scalar, Kokkos::LayoutRight,
+                                        DeviceType>(
+                "fft_spectral", appendDimension( _spectral_space, 2 ) );
+        }
+    }
+
+    /*!
+      \brief Get the global index space of the spectral data owned by this
+      rank.
+    */
+    IndexSpace<num_space_dim> spectralIndexSpace() const
+    {
+        checkSpectral();
+        return _spectral_space;
+    }
+
+    /*!
+      \brief Get the spectral data owned by this rank. The data persists
+      between transforms so fields may be kept in the spectral decomposition
+      across steps.
+    */
+    spectral_view_type spectralView() const
+    {
+        checkSpectral();
+        return _spectral_data;
     }
 
     /*!
@@ -491,7 +678,52 @@ class HeffteFastFourierTransform
     }
 
     /*!
-     \brief Do the FFT.
+      \brief Do a forward FFT into the spectral data.
+      \param x The array on which to perform the forward transform.
+      \param ScaleType Method of scaling data.
+    */
+    template <class Array_t, class ScaleType>
+    void forwardToSpectralImpl( const Array_t& x, const ScaleType )
+    {
+        checkSpectral( x.layout()->dofsPerEntity() );
+        auto own_space =
+            x.layout()->localGrid()->indexSpace( Own(), EntityType(), Local() );
+        auto local_view =
+            this->createLocalView( own_space, 1, _fft_work.data() );
+        this->copyToLocal( own_space, local_view, x.view() );
+
+        _spectral_fft->forward(
+            reinterpret_cast<std::complex<Scalar>*>( _fft_work.data() ),
+            reinterpret_cast<std::complex<Scalar>*>( _spectral_data.data() ),
+            Impl::HeffteScalingTraits<ScaleType>().scaling_type );
+    }
+
+    /*!
+      \brief Do a reverse FFT from the spectral data.
+      \param x The array in which to write the reverse transform.
+      \param ScaleType Method of scaling data.
+    */
+    template <class Array_t, class ScaleType>
+    void reverseFromSpectralImpl( const Array_t& x, const ScaleType )
+    {
+        checkSpectral( x.layout()->dofsPerEntity() );
+        _spectral_fft->backward(
+            reinterpret_cast<std::complex<Scalar>*>( _spectral_data.data() ),
+            reinterpret_cast<std::complex<Scalar>*>( _fft_work.data() ),
+            Impl::HeffteScalingTraits<ScaleType>().scaling_type );
+
+        auto own_space =
+            x.layout()->localGrid()->indexSpace( Own(), EntityType(), Local() );
+        auto local_view =
+            this->createLocalView( own_space, 1, _fft_work.data() );
+        auto localghost_view = x.view();
+        this->copyFromLocal( own_space, local_view, localghost_view );
+    }
+
+    /*!
+     \brief Do the FFT. Each complex value per entity of the array is a
+     separate field and all fields are transformed in one batched heFFTe
+     execution, combining their reshape communication.
      \param x The array on which to perform the transform.
      \param flag Flag for forward or reverse.
      \param scale Method of scaling data.
@@ -499,12 +731,17 @@ class HeffteFastFourierTransform
     template <class Array_t>
     void compute( const Array_t& x, const int flag, const heffte::scale scale )
     {
+        // Grow the work array to hold all fields of the batch.
+        const int batch = x.layout()->dofsPerEntity() / 2;
+        const std::size_t work_size = 2 * batch * _fft_size;
+        if ( _fft_work.size() < work_size )
+            Kokkos::realloc( _fft_work, work_size );
+
         // Create a subview of the work array to write the local data into.
         auto own_space =
             x.layout()->localGrid()->indexSpace( Own(), EntityType(), Local() );
-        auto local_view_space = appendDimension( own_space, 2 );
-        auto local_view = createView<Scalar, Kokkos::LayoutRight, DeviceType>(
-            local_view_space, _fft_work.data() );
+        auto local_view =
+            this->createLocalView( own_space, batch, _fft_work.data() );
 
         // TODO: pull this out to template function
         // Copy to the work array. The work array only contains owned data.
@@ -515,6 +752,7 @@ class HeffteFastFourierTransform
         if ( flag == 1 )
         {
             _fft->forward(
+                batch,
                 reinterpret_cast<std::complex<Scalar>*>( _fft_work.data() ),
                 reinterpret_cast<std::complex<Scalar>*>( _fft_work.data() ),
                 scale );
@@ -522,6 +760,7 @@ class HeffteFastFourierTransform
         else if ( flag == -1 )
         {
             _fft->backward(
+                batch,
                 reinterpret_cast<std::complex<Scalar>*>( _fft_work.data() ),
                 reinterpret_cast<std::complex<Scalar>*>( _fft_work.data() ),
                 scale );
@@ -537,9 +776,323 @@ class HeffteFastFourierTransform
     }
 
   private:
+    // Ensure the persistent spectral data was requested and, if given, that
+    // the array holds a single field.
+    void checkSpectral( const int dof = 2 ) const
+    {
+        if ( !_spectral_fft )
+            throw std::logic_error( "FFT spectral data requires "
+                                    "FastFourierTransformParams::"
+                                    "setSpectralPencils" );
+        if ( 2 != dof )
+            throw std::logic_error(
+                "Only 1 complex value per entity allowed in spectral FFT" );
+    }
+
     // heFFTe correctly handles 2D or 3D FFTs within "fft3d"
     std::shared_ptr<heffte::fft3d<heffte_backend_type>> _fft;
+    int _fft_size;
     Kokkos::View<Scalar*, DeviceType> _fft_work;
+
+    // Optional brick to pencil transform and its persistent output.
+    std::shared_ptr<heffte::fft3d<heffte_backend_type>> _spectral_fft;
+    IndexSpace<num_space_dim> _spectral_space;
+    spectral_view_type _spectral_data;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Interface to heFFTe real-to-complex fast Fourier transforms.
+
+  The forward transform maps a real array with one DoF per entity to the
+  half spectrum along the last (contiguous) dimension, held by the transform
+  in a pencil decomposition. The reverse transform maps the half spectrum
+  back to the real array. Compared to a complex transform of real data this
+  halves the data stored, communicated, and transformed.
+*/
+template <class EntityType, class MeshType, class Scalar, class DeviceType,
+          class BackendType>
+class HeffteRealFastFourierTransform
+{
+  public:
+    //! Array entity type.
+    using entity_type = EntityType;
+    //! Mesh type.
+    using mesh_type = MeshType;
+    //! Scalar value type.
+    using value_type = Scalar;
+    //! Kokkos device type.
+    using device_type = DeviceType;
+    //! FFT backend type.
+    using backend_type = BackendType;
+    //! Kokkos execution space.
+    using exec_space = typename device_type::execution_space;
+
+    //! Spatial dimension.
+    static constexpr std::size_t num_space_dim = mesh_type::num_space_dim;
+
+    //! heFFTe backend type.
+    using heffte_backend_type =
+        typename Impl::HeffteBackendTraits<exec_space,
+                                           backend_type>::backend_type;
+
+    //! Spectral data view type. Indexed locally from the spectral index space
+    //! minimum with the real and imaginary parts in the last dimension.
+    using spectral_view_type =
+        typename std::conditional<3 == num_space_dim,
+                                  Kokkos::View<Scalar****, Kokkos::LayoutRight,
+                                               DeviceType>,
+                                  Kokkos::View<Scalar***, Kokkos::LayoutRight,
+                                               DeviceType>>::type;
+
+    /*!
+      \brief Constructor
+      \param layout The array layout defining the real vector space of the
+      transform.
+      \param params Parameters for the FFT.
+    */
+    HeffteRealFastFourierTransform(
+        const ArrayLayout<EntityType, MeshType>& layout,
+        const FastFourierTransformParams& params )
+    {
+        checkArrayDofs( layout.dofsPerEntity() );
+
+        const auto& global_grid = layout.localGrid()->globalGrid();
+        int comm_size, comm_rank;
+        MPI_Comm_size( global_grid.comm(), &comm_size );
+        MPI_Comm_rank( global_grid.comm(), &comm_rank );
+
+        // Get the real boxes of this rank and of the world. heFFTe orders the
+        // box dimensions fastest first.
+        auto entity_space =
+            layout.localGrid()->indexSpace( Own(), EntityType(), Local() );
+        std::array<int, num_space_dim> global_low;
+        std::array<int, num_space_dim> global_high;
+        std::array<int, num_space_dim> world_low;
+        std::array<int, num_space_dim> world_high;
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+        {
+            global_low[d] =
+                (int)global_grid.globalOffset( num_space_dim - d - 1 );
+            global_high[d] =
+                global_low[d] +
+                (int)entity_space.extent( num_space_dim - d - 1 ) - 1;
+            world_low[d] = 0;
+            world_high[d] = global_grid.globalNumEntity(
+                                EntityType(), num_space_dim - d - 1 ) -
+                            1;
+        }
+        heffte::box3d inbox = { global_low, global_high };
+        heffte::box3d real_world = { world_low, world_high };
+
+        // Split the half spectrum along the contiguous dimension into pencils.
+        const int r2c_direction = 0;
+        auto complex_world = real_world.r2c( r2c_direction );
+        std::array<int, 3> proc_grid = { 1, comm_size, 1 };
+        if ( 3 == num_space_dim )
+        {
+            auto pencil_grid = heffte::make_procgrid( comm_size );
+            proc_grid = { 1, pencil_grid[0], pencil_grid[1] };
+        }
+        auto outbox =
+            heffte::split_world( complex_world, proc_grid )[comm_rank];
+
+        heffte::plan_options heffte_params =
+            heffte::default_options<heffte_backend_type>();
+        heffte_params.use_alltoall = params.getAllToAll();
+        heffte_params.use_pencils = params.getPencils();
+        heffte_params.use_reorder = params.getReorder();
+
+        _fft = std::make_shared<heffte::fft3d_r2c<heffte_backend_type>>(
+            inbox, outbox, r2c_direction, global_grid.comm(), heffte_params );
+
+        // Check the size.
+        if ( _fft->size_inbox() < (int)entity_space.size() )
+            throw std::logic_error( "Expected FFT allocation size smaller "
+                                    "than local grid size" );
+
+        _real_work = Kokkos::View<Scalar*, DeviceType>(
+            Kokkos::ViewAllocateWithoutInitializing( "fft_real_work" ),
+            _fft->size_inbox() );
+
+        std::array<long, num_space_dim> spectral_min;
+        std::array<long, num_space_dim> spectral_max;
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+        {
+            spectral_min[d] = outbox.low[num_space_dim - d - 1];
+            spectral_max[d] = outbox.high[num_space_dim - d - 1] + 1;
+        }
+        _spectral_space =
+            IndexSpace<num_space_dim>( spectral_min, spectral_max );
+        _spectral_data = createView<Scalar, Kokkos::LayoutRight, DeviceType>(
+            "fft_spectral", appendDimension( _spectral_space, 2 ) );
+    }
+
+    /*!
+      \brief Ensure the FFT real array has the correct DoFs.
+      \param dof Degrees of freedom of array.
+    */
+    inline void checkArrayDofs( const int dof )
+    {
+        if ( 1 != dof )
+            throw std::logic_error(
+                "Only 1 real value per entity allowed in real FFT" );
+    }
+
+    /*!
+      \brief Get the global index space of the half spectrum owned by this
+      rank.
+    */
+    IndexSpace<num_space_dim> spectralIndexSpace() const
+    {
+        return _spectral_space;
+    }
+
+    /*!
+      \brief Get the half spectrum owned by this rank.
+    */
+    spectral_view_type spectralView() const { return _spectral_data; }
+
+    /*!
+      \brief Do a forward FFT of a real array into the half spectrum.
+      \param x The real array on which to perform the forward transform. It
+      is not modified.
+      \param ScaleType Method of scaling data.
+    */
+    template <class Array_t, class ScaleType>
+    void forward(
+        const Array_t& x, const ScaleType,
+        typename std::enable_if<
+            ( is_array<Array_t>::value &&
+              is_matching_array<
+                  typename Array_t::entity_type, typename Array_t::mesh_type,
+                  typename Array_t::device_type, typename Array_t::value_type,
+                  entity_type, mesh_type, device_type, value_type>::value ),
+            int>::type* = 0 )
+    {
+        checkArrayDofs( x.layout()->dofsPerEntity() );
+        auto own_space =
+            x.layout()->localGrid()->indexSpace( Own(), EntityType(), Local() );
+        auto local_view = createView<Scalar, Kokkos::LayoutRight, DeviceType>(
+            own_space, _real_work.data() );
+        copyToLocal( own_space, local_view, x.view() );
+
+        _fft->forward(
+            _real_work.data(),
+            reinterpret_cast<std::complex<Scalar>*>( _spectral_data.data() ),
+            Impl::HeffteScalingTraits<ScaleType>().scaling_type );
+    }
+
+    /*!
+      \brief Do a reverse FFT of the half spectrum into a real array.
+      \param x The real array in which to write the reverse transform.
+      \param ScaleType Method of scaling data.
+    */
+    template <class Array_t, class ScaleType>
+    void reverse(
+        const Array_t& x, const ScaleType,
+        typename std::enable_if<
+            ( is_array<Array_t>::value &&
+              is_matching_array<
+                  typename Array_t::entity_type, typename Array_t::mesh_type,
+                  typename Array_t::device_type, typename Array_t::value_type,
+                  entity_type, mesh_type, device_type, value_type>::value ),
+            int>::type* = 0 )
+    {
+        checkArrayDofs( x.layout()->dofsPerEntity() );
+        _fft->backward(
+            reinterpret_cast<std::complex<Scalar>*>( _spectral_data.data() ),
+            _real_work.data(),
+            Impl::HeffteScalingTraits<ScaleType>().scaling_type );
+
+        auto own_space =
+            x.layout()->localGrid()->indexSpace( Own(), EntityType(), Local() );
+        auto local_view = createView<Scalar, Kokkos::LayoutRight, DeviceType>(
+            own_space, _real_work.data() );
+        auto localghost_view = x.view();
+        copyFromLocal( own_space, local_view, localghost_view );
+    }
+
+    /*!
+      \brief Copy owned real data for FFT.
+    */
+    template <class IndexSpaceType, class LViewType, class LGViewType,
+              std::size_t NSD = num_space_dim>
+    std::enable_if_t<3 == NSD, void>
+    copyToLocal( const IndexSpaceType own_space, LViewType& l_view,
+                 const LGViewType lg_view )
+    {
+        Kokkos::parallel_for(
+            "fft_copy_to_real_work",
+            createExecutionPolicy( own_space, exec_space() ),
+            KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+                l_view( i - own_space.min( Dim::I ),
+                        j - own_space.min( Dim::J ),
+                        k - own_space.min( Dim::K ) ) = lg_view( i, j, k, 0 );
+            } );
+    }
+
+    /*!
+      \brief Copy owned real data for FFT.
+    */
+    template <class IndexSpaceType, class LViewType, class LGViewType,
+              std::size_t NSD = num_space_dim>
+    std::enable_if_t<2 == NSD, void>
+    copyToLocal( const IndexSpaceType own_space, LViewType& l_view,
+                 const LGViewType lg_view )
+    {
+        Kokkos::parallel_for(
+            "fft_copy_to_real_work",
+            createExecutionPolicy( own_space, exec_space() ),
+            KOKKOS_LAMBDA( const int i, const int j ) {
+                l_view( i - own_space.min( Dim::I ),
+                        j - own_space.min( Dim::J ) ) = lg_view( i, j, 0 );
+            } );
+    }
+
+    /*!
+      \brief Copy owned real data back after FFT.
+    */
+    template <class IndexSpaceType, class LViewType, class LGViewType,
+              std::size_t NSD = num_space_dim>
+    std::enable_if_t<3 == NSD, void>
+    copyFromLocal( const IndexSpaceType own_space, const LViewType l_view,
+                   LGViewType& lg_view )
+    {
+        Kokkos::parallel_for(
+            "fft_copy_from_real_work",
+            createExecutionPolicy( own_space, exec_space() ),
+            KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+                lg_view( i, j, k, 0 ) =
+                    l_view( i - own_space.min( Dim::I ),
+                            j - own_space.min( Dim::J ),
+                            k - own_space.min( Dim::K ) );
+            } );
+    }
+
+    /*!
+      \brief Copy owned real data back after FFT.
+    */
+    template <class IndexSpaceType, class LViewType, class LGViewType,
+              std::size_t NSD = num_space_dim>
+    std::enable_if_t<2 == NSD, void>
+    copyFromLocal( const IndexSpaceType own_space, const LViewType l_view,
+                   LGViewType& lg_view )
+    {
+        Kokkos::parallel_for(
+            "fft_copy_from_real_work",
+            createExecutionPolicy( own_space, exec_space() ),
+            KOKKOS_LAMBDA( const int i, const int j ) {
+                lg_view( i, j, 0 ) = l_view( i - own_space.min( Dim::I ),
+                                             j - own_space.min( Dim::J ) );
+            } );
+    }
+
+  private:
+    std::shared_ptr<heffte::fft3d_r2c<heffte_backend_type>> _fft;
+    Kokkos::View<Scalar*, DeviceType> _real_work;
+    IndexSpace<num_space_dim> _spectral_space;
+    spectral_view_type _spectral_data;
 };
 
 //---------------------------------------------------------------------------//
@@ -612,6 +1165,57 @@ auto createHeffteFastFourierTransform(
         layout );
 }
 
+//! Creation function for heFFTe real-to-complex FFT with explict FFT backend.
+//! \param layout FFT real entity array
+//! \param params FFT parameters
+template <class Scalar, class DeviceType, class BackendType, class EntityType,
+          class MeshType>
+auto createHeffteRealFastFourierTransform(
+    const ArrayLayout<EntityType, MeshType>& layout,
+    const FastFourierTransformParams& params )
+{
+    return std::make_shared<HeffteRealFastFourierTransform<
+        EntityType, MeshType, Scalar, DeviceType, BackendType>>( layout,
+                                                                 params );
+}
+
+//! Creation function for heFFTe real-to-complex FFT with default FFT backend.
+//! \param layout FFT real entity array
+//! \param params FFT parameters
+template <class Scalar, class DeviceType, class EntityType, class MeshType>
+auto createHeffteRealFastFourierTransform(
+    const ArrayLayout<EntityType, MeshType>& layout,
+    const FastFourierTransformParams& params )
+{
+    return createHeffteRealFastFourierTransform<
+        Scalar, DeviceType, Impl::FFTBackendDefault, EntityType, MeshType>(
+        layout, params );
+}
+
+//! Creation function for heFFTe real-to-complex FFT with default FFT backend
+//! and default parameters.
+//! \param layout FFT real entity array
+template <class Scalar, class DeviceType, class EntityType, class MeshType>
+auto createHeffteRealFastFourierTransform(
+    const ArrayLayout<EntityType, MeshType>& layout )
+{
+    using exec_space = typename DeviceType::execution_space;
+    using heffte_backend_type =
+        typename Impl::HeffteBackendTraits<
+            exec_space, Impl::FFTBackendDefault>::backend_type;
+
+    // use default heFFTe params for this backend
+    const heffte::plan_options heffte_params =
+        heffte::default_options<heffte_backend_type>();
+    FastFourierTransformParams params;
+    params.setAllToAll( heffte_params.use_alltoall );
+    params.setPencils( heffte_params.use_pencils );
+    params.setReorder( heffte_params.use_reorder );
+
+    return createHeffteRealFastFourierTransform<Scalar, DeviceType>( layout,
+                                                                     params );
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Experimental
@@ -22,6 +22,7 @@
 
 #include <array>
 #include <memory>
+#include <vector>
 
 #include <mpi.h>
 
@@ -48,11 +49,16 @@ class GlobalGrid
      \param global_mesh The global mesh data.
      \param periodic Whether each logical dimension is periodic.
      \param partitioner The grid partitioner.
+     \param node_aware If true, place the ranks of each shared memory node in
+     a sub-block of the rank grid such that most halo faces stay within a
+     node. Falls back to the MPI rank order if the nodes hold different
+     numbers of ranks or their size does not factor into the rank grid.
     */
     GlobalGrid( MPI_Comm comm,
                 const std::shared_ptr<GlobalMesh<MeshType>>& global_mesh,
                 const std::array<bool, num_space_dim>& periodic,
-                const BlockPartitioner<num_space_dim>& partitioner );
+                const BlockPartitioner<num_space_dim>& partitioner,
+                const bool node_aware = false );
 
     // Destructor.
     ~GlobalGrid();
@@ -61,6 +67,9 @@ class GlobalGrid
     //! Cartesian topology.
     MPI_Comm comm() const;
 
+    //! \brief Determine if the ranks were placed by shared memory node.
+    bool nodeAware() const;
+
     //! \brief Get the global mesh data.
     const GlobalMesh<MeshType>& globalMesh() const;
 
@@ -162,6 +171,29 @@ class GlobalGrid
     //! \param dim Spatial dimension.
     int globalOffset( const int dim ) const;
 
+    //! \brief Set the owned number of cells and the global offset of this
+    //! block, e.g. after a load balancer moved the block boundaries. The
+    //! blocks of all ranks must still tile the global grid. This is
+    //! collective over the grid communicator as the offsets of all blocks
+    //! are gathered.
+    //! \param num_cell Owned number of cells in each dimension.
+    //! \param offset Global cell offset in each dimension.
+    void setNumCellAndOffset( const std::array<int, num_space_dim>& num_cell,
+                              const std::array<int, num_space_dim>& offset );
+
+    /*!
+      \brief Get the global cell offsets of all blocks along a dimension.
+
+      Entry b is the offset of the blocks with index b in the dimension and
+      the last entry is the global number of cells. Tables of uniform blocks
+      are computed locally on first request and cached, while those of
+      blocks set with setNumCellAndOffset() are gathered there. This is not
+      collective.
+
+      \param dim Spatial dimension.
+    */
+    const std::vector<int>& blockOffsets( const int dim ) const;
+
   private:
     MPI_Comm _cart_comm;
     std::shared_ptr<GlobalMesh<MeshType>> _global_mesh;
@@ -172,6 +204,8 @@ class GlobalGrid
     std::array<int, num_space_dim> _global_cell_offset;
     std::array<bool, num_space_dim> _boundary_lo;
     std::array<bool, num_space_dim> _boundary_hi;
+    bool _node_aware;
+    mutable std::array<std::vector<int>, num_space_dim> _block_offsets;
 };
 
 //---------------------------------------------------------------------------//
@@ -183,16 +217,19 @@ class GlobalGrid
   \param global_mesh The global mesh data.
   \param periodic Whether each logical dimension is periodic.
   \param partitioner The grid partitioner.
+  \param node_aware If true, place the ranks of each shared memory node in a
+  sub-block of the rank grid.
 */
 template <class MeshType>
 std::shared_ptr<GlobalGrid<MeshType>>
 createGlobalGrid( MPI_Comm comm,
                   const std::shared_ptr<GlobalMesh<MeshType>>& global_mesh,
                   const std::array<bool, MeshType::num_space_dim>& periodic,
-                  const BlockPartitioner<MeshType::num_space_dim>& partitioner )
+                  const BlockPartitioner<MeshType::num_space_dim>& partitioner,
+                  const bool node_aware = false )
 {
     return std::make_shared<GlobalGrid<MeshType>>( comm, global_mesh, periodic,
-                                                   partitioner );
+                                                   partitioner, node_aware );
 }
 
 //---------------------------------------------------------------------------//
@@ -15,16 +15,122 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <vector>
 
 namespace Cajita
 {
+namespace Impl
+{
+//! \cond Impl
+//---------------------------------------------------------------------------//
+// Create a communicator in which the ranks of each shared memory node tile
+// a sub-block of the Cartesian rank grid. The rank of a process in the new
+// communicator is its linear Cartesian rank. Returns false and creates no
+// communicator if the node sizes differ or do not factor into the rank grid.
+template <std::size_t NumSpaceDim>
+bool createNodeAwareComm( MPI_Comm comm,
+                          const std::array<int, NumSpaceDim>& ranks_per_dim,
+                          MPI_Comm& node_aware_comm )
+{
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+
+    // Group the ranks by shared memory node.
+    MPI_Comm node_comm;
+    MPI_Comm_split_type( comm, MPI_COMM_TYPE_SHARED, comm_rank,
+                         MPI_INFO_NULL, &node_comm );
+    int node_size;
+    int node_rank;
+    MPI_Comm_size( node_comm, &node_size );
+    MPI_Comm_rank( node_comm, &node_rank );
+
+    // All nodes must hold the same number of ranks.
+    int min_node_size;
+    int max_node_size;
+    MPI_Allreduce( &node_size, &min_node_size, 1, MPI_INT, MPI_MIN, comm );
+    MPI_Allreduce( &node_size, &max_node_size, 1, MPI_INT, MPI_MAX, comm );
+    if ( min_node_size != max_node_size )
+    {
+        MPI_Comm_free( &node_comm );
+        return false;
+    }
+
+    // Factor the node size into a sub-block of the rank grid. Each prime
+    // factor, largest first, goes to the dimension with the smallest
+    // sub-block extent it divides to keep the sub-blocks compact. All ranks
+    // compute the same factorization.
+    std::vector<int> factors;
+    int remainder = node_size;
+    for ( int f = 2; f * f <= remainder; ++f )
+        while ( 0 == remainder % f )
+        {
+            factors.push_back( f );
+            remainder /= f;
+        }
+    if ( remainder > 1 )
+        factors.push_back( remainder );
+    std::array<int, NumSpaceDim> node_dims;
+    node_dims.fill( 1 );
+    for ( auto f = factors.rbegin(); f != factors.rend(); ++f )
+    {
+        int dim = -1;
+        for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+            if ( 0 == ( ranks_per_dim[d] / node_dims[d] ) % *f &&
+                 ( dim < 0 || node_dims[d] < node_dims[dim] ) )
+                dim = d;
+        if ( dim < 0 )
+        {
+            MPI_Comm_free( &node_comm );
+            return false;
+        }
+        node_dims[dim] *= *f;
+    }
+
+    // Number the nodes by the rank of their first process.
+    MPI_Comm leader_comm;
+    MPI_Comm_split( comm, ( 0 == node_rank ) ? 0 : MPI_UNDEFINED, comm_rank,
+                    &leader_comm );
+    int node_id = 0;
+    if ( 0 == node_rank )
+    {
+        MPI_Comm_rank( leader_comm, &node_id );
+        MPI_Comm_free( &leader_comm );
+    }
+    MPI_Bcast( &node_id, 1, MPI_INT, 0, node_comm );
+    MPI_Comm_free( &node_comm );
+
+    // The Cartesian index of this rank is the index of its node sub-block
+    // plus its index within the sub-block, both in row-major order.
+    int cart_rank = 0;
+    int node_stride = 1;
+    int local_stride = 1;
+    int cart_stride = 1;
+    for ( int d = NumSpaceDim - 1; d >= 0; --d )
+    {
+        int num_node_block = ranks_per_dim[d] / node_dims[d];
+        int node_index = ( node_id / node_stride ) % num_node_block;
+        int local_index = ( node_rank / local_stride ) % node_dims[d];
+        cart_rank += cart_stride * ( node_index * node_dims[d] + local_index );
+        node_stride *= num_node_block;
+        local_stride *= node_dims[d];
+        cart_stride *= ranks_per_dim[d];
+    }
+
+    MPI_Comm_split( comm, 0, cart_rank, &node_aware_comm );
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+//! \endcond
+} // end namespace Impl
+
 //---------------------------------------------------------------------------//
 // Constructor.
 template <class MeshType>
 GlobalGrid<MeshType>::GlobalGrid(
     MPI_Comm comm, const std::shared_ptr<GlobalMesh<MeshType>>& global_mesh,
     const std::array<bool, num_space_dim>& periodic,
-    const BlockPartitioner<num_space_dim>& partitioner )
+    const BlockPartitioner<num_space_dim>& partitioner, const bool node_aware )
     : _global_mesh( global_mesh )
     , _periodic( periodic )
 {
@@ -39,10 +145,24 @@ GlobalGrid<MeshType>::GlobalGrid(
     for ( std::size_t d = 0; d < num_space_dim; ++d )
         periodic_dims[d] = _periodic[d];
 
-    // Generate a communicator with a Cartesian topology.
-    int reorder_cart_ranks = 1;
-    MPI_Cart_create( comm, num_space_dim, _ranks_per_dim.data(),
-                     periodic_dims.data(), reorder_cart_ranks, &_cart_comm );
+    // Generate a communicator with a Cartesian topology. Node-aware
+    // placement fixes the rank order itself, otherwise MPI may reorder.
+    MPI_Comm node_aware_comm;
+    _node_aware = node_aware && Impl::createNodeAwareComm(
+                                    comm, _ranks_per_dim, node_aware_comm );
+    if ( _node_aware )
+    {
+        MPI_Cart_create( node_aware_comm, num_space_dim, _ranks_per_dim.data(),
+                         periodic_dims.data(), 0, &_cart_comm );
+        MPI_Comm_free( &node_aware_comm );
+    }
+    else
+    {
+        int reorder_cart_ranks = 1;
+        MPI_Cart_create( comm, num_space_dim, _ranks_per_dim.data(),
+                         periodic_dims.data(), reorder_cart_ranks,
+                         &_cart_comm );
+    }
 
     // Get the Cartesian topology index of this rank.
     int linear_rank;
@@ -59,18 +179,12 @@ GlobalGrid<MeshType>::GlobalGrid(
         dim_remainder[d] = global_num_cell[d] % _ranks_per_dim[d];
     }
 
-    // Compute the global cell offset and the local low corner on this rank by
-    // computing the starting global cell index via exclusive scan.
+    // Compute the global cell offset of this rank. The first remainder
+    // blocks own one extra cell such that the offset follows directly from
+    // the block index without visiting the blocks below it.
     for ( std::size_t d = 0; d < num_space_dim; ++d )
-    {
-        _global_cell_offset[d] = 0;
-        for ( int r = 0; r < _cart_rank[d]; ++r )
-        {
-            _global_cell_offset[d] += cells_per_dim[d];
-            if ( dim_remainder[d] > r )
-                ++_global_cell_offset[d];
-        }
-    }
+        _global_cell_offset[d] = _cart_rank[d] * cells_per_dim[d] +
+                                 std::min( _cart_rank[d], dim_remainder[d] );
 
     // Compute the number of local cells in this rank in each dimension.
     for ( std::size_t d = 0; d < num_space_dim; ++d )
@@ -104,6 +218,14 @@ MPI_Comm GlobalGrid<MeshType>::comm() const
     return _cart_comm;
 }
 
+//---------------------------------------------------------------------------//
+// Determine if the ranks were placed by shared memory node.
+template <class MeshType>
+bool GlobalGrid<MeshType>::nodeAware() const
+{
+    return _node_aware;
+}
+
 //---------------------------------------------------------------------------//
 // Get the global mesh data.
 template <class MeshType>
@@ -319,6 +441,62 @@ int GlobalGrid<MeshType>::globalOffset( const int dim ) const
     return _global_cell_offset[dim];
 }
 
+//---------------------------------------------------------------------------//
+// Set the owned number of cells and the global offset of this block.
+template <class MeshType>
+void GlobalGrid<MeshType>::setNumCellAndOffset(
+    const std::array<int, num_space_dim>& num_cell,
+    const std::array<int, num_space_dim>& offset )
+{
+    std::copy( std::begin( num_cell ), std::end( num_cell ),
+               std::begin( _owned_num_cell ) );
+    std::copy( std::begin( offset ), std::end( offset ),
+               std::begin( _global_cell_offset ) );
+
+    // The blocks are no longer uniform. Gather the offset tables of the new
+    // blocks now, while all ranks of the grid take part, such that later
+    // requests are local. For each dimension the offsets are gathered over
+    // the row of blocks along it. Blocks are rectilinear so every row along
+    // the dimension has the same offsets.
+    for ( std::size_t dim = 0; dim < num_space_dim; ++dim )
+    {
+        auto& offsets = _block_offsets[dim];
+        int num_block = _ranks_per_dim[dim];
+        offsets.resize( num_block + 1 );
+        std::array<int, num_space_dim> remain_dims;
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+            remain_dims[d] = ( d == dim );
+        MPI_Comm row_comm;
+        MPI_Cart_sub( _cart_comm, remain_dims.data(), &row_comm );
+        MPI_Allgather( &_global_cell_offset[dim], 1, MPI_INT, offsets.data(),
+                       1, MPI_INT, row_comm );
+        MPI_Comm_free( &row_comm );
+        offsets[num_block] = _global_mesh->globalNumCell( dim );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Get the global cell offsets of the blocks along a dimension.
+template <class MeshType>
+const std::vector<int>&
+GlobalGrid<MeshType>::blockOffsets( const int dim ) const
+{
+    // Offsets of blocks set with setNumCellAndOffset() were gathered there.
+    auto& offsets = _block_offsets[dim];
+    if ( !offsets.empty() )
+        return offsets;
+
+    // Uniform blocks have closed form offsets.
+    int num_block = _ranks_per_dim[dim];
+    offsets.resize( num_block + 1 );
+    int num_cell = _global_mesh->globalNumCell( dim );
+    int cells_per_dim = num_cell / num_block;
+    int dim_remainder = num_cell % num_block;
+    for ( int b = 0; b <= num_block; ++b )
+        offsets[b] = b * cells_per_dim + std::min( b, dim_remainder );
+    return offsets;
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Cajita
@@ -0,0 +1,213 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cajita_HDF5ArrayIO.hpp
+  \brief Parallel HDF5 grid array output
+*/
+#ifndef CAJITA_HDF5ARRAYIO_HPP
+#define CAJITA_HDF5ARRAYIO_HPP
+
+#include <Cajita_Array.hpp>
+#include <Cajita_IndexSpace.hpp>
+#include <Cajita_Types.hpp>
+
+#include <Cabana_HDF5ParticleIO.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <hdf5.h>
+#include <mpi.h>
+
+#include <stdexcept>
+#include <string>
+
+namespace Cajita
+{
+namespace Experimental
+{
+namespace HDF5ArrayOutput
+{
+//! HDF5 access configuration shared with the particle output.
+using HDF5Config = Cabana::Experimental::HDF5ParticleOutput::HDF5Config;
+
+namespace Impl
+{
+//! \cond Impl
+//---------------------------------------------------------------------------//
+// Write the owned entities of an array as a (global index..., dof) dataset.
+// Each rank writes its owned block at its global offset.
+template <class Array_t>
+void writeArray( const HDF5Config& h5_config, hid_t file_id, hid_t dxpl_id,
+                 const Array_t& array )
+{
+    namespace ParticleImpl = Cabana::Experimental::HDF5ParticleOutput::Impl;
+
+    using entity_type = typename Array_t::entity_type;
+    using value_type = typename Array_t::value_type;
+    using memory_space = typename Array_t::memory_space;
+    constexpr std::size_t num_space_dim = Array_t::num_space_dim;
+    constexpr std::size_t rank = num_space_dim + 1;
+
+    const auto& local_grid = *( array.layout()->localGrid() );
+    const auto& global_grid = local_grid.globalGrid();
+    std::string name = array.label();
+    if ( name.empty() )
+        throw std::logic_error( "HDF5 array output requires labeled arrays" );
+
+    // Gather the owned entities into contiguous memory and stage them on the
+    // host.
+    auto owned_space = array.layout()->indexSpace( Own(), Local() );
+    auto owned_subview = createSubview( array.view(), owned_space );
+    auto owned_view = createView<value_type, Kokkos::LayoutRight,
+                                 memory_space>( name, owned_space );
+    Kokkos::deep_copy( owned_view, owned_subview );
+    auto host_view =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), owned_view );
+
+    hsize_t dims_global[rank];
+    hsize_t dims_local[rank];
+    hsize_t offset[rank];
+    for ( std::size_t d = 0; d < num_space_dim; ++d )
+    {
+        dims_global[d] = global_grid.globalNumEntity( entity_type(), d );
+        dims_local[d] = owned_space.extent( d );
+        offset[d] = global_grid.globalOffset( d );
+    }
+    dims_global[num_space_dim] = owned_space.extent( num_space_dim );
+    dims_local[num_space_dim] = owned_space.extent( num_space_dim );
+    offset[num_space_dim] = 0;
+
+    hid_t filespace_id = H5Screate_simple( rank, dims_global, nullptr );
+    hid_t memspace_id = H5Screate_simple( rank, dims_local, nullptr );
+
+    // Optionally chunk the dataset by the largest owned block of all ranks.
+    // The dataset creation is collective and needs the same chunk shape on
+    // every rank, also with uneven decompositions and empty ranks.
+    hid_t dcpl_id = H5Pcreate( H5P_DATASET_CREATE );
+    if ( h5_config.chunk_size > 0 )
+    {
+        unsigned long long dims_chunk[rank];
+        for ( std::size_t d = 0; d < rank; ++d )
+            dims_chunk[d] = dims_local[d];
+        MPI_Allreduce( MPI_IN_PLACE, dims_chunk, rank,
+                       MPI_UNSIGNED_LONG_LONG, MPI_MAX, global_grid.comm() );
+        hsize_t chunk_dims[rank];
+        bool empty = false;
+        for ( std::size_t d = 0; d < rank; ++d )
+        {
+            chunk_dims[d] = dims_chunk[d];
+            empty = empty || ( 0 == chunk_dims[d] );
+        }
+        if ( !empty )
+            ParticleImpl::checkHDF5(
+                H5Pset_chunk( dcpl_id, rank, chunk_dims ), "H5Pset_chunk" );
+    }
+
+    hid_t dset_id = H5Dcreate(
+        file_id, name.c_str(), ParticleImpl::HDF5Traits<value_type>::type(),
+        filespace_id, H5P_DEFAULT, dcpl_id, H5P_DEFAULT );
+    if ( dset_id < 0 )
+        throw std::runtime_error( "HDF5 error creating dataset " + name );
+
+    if ( 0 == owned_space.size() )
+    {
+        H5Sselect_none( filespace_id );
+        H5Sselect_none( memspace_id );
+    }
+    else
+    {
+        H5Sselect_hyperslab( filespace_id, H5S_SELECT_SET, offset, nullptr,
+                             dims_local, nullptr );
+    }
+    ParticleImpl::checkHDF5(
+        H5Dwrite( dset_id, ParticleImpl::HDF5Traits<value_type>::type(),
+                  memspace_id, filespace_id, dxpl_id, host_view.data() ),
+        "H5Dwrite " + name );
+
+    H5Dclose( dset_id );
+    H5Pclose( dcpl_id );
+    H5Sclose( memspace_id );
+    H5Sclose( filespace_id );
+}
+
+//---------------------------------------------------------------------------//
+inline void writeArrays( const HDF5Config&, hid_t, hid_t ) {}
+
+template <class Array_t, class... ArrayTypes>
+void writeArrays( const HDF5Config& h5_config, hid_t file_id, hid_t dxpl_id,
+                  const Array_t& array, const ArrayTypes&... arrays )
+{
+    writeArray( h5_config, file_id, dxpl_id, array );
+    writeArrays( h5_config, file_id, dxpl_id, arrays... );
+}
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Write grid arrays to one parallel HDF5 file per time step.
+
+  Every array is written as a (global index..., dof) dataset named by the
+  array label, with each rank's owned entities at their global offset. All
+  ranks of the grid write into the same file through MPI-IO. The time and
+  step are stored as attributes of the root group.
+
+  \param h5_config HDF5 access configuration. A nonzero chunk size chunks
+  the datasets by the largest owned block of all ranks.
+  \param prefix File name prefix. The file is <prefix>_<step>.h5.
+  \param step The time step index.
+  \param time The time of the step.
+  \param array The first array to write.
+  \param arrays Further arrays on the same grid to write.
+*/
+template <class Array_t, class... ArrayTypes>
+void writeTimeStep( const HDF5Config& h5_config, const std::string& prefix,
+                    const int step, const double time, const Array_t& array,
+                    const ArrayTypes&... arrays )
+{
+    namespace ParticleImpl = Cabana::Experimental::HDF5ParticleOutput::Impl;
+
+    MPI_Comm comm = array.layout()->localGrid()->globalGrid().comm();
+    hid_t fapl_id = ParticleImpl::fileAccess( h5_config, comm );
+    std::string filename = ParticleImpl::fileName( prefix, step );
+    hid_t file_id =
+        H5Fcreate( filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, fapl_id );
+    if ( file_id < 0 )
+        throw std::runtime_error( "HDF5 error creating " + filename );
+
+    // Store the time step information.
+    hid_t attr_space_id = H5Screate( H5S_SCALAR );
+    hid_t attr_id = H5Acreate( file_id, "Time", H5T_NATIVE_DOUBLE,
+                               attr_space_id, H5P_DEFAULT, H5P_DEFAULT );
+    H5Awrite( attr_id, H5T_NATIVE_DOUBLE, &time );
+    H5Aclose( attr_id );
+    attr_id = H5Acreate( file_id, "Step", H5T_NATIVE_INT, attr_space_id,
+                         H5P_DEFAULT, H5P_DEFAULT );
+    H5Awrite( attr_id, H5T_NATIVE_INT, &step );
+    H5Aclose( attr_id );
+    H5Sclose( attr_space_id );
+
+    hid_t dxpl_id = ParticleImpl::dataTransfer( h5_config );
+    Impl::writeArrays( h5_config, file_id, dxpl_id, array, arrays... );
+
+    H5Pclose( dxpl_id );
+    H5Fclose( file_id );
+    H5Pclose( fapl_id );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace HDF5ArrayOutput
+} // end namespace Experimental
+} // end namespace Cajita
+
+#endif // end CAJITA_HDF5ARRAYIO_HPP
@@ -18,8 +18,13 @@
 
 #include <Cajita_Array.hpp>
 #include <Cajita_IndexSpace.hpp>
+#include <Cajita_Parallel.hpp>
 
+#include <Cabana_CommProgress.hpp>
+#include <Cabana_CommStatistics.hpp>
+#include <Cabana_CommunicationPlan.hpp>
 #include <Cabana_ParameterPack.hpp>
+#include <impl/Cabana_Profiling.hpp>
 
 #include <Kokkos_Core.hpp>
 
@@ -28,6 +33,12 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstdlib>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <stdexcept>
 #include <type_traits>
 #include <vector>
 
@@ -57,14 +68,31 @@ class HaloPattern
         _neighbors = neighbors;
     }
 
+    //! Assign the neighbors that are in the halo pattern and the halo width
+    //! needed from each of them.
+    void
+    setNeighbors( const std::vector<std::array<int, num_space_dim>>& neighbors,
+                  const std::vector<int>& widths )
+    {
+        if ( neighbors.size() != widths.size() )
+            throw std::runtime_error( "Neighbors and widths different sizes" );
+        _neighbors = neighbors;
+        _widths = widths;
+    }
+
     //! Get the neighbors that are in the halo pattern.
     std::vector<std::array<int, num_space_dim>> getNeighbors() const
     {
         return _neighbors;
     }
 
+    //! Get the halo width needed from each neighbor. If empty, the width of
+    //! the halo is used for all neighbors.
+    std::vector<int> getWidths() const { return _widths; }
+
   private:
     std::vector<std::array<int, num_space_dim>> _neighbors;
+    std::vector<int> _widths;
 };
 
 //! %Halo with node connectivity. I.e. communicate with all neighbor ranks with
@@ -152,6 +180,58 @@ class FullHaloPattern : public NodeHaloPattern<3>
 {
 };
 
+/*!
+  \brief %Halo built from the offsets of a stencil. Only the neighbors that
+  the stencil actually reads from are in the pattern and the halo width
+  needed from each neighbor is the largest stencil reach in its direction. For
+  example, a 7-point Laplacian only uses the face neighbors and an upwind
+  stencil only uses the neighbors on the upstream side.
+*/
+template <std::size_t NumSpaceDim>
+class StencilHaloPattern : public HaloPattern<NumSpaceDim>
+{
+  public:
+    /*!
+      \brief Constructor.
+      \param offsets The logical index offsets of each point in the
+      stencil. Offsets of zero are ignored.
+    */
+    StencilHaloPattern(
+        const std::vector<std::array<int, NumSpaceDim>>& offsets )
+        : HaloPattern<NumSpaceDim>()
+    {
+        std::vector<std::array<int, NumSpaceDim>> neighbors;
+        std::vector<int> widths;
+        for ( const auto& o : offsets )
+        {
+            // The neighbor direction of the offset and its reach.
+            std::array<int, NumSpaceDim> n;
+            int width = 0;
+            for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+            {
+                n[d] = ( o[d] > 0 ) - ( o[d] < 0 );
+                width = std::max( width, std::abs( o[d] ) );
+            }
+            if ( 0 == width )
+                continue;
+
+            // Add the neighbor or update its width.
+            auto found = std::find( neighbors.begin(), neighbors.end(), n );
+            if ( found == neighbors.end() )
+            {
+                neighbors.push_back( n );
+                widths.push_back( width );
+            }
+            else
+            {
+                auto i = std::distance( neighbors.begin(), found );
+                widths[i] = std::max( widths[i], width );
+            }
+        }
+        this->setNeighbors( neighbors, widths );
+    }
+};
+
 //---------------------------------------------------------------------------//
 // Scatter reduction.
 //---------------------------------------------------------------------------//
@@ -210,12 +290,19 @@ class Halo
       \tparam The arrays types to construct the halo for.
       \param pattern The halo pattern to use for halo communication.
       \param width Halo cell width. Must be less than or equal to the halo
-      width of the block.
+      width of the block. If the pattern gives a width for each neighbor these
+      are used instead, limited to this width.
       \param arrays The arrays to build the halo for. These arrays must be
       provided in the same order
+
+      \note If the pattern is not symmetric (e.g. it only contains the
+      neighbors on one side) data is only exchanged in the directions the
+      pattern reads from: ghosts are only filled from neighbors in the pattern
+      and owned data is only sent to the neighbors in the opposite directions.
     */
     template <class Pattern, class... ArrayTypes>
     Halo( const Pattern& pattern, const int width, const ArrayTypes&... arrays )
+        : _gather_precision( Cabana::CommPrecision::Full )
     {
         // Spatial dimension.
         const std::size_t num_space_dim = Pattern::num_space_dim;
@@ -244,11 +331,31 @@ class Halo
             return flip_ijk;
         };
 
+        // Get the ghost width needed from each neighbor in the pattern.
+        auto neighbors = pattern.getNeighbors();
+        auto widths = pattern.getWidths();
+        auto ghost_width = [&]( const std::array<int, num_space_dim>& ijk ) {
+            auto found = std::find( neighbors.begin(), neighbors.end(), ijk );
+            if ( found == neighbors.end() )
+                return 0;
+            if ( widths.empty() )
+                return width;
+            int w = widths[std::distance( neighbors.begin(), found )];
+            return ( -1 == width ) ? w : std::min( w, width );
+        };
+
+        // We send owned data to the neighbors opposite of the directions in
+        // the pattern so add those to the exchange.
+        auto exchange = neighbors;
+        for ( const auto& n : neighbors )
+            if ( std::find( exchange.begin(), exchange.end(), flip_id( n ) ) ==
+                 exchange.end() )
+                exchange.push_back( flip_id( n ) );
+
         // Get the neighbor ranks we will exchange with in the halo and
         // allocate buffers. If any of the exchanges are self sends mark these
         // so we know which send buffers correspond to which receive buffers.
-        auto neighbors = pattern.getNeighbors();
-        for ( const auto& n : neighbors )
+        for ( const auto& n : exchange )
         {
             // Get the rank of the neighbor.
             int rank = local_grid->neighborRank( n );
@@ -267,19 +374,91 @@ class Halo
                 // neighbor. The sending rank should have a matching tag.
                 _receive_tags.push_back( neighbor_id( flip_id( n ) ) );
 
-                // Create communication data for owned entities.
-                buildCommData( Own(), width, n, _owned_buffers, _owned_steering,
+                // Create communication data for owned entities. The
+                // neighbor ghosts these with the width it needs from us.
+                buildCommData( Own(), ghost_width( flip_id( n ) ), n,
+                               _owned_buffers, _owned_steering, _owned_blocks,
                                arrays... );
 
                 // Create communication data for ghosted entities.
-                buildCommData( Ghost(), width, n, _ghosted_buffers,
-                               _ghosted_steering, arrays... );
+                buildCommData( Ghost(), ghost_width( n ), n, _ghosted_buffers,
+                               _ghosted_steering, _ghosted_blocks, arrays... );
             }
         }
+
+        // The buffers and neighbors are fixed for the life of the halo so
+        // create persistent requests for the gather and scatter.
+        createRequests( 1234, _ghosted_buffers, _owned_buffers,
+                        _gather_requests );
+        createRequests( 2345, _owned_buffers, _ghosted_buffers,
+                        _scatter_requests );
     }
 
     // Destructor.
-    ~Halo() { MPI_Comm_free( &_comm ); }
+    ~Halo()
+    {
+        freeRequests( _gather_requests );
+        freeRequests( _reduced_gather_requests );
+        freeRequests( _scatter_requests );
+        MPI_Comm_free( &_comm );
+    }
+
+    /*!
+      \brief Set the precision of the data sent by gathers. With reduced
+      precision double arrays are sent as float and widened again in the
+      ghosts. Scatters always send full precision data.
+
+      \param precision The gather precision. All ranks must use the same
+      precision.
+    */
+    void setGatherPrecision( const Cabana::CommPrecision precision )
+    {
+        _gather_precision = precision;
+    }
+
+    //! Get the precision of the data sent by gathers.
+    Cabana::CommPrecision gatherPrecision() const { return _gather_precision; }
+
+    /*!
+      \brief Attach statistics in which the gathers and scatters executed
+      with this halo are recorded.
+
+      \param stats The statistics. Pass nullptr to stop recording.
+    */
+    void
+    setStatistics( const std::shared_ptr<Cabana::CommStatistics>& stats )
+    {
+        _stats = stats;
+    }
+
+    /*!
+      \brief Get the statistics attached to the halo. This is nullptr if none
+      are attached.
+    */
+    std::shared_ptr<Cabana::CommStatistics> statistics() const
+    {
+        return _stats;
+    }
+
+    /*!
+      \brief Attach a progress thread driving the messages of split-phase
+      gathers between startGather and finishGather.
+
+      \param progress The progress thread. Pass nullptr to detach.
+    */
+    void setProgress( const std::shared_ptr<Cabana::CommProgress>& progress )
+    {
+        _progress = progress;
+    }
+
+    /*!
+      \brief Get the progress thread attached to the halo. This is nullptr if
+      none is attached.
+    */
+    std::shared_ptr<Cabana::CommProgress> progress() const
+    {
+        return _progress;
+    }
 
     /*!
       \brief Gather data into our ghosts from their owners.
@@ -295,57 +474,138 @@ class Halo
     void gather( const ExecutionSpace& exec_space,
                  const ArrayTypes&... arrays ) const
     {
+        enqueueGather( exec_space, arrays... );
+        exec_space.fence();
+    }
+
+    /*!
+      \brief Gather data into our ghosts from their owners in stream order.
+
+      The pack kernels are enqueued on the given execution space instance and
+      only that instance is synchronized before the data is given to MPI. The
+      unpack kernels are enqueued on the same instance as the data arrives
+      and are not fenced on return. Work enqueued on the instance afterwards
+      will see the gathered data. The halos of several arrays may therefore be
+      pipelined using separate execution space instances.
+
+      \param exec_space The execution space instance to use for pack/unpack.
+
+      \param arrays The arrays to gather. NOTE: These arrays must be given in
+      the same order as in the constructor.
+    */
+    template <class ExecutionSpace, class... ArrayTypes>
+    void enqueueGather( const ExecutionSpace& exec_space,
+                        const ArrayTypes&... arrays ) const
+    {
+        startGather( exec_space, arrays... );
+        finishGather( exec_space, arrays... );
+    }
+
+    /*!
+      \brief Start gathering data into our ghosts from their owners.
+
+      The send buffers are packed on the given execution space instance and
+      the messages are started. Work not depending on the ghosts may be done
+      until the gather is completed with finishGather. The owned data of the
+      arrays must not be modified until then.
+
+      \param exec_space The execution space instance to use for packing.
+
+      \param arrays The arrays to gather. NOTE: These arrays must be given in
+      the same order as in the constructor.
+    */
+    template <class ExecutionSpace, class... ArrayTypes>
+    void startGather( const ExecutionSpace& exec_space,
+                      const ArrayTypes&... arrays ) const
+    {
+        Cabana::Impl::ScopedProfileRegion region(
+            "Cajita::Halo::startGather" );
+
         // Get the number of neighbors. Return if we have none.
         int num_n = _neighbor_ranks.size();
         if ( 0 == num_n )
             return;
 
-        // Allocate requests.
-        std::vector<MPI_Request> requests( 2 * num_n, MPI_REQUEST_NULL );
-
-        // Pick a tag to use for communication. This object has its own
-        // communication space so any tag will do.
-        const int mpi_tag = 1234;
-
-        // Post receives.
+        // With reduced precision the data is sent through separate buffers
+        // holding the reduced types. These are created by the first reduced
+        // gather.
+        bool reduced = ( Cabana::CommPrecision::Reduced == _gather_precision );
+        if ( reduced )
+            createReducedGather( arrays.view()... );
+        auto& requests = reduced ? _reduced_gather_requests : _gather_requests;
+        const auto& send_buffers =
+            reduced ? _reduced_owned_buffers : _owned_buffers;
+
+        // Pack send buffers. Only process neighbors with work to do.
         for ( int n = 0; n < num_n; ++n )
         {
-            // Only process this neighbor if there is work to do.
-            if ( 0 < _ghosted_buffers[n].size() )
+            if ( 0 < send_buffers[n].size() )
             {
-                MPI_Irecv( _ghosted_buffers[n].data(),
-                           _ghosted_buffers[n].size(), MPI_BYTE,
-                           _neighbor_ranks[n], mpi_tag + _receive_tags[n],
-                           _comm, &requests[n] );
+                if ( reduced )
+                    packReducedBuffer( exec_space, send_buffers[n],
+                                       _owned_blocks[n], arrays.view()... );
+                else
+                    packBuffer( exec_space, send_buffers[n],
+                                _owned_steering[n], arrays.view()... );
             }
         }
 
-        // Pack send buffers and post sends.
+        // Wait for the packing on this execution space instance and start the
+        // receives and sends. The fence also completes any unpacking of the
+        // receive buffers still enqueued by the previous exchange on this
+        // instance so the receives do not overwrite them.
+        exec_space.fence();
+        if ( !requests.recv.empty() )
+            MPI_Startall( requests.recv.size(), requests.recv.data() );
         for ( int n = 0; n < num_n; ++n )
-        {
-            // Only process this neighbor if there is work to do.
-            if ( 0 < _owned_buffers[n].size() )
-            {
-                // Pack the send buffer.
-                packBuffer( exec_space, _owned_buffers[n], _owned_steering[n],
-                            arrays.view()... );
-
-                // Post a send.
-                MPI_Isend( _owned_buffers[n].data(), _owned_buffers[n].size(),
-                           MPI_BYTE, _neighbor_ranks[n],
-                           mpi_tag + _send_tags[n], _comm,
-                           &requests[num_n + n] );
-            }
-        }
+            if ( 0 < send_buffers[n].size() )
+                MPI_Start( &requests.send[n] );
+        recordOperation(
+            send_buffers,
+            reduced ? _reduced_ghosted_buffers : _ghosted_buffers );
+        if ( _progress )
+            _progress->begin();
+    }
+
+    /*!
+      \brief Finish gathering data into our ghosts from their owners.
+
+      The receive buffers are unpacked on the given execution space instance
+      as the data arrives and are not fenced on return.
+
+      \param exec_space The execution space instance to use for unpacking.
+
+      \param arrays The arrays given to startGather.
+    */
+    template <class ExecutionSpace, class... ArrayTypes>
+    void finishGather( const ExecutionSpace& exec_space,
+                       const ArrayTypes&... arrays ) const
+    {
+        Cabana::Impl::ScopedProfileRegion region(
+            "Cajita::Halo::finishGather" );
+
+        // Get the number of neighbors. Return if we have none.
+        int num_n = _neighbor_ranks.size();
+        if ( 0 == num_n )
+            return;
+
+        bool reduced = ( Cabana::CommPrecision::Reduced == _gather_precision );
+        auto& requests = reduced ? _reduced_gather_requests : _gather_requests;
+        const auto& recv_buffers =
+            reduced ? _reduced_ghosted_buffers : _ghosted_buffers;
 
         // Unpack receive buffers.
         bool unpack_complete = false;
         while ( !unpack_complete )
         {
-            // Get the next buffer to unpack.
+            // Get the next buffer to unpack. Completed persistent requests
+            // are inactive and are ignored.
             int unpack_index = MPI_UNDEFINED;
-            MPI_Waitany( num_n, requests.data(), &unpack_index,
-                         MPI_STATUS_IGNORE );
+            Cabana::Impl::CommWait comm_wait( "Cajita::Halo::wait",
+                                              _stats.get() );
+            MPI_Waitany( requests.recv.size(), requests.recv.data(),
+                         &unpack_index, MPI_STATUS_IGNORE );
+            comm_wait.stop();
 
             // If there are no more buffers to unpack we are done.
             if ( MPI_UNDEFINED == unpack_index )
@@ -356,15 +616,24 @@ class Halo
             // Otherwise unpack the next buffer.
             else
             {
-                unpackBuffer( ScatterReduce::Replace(), exec_space,
-                              _ghosted_buffers[unpack_index],
-                              _ghosted_steering[unpack_index],
-                              arrays.view()... );
+                int n = requests.recv_neighbors[unpack_index];
+                if ( reduced )
+                    unpackReducedBuffer( exec_space, recv_buffers[n],
+                                         _ghosted_blocks[n],
+                                         arrays.view()... );
+                else
+                    unpackBuffer( ScatterReduce::Replace(), exec_space,
+                                  recv_buffers[n], _ghosted_steering[n],
+                                  _ghosted_blocks[n], arrays.view()... );
             }
         }
 
         // Wait on send requests.
-        MPI_Waitall( num_n, requests.data() + num_n, MPI_STATUSES_IGNORE );
+        Cabana::Impl::CommWait comm_wait( "Cajita::Halo::wait", _stats.get() );
+        MPI_Waitall( num_n, requests.send.data(), MPI_STATUSES_IGNORE );
+        comm_wait.stop();
+        if ( _progress )
+            _progress->end();
     }
 
     /*!
@@ -378,56 +647,114 @@ class Halo
     void scatter( const ExecutionSpace& exec_space, const ReduceOp& reduce_op,
                   const ArrayTypes&... arrays ) const
     {
+        enqueueScatter( exec_space, reduce_op, arrays... );
+        exec_space.fence();
+    }
+
+    /*!
+      \brief Scatter data from our ghosts to their owners using the given type
+      of reduce operation in stream order.
+
+      The pack kernels are enqueued on the given execution space instance and
+      only that instance is synchronized before the data is given to MPI. The
+      unpack kernels are enqueued on the same instance and are not fenced on
+      return.
+
+      \param reduce_op The functor used to reduce the results.
+      \param exec_space The execution space instance to use for pack/unpack.
+      \param arrays The arrays to scatter.
+    */
+    template <class ExecutionSpace, class ReduceOp, class... ArrayTypes>
+    void enqueueScatter( const ExecutionSpace& exec_space,
+                         const ReduceOp& reduce_op,
+                         const ArrayTypes&... arrays ) const
+    {
+        scatterImpl( exec_space, reduce_op, false, arrays... );
+    }
+
+    /*!
+      \brief Scatter data from our ghosts to their owners using the given type
+      of reduce operation, reducing the neighbor contributions in a fixed
+      order.
+
+      The receive buffers are unpacked in neighbor order once all have
+      arrived rather than in order of arrival, such that sum reductions give
+      the same result in every run at the cost of overlapping less of the
+      unpacking with communication.
+
+      \param reduce_op The functor used to reduce the results.
+      \param exec_space The execution space to use for pack/unpack.
+      \param arrays The arrays to scatter.
+    */
+    template <class ExecutionSpace, class ReduceOp, class... ArrayTypes>
+    void orderedScatter( const ExecutionSpace& exec_space,
+                         const ReduceOp& reduce_op,
+                         const ArrayTypes&... arrays ) const
+    {
+        scatterImpl( exec_space, reduce_op, true, arrays... );
+        exec_space.fence();
+    }
+
+  private:
+    // Scatter, optionally unpacking the receive buffers in neighbor order.
+    template <class ExecutionSpace, class ReduceOp, class... ArrayTypes>
+    void scatterImpl( const ExecutionSpace& exec_space,
+                      const ReduceOp& reduce_op, const bool ordered,
+                      const ArrayTypes&... arrays ) const
+    {
+        Cabana::Impl::ScopedProfileRegion region( "Cajita::Halo::scatter" );
+
         // Get the number of neighbors. Return if we have none.
         int num_n = _neighbor_ranks.size();
         if ( 0 == num_n )
             return;
 
-        // Requests.
-        std::vector<MPI_Request> requests( 2 * num_n, MPI_REQUEST_NULL );
-
-        // Pick a tag to use for communication. This object has its own
-        // communication space so any tag will do.
-        const int mpi_tag = 2345;
-
-        // Post receives for all neighbors that are not self sends.
-        for ( int n = 0; n < num_n; ++n )
-        {
-            // Only process this neighbor if there is work to do.
-            if ( 0 < _owned_buffers[n].size() )
-            {
-                MPI_Irecv( _owned_buffers[n].data(), _owned_buffers[n].size(),
-                           MPI_BYTE, _neighbor_ranks[n],
-                           mpi_tag + _receive_tags[n], _comm, &requests[n] );
-            }
-        }
+        auto& requests = _scatter_requests;
 
-        // Pack send buffers and post sends.
+        // Pack send buffers. Only process neighbors with work to do.
         for ( int n = 0; n < num_n; ++n )
-        {
-            // Only process this neighbor if there is work to do.
             if ( 0 < _ghosted_buffers[n].size() )
-            {
-                // Pack the send buffer.
                 packBuffer( exec_space, _ghosted_buffers[n],
                             _ghosted_steering[n], arrays.view()... );
 
-                // Post a send.
-                MPI_Isend( _ghosted_buffers[n].data(),
-                           _ghosted_buffers[n].size(), MPI_BYTE,
-                           _neighbor_ranks[n], mpi_tag + _send_tags[n], _comm,
-                           &requests[num_n + n] );
-            }
+        // Wait for the packing on this execution space instance and start the
+        // receives and sends. The fence also completes any unpacking of the
+        // receive buffers still enqueued by the previous exchange on this
+        // instance so the receives do not overwrite them.
+        exec_space.fence();
+        if ( !requests.recv.empty() )
+            MPI_Startall( requests.recv.size(), requests.recv.data() );
+        for ( int n = 0; n < num_n; ++n )
+            if ( 0 < _ghosted_buffers[n].size() )
+                MPI_Start( &requests.send[n] );
+        recordOperation( _ghosted_buffers, _owned_buffers );
+
+        // Unpack receive buffers in neighbor order.
+        if ( ordered )
+        {
+            Cabana::Impl::CommWait comm_wait( "Cajita::Halo::wait",
+                                              _stats.get() );
+            MPI_Waitall( requests.recv.size(), requests.recv.data(),
+                         MPI_STATUSES_IGNORE );
+            comm_wait.stop();
+            for ( auto n : requests.recv_neighbors )
+                unpackBuffer( reduce_op, exec_space, _owned_buffers[n],
+                              _owned_steering[n], _owned_blocks[n],
+                              arrays.view()... );
         }
 
-        // Unpack receive buffers.
-        bool unpack_complete = false;
+        // Unpack receive buffers in order of arrival.
+        bool unpack_complete = ordered;
         while ( !unpack_complete )
         {
-            // Get the next buffer to unpack.
+            // Get the next buffer to unpack. Completed persistent requests
+            // are inactive and are ignored.
             int unpack_index = MPI_UNDEFINED;
-            MPI_Waitany( num_n, requests.data(), &unpack_index,
-                         MPI_STATUS_IGNORE );
+            Cabana::Impl::CommWait comm_wait( "Cajita::Halo::wait",
+                                              _stats.get() );
+            MPI_Waitany( requests.recv.size(), requests.recv.data(),
+                         &unpack_index, MPI_STATUS_IGNORE );
+            comm_wait.stop();
 
             // If there are no more buffers to unpack we are done.
             if ( MPI_UNDEFINED == unpack_index )
@@ -438,17 +765,130 @@ class Halo
             // Otherwise unpack the next buffer and apply the reduce operation.
             else
             {
-                unpackBuffer( reduce_op, exec_space,
-                              _owned_buffers[unpack_index],
-                              _owned_steering[unpack_index], arrays.view()... );
+                int n = requests.recv_neighbors[unpack_index];
+                unpackBuffer( reduce_op, exec_space, _owned_buffers[n],
+                              _owned_steering[n], _owned_blocks[n],
+                              arrays.view()... );
             }
-
-            // Wait on send requests.
-            MPI_Waitall( num_n, requests.data() + num_n, MPI_STATUSES_IGNORE );
         }
+
+        // Wait on send requests.
+        Cabana::Impl::CommWait comm_wait( "Cajita::Halo::wait", _stats.get() );
+        MPI_Waitall( num_n, requests.send.data(), MPI_STATUSES_IGNORE );
+        comm_wait.stop();
     }
 
   public:
+    //! Persistent requests for one type of exchange. Receives are only
+    //! created for neighbors we receive data from. A send is created for each
+    //! neighbor and is null if there is no data to send.
+    struct PersistentRequests
+    {
+        //! Receive requests.
+        std::vector<MPI_Request> recv;
+        //! The neighbor of each receive request.
+        std::vector<int> recv_neighbors;
+        //! Send requests for each neighbor.
+        std::vector<MPI_Request> send;
+    };
+
+    //! Location of the data of one array in a buffer. The data is the
+    //! shared index space of the array packed in the storage order of the
+    //! array starting at the given byte offset.
+    struct BufferBlock
+    {
+        //! Byte offset of the block in the buffer.
+        std::size_t offset;
+        //! Number of elements in the block.
+        std::size_t size;
+        //! Minimum structured index of the block.
+        std::array<long, 4> min;
+        //! Maximum structured index of the block.
+        std::array<long, 4> max;
+        //! Whether the block stores the degrees of freedom outermost.
+        bool dofs_outermost;
+    };
+
+    //! Create the persistent requests for an exchange.
+    void
+    createRequests( const int mpi_tag,
+                    const std::vector<Kokkos::View<char*, memory_space>>&
+                        recv_buffers,
+                    const std::vector<Kokkos::View<char*, memory_space>>&
+                        send_buffers,
+                    PersistentRequests& requests ) const
+    {
+        int num_n = _neighbor_ranks.size();
+        requests.send.assign( num_n, MPI_REQUEST_NULL );
+        for ( int n = 0; n < num_n; ++n )
+        {
+            if ( 0 < recv_buffers[n].size() )
+            {
+                requests.recv.push_back( MPI_REQUEST_NULL );
+                requests.recv_neighbors.push_back( n );
+                MPI_Recv_init( recv_buffers[n].data(), recv_buffers[n].size(),
+                               MPI_BYTE, _neighbor_ranks[n],
+                               mpi_tag + _receive_tags[n], _comm,
+                               &requests.recv.back() );
+            }
+            if ( 0 < send_buffers[n].size() )
+            {
+                MPI_Send_init( send_buffers[n].data(), send_buffers[n].size(),
+                               MPI_BYTE, _neighbor_ranks[n],
+                               mpi_tag + _send_tags[n], _comm,
+                               &requests.send[n] );
+            }
+        }
+    }
+
+    //! Record an exchange with the given buffers in the statistics, if any.
+    //! Data exchanged with this rank is recorded as self-copied.
+    void recordOperation(
+        const std::vector<Kokkos::View<char*, memory_space>>& send_buffers,
+        const std::vector<Kokkos::View<char*, memory_space>>& recv_buffers )
+        const
+    {
+        if ( !_stats )
+            return;
+
+        int my_rank = -1;
+        MPI_Comm_rank( _comm, &my_rank );
+
+        std::size_t num_messages_sent = 0;
+        std::size_t bytes_sent = 0;
+        std::size_t num_messages_received = 0;
+        std::size_t bytes_received = 0;
+        std::size_t bytes_self = 0;
+        for ( std::size_t n = 0; n < _neighbor_ranks.size(); ++n )
+        {
+            if ( _neighbor_ranks[n] == my_rank )
+            {
+                bytes_self += send_buffers[n].size();
+            }
+            else
+            {
+                num_messages_sent += ( 0 < send_buffers[n].size() ) ? 1 : 0;
+                bytes_sent += send_buffers[n].size();
+                num_messages_received +=
+                    ( 0 < recv_buffers[n].size() ) ? 1 : 0;
+                bytes_received += recv_buffers[n].size();
+            }
+        }
+        _stats->recordOperation( num_messages_sent, bytes_sent,
+                                 num_messages_received, bytes_received,
+                                 bytes_self );
+    }
+
+    //! Free the persistent requests for an exchange.
+    void freeRequests( PersistentRequests& requests )
+    {
+        for ( auto& r : requests.recv )
+            MPI_Request_free( &r );
+        for ( auto& r : requests.send )
+            if ( MPI_REQUEST_NULL != r )
+                MPI_Request_free( &r );
+    }
+
     //! Get the communicator and check to make sure all are the same.
     template <class Array_t>
     void getComm( const Array_t& array )
@@ -508,8 +948,20 @@ class Halo
                    const std::array<int, NumSpaceDim>& nid,
                    std::vector<Kokkos::View<char*, memory_space>>& buffers,
                    std::vector<Kokkos::View<int**, memory_space>>& steering,
+                   std::vector<std::vector<BufferBlock>>& blocks,
                    const ArrayTypes&... arrays )
     {
+        // No data is shared with this neighbor if the width is zero.
+        if ( 0 == width )
+        {
+            buffers.push_back(
+                Kokkos::View<char*, memory_space>( "halo_buffer", 0 ) );
+            steering.push_back( Kokkos::View<int**, memory_space>(
+                "steering", 0, 3 + NumSpaceDim ) );
+            blocks.emplace_back();
+            return;
+        }
+
         // Number of arrays.
         const std::size_t num_array = sizeof...( ArrayTypes );
 
@@ -542,9 +994,47 @@ class Halo
         steering.push_back( Kokkos::View<int**, memory_space>(
             "steering", buffer_num_element, 3 + NumSpaceDim ) );
 
+        // Get the storage order of array degrees of freedom.
+        std::array<bool, num_array> dofs_outermost = {
+            dofsOutermost( arrays, 0 )... };
+
         // Build steering vector.
-        buildSteeringVector( spaces, value_byte_sizes, buffer_bytes,
-                             buffer_num_element, steering );
+        buildSteeringVector( spaces, value_byte_sizes, dofs_outermost,
+                             buffer_bytes, buffer_num_element, steering );
+
+        // Record where the data of each array is in the buffer.
+        blocks.emplace_back( num_array );
+        std::size_t offset = 0;
+        for ( std::size_t a = 0; a < num_array; ++a )
+        {
+            auto& block = blocks.back()[a];
+            block.offset = offset;
+            block.size = spaces[a].size();
+            block.min.fill( 0 );
+            block.max.fill( 0 );
+            block.dofs_outermost = dofs_outermost[a];
+            for ( std::size_t d = 0; d < NumSpaceDim + 1; ++d )
+            {
+                block.min[d] = spaces[a].min( d );
+                block.max[d] = spaces[a].max( d );
+            }
+            offset += value_byte_sizes[a] * spaces[a].size();
+        }
+    }
+
+    //! Whether an array stores degrees of freedom outermost.
+    template <class ArrayType>
+    static auto dofsOutermost( const ArrayType& array, int )
+        -> decltype( array.dofsOutermost() )
+    {
+        return array.dofsOutermost();
+    }
+
+    //! Layouts without data store degrees of freedom innermost.
+    template <class ArrayType>
+    static bool dofsOutermost( const ArrayType&, long )
+    {
+        return false;
     }
 
     //! Build 3d steering vector.
@@ -552,48 +1042,60 @@ class Halo
     void buildSteeringVector(
         const std::array<IndexSpace<4>, NumArray>& spaces,
         const std::array<std::size_t, NumArray>& value_byte_sizes,
+        const std::array<bool, NumArray>& dofs_outermost,
         const int buffer_bytes, const int buffer_num_element,
         std::vector<Kokkos::View<int**, memory_space>>& steering )
     {
         // Create the steering vector. For each element in the buffer it gives
         // the starting byte location of the element, the array the element is
         // in, and the ijkl structured index in the array of the element.
+        // Elements are ordered as they are stored in the array such that
+        // packing reads contiguous memory.
         auto host_steering =
             Kokkos::create_mirror_view( Kokkos::HostSpace(), steering.back() );
         int elem_counter = 0;
         int byte_counter = 0;
         for ( std::size_t a = 0; a < NumArray; ++a )
         {
-            for ( int i = spaces[a].min( 0 ); i < spaces[a].max( 0 ); ++i )
+            auto add_element = [&]( const int i, const int j, const int k,
+                                    const int l ) {
+                // Byte starting location in buffer.
+                host_steering( elem_counter, 0 ) = byte_counter;
+
+                // Array location of element.
+                host_steering( elem_counter, 1 ) = a;
+
+                // Structured index in array of element.
+                host_steering( elem_counter, 2 ) = i;
+                host_steering( elem_counter, 3 ) = j;
+                host_steering( elem_counter, 4 ) = k;
+                host_steering( elem_counter, 5 ) = l;
+
+                // Update element id.
+                ++elem_counter;
+
+                // Update buffer position.
+                byte_counter += value_byte_sizes[a];
+            };
+
+            const auto& space = spaces[a];
+            if ( dofs_outermost[a] )
+            {
+                for ( int l = space.min( 3 ); l < space.max( 3 ); ++l )
+                    for ( int i = space.min( 0 ); i < space.max( 0 ); ++i )
+                        for ( int j = space.min( 1 ); j < space.max( 1 ); ++j )
+                            for ( int k = space.min( 2 ); k < space.max( 2 );
+                                  ++k )
+                                add_element( i, j, k, l );
+            }
+            else
             {
-                for ( int j = spaces[a].min( 1 ); j < spaces[a].max( 1 ); ++j )
-                {
-                    for ( int k = spaces[a].min( 2 ); k < spaces[a].max( 2 );
-                          ++k )
-                    {
-                        for ( int l = spaces[a].min( 3 );
-                              l < spaces[a].max( 3 ); ++l )
-                        {
-                            // Byte starting location in buffer.
-                            host_steering( elem_counter, 0 ) = byte_counter;
-
-                            // Array location of element.
-                            host_steering( elem_counter, 1 ) = a;
-
-                            // Structured index in array of element.
-                            host_steering( elem_counter, 2 ) = i;
-                            host_steering( elem_counter, 3 ) = j;
-                            host_steering( elem_counter, 4 ) = k;
-                            host_steering( elem_counter, 5 ) = l;
-
-                            // Update element id.
-                            ++elem_counter;
-
-                            // Update buffer position.
-                            byte_counter += value_byte_sizes[a];
-                        }
-                    }
-                }
+                for ( int i = space.min( 0 ); i < space.max( 0 ); ++i )
+                    for ( int j = space.min( 1 ); j < space.max( 1 ); ++j )
+                        for ( int k = space.min( 2 ); k < space.max( 2 ); ++k )
+                            for ( int l = space.min( 3 ); l < space.max( 3 );
+                                  ++l )
+                                add_element( i, j, k, l );
             }
         }
 
@@ -614,43 +1116,54 @@ class Halo
     void buildSteeringVector(
         const std::array<IndexSpace<3>, NumArray>& spaces,
         const std::array<std::size_t, NumArray>& value_byte_sizes,
+        const std::array<bool, NumArray>& dofs_outermost,
         const int buffer_bytes, const int buffer_num_element,
         std::vector<Kokkos::View<int**, memory_space>>& steering )
     {
         // Create the steering vector. For each element in the buffer it gives
         // the starting byte location of the element, the array the element is
         // in, and the ijkl structured index in the array of the element.
+        // Elements are ordered as they are stored in the array such that
+        // packing reads contiguous memory.
         auto host_steering =
             Kokkos::create_mirror_view( Kokkos::HostSpace(), steering.back() );
         int elem_counter = 0;
         int byte_counter = 0;
         for ( std::size_t a = 0; a < NumArray; ++a )
         {
-            for ( int i = spaces[a].min( 0 ); i < spaces[a].max( 0 ); ++i )
+            auto add_element = [&]( const int i, const int j, const int l ) {
+                // Byte starting location in buffer.
+                host_steering( elem_counter, 0 ) = byte_counter;
+
+                // Array location of element.
+                host_steering( elem_counter, 1 ) = a;
+
+                // Structured index in array of element.
+                host_steering( elem_counter, 2 ) = i;
+                host_steering( elem_counter, 3 ) = j;
+                host_steering( elem_counter, 4 ) = l;
+
+                // Update element id.
+                ++elem_counter;
+
+                // Update buffer position.
+                byte_counter += value_byte_sizes[a];
+            };
+
+            const auto& space = spaces[a];
+            if ( dofs_outermost[a] )
             {
-                for ( int j = spaces[a].min( 1 ); j < spaces[a].max( 1 ); ++j )
-                {
-                    for ( int l = spaces[a].min( 2 ); l < spaces[a].max( 2 );
-                          ++l )
-                    {
-                        // Byte starting location in buffer.
-                        host_steering( elem_counter, 0 ) = byte_counter;
-
-                        // Array location of element.
-                        host_steering( elem_counter, 1 ) = a;
-
-                        // Structured index in array of element.
-                        host_steering( elem_counter, 2 ) = i;
-                        host_steering( elem_counter, 3 ) = j;
-                        host_steering( elem_counter, 4 ) = l;
-
-                        // Update element id.
-                        ++elem_counter;
-
-                        // Update buffer position.
-                        byte_counter += value_byte_sizes[a];
-                    }
-                }
+                for ( int l = space.min( 2 ); l < space.max( 2 ); ++l )
+                    for ( int i = space.min( 0 ); i < space.max( 0 ); ++i )
+                        for ( int j = space.min( 1 ); j < space.max( 1 ); ++j )
+                            add_element( i, j, l );
+            }
+            else
+            {
+                for ( int i = space.min( 0 ); i < space.max( 0 ); ++i )
+                    for ( int j = space.min( 1 ); j < space.max( 1 ); ++j )
+                        for ( int l = space.min( 2 ); l < space.max( 2 ); ++l )
+                            add_element( i, j, l );
             }
         }
 
@@ -758,7 +1271,6 @@ class Halo
                                            sizeof...( ArrayViews ) - 1>(),
                     pp );
             } );
-        exec_space.fence();
     }
 
     //! Reduce an element into the buffer. Sum reduction.
@@ -880,14 +1392,200 @@ class Halo
                      array_views );
     }
 
-    //! Unpack arrays from a buffer.
+    //! Get the layout of a block of a buffer. Blocks are stored in the order
+    //! of the steering vector: row-major with the degrees of freedom
+    //! innermost or outermost as in the array.
+    template <long N>
+    static Kokkos::LayoutStride blockLayout( const BufferBlock& block )
+    {
+        // Order the dimensions by increasing stride.
+        int order[N];
+        long extents[N];
+        for ( long d = 0; d < N; ++d )
+        {
+            order[d] = N - 1 - d;
+            extents[d] = block.max[d] - block.min[d];
+        }
+        if ( block.dofs_outermost )
+        {
+            for ( long d = 0; d < N - 1; ++d )
+                order[d] = N - 2 - d;
+            order[N - 1] = N - 1;
+        }
+        return Kokkos::LayoutStride::order_dimensions( N, order, extents );
+    }
+
+    //! Pack an array into a block of a buffer. The block is written with the
+    //! given wire type starting at the given byte offset.
+    template <class WireType, class ExecutionSpace, class ArrayView>
+    static std::enable_if_t<4 == ArrayView::rank, void>
+    packBlock( const ExecutionSpace& exec_space,
+               const Kokkos::View<char*, memory_space>& buffer,
+               const std::size_t offset, const BufferBlock& block,
+               const ArrayView& array_view )
+    {
+        Kokkos::View<WireType****, Kokkos::LayoutStride, memory_space,
+                     Kokkos::MemoryUnmanaged>
+            block_view( reinterpret_cast<WireType*>( buffer.data() + offset ),
+                        blockLayout<4>( block ) );
+        const long i0 = block.min[0];
+        const long j0 = block.min[1];
+        const long k0 = block.min[2];
+        const long l0 = block.min[3];
+        Kokkos::parallel_for(
+            "pack_block",
+            Kokkos::MDRangePolicy<ExecutionSpace, Kokkos::Rank<4>>(
+                exec_space, { block.min[0], block.min[1], block.min[2],
+                              block.min[3] },
+                { block.max[0], block.max[1], block.max[2], block.max[3] } ),
+            KOKKOS_LAMBDA( const long i, const long j, const long k,
+                           const long l ) {
+                block_view( i - i0, j - j0, k - k0, l - l0 ) =
+                    static_cast<WireType>( array_view( i, j, k, l ) );
+            } );
+    }
+
+    //! Pack an array into a block of a buffer. The block is written with the
+    //! given wire type starting at the given byte offset.
+    template <class WireType, class ExecutionSpace, class ArrayView>
+    static std::enable_if_t<3 == ArrayView::rank, void>
+    packBlock( const ExecutionSpace& exec_space,
+               const Kokkos::View<char*, memory_space>& buffer,
+               const std::size_t offset, const BufferBlock& block,
+               const ArrayView& array_view )
+    {
+        Kokkos::View<WireType***, Kokkos::LayoutStride, memory_space,
+                     Kokkos::MemoryUnmanaged>
+            block_view( reinterpret_cast<WireType*>( buffer.data() + offset ),
+                        blockLayout<3>( block ) );
+        const long i0 = block.min[0];
+        const long j0 = block.min[1];
+        const long l0 = block.min[2];
+        Kokkos::parallel_for(
+            "pack_block",
+            Kokkos::MDRangePolicy<ExecutionSpace, Kokkos::Rank<3>>(
+                exec_space, { block.min[0], block.min[1], block.min[2] },
+                { block.max[0], block.max[1], block.max[2] } ),
+            KOKKOS_LAMBDA( const long i, const long j, const long l ) {
+                block_view( i - i0, j - j0, l - l0 ) =
+                    static_cast<WireType>( array_view( i, j, l ) );
+            } );
+    }
+
+    //! Unpack a block of a buffer into an array. The block is read with the
+    //! given wire type starting at the given byte offset.
+    template <class WireType, class ExecutionSpace, class ReduceOp,
+              class ArrayView>
+    static std::enable_if_t<4 == ArrayView::rank, void>
+    unpackBlock( const ReduceOp& reduce_op, const ExecutionSpace& exec_space,
+                 const Kokkos::View<char*, memory_space>& buffer,
+                 const std::size_t offset, const BufferBlock& block,
+                 const ArrayView& array_view )
+    {
+        using value_type = typename ArrayView::value_type;
+        Kokkos::View<const WireType****, Kokkos::LayoutStride, memory_space,
+                     Kokkos::MemoryUnmanaged>
+            block_view(
+                reinterpret_cast<const WireType*>( buffer.data() + offset ),
+                blockLayout<4>( block ) );
+        const long i0 = block.min[0];
+        const long j0 = block.min[1];
+        const long k0 = block.min[2];
+        const long l0 = block.min[3];
+        Kokkos::parallel_for(
+            "unpack_block",
+            Kokkos::MDRangePolicy<ExecutionSpace, Kokkos::Rank<4>>(
+                exec_space, { block.min[0], block.min[1], block.min[2],
+                              block.min[3] },
+                { block.max[0], block.max[1], block.max[2], block.max[3] } ),
+            KOKKOS_LAMBDA( const long i, const long j, const long k,
+                           const long l ) {
+                unpackOp( reduce_op,
+                          static_cast<value_type>(
+                              block_view( i - i0, j - j0, k - k0, l - l0 ) ),
+                          array_view( i, j, k, l ) );
+            } );
+    }
+
+    //! Unpack a block of a buffer into an array. The block is read with the
+    //! given wire type starting at the given byte offset.
+    template <class WireType, class ExecutionSpace, class ReduceOp,
+              class ArrayView>
+    static std::enable_if_t<3 == ArrayView::rank, void>
+    unpackBlock( const ReduceOp& reduce_op, const ExecutionSpace& exec_space,
+                 const Kokkos::View<char*, memory_space>& buffer,
+                 const std::size_t offset, const BufferBlock& block,
+                 const ArrayView& array_view )
+    {
+        using value_type = typename ArrayView::value_type;
+        Kokkos::View<const WireType***, Kokkos::LayoutStride, memory_space,
+                     Kokkos::MemoryUnmanaged>
+            block_view(
+                reinterpret_cast<const WireType*>( buffer.data() + offset ),
+                blockLayout<3>( block ) );
+        const long i0 = block.min[0];
+        const long j0 = block.min[1];
+        const long l0 = block.min[2];
+        Kokkos::parallel_for(
+            "unpack_block",
+            Kokkos::MDRangePolicy<ExecutionSpace, Kokkos::Rank<3>>(
+                exec_space, { block.min[0], block.min[1], block.min[2] },
+                { block.max[0], block.max[1], block.max[2] } ),
+            KOKKOS_LAMBDA( const long i, const long j, const long l ) {
+                unpackOp( reduce_op,
+                          static_cast<value_type>(
+                              block_view( i - i0, j - j0, l - l0 ) ),
+                          array_view( i, j, l ) );
+            } );
+    }
+
+    //! Check if every block of a buffer can be read with the value type of
+    //! its array.
+    template <class... ArrayViews>
+    static bool blocksAligned( const std::vector<BufferBlock>& blocks,
+                               const ArrayViews&... )
+    {
+        std::array<std::size_t, sizeof...( ArrayViews )> alignments = {
+            alignof( typename ArrayViews::value_type )... };
+        std::array<bool, sizeof...( ArrayViews )> arithmetic = {
+            std::is_arithmetic<typename ArrayViews::value_type>::value... };
+        if ( blocks.size() != alignments.size() )
+            return false;
+        for ( std::size_t a = 0; a < blocks.size(); ++a )
+            if ( !arithmetic[a] || 0 != blocks[a].offset % alignments[a] )
+                return false;
+        return true;
+    }
+
+    /*!
+      \brief Unpack arrays from a buffer.
+
+      If the data of each array in the buffer is aligned for its value type
+      the arrays are unpacked block by block with typed loads. Otherwise the
+      buffer is unpacked element by element through the steering vector.
+    */
     template <class ExecutionSpace, class ReduceOp, class... ArrayViews>
     void unpackBuffer( const ReduceOp& reduce_op,
                        const ExecutionSpace& exec_space,
                        const Kokkos::View<char*, memory_space>& buffer,
                        const Kokkos::View<int**, memory_space>& steering,
+                       const std::vector<BufferBlock>& blocks,
                        ArrayViews... array_views ) const
     {
+        if ( 0 == steering.extent( 0 ) )
+            return;
+
+        if ( blocksAligned( blocks, array_views... ) )
+        {
+            std::size_t a = 0;
+            (void)std::initializer_list<int>{ (
+                unpackBlock<typename ArrayViews::value_type>(
+                    reduce_op, exec_space, buffer, blocks[a].offset,
+                    blocks[a], array_views ),
+                ++a, 0 )... };
+            return;
+        }
+
         auto pp = Cabana::makeParameterPack( array_views... );
         Kokkos::parallel_for(
             "unpack_buffer",
@@ -902,6 +1600,96 @@ class Halo
             } );
     }
 
+    //! Get the byte offset of each array in a reduced precision buffer. The
+    //! total size of the buffer is appended. Each array is aligned for its
+    //! reduced type.
+    template <class... ArrayViews>
+    static std::vector<std::size_t>
+    reducedOffsets( const std::vector<BufferBlock>& blocks,
+                    const ArrayViews&... )
+    {
+        const std::size_t num_array = sizeof...( ArrayViews );
+        std::vector<std::size_t> offsets( num_array + 1, 0 );
+        if ( blocks.empty() )
+            return offsets;
+
+        std::array<std::size_t, num_array> sizes = {
+            sizeof( typename Cabana::Impl::ReducedPrecision<
+                    typename ArrayViews::value_type>::type )... };
+        std::array<std::size_t, num_array> alignments = {
+            alignof( typename Cabana::Impl::ReducedPrecision<
+                     typename ArrayViews::value_type>::type )... };
+        std::size_t offset = 0;
+        for ( std::size_t a = 0; a < num_array; ++a )
+        {
+            offset = alignments[a] * ( ( offset + alignments[a] - 1 ) /
+                                       alignments[a] );
+            offsets[a] = offset;
+            offset += blocks[a].size * sizes[a];
+        }
+        offsets[num_array] = offset;
+        return offsets;
+    }
+
+    //! Create the buffers and persistent requests for reduced precision
+    //! gathers if they do not exist yet.
+    template <class... ArrayViews>
+    void createReducedGather( const ArrayViews&... array_views ) const
+    {
+        if ( !_reduced_gather_requests.send.empty() )
+            return;
+
+        int num_n = _neighbor_ranks.size();
+        for ( int n = 0; n < num_n; ++n )
+        {
+            _reduced_owned_buffers.push_back(
+                Kokkos::View<char*, memory_space>(
+                    "reduced_halo_buffer",
+                    reducedOffsets( _owned_blocks[n], array_views... )
+                        .back() ) );
+            _reduced_ghosted_buffers.push_back(
+                Kokkos::View<char*, memory_space>(
+                    "reduced_halo_buffer",
+                    reducedOffsets( _ghosted_blocks[n], array_views... )
+                        .back() ) );
+        }
+        createRequests( 1234, _reduced_ghosted_buffers, _reduced_owned_buffers,
+                        _reduced_gather_requests );
+    }
+
+    //! Pack arrays into a reduced precision buffer.
+    template <class ExecutionSpace, class... ArrayViews>
+    void packReducedBuffer( const ExecutionSpace& exec_space,
+                            const Kokkos::View<char*, memory_space>& buffer,
+                            const std::vector<BufferBlock>& blocks,
+                            ArrayViews... array_views ) const
+    {
+        auto offsets = reducedOffsets( blocks, array_views... );
+        std::size_t a = 0;
+        (void)std::initializer_list<int>{ (
+            packBlock<typename Cabana::Impl::ReducedPrecision<
+                typename ArrayViews::value_type>::type>(
+                exec_space, buffer, offsets[a], blocks[a], array_views ),
+            ++a, 0 )... };
+    }
+
+    //! Unpack arrays from a reduced precision buffer.
+    template <class ExecutionSpace, class... ArrayViews>
+    void unpackReducedBuffer( const ExecutionSpace& exec_space,
+                              const Kokkos::View<char*, memory_space>& buffer,
+                              const std::vector<BufferBlock>& blocks,
+                              ArrayViews... array_views ) const
+    {
+        auto offsets = reducedOffsets( blocks, array_views... );
+        std::size_t a = 0;
+        (void)std::initializer_list<int>{ (
+            unpackBlock<typename Cabana::Impl::ReducedPrecision<
+                typename ArrayViews::value_type>::type>(
+                ScatterReduce::Replace(), exec_space, buffer, offsets[a],
+                blocks[a], array_views ),
+            ++a, 0 )... };
+    }
+
   private:
     // MPI communicator.
     MPI_Comm _comm;
@@ -926,6 +1714,36 @@ class Halo
 
     // For each neighbor, steering vector for the ghosted buffer.
     std::vector<Kokkos::View<int**, memory_space>> _ghosted_steering;
+
+    // For each neighbor, location of each array in the owned buffer.
+    std::vector<std::vector<BufferBlock>> _owned_blocks;
+
+    // For each neighbor, location of each array in the ghosted buffer.
+    std::vector<std::vector<BufferBlock>> _ghosted_blocks;
+
+    // Persistent requests for the gather. These are started by each gather
+    // and are inactive between exchanges.
+    mutable PersistentRequests _gather_requests;
+
+    // Persistent requests for the scatter.
+    mutable PersistentRequests _scatter_requests;
+
+    // Precision of the data sent by gathers.
+    Cabana::CommPrecision _gather_precision;
+
+    // For each neighbor, reduced precision send/receive buffers for data we
+    // own and data we ghost. These are created by the first reduced gather.
+    mutable std::vector<Kokkos::View<char*, memory_space>>
+        _reduced_owned_buffers;
+    mutable std::vector<Kokkos::View<char*, memory_space>>
+        _reduced_ghosted_buffers;
+
+    // Persistent requests for reduced precision gathers.
+    mutable PersistentRequests _reduced_gather_requests;
+
+    // Statistics in which exchanges are recorded. May be null.
+    std::shared_ptr<Cabana::CommStatistics> _stats;
+    std::shared_ptr<Cabana::CommProgress> _progress;
 };
 
 //---------------------------------------------------------------------------//
@@ -1018,6 +1836,58 @@ auto createHalo( const Array<Scalar, EntityType, MeshType, Params...>& array,
         adapter{ *array.layout() };
     return createHalo( pattern, width, adapter );
 }
+//---------------------------------------------------------------------------//
+/*!
+  \brief Execute a functor in parallel over an index space while gathering
+  the halo it depends on.
+
+  The interior of the index space, which does not depend on ghosts within
+  the given width, is launched after the gather is started. The boundary
+  layer is launched after the gather is finished. On execution spaces with
+  asynchronous kernels the interior work overlaps the communication. All
+  work is enqueued on the given execution space instance and is not fenced
+  on return.
+
+  \param label Parallel region label.
+
+  \param exec_space An execution space instance.
+
+  \param index_space The index space over which to loop, e.g. the owned
+  space of an entity type.
+
+  \param width The width of the stencil of the functor, i.e. the number of
+  neighboring indices it reads in each direction.
+
+  \param functor The functor to execute.
+
+  \param halo The halo of the arrays read by the functor.
+
+  \param arrays The arrays to gather. NOTE: These arrays must be given in the
+  same order as in the halo constructor.
+*/
+template <class FunctorType, class ExecutionSpace, long N, class HaloType,
+          class... ArrayTypes>
+void halo_parallel_for( const std::string& label,
+                        const ExecutionSpace& exec_space,
+                        const IndexSpace<N>& index_space, const long width,
+                        const FunctorType& functor, const HaloType& halo,
+                        const ArrayTypes&... arrays )
+{
+    halo.startGather( exec_space, arrays... );
+
+    auto interior = interiorIndexSpace( index_space, width );
+    if ( interior.size() > 0 )
+        grid_parallel_for( label + "_interior", exec_space, interior,
+                           functor );
+
+    halo.finishGather( exec_space, arrays... );
+
+    for ( const auto& boundary : boundaryIndexSpaces( index_space, width ) )
+        if ( boundary.size() > 0 )
+            grid_parallel_for( label + "_boundary", exec_space, boundary,
+                               functor );
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Cajita
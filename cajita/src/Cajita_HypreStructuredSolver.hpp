@@ -20,12 +20,15 @@
 #include <Cajita_GlobalGrid.hpp>
 #include <Cajita_IndexSpace.hpp>
 #include <Cajita_LocalGrid.hpp>
+#include <Cajita_SolverTelemetry.hpp>
 #include <Cajita_Types.hpp>
 
 #include <HYPRE_config.h>
 #include <HYPRE_struct_ls.h>
 #include <HYPRE_struct_mv.h>
 
+#include <impl/Cabana_Profiling.hpp>
+
 #include <Kokkos_Core.hpp>
 
 #include <array>
@@ -104,6 +107,8 @@ class HypreStructuredSolver
     using memory_space = MemorySpace;
     //! Default Kokkos device type.
     using device_type [[deprecated]] = typename memory_space::device_type;
+    //! Kokkos execution space.
+    using execution_space = typename memory_space::execution_space;
     //! Scalar value type.
     using value_type = Scalar;
     //! Hypre memory space compatibility check.
@@ -121,6 +126,8 @@ class HypreStructuredSolver
                            const bool is_preconditioner = false )
         : _comm( layout.localGrid()->globalGrid().comm() )
         , _is_preconditioner( is_preconditioner )
+        , _matrix_initialized( false )
+        , _initial_guess( SolverInitialGuess::Previous )
     {
         static_assert( is_array_layout<ArrayLayout_t>::value,
                        "Must use an array layout" );
@@ -145,8 +152,9 @@ class HypreStructuredSolver
             // this to KJI from IJK to be consistent with HYPRE ordering. By
             // setting up the grid like this, HYPRE will then want layout-right
             // data indexed as (i,j,k) or (i,j,k,l) which will allow us to
-            // directly use Kokkos::deep_copy to move data between Cajita arrays
-            // and HYPRE data structures.
+            // pass layout-right Cajita arrays to HYPRE in place and to
+            // directly use Kokkos::deep_copy to move data between other Cajita
+            // arrays and HYPRE data structures.
             auto global_space = layout.indexSpace( Own(), Global() );
             _lower.resize( num_space_dim );
             _upper.resize( num_space_dim );
@@ -185,9 +193,11 @@ class HypreStructuredSolver
                 reorder_size[d] = global_space.extent( d );
             }
             IndexSpace<num_space_dim> reorder_space( reorder_size );
+            _vector_values = Kokkos::View<HYPRE_Complex*, memory_space>(
+                "vector_values", reorder_space.size() );
             auto vector_values =
                 createView<HYPRE_Complex, Kokkos::LayoutRight, memory_space>(
-                    "vector_values", reorder_space );
+                    reorder_space, _vector_values.data() );
             Kokkos::deep_copy( vector_values, 0.0 );
 
             error = HYPRE_StructVectorCreate( _comm, _grid, &_b );
@@ -266,6 +276,7 @@ class HypreStructuredSolver
         checkHypreError( error );
         error = HYPRE_StructMatrixSetSymmetric( _A, is_symmetric );
         checkHypreError( error );
+        _matrix_initialized = false;
     }
 
     /*!
@@ -301,38 +312,76 @@ class HypreStructuredSolver
             throw std::runtime_error(
                 "Number of matrix values does not match stencil size" );
 
-        // Spatial dimension.
-        const std::size_t num_space_dim = Array_t::num_space_dim;
-
-        // Intialize the matrix for setting values.
-        auto error = HYPRE_StructMatrixInitialize( _A );
-        checkHypreError( error );
-
-        // Copy the matrix entries into HYPRE. The HYPRE layout is fixed as
-        // layout-right.
-        auto owned_space = values.layout()->indexSpace( Own(), Local() );
-        std::array<long, num_space_dim + 1> reorder_size;
-        for ( std::size_t d = 0; d < num_space_dim; ++d )
+        // Intialize the matrix for setting values. The matrix data is only
+        // allocated the first time values are set for a given stencil.
+        if ( !_matrix_initialized )
         {
-            reorder_size[d] = owned_space.extent( d );
+            auto error = HYPRE_StructMatrixInitialize( _A );
+            checkHypreError( error );
+            _matrix_initialized = true;
         }
-        reorder_size.back() = _stencil_size;
-        IndexSpace<num_space_dim + 1> reorder_space( reorder_size );
-        auto a_values =
-            createView<HYPRE_Complex, Kokkos::LayoutRight, memory_space>(
-                "a_values", reorder_space );
-        auto values_subv = createSubview( values.view(), owned_space );
-        Kokkos::deep_copy( a_values, values_subv );
 
         // Insert values into the HYPRE matrix.
         std::vector<HYPRE_Int> indices( _stencil_size );
         std::iota( indices.begin(), indices.end(), 0 );
-        error = HYPRE_StructMatrixSetBoxValues(
-            _A, _lower.data(), _upper.data(), indices.size(), indices.data(),
-            a_values.data() );
-        checkHypreError( error );
-        error = HYPRE_StructMatrixAssemble( _A );
-        checkHypreError( error );
+        setMatrixBoxValues( values, indices );
+    }
+
+    /*!
+      \brief Update the values of some of the stencil entries of the matrix,
+      e.g. the diagonal, keeping the matrix structure and the other values.
+      \param values The new matrix entry values. For each entity over which
+      the vector space is defined an entry for each updated stencil element is
+      required, in the order of the given entries.
+      \param entries The indices of the updated elements in the stencil
+      definition.
+
+      The HYPRE grid, stencil, and matrix are reused and only the given
+      values are copied. After an update setup() may be called to rebuild the
+      solver and preconditioner data for the new values. Skipping setup()
+      keeps the data of the last setup, e.g. the coarse grid operators of
+      PFMG, which remains usable as a preconditioner when the values change
+      slowly between solves.
+    */
+    template <class Array_t>
+    void updateMatrixValues( const Array_t& values,
+                             const std::vector<int>& entries )
+    {
+        static_assert( is_array<Array_t>::value, "Must use an array" );
+        static_assert(
+            std::is_same<typename Array_t::entity_type, entity_type>::value,
+            "Array entity type mush match solver entity type" );
+        static_assert(
+            std::is_same<typename Array_t::memory_space, MemorySpace>::value,
+            "Array device type and solver device type are different." );
+
+        static_assert(
+            std::is_same<typename Array_t::value_type, value_type>::value,
+            "Array value type and solver value type are different." );
+
+        // This function is only valid for non-preconditioners.
+        if ( _is_preconditioner )
+            throw std::logic_error(
+                "Cannot call updateMatrixValues() on preconditioners" );
+
+        if ( !_matrix_initialized )
+            throw std::logic_error(
+                "Matrix values must be set before they are updated" );
+
+        if ( values.layout()->dofsPerEntity() !=
+             static_cast<int>( entries.size() ) )
+            throw std::runtime_error(
+                "Number of matrix values does not match number of entries" );
+
+        std::vector<HYPRE_Int> indices( entries.size() );
+        for ( unsigned n = 0; n < entries.size(); ++n )
+        {
+            if ( entries[n] < 0 ||
+                 entries[n] >= static_cast<int>( _stencil_size ) )
+                throw std::runtime_error( "Stencil entry out of bounds" );
+            indices[n] = entries[n];
+        }
+        setMatrixBoxValues( values, indices );
     }
 
     //! Set convergence tolerance implementation.
@@ -368,13 +417,37 @@ class HypreStructuredSolver
     //! Setup the problem.
     void setup()
     {
+        Cabana::Impl::ScopedProfileRegion region(
+            "Cajita::HypreStructuredSolver::setup" );
+
         // This function is only valid for non-preconditioners.
         if ( _is_preconditioner )
             throw std::logic_error( "Cannot call setup() on preconditioners" );
 
+        _telemetry.beginSetup();
+        SolverStopwatch<execution_space> watch( _telemetry );
         this->setupImpl( _A, _b, _x );
+        watch.lap( SolverPhase::Setup );
     }
 
+    /*!
+      \brief Set the initial guess of the solves.
+      \param initial_guess Previous (default) starts from the solution of the
+      previous solve retained by HYPRE, Given from the solution array passed
+      to the solve, and Zero from zero.
+    */
+    void setInitialGuess( const SolverInitialGuess initial_guess )
+    {
+        _initial_guess = initial_guess;
+    }
+
+    /*!
+      \brief Get the telemetry of the last solve. Enable it to time the
+      phases of the solves. HYPRE does not expose the residual history so
+      only the final residual norm is recorded.
+    */
+    SolverTelemetry& getTelemetry() { return _telemetry; }
+
     /*!
       \brief Solve the problem Ax = b for x.
       \param b The forcing term.
@@ -383,6 +456,9 @@ class HypreStructuredSolver
     template <class Array_t>
     void solve( const Array_t& b, Array_t& x )
     {
+        Cabana::Impl::ScopedProfileRegion region(
+            "Cajita::HypreStructuredSolver::solve" );
+
         static_assert( is_array<Array_t>::value, "Must use an array" );
         static_assert(
             std::is_same<typename Array_t::entity_type, entity_type>::value,
@@ -404,14 +480,62 @@ class HypreStructuredSolver
             throw std::runtime_error(
                 "Structured solver only for scalar fields" );
 
+        _telemetry.beginSolve();
+        SolverStopwatch<execution_space> watch( _telemetry );
+
+        // Start from zero if requested. Otherwise the previous solution is
+        // kept in the HYPRE vector unless the given one is copied below.
+        if ( SolverInitialGuess::Zero == _initial_guess )
+        {
+            auto error = HYPRE_StructVectorSetConstantValues( _x, 0.0 );
+            checkHypreError( error );
+        }
+
+        // Pass the array data to HYPRE in place if its layout matches.
+        std::vector<HYPRE_Int> b_lower;
+        std::vector<HYPRE_Int> b_upper;
+        std::vector<HYPRE_Int> x_lower;
+        std::vector<HYPRE_Int> x_upper;
+        if ( hypreDataBox( b, b_lower, b_upper ) &&
+             hypreDataBox( x, x_lower, x_upper ) )
+        {
+            auto error = HYPRE_StructVectorSetBoxValues2(
+                _b, _lower.data(), _upper.data(), b_lower.data(),
+                b_upper.data(),
+                reinterpret_cast<HYPRE_Complex*>( b.view().data() ) );
+            checkHypreError( error );
+            error = HYPRE_StructVectorAssemble( _b );
+            checkHypreError( error );
+            if ( SolverInitialGuess::Given == _initial_guess )
+            {
+                error = HYPRE_StructVectorSetBoxValues2(
+                    _x, _lower.data(), _upper.data(), x_lower.data(),
+                    x_upper.data(),
+                    reinterpret_cast<HYPRE_Complex*>( x.view().data() ) );
+                checkHypreError( error );
+                error = HYPRE_StructVectorAssemble( _x );
+                checkHypreError( error );
+            }
+            watch.lap( SolverPhase::Transfer );
+
+            this->solveImpl( _A, _b, _x );
+            watch.lap( SolverPhase::Library );
+
+            error = HYPRE_StructVectorGetBoxValues2(
+                _x, _lower.data(), _upper.data(), x_lower.data(),
+                x_upper.data(),
+                reinterpret_cast<HYPRE_Complex*>( x.view().data() ) );
+            checkHypreError( error );
+            watch.lap( SolverPhase::Transfer );
+            recordSolve();
+            return;
+        }
+
         // Spatial dimension.
         const std::size_t num_space_dim = Array_t::num_space_dim;
 
-        // Initialize the RHS.
-        auto error = HYPRE_StructVectorInitialize( _b );
-        checkHypreError( error );
-
-        // Copy the RHS into HYPRE. The HYPRE layout is fixed as layout-right.
+        // Otherwise copy the RHS into HYPRE. The HYPRE layout is fixed as
+        // layout-right. The vector data was initialized on construction.
         auto owned_space = b.layout()->indexSpace( Own(), Local() );
         std::array<long, num_space_dim + 1> reorder_size;
         for ( std::size_t d = 0; d < num_space_dim; ++d )
@@ -422,7 +546,19 @@ class HypreStructuredSolver
         IndexSpace<num_space_dim + 1> reorder_space( reorder_size );
         auto vector_values =
             createView<HYPRE_Complex, Kokkos::LayoutRight, memory_space>(
-                "vector_values", reorder_space );
+                reorder_space, _vector_values.data() );
+        auto x_subv = createSubview( x.view(), owned_space );
+        HYPRE_Int error = 0;
+        if ( SolverInitialGuess::Given == _initial_guess )
+        {
+            // Insert the initial guess into the HYPRE vector.
+            Kokkos::deep_copy( vector_values, x_subv );
+            error = HYPRE_StructVectorSetBoxValues(
+                _x, _lower.data(), _upper.data(), vector_values.data() );
+            checkHypreError( error );
+            error = HYPRE_StructVectorAssemble( _x );
+            checkHypreError( error );
+        }
         auto b_subv = createSubview( b.view(), owned_space );
         Kokkos::deep_copy( vector_values, b_subv );
 
@@ -432,9 +568,11 @@ class HypreStructuredSolver
         checkHypreError( error );
         error = HYPRE_StructVectorAssemble( _b );
         checkHypreError( error );
+        watch.lap( SolverPhase::Transfer );
 
         // Solve the problem
         this->solveImpl( _A, _b, _x );
+        watch.lap( SolverPhase::Library );
 
         // Extract the solution from the LHS
         error = HYPRE_StructVectorGetBoxValues(
@@ -442,8 +580,9 @@ class HypreStructuredSolver
         checkHypreError( error );
 
         // Copy the HYPRE solution to the LHS.
-        auto x_subv = createSubview( x.view(), owned_space );
         Kokkos::deep_copy( x_subv, vector_values );
+        watch.lap( SolverPhase::Transfer );
+        recordSolve();
     }
 
     //! Get the number of iterations taken on the last solve.
@@ -506,6 +645,107 @@ class HypreStructuredSolver
         }
     }
 
+  private:
+    // Record the iteration count and final residual norm of a solve.
+    void recordSolve()
+    {
+        _telemetry.setNumIter( this->getNumIterImpl() );
+        _telemetry.recordResidual( this->getFinalRelativeResidualNormImpl() );
+    }
+
+    // Get the HYPRE data box of the ghosted array data if the array values
+    // can be passed to HYPRE in place. HYPRE reads a box of values with the
+    // stencil entries fastest, followed by its first dimension, which is the
+    // last array dimension. This is the order of contiguous layout-right
+    // array data with the entries or the single vector value in the DoFs.
+    template <class Array_t>
+    bool hypreDataBox( const Array_t& array, std::vector<HYPRE_Int>& lower,
+                       std::vector<HYPRE_Int>& upper ) const
+    {
+        if ( !std::is_same<typename Array_t::value_type,
+                           HYPRE_Complex>::value )
+            return false;
+
+        const std::size_t num_space_dim = Array_t::num_space_dim;
+        auto view = array.view();
+        std::size_t stride = 1;
+        for ( int d = num_space_dim; d >= 0; --d )
+        {
+            if ( view.extent( d ) > 1 && view.stride( d ) != stride )
+                return false;
+            stride *= view.extent( d );
+        }
+
+        // The data box spans the ghosted entities. Note that it is reordered
+        // to KJI like the owned box.
+        auto owned_space = array.layout()->indexSpace( Own(), Local() );
+        lower.resize( num_space_dim );
+        upper.resize( num_space_dim );
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+        {
+            const std::size_t array_dim = num_space_dim - d - 1;
+            lower[d] = _lower[d] -
+                       static_cast<HYPRE_Int>( owned_space.min( array_dim ) );
+            upper[d] =
+                lower[d] + static_cast<HYPRE_Int>( view.extent( array_dim ) ) -
+                1;
+        }
+        return true;
+    }
+
+    // Copy matrix values into the given stencil entries of the HYPRE matrix.
+    template <class Array_t>
+    void setMatrixBoxValues( const Array_t& values,
+                             std::vector<HYPRE_Int>& indices )
+    {
+        // Pass the array data to HYPRE in place if its layout matches.
+        std::vector<HYPRE_Int> data_lower;
+        std::vector<HYPRE_Int> data_upper;
+        if ( hypreDataBox( values, data_lower, data_upper ) )
+        {
+            auto error = HYPRE_StructMatrixSetBoxValues2(
+                _A, _lower.data(), _upper.data(), indices.size(),
+                indices.data(), data_lower.data(), data_upper.data(),
+                reinterpret_cast<HYPRE_Complex*>( values.view().data() ) );
+            checkHypreError( error );
+            error = HYPRE_StructMatrixAssemble( _A );
+            checkHypreError( error );
+            return;
+        }
+
+        // Spatial dimension.
+        const std::size_t num_space_dim = Array_t::num_space_dim;
+
+        // Otherwise copy the matrix entries into HYPRE. The HYPRE layout is
+        // fixed as layout-right. The staging buffer is kept between calls.
+        auto owned_space = values.layout()->indexSpace( Own(), Local() );
+        std::array<long, num_space_dim + 1> reorder_size;
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+        {
+            reorder_size[d] = owned_space.extent( d );
+        }
+        reorder_size.back() = indices.size();
+        IndexSpace<num_space_dim + 1> reorder_space( reorder_size );
+        if ( static_cast<long>( _matrix_values.size() ) <
+             reorder_space.size() )
+            _matrix_values = Kokkos::View<HYPRE_Complex*, memory_space>(
+                Kokkos::ViewAllocateWithoutInitializing( "matrix_values" ),
+                reorder_space.size() );
+        auto a_values =
+            createView<HYPRE_Complex, Kokkos::LayoutRight, memory_space>(
+                reorder_space, _matrix_values.data() );
+        auto values_subv = createSubview( values.view(), owned_space );
+        Kokkos::deep_copy( a_values, values_subv );
+
+        // Insert values into the HYPRE matrix.
+        auto error = HYPRE_StructMatrixSetBoxValues(
+            _A, _lower.data(), _upper.data(), indices.size(), indices.data(),
+            a_values.data() );
+        checkHypreError( error );
+        error = HYPRE_StructMatrixAssemble( _A );
+        checkHypreError( error );
+    }
+
   private:
     MPI_Comm _comm;
     bool _is_preconditioner;
@@ -517,6 +757,11 @@ class HypreStructuredSolver
     HYPRE_StructMatrix _A;
     HYPRE_StructVector _b;
     HYPRE_StructVector _x;
+    bool _matrix_initialized;
+    SolverInitialGuess _initial_guess;
+    SolverTelemetry _telemetry;
+    Kokkos::View<HYPRE_Complex*, memory_space> _matrix_values;
+    Kokkos::View<HYPRE_Complex*, memory_space> _vector_values;
     std::shared_ptr<HypreStructuredSolver<Scalar, EntityType, MemorySpace>>
         _preconditioner;
 };
@@ -215,6 +215,42 @@ createExecutionPolicy( const IndexSpace_t& index_space, const ExecutionSpace&,
         index_space.min(), index_space.max() );
 }
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create a multi-dimensional execution policy over an index space with
+  the given tile sizes.
+
+  \param index_space The index space over which to loop.
+
+  \param tile The number of indices in each dimension of a tile. Each tile is
+  executed by a single thread on host backends and by a thread block on
+  device backends.
+*/
+template <class ExecutionSpace, long N>
+Kokkos::MDRangePolicy<ExecutionSpace, Kokkos::Rank<N>>
+createExecutionPolicy( const IndexSpace<N>& index_space, const ExecutionSpace&,
+                       const Kokkos::Array<long, N>& tile )
+{
+    static_assert( N > 1, "Tiled execution policies require rank > 1" );
+    return Kokkos::MDRangePolicy<ExecutionSpace, Kokkos::Rank<N>>(
+        index_space.min(), index_space.max(), tile );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create a multi-dimensional execution policy over an index space with
+  a work tag and the given tile sizes.
+*/
+template <class ExecutionSpace, class WorkTag, long N>
+Kokkos::MDRangePolicy<ExecutionSpace, WorkTag, Kokkos::Rank<N>>
+createExecutionPolicy( const IndexSpace<N>& index_space, const ExecutionSpace&,
+                       const WorkTag&, const Kokkos::Array<long, N>& tile )
+{
+    static_assert( N > 1, "Tiled execution policies require rank > 1" );
+    return Kokkos::MDRangePolicy<ExecutionSpace, WorkTag, Kokkos::Rank<N>>(
+        index_space.min(), index_space.max(), tile );
+}
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Given an index space create a view over the extent of that index
@@ -457,6 +493,65 @@ IndexSpace<N + 1> appendDimension( const IndexSpace<N>& index_space,
     return IndexSpace<N + 1>( range_min, range_max );
 }
 
+//---------------------------------------------------------------------------//
+/*!
+  Given an N-dimensional index space get its interior excluding a layer of
+  the given width at each of its boundaries. The interior is empty if the
+  index space is no wider than two layers in a dimension.
+*/
+template <long N>
+IndexSpace<N> interiorIndexSpace( const IndexSpace<N>& index_space,
+                                  const long width )
+{
+    std::array<long, N> min;
+    std::array<long, N> max;
+    for ( int d = 0; d < N; ++d )
+    {
+        min[d] = std::min( index_space.min( d ) + width, index_space.max( d ) );
+        max[d] = std::max( index_space.max( d ) - width, min[d] );
+    }
+
+    return IndexSpace<N>( min, max );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  Given an N-dimensional index space get the layer of the given width at its
+  boundaries as 2N disjoint index spaces which, together with the interior
+  index space, cover the index space once. The spaces are ordered by
+  dimension, low side first. The spaces of a dimension span the interior in
+  the lower dimensions and the full index space in the higher dimensions.
+*/
+template <long N>
+std::array<IndexSpace<N>, 2 * N>
+boundaryIndexSpaces( const IndexSpace<N>& index_space, const long width )
+{
+    auto interior = interiorIndexSpace( index_space, width );
+
+    std::array<IndexSpace<N>, 2 * N> boundary;
+    for ( int d = 0; d < N; ++d )
+    {
+        std::array<long, N> min;
+        std::array<long, N> max;
+        for ( int e = 0; e < N; ++e )
+        {
+            min[e] = ( e < d ) ? interior.min( e ) : index_space.min( e );
+            max[e] = ( e < d ) ? interior.max( e ) : index_space.max( e );
+        }
+
+        // Low side.
+        max[d] = interior.min( d );
+        boundary[2 * d] = IndexSpace<N>( min, max );
+
+        // High side.
+        min[d] = interior.max( d );
+        max[d] = index_space.max( d );
+        boundary[2 * d + 1] = IndexSpace<N>( min, max );
+    }
+
+    return boundary;
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Cajita
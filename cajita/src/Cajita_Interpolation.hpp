@@ -16,6 +16,10 @@
 #ifndef CAJITA_INTERPOLATION_HPP
 #define CAJITA_INTERPOLATION_HPP
 
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_Sort.hpp>
+#include <impl/Cabana_Profiling.hpp>
+
 #include <Cajita_Array.hpp>
 #include <Cajita_Halo.hpp>
 #include <Cajita_LocalMesh.hpp>
@@ -25,7 +29,10 @@
 #include <Kokkos_Core.hpp>
 #include <Kokkos_ScatterView.hpp>
 
+#include <initializer_list>
 #include <memory>
+#include <stdexcept>
+#include <tuple>
 #include <type_traits>
 
 namespace Cajita
@@ -60,12 +67,10 @@ KOKKOS_INLINE_FUNCTION
 
     result = 0.0;
 
-    for ( int i = 0; i < SplineDataType::num_knot; ++i )
-        for ( int j = 0; j < SplineDataType::num_knot; ++j )
-            for ( int k = 0; k < SplineDataType::num_knot; ++k )
-                result += view( sd.s[Dim::I][i], sd.s[Dim::J][j],
-                                sd.s[Dim::K][k], 0 ) *
-                          sd.w[Dim::I][i] * sd.w[Dim::J][j] * sd.w[Dim::K][k];
+    forEachStencilNode( sd, [&]( const int i, const int j, const int k ) {
+        result += view( sd.s[Dim::I][i], sd.s[Dim::J][j], sd.s[Dim::K][k], 0 ) *
+                  sd.w[Dim::I][i] * sd.w[Dim::J][j] * sd.w[Dim::K][k];
+    } );
 }
 
 /*!
@@ -88,10 +93,10 @@ KOKKOS_INLINE_FUNCTION
 
     result = 0.0;
 
-    for ( int i = 0; i < SplineDataType::num_knot; ++i )
-        for ( int j = 0; j < SplineDataType::num_knot; ++j )
-            result += view( sd.s[Dim::I][i], sd.s[Dim::J][j], 0 ) *
-                      sd.w[Dim::I][i] * sd.w[Dim::J][j];
+    forEachStencilNode( sd, [&]( const int i, const int j ) {
+        result += view( sd.s[Dim::I][i], sd.s[Dim::J][j], 0 ) *
+                  sd.w[Dim::I][i] * sd.w[Dim::J][j];
+    } );
 }
 
 //---------------------------------------------------------------------------//
@@ -116,14 +121,12 @@ KOKKOS_INLINE_FUNCTION
     for ( int d = 0; d < 3; ++d )
         result[d] = 0.0;
 
-    for ( int i = 0; i < SplineDataType::num_knot; ++i )
-        for ( int j = 0; j < SplineDataType::num_knot; ++j )
-            for ( int k = 0; k < SplineDataType::num_knot; ++k )
-                for ( int d = 0; d < 3; ++d )
-                    result[d] += view( sd.s[Dim::I][i], sd.s[Dim::J][j],
-                                       sd.s[Dim::K][k], d ) *
-                                 sd.w[Dim::I][i] * sd.w[Dim::J][j] *
-                                 sd.w[Dim::K][k];
+    forEachStencilNode( sd, [&]( const int i, const int j, const int k ) {
+        for ( int d = 0; d < 3; ++d )
+            result[d] +=
+                view( sd.s[Dim::I][i], sd.s[Dim::J][j], sd.s[Dim::K][k], d ) *
+                sd.w[Dim::I][i] * sd.w[Dim::J][j] * sd.w[Dim::K][k];
+    } );
 }
 
 /*!
@@ -147,11 +150,11 @@ KOKKOS_INLINE_FUNCTION
     for ( int d = 0; d < 2; ++d )
         result[d] = 0.0;
 
-    for ( int i = 0; i < SplineDataType::num_knot; ++i )
-        for ( int j = 0; j < SplineDataType::num_knot; ++j )
-            for ( int d = 0; d < 2; ++d )
-                result[d] += view( sd.s[Dim::I][i], sd.s[Dim::J][j], d ) *
-                             sd.w[Dim::I][i] * sd.w[Dim::J][j];
+    forEachStencilNode( sd, [&]( const int i, const int j ) {
+        for ( int d = 0; d < 2; ++d )
+            result[d] += view( sd.s[Dim::I][i], sd.s[Dim::J][j], d ) *
+                         sd.w[Dim::I][i] * sd.w[Dim::J][j];
+    } );
 }
 
 //---------------------------------------------------------------------------//
@@ -437,6 +440,278 @@ struct is_scatter_view
 {
 };
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create a scatter view of an array view.
+
+  Kokkos only duplicates views with LayoutLeft or LayoutRight. Views with a
+  strided layout, such as the views of arrays storing degrees of freedom
+  outermost, are therefore added to atomically.
+*/
+template <class ViewType>
+auto createScatterView( const ViewType& view )
+{
+#if ( KOKKOS_VERSION < 30200 )
+    return Kokkos::Experimental::create_scatter_view( view );
+#else
+    using execution_space = typename ViewType::execution_space;
+    using duplication = std::conditional_t<
+        std::is_same<typename ViewType::array_layout,
+                     Kokkos::LayoutStride>::value,
+        Kokkos::Experimental::ScatterNonDuplicated,
+        typename Kokkos::Impl::Experimental::DefaultDuplication<
+            execution_space>::type>;
+    return Kokkos::Experimental::ScatterView<
+        typename ViewType::data_type, typename ViewType::array_layout,
+        typename ViewType::device_type, Kokkos::Experimental::ScatterSum,
+        duplication>( view );
+#endif
+}
+
+//---------------------------------------------------------------------------//
+//! \cond Impl
+// Reference to a grid value which is added to atomically.
+template <class Scalar>
+struct AtomicAddReference
+{
+    Scalar* ptr;
+
+    KOKKOS_INLINE_FUNCTION
+    void operator+=( const Scalar value ) const
+    {
+        Kokkos::atomic_add( ptr, value );
+    }
+};
+
+// Scatter into a team scratch tile of grid values. Contributions to entities
+// within the tile are added in scratch and contributions outside of it
+// directly to the grid. The tile is flattened in row-major order with the
+// component index fastest.
+template <class TileViewType, class GridViewType, std::size_t NumSpaceDim>
+struct ScatterTile
+{
+    using value_type = typename GridViewType::value_type;
+
+    TileViewType tile;
+    GridViewType grid;
+    int origin[3];
+    int extent;
+    int num_comp;
+
+    KOKKOS_INLINE_FUNCTION
+    ScatterTile access() const { return *this; }
+
+    KOKKOS_INLINE_FUNCTION
+    bool inTile( const int d, const int i ) const
+    {
+        return ( i >= origin[d] ) && ( i < origin[d] + extent );
+    }
+
+    // 3D access.
+    KOKKOS_INLINE_FUNCTION
+    AtomicAddReference<value_type> operator()( const int i, const int j,
+                                               const int k,
+                                               const int c ) const
+    {
+        if ( inTile( Dim::I, i ) && inTile( Dim::J, j ) && inTile( Dim::K, k ) )
+            return { &tile( ( ( ( i - origin[Dim::I] ) * extent +
+                                 ( j - origin[Dim::J] ) ) *
+                                   extent +
+                               ( k - origin[Dim::K] ) ) *
+                                 num_comp +
+                             c ) };
+        return { &grid( i, j, k, c ) };
+    }
+
+    // 2D access.
+    KOKKOS_INLINE_FUNCTION
+    AtomicAddReference<value_type> operator()( const int i, const int j,
+                                               const int c ) const
+    {
+        if ( inTile( Dim::I, i ) && inTile( Dim::J, j ) )
+            return { &tile(
+                ( ( i - origin[Dim::I] ) * extent + ( j - origin[Dim::J] ) ) *
+                    num_comp +
+                c ) };
+        return { &grid( i, j, c ) };
+    }
+
+    // Number of values in the tile.
+    KOKKOS_INLINE_FUNCTION
+    int size() const
+    {
+        int n = num_comp;
+        for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+            n *= extent;
+        return n;
+    }
+
+    // Add a non-zero tile value to the grid. 3D specialization.
+    KOKKOS_INLINE_FUNCTION
+    void flush( const int n, std::integral_constant<std::size_t, 3> ) const
+    {
+        if ( tile( n ) == value_type( 0 ) )
+            return;
+        int c = n % num_comp;
+        int r = n / num_comp;
+        int k = r % extent;
+        r /= extent;
+        int j = r % extent;
+        int i = r / extent;
+        Kokkos::atomic_add( &grid( i + origin[Dim::I], j + origin[Dim::J],
+                                   k + origin[Dim::K], c ),
+                            tile( n ) );
+    }
+
+    // Add a non-zero tile value to the grid. 2D specialization.
+    KOKKOS_INLINE_FUNCTION
+    void flush( const int n, std::integral_constant<std::size_t, 2> ) const
+    {
+        if ( tile( n ) == value_type( 0 ) )
+            return;
+        int c = n % num_comp;
+        int r = n / num_comp;
+        int j = r % extent;
+        int i = r / extent;
+        Kokkos::atomic_add( &grid( i + origin[Dim::I], j + origin[Dim::J], c ),
+                            tile( n ) );
+    }
+
+    // Add a non-zero tile value to the grid.
+    KOKKOS_INLINE_FUNCTION
+    void flush( const int n ) const
+    {
+        flush( n, std::integral_constant<std::size_t, NumSpaceDim>() );
+    }
+};
+
+// Scatter tiles are used in place of scatter views.
+template <class TileViewType, class GridViewType, std::size_t NumSpaceDim>
+struct is_scatter_view_impl<
+    ScatterTile<TileViewType, GridViewType, NumSpaceDim>>
+    : public std::true_type
+{
+};
+
+// Reference to the slot recording a contribution. Contributions beyond the
+// capacity of a point are dropped.
+template <class Scalar>
+struct RecordedContribution
+{
+    Scalar* value;
+
+    KOKKOS_INLINE_FUNCTION
+    void operator+=( const Scalar v ) const
+    {
+        if ( value )
+            *value = v;
+    }
+};
+
+// Record the contributions of a point to grid values rather than adding
+// them, such that they can be summed in a fixed order. Each point has slots
+// for capacity contributions. A slot records the grid value index, flattened
+// in row-major order, and the contribution.
+template <class IndexViewType, class ValueViewType, class FlagViewType,
+          std::size_t NumSpaceDim>
+struct ContributionRecorder
+{
+    using value_type = typename ValueViewType::value_type;
+
+    IndexViewType index;
+    ValueViewType value;
+    FlagViewType overflow;
+    long extent[4];
+    int capacity;
+    int p;
+    int* count;
+
+    KOKKOS_INLINE_FUNCTION
+    ContributionRecorder access() const { return *this; }
+
+    // Record a contribution to the grid value with the given flat index.
+    KOKKOS_INLINE_FUNCTION
+    RecordedContribution<value_type> record( const long flat ) const
+    {
+        int n = ( *count )++;
+        if ( n >= capacity )
+        {
+            overflow() = 1;
+            return { nullptr };
+        }
+        long slot = static_cast<long>( p ) * capacity + n;
+        index( slot ) = flat;
+        return { &value( slot ) };
+    }
+
+    // 3D access.
+    KOKKOS_INLINE_FUNCTION
+    RecordedContribution<value_type> operator()( const int i, const int j,
+                                                 const int k,
+                                                 const int c ) const
+    {
+        return record( ( ( i * extent[1] + j ) * extent[2] + k ) * extent[3] +
+                       c );
+    }
+
+    // 2D access.
+    KOKKOS_INLINE_FUNCTION
+    RecordedContribution<value_type> operator()( const int i, const int j,
+                                                 const int c ) const
+    {
+        return record( ( i * extent[1] + j ) * extent[2] + c );
+    }
+
+    // Add a sum to the grid value with the given flat index. 3D
+    // specialization.
+    template <class GridViewType>
+    KOKKOS_INLINE_FUNCTION void
+    add( const GridViewType& grid, const long flat, const value_type sum,
+         std::integral_constant<std::size_t, 3> ) const
+    {
+        long r = flat / extent[3];
+        int c = flat % extent[3];
+        int k = r % extent[2];
+        r /= extent[2];
+        int j = r % extent[1];
+        int i = r / extent[1];
+        grid( i, j, k, c ) += sum;
+    }
+
+    // Add a sum to the grid value with the given flat index. 2D
+    // specialization.
+    template <class GridViewType>
+    KOKKOS_INLINE_FUNCTION void
+    add( const GridViewType& grid, const long flat, const value_type sum,
+         std::integral_constant<std::size_t, 2> ) const
+    {
+        long r = flat / extent[2];
+        int c = flat % extent[2];
+        int j = r % extent[1];
+        int i = r / extent[1];
+        grid( i, j, c ) += sum;
+    }
+
+    // Add a sum to the grid value with the given flat index.
+    template <class GridViewType>
+    KOKKOS_INLINE_FUNCTION void add( const GridViewType& grid, const long flat,
+                                     const value_type sum ) const
+    {
+        add( grid, flat, sum,
+             std::integral_constant<std::size_t, NumSpaceDim>() );
+    }
+};
+
+// Contribution recorders are used in place of scatter views.
+template <class IndexViewType, class ValueViewType, class FlagViewType,
+          std::size_t NumSpaceDim>
+struct is_scatter_view_impl<ContributionRecorder<IndexViewType, ValueViewType,
+                                                 FlagViewType, NumSpaceDim>>
+    : public std::true_type
+{
+};
+//! \endcond
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Interpolate a scalar value to the grid. 3D specialization.
@@ -459,12 +734,10 @@ KOKKOS_INLINE_FUNCTION
                    "P2G requires a Kokkos::ScatterView" );
     auto view_access = view.access();
 
-    for ( int i = 0; i < SplineDataType::num_knot; ++i )
-        for ( int j = 0; j < SplineDataType::num_knot; ++j )
-            for ( int k = 0; k < SplineDataType::num_knot; ++k )
-                view_access( sd.s[Dim::I][i], sd.s[Dim::J][j], sd.s[Dim::K][k],
-                             0 ) += point_data * sd.w[Dim::I][i] *
-                                    sd.w[Dim::J][j] * sd.w[Dim::K][k];
+    forEachStencilNode( sd, [&]( const int i, const int j, const int k ) {
+        view_access( sd.s[Dim::I][i], sd.s[Dim::J][j], sd.s[Dim::K][k], 0 ) +=
+            point_data * sd.w[Dim::I][i] * sd.w[Dim::J][j] * sd.w[Dim::K][k];
+    } );
 }
 
 /*!
@@ -488,10 +761,10 @@ KOKKOS_INLINE_FUNCTION
                    "P2G requires a Kokkos::ScatterView" );
     auto view_access = view.access();
 
-    for ( int i = 0; i < SplineDataType::num_knot; ++i )
-        for ( int j = 0; j < SplineDataType::num_knot; ++j )
-            view_access( sd.s[Dim::I][i], sd.s[Dim::J][j], 0 ) +=
-                point_data * sd.w[Dim::I][i] * sd.w[Dim::J][j];
+    forEachStencilNode( sd, [&]( const int i, const int j ) {
+        view_access( sd.s[Dim::I][i], sd.s[Dim::J][j], 0 ) +=
+            point_data * sd.w[Dim::I][i] * sd.w[Dim::J][j];
+    } );
 }
 
 //---------------------------------------------------------------------------//
@@ -517,14 +790,12 @@ KOKKOS_INLINE_FUNCTION
                    "P2G requires a Kokkos::ScatterView" );
     auto view_access = view.access();
 
-    for ( int i = 0; i < SplineDataType::num_knot; ++i )
-        for ( int j = 0; j < SplineDataType::num_knot; ++j )
-            for ( int k = 0; k < SplineDataType::num_knot; ++k )
-                for ( int d = 0; d < 3; ++d )
-                    view_access( sd.s[Dim::I][i], sd.s[Dim::J][j],
-                                 sd.s[Dim::K][k], d ) +=
-                        point_data[d] * sd.w[Dim::I][i] * sd.w[Dim::J][j] *
-                        sd.w[Dim::K][k];
+    forEachStencilNode( sd, [&]( const int i, const int j, const int k ) {
+        for ( int d = 0; d < 3; ++d )
+            view_access( sd.s[Dim::I][i], sd.s[Dim::J][j], sd.s[Dim::K][k],
+                         d ) += point_data[d] * sd.w[Dim::I][i] *
+                                sd.w[Dim::J][j] * sd.w[Dim::K][k];
+    } );
 }
 
 /*!
@@ -549,11 +820,11 @@ KOKKOS_INLINE_FUNCTION
                    "P2G requires a Kokkos::ScatterView" );
     auto view_access = view.access();
 
-    for ( int i = 0; i < SplineDataType::num_knot; ++i )
-        for ( int j = 0; j < SplineDataType::num_knot; ++j )
-            for ( int d = 0; d < 2; ++d )
-                view_access( sd.s[Dim::I][i], sd.s[Dim::J][j], d ) +=
-                    point_data[d] * sd.w[Dim::I][i] * sd.w[Dim::J][j];
+    forEachStencilNode( sd, [&]( const int i, const int j ) {
+        for ( int d = 0; d < 2; ++d )
+            view_access( sd.s[Dim::I][i], sd.s[Dim::J][j], d ) +=
+                point_data[d] * sd.w[Dim::I][i] * sd.w[Dim::J][j];
+    } );
 }
 
 //---------------------------------------------------------------------------//
@@ -823,6 +1094,8 @@ KOKKOS_INLINE_FUNCTION
 
   \tparam NumSpaceDim The spatial dimension of the mesh.
 
+  \tparam MeshType The uniform or non-uniform mesh tag.
+
   \tparam EntityType The entitytype to which the points will interpolate.
 
   \tparam SplineOrder The order of spline interpolation to use.
@@ -851,16 +1124,19 @@ KOKKOS_INLINE_FUNCTION
 */
 template <class PointEvalFunctor, class PointCoordinates, class ArrayScalar,
           class MeshScalar, class EntityType, int SplineOrder,
-          std::size_t NumSpaceDim, class DeviceType, class... ArrayParams>
+          std::size_t NumSpaceDim, template <class, std::size_t> class MeshType,
+          class DeviceType, class... ArrayParams>
 void g2p(
-    const Array<ArrayScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
+    const Array<ArrayScalar, EntityType, MeshType<MeshScalar, NumSpaceDim>,
                 ArrayParams...>& array,
     const Halo<DeviceType>& halo, const PointCoordinates& points,
     const std::size_t num_point, Spline<SplineOrder>,
     const PointEvalFunctor& functor )
 {
+    Cabana::Impl::ScopedProfileRegion region( "Cajita::g2p" );
+
     using array_type =
-        Array<ArrayScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
+        Array<ArrayScalar, EntityType, MeshType<MeshScalar, NumSpaceDim>,
               ArrayParams...>;
     static_assert( std::is_same<typename Halo<DeviceType>::memory_space,
                                 typename array_type::memory_space>::value,
@@ -1152,6 +1428,158 @@ createVectorDivergenceG2P( const ViewType& x,
 
 //---------------------------------------------------------------------------//
 // Global point-to-grid
+//---------------------------------------------------------------------------//
+//! \cond Impl
+// Interpolate points to the local grid, summing the contributions to each
+// grid value in order of point index. The contributions are recorded, binned
+// by grid value, and each bin is sorted and summed by one thread.
+template <class PointEvalFunctor, class PointCoordinates, class LocalMeshType,
+          class ArrayScalar, class MeshScalar, std::size_t NumSpaceDim,
+          template <class, std::size_t> class MeshType, class EntityType,
+          int SplineOrder, class... ArrayParams>
+void deterministicP2G(
+    const PointEvalFunctor& functor, const PointCoordinates& points,
+    const std::size_t num_point, Spline<SplineOrder>,
+    const LocalMeshType& local_mesh,
+    Array<ArrayScalar, EntityType, MeshType<MeshScalar, NumSpaceDim>,
+          ArrayParams...>& array )
+{
+    using array_type =
+        Array<ArrayScalar, EntityType, MeshType<MeshScalar, NumSpaceDim>,
+              ArrayParams...>;
+    using device_type = typename array_type::device_type;
+    using execution_space = typename device_type::execution_space;
+    using sd_type =
+        SplineData<MeshScalar, SplineOrder, NumSpaceDim, EntityType>;
+
+    // Each point contributes at most once to every component of every
+    // entity of its stencil.
+    auto array_view = array.view();
+    int capacity = array_view.extent( NumSpaceDim );
+    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+        capacity *= sd_type::num_knot;
+    long num_slot = static_cast<long>( num_point ) * capacity;
+    long num_value = array_view.size();
+
+    // Record the contributions of each point.
+    Kokkos::View<long*, device_type> slot_index(
+        Kokkos::ViewAllocateWithoutInitializing( "p2g_slot_index" ),
+        num_slot );
+    Kokkos::deep_copy( slot_index, -1 );
+    Kokkos::View<ArrayScalar*, device_type> slot_value(
+        Kokkos::ViewAllocateWithoutInitializing( "p2g_slot_value" ),
+        num_slot );
+    Kokkos::View<int, device_type> overflow( "p2g_overflow" );
+    using recorder_type =
+        P2G::ContributionRecorder<decltype( slot_index ),
+                                  decltype( slot_value ),
+                                  decltype( overflow ), NumSpaceDim>;
+    recorder_type recorder{ slot_index, slot_value, overflow, {},
+                            capacity,   0,          nullptr };
+    for ( std::size_t d = 0; d < NumSpaceDim + 1; ++d )
+        recorder.extent[d] = array_view.extent( d );
+    Kokkos::parallel_for(
+        "p2g_record", Kokkos::RangePolicy<execution_space>( 0, num_point ),
+        KOKKOS_LAMBDA( const int p ) {
+            // Get the point coordinates.
+            MeshScalar px[NumSpaceDim];
+            for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+            {
+                px[d] = points( p, d );
+            }
+
+            // Create the local spline data.
+            sd_type sd;
+            evaluateSpline( local_mesh, px, sd );
+
+            // Record the contributions of the functor.
+            int count = 0;
+            auto point_recorder = recorder;
+            point_recorder.p = p;
+            point_recorder.count = &count;
+            functor( sd, p, point_recorder );
+        } );
+    auto overflow_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), overflow );
+    if ( overflow_host() )
+        throw std::runtime_error( "P2G functor contributed more than once to "
+                                  "a grid value of a point" );
+
+    // Bin the contributions by grid value.
+    Kokkos::View<int*, device_type> value_count( "p2g_value_count",
+                                                 num_value );
+    Kokkos::parallel_for(
+        "p2g_count", Kokkos::RangePolicy<execution_space>( 0, num_slot ),
+        KOKKOS_LAMBDA( const long s ) {
+            if ( slot_index( s ) >= 0 )
+                Kokkos::atomic_increment( &value_count( slot_index( s ) ) );
+        } );
+    Kokkos::View<long*, device_type> value_offset(
+        Kokkos::ViewAllocateWithoutInitializing( "p2g_value_offset" ),
+        num_value );
+    Kokkos::parallel_scan(
+        "p2g_offset", Kokkos::RangePolicy<execution_space>( 0, num_value ),
+        KOKKOS_LAMBDA( const long v, long& update, const bool final_pass ) {
+            if ( final_pass )
+                value_offset( v ) = update;
+            update += value_count( v );
+        } );
+    Kokkos::View<int*, device_type> value_fill( "p2g_value_fill", num_value );
+    Kokkos::View<long*, device_type> bin_slot(
+        Kokkos::ViewAllocateWithoutInitializing( "p2g_bin_slot" ), num_slot );
+    Kokkos::parallel_for(
+        "p2g_bin", Kokkos::RangePolicy<execution_space>( 0, num_slot ),
+        KOKKOS_LAMBDA( const long s ) {
+            long v = slot_index( s );
+            if ( v >= 0 )
+                bin_slot( value_offset( v ) +
+                          Kokkos::atomic_fetch_add( &value_fill( v ), 1 ) ) =
+                    s;
+        } );
+
+    // Sort the contributions to each grid value by slot, and therefore by
+    // point, and sum them in that order.
+    Kokkos::parallel_for(
+        "p2g_sum", Kokkos::RangePolicy<execution_space>( 0, num_value ),
+        KOKKOS_LAMBDA( const long v ) {
+            long begin = value_offset( v );
+            long end = begin + value_count( v );
+            if ( begin == end )
+                return;
+            for ( long n = begin + 1; n < end; ++n )
+            {
+                long s = bin_slot( n );
+                long m = n;
+                for ( ; m > begin && bin_slot( m - 1 ) > s; --m )
+                    bin_slot( m ) = bin_slot( m - 1 );
+                bin_slot( m ) = s;
+            }
+            ArrayScalar sum = 0;
+            for ( long n = begin; n < end; ++n )
+                sum += slot_value( bin_slot( n ) );
+            recorder.add( array_view, v, sum );
+        } );
+    Kokkos::fence();
+}
+//! \endcond
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Strategy used to sum point contributions to grid values in
+  point-to-grid interpolation.
+*/
+enum class P2GReduction
+{
+    //! Sum with a Kokkos::ScatterView. Atomic or duplicated updates make the
+    //! order of the sums, and the rounding of the result, vary between runs.
+    ScatterView,
+    //! Sum the contributions to each grid value in order of point index and
+    //! then the contributions from neighbors in order of neighbor, such that
+    //! every run gives the same result. Uses memory for every contribution
+    //! and is intended for validation.
+    Deterministic
+};
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Global Point-to-Grid interpolation.
@@ -1168,6 +1596,8 @@ createVectorDivergenceG2P( const ViewType& x,
 
   \tparam NumSpaceDim The spatial dimension of the mesh.
 
+  \tparam MeshType The uniform or non-uniform mesh tag.
+
   \tparam EntityType The entitytype to which the points will interpolate.
 
   \tparam SplineOrder The order of spline interpolation to use.
@@ -1192,19 +1622,25 @@ createVectorDivergenceG2P( const ViewType& x,
 
   \param array The grid array to which the point data will be interpolated.
 
+  \param reduction The strategy used to sum the contributions of the points.
+
   \note Spline of SplineOrder passed for interpolation.
 */
 template <class PointEvalFunctor, class PointCoordinates, class ArrayScalar,
           class MeshScalar, std::size_t NumSpaceDim, class EntityType,
-          int SplineOrder, class DeviceType, class... ArrayParams>
+          int SplineOrder, template <class, std::size_t> class MeshType,
+          class DeviceType, class... ArrayParams>
 void p2g( const PointEvalFunctor& functor, const PointCoordinates& points,
           const std::size_t num_point, Spline<SplineOrder>,
           const Halo<DeviceType>& halo,
-          Array<ArrayScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
-                ArrayParams...>& array )
+          Array<ArrayScalar, EntityType, MeshType<MeshScalar, NumSpaceDim>,
+                ArrayParams...>& array,
+          const P2GReduction reduction = P2GReduction::ScatterView )
 {
+    Cabana::Impl::ScopedProfileRegion region( "Cajita::p2g" );
+
     using array_type =
-        Array<ArrayScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
+        Array<ArrayScalar, EntityType, MeshType<MeshScalar, NumSpaceDim>,
               ArrayParams...>;
     static_assert( std::is_same<typename Halo<DeviceType>::memory_space,
                                 typename array_type::memory_space>::value,
@@ -1216,9 +1652,18 @@ void p2g( const PointEvalFunctor& functor, const PointCoordinates& points,
     auto local_mesh =
         createLocalMesh<DeviceType>( *( array.layout()->localGrid() ) );
 
+    // Sum the contributions in a fixed order.
+    if ( P2GReduction::Deterministic == reduction )
+    {
+        deterministicP2G( functor, points, num_point, Spline<SplineOrder>(),
+                          local_mesh, array );
+        halo.orderedScatter( execution_space(), ScatterReduce::Sum(), array );
+        return;
+    }
+
     // Create a scatter view of the array.
     auto array_view = array.view();
-    auto array_sv = Kokkos::Experimental::create_scatter_view( array_view );
+    auto array_sv = P2G::createScatterView( array_view );
 
     // Loop over points and interpolate to the grid.
     Kokkos::parallel_for(
@@ -1247,6 +1692,896 @@ void p2g( const PointEvalFunctor& functor, const PointCoordinates& points,
     halo.scatter( execution_space(), ScatterReduce::Sum(), array );
 }
 
+//---------------------------------------------------------------------------//
+//! \cond Impl
+namespace Impl
+{
+// Evaluate the spline data of a point from its coordinates.
+template <class LocalMeshType, class PointCoordinates>
+struct SplinePointEvaluator
+{
+    LocalMeshType local_mesh;
+    PointCoordinates points;
+
+    template <class SplineDataType>
+    KOKKOS_INLINE_FUNCTION void operator()( const int p,
+                                            SplineDataType& sd ) const
+    {
+        typename SplineDataType::scalar_type
+            px[SplineDataType::num_space_dim];
+        for ( std::size_t d = 0; d < SplineDataType::num_space_dim; ++d )
+            px[d] = points( p, d );
+        evaluateSpline( local_mesh, px, sd );
+    }
+};
+
+// Interpolate binned points to a grid view with one thread team per bin
+// accumulating into a scratch tile of the grid entities around the bin. The
+// evaluator provides the spline data of a point.
+template <class SplineDataType, class ExecutionSpace, class PointEvalFunctor,
+          class SplineEvaluator, class BinningDataType, class GridViewType>
+void binnedP2G( ExecutionSpace, const PointEvalFunctor& functor,
+                const SplineEvaluator& evaluator, const BinningDataType& bins,
+                const GridViewType& array_view, const bool sorted,
+                const int bin_cells )
+{
+    using sd_type = SplineDataType;
+    static constexpr std::size_t num_space_dim = sd_type::num_space_dim;
+    using value_type = typename GridViewType::value_type;
+
+    // The tile of a bin covers the stencils of all points of the bin when
+    // centered on the stencil of its first point.
+    using tile_view_type =
+        Kokkos::View<value_type*, typename ExecutionSpace::scratch_memory_space,
+                     Kokkos::MemoryUnmanaged>;
+    using tile_type =
+        P2G::ScatterTile<tile_view_type, GridViewType, num_space_dim>;
+    int extent = sd_type::num_knot + 2 * bin_cells;
+    int num_comp = array_view.extent( num_space_dim );
+    int tile_size = num_comp;
+    for ( std::size_t d = 0; d < num_space_dim; ++d )
+        tile_size *= extent;
+
+    using team_policy = Kokkos::TeamPolicy<ExecutionSpace>;
+    team_policy policy( bins.numBin(), Kokkos::AUTO );
+    policy.set_scratch_size(
+        0, Kokkos::PerTeam( tile_view_type::shmem_size( tile_size ) ) );
+
+    // The bin offsets are relative to the beginning of the binning range
+    // while the permutation holds absolute point indices.
+    std::size_t range_begin = bins.rangeBegin();
+
+    Kokkos::parallel_for(
+        "p2g_binned", policy,
+        KOKKOS_LAMBDA( const typename team_policy::member_type& team ) {
+            int b = team.league_rank();
+            int num_bin_point = bins.binSize( b );
+            if ( num_bin_point == 0 )
+                return;
+            auto offset = bins.binOffset( b );
+
+            // Get the point index and spline data.
+            auto evaluate = [&]( const int n, int& p, sd_type& sd ) {
+                p = sorted ? range_begin + offset + n
+                           : bins.permutation( offset + n );
+                evaluator( p, sd );
+            };
+
+            // Center the tile on the stencil of the first point.
+            tile_type tile;
+            tile.tile = tile_view_type( team.team_scratch( 0 ), tile_size );
+            tile.grid = array_view;
+            tile.extent = extent;
+            tile.num_comp = num_comp;
+            {
+                int p;
+                sd_type sd;
+                evaluate( 0, p, sd );
+                for ( std::size_t d = 0; d < num_space_dim; ++d )
+                    tile.origin[d] = sd.s[d][0] - bin_cells;
+            }
+            Kokkos::parallel_for( Kokkos::TeamThreadRange( team, tile_size ),
+                                  [&]( const int n ) { tile.tile( n ) = 0; } );
+            team.team_barrier();
+
+            // Interpolate the points of the bin into the tile.
+            Kokkos::parallel_for(
+                Kokkos::TeamThreadRange( team, num_bin_point ),
+                [&]( const int n ) {
+                    int p;
+                    sd_type sd;
+                    evaluate( n, p, sd );
+                    functor( sd, p, tile );
+                } );
+            team.team_barrier();
+
+            // Add the tile to the grid.
+            Kokkos::parallel_for( Kokkos::TeamThreadRange( team, tile_size ),
+                                  [&]( const int n ) { tile.flush( n ); } );
+        } );
+    Kokkos::fence();
+}
+} // end namespace Impl
+//! \endcond
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Global Point-to-Grid interpolation of binned points.
+
+  \tparam PointEvalFunctor Functor type used to evaluate the interpolated data
+  for a given point at a given entity.
+
+  \tparam PointCoordinates Container type with view traits containing the
+  point coordinates. Will be indexed as (point,dim).
+
+  \tparam BinningDataType The binning data type.
+
+  \param functor A functor that interpolates from a given point to a given
+  entity.
+
+  \param points The points over which to perform the interpolation. Will be
+  indexed as (point,dim). The subset of indices in each point's interpolation
+  stencil must be contained within the local grid that will be used for the
+  interpolation
+
+  \param bins The binning of the points, e.g. from a Cabana::LinkedCellList
+  with cells aligned to the cells of the local grid. Each bin is interpolated
+  by one thread team.
+
+  \param halo The halo associated with the grid array. This hallo will be used
+  to scatter the interpolated data.
+
+  \param array The grid array to which the point data will be interpolated.
+
+  \param sorted True if the points are sorted by the binning, e.g. with
+  Cabana::permute, such that the points of a bin are contiguous. Otherwise
+  the points are accessed through the binning permutation.
+
+  \param bin_cells The number of grid cells covered by a bin in each
+  dimension.
+
+  Each team accumulates the contributions of the points in its bin into a
+  scratch tile of the grid entities around the bin and adds the tile to the
+  array once, such that atomic updates to the array are done per tile entity
+  rather than per point and stencil entity. Contributions of points outside
+  of the tile of their bin are added to the array directly.
+
+  \note Spline of SplineOrder passed for interpolation.
+*/
+template <class PointEvalFunctor, class PointCoordinates, class BinningDataType,
+          class ArrayScalar, class MeshScalar, std::size_t NumSpaceDim,
+          class EntityType, int SplineOrder, class DeviceType,
+          class... ArrayParams>
+std::enable_if_t<( Cabana::is_binning_data<BinningDataType>::value &&
+                   !Cabana::is_aosoa<PointCoordinates>::value ),
+                 void>
+p2g( const PointEvalFunctor& functor, const PointCoordinates& points,
+     const BinningDataType& bins, Spline<SplineOrder>,
+     const Halo<DeviceType>& halo,
+     Array<ArrayScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
+           ArrayParams...>& array,
+     const bool sorted = true, const int bin_cells = 1 )
+{
+    Cabana::Impl::ScopedProfileRegion region( "Cajita::p2g" );
+
+    using array_type =
+        Array<ArrayScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
+              ArrayParams...>;
+    static_assert( std::is_same<typename Halo<DeviceType>::memory_space,
+                                typename array_type::memory_space>::value,
+                   "Mismatching points/array memory space." );
+
+    using execution_space = typename DeviceType::execution_space;
+    using sd_type =
+        SplineData<MeshScalar, SplineOrder, NumSpaceDim, EntityType>;
+
+    // Create the local mesh.
+    auto local_mesh =
+        createLocalMesh<DeviceType>( *( array.layout()->localGrid() ) );
+
+    // Interpolate the bins into the array.
+    Impl::SplinePointEvaluator<decltype( local_mesh ), PointCoordinates>
+        evaluator{ local_mesh, points };
+    Impl::binnedP2G<sd_type>( execution_space(), functor, evaluator, bins,
+                              array.view(), sorted, bin_cells );
+
+    // Scatter interpolation contributions in the halo back to their owning
+    // ranks.
+    halo.scatter( execution_space(), ScatterReduce::Sum(), array );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Global Grid-to-Point, point update, and Point-to-Grid interpolation
+  in a single pass over the points.
+
+  \tparam G2PFunctor Functor type used to interpolate from the source grid
+  array to a given point.
+
+  \tparam UpdateFunctor Functor type used to update a given point.
+
+  \tparam P2GFunctor Functor type used to interpolate from a given point to
+  the destination grid array.
+
+  \tparam PointCoordinates Container type with view traits containing the
+  point coordinates. Will be indexed as (point,dim).
+
+  \param src_array The grid array from which the point data will be
+  interpolated.
+
+  \param src_halo The halo associated with the source grid array. This halo
+  will be used to gather the array data before interpolation.
+
+  \param points The points over which to perform the interpolation. Will be
+  indexed as (point,dim). The subset of indices in each point's interpolation
+  stencil must be contained within the local grid that will be used for the
+  interpolation
+
+  \param num_point The number of points. This is the size of the first
+  dimension of points.
+
+  \param g2p_functor A functor that interpolates from a given entity to a
+  given point.
+
+  \param update_functor A functor that updates a given point with the data
+  interpolated to it. Called as update_functor( sd, p ) once per point.
+
+  \param p2g_functor A functor that interpolates from a given point to a
+  given entity.
+
+  \param dst_halo The halo associated with the destination grid array. This
+  halo will be used to scatter the interpolated data.
+
+  \param dst_array The grid array to which the point data will be
+  interpolated.
+
+  The spline data of each point is evaluated once and used by all three
+  functors, such that the point data is read once and the interpolation
+  weights are computed once rather than in separate g2p and p2g passes. The
+  point coordinates are not re-evaluated after the update: the P2G
+  contribution uses the stencil of the point before the update. The
+  destination array must not be the source array.
+
+  \note Spline of SplineOrder passed for interpolation.
+*/
+template <class G2PFunctor, class UpdateFunctor, class P2GFunctor,
+          class PointCoordinates, class SrcScalar, class DstScalar,
+          class MeshScalar, class EntityType, int SplineOrder,
+          std::size_t NumSpaceDim, class DeviceType, class... SrcParams,
+          class... DstParams>
+void g2p2g(
+    const Array<SrcScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
+                SrcParams...>& src_array,
+    const Halo<DeviceType>& src_halo, const PointCoordinates& points,
+    const std::size_t num_point, Spline<SplineOrder>,
+    const G2PFunctor& g2p_functor, const UpdateFunctor& update_functor,
+    const P2GFunctor& p2g_functor, const Halo<DeviceType>& dst_halo,
+    Array<DstScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
+          DstParams...>& dst_array )
+{
+    Cabana::Impl::ScopedProfileRegion region( "Cajita::g2p2g" );
+
+    using src_array_type =
+        Array<SrcScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
+              SrcParams...>;
+    using dst_array_type =
+        Array<DstScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
+              DstParams...>;
+    static_assert( std::is_same<typename Halo<DeviceType>::memory_space,
+                                typename src_array_type::memory_space>::value,
+                   "Mismatching points/array memory space." );
+    static_assert( std::is_same<typename Halo<DeviceType>::memory_space,
+                                typename dst_array_type::memory_space>::value,
+                   "Mismatching points/array memory space." );
+
+    using execution_space = typename DeviceType::execution_space;
+
+    // Create the local mesh.
+    auto local_mesh =
+        createLocalMesh<DeviceType>( *( src_array.layout()->localGrid() ) );
+
+    // Gather data into the halo before interpolating.
+    src_halo.gather( execution_space(), src_array );
+
+    // Get a view of the source array data.
+    auto src_view = src_array.view();
+
+    // Create a scatter view of the destination array.
+    auto dst_view = dst_array.view();
+    auto dst_sv = P2G::createScatterView( dst_view );
+
+    // Loop over points, interpolate from the grid, update, and interpolate
+    // back to the grid.
+    Kokkos::parallel_for(
+        "g2p2g", Kokkos::RangePolicy<execution_space>( 0, num_point ),
+        KOKKOS_LAMBDA( const int p ) {
+            // Get the point coordinates.
+            MeshScalar px[NumSpaceDim];
+            for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+            {
+                px[d] = points( p, d );
+            }
+
+            // Create the local spline data.
+            using sd_type =
+                SplineData<MeshScalar, SplineOrder, NumSpaceDim, EntityType>;
+            sd_type sd;
+            evaluateSpline( local_mesh, px, sd );
+
+            // Evaluate the functors.
+            g2p_functor( sd, p, src_view );
+            update_functor( sd, p );
+            p2g_functor( sd, p, dst_sv );
+        } );
+    Kokkos::Experimental::contribute( dst_view, dst_sv );
+
+    // Scatter interpolation contributions in the halo back to their owning
+    // ranks.
+    dst_halo.scatter( execution_space(), ScatterReduce::Sum(), dst_array );
+}
+
+//---------------------------------------------------------------------------//
+// Cached spline data.
+//---------------------------------------------------------------------------//
+/*!
+  \brief Member types of cached spline data: the local interpolation stencil,
+  the weight values, and the weight physical gradients of each point.
+*/
+template <class Scalar, int SplineOrder, std::size_t NumSpaceDim>
+using SplineDataCacheMemberTypes = Cabana::MemberTypes<
+    int[NumSpaceDim][Spline<SplineOrder>::num_knot],
+    Scalar[NumSpaceDim][Spline<SplineOrder>::num_knot],
+    Scalar[NumSpaceDim][Spline<SplineOrder>::num_knot]>;
+
+/*!
+  \brief AoSoA of cached spline data with one element per point.
+*/
+template <class Scalar, int SplineOrder, std::size_t NumSpaceDim,
+          class DeviceType>
+using SplineDataCache =
+    Cabana::AoSoA<SplineDataCacheMemberTypes<Scalar, SplineOrder, NumSpaceDim>,
+                  DeviceType>;
+
+/*!
+  \brief Spline data type loaded from a cache. Contains the stencil, weight
+  values, and weight physical gradients.
+*/
+template <class Scalar, int SplineOrder, std::size_t NumSpaceDim,
+          class EntityType>
+using CachedSplineData =
+    SplineData<Scalar, SplineOrder, NumSpaceDim, EntityType,
+               SplineDataMemberTypes<SplineWeightValues,
+                                     SplineWeightPhysicalGradients>>;
+
+//! \cond Impl
+namespace Impl
+{
+// Store the spline data of a point in the cache slices.
+template <class StencilSlice, class WeightSlice, class SplineDataType>
+KOKKOS_INLINE_FUNCTION void
+storeSplineData( const StencilSlice& s, const WeightSlice& w,
+                 const WeightSlice& g, const int p, const SplineDataType& sd )
+{
+    for ( std::size_t d = 0; d < SplineDataType::num_space_dim; ++d )
+        for ( int n = 0; n < SplineDataType::num_knot; ++n )
+        {
+            s( p, d, n ) = sd.s[d][n];
+            w( p, d, n ) = sd.w[d][n];
+            g( p, d, n ) = sd.g[d][n];
+        }
+}
+
+// Load the spline data of a point from the cache slices.
+template <class StencilSlice, class WeightSlice, class SplineDataType>
+KOKKOS_INLINE_FUNCTION void loadSplineData( const StencilSlice& s,
+                                            const WeightSlice& w,
+                                            const WeightSlice& g, const int p,
+                                            SplineDataType& sd )
+{
+    for ( std::size_t d = 0; d < SplineDataType::num_space_dim; ++d )
+        for ( int n = 0; n < SplineDataType::num_knot; ++n )
+        {
+            sd.s[d][n] = s( p, d, n );
+            sd.w[d][n] = w( p, d, n );
+            sd.g[d][n] = g( p, d, n );
+        }
+}
+
+// Load the spline data of a point from the cache slices.
+template <class StencilSlice, class WeightSlice>
+struct SplineCacheLoader
+{
+    StencilSlice s;
+    WeightSlice w;
+    WeightSlice g;
+
+    template <class SplineDataType>
+    KOKKOS_INLINE_FUNCTION void operator()( const int p,
+                                            SplineDataType& sd ) const
+    {
+        loadSplineData( s, w, g, p, sd );
+    }
+};
+} // end namespace Impl
+//! \endcond
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Evaluate the spline data of points on the entities of a grid array
+  and store it in a cache.
+
+  \param array The grid array on whose entities the spline data will be
+  evaluated.
+
+  \param points The points at which to evaluate the spline data. Will be
+  indexed as (point,dim).
+
+  \param num_point The number of points. This is the size of the first
+  dimension of points.
+
+  \param cache The spline data cache, e.g. a SplineDataCache. Resized to the
+  number of points.
+
+  The cache remains valid for interpolation to and from arrays of the same
+  entity type on the same local grid until the points move. It stores the
+  stencil, weight values, and weight physical gradients used by the
+  interpolation functors.
+
+  \note Spline of SplineOrder passed for interpolation.
+*/
+template <class PointCoordinates, class ArrayScalar, class MeshScalar,
+          class EntityType, int SplineOrder, std::size_t NumSpaceDim,
+          class CacheType, class... ArrayParams>
+void evaluateSplineCache(
+    const Array<ArrayScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
+                ArrayParams...>& array,
+    const PointCoordinates& points, const std::size_t num_point,
+    Spline<SplineOrder>, CacheType& cache )
+{
+    using array_type =
+        Array<ArrayScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
+              ArrayParams...>;
+    static_assert(
+        std::is_same<typename CacheType::member_types,
+                     SplineDataCacheMemberTypes<MeshScalar, SplineOrder,
+                                                NumSpaceDim>>::value,
+        "Mismatching spline data cache type." );
+
+    using device_type = typename array_type::device_type;
+    using execution_space = typename device_type::execution_space;
+
+    // Create the local mesh.
+    auto local_mesh =
+        createLocalMesh<device_type>( *( array.layout()->localGrid() ) );
+
+    cache.resize( num_point );
+    auto cache_s = Cabana::slice<0>( cache );
+    auto cache_w = Cabana::slice<1>( cache );
+    auto cache_g = Cabana::slice<2>( cache );
+
+    // Loop over points and evaluate the spline data.
+    Kokkos::parallel_for(
+        "evaluate_spline_cache",
+        Kokkos::RangePolicy<execution_space>( 0, num_point ),
+        KOKKOS_LAMBDA( const int p ) {
+            // Get the point coordinates.
+            MeshScalar px[NumSpaceDim];
+            for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+            {
+                px[d] = points( p, d );
+            }
+
+            // Create the local spline data.
+            using sd_type =
+                SplineData<MeshScalar, SplineOrder, NumSpaceDim, EntityType>;
+            sd_type sd;
+            evaluateSpline( local_mesh, px, sd );
+
+            // Store the spline data.
+            Impl::storeSplineData( cache_s, cache_w, cache_g, p, sd );
+        } );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Global Grid-to-Point interpolation with cached spline data.
+
+  \param array The grid array from which the point data will be interpolated.
+
+  \param halo The halo associated with the grid array. This hallo will be used
+  to gather the array data before interpolation.
+
+  \param cache The spline data of the points from evaluateSplineCache.
+
+  \param functor A functor that interpolates from a given entity to a given
+  point.
+
+  \note Spline of SplineOrder passed for interpolation.
+*/
+template <class PointEvalFunctor, class CacheType, class ArrayScalar,
+          class MeshScalar, class EntityType, int SplineOrder,
+          std::size_t NumSpaceDim, class DeviceType, class... ArrayParams>
+std::enable_if_t<Cabana::is_aosoa<CacheType>::value, void>
+g2p( const Array<ArrayScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
+                 ArrayParams...>& array,
+     const Halo<DeviceType>& halo, const CacheType& cache,
+     Spline<SplineOrder>, const PointEvalFunctor& functor )
+{
+    Cabana::Impl::ScopedProfileRegion region( "Cajita::g2p" );
+
+    using array_type =
+        Array<ArrayScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
+              ArrayParams...>;
+    static_assert( std::is_same<typename Halo<DeviceType>::memory_space,
+                                typename array_type::memory_space>::value,
+                   "Mismatching points/array memory space." );
+    static_assert(
+        std::is_same<typename CacheType::member_types,
+                     SplineDataCacheMemberTypes<MeshScalar, SplineOrder,
+                                                NumSpaceDim>>::value,
+        "Mismatching spline data cache type." );
+
+    using execution_space = typename DeviceType::execution_space;
+
+    // Gather data into the halo before interpolating.
+    halo.gather( execution_space(), array );
+
+    // Get a view of the array data.
+    auto array_view = array.view();
+
+    auto cache_s = Cabana::slice<0>( cache );
+    auto cache_w = Cabana::slice<1>( cache );
+    auto cache_g = Cabana::slice<2>( cache );
+
+    // Loop over points and interpolate from the grid.
+    Kokkos::parallel_for(
+        "g2p_cached", Kokkos::RangePolicy<execution_space>( 0, cache.size() ),
+        KOKKOS_LAMBDA( const int p ) {
+            // Load the spline data.
+            using sd_type = CachedSplineData<MeshScalar, SplineOrder,
+                                             NumSpaceDim, EntityType>;
+            sd_type sd;
+            Impl::loadSplineData( cache_s, cache_w, cache_g, p, sd );
+
+            // Evaluate the functor.
+            functor( sd, p, array_view );
+        } );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Global Point-to-Grid interpolation with cached spline data.
+
+  \param functor A functor that interpolates from a given point to a given
+  entity.
+
+  \param cache The spline data of the points from evaluateSplineCache.
+
+  \param halo The halo associated with the grid array. This hallo will be used
+  to scatter the interpolated data.
+
+  \param array The grid array to which the point data will be interpolated.
+
+  \note Spline of SplineOrder passed for interpolation.
+*/
+template <class PointEvalFunctor, class CacheType, class ArrayScalar,
+          class MeshScalar, std::size_t NumSpaceDim, class EntityType,
+          int SplineOrder, class DeviceType, class... ArrayParams>
+std::enable_if_t<Cabana::is_aosoa<CacheType>::value, void>
+p2g( const PointEvalFunctor& functor, const CacheType& cache,
+     Spline<SplineOrder>, const Halo<DeviceType>& halo,
+     Array<ArrayScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
+           ArrayParams...>& array )
+{
+    Cabana::Impl::ScopedProfileRegion region( "Cajita::p2g" );
+
+    using array_type =
+        Array<ArrayScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
+              ArrayParams...>;
+    static_assert( std::is_same<typename Halo<DeviceType>::memory_space,
+                                typename array_type::memory_space>::value,
+                   "Mismatching points/array memory space." );
+    static_assert(
+        std::is_same<typename CacheType::member_types,
+                     SplineDataCacheMemberTypes<MeshScalar, SplineOrder,
+                                                NumSpaceDim>>::value,
+        "Mismatching spline data cache type." );
+
+    using execution_space = typename DeviceType::execution_space;
+
+    // Create a scatter view of the array.
+    auto array_view = array.view();
+    auto array_sv = P2G::createScatterView( array_view );
+
+    auto cache_s = Cabana::slice<0>( cache );
+    auto cache_w = Cabana::slice<1>( cache );
+    auto cache_g = Cabana::slice<2>( cache );
+
+    // Loop over points and interpolate to the grid.
+    Kokkos::parallel_for(
+        "p2g_cached", Kokkos::RangePolicy<execution_space>( 0, cache.size() ),
+        KOKKOS_LAMBDA( const int p ) {
+            // Load the spline data.
+            using sd_type = CachedSplineData<MeshScalar, SplineOrder,
+                                             NumSpaceDim, EntityType>;
+            sd_type sd;
+            Impl::loadSplineData( cache_s, cache_w, cache_g, p, sd );
+
+            // Evaluate the functor.
+            functor( sd, p, array_sv );
+        } );
+    Kokkos::Experimental::contribute( array_view, array_sv );
+
+    // Scatter interpolation contributions in the halo back to their owning
+    // ranks.
+    halo.scatter( execution_space(), ScatterReduce::Sum(), array );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Global Point-to-Grid interpolation of binned points with cached
+  spline data.
+
+  \param functor A functor that interpolates from a given point to a given
+  entity.
+
+  \param cache The spline data of the points from evaluateSplineCache.
+
+  \param bins The binning of the points, e.g. from a Cabana::LinkedCellList
+  with cells aligned to the cells of the local grid. Each bin is interpolated
+  by one thread team.
+
+  \param halo The halo associated with the grid array. This hallo will be used
+  to scatter the interpolated data.
+
+  \param array The grid array to which the point data will be interpolated.
+
+  \param sorted True if the points are sorted by the binning such that the
+  points of a bin are contiguous. Otherwise the points are accessed through
+  the binning permutation.
+
+  \param bin_cells The number of grid cells covered by a bin in each
+  dimension.
+
+  The per-dimension stencil weights of each point are loaded from the cache
+  rather than evaluated, and the team of each bin accumulates the tensor
+  product of the weights into a scratch tile of the grid entities around the
+  bin which is added to the array once, as in the binned p2g() without a
+  cache. This suits repeated spreading of high order splines, e.g. several
+  fields or solver iterations per step, where evaluating the weights and
+  adding every stencil contribution to the array atomically dominate.
+
+  \note Spline of SplineOrder passed for interpolation.
+*/
+template <class PointEvalFunctor, class CacheType, class BinningDataType,
+          class ArrayScalar, class MeshScalar, std::size_t NumSpaceDim,
+          class EntityType, int SplineOrder, class DeviceType,
+          class... ArrayParams>
+std::enable_if_t<( Cabana::is_aosoa<CacheType>::value &&
+                   Cabana::is_binning_data<BinningDataType>::value ),
+                 void>
+p2g( const PointEvalFunctor& functor, const CacheType& cache,
+     const BinningDataType& bins, Spline<SplineOrder>,
+     const Halo<DeviceType>& halo,
+     Array<ArrayScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
+           ArrayParams...>& array,
+     const bool sorted = true, const int bin_cells = 1 )
+{
+    Cabana::Impl::ScopedProfileRegion region( "Cajita::p2g" );
+
+    using array_type =
+        Array<ArrayScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
+              ArrayParams...>;
+    static_assert( std::is_same<typename Halo<DeviceType>::memory_space,
+                                typename array_type::memory_space>::value,
+                   "Mismatching points/array memory space." );
+    static_assert(
+        std::is_same<typename CacheType::member_types,
+                     SplineDataCacheMemberTypes<MeshScalar, SplineOrder,
+                                                NumSpaceDim>>::value,
+        "Mismatching spline data cache type." );
+
+    using execution_space = typename DeviceType::execution_space;
+    using sd_type =
+        CachedSplineData<MeshScalar, SplineOrder, NumSpaceDim, EntityType>;
+
+    // Interpolate the bins into the array.
+    auto cache_s = Cabana::slice<0>( cache );
+    auto cache_w = Cabana::slice<1>( cache );
+    auto cache_g = Cabana::slice<2>( cache );
+    Impl::SplineCacheLoader<decltype( cache_s ), decltype( cache_w )> loader{
+        cache_s, cache_w, cache_g };
+    Impl::binnedP2G<sd_type>( execution_space(), functor, loader, bins,
+                              array.view(), sorted, bin_cells );
+
+    // Scatter interpolation contributions in the halo back to their owning
+    // ranks.
+    halo.scatter( execution_space(), ScatterReduce::Sum(), array );
+}
+
+//---------------------------------------------------------------------------//
+// Multiple field grid-to-point interpolation.
+//---------------------------------------------------------------------------//
+/*!
+  \brief A grid array, its halo, and the functor interpolating from it to
+  points, for interpolation together with other fields.
+*/
+template <class ArrayType, class HaloType, class PointEvalFunctor>
+struct G2PField
+{
+    //! Array type.
+    using array_type = ArrayType;
+    //! Functor type.
+    using functor_type = PointEvalFunctor;
+    //! Entity type.
+    using entity_type = typename ArrayType::entity_type;
+    //! Mesh type.
+    using mesh_type = typename ArrayType::mesh_type;
+
+    //! The grid array from which the point data will be interpolated.
+    const ArrayType& array;
+    //! The halo used to gather the array data before interpolation.
+    const HaloType& halo;
+    //! The functor interpolating from a given entity to a given point.
+    PointEvalFunctor functor;
+};
+
+/*!
+  \brief Create a field for multiple field grid-to-point interpolation.
+
+  \param array The grid array from which the point data will be interpolated.
+
+  \param halo The halo associated with the grid array. This halo will be used
+  to gather the array data before interpolation.
+
+  \param functor A functor that interpolates from a given entity to a given
+  point.
+
+  \return The field. It refers to the array and halo, which must outlive it.
+*/
+template <class ArrayType, class HaloType, class PointEvalFunctor>
+G2PField<ArrayType, HaloType, PointEvalFunctor>
+createG2PField( const ArrayType& array, const HaloType& halo,
+                const PointEvalFunctor& functor )
+{
+    return { array, halo, functor };
+}
+
+//! \cond Impl
+namespace Impl
+{
+// Device list of array views and the functors interpolating from them. Each
+// entry is given as a G2PFieldEntry.
+template <class ViewType, class PointEvalFunctor>
+struct G2PFieldEntry;
+
+template <class... Entries>
+struct G2PFieldList;
+
+template <>
+struct G2PFieldList<>
+{
+    template <class SplineDataType>
+    KOKKOS_INLINE_FUNCTION void apply( const SplineDataType&, const int ) const
+    {
+    }
+};
+
+template <class ViewType, class PointEvalFunctor, class... Entries>
+struct G2PFieldList<G2PFieldEntry<ViewType, PointEvalFunctor>, Entries...>
+{
+    ViewType view;
+    PointEvalFunctor functor;
+    G2PFieldList<Entries...> rest;
+
+    template <class SplineDataType>
+    KOKKOS_INLINE_FUNCTION void apply( const SplineDataType& sd,
+                                       const int p ) const
+    {
+        functor( sd, p, view );
+        rest.apply( sd, p );
+    }
+};
+
+inline G2PFieldList<> createG2PFieldList() { return {}; }
+
+template <class Field, class... Fields>
+G2PFieldList<G2PFieldEntry<typename Field::array_type::view_type,
+                           typename Field::functor_type>,
+             G2PFieldEntry<typename Fields::array_type::view_type,
+                           typename Fields::functor_type>...>
+createG2PFieldList( const Field& field, const Fields&... fields )
+{
+    return { field.array.view(), field.functor,
+             createG2PFieldList( fields... ) };
+}
+} // end namespace Impl
+//! \endcond
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Global Grid-to-Point interpolation of multiple fields in a single
+  pass over the points.
+
+  \param points The points over which to perform the interpolation. Will be
+  indexed as (point,dim). The subset of indices in each point's interpolation
+  stencil must be contained within the local grid that will be used for the
+  interpolation
+
+  \param num_point The number of points. This is the size of the first
+  dimension of points.
+
+  \param field The first field to interpolate, from createG2PField.
+
+  \param fields The other fields to interpolate. All arrays must be defined
+  on the same entity type of the same local grid.
+
+  The halos of all fields are gathered first. Each point then reads its
+  coordinates and evaluates its spline data once, and the functors of all
+  fields are evaluated with it in turn.
+
+  \note Spline of SplineOrder passed for interpolation.
+*/
+template <class PointCoordinates, int SplineOrder, class ArrayType,
+          class HaloType, class PointEvalFunctor, class... Fields>
+void g2p( const PointCoordinates& points, const std::size_t num_point,
+          Spline<SplineOrder>,
+          const G2PField<ArrayType, HaloType, PointEvalFunctor>& field,
+          const Fields&... fields )
+{
+    Cabana::Impl::ScopedProfileRegion region( "Cajita::g2p" );
+
+    using entity_type = typename ArrayType::entity_type;
+    using mesh_type = typename ArrayType::mesh_type;
+    // The lists are equal when rotated if and only if all types are the same.
+    static_assert(
+        std::is_same<std::tuple<entity_type, typename Fields::entity_type...>,
+                     std::tuple<typename Fields::entity_type...,
+                                entity_type>>::value,
+        "Mismatching array entity types." );
+    static_assert(
+        std::is_same<
+            std::tuple<mesh_type, typename Fields::mesh_type...>,
+            std::tuple<typename Fields::mesh_type..., mesh_type>>::value,
+        "Mismatching array mesh types." );
+
+    using execution_space = typename ArrayType::execution_space;
+    using mesh_scalar = typename mesh_type::scalar_type;
+
+    // Create the local mesh.
+    auto local_mesh = createLocalMesh<typename ArrayType::device_type>(
+        *( field.array.layout()->localGrid() ) );
+
+    // Gather data into the halos before interpolating.
+    field.halo.gather( execution_space(), field.array );
+    (void)std::initializer_list<int>{ (
+        fields.halo.gather( execution_space(), fields.array ), 0 )... };
+
+    // Get the views of the array data with their functors.
+    auto field_list = Impl::createG2PFieldList( field, fields... );
+
+    // Loop over points and interpolate from the grids.
+    Kokkos::parallel_for(
+        "g2p_multiple", Kokkos::RangePolicy<execution_space>( 0, num_point ),
+        KOKKOS_LAMBDA( const int p ) {
+            // Get the point coordinates.
+            mesh_scalar px[mesh_type::num_space_dim];
+            for ( std::size_t d = 0; d < mesh_type::num_space_dim; ++d )
+            {
+                px[d] = points( p, d );
+            }
+
+            // Create the local spline data.
+            using sd_type = SplineData<mesh_scalar, SplineOrder,
+                                       mesh_type::num_space_dim, entity_type>;
+            sd_type sd;
+            evaluateSpline( local_mesh, px, sd );
+
+            // Evaluate the functors.
+            field_list.apply( sd, p );
+        } );
+}
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Point-to-grid scalar value functor.
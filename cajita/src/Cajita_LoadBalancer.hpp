@@ -0,0 +1,494 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cajita_LoadBalancer.hpp
+  \brief Workload driven repartitioning of a grid, its particles and arrays
+*/
+#ifndef CAJITA_LOADBALANCER_HPP
+#define CAJITA_LOADBALANCER_HPP
+
+#include <Cabana_Distributor.hpp>
+
+#include <Cajita_Array.hpp>
+#include <Cajita_GlobalGrid.hpp>
+#include <Cajita_GlobalMesh.hpp>
+#include <Cajita_IndexSpace.hpp>
+#include <Cajita_LocalGrid.hpp>
+#include <Cajita_SparseDimPartitioner.hpp>
+#include <Cajita_Types.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <mpi.h>
+
+namespace Cajita
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief Rebalance a uniform grid together with its particles and arrays.
+
+  Each rank reports a measured workload, e.g. its step time or its particle
+  count. When the largest workload exceeds the average by the imbalance
+  threshold the SparseDimPartitioner re-optimizes the block boundaries from
+  the particle distribution, the global and local grids are rebuilt on the
+  new partition and the particles and arrays are moved to their new owners.
+
+  \tparam MeshType Uniform 3D mesh type.
+  \tparam Device Kokkos device type.
+  \tparam CellPerTileDim Cells per tile per dimension.
+*/
+template <class MeshType, class Device, unsigned long long CellPerTileDim = 4>
+class LoadBalancer
+{
+  public:
+    //! Mesh type.
+    using mesh_type = MeshType;
+    //! Kokkos device type.
+    using device_type = Device;
+    //! Kokkos memory space.
+    using memory_space = typename Device::memory_space;
+    //! Kokkos execution space.
+    using execution_space = typename Device::execution_space;
+    //! Partitioner type.
+    using partitioner_type = SparseDimPartitioner<Device, CellPerTileDim>;
+    //! Spatial dimension.
+    static constexpr std::size_t num_space_dim = mesh_type::num_space_dim;
+
+    static_assert( isUniformMesh<MeshType>::value,
+                   "The load balancer requires a uniform mesh" );
+    static_assert( 3 == num_space_dim, "The load balancer requires a 3D mesh" );
+
+    /*!
+      \brief Constructor. Builds the grids on the current partition of the
+      partitioner.
+      \param comm The communicator over which to define the grid.
+      \param global_mesh The global mesh data.
+      \param periodic Whether each logical dimension is periodic.
+      \param halo_cell_width The number of halo cells of the local grid.
+      \param partitioner The partitioner with an initialized partition.
+      \param imbalance_threshold Ratio of the largest to the average workload
+      above which the grid is rebalanced.
+    */
+    LoadBalancer( MPI_Comm comm,
+                  const std::shared_ptr<GlobalMesh<MeshType>>& global_mesh,
+                  const std::array<bool, num_space_dim>& periodic,
+                  const int halo_cell_width,
+                  const std::shared_ptr<partitioner_type>& partitioner,
+                  const double imbalance_threshold = 1.2 )
+        : _comm( comm )
+        , _global_mesh( global_mesh )
+        , _periodic( periodic )
+        , _halo_cell_width( halo_cell_width )
+        , _partitioner( partitioner )
+        , _imbalance_threshold( imbalance_threshold )
+    {
+        build();
+    }
+
+    //! Get the global grid on the current partition.
+    std::shared_ptr<GlobalGrid<MeshType>> globalGrid() const
+    {
+        return _global_grid;
+    }
+
+    //! Get the local grid on the current partition.
+    std::shared_ptr<LocalGrid<MeshType>> localGrid() const
+    {
+        return _local_grid;
+    }
+
+    //! Get the partitioner.
+    std::shared_ptr<partitioner_type> partitioner() const
+    {
+        return _partitioner;
+    }
+
+    /*!
+      \brief Get the imbalance factor of the measured workloads: the largest
+      workload over the average workload.
+      \param local_work The workload measured on this rank.
+    */
+    double imbalanceFactor( const double local_work ) const
+    {
+        double max_work = 0.0;
+        double total_work = 0.0;
+        MPI_Allreduce( &local_work, &max_work, 1, MPI_DOUBLE, MPI_MAX,
+                       _global_grid->comm() );
+        MPI_Allreduce( &local_work, &total_work, 1, MPI_DOUBLE, MPI_SUM,
+                       _global_grid->comm() );
+        if ( total_work <= 0.0 )
+            return 1.0;
+        return max_work * _global_grid->totalNumBlock() / total_work;
+    }
+
+    /*!
+      \brief Rebalance if the workload imbalance crosses the threshold: the
+      partition is optimized from the particle positions, the grids are
+      rebuilt and the particles and arrays are moved to the new partition.
+
+      The positions slice and any other slice of the particles are invalid
+      after a rebalance. The ghost values of the arrays are not filled.
+
+      \param local_work The workload measured on this rank.
+      \param positions The particle positions.
+      \param particles The particle AoSoA, migrated in place.
+      \param arrays The arrays on the current local grid, replaced by arrays
+      on the new local grid.
+      \return Whether the partition changed.
+    */
+    template <class PositionSliceType, class ParticleContainer,
+              class... ArrayTypes>
+    bool rebalance( const double local_work, PositionSliceType& positions,
+                    ParticleContainer& particles,
+                    std::shared_ptr<ArrayTypes>&... arrays )
+    {
+        if ( imbalanceFactor( local_work ) < _imbalance_threshold )
+            return false;
+
+        if ( !updatePartition( positions ) )
+            return false;
+
+        migrateParticles( positions, particles );
+        int remap[] = { 0, ( arrays = remapArray( *arrays ), 0 )... };
+        (void)remap;
+        return true;
+    }
+
+    /*!
+      \brief Optimize the partition from the particle positions and rebuild
+      the grids on it.
+      \param positions The particle positions.
+      \return Whether the partition changed.
+    */
+    template <class PositionSliceType>
+    bool updatePartition( const PositionSliceType& positions )
+    {
+        auto old_partition = _partitioner->getCurrentPartition();
+
+        std::array<double, num_space_dim> low_corner;
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+            low_corner[d] = _global_mesh->lowCorner( d );
+        _partitioner->optimizePartition( positions, positions.size(),
+                                         low_corner,
+                                         _global_mesh->cellSize( 0 ),
+                                         _global_grid->comm() );
+
+        // The optimization picks its starting dimension at random, so make
+        // every rank use the partition found on the first one.
+        auto partition = _partitioner->getCurrentPartition();
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+            MPI_Bcast( partition[d].data(), partition[d].size(), MPI_INT, 0,
+                       _global_grid->comm() );
+        _partitioner->initializeRecPartition( partition[0], partition[1],
+                                              partition[2] );
+
+        if ( partition == old_partition )
+            return false;
+
+        build();
+        return true;
+    }
+
+    /*!
+      \brief Move every particle to the rank owning it on the current
+      partition. Positions across periodic boundaries are wrapped back into
+      the domain.
+      \param positions The particle positions.
+      \param particles The particle AoSoA, migrated in place.
+    */
+    template <class PositionSliceType, class ParticleContainer>
+    void migrateParticles( PositionSliceType& positions,
+                           ParticleContainer& particles ) const
+    {
+        using slice_device_type = typename PositionSliceType::device_type;
+        using slice_execution_space =
+            typename PositionSliceType::execution_space;
+
+        // Low cell of each block and the rank of each block.
+        Kokkos::Array<int, num_space_dim> num_block;
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+            num_block[d] = _global_grid->dimNumBlock( d );
+        int max_block = *std::max_element( num_block.data(),
+                                           num_block.data() + num_space_dim );
+        Kokkos::View<int**, slice_device_type> block_low(
+            "block_low", num_space_dim, max_block );
+        Kokkos::View<int***, slice_device_type> block_rank(
+            "block_rank", num_block[0], num_block[1], num_block[2] );
+        auto block_low_host =
+            Kokkos::create_mirror_view( Kokkos::HostSpace(), block_low );
+        auto block_rank_host =
+            Kokkos::create_mirror_view( Kokkos::HostSpace(), block_rank );
+        auto partition = _partitioner->getCurrentPartition();
+        int cell_num_per_tile_dim = partitioner_type::cell_num_per_tile_dim;
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+            for ( int b = 0; b < num_block[d]; ++b )
+                block_low_host( d, b ) =
+                    partition[d][b] * cell_num_per_tile_dim;
+        for ( int i = 0; i < num_block[0]; ++i )
+            for ( int j = 0; j < num_block[1]; ++j )
+                for ( int k = 0; k < num_block[2]; ++k )
+                    block_rank_host( i, j, k ) =
+                        _global_grid->blockRank( i, j, k );
+        Kokkos::deep_copy( block_low, block_low_host );
+        Kokkos::deep_copy( block_rank, block_rank_host );
+
+        Kokkos::Array<bool, num_space_dim> periodic;
+        Kokkos::Array<double, num_space_dim> global_low;
+        Kokkos::Array<double, num_space_dim> global_high;
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+        {
+            periodic[d] = _periodic[d];
+            global_low[d] = _global_mesh->lowCorner( d );
+            global_high[d] = _global_mesh->highCorner( d );
+        }
+        double inv_dx = 1.0 / _global_mesh->cellSize( 0 );
+
+        Kokkos::View<int*, slice_device_type> destinations(
+            Kokkos::ViewAllocateWithoutInitializing( "destinations" ),
+            positions.size() );
+        Kokkos::parallel_for(
+            "Cajita::LoadBalancer::destinations",
+            Kokkos::RangePolicy<slice_execution_space>( 0, positions.size() ),
+            KOKKOS_LAMBDA( const int p ) {
+                int ijk[num_space_dim];
+                for ( std::size_t d = 0; d < num_space_dim; ++d )
+                {
+                    if ( periodic[d] )
+                    {
+                        double extent = global_high[d] - global_low[d];
+                        if ( positions( p, d ) > global_high[d] )
+                            positions( p, d ) -= extent;
+                        else if ( positions( p, d ) < global_low[d] )
+                            positions( p, d ) += extent;
+                    }
+                    double x = ( positions( p, d ) - global_low[d] ) * inv_dx;
+                    int cell = ( x < 0.0 ) ? -1 : static_cast<int>( x );
+                    ijk[d] = 0;
+                    for ( int b = 1; b < num_block[d]; ++b )
+                        if ( cell >= block_low( d, b ) )
+                            ijk[d] = b;
+                }
+                destinations( p ) = block_rank( ijk[0], ijk[1], ijk[2] );
+            } );
+
+        Cabana::Distributor<slice_device_type> distributor(
+            _global_grid->comm(), destinations );
+        Cabana::migrate( distributor, particles );
+    }
+
+    /*!
+      \brief Copy the owned values of an array built on a previous partition
+      into a new array on the current local grid.
+      \param array The array on the previous local grid.
+      \return The array on the current local grid. Ghost values are not
+      filled.
+    */
+    template <class ArrayType>
+    std::shared_ptr<ArrayType> remapArray( const ArrayType& array ) const
+    {
+        using entity_type = typename ArrayType::entity_type;
+        using value_type = typename ArrayType::value_type;
+
+        auto old_layout = array.layout();
+        auto new_layout = createArrayLayout(
+            _local_grid, old_layout->dofsPerEntity(), entity_type() );
+        auto new_array =
+            std::make_shared<ArrayType>( array.label(), new_layout );
+
+        // Owned index spaces of every rank before and after the rebalance, in
+        // global indices: old min, old max, new min, new max.
+        auto old_global = old_layout->indexSpace( Own(), Global() );
+        auto old_local = old_layout->indexSpace( Own(), Local() );
+        auto new_global = new_layout->indexSpace( Own(), Global() );
+        auto new_local = new_layout->indexSpace( Own(), Local() );
+        std::array<int, 4 * num_space_dim> local_bounds;
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+        {
+            local_bounds[d] = old_global.min( d );
+            local_bounds[num_space_dim + d] = old_global.max( d );
+            local_bounds[2 * num_space_dim + d] = new_global.min( d );
+            local_bounds[3 * num_space_dim + d] = new_global.max( d );
+        }
+        MPI_Comm comm = _global_grid->comm();
+        int comm_rank;
+        int comm_size;
+        MPI_Comm_rank( comm, &comm_rank );
+        MPI_Comm_size( comm, &comm_size );
+        std::vector<int> bounds( 4 * num_space_dim * comm_size );
+        MPI_Allgather( local_bounds.data(), 4 * num_space_dim, MPI_INT,
+                       bounds.data(), 4 * num_space_dim, MPI_INT, comm );
+
+        // Global entities owned by one rank before and by another after.
+        auto overlap = [&]( const int old_rank, const int new_rank ) {
+            std::array<long, num_space_dim> min;
+            std::array<long, num_space_dim> max;
+            const int* old_bounds = &bounds[4 * num_space_dim * old_rank];
+            const int* new_bounds =
+                &bounds[4 * num_space_dim * new_rank + 2 * num_space_dim];
+            for ( std::size_t d = 0; d < num_space_dim; ++d )
+            {
+                min[d] = std::max( old_bounds[d], new_bounds[d] );
+                max[d] = std::max(
+                    min[d], static_cast<long>(
+                                std::min( old_bounds[num_space_dim + d],
+                                          new_bounds[num_space_dim + d] ) ) );
+            }
+            return IndexSpace<num_space_dim>( min, max );
+        };
+
+        auto old_host = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), array.view() );
+        auto new_host = Kokkos::create_mirror_view( Kokkos::HostSpace(),
+                                                    new_array->view() );
+        int dofs = old_layout->dofsPerEntity();
+        std::array<long, num_space_dim> old_shift;
+        std::array<long, num_space_dim> new_shift;
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+        {
+            old_shift[d] = old_global.min( d ) - old_local.min( d );
+            new_shift[d] = new_global.min( d ) - new_local.min( d );
+        }
+
+        // Post the receives and pack and send the owned values.
+        const int mpi_tag = 7305;
+        std::vector<std::vector<value_type>> send_buffers( comm_size );
+        std::vector<std::vector<value_type>> recv_buffers( comm_size );
+        std::vector<MPI_Request> requests;
+        for ( int r = 0; r < comm_size; ++r )
+        {
+            auto space = overlap( r, comm_rank );
+            if ( space.size() == 0 )
+                continue;
+            recv_buffers[r].resize( space.size() * dofs );
+            requests.push_back( MPI_Request() );
+            MPI_Irecv( recv_buffers[r].data(),
+                       recv_buffers[r].size() * sizeof( value_type ), MPI_BYTE,
+                       r, mpi_tag, comm, &requests.back() );
+        }
+        for ( int r = 0; r < comm_size; ++r )
+        {
+            auto space = overlap( comm_rank, r );
+            if ( space.size() == 0 )
+                continue;
+            send_buffers[r].reserve( space.size() * dofs );
+            for ( long i = space.min( 0 ); i < space.max( 0 ); ++i )
+                for ( long j = space.min( 1 ); j < space.max( 1 ); ++j )
+                    for ( long k = space.min( 2 ); k < space.max( 2 ); ++k )
+                        for ( int n = 0; n < dofs; ++n )
+                            send_buffers[r].push_back(
+                                old_host( i - old_shift[0], j - old_shift[1],
+                                          k - old_shift[2], n ) );
+            requests.push_back( MPI_Request() );
+            MPI_Isend( send_buffers[r].data(),
+                       send_buffers[r].size() * sizeof( value_type ), MPI_BYTE,
+                       r, mpi_tag, comm, &requests.back() );
+        }
+        MPI_Waitall( requests.size(), requests.data(), MPI_STATUSES_IGNORE );
+
+        // Unpack the received values.
+        for ( int r = 0; r < comm_size; ++r )
+        {
+            auto space = overlap( r, comm_rank );
+            if ( space.size() == 0 )
+                continue;
+            std::size_t e = 0;
+            for ( long i = space.min( 0 ); i < space.max( 0 ); ++i )
+                for ( long j = space.min( 1 ); j < space.max( 1 ); ++j )
+                    for ( long k = space.min( 2 ); k < space.max( 2 ); ++k )
+                        for ( int n = 0; n < dofs; ++n, ++e )
+                            new_host( i - new_shift[0], j - new_shift[1],
+                                      k - new_shift[2], n ) =
+                                recv_buffers[r][e];
+        }
+        Kokkos::deep_copy( new_array->view(), new_host );
+
+        return new_array;
+    }
+
+  private:
+    // Build the global and local grids on the current partition.
+    void build()
+    {
+        _global_grid =
+            createGlobalGrid( _comm, _global_mesh, _periodic, *_partitioner );
+
+        auto partition = _partitioner->getCurrentPartition();
+        int cell_num_per_tile_dim = partitioner_type::cell_num_per_tile_dim;
+        std::array<int, num_space_dim> num_cell;
+        std::array<int, num_space_dim> offset;
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+        {
+            int global_num_cell = _global_grid->globalNumEntity( Cell(), d );
+            int b = _global_grid->dimBlockId( d );
+            int low = std::min( partition[d][b] * cell_num_per_tile_dim,
+                                global_num_cell );
+            int high =
+                ( b == _global_grid->dimNumBlock( d ) - 1 )
+                    ? global_num_cell
+                    : std::min( partition[d][b + 1] * cell_num_per_tile_dim,
+                                global_num_cell );
+            offset[d] = low;
+            num_cell[d] = high - low;
+        }
+        _global_grid->setNumCellAndOffset( num_cell, offset );
+
+        _local_grid = createLocalGrid( _global_grid, _halo_cell_width );
+    }
+
+    MPI_Comm _comm;
+    std::shared_ptr<GlobalMesh<MeshType>> _global_mesh;
+    std::array<bool, num_space_dim> _periodic;
+    int _halo_cell_width;
+    std::shared_ptr<partitioner_type> _partitioner;
+    double _imbalance_threshold;
+    std::shared_ptr<GlobalGrid<MeshType>> _global_grid;
+    std::shared_ptr<LocalGrid<MeshType>> _local_grid;
+};
+
+//---------------------------------------------------------------------------//
+// Creation function.
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create a load balancer.
+  \param comm The communicator over which to define the grid.
+  \param global_mesh The global mesh data.
+  \param periodic Whether each logical dimension is periodic.
+  \param halo_cell_width The number of halo cells of the local grid.
+  \param partitioner The partitioner with an initialized partition.
+  \param imbalance_threshold Ratio of the largest to the average workload
+  above which the grid is rebalanced.
+*/
+template <class MeshType, class Device, unsigned long long CellPerTileDim>
+std::shared_ptr<LoadBalancer<MeshType, Device, CellPerTileDim>>
+createLoadBalancer(
+    MPI_Comm comm, const std::shared_ptr<GlobalMesh<MeshType>>& global_mesh,
+    const std::array<bool, 3>& periodic, const int halo_cell_width,
+    const std::shared_ptr<SparseDimPartitioner<Device, CellPerTileDim>>&
+        partitioner,
+    const double imbalance_threshold = 1.2 )
+{
+    return std::make_shared<LoadBalancer<MeshType, Device, CellPerTileDim>>(
+        comm, global_mesh, periodic, halo_cell_width, partitioner,
+        imbalance_threshold );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cajita
+
+#endif // end CAJITA_LOADBALANCER_HPP
@@ -21,8 +21,11 @@
 #include <Cajita_Types.hpp>
 
 #include <array>
+#include <map>
 #include <memory>
+#include <tuple>
 #include <type_traits>
+#include <typeindex>
 #include <vector>
 
 namespace Cajita
@@ -31,6 +34,12 @@ namespace Cajita
 /*!
   \brief Local logical grid.
   \tparam MeshType Mesh type: UniformMesh, NonUniformMesh, or SparseMesh
+
+  Index spaces are computed on the first request and cached such that halo
+  construction and boundary loops do not repeat the index arithmetic. The
+  cache is reset if the owned cells of the global grid change. It is not
+  synchronized: index spaces must not be requested concurrently from several
+  host threads.
 */
 template <class MeshType>
 class LocalGrid
@@ -246,7 +255,38 @@ class LocalGrid
     boundaryIndexSpace( DecompositionTag t1, EntityType t2, const int off_i,
                         const int off_j, const int halo_width = -1 ) const;
 
+    /*!
+      \brief Compute and cache the owned and ghosted index spaces of every
+      entity type and the shared and boundary index spaces with every
+      neighbor offset using the halo width of the local grid.
+
+      Later requests for these spaces are lookups. Calling this is optional
+      as spaces are otherwise cached on first request.
+    */
+    void precomputeIndexSpaces() const;
+
+    //! \brief Clear the cached index spaces.
+    void clearIndexSpaceCache() const;
+
+    //! \brief Get the number of cached index spaces.
+    std::size_t numCachedIndexSpace() const;
+
   private:
+    // Clear the cache if the owned cells of the global grid changed since
+    // the spaces were cached.
+    void validateIndexSpaceCache() const;
+
+    // Cache the spaces of an entity type.
+    template <class EntityType>
+    void precomputeEntityIndexSpaces( EntityType ) const;
+
+    // Cache the spaces of the entity types of the given dimension.
+    template <std::size_t NSD = num_space_dim>
+    std::enable_if_t<3 == NSD, void> precomputeDimIndexSpaces() const;
+
+    template <std::size_t NSD = num_space_dim>
+    std::enable_if_t<2 == NSD, void> precomputeDimIndexSpaces() const;
+
     // 3D and 2D entity types
     IndexSpace<num_space_dim> indexSpaceImpl( Own, Cell, Local ) const;
     IndexSpace<num_space_dim> indexSpaceImpl( Ghost, Cell, Local ) const;
@@ -455,6 +495,21 @@ class LocalGrid
   private:
     std::shared_ptr<GlobalGrid<MeshType>> _global_grid;
     int _halo_cell_width;
+
+    // Index space caches keyed by the tag types, neighbor offsets, and halo
+    // width.
+    using index_key_type =
+        std::tuple<std::type_index, std::type_index, std::type_index>;
+    using shared_key_type =
+        std::tuple<std::type_index, std::type_index,
+                   std::array<int, num_space_dim>, int>;
+    mutable std::map<index_key_type, IndexSpace<num_space_dim>> _index_cache;
+    mutable std::map<shared_key_type, IndexSpace<num_space_dim>>
+        _shared_cache;
+    mutable std::map<shared_key_type, IndexSpace<num_space_dim>>
+        _boundary_cache;
+    mutable std::array<int, num_space_dim> _cache_num_cell;
+    mutable std::array<int, num_space_dim> _cache_offset;
 };
 
 //---------------------------------------------------------------------------//
@@ -23,6 +23,11 @@ LocalGrid<MeshType>::LocalGrid(
     : _global_grid( global_grid )
     , _halo_cell_width( halo_cell_width )
 {
+    for ( std::size_t d = 0; d < num_space_dim; ++d )
+    {
+        _cache_num_cell[d] = _global_grid->ownedNumCell( d );
+        _cache_offset[d] = _global_grid->globalOffset( d );
+    }
 }
 
 //---------------------------------------------------------------------------//
@@ -91,7 +96,15 @@ auto LocalGrid<MeshType>::indexSpace( DecompositionTag t1, EntityType t2,
                                       IndexType t3 ) const
     -> IndexSpace<num_space_dim>
 {
-    return indexSpaceImpl( t1, t2, t3 );
+    validateIndexSpaceCache();
+    index_key_type key( typeid( t1 ), typeid( t2 ), typeid( t3 ) );
+    auto cached = _index_cache.find( key );
+    if ( cached != _index_cache.end() )
+        return cached->second;
+
+    auto space = indexSpaceImpl( t1, t2, t3 );
+    _index_cache.emplace( key, space );
+    return space;
 }
 
 //---------------------------------------------------------------------------//
@@ -122,18 +135,28 @@ auto LocalGrid<MeshType>::sharedIndexSpace(
         throw std::logic_error(
             "Requested halo width larger than local grid halo" );
 
+    validateIndexSpaceCache();
+    shared_key_type key( typeid( t1 ), typeid( t2 ), off_ijk, hw );
+    auto cached = _shared_cache.find( key );
+    if ( cached != _shared_cache.end() )
+        return cached->second;
+
     // Check to see if this is a valid neighbor. If not, return a shared space
-    // of size 0.
+    // of size 0. Otherwise call the underlying implementation.
+    IndexSpace<num_space_dim> space;
     if ( neighborRank( off_ijk ) < 0 )
     {
         std::array<long, num_space_dim> zero_size;
         for ( std::size_t d = 0; d < num_space_dim; ++d )
             zero_size[d] = 0;
-        return IndexSpace<num_space_dim>( zero_size, zero_size );
+        space = IndexSpace<num_space_dim>( zero_size, zero_size );
     }
-
-    // Call the underlying implementation.
-    return sharedIndexSpaceImpl( t1, t2, off_ijk, hw );
+    else
+    {
+        space = sharedIndexSpaceImpl( t1, t2, off_ijk, hw );
+    }
+    _shared_cache.emplace( key, space );
+    return space;
 }
 
 template <class MeshType>
@@ -187,19 +210,30 @@ auto LocalGrid<MeshType>::boundaryIndexSpace(
         throw std::logic_error(
             "Requested halo width larger than local grid halo" );
 
+    validateIndexSpaceCache();
+    shared_key_type key( typeid( t1 ), typeid( t2 ), off_ijk, hw );
+    auto cached = _boundary_cache.find( key );
+    if ( cached != _boundary_cache.end() )
+        return cached->second;
+
     // Check to see if this is not a communication neighbor. If it is, return
-    // a boundary space of size 0 because there is no boundary.
+    // a boundary space of size 0 because there is no boundary. Otherwise the
+    // boundary index space is just the shared index space for the given
+    // offsets and decomposition.
+    IndexSpace<num_space_dim> space;
     if ( neighborRank( off_ijk ) >= 0 )
     {
         std::array<long, num_space_dim> zero_size;
         for ( std::size_t d = 0; d < num_space_dim; ++d )
             zero_size[d] = 0;
-        return IndexSpace<num_space_dim>( zero_size, zero_size );
+        space = IndexSpace<num_space_dim>( zero_size, zero_size );
     }
-
-    // The boundary index space is just the shared index space for the
-    // given offsets and decomposition.
-    return sharedIndexSpaceImpl( t1, t2, off_ijk, hw );
+    else
+    {
+        space = sharedIndexSpaceImpl( t1, t2, off_ijk, hw );
+    }
+    _boundary_cache.emplace( key, space );
+    return space;
 }
 
 template <class MeshType>
@@ -225,6 +259,111 @@ LocalGrid<MeshType>::boundaryIndexSpace( DecompositionTag t1, EntityType t2,
     return boundaryIndexSpace( t1, t2, off_ijk, halo_width );
 }
 
+//---------------------------------------------------------------------------//
+// Compute and cache the spaces of every entity type.
+template <class MeshType>
+void LocalGrid<MeshType>::precomputeIndexSpaces() const
+{
+    precomputeEntityIndexSpaces( Cell() );
+    precomputeEntityIndexSpaces( Node() );
+    precomputeEntityIndexSpaces( Face<Dim::I>() );
+    precomputeEntityIndexSpaces( Face<Dim::J>() );
+    precomputeDimIndexSpaces();
+}
+
+//---------------------------------------------------------------------------//
+// Clear the cached index spaces.
+template <class MeshType>
+void LocalGrid<MeshType>::clearIndexSpaceCache() const
+{
+    _index_cache.clear();
+    _shared_cache.clear();
+    _boundary_cache.clear();
+}
+
+//---------------------------------------------------------------------------//
+// Get the number of cached index spaces.
+template <class MeshType>
+std::size_t LocalGrid<MeshType>::numCachedIndexSpace() const
+{
+    return _index_cache.size() + _shared_cache.size() +
+           _boundary_cache.size();
+}
+
+//---------------------------------------------------------------------------//
+// Clear the cache if the owned cells of the global grid changed.
+template <class MeshType>
+void LocalGrid<MeshType>::validateIndexSpaceCache() const
+{
+    bool changed = false;
+    for ( std::size_t d = 0; d < num_space_dim; ++d )
+    {
+        if ( _cache_num_cell[d] != _global_grid->ownedNumCell( d ) ||
+             _cache_offset[d] != _global_grid->globalOffset( d ) )
+        {
+            _cache_num_cell[d] = _global_grid->ownedNumCell( d );
+            _cache_offset[d] = _global_grid->globalOffset( d );
+            changed = true;
+        }
+    }
+    if ( changed )
+        clearIndexSpaceCache();
+}
+
+//---------------------------------------------------------------------------//
+// Cache the spaces of an entity type.
+template <class MeshType>
+template <class EntityType>
+void LocalGrid<MeshType>::precomputeEntityIndexSpaces( EntityType e ) const
+{
+    indexSpace( Own(), e, Local() );
+    indexSpace( Ghost(), e, Local() );
+    indexSpace( Own(), e, Global() );
+
+    // Loop over every neighbor offset except this block.
+    int num_offset = 1;
+    for ( std::size_t d = 0; d < num_space_dim; ++d )
+        num_offset *= 3;
+    for ( int n = 0; n < num_offset; ++n )
+    {
+        std::array<int, num_space_dim> off_ijk;
+        bool self = true;
+        for ( std::size_t d = 0, r = n; d < num_space_dim; ++d, r /= 3 )
+        {
+            off_ijk[d] = static_cast<int>( r % 3 ) - 1;
+            if ( off_ijk[d] != 0 )
+                self = false;
+        }
+        if ( self )
+            continue;
+
+        sharedIndexSpace( Own(), e, off_ijk );
+        sharedIndexSpace( Ghost(), e, off_ijk );
+        boundaryIndexSpace( Own(), e, off_ijk );
+        boundaryIndexSpace( Ghost(), e, off_ijk );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Cache the spaces of the 3D-only entity types.
+template <class MeshType>
+template <std::size_t NSD>
+std::enable_if_t<3 == NSD, void>
+LocalGrid<MeshType>::precomputeDimIndexSpaces() const
+{
+    precomputeEntityIndexSpaces( Face<Dim::K>() );
+    precomputeEntityIndexSpaces( Edge<Dim::I>() );
+    precomputeEntityIndexSpaces( Edge<Dim::J>() );
+    precomputeEntityIndexSpaces( Edge<Dim::K>() );
+}
+
+template <class MeshType>
+template <std::size_t NSD>
+std::enable_if_t<2 == NSD, void>
+LocalGrid<MeshType>::precomputeDimIndexSpaces() const
+{
+}
+
 //---------------------------------------------------------------------------//
 // Get the local index space of the owned cells.
 template <class MeshType>
@@ -21,6 +21,9 @@
 
 #include <Kokkos_Core.hpp>
 
+#include <algorithm>
+#include <cmath>
+
 namespace Cajita
 {
 //---------------------------------------------------------------------------//
@@ -494,6 +497,35 @@ class LocalMesh<Device, NonUniformMesh<Scalar, NumSpaceDim>>
 
             // Copy edges to the device.
             Kokkos::deep_copy( _local_edges[d], edge_mirror );
+
+            // Build the cell lookup table. The ghosted span of the edges is
+            // divided into uniform buckets as wide as the smallest cell and
+            // each bucket stores the cell containing its low end. A point
+            // is then located with a single table read followed by at most
+            // one step to the next cell.
+            Scalar min_dx = edge_mirror( 1 ) - edge_mirror( 0 );
+            for ( int n = 1; n < nedge - 1; ++n )
+                min_dx = std::min( min_dx,
+                                   edge_mirror( n + 1 ) - edge_mirror( n ) );
+            Scalar span = edge_mirror( nedge - 1 ) - edge_mirror( 0 );
+            int nbucket = static_cast<int>( std::ceil( span / min_dx ) );
+            nbucket = ( nbucket > 0 ) ? nbucket : 1;
+            _lookup_low[d] = edge_mirror( 0 );
+            _lookup_rdx[d] = nbucket / span;
+            _cell_lookup[d] = Kokkos::View<int*, Device>(
+                Kokkos::ViewAllocateWithoutInitializing( "cell_lookup" ),
+                nbucket );
+            auto lookup_mirror = Kokkos::create_mirror_view(
+                Kokkos::HostSpace(), _cell_lookup[d] );
+            int c = 0;
+            for ( int b = 0; b < nbucket; ++b )
+            {
+                Scalar x = _lookup_low[d] + b / _lookup_rdx[d];
+                while ( c + 2 < nedge && x >= edge_mirror( c + 1 ) )
+                    ++c;
+                lookup_mirror( b ) = c;
+            }
+            Kokkos::deep_copy( _cell_lookup[d], lookup_mirror );
         }
 
         // Periodicity
@@ -736,12 +768,54 @@ class LocalMesh<Device, NonUniformMesh<Scalar, NumSpaceDim>>
         return m;
     }
 
+    /*!
+      \brief Get the local index of the cell containing a coordinate.
+      \param dim Spatial dimension.
+      \param x Coordinate in the given dimension.
+
+      The cell is found with the precomputed lookup table in constant time.
+      Coordinates outside of the ghosted domain are assigned to the first or
+      last ghosted cell.
+    */
+    KOKKOS_INLINE_FUNCTION
+    int locateCell( const int dim, const Scalar x ) const
+    {
+        int nbucket = _cell_lookup[dim].extent( 0 );
+        Scalar b = ( x - _lookup_low[dim] ) * _lookup_rdx[dim];
+        b = ( b > 0.0 ) ? b : 0.0;
+        b = ( b < nbucket - 1 ) ? b : nbucket - 1;
+        int c = _cell_lookup[dim]( static_cast<int>( b ) );
+        int ncell = _local_edges[dim].extent( 0 ) - 1;
+        while ( c + 1 < ncell && x >= _local_edges[dim]( c + 1 ) )
+            ++c;
+        return c;
+    }
+
+    /*!
+      \brief Map a coordinate to the logical node index space.
+      \param dim Spatial dimension.
+      \param x Coordinate in the given dimension.
+      \param dx Width of the cell containing the coordinate.
+      \return Logical coordinate such that node n is at n and the coordinate
+      varies linearly within each cell.
+    */
+    KOKKOS_INLINE_FUNCTION
+    Scalar logicalCoordinate( const int dim, const Scalar x, Scalar& dx ) const
+    {
+        int c = locateCell( dim, x );
+        dx = _local_edges[dim]( c + 1 ) - _local_edges[dim]( c );
+        return c + ( x - _local_edges[dim]( c ) ) / dx;
+    }
+
   private:
     Kokkos::Array<Scalar, num_space_dim> _own_low_corner;
     Kokkos::Array<Scalar, num_space_dim> _own_high_corner;
     Kokkos::Array<Scalar, num_space_dim> _ghost_low_corner;
     Kokkos::Array<Scalar, num_space_dim> _ghost_high_corner;
     Kokkos::Array<Kokkos::View<Scalar*, Device>, num_space_dim> _local_edges;
+    Kokkos::Array<Kokkos::View<int*, Device>, num_space_dim> _cell_lookup;
+    Kokkos::Array<Scalar, num_space_dim> _lookup_low;
+    Kokkos::Array<Scalar, num_space_dim> _lookup_rdx;
     Kokkos::Array<bool, num_space_dim> _periodic;
     Kokkos::Array<bool, num_space_dim> _boundary_lo;
     Kokkos::Array<bool, num_space_dim> _boundary_hi;
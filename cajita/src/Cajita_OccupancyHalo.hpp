@@ -0,0 +1,707 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cajita_OccupancyHalo.hpp
+  \brief Grid scatter/gather of occupied tiles only
+*/
+#ifndef CAJITA_OCCUPANCYHALO_HPP
+#define CAJITA_OCCUPANCYHALO_HPP
+
+#include <Cajita_Array.hpp>
+#include <Cajita_Halo.hpp>
+#include <Cajita_IndexSpace.hpp>
+
+#include <impl/Cabana_Profiling.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace Cajita
+{
+//! \cond Impl
+namespace Impl
+{
+//---------------------------------------------------------------------------//
+// Tiling of an index space shared with a neighbor. The space is cut into
+// cubic tiles of entities holding all degrees of freedom of those entities.
+// Tiles are numbered in row-major order. Two dimensional spaces are padded
+// with a third dimension of extent one.
+struct OccupancyTiling
+{
+    Kokkos::Array<int, 3> min;
+    Kokkos::Array<int, 3> extent;
+    Kokkos::Array<int, 3> num_tile;
+    int tile_size;
+    int num_dof;
+
+    // Create an empty tiling.
+    OccupancyTiling()
+        : tile_size( 1 )
+        , num_dof( 0 )
+    {
+        for ( int d = 0; d < 3; ++d )
+        {
+            min[d] = 0;
+            extent[d] = 0;
+            num_tile[d] = 0;
+        }
+    }
+
+    // Tile a shared index space. The last dimension holds the degrees of
+    // freedom.
+    template <long N>
+    OccupancyTiling( const IndexSpace<N>& space, const int size )
+        : tile_size( size )
+        , num_dof( space.extent( N - 1 ) )
+    {
+        for ( int d = 0; d < 3; ++d )
+        {
+            min[d] = ( d < N - 1 ) ? space.min( d ) : 0;
+            extent[d] = ( d < N - 1 ) ? space.extent( d ) : 1;
+            num_tile[d] = ( extent[d] + tile_size - 1 ) / tile_size;
+        }
+    }
+
+    // Number of tiles.
+    KOKKOS_INLINE_FUNCTION
+    int size() const { return num_tile[0] * num_tile[1] * num_tile[2]; }
+
+    // Local index bounds of a tile. Tiles on the high side of the space are
+    // clipped to it.
+    KOKKOS_INLINE_FUNCTION
+    void tileBounds( const int tile, int lo[3], int te[3] ) const
+    {
+        int t[3];
+        t[2] = tile % num_tile[2];
+        t[1] = ( tile / num_tile[2] ) % num_tile[1];
+        t[0] = tile / ( num_tile[2] * num_tile[1] );
+        for ( int d = 0; d < 3; ++d )
+        {
+            lo[d] = min[d] + t[d] * tile_size;
+            te[d] = extent[d] - t[d] * tile_size;
+            if ( te[d] > tile_size )
+                te[d] = tile_size;
+        }
+    }
+
+    // Number of values in a tile.
+    KOKKOS_INLINE_FUNCTION
+    int tileNumValue( const int tile ) const
+    {
+        int lo[3];
+        int te[3];
+        tileBounds( tile, lo, te );
+        return te[0] * te[1] * te[2] * num_dof;
+    }
+
+    // Array indices of a value of a tile. Values are ordered by entity in
+    // row-major order with the degrees of freedom innermost.
+    KOKKOS_INLINE_FUNCTION
+    void valueIndex( const int lo[3], const int te[3], const int v,
+                     int ijkl[4] ) const
+    {
+        ijkl[3] = v % num_dof;
+        int e = v / num_dof;
+        ijkl[2] = lo[2] + e % te[2];
+        ijkl[1] = lo[1] + ( e / te[2] ) % te[1];
+        ijkl[0] = lo[0] + e / ( te[2] * te[1] );
+    }
+};
+
+//---------------------------------------------------------------------------//
+// Array element access of three and two dimensional arrays. The third index
+// is ignored by two dimensional arrays.
+template <class ArrayView>
+KOKKOS_INLINE_FUNCTION std::enable_if_t<
+    4 == ArrayView::rank, typename ArrayView::reference_type>
+occupancyArrayElement( const ArrayView& view, const int ijkl[4] )
+{
+    return view( ijkl[0], ijkl[1], ijkl[2], ijkl[3] );
+}
+
+template <class ArrayView>
+KOKKOS_INLINE_FUNCTION std::enable_if_t<
+    3 == ArrayView::rank, typename ArrayView::reference_type>
+occupancyArrayElement( const ArrayView& view, const int ijkl[4] )
+{
+    return view( ijkl[0], ijkl[1], ijkl[3] );
+}
+
+// Occupancy mask access of three and two dimensional masks.
+template <class MaskView>
+KOKKOS_INLINE_FUNCTION std::enable_if_t<3 == MaskView::rank, bool>
+isOccupied( const MaskView& mask, const int i, const int j, const int k )
+{
+    return 0 != mask( i, j, k );
+}
+
+template <class MaskView>
+KOKKOS_INLINE_FUNCTION std::enable_if_t<2 == MaskView::rank, bool>
+isOccupied( const MaskView& mask, const int i, const int j, const int )
+{
+    return 0 != mask( i, j );
+}
+
+//---------------------------------------------------------------------------//
+// Reduce a received value into the array.
+template <class T>
+KOKKOS_INLINE_FUNCTION void occupancyReduce( ScatterReduce::Sum,
+                                             const T& buffer_val,
+                                             T& array_val )
+{
+    array_val += buffer_val;
+}
+
+template <class T>
+KOKKOS_INLINE_FUNCTION void occupancyReduce( ScatterReduce::Min,
+                                             const T& buffer_val,
+                                             T& array_val )
+{
+    if ( buffer_val < array_val )
+        array_val = buffer_val;
+}
+
+template <class T>
+KOKKOS_INLINE_FUNCTION void occupancyReduce( ScatterReduce::Max,
+                                             const T& buffer_val,
+                                             T& array_val )
+{
+    if ( buffer_val > array_val )
+        array_val = buffer_val;
+}
+
+template <class T>
+KOKKOS_INLINE_FUNCTION void occupancyReduce( ScatterReduce::Replace,
+                                             const T& buffer_val,
+                                             T& array_val )
+{
+    array_val = buffer_val;
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Impl
+//! \endcond
+
+//---------------------------------------------------------------------------//
+// Occupancy halo
+//---------------------------------------------------------------------------//
+/*!
+  \brief Halo communication plan exchanging only occupied tiles of the shared
+  index spaces.
+
+  Particle-in-cell simulations often hold material in only a few of the
+  cells shared with neighboring blocks. The Halo always sends the full shared
+  index spaces. This halo instead cuts each shared index space into cubic
+  tiles of entities and only sends the tiles with an occupied entity
+  according to an occupancy mask given with each exchange, e.g. a particle
+  count per cell or the registered cells of a SparseMap. The occupied tiles
+  are described to the receiving rank by runs of consecutive tile ids so the
+  cost of an exchange scales with the material on the block boundary instead
+  of the boundary area.
+
+  Entities of tiles that are not sent are left unchanged by the exchange.
+  After a gather the ghosts of unoccupied tiles therefore keep their
+  previous values and after a scatter the owned entities of unoccupied
+  tiles do not receive contributions.
+
+  The messages change size with the occupancy so unlike the Halo the buffers
+  are sized and the messages posted for each exchange. The halo is built for
+  a single array and may be used with any array of the same layout.
+*/
+template <class MemorySpace>
+class OccupancyHalo
+{
+  public:
+    //! Memory space.
+    using memory_space = MemorySpace;
+
+    /*!
+      \brief Constructor.
+      \param pattern The halo pattern to use for halo communication.
+      \param width Halo cell width. Must be less than or equal to the halo
+      width of the block. If the pattern gives a width for each neighbor these
+      are used instead, limited to this width.
+      \param tile_size The number of entities along each dimension of a tile.
+      \param array The array to build the halo for.
+    */
+    template <class Pattern, class ArrayType>
+    OccupancyHalo( const Pattern& pattern, const int width,
+                   const int tile_size, const ArrayType& array )
+        : _tile_size( tile_size )
+        , _num_tile( 0 )
+        , _num_sent_tile( 0 )
+    {
+        static_assert( is_array<ArrayType>::value, "Cajita::Array required" );
+        if ( tile_size < 1 )
+            throw std::runtime_error( "Tile size must be positive" );
+
+        // Spatial dimension.
+        const std::size_t num_space_dim = Pattern::num_space_dim;
+
+        // Get the MPI communicator.
+        MPI_Comm_dup( array.layout()->localGrid()->globalGrid().comm(),
+                      &_comm );
+
+        // Get the local grid.
+        auto local_grid = array.layout()->localGrid();
+
+        // Function to get the local id of the neighbor.
+        auto neighbor_id = []( const std::array<int, num_space_dim>& ijk ) {
+            int id = ijk[0];
+            for ( std::size_t d = 1; d < num_space_dim; ++d )
+                id += num_space_dim * id + ijk[d];
+            return id;
+        };
+
+        // Neighbor id flip function.
+        auto flip_id = [=]( const std::array<int, num_space_dim>& ijk ) {
+            std::array<int, num_space_dim> flip_ijk;
+            for ( std::size_t d = 0; d < num_space_dim; ++d )
+                flip_ijk[d] = -ijk[d];
+            return flip_ijk;
+        };
+
+        // Get the ghost width needed from each neighbor in the pattern.
+        auto neighbors = pattern.getNeighbors();
+        auto widths = pattern.getWidths();
+        auto ghost_width = [&]( const std::array<int, num_space_dim>& ijk ) {
+            auto found = std::find( neighbors.begin(), neighbors.end(), ijk );
+            if ( found == neighbors.end() )
+                return 0;
+            if ( widths.empty() )
+                return width;
+            int w = widths[std::distance( neighbors.begin(), found )];
+            return ( -1 == width ) ? w : std::min( w, width );
+        };
+
+        // We send owned data to the neighbors opposite of the directions in
+        // the pattern so add those to the exchange.
+        auto exchange = neighbors;
+        for ( const auto& n : neighbors )
+            if ( std::find( exchange.begin(), exchange.end(), flip_id( n ) ) ==
+                 exchange.end() )
+                exchange.push_back( flip_id( n ) );
+
+        // Tile the spaces shared with each valid neighbor.
+        for ( const auto& n : exchange )
+        {
+            int rank = local_grid->neighborRank( n );
+            if ( rank >= 0 )
+            {
+                _neighbor_ranks.push_back( rank );
+                _send_tags.push_back( neighbor_id( n ) );
+                _receive_tags.push_back( neighbor_id( flip_id( n ) ) );
+                _owned_tilings.push_back(
+                    createTiling( Own(), ghost_width( flip_id( n ) ), n,
+                                  array ) );
+                _ghosted_tilings.push_back(
+                    createTiling( Ghost(), ghost_width( n ), n, array ) );
+            }
+        }
+        _send_buffers.resize( _neighbor_ranks.size() );
+        _receive_buffers.resize( _neighbor_ranks.size() );
+    }
+
+    // Destructor.
+    ~OccupancyHalo() { MPI_Comm_free( &_comm ); }
+
+    //! Get the number of entities along each dimension of a tile.
+    int tileSize() const { return _tile_size; }
+
+    //! Get the number of tiles this rank could have sent in the last
+    //! exchange.
+    std::size_t numTiles() const { return _num_tile; }
+
+    //! Get the number of occupied tiles this rank sent in the last exchange.
+    std::size_t numSentTiles() const { return _num_sent_tile; }
+
+    /*!
+      \brief Gather data into our ghosts from their owners. Only the tiles of
+      owned entities which are occupied are sent.
+
+      \param exec_space The execution space to use for pack/unpack.
+
+      \param array The array to gather.
+
+      \param mask The occupancy mask over the local entities of the array.
+      An entity is occupied if its mask value is nonzero. Only the owned
+      entities of the mask are used.
+    */
+    template <class ExecutionSpace, class ArrayType, class MaskView>
+    void gather( const ExecutionSpace& exec_space, const ArrayType& array,
+                 const MaskView& mask ) const
+    {
+        Cabana::Impl::ScopedProfileRegion region(
+            "Cajita::OccupancyHalo::gather" );
+        exchange( exec_space, ScatterReduce::Replace(), array.view(), mask,
+                  _owned_tilings, _ghosted_tilings, 3456 );
+    }
+
+    /*!
+      \brief Scatter data from our ghosts to their owners using the given
+      type of reduce operation. Only the tiles of ghosted entities which are
+      occupied are sent.
+
+      \param exec_space The execution space to use for pack/unpack.
+
+      \param reduce_op The functor used to reduce the results.
+
+      \param array The array to scatter.
+
+      \param mask The occupancy mask over the local entities of the array.
+      An entity is occupied if its mask value is nonzero. Only the ghosted
+      entities of the mask are used.
+    */
+    template <class ExecutionSpace, class ReduceOp, class ArrayType,
+              class MaskView>
+    void scatter( const ExecutionSpace& exec_space, const ReduceOp& reduce_op,
+                  const ArrayType& array, const MaskView& mask ) const
+    {
+        Cabana::Impl::ScopedProfileRegion region(
+            "Cajita::OccupancyHalo::scatter" );
+        exchange( exec_space, reduce_op, array.view(), mask, _ghosted_tilings,
+                  _owned_tilings, 5678 );
+    }
+
+  private:
+    // Tile the index space shared with a neighbor.
+    template <class DecompositionTag, std::size_t NumSpaceDim,
+              class ArrayType>
+    Impl::OccupancyTiling
+    createTiling( DecompositionTag decomposition_tag, const int width,
+                  const std::array<int, NumSpaceDim>& nid,
+                  const ArrayType& array ) const
+    {
+        // No data is shared with this neighbor if the width is zero.
+        if ( 0 == width )
+            return Impl::OccupancyTiling();
+        return Impl::OccupancyTiling(
+            array.layout()->sharedIndexSpace( decomposition_tag, nid, width ),
+            _tile_size );
+    }
+
+    // Copy a list of tiles to the device along with the offset of each tile
+    // in the message. Returns the number of values in the message.
+    int createSteering( const Impl::OccupancyTiling& tiling,
+                        const std::vector<int>& tiles,
+                        Kokkos::View<int*, memory_space>& tile_ids,
+                        Kokkos::View<int*, memory_space>& offsets ) const
+    {
+        int num_tile = tiles.size();
+        Kokkos::View<int*, Kokkos::HostSpace> host_ids(
+            Kokkos::ViewAllocateWithoutInitializing( "tile_ids" ), num_tile );
+        Kokkos::View<int*, Kokkos::HostSpace> host_offsets(
+            Kokkos::ViewAllocateWithoutInitializing( "tile_offsets" ),
+            num_tile + 1 );
+        host_offsets( 0 ) = 0;
+        for ( int t = 0; t < num_tile; ++t )
+        {
+            host_ids( t ) = tiles[t];
+            host_offsets( t + 1 ) =
+                host_offsets( t ) + tiling.tileNumValue( tiles[t] );
+        }
+        tile_ids = Kokkos::create_mirror_view_and_copy( memory_space(),
+                                                        host_ids );
+        offsets = Kokkos::create_mirror_view_and_copy( memory_space(),
+                                                       host_offsets );
+        return host_offsets( num_tile );
+    }
+
+    // Get a message buffer of the given number of values. Buffers are kept
+    // between exchanges and only grown.
+    template <class T>
+    Kokkos::View<T*, memory_space, Kokkos::MemoryUnmanaged>
+    messageBuffer( Kokkos::View<char*, memory_space>& buffer,
+                   const int num_value ) const
+    {
+        std::size_t num_bytes = num_value * sizeof( T );
+        if ( buffer.extent( 0 ) < num_bytes )
+            buffer = Kokkos::View<char*, memory_space>(
+                Kokkos::ViewAllocateWithoutInitializing(
+                    "occupancy_halo_buffer" ),
+                num_bytes );
+        return Kokkos::View<T*, memory_space, Kokkos::MemoryUnmanaged>(
+            reinterpret_cast<T*>( buffer.data() ), num_value );
+    }
+
+    // Exchange the occupied tiles of the send spaces with the neighbors and
+    // reduce them into the receive spaces.
+    template <class ExecutionSpace, class ReduceOp, class ArrayView,
+              class MaskView>
+    void exchange( const ExecutionSpace& exec_space, const ReduceOp& reduce_op,
+                   const ArrayView& array_view, const MaskView& mask,
+                   const std::vector<Impl::OccupancyTiling>& send_tilings,
+                   const std::vector<Impl::OccupancyTiling>& recv_tilings,
+                   const int mpi_tag ) const
+    {
+        static_assert( MaskView::rank + 1 == ArrayView::rank,
+                       "Occupancy mask must have one index per dimension" );
+        using value_type = typename ArrayView::non_const_value_type;
+
+        _num_tile = 0;
+        _num_sent_tile = 0;
+
+        // Get the number of neighbors. Return if we have none.
+        int num_n = _neighbor_ranks.size();
+        if ( 0 == num_n )
+            return;
+
+        // Flag the occupied tiles of the spaces we send.
+        std::vector<Kokkos::View<int*, memory_space>> flags( num_n );
+        for ( int n = 0; n < num_n; ++n )
+        {
+            auto tiling = send_tilings[n];
+            auto tile_flags = Kokkos::View<int*, memory_space>(
+                Kokkos::ViewAllocateWithoutInitializing( "occupancy_flags" ),
+                tiling.size() );
+            Kokkos::parallel_for(
+                "Cajita::OccupancyHalo::flag",
+                Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                                     tiling.size() ),
+                KOKKOS_LAMBDA( const int t ) {
+                    int lo[3];
+                    int te[3];
+                    tiling.tileBounds( t, lo, te );
+                    int occupied = 0;
+                    for ( int i = lo[0]; i < lo[0] + te[0]; ++i )
+                        for ( int j = lo[1]; j < lo[1] + te[1]; ++j )
+                            for ( int k = lo[2]; k < lo[2] + te[2]; ++k )
+                                if ( Impl::isOccupied( mask, i, j, k ) )
+                                    occupied = 1;
+                    tile_flags( t ) = occupied;
+                } );
+            flags[n] = tile_flags;
+            _num_tile += tiling.size();
+        }
+        exec_space.fence();
+
+        // Compress the occupied tiles into runs of consecutive tiles given
+        // as pairs of the first tile and the number of tiles.
+        std::vector<std::vector<int>> send_tiles( num_n );
+        std::vector<std::vector<int>> send_runs( num_n );
+        for ( int n = 0; n < num_n; ++n )
+        {
+            auto host_flags = Kokkos::create_mirror_view_and_copy(
+                Kokkos::HostSpace(), flags[n] );
+            auto& runs = send_runs[n];
+            for ( std::size_t t = 0; t < host_flags.extent( 0 ); ++t )
+            {
+                if ( !host_flags( t ) )
+                    continue;
+                int tile = t;
+                send_tiles[n].push_back( tile );
+                if ( !runs.empty() &&
+                     runs[runs.size() - 2] + runs.back() == tile )
+                    ++runs.back();
+                else
+                {
+                    runs.push_back( tile );
+                    runs.push_back( 1 );
+                }
+            }
+            _num_sent_tile += send_tiles[n].size();
+        }
+
+        // Exchange the runs.
+        std::vector<MPI_Request> requests( num_n );
+        for ( int n = 0; n < num_n; ++n )
+            MPI_Isend( send_runs[n].data(), send_runs[n].size(), MPI_INT,
+                       _neighbor_ranks[n], mpi_tag + _send_tags[n], _comm,
+                       &requests[n] );
+        std::vector<std::vector<int>> recv_tiles( num_n );
+        for ( int n = 0; n < num_n; ++n )
+        {
+            MPI_Status status;
+            MPI_Probe( _neighbor_ranks[n], mpi_tag + _receive_tags[n], _comm,
+                       &status );
+            int num_run_value = 0;
+            MPI_Get_count( &status, MPI_INT, &num_run_value );
+            std::vector<int> runs( num_run_value );
+            MPI_Recv( runs.data(), num_run_value, MPI_INT, _neighbor_ranks[n],
+                      mpi_tag + _receive_tags[n], _comm, MPI_STATUS_IGNORE );
+            for ( int r = 0; r < num_run_value; r += 2 )
+                for ( int t = runs[r]; t < runs[r] + runs[r + 1]; ++t )
+                    recv_tiles[n].push_back( t );
+        }
+        MPI_Waitall( num_n, requests.data(), MPI_STATUSES_IGNORE );
+
+        // Post receives of the occupied tiles.
+        const int data_tag = mpi_tag + 1000;
+        std::vector<MPI_Request> recv_requests( num_n, MPI_REQUEST_NULL );
+        std::vector<Kokkos::View<int*, memory_space>> recv_ids( num_n );
+        std::vector<Kokkos::View<int*, memory_space>> recv_offsets( num_n );
+        std::vector<Kokkos::View<value_type*, memory_space,
+                                 Kokkos::MemoryUnmanaged>>
+            recv_values( num_n );
+        for ( int n = 0; n < num_n; ++n )
+        {
+            int num_value = createSteering( recv_tilings[n], recv_tiles[n],
+                                            recv_ids[n], recv_offsets[n] );
+            if ( 0 == num_value )
+                continue;
+            recv_values[n] =
+                messageBuffer<value_type>( _receive_buffers[n], num_value );
+            MPI_Irecv( recv_values[n].data(), num_value * sizeof( value_type ),
+                       MPI_BYTE, _neighbor_ranks[n],
+                       data_tag + _receive_tags[n], _comm, &recv_requests[n] );
+        }
+
+        // Pack and send the occupied tiles.
+        using team_policy = Kokkos::TeamPolicy<ExecutionSpace>;
+        using team_member = typename team_policy::member_type;
+        std::vector<MPI_Request> send_requests( num_n, MPI_REQUEST_NULL );
+        std::vector<int> num_send_value( num_n );
+        std::vector<Kokkos::View<value_type*, memory_space,
+                                 Kokkos::MemoryUnmanaged>>
+            send_values( num_n );
+        for ( int n = 0; n < num_n; ++n )
+        {
+            Kokkos::View<int*, memory_space> tile_ids;
+            Kokkos::View<int*, memory_space> offsets;
+            num_send_value[n] = createSteering( send_tilings[n], send_tiles[n],
+                                                tile_ids, offsets );
+            if ( 0 == num_send_value[n] )
+                continue;
+            auto tiling = send_tilings[n];
+            auto buffer = messageBuffer<value_type>( _send_buffers[n],
+                                                     num_send_value[n] );
+            Kokkos::parallel_for(
+                "Cajita::OccupancyHalo::pack",
+                team_policy( exec_space, send_tiles[n].size(), Kokkos::AUTO ),
+                KOKKOS_LAMBDA( const team_member& team ) {
+                    int lo[3];
+                    int te[3];
+                    tiling.tileBounds( tile_ids( team.league_rank() ), lo,
+                                       te );
+                    int offset = offsets( team.league_rank() );
+                    int num_value = offsets( team.league_rank() + 1 ) - offset;
+                    Kokkos::parallel_for(
+                        Kokkos::TeamThreadRange( team, num_value ),
+                        [&]( const int v ) {
+                            int ijkl[4];
+                            tiling.valueIndex( lo, te, v, ijkl );
+                            buffer( offset + v ) =
+                                Impl::occupancyArrayElement( array_view,
+                                                             ijkl );
+                        } );
+                } );
+            send_values[n] = buffer;
+        }
+        exec_space.fence();
+        for ( int n = 0; n < num_n; ++n )
+            if ( 0 < num_send_value[n] )
+                MPI_Isend( send_values[n].data(),
+                           num_send_value[n] * sizeof( value_type ), MPI_BYTE,
+                           _neighbor_ranks[n], data_tag + _send_tags[n],
+                           _comm, &send_requests[n] );
+
+        // Unpack the tiles as they arrive.
+        for ( int i = 0; i < num_n; ++i )
+        {
+            int n = MPI_UNDEFINED;
+            MPI_Waitany( num_n, recv_requests.data(), &n, MPI_STATUS_IGNORE );
+            if ( MPI_UNDEFINED == n )
+                break;
+            auto tiling = recv_tilings[n];
+            auto tile_ids = recv_ids[n];
+            auto offsets = recv_offsets[n];
+            auto buffer = recv_values[n];
+            Kokkos::parallel_for(
+                "Cajita::OccupancyHalo::unpack",
+                team_policy( exec_space, tile_ids.extent( 0 ), Kokkos::AUTO ),
+                KOKKOS_LAMBDA( const team_member& team ) {
+                    int lo[3];
+                    int te[3];
+                    tiling.tileBounds( tile_ids( team.league_rank() ), lo,
+                                       te );
+                    int offset = offsets( team.league_rank() );
+                    int num_value = offsets( team.league_rank() + 1 ) - offset;
+                    Kokkos::parallel_for(
+                        Kokkos::TeamThreadRange( team, num_value ),
+                        [&]( const int v ) {
+                            int ijkl[4];
+                            tiling.valueIndex( lo, te, v, ijkl );
+                            Impl::occupancyReduce(
+                                reduce_op, buffer( offset + v ),
+                                Impl::occupancyArrayElement( array_view,
+                                                             ijkl ) );
+                        } );
+                } );
+        }
+        exec_space.fence();
+
+        // Wait on the sends before the buffers are reused.
+        MPI_Waitall( num_n, send_requests.data(), MPI_STATUSES_IGNORE );
+    }
+
+  private:
+    // MPI communicator.
+    MPI_Comm _comm;
+
+    // Number of entities along each dimension of a tile.
+    int _tile_size;
+
+    // The ranks we will send/receive from.
+    std::vector<int> _neighbor_ranks;
+
+    // The tag we use for sending to each neighbor.
+    std::vector<int> _send_tags;
+
+    // The tag we use for receiveing from each neighbor.
+    std::vector<int> _receive_tags;
+
+    // For each neighbor, tiling of the owned entities we share.
+    std::vector<Impl::OccupancyTiling> _owned_tilings;
+
+    // For each neighbor, tiling of the ghosted entities we share.
+    std::vector<Impl::OccupancyTiling> _ghosted_tilings;
+
+    // For each neighbor, message buffers grown as needed by the exchanges.
+    mutable std::vector<Kokkos::View<char*, memory_space>> _send_buffers;
+    mutable std::vector<Kokkos::View<char*, memory_space>> _receive_buffers;
+
+    // Tile counts of the last exchange.
+    mutable std::size_t _num_tile;
+    mutable std::size_t _num_sent_tile;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Occupancy halo creation function.
+  \param pattern The pattern to build the halo from.
+  \param width Must be less than or equal to the width of the array halo.
+  \param tile_size The number of entities along each dimension of a tile.
+  \param array The array over which to build the halo.
+*/
+template <class Pattern, class ArrayType>
+auto createOccupancyHalo( const Pattern& pattern, const int width,
+                          const int tile_size, const ArrayType& array )
+{
+    using memory_space = typename ArrayType::memory_space;
+    return std::make_shared<OccupancyHalo<memory_space>>( pattern, width,
+                                                          tile_size, array );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cajita
+
+#endif // end CAJITA_OCCUPANCYHALO_HPP
@@ -0,0 +1,560 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cajita_PPPMSolver.hpp
+  \brief Particle-particle particle-mesh (P3M) long-range electrostatics
+*/
+#ifndef CAJITA_PPPMSOLVER_HPP
+#define CAJITA_PPPMSOLVER_HPP
+
+#include <Cajita_Array.hpp>
+#include <Cajita_FastFourierTransform.hpp>
+#include <Cajita_Halo.hpp>
+#include <Cajita_IndexSpace.hpp>
+#include <Cajita_Interpolation.hpp>
+#include <Cajita_LocalGrid.hpp>
+#include <Cajita_Splines.hpp>
+#include <Cajita_Types.hpp>
+
+#include <Cabana_NeighborList.hpp>
+#include <Cabana_Parallel.hpp>
+#include <impl/Cabana_Profiling.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+
+namespace Cajita
+{
+namespace Experimental
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief Grid-to-point functor evaluating the potential and the electric
+  field (the negative potential gradient) in a single pass over the stencil.
+*/
+template <class PotentialViewType, class FieldViewType>
+struct PPPMPotentialFieldG2P
+{
+    //! Scalar value type.
+    using value_type = typename PotentialViewType::value_type;
+
+    //! Point potentials.
+    PotentialViewType _potential;
+    //! Point fields.
+    FieldViewType _field;
+
+    //! Apply spline interpolation.
+    template <class SplineDataType, class GridViewType>
+    KOKKOS_INLINE_FUNCTION void operator()( const SplineDataType& sd,
+                                            const int p,
+                                            const GridViewType& view ) const
+    {
+        value_type phi;
+        value_type grad[3];
+        G2P::value( view, sd, phi );
+        G2P::gradient( view, sd, grad );
+        _potential( p ) += phi;
+        for ( int d = 0; d < 3; ++d )
+            _field( p, d ) -= grad[d];
+    }
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Particle-particle particle-mesh (P3M) solver for the long-range part
+  of the Coulomb interaction in a periodic 3D domain.
+
+  The Coulomb potential is split with the Ewald splitting parameter alpha
+  into a short-range part, erfc(alpha r)/r, computed over particle pairs
+  within a cutoff (see computeRealSpace()), and a smooth long-range part
+  computed on the mesh:
+
+  1. The charges are assigned to the mesh nodes with B-splines.
+  2. The charge density is transformed with a real-to-complex FFT.
+  3. The half spectrum is multiplied by the influence function.
+  4. The potential is transformed back to the mesh.
+  5. The potential and its analytic gradient are interpolated to the
+     particles with the assignment splines.
+
+  The influence function is the optimal one of Hockney and Eastwood for
+  analytic differentiation, including the aliasing sums over the reciprocal
+  lattice, such that assignment and interpolation errors are minimized for
+  the chosen order. It depends only on the mesh, the splitting parameter,
+  and the assignment order and is computed once at construction and cached.
+
+  The spline weights of each particle are evaluated once per solve, as in
+  smooth particle mesh Ewald, and used for both assignment and
+  interpolation. The charges may also be spread by bins of particles into
+  scratch tiles of mesh nodes (see the binned compute()).
+
+  The charge assignment order is a template parameter such that the
+  assignment and interpolation stencil loops are unrolled. Higher orders
+  allow coarser meshes for the same accuracy at the cost of wider stencils.
+  The local grid halo must be at least SplineOrder / 2 + 1 cells wide.
+
+  Potentials, fields, and energies are in Gaussian units. Multiply them by
+  the Coulomb constant of the unit system in use. The system is assumed to
+  be charge neutral with tin-foil boundary conditions.
+
+  \tparam Scalar The mesh and charge scalar type.
+  \tparam DeviceType The device type.
+  \tparam SplineOrder The B-spline order. The charge of a particle is
+  assigned to SplineOrder + 1 mesh nodes in each dimension.
+*/
+template <class Scalar, class DeviceType, int SplineOrder = 3>
+class PPPMSolver
+{
+  public:
+    //! Scalar value type.
+    using value_type = Scalar;
+    //! Kokkos device type.
+    using device_type = DeviceType;
+    //! Kokkos execution space.
+    using execution_space = typename DeviceType::execution_space;
+    //! Kokkos memory space.
+    using memory_space = typename DeviceType::memory_space;
+    //! Mesh type.
+    using mesh_type = UniformMesh<Scalar, 3>;
+    //! Assignment spline type.
+    using spline_type = Spline<SplineOrder>;
+    //! Number of mesh nodes a charge is assigned to in each dimension.
+    static constexpr int assignment_order = SplineOrder + 1;
+
+    /*!
+      \brief Constructor.
+      \param local_grid The local grid of a mesh periodic in all dimensions.
+      \param alpha The Ewald splitting parameter.
+      \param aliasing_width The number of reciprocal lattice images included
+      in each direction of the influence function aliasing sums.
+    */
+    PPPMSolver( const std::shared_ptr<LocalGrid<mesh_type>>& local_grid,
+                const Scalar alpha, const int aliasing_width = 2 )
+        : _alpha( alpha )
+        , _aliasing_width( aliasing_width )
+        , _spline_cache( "pppm_spline_cache" )
+    {
+        const auto& global_grid = local_grid->globalGrid();
+        for ( int d = 0; d < 3; ++d )
+        {
+            if ( !global_grid.isPeriodic( d ) )
+                throw std::logic_error(
+                    "PPPM requires a mesh periodic in all dimensions" );
+            _num_node[d] = global_grid.globalNumEntity( Node(), d );
+            _cell_size[d] = global_grid.globalMesh().cellSize( d );
+        }
+        if ( local_grid->haloCellWidth() < SplineOrder / 2 + 1 )
+            throw std::logic_error(
+                "PPPM requires a halo of at least SplineOrder / 2 + 1 cells" );
+
+        auto layout = createArrayLayout( local_grid, 1, Node() );
+        _grid = createArray<Scalar, DeviceType>( "pppm_grid", layout );
+        _halo = createHalo( *_grid, FullHaloPattern() );
+        _fft = createHeffteRealFastFourierTransform<Scalar, DeviceType>(
+            *layout );
+
+        auto spectral_space = _fft->spectralIndexSpace();
+        _influence = Kokkos::View<Scalar***, Kokkos::LayoutRight, DeviceType>(
+            Kokkos::ViewAllocateWithoutInitializing( "pppm_influence" ),
+            spectral_space.extent( Dim::I ), spectral_space.extent( Dim::J ),
+            spectral_space.extent( Dim::K ) );
+        computeInfluenceFunction();
+    }
+
+    //! Get the Ewald splitting parameter.
+    Scalar splittingParameter() const { return _alpha; }
+
+    /*!
+      \brief Set the Ewald splitting parameter. The cached influence function
+      is recomputed.
+    */
+    void setSplittingParameter( const Scalar alpha )
+    {
+        _alpha = alpha;
+        computeInfluenceFunction();
+    }
+
+    /*!
+      \brief Get the mesh potential of the last solve including ghosts.
+    */
+    std::shared_ptr<Array<Scalar, Node, mesh_type, DeviceType>> grid() const
+    {
+        return _grid;
+    }
+
+    /*!
+      \brief Compute the long-range potential and field at the particles.
+
+      \param positions The particle positions, indexed as (particle,dim). All
+      particles must be within the owned domain of this rank.
+
+      \param charges The particle charges.
+
+      \param num_point The number of particles.
+
+      \param potential The long-range potential at each particle is added to
+      this view.
+
+      \param field The long-range electric field at each particle is added to
+      this view, indexed as (particle,dim). The force on a particle is its
+      charge times the field.
+
+      \return The long-range energy of all particles on all ranks, excluding
+      the self energy (see selfEnergy()).
+    */
+    template <class PositionSlice, class ChargeSlice, class PotentialView,
+              class FieldView>
+    Scalar compute( const PositionSlice& positions, const ChargeSlice& charges,
+                    const std::size_t num_point,
+                    const PotentialView& potential, const FieldView& field )
+    {
+        Cabana::Impl::ScopedProfileRegion region( "Cajita::PPPMSolver" );
+
+        // Assign the charge density to the mesh.
+        evaluateSplineCache( *_grid, positions, num_point, spline_type(),
+                             _spline_cache );
+        ArrayOp::assign( *_grid, 0.0, Ghost() );
+        p2g( createScalarValueP2G( charges, inverseCellVolume() ),
+             _spline_cache, spline_type(), *_halo, *_grid );
+
+        return solve( potential, field );
+    }
+
+    /*!
+      \brief Compute the long-range potential and field at binned particles.
+
+      \param positions The particle positions, indexed as (particle,dim). All
+      particles must be within the owned domain of this rank.
+
+      \param charges The particle charges.
+
+      \param num_point The number of particles.
+
+      \param bins The binning of the particles, e.g. from a
+      Cabana::LinkedCellList with cells aligned to the cells of the local
+      grid.
+
+      \param potential The long-range potential at each particle is added to
+      this view.
+
+      \param field The long-range electric field at each particle is added to
+      this view, indexed as (particle,dim).
+
+      \param sorted True if the particles are sorted by the binning.
+
+      \param bin_cells The number of grid cells covered by a bin in each
+      dimension.
+
+      \return The long-range energy of all particles on all ranks, excluding
+      the self energy (see selfEnergy()).
+
+      The charges of each bin are spread by one thread team into a scratch
+      tile of the mesh nodes around the bin, which is added to the mesh once,
+      rather than with one atomic add per particle and stencil node. This is
+      faster for the wide stencils of high assignment orders when the
+      particles are dense.
+    */
+    template <class PositionSlice, class ChargeSlice, class BinningDataType,
+              class PotentialView, class FieldView>
+    Scalar compute( const PositionSlice& positions, const ChargeSlice& charges,
+                    const std::size_t num_point, const BinningDataType& bins,
+                    const PotentialView& potential, const FieldView& field,
+                    const bool sorted = true, const int bin_cells = 1 )
+    {
+        Cabana::Impl::ScopedProfileRegion region( "Cajita::PPPMSolver" );
+
+        // Assign the charge density to the mesh.
+        evaluateSplineCache( *_grid, positions, num_point, spline_type(),
+                             _spline_cache );
+        ArrayOp::assign( *_grid, 0.0, Ghost() );
+        p2g( createScalarValueP2G( charges, inverseCellVolume() ),
+             _spline_cache, bins, spline_type(), *_halo, *_grid, sorted,
+             bin_cells );
+
+        return solve( potential, field );
+    }
+
+    /*!
+      \brief Get the self energy of the particles, to be added to the sum of
+      the long-range and short-range energies.
+      \param sum_charge_squared The sum of the squared charges of all
+      particles.
+    */
+    Scalar selfEnergy( const Scalar sum_charge_squared ) const
+    {
+        return -_alpha / std::sqrt( M_PI ) * sum_charge_squared;
+    }
+
+  private:
+    // Get the inverse volume of a mesh cell.
+    Scalar inverseCellVolume() const
+    {
+        return 1.0 / ( _cell_size[0] * _cell_size[1] * _cell_size[2] );
+    }
+
+    // Solve for the potential from the charge density on the mesh and
+    // interpolate the potential and field to the cached particles.
+    template <class PotentialView, class FieldView>
+    Scalar solve( const PotentialView& potential, const FieldView& field )
+    {
+        // Solve for the potential in the half spectrum.
+        _fft->forward( *_grid, FFTScaleNone() );
+        Scalar energy = applyInfluenceFunction();
+        _fft->reverse( *_grid, FFTScaleFull() );
+
+        // Interpolate the potential and field to the particles.
+        PPPMPotentialFieldG2P<PotentialView, FieldView> g2p_func{ potential,
+                                                                  field };
+        g2p( *_grid, *_halo, _spline_cache, spline_type(), g2p_func );
+
+        return energy;
+    }
+
+    // Compute the optimal influence function for analytic differentiation
+    // on the half spectrum owned by this rank.
+    void computeInfluenceFunction()
+    {
+        auto spectral_space = _fft->spectralIndexSpace();
+        auto influence = _influence;
+        const Scalar alpha = _alpha;
+        const int m_max = _aliasing_width;
+        const Kokkos::Array<int, 3> num_node = { _num_node[0], _num_node[1],
+                                                 _num_node[2] };
+        const Kokkos::Array<Scalar, 3> h = { _cell_size[0], _cell_size[1],
+                                             _cell_size[2] };
+        Kokkos::parallel_for(
+            "Cajita::PPPMSolver::influence",
+            createExecutionPolicy( spectral_space, execution_space() ),
+            KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+                const Scalar two_pi = 2.0 * M_PI;
+                const int n[3] = { i, j, k };
+                Scalar k0[3];
+                bool zero_mode = true;
+                for ( int d = 0; d < 3; ++d )
+                {
+                    int nd = ( 2 * n[d] > num_node[d] ) ? n[d] - num_node[d]
+                                                         : n[d];
+                    zero_mode = zero_mode && ( 0 == nd );
+                    k0[d] = two_pi * nd / ( num_node[d] * h[d] );
+                }
+
+                // G(k) = sum_m U^2(k_m) k_m^2 R(k_m) /
+                //        ( sum_m U^2(k_m) * sum_m U^2(k_m) k_m^2 )
+                // with R(k) = 4 pi exp(-k^2/(4 alpha^2)) / k^2.
+                Scalar numerator = 0.0;
+                Scalar sum_u2 = 0.0;
+                Scalar sum_k2_u2 = 0.0;
+                for ( int mi = -m_max; mi <= m_max; ++mi )
+                    for ( int mj = -m_max; mj <= m_max; ++mj )
+                        for ( int mk = -m_max; mk <= m_max; ++mk )
+                        {
+                            const int m[3] = { mi, mj, mk };
+                            Scalar u2 = 1.0;
+                            Scalar k2 = 0.0;
+                            for ( int d = 0; d < 3; ++d )
+                            {
+                                Scalar km = k0[d] + two_pi * m[d] / h[d];
+                                Scalar x = 0.5 * km * h[d];
+                                Scalar s = ( 0.0 == x ) ? 1.0 : sin( x ) / x;
+                                for ( int o = 0; o < assignment_order; ++o )
+                                    u2 *= s * s;
+                                k2 += km * km;
+                            }
+                            sum_u2 += u2;
+                            sum_k2_u2 += k2 * u2;
+                            numerator += u2 * 4.0 * M_PI *
+                                         exp( -k2 / ( 4.0 * alpha * alpha ) );
+                        }
+
+                influence( i - spectral_space.min( Dim::I ),
+                           j - spectral_space.min( Dim::J ),
+                           k - spectral_space.min( Dim::K ) ) =
+                    ( zero_mode || 0.0 == sum_u2 * sum_k2_u2 )
+                        ? 0.0
+                        : numerator / ( sum_u2 * sum_k2_u2 );
+            } );
+    }
+
+    // Multiply the half spectrum of the charge density by the influence
+    // function and return the energy of all ranks.
+    Scalar applyInfluenceFunction()
+    {
+        auto spectral_space = _fft->spectralIndexSpace();
+        auto spectral = _fft->spectralView();
+        auto influence = _influence;
+        const int num_k = _num_node[2];
+
+        // Modes in the interior of the half spectrum stand for their
+        // conjugates as well.
+        Scalar local_energy = 0.0;
+        Kokkos::parallel_reduce(
+            "Cajita::PPPMSolver::apply_influence",
+            createExecutionPolicy( spectral_space, execution_space() ),
+            KOKKOS_LAMBDA( const int i, const int j, const int k,
+                           Scalar& result ) {
+                const int li = i - spectral_space.min( Dim::I );
+                const int lj = j - spectral_space.min( Dim::J );
+                const int lk = k - spectral_space.min( Dim::K );
+                const Scalar g = influence( li, lj, lk );
+                const Scalar re = spectral( li, lj, lk, 0 );
+                const Scalar im = spectral( li, lj, lk, 1 );
+                const Scalar weight = ( 0 == k || 2 * k == num_k ) ? 1.0 : 2.0;
+                result += weight * g * ( re * re + im * im );
+                spectral( li, lj, lk, 0 ) = g * re;
+                spectral( li, lj, lk, 1 ) = g * im;
+            },
+            local_energy );
+
+        Scalar energy = 0.0;
+        MPI_Allreduce( &local_energy, &energy, 1,
+                       MpiTraits<Scalar>::type(), MPI_SUM,
+                       _grid->layout()->localGrid()->globalGrid().comm() );
+
+        // E = h^3 / (2 N) sum_k G(k) |rho(k)|^2
+        const Scalar cell_volume =
+            _cell_size[0] * _cell_size[1] * _cell_size[2];
+        const Scalar num_total = static_cast<Scalar>( _num_node[0] ) *
+                                 _num_node[1] * _num_node[2];
+        return 0.5 * cell_volume * energy / num_total;
+    }
+
+  private:
+    Scalar _alpha;
+    int _aliasing_width;
+    int _num_node[3];
+    Scalar _cell_size[3];
+    std::shared_ptr<Array<Scalar, Node, mesh_type, DeviceType>> _grid;
+    std::shared_ptr<Halo<memory_space>> _halo;
+    std::shared_ptr<HeffteRealFastFourierTransform<
+        Node, mesh_type, Scalar, DeviceType, Impl::FFTBackendDefault>>
+        _fft;
+    Kokkos::View<Scalar***, Kokkos::LayoutRight, DeviceType> _influence;
+    SplineDataCache<Scalar, SplineOrder, 3, DeviceType> _spline_cache;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create a P3M solver.
+  \param local_grid The local grid of a mesh periodic in all dimensions.
+  \param alpha The Ewald splitting parameter.
+  \param aliasing_width The number of reciprocal lattice images included in
+  each direction of the influence function aliasing sums.
+*/
+template <class DeviceType, int SplineOrder, class Scalar>
+std::shared_ptr<PPPMSolver<Scalar, DeviceType, SplineOrder>>
+createPPPMSolver( const std::shared_ptr<LocalGrid<UniformMesh<Scalar, 3>>>&
+                      local_grid,
+                  Spline<SplineOrder>, const Scalar alpha,
+                  const int aliasing_width = 2 )
+{
+    return std::make_shared<PPPMSolver<Scalar, DeviceType, SplineOrder>>(
+        local_grid, alpha, aliasing_width );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Choose the Ewald splitting parameter for a short-range cutoff such
+  that the short-range interaction is truncated with the given relative
+  accuracy, i.e. erfc(alpha * cutoff) is approximately the accuracy.
+  \param cutoff The short-range cutoff.
+  \param accuracy The relative accuracy of the truncation.
+*/
+template <class Scalar>
+Scalar pppmSplittingParameter( const Scalar cutoff, const Scalar accuracy )
+{
+    return std::sqrt( -std::log( accuracy ) ) / cutoff;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Compute the short-range potential and field at the particles.
+
+  \param list A full neighbor list of the particles within the short-range
+  cutoff, e.g. a Cabana::VerletList built with Cabana::FullNeighborTag over
+  the particles and their periodic ghosts.
+
+  \param positions The particle positions, indexed as (particle,dim).
+
+  \param charges The particle charges.
+
+  \param num_point The number of particles for which to compute the
+  potential and field. Neighbors may be beyond this number (e.g. ghosts).
+
+  \param alpha The Ewald splitting parameter.
+
+  \param cutoff The short-range cutoff.
+
+  \param potential The short-range potential at each particle is added to
+  this view.
+
+  \param field The short-range electric field at each particle is added to
+  this view, indexed as (particle,dim).
+
+  The short-range energy is half the sum over particles of the charge times
+  the short-range potential.
+*/
+template <class ExecutionSpace, class NeighborListType, class PositionSlice,
+          class ChargeSlice, class PotentialView, class FieldView,
+          class Scalar>
+void computeRealSpace( ExecutionSpace, const NeighborListType& list,
+                       const PositionSlice& positions,
+                       const ChargeSlice& charges, const std::size_t num_point,
+                       const Scalar alpha, const Scalar cutoff,
+                       const PotentialView& potential, const FieldView& field )
+{
+    Cabana::Impl::ScopedProfileRegion region(
+        "Cajita::PPPMSolver::computeRealSpace" );
+
+    const Scalar cutoff_sq = cutoff * cutoff;
+    const Scalar two_alpha_over_sqrt_pi = 2.0 * alpha / std::sqrt( M_PI );
+    auto pair_func = KOKKOS_LAMBDA( const int i, const int j )
+    {
+        Scalar dx[3];
+        Scalar r2 = 0.0;
+        for ( int d = 0; d < 3; ++d )
+        {
+            dx[d] = positions( i, d ) - positions( j, d );
+            r2 += dx[d] * dx[d];
+        }
+        if ( r2 >= cutoff_sq || 0.0 == r2 )
+            return;
+
+        // phi = q erfc(alpha r) / r
+        // E = q ( erfc(alpha r) / r + 2 alpha / sqrt(pi) exp(-alpha^2 r^2) )
+        //     * dx / r^2
+        const Scalar r = sqrt( r2 );
+        const Scalar qj = charges( j );
+        const Scalar screened = erfc( alpha * r ) / r;
+        const Scalar e_over_r =
+            qj *
+            ( screened + two_alpha_over_sqrt_pi * exp( -alpha * alpha * r2 ) ) /
+            r2;
+        potential( i ) += qj * screened;
+        for ( int d = 0; d < 3; ++d )
+            field( i, d ) += e_over_r * dx[d];
+    };
+    Cabana::neighbor_parallel_for(
+        Kokkos::RangePolicy<ExecutionSpace>( 0, num_point ), pair_func, list,
+        Cabana::FirstNeighborsTag(), Cabana::SerialOpTag(),
+        "Cajita::PPPMSolver::real_space" );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Experimental
+} // end namespace Cajita
+
+#endif // end CAJITA_PPPMSOLVER_HPP
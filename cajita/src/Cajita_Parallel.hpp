@@ -19,7 +19,14 @@
 #include <Cajita_IndexSpace.hpp>
 #include <Cajita_LocalGrid.hpp>
 
+#include <mpi.h>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 namespace Cajita
 {
@@ -88,6 +95,80 @@ grid_parallel_for( const std::string& label, const ExecutionSpace& exec_space,
         functor );
 }
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief Execute a functor in parallel with a multidimensional execution
+  policy specified by the given index space and tile sizes.
+
+  \tparam FunctorType The functor type to execute.
+
+  \tparam ExecutionSpace The execution space type.
+
+  \tparam N The dimension of the index space.
+
+  \param label Parallel region label.
+
+  \param exec_space An execution space instance.
+
+  \param index_space The index space over which to loop.
+
+  \param tile The number of indices in each dimension of a tile.
+
+  \param functor The functor to execute.
+
+  \see defaultTileSize, tuneTileSize
+ */
+template <class FunctorType, class ExecutionSpace, long N>
+inline void
+grid_parallel_for( const std::string& label, const ExecutionSpace& exec_space,
+                   const IndexSpace<N>& index_space,
+                   const Kokkos::Array<long, N>& tile,
+                   const FunctorType& functor )
+{
+    Kokkos::parallel_for(
+        label, createExecutionPolicy( index_space, exec_space, tile ),
+        functor );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Execute a functor with a work tag in parallel with a
+  multidimensional execution policy specified by the given index space and
+  tile sizes.
+
+  \tparam FunctorType The functor type to execute.
+
+  \tparam WorkTag The functor execution tag.
+
+  \tparam ExecutionSpace The execution space type.
+
+  \tparam N The dimension of the index space.
+
+  \param label Parallel region label.
+
+  \param exec_space An execution space instance.
+
+  \param index_space The index space over which to loop.
+
+  \param work_tag The functor execution tag.
+
+  \param tile The number of indices in each dimension of a tile.
+
+  \param functor The functor to execute.
+ */
+template <class FunctorType, class WorkTag, class ExecutionSpace, long N>
+inline void
+grid_parallel_for( const std::string& label, const ExecutionSpace& exec_space,
+                   const IndexSpace<N>& index_space, const WorkTag& work_tag,
+                   const Kokkos::Array<long, N>& tile,
+                   const FunctorType& functor )
+{
+    Kokkos::parallel_for(
+        label,
+        createExecutionPolicy( index_space, exec_space, work_tag, tile ),
+        functor );
+}
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Execute a functor in parallel with a multidimensional execution
@@ -562,6 +643,248 @@ inline void grid_parallel_reduce(
                           reducer );
 }
 
+//---------------------------------------------------------------------------//
+// Tile Sizes
+//---------------------------------------------------------------------------//
+//! \cond Impl
+namespace Impl
+{
+// Index of the dimension with unit stride in the default array layout of an
+// execution space.
+template <long N, class ExecutionSpace>
+constexpr long contiguousTileDim()
+{
+    return std::is_same<typename ExecutionSpace::array_layout,
+                        Kokkos::LayoutLeft>::value
+               ? 0
+               : N - 1;
+}
+
+// Whether an execution space runs on the host.
+template <class ExecutionSpace>
+constexpr bool isHostTileSpace()
+{
+    return Kokkos::SpaceAccessibility<ExecutionSpace,
+                                      Kokkos::HostSpace>::accessible;
+}
+} // end namespace Impl
+//! \endcond
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Get default tile sizes for grid kernels on an execution space.
+
+  \tparam N The dimension of the index space.
+
+  \param exec_space An execution space instance.
+
+  \return The tile sizes. On host backends the dimension with unit stride in
+  the default array layout is blocked by 64 and the others by 4 such that the
+  data of a tile for a few fields stays in cache. On device backends tiles of
+  128 threads are used with 32 threads along the dimension with unit stride
+  for coalesced access.
+*/
+template <long N, class ExecutionSpace>
+Kokkos::Array<long, N> defaultTileSize( const ExecutionSpace& )
+{
+    constexpr long c = Impl::contiguousTileDim<N, ExecutionSpace>();
+    constexpr bool host = Impl::isHostTileSpace<ExecutionSpace>();
+    Kokkos::Array<long, N> tile;
+    for ( long d = 0; d < N; ++d )
+        tile[d] = host ? 4 : 1;
+    tile[c] = host ? 64 : 32;
+    if ( !host && N > 1 )
+        tile[( c == 0 ) ? 1 : c - 1] = 4;
+    return tile;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Get a set of candidate tile sizes for grid kernels on an execution
+  space.
+
+  \tparam N The dimension of the index space.
+
+  \param exec_space An execution space instance.
+
+  \return The candidate tile sizes. The dimension with unit stride in the
+  default array layout is blocked by 8 to 256 and the others by 1 to 8. On
+  device backends tiles with more than 1024 threads are excluded.
+*/
+template <long N, class ExecutionSpace>
+std::vector<Kokkos::Array<long, N>>
+tileSizeCandidates( const ExecutionSpace& )
+{
+    constexpr long c = Impl::contiguousTileDim<N, ExecutionSpace>();
+    constexpr bool host = Impl::isHostTileSpace<ExecutionSpace>();
+    std::vector<Kokkos::Array<long, N>> candidates;
+    for ( long inner = 8; inner <= 256; inner *= 2 )
+        for ( long outer = 1; outer <= 8; outer *= 2 )
+        {
+            Kokkos::Array<long, N> tile;
+            long size = 1;
+            for ( long d = 0; d < N; ++d )
+            {
+                tile[d] = ( d == c ) ? inner : outer;
+                size *= tile[d];
+            }
+            if ( host || size <= 1024 )
+                candidates.push_back( tile );
+        }
+    return candidates;
+}
+
+//---------------------------------------------------------------------------//
+//! \cond Impl
+namespace Impl
+{
+// Time a grid kernel with each candidate tile size. The time of a candidate
+// is its fastest execution.
+template <class FunctorType, class ExecutionSpace, long N>
+std::vector<double>
+timeTileSizes( const std::string& label, const ExecutionSpace& exec_space,
+               const IndexSpace<N>& index_space, const FunctorType& functor,
+               const std::vector<Kokkos::Array<long, N>>& candidates,
+               const int num_trial )
+{
+    if ( candidates.empty() )
+        throw std::runtime_error( "No candidate tile sizes given" );
+
+    std::vector<double> times( candidates.size(),
+                               std::numeric_limits<double>::max() );
+    for ( std::size_t c = 0; c < candidates.size(); ++c )
+    {
+        for ( int t = 0; t < num_trial; ++t )
+        {
+            exec_space.fence();
+            Kokkos::Timer timer;
+            grid_parallel_for( label, exec_space, index_space, candidates[c],
+                               functor );
+            exec_space.fence();
+            times[c] = std::min( times[c], timer.seconds() );
+        }
+    }
+    return times;
+}
+
+// Get the candidate with the smallest time.
+template <long N>
+Kokkos::Array<long, N>
+fastestTileSize( const std::vector<Kokkos::Array<long, N>>& candidates,
+                 const std::vector<double>& times )
+{
+    return candidates[std::min_element( times.begin(), times.end() ) -
+                      times.begin()];
+}
+} // end namespace Impl
+//! \endcond
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Pick the fastest tile sizes for a grid kernel on this rank by timing
+  it.
+
+  \tparam FunctorType The functor type to execute.
+
+  \tparam ExecutionSpace The execution space type.
+
+  \tparam N The dimension of the index space.
+
+  \param label Parallel region label.
+
+  \param exec_space An execution space instance.
+
+  \param index_space The index space over which to loop.
+
+  \param functor The functor to execute. It is executed num_trial times for
+  every candidate and so must give the same result when executed repeatedly,
+  e.g. by writing its output from unmodified inputs.
+
+  \param candidates The tile sizes to choose from.
+
+  \param num_trial The number of timed executions of each candidate. The
+  fastest execution of a candidate is its time.
+
+  \return The tile sizes of the fastest candidate. The result depends on the
+  kernel and backend and is meant to be computed once, e.g. at setup, and
+  reused with grid_parallel_for. The choice is local to the calling rank and
+  may differ between ranks; use the overload taking a communicator for a
+  choice shared by all ranks.
+*/
+template <class FunctorType, class ExecutionSpace, long N>
+Kokkos::Array<long, N>
+tuneTileSize( const std::string& label, const ExecutionSpace& exec_space,
+              const IndexSpace<N>& index_space, const FunctorType& functor,
+              const std::vector<Kokkos::Array<long, N>>& candidates,
+              const int num_trial = 3 )
+{
+    auto times = Impl::timeTileSizes( label, exec_space, index_space, functor,
+                                      candidates, num_trial );
+    return Impl::fastestTileSize( candidates, times );
+}
+
+/*!
+  \brief Pick the fastest tile sizes for a grid kernel on this rank by timing
+  it with the candidates of tileSizeCandidates.
+*/
+template <class FunctorType, class ExecutionSpace, long N>
+Kokkos::Array<long, N>
+tuneTileSize( const std::string& label, const ExecutionSpace& exec_space,
+              const IndexSpace<N>& index_space, const FunctorType& functor,
+              const int num_trial = 3 )
+{
+    return tuneTileSize( label, exec_space, index_space, functor,
+                         tileSizeCandidates<N>( exec_space ), num_trial );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Pick the tile sizes for a grid kernel that are fastest on the
+  slowest rank of a communicator by timing it.
+
+  Every rank times every candidate over its own index space. The time of a
+  candidate is the maximum over the ranks such that the choice minimizes the
+  time of the bulk-synchronous step and is the same on all ranks.
+
+  \param comm The communicator over which to agree on the choice. This is
+  collective over the communicator and every rank must give the same
+  candidates.
+
+  \see tuneTileSize( const std::string&, const ExecutionSpace&,
+  const IndexSpace<N>&, const FunctorType&,
+  const std::vector<Kokkos::Array<long, N>>&, const int )
+*/
+template <class FunctorType, class ExecutionSpace, long N>
+Kokkos::Array<long, N>
+tuneTileSize( MPI_Comm comm, const std::string& label,
+              const ExecutionSpace& exec_space,
+              const IndexSpace<N>& index_space, const FunctorType& functor,
+              const std::vector<Kokkos::Array<long, N>>& candidates,
+              const int num_trial = 3 )
+{
+    auto times = Impl::timeTileSizes( label, exec_space, index_space, functor,
+                                      candidates, num_trial );
+    MPI_Allreduce( MPI_IN_PLACE, times.data(), times.size(), MPI_DOUBLE,
+                   MPI_MAX, comm );
+    return Impl::fastestTileSize( candidates, times );
+}
+
+/*!
+  \brief Pick the tile sizes for a grid kernel that are fastest on the
+  slowest rank of a communicator by timing it with the candidates of
+  tileSizeCandidates.
+*/
+template <class FunctorType, class ExecutionSpace, long N>
+Kokkos::Array<long, N>
+tuneTileSize( MPI_Comm comm, const std::string& label,
+              const ExecutionSpace& exec_space,
+              const IndexSpace<N>& index_space, const FunctorType& functor,
+              const int num_trial = 3 )
+{
+    return tuneTileSize( comm, label, exec_space, index_space, functor,
+                         tileSizeCandidates<N>( exec_space ), num_trial );
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Cajita
@@ -14,6 +14,9 @@
 
 #include <Cabana_DeepCopy.hpp>
 #include <Cabana_Distributor.hpp>
+#include <Cabana_ParallelIO.hpp>
+#include <Cabana_Slice.hpp>
+#include <Cabana_Tuple.hpp>
 
 #include <Cajita_GlobalGrid.hpp>
 #include <Cajita_GlobalMesh.hpp>
@@ -22,6 +25,9 @@
 
 #include <Kokkos_Core.hpp>
 
+#include <algorithm>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace Cajita
@@ -67,13 +73,15 @@ getTopology( const LocalGridType& local_grid )
 // Locate the particles in the local grid and get their destination rank.
 // Particles are assumed to only migrate to a location in the nearest
 // neighbor halo or stay on this rank. If the particle crosses a global
-// periodic boundary, wrap it's coordinates back into the domain.
+// periodic boundary, wrap it's coordinates back into the domain unless the
+// shift is done later, e.g. by a PeriodicShiftTransform during migration.
 template <class LocalGridType, class PositionSliceType, class NeighborRankView,
           class DestinationRankView>
 void getMigrateDestinations( const LocalGridType& local_grid,
                              const NeighborRankView& neighbor_ranks,
                              DestinationRankView& destinations,
-                             PositionSliceType& positions )
+                             PositionSliceType& positions,
+                             const bool shift_positions = true )
 {
     static constexpr std::size_t num_space_dim = LocalGridType::num_space_dim;
     using execution_space = typename PositionSliceType::execution_space;
@@ -132,7 +140,7 @@ void getMigrateDestinations( const LocalGridType& local_grid,
             // Shift particles through periodic boundaries.
             for ( std::size_t d = 0; d < num_space_dim; ++d )
             {
-                if ( periodic[d] )
+                if ( shift_positions && periodic[d] )
                 {
                     if ( positions( p, d ) > global_high[d] )
                         positions( p, d ) -= global_extent[d];
@@ -142,6 +150,53 @@ void getMigrateDestinations( const LocalGridType& local_grid,
             }
         } );
 }
+
+// Pack transform wrapping the positions of migrating particles that crossed
+// a global periodic boundary back into the domain.
+template <std::size_t PositionMember, std::size_t NumSpaceDim>
+struct PeriodicShiftTransform
+{
+    Kokkos::Array<bool, NumSpaceDim> periodic;
+    Kokkos::Array<double, NumSpaceDim> global_low;
+    Kokkos::Array<double, NumSpaceDim> global_high;
+    Kokkos::Array<double, NumSpaceDim> global_extent;
+
+    template <class Tuple>
+    KOKKOS_INLINE_FUNCTION void operator()( const std::size_t,
+                                            Tuple& tpl ) const
+    {
+        for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+        {
+            if ( periodic[d] )
+            {
+                auto& x = Cabana::get<PositionMember>( tpl, d );
+                if ( x > global_high[d] )
+                    x -= global_extent[d];
+                else if ( x < global_low[d] )
+                    x += global_extent[d];
+            }
+        }
+    }
+};
+
+// Create the periodic shift transform of a grid.
+template <std::size_t PositionMember, class LocalGridType>
+PeriodicShiftTransform<PositionMember, LocalGridType::num_space_dim>
+createPeriodicShiftTransform( const LocalGridType& local_grid )
+{
+    const auto& global_grid = local_grid.globalGrid();
+    const auto& global_mesh = global_grid.globalMesh();
+    PeriodicShiftTransform<PositionMember, LocalGridType::num_space_dim>
+        transform;
+    for ( std::size_t d = 0; d < LocalGridType::num_space_dim; ++d )
+    {
+        transform.periodic[d] = global_grid.isPeriodic( d );
+        transform.global_low[d] = global_mesh.lowCorner( d );
+        transform.global_high[d] = global_mesh.highCorner( d );
+        transform.global_extent[d] = global_mesh.extent( d );
+    }
+    return transform;
+}
 //! \endcond
 } // namespace Impl
 
@@ -227,12 +282,16 @@ int migrateCount( const LocalGridType& local_grid,
 
   \param positions The particle positions.
 
+  \param shift_positions Whether to wrap the positions across periodic
+  boundaries now. Pass false when the shift is fused into the migration.
+
   \return Distributor for later migration.
 */
 template <class LocalGridType, class PositionSliceType>
 Cabana::Distributor<typename PositionSliceType::device_type>
 createParticleGridDistributor( const LocalGridType& local_grid,
-                               PositionSliceType& positions )
+                               PositionSliceType& positions,
+                               const bool shift_positions = true )
 {
     using device_type = typename PositionSliceType::device_type;
 
@@ -250,7 +309,7 @@ createParticleGridDistributor( const LocalGridType& local_grid,
     // Determine destination ranks for all particles and wrap positions across
     // periodic boundaries.
     Impl::getMigrateDestinations( local_grid, topology_mirror, destinations,
-                                  positions );
+                                  positions, shift_positions );
 
     // Create the Cabana distributor.
     Cabana::Distributor<device_type> distributor(
@@ -370,6 +429,375 @@ void particleGridMigrate( const LocalGridType& local_grid,
     migrate( distributor, src_particles, dst_particles );
 }
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief Migrate data from one uniquely-owned decomposition to another
+  uniquely-owned decomposition, using the bounds and periodic boundaries of a
+  Cajita grid to determine which particles should be moved. In-place variant
+  with the periodic shift of the positions fused into the migration, so the
+  positions of particles crossing a periodic boundary are only touched once.
+
+  \tparam PositionMember The AoSoA member index of the particle positions.
+
+  \tparam LocalGridType Cajita LocalGrid type.
+
+  \tparam ParticleContainer AoSoA type.
+
+  \param local_grid The local grid containing periodicity and system bounds.
+
+  \param particles The particle AoSoA.
+
+  \param min_halo_width Number of halo mesh widths to allow particles before
+  migrating.
+
+  \param force_migrate Migrate particles outside the local domain regardless of
+  ghosted halo.
+*/
+template <std::size_t PositionMember, class LocalGridType,
+          class ParticleContainer>
+void particleGridMigrate( const LocalGridType& local_grid,
+                          ParticleContainer& particles,
+                          const int min_halo_width,
+                          const bool force_migrate = false )
+{
+    auto positions = Cabana::slice<PositionMember>( particles );
+
+    // When false, this option checks that any particles are nearly outside the
+    // ghosted halo region (outside the min_halo_width) before initiating
+    // migration. Otherwise, anything outside the local domain is migrated
+    // regardless of position in the halo.
+    if ( !force_migrate )
+    {
+        // Check to see if we need to communicate.
+        auto comm_count = migrateCount( local_grid, positions, min_halo_width );
+
+        // If we have no particles near the ghosted boundary, then exit.
+        if ( 0 == comm_count )
+            return;
+    }
+
+    auto distributor =
+        createParticleGridDistributor( local_grid, positions, false );
+
+    // Redistribute the particles, shifting positions as they are packed.
+    Cabana::migrate(
+        distributor, particles,
+        Impl::createPeriodicShiftTransform<PositionMember>( local_grid ) );
+}
+
+//---------------------------------------------------------------------------//
+namespace Impl
+{
+//! \cond Impl
+// Locate the particles in the blocks of all ranks and get their owning rank,
+// wherever they are in the global domain. Positions are wrapped into the
+// domain along periodic dimensions. Positions outside of the domain along
+// other dimensions are owned by the nearest boundary block.
+template <class LocalGridType, class PositionSliceType,
+          class DestinationRankView>
+void getOwnerDestinations( const LocalGridType& local_grid,
+                           DestinationRankView& destinations,
+                           PositionSliceType& positions )
+{
+    static constexpr std::size_t num_space_dim = LocalGridType::num_space_dim;
+    using execution_space = typename PositionSliceType::execution_space;
+    using memory_space = typename PositionSliceType::memory_space;
+
+    const auto& local_mesh =
+        Cajita::createLocalMesh<Kokkos::HostSpace>( local_grid );
+    const auto& global_grid = local_grid.globalGrid();
+    const auto& global_mesh = global_grid.globalMesh();
+    MPI_Comm comm = global_grid.comm();
+    int comm_size = -1;
+    MPI_Comm_size( comm, &comm_size );
+
+    // Gather the block indices and the low corners of the blocks of all
+    // ranks.
+    std::vector<int> block_id( num_space_dim );
+    std::vector<double> block_low( num_space_dim );
+    for ( std::size_t d = 0; d < num_space_dim; ++d )
+    {
+        block_id[d] = global_grid.dimBlockId( d );
+        block_low[d] = local_mesh.lowCorner( Cajita::Own(), d );
+    }
+    std::vector<int> all_block_id( num_space_dim * comm_size );
+    std::vector<double> all_block_low( num_space_dim * comm_size );
+    MPI_Allgather( block_id.data(), num_space_dim, MPI_INT,
+                   all_block_id.data(), num_space_dim, MPI_INT, comm );
+    MPI_Allgather( block_low.data(), num_space_dim, MPI_DOUBLE,
+                   all_block_low.data(), num_space_dim, MPI_DOUBLE, comm );
+
+    // Build the block bounds along each dimension and the rank of every
+    // block.
+    Kokkos::Array<int, num_space_dim> num_block{};
+    Kokkos::Array<int, num_space_dim> stride{};
+    Kokkos::Array<bool, num_space_dim> periodic{};
+    Kokkos::Array<double, num_space_dim> global_low{};
+    Kokkos::Array<double, num_space_dim> global_extent{};
+    int max_block = 0;
+    int total_block = 1;
+    for ( std::size_t d = 0; d < num_space_dim; ++d )
+    {
+        num_block[d] = global_grid.dimNumBlock( d );
+        stride[d] = total_block;
+        total_block *= num_block[d];
+        max_block = std::max( max_block, num_block[d] );
+        periodic[d] = global_grid.isPeriodic( d );
+        global_low[d] = global_mesh.lowCorner( d );
+        global_extent[d] = global_mesh.extent( d );
+    }
+    Kokkos::View<double**, Kokkos::HostSpace> bounds_host(
+        "block_bounds", num_space_dim, max_block + 1 );
+    Kokkos::View<int*, Kokkos::HostSpace> ranks_host( "block_ranks",
+                                                      total_block );
+    for ( int r = 0; r < comm_size; ++r )
+    {
+        int index = 0;
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+        {
+            int b = all_block_id[r * num_space_dim + d];
+            bounds_host( d, b ) = all_block_low[r * num_space_dim + d];
+            index += b * stride[d];
+        }
+        ranks_host( index ) = r;
+    }
+    for ( std::size_t d = 0; d < num_space_dim; ++d )
+        bounds_host( d, num_block[d] ) = global_mesh.highCorner( d );
+    auto bounds =
+        Kokkos::create_mirror_view_and_copy( memory_space(), bounds_host );
+    auto block_ranks =
+        Kokkos::create_mirror_view_and_copy( memory_space(), ranks_host );
+
+    Kokkos::parallel_for(
+        "get_owner_destinations",
+        Kokkos::RangePolicy<execution_space>( 0, positions.size() ),
+        KOKKOS_LAMBDA( const int p ) {
+            int index = 0;
+            for ( std::size_t d = 0; d < num_space_dim; ++d )
+            {
+                // Wrap the position through periodic boundaries.
+                if ( periodic[d] )
+                    positions( p, d ) -=
+                        global_extent[d] *
+                        floor( ( positions( p, d ) - global_low[d] ) /
+                               global_extent[d] );
+
+                // Find the last block starting at or below the position.
+                int lo = 0;
+                int hi = num_block[d] - 1;
+                while ( lo < hi )
+                {
+                    int mid = ( lo + hi + 1 ) / 2;
+                    if ( bounds( d, mid ) <= positions( p, d ) )
+                        lo = mid;
+                    else
+                        hi = mid - 1;
+                }
+                index += lo * stride[d];
+            }
+            destinations( p ) = block_ranks( index );
+        } );
+    Kokkos::fence();
+}
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Determine which data should be migrated from any rank to the rank
+  owning it in the decomposition of a Cajita grid.
+
+  Unlike createParticleGridDistributor(), particles may be anywhere in the
+  global domain, e.g. after a parallel read of initial conditions, at the
+  cost of gathering the block bounds of all ranks.
+
+  \tparam LocalGridType Cajita LocalGrid type.
+
+  \tparam PositionSliceType Particle position type.
+
+  \param local_grid The local grid containing periodicity and system bounds.
+
+  \param positions The particle positions. They are wrapped through periodic
+  boundaries.
+
+  \return Distributor for later migration.
+*/
+template <class LocalGridType, class PositionSliceType>
+Cabana::Distributor<typename PositionSliceType::device_type>
+createParticleGridOwnerDistributor( const LocalGridType& local_grid,
+                                    PositionSliceType& positions )
+{
+    using device_type = typename PositionSliceType::device_type;
+
+    Kokkos::View<int*, device_type> destinations(
+        Kokkos::ViewAllocateWithoutInitializing( "destinations" ),
+        positions.size() );
+    Impl::getOwnerDestinations( local_grid, destinations, positions );
+
+    return Cabana::Distributor<device_type>( local_grid.globalGrid().comm(),
+                                             destinations );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Migrate particles located anywhere in the global domain to their
+  owning ranks in the decomposition of a Cajita grid with a single
+  migration.
+
+  \tparam PositionMember The AoSoA member index of the particle positions.
+
+  \tparam LocalGridType Cajita LocalGrid type.
+
+  \tparam ParticleContainer AoSoA type.
+
+  \param local_grid The local grid containing periodicity and system bounds.
+
+  \param particles The particle AoSoA.
+*/
+template <std::size_t PositionMember, class LocalGridType,
+          class ParticleContainer>
+void particleGridOwnerMigrate( const LocalGridType& local_grid,
+                               ParticleContainer& particles )
+{
+    auto positions = Cabana::slice<PositionMember>( particles );
+    auto distributor =
+        createParticleGridOwnerDistributor( local_grid, positions );
+    Cabana::migrate( distributor, particles );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Read a particle file in parallel and migrate the particles to their
+  owning ranks in the decomposition of a Cajita grid.
+
+  Every rank reads its part of the file with Cabana::IO::readParticles()
+  followed by a single particleGridOwnerMigrate().
+
+  \tparam PositionMember The AoSoA member index of the particle positions.
+
+  \tparam LocalGridType Cajita LocalGrid type.
+
+  \tparam ParticleContainer AoSoA type.
+
+  \param local_grid The local grid containing periodicity and system bounds.
+
+  \param path The particle file in the raw format of Cabana::checkpoint().
+
+  \param particles The particle AoSoA to read into.
+
+  \param method The method used to read the file.
+*/
+template <std::size_t PositionMember, class LocalGridType,
+          class ParticleContainer>
+void particleGridRead(
+    const LocalGridType& local_grid, const std::string& path,
+    ParticleContainer& particles,
+    const Cabana::IO::ReadMethod method = Cabana::IO::ReadMethod::MPIIO )
+{
+    Cabana::IO::readParticles( local_grid.globalGrid().comm(), path,
+                               particles, method );
+    particleGridOwnerMigrate<PositionMember>( local_grid, particles );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Migrate particles between neighboring blocks of a Cajita grid with a
+  communication plan reused from step to step.
+
+  The plan is built on the nearest neighbor topology of the local grid by the
+  first migration. Later migrations only exchange the send and receive counts
+  with the neighbors: there is no global count as in migrateCount() and no
+  topology setup of a new distributor. Particles must not move past the
+  nearest neighbor blocks between migrations.
+
+  \tparam LocalGridType Cajita LocalGrid type.
+
+  \tparam DeviceType Kokkos device type of the particles.
+*/
+template <class LocalGridType, class DeviceType>
+class ParticleGridMigrator
+{
+  public:
+    //! Kokkos device type.
+    using device_type = DeviceType;
+
+    //! Distributor type.
+    using distributor_type = Cabana::Distributor<device_type>;
+
+    /*!
+      \brief Constructor.
+      \param local_grid The local grid containing periodicity and system
+      bounds.
+    */
+    ParticleGridMigrator( const std::shared_ptr<LocalGridType>& local_grid )
+        : _local_grid( local_grid )
+        , _topology( Impl::getTopology( *local_grid ) )
+    {
+        Kokkos::View<int*, Kokkos::HostSpace, Kokkos::MemoryUnmanaged>
+            topology_host( _topology.data(), _topology.size() );
+        _topology_view =
+            Kokkos::create_mirror_view_and_copy( device_type(), topology_host );
+    }
+
+    /*!
+      \brief Move every particle outside the local domain to its neighbor,
+      wrapping positions across periodic boundaries. The positions slice and
+      any other slice of the particles are invalid afterwards.
+
+      \param positions Particle positions.
+
+      \param particles The particle AoSoA, migrated in place.
+    */
+    template <class PositionSliceType, class ParticleContainer>
+    void migrate( PositionSliceType& positions, ParticleContainer& particles )
+    {
+        Kokkos::View<int*, device_type> destinations(
+            Kokkos::ViewAllocateWithoutInitializing( "destinations" ),
+            positions.size() );
+        Impl::getMigrateDestinations( *_local_grid, _topology_view,
+                                      destinations, positions );
+
+        // Build the plan on the first step, then only update the counts.
+        if ( _distributor )
+            _distributor->updateWithTopology( destinations );
+        else
+            _distributor = std::make_shared<distributor_type>(
+                _local_grid->globalGrid().comm(), destinations, _topology );
+
+        Cabana::migrate( *_distributor, particles );
+    }
+
+    //! Get the distributor of the last migration.
+    std::shared_ptr<distributor_type> distributor() const
+    {
+        return _distributor;
+    }
+
+  private:
+    std::shared_ptr<LocalGridType> _local_grid;
+    std::vector<int> _topology;
+    Kokkos::View<int*, device_type> _topology_view;
+    std::shared_ptr<distributor_type> _distributor;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create a particle grid migrator.
+
+  \tparam DeviceType Kokkos device type of the particles.
+
+  \tparam LocalGridType Cajita LocalGrid type.
+
+  \param local_grid The local grid containing periodicity and system bounds.
+*/
+template <class DeviceType, class LocalGridType>
+std::shared_ptr<ParticleGridMigrator<LocalGridType, DeviceType>>
+createParticleGridMigrator( const std::shared_ptr<LocalGridType>& local_grid )
+{
+    return std::make_shared<ParticleGridMigrator<LocalGridType, DeviceType>>(
+        local_grid );
+}
+
 } // namespace Cajita
 
 #endif // end CABANA_PARTICLEGRIDDISTRIBUTOR_HPP
@@ -0,0 +1,417 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cajita_ParticleGridHalo.hpp
+  \brief Particle halos built from the geometry of a Cajita grid
+*/
+#ifndef CAJITA_PARTICLEGRIDHALO_HPP
+#define CAJITA_PARTICLEGRIDHALO_HPP
+
+#include <Cabana_Halo.hpp>
+#include <Cabana_Slice.hpp>
+#include <impl/Cabana_Profiling.hpp>
+
+#include <Cajita_GlobalGrid.hpp>
+#include <Cajita_GlobalMesh.hpp>
+#include <Cajita_LocalGrid.hpp>
+#include <Cajita_LocalMesh.hpp>
+#include <Cajita_ParticleGridDistributor.hpp>
+#include <Cajita_Types.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace Cajita
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief Particle halo of the nearest neighbor blocks of a Cajita grid.
+
+  \tparam DeviceType Kokkos device type of the particles.
+  \tparam NumSpaceDim The number of spatial dimensions.
+
+  Wraps a Cabana::Halo with the periodic shift of each ghost such that ghosts
+  received through a periodic boundary are placed next to the local domain.
+  Ghosts are shifted after each gather of the positions by the gather()
+  and updatePositions() members of this class, or by shiftGhosts() after a
+  gather performed directly with the halo.
+*/
+template <class DeviceType, std::size_t NumSpaceDim>
+class ParticleGridHalo
+{
+  public:
+    //! Kokkos device type.
+    using device_type = DeviceType;
+
+    //! Kokkos memory space.
+    using memory_space = typename device_type::memory_space;
+
+    //! Kokkos execution space.
+    using execution_space = typename device_type::execution_space;
+
+    //! Particle halo type.
+    using halo_type = Cabana::Halo<device_type>;
+
+    //! Spatial dimension.
+    static constexpr std::size_t num_space_dim = NumSpaceDim;
+
+    //! Ghost shift view type.
+    using shift_view_type =
+        Kokkos::View<int* [NumSpaceDim], Kokkos::LayoutRight, memory_space>;
+
+    /*!
+      \brief Constructor.
+
+      \param halo The particle halo.
+
+      \param ghost_shifts The number of global domain extents to shift each
+      ghost by in each dimension.
+
+      \param global_extent The extent of the global domain in each dimension.
+    */
+    ParticleGridHalo( const halo_type& halo,
+                      const shift_view_type& ghost_shifts,
+                      const Kokkos::Array<double, NumSpaceDim>& global_extent )
+        : _halo( halo )
+        , _ghost_shifts( ghost_shifts )
+        , _global_extent( global_extent )
+    {
+    }
+
+    //! Get the particle halo.
+    const halo_type& halo() const { return _halo; }
+
+    //! Get the number of locally owned particles.
+    std::size_t numLocal() const { return _halo.numLocal(); }
+
+    //! Get the number of ghosted particles.
+    std::size_t numGhost() const { return _halo.numGhost(); }
+
+    //! Get the periodic shift of each ghost in units of the global extent.
+    shift_view_type ghostShifts() const { return _ghost_shifts; }
+
+    /*!
+      \brief Shift the positions of the ghosts received through periodic
+      boundaries. Call once after each gather of the positions.
+
+      \param positions The positions of the owned particles followed by the
+      ghosts.
+    */
+    template <class PositionSliceType>
+    void shiftGhosts( PositionSliceType& positions ) const
+    {
+        auto shifts = _ghost_shifts;
+        auto extent = _global_extent;
+        const std::size_t num_local = _halo.numLocal();
+        Kokkos::parallel_for(
+            "Cajita::ParticleGridHalo::shiftGhosts",
+            Kokkos::RangePolicy<execution_space>( 0, _halo.numGhost() ),
+            KOKKOS_LAMBDA( const int g ) {
+                for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+                    positions( num_local + g, d ) +=
+                        shifts( g, d ) * extent[d];
+            } );
+        Kokkos::fence();
+    }
+
+    /*!
+      \brief Resize the particles to hold the ghosts, gather them, and shift
+      their positions.
+
+      \tparam PositionMember The AoSoA member index of the positions.
+
+      \param particles The particle AoSoA.
+    */
+    template <std::size_t PositionMember, class AoSoAType>
+    void gather( AoSoAType& particles ) const
+    {
+        Cabana::Impl::ScopedProfileRegion region(
+            "Cajita::ParticleGridHalo::gather" );
+        particles.resize( _halo.numLocal() + _halo.numGhost() );
+        Cabana::gather( _halo, particles );
+        auto positions = Cabana::slice<PositionMember>( particles );
+        shiftGhosts( positions );
+    }
+
+    /*!
+      \brief Update the positions of the existing ghosts with the positions
+      of their owners and shift them, e.g. between neighbor list rebuilds.
+
+      \param positions The positions of the owned particles followed by the
+      ghosts of the last gather.
+    */
+    template <class PositionSliceType>
+    void updatePositions( PositionSliceType& positions ) const
+    {
+        Cabana::Impl::ScopedProfileRegion region(
+            "Cajita::ParticleGridHalo::updatePositions" );
+        Cabana::updateGhosts( _halo, positions );
+        shiftGhosts( positions );
+    }
+
+  private:
+    halo_type _halo;
+    shift_view_type _ghost_shifts;
+    Kokkos::Array<double, NumSpaceDim> _global_extent;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create a particle halo from the geometry of a Cajita grid.
+
+  Every owned particle within the halo width of a face, edge, or corner of
+  the local domain is ghosted on the neighbor block across it, including
+  neighbors across periodic boundaries. A particle near a corner is sent to
+  each of the blocks sharing the corner. The exports are computed on the
+  device and the halo is built on the nearest neighbor topology of the grid
+  such that no global communication is needed to discover the neighbors.
+
+  \tparam LocalGridType Cajita LocalGrid type with a uniform mesh.
+
+  \tparam PositionSliceType Particle position type.
+
+  \param local_grid The local grid containing periodicity and system bounds.
+
+  \param positions The positions of the locally owned particles. All
+  particles must be within the local domain.
+
+  \param halo_width The width of the particle halo in number of cells.
+
+  \return The particle halo.
+*/
+template <class LocalGridType, class PositionSliceType>
+ParticleGridHalo<typename PositionSliceType::device_type,
+                 LocalGridType::num_space_dim>
+createParticleHalo( const LocalGridType& local_grid,
+                    const PositionSliceType& positions, const int halo_width )
+{
+    Cabana::Impl::ScopedProfileRegion region( "Cajita::createParticleHalo" );
+
+    static constexpr std::size_t num_space_dim = LocalGridType::num_space_dim;
+    using mesh_type = typename LocalGridType::mesh_type;
+    using scalar_type = typename mesh_type::scalar_type;
+    static_assert(
+        std::is_same<mesh_type, UniformMesh<scalar_type, num_space_dim>>::value,
+        "Particle halo requires a uniform mesh." );
+
+    using device_type = typename PositionSliceType::device_type;
+    using memory_space = typename device_type::memory_space;
+    using execution_space = typename device_type::execution_space;
+    using halo_type =
+        typename ParticleGridHalo<device_type, num_space_dim>::halo_type;
+    using shift_view_type =
+        typename ParticleGridHalo<device_type, num_space_dim>::shift_view_type;
+
+    // Number of neighbor directions, including this block, in the order of
+    // the topology [ni + 3*(nj + 3*nk) in 3d].
+    int num_dir = 1;
+    for ( std::size_t d = 0; d < num_space_dim; ++d )
+        num_dir *= 3;
+    const int self_dir = ( num_dir - 1 ) / 2;
+
+    // Get the neighbor ranks.
+    auto topology = Impl::getTopology( local_grid );
+    Kokkos::View<int*, Kokkos::HostSpace, Kokkos::MemoryUnmanaged>
+        topology_host( topology.data(), topology.size() );
+    auto neighbor_ranks =
+        Kokkos::create_mirror_view_and_copy( memory_space(), topology_host );
+
+    // Get the bands of the local domain in which particles are ghosted and
+    // the periodic shift of ghosts sent through each boundary.
+    const auto& local_mesh =
+        Cajita::createLocalMesh<Kokkos::HostSpace>( local_grid );
+    const auto& global_grid = local_grid.globalGrid();
+    const auto& global_mesh = global_grid.globalMesh();
+    Kokkos::Array<double, num_space_dim> band_low{};
+    Kokkos::Array<double, num_space_dim> band_high{};
+    Kokkos::Array<int, num_space_dim> shift_low{};
+    Kokkos::Array<int, num_space_dim> shift_high{};
+    Kokkos::Array<double, num_space_dim> global_extent{};
+    for ( std::size_t d = 0; d < num_space_dim; ++d )
+    {
+        auto width = halo_width * global_mesh.cellSize( d );
+        band_low[d] = local_mesh.lowCorner( Cajita::Own(), d ) + width;
+        band_high[d] = local_mesh.highCorner( Cajita::Own(), d ) - width;
+        bool periodic = global_grid.isPeriodic( d );
+        shift_low[d] = ( periodic && global_grid.onLowBoundary( d ) ) ? 1 : 0;
+        shift_high[d] =
+            ( periodic && global_grid.onHighBoundary( d ) ) ? -1 : 0;
+        global_extent[d] = global_mesh.extent( d );
+    }
+
+    // Get the neighbor direction offset of a direction in a dimension.
+    auto offset = KOKKOS_LAMBDA( const int dir, const std::size_t d )
+    {
+        int stride = 1;
+        for ( std::size_t dp = 0; dp < d; ++dp )
+            stride *= 3;
+        return ( dir / stride ) % 3 - 1;
+    };
+
+    // Determine if a particle is ghosted in a direction.
+    auto ghosted = KOKKOS_LAMBDA( const int p, const int dir )
+    {
+        if ( dir == self_dir || neighbor_ranks( dir ) < 0 )
+            return false;
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+        {
+            int o = offset( dir, d );
+            if ( ( o < 0 && !( positions( p, d ) < band_low[d] ) ) ||
+                 ( o > 0 && !( positions( p, d ) > band_high[d] ) ) )
+                return false;
+        }
+        return true;
+    };
+
+    // Count the exports of each particle.
+    const int num_local = positions.size();
+    Kokkos::View<int*, memory_space> export_offsets( "export_offsets",
+                                                     num_local + 1 );
+    int num_export = 0;
+    Kokkos::parallel_scan(
+        "Cajita::createParticleHalo::count",
+        Kokkos::RangePolicy<execution_space>( 0, num_local ),
+        KOKKOS_LAMBDA( const int p, int& offset_p, const bool final ) {
+            if ( final )
+                export_offsets( p ) = offset_p;
+            for ( int dir = 0; dir < num_dir; ++dir )
+                if ( ghosted( p, dir ) )
+                    ++offset_p;
+            if ( final && p == num_local - 1 )
+                export_offsets( num_local ) = offset_p;
+        },
+        num_export );
+
+    // Create the exports.
+    Kokkos::View<int*, memory_space> export_ids(
+        Kokkos::ViewAllocateWithoutInitializing( "export_ids" ), num_export );
+    Kokkos::View<int*, memory_space> export_ranks(
+        Kokkos::ViewAllocateWithoutInitializing( "export_ranks" ),
+        num_export );
+    Kokkos::View<int*, memory_space> export_dirs(
+        Kokkos::ViewAllocateWithoutInitializing( "export_dirs" ), num_export );
+    Kokkos::parallel_for(
+        "Cajita::createParticleHalo::exports",
+        Kokkos::RangePolicy<execution_space>( 0, num_local ),
+        KOKKOS_LAMBDA( const int p ) {
+            int e = export_offsets( p );
+            for ( int dir = 0; dir < num_dir; ++dir )
+                if ( ghosted( p, dir ) )
+                {
+                    export_ids( e ) = p;
+                    export_ranks( e ) = neighbor_ranks( dir );
+                    export_dirs( e ) = dir;
+                    ++e;
+                }
+        } );
+    Kokkos::fence();
+
+    // Build the halo on the grid topology.
+    halo_type halo( global_grid.comm(), num_local, export_ids, export_ranks,
+                    topology );
+
+    // Assign an export of each particle to each of its slots in the send
+    // buffer. Slots of the same particle sent to the same rank are
+    // interchangeable so each claims the first unclaimed export matching its
+    // rank.
+    const int num_n = halo.numNeighbor();
+    Kokkos::View<int*, Kokkos::HostSpace> slot_ranks_host( "slot_ranks",
+                                                           num_n );
+    Kokkos::View<std::size_t*, Kokkos::HostSpace> slot_offsets_host(
+        "slot_offsets", num_n + 1 );
+    slot_offsets_host( 0 ) = 0;
+    for ( int n = 0; n < num_n; ++n )
+    {
+        slot_ranks_host( n ) = halo.neighborRank( n );
+        slot_offsets_host( n + 1 ) =
+            slot_offsets_host( n ) + halo.numExport( n );
+    }
+    auto slot_ranks =
+        Kokkos::create_mirror_view_and_copy( memory_space(), slot_ranks_host );
+    auto slot_offsets = Kokkos::create_mirror_view_and_copy(
+        memory_space(), slot_offsets_host );
+    auto steering = halo.getExportSteering();
+    Kokkos::View<int*, memory_space> claimed( "claimed", num_export );
+    shift_view_type send_shifts( "send_shifts", halo.totalNumExport() );
+    Kokkos::parallel_for(
+        "Cajita::createParticleHalo::shifts",
+        Kokkos::RangePolicy<execution_space>( 0, halo.totalNumExport() ),
+        KOKKOS_LAMBDA( const int s ) {
+            int n = 0;
+            while ( slot_offsets( n + 1 ) <= static_cast<std::size_t>( s ) )
+                ++n;
+            int p = steering( s );
+            for ( int e = export_offsets( p ); e < export_offsets( p + 1 );
+                  ++e )
+            {
+                if ( export_ranks( e ) == slot_ranks( n ) &&
+                     0 == Kokkos::atomic_compare_exchange( &claimed( e ), 0,
+                                                           1 ) )
+                {
+                    for ( std::size_t d = 0; d < num_space_dim; ++d )
+                    {
+                        int o = offset( export_dirs( e ), d );
+                        send_shifts( s, d ) =
+                            ( o < 0 ) ? shift_low[d]
+                                      : ( ( o > 0 ) ? shift_high[d] : 0 );
+                    }
+                    break;
+                }
+            }
+        } );
+    Kokkos::fence();
+
+    // Send the shifts to the ghosts. The send and receive buffers are
+    // contiguous by neighbor in the order of the halo gather.
+    auto send_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), send_shifts );
+    typename shift_view_type::HostMirror recv_host( "ghost_shifts",
+                                                    halo.numGhost() );
+    const int mpi_tag = 3456;
+    std::vector<MPI_Request> requests( 2 * num_n );
+    std::size_t send_offset = 0;
+    std::size_t recv_offset = 0;
+    for ( int n = 0; n < num_n; ++n )
+    {
+        MPI_Irecv( recv_host.data() + recv_offset,
+                   halo.numImport( n ) * num_space_dim, MPI_INT,
+                   halo.neighborRank( n ), mpi_tag, halo.comm(),
+                   &requests[n] );
+        recv_offset += halo.numImport( n ) * num_space_dim;
+        MPI_Isend( send_host.data() + send_offset,
+                   halo.numExport( n ) * num_space_dim, MPI_INT,
+                   halo.neighborRank( n ), mpi_tag, halo.comm(),
+                   &requests[num_n + n] );
+        send_offset += halo.numExport( n ) * num_space_dim;
+    }
+    const int ec = MPI_Waitall( requests.size(), requests.data(),
+                                MPI_STATUSES_IGNORE );
+    if ( MPI_SUCCESS != ec )
+        throw std::logic_error( "Failed MPI Communication" );
+    auto ghost_shifts =
+        Kokkos::create_mirror_view_and_copy( memory_space(), recv_host );
+
+    return ParticleGridHalo<device_type, num_space_dim>( halo, ghost_shifts,
+                                                         global_extent );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cajita
+
+#endif // end CAJITA_PARTICLEGRIDHALO_HPP
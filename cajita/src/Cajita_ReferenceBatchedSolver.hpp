@@ -0,0 +1,640 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cajita_ReferenceBatchedSolver.hpp
+  \brief Reference batched conjugate gradient for independent systems
+*/
+#ifndef CAJITA_REFERENCEBATCHEDSOLVER_HPP
+#define CAJITA_REFERENCEBATCHEDSOLVER_HPP
+
+#include <Cajita_Array.hpp>
+#include <Cajita_GlobalGrid.hpp>
+#include <Cajita_Halo.hpp>
+#include <Cajita_IndexSpace.hpp>
+#include <Cajita_LocalGrid.hpp>
+#include <Cajita_MpiTraits.hpp>
+#include <Cajita_Types.hpp>
+
+#include <impl/Cabana_Profiling.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <mpi.h>
+
+namespace Cajita
+{
+//! \cond Impl
+namespace Impl
+{
+//---------------------------------------------------------------------------//
+// Reduction of one value for each system of a batch.
+template <class Scalar>
+struct BatchedReduction
+{
+    typedef Scalar value_type[];
+    unsigned value_count;
+
+    KOKKOS_INLINE_FUNCTION
+    void join( volatile Scalar* dst, const volatile Scalar* src ) const
+    {
+        for ( unsigned n = 0; n < value_count; ++n )
+            dst[n] += src[n];
+    }
+
+    KOKKOS_INLINE_FUNCTION void init( Scalar* sum ) const
+    {
+        for ( unsigned n = 0; n < value_count; ++n )
+            sum[n] = 0.0;
+    }
+};
+
+//---------------------------------------------------------------------------//
+// Apply the stencil matrix of each system, out = M in, and reduce out * in.
+// The entries of system l are stored at l * stencil_size + s. Only nonzero
+// entries are applied, as ghosts outside of non-periodic boundaries are
+// never written and zero entries must not pick up their values.
+template <class StencilView, class MatrixView, class VectorView, class Scalar>
+struct BatchedApplyStencil : BatchedReduction<Scalar>
+{
+    StencilView stencil;
+    MatrixView matrix;
+    VectorView in;
+    VectorView out;
+
+    BatchedApplyStencil( const StencilView& stencil_, const MatrixView& matrix_,
+                         const VectorView& in_, const VectorView& out_,
+                         const unsigned num_system )
+        : stencil( stencil_ )
+        , matrix( matrix_ )
+        , in( in_ )
+        , out( out_ )
+    {
+        this->value_count = num_system;
+    }
+
+    KOKKOS_INLINE_FUNCTION Scalar apply( const int i, const int j,
+                                         const int k, const int l ) const
+    {
+        const int ns = stencil.extent( 0 );
+        Scalar result = 0.0;
+        for ( int s = 0; s < ns; ++s )
+            if ( fabs( matrix( i, j, k, l * ns + s ) ) > 0.0 )
+                result += matrix( i, j, k, l * ns + s ) *
+                          in( i + stencil( s, Dim::I ),
+                              j + stencil( s, Dim::J ),
+                              k + stencil( s, Dim::K ), l );
+        return result;
+    }
+
+    KOKKOS_INLINE_FUNCTION Scalar apply( const int i, const int j,
+                                         const int l ) const
+    {
+        const int ns = stencil.extent( 0 );
+        Scalar result = 0.0;
+        for ( int s = 0; s < ns; ++s )
+            if ( fabs( matrix( i, j, l * ns + s ) ) > 0.0 )
+                result += matrix( i, j, l * ns + s ) *
+                          in( i + stencil( s, Dim::I ),
+                              j + stencil( s, Dim::J ), l );
+        return result;
+    }
+
+    KOKKOS_INLINE_FUNCTION void
+    operator()( const std::integral_constant<std::size_t, 3>&, const int i,
+                const int j, const int k, const int l, Scalar* sum ) const
+    {
+        Scalar result = apply( i, j, k, l );
+        out( i, j, k, l ) = result;
+        sum[l] += result * in( i, j, k, l );
+    }
+
+    KOKKOS_INLINE_FUNCTION void
+    operator()( const std::integral_constant<std::size_t, 2>&, const int i,
+                const int j, const int l, Scalar* sum ) const
+    {
+        Scalar result = apply( i, j, l );
+        out( i, j, l ) = result;
+        sum[l] += result * in( i, j, l );
+    }
+};
+
+//---------------------------------------------------------------------------//
+// Compute the residual r = b - q of each system from the matrix application
+// q and reduce r * r.
+template <class VectorView, class RHSView, class Scalar>
+struct BatchedResidual : BatchedReduction<Scalar>
+{
+    RHSView b;
+    VectorView q;
+    VectorView r;
+
+    BatchedResidual( const RHSView& b_, const VectorView& q_,
+                     const VectorView& r_, const unsigned num_system )
+        : b( b_ )
+        , q( q_ )
+        , r( r_ )
+    {
+        this->value_count = num_system;
+    }
+
+    KOKKOS_INLINE_FUNCTION void
+    operator()( const std::integral_constant<std::size_t, 3>&, const int i,
+                const int j, const int k, const int l, Scalar* sum ) const
+    {
+        Scalar r_new = b( i, j, k, l ) - q( i, j, k, l );
+        r( i, j, k, l ) = r_new;
+        sum[l] += r_new * r_new;
+    }
+
+    KOKKOS_INLINE_FUNCTION void
+    operator()( const std::integral_constant<std::size_t, 2>&, const int i,
+                const int j, const int l, Scalar* sum ) const
+    {
+        Scalar r_new = b( i, j, l ) - q( i, j, l );
+        r( i, j, l ) = r_new;
+        sum[l] += r_new * r_new;
+    }
+};
+
+//---------------------------------------------------------------------------//
+// Update x += alpha p and r -= alpha q of each system and reduce r * r.
+template <class SolutionView, class VectorView, class CoeffView, class Scalar>
+struct BatchedUpdate : BatchedReduction<Scalar>
+{
+    SolutionView x;
+    VectorView r;
+    VectorView p;
+    VectorView q;
+    CoeffView alpha;
+
+    BatchedUpdate( const SolutionView& x_, const VectorView& r_,
+                   const VectorView& p_, const VectorView& q_,
+                   const CoeffView& alpha_, const unsigned num_system )
+        : x( x_ )
+        , r( r_ )
+        , p( p_ )
+        , q( q_ )
+        , alpha( alpha_ )
+    {
+        this->value_count = num_system;
+    }
+
+    KOKKOS_INLINE_FUNCTION void
+    operator()( const std::integral_constant<std::size_t, 3>&, const int i,
+                const int j, const int k, const int l, Scalar* sum ) const
+    {
+        x( i, j, k, l ) += alpha( l ) * p( i, j, k, l );
+        Scalar r_new = r( i, j, k, l ) - alpha( l ) * q( i, j, k, l );
+        r( i, j, k, l ) = r_new;
+        sum[l] += r_new * r_new;
+    }
+
+    KOKKOS_INLINE_FUNCTION void
+    operator()( const std::integral_constant<std::size_t, 2>&, const int i,
+                const int j, const int l, Scalar* sum ) const
+    {
+        x( i, j, l ) += alpha( l ) * p( i, j, l );
+        Scalar r_new = r( i, j, l ) - alpha( l ) * q( i, j, l );
+        r( i, j, l ) = r_new;
+        sum[l] += r_new * r_new;
+    }
+};
+
+//---------------------------------------------------------------------------//
+// Update the search direction p = z + beta p of each system.
+template <class VectorView, class CoeffView>
+struct BatchedDirection
+{
+    VectorView z;
+    VectorView p;
+    CoeffView beta;
+
+    KOKKOS_INLINE_FUNCTION void
+    operator()( const std::integral_constant<std::size_t, 3>&, const int i,
+                const int j, const int k, const int l ) const
+    {
+        p( i, j, k, l ) = z( i, j, k, l ) + beta( l ) * p( i, j, k, l );
+    }
+
+    KOKKOS_INLINE_FUNCTION void
+    operator()( const std::integral_constant<std::size_t, 2>&, const int i,
+                const int j, const int l ) const
+    {
+        p( i, j, l ) = z( i, j, l ) + beta( l ) * p( i, j, l );
+    }
+};
+} // end namespace Impl
+//! \endcond
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Reference preconditioned conjugate gradient for a batch of
+  independent structured systems.
+
+  \tparam Scalar The scalar type of the solver vectors.
+  \tparam EntityType The entity type of the systems.
+  \tparam MeshType The mesh type.
+  \tparam DeviceType The Kokkos device type.
+
+  The systems share the grid and the stencils of the matrix and the
+  preconditioner and are stored as the degrees of freedom of the vectors:
+  degree of freedom l of a vector is the vector of system l. Every iteration
+  updates all systems with the same kernel launches and reduces the dot
+  products of all systems together. Converged systems are masked out and
+  keep their solution while the others continue.
+*/
+template <class Scalar, class EntityType, class MeshType, class DeviceType>
+class ReferenceBatchedConjugateGradient
+{
+  public:
+    //! Entity type.
+    using entity_type = EntityType;
+    //! Kokkos device type.
+    using device_type = DeviceType;
+    //! Scalar value type.
+    using value_type = Scalar;
+    //! Kokkos execution space.
+    using execution_space = typename device_type::execution_space;
+    //! Kokkos memory space.
+    using memory_space = typename device_type::memory_space;
+    //! Array type.
+    using Array_t = Array<Scalar, EntityType, MeshType, DeviceType>;
+    //! Spatial dimension.
+    static constexpr std::size_t num_space_dim = MeshType::num_space_dim;
+
+    /*!
+      \brief Constructor.
+      \param layout The layout of the batched vectors. Each degree of freedom
+      is one system.
+    */
+    ReferenceBatchedConjugateGradient(
+        const ArrayLayout<EntityType, MeshType>& layout )
+        : _num_system( layout.dofsPerEntity() )
+        , _tol( 1.0e-6 )
+        , _max_iter( 1000 )
+        , _print_level( 0 )
+        , _num_iter( _num_system, 0 )
+        , _residual_norm( _num_system, 0.0 )
+    {
+        // Array layout for vectors (p,z,r,q) of all systems.
+        auto vector_layout = createArrayLayout(
+            layout.localGrid(), 4 * _num_system, EntityType() );
+        _vectors = createArray<Scalar, DeviceType>( "batched_cg_vectors",
+                                                    vector_layout );
+        _coeffs = Kokkos::View<Scalar*, DeviceType>( "batched_cg_coeffs",
+                                                     _num_system );
+    }
+
+    //! Get the number of systems in the batch.
+    int numSystem() const { return _num_system; }
+
+    /*!
+      \brief Set the matrix stencil shared by all systems.
+      \param stencil The (i,j,k) offsets describing the structured matrix
+      entries at each grid point. Offsets are defined relative to an index.
+    */
+    void setMatrixStencil(
+        const std::vector<std::array<int, num_space_dim>>& stencil )
+    {
+        setStencil( stencil, _A_stencil, _A_halo, _A );
+    }
+
+    /*!
+      \brief Get the matrix values.
+      \return The matrix entry values. For each entity the entry of stencil
+      element s of system l is degree of freedom l * stencil_size + s. Values
+      corresponding to stencil entries outside of the domain should be set to
+      zero.
+    */
+    const Array_t& getMatrixValues() { return *_A; }
+
+    /*!
+      \brief Set the preconditioner stencil shared by all systems.
+      \param stencil The (i,j,k) offsets describing the structured
+      preconditioner entries at each grid point.
+    */
+    void setPreconditionerStencil(
+        const std::vector<std::array<int, num_space_dim>>& stencil )
+    {
+        setStencil( stencil, _M_stencil, _M_halo, _M );
+    }
+
+    /*!
+      \brief Get the preconditioner values. Stored in the same order as the
+      matrix values.
+    */
+    const Array_t& getPreconditionerValues() { return *_M; }
+
+    //! Set the relative residual norm at which each system is converged.
+    void setTolerance( const double tol ) { _tol = tol; }
+
+    //! Set the maximum number of iterations.
+    void setMaxIter( const int max_iter ) { _max_iter = max_iter; }
+
+    //! Set the output level.
+    void setPrintLevel( const int print_level ) { _print_level = print_level; }
+
+    /*!
+      \brief Solve the problems Ax = b for x.
+      \param b The forcing terms with one degree of freedom per system.
+      \param x The solutions with one degree of freedom per system.
+    */
+    void solve( const Array_t& b, Array_t& x )
+    {
+        Cabana::Impl::ScopedProfileRegion region(
+            "Cajita::ReferenceBatchedConjugateGradient::solve" );
+
+        if ( !_A || !_M )
+            throw std::runtime_error(
+                "Matrix and preconditioner values must be set to solve" );
+        if ( b.layout()->dofsPerEntity() != _num_system ||
+             x.layout()->dofsPerEntity() != _num_system )
+            throw std::runtime_error(
+                "Batched vectors must have one entry per system" );
+
+        // Get the local grid.
+        auto local_grid = _vectors->layout()->localGrid();
+        bool print = 0 == local_grid->globalGrid().blockId();
+
+        // Print banner
+        if ( 1 <= _print_level && print )
+            std::cout << std::endl
+                      << "Batched preconditioned conjugate gradient"
+                      << std::endl;
+
+        // Index space of the owned entities of all systems.
+        auto space = b.layout()->indexSpace( Own(), Local() );
+
+        // Subarrays.
+        auto p = createSubarray( *_vectors, 0, _num_system );
+        auto z = createSubarray( *_vectors, _num_system, 2 * _num_system );
+        auto r = createSubarray( *_vectors, 2 * _num_system, 3 * _num_system );
+        auto q = createSubarray( *_vectors, 3 * _num_system, 4 * _num_system );
+
+        // Views.
+        auto x_view = x.view();
+        auto b_view = b.view();
+        auto p_view = p->view();
+        auto z_view = z->view();
+        auto r_view = r->view();
+        auto q_view = q->view();
+        auto coeffs_host =
+            Kokkos::create_mirror_view( Kokkos::HostSpace(), _coeffs );
+
+        // Reset iteration counts.
+        for ( auto& n : _num_iter )
+            n = 0;
+
+        // Compute the norms of the RHS.
+        std::vector<Scalar> b_norm( _num_system );
+        ArrayOp::norm2( b, b_norm );
+
+        // Compute the initial residuals and norms from x copied into p and
+        // mask out the converged systems.
+        std::vector<Scalar> rr( _num_system );
+        std::vector<Scalar> rz( _num_system );
+        std::vector<Scalar> rz_new( _num_system );
+        std::vector<Scalar> pq( _num_system );
+        Kokkos::deep_copy( p_view, x_view );
+        _A_halo->gather( execution_space(), *p );
+        reduce( "batched_cg_compute_q0", space,
+                createApplyStencil( _A_stencil, *_A, p_view, q_view ), pq );
+        reduce( "batched_cg_compute_r0", space,
+                Impl::BatchedResidual<decltype( r_view ), decltype( b_view ),
+                                      Scalar>( b_view, q_view, r_view,
+                                               _num_system ),
+                rr );
+        std::vector<bool> active( _num_system );
+        int num_active = updateNorms( rr, b_norm, active );
+
+        // Compute the initial preconditioned residuals and directions.
+        _M_halo->gather( execution_space(), *r );
+        reduce( "batched_cg_compute_z0", space,
+                createApplyStencil( _M_stencil, *_M, r_view, z_view ), rz );
+        Kokkos::deep_copy( p_view, z_view );
+
+        // Iterate.
+        int iter = 0;
+        while ( num_active > 0 && iter < _max_iter )
+        {
+            // Compute A*p and pT*A*p.
+            _A_halo->gather( execution_space(), *p );
+            reduce( "batched_cg_compute_q", space,
+                    createApplyStencil( _A_stencil, *_A, p_view, q_view ), pq );
+
+            // Update x, r, and the residual norms of the active systems.
+            for ( int l = 0; l < _num_system; ++l )
+                coeffs_host( l ) = active[l] ? rz[l] / pq[l] : 0.0;
+            Kokkos::deep_copy( _coeffs, coeffs_host );
+            reduce( "batched_cg_update", space,
+                    Impl::BatchedUpdate<decltype( x_view ), decltype( r_view ),
+                                        decltype( _coeffs ), Scalar>(
+                        x_view, r_view, p_view, q_view, _coeffs, _num_system ),
+                    rr );
+            for ( int l = 0; l < _num_system; ++l )
+                if ( active[l] )
+                    ++_num_iter[l];
+            ++iter;
+            num_active = updateNorms( rr, b_norm, active );
+
+            // Output result
+            if ( 2 == _print_level && print )
+                std::cout << "Iteration " << iter << ": " << num_active
+                          << " of " << _num_system << " systems active"
+                          << std::endl;
+
+            if ( 0 == num_active )
+                break;
+
+            // Precondition the residuals and update the directions.
+            _M_halo->gather( execution_space(), *r );
+            reduce( "batched_cg_compute_z", space,
+                    createApplyStencil( _M_stencil, *_M, r_view, z_view ),
+                    rz_new );
+            for ( int l = 0; l < _num_system; ++l )
+                coeffs_host( l ) = active[l] ? rz_new[l] / rz[l] : 0.0;
+            Kokkos::deep_copy( _coeffs, coeffs_host );
+            Impl::BatchedDirection<decltype( z_view ), decltype( _coeffs )>
+                direction{ z_view, p_view, _coeffs };
+            Kokkos::parallel_for(
+                "batched_cg_direction",
+                createExecutionPolicy( space, execution_space(), dim_tag{} ),
+                direction );
+            rz = rz_new;
+        }
+
+        // Output end state.
+        if ( 1 <= _print_level && print )
+            std::cout << "Finished in " << iter << " iterations, "
+                      << _num_system - num_active << " of " << _num_system
+                      << " systems converged" << std::endl
+                      << std::endl;
+
+        // If a system did not converge throw.
+        if ( num_active > 0 )
+            throw std::runtime_error( "Batched CG solver did not converge" );
+    }
+
+    //! Get the number of iterations taken by a system on the last solve.
+    int getNumIter( const int system ) const { return _num_iter[system]; }
+
+    //! Get the relative residual norm achieved by a system on the last solve.
+    double getFinalRelativeResidualNorm( const int system ) const
+    {
+        return _residual_norm[system];
+    }
+
+  private:
+    using dim_tag = std::integral_constant<std::size_t, num_space_dim>;
+    using stencil_view = Kokkos::View<int* [num_space_dim], DeviceType>;
+
+    // Create the stencil application functor of a matrix.
+    template <class VectorView>
+    Impl::BatchedApplyStencil<stencil_view, typename Array_t::view_type,
+                              VectorView, Scalar>
+    createApplyStencil( const stencil_view& stencil, const Array_t& matrix,
+                        const VectorView& in, const VectorView& out ) const
+    {
+        return Impl::BatchedApplyStencil<
+            stencil_view, typename Array_t::view_type, VectorView, Scalar>(
+            stencil, matrix.view(), in, out, _num_system );
+    }
+
+    // Reduce one value per system over the owned entities and all ranks.
+    template <class FunctorType>
+    void reduce( const std::string& label,
+                 const IndexSpace<num_space_dim + 1>& space,
+                 const FunctorType& functor, std::vector<Scalar>& result )
+    {
+        Kokkos::parallel_reduce(
+            label, createExecutionPolicy( space, execution_space(), dim_tag{} ),
+            functor, result.data() );
+        MPI_Allreduce( MPI_IN_PLACE, result.data(), _num_system,
+                       MpiTraits<Scalar>::type(), MPI_SUM,
+                       _vectors->layout()->localGrid()->globalGrid().comm() );
+    }
+
+    // Update the relative residual norms and the mask of active systems.
+    // Returns the number of active systems.
+    int updateNorms( const std::vector<Scalar>& rr,
+                     const std::vector<Scalar>& b_norm,
+                     std::vector<bool>& active )
+    {
+        int num_active = 0;
+        for ( int l = 0; l < _num_system; ++l )
+        {
+            _residual_norm[l] = std::sqrt( rr[l] ) / b_norm[l];
+            active[l] = _residual_norm[l] > _tol;
+            if ( active[l] )
+                ++num_active;
+        }
+        return num_active;
+    }
+
+    // Set the stencil of a matrix.
+    void setStencil( const std::vector<std::array<int, num_space_dim>>& stencil,
+                     stencil_view& device_stencil,
+                     std::shared_ptr<Halo<memory_space>>& halo,
+                     std::shared_ptr<Array_t>& matrix )
+    {
+        // Get the local grid.
+        auto local_grid = _vectors->layout()->localGrid();
+
+        // Copy stencil to the device.
+        device_stencil = stencil_view(
+            Kokkos::ViewAllocateWithoutInitializing( "stencil" ),
+            stencil.size() );
+        auto stencil_mirror =
+            Kokkos::create_mirror_view( Kokkos::HostSpace(), device_stencil );
+        for ( unsigned s = 0; s < stencil.size(); ++s )
+            for ( std::size_t d = 0; d < num_space_dim; ++d )
+                stencil_mirror( s, d ) = stencil[s][d];
+        Kokkos::deep_copy( device_stencil, stencil_mirror );
+
+        // Compose the halo pattern and compute how wide the halo needs to be
+        // to gather all elements accessed by the stencil.
+        std::set<std::array<int, num_space_dim>> neighbor_set;
+        std::array<int, num_space_dim> neighbor;
+        int width = 0;
+        for ( auto s : stencil )
+        {
+            for ( std::size_t d = 0; d < num_space_dim; ++d )
+            {
+                neighbor[d] = ( s[d] == 0 ) ? 0 : s[d] / std::abs( s[d] );
+                width = std::max( width, std::abs( s[d] ) );
+            }
+            neighbor_set.emplace( neighbor );
+        }
+        std::vector<std::array<int, num_space_dim>> halo_neighbors(
+            neighbor_set.begin(), neighbor_set.end() );
+
+        // Build the halo for the vectors of all systems.
+        auto halo_layout =
+            createArrayLayout( local_grid, _num_system, EntityType() );
+        HaloPattern<num_space_dim> pattern;
+        pattern.setNeighbors( halo_neighbors );
+        halo = createHalo<Scalar, DeviceType>( *halo_layout, pattern, width );
+
+        // Allocate the matrix.
+        auto matrix_layout = createArrayLayout(
+            local_grid, stencil.size() * _num_system, EntityType() );
+        matrix = createArray<Scalar, DeviceType>( "matrix", matrix_layout );
+    }
+
+  private:
+    int _num_system;
+    Scalar _tol;
+    int _max_iter;
+    int _print_level;
+    std::vector<int> _num_iter;
+    std::vector<Scalar> _residual_norm;
+    stencil_view _A_stencil;
+    stencil_view _M_stencil;
+    std::shared_ptr<Halo<memory_space>> _A_halo;
+    std::shared_ptr<Halo<memory_space>> _M_halo;
+    std::shared_ptr<Array_t> _A;
+    std::shared_ptr<Array_t> _M;
+    std::shared_ptr<Array_t> _vectors;
+    Kokkos::View<Scalar*, DeviceType> _coeffs;
+};
+
+//---------------------------------------------------------------------------//
+// Builders.
+//---------------------------------------------------------------------------//
+//! Creation function for reference batched preconditioned conjugate
+//! gradient.
+template <class Scalar, class DeviceType, class EntityType, class MeshType>
+std::shared_ptr<
+    ReferenceBatchedConjugateGradient<Scalar, EntityType, MeshType, DeviceType>>
+createReferenceBatchedConjugateGradient(
+    const ArrayLayout<EntityType, MeshType>& layout )
+{
+    return std::make_shared<ReferenceBatchedConjugateGradient<
+        Scalar, EntityType, MeshType, DeviceType>>( layout );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cajita
+
+#endif // end CAJITA_REFERENCEBATCHEDSOLVER_HPP
@@ -0,0 +1,517 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cajita_ReferenceMultigrid.hpp
+  \brief Reference geometric multigrid preconditioner
+*/
+#ifndef CAJITA_REFERENCEMULTIGRID_HPP
+#define CAJITA_REFERENCEMULTIGRID_HPP
+
+#include <Cajita_Array.hpp>
+#include <Cajita_GlobalGrid.hpp>
+#include <Cajita_GlobalMesh.hpp>
+#include <Cajita_Halo.hpp>
+#include <Cajita_IndexSpace.hpp>
+#include <Cajita_LocalGrid.hpp>
+#include <Cajita_Parallel.hpp>
+#include <Cajita_Partitioner.hpp>
+#include <Cajita_Types.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <array>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <mpi.h>
+
+namespace Cajita
+{
+//! \cond Impl
+namespace Impl
+{
+//---------------------------------------------------------------------------//
+// Constant coefficient Laplacian alpha * (2d u_i - sum_n u_n) on a multigrid
+// level. Neighbors outside of non-periodic boundaries are zero.
+template <class Scalar, std::size_t NumSpaceDim>
+struct MultigridLevelOperator
+{
+    Scalar alpha;
+    int offset[NumSpaceDim];
+    int num_cell[NumSpaceDim];
+    bool periodic[NumSpaceDim];
+
+    KOKKOS_INLINE_FUNCTION Scalar diagonal() const
+    {
+        return 2.0 * NumSpaceDim * alpha;
+    }
+
+    // Whether the neighbor of a local index in the given direction exists.
+    KOKKOS_INLINE_FUNCTION bool hasNeighbor( const int d, const int i,
+                                             const int dir ) const
+    {
+        int g = i + offset[d] + dir;
+        return periodic[d] || ( g >= 0 && g < num_cell[d] );
+    }
+
+    template <class ViewType>
+    KOKKOS_INLINE_FUNCTION Scalar apply( const ViewType& u, const int i,
+                                         const int j, const int k ) const
+    {
+        Scalar result = diagonal() * u( i, j, k, 0 );
+        if ( hasNeighbor( Dim::I, i, -1 ) )
+            result -= alpha * u( i - 1, j, k, 0 );
+        if ( hasNeighbor( Dim::I, i, 1 ) )
+            result -= alpha * u( i + 1, j, k, 0 );
+        if ( hasNeighbor( Dim::J, j, -1 ) )
+            result -= alpha * u( i, j - 1, k, 0 );
+        if ( hasNeighbor( Dim::J, j, 1 ) )
+            result -= alpha * u( i, j + 1, k, 0 );
+        if ( hasNeighbor( Dim::K, k, -1 ) )
+            result -= alpha * u( i, j, k - 1, 0 );
+        if ( hasNeighbor( Dim::K, k, 1 ) )
+            result -= alpha * u( i, j, k + 1, 0 );
+        return result;
+    }
+
+    template <class ViewType>
+    KOKKOS_INLINE_FUNCTION Scalar apply( const ViewType& u, const int i,
+                                         const int j ) const
+    {
+        Scalar result = diagonal() * u( i, j, 0 );
+        if ( hasNeighbor( Dim::I, i, -1 ) )
+            result -= alpha * u( i - 1, j, 0 );
+        if ( hasNeighbor( Dim::I, i, 1 ) )
+            result -= alpha * u( i + 1, j, 0 );
+        if ( hasNeighbor( Dim::J, j, -1 ) )
+            result -= alpha * u( i, j - 1, 0 );
+        if ( hasNeighbor( Dim::J, j, 1 ) )
+            result -= alpha * u( i, j + 1, 0 );
+        return result;
+    }
+};
+
+//---------------------------------------------------------------------------//
+// Compute t = u_scale * u + r_scale * ( f - A u ). Gives the residual with
+// u_scale = 0 and r_scale = 1 and a weighted Jacobi sweep with u_scale = 1
+// and r_scale = weight / diagonal.
+template <class OperatorType, class ViewType, class Scalar>
+struct MultigridResidual
+{
+    OperatorType op;
+    ViewType u;
+    ViewType f;
+    ViewType t;
+    Scalar u_scale;
+    Scalar r_scale;
+
+    KOKKOS_INLINE_FUNCTION void
+    operator()( const std::integral_constant<std::size_t, 3>&, const int i,
+                const int j, const int k ) const
+    {
+        t( i, j, k, 0 ) =
+            u_scale * u( i, j, k, 0 ) +
+            r_scale * ( f( i, j, k, 0 ) - op.apply( u, i, j, k ) );
+    }
+
+    KOKKOS_INLINE_FUNCTION void
+    operator()( const std::integral_constant<std::size_t, 2>&, const int i,
+                const int j ) const
+    {
+        t( i, j, 0 ) = u_scale * u( i, j, 0 ) +
+                       r_scale * ( f( i, j, 0 ) - op.apply( u, i, j ) );
+    }
+};
+
+//---------------------------------------------------------------------------//
+// Restrict a fine level residual to the right hand side of the next coarser
+// level by averaging the fine cells of each coarse cell.
+template <class ViewType, class Scalar, std::size_t NumSpaceDim>
+struct MultigridRestriction
+{
+    ViewType fine;
+    ViewType coarse;
+    int fine_min[NumSpaceDim];
+    int coarse_min[NumSpaceDim];
+
+    KOKKOS_INLINE_FUNCTION void
+    operator()( const std::integral_constant<std::size_t, 3>&, const int i,
+                const int j, const int k ) const
+    {
+        int fi = 2 * ( i - coarse_min[Dim::I] ) + fine_min[Dim::I];
+        int fj = 2 * ( j - coarse_min[Dim::J] ) + fine_min[Dim::J];
+        int fk = 2 * ( k - coarse_min[Dim::K] ) + fine_min[Dim::K];
+        Scalar sum = 0.0;
+        for ( int di = 0; di < 2; ++di )
+            for ( int dj = 0; dj < 2; ++dj )
+                for ( int dk = 0; dk < 2; ++dk )
+                    sum += fine( fi + di, fj + dj, fk + dk, 0 );
+        coarse( i, j, k, 0 ) = 0.125 * sum;
+    }
+
+    KOKKOS_INLINE_FUNCTION void
+    operator()( const std::integral_constant<std::size_t, 2>&, const int i,
+                const int j ) const
+    {
+        int fi = 2 * ( i - coarse_min[Dim::I] ) + fine_min[Dim::I];
+        int fj = 2 * ( j - coarse_min[Dim::J] ) + fine_min[Dim::J];
+        Scalar sum = 0.0;
+        for ( int di = 0; di < 2; ++di )
+            for ( int dj = 0; dj < 2; ++dj )
+                sum += fine( fi + di, fj + dj, 0 );
+        coarse( i, j, 0 ) = 0.25 * sum;
+    }
+};
+
+//---------------------------------------------------------------------------//
+// Add the correction of the next coarser level to each of its fine cells.
+template <class ViewType, std::size_t NumSpaceDim>
+struct MultigridProlongation
+{
+    ViewType coarse;
+    ViewType fine;
+    int fine_min[NumSpaceDim];
+    int coarse_min[NumSpaceDim];
+
+    KOKKOS_INLINE_FUNCTION void
+    operator()( const std::integral_constant<std::size_t, 3>&, const int i,
+                const int j, const int k ) const
+    {
+        fine( i, j, k, 0 ) +=
+            coarse( ( i - fine_min[Dim::I] ) / 2 + coarse_min[Dim::I],
+                    ( j - fine_min[Dim::J] ) / 2 + coarse_min[Dim::J],
+                    ( k - fine_min[Dim::K] ) / 2 + coarse_min[Dim::K], 0 );
+    }
+
+    KOKKOS_INLINE_FUNCTION void
+    operator()( const std::integral_constant<std::size_t, 2>&, const int i,
+                const int j ) const
+    {
+        fine( i, j, 0 ) +=
+            coarse( ( i - fine_min[Dim::I] ) / 2 + coarse_min[Dim::I],
+                    ( j - fine_min[Dim::J] ) / 2 + coarse_min[Dim::J], 0 );
+    }
+};
+} // end namespace Impl
+//! \endcond
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Reference geometric multigrid V-cycle preconditioner for cell
+  centered Poisson problems.
+
+  \tparam Scalar The scalar type of the solver vectors.
+  \tparam MeshType The uniform mesh type.
+  \tparam DeviceType The Kokkos device type.
+
+  Each application performs one V-cycle on the constant coefficient Laplacian
+  alpha * (2d u_i - sum_n u_n), where neighbors outside of non-periodic
+  boundaries are zero. Coarse levels halve the number of cells in each
+  dimension, restrict by averaging, prolong by injection, and use the
+  Galerkin coefficient alpha / 2 of the next finer level. Smoothing uses
+  weighted Jacobi sweeps before and after the coarse correction and the
+  coarsest level is approximated with a fixed number of sweeps, which keeps
+  the preconditioner symmetric for use with conjugate gradient.
+
+  Coarsening keeps the domain decomposition of the fine grid such that
+  restriction and prolongation need no communication. It stops when a level
+  has an odd number of cells on some rank or the coarse blocks do not align
+  with the fine blocks.
+*/
+template <class Scalar, class MeshType, class DeviceType>
+class ReferenceMultigrid
+{
+  public:
+    static_assert( isUniformMesh<MeshType>::value,
+                   "Reference multigrid requires a uniform mesh" );
+
+    //! Scalar value type.
+    using value_type = Scalar;
+    //! Kokkos device type.
+    using device_type = DeviceType;
+    //! Kokkos memory space.
+    using memory_space = typename device_type::memory_space;
+    //! Kokkos execution space.
+    using execution_space = typename device_type::execution_space;
+    //! Level array type.
+    using Array_t = Array<Scalar, Cell, MeshType, DeviceType>;
+    //! Spatial dimension.
+    static constexpr std::size_t num_space_dim = MeshType::num_space_dim;
+
+    /*!
+      \brief Constructor.
+      \param layout The layout of the vectors to precondition. Its local grid
+      must have a halo of at least one cell.
+      \param alpha The coefficient of the Laplacian on the finest level, e.g.
+      one over the squared cell size.
+      \param max_levels The maximum number of levels including the finest.
+    */
+    ReferenceMultigrid( const ArrayLayout<Cell, MeshType>& layout,
+                        const Scalar alpha = 1.0, const int max_levels = 20 )
+        : _num_smooth( 2 )
+        , _num_coarse_sweep( 20 )
+        , _weight( 2.0 / 3.0 )
+    {
+        auto local_grid = layout.localGrid();
+        if ( local_grid->haloCellWidth() < 1 )
+            throw std::runtime_error(
+                "Multigrid requires a halo of at least one cell" );
+
+        addLevel( local_grid, alpha );
+        while ( static_cast<int>( _levels.size() ) < max_levels )
+        {
+            auto coarse_grid = coarsen( _levels.back().local_grid );
+            if ( !coarse_grid )
+                break;
+            addLevel( coarse_grid, 0.5 * _levels.back().op.alpha );
+        }
+    }
+
+    //! Set the number of Jacobi sweeps before and after each coarse
+    //! correction.
+    void setNumSmooth( const int num_smooth ) { _num_smooth = num_smooth; }
+
+    //! Set the number of Jacobi sweeps on the coarsest level.
+    void setNumCoarseSweep( const int num_sweep )
+    {
+        _num_coarse_sweep = num_sweep;
+    }
+
+    //! Set the weight of the Jacobi sweeps.
+    void setJacobiWeight( const Scalar weight ) { _weight = weight; }
+
+    //! Get the number of levels including the finest.
+    int numLevels() const { return _levels.size(); }
+
+    /*!
+      \brief Apply one V-cycle, z = M r.
+      \param r The view of the vector to precondition over the ghosted
+      entities of the layout. Only the owned entities are read.
+      \param z The view of the preconditioned vector. The owned and ghosted
+      entities are written; ghosted values are meaningless.
+    */
+    template <class RViewType, class ZViewType>
+    void apply( const RViewType& r, const ZViewType& z )
+    {
+        Kokkos::deep_copy( _levels[0].f->view(), r );
+        vcycle( 0 );
+        Kokkos::deep_copy( z, _levels[0].u->view() );
+    }
+
+  private:
+    using operator_type = Impl::MultigridLevelOperator<Scalar, num_space_dim>;
+    using view_type = typename Array_t::view_type;
+    using dim_tag = std::integral_constant<std::size_t, num_space_dim>;
+
+    // Grid level.
+    struct Level
+    {
+        std::shared_ptr<LocalGrid<MeshType>> local_grid;
+        std::shared_ptr<Array_t> u;
+        std::shared_ptr<Array_t> f;
+        std::shared_ptr<Array_t> t;
+        std::shared_ptr<Halo<memory_space>> halo;
+        operator_type op;
+    };
+
+    // Add a level over a local grid.
+    void addLevel( const std::shared_ptr<LocalGrid<MeshType>>& local_grid,
+                   const Scalar alpha )
+    {
+        Level level;
+        level.local_grid = local_grid;
+        auto layout = createArrayLayout( local_grid, 1, Cell() );
+        level.u = createArray<Scalar, DeviceType>( "multigrid_u", layout );
+        level.f = createArray<Scalar, DeviceType>( "multigrid_f", layout );
+        level.t = createArray<Scalar, DeviceType>( "multigrid_t", layout );
+        ArrayOp::assign( *level.u, 0.0, Ghost() );
+        ArrayOp::assign( *level.f, 0.0, Ghost() );
+        ArrayOp::assign( *level.t, 0.0, Ghost() );
+        level.halo = createHalo( *level.u, FullHaloPattern(), 1 );
+
+        const auto& global_grid = local_grid->globalGrid();
+        auto owned = local_grid->indexSpace( Own(), Cell(), Local() );
+        level.op.alpha = alpha;
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+        {
+            level.op.offset[d] = global_grid.globalOffset( d ) - owned.min( d );
+            level.op.num_cell[d] = global_grid.globalNumEntity( Cell(), d );
+            level.op.periodic[d] = global_grid.isPeriodic( d );
+        }
+        _levels.push_back( level );
+    }
+
+    // Create the next coarser grid, or null if the grid cannot be coarsened
+    // without communication.
+    std::shared_ptr<LocalGrid<MeshType>>
+    coarsen( const std::shared_ptr<LocalGrid<MeshType>>& fine_grid ) const
+    {
+        const auto& fine_global = fine_grid->globalGrid();
+        MPI_Comm comm = fine_global.comm();
+
+        // Every rank must own an even number of at least two cells.
+        int can_coarsen = 1;
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+            if ( fine_global.globalNumEntity( Cell(), d ) % 2 != 0 ||
+                 fine_global.ownedNumCell( d ) % 2 != 0 ||
+                 fine_global.ownedNumCell( d ) < 2 )
+                can_coarsen = 0;
+        MPI_Allreduce( MPI_IN_PLACE, &can_coarsen, 1, MPI_INT, MPI_MIN, comm );
+        if ( !can_coarsen )
+            return nullptr;
+
+        // Create the coarse grid with the same blocks.
+        const auto& fine_mesh = fine_global.globalMesh();
+        std::array<typename MeshType::scalar_type, num_space_dim> low_corner;
+        std::array<typename MeshType::scalar_type, num_space_dim> high_corner;
+        std::array<int, num_space_dim> num_cell;
+        std::array<bool, num_space_dim> periodic;
+        std::array<int, num_space_dim> ranks_per_dim;
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+        {
+            low_corner[d] = fine_mesh.lowCorner( d );
+            high_corner[d] = fine_mesh.highCorner( d );
+            num_cell[d] = fine_global.globalNumEntity( Cell(), d ) / 2;
+            periodic[d] = fine_global.isPeriodic( d );
+            ranks_per_dim[d] = fine_global.dimNumBlock( d );
+        }
+        auto coarse_mesh =
+            createUniformGlobalMesh( low_corner, high_corner, num_cell );
+        auto coarse_global = createGlobalGrid(
+            comm, coarse_mesh, periodic,
+            ManualBlockPartitioner<num_space_dim>( ranks_per_dim ) );
+
+        // The coarse blocks must cover the fine blocks of this rank.
+        int aligned = 1;
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+            if ( coarse_global->dimBlockId( d ) !=
+                     fine_global.dimBlockId( d ) ||
+                 2 * coarse_global->ownedNumCell( d ) !=
+                     fine_global.ownedNumCell( d ) ||
+                 2 * coarse_global->globalOffset( d ) !=
+                     fine_global.globalOffset( d ) )
+                aligned = 0;
+        MPI_Allreduce( MPI_IN_PLACE, &aligned, 1, MPI_INT, MPI_MIN, comm );
+        if ( !aligned )
+            return nullptr;
+
+        return createLocalGrid( coarse_global, 1 );
+    }
+
+    // Compute t = u_scale * u + r_scale * ( f - A u ) over the owned cells.
+    void residual( Level& level, const Scalar u_scale, const Scalar r_scale )
+    {
+        level.halo->gather( execution_space(), *level.u );
+        Impl::MultigridResidual<operator_type, view_type, Scalar> functor{
+            level.op,       level.u->view(), level.f->view(),
+            level.t->view(), u_scale,        r_scale };
+        grid_parallel_for(
+            "multigrid_residual", execution_space(),
+            level.local_grid->indexSpace( Own(), Cell(), Local() ), dim_tag{},
+            functor );
+    }
+
+    // Apply weighted Jacobi sweeps.
+    void smooth( Level& level, const int num_sweep )
+    {
+        auto owned = level.local_grid->indexSpace( Own(), Cell(), Local() );
+        auto u_owned = createSubview( level.u->view(), owned );
+        auto t_owned = createSubview( level.t->view(), owned );
+        for ( int s = 0; s < num_sweep; ++s )
+        {
+            residual( level, 1.0, _weight / level.op.diagonal() );
+            Kokkos::deep_copy( u_owned, t_owned );
+        }
+    }
+
+    // Apply a V-cycle to the given level with a zero initial guess.
+    void vcycle( const std::size_t l )
+    {
+        auto& level = _levels[l];
+        ArrayOp::assign( *level.u, 0.0, Ghost() );
+
+        // Approximate the coarsest level.
+        if ( l + 1 == _levels.size() )
+        {
+            smooth( level, _num_coarse_sweep );
+            return;
+        }
+
+        smooth( level, _num_smooth );
+
+        // Restrict the residual.
+        auto& coarse = _levels[l + 1];
+        residual( level, 0.0, 1.0 );
+        auto fine_space =
+            level.local_grid->indexSpace( Own(), Cell(), Local() );
+        auto coarse_space =
+            coarse.local_grid->indexSpace( Own(), Cell(), Local() );
+        Impl::MultigridRestriction<view_type, Scalar, num_space_dim>
+            restriction;
+        restriction.fine = level.t->view();
+        restriction.coarse = coarse.f->view();
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+        {
+            restriction.fine_min[d] = fine_space.min( d );
+            restriction.coarse_min[d] = coarse_space.min( d );
+        }
+        grid_parallel_for( "multigrid_restriction", execution_space(),
+                           coarse_space, dim_tag{}, restriction );
+
+        // Correct with the coarse level.
+        vcycle( l + 1 );
+        Impl::MultigridProlongation<view_type, num_space_dim> prolong;
+        prolong.coarse = coarse.u->view();
+        prolong.fine = level.u->view();
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+        {
+            prolong.fine_min[d] = fine_space.min( d );
+            prolong.coarse_min[d] = coarse_space.min( d );
+        }
+        grid_parallel_for( "multigrid_prolongation", execution_space(),
+                           fine_space, dim_tag{}, prolong );
+
+        smooth( level, _num_smooth );
+    }
+
+  private:
+    int _num_smooth;
+    int _num_coarse_sweep;
+    Scalar _weight;
+    std::vector<Level> _levels;
+};
+
+//---------------------------------------------------------------------------//
+// Builders.
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create a reference geometric multigrid preconditioner.
+  \param layout The layout of the vectors to precondition.
+  \param alpha The coefficient of the Laplacian on the finest level.
+  \param max_levels The maximum number of levels including the finest.
+*/
+template <class Scalar, class DeviceType, class MeshType>
+std::shared_ptr<ReferenceMultigrid<Scalar, MeshType, DeviceType>>
+createReferenceMultigrid( const ArrayLayout<Cell, MeshType>& layout,
+                          const Scalar alpha = 1.0, const int max_levels = 20 )
+{
+    return std::make_shared<ReferenceMultigrid<Scalar, MeshType, DeviceType>>(
+        layout, alpha, max_levels );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cajita
+
+#endif // end CAJITA_REFERENCEMULTIGRID_HPP
@@ -23,14 +23,19 @@
 #include <Cajita_LocalGrid.hpp>
 #include <Cajita_MpiTraits.hpp>
 #include <Cajita_Parallel.hpp>
+#include <Cajita_SolverTelemetry.hpp>
 #include <Cajita_Types.hpp>
 
+#include <impl/Cabana_Profiling.hpp>
+
 #include <Kokkos_Core.hpp>
 
 #include <array>
+#include <functional>
 #include <memory>
 #include <numeric>
 #include <set>
+#include <stdexcept>
 #include <sstream>
 #include <string>
 #include <type_traits>
@@ -38,6 +43,153 @@
 
 namespace Cajita
 {
+//---------------------------------------------------------------------------//
+// Structured operators.
+//---------------------------------------------------------------------------//
+/*
+  The reference solvers apply the matrix and preconditioner through operator
+  functors. An operator computes the entry of the product of the operator
+  and a vector at a given index:
+
+    template <class VectorType>
+    KOKKOS_INLINE_FUNCTION Scalar operator()( const VectorType& v,
+                                              const int i, const int j,
+                                              const int k ) const;
+
+  or with (v,i,j) in 2D, where v(i,j,k) (or v(i,j)) gives the vector value
+  at an index. Operators may read the vector at the offsets of the stencil
+  given to the solver. Vector values outside of the global domain are
+  undefined and must not contribute. Matrix-free operators computing their
+  coefficients on the fly, e.g. for constant coefficient problems, only read
+  the vector.
+*/
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Operator applying explicit stencil coefficients stored for each
+  entity.
+  \tparam StencilView The view of (i,j,k) stencil offsets.
+  \tparam MatrixView The view of the coefficients of each stencil entry.
+*/
+template <class StencilView, class MatrixView>
+struct StencilMatrixOperator
+{
+    //! Scalar value type.
+    using value_type = typename MatrixView::non_const_value_type;
+
+    //! Stencil offsets.
+    StencilView stencil;
+
+    //! Stencil coefficients. Only non-zero coefficients are applied.
+    MatrixView matrix;
+
+    //! Apply the operator to a vector at an index. 3D specialization.
+    template <class VectorType>
+    KOKKOS_INLINE_FUNCTION value_type operator()( const VectorType& v,
+                                                  const int i, const int j,
+                                                  const int k ) const
+    {
+        value_type result = 0.0;
+        for ( unsigned c = 0; c < stencil.extent( 0 ); ++c )
+            if ( fabs( matrix( i, j, k, c ) ) > 0.0 )
+                result += matrix( i, j, k, c ) *
+                          v( i + stencil( c, Dim::I ), j + stencil( c, Dim::J ),
+                             k + stencil( c, Dim::K ) );
+        return result;
+    }
+
+    //! Apply the operator to a vector at an index. 2D specialization.
+    template <class VectorType>
+    KOKKOS_INLINE_FUNCTION value_type operator()( const VectorType& v,
+                                                  const int i,
+                                                  const int j ) const
+    {
+        value_type result = 0.0;
+        for ( unsigned c = 0; c < stencil.extent( 0 ); ++c )
+            if ( fabs( matrix( i, j, c ) ) > 0.0 )
+                result +=
+                    matrix( i, j, c ) *
+                    v( i + stencil( c, Dim::I ), j + stencil( c, Dim::J ) );
+        return result;
+    }
+};
+
+/*!
+  \brief Create an operator applying explicit stencil coefficients.
+  \param stencil The view of (i,j,k) stencil offsets.
+  \param matrix The view of the coefficients of each stencil entry.
+*/
+template <class StencilView, class MatrixView>
+StencilMatrixOperator<StencilView, MatrixView>
+createStencilMatrixOperator( const StencilView& stencil,
+                             const MatrixView& matrix )
+{
+    return StencilMatrixOperator<StencilView, MatrixView>{ stencil, matrix };
+}
+
+//! \cond Impl
+namespace Impl
+{
+//---------------------------------------------------------------------------//
+// Vector given to operators reading the first component of a view.
+template <class ViewType>
+struct OperatorVector
+{
+    ViewType view;
+
+    KOKKOS_INLINE_FUNCTION
+    typename ViewType::non_const_value_type
+    operator()( const int i, const int j, const int k ) const
+    {
+        return view( i, j, k, 0 );
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    typename ViewType::non_const_value_type operator()( const int i,
+                                                        const int j ) const
+    {
+        return view( i, j, 0 );
+    }
+};
+
+template <class ViewType>
+KOKKOS_INLINE_FUNCTION OperatorVector<ViewType>
+createOperatorVector( const ViewType& view )
+{
+    return OperatorVector<ViewType>{ view };
+}
+
+// Vector given to operators computing x + alpha * y in-line.
+template <class ViewX, class ViewY, class ValueType>
+struct OperatorVectorSum
+{
+    ViewX x;
+    ViewY y;
+    ValueType alpha;
+
+    KOKKOS_INLINE_FUNCTION
+    ValueType operator()( const int i, const int j, const int k ) const
+    {
+        return x( i, j, k, 0 ) + alpha * y( i, j, k, 0 );
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    ValueType operator()( const int i, const int j ) const
+    {
+        return x( i, j, 0 ) + alpha * y( i, j, 0 );
+    }
+};
+
+template <class ViewX, class ViewY, class ValueType>
+KOKKOS_INLINE_FUNCTION OperatorVectorSum<ViewX, ViewY, ValueType>
+createOperatorVectorSum( const ViewX& x, const ViewY& y,
+                         const ValueType alpha )
+{
+    return OperatorVectorSum<ViewX, ViewY, ValueType>{ x, y, alpha };
+}
+} // end namespace Impl
+//! \endcond
+
 //---------------------------------------------------------------------------//
 //! Reference preconditioned structured solver interface.
 template <class Scalar, class EntityType, class MeshType, class DeviceType>
@@ -155,6 +307,10 @@ class ReferenceConjugateGradient
     using Array_t = Array<Scalar, EntityType, MeshType, DeviceType>;
     //! Spatial dimension.
     static constexpr std::size_t num_space_dim = MeshType::num_space_dim;
+    //! View type of a single solver vector.
+    using vector_view_type =
+        typename decltype( createSubarray( std::declval<const Array_t&>(), 0,
+                                           1 ) )::element_type::view_type;
 
     //! Array-like container to hold layout and data information.
     template <class ScalarT, class MemorySpaceT, class ArrayLayoutT>
@@ -180,6 +336,8 @@ class ReferenceConjugateGradient
         , _print_level( 0 )
         , _num_iter( 0 )
         , _residual_norm( 0.0 )
+        , _pipelined( false )
+        , _initial_guess( SolverInitialGuess::Given )
     {
         // Array layout for vectors (p_old,z,r_old,q,p_new,r_new).
         auto vector_layout =
@@ -226,6 +384,7 @@ class ReferenceConjugateGradient
         const bool is_symmetric = false ) override
     {
         setStencil( stencil, is_symmetric, _M_stencil, _M_halo, _M );
+        _M_apply = nullptr;
     }
 
     /*!
@@ -254,189 +413,159 @@ class ReferenceConjugateGradient
     void setup() override {}
 
     /*!
-      \brief Solve the problem Ax = b for x.
-      \param b The forcing term.
-      \param x The solution.
+      \brief Use the pipelined conjugate gradient algorithm of Ghysels and
+      Vanroose.
+      \param pipelined If true, the dot products of each iteration are
+      combined into a single non-blocking global reduction which is overlapped
+      with the preconditioner and matrix applications, at the cost of three
+      more vectors and extra vector updates. The residual norm is that of the
+      recursively updated residual.
     */
-    void solve( const Array_t& b, Array_t& x ) override
+    void setPipelined( const bool pipelined )
     {
-        // Get the local grid.
-        auto local_grid = _vectors->layout()->localGrid();
-
-        // Print banner
-        if ( 1 <= _print_level && 0 == local_grid->globalGrid().blockId() )
-            std::cout << std::endl
-                      << "Preconditioned conjugate gradient" << std::endl;
-
-        // Index space.
-        auto entity_space =
-            local_grid->indexSpace( Own(), EntityType(), Local() );
-
-        // Subarrays.
-        auto p_old = createSubarray( *_vectors, 0, 1 );
-        auto z = createSubarray( *_vectors, 1, 2 );
-        auto r_old = createSubarray( *_vectors, 2, 3 );
-        auto q = createSubarray( *_vectors, 3, 4 );
-        auto p_new = createSubarray( *_vectors, 4, 5 );
-        auto r_new = createSubarray( *_vectors, 5, 6 );
-        auto A_halo_vectors = createSubarray( *_vectors, 0, 2 );
-        auto M_halo_vectors = createSubarray( *_vectors, 2, 4 );
-
-        // Views.
-        auto x_view = x.view();
-        auto b_view = b.view();
-        auto M_view = _M->view();
-        auto A_view = _A->view();
-        auto p_old_view = p_old->view();
-        auto z_view = z->view();
-        auto r_old_view = r_old->view();
-        auto q_view = q->view();
-        auto p_new_view = p_new->view();
-        auto r_new_view = r_new->view();
-
-        // Reset iteration count.
-        _num_iter = 0;
-
-        // Compute the norm of the RHS.
-        std::vector<Scalar> b_norm( 1 );
-        ArrayOp::norm2( b, b_norm );
-
-        // Copy the LHS into p so we can gather it.
-        Kokkos::deep_copy( p_old_view, x_view );
-
-        // Gather the LHS through gatheing p and z.
-        _A_halo->gather( execution_space(), *A_halo_vectors );
-
-        // Compute the initial residual and norm.
-        _residual_norm = 0.0;
-        auto compute_r0 = createComputeR0( _A_stencil, A_view, p_old_view,
-                                           b_view, r_old_view );
-        grid_parallel_reduce(
-            "compute_r0", execution_space(), entity_space,
-            std::integral_constant<std::size_t, num_space_dim>{}, compute_r0,
-            _residual_norm );
-
-        // Finish the global norm reduction.
-        MPI_Allreduce( MPI_IN_PLACE, &_residual_norm, 1,
-                       MpiTraits<Scalar>::type(), MPI_SUM,
-                       local_grid->globalGrid().comm() );
-
-        // If we already have met our criteria then return.
-        _residual_norm = std::sqrt( _residual_norm ) / b_norm[0];
-        if ( 2 == _print_level && 0 == local_grid->globalGrid().blockId() )
-            std::cout << "Iteration " << _num_iter
-                      << ": |r|_2 / |b|_2 = " << _residual_norm << std::endl;
-        if ( _residual_norm <= _tol )
-            return;
-
-        // r and q.
-        _M_halo->gather( execution_space(), *M_halo_vectors );
-
-        // Compute the initial preconditioned residual.
-        Scalar zTr_old = 0.0;
-        auto compute_z0 = createComputeZ0( _M_stencil, M_view, p_old_view,
-                                           p_new_view, r_old_view, z_view );
-        grid_parallel_reduce(
-            "compute_z0", execution_space(), entity_space,
-            std::integral_constant<std::size_t, num_space_dim>{}, compute_z0,
-            zTr_old );
-
-        // Finish computation of zTr
-        MPI_Allreduce( MPI_IN_PLACE, &zTr_old, 1, MpiTraits<Scalar>::type(),
-                       MPI_SUM, local_grid->globalGrid().comm() );
-
-        // Gather the LHS through gatheing p and z.
-        _A_halo->gather( execution_space(), *A_halo_vectors );
-
-        // Compute A*p and pT*A*p.
-        Scalar pTAp = 0.0;
-        auto compute_q0 =
-            createComputeQ0( _A_stencil, A_view, p_old_view, q_view );
-        grid_parallel_reduce(
-            "compute_q0", execution_space(), entity_space,
-            std::integral_constant<std::size_t, num_space_dim>{}, compute_q0,
-            pTAp );
-
-        // Finish the global reduction on pTAp.
-        MPI_Allreduce( MPI_IN_PLACE, &pTAp, 1, MpiTraits<Scalar>::type(),
-                       MPI_SUM, local_grid->globalGrid().comm() );
-
-        // Iterate.
-        bool converged = false;
-        Scalar zTr_new = 0.0;
-        Scalar alpha;
-        Scalar beta;
-        while ( _residual_norm > _tol && _num_iter < _max_iter )
+        _pipelined = pipelined;
+        if ( _pipelined && !_pipelined_vectors )
         {
-            // Gather r and q.
-            _M_halo->gather( execution_space(), *M_halo_vectors );
-
-            // Kernel 1: Compute x, r, residual norm, and zTr
-            alpha = zTr_old / pTAp;
-            zTr_new = 0.0;
-            auto cg_kernel_1 = createKernel1(
-                _M_stencil, M_view, x_view, r_new_view, r_old_view, p_new_view,
-                p_old_view, z_view, q_view, alpha );
-            grid_parallel_reduce(
-                "cg_kernel_1", execution_space(), entity_space,
-                std::integral_constant<std::size_t, num_space_dim>{},
-                cg_kernel_1, zTr_new );
-
-            // Finish the global reduction on zTr and r_norm.
-            MPI_Allreduce( MPI_IN_PLACE, &zTr_new, 1, MpiTraits<Scalar>::type(),
-                           MPI_SUM, local_grid->globalGrid().comm() );
-
-            // Update residual norm
-            _residual_norm = std::sqrt( fabs( zTr_new ) ) / b_norm[0];
+            // Array layout for vectors (m,u,w,r,n,z,q,s,p).
+            auto vector_layout = createArrayLayout(
+                _vectors->layout()->localGrid(), 9, EntityType() );
+            _pipelined_vectors = createArray<Scalar, DeviceType>(
+                "pipelined_cg_vectors", vector_layout );
+        }
+    }
 
-            // Increment iteration count.
-            _num_iter++;
+    /*!
+      \brief Set the initial guess of the solves.
+      \param initial_guess Given (default) starts from the solution array
+      passed to the solve and Zero sets it to zero first. Previous is not
+      supported as the solver does not retain a solution.
+    */
+    void setInitialGuess( const SolverInitialGuess initial_guess )
+    {
+        if ( SolverInitialGuess::Previous == initial_guess )
+            throw std::logic_error( "Reference conjugate gradient does not "
+                                    "retain a previous solution" );
+        _initial_guess = initial_guess;
+    }
 
-            // Output result
-            if ( 2 == _print_level && 0 == local_grid->globalGrid().blockId() )
-                std::cout << "Iteration " << _num_iter
-                          << ": |r|_2 / |b|_2 = " << _residual_norm
-                          << std::endl;
+    /*!
+      \brief Get the telemetry of the last solve. Enable it to time the
+      phases of the solves.
+    */
+    SolverTelemetry& getTelemetry() { return _telemetry; }
 
-            // Check for convergence.
-            if ( _residual_norm <= _tol )
-            {
-                converged = true;
-                break;
-            }
+    /*!
+      \brief Set the stencil of a matrix-free matrix operator. The matrix
+      values are not allocated.
+      \param stencil The (i,j,k) offsets at which the operator reads the
+      vector it is applied to. Offsets are defined relative to an index.
+    */
+    void setMatrixOperatorStencil(
+        const std::vector<std::array<int, num_space_dim>>& stencil )
+    {
+        setStencil( stencil, false, _A_stencil, _A_halo, _A, false );
+    }
 
-            // Gather p and z.
-            _A_halo->gather( execution_space(), *A_halo_vectors );
+    /*!
+      \brief Set the stencil of a matrix-free preconditioner operator. The
+      preconditioner values are not allocated.
+      \param stencil The (i,j,k) offsets at which the operator reads the
+      vector it is applied to. Offsets are defined relative to an index.
+    */
+    void setPreconditionerOperatorStencil(
+        const std::vector<std::array<int, num_space_dim>>& stencil )
+    {
+        setStencil( stencil, false, _M_stencil, _M_halo, _M, false );
+        _M_apply = nullptr;
+    }
 
-            // Kernel 2: Compute p, A*p, and p^T*A*p
-            beta = zTr_new / zTr_old;
-            pTAp = 0.0;
-            auto cg_kernel_2 = createKernel2(
-                _A_stencil, A_view, x_view, r_new_view, r_old_view, p_new_view,
-                p_old_view, z_view, q_view, beta );
-            grid_parallel_reduce(
-                "cg_kernel_2", execution_space(), entity_space,
-                std::integral_constant<std::size_t, num_space_dim>{},
-                cg_kernel_2, pTAp );
+    /*!
+      \brief Set a preconditioner applied to the whole residual at once, e.g.
+      a ReferenceMultigrid. Replaces the preconditioner stencil.
+      \param preconditioner The preconditioner. Its apply( r, z ) member
+      computes z = M r over the owned entities from the owned entities of r,
+      where r and z are views over the ghosted entities of the vector layout.
+      The preconditioner must be symmetric positive definite.
+    */
+    template <class Preconditioner>
+    void
+    setPreconditioner( const std::shared_ptr<Preconditioner>& preconditioner )
+    {
+        _M_apply = [preconditioner]( const vector_view_type& r,
+                                     const vector_view_type& z ) {
+            preconditioner->apply( r, z );
+        };
+    }
 
-            // Finish the global reduction on pTAp.
-            MPI_Allreduce( MPI_IN_PLACE, &pTAp, 1, MpiTraits<Scalar>::type(),
-                           MPI_SUM, local_grid->globalGrid().comm() );
+    /*!
+      \brief Solve the problem Ax = b for x.
+      \param b The forcing term.
+      \param x The solution.
+    */
+    void solve( const Array_t& b, Array_t& x ) override
+    {
+        Cabana::Impl::ScopedProfileRegion region(
+            "Cajita::ReferenceConjugateGradient::solve" );
+
+        beginSolve( x );
+        if ( _A && _M_apply )
+            solvePreconditionedImpl(
+                createStencilMatrixOperator( _A_stencil, _A->view() ), b, x );
+        else if ( !_A || !_M )
+            throw std::runtime_error(
+                "Matrix and preconditioner values must be set to solve" );
+        else
+            solveImpl( createStencilMatrixOperator( _A_stencil, _A->view() ),
+                       createStencilMatrixOperator( _M_stencil, _M->view() ),
+                       b, x );
+    }
 
-            // Update zTr
-            zTr_old = zTr_new;
-        }
+    /*!
+      \brief Solve the problem Ax = b for x with matrix-free operators.
+      \param A The matrix operator. Its stencil must have been set with
+      setMatrixOperatorStencil() or setMatrixStencil().
+      \param M The preconditioner operator. Its stencil must have been set
+      with setPreconditionerOperatorStencil() or setPreconditionerStencil().
+      \param b The forcing term.
+      \param x The solution.
 
-        // Output end state.
-        if ( 1 <= _print_level && 0 == local_grid->globalGrid().blockId() )
-            std::cout << "Finished in " << _num_iter
-                      << " iterations, converged to " << _residual_norm
-                      << std::endl
-                      << std::endl;
+      The operators are applied inside the fused solver kernels and only
+      read the vectors they are applied to, which avoids reading a matrix
+      coefficient for each stencil entry of each entity.
+    */
+    template <class MatrixOperator, class PreconditionerOperator>
+    void solve( const MatrixOperator& A, const PreconditionerOperator& M,
+                const Array_t& b, Array_t& x )
+    {
+        Cabana::Impl::ScopedProfileRegion region(
+            "Cajita::ReferenceConjugateGradient::solve" );
+
+        if ( !_A_halo || !_M_halo )
+            throw std::runtime_error(
+                "Matrix and preconditioner stencils must be set to solve" );
+        beginSolve( x );
+        solveImpl( A, M, b, x );
+    }
 
-        // If we didn't converge throw.
-        if ( !converged )
-            throw std::runtime_error( "CG solver did not converge" );
+    /*!
+      \brief Solve the problem Ax = b for x with a matrix-free matrix
+      operator and the preconditioner given to setPreconditioner().
+      \param A The matrix operator. Its stencil must have been set with
+      setMatrixOperatorStencil() or setMatrixStencil().
+      \param b The forcing term.
+      \param x The solution.
+    */
+    template <class MatrixOperator>
+    void solve( const MatrixOperator& A, const Array_t& b, Array_t& x )
+    {
+        Cabana::Impl::ScopedProfileRegion region(
+            "Cajita::ReferenceConjugateGradient::solve" );
+
+        if ( !_A_halo || !_M_apply )
+            throw std::runtime_error(
+                "Matrix stencil and preconditioner must be set to solve" );
+        beginSolve( x );
+        solvePreconditionedImpl( A, b, x );
     }
 
     //! Get the number of iterations taken on the last solve.
@@ -447,17 +576,15 @@ class ReferenceConjugateGradient
 
   public:
     //! \cond Impl
-    template <class StencilA, class ViewA, class ViewOldP, class ViewB,
-              class ViewOldR>
+    template <class OperatorA, class ViewOldP, class ViewB, class ViewOldR>
     struct ComputeR0
     {
-        StencilA A_stencil;
-        ViewA A_view;
+        OperatorA A_op;
         ViewOldP p_old_view;
         ViewB b_view;
         ViewOldR r_old_view;
 
-        using value_type = typename ViewB::value_type;
+        using value_type = typename ViewB::non_const_value_type;
 
         KOKKOS_INLINE_FUNCTION void
         operator()( const std::integral_constant<std::size_t, 3>&, const int i,
@@ -465,15 +592,9 @@ class ReferenceConjugateGradient
         {
             // Compute the local contribution from matrix-vector
             // multiplication. Note that we copied x into p for this
-            // operation to easily perform the gather. Only apply the
-            // stencil entry if it is greater than 0.
-            value_type Ax = 0.0;
-            for ( unsigned c = 0; c < A_stencil.extent( 0 ); ++c )
-                if ( fabs( A_view( i, j, k, c ) ) > 0.0 )
-                    Ax += A_view( i, j, k, c ) *
-                          p_old_view( i + A_stencil( c, Dim::I ),
-                                      j + A_stencil( c, Dim::J ),
-                                      k + A_stencil( c, Dim::K ), 0 );
+            // operation to easily perform the gather.
+            value_type Ax =
+                A_op( Impl::createOperatorVector( p_old_view ), i, j, k );
 
             // Compute the residual.
             auto r_new = b_view( i, j, k, 0 ) - Ax;
@@ -491,14 +612,9 @@ class ReferenceConjugateGradient
         {
             // Compute the local contribution from matrix-vector
             // multiplication. Note that we copied x into p for this
-            // operation to easily perform the gather. Only apply the
-            // stencil entry if it is greater than 0.
-            value_type Ax = 0.0;
-            for ( unsigned c = 0; c < A_stencil.extent( 0 ); ++c )
-                if ( fabs( A_view( i, j, c ) ) > 0.0 )
-                    Ax += A_view( i, j, c ) *
-                          p_old_view( i + A_stencil( c, Dim::I ),
-                                      j + A_stencil( c, Dim::J ), 0 );
+            // operation to easily perform the gather.
+            value_type Ax =
+                A_op( Impl::createOperatorVector( p_old_view ), i, j );
 
             // Compute the residual.
             auto r_new = b_view( i, j, 0 ) - Ax;
@@ -511,43 +627,35 @@ class ReferenceConjugateGradient
         }
     };
 
-    template <class StencilA, class ViewA, class ViewOldP, class ViewB,
-              class ViewOldR>
-    auto createComputeR0( const StencilA& A_stencil, const ViewA& A_view,
-                          const ViewOldP& p_old_view, const ViewB& b_view,
-                          const ViewOldR& r_old_view )
+    template <class OperatorA, class ViewOldP, class ViewB, class ViewOldR>
+    auto createComputeR0( const OperatorA& A_op, const ViewOldP& p_old_view,
+                          const ViewB& b_view, const ViewOldR& r_old_view )
     {
-        return ComputeR0<StencilA, ViewA, ViewOldP, ViewB, ViewOldR>{
-            A_stencil, A_view, p_old_view, b_view, r_old_view };
+        return ComputeR0<OperatorA, ViewOldP, ViewB, ViewOldR>{
+            A_op, p_old_view, b_view, r_old_view };
     }
 
-    template <class StencilM, class ViewM, class ViewOldP, class ViewNewP,
-              class ViewOldR, class ViewZ>
+    template <class OperatorM, class ViewOldP, class ViewNewP, class ViewOldR,
+              class ViewZ>
     struct ComputeZ0
     {
-        StencilM M_stencil;
-        ViewM M_view;
+        OperatorM M_op;
         ViewOldP p_old_view;
         ViewNewP p_new_view;
         ViewOldR r_old_view;
         ViewZ z_view;
 
-        using value_type = typename ViewZ::value_type;
+        using value_type = typename ViewZ::non_const_value_type;
 
         KOKKOS_INLINE_FUNCTION void
         operator()( const std::integral_constant<std::size_t, 3>&, const int i,
                     const int j, const int k, value_type& result ) const
         {
             // Compute the local contribution from matrix-vector
-            // multiplication. Only apply the stencil entry if it is
-            // greater than 0.
-            value_type Mr = 0.0;
-            for ( unsigned c = 0; c < M_stencil.extent( 0 ); ++c )
-                if ( fabs( M_view( i, j, k, c ) ) > 0.0 )
-                    Mr += M_view( i, j, k, c ) *
-                          r_old_view( i + M_stencil( c, Dim::I ),
-                                      j + M_stencil( c, Dim::J ),
-                                      k + M_stencil( c, Dim::K ), 0 );
+            // multiplication.
+            value_type Mr =
+                M_op( Impl::createOperatorVector( r_old_view ), i, j, k );
+
             // Write values.
             z_view( i, j, k, 0 ) = Mr;
             p_old_view( i, j, k, 0 ) = Mr;
@@ -562,14 +670,10 @@ class ReferenceConjugateGradient
                     const int j, value_type& result ) const
         {
             // Compute the local contribution from matrix-vector
-            // multiplication. Only apply the stencil entry if it is
-            // greater than 0.
-            value_type Mr = 0.0;
-            for ( unsigned c = 0; c < M_stencil.extent( 0 ); ++c )
-                if ( fabs( M_view( i, j, c ) ) > 0.0 )
-                    Mr += M_view( i, j, c ) *
-                          r_old_view( i + M_stencil( c, Dim::I ),
-                                      j + M_stencil( c, Dim::J ), 0 );
+            // multiplication.
+            value_type Mr =
+                M_op( Impl::createOperatorVector( r_old_view ), i, j );
+
             // Write values.
             z_view( i, j, 0 ) = Mr;
             p_old_view( i, j, 0 ) = Mr;
@@ -580,42 +684,33 @@ class ReferenceConjugateGradient
         }
     };
 
-    template <class StencilM, class ViewM, class ViewOldP, class ViewNewP,
-              class ViewOldR, class ViewZ>
-    auto createComputeZ0( const StencilM& M_stencil, const ViewM& M_view,
-                          const ViewOldP& p_old_view,
+    template <class OperatorM, class ViewOldP, class ViewNewP, class ViewOldR,
+              class ViewZ>
+    auto createComputeZ0( const OperatorM& M_op, const ViewOldP& p_old_view,
                           const ViewNewP& p_new_view,
                           const ViewOldR& r_old_view, const ViewZ& z_view )
     {
-        return ComputeZ0<StencilM, ViewM, ViewOldP, ViewNewP, ViewOldR, ViewZ>{
-            M_stencil, M_view, p_old_view, p_new_view, r_old_view, z_view };
+        return ComputeZ0<OperatorM, ViewOldP, ViewNewP, ViewOldR, ViewZ>{
+            M_op, p_old_view, p_new_view, r_old_view, z_view };
     }
 
-    template <class StencilA, class ViewA, class ViewOldP, class ViewQ>
+    template <class OperatorA, class ViewOldP, class ViewQ>
     struct ComputeQ0
     {
-        StencilA A_stencil;
-        ViewA A_view;
+        OperatorA A_op;
         ViewOldP p_old_view;
         ViewQ q_view;
 
-        using value_type = typename ViewQ::value_type;
+        using value_type = typename ViewQ::non_const_value_type;
 
         KOKKOS_INLINE_FUNCTION void
         operator()( const std::integral_constant<std::size_t, 3>&, const int i,
                     const int j, const int k, value_type& result ) const
         {
             // Compute the local contribution from matrix-vector
-            // multiplication. This computes the updated p vector
-            // in-line to avoid another kernel launch. Only apply the
-            // stencil entry if it is greater than 0.
-            value_type Ap = 0.0;
-            for ( unsigned c = 0; c < A_stencil.extent( 0 ); ++c )
-                if ( fabs( A_view( i, j, k, c ) ) > 0.0 )
-                    Ap += A_view( i, j, k, c ) *
-                          ( p_old_view( i + A_stencil( c, Dim::I ),
-                                        j + A_stencil( c, Dim::J ),
-                                        k + A_stencil( c, Dim::K ), 0 ) );
+            // multiplication.
+            value_type Ap =
+                A_op( Impl::createOperatorVector( p_old_view ), i, j, k );
 
             // Write values.
             q_view( i, j, k, 0 ) = Ap;
@@ -629,15 +724,9 @@ class ReferenceConjugateGradient
                     const int j, value_type& result ) const
         {
             // Compute the local contribution from matrix-vector
-            // multiplication. This computes the updated p vector
-            // in-line to avoid another kernel launch. Only apply the
-            // stencil entry if it is greater than 0.
-            value_type Ap = 0.0;
-            for ( unsigned c = 0; c < A_stencil.extent( 0 ); ++c )
-                if ( fabs( A_view( i, j, c ) ) > 0.0 )
-                    Ap += A_view( i, j, c ) *
-                          ( p_old_view( i + A_stencil( c, Dim::I ),
-                                        j + A_stencil( c, Dim::J ), 0 ) );
+            // multiplication.
+            value_type Ap =
+                A_op( Impl::createOperatorVector( p_old_view ), i, j );
 
             // Write values.
             q_view( i, j, 0 ) = Ap;
@@ -647,21 +736,20 @@ class ReferenceConjugateGradient
         }
     };
 
-    template <class StencilA, class ViewA, class ViewOldP, class ViewQ>
-    auto createComputeQ0( const StencilA& A_stencil, const ViewA& A_view,
-                          const ViewOldP& p_old_view, const ViewQ& q_view )
+    template <class OperatorA, class ViewOldP, class ViewQ>
+    auto createComputeQ0( const OperatorA& A_op, const ViewOldP& p_old_view,
+                          const ViewQ& q_view )
     {
-        return ComputeQ0<StencilA, ViewA, ViewOldP, ViewQ>{
-            A_stencil, A_view, p_old_view, q_view };
+        return ComputeQ0<OperatorA, ViewOldP, ViewQ>{ A_op, p_old_view,
+                                                      q_view };
     }
 
-    template <class StencilM, class ViewM, class ViewX, class ViewNewR,
-              class ViewOldR, class ViewOldP, class ViewNewP, class ViewZ,
-              class ViewQ, class ValueType>
+    template <class OperatorM, class ViewX, class ViewNewR, class ViewOldR,
+              class ViewOldP, class ViewNewP, class ViewZ, class ViewQ,
+              class ValueType>
     struct Kernel1
     {
-        StencilM M_stencil;
-        ViewM M_view;
+        OperatorM M_op;
         ViewX x_view;
         ViewNewR r_new_view;
         ViewOldR r_old_view;
@@ -676,19 +764,11 @@ class ReferenceConjugateGradient
                     const int j, const int k, ValueType& result ) const
         {
             // Compute the local contribution from matrix-vector
-            // multiplication. This computes the updated q vector
-            // in-line to avoid another kernel launch. Only apply the
-            // stencil entry if it is greater than 0.
-            ValueType Mr = 0.0;
-            for ( unsigned c = 0; c < M_stencil.extent( 0 ); ++c )
-                if ( fabs( M_view( i, j, k, c ) ) > 0.0 )
-                    Mr += M_view( i, j, k, c ) *
-                          ( r_old_view( i + M_stencil( c, Dim::I ),
-                                        j + M_stencil( c, Dim::J ),
-                                        k + M_stencil( c, Dim::K ), 0 ) -
-                            alpha * q_view( i + M_stencil( c, Dim::I ),
-                                            j + M_stencil( c, Dim::J ),
-                                            k + M_stencil( c, Dim::K ), 0 ) );
+            // multiplication. This computes the updated r vector
+            // in-line to avoid another kernel launch.
+            ValueType Mr = M_op(
+                Impl::createOperatorVectorSum( r_old_view, q_view, -alpha ), i,
+                j, k );
 
             // Compute the updated x.
             ValueType x_new =
@@ -715,17 +795,11 @@ class ReferenceConjugateGradient
                     const int j, ValueType& result ) const
         {
             // Compute the local contribution from matrix-vector
-            // multiplication. This computes the updated q vector
-            // in-line to avoid another kernel launch. Only apply the
-            // stencil entry if it is greater than 0.
-            ValueType Mr = 0.0;
-            for ( unsigned c = 0; c < M_stencil.extent( 0 ); ++c )
-                if ( fabs( M_view( i, j, c ) ) > 0.0 )
-                    Mr += M_view( i, j, c ) *
-                          ( r_old_view( i + M_stencil( c, Dim::I ),
-                                        j + M_stencil( c, Dim::J ), 0 ) -
-                            alpha * q_view( i + M_stencil( c, Dim::I ),
-                                            j + M_stencil( c, Dim::J ), 0 ) );
+            // multiplication. This computes the updated r vector
+            // in-line to avoid another kernel launch.
+            ValueType Mr = M_op(
+                Impl::createOperatorVectorSum( r_old_view, q_view, -alpha ), i,
+                j );
 
             // Compute the updated x.
             ValueType x_new = x_view( i, j, 0 ) + alpha * p_new_view( i, j, 0 );
@@ -746,28 +820,27 @@ class ReferenceConjugateGradient
         }
     };
 
-    template <class StencilM, class ViewM, class ViewX, class ViewNewR,
-              class ViewOldR, class ViewOldP, class ViewNewP, class ViewZ,
-              class ViewQ, class ValueType>
-    auto createKernel1( const StencilM& M_stencil, const ViewM& M_view,
-                        const ViewX& x_view, const ViewNewR& r_new_view,
-                        const ViewOldR& r_old_view, const ViewNewP& p_new_view,
-                        const ViewOldP& p_old_view, const ViewZ& z_view,
-                        const ViewQ& q_view, const ValueType& alpha )
+    template <class OperatorM, class ViewX, class ViewNewR, class ViewOldR,
+              class ViewOldP, class ViewNewP, class ViewZ, class ViewQ,
+              class ValueType>
+    auto createKernel1( const OperatorM& M_op, const ViewX& x_view,
+                        const ViewNewR& r_new_view, const ViewOldR& r_old_view,
+                        const ViewNewP& p_new_view, const ViewOldP& p_old_view,
+                        const ViewZ& z_view, const ViewQ& q_view,
+                        const ValueType& alpha )
     {
-        return Kernel1<StencilM, ViewM, ViewX, ViewNewR, ViewOldR, ViewOldP,
+        return Kernel1<OperatorM, ViewX, ViewNewR, ViewOldR, ViewOldP,
                        ViewNewP, ViewZ, ViewQ, ValueType>{
-            M_stencil,  M_view,     x_view, r_new_view, r_old_view,
-            p_new_view, p_old_view, z_view, q_view,     alpha };
+            M_op,       x_view, r_new_view, r_old_view, p_new_view,
+            p_old_view, z_view, q_view,     alpha };
     }
 
-    template <class StencilA, class ViewA, class ViewX, class ViewNewR,
-              class ViewOldR, class ViewOldP, class ViewNewP, class ViewZ,
-              class ViewQ, class ValueType>
+    template <class OperatorA, class ViewX, class ViewNewR, class ViewOldR,
+              class ViewOldP, class ViewNewP, class ViewZ, class ViewQ,
+              class ValueType>
     struct Kernel2
     {
-        StencilA A_stencil;
-        ViewA A_view;
+        OperatorA A_op;
         ViewX x_view;
         ViewNewR r_new_view;
         ViewOldR r_old_view;
@@ -783,19 +856,10 @@ class ReferenceConjugateGradient
         {
             // Compute the local contribution from matrix-vector
             // multiplication. This computes the updated p vector
-            // in-line to avoid another kernel launch. Only apply the
-            // stencil entry if it is greater than 0.
-            ValueType Ap = 0.0;
-            for ( unsigned c = 0; c < A_stencil.extent( 0 ); ++c )
-                if ( fabs( A_view( i, j, k, c ) ) > 0.0 )
-                    Ap +=
-                        A_view( i, j, k, c ) *
-                        ( z_view( i + A_stencil( c, Dim::I ),
-                                  j + A_stencil( c, Dim::J ),
-                                  k + A_stencil( c, Dim::K ), 0 ) +
-                          beta * p_old_view( i + A_stencil( c, Dim::I ),
-                                             j + A_stencil( c, Dim::J ),
-                                             k + A_stencil( c, Dim::K ), 0 ) );
+            // in-line to avoid another kernel launch.
+            ValueType Ap = A_op(
+                Impl::createOperatorVectorSum( z_view, p_old_view, beta ), i,
+                j, k );
 
             // Compute the updated p.
             ValueType p_new =
@@ -818,17 +882,10 @@ class ReferenceConjugateGradient
         {
             // Compute the local contribution from matrix-vector
             // multiplication. This computes the updated p vector
-            // in-line to avoid another kernel launch. Only apply the
-            // stencil entry if it is greater than 0.
-            ValueType Ap = 0.0;
-            for ( unsigned c = 0; c < A_stencil.extent( 0 ); ++c )
-                if ( fabs( A_view( i, j, c ) ) > 0.0 )
-                    Ap +=
-                        A_view( i, j, c ) *
-                        ( z_view( i + A_stencil( c, Dim::I ),
-                                  j + A_stencil( c, Dim::J ), 0 ) +
-                          beta * p_old_view( i + A_stencil( c, Dim::I ),
-                                             j + A_stencil( c, Dim::J ), 0 ) );
+            // in-line to avoid another kernel launch.
+            ValueType Ap = A_op(
+                Impl::createOperatorVectorSum( z_view, p_old_view, beta ), i,
+                j );
 
             // Compute the updated p.
             ValueType p_new = z_view( i, j, 0 ) + beta * p_old_view( i, j, 0 );
@@ -845,30 +902,916 @@ class ReferenceConjugateGradient
         }
     };
 
-    template <class StencilA, class ViewA, class ViewX, class ViewNewR,
-              class ViewOldR, class ViewOldP, class ViewNewP, class ViewZ,
-              class ViewQ, class ValueType>
-    auto createKernel2( const StencilA& A_stencil, const ViewA& A_view,
-                        const ViewX& x_view, const ViewNewR& r_new_view,
-                        const ViewOldR& r_old_view, const ViewNewP& p_new_view,
-                        const ViewOldP& p_old_view, const ViewZ& z_view,
-                        const ViewQ& q_view, const ValueType& beta )
+    template <class OperatorA, class ViewX, class ViewNewR, class ViewOldR,
+              class ViewOldP, class ViewNewP, class ViewZ, class ViewQ,
+              class ValueType>
+    auto createKernel2( const OperatorA& A_op, const ViewX& x_view,
+                        const ViewNewR& r_new_view, const ViewOldR& r_old_view,
+                        const ViewNewP& p_new_view, const ViewOldP& p_old_view,
+                        const ViewZ& z_view, const ViewQ& q_view,
+                        const ValueType& beta )
     {
-        return Kernel2<StencilA, ViewA, ViewX, ViewNewR, ViewOldR, ViewOldP,
+        return Kernel2<OperatorA, ViewX, ViewNewR, ViewOldR, ViewOldP,
                        ViewNewP, ViewZ, ViewQ, ValueType>{
-            A_stencil,  A_view,     x_view, r_new_view, r_old_view,
-            p_new_view, p_old_view, z_view, q_view,     beta };
+            A_op,       x_view, r_new_view, r_old_view, p_new_view,
+            p_old_view, z_view, q_view,     beta };
     }
-    //! \endcond
 
-  private:
-    // Set the stencil of a matrix.
-    void
+    template <class ViewX, class ViewY>
+    struct ComputeDot
+    {
+        ViewX x_view;
+        ViewY y_view;
+
+        using value_type = typename ViewX::non_const_value_type;
+
+        KOKKOS_INLINE_FUNCTION void
+        operator()( const std::integral_constant<std::size_t, 3>&, const int i,
+                    const int j, const int k, value_type& result ) const
+        {
+            result += x_view( i, j, k, 0 ) * y_view( i, j, k, 0 );
+        }
+
+        KOKKOS_INLINE_FUNCTION void
+        operator()( const std::integral_constant<std::size_t, 2>&, const int i,
+                    const int j, value_type& result ) const
+        {
+            result += x_view( i, j, 0 ) * y_view( i, j, 0 );
+        }
+    };
+
+    template <class ViewX, class ViewY>
+    auto createComputeDot( const ViewX& x_view, const ViewY& y_view )
+    {
+        return ComputeDot<ViewX, ViewY>{ x_view, y_view };
+    }
+
+    template <class ViewX, class ViewR, class ViewP, class ViewQ,
+              class ValueType>
+    struct UpdateSolution
+    {
+        ViewX x_view;
+        ViewR r_view;
+        ViewP p_view;
+        ViewQ q_view;
+        ValueType alpha;
+
+        KOKKOS_INLINE_FUNCTION void
+        operator()( const std::integral_constant<std::size_t, 3>&, const int i,
+                    const int j, const int k, ValueType& result ) const
+        {
+            x_view( i, j, k, 0 ) += alpha * p_view( i, j, k, 0 );
+            ValueType r_new =
+                r_view( i, j, k, 0 ) - alpha * q_view( i, j, k, 0 );
+            r_view( i, j, k, 0 ) = r_new;
+            result += r_new * r_new;
+        }
+
+        KOKKOS_INLINE_FUNCTION void
+        operator()( const std::integral_constant<std::size_t, 2>&, const int i,
+                    const int j, ValueType& result ) const
+        {
+            x_view( i, j, 0 ) += alpha * p_view( i, j, 0 );
+            ValueType r_new = r_view( i, j, 0 ) - alpha * q_view( i, j, 0 );
+            r_view( i, j, 0 ) = r_new;
+            result += r_new * r_new;
+        }
+    };
+
+    template <class ViewX, class ViewR, class ViewP, class ViewQ,
+              class ValueType>
+    auto createUpdateSolution( const ViewX& x_view, const ViewR& r_view,
+                               const ViewP& p_view, const ViewQ& q_view,
+                               const ValueType& alpha )
+    {
+        return UpdateSolution<ViewX, ViewR, ViewP, ViewQ, ValueType>{
+            x_view, r_view, p_view, q_view, alpha };
+    }
+
+    template <class ViewZ, class ViewP, class ValueType>
+    struct UpdateDirection
+    {
+        ViewZ z_view;
+        ViewP p_view;
+        ValueType beta;
+
+        KOKKOS_INLINE_FUNCTION void
+        operator()( const std::integral_constant<std::size_t, 3>&, const int i,
+                    const int j, const int k ) const
+        {
+            p_view( i, j, k, 0 ) =
+                z_view( i, j, k, 0 ) + beta * p_view( i, j, k, 0 );
+        }
+
+        KOKKOS_INLINE_FUNCTION void
+        operator()( const std::integral_constant<std::size_t, 2>&, const int i,
+                    const int j ) const
+        {
+            p_view( i, j, 0 ) = z_view( i, j, 0 ) + beta * p_view( i, j, 0 );
+        }
+    };
+
+    template <class ViewZ, class ViewP, class ValueType>
+    auto createUpdateDirection( const ViewZ& z_view, const ViewP& p_view,
+                                const ValueType& beta )
+    {
+        return UpdateDirection<ViewZ, ViewP, ValueType>{ z_view, p_view,
+                                                         beta };
+    }
+
+    template <class OperatorType, class ViewIn, class ViewOut>
+    struct ApplyOperator
+    {
+        OperatorType op;
+        ViewIn in_view;
+        ViewOut out_view;
+
+        KOKKOS_INLINE_FUNCTION void
+        operator()( const std::integral_constant<std::size_t, 3>&, const int i,
+                    const int j, const int k ) const
+        {
+            out_view( i, j, k, 0 ) =
+                op( Impl::createOperatorVector( in_view ), i, j, k );
+        }
+
+        KOKKOS_INLINE_FUNCTION void
+        operator()( const std::integral_constant<std::size_t, 2>&, const int i,
+                    const int j ) const
+        {
+            out_view( i, j, 0 ) =
+                op( Impl::createOperatorVector( in_view ), i, j );
+        }
+    };
+
+    template <class OperatorType, class ViewIn, class ViewOut>
+    auto createApplyOperator( const OperatorType& op, const ViewIn& in_view,
+                              const ViewOut& out_view )
+    {
+        return ApplyOperator<OperatorType, ViewIn, ViewOut>{ op, in_view,
+                                                             out_view };
+    }
+
+    // Reduction of the dot products (r,u), (w,u), and (r,r) of pipelined CG.
+    template <class ValueType>
+    struct PipelinedReduction
+    {
+        typedef ValueType value_type[];
+        unsigned value_count = 3;
+
+        KOKKOS_INLINE_FUNCTION
+        void join( volatile ValueType* dst,
+                   const volatile ValueType* src ) const
+        {
+            for ( unsigned n = 0; n < value_count; ++n )
+                dst[n] += src[n];
+        }
+
+        KOKKOS_INLINE_FUNCTION void init( ValueType* sum ) const
+        {
+            for ( unsigned n = 0; n < value_count; ++n )
+                sum[n] = 0.0;
+        }
+    };
+
+    template <class ViewVector, class ValueType>
+    struct PipelinedDots : PipelinedReduction<ValueType>
+    {
+        ViewVector r_view;
+        ViewVector u_view;
+        ViewVector w_view;
+
+        PipelinedDots( const ViewVector& r, const ViewVector& u,
+                       const ViewVector& w )
+            : r_view( r )
+            , u_view( u )
+            , w_view( w )
+        {
+        }
+
+        KOKKOS_INLINE_FUNCTION void
+        operator()( const std::integral_constant<std::size_t, 3>&, const int i,
+                    const int j, const int k, ValueType* sum ) const
+        {
+            ValueType r = r_view( i, j, k, 0 );
+            ValueType u = u_view( i, j, k, 0 );
+            sum[0] += r * u;
+            sum[1] += w_view( i, j, k, 0 ) * u;
+            sum[2] += r * r;
+        }
+
+        KOKKOS_INLINE_FUNCTION void
+        operator()( const std::integral_constant<std::size_t, 2>&, const int i,
+                    const int j, ValueType* sum ) const
+        {
+            ValueType r = r_view( i, j, 0 );
+            ValueType u = u_view( i, j, 0 );
+            sum[0] += r * u;
+            sum[1] += w_view( i, j, 0 ) * u;
+            sum[2] += r * r;
+        }
+    };
+
+    template <class ValueType, class ViewVector>
+    auto createPipelinedDots( const ViewVector& r_view,
+                              const ViewVector& u_view,
+                              const ViewVector& w_view )
+    {
+        return PipelinedDots<ViewVector, ValueType>( r_view, u_view, w_view );
+    }
+
+    // Fused vector updates of a pipelined CG iteration followed by the local
+    // dot products of the next iteration.
+    template <class ViewX, class ViewVector, class ValueType>
+    struct PipelinedUpdate : PipelinedReduction<ValueType>
+    {
+        ViewX x_view;
+        ViewVector r_view;
+        ViewVector u_view;
+        ViewVector w_view;
+        ViewVector m_view;
+        ViewVector n_view;
+        ViewVector z_view;
+        ViewVector q_view;
+        ViewVector s_view;
+        ViewVector p_view;
+        ValueType alpha;
+        ValueType beta;
+
+        PipelinedUpdate( const ViewX& x, const ViewVector& r,
+                         const ViewVector& u, const ViewVector& w,
+                         const ViewVector& m, const ViewVector& n,
+                         const ViewVector& z, const ViewVector& q,
+                         const ViewVector& s, const ViewVector& p,
+                         const ValueType a, const ValueType b )
+            : x_view( x )
+            , r_view( r )
+            , u_view( u )
+            , w_view( w )
+            , m_view( m )
+            , n_view( n )
+            , z_view( z )
+            , q_view( q )
+            , s_view( s )
+            , p_view( p )
+            , alpha( a )
+            , beta( b )
+        {
+        }
+
+        KOKKOS_INLINE_FUNCTION void
+        operator()( const std::integral_constant<std::size_t, 3>&, const int i,
+                    const int j, const int k, ValueType* sum ) const
+        {
+            ValueType z = n_view( i, j, k, 0 ) + beta * z_view( i, j, k, 0 );
+            ValueType q = m_view( i, j, k, 0 ) + beta * q_view( i, j, k, 0 );
+            ValueType s = w_view( i, j, k, 0 ) + beta * s_view( i, j, k, 0 );
+            ValueType p = u_view( i, j, k, 0 ) + beta * p_view( i, j, k, 0 );
+            ValueType r = r_view( i, j, k, 0 ) - alpha * s;
+            ValueType u = u_view( i, j, k, 0 ) - alpha * q;
+            ValueType w = w_view( i, j, k, 0 ) - alpha * z;
+            x_view( i, j, k, 0 ) += alpha * p;
+            z_view( i, j, k, 0 ) = z;
+            q_view( i, j, k, 0 ) = q;
+            s_view( i, j, k, 0 ) = s;
+            p_view( i, j, k, 0 ) = p;
+            r_view( i, j, k, 0 ) = r;
+            u_view( i, j, k, 0 ) = u;
+            w_view( i, j, k, 0 ) = w;
+            sum[0] += r * u;
+            sum[1] += w * u;
+            sum[2] += r * r;
+        }
+
+        KOKKOS_INLINE_FUNCTION void
+        operator()( const std::integral_constant<std::size_t, 2>&, const int i,
+                    const int j, ValueType* sum ) const
+        {
+            ValueType z = n_view( i, j, 0 ) + beta * z_view( i, j, 0 );
+            ValueType q = m_view( i, j, 0 ) + beta * q_view( i, j, 0 );
+            ValueType s = w_view( i, j, 0 ) + beta * s_view( i, j, 0 );
+            ValueType p = u_view( i, j, 0 ) + beta * p_view( i, j, 0 );
+            ValueType r = r_view( i, j, 0 ) - alpha * s;
+            ValueType u = u_view( i, j, 0 ) - alpha * q;
+            ValueType w = w_view( i, j, 0 ) - alpha * z;
+            x_view( i, j, 0 ) += alpha * p;
+            z_view( i, j, 0 ) = z;
+            q_view( i, j, 0 ) = q;
+            s_view( i, j, 0 ) = s;
+            p_view( i, j, 0 ) = p;
+            r_view( i, j, 0 ) = r;
+            u_view( i, j, 0 ) = u;
+            w_view( i, j, 0 ) = w;
+            sum[0] += r * u;
+            sum[1] += w * u;
+            sum[2] += r * r;
+        }
+    };
+
+    template <class ViewX, class ViewVector, class ValueType>
+    auto createPipelinedUpdate(
+        const ViewX& x_view, const ViewVector& r_view, const ViewVector& u_view,
+        const ViewVector& w_view, const ViewVector& m_view,
+        const ViewVector& n_view, const ViewVector& z_view,
+        const ViewVector& q_view, const ViewVector& s_view,
+        const ViewVector& p_view, const ValueType& alpha,
+        const ValueType& beta )
+    {
+        return PipelinedUpdate<ViewX, ViewVector, ValueType>(
+            x_view, r_view, u_view, w_view, m_view, n_view, z_view, q_view,
+            s_view, p_view, alpha, beta );
+    }
+    //! \endcond
+
+  private:
+    // Tag for the preconditioner given to setPreconditioner().
+    struct GlobalPreconditioner
+    {
+    };
+
+    // Compute out = M in with a pointwise preconditioner operator.
+    template <class PreconditionerOperator, class HaloArray>
+    void applyPreconditioner( const PreconditionerOperator& M,
+                              const HaloArray& halo_vectors,
+                              const vector_view_type& in,
+                              const vector_view_type& out,
+                              SolverStopwatch<execution_space>& watch )
+    {
+        _M_halo->gather( execution_space(), halo_vectors );
+        watch.lap( SolverPhase::Halo );
+        grid_parallel_for(
+            "apply_preconditioner", execution_space(),
+            _vectors->layout()->localGrid()->indexSpace( Own(), EntityType(),
+                                                         Local() ),
+            std::integral_constant<std::size_t, num_space_dim>{},
+            createApplyOperator( M, in, out ) );
+        watch.lap( SolverPhase::Preconditioner );
+    }
+
+    // Compute out = M in with the preconditioner given to
+    // setPreconditioner().
+    template <class HaloArray>
+    void applyPreconditioner( const GlobalPreconditioner&, const HaloArray&,
+                              const vector_view_type& in,
+                              const vector_view_type& out,
+                              SolverStopwatch<execution_space>& watch )
+    {
+        _M_apply( in, out );
+        watch.lap( SolverPhase::Preconditioner );
+    }
+
+    // Clear the telemetry and apply the initial guess before a solve.
+    void beginSolve( Array_t& x )
+    {
+        _telemetry.beginSolve();
+        if ( SolverInitialGuess::Zero == _initial_guess )
+            ArrayOp::assign( x, 0.0, Own() );
+    }
+
+    // Record the residual norm of the current iteration.
+    void recordIteration()
+    {
+        _telemetry.setNumIter( _num_iter );
+        _telemetry.recordResidual( _residual_norm );
+    }
+
+    // Solve the problem Ax = b for x with pipelined CG. Each iteration
+    // starts the global reduction of its dot products and applies the
+    // preconditioner and the matrix before waiting on it.
+    template <class MatrixOperator, class PreconditionerOperator>
+    void solvePipelinedImpl( const MatrixOperator& A,
+                             const PreconditionerOperator& M,
+                             const Array_t& b, Array_t& x )
+    {
+        // Get the local grid.
+        auto local_grid = _vectors->layout()->localGrid();
+        MPI_Comm comm = local_grid->globalGrid().comm();
+
+        // Print banner
+        if ( 1 <= _print_level && 0 == local_grid->globalGrid().blockId() )
+            std::cout << std::endl
+                      << "Pipelined preconditioned conjugate gradient"
+                      << std::endl;
+
+        // Index space.
+        auto entity_space =
+            local_grid->indexSpace( Own(), EntityType(), Local() );
+        using dim_tag = std::integral_constant<std::size_t, num_space_dim>;
+
+        // Subarrays. The matrix is applied to m and u and the preconditioner
+        // to w and r so each pair is gathered together.
+        auto& vectors = *_pipelined_vectors;
+        auto A_halo_vectors = createSubarray( vectors, 0, 2 );
+        auto M_halo_vectors = createSubarray( vectors, 2, 4 );
+
+        // Views.
+        auto x_view = x.view();
+        auto b_view = b.view();
+        auto m_view = createSubarray( vectors, 0, 1 )->view();
+        auto u_view = createSubarray( vectors, 1, 2 )->view();
+        auto w_view = createSubarray( vectors, 2, 3 )->view();
+        auto r_view = createSubarray( vectors, 3, 4 )->view();
+        auto n_view = createSubarray( vectors, 4, 5 )->view();
+        auto z_view = createSubarray( vectors, 5, 6 )->view();
+        auto q_view = createSubarray( vectors, 6, 7 )->view();
+        auto s_view = createSubarray( vectors, 7, 8 )->view();
+        auto p_view = createSubarray( vectors, 8, 9 )->view();
+
+        // Reset iteration count.
+        _num_iter = 0;
+
+        // Compute the norm of the RHS.
+        std::vector<Scalar> b_norm( 1 );
+        ArrayOp::norm2( b, b_norm );
+
+        // Compute the initial residual from x copied into m, u = M r, and
+        // w = A u. The residual norm is taken from the dot products.
+        SolverStopwatch<execution_space> watch( _telemetry );
+        Kokkos::deep_copy( m_view, x_view );
+        watch.lap( SolverPhase::Compute );
+        _A_halo->gather( execution_space(), *A_halo_vectors );
+        watch.lap( SolverPhase::Halo );
+        Scalar r_norm = 0.0;
+        grid_parallel_reduce( "compute_r0", execution_space(), entity_space,
+                              dim_tag{},
+                              createComputeR0( A, m_view, b_view, r_view ),
+                              r_norm );
+        watch.lap( SolverPhase::Compute );
+        applyPreconditioner( M, *M_halo_vectors, r_view, u_view, watch );
+        _A_halo->gather( execution_space(), *A_halo_vectors );
+        watch.lap( SolverPhase::Halo );
+        grid_parallel_for( "compute_w0", execution_space(), entity_space,
+                           dim_tag{},
+                           createApplyOperator( A, u_view, w_view ) );
+
+        // Compute the local dot products of the first iteration.
+        std::array<Scalar, 3> dots;
+        Kokkos::parallel_reduce(
+            "pipelined_dots",
+            createExecutionPolicy( entity_space, execution_space(), dim_tag{} ),
+            createPipelinedDots<Scalar>( r_view, u_view, w_view ),
+            dots.data() );
+        watch.lap( SolverPhase::Compute );
+
+        // Iterate.
+        bool converged = false;
+        Scalar gamma_old = 0.0;
+        Scalar alpha_old = 0.0;
+        while ( true )
+        {
+            // Start the global reduction of (r,u), (w,u), and (r,r).
+            MPI_Request request;
+            MPI_Iallreduce( MPI_IN_PLACE, dots.data(), 3,
+                            MpiTraits<Scalar>::type(), MPI_SUM, comm,
+                            &request );
+            watch.lap( SolverPhase::Reduction );
+
+            // Compute m = M w and n = A m while the reduction completes.
+            applyPreconditioner( M, *M_halo_vectors, w_view, m_view, watch );
+            _A_halo->gather( execution_space(), *A_halo_vectors );
+            watch.lap( SolverPhase::Halo );
+            grid_parallel_for( "compute_n", execution_space(), entity_space,
+                               dim_tag{},
+                               createApplyOperator( A, m_view, n_view ) );
+            watch.lap( SolverPhase::Compute );
+
+            // Finish the reduction.
+            Kokkos::Profiling::pushRegion(
+                "Cajita::ReferenceConjugateGradient::wait" );
+            MPI_Wait( &request, MPI_STATUS_IGNORE );
+            Kokkos::Profiling::popRegion();
+            watch.lap( SolverPhase::Reduction );
+            Scalar gamma = dots[0];
+            Scalar delta = dots[1];
+            _residual_norm = std::sqrt( dots[2] ) / b_norm[0];
+            recordIteration();
+
+            // Output result
+            if ( 2 == _print_level && 0 == local_grid->globalGrid().blockId() )
+                std::cout << "Iteration " << _num_iter
+                          << ": |r|_2 / |b|_2 = " << _residual_norm
+                          << std::endl;
+
+            // Check for convergence.
+            if ( _residual_norm <= _tol )
+            {
+                converged = true;
+                break;
+            }
+            if ( _num_iter >= _max_iter )
+                break;
+
+            // Update the vectors and compute the local dot products of the
+            // next iteration.
+            Scalar beta = ( _num_iter > 0 ) ? gamma / gamma_old : 0.0;
+            Scalar alpha = ( _num_iter > 0 )
+                               ? gamma / ( delta - beta * gamma / alpha_old )
+                               : gamma / delta;
+            Kokkos::parallel_reduce(
+                "pipelined_update",
+                createExecutionPolicy( entity_space, execution_space(),
+                                       dim_tag{} ),
+                createPipelinedUpdate( x_view, r_view, u_view, w_view, m_view,
+                                       n_view, z_view, q_view, s_view, p_view,
+                                       alpha, beta ),
+                dots.data() );
+            watch.lap( SolverPhase::Compute );
+            gamma_old = gamma;
+            alpha_old = alpha;
+
+            // Increment iteration count.
+            _num_iter++;
+        }
+
+        // Output end state.
+        if ( 1 <= _print_level && 0 == local_grid->globalGrid().blockId() )
+            std::cout << "Finished in " << _num_iter
+                      << " iterations, converged to " << _residual_norm
+                      << std::endl
+                      << std::endl;
+
+        // If we didn't converge throw.
+        if ( !converged )
+            throw std::runtime_error( "CG solver did not converge" );
+    }
+
+    // Solve the problem Ax = b for x with the given operators.
+    template <class MatrixOperator, class PreconditionerOperator>
+    void solveImpl( const MatrixOperator& A, const PreconditionerOperator& M,
+                    const Array_t& b, Array_t& x )
+    {
+        if ( _pipelined )
+        {
+            solvePipelinedImpl( A, M, b, x );
+            return;
+        }
+
+        // Get the local grid.
+        auto local_grid = _vectors->layout()->localGrid();
+
+        // Print banner
+        if ( 1 <= _print_level && 0 == local_grid->globalGrid().blockId() )
+            std::cout << std::endl
+                      << "Preconditioned conjugate gradient" << std::endl;
+
+        // Index space.
+        auto entity_space =
+            local_grid->indexSpace( Own(), EntityType(), Local() );
+
+        // Subarrays.
+        auto p_old = createSubarray( *_vectors, 0, 1 );
+        auto z = createSubarray( *_vectors, 1, 2 );
+        auto r_old = createSubarray( *_vectors, 2, 3 );
+        auto q = createSubarray( *_vectors, 3, 4 );
+        auto p_new = createSubarray( *_vectors, 4, 5 );
+        auto r_new = createSubarray( *_vectors, 5, 6 );
+        auto A_halo_vectors = createSubarray( *_vectors, 0, 2 );
+        auto M_halo_vectors = createSubarray( *_vectors, 2, 4 );
+
+        // Views.
+        auto x_view = x.view();
+        auto b_view = b.view();
+        auto p_old_view = p_old->view();
+        auto z_view = z->view();
+        auto r_old_view = r_old->view();
+        auto q_view = q->view();
+        auto p_new_view = p_new->view();
+        auto r_new_view = r_new->view();
+
+        // Reset iteration count.
+        _num_iter = 0;
+
+        // Compute the norm of the RHS.
+        std::vector<Scalar> b_norm( 1 );
+        ArrayOp::norm2( b, b_norm );
+
+        // Copy the LHS into p so we can gather it.
+        SolverStopwatch<execution_space> watch( _telemetry );
+        Kokkos::deep_copy( p_old_view, x_view );
+        watch.lap( SolverPhase::Compute );
+
+        // Gather the LHS through gatheing p and z.
+        _A_halo->gather( execution_space(), *A_halo_vectors );
+        watch.lap( SolverPhase::Halo );
+
+        // Compute the initial residual and norm.
+        _residual_norm = 0.0;
+        auto compute_r0 = createComputeR0( A, p_old_view, b_view, r_old_view );
+        grid_parallel_reduce(
+            "compute_r0", execution_space(), entity_space,
+            std::integral_constant<std::size_t, num_space_dim>{}, compute_r0,
+            _residual_norm );
+        watch.lap( SolverPhase::Compute );
+
+        // Finish the global norm reduction.
+        MPI_Allreduce( MPI_IN_PLACE, &_residual_norm, 1,
+                       MpiTraits<Scalar>::type(), MPI_SUM,
+                       local_grid->globalGrid().comm() );
+        watch.lap( SolverPhase::Reduction );
+
+        // If we already have met our criteria then return.
+        _residual_norm = std::sqrt( _residual_norm ) / b_norm[0];
+        recordIteration();
+        if ( 2 == _print_level && 0 == local_grid->globalGrid().blockId() )
+            std::cout << "Iteration " << _num_iter
+                      << ": |r|_2 / |b|_2 = " << _residual_norm << std::endl;
+        if ( _residual_norm <= _tol )
+            return;
+
+        // r and q.
+        _M_halo->gather( execution_space(), *M_halo_vectors );
+        watch.lap( SolverPhase::Halo );
+
+        // Compute the initial preconditioned residual.
+        Scalar zTr_old = 0.0;
+        auto compute_z0 =
+            createComputeZ0( M, p_old_view, p_new_view, r_old_view, z_view );
+        grid_parallel_reduce(
+            "compute_z0", execution_space(), entity_space,
+            std::integral_constant<std::size_t, num_space_dim>{}, compute_z0,
+            zTr_old );
+        watch.lap( SolverPhase::Compute );
+
+        // Finish computation of zTr
+        MPI_Allreduce( MPI_IN_PLACE, &zTr_old, 1, MpiTraits<Scalar>::type(),
+                       MPI_SUM, local_grid->globalGrid().comm() );
+        watch.lap( SolverPhase::Reduction );
+
+        // Gather the LHS through gatheing p and z.
+        _A_halo->gather( execution_space(), *A_halo_vectors );
+        watch.lap( SolverPhase::Halo );
+
+        // Compute A*p and pT*A*p.
+        Scalar pTAp = 0.0;
+        auto compute_q0 = createComputeQ0( A, p_old_view, q_view );
+        grid_parallel_reduce(
+            "compute_q0", execution_space(), entity_space,
+            std::integral_constant<std::size_t, num_space_dim>{}, compute_q0,
+            pTAp );
+        watch.lap( SolverPhase::Compute );
+
+        // Finish the global reduction on pTAp.
+        MPI_Allreduce( MPI_IN_PLACE, &pTAp, 1, MpiTraits<Scalar>::type(),
+                       MPI_SUM, local_grid->globalGrid().comm() );
+        watch.lap( SolverPhase::Reduction );
+
+        // Iterate.
+        bool converged = false;
+        Scalar zTr_new = 0.0;
+        Scalar alpha;
+        Scalar beta;
+        while ( _residual_norm > _tol && _num_iter < _max_iter )
+        {
+            // Gather r and q.
+            _M_halo->gather( execution_space(), *M_halo_vectors );
+            watch.lap( SolverPhase::Halo );
+
+            // Kernel 1: Compute x, r, residual norm, and zTr
+            alpha = zTr_old / pTAp;
+            zTr_new = 0.0;
+            auto cg_kernel_1 =
+                createKernel1( M, x_view, r_new_view, r_old_view, p_new_view,
+                               p_old_view, z_view, q_view, alpha );
+            grid_parallel_reduce(
+                "cg_kernel_1", execution_space(), entity_space,
+                std::integral_constant<std::size_t, num_space_dim>{},
+                cg_kernel_1, zTr_new );
+            watch.lap( SolverPhase::Compute );
+
+            // Finish the global reduction on zTr and r_norm.
+            MPI_Allreduce( MPI_IN_PLACE, &zTr_new, 1, MpiTraits<Scalar>::type(),
+                           MPI_SUM, local_grid->globalGrid().comm() );
+            watch.lap( SolverPhase::Reduction );
+
+            // Update residual norm
+            _residual_norm = std::sqrt( fabs( zTr_new ) ) / b_norm[0];
+
+            // Increment iteration count.
+            _num_iter++;
+            recordIteration();
+
+            // Output result
+            if ( 2 == _print_level && 0 == local_grid->globalGrid().blockId() )
+                std::cout << "Iteration " << _num_iter
+                          << ": |r|_2 / |b|_2 = " << _residual_norm
+                          << std::endl;
+
+            // Check for convergence.
+            if ( _residual_norm <= _tol )
+            {
+                converged = true;
+                break;
+            }
+
+            // Gather p and z.
+            _A_halo->gather( execution_space(), *A_halo_vectors );
+            watch.lap( SolverPhase::Halo );
+
+            // Kernel 2: Compute p, A*p, and p^T*A*p
+            beta = zTr_new / zTr_old;
+            pTAp = 0.0;
+            auto cg_kernel_2 =
+                createKernel2( A, x_view, r_new_view, r_old_view, p_new_view,
+                               p_old_view, z_view, q_view, beta );
+            grid_parallel_reduce(
+                "cg_kernel_2", execution_space(), entity_space,
+                std::integral_constant<std::size_t, num_space_dim>{},
+                cg_kernel_2, pTAp );
+            watch.lap( SolverPhase::Compute );
+
+            // Finish the global reduction on pTAp.
+            MPI_Allreduce( MPI_IN_PLACE, &pTAp, 1, MpiTraits<Scalar>::type(),
+                           MPI_SUM, local_grid->globalGrid().comm() );
+            watch.lap( SolverPhase::Reduction );
+
+            // Update zTr
+            zTr_old = zTr_new;
+        }
+
+        // Output end state.
+        if ( 1 <= _print_level && 0 == local_grid->globalGrid().blockId() )
+            std::cout << "Finished in " << _num_iter
+                      << " iterations, converged to " << _residual_norm
+                      << std::endl
+                      << std::endl;
+
+        // If we didn't converge throw.
+        if ( !converged )
+            throw std::runtime_error( "CG solver did not converge" );
+    }
+
+    // Solve the problem Ax = b for x with the given matrix operator and the
+    // preconditioner given to setPreconditioner(). The preconditioner is
+    // applied to the whole residual between kernels so the vector updates
+    // are not fused with the operator applications.
+    template <class MatrixOperator>
+    void solvePreconditionedImpl( const MatrixOperator& A, const Array_t& b,
+                                  Array_t& x )
+    {
+        if ( _pipelined )
+        {
+            solvePipelinedImpl( A, GlobalPreconditioner(), b, x );
+            return;
+        }
+
+        // Get the local grid.
+        auto local_grid = _vectors->layout()->localGrid();
+        MPI_Comm comm = local_grid->globalGrid().comm();
+
+        // Print banner
+        if ( 1 <= _print_level && 0 == local_grid->globalGrid().blockId() )
+            std::cout << std::endl
+                      << "Preconditioned conjugate gradient" << std::endl;
+
+        // Index space.
+        auto entity_space =
+            local_grid->indexSpace( Own(), EntityType(), Local() );
+        using dim_tag = std::integral_constant<std::size_t, num_space_dim>;
+
+        // Subarrays. The matrix halo gathers p along with z.
+        auto p = createSubarray( *_vectors, 0, 1 );
+        auto z = createSubarray( *_vectors, 1, 2 );
+        auto r = createSubarray( *_vectors, 2, 3 );
+        auto q = createSubarray( *_vectors, 3, 4 );
+        auto A_halo_vectors = createSubarray( *_vectors, 0, 2 );
+
+        // Views.
+        auto x_view = x.view();
+        auto b_view = b.view();
+        auto p_view = p->view();
+        auto z_view = z->view();
+        auto r_view = r->view();
+        auto q_view = q->view();
+
+        // Reset iteration count.
+        _num_iter = 0;
+
+        // Compute the norm of the RHS.
+        std::vector<Scalar> b_norm( 1 );
+        ArrayOp::norm2( b, b_norm );
+
+        // Compute the initial residual and norm from x copied into p.
+        SolverStopwatch<execution_space> watch( _telemetry );
+        Kokkos::deep_copy( p_view, x_view );
+        watch.lap( SolverPhase::Compute );
+        _A_halo->gather( execution_space(), *A_halo_vectors );
+        watch.lap( SolverPhase::Halo );
+        _residual_norm = 0.0;
+        grid_parallel_reduce( "compute_r0", execution_space(), entity_space,
+                              dim_tag{},
+                              createComputeR0( A, p_view, b_view, r_view ),
+                              _residual_norm );
+        watch.lap( SolverPhase::Compute );
+        MPI_Allreduce( MPI_IN_PLACE, &_residual_norm, 1,
+                       MpiTraits<Scalar>::type(), MPI_SUM, comm );
+        watch.lap( SolverPhase::Reduction );
+
+        // If we already have met our criteria then return.
+        _residual_norm = std::sqrt( _residual_norm ) / b_norm[0];
+        recordIteration();
+        if ( 2 == _print_level && 0 == local_grid->globalGrid().blockId() )
+            std::cout << "Iteration " << _num_iter
+                      << ": |r|_2 / |b|_2 = " << _residual_norm << std::endl;
+        if ( _residual_norm <= _tol )
+            return;
+
+        // Compute the initial preconditioned residual and direction.
+        _M_apply( r_view, z_view );
+        watch.lap( SolverPhase::Preconditioner );
+        Scalar zTr_old = 0.0;
+        grid_parallel_reduce( "compute_z0", execution_space(), entity_space,
+                              dim_tag{}, createComputeDot( z_view, r_view ),
+                              zTr_old );
+        watch.lap( SolverPhase::Compute );
+        MPI_Allreduce( MPI_IN_PLACE, &zTr_old, 1, MpiTraits<Scalar>::type(),
+                       MPI_SUM, comm );
+        watch.lap( SolverPhase::Reduction );
+        Kokkos::deep_copy( p_view, z_view );
+        watch.lap( SolverPhase::Compute );
+
+        // Iterate.
+        bool converged = false;
+        while ( _num_iter < _max_iter )
+        {
+            // Compute A*p and pT*A*p.
+            _A_halo->gather( execution_space(), *A_halo_vectors );
+            watch.lap( SolverPhase::Halo );
+            Scalar pTAp = 0.0;
+            grid_parallel_reduce( "compute_q", execution_space(), entity_space,
+                                  dim_tag{},
+                                  createComputeQ0( A, p_view, q_view ), pTAp );
+            watch.lap( SolverPhase::Compute );
+            MPI_Allreduce( MPI_IN_PLACE, &pTAp, 1, MpiTraits<Scalar>::type(),
+                           MPI_SUM, comm );
+            watch.lap( SolverPhase::Reduction );
+
+            // Update x, r, and the residual norm.
+            Scalar alpha = zTr_old / pTAp;
+            _residual_norm = 0.0;
+            grid_parallel_reduce(
+                "update_solution", execution_space(), entity_space, dim_tag{},
+                createUpdateSolution( x_view, r_view, p_view, q_view, alpha ),
+                _residual_norm );
+            watch.lap( SolverPhase::Compute );
+            MPI_Allreduce( MPI_IN_PLACE, &_residual_norm, 1,
+                           MpiTraits<Scalar>::type(), MPI_SUM, comm );
+            watch.lap( SolverPhase::Reduction );
+            _residual_norm = std::sqrt( _residual_norm ) / b_norm[0];
+
+            // Increment iteration count.
+            _num_iter++;
+            recordIteration();
+
+            // Output result
+            if ( 2 == _print_level && 0 == local_grid->globalGrid().blockId() )
+                std::cout << "Iteration " << _num_iter
+                          << ": |r|_2 / |b|_2 = " << _residual_norm
+                          << std::endl;
+
+            // Check for convergence.
+            if ( _residual_norm <= _tol )
+            {
+                converged = true;
+                break;
+            }
+
+            // Precondition the residual and update the direction.
+            _M_apply( r_view, z_view );
+            watch.lap( SolverPhase::Preconditioner );
+            Scalar zTr_new = 0.0;
+            grid_parallel_reduce( "compute_z", execution_space(), entity_space,
+                                  dim_tag{}, createComputeDot( z_view, r_view ),
+                                  zTr_new );
+            watch.lap( SolverPhase::Compute );
+            MPI_Allreduce( MPI_IN_PLACE, &zTr_new, 1, MpiTraits<Scalar>::type(),
+                           MPI_SUM, comm );
+            watch.lap( SolverPhase::Reduction );
+            grid_parallel_for(
+                "update_direction", execution_space(), entity_space, dim_tag{},
+                createUpdateDirection( z_view, p_view, zTr_new / zTr_old ) );
+            watch.lap( SolverPhase::Compute );
+            zTr_old = zTr_new;
+        }
+
+        // Output end state.
+        if ( 1 <= _print_level && 0 == local_grid->globalGrid().blockId() )
+            std::cout << "Finished in " << _num_iter
+                      << " iterations, converged to " << _residual_norm
+                      << std::endl
+                      << std::endl;
+
+        // If we didn't converge throw.
+        if ( !converged )
+            throw std::runtime_error( "CG solver did not converge" );
+    }
+
+    // Set the stencil of a matrix.
+    void
     setStencil( const std::vector<std::array<int, num_space_dim>>& stencil,
                 const bool is_symmetric,
                 Kokkos::View<int* [num_space_dim], DeviceType>& device_stencil,
                 std::shared_ptr<Halo<memory_space>>& halo,
-                std::shared_ptr<Array_t>& matrix )
+                std::shared_ptr<Array_t>& matrix,
+                const bool allocate_matrix = true )
     {
         // For now we don't support symmetry.
         if ( is_symmetric )
@@ -917,6 +1860,13 @@ class ReferenceConjugateGradient
         pattern.setNeighbors( halo_neighbors );
         halo = createHalo<Scalar, DeviceType>( *halo_layout, pattern, width );
 
+        // Matrix-free operators do not store their values.
+        if ( !allocate_matrix )
+        {
+            matrix = nullptr;
+            return;
+        }
+
         // Create a new layout.
         auto matrix_layout =
             createArrayLayout( local_grid, stencil.size(), EntityType() );
@@ -931,6 +1881,9 @@ class ReferenceConjugateGradient
     int _print_level;
     int _num_iter;
     Scalar _residual_norm;
+    bool _pipelined;
+    SolverInitialGuess _initial_guess;
+    SolverTelemetry _telemetry;
     int _diag_entry;
     Kokkos::View<int* [num_space_dim], DeviceType> _A_stencil;
     Kokkos::View<int* [num_space_dim], DeviceType> _M_stencil;
@@ -938,7 +1891,367 @@ class ReferenceConjugateGradient
     std::shared_ptr<Halo<memory_space>> _M_halo;
     std::shared_ptr<Array_t> _A;
     std::shared_ptr<Array_t> _M;
+    std::function<void( const vector_view_type&, const vector_view_type& )>
+        _M_apply;
     std::shared_ptr<Array_t> _vectors;
+    std::shared_ptr<Array_t> _pipelined_vectors;
+};
+
+//---------------------------------------------------------------------------//
+//! \cond Impl
+namespace Impl
+{
+// Compute the residual r = b - A x with the precision of b and reduce r * r.
+template <class OperatorA, class ViewX, class ViewB, class ViewR>
+struct RefinementResidual
+{
+    OperatorA A_op;
+    ViewX x_view;
+    ViewB b_view;
+    ViewR r_view;
+
+    using value_type = typename ViewB::non_const_value_type;
+
+    KOKKOS_INLINE_FUNCTION void
+    operator()( const std::integral_constant<std::size_t, 3>&, const int i,
+                const int j, const int k, value_type& result ) const
+    {
+        value_type r = b_view( i, j, k, 0 ) -
+                       A_op( createOperatorVector( x_view ), i, j, k );
+        r_view( i, j, k, 0 ) = r;
+        result += r * r;
+    }
+
+    KOKKOS_INLINE_FUNCTION void
+    operator()( const std::integral_constant<std::size_t, 2>&, const int i,
+                const int j, value_type& result ) const
+    {
+        value_type r =
+            b_view( i, j, 0 ) - A_op( createOperatorVector( x_view ), i, j );
+        r_view( i, j, 0 ) = r;
+        result += r * r;
+    }
+};
+
+// Add a correction to the solution in the precision of the solution.
+template <class ViewX, class ViewE>
+struct RefinementCorrection
+{
+    ViewX x_view;
+    ViewE e_view;
+
+    KOKKOS_INLINE_FUNCTION void
+    operator()( const std::integral_constant<std::size_t, 3>&, const int i,
+                const int j, const int k ) const
+    {
+        x_view( i, j, k, 0 ) += e_view( i, j, k, 0 );
+    }
+
+    KOKKOS_INLINE_FUNCTION void
+    operator()( const std::integral_constant<std::size_t, 2>&, const int i,
+                const int j ) const
+    {
+        x_view( i, j, 0 ) += e_view( i, j, 0 );
+    }
+};
+} // end namespace Impl
+//! \endcond
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Reference mixed precision solver with iterative refinement.
+
+  \tparam Scalar The scalar type of the matrix, forcing term, and solution.
+  \tparam InnerScalar The scalar type of the inner conjugate gradient solver,
+  e.g. float.
+
+  Each refinement step computes the residual r = b - A x in the precision of
+  Scalar, solves A e = r approximately with a conjugate gradient solver in
+  the precision of InnerScalar, and adds the correction e to x. The solve
+  converges when the relative residual in the precision of Scalar reaches
+  the tolerance, while most of the work, the inner iterations, reads only
+  values in the precision of InnerScalar.
+
+  The matrix and preconditioner values are set in the precision of Scalar
+  and copied to the inner solver by setup(), which must be called after the
+  values change.
+*/
+template <class Scalar, class InnerScalar, class EntityType, class MeshType,
+          class DeviceType>
+class ReferenceMixedPrecisionSolver
+    : public ReferenceStructuredSolver<Scalar, EntityType, MeshType, DeviceType>
+{
+  public:
+    //! Entity type.
+    using entity_type = EntityType;
+    //! Kokkos device type.
+    using device_type = DeviceType;
+    //! Scalar value type.
+    using value_type = Scalar;
+    //! Inner solver scalar value type.
+    using inner_value_type = InnerScalar;
+    //! Kokkos execution space.
+    using execution_space = typename device_type::execution_space;
+    //! Kokkos memory space.
+    using memory_space = typename device_type::memory_space;
+    //! Array type.
+    using Array_t = Array<Scalar, EntityType, MeshType, DeviceType>;
+    //! Inner solver array type.
+    using InnerArray_t = Array<InnerScalar, EntityType, MeshType, DeviceType>;
+    //! Inner solver type.
+    using inner_solver_type =
+        ReferenceConjugateGradient<InnerScalar, EntityType, MeshType,
+                                   DeviceType>;
+    //! Spatial dimension.
+    static constexpr std::size_t num_space_dim = MeshType::num_space_dim;
+
+    /*!
+      \brief Constructor.
+      \param layout The layout of the solution and forcing term.
+    */
+    ReferenceMixedPrecisionSolver(
+        const ArrayLayout<EntityType, MeshType>& layout )
+        : _tol( 1.0e-6 )
+        , _max_refinement( 20 )
+        , _print_level( 0 )
+        , _num_iter( 0 )
+        , _residual_norm( 0.0 )
+    {
+        _inner = std::make_shared<inner_solver_type>( layout );
+        _inner->setTolerance( 1.0e-4 );
+        auto vector_layout =
+            createArrayLayout( layout.localGrid(), 1, EntityType() );
+        _x_work = createArray<Scalar, DeviceType>( "refinement_x",
+                                                   vector_layout );
+        _inner_r = createArray<InnerScalar, DeviceType>( "refinement_r",
+                                                         vector_layout );
+        _inner_e = createArray<InnerScalar, DeviceType>( "refinement_e",
+                                                         vector_layout );
+    }
+
+    /*!
+      \brief Set the matrix stencil.
+      \param stencil The (i,j,k) offsets describing the structured matrix
+      entries at each grid point. Offsets are defined relative to an index.
+      \param is_symmetric Symmetric storage is not supported.
+    */
+    void setMatrixStencil(
+        const std::vector<std::array<int, num_space_dim>>& stencil,
+        const bool is_symmetric = false ) override
+    {
+        _inner->setMatrixStencil( stencil, is_symmetric );
+        setStencil( stencil, _A_stencil, _A );
+
+        // Compose the halo pattern of the stencil to gather the solution.
+        std::set<std::array<int, num_space_dim>> neighbor_set;
+        std::array<int, num_space_dim> neighbor;
+        int width = 0;
+        for ( auto s : stencil )
+        {
+            for ( std::size_t d = 0; d < num_space_dim; ++d )
+            {
+                neighbor[d] = ( s[d] == 0 ) ? 0 : s[d] / std::abs( s[d] );
+                width = std::max( width, std::abs( s[d] ) );
+            }
+            neighbor_set.emplace( neighbor );
+        }
+        HaloPattern<num_space_dim> pattern;
+        pattern.setNeighbors( std::vector<std::array<int, num_space_dim>>(
+            neighbor_set.begin(), neighbor_set.end() ) );
+        _x_halo = createHalo( *_x_work, pattern, width );
+    }
+
+    //! Get the matrix values.
+    const Array_t& getMatrixValues() override { return *_A; }
+
+    /*!
+      \brief Set the preconditioner stencil of the inner solver.
+      \param stencil The (i,j,k) offsets describing the structured
+      preconditioner entries at each grid point.
+      \param is_symmetric Symmetric storage is not supported.
+    */
+    void setPreconditionerStencil(
+        const std::vector<std::array<int, num_space_dim>>& stencil,
+        const bool is_symmetric = false ) override
+    {
+        _inner->setPreconditionerStencil( stencil, is_symmetric );
+        setStencil( stencil, _M_stencil, _M );
+    }
+
+    //! Get the preconditioner values.
+    const Array_t& getPreconditionerValues() override { return *_M; }
+
+    //! Set the relative residual norm at which the refinement converges.
+    void setTolerance( const double tol ) override { _tol = tol; }
+
+    //! Set the maximum number of iterations of each inner solve.
+    void setMaxIter( const int max_iter ) override
+    {
+        _inner->setMaxIter( max_iter );
+    }
+
+    //! Set the output level.
+    void setPrintLevel( const int print_level ) override
+    {
+        _print_level = print_level;
+    }
+
+    //! Set the relative residual norm at which each inner solve converges.
+    void setInnerTolerance( const double tol ) { _inner->setTolerance( tol ); }
+
+    //! Set the maximum number of refinement steps.
+    void setMaxRefinementSteps( const int max_refinement )
+    {
+        _max_refinement = max_refinement;
+    }
+
+    //! Get the inner solver, e.g. to enable pipelining.
+    inner_solver_type& innerSolver() { return *_inner; }
+
+    //! Copy the matrix and preconditioner values to the inner solver.
+    void setup() override
+    {
+        Cabana::Impl::ScopedProfileRegion region(
+            "Cajita::ReferenceMixedPrecisionSolver::setup" );
+
+        if ( !_A || !_M )
+            throw std::runtime_error(
+                "Matrix and preconditioner values must be set to setup" );
+        Kokkos::deep_copy( _inner->getMatrixValues().view(), _A->view() );
+        Kokkos::deep_copy( _inner->getPreconditionerValues().view(),
+                           _M->view() );
+        _inner->setup();
+    }
+
+    /*!
+      \brief Solve the problem Ax = b for x.
+      \param b The forcing term.
+      \param x The solution.
+    */
+    void solve( const Array_t& b, Array_t& x ) override
+    {
+        Cabana::Impl::ScopedProfileRegion region(
+            "Cajita::ReferenceMixedPrecisionSolver::solve" );
+
+        if ( !_A || !_M )
+            throw std::runtime_error(
+                "Matrix and preconditioner values must be set to solve" );
+
+        // Get the local grid.
+        auto local_grid = _x_work->layout()->localGrid();
+        bool print = 0 == local_grid->globalGrid().blockId();
+
+        // Print banner
+        if ( 1 <= _print_level && print )
+            std::cout << std::endl
+                      << "Mixed precision iterative refinement" << std::endl;
+
+        // Index space.
+        auto entity_space =
+            local_grid->indexSpace( Own(), EntityType(), Local() );
+        using dim_tag = std::integral_constant<std::size_t, num_space_dim>;
+
+        // Compute the norm of the RHS.
+        std::vector<Scalar> b_norm( 1 );
+        ArrayOp::norm2( b, b_norm );
+
+        _num_iter = 0;
+        auto A_op = createStencilMatrixOperator( _A_stencil, _A->view() );
+        for ( int step = 0; step <= _max_refinement; ++step )
+        {
+            // Compute the residual from x copied into the work vector so we
+            // can gather it. The residual is stored in inner precision.
+            Kokkos::deep_copy( _x_work->view(), x.view() );
+            _x_halo->gather( execution_space(), *_x_work );
+            Scalar r_norm = 0.0;
+            Impl::RefinementResidual<decltype( A_op ),
+                                     typename Array_t::view_type,
+                                     typename Array_t::view_type,
+                                     typename InnerArray_t::view_type>
+                residual{ A_op, _x_work->view(), b.view(), _inner_r->view() };
+            grid_parallel_reduce( "refinement_residual", execution_space(),
+                                  entity_space, dim_tag{}, residual, r_norm );
+            MPI_Allreduce( MPI_IN_PLACE, &r_norm, 1, MpiTraits<Scalar>::type(),
+                           MPI_SUM, local_grid->globalGrid().comm() );
+            _residual_norm = std::sqrt( r_norm ) / b_norm[0];
+
+            if ( 2 == _print_level && print )
+                std::cout << "Refinement step " << step
+                          << ": |r|_2 / |b|_2 = " << _residual_norm
+                          << std::endl;
+
+            // Check for convergence.
+            if ( _residual_norm <= _tol )
+            {
+                if ( 1 <= _print_level && print )
+                    std::cout << "Finished in " << step
+                              << " refinement steps and " << _num_iter
+                              << " inner iterations, converged to "
+                              << _residual_norm << std::endl
+                              << std::endl;
+                return;
+            }
+            if ( step == _max_refinement )
+                break;
+
+            // Solve for the correction in inner precision and apply it.
+            ArrayOp::assign( *_inner_e, 0.0, Ghost() );
+            _inner->solve( *_inner_r, *_inner_e );
+            _num_iter += _inner->getNumIter();
+            Impl::RefinementCorrection<typename Array_t::view_type,
+                                       typename InnerArray_t::view_type>
+                correction{ x.view(), _inner_e->view() };
+            grid_parallel_for( "refinement_correction", execution_space(),
+                               entity_space, dim_tag{}, correction );
+        }
+
+        throw std::runtime_error( "Mixed precision solver did not converge" );
+    }
+
+    //! Get the total number of inner iterations taken on the last solve.
+    int getNumIter() override { return _num_iter; }
+
+    //! Get the relative residual norm achieved on the last solve.
+    double getFinalRelativeResidualNorm() override { return _residual_norm; }
+
+  private:
+    // Copy a stencil to the device and allocate its values.
+    void
+    setStencil( const std::vector<std::array<int, num_space_dim>>& stencil,
+                Kokkos::View<int* [num_space_dim], DeviceType>& device_stencil,
+                std::shared_ptr<Array_t>& matrix )
+    {
+        device_stencil = Kokkos::View<int* [num_space_dim], DeviceType>(
+            Kokkos::ViewAllocateWithoutInitializing( "stencil" ),
+            stencil.size() );
+        auto stencil_mirror =
+            Kokkos::create_mirror_view( Kokkos::HostSpace(), device_stencil );
+        for ( unsigned s = 0; s < stencil.size(); ++s )
+            for ( std::size_t d = 0; d < num_space_dim; ++d )
+                stencil_mirror( s, d ) = stencil[s][d];
+        Kokkos::deep_copy( device_stencil, stencil_mirror );
+
+        auto matrix_layout =
+            createArrayLayout( _x_work->layout()->localGrid(), stencil.size(),
+                               EntityType() );
+        matrix = createArray<Scalar, DeviceType>( "matrix", matrix_layout );
+    }
+
+  private:
+    Scalar _tol;
+    int _max_refinement;
+    int _print_level;
+    int _num_iter;
+    Scalar _residual_norm;
+    std::shared_ptr<inner_solver_type> _inner;
+    Kokkos::View<int* [num_space_dim], DeviceType> _A_stencil;
+    Kokkos::View<int* [num_space_dim], DeviceType> _M_stencil;
+    std::shared_ptr<Array_t> _A;
+    std::shared_ptr<Array_t> _M;
+    std::shared_ptr<Halo<memory_space>> _x_halo;
+    std::shared_ptr<Array_t> _x_work;
+    std::shared_ptr<InnerArray_t> _inner_r;
+    std::shared_ptr<InnerArray_t> _inner_e;
 };
 
 //---------------------------------------------------------------------------//
@@ -957,6 +2270,20 @@ createReferenceConjugateGradient(
         layout );
 }
 
+//---------------------------------------------------------------------------//
+//! Creation function for reference mixed precision iterative refinement
+//! with an inner conjugate gradient solver.
+template <class Scalar, class InnerScalar, class DeviceType, class EntityType,
+          class MeshType>
+std::shared_ptr<ReferenceMixedPrecisionSolver<Scalar, InnerScalar, EntityType,
+                                              MeshType, DeviceType>>
+createReferenceMixedPrecisionSolver(
+    const ArrayLayout<EntityType, MeshType>& layout )
+{
+    return std::make_shared<ReferenceMixedPrecisionSolver<
+        Scalar, InnerScalar, EntityType, MeshType, DeviceType>>( layout );
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Cajita
@@ -0,0 +1,197 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cajita_SolverTelemetry.hpp
+  \brief Structured solver performance telemetry and initial guess controls
+*/
+#ifndef CAJITA_SOLVERTELEMETRY_HPP
+#define CAJITA_SOLVERTELEMETRY_HPP
+
+#include <Kokkos_Core.hpp>
+
+#include <array>
+#include <vector>
+
+namespace Cajita
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief Phases of a structured solve timed by the solver telemetry.
+*/
+enum class SolverPhase
+{
+    //! Solver and preconditioner setup.
+    Setup = 0,
+    //! Copies between Cajita arrays and solver library data structures.
+    Transfer,
+    //! Halo gathers.
+    Halo,
+    //! Local kernels (matrix-vector products, vector updates, local dot
+    //! products).
+    Compute,
+    //! Preconditioner application.
+    Preconditioner,
+    //! Global reductions.
+    Reduction,
+    //! Iterations executed inside a third-party solver library.
+    Library,
+    //! Number of phases.
+    Count
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Initial guess used by a structured solve.
+*/
+enum class SolverInitialGuess
+{
+    //! Use the values of the solution array passed to the solve.
+    Given,
+    //! Start from zero.
+    Zero,
+    //! Start from the solution of the previous solve retained by the solver.
+    Previous
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Per-solve solver telemetry.
+
+  Holds the iteration count, the residual history, and the time spent in
+  each phase of the last solve. The setup time is that of the last setup.
+  Timing fences the execution space between phases and is therefore only
+  performed when enabled. The iteration count and residual history are
+  always recorded.
+*/
+class SolverTelemetry
+{
+  public:
+    //! Enable or disable phase timing.
+    void setEnabled( const bool enabled ) { _enabled = enabled; }
+
+    //! Get whether phase timing is enabled.
+    bool enabled() const { return _enabled; }
+
+    //! Clear the data of the last solve. The setup time is kept.
+    void beginSolve()
+    {
+        _num_iter = 0;
+        _residual_history.clear();
+        for ( int p = 0; p < static_cast<int>( SolverPhase::Count ); ++p )
+            if ( static_cast<int>( SolverPhase::Setup ) != p )
+                _phase_time[p] = 0.0;
+    }
+
+    //! Clear the setup time.
+    void beginSetup()
+    {
+        _phase_time[static_cast<int>( SolverPhase::Setup )] = 0.0;
+    }
+
+    //! Set the number of iterations of the last solve.
+    void setNumIter( const int num_iter ) { _num_iter = num_iter; }
+
+    //! Get the number of iterations of the last solve.
+    int numIter() const { return _num_iter; }
+
+    //! Append a residual norm to the residual history.
+    void recordResidual( const double residual )
+    {
+        _residual_history.push_back( residual );
+    }
+
+    //! Get the residual norms of the last solve in iteration order.
+    const std::vector<double>& residualHistory() const
+    {
+        return _residual_history;
+    }
+
+    //! Add time in seconds to a phase.
+    void addTime( const SolverPhase phase, const double seconds )
+    {
+        _phase_time[static_cast<int>( phase )] += seconds;
+    }
+
+    //! Get the time in seconds spent in a phase.
+    double phaseTime( const SolverPhase phase ) const
+    {
+        return _phase_time[static_cast<int>( phase )];
+    }
+
+    //! Get the time in seconds spent in all phases of the last solve.
+    double solveTime() const
+    {
+        double time = 0.0;
+        for ( int p = 0; p < static_cast<int>( SolverPhase::Count ); ++p )
+            if ( static_cast<int>( SolverPhase::Setup ) != p )
+                time += _phase_time[p];
+        return time;
+    }
+
+  private:
+    bool _enabled = false;
+    int _num_iter = 0;
+    std::vector<double> _residual_history;
+    std::array<double, static_cast<int>( SolverPhase::Count )> _phase_time =
+        {};
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Attribute the time between consecutive laps to solve phases.
+
+  Does nothing if the telemetry is disabled. Otherwise the execution space
+  is fenced at construction and at every lap such that asynchronous kernels
+  are charged to the phase that launched them.
+*/
+template <class ExecutionSpace>
+class SolverStopwatch
+{
+  public:
+    /*!
+      \brief Constructor. Starts the first lap.
+      \param telemetry The telemetry to add the lap times to.
+      \param exec_space The execution space to fence.
+    */
+    SolverStopwatch( SolverTelemetry& telemetry,
+                     const ExecutionSpace& exec_space = ExecutionSpace() )
+        : _telemetry( telemetry )
+        , _exec_space( exec_space )
+    {
+        if ( _telemetry.enabled() )
+        {
+            _exec_space.fence();
+            _timer.reset();
+        }
+    }
+
+    //! Charge the time since the last lap to a phase and start a new lap.
+    void lap( const SolverPhase phase )
+    {
+        if ( !_telemetry.enabled() )
+            return;
+        _exec_space.fence();
+        _telemetry.addTime( phase, _timer.seconds() );
+        _timer.reset();
+    }
+
+  private:
+    SolverTelemetry& _telemetry;
+    ExecutionSpace _exec_space;
+    Kokkos::Timer _timer;
+};
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cajita
+
+#endif // end CAJITA_SOLVERTELEMETRY_HPP
@@ -0,0 +1,586 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cajita_SparseArray.hpp
+  \brief Tile-allocated grid field data and halo for sparse grids
+*/
+#ifndef CAJITA_SPARSE_ARRAY_HPP
+#define CAJITA_SPARSE_ARRAY_HPP
+
+#include <Cajita_IndexSpace.hpp>
+#include <Cajita_LocalGrid.hpp>
+#include <Cajita_SparseIndexSpace.hpp>
+#include <Cajita_Types.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Cajita
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief Device accessor of the field data of a sparse array.
+
+  Cells are addressed either by their global cell indices, which are located
+  through the sparse map, or directly by their tile number and the offset of
+  the cell inside the tile.
+*/
+template <class Scalar, class DeviceType, class SparseMapType>
+struct SparseArrayView
+{
+    //! Sparse map type.
+    using sparse_map_type = SparseMapType;
+    //! Tile data view type, indexed by (tile No., cell offset, dof).
+    using view_type = Kokkos::View<Scalar***, DeviceType>;
+
+    //! Sparse map locating the tiles.
+    sparse_map_type map;
+    //! Tile data.
+    view_type data;
+
+    //! Access a cell dof by its global cell indices.
+    KOKKOS_INLINE_FUNCTION
+    Scalar& operator()( const int i, const int j, const int k,
+                        const int d ) const
+    {
+        constexpr int mask = sparse_map_type::cell_mask_per_tile_dim;
+        return data( map.queryTile( i, j, k ),
+                     TileMap<sparse_map_type::cell_bits_per_tile_dim,
+                             sparse_map_type::cell_num_per_tile_dim,
+                             sparse_map_type::cell_num_per_tile>::
+                         coordToOffset( i & mask, j & mask, k & mask ),
+                     d );
+    }
+
+    //! Access a cell dof by its tile number and offset inside the tile.
+    KOKKOS_INLINE_FUNCTION
+    Scalar& operator()( const int tile, const int cell, const int d ) const
+    {
+        return data( tile, cell, d );
+    }
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Grid field data allocated per tile of a sparse map.
+
+  \tparam Scalar Field value type.
+  \tparam DeviceType Device type the data is allocated on.
+  \tparam SparseMapType Sparse map type registering the active tiles.
+
+  Storage is allocated only for the tiles inserted into the sparse map and is
+  indexed by the tile number the map assigns to each tile. Tile numbers are
+  stable under insertion, so after tiles are inserted the array keeps its
+  values when resized. Clearing the map renumbers the tiles and invalidates
+  the data.
+*/
+template <class Scalar, class DeviceType, class SparseMapType>
+class SparseArray
+{
+  public:
+    //! Value type.
+    using value_type = Scalar;
+    //! Kokkos device type.
+    using device_type = DeviceType;
+    //! Kokkos memory space.
+    using memory_space = typename device_type::memory_space;
+    //! Kokkos execution space.
+    using execution_space = typename device_type::execution_space;
+    //! Sparse map type.
+    using sparse_map_type = SparseMapType;
+    //! Device accessor type.
+    using sparse_view_type =
+        SparseArrayView<Scalar, DeviceType, SparseMapType>;
+    //! Tile data view type, indexed by (tile No., cell offset, dof).
+    using view_type = typename sparse_view_type::view_type;
+    //! Number of cells in each tile.
+    static constexpr int cell_num_per_tile =
+        sparse_map_type::cell_num_per_tile;
+
+    /*!
+      \brief Constructor.
+      \param label Array label.
+      \param map Sparse map registering the active tiles.
+      \param dofs_per_cell Number of degrees of freedom in each cell.
+    */
+    SparseArray( const std::string& label,
+                 const std::shared_ptr<sparse_map_type>& map,
+                 const int dofs_per_cell )
+        : _map( map )
+        , _data( label, map->size(), cell_num_per_tile, dofs_per_cell )
+    {
+    }
+
+    //! Get the sparse map.
+    const std::shared_ptr<sparse_map_type>& map() const { return _map; }
+
+    //! Get the tile data view.
+    view_type view() const { return _data; }
+
+    //! Get a device accessor of the array. It must be recreated after
+    //! resizing the array or rehashing the map.
+    sparse_view_type sparseView() const
+    {
+        return sparse_view_type{ *_map, _data };
+    }
+
+    //! Get the array label.
+    std::string label() const { return _data.label(); }
+
+    //! Get the number of allocated tiles.
+    int numTile() const { return _data.extent( 0 ); }
+
+    //! Get the number of degrees of freedom in each cell.
+    int dofsPerCell() const { return _data.extent( 2 ); }
+
+    /*!
+      \brief Allocate the tiles inserted into the map since the last resize.
+      Values of the existing tiles are kept; new tiles are zero.
+    */
+    void resize()
+    {
+        int num_tile = _map->size();
+        if ( num_tile > numTile() )
+            Kokkos::resize( _data, num_tile, cell_num_per_tile,
+                            dofsPerCell() );
+    }
+
+  private:
+    std::shared_ptr<sparse_map_type> _map;
+    view_type _data;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create a sparse array.
+  \param label Array label.
+  \param map Sparse map registering the active tiles.
+  \param dofs_per_cell Number of degrees of freedom in each cell.
+*/
+template <class Scalar, class DeviceType, class SparseMapType>
+std::shared_ptr<SparseArray<Scalar, DeviceType, SparseMapType>>
+createSparseArray( const std::string& label,
+                   const std::shared_ptr<SparseMapType>& map,
+                   const int dofs_per_cell )
+{
+    return std::make_shared<SparseArray<Scalar, DeviceType, SparseMapType>>(
+        label, map, dofs_per_cell );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Execute a functor in parallel over the cells of the tiles
+  registered in a sparse map.
+  \param label Kernel label.
+  \param exec_space Execution space.
+  \param map Sparse map registering the active tiles.
+  \param functor Functor taking the global cell indices (i, j, k).
+
+  Only registered tiles are visited so the work scales with the number of
+  active tiles instead of the bounding box of the grid.
+*/
+template <class FunctorType, class ExecutionSpace, class SparseMapType>
+void sparse_grid_parallel_for( const std::string& label,
+                               const ExecutionSpace& exec_space,
+                               const SparseMapType& map,
+                               const FunctorType& functor )
+{
+    using key_type = typename SparseMapType::key_type;
+    constexpr int cells_per_tile = SparseMapType::cell_num_per_tile;
+    constexpr int cell_bits = SparseMapType::cell_bits_per_tile_dim;
+    using tile_map_type =
+        TileMap<cell_bits, SparseMapType::cell_num_per_tile_dim,
+                cells_per_tile>;
+
+    Kokkos::parallel_for(
+        label,
+        Kokkos::RangePolicy<ExecutionSpace>(
+            exec_space, 0,
+            static_cast<std::size_t>( map.capacity() ) * cells_per_tile ),
+        KOKKOS_LAMBDA( const std::size_t n ) {
+            uint32_t index = n / cells_per_tile;
+            if ( !map.valid_at( index ) )
+                return;
+            key_type key = map.key_at( index );
+            int ti, tj, tk;
+            map.key2ijk( key, ti, tj, tk );
+            int ci, cj, ck;
+            tile_map_type::offsetToCoord( n % cells_per_tile, ci, cj, ck );
+            functor( ( ti << cell_bits ) + ci, ( tj << cell_bits ) + cj,
+                     ( tk << cell_bits ) + ck );
+        } );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Halo exchange of sparse arrays.
+
+  A gather sends the active tiles a rank owns in the halo region of each
+  neighbor. The neighbor registers the received tiles in its sparse map,
+  allocates them and copies in the data, so ghost tiles exist only where the
+  neighbor has active tiles. Tiles are keyed by their global indices: tiles
+  received across a periodic boundary are stored at the global indices of
+  their owner and exchanges of a rank with itself are skipped.
+
+  A scatter sends the active ghost tiles of a rank that lie in the owned
+  region of each neighbor and the neighbor adds them to its tiles, inserting
+  tiles it does not have yet, e.g. to sum point-to-grid contributions.
+
+  Rank boundaries must align with the tiles, as given by the sparse
+  partitioner, and ghost data is overwritten on each gather.
+*/
+template <class Scalar, class DeviceType, class SparseMapType>
+class SparseHalo
+{
+  public:
+    //! Sparse array type.
+    using array_type = SparseArray<Scalar, DeviceType, SparseMapType>;
+    //! Kokkos memory space.
+    using memory_space = typename array_type::memory_space;
+    //! Kokkos execution space.
+    using execution_space = typename array_type::execution_space;
+    //! Sparse map type.
+    using sparse_map_type = SparseMapType;
+
+    /*!
+      \brief Constructor.
+      \param local_grid The local grid the sparse arrays are defined on. Its
+      halo width sets the width of the exchanged region.
+    */
+    template <class MeshType>
+    SparseHalo( const LocalGrid<MeshType>& local_grid )
+    {
+        static_assert( 3 == MeshType::num_space_dim,
+                       "Sparse halos are three dimensional" );
+
+        MPI_Comm_dup( local_grid.globalGrid().comm(), &_comm );
+        int my_rank;
+        MPI_Comm_rank( _comm, &my_rank );
+
+        // Cells shared with each neighbor, in global tile indices.
+        int halo = local_grid.haloCellWidth();
+        const auto& global_grid = local_grid.globalGrid();
+        for ( int k = -1; k < 2; ++k )
+            for ( int j = -1; j < 2; ++j )
+                for ( int i = -1; i < 2; ++i )
+                {
+                    int rank = local_grid.neighborRank( i, j, k );
+                    if ( ( i == 0 && j == 0 && k == 0 ) || rank < 0 ||
+                         rank == my_rank )
+                        continue;
+                    int id = ( i + 1 ) + 3 * ( ( j + 1 ) + 3 * ( k + 1 ) );
+                    _neighbor_ranks.push_back( rank );
+                    _send_tags.push_back( id );
+                    _receive_tags.push_back( 26 - id );
+                    _own_boxes.push_back( tileBox(
+                        global_grid,
+                        local_grid.sharedIndexSpace( Own(), Cell(), i, j, k ),
+                        halo ) );
+                    _ghost_boxes.push_back( tileBox(
+                        global_grid,
+                        local_grid.sharedIndexSpace( Ghost(), Cell(), i, j,
+                                                     k ),
+                        halo ) );
+                }
+    }
+
+    // Destructor.
+    ~SparseHalo() { MPI_Comm_free( &_comm ); }
+
+    /*!
+      \brief Gather the owned boundary tiles of the neighbors into the ghost
+      tiles of an array.
+      \param exec_space The execution space to use for packing and unpacking.
+      \param array The sparse array to gather. New ghost tiles are inserted
+      into its map and the array is resized.
+    */
+    void gather( const execution_space& exec_space, array_type& array ) const
+    {
+        exchange( exec_space, array, _own_boxes, false );
+    }
+
+    /*!
+      \brief Sum the ghost tiles of an array into the owned tiles of the
+      neighbors.
+      \param exec_space The execution space to use for packing and unpacking.
+      \param array The sparse array to scatter. Received tiles missing on
+      this rank are inserted into its map and the array is resized.
+    */
+    void scatter( const execution_space& exec_space, array_type& array ) const
+    {
+        exchange( exec_space, array, _ghost_boxes, true );
+    }
+
+    //! Get the number of neighbors exchanging tiles with this rank.
+    int numNeighbor() const { return _neighbor_ranks.size(); }
+
+    //! \cond Impl
+    // The kernels are public static members so they can be compiled for
+    // device backends.
+
+    // Collect the registered tiles inside a box of global tile indices.
+    static Kokkos::View<int* [3], memory_space>
+    findTiles( const execution_space& exec_space, const sparse_map_type& map,
+               const Kokkos::Array<int, 6>& box, int& count )
+    {
+        using key_type = typename sparse_map_type::key_type;
+        Kokkos::View<int* [3], memory_space> tiles(
+            Kokkos::ViewAllocateWithoutInitializing( "sparse_halo_tiles" ),
+            map.size() );
+        Kokkos::View<int, memory_space> counter( "sparse_halo_counter" );
+        Kokkos::parallel_for(
+            "Cajita::SparseHalo::findTiles",
+            Kokkos::RangePolicy<execution_space>( exec_space, 0,
+                                                  map.capacity() ),
+            KOKKOS_LAMBDA( const uint32_t index ) {
+                if ( !map.valid_at( index ) )
+                    return;
+                key_type key = map.key_at( index );
+                int ijk[3];
+                map.key2ijk( key, ijk[0], ijk[1], ijk[2] );
+                for ( int d = 0; d < 3; ++d )
+                    if ( ijk[d] < box[d] || ijk[d] >= box[d + 3] )
+                        return;
+                int t = Kokkos::atomic_fetch_add( &counter(), 1 );
+                for ( int d = 0; d < 3; ++d )
+                    tiles( t, d ) = ijk[d];
+            } );
+        auto counter_host =
+            Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), counter );
+        count = counter_host();
+        return tiles;
+    }
+
+    // Copy the data of a list of tiles into a buffer.
+    template <class SparseViewType>
+    static void packTiles( const execution_space& exec_space,
+                           const SparseViewType& array,
+                           const Kokkos::View<int* [3], memory_space>& tiles,
+                           const Kokkos::View<Scalar*, memory_space>& buffer )
+    {
+        constexpr int cell_bits = sparse_map_type::cell_bits_per_tile_dim;
+        int tile_size = array.data.extent( 1 ) * array.data.extent( 2 );
+        int dofs = array.data.extent( 2 );
+        Kokkos::parallel_for(
+            "Cajita::SparseHalo::pack",
+            Kokkos::RangePolicy<execution_space>( exec_space, 0,
+                                                  buffer.size() ),
+            KOKKOS_LAMBDA( const int n ) {
+                int t = n / tile_size;
+                int tile = array.map.queryTile( tiles( t, 0 ) << cell_bits,
+                                                tiles( t, 1 ) << cell_bits,
+                                                tiles( t, 2 ) << cell_bits );
+                buffer( n ) = array( tile, ( n % tile_size ) / dofs, n % dofs );
+            } );
+    }
+
+    // Register a list of tiles in a sparse map.
+    static void insertTiles( const execution_space& exec_space,
+                             const sparse_map_type& map,
+                             const Kokkos::View<int* [3], memory_space>& tiles )
+    {
+        Kokkos::parallel_for(
+            "Cajita::SparseHalo::insert",
+            Kokkos::RangePolicy<execution_space>( exec_space, 0,
+                                                  tiles.extent( 0 ) ),
+            KOKKOS_LAMBDA( const int t ) {
+                map.insertTile( tiles( t, 0 ), tiles( t, 1 ), tiles( t, 2 ) );
+            } );
+    }
+
+    // Copy or add a buffer into the data of a list of tiles.
+    template <class SparseViewType>
+    static void
+    unpackTiles( const execution_space& exec_space,
+                 const SparseViewType& array,
+                 const Kokkos::View<int* [3], memory_space>& tiles,
+                 const Kokkos::View<Scalar*, memory_space>& buffer,
+                 const bool add )
+    {
+        constexpr int cell_bits = sparse_map_type::cell_bits_per_tile_dim;
+        int tile_size = array.data.extent( 1 ) * array.data.extent( 2 );
+        int dofs = array.data.extent( 2 );
+        Kokkos::parallel_for(
+            "Cajita::SparseHalo::unpack",
+            Kokkos::RangePolicy<execution_space>( exec_space, 0,
+                                                  buffer.size() ),
+            KOKKOS_LAMBDA( const int n ) {
+                int t = n / tile_size;
+                int tile = array.map.queryTile( tiles( t, 0 ) << cell_bits,
+                                                tiles( t, 1 ) << cell_bits,
+                                                tiles( t, 2 ) << cell_bits );
+                auto& value =
+                    array( tile, ( n % tile_size ) / dofs, n % dofs );
+                value = add ? value + buffer( n ) : buffer( n );
+            } );
+    }
+    //! \endcond
+
+  private:
+    // Global tile box of a local cell index space. Boxes across a periodic
+    // boundary are moved to the tile indices of their owner.
+    template <class GlobalGridType>
+    static Kokkos::Array<int, 6> tileBox( const GlobalGridType& global_grid,
+                                          const IndexSpace<3>& space,
+                                          const int halo )
+    {
+        constexpr int cell_bits = sparse_map_type::cell_bits_per_tile_dim;
+        Kokkos::Array<int, 6> box;
+        for ( int d = 0; d < 3; ++d )
+        {
+            int offset = global_grid.globalOffset( d ) - halo;
+            int num_tile = global_grid.globalNumEntity( Cell(), d ) >>
+                           cell_bits;
+            box[d] = ( space.min( d ) + offset ) >> cell_bits;
+            box[d + 3] = ( ( space.max( d ) + offset - 1 ) >> cell_bits ) + 1;
+            int shift = 0;
+            if ( box[d + 3] <= 0 )
+                shift = num_tile;
+            else if ( box[d] >= num_tile )
+                shift = -num_tile;
+            box[d] += shift;
+            box[d + 3] += shift;
+        }
+        return box;
+    }
+
+    // Send the tiles of an array inside the given box of each neighbor and
+    // copy or add the received tiles.
+    void exchange( const execution_space& exec_space, array_type& array,
+                   const std::vector<Kokkos::Array<int, 6>>& boxes,
+                   const bool add ) const
+    {
+        int num_n = _neighbor_ranks.size();
+        int dofs = array.dofsPerCell();
+        constexpr int cells_per_tile = array_type::cell_num_per_tile;
+        int tile_size = cells_per_tile * dofs;
+
+        // Find and pack the tiles to send to each neighbor.
+        std::vector<int> send_count( num_n );
+        std::vector<Kokkos::View<int* [3], memory_space>> send_tiles( num_n );
+        std::vector<Kokkos::View<Scalar*, memory_space>> send_data( num_n );
+        for ( int n = 0; n < num_n; ++n )
+        {
+            send_tiles[n] =
+                findTiles( exec_space, *array.map(), boxes[n], send_count[n] );
+            send_data[n] = Kokkos::View<Scalar*, memory_space>(
+                Kokkos::ViewAllocateWithoutInitializing( "send_data" ),
+                send_count[n] * tile_size );
+            packTiles( exec_space, array.sparseView(), send_tiles[n],
+                       send_data[n] );
+        }
+        exec_space.fence();
+
+        // Exchange the tile counts.
+        std::vector<int> recv_count( num_n );
+        std::vector<MPI_Request> requests( 2 * num_n );
+        for ( int n = 0; n < num_n; ++n )
+        {
+            MPI_Irecv( &recv_count[n], 1, MPI_INT, _neighbor_ranks[n],
+                       1234 + _receive_tags[n], _comm, &requests[n] );
+            MPI_Isend( &send_count[n], 1, MPI_INT, _neighbor_ranks[n],
+                       1234 + _send_tags[n], _comm, &requests[num_n + n] );
+        }
+        MPI_Waitall( requests.size(), requests.data(), MPI_STATUSES_IGNORE );
+
+        // Exchange the tile indices and data.
+        std::vector<Kokkos::View<int* [3], memory_space>> recv_tiles( num_n );
+        std::vector<Kokkos::View<Scalar*, memory_space>> recv_data( num_n );
+        requests.assign( 4 * num_n, MPI_REQUEST_NULL );
+        for ( int n = 0; n < num_n; ++n )
+        {
+            recv_tiles[n] = Kokkos::View<int* [3], memory_space>(
+                Kokkos::ViewAllocateWithoutInitializing( "recv_tiles" ),
+                recv_count[n] );
+            recv_data[n] = Kokkos::View<Scalar*, memory_space>(
+                Kokkos::ViewAllocateWithoutInitializing( "recv_data" ),
+                recv_count[n] * tile_size );
+            if ( recv_count[n] > 0 )
+            {
+                MPI_Irecv( recv_tiles[n].data(), 3 * recv_count[n], MPI_INT,
+                           _neighbor_ranks[n], 2345 + _receive_tags[n],
+                           _comm, &requests[n] );
+                MPI_Irecv( recv_data[n].data(),
+                           recv_data[n].size() * sizeof( Scalar ), MPI_BYTE,
+                           _neighbor_ranks[n], 3456 + _receive_tags[n],
+                           _comm, &requests[num_n + n] );
+            }
+            if ( send_count[n] > 0 )
+            {
+                MPI_Isend( send_tiles[n].data(), 3 * send_count[n], MPI_INT,
+                           _neighbor_ranks[n], 2345 + _send_tags[n], _comm,
+                           &requests[2 * num_n + n] );
+                MPI_Isend( send_data[n].data(),
+                           send_data[n].size() * sizeof( Scalar ), MPI_BYTE,
+                           _neighbor_ranks[n], 3456 + _send_tags[n], _comm,
+                           &requests[3 * num_n + n] );
+            }
+        }
+        MPI_Waitall( 2 * num_n, requests.data(), MPI_STATUSES_IGNORE );
+
+        // Register and allocate the received tiles.
+        int total_recv = 0;
+        for ( int n = 0; n < num_n; ++n )
+            total_recv += recv_count[n];
+        auto& map = *array.map();
+        if ( map.capacity() < map.size() + total_recv )
+            map.reserve( map.size() + total_recv );
+        for ( int n = 0; n < num_n; ++n )
+            insertTiles( exec_space, map, recv_tiles[n] );
+        exec_space.fence();
+        array.resize();
+
+        // Unpack the received data.
+        for ( int n = 0; n < num_n; ++n )
+            unpackTiles( exec_space, array.sparseView(), recv_tiles[n],
+                         recv_data[n], add );
+        exec_space.fence();
+
+        MPI_Waitall( 2 * num_n, requests.data() + 2 * num_n,
+                     MPI_STATUSES_IGNORE );
+    }
+
+  private:
+    MPI_Comm _comm;
+    std::vector<int> _neighbor_ranks;
+    std::vector<int> _send_tags;
+    std::vector<int> _receive_tags;
+    std::vector<Kokkos::Array<int, 6>> _own_boxes;
+    std::vector<Kokkos::Array<int, 6>> _ghost_boxes;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create a halo for sparse arrays.
+  \param array A sparse array the halo will exchange.
+  \param local_grid The local grid the array is defined on.
+*/
+template <class Scalar, class DeviceType, class SparseMapType, class MeshType>
+std::shared_ptr<SparseHalo<Scalar, DeviceType, SparseMapType>>
+createSparseHalo( const SparseArray<Scalar, DeviceType, SparseMapType>&,
+                  const LocalGrid<MeshType>& local_grid )
+{
+    return std::make_shared<SparseHalo<Scalar, DeviceType, SparseMapType>>(
+        local_grid );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cajita
+
+#endif // end CAJITA_SPARSE_ARRAY_HPP
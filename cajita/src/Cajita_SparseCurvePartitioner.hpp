@@ -0,0 +1,396 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cajita_SparseCurvePartitioner.hpp
+  \brief Space-filling curve partitioner of sparse grid tiles
+*/
+#ifndef CAJITA_SPARSECURVEPARTITIONER_HPP
+#define CAJITA_SPARSECURVEPARTITIONER_HPP
+
+#include <Cajita_SparseIndexSpace.hpp>
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include <mpi.h>
+
+namespace Cajita
+{
+//---------------------------------------------------------------------------//
+/*!
+  Sparse grid partitioner cutting the Morton curve through the tiles of the
+  global grid into chunks of equal workload. Unlike the block partitioners
+  the chunks do not form a Cartesian rank grid: each rank owns an arbitrary
+  set of tiles, so concentrated workloads can be split finely where they
+  are. The owner of every tile is known on every rank and the halo
+  neighbors of a rank are discovered from the tiles next to its own.
+  \tparam Device Kokkos device type.
+  \tparam CellPerTileDim Cells per tile per dimension.
+*/
+template <typename Device, unsigned long long CellPerTileDim = 4>
+class SparseCurvePartitioner
+{
+  public:
+    //! Kokkos device type.
+    using device_type = Device;
+    //! Kokkos memory space.
+    using memory_space = typename Device::memory_space;
+    //! Kokkos execution space.
+    using execution_space = typename Device::execution_space;
+
+    //! Per-tile device view (workload or owner rank).
+    using tile_view = Kokkos::View<int***, memory_space>;
+
+    //! Number of bits (per dimension) needed to index the cells inside a tile
+    static constexpr unsigned long long cell_bits_per_tile_dim =
+        bitCount( CellPerTileDim );
+    //! Number of cells inside each tile (per dimension)
+    //! Tile size reset to power of 2
+    static constexpr unsigned long long cell_num_per_tile_dim =
+        1 << cell_bits_per_tile_dim;
+
+    /*!
+      \brief Constructor. The initial partition gives every rank the same
+      number of tiles along the curve.
+      \param comm MPI communicator over which to partition the tiles
+      \param global_cells_per_dim 3D array, global cells in each dimension
+    */
+    SparseCurvePartitioner( MPI_Comm comm,
+                            const std::array<int, 3>& global_cells_per_dim )
+        : _comm( comm )
+    {
+        MPI_Comm_rank( _comm, &_rank );
+        MPI_Comm_size( _comm, &_size );
+
+        for ( int d = 0; d < 3; ++d )
+            _tiles_per_dim[d] =
+                ( global_cells_per_dim[d] + cell_num_per_tile_dim - 1 ) >>
+                cell_bits_per_tile_dim;
+
+        _workload_per_tile =
+            tile_view( "workload_per_tile", _tiles_per_dim[0],
+                       _tiles_per_dim[1], _tiles_per_dim[2] );
+        _owner = tile_view( "tile_owner", _tiles_per_dim[0], _tiles_per_dim[1],
+                            _tiles_per_dim[2] );
+        _owner_host = Kokkos::create_mirror_view( _owner );
+
+        // Order the tiles along the Morton curve.
+        TileID2HashKey<uint64_t, HashTypes::Morton> ijk2key(
+            _tiles_per_dim[0], _tiles_per_dim[1], _tiles_per_dim[2] );
+        int num_tile =
+            _tiles_per_dim[0] * _tiles_per_dim[1] * _tiles_per_dim[2];
+        std::vector<uint64_t> keys( num_tile );
+        _curve_order.resize( num_tile );
+        for ( int i = 0; i < _tiles_per_dim[0]; ++i )
+            for ( int j = 0; j < _tiles_per_dim[1]; ++j )
+                for ( int k = 0; k < _tiles_per_dim[2]; ++k )
+                    keys[tileId( i, j, k )] = ijk2key( i, j, k );
+        std::iota( _curve_order.begin(), _curve_order.end(), 0 );
+        std::sort( _curve_order.begin(), _curve_order.end(),
+                   [&]( const int a, const int b ) {
+                       return keys[a] < keys[b];
+                   } );
+
+        std::vector<int> unit_workload( num_tile, 1 );
+        cutCurve( unit_workload );
+    }
+
+    //! Get the number of tiles in each dimension of the global grid.
+    std::array<int, 3> tilesPerDimension() const { return _tiles_per_dim; }
+
+    /*!
+      \brief Get the owner rank of every tile (device view indexed by the
+      global tile ijk)
+    */
+    tile_view ownerView() const { return _owner; }
+
+    /*!
+      \brief Get the owner rank of a tile
+      \param tile_i, tile_j, tile_k Global tile ID in each dimension
+    */
+    int ownerRank( const int tile_i, const int tile_j, const int tile_k ) const
+    {
+        return _owner_host( tile_i, tile_j, tile_k );
+    }
+
+    /*!
+      \brief Get the number of tiles owned by the current MPI rank
+    */
+    int ownedTileNum() const
+    {
+        return std::count( _owner_host.data(),
+                           _owner_host.data() + _owner_host.size(), _rank );
+    }
+
+    /*!
+      \brief set all elements in _workload_per_tile to 0
+    */
+    void resetWorkload() { Kokkos::deep_copy( _workload_per_tile, 0 ); }
+
+    /*!
+      \brief compute the workload in the current MPI rank from particle
+      positions (each particle count for 1 workload value)
+      \param view particle positions view
+      \param particle_num total particle number
+      \param global_lower_corner the coordinate of the domain global lower
+      corner
+      \param dx cell dx size
+    */
+    template <class ParticlePosViewType, typename ArrayType, typename CellUnit>
+    void computeLocalWorkLoad( const ParticlePosViewType& view,
+                               int particle_num,
+                               const ArrayType& global_lower_corner,
+                               const CellUnit dx )
+    {
+        resetWorkload();
+        // make a local copy
+        auto workload = _workload_per_tile;
+        Kokkos::Array<CellUnit, 3> lower_corner;
+        Kokkos::Array<int, 3> tiles_per_dim;
+        for ( int d = 0; d < 3; ++d )
+        {
+            lower_corner[d] = global_lower_corner[d];
+            tiles_per_dim[d] = _tiles_per_dim[d];
+        }
+
+        Kokkos::parallel_for(
+            "compute_local_workload_curve_parpos",
+            Kokkos::RangePolicy<execution_space>( 0, particle_num ),
+            KOKKOS_LAMBDA( const int i ) {
+                int tid[3];
+                for ( int d = 0; d < 3; ++d )
+                {
+                    CellUnit x = ( view( i, d ) - lower_corner[d] ) / dx;
+                    int t = ( x < 0 ) ? 0
+                                      : static_cast<int>( x ) >>
+                                            cell_bits_per_tile_dim;
+                    tid[d] =
+                        ( t < tiles_per_dim[d] ) ? t : tiles_per_dim[d] - 1;
+                }
+                Kokkos::atomic_increment( &workload( tid[0], tid[1], tid[2] ) );
+            } );
+    }
+
+    /*!
+      \brief compute the workload in the current MPI rank from sparseMap
+      (the workload of a tile is 1 if the tile is occupied, 0 otherwise)
+      \param sparseMap sparseMap in the current rank
+    */
+    template <class SparseMapType>
+    void computeLocalWorkLoad( const SparseMapType& sparseMap )
+    {
+        resetWorkload();
+        // make a local copy
+        auto workload = _workload_per_tile;
+        Kokkos::parallel_for(
+            "compute_local_workload_curve_sparsmap",
+            Kokkos::RangePolicy<execution_space>( 0, sparseMap.capacity() ),
+            KOKKOS_LAMBDA( uint32_t i ) {
+                if ( sparseMap.valid_at( i ) )
+                {
+                    auto key = sparseMap.key_at( i );
+                    int ti, tj, tk;
+                    sparseMap.key2ijk( key, ti, tj, tk );
+                    Kokkos::atomic_increment( &workload( ti, tj, tk ) );
+                }
+            } );
+    }
+
+    /*!
+      \brief reduce the workload of all MPI ranks and cut the curve into
+      chunks of equal workload
+      \return whether the owner of any tile changed
+    */
+    bool optimizePartition()
+    {
+        auto workload_mirror = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), _workload_per_tile );
+        std::vector<int> workload( workload_mirror.size() );
+        for ( int i = 0; i < _tiles_per_dim[0]; ++i )
+            for ( int j = 0; j < _tiles_per_dim[1]; ++j )
+                for ( int k = 0; k < _tiles_per_dim[2]; ++k )
+                    workload[tileId( i, j, k )] = workload_mirror( i, j, k );
+        MPI_Allreduce( MPI_IN_PLACE, workload.data(), workload.size(),
+                       MPI_INT, MPI_SUM, _comm );
+        return cutCurve( workload );
+    }
+
+    /*!
+      \brief iteratively optimize the partition
+      \param view particle positions view
+      \param particle_num total particle number
+      \param global_lower_corner the coordinate of the domain global lower
+      corner
+      \param dx cell dx size
+      \return whether the owner of any tile changed
+    */
+    template <class ParticlePosViewType, typename ArrayType, typename CellUnit>
+    bool optimizePartition( const ParticlePosViewType& view, int particle_num,
+                            const ArrayType& global_lower_corner,
+                            const CellUnit dx )
+    {
+        computeLocalWorkLoad( view, particle_num, global_lower_corner, dx );
+        return optimizePartition();
+    }
+
+    /*!
+      \brief optimize the partition
+      \param sparseMap sparseMap in the current rank
+      \return whether the owner of any tile changed
+    */
+    template <class SparseMapType>
+    bool optimizePartition( const SparseMapType& sparseMap )
+    {
+        computeLocalWorkLoad( sparseMap );
+        return optimizePartition();
+    }
+
+    /*!
+      \brief compute the imbalance factor of the current partition from the
+      last reduced workload
+      \return the largest rank workload over the average rank workload
+    */
+    float computeImbalanceFactor() const
+    {
+        long max_workload = *std::max_element( _rank_workload.begin(),
+                                               _rank_workload.end() );
+        long total_workload = std::accumulate( _rank_workload.begin(),
+                                               _rank_workload.end(), 0L );
+        if ( total_workload == 0 )
+            return 1.0f;
+        return static_cast<float>( max_workload * _size ) /
+               static_cast<float>( total_workload );
+    }
+
+    /*!
+      \brief Get the ranks owning the tiles within a halo of the tiles of the
+      current MPI rank. The list is sorted and includes the current rank, as
+      expected by the topology of a Cabana communication plan.
+      \param halo_tile_width Halo width (unit: tile)
+      \param periodic Whether each dimension is periodic
+    */
+    std::vector<int>
+    neighborRanks( const int halo_tile_width,
+                   const std::array<bool, 3>& periodic = { false, false,
+                                                           false } ) const
+    {
+        std::vector<bool> is_neighbor( _size, false );
+        is_neighbor[_rank] = true;
+        for ( int i = 0; i < _tiles_per_dim[0]; ++i )
+            for ( int j = 0; j < _tiles_per_dim[1]; ++j )
+                for ( int k = 0; k < _tiles_per_dim[2]; ++k )
+                {
+                    if ( _owner_host( i, j, k ) != _rank )
+                        continue;
+                    for ( int oi = -halo_tile_width; oi <= halo_tile_width;
+                          ++oi )
+                        for ( int oj = -halo_tile_width; oj <= halo_tile_width;
+                              ++oj )
+                            for ( int ok = -halo_tile_width;
+                                  ok <= halo_tile_width; ++ok )
+                            {
+                                std::array<int, 3> nid = { i + oi, j + oj,
+                                                           k + ok };
+                                if ( wrapTile( nid, periodic ) )
+                                    is_neighbor[_owner_host(
+                                        nid[0], nid[1], nid[2] )] = true;
+                            }
+                }
+
+        std::vector<int> neighbors;
+        for ( int r = 0; r < _size; ++r )
+            if ( is_neighbor[r] )
+                neighbors.push_back( r );
+        return neighbors;
+    }
+
+  private:
+    // Linear ID of a tile.
+    int tileId( const int i, const int j, const int k ) const
+    {
+        return ( i * _tiles_per_dim[1] + j ) * _tiles_per_dim[2] + k;
+    }
+
+    // Wrap a tile ID across periodic boundaries, return false if it lies
+    // outside a non-periodic boundary.
+    bool wrapTile( std::array<int, 3>& tid,
+                   const std::array<bool, 3>& periodic ) const
+    {
+        for ( int d = 0; d < 3; ++d )
+        {
+            if ( tid[d] < 0 || tid[d] >= _tiles_per_dim[d] )
+            {
+                if ( !periodic[d] )
+                    return false;
+                tid[d] = ( tid[d] % _tiles_per_dim[d] + _tiles_per_dim[d] ) %
+                         _tiles_per_dim[d];
+            }
+        }
+        return true;
+    }
+
+    // Assign the tiles to the ranks in curve order so that each rank gets
+    // the same share of the total workload. Without any workload the tiles
+    // are shared evenly. Returns whether any owner changed.
+    bool cutCurve( const std::vector<int>& workload )
+    {
+        long total_workload =
+            std::accumulate( workload.begin(), workload.end(), 0L );
+        long num_tile = _curve_order.size();
+        bool is_changed = false;
+        _rank_workload.assign( _size, 0 );
+        long prefix_sum = 0;
+        for ( long n = 0; n < num_tile; ++n )
+        {
+            int tile = _curve_order[n];
+            int owner = ( total_workload > 0 )
+                            ? static_cast<int>( prefix_sum * _size /
+                                                total_workload )
+                            : static_cast<int>( n * _size / num_tile );
+            owner = std::min( owner, _size - 1 );
+            prefix_sum += workload[tile];
+            _rank_workload[owner] += workload[tile];
+
+            int k = tile % _tiles_per_dim[2];
+            int j = ( tile / _tiles_per_dim[2] ) % _tiles_per_dim[1];
+            int i = tile / _tiles_per_dim[2] / _tiles_per_dim[1];
+            if ( _owner_host( i, j, k ) != owner )
+                is_changed = true;
+            _owner_host( i, j, k ) = owner;
+        }
+        Kokkos::deep_copy( _owner, _owner_host );
+        return is_changed;
+    }
+
+    // MPI communicator and the rank and size in it
+    MPI_Comm _comm;
+    int _rank;
+    int _size;
+    // number of tiles in each dimension of the global grid
+    std::array<int, 3> _tiles_per_dim;
+    // linear tile IDs in Morton curve order
+    std::vector<int> _curve_order;
+    // the workload of each tile on current rank
+    tile_view _workload_per_tile;
+    // the owner rank of each tile
+    tile_view _owner;
+    typename tile_view::HostMirror _owner_host;
+    // the total workload of each rank after the last partition
+    std::vector<long> _rank_workload;
+};
+} // end namespace Cajita
+
+#endif // end CAJITA_SPARSECURVEPARTITIONER_HPP
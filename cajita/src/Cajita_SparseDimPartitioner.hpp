@@ -21,6 +21,8 @@
 #include <Kokkos_Core.hpp>
 
 #include <array>
+#include <climits>
+#include <numeric>
 #include <vector>
 
 #include <mpi.h>
@@ -46,6 +48,8 @@ class SparseDimPartitioner : public BlockPartitioner<3>
 
     //! Workload device view.
     using workload_view = Kokkos::View<int***, memory_space>;
+    //! Workload profile device view.
+    using workload_profile_view = Kokkos::View<int**, memory_space>;
     //! Partition device view.
     using partition_view = Kokkos::View<int* [3], memory_space>;
     //! Workload host view.
@@ -254,14 +258,9 @@ class SparseDimPartitioner : public BlockPartitioner<3>
     }
 
     /*!
-         \brief set all elements in _workload_per_tile and _workload_prefix_sum
-         matrix to 0
-       */
-    void resetWorkload()
-    {
-        Kokkos::deep_copy( _workload_per_tile, 0 );
-        Kokkos::deep_copy( _workload_prefix_sum, 0 );
-    }
+      \brief set all elements in _workload_per_tile to 0
+    */
+    void resetWorkload() { Kokkos::deep_copy( _workload_per_tile, 0 ); }
 
     /*!
       \brief compute the workload in the current MPI rank from particle
@@ -300,7 +299,7 @@ class SparseDimPartitioner : public BlockPartitioner<3>
                 int tz = static_cast<int>(
                              ( view( i, 2 ) - lower_corner[2] ) / dx - 0.5 ) >>
                          cell_bits_per_tile_dim;
-                Kokkos::atomic_increment( &workload( ti + 1, tj + 1, tz + 1 ) );
+                Kokkos::atomic_increment( &workload( ti, tj, tz ) );
             } );
     }
 
@@ -324,89 +323,86 @@ class SparseDimPartitioner : public BlockPartitioner<3>
                     auto key = sparseMap.key_at( i );
                     int ti, tj, tk;
                     sparseMap.key2ijk( key, ti, tj, tk );
-                    Kokkos::atomic_increment(
-                        &workload( ti + 1, tj + 1, tk + 1 ) );
+                    Kokkos::atomic_increment( &workload( ti, tj, tk ) );
                 }
             } );
     }
 
     /*!
-      \brief 1. reduce the total workload in all MPI ranks; 2. compute the
-      workload prefix sum matrix for all MPI ranks
+      \brief record the MPI communicator used for workload reduction by the
+      deprecated optimizePartition( is_changed, iter_seed ) and
+      averageRankWorkload() overloads
       \param comm MPI communicator used for workload reduction
+
+      The full 3D prefix sum is no longer built. The workload is reduced by
+      the optimization steps themselves, one workload profile at a time.
     */
-    void computeFullPrefixSum( MPI_Comm comm )
+    [[deprecated]] void computeFullPrefixSum( MPI_Comm comm )
     {
-        // local copy
+        _workload_comm = comm;
+    }
+
+    /*!
+      \brief compute the workload profile along one dimension for all MPI
+      ranks
+      \param dim_i the dimension of the profile
+      \param comm MPI communicator used for workload reduction
+
+      The profile holds, for each tile slab normal to dim_i and each block of
+      the current partition in the two other dimensions, the prefix sum over
+      the slabs of the total workload of all ranks. Only the profile is
+      reduced, so the collective is the size of one tile row per rank block
+      rather than of the full tile grid, and it stays on the device.
+    */
+    void computeWorkloadProfile( const int dim_i, MPI_Comm comm )
+    {
+        int dim_j = ( dim_i + 1 ) % 3;
+        int dim_k = ( dim_i + 2 ) % 3;
+        int num_block = _ranks_per_dim[dim_j] * _ranks_per_dim[dim_k];
+        int num_slab = _workload_per_tile.extent( dim_i );
+        _workload_profile = workload_profile_view( "workload_profile",
+                                                   num_slab + 1, num_block );
+
+        // Sum the local workload of each slab in each block.
         auto workload = _workload_per_tile;
-        auto prefix_sum = _workload_prefix_sum;
-        int total_size = _workload_per_tile.size();
+        auto profile = _workload_profile;
+        auto rec_partition = _rectangle_partition_dev;
+        auto ranks_per_dim = _ranks_per_dim;
+        int num_tile_j = _workload_per_tile.extent( 1 );
+        int num_tile_k = _workload_per_tile.extent( 2 );
+        Kokkos::parallel_for(
+            "compute_local_workload_profile",
+            Kokkos::RangePolicy<execution_space>( 0, workload.size() ),
+            KOKKOS_LAMBDA( const int n ) {
+                int tile[3] = { n / ( num_tile_j * num_tile_k ),
+                                ( n / num_tile_k ) % num_tile_j,
+                                n % num_tile_k };
+                int w = workload( tile[0], tile[1], tile[2] );
+                if ( w == 0 )
+                    return;
+                int j = rankBlock( rec_partition, dim_j,
+                                   ranks_per_dim[dim_j], tile[dim_j] );
+                int k = rankBlock( rec_partition, dim_k,
+                                   ranks_per_dim[dim_k], tile[dim_k] );
+                Kokkos::atomic_add(
+                    &profile( tile[dim_i] + 1,
+                              j * ranks_per_dim[dim_k] + k ),
+                    w );
+            } );
+        execution_space().fence();
 
-        // MPI all reduce: compute workload in all MPI ranks from the local
-        // workload matrix, save the results in _workload_prefix_sum
-        MPI_Allreduce( workload.data(), prefix_sum.data(), total_size, MPI_INT,
+        // Reduce the profile over all ranks.
+        MPI_Allreduce( MPI_IN_PLACE, profile.data(), profile.size(), MPI_INT,
                        MPI_SUM, comm );
 
-        // compute the prefix sum (in three dimensions)
-        // prefix sum in the dimension 0
-        for ( int j = 0;
-              j < static_cast<int>( _workload_prefix_sum.extent( 1 ) ); ++j )
-            for ( int k = 0;
-                  k < static_cast<int>( _workload_prefix_sum.extent( 2 ) );
-                  ++k )
-                Kokkos::parallel_scan(
-                    "scan_prefix_sum_dim0",
-                    Kokkos::RangePolicy<execution_space>(
-                        0, _workload_prefix_sum.extent( 0 ) ),
-                    KOKKOS_LAMBDA( const int i, int& update,
-                                   const bool final ) {
-                        const float val_i = prefix_sum( i, j, k );
-                        update += val_i;
-                        if ( final )
-                        {
-                            prefix_sum( i, j, k ) = update;
-                        }
-                    } );
-
-        // prefix sum in the dimension 1
-        for ( int i = 0;
-              i < static_cast<int>( _workload_prefix_sum.extent( 0 ) ); ++i )
-            for ( int k = 0;
-                  k < static_cast<int>( _workload_prefix_sum.extent( 2 ) );
-                  ++k )
-                Kokkos::parallel_scan(
-                    "scan_prefix_sum_dim1",
-                    Kokkos::RangePolicy<execution_space>(
-                        0, _workload_prefix_sum.extent( 1 ) ),
-                    KOKKOS_LAMBDA( const int j, int& update,
-                                   const bool final ) {
-                        const float val_i = prefix_sum( i, j, k );
-                        update += val_i;
-                        if ( final )
-                        {
-                            prefix_sum( i, j, k ) = update;
-                        }
-                    } );
-
-        // prefix sum in the dimension 2
-        for ( int i = 0;
-              i < static_cast<int>( _workload_prefix_sum.extent( 0 ) ); ++i )
-            for ( int j = 0;
-                  j < static_cast<int>( _workload_prefix_sum.extent( 1 ) );
-                  ++j )
-                Kokkos::parallel_scan(
-                    "scan_prefix_sum_dim2",
-                    Kokkos::RangePolicy<execution_space>(
-                        0, _workload_prefix_sum.extent( 2 ) ),
-                    KOKKOS_LAMBDA( const int k, int& update,
-                                   const bool final ) {
-                        const float val_i = prefix_sum( i, j, k );
-                        update += val_i;
-                        if ( final )
-                        {
-                            prefix_sum( i, j, k ) = update;
-                        }
-                    } );
+        // Prefix sum over the slabs of each block.
+        Kokkos::parallel_for(
+            "scan_workload_profile",
+            Kokkos::RangePolicy<execution_space>( 0, num_block ),
+            KOKKOS_LAMBDA( const int jnk ) {
+                for ( int i = 1; i < num_slab + 1; ++i )
+                    profile( i, jnk ) += profile( i - 1, jnk );
+            } );
     }
 
     /*!
@@ -425,11 +421,10 @@ class SparseDimPartitioner : public BlockPartitioner<3>
                            const CellUnit dx, MPI_Comm comm )
     {
         computeLocalWorkLoad( view, particle_num, global_lower_corner, dx );
-        computeFullPrefixSum( comm );
         bool is_changed = false;
         for ( int i = 0; i < _max_optimize_iteration; ++i )
         {
-            optimizePartition( is_changed, std::rand() % 3 );
+            optimizePartition( is_changed, std::rand() % 3, comm );
             if ( !is_changed )
                 return i;
         }
@@ -446,11 +441,10 @@ class SparseDimPartitioner : public BlockPartitioner<3>
     int optimizePartition( const SparseMapType& sparseMap, MPI_Comm comm )
     {
         computeLocalWorkLoad( sparseMap );
-        computeFullPrefixSum( comm );
         bool is_changed = false;
         for ( int i = 0; i < _max_optimize_iteration; ++i )
         {
-            optimizePartition( is_changed, std::rand() % 3 );
+            optimizePartition( is_changed, std::rand() % 3, comm );
             if ( !is_changed )
                 return i;
         }
@@ -462,189 +456,204 @@ class SparseDimPartitioner : public BlockPartitioner<3>
       \param is_changed label if the partition is changed after the optimization
       \param iter_seed seed number to choose the starting dimension of the
       optimization
+      \param comm MPI communicator used for workload reduction
     */
-    void optimizePartition( bool& is_changed, int iter_seed )
+    void optimizePartition( bool& is_changed, int iter_seed, MPI_Comm comm )
     {
-        is_changed = false;
+        Kokkos::View<int, memory_space> changed( "partition_changed" );
+
         // loop over three dimensions, optimize the partition in dimension di
         for ( int iter_id = iter_seed; iter_id < iter_seed + 3; ++iter_id )
         {
             int di = iter_id % 3;
-            // compute the dimensions that should be fixed (dj and dk)
-            int dj = ( di + 1 ) % 3;
-            int dk = ( di + 2 ) % 3;
-            auto rank_k = _ranks_per_dim[dk];
-
-            auto rank = _ranks_per_dim[di];
-            auto rec_mirror = Kokkos::create_mirror_view_and_copy(
-                Kokkos::HostSpace(), _rectangle_partition_dev );
+            // the workload profile of di, with the partition in the fixed
+            // dimensions (dj and dk) as optimized so far
+            computeWorkloadProfile( di, comm );
+            int num_block = _workload_profile.extent( 1 );
+            int rank = _ranks_per_dim[di];
+            auto profile = _workload_profile;
             auto rec_partition = _rectangle_partition_dev;
 
-            SubWorkloadFunctor<partition_view, workload_view>
-                compute_sub_workload( _rectangle_partition_dev,
-                                      _workload_prefix_sum );
-
-            // compute average workload in the dimension di
-            Kokkos::View<int*, memory_space> ave_workload(
-                "ave_workload", _ranks_per_dim[dj] * _ranks_per_dim[dk] );
+            // Move the partition points one after another in a single device
+            // thread such that the partition never leaves the device.
             Kokkos::parallel_for(
-                "compute_average_workload",
-                Kokkos::RangePolicy<execution_space>(
-                    0, _ranks_per_dim[dj] * _ranks_per_dim[dk] ),
-                KOKKOS_LAMBDA( uint32_t jnk ) {
-                    // compute rank_id in the fixed dimensions
-                    int j = static_cast<int>( jnk / rank_k );
-                    int k = static_cast<int>( jnk % rank_k );
-                    // compute the average workload with the partition of the
-                    // two fixed dimensions
-                    ave_workload( jnk ) =
-                        compute_sub_workload( di, 0, rec_partition( rank, di ),
-                                              dj, j, dk, k ) /
-                        rank;
-                } );
-
-            // point_i: current partition position
-            int point_i = 1;
-            // last_point: the opimized position for the lask partition
-            int last_point = 0;
-            // current_workload: the workload between [last_point, point_i)
-            Kokkos::View<int*, memory_space> current_workload(
-                "current_workload", _ranks_per_dim[dj] * _ranks_per_dim[dk] );
-            for ( int current_rank = 1; current_rank < rank; current_rank++ )
-            {
-                int last_diff = __INT_MAX__;
-                while ( true )
-                {
-                    // compute current workload between [last_point, point_i)
-                    Kokkos::parallel_for(
-                        "compute_current_workload",
-                        Kokkos::RangePolicy<execution_space>(
-                            0, _ranks_per_dim[dj] * _ranks_per_dim[dk] ),
-                        KOKKOS_LAMBDA( uint32_t jnk ) {
-                            int j = static_cast<int>( jnk / rank_k );
-                            int k = static_cast<int>( jnk % rank_k );
-                            current_workload( jnk ) = compute_sub_workload(
-                                di, last_point, point_i, dj, j, dk, k );
-                        } );
-                    // compute the (w_jk^ave - w_jk^{last_point:point_i})
-                    Kokkos::parallel_for(
-                        "compute_diff",
-                        Kokkos::RangePolicy<execution_space>(
-                            0, _ranks_per_dim[dj] * _ranks_per_dim[dk] ),
-                        KOKKOS_LAMBDA( uint32_t jnk ) {
-                            auto wl =
-                                current_workload( jnk ) - ave_workload( jnk );
-                            wl *= wl;
-                            current_workload( jnk ) = wl;
-                        } );
-                    // compute the sum of the difference in all rank_j*rank_k
-                    // regions
-                    int diff;
-                    Kokkos::parallel_reduce(
-                        "diff_reduce",
-                        Kokkos::RangePolicy<execution_space>(
-                            0, _ranks_per_dim[dj] * _ranks_per_dim[dk] ),
-                        KOKKOS_LAMBDA( const int idx, int& update ) {
-                            update += current_workload( idx );
-                        },
-                        diff );
-                    // record the new optimal position
-                    if ( diff <= last_diff )
-                    {
-                        // check if point_i reach the total_tile_num
-                        if ( point_i == rec_mirror( rank, di ) )
-                        {
-                            rec_mirror( current_rank, di ) = point_i;
-                            break;
-                        }
-                        last_diff = diff;
-                        point_i++;
-                    }
-                    else
+                "optimize_partition_dim",
+                Kokkos::RangePolicy<execution_space>( 0, 1 ),
+                KOKKOS_LAMBDA( const int ) {
+                    int total_point = rec_partition( rank, di );
+                    // point_i: current partition position
+                    int point_i = 1;
+                    // last_point: the opimized position for the lask
+                    // partition
+                    int last_point = 0;
+                    for ( int current_rank = 1; current_rank < rank;
+                          current_rank++ )
                     {
-                        // final optimal position
-                        if ( rec_mirror( current_rank, di ) != point_i - 1 )
+                        long last_diff = LONG_MAX;
+                        while ( true )
                         {
-                            rec_mirror( current_rank, di ) = point_i - 1;
-                            is_changed = true;
-                        }
-                        last_point = point_i - 1;
-                        break;
-                    }
-                } // end while (optimization for the current rank)
-            }     // end for (all partition/rank in the optimized dimension)
-            Kokkos::deep_copy( _rectangle_partition_dev, rec_mirror );
+                            // compute the sum of (w_jk^ave -
+                            // w_jk^{last_point:point_i})^2 over all
+                            // rank_j*rank_k regions
+                            long diff = 0;
+                            for ( int jnk = 0; jnk < num_block; ++jnk )
+                            {
+                                long ave =
+                                    profile( total_point, jnk ) / rank;
+                                long wl = profile( point_i, jnk ) -
+                                          profile( last_point, jnk ) - ave;
+                                diff += wl * wl;
+                            }
+                            // record the new optimal position
+                            if ( diff <= last_diff )
+                            {
+                                // check if point_i reach the total_tile_num
+                                if ( point_i == total_point )
+                                {
+                                    rec_partition( current_rank, di ) =
+                                        point_i;
+                                    break;
+                                }
+                                last_diff = diff;
+                                point_i++;
+                            }
+                            else
+                            {
+                                // final optimal position
+                                if ( rec_partition( current_rank, di ) !=
+                                     point_i - 1 )
+                                {
+                                    rec_partition( current_rank, di ) =
+                                        point_i - 1;
+                                    changed() = 1;
+                                }
+                                last_point = point_i - 1;
+                                break;
+                            }
+                        } // end while (optimization for the current rank)
+                    } // end for (all partition/rank in the optimized dim)
+                } );
         } // end for (3 dimensions)
+
+        auto changed_host =
+            Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), changed );
+        is_changed = changed_host();
     }
 
     /*!
-      \brief compute the total workload on the current MPI rank
+      \brief optimize the partition in three dimensions seperately with the
+      communicator recorded by computeFullPrefixSum()
+      \param is_changed label if the partition is changed after the optimization
+      \param iter_seed seed number to choose the starting dimension of the
+      optimization
+    */
+    [[deprecated]] void optimizePartition( bool& is_changed, int iter_seed )
+    {
+        optimizePartition( is_changed, iter_seed, _workload_comm );
+    }
+
+    /*!
+      \brief compute the total workload of every MPI rank with the current
+      partition from the last computed local workload
       \param cart_comm MPI cartesian communicator
-      \return total workload on current rank
+      \return workload of each rank, indexed by the rank in cart_comm
     */
-    int currentRankWorkload( MPI_Comm cart_comm )
+    std::vector<int> rankWorkloads( MPI_Comm cart_comm )
     {
-        auto rec_mirror = Kokkos::create_mirror_view_and_copy(
-            Kokkos::HostSpace(), _rectangle_partition_dev );
-        auto prefix_sum_mirror = Kokkos::create_mirror_view_and_copy(
-            Kokkos::HostSpace(), _workload_prefix_sum );
+        int num_rank =
+            _ranks_per_dim[0] * _ranks_per_dim[1] * _ranks_per_dim[2];
+        Kokkos::View<int*, memory_space> block_workload( "block_workload",
+                                                         num_rank );
 
-        return currentRankWorkload( cart_comm, rec_mirror, prefix_sum_mirror );
+        // Sum the local workload of each rank block.
+        auto workload = _workload_per_tile;
+        auto rec_partition = _rectangle_partition_dev;
+        auto ranks_per_dim = _ranks_per_dim;
+        int num_tile_j = _workload_per_tile.extent( 1 );
+        int num_tile_k = _workload_per_tile.extent( 2 );
+        Kokkos::parallel_for(
+            "compute_rank_workload",
+            Kokkos::RangePolicy<execution_space>( 0, workload.size() ),
+            KOKKOS_LAMBDA( const int n ) {
+                int tile[3] = { n / ( num_tile_j * num_tile_k ),
+                                ( n / num_tile_k ) % num_tile_j,
+                                n % num_tile_k };
+                int w = workload( tile[0], tile[1], tile[2] );
+                if ( w == 0 )
+                    return;
+                int block = 0;
+                for ( int d = 0; d < 3; ++d )
+                    block = block * ranks_per_dim[d] +
+                            rankBlock( rec_partition, d, ranks_per_dim[d],
+                                       tile[d] );
+                Kokkos::atomic_add( &block_workload( block ), w );
+            } );
+        auto block_host = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), block_workload );
+        MPI_Allreduce( MPI_IN_PLACE, block_host.data(), num_rank, MPI_INT,
+                       MPI_SUM, cart_comm );
+
+        // Order the blocks by rank.
+        std::vector<int> rank_workload( num_rank );
+        for ( int r = 0; r < num_rank; ++r )
+        {
+            std::array<int, 3> cart_rank;
+            MPI_Cart_coords( cart_comm, r, 3, cart_rank.data() );
+            rank_workload[r] = block_host(
+                ( cart_rank[0] * _ranks_per_dim[1] + cart_rank[1] ) *
+                    _ranks_per_dim[2] +
+                cart_rank[2] );
+        }
+        return rank_workload;
     }
 
     /*!
-       \brief compute the total workload on the current MPI rank
-       \param cart_comm MPI cartesian communicator
-       \param rec_view Host mirror of _rec_partition_dev
-       \param prefix_sum_view Host mirror of _workload_prefix_sum
-       \return total workload on current rank
-     */
-    template <typename PartitionViewHost, typename WorkloadViewHost>
-    int currentRankWorkload( MPI_Comm cart_comm, PartitionViewHost& rec_view,
-                             WorkloadViewHost& prefix_sum_view )
+      \brief compute the total workload on the current MPI rank
+      \param cart_comm MPI cartesian communicator
+      \return total workload on current rank
+    */
+    int currentRankWorkload( MPI_Comm cart_comm )
     {
-        SubWorkloadFunctor<PartitionViewHost, WorkloadViewHost>
-            compute_sub_workload_host( rec_view, prefix_sum_view );
-
-        // Get the Cartesian topology index of this rank.
-        Kokkos::Array<int, 3> cart_rank;
         int linear_rank;
         MPI_Comm_rank( cart_comm, &linear_rank );
-        MPI_Cart_coords( cart_comm, linear_rank, 3, cart_rank.data() );
-
-        // compute total workload of the current rank
-        int workload_current_rank = compute_sub_workload_host(
-            0, rec_view( cart_rank[0], 0 ), rec_view( cart_rank[0] + 1, 0 ), 1,
-            cart_rank[1], 2, cart_rank[2] );
-
-        return workload_current_rank;
+        return rankWorkloads( cart_comm )[linear_rank];
     }
 
     /*!
     \brief compute the average workload on each MPI rank
+    \param comm MPI communicator used for workload reduction. This does not
+    need a cartesian topology.
     \return average workload on each rank
     */
-    int averageRankWorkload()
+    int averageRankWorkload( MPI_Comm comm )
     {
-        auto prefix_sum_view = Kokkos::create_mirror_view_and_copy(
-            Kokkos::HostSpace(), _workload_prefix_sum );
-        // compute total workload of the current rank
-        return averageRankWorkload( prefix_sum_view );
+        auto workload = _workload_per_tile;
+        int num_tile_j = _workload_per_tile.extent( 1 );
+        int num_tile_k = _workload_per_tile.extent( 2 );
+        int total_workload = 0;
+        Kokkos::parallel_reduce(
+            "compute_total_workload",
+            Kokkos::RangePolicy<execution_space>( 0, workload.size() ),
+            KOKKOS_LAMBDA( const int n, int& update ) {
+                update += workload( n / ( num_tile_j * num_tile_k ),
+                                    ( n / num_tile_k ) % num_tile_j,
+                                    n % num_tile_k );
+            },
+            total_workload );
+        MPI_Allreduce( MPI_IN_PLACE, &total_workload, 1, MPI_INT, MPI_SUM,
+                       comm );
+        return total_workload /
+               ( _ranks_per_dim[0] * _ranks_per_dim[1] * _ranks_per_dim[2] );
     }
 
     /*!
-    \brief compute the average workload on each MPI rank
-    \param prefix_sum_view Host mirror of _workload_prefix_sum
+    \brief compute the average workload on each MPI rank with the
+    communicator recorded by computeFullPrefixSum()
     \return average workload on each rank
     */
-    template <typename WorkloadViewHost>
-    int averageRankWorkload( WorkloadViewHost& prefix_sum_view )
+    [[deprecated]] int averageRankWorkload()
     {
-        // compute total workload of the current rank
-        return prefix_sum_view( prefix_sum_view.extent( 0 ) - 1,
-                                prefix_sum_view.extent( 1 ) - 1,
-                                prefix_sum_view.extent( 2 ) - 1 ) /
-               ( _ranks_per_dim[0] * _ranks_per_dim[1] * _ranks_per_dim[2] );
+        return averageRankWorkload( _workload_comm );
     }
 
     /*!
@@ -654,75 +663,29 @@ class SparseDimPartitioner : public BlockPartitioner<3>
     */
     float computeImbalanceFactor( MPI_Comm cart_comm )
     {
-        auto rec_mirror = Kokkos::create_mirror_view_and_copy(
-            Kokkos::HostSpace(), _rectangle_partition_dev );
-        auto prefix_sum_mirror = Kokkos::create_mirror_view_and_copy(
-            Kokkos::HostSpace(), _workload_prefix_sum );
-
-        int workload_current_rank =
-            currentRankWorkload( cart_comm, rec_mirror, prefix_sum_mirror );
-        int workload_ave_rank = averageRankWorkload( prefix_sum_mirror );
+        auto rank_workload = rankWorkloads( cart_comm );
+        int linear_rank;
+        MPI_Comm_rank( cart_comm, &linear_rank );
+        int workload_current_rank = rank_workload[linear_rank];
+        int workload_ave_rank =
+            std::accumulate( rank_workload.begin(), rank_workload.end(), 0 ) /
+            static_cast<int>( rank_workload.size() );
 
         return static_cast<float>( workload_current_rank ) /
                static_cast<float>( workload_ave_rank );
     }
 
-    /*!
-      \brief functor to compute the sub workload in a given region (from the
-      prefix sum)
-    */
-    template <typename PartitionView, typename WorkloadView>
-    struct SubWorkloadFunctor
+    //! Find the block of the partition containing a tile in a dimension.
+    template <class PartitionView>
+    KOKKOS_INLINE_FUNCTION static int
+    rankBlock( const PartitionView& rec_partition, const int dim,
+               const int num_rank, const int tile )
     {
-        //! Rectilinear partition
-        PartitionView rec_partition;
-        //! Workload prefix sum matrix
-        WorkloadView workload_prefix_sum;
-
-        //! Constructor.
-        SubWorkloadFunctor( PartitionView rec_par, WorkloadView pre_sum )
-            : rec_partition( rec_par )
-            , workload_prefix_sum( pre_sum )
-        {
-        }
-
-        //! compute the workload in region rounded by:
-        //! [i_start, i_end) in dim_i
-        //! [partition[j], partition[j+1]) in dim_j
-        //! [partition[k], partition[k+1]) in dim_k
-        KOKKOS_INLINE_FUNCTION int operator()( int dim_i, int i_start,
-                                               int i_end, int dim_j, int j,
-                                               int dim_k, int k ) const
-        {
-            int end[3], start[3];
-            end[dim_i] = i_end;
-            end[dim_j] = rec_partition( j + 1, dim_j );
-            end[dim_k] = rec_partition( k + 1, dim_k );
-
-            start[dim_i] = i_start;
-            start[dim_j] = rec_partition( j, dim_j );
-            start[dim_k] = rec_partition( k, dim_k );
-
-            // S[i][j][k] = S[i-1][j][k] + S[i][j-1][k] + S[i][j][k-1] -
-            // S[i-1][j-1][k]
-            // - S[i][j-1][k-1] - S[i-1][j][k-1] + S[i-1][j-1][k-1] + a[i][j][k]
-            return workload_prefix_sum( end[0], end[1], end[2] ) // S[i][j][k]
-                   - workload_prefix_sum( start[0], end[1],
-                                          end[2] ) // S[i-1][j][k]
-                   - workload_prefix_sum( end[0], start[1],
-                                          end[2] ) // S[i][j-1][k]
-                   - workload_prefix_sum( end[0], end[1],
-                                          start[2] ) // S[i][j][k-1]
-                   + workload_prefix_sum( start[0], start[1],
-                                          end[2] ) // S[i-1][j-1][k]
-                   + workload_prefix_sum( end[0], start[1],
-                                          start[2] ) // S[i][j-1][k-1]
-                   + workload_prefix_sum( start[0], end[1],
-                                          start[2] ) // S[i-1][j][k-1]
-                   - workload_prefix_sum( start[0], start[1],
-                                          start[2] ); // S[i-1][j-1][k-1]
-        }
-    };
+        int r = 0;
+        while ( r + 1 < num_rank && rec_partition( r + 1, dim ) <= tile )
+            ++r;
+        return r;
+    }
 
   private:
     // workload_threshold
@@ -739,10 +702,12 @@ class SparseDimPartitioner : public BlockPartitioner<3>
     partition_view _rectangle_partition_dev;
     // the workload of each tile on current
     workload_view _workload_per_tile;
-    // 3d prefix sum of the workload of each tile on current
-    workload_view _workload_prefix_sum;
+    // prefix sum of the workload profile along the last optimized dimension
+    workload_profile_view _workload_profile;
     // ranks per dimension
     Kokkos::Array<int, 3> _ranks_per_dim;
+    // workload reduction communicator of the deprecated overloads
+    MPI_Comm _workload_comm = MPI_COMM_WORLD;
 
     void allocate( const std::array<int, 3>& global_cells_per_dim )
     {
@@ -750,16 +715,9 @@ class SparseDimPartitioner : public BlockPartitioner<3>
         _workload_per_tile = workload_view(
             Kokkos::view_alloc( Kokkos::WithoutInitializing,
                                 "workload_per_tile" ),
-            ( global_cells_per_dim[0] >> cell_bits_per_tile_dim ) + 1,
-            ( global_cells_per_dim[1] >> cell_bits_per_tile_dim ) + 1,
-            ( global_cells_per_dim[2] >> cell_bits_per_tile_dim ) + 1 );
-
-        _workload_prefix_sum = workload_view(
-            Kokkos::view_alloc( Kokkos::WithoutInitializing,
-                                "workload_prefix_sum" ),
-            ( global_cells_per_dim[0] >> cell_bits_per_tile_dim ) + 1,
-            ( global_cells_per_dim[1] >> cell_bits_per_tile_dim ) + 1,
-            ( global_cells_per_dim[2] >> cell_bits_per_tile_dim ) + 1 );
+            global_cells_per_dim[0] >> cell_bits_per_tile_dim,
+            global_cells_per_dim[1] >> cell_bits_per_tile_dim,
+            global_cells_per_dim[2] >> cell_bits_per_tile_dim );
     }
 };
 } // end namespace Cajita
@@ -18,11 +18,13 @@
 
 #include <Cajita_GlobalMesh.hpp>
 #include <Kokkos_Core.hpp>
+#include <Kokkos_Sort.hpp>
 #include <Kokkos_UnorderedMap.hpp>
 
 #include <array>
 #include <memory>
 #include <string>
+#include <type_traits>
 
 //---------------------------------------------------------------------------//
 // Naming convension:
@@ -371,6 +373,226 @@ struct HashKey2TileID<Key, HashTypes::Morton>
     Kokkos::Array<int, 3> _tile_num;
 };
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief Open-addressed tile hash table with linear probing
+
+  Each key is stored next to its value in a single array, so a lookup touches
+  one cache line unless it has to probe past it. Morton keys interleave the
+  tile ijk in their low bits, so they are used as their own hash: tiles close
+  in space land in neighboring slots and the sweeps of particle kernels over
+  neighboring tiles stay in cache. Other keys are scattered with a
+  multiplicative hash. The interface mirrors the subset of
+  Kokkos::UnorderedMap used by BlockMap.
+
+  \tparam Key Type of the tile hash key
+  \tparam Value Type of the tile No.
+  \tparam MemorySpace Memory space to store the table
+  \tparam Hash Hash type of the keys
+*/
+template <typename Key, typename Value, typename MemorySpace, HashTypes Hash>
+class TileHashTable
+{
+  public:
+    //! Tile hash key type.
+    using key_type = Key;
+    //! Tile number type.
+    using value_type = Value;
+    //! Execution space of the memory space.
+    using execution_space = typename MemorySpace::execution_space;
+    //! Packed key/value entry.
+    struct entry_type
+    {
+        //! Tile hash key, empty_key for unused slots.
+        key_type key;
+        //! Tile No.
+        value_type value;
+    };
+    //! Key marking unused slots.
+    static constexpr key_type empty_key = ~static_cast<key_type>( 0 );
+
+    //! Result of an insertion.
+    struct insert_result
+    {
+        //! Slot of the key, capacity() if the table is full.
+        uint32_t slot;
+        //! Whether the key was already in the table.
+        bool exists;
+
+        //! (Device) Whether the key was inserted by this call.
+        KOKKOS_INLINE_FUNCTION
+        bool success() const { return !exists && slot != failed_slot; }
+        //! (Device) Whether the key was already in the table.
+        KOKKOS_INLINE_FUNCTION
+        bool existing() const { return exists; }
+        //! (Device) Whether the table was full.
+        KOKKOS_INLINE_FUNCTION
+        bool failed() const { return slot == failed_slot; }
+        //! (Device) Slot of the key.
+        KOKKOS_INLINE_FUNCTION
+        uint32_t index() const { return slot; }
+
+        //! Slot value of a failed insertion.
+        uint32_t failed_slot;
+    };
+
+    /*!
+      \brief (Host) Constructor
+      \param capacity Expected number of keys
+    */
+    TileHashTable( const uint32_t capacity = 0 ) { allocate( capacity ); }
+
+    /*!
+     \brief (Host/Device) Number of slots in the table
+    */
+    KOKKOS_INLINE_FUNCTION
+    uint32_t capacity() const { return _entries.extent( 0 ); }
+
+    /*!
+      \brief (Device) Insert a key. Concurrent insertions of the same key
+      return the same slot and only one of them succeeds.
+      \param key Tile hash key
+      \param value Tile No. stored with a new key
+    */
+    KOKKOS_INLINE_FUNCTION
+    insert_result insert( const key_type key, const value_type value ) const
+    {
+        const key_type empty = empty_key;
+        uint32_t cap = capacity();
+        uint32_t slot = hash( key );
+        for ( uint32_t n = 0; n < cap; ++n )
+        {
+            key_type prev = Kokkos::atomic_compare_exchange(
+                &_entries( slot ).key, empty, key );
+            if ( prev == empty )
+            {
+                _entries( slot ).value = value;
+                return insert_result{ slot, false, cap };
+            }
+            if ( prev == key )
+                return insert_result{ slot, true, cap };
+            slot = ( slot + 1 ) & ( cap - 1 );
+        }
+        return insert_result{ cap, false, cap };
+    }
+
+    /*!
+      \brief (Device) Find the slot of a key, capacity() if it is absent
+      \param key Tile hash key
+    */
+    KOKKOS_INLINE_FUNCTION
+    uint32_t find( const key_type key ) const
+    {
+        uint32_t cap = capacity();
+        uint32_t slot = hash( key );
+        for ( uint32_t n = 0; n < cap; ++n )
+        {
+            key_type k = _entries( slot ).key;
+            if ( k == key )
+                return slot;
+            if ( k == empty_key )
+                break;
+            slot = ( slot + 1 ) & ( cap - 1 );
+        }
+        return cap;
+    }
+
+    /*!
+      \brief (Device) Whether a slot holds a key
+      \param index Slot number
+    */
+    KOKKOS_INLINE_FUNCTION
+    bool valid_at( const uint32_t index ) const
+    {
+        return _entries( index ).key != empty_key;
+    }
+
+    /*!
+      \brief (Device) Key of a slot
+      \param index Slot number
+    */
+    KOKKOS_INLINE_FUNCTION
+    key_type key_at( const uint32_t index ) const
+    {
+        return _entries( index ).key;
+    }
+
+    /*!
+      \brief (Device) Value of a slot
+      \param index Slot number
+    */
+    KOKKOS_INLINE_FUNCTION
+    value_type& value_at( const uint32_t index ) const
+    {
+        return _entries( index ).value;
+    }
+
+    /*!
+      \brief (Host) Remove all keys
+    */
+    void clear()
+    {
+        auto entries = _entries;
+        Kokkos::parallel_for(
+            "Cajita::TileHashTable::clear",
+            Kokkos::RangePolicy<execution_space>( 0, capacity() ),
+            KOKKOS_LAMBDA( const uint32_t n ) {
+                entries( n ).key = empty_key;
+            } );
+        Kokkos::fence();
+    }
+
+    /*!
+      \brief (Host) Grow the table to hold at least the given number of keys,
+      reinserting the keys and their values
+      \param capacity Expected number of keys
+    */
+    bool rehash( const uint32_t capacity )
+    {
+        if ( capacity + capacity / 2 <= this->capacity() )
+            return true;
+        auto old_entries = _entries;
+        allocate( capacity );
+        auto table = *this;
+        Kokkos::parallel_for(
+            "Cajita::TileHashTable::rehash",
+            Kokkos::RangePolicy<execution_space>( 0, old_entries.extent( 0 ) ),
+            KOKKOS_LAMBDA( const uint32_t n ) {
+                if ( old_entries( n ).key != empty_key )
+                    table.insert( old_entries( n ).key,
+                                  old_entries( n ).value );
+            } );
+        Kokkos::fence();
+        return true;
+    }
+
+  private:
+    // Slot of a key before probing.
+    KOKKOS_INLINE_FUNCTION
+    uint32_t hash( const key_type key ) const
+    {
+        uint64_t h = static_cast<uint64_t>( key );
+        if ( Hash != HashTypes::Morton )
+            h = ( h * 0x9E3779B97F4A7C15ULL ) >> 32;
+        return static_cast<uint32_t>( h ) & ( capacity() - 1 );
+    }
+
+    // Allocate empty slots, keeping the load factor at most 2/3 so probe
+    // sequences stay short.
+    void allocate( const uint32_t capacity )
+    {
+        uint32_t cap = 1;
+        while ( cap < capacity + capacity / 2 )
+            cap <<= 1;
+        _entries = Kokkos::View<entry_type*, MemorySpace>(
+            Kokkos::ViewAllocateWithoutInitializing( "tile_hash_table" ),
+            cap );
+        clear();
+    }
+
+    Kokkos::View<entry_type*, MemorySpace> _entries;
+};
+
 //---------------------------------------------------------------------------//
 // Hierarchical index spaces
 // SparseMap <- BlockMap <- TileMap
@@ -488,6 +710,16 @@ class SparseMap
         return tile_id;
     }
 
+    /*!
+      \brief (Device) Whether a tile is registered in the hash table
+      \param tile_i, tile_j, tile_k Tile ID in each dimension
+    */
+    KOKKOS_INLINE_FUNCTION
+    bool tileExists( int tile_i, int tile_j, int tile_k ) const
+    {
+        return _block_id_space.exists( tile_i, tile_j, tile_k );
+    }
+
     /*!
       \brief (Device) Query the 1D cell key from the 3D cell ijk
       \param cell_i, cell_j, cell_k Cell ID in each dimension
@@ -590,6 +822,176 @@ SparseMap<MemorySpace, CellPerTileDim, Hash, Key, Value> createSparseMap(
         pre_alloc_size );
 }
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief (Host) Register the tiles containing a set of particles in a sparse
+  map with a single bulk insertion
+  \param exec_space Execution space
+  \param map Sparse map to insert the tiles into
+  \param positions Particle positions, accessed as positions( p, dim )
+  \param num_particles Number of particles
+  \param global_mesh Global mesh locating the particles on the grid
+  \param cell_halo Number of cells around the cell of each particle whose
+  tiles are registered as well, e.g. to cover interpolation stencils
+  \param periodic Whether each dimension is periodic. Halos crossing a
+  periodic boundary register the tiles on the other side of the mesh.
+  \return Number of distinct tiles registered for the particles
+
+  Instead of every particle inserting its tile into the hash table, the tile
+  keys are computed for all particles, sorted, and reduced to the distinct
+  tiles. The hash table is then resized once, if needed, and each tile is
+  inserted by a single thread. Particles outside of the global mesh are
+  ignored, as are the parts of their halos outside of non-periodic
+  boundaries.
+*/
+template <class ExecutionSpace, class SparseMapType, class PositionType,
+          class Scalar>
+int registerParticles(
+    const ExecutionSpace& exec_space, SparseMapType& map,
+    const PositionType& positions, const std::size_t num_particles,
+    const GlobalMesh<SparseMesh<Scalar>>& global_mesh,
+    const int cell_halo = 0,
+    const std::array<bool, 3>& periodic = { false, false, false } )
+{
+    using memory_space = typename ExecutionSpace::memory_space;
+    constexpr int cell_bits = SparseMapType::cell_bits_per_tile_dim;
+    constexpr uint64_t invalid_key = ~static_cast<uint64_t>( 0 );
+
+    // Compute the lexicographic global tile keys of each particle. The halo
+    // of a particle covers at most span tiles per dimension.
+    Kokkos::Array<Scalar, 3> low_corner;
+    Kokkos::Array<Scalar, 3> inv_cell_size;
+    Kokkos::Array<int, 3> num_cell;
+    Kokkos::Array<int, 3> num_tile;
+    Kokkos::Array<bool, 3> is_periodic;
+    for ( int d = 0; d < 3; ++d )
+    {
+        is_periodic[d] = periodic[d];
+        low_corner[d] = global_mesh.lowCorner( d );
+        inv_cell_size[d] = 1.0 / global_mesh.cellSize( d );
+        num_cell[d] = global_mesh.globalNumCell( d );
+        num_tile[d] = num_cell[d] >> cell_bits;
+    }
+    int span = ( cell_halo > 0 ) ? ( ( 2 * cell_halo ) >> cell_bits ) + 2 : 1;
+    int keys_per_particle = span * span * span;
+    std::size_t num_keys = num_particles * keys_per_particle;
+    Kokkos::View<uint64_t*, memory_space> keys(
+        Kokkos::ViewAllocateWithoutInitializing( "particle_tile_keys" ),
+        num_keys );
+    Kokkos::parallel_for(
+        "Cajita::registerParticles::keys",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_particles ),
+        KOKKOS_LAMBDA( const std::size_t p ) {
+            int tile_lo[3];
+            int tile_hi[3];
+            bool in_mesh = true;
+            for ( int d = 0; d < 3; ++d )
+            {
+                Scalar x = ( positions( p, d ) - low_corner[d] ) *
+                           inv_cell_size[d];
+                int cell = x < 0.0 ? -1 : static_cast<int>( x );
+                if ( cell < 0 || cell >= num_cell[d] )
+                    in_mesh = false;
+                int lo = cell - cell_halo;
+                int hi = cell + cell_halo;
+                if ( !is_periodic[d] )
+                {
+                    lo = lo < 0 ? 0 : lo;
+                    hi = hi < num_cell[d] ? hi : num_cell[d] - 1;
+                }
+                // Shift by whole meshes to divide non-negative indices.
+                tile_lo[d] =
+                    ( ( lo + num_cell[d] ) >> cell_bits ) - num_tile[d];
+                tile_hi[d] =
+                    ( ( hi + num_cell[d] ) >> cell_bits ) - num_tile[d];
+            }
+            for ( int n = 0; n < keys_per_particle; ++n )
+            {
+                int tile[3] = { tile_lo[0] + n % span,
+                                tile_lo[1] + ( n / span ) % span,
+                                tile_lo[2] + n / ( span * span ) };
+                bool valid = in_mesh;
+                uint64_t key = 0;
+                for ( int d = 2; d >= 0; --d )
+                {
+                    if ( tile[d] > tile_hi[d] )
+                        valid = false;
+                    int t = ( tile[d] + num_tile[d] ) % num_tile[d];
+                    key = key * num_tile[d] + t;
+                }
+                keys( p * keys_per_particle + n ) = valid ? key : invalid_key;
+            }
+        } );
+    exec_space.fence();
+
+    // Sort the keys and compact the distinct ones.
+    Kokkos::sort( keys );
+    Kokkos::View<uint64_t*, memory_space> unique_keys(
+        Kokkos::ViewAllocateWithoutInitializing( "unique_tile_keys" ),
+        num_keys );
+    int num_unique = 0;
+    Kokkos::parallel_scan(
+        "Cajita::registerParticles::unique",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_keys ),
+        KOKKOS_LAMBDA( const std::size_t p, int& count, const bool final ) {
+            if ( keys( p ) != invalid_key &&
+                 ( p == 0 || keys( p ) != keys( p - 1 ) ) )
+            {
+                if ( final )
+                    unique_keys( count ) = keys( p );
+                ++count;
+            }
+        },
+        num_unique );
+
+    // Size the hash table once and insert the distinct tiles.
+    std::size_t required = map.size() + num_unique;
+    if ( map.capacity() < required )
+        map.reserve( required );
+    auto insert_map = map;
+    Kokkos::parallel_for(
+        "Cajita::registerParticles::insert",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_unique ),
+        KOKKOS_LAMBDA( const int n ) {
+            uint64_t key = unique_keys( n );
+            int tile_i = key % num_tile[0];
+            key /= num_tile[0];
+            int tile_j = key % num_tile[1];
+            int tile_k = key / num_tile[1];
+            insert_map.insertTile( tile_i, tile_j, tile_k );
+        } );
+    exec_space.fence();
+
+    return num_unique;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief (Host) Register the tiles containing a set of particles in a sparse
+  map with a single bulk insertion
+  \param exec_space Execution space
+  \param map Sparse map to insert the tiles into
+  \param positions Particle positions, accessed as positions( p, dim )
+  \param num_particles Number of particles
+  \param global_mesh Global mesh locating the particles on the grid
+  \param cell_halo Number of cells around the cell of each particle whose
+  tiles are registered as well
+  \param periodic Whether each dimension is periodic
+  \return Number of distinct tiles registered for the particles
+*/
+template <class ExecutionSpace, class SparseMapType, class PositionType,
+          class Scalar>
+int registerParticles(
+    const ExecutionSpace& exec_space, SparseMapType& map,
+    const PositionType& positions, const std::size_t num_particles,
+    const std::shared_ptr<GlobalMesh<SparseMesh<Scalar>>>& global_mesh,
+    const int cell_halo = 0,
+    const std::array<bool, 3>& periodic = { false, false, false } )
+{
+    return registerParticles( exec_space, map, positions, num_particles,
+                              *global_mesh, cell_halo, periodic );
+}
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Block index space, mapping tile ijks to tile No. through a hash table
@@ -736,7 +1138,7 @@ class BlockMap
         // If the tile key was actually inserted, atomically increment the
         // counter Only threads that actually did a successful insert will call
         // it
-        if ( !insert_result.existing() )
+        if ( insert_result.success() )
             _tile_table.value_at( insert_result.index() ) =
                 Kokkos::atomic_fetch_add( &( _tile_table_info( 0 ) ), 1 );
     }
@@ -752,6 +1154,17 @@ class BlockMap
             _tile_table.find( ijk2key( tile_i, tile_j, tile_k ) ) );
     }
 
+    /*!
+      \brief (Device) Whether a tile is in the hash table
+      \param tile_i, tile_j, tile_k Tile ID in each dimension
+    */
+    KOKKOS_INLINE_FUNCTION
+    bool exists( int tile_i, int tile_j, int tile_k ) const
+    {
+        auto index = _tile_table.find( ijk2key( tile_i, tile_j, tile_k ) );
+        return index < _tile_table.capacity() && _tile_table.valid_at( index );
+    }
+
     /*!
       \brief (Device) Transfer tile ijk to tile hash key
       \param tile_i, tile_j, tile_k Tile ID in each dimension
@@ -778,8 +1191,12 @@ class BlockMap
     Kokkos::View<int[2], MemorySpace> _tile_table_info;
     //! current number of tiles inserted to the hash table
     Kokkos::Array<int, 3> _block_size;
-    //! hash table (tile hash key => tile No)
-    Kokkos::UnorderedMap<key_type, value_type, MemorySpace> _tile_table;
+    //! hash table (tile hash key => tile No), open-addressed for Morton keys
+    typename std::conditional<
+        hash_type == HashTypes::Morton,
+        TileHashTable<key_type, value_type, MemorySpace, hash_type>,
+        Kokkos::UnorderedMap<key_type, value_type, MemorySpace>>::type
+        _tile_table;
     //! Ops: transfer between tile ijk <=> tile hash key
     TileID2HashKey<key_type, hash_type> _op_ijk2key;
     HashKey2TileID<key_type, hash_type> _op_key2ijk;
@@ -0,0 +1,389 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cajita_SparseInterpolation.hpp
+  \brief Particle to grid and grid to particle interpolation on sparse arrays
+*/
+#ifndef CAJITA_SPARSEINTERPOLATION_HPP
+#define CAJITA_SPARSEINTERPOLATION_HPP
+
+#include <Cabana_Sort.hpp>
+#include <impl/Cabana_Profiling.hpp>
+
+#include <Cajita_Interpolation.hpp>
+#include <Cajita_LocalGrid.hpp>
+#include <Cajita_SparseArray.hpp>
+#include <Cajita_SparseIndexSpace.hpp>
+#include <Cajita_Splines.hpp>
+#include <Cajita_Types.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Sort.hpp>
+
+#include <array>
+#include <type_traits>
+
+namespace Cajita
+{
+//---------------------------------------------------------------------------//
+//! \cond Impl
+namespace Impl
+{
+// Geometry of the cells of a sparse grid. Cell indices are global and wrap
+// around periodic boundaries.
+template <class Scalar>
+struct SparseGridGeometry
+{
+    // Location of the cell with index 0 and cell size.
+    Scalar low_x[3];
+    Scalar dx[3];
+    int num_cell[3];
+    bool periodic[3];
+
+    // Wrap a cell index into the mesh. Returns false if the index is
+    // outside of a non-periodic mesh.
+    KOKKOS_INLINE_FUNCTION
+    bool wrap( const int d, int& i ) const
+    {
+        if ( periodic[d] )
+            i = ( i % num_cell[d] + num_cell[d] ) % num_cell[d];
+        return ( i >= 0 ) && ( i < num_cell[d] );
+    }
+};
+
+// Create the cell geometry of a sparse grid.
+template <class Scalar>
+SparseGridGeometry<Scalar>
+createSparseGridGeometry( const LocalGrid<SparseMesh<Scalar, 3>>& local_grid )
+{
+    const auto& global_grid = local_grid.globalGrid();
+    const auto& global_mesh = global_grid.globalMesh();
+    SparseGridGeometry<Scalar> geom;
+    for ( int d = 0; d < 3; ++d )
+    {
+        geom.dx[d] = global_mesh.cellSize( d );
+        geom.low_x[d] = global_mesh.lowCorner( d ) + 0.5 * geom.dx[d];
+        geom.num_cell[d] = global_grid.globalNumEntity( Cell(), d );
+        geom.periodic[d] = global_grid.isPeriodic( d );
+    }
+    return geom;
+}
+
+// Evaluate the spline data of a point on a sparse grid. Stencil indices are
+// global cell indices.
+template <class Scalar, class PointCoordinates>
+struct SparseSplinePointEvaluator
+{
+    SparseGridGeometry<Scalar> geom;
+    PointCoordinates points;
+
+    template <class SplineDataType>
+    KOKKOS_INLINE_FUNCTION void operator()( const int p,
+                                            SplineDataType& sd ) const
+    {
+        Scalar px[3];
+        for ( int d = 0; d < 3; ++d )
+            px[d] = points( p, d );
+        evaluateSpline( geom.low_x, geom.dx, px, sd );
+    }
+};
+
+// Access the cells of a sparse array by global cell index for point-to-grid
+// interpolation. Contributions to cells outside of a non-periodic mesh or in
+// tiles missing from the map are added to a dummy value and dropped.
+template <class SparseViewType, class Scalar>
+struct SparseGridAccessor
+{
+    using view_type = typename SparseViewType::view_type;
+    using value_type = typename view_type::value_type;
+    static constexpr int cell_bits =
+        SparseViewType::sparse_map_type::cell_bits_per_tile_dim;
+
+    SparseViewType view;
+    Kokkos::View<value_type, typename view_type::device_type> dummy;
+    SparseGridGeometry<Scalar> geom;
+
+    // Extent of the grid in each dimension and number of components.
+    KOKKOS_INLINE_FUNCTION
+    int extent( const int d ) const
+    {
+        return ( d < 3 ) ? geom.num_cell[d]
+                         : static_cast<int>( view.data.extent( 2 ) );
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    value_type& operator()( int i, int j, int k, const int c ) const
+    {
+        if ( geom.wrap( Dim::I, i ) && geom.wrap( Dim::J, j ) &&
+             geom.wrap( Dim::K, k ) &&
+             view.map.tileExists( i >> cell_bits, j >> cell_bits,
+                                  k >> cell_bits ) )
+            return view( i, j, k, c );
+        return dummy();
+    }
+};
+
+// Access the cells of a sparse array in the stencil of a single point for
+// grid-to-point interpolation. The stencil spans at most two tiles per
+// dimension which are located in the map once per point. Cells in missing
+// tiles or outside of a non-periodic mesh are zero.
+template <class SparseViewType, class Scalar, int NumKnot>
+struct SparseStencilAccessor
+{
+    using sparse_map_type = typename SparseViewType::sparse_map_type;
+    using value_type = typename SparseViewType::view_type::value_type;
+    static constexpr int cell_bits = sparse_map_type::cell_bits_per_tile_dim;
+    static constexpr int cell_mask = sparse_map_type::cell_mask_per_tile_dim;
+    using tile_map_type =
+        TileMap<sparse_map_type::cell_bits_per_tile_dim,
+                sparse_map_type::cell_num_per_tile_dim,
+                sparse_map_type::cell_num_per_tile>;
+    static_assert( NumKnot <= sparse_map_type::cell_num_per_tile_dim,
+                   "Spline stencils must span at most two tiles" );
+
+    SparseViewType view;
+    SparseGridGeometry<Scalar> geom;
+    int base[3];
+    int tile[8];
+
+    // Locate the tiles covering the stencil of a point.
+    template <class SplineDataType>
+    KOKKOS_INLINE_FUNCTION void bind( const SplineDataType& sd )
+    {
+        for ( int d = 0; d < 3; ++d )
+            base[d] = sd.s[d][0] >> cell_bits;
+        for ( int n = 0; n < 8; ++n )
+        {
+            int c[3] = { ( base[0] + ( n & 1 ) ) << cell_bits,
+                         ( base[1] + ( ( n >> 1 ) & 1 ) ) << cell_bits,
+                         ( base[2] + ( n >> 2 ) ) << cell_bits };
+            bool valid = true;
+            for ( int d = 0; d < 3; ++d )
+                valid = geom.wrap( d, c[d] ) && valid;
+            tile[n] = ( valid && view.map.tileExists( c[0] >> cell_bits,
+                                                      c[1] >> cell_bits,
+                                                      c[2] >> cell_bits ) )
+                          ? static_cast<int>(
+                                view.map.queryTile( c[0], c[1], c[2] ) )
+                          : -1;
+        }
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    value_type operator()( const int i, const int j, const int k,
+                           const int c ) const
+    {
+        int n = ( ( i >> cell_bits ) - base[0] ) +
+                2 * ( ( ( j >> cell_bits ) - base[1] ) +
+                      2 * ( ( k >> cell_bits ) - base[2] ) );
+        if ( tile[n] < 0 )
+            return value_type( 0 );
+        return view.data( tile[n],
+                          tile_map_type::coordToOffset(
+                              i & cell_mask, j & cell_mask, k & cell_mask ),
+                          c );
+    }
+};
+
+} // end namespace Impl
+//! \endcond
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Grid-to-Point interpolation from a sparse array.
+
+  \tparam PointEvalFunctor Functor type used to evaluate the interpolated data
+  for a given point at a given entity.
+
+  \tparam PointCoordinates Container type with view traits containing the
+  point coordinates. Will be indexed as (point,dim).
+
+  \param array The sparse cell array from which the point data will be
+  interpolated.
+
+  \param halo The halo of the array. This halo will be used to gather the
+  array data before interpolation.
+
+  \param local_grid The local grid the array is defined on.
+
+  \param points The points over which to perform the interpolation. Will be
+  indexed as (point,dim). The stencil of each point must be contained within
+  the owned and halo tiles of the local grid.
+
+  \param num_point The number of points. This is the size of the first
+  dimension of points.
+
+  \param functor A functor that interpolates from a given entity to a given
+  point.
+
+  The tiles covering the stencil of each point are located in the sparse map
+  once per point, such that the stencil loops of the functor read the tile
+  data directly. Cells of tiles not registered in the map are zero.
+
+  \note Spline of SplineOrder passed for interpolation.
+*/
+template <class PointEvalFunctor, class PointCoordinates, class ArrayScalar,
+          class DeviceType, class SparseMapType, class MeshScalar,
+          int SplineOrder>
+void g2p( SparseArray<ArrayScalar, DeviceType, SparseMapType>& array,
+          const SparseHalo<ArrayScalar, DeviceType, SparseMapType>& halo,
+          const LocalGrid<SparseMesh<MeshScalar, 3>>& local_grid,
+          const PointCoordinates& points, const std::size_t num_point,
+          Spline<SplineOrder>, const PointEvalFunctor& functor )
+{
+    Cabana::Impl::ScopedProfileRegion region( "Cajita::g2p" );
+
+    using execution_space = typename DeviceType::execution_space;
+    using sd_type = SplineData<MeshScalar, SplineOrder, 3, Cell>;
+    using array_type = SparseArray<ArrayScalar, DeviceType, SparseMapType>;
+    using accessor_type =
+        Impl::SparseStencilAccessor<typename array_type::sparse_view_type,
+                                    MeshScalar, sd_type::num_knot>;
+
+    // Gather data into the halo before interpolating.
+    halo.gather( execution_space(), array );
+
+    auto geom = Impl::createSparseGridGeometry( local_grid );
+    Impl::SparseSplinePointEvaluator<MeshScalar, PointCoordinates> evaluator{
+        geom, points };
+    accessor_type accessor;
+    accessor.view = array.sparseView();
+    accessor.geom = geom;
+
+    // Loop over points and interpolate from the grid.
+    Kokkos::parallel_for(
+        "g2p", Kokkos::RangePolicy<execution_space>( 0, num_point ),
+        KOKKOS_LAMBDA( const int p ) {
+            // Create the spline data.
+            sd_type sd;
+            evaluator( p, sd );
+
+            // Locate the stencil tiles and evaluate the functor.
+            auto stencil = accessor;
+            stencil.bind( sd );
+            functor( sd, p, stencil );
+        } );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Point-to-Grid interpolation to a sparse array.
+
+  \tparam PointEvalFunctor Functor type used to evaluate the interpolated data
+  for a given point at a given entity.
+
+  \tparam PointCoordinates Container type with view traits containing the
+  point coordinates. Will be indexed as (point,dim).
+
+  \param functor A functor that interpolates from a given point to a given
+  entity.
+
+  \param points The points over which to perform the interpolation. Will be
+  indexed as (point,dim). The stencil of each point must be contained within
+  the owned and halo tiles of the local grid.
+
+  \param num_point The number of points. This is the size of the first
+  dimension of points.
+
+  \param halo The halo of the array. This halo will be used to scatter the
+  interpolated data.
+
+  \param array The sparse cell array to which the point data will be
+  interpolated.
+
+  \param local_grid The local grid the array is defined on.
+
+  The tiles covered by the stencils of the points are registered in the
+  sparse map of the array and allocated. The points are then binned by the
+  tile of their cell and each bin is interpolated by one thread team
+  accumulating into a scratch tile, such that atomic updates to the array are
+  done per tile cell rather than per point and stencil cell. The ghost tiles
+  are finally summed into their owning ranks.
+
+  \note Spline of SplineOrder passed for interpolation.
+*/
+template <class PointEvalFunctor, class PointCoordinates, class ArrayScalar,
+          class DeviceType, class SparseMapType, class MeshScalar,
+          int SplineOrder>
+void p2g( const PointEvalFunctor& functor, const PointCoordinates& points,
+          const std::size_t num_point, Spline<SplineOrder>,
+          const SparseHalo<ArrayScalar, DeviceType, SparseMapType>& halo,
+          SparseArray<ArrayScalar, DeviceType, SparseMapType>& array,
+          const LocalGrid<SparseMesh<MeshScalar, 3>>& local_grid )
+{
+    Cabana::Impl::ScopedProfileRegion region( "Cajita::p2g" );
+
+    using execution_space = typename DeviceType::execution_space;
+    using sd_type = SplineData<MeshScalar, SplineOrder, 3, Cell>;
+    using array_type = SparseArray<ArrayScalar, DeviceType, SparseMapType>;
+    using accessor_type =
+        Impl::SparseGridAccessor<typename array_type::sparse_view_type,
+                                 MeshScalar>;
+
+    // Register and allocate the tiles covered by the point stencils.
+    auto geom = Impl::createSparseGridGeometry( local_grid );
+    std::array<bool, 3> periodic;
+    for ( int d = 0; d < 3; ++d )
+        periodic[d] = geom.periodic[d];
+    registerParticles( execution_space(), *array.map(), points, num_point,
+                       local_grid.globalGrid().globalMesh(),
+                       sd_type::num_knot / 2, periodic );
+    array.resize();
+
+    // Bin the points by the tile of their cell. Points outside of the mesh
+    // are put in a last bin.
+    auto sparse_view = array.sparseView();
+    int num_tile = array.numTile();
+    Kokkos::View<int*, DeviceType> keys(
+        Kokkos::ViewAllocateWithoutInitializing( "p2g_tile_keys" ),
+        num_point );
+    Kokkos::parallel_for(
+        "p2g_tile_keys", Kokkos::RangePolicy<execution_space>( 0, num_point ),
+        KOKKOS_LAMBDA( const int p ) {
+            int cell[3];
+            bool in_mesh = true;
+            for ( int d = 0; d < 3; ++d )
+            {
+                MeshScalar x =
+                    ( points( p, d ) - geom.low_x[d] ) / geom.dx[d] + 0.5;
+                cell[d] = ( x < 0.0 ) ? -1 : static_cast<int>( x );
+                in_mesh = in_mesh && ( cell[d] < geom.num_cell[d] );
+                in_mesh = in_mesh && ( cell[d] >= 0 );
+            }
+            keys( p ) = in_mesh ? static_cast<int>( sparse_view.map.queryTile(
+                                      cell[0], cell[1], cell[2] ) )
+                                : num_tile;
+        } );
+    Kokkos::BinOp1D<decltype( keys )> comp( num_tile + 1, 0, num_tile + 1 );
+    auto bins = Cabana::binByKeyWithComparator( keys, comp );
+
+    // Interpolate the bins into the array.
+    Impl::SparseSplinePointEvaluator<MeshScalar, PointCoordinates> evaluator{
+        geom, points };
+    accessor_type accessor;
+    accessor.view = sparse_view;
+    accessor.dummy = Kokkos::View<ArrayScalar, DeviceType>( "p2g_dummy" );
+    accessor.geom = geom;
+    Impl::binnedP2G<sd_type>( execution_space(), functor, evaluator, bins,
+                              accessor, false,
+                              SparseMapType::cell_num_per_tile_dim );
+
+    // Scatter interpolation contributions in the ghost tiles back to their
+    // owning ranks.
+    halo.scatter( execution_space(), array );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cajita
+
+#endif // end CAJITA_SPARSEINTERPOLATION_HPP
@@ -0,0 +1,300 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cajita_SpectralPoissonSolver.hpp
+  \brief FFT-based Poisson solver for periodic uniform meshes
+*/
+#ifndef CAJITA_SPECTRALPOISSONSOLVER_HPP
+#define CAJITA_SPECTRALPOISSONSOLVER_HPP
+
+#include <Cajita_Array.hpp>
+#include <Cajita_FastFourierTransform.hpp>
+#include <Cajita_IndexSpace.hpp>
+#include <Cajita_LocalGrid.hpp>
+#include <Cajita_Types.hpp>
+
+#include <impl/Cabana_Profiling.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+
+namespace Cajita
+{
+namespace Experimental
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief Laplacian eigenvalues used by the spectral Poisson solver.
+*/
+enum class SpectralPoissonKernel
+{
+    //! Eigenvalues of the continuous Laplacian, -|k|^2.
+    Continuous,
+    //! Eigenvalues of the second-order 7-point finite difference Laplacian
+    //! such that the solution matches the iterative structured solvers.
+    FiniteDifference
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Spectral Poisson solver for a mesh periodic in all dimensions.
+
+  Solves the Poisson equation lap(x) = b with one forward FFT of the right
+  hand side, a multiply by the Green's function in k-space, and one reverse
+  FFT. The Green's function depends only on the mesh and is computed once at
+  construction and cached. The zero mode is removed such that the solution
+  has zero mean; the right hand side is assumed to have zero mean.
+
+  Arrays with a single field use a real-to-complex transform. Arrays with
+  several fields pack pairs of real fields into the real and imaginary parts
+  of complex fields, which are solved in a single batched transform. The
+  Green's function is real and even in k such that the fields of a pair do
+  not mix.
+
+  \tparam Scalar The scalar type.
+  \tparam EntityType The array entity type.
+  \tparam DeviceType The device type.
+*/
+template <class Scalar, class EntityType, class DeviceType>
+class SpectralPoissonSolver
+{
+  public:
+    //! Scalar value type.
+    using value_type = Scalar;
+    //! Array entity type.
+    using entity_type = EntityType;
+    //! Kokkos device type.
+    using device_type = DeviceType;
+    //! Kokkos execution space.
+    using execution_space = typename DeviceType::execution_space;
+    //! Kokkos memory space.
+    using memory_space = typename DeviceType::memory_space;
+    //! Mesh type.
+    using mesh_type = UniformMesh<Scalar, 3>;
+    //! Array type.
+    using array_type = Array<Scalar, EntityType, mesh_type, DeviceType>;
+    //! Green's function view type, indexed locally from the minimum of the
+    //! spectral index space.
+    using green_view_type =
+        Kokkos::View<Scalar***, Kokkos::LayoutRight, DeviceType>;
+
+    /*!
+      \brief Constructor.
+      \param layout The layout of the solution and right hand side arrays.
+      Every DoF per entity is a separate field.
+      \param kernel The Laplacian eigenvalues to invert.
+    */
+    SpectralPoissonSolver( const ArrayLayout<EntityType, mesh_type>& layout,
+                           const SpectralPoissonKernel kernel =
+                               SpectralPoissonKernel::FiniteDifference )
+        : _num_field( layout.dofsPerEntity() )
+        , _kernel( kernel )
+    {
+        const auto& global_grid = layout.localGrid()->globalGrid();
+        for ( int d = 0; d < 3; ++d )
+        {
+            if ( !global_grid.isPeriodic( d ) )
+                throw std::logic_error( "Spectral Poisson solver requires a "
+                                        "mesh periodic in all dimensions" );
+            _num_entity[d] = global_grid.globalNumEntity( EntityType(), d );
+            _cell_size[d] = global_grid.globalMesh().cellSize( d );
+        }
+
+        if ( 1 == _num_field )
+        {
+            _real_fft =
+                createHeffteRealFastFourierTransform<Scalar, DeviceType>(
+                    layout );
+            _green_space = _real_fft->spectralIndexSpace();
+        }
+        else
+        {
+            auto complex_layout = createArrayLayout(
+                layout.localGrid(), 2 * ( ( _num_field + 1 ) / 2 ),
+                EntityType() );
+            _work = createArray<Scalar, DeviceType>( "spectral_poisson_work",
+                                                     complex_layout );
+            _complex_fft =
+                createHeffteFastFourierTransform<Scalar, DeviceType>(
+                    *complex_layout );
+            _green_space =
+                layout.localGrid()->indexSpace( Own(), EntityType(), Global() );
+        }
+        computeGreenFunction();
+    }
+
+    //! Get the number of fields solved at once.
+    int numField() const { return _num_field; }
+
+    //! Get the Laplacian eigenvalues inverted by the solver.
+    SpectralPoissonKernel kernel() const { return _kernel; }
+
+    /*!
+      \brief Solve the Poisson equation.
+      \param b The right hand side.
+      \param x The solution. May be the same array as the right hand side.
+    */
+    void solve( const array_type& b, array_type& x )
+    {
+        Cabana::Impl::ScopedProfileRegion region(
+            "Cajita::SpectralPoissonSolver::solve" );
+
+        if ( b.layout()->dofsPerEntity() != _num_field ||
+             x.layout()->dofsPerEntity() != _num_field )
+            throw std::logic_error(
+                "Spectral Poisson solver array field count mismatch" );
+
+        if ( 1 == _num_field )
+        {
+            _real_fft->forward( b, FFTScaleNone() );
+            applyGreenFunction( _real_fft->spectralView() );
+            _real_fft->reverse( x, FFTScaleFull() );
+        }
+        else
+        {
+            // Pair the fields into complex fields. The imaginary part of the
+            // last pair is zero for an odd number of fields.
+            auto own_space = b.layout()->localGrid()->indexSpace(
+                Own(), EntityType(), Local() );
+            auto b_view = b.view();
+            auto work_view = _work->view();
+            const int num_field = _num_field;
+            const int num_work = work_view.extent( 3 );
+            Kokkos::parallel_for(
+                "Cajita::SpectralPoissonSolver::pack",
+                createExecutionPolicy( own_space, execution_space() ),
+                KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+                    for ( int n = 0; n < num_field; ++n )
+                        work_view( i, j, k, n ) = b_view( i, j, k, n );
+                    for ( int n = num_field; n < num_work; ++n )
+                        work_view( i, j, k, n ) = 0.0;
+                } );
+
+            _complex_fft->forward( *_work, FFTScaleNone() );
+            applyGreenFunction( createSubview(
+                work_view, appendDimension( own_space, num_work ) ) );
+            _complex_fft->reverse( *_work, FFTScaleFull() );
+
+            auto x_view = x.view();
+            Kokkos::parallel_for(
+                "Cajita::SpectralPoissonSolver::unpack",
+                createExecutionPolicy( own_space, execution_space() ),
+                KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+                    for ( int n = 0; n < num_field; ++n )
+                        x_view( i, j, k, n ) = work_view( i, j, k, n );
+                } );
+        }
+    }
+
+  private:
+    // Compute the inverse Laplacian eigenvalues on the global index space of
+    // the spectral data owned by this rank.
+    void computeGreenFunction()
+    {
+        auto space = _green_space;
+        _green = green_view_type(
+            Kokkos::ViewAllocateWithoutInitializing( "spectral_poisson_green" ),
+            space.extent( Dim::I ), space.extent( Dim::J ),
+            space.extent( Dim::K ) );
+        auto green = _green;
+        const bool continuous =
+            ( SpectralPoissonKernel::Continuous == _kernel );
+        const Kokkos::Array<int, 3> num_entity = {
+            _num_entity[0], _num_entity[1], _num_entity[2] };
+        const Kokkos::Array<Scalar, 3> h = { _cell_size[0], _cell_size[1],
+                                             _cell_size[2] };
+        Kokkos::parallel_for(
+            "Cajita::SpectralPoissonSolver::green",
+            createExecutionPolicy( space, execution_space() ),
+            KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+                const int n[3] = { i, j, k };
+                Scalar eigenvalue = 0.0;
+                for ( int d = 0; d < 3; ++d )
+                {
+                    int nd = ( 2 * n[d] > num_entity[d] ) ? n[d] - num_entity[d]
+                                                          : n[d];
+                    Scalar kd = 2.0 * M_PI * nd / ( num_entity[d] * h[d] );
+                    Scalar ld =
+                        continuous ? kd : 2.0 * sin( 0.5 * kd * h[d] ) / h[d];
+                    eigenvalue += ld * ld;
+                }
+                green( i - space.min( Dim::I ), j - space.min( Dim::J ),
+                       k - space.min( Dim::K ) ) =
+                    ( 0.0 == eigenvalue ) ? 0.0 : -1.0 / eigenvalue;
+            } );
+    }
+
+    // Multiply every component of the spectral data by the Green's
+    // function. The spectral data is indexed locally like the Green's
+    // function.
+    template <class ViewType>
+    void applyGreenFunction( const ViewType& spectral )
+    {
+        auto green = _green;
+        const int num_comp = spectral.extent( 3 );
+        IndexSpace<3> local_space( { _green_space.extent( Dim::I ),
+                                     _green_space.extent( Dim::J ),
+                                     _green_space.extent( Dim::K ) } );
+        Kokkos::parallel_for(
+            "Cajita::SpectralPoissonSolver::apply_green",
+            createExecutionPolicy( local_space, execution_space() ),
+            KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+                const Scalar g = green( i, j, k );
+                for ( int n = 0; n < num_comp; ++n )
+                    spectral( i, j, k, n ) *= g;
+            } );
+    }
+
+  private:
+    int _num_field;
+    SpectralPoissonKernel _kernel;
+    int _num_entity[3];
+    Scalar _cell_size[3];
+    IndexSpace<3> _green_space;
+    green_view_type _green;
+    std::shared_ptr<HeffteRealFastFourierTransform<
+        EntityType, mesh_type, Scalar, DeviceType, Impl::FFTBackendDefault>>
+        _real_fft;
+    std::shared_ptr<HeffteFastFourierTransform<
+        EntityType, mesh_type, Scalar, DeviceType, Impl::FFTBackendDefault>>
+        _complex_fft;
+    std::shared_ptr<array_type> _work;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create a spectral Poisson solver.
+  \param layout The layout of the solution and right hand side arrays. Every
+  DoF per entity is a separate field.
+  \param kernel The Laplacian eigenvalues to invert.
+*/
+template <class Scalar, class DeviceType, class EntityType>
+std::shared_ptr<SpectralPoissonSolver<Scalar, EntityType, DeviceType>>
+createSpectralPoissonSolver(
+    const ArrayLayout<EntityType, UniformMesh<Scalar, 3>>& layout,
+    const SpectralPoissonKernel kernel =
+        SpectralPoissonKernel::FiniteDifference )
+{
+    return std::make_shared<
+        SpectralPoissonSolver<Scalar, EntityType, DeviceType>>( layout,
+                                                                kernel );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Experimental
+} // end namespace Cajita
+
+#endif // end CAJITA_SPECTRALPOISSONSOLVER_HPP
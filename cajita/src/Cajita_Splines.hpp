@@ -449,6 +449,330 @@ struct Spline<3>
     }
 };
 
+//---------------------------------------------------------------------------//
+//! Quartic. Defined on the dual grid.
+template <>
+struct Spline<4>
+{
+    //! Order.
+    static constexpr int order = 4;
+
+    //! The number of non-zero knots in the spline.
+    static constexpr int num_knot = 5;
+
+    /*!
+      \brief Map a physical location to the logical space of the dual grid in a
+      single dimension.
+      \param xp The coordinate to map to the logical space.
+      \param rdx The inverse of the physical distance between grid locations.
+      \param low_x The physical location of the low corner of the dual grid.
+      \return The coordinate in the logical dual grid space.
+
+      \note Casting this result to an integer yields the index at the center
+      of the stencil.
+      \note A quartic spline uses the dual grid.
+    */
+    template <class Scalar>
+    KOKKOS_INLINE_FUNCTION static Scalar
+    mapToLogicalGrid( const Scalar xp, const Scalar rdx, const Scalar low_x )
+    {
+        return ( xp - low_x ) * rdx + 0.5;
+    }
+
+    /*!
+      \brief Get the logical space stencil offsets of the spline. The stencil
+      defines the offsets into a grid field about a logical coordinate.
+      \param indices The stencil index offsets.
+    */
+    KOKKOS_INLINE_FUNCTION
+    static void offsets( int indices[num_knot] )
+    {
+        indices[0] = -2;
+        indices[1] = -1;
+        indices[2] = 0;
+        indices[3] = 1;
+        indices[4] = 2;
+    }
+
+    /*!
+      \brief Compute the stencil indices for a given logical space location.
+      \param x0 The coordinate at which to evaluate the spline stencil.
+      \param indices The indices of the stencil.
+    */
+    template <class Scalar>
+    KOKKOS_INLINE_FUNCTION static void stencil( const Scalar x0,
+                                                int indices[num_knot] )
+    {
+        indices[0] = static_cast<int>( x0 ) - 2;
+        indices[1] = indices[0] + 1;
+        indices[2] = indices[1] + 1;
+        indices[3] = indices[2] + 1;
+        indices[4] = indices[3] + 1;
+    }
+
+    /*!
+       \brief Calculate the value of the spline at all knots.
+       \param x0 The coordinate at which to evaluate the spline in the logical
+       grid space.
+       \param values Basis values at the knots. Ordered from lowest to highest
+       in terms of knot location.
+    */
+    template <typename Scalar>
+    KOKKOS_INLINE_FUNCTION static void value( const Scalar x0,
+                                              Scalar values[num_knot] )
+    {
+        // Constants
+        Scalar one_24th = 1.0 / 24.0;
+
+        // Knot at i - 2
+        Scalar xn = x0 - static_cast<int>( x0 ) + 1.5;
+        Scalar a = 2.5 - xn;
+        values[0] = a * a * a * a * one_24th;
+
+        // Knot at i - 1
+        xn -= 1.0;
+        a = 2.5 - xn;
+        Scalar b = 1.5 - xn;
+        values[1] = ( a * a * a * a - 5.0 * b * b * b * b ) * one_24th;
+
+        // Knot at i
+        xn -= 1.0;
+        Scalar xn2 = xn * xn;
+        values[2] = 115.0 / 192.0 - 0.625 * xn2 + 0.25 * xn2 * xn2;
+
+        // Knot at i + 1
+        xn -= 1.0;
+        a = 2.5 + xn;
+        b = 1.5 + xn;
+        values[3] = ( a * a * a * a - 5.0 * b * b * b * b ) * one_24th;
+
+        // Knot at i + 2
+        xn -= 1.0;
+        a = 2.5 + xn;
+        values[4] = a * a * a * a * one_24th;
+    }
+
+    /*!
+      \brief Calculate the value of the gradient of the spline in the
+      physical frame.
+      \param x0 The coordinate at which to evaluate the spline in the logical
+      grid space.
+      \param rdx The inverse of the physical distance between grid locations.
+      \param gradients Basis gradient values at the knots in the physical
+      frame. Ordered from lowest to highest in terms of knot location.
+    */
+    template <typename Scalar>
+    KOKKOS_INLINE_FUNCTION static void
+    gradient( const Scalar x0, const Scalar rdx, Scalar gradients[num_knot] )
+    {
+        // Constants
+        Scalar one_sixth = 1.0 / 6.0;
+
+        // Knot at i - 2
+        Scalar xn = x0 - static_cast<int>( x0 ) + 1.5;
+        Scalar a = 2.5 - xn;
+        gradients[0] = -a * a * a * one_sixth * rdx;
+
+        // Knot at i - 1
+        xn -= 1.0;
+        a = 2.5 - xn;
+        Scalar b = 1.5 - xn;
+        gradients[1] = ( -a * a * a + 5.0 * b * b * b ) * one_sixth * rdx;
+
+        // Knot at i
+        xn -= 1.0;
+        gradients[2] = ( -1.25 * xn + xn * xn * xn ) * rdx;
+
+        // Knot at i + 1
+        xn -= 1.0;
+        a = 2.5 + xn;
+        b = 1.5 + xn;
+        gradients[3] = ( a * a * a - 5.0 * b * b * b ) * one_sixth * rdx;
+
+        // Knot at i + 2
+        xn -= 1.0;
+        a = 2.5 + xn;
+        gradients[4] = a * a * a * one_sixth * rdx;
+    }
+};
+
+//---------------------------------------------------------------------------//
+//! Quintic. Defined on the primal grid.
+template <>
+struct Spline<5>
+{
+    //! Order.
+    static constexpr int order = 5;
+
+    //! The number of non-zero knots in the spline.
+    static constexpr int num_knot = 6;
+
+    /*!
+      \brief Map a physical location to the logical space of the primal grid in
+      a single dimension.
+      \param xp The coordinate to map to the logical space.
+      \param rdx The inverse of the physical distance between grid locations.
+      \param low_x The physical location of the low corner of the primal
+      grid.
+      \return The coordinate in the logical primal grid space.
+
+      \note Casting this result to an integer yields the index at the center
+      of the stencil.
+      \note A quintic spline uses the primal grid.
+    */
+    template <class Scalar>
+    KOKKOS_INLINE_FUNCTION static Scalar
+    mapToLogicalGrid( const Scalar xp, const Scalar rdx, const Scalar low_x )
+    {
+        return ( xp - low_x ) * rdx;
+    }
+
+    /*!
+      \brief Get the logical space stencil offsets of the spline. The stencil
+      defines the offsets into a grid field about a logical coordinate.
+      \param indices The stencil index offsets.
+    */
+    KOKKOS_INLINE_FUNCTION
+    static void offsets( int indices[num_knot] )
+    {
+        indices[0] = -2;
+        indices[1] = -1;
+        indices[2] = 0;
+        indices[3] = 1;
+        indices[4] = 2;
+        indices[5] = 3;
+    }
+
+    /*!
+      \brief Compute the stencil indices for a given logical space location.
+      \param x0 The coordinate at which to evaluate the spline stencil.
+      \param indices The indices of the stencil.
+    */
+    template <class Scalar>
+    KOKKOS_INLINE_FUNCTION static void stencil( const Scalar x0,
+                                                int indices[num_knot] )
+    {
+        indices[0] = static_cast<int>( x0 ) - 2;
+        indices[1] = indices[0] + 1;
+        indices[2] = indices[1] + 1;
+        indices[3] = indices[2] + 1;
+        indices[4] = indices[3] + 1;
+        indices[5] = indices[4] + 1;
+    }
+
+    /*!
+       \brief Calculate the value of the spline at all knots.
+       \param x0 The coordinate at which to evaluate the spline in the logical
+       grid space.
+       \param values Basis values at the knots. Ordered from lowest to highest
+       in terms of knot location.
+    */
+    template <typename Scalar>
+    KOKKOS_INLINE_FUNCTION static void value( const Scalar x0,
+                                              Scalar values[num_knot] )
+    {
+        // Constants
+        Scalar one_120th = 1.0 / 120.0;
+
+        // Distances from the knots at i and i + 1.
+        Scalar xn = x0 - static_cast<int>( x0 );
+        Scalar xm = 1.0 - xn;
+
+        // Knot at i - 2
+        Scalar a = 1.0 - xn;
+        values[0] = a * a * a * a * a * one_120th;
+
+        // Knot at i - 1
+        a = 2.0 - xn;
+        Scalar b = 1.0 - xn;
+        values[1] =
+            ( a * a * a * a * a - 6.0 * b * b * b * b * b ) * one_120th;
+
+        // Knot at i
+        a = 3.0 - xn;
+        b = 2.0 - xn;
+        Scalar c = 1.0 - xn;
+        values[2] = ( a * a * a * a * a - 6.0 * b * b * b * b * b +
+                      15.0 * c * c * c * c * c ) *
+                    one_120th;
+
+        // Knot at i + 1
+        a = 3.0 - xm;
+        b = 2.0 - xm;
+        c = 1.0 - xm;
+        values[3] = ( a * a * a * a * a - 6.0 * b * b * b * b * b +
+                      15.0 * c * c * c * c * c ) *
+                    one_120th;
+
+        // Knot at i + 2
+        a = 2.0 - xm;
+        b = 1.0 - xm;
+        values[4] =
+            ( a * a * a * a * a - 6.0 * b * b * b * b * b ) * one_120th;
+
+        // Knot at i + 3
+        a = 1.0 - xm;
+        values[5] = a * a * a * a * a * one_120th;
+    }
+
+    /*!
+      \brief Calculate the value of the gradient of the spline in the
+      physical frame.
+      \param x0 The coordinate at which to evaluate the spline in the logical
+      grid space.
+      \param rdx The inverse of the physical distance between grid locations.
+      \param gradients Basis gradient values at the knots in the physical
+      frame. Ordered from lowest to highest in terms of knot location.
+    */
+    template <typename Scalar>
+    KOKKOS_INLINE_FUNCTION static void
+    gradient( const Scalar x0, const Scalar rdx, Scalar gradients[num_knot] )
+    {
+        // Constants
+        Scalar one_24th = 1.0 / 24.0;
+
+        // Distances from the knots at i and i + 1.
+        Scalar xn = x0 - static_cast<int>( x0 );
+        Scalar xm = 1.0 - xn;
+
+        // Knot at i - 2
+        Scalar a = 1.0 - xn;
+        gradients[0] = -a * a * a * a * one_24th * rdx;
+
+        // Knot at i - 1
+        a = 2.0 - xn;
+        Scalar b = 1.0 - xn;
+        gradients[1] =
+            ( -a * a * a * a + 6.0 * b * b * b * b ) * one_24th * rdx;
+
+        // Knot at i
+        a = 3.0 - xn;
+        b = 2.0 - xn;
+        Scalar c = 1.0 - xn;
+        gradients[2] = ( -a * a * a * a + 6.0 * b * b * b * b -
+                         15.0 * c * c * c * c ) *
+                       one_24th * rdx;
+
+        // Knot at i + 1
+        a = 3.0 - xm;
+        b = 2.0 - xm;
+        c = 1.0 - xm;
+        gradients[3] = ( a * a * a * a - 6.0 * b * b * b * b +
+                         15.0 * c * c * c * c ) *
+                       one_24th * rdx;
+
+        // Knot at i + 2
+        a = 2.0 - xm;
+        b = 1.0 - xm;
+        gradients[4] =
+            ( a * a * a * a - 6.0 * b * b * b * b ) * one_24th * rdx;
+
+        // Knot at i + 3
+        a = 1.0 - xm;
+        gradients[5] = a * a * a * a * one_24th * rdx;
+    }
+};
+
 //---------------------------------------------------------------------------//
 // Spline Data
 //---------------------------------------------------------------------------//
@@ -790,11 +1114,15 @@ setSplineData( SplinePhysicalDistance,
 }
 
 //---------------------------------------------------------------------------//
-//! Evaluate spline data at a point in a uniform mesh.
-template <typename Scalar, int Order, std::size_t NumSpaceDim, class Device,
+/*!
+  \brief Evaluate spline data at a point in a uniform grid given the location
+  of the entity with index 0 and the cell size. Stencil indices are relative
+  to the entity with index 0.
+*/
+template <typename Scalar, int Order, std::size_t NumSpaceDim,
           class EntityType, class DataTags>
 KOKKOS_INLINE_FUNCTION void evaluateSpline(
-    const LocalMesh<Device, UniformMesh<Scalar, NumSpaceDim>>& local_mesh,
+    const Scalar low_x[NumSpaceDim], const Scalar dx[NumSpaceDim],
     const Scalar p[NumSpaceDim],
     SplineData<Scalar, Order, NumSpaceDim, EntityType, DataTags>& data )
 {
@@ -802,8 +1130,48 @@ KOKKOS_INLINE_FUNCTION void evaluateSpline(
     using sd_type =
         SplineData<Scalar, Order, NumSpaceDim, EntityType, DataTags>;
 
-    // spline type.
+    // Set the physical cell size.
+    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+        setSplineData( SplinePhysicalCellSize(), data, d, dx[d] );
+
+    // Compute the inverse physicall cell size.
+    Scalar rdx[NumSpaceDim];
+    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+        rdx[d] = 1.0 / dx[d];
+
+    // Compute the reference coordinates.
+    Scalar x[NumSpaceDim];
+    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+    {
+        x[d] = sd_type::spline_type::mapToLogicalGrid( p[d], rdx[d], low_x[d] );
+        setSplineData( SplineLogicalPosition(), data, d, x[d] );
+    }
 
+    // Compute the stencil.
+    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+    {
+        sd_type::spline_type::stencil( x[d], data.s[d] );
+    }
+
+    // Compute the weight values.
+    setSplineData( SplineWeightValues(), data, x );
+
+    // Compute the weight gradients.
+    setSplineData( SplineWeightPhysicalGradients(), data, x, rdx );
+
+    // Compute the physical distance.
+    setSplineData( SplinePhysicalDistance(), data, low_x, p, dx );
+}
+
+//---------------------------------------------------------------------------//
+//! Evaluate spline data at a point in a uniform mesh.
+template <typename Scalar, int Order, std::size_t NumSpaceDim, class Device,
+          class EntityType, class DataTags>
+KOKKOS_INLINE_FUNCTION void evaluateSpline(
+    const LocalMesh<Device, UniformMesh<Scalar, NumSpaceDim>>& local_mesh,
+    const Scalar p[NumSpaceDim],
+    SplineData<Scalar, Order, NumSpaceDim, EntityType, DataTags>& data )
+{
     // Get the low corner of the mesh.
     Scalar low_x[NumSpaceDim];
     Scalar low_x_p1[NumSpaceDim];
@@ -820,21 +1188,116 @@ KOKKOS_INLINE_FUNCTION void evaluateSpline(
     // Compute the physical cell size.
     Scalar dx[NumSpaceDim];
     for ( std::size_t d = 0; d < NumSpaceDim; ++d )
-    {
         dx[d] = low_x_p1[d] - low_x[d];
-        setSplineData( SplinePhysicalCellSize(), data, d, dx[d] );
+
+    evaluateSpline( low_x, dx, p, data );
+}
+
+//---------------------------------------------------------------------------//
+//! \cond Impl
+namespace Impl
+{
+// Logical offset of the entities from the nodes in a given dimension. Cell
+// centered entities are offset by half a cell.
+KOKKOS_INLINE_FUNCTION constexpr double entityLogicalOffset( Cell, const int )
+{
+    return 0.5;
+}
+
+KOKKOS_INLINE_FUNCTION constexpr double entityLogicalOffset( Node, const int )
+{
+    return 0.0;
+}
+
+template <int Dir>
+KOKKOS_INLINE_FUNCTION constexpr double entityLogicalOffset( Face<Dir>,
+                                                             const int d )
+{
+    return ( Dir == d ) ? 0.0 : 0.5;
+}
+
+template <int Dir>
+KOKKOS_INLINE_FUNCTION constexpr double entityLogicalOffset( Edge<Dir>,
+                                                             const int d )
+{
+    return ( Dir == d ) ? 0.5 : 0.0;
+}
+
+} // end namespace Impl
+//! \endcond
+
+//! Assign physical distance to the spline data in a non-uniform mesh.
+template <typename Scalar, int Order, std::size_t NumSpaceDim, class Device,
+          class EntityType, class DataTags>
+KOKKOS_INLINE_FUNCTION
+    std::enable_if_t<SplineData<Scalar, Order, NumSpaceDim, EntityType,
+                                DataTags>::has_physical_distance>
+    setSplineData(
+        SplinePhysicalDistance,
+        SplineData<Scalar, Order, NumSpaceDim, EntityType, DataTags>& data,
+        const LocalMesh<Device, NonUniformMesh<Scalar, NumSpaceDim>>&
+            local_mesh,
+        const Scalar p[NumSpaceDim] )
+{
+    using spline_type = typename SplineData<Scalar, Order, NumSpaceDim,
+                                            EntityType, DataTags>::spline_type;
+    int index[NumSpaceDim];
+    Scalar x[NumSpaceDim];
+    for ( int n = 0; n < spline_type::num_knot; ++n )
+    {
+        for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+            index[d] = data.s[d][n];
+        local_mesh.coordinates( EntityType(), index, x );
+        for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+            data.d[d][n] = x[d] - p[d];
     }
+}
+//! Physical distance non-uniform mesh spline data template helper.
+template <typename Scalar, int Order, std::size_t NumSpaceDim, class Device,
+          class EntityType, class DataTags>
+KOKKOS_INLINE_FUNCTION std::enable_if_t<!SplineData<
+    Scalar, Order, NumSpaceDim, EntityType, DataTags>::has_physical_distance>
+setSplineData(
+    SplinePhysicalDistance,
+    SplineData<Scalar, Order, NumSpaceDim, EntityType, DataTags>&,
+    const LocalMesh<Device, NonUniformMesh<Scalar, NumSpaceDim>>&,
+    const Scalar[NumSpaceDim] )
+{
+}
 
-    // Compute the inverse physicall cell size.
-    Scalar rdx[NumSpaceDim];
-    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
-        rdx[d] = 1.0 / dx[d];
+//---------------------------------------------------------------------------//
+/*!
+  \brief Evaluate spline data at a point in a non-uniform mesh.
 
-    // Compute the reference coordinates.
+  The point is located with the cell lookup tables of the local mesh and
+  mapped to the logical node index space, which is linear within each
+  cell. The weights are the uniform splines of the logical coordinate and the
+  gradients are scaled by the width of the cell containing the point.
+*/
+template <typename Scalar, int Order, std::size_t NumSpaceDim, class Device,
+          class EntityType, class DataTags>
+KOKKOS_INLINE_FUNCTION void evaluateSpline(
+    const LocalMesh<Device, NonUniformMesh<Scalar, NumSpaceDim>>& local_mesh,
+    const Scalar p[NumSpaceDim],
+    SplineData<Scalar, Order, NumSpaceDim, EntityType, DataTags>& data )
+{
+    // data type
+    using sd_type =
+        SplineData<Scalar, Order, NumSpaceDim, EntityType, DataTags>;
+
+    // Compute the reference coordinates and the size of the cells containing
+    // the point.
     Scalar x[NumSpaceDim];
+    Scalar rdx[NumSpaceDim];
     for ( std::size_t d = 0; d < NumSpaceDim; ++d )
     {
-        x[d] = sd_type::spline_type::mapToLogicalGrid( p[d], rdx[d], low_x[d] );
+        Scalar dx;
+        Scalar xi = local_mesh.logicalCoordinate( d, p[d], dx );
+        setSplineData( SplinePhysicalCellSize(), data, d, dx );
+        rdx[d] = 1.0 / dx;
+        Scalar offset = Impl::entityLogicalOffset( EntityType(), d );
+        x[d] = sd_type::spline_type::mapToLogicalGrid( xi, Scalar( 1.0 ),
+                                                       offset );
         setSplineData( SplineLogicalPosition(), data, d, x[d] );
     }
 
@@ -851,7 +1314,73 @@ KOKKOS_INLINE_FUNCTION void evaluateSpline(
     setSplineData( SplineWeightPhysicalGradients(), data, x, rdx );
 
     // Compute the physical distance.
-    setSplineData( SplinePhysicalDistance(), data, low_x, p, dx );
+    setSplineData( SplinePhysicalDistance(), data, local_mesh, p );
+}
+
+//---------------------------------------------------------------------------//
+// Stencil iteration
+//---------------------------------------------------------------------------//
+//! \cond Impl
+namespace Impl
+{
+// Apply a functor to the knot indices 0 to N-1 in order, unrolled at compile
+// time.
+template <int N>
+struct StencilUnroll
+{
+    template <class Functor>
+    KOKKOS_FORCEINLINE_FUNCTION static void apply( const Functor& functor )
+    {
+        StencilUnroll<N - 1>::apply( functor );
+        functor( N - 1 );
+    }
+};
+
+template <>
+struct StencilUnroll<0>
+{
+    template <class Functor>
+    KOKKOS_FORCEINLINE_FUNCTION static void apply( const Functor& )
+    {
+    }
+};
+} // end namespace Impl
+//! \endcond
+
+/*!
+  \brief Apply a functor to every node of the stencil of spline data with the
+  loops over knots unrolled at compile time. 3D specialization.
+  \param functor The functor to apply. Called with the knot indices (i,j,k)
+  into the stencil in each dimension, with k the fastest.
+*/
+template <class SplineDataType, class Functor>
+KOKKOS_FORCEINLINE_FUNCTION
+    std::enable_if_t<3 == SplineDataType::num_space_dim, void>
+    forEachStencilNode( const SplineDataType&, const Functor& functor )
+{
+    using unroll_type = Impl::StencilUnroll<SplineDataType::num_knot>;
+    unroll_type::apply( [&]( const int i ) {
+        unroll_type::apply( [&]( const int j ) {
+            unroll_type::apply( [&]( const int k ) { functor( i, j, k ); } );
+        } );
+    } );
+}
+
+/*!
+  \brief Apply a functor to every node of the stencil of spline data with the
+  loops over knots unrolled at compile time. 2D specialization.
+  \param functor The functor to apply. Called with the knot indices (i,j)
+  into the stencil in each dimension, with j the fastest.
+*/
+template <class SplineDataType, class Functor>
+KOKKOS_FORCEINLINE_FUNCTION
+    std::enable_if_t<2 == SplineDataType::num_space_dim, void>
+    forEachStencilNode( const SplineDataType&, const Functor& functor )
+{
+    using unroll_type = Impl::StencilUnroll<SplineDataType::num_knot>;
+    unroll_type::apply( [&]( const int i ) {
+        unroll_type::apply( [&]( const int j ) { functor( i, j ); } );
+    } );
 }
 
 //---------------------------------------------------------------------------//
@@ -0,0 +1,217 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cajita_AdaptiveMesh.hpp>
+#include <Cajita_ManualPartitioner.hpp>
+#include <Cajita_SparseArray.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <array>
+
+using namespace Cajita;
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+// Field value of a coarse cell.
+KOKKOS_INLINE_FUNCTION
+double coarseValue( const int i, const int j, const int k )
+{
+    return i + 1000.0 * j + 1000000.0 * k;
+}
+
+//---------------------------------------------------------------------------//
+// Count the cells of a level that do not match a reference function.
+template <class ArrayType, class Function>
+int countErrors( const ArrayType& array, const Function& reference )
+{
+    Kokkos::View<int, TEST_MEMSPACE> errors( "errors" );
+    auto view = array.sparseView();
+    sparse_grid_parallel_for(
+        "check", TEST_EXECSPACE(), view.map,
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            if ( view( i, j, k, 0 ) != reference( i, j, k ) )
+                Kokkos::atomic_increment( &errors() );
+        } );
+    auto errors_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), errors );
+    return errors_host();
+}
+
+//---------------------------------------------------------------------------//
+// Refine the first owned tile of the coarse level of every rank and transfer
+// data between the levels and the particles.
+void adaptiveTest( const std::array<bool, 3>& is_dim_periodic )
+{
+    // Each rank owns 2 tiles of 4 cells per dimension on the coarse level.
+    constexpr int tile_dim = 4;
+    constexpr int owned_cell = 8;
+    int comm_size;
+    MPI_Comm_size( MPI_COMM_WORLD, &comm_size );
+    std::array<int, 3> ranks_per_dim = { 0, 0, 0 };
+    MPI_Dims_create( comm_size, 3, ranks_per_dim.data() );
+    double cell_size = 0.1;
+    std::array<int, 3> global_num_cell;
+    std::array<double, 3> global_low_corner = { 0.0, 0.0, 0.0 };
+    std::array<double, 3> global_high_corner;
+    for ( int d = 0; d < 3; ++d )
+    {
+        global_num_cell[d] = owned_cell * ranks_per_dim[d];
+        global_high_corner[d] = cell_size * global_num_cell[d];
+    }
+    ManualPartitioner partitioner( ranks_per_dim );
+    auto mesh = createAdaptiveMesh<TEST_MEMSPACE, tile_dim>(
+        MPI_COMM_WORLD, global_low_corner, global_high_corner,
+        global_num_cell, is_dim_periodic, partitioner, 2 );
+    EXPECT_EQ( mesh->numLevel(), 2 );
+    EXPECT_EQ( mesh->map( 0 )->size(), 8u );
+    EXPECT_EQ( mesh->map( 1 )->size(), 0u );
+    EXPECT_DOUBLE_EQ( mesh->cellSize( 1, Dim::I ), 0.5 * cell_size );
+
+    // Refine the cells of the first owned coarse tile.
+    const auto& global_grid = mesh->localGrid( 0 )->globalGrid();
+    Kokkos::View<int* [3], Kokkos::HostSpace> cells_host(
+        "cells", tile_dim * tile_dim * tile_dim );
+    int n = 0;
+    for ( int i = 0; i < tile_dim; ++i )
+        for ( int j = 0; j < tile_dim; ++j )
+            for ( int k = 0; k < tile_dim; ++k, ++n )
+            {
+                cells_host( n, 0 ) = global_grid.globalOffset( Dim::I ) + i;
+                cells_host( n, 1 ) = global_grid.globalOffset( Dim::J ) + j;
+                cells_host( n, 2 ) = global_grid.globalOffset( Dim::K ) + k;
+            }
+    auto cells =
+        Kokkos::create_mirror_view_and_copy( TEST_MEMSPACE(), cells_host );
+    mesh->refine( TEST_EXECSPACE(), 0, cells );
+    EXPECT_EQ( mesh->map( 1 )->size(), 8u );
+
+    // Fill the coarse level and prolong it.
+    auto array = createAdaptiveArray<double, TEST_DEVICE>( "array", mesh, 1 );
+    EXPECT_EQ( array->numLevel(), 2 );
+    EXPECT_EQ( array->level( 1 ).numTile(), 8 );
+    auto coarse = array->level( 0 ).sparseView();
+    sparse_grid_parallel_for(
+        "fill", TEST_EXECSPACE(), coarse.map,
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            coarse( i, j, k, 0 ) = coarseValue( i, j, k );
+        } );
+    prolongLevel( TEST_EXECSPACE(), *array, 1 );
+    Kokkos::fence();
+    auto parent_value = KOKKOS_LAMBDA( const int i, const int j, const int k )
+    {
+        return coarseValue( i / 2, j / 2, k / 2 );
+    };
+    EXPECT_EQ( countErrors( array->level( 1 ), parent_value ), 0 );
+
+    // Fill the fine level and restrict it.
+    auto fine = array->level( 1 ).sparseView();
+    sparse_grid_parallel_for(
+        "fill", TEST_EXECSPACE(), fine.map,
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            fine( i, j, k, 0 ) = i + j + k;
+        } );
+    restrictLevel( TEST_EXECSPACE(), *array, 1 );
+    Kokkos::fence();
+
+    // The first tile of the block of every rank is refined. The blocks start
+    // at multiples of the owned cells.
+    auto restricted_value =
+        KOKKOS_LAMBDA( const int i, const int j, const int k )
+    {
+        bool refined = ( i % owned_cell < tile_dim ) &&
+                       ( j % owned_cell < tile_dim ) &&
+                       ( k % owned_cell < tile_dim );
+        return refined ? 2.0 * ( i + j + k ) + 1.5 : coarseValue( i, j, k );
+    };
+    auto fine_value = KOKKOS_LAMBDA( const int i, const int j, const int k )
+    {
+        return 1.0 * ( i + j + k );
+    };
+    EXPECT_EQ( countErrors( array->level( 0 ), restricted_value ), 0 );
+
+    // Gather the ghost tiles of both levels.
+    auto halo = createAdaptiveHalo( *array );
+    halo->gather( TEST_EXECSPACE(), *array );
+    EXPECT_GE( mesh->map( 0 )->size(), 8u );
+    EXPECT_GE( mesh->map( 1 )->size(), 8u );
+    EXPECT_EQ( countErrors( array->level( 0 ), restricted_value ), 0 );
+    EXPECT_EQ( countErrors( array->level( 1 ), fine_value ), 0 );
+
+    // Put a particle at the center of every owned coarse cell and deposit
+    // them.
+    int num_p = owned_cell * owned_cell * owned_cell;
+    Kokkos::View<double* [3], Kokkos::HostSpace> positions_host( "positions",
+                                                                num_p );
+    int p = 0;
+    for ( int i = 0; i < owned_cell; ++i )
+        for ( int j = 0; j < owned_cell; ++j )
+            for ( int k = 0; k < owned_cell; ++k, ++p )
+            {
+                std::array<int, 3> c = { i, j, k };
+                for ( int d = 0; d < 3; ++d )
+                    positions_host( p, d ) =
+                        ( global_grid.globalOffset( d ) + c[d] + 0.5 ) *
+                        cell_size;
+            }
+    auto positions =
+        Kokkos::create_mirror_view_and_copy( TEST_MEMSPACE(), positions_host );
+    Kokkos::View<double*, TEST_MEMSPACE> values( "values", num_p );
+    Kokkos::deep_copy( values, 1.0 );
+    for ( int l = 0; l < 2; ++l )
+        Kokkos::deep_copy( array->level( l ).view(), 0.0 );
+    adaptiveP2G( TEST_EXECSPACE(), positions, values, *array );
+    Kokkos::fence();
+
+    // Particles in the refined tile deposit on the fine level.
+    Kokkos::View<int[2], TEST_MEMSPACE> count( "count" );
+    for ( int l = 0; l < 2; ++l )
+    {
+        auto level = array->level( l ).sparseView();
+        sparse_grid_parallel_for(
+            "count", TEST_EXECSPACE(), level.map,
+            KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+                if ( level( i, j, k, 0 ) == 1.0 )
+                    Kokkos::atomic_increment( &count( l ) );
+            } );
+    }
+    auto count_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), count );
+    int num_refined = tile_dim * tile_dim * tile_dim;
+    EXPECT_EQ( count_host( 0 ), num_p - num_refined );
+    EXPECT_EQ( count_host( 1 ), num_refined );
+
+    // Interpolate back.
+    Kokkos::deep_copy( values, 0.0 );
+    adaptiveG2P( TEST_EXECSPACE(), *array, positions, values );
+    auto values_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), values );
+    for ( p = 0; p < num_p; ++p )
+        EXPECT_EQ( values_host( p ), 1.0 );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, adaptive_mesh_test )
+{
+    adaptiveTest( { false, false, false } );
+    adaptiveTest( { true, true, true } );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
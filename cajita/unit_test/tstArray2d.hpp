@@ -386,6 +386,45 @@ void arrayOpTest()
             for ( long l = 0; l < ghosted_space.extent( 2 ); ++l )
                 EXPECT_EQ( host_view( i, j, l ),
                            ( 3.0 + 1.0 + 6.0 ) * scales[l] );
+
+#ifndef KOKKOS_ENABLE_OPENMPTARGET // FIXME_OPENMPTARGET
+    // Fused update and dot product.
+    ArrayOp::updateAndDot( *array, 1.0, *array_2, 2.0, *array_3, dots );
+    for ( int n = 0; n < dofs_per_cell; ++n )
+        EXPECT_FLOAT_EQ( dots[n],
+                         16.5 * scales[n] * scales[n] * total_num_cell );
+
+    // Two dot products in one pass.
+    std::vector<double> dots_2( dofs_per_cell );
+    ArrayOp::dot( *array, *array_2, *array_3, *array_3, dots, dots_2 );
+    for ( int n = 0; n < dofs_per_cell; ++n )
+    {
+        EXPECT_FLOAT_EQ( dots[n],
+                         5.5 * scales[n] * scales[n] * total_num_cell );
+        EXPECT_FLOAT_EQ( dots_2[n],
+                         2.25 * scales[n] * scales[n] * total_num_cell );
+    }
+
+    // Fused update and two-norm.
+    ArrayOp::updateAndNorm2( *array, 0.0, *array_3, 2.0, norm_2 );
+    for ( int n = 0; n < dofs_per_cell; ++n )
+        EXPECT_FLOAT_EQ( norm_2[n], 3.0 * fabs( scales[n] ) *
+                                        std::sqrt( total_num_cell ) );
+
+    // Non-blocking reductions.
+    auto dot_request = ArrayOp::dotStart( *array, *array_3 );
+    auto norm_request = ArrayOp::norm2Start( *array );
+    norm_request.wait();
+    EXPECT_FALSE( norm_request.active() );
+    EXPECT_TRUE( norm_request.test() );
+    const auto& dot_values = dot_request.wait();
+    for ( int n = 0; n < dofs_per_cell; ++n )
+    {
+        EXPECT_FLOAT_EQ( dot_values[n],
+                         4.5 * scales[n] * scales[n] * total_num_cell );
+        EXPECT_FLOAT_EQ( norm_request.values()[n], norm_2[n] );
+    }
+#endif
 }
 
 //---------------------------------------------------------------------------//
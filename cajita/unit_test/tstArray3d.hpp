@@ -220,6 +220,22 @@ void arrayTest()
     EXPECT_EQ( view.size(), space.size() );
     for ( int i = 0; i < 4; ++i )
         EXPECT_EQ( view.extent( i ), space.extent( i ) );
+    EXPECT_FALSE( array->dofsOutermost() );
+
+    // Create an array storing the degrees of freedom outermost and check
+    // that each degree of freedom is stored contiguously.
+    auto outer_array =
+        createArray<double, DofOutermost, TEST_DEVICE>( label, cell_layout );
+    EXPECT_TRUE( outer_array->dofsOutermost() );
+    auto outer_view = outer_array->view();
+    EXPECT_EQ( outer_view.size(), space.size() );
+    for ( int i = 0; i < 4; ++i )
+        EXPECT_EQ( outer_view.extent( i ), space.extent( i ) );
+    EXPECT_EQ( outer_view.stride( 2 ), 1 );
+    EXPECT_EQ( outer_view.stride( 1 ), space.extent( 2 ) );
+    EXPECT_EQ( outer_view.stride( 0 ), space.extent( 1 ) * space.extent( 2 ) );
+    EXPECT_EQ( outer_view.stride( 3 ),
+               space.extent( 0 ) * space.extent( 1 ) * space.extent( 2 ) );
 }
 
 //---------------------------------------------------------------------------//
@@ -406,6 +422,45 @@ void arrayOpTest()
                 for ( long l = 0; l < ghosted_space.extent( 3 ); ++l )
                     EXPECT_EQ( host_view( i, j, k, l ),
                                ( 3.0 + 1.0 + 6.0 ) * scales[l] );
+
+#ifndef KOKKOS_ENABLE_OPENMPTARGET // FIXME_OPENMPTARGET
+    // Fused update and dot product.
+    ArrayOp::updateAndDot( *array, 1.0, *array_2, 2.0, *array_3, dots );
+    for ( int n = 0; n < dofs_per_cell; ++n )
+        EXPECT_FLOAT_EQ( dots[n],
+                         16.5 * scales[n] * scales[n] * total_num_cell );
+
+    // Two dot products in one pass.
+    std::vector<double> dots_2( dofs_per_cell );
+    ArrayOp::dot( *array, *array_2, *array_3, *array_3, dots, dots_2 );
+    for ( int n = 0; n < dofs_per_cell; ++n )
+    {
+        EXPECT_FLOAT_EQ( dots[n],
+                         5.5 * scales[n] * scales[n] * total_num_cell );
+        EXPECT_FLOAT_EQ( dots_2[n],
+                         2.25 * scales[n] * scales[n] * total_num_cell );
+    }
+
+    // Fused update and two-norm.
+    ArrayOp::updateAndNorm2( *array, 0.0, *array_3, 2.0, norm_2 );
+    for ( int n = 0; n < dofs_per_cell; ++n )
+        EXPECT_FLOAT_EQ( norm_2[n], 3.0 * fabs( scales[n] ) *
+                                        std::sqrt( total_num_cell ) );
+
+    // Non-blocking reductions.
+    auto dot_request = ArrayOp::dotStart( *array, *array_3 );
+    auto norm_request = ArrayOp::norm2Start( *array );
+    norm_request.wait();
+    EXPECT_FALSE( norm_request.active() );
+    EXPECT_TRUE( norm_request.test() );
+    const auto& dot_values = dot_request.wait();
+    for ( int n = 0; n < dofs_per_cell; ++n )
+    {
+        EXPECT_FLOAT_EQ( dot_values[n],
+                         4.5 * scales[n] * scales[n] * total_num_cell );
+        EXPECT_FLOAT_EQ( norm_request.values()[n], norm_2[n] );
+    }
+#endif
 }
 
 //---------------------------------------------------------------------------//
@@ -27,7 +27,9 @@
 #include <array>
 #include <cmath>
 #include <fstream>
+#include <iterator>
 #include <memory>
+#include <string>
 
 using namespace Cajita;
 
@@ -117,12 +119,40 @@ void writeTest3d()
         // Write the fields to a file.
         Experimental::BovWriter::writeTimeStep( 302, 3.43, *cell_field );
         Experimental::BovWriter::writeTimeStep( 1972, 12.457, *node_field );
+
+        // Write the same fields in the background. The fields may be changed
+        // as soon as each write returns.
+        Experimental::BovWriter::AsyncWriter writer( 1 );
+        writer.writeTimeStep( 303, 3.43, *cell_field );
+        writer.writeTimeStep( 1973, 12.457, *node_field );
+        ArrayOp::assign( *cell_field, 0.0, Ghost() );
+        writer.wait();
     }
     // Read the data back in on rank 0 and make sure it is OK.
     int rank;
     MPI_Comm_rank( MPI_COMM_WORLD, &rank );
     if ( 0 == rank )
     {
+        // The background writes match the direct writes.
+        for ( auto files : { std::array<std::string, 2>{
+                                 "grid_cell_field_3d_000302.dat",
+                                 "grid_cell_field_3d_000303.dat" },
+                             std::array<std::string, 2>{
+                                 "grid_node_field_3d_001972.dat",
+                                 "grid_node_field_3d_001973.dat" } } )
+        {
+            std::ifstream direct( files[0], std::ios::binary );
+            std::ifstream async( files[1], std::ios::binary );
+            std::string direct_data(
+                ( std::istreambuf_iterator<char>( direct ) ),
+                std::istreambuf_iterator<char>() );
+            std::string async_data(
+                ( std::istreambuf_iterator<char>( async ) ),
+                std::istreambuf_iterator<char>() );
+            EXPECT_FALSE( direct_data.empty() );
+            EXPECT_EQ( direct_data, async_data );
+        }
+
         // Open the cell file.
         std::fstream cell_data_file;
         cell_data_file.open( "grid_cell_field_3d_000302.dat",
@@ -0,0 +1,98 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cajita_Array.hpp>
+#include <Cajita_Checkpoint.hpp>
+#include <Cajita_GlobalGrid.hpp>
+#include <Cajita_GlobalMesh.hpp>
+#include <Cajita_Partitioner.hpp>
+#include <Cajita_Types.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <array>
+#include <stdexcept>
+#include <string>
+
+using namespace Cajita;
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+void checkpointTest()
+{
+    // Create the global grid.
+    DimBlockPartitioner<3> partitioner;
+    double cell_size = 0.23;
+    std::array<int, 3> global_num_cell = { 17, 12, 9 };
+    std::array<double, 3> global_low_corner = { 1.2, 3.3, -2.8 };
+    std::array<double, 3> global_high_corner = {
+        global_low_corner[0] + cell_size * global_num_cell[0],
+        global_low_corner[1] + cell_size * global_num_cell[1],
+        global_low_corner[2] + cell_size * global_num_cell[2] };
+    std::array<bool, 3> is_dim_periodic = { true, true, true };
+    auto global_mesh = createUniformGlobalMesh(
+        global_low_corner, global_high_corner, global_num_cell );
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+
+    // Fill a node array including its ghosts.
+    auto layout = createArrayLayout( global_grid, 1, 3, Node() );
+    auto array = createArray<double, TEST_DEVICE>( "array", layout );
+    auto host_view = Kokkos::create_mirror_view( array->view() );
+    for ( std::size_t i = 0; i < host_view.extent( 0 ); ++i )
+        for ( std::size_t j = 0; j < host_view.extent( 1 ); ++j )
+            for ( std::size_t k = 0; k < host_view.extent( 2 ); ++k )
+                for ( std::size_t d = 0; d < host_view.extent( 3 ); ++d )
+                    host_view( i, j, k, d ) = i + 0.1 * j + 0.01 * k - d;
+    Kokkos::deep_copy( array->view(), host_view );
+
+    std::string path = "cajita_checkpoint_test_" +
+                       std::to_string( global_grid->blockId() ) + ".bin";
+    Cajita::checkpoint( *array, path );
+
+    // Restart into a new array on the same layout.
+    auto restart = createArray<double, TEST_DEVICE>( "restart", layout );
+    Cajita::restart( *restart, path );
+    auto restart_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), restart->view() );
+    for ( std::size_t i = 0; i < host_view.extent( 0 ); ++i )
+        for ( std::size_t j = 0; j < host_view.extent( 1 ); ++j )
+            for ( std::size_t k = 0; k < host_view.extent( 2 ); ++k )
+                for ( std::size_t d = 0; d < host_view.extent( 3 ); ++d )
+                    EXPECT_DOUBLE_EQ( restart_host( i, j, k, d ),
+                                      host_view( i, j, k, d ) );
+
+    // Restarting with a different layout or value type must fail.
+    auto wrong_layout = createArrayLayout( global_grid, 1, 2, Node() );
+    auto wrong_dofs =
+        createArray<double, TEST_DEVICE>( "wrong_dofs", wrong_layout );
+    EXPECT_THROW( Cajita::restart( *wrong_dofs, path ), std::runtime_error );
+    auto wrong_type = createArray<float, TEST_DEVICE>( "wrong_type", layout );
+    EXPECT_THROW( Cajita::restart( *wrong_type, path ), std::runtime_error );
+
+    // Missing files must fail.
+    EXPECT_THROW( Cajita::restart( *restart, "no_such_checkpoint.bin" ),
+                  std::runtime_error );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, checkpoint_test ) { checkpointTest(); }
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
@@ -0,0 +1,154 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cajita_Array.hpp>
+#include <Cajita_ConduitBlueprint.hpp>
+#include <Cajita_GlobalGrid.hpp>
+#include <Cajita_GlobalMesh.hpp>
+#include <Cajita_IndexSpace.hpp>
+#include <Cajita_Partitioner.hpp>
+#include <Cajita_Types.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <conduit.hpp>
+#include <conduit_blueprint.hpp>
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <array>
+
+using namespace Cajita;
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+template <class EntityType, class ArrayLayoutType>
+void checkArrayFields( const ArrayLayoutType& layout )
+{
+    using Experimental::ConduitBlueprint::createArrayAdapter;
+
+    // Fill an interleaved and a blocked array with their local indices.
+    auto inner = createArray<double, Kokkos::HostSpace>( "inner", layout );
+    auto outer = createArray<double, DofOutermost, Kokkos::HostSpace>(
+        "outer", layout );
+    auto space = layout->indexSpace( Ghost(), Local() );
+    auto inner_view = inner->view();
+    auto outer_view = outer->view();
+    for ( int i = 0; i < space.extent( Dim::I ); ++i )
+        for ( int j = 0; j < space.extent( Dim::J ); ++j )
+            for ( int k = 0; k < space.extent( Dim::K ); ++k )
+                for ( int n = 0; n < space.extent( 3 ); ++n )
+                {
+                    double value = ( ( i * 100 + j ) * 100 + k ) * 10 + n;
+                    inner_view( i, j, k, n ) = value;
+                    outer_view( i, j, k, n ) = -value;
+                }
+
+    auto adapter = createArrayAdapter<Kokkos::HostSpace>( layout );
+    conduit::Node mesh;
+    adapter->publish( mesh, *inner, *outer );
+
+    conduit::Node info;
+    EXPECT_TRUE( conduit::blueprint::mesh::verify( mesh, info ) );
+
+    // Entities are numbered in LayoutRight order over the ghosted block.
+    std::string association =
+        std::is_same<EntityType, Cell>::value ? "element" : "vertex";
+    EXPECT_EQ( mesh["fields/inner/association"].as_string(), association );
+    for ( int n = 0; n < space.extent( 3 ); ++n )
+    {
+        auto inner_values =
+            mesh["fields/inner/values/" + std::to_string( n )]
+                .as_float64_array();
+        auto outer_values =
+            mesh["fields/outer/values/" + std::to_string( n )]
+                .as_float64_array();
+        int e = 0;
+        for ( int i = 0; i < space.extent( Dim::I ); ++i )
+            for ( int j = 0; j < space.extent( Dim::J ); ++j )
+                for ( int k = 0; k < space.extent( Dim::K ); ++k, ++e )
+                {
+                    EXPECT_EQ( inner_values[e], inner_view( i, j, k, n ) );
+                    EXPECT_EQ( outer_values[e], outer_view( i, j, k, n ) );
+                }
+    }
+
+    // Owned elements are not flagged as ghosts.
+    auto own_space =
+        layout->localGrid()->indexSpace( Own(), EntityType(), Local() );
+    auto ghosts = mesh["fields/ascent_ghosts/values"].as_int_array();
+    long num_owned = 0;
+    for ( long e = 0; e < ghosts.number_of_elements(); ++e )
+        if ( 0 == ghosts[e] )
+            ++num_owned;
+    if ( std::is_same<EntityType, Cell>::value )
+        EXPECT_EQ( num_owned, own_space.size() );
+}
+
+//---------------------------------------------------------------------------//
+void blueprintTest()
+{
+    // Create the global mesh.
+    std::array<int, 3> global_num_cell = { 10, 6, 8 };
+    std::array<double, 3> global_low_corner = { 0.0, -1.0, 2.0 };
+    std::array<double, 3> global_high_corner = { 1.0, 0.2, 2.8 };
+    auto global_mesh = createUniformGlobalMesh(
+        global_low_corner, global_high_corner, global_num_cell );
+
+    // Create the global grid.
+    DimBlockPartitioner<3> partitioner;
+    std::array<bool, 3> is_dim_periodic = { true, false, true };
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+    auto local_grid = createLocalGrid( global_grid, 1 );
+
+    checkArrayFields<Cell>( createArrayLayout( local_grid, 3, Cell() ) );
+    checkArrayFields<Node>( createArrayLayout( local_grid, 2, Node() ) );
+
+    // Check the vertex coordinates of a cell mesh against the local mesh.
+    auto layout = createArrayLayout( local_grid, 1, Cell() );
+    auto adapter =
+        Experimental::ConduitBlueprint::createArrayAdapter<Kokkos::HostSpace>(
+            layout );
+    conduit::Node mesh;
+    adapter->publish( mesh );
+    auto local_mesh = createLocalMesh<Kokkos::HostSpace>( *local_grid );
+    auto cell_space = local_grid->indexSpace( Ghost(), Cell(), Local() );
+    const char* axes[3] = { "x", "y", "z" };
+    for ( int d = 0; d < 3; ++d )
+    {
+        auto coords = mesh[std::string( "coordsets/grid_coords/values/" ) +
+                           axes[d]]
+                          .as_float64_array();
+        int v = 0;
+        for ( int i = 0; i <= cell_space.extent( Dim::I ); ++i )
+            for ( int j = 0; j <= cell_space.extent( Dim::J ); ++j )
+                for ( int k = 0; k <= cell_space.extent( Dim::K ); ++k, ++v )
+                {
+                    int index[3] = { i, j, k };
+                    double x[3];
+                    local_mesh.coordinates( Node(), index, x );
+                    EXPECT_DOUBLE_EQ( coords[v], x[d] );
+                }
+    }
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, blueprint_array_test ) { blueprintTest(); }
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
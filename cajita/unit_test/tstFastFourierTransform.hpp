@@ -22,7 +22,10 @@
 
 #include <gtest/gtest.h>
 
+#include <mpi.h>
+
 #include <array>
+#include <cmath>
 #include <type_traits>
 #include <vector>
 
@@ -226,6 +229,303 @@ void forwardReverseTest2d( bool use_default, bool use_params )
         }
 }
 
+//---------------------------------------------------------------------------//
+void spectralPencilTest3d()
+{
+    // Create the global mesh.
+    double cell_size = 0.1;
+    std::array<bool, 3> is_dim_periodic = { true, true, true };
+    std::array<double, 3> global_low_corner = { -1.0, -2.0, -1.0 };
+    std::array<double, 3> global_high_corner = { 1.0, 1.0, 0.5 };
+    auto global_mesh = createUniformGlobalMesh( global_low_corner,
+                                                global_high_corner, cell_size );
+
+    // Create the global grid.
+    DimBlockPartitioner<3> partitioner;
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+
+    // Create a local grid.
+    auto local_grid = createLocalGrid( global_grid, 0 );
+    auto owned_space = local_grid->indexSpace( Own(), Cell(), Local() );
+    auto global_space = local_grid->indexSpace( Own(), Cell(), Global() );
+
+    // Fill a vector from its global indices.
+    auto vector_layout = createArrayLayout( local_grid, 2, Cell() );
+    auto lhs = createArray<double, TEST_DEVICE>( "lhs", vector_layout );
+    auto lhs_host_view = Kokkos::create_mirror_view( lhs->view() );
+    for ( int i = 0; i < owned_space.extent( Dim::I ); ++i )
+        for ( int j = 0; j < owned_space.extent( Dim::J ); ++j )
+            for ( int k = 0; k < owned_space.extent( Dim::K ); ++k )
+            {
+                int il = i + owned_space.min( Dim::I );
+                int jl = j + owned_space.min( Dim::J );
+                int kl = k + owned_space.min( Dim::K );
+                lhs_host_view( il, jl, kl, 0 ) =
+                    i + global_space.min( Dim::I ) + 0.5;
+                lhs_host_view( il, jl, kl, 1 ) =
+                    j + global_space.min( Dim::J ) -
+                    2.0 * ( k + global_space.min( Dim::K ) );
+            }
+    Kokkos::deep_copy( lhs->view(), lhs_host_view );
+
+    Experimental::FastFourierTransformParams params;
+    params.setSpectralPencils( true );
+    auto fft =
+        Experimental::createHeffteFastFourierTransform<double, TEST_DEVICE>(
+            *vector_layout, params );
+
+    // The spectral data holds full pencils along K and covers the grid.
+    auto spectral_space = fft->spectralIndexSpace();
+    EXPECT_EQ( spectral_space.min( Dim::K ), 0 );
+    EXPECT_EQ( spectral_space.max( Dim::K ),
+               global_grid->globalNumEntity( Cell(), Dim::K ) );
+    long spectral_size = spectral_space.size();
+    long total_size = 0;
+    MPI_Allreduce( &spectral_size, &total_size, 1, MPI_LONG, MPI_SUM,
+                   MPI_COMM_WORLD );
+    long global_size = 1;
+    for ( int d = 0; d < 3; ++d )
+        global_size *= global_grid->globalNumEntity( Cell(), d );
+    EXPECT_EQ( total_size, global_size );
+
+    // Transform into the spectral data, scale it there, and transform back.
+    fft->forwardToSpectral( *lhs, Experimental::FFTScaleFull() );
+    auto spectral = fft->spectralView();
+    EXPECT_EQ( spectral.extent( 0 ), spectral_space.extent( Dim::I ) );
+    EXPECT_EQ( spectral.extent( 1 ), spectral_space.extent( Dim::J ) );
+    EXPECT_EQ( spectral.extent( 2 ), spectral_space.extent( Dim::K ) );
+    Kokkos::parallel_for(
+        "scale_spectral",
+        Kokkos::RangePolicy<TEST_EXECSPACE>( 0, spectral.span() ),
+        KOKKOS_LAMBDA( const int n ) { spectral.data()[n] *= 2.0; } );
+    Kokkos::deep_copy( lhs->view(), 0.0 );
+    fft->reverseFromSpectral( *lhs, Experimental::FFTScaleNone() );
+
+    // Check the results.
+    auto lhs_result =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), lhs->view() );
+    for ( int i = owned_space.min( Dim::I ); i < owned_space.max( Dim::I );
+          ++i )
+        for ( int j = owned_space.min( Dim::J ); j < owned_space.max( Dim::J );
+              ++j )
+            for ( int k = owned_space.min( Dim::K );
+                  k < owned_space.max( Dim::K ); ++k )
+            {
+                EXPECT_NEAR( 2.0 * lhs_host_view( i, j, k, 0 ),
+                             lhs_result( i, j, k, 0 ), 1.0e-10 );
+                EXPECT_NEAR( 2.0 * lhs_host_view( i, j, k, 1 ),
+                             lhs_result( i, j, k, 1 ), 1.0e-10 );
+            }
+
+    // The in-place transforms are unaffected.
+    Kokkos::deep_copy( lhs->view(), lhs_host_view );
+    fft->forward( *lhs, Experimental::FFTScaleFull() );
+    fft->reverse( *lhs, Experimental::FFTScaleNone() );
+    Kokkos::deep_copy( lhs_result, lhs->view() );
+    for ( int i = owned_space.min( Dim::I ); i < owned_space.max( Dim::I );
+          ++i )
+        for ( int j = owned_space.min( Dim::J ); j < owned_space.max( Dim::J );
+              ++j )
+            for ( int k = owned_space.min( Dim::K );
+                  k < owned_space.max( Dim::K ); ++k )
+            {
+                EXPECT_NEAR( lhs_host_view( i, j, k, 0 ),
+                             lhs_result( i, j, k, 0 ), 1.0e-10 );
+                EXPECT_NEAR( lhs_host_view( i, j, k, 1 ),
+                             lhs_result( i, j, k, 1 ), 1.0e-10 );
+            }
+}
+
+//---------------------------------------------------------------------------//
+void batchTest3d()
+{
+    // Create the global mesh.
+    double cell_size = 0.1;
+    std::array<bool, 3> is_dim_periodic = { true, true, true };
+    std::array<double, 3> global_low_corner = { -1.0, -2.0, -1.0 };
+    std::array<double, 3> global_high_corner = { 1.0, 1.0, 0.5 };
+    auto global_mesh = createUniformGlobalMesh( global_low_corner,
+                                                global_high_corner, cell_size );
+
+    // Create the global grid.
+    DimBlockPartitioner<3> partitioner;
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+
+    // Create a local grid.
+    auto local_grid = createLocalGrid( global_grid, 0 );
+    auto owned_space = local_grid->indexSpace( Own(), Cell(), Local() );
+    auto global_space = local_grid->indexSpace( Own(), Cell(), Global() );
+
+    // Create three complex fields in one array and each field on its own.
+    const int num_field = 3;
+    auto batch_layout = createArrayLayout( local_grid, 2 * num_field, Cell() );
+    auto batch = createArray<double, TEST_DEVICE>( "batch", batch_layout );
+    auto batch_host = Kokkos::create_mirror_view( batch->view() );
+    auto field_layout = createArrayLayout( local_grid, 2, Cell() );
+    using field_type =
+        decltype( createArray<double, TEST_DEVICE>( "field", field_layout ) );
+    std::vector<field_type> fields( num_field );
+    for ( int f = 0; f < num_field; ++f )
+    {
+        fields[f] = createArray<double, TEST_DEVICE>( "field", field_layout );
+        auto field_host = Kokkos::create_mirror_view( fields[f]->view() );
+        for ( int i = owned_space.min( Dim::I ); i < owned_space.max( Dim::I );
+              ++i )
+            for ( int j = owned_space.min( Dim::J );
+                  j < owned_space.max( Dim::J ); ++j )
+                for ( int k = owned_space.min( Dim::K );
+                      k < owned_space.max( Dim::K ); ++k )
+                {
+                    int gi = i - owned_space.min( Dim::I ) +
+                             global_space.min( Dim::I );
+                    int gj = j - owned_space.min( Dim::J ) +
+                             global_space.min( Dim::J );
+                    int gk = k - owned_space.min( Dim::K ) +
+                             global_space.min( Dim::K );
+                    field_host( i, j, k, 0 ) = ( f + 1 ) * gi - gk + 0.25;
+                    field_host( i, j, k, 1 ) = gj * gk - f;
+                    batch_host( i, j, k, 2 * f ) = field_host( i, j, k, 0 );
+                    batch_host( i, j, k, 2 * f + 1 ) =
+                        field_host( i, j, k, 1 );
+                }
+        Kokkos::deep_copy( fields[f]->view(), field_host );
+    }
+    Kokkos::deep_copy( batch->view(), batch_host );
+
+    // One transform handles the whole batch.
+    auto fft =
+        Experimental::createHeffteFastFourierTransform<double, TEST_DEVICE>(
+            *field_layout );
+    fft->forward( *batch, Experimental::FFTScaleFull() );
+    for ( int f = 0; f < num_field; ++f )
+        fft->forward( *fields[f], Experimental::FFTScaleFull() );
+
+    // Each batched field matches its separate transform.
+    auto batch_result = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), batch->view() );
+    for ( int f = 0; f < num_field; ++f )
+    {
+        auto field_result = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), fields[f]->view() );
+        for ( int i = owned_space.min( Dim::I ); i < owned_space.max( Dim::I );
+              ++i )
+            for ( int j = owned_space.min( Dim::J );
+                  j < owned_space.max( Dim::J ); ++j )
+                for ( int k = owned_space.min( Dim::K );
+                      k < owned_space.max( Dim::K ); ++k )
+                {
+                    EXPECT_NEAR( batch_result( i, j, k, 2 * f ),
+                                 field_result( i, j, k, 0 ), 1.0e-10 );
+                    EXPECT_NEAR( batch_result( i, j, k, 2 * f + 1 ),
+                                 field_result( i, j, k, 1 ), 1.0e-10 );
+                }
+    }
+
+    // The reverse batch recovers the fields.
+    fft->reverse( *batch, Experimental::FFTScaleNone() );
+    Kokkos::deep_copy( batch_result, batch->view() );
+    for ( int i = owned_space.min( Dim::I ); i < owned_space.max( Dim::I );
+          ++i )
+        for ( int j = owned_space.min( Dim::J ); j < owned_space.max( Dim::J );
+              ++j )
+            for ( int k = owned_space.min( Dim::K );
+                  k < owned_space.max( Dim::K ); ++k )
+                for ( int n = 0; n < 2 * num_field; ++n )
+                    EXPECT_NEAR( batch_host( i, j, k, n ),
+                                 batch_result( i, j, k, n ), 1.0e-8 );
+}
+
+//---------------------------------------------------------------------------//
+void realToComplexTest3d()
+{
+    // Create the global mesh.
+    double cell_size = 0.1;
+    std::array<bool, 3> is_dim_periodic = { true, true, true };
+    std::array<double, 3> global_low_corner = { -1.0, -2.0, -1.0 };
+    std::array<double, 3> global_high_corner = { 1.0, 1.0, 0.5 };
+    auto global_mesh = createUniformGlobalMesh( global_low_corner,
+                                                global_high_corner, cell_size );
+
+    // Create the global grid.
+    DimBlockPartitioner<3> partitioner;
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+
+    // Create a local grid.
+    auto local_grid = createLocalGrid( global_grid, 0 );
+    auto owned_space = local_grid->indexSpace( Own(), Cell(), Local() );
+    auto global_space = local_grid->indexSpace( Own(), Cell(), Global() );
+
+    // Create a real scalar field.
+    auto scalar_layout = createArrayLayout( local_grid, 1, Cell() );
+    auto rhs = createArray<double, TEST_DEVICE>( "rhs", scalar_layout );
+    auto rhs_host = Kokkos::create_mirror_view( rhs->view() );
+    double local_sum = 0.0;
+    for ( int i = owned_space.min( Dim::I ); i < owned_space.max( Dim::I );
+          ++i )
+        for ( int j = owned_space.min( Dim::J ); j < owned_space.max( Dim::J );
+              ++j )
+            for ( int k = owned_space.min( Dim::K );
+                  k < owned_space.max( Dim::K ); ++k )
+            {
+                int gi =
+                    i - owned_space.min( Dim::I ) + global_space.min( Dim::I );
+                int gk =
+                    k - owned_space.min( Dim::K ) + global_space.min( Dim::K );
+                rhs_host( i, j, k, 0 ) = 0.5 * gi - gk * j + 1.0;
+                local_sum += rhs_host( i, j, k, 0 );
+            }
+    Kokkos::deep_copy( rhs->view(), rhs_host );
+    double global_sum = 0.0;
+    MPI_Allreduce( &local_sum, &global_sum, 1, MPI_DOUBLE, MPI_SUM,
+                   MPI_COMM_WORLD );
+
+    auto fft =
+        Experimental::createHeffteRealFastFourierTransform<double, TEST_DEVICE>(
+            *scalar_layout );
+
+    // The ranks share the half spectrum along K.
+    std::array<long, 3> num_cell;
+    for ( int d = 0; d < 3; ++d )
+        num_cell[d] = global_grid->globalNumEntity( Cell(), d );
+    auto spectral_space = fft->spectralIndexSpace();
+    long spectral_size = spectral_space.size();
+    long total_size = 0;
+    MPI_Allreduce( &spectral_size, &total_size, 1, MPI_LONG, MPI_SUM,
+                   MPI_COMM_WORLD );
+    EXPECT_EQ( total_size,
+               num_cell[0] * num_cell[1] * ( num_cell[2] / 2 + 1 ) );
+
+    // The unscaled zero mode is the sum of the field.
+    fft->forward( *rhs, Experimental::FFTScaleNone() );
+    auto spectral = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), fft->spectralView() );
+    if ( spectral_space.size() > 0 && spectral_space.min( Dim::I ) == 0 &&
+         spectral_space.min( Dim::J ) == 0 &&
+         spectral_space.min( Dim::K ) == 0 )
+    {
+        EXPECT_NEAR( spectral( 0, 0, 0, 0 ), global_sum,
+                     1.0e-10 * std::abs( global_sum ) + 1.0e-10 );
+        EXPECT_NEAR( spectral( 0, 0, 0, 1 ), 0.0, 1.0e-8 );
+    }
+
+    // The round trip recovers the field.
+    Kokkos::deep_copy( rhs->view(), 0.0 );
+    fft->reverse( *rhs, Experimental::FFTScaleFull() );
+    auto rhs_result =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), rhs->view() );
+    for ( int i = owned_space.min( Dim::I ); i < owned_space.max( Dim::I );
+          ++i )
+        for ( int j = owned_space.min( Dim::J ); j < owned_space.max( Dim::J );
+              ++j )
+            for ( int k = owned_space.min( Dim::K );
+                  k < owned_space.max( Dim::K ); ++k )
+                EXPECT_NEAR( rhs_host( i, j, k, 0 ), rhs_result( i, j, k, 0 ),
+                             1.0e-8 );
+}
+
 //---------------------------------------------------------------------------//
 // RUN TESTS
 //---------------------------------------------------------------------------//
@@ -260,6 +560,18 @@ TEST( fast_fourier_transform, forward_reverse_2d_test )
     forwardReverseTest2d<Experimental::FFTBackendMKL>( false, false );
 #endif
 }
+
+TEST( fast_fourier_transform, spectral_pencil_3d_test )
+{
+    spectralPencilTest3d();
+}
+
+TEST( fast_fourier_transform, batch_3d_test ) { batchTest3d(); }
+
+TEST( fast_fourier_transform, real_to_complex_3d_test )
+{
+    realToComplexTest3d();
+}
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
@@ -185,6 +185,14 @@ void gridTest3d( const std::array<bool, 3>& is_dim_periodic )
             dim_sum += dim_cells_per_rank[n];
         EXPECT_EQ( global_grid->globalOffset( d ), dim_offset );
         EXPECT_EQ( global_grid->globalNumEntity( Cell(), d ), dim_sum );
+
+        // Check the lazily computed offset table.
+        const auto& offsets = global_grid->blockOffsets( d );
+        EXPECT_EQ( offsets.size(), dim_cells_per_rank.size() + 1 );
+        for ( int n = 0; n < global_grid->dimNumBlock( d ); ++n )
+            EXPECT_EQ( offsets[n + 1] - offsets[n], dim_cells_per_rank[n] );
+        EXPECT_EQ( offsets[global_grid->dimBlockId( d )], dim_offset );
+        EXPECT_EQ( offsets.back(), dim_sum );
     }
 
     // Check block ranks
@@ -332,6 +340,14 @@ void gridTest2d( const std::array<bool, 2>& is_dim_periodic )
             dim_sum += dim_cells_per_rank[n];
         EXPECT_EQ( global_grid->globalOffset( d ), dim_offset );
         EXPECT_EQ( global_grid->globalNumEntity( Cell(), d ), dim_sum );
+
+        // Check the lazily computed offset table.
+        const auto& offsets = global_grid->blockOffsets( d );
+        EXPECT_EQ( offsets.size(), dim_cells_per_rank.size() + 1 );
+        for ( int n = 0; n < global_grid->dimNumBlock( d ); ++n )
+            EXPECT_EQ( offsets[n + 1] - offsets[n], dim_cells_per_rank[n] );
+        EXPECT_EQ( offsets[global_grid->dimBlockId( d )], dim_offset );
+        EXPECT_EQ( offsets.back(), dim_sum );
     }
 
     // Check block ranks
@@ -368,6 +384,54 @@ void gridTest2d( const std::array<bool, 2>& is_dim_periodic )
             -1 );
 }
 
+//---------------------------------------------------------------------------//
+void nodeAwareTest()
+{
+    UniformDimPartitioner partitioner;
+    std::array<int, 3> global_num_cell = { 47, 38, 53 };
+    std::array<double, 3> global_low_corner = { 1.2, 3.3, -2.8 };
+    std::array<double, 3> global_high_corner = { 2.3, 4.8, 1.2 };
+    auto global_mesh = createUniformGlobalMesh(
+        global_low_corner, global_high_corner, global_num_cell );
+    std::array<bool, 3> periodic = { true, false, true };
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh, periodic,
+                                         partitioner, true );
+
+    // The blocks still tile the global grid.
+    for ( int d = 0; d < 3; ++d )
+    {
+        int num_cell = global_grid->ownedNumCell( d );
+        int dim_sum;
+        MPI_Allreduce( &num_cell, &dim_sum, 1, MPI_INT, MPI_SUM,
+                       MPI_COMM_WORLD );
+        int num_row = global_grid->totalNumBlock() /
+                      global_grid->dimNumBlock( d );
+        EXPECT_EQ( dim_sum, num_row * global_num_cell[d] );
+    }
+
+    // The ranks of a node tile a sub-block of the rank grid.
+    if ( global_grid->nodeAware() )
+    {
+        MPI_Comm node_comm;
+        MPI_Comm_split_type( global_grid->comm(), MPI_COMM_TYPE_SHARED, 0,
+                             MPI_INFO_NULL, &node_comm );
+        int node_size;
+        MPI_Comm_size( node_comm, &node_size );
+        int volume = 1;
+        for ( int d = 0; d < 3; ++d )
+        {
+            int id = global_grid->dimBlockId( d );
+            int min_id;
+            int max_id;
+            MPI_Allreduce( &id, &min_id, 1, MPI_INT, MPI_MIN, node_comm );
+            MPI_Allreduce( &id, &max_id, 1, MPI_INT, MPI_MAX, node_comm );
+            volume *= max_id - min_id + 1;
+        }
+        EXPECT_EQ( volume, node_size );
+        MPI_Comm_free( &node_comm );
+    }
+}
+
 //---------------------------------------------------------------------------//
 // RUN TESTS
 //---------------------------------------------------------------------------//
@@ -379,6 +443,8 @@ TEST( global_grid, 3d_grid_test )
     gridTest3d( not_periodic );
 }
 
+TEST( global_grid, node_aware_test ) { nodeAwareTest(); }
+
 TEST( global_grid, 2d_grid_test )
 {
     std::array<bool, 2> periodic = { true, true };
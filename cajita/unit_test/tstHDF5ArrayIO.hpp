@@ -0,0 +1,127 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cajita_Array.hpp>
+#include <Cajita_GlobalGrid.hpp>
+#include <Cajita_GlobalMesh.hpp>
+#include <Cajita_HDF5ArrayIO.hpp>
+#include <Cajita_IndexSpace.hpp>
+#include <Cajita_Partitioner.hpp>
+#include <Cajita_Types.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <hdf5.h>
+#include <mpi.h>
+
+#include <array>
+#include <vector>
+
+using namespace Cajita;
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+void writeTest( const hsize_t chunk_size )
+{
+    // Create the global mesh.
+    std::array<int, 3> global_num_cell = { 12, 7, 9 };
+    std::array<double, 3> global_low_corner = { 0.0, 0.0, 0.0 };
+    std::array<double, 3> global_high_corner = { 1.2, 0.7, 0.9 };
+    auto global_mesh = createUniformGlobalMesh(
+        global_low_corner, global_high_corner, global_num_cell );
+
+    // Create the global grid.
+    DimBlockPartitioner<3> partitioner;
+    std::array<bool, 3> is_dim_periodic = { false, true, false };
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+    auto local_grid = createLocalGrid( global_grid, 1 );
+
+    // Fill a cell array with its global indices.
+    auto layout = createArrayLayout( local_grid, 3, Cell() );
+    auto array = createArray<double, TEST_DEVICE>( "cell_ids", layout );
+    auto owned_space = local_grid->indexSpace( Own(), Cell(), Local() );
+    auto global_space = local_grid->indexSpace( Own(), Cell(), Global() );
+    auto host_view = Kokkos::create_mirror_view( array->view() );
+    for ( int i = 0; i < owned_space.extent( Dim::I ); ++i )
+        for ( int j = 0; j < owned_space.extent( Dim::J ); ++j )
+            for ( int k = 0; k < owned_space.extent( Dim::K ); ++k )
+            {
+                int il = i + owned_space.min( Dim::I );
+                int jl = j + owned_space.min( Dim::J );
+                int kl = k + owned_space.min( Dim::K );
+                host_view( il, jl, kl, 0 ) = i + global_space.min( Dim::I );
+                host_view( il, jl, kl, 1 ) = j + global_space.min( Dim::J );
+                host_view( il, jl, kl, 2 ) = k + global_space.min( Dim::K );
+            }
+    Kokkos::deep_copy( array->view(), host_view );
+
+    Experimental::HDF5ArrayOutput::HDF5Config h5_config;
+    h5_config.chunk_size = chunk_size;
+    Experimental::HDF5ArrayOutput::writeTimeStep( h5_config, "grid", 5, 1.5,
+                                                  *array );
+
+    // Read the whole dataset back on rank 0 and check every cell.
+    int comm_rank;
+    MPI_Comm_rank( MPI_COMM_WORLD, &comm_rank );
+    MPI_Barrier( MPI_COMM_WORLD );
+    if ( 0 == comm_rank )
+    {
+        hid_t file_id = H5Fopen( "grid_5.h5", H5F_ACC_RDONLY, H5P_DEFAULT );
+        ASSERT_GE( file_id, 0 );
+        double time = 0.0;
+        hid_t attr_id = H5Aopen( file_id, "Time", H5P_DEFAULT );
+        H5Aread( attr_id, H5T_NATIVE_DOUBLE, &time );
+        H5Aclose( attr_id );
+        EXPECT_DOUBLE_EQ( time, 1.5 );
+
+        hid_t dset_id = H5Dopen( file_id, "cell_ids", H5P_DEFAULT );
+        hid_t space_id = H5Dget_space( dset_id );
+        hsize_t dims[4];
+        EXPECT_EQ( H5Sget_simple_extent_dims( space_id, dims, nullptr ), 4 );
+        for ( int d = 0; d < 3; ++d )
+            EXPECT_EQ( dims[d], static_cast<hsize_t>( global_num_cell[d] ) );
+        EXPECT_EQ( dims[3], static_cast<hsize_t>( 3 ) );
+
+        std::vector<double> data( dims[0] * dims[1] * dims[2] * dims[3] );
+        H5Dread( dset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+                 data.data() );
+        for ( hsize_t i = 0; i < dims[0]; ++i )
+            for ( hsize_t j = 0; j < dims[1]; ++j )
+                for ( hsize_t k = 0; k < dims[2]; ++k )
+                {
+                    std::size_t n = ( ( i * dims[1] + j ) * dims[2] + k ) * 3;
+                    EXPECT_DOUBLE_EQ( data[n], static_cast<double>( i ) );
+                    EXPECT_DOUBLE_EQ( data[n + 1], static_cast<double>( j ) );
+                    EXPECT_DOUBLE_EQ( data[n + 2], static_cast<double>( k ) );
+                }
+
+        H5Sclose( space_id );
+        H5Dclose( dset_id );
+        H5Fclose( file_id );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, hdf5_array_test )
+{
+    writeTest( 0 );
+    writeTest( 1 );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
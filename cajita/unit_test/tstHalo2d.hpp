@@ -208,6 +208,26 @@ void gatherScatterTest( const ManualBlockPartitioner<2>& partitioner,
 
         // Check the scatter.
         checkScatter( is_dim_periodic, halo_width, *array );
+
+        // Exchange again with the same halo to check that its communication
+        // can be restarted.
+        ArrayOp::assign( *array, 0.0, Ghost() );
+        ArrayOp::assign( *array, 1.0, Own() );
+        halo->gather( TEST_EXECSPACE(), *array );
+        checkGather( is_dim_periodic, halo_width, *array );
+        halo->scatter( TEST_EXECSPACE(), ScatterReduce::Sum(), *array );
+        checkScatter( is_dim_periodic, halo_width, *array );
+
+        // Exchange once more with the stream-ordered variants.
+        TEST_EXECSPACE exec_space;
+        ArrayOp::assign( *array, 0.0, Ghost() );
+        ArrayOp::assign( *array, 1.0, Own() );
+        halo->enqueueGather( exec_space, *array );
+        exec_space.fence();
+        checkGather( is_dim_periodic, halo_width, *array );
+        halo->enqueueScatter( exec_space, ScatterReduce::Sum(), *array );
+        exec_space.fence();
+        checkScatter( is_dim_periodic, halo_width, *array );
     }
 
     // Repeat the process but this time with multiple arrays in a Halo
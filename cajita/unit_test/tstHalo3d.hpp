@@ -13,6 +13,8 @@
 #include <Cajita_GlobalGrid.hpp>
 #include <Cajita_GlobalMesh.hpp>
 #include <Cajita_Halo.hpp>
+#include <Cajita_IndexConversion.hpp>
+#include <Cajita_Parallel.hpp>
 #include <Cajita_Partitioner.hpp>
 #include <Cajita_Types.hpp>
 
@@ -24,6 +26,8 @@
 
 #include <array>
 #include <cmath>
+#include <initializer_list>
+#include <memory>
 
 using namespace Cajita;
 
@@ -231,6 +235,42 @@ void gatherScatterTest( const ManualBlockPartitioner<3>& partitioner,
 
         // Check the scatter.
         checkScatter( is_dim_periodic, halo_width, *array );
+
+        // Exchange again with the same halo to check that its communication
+        // can be restarted.
+        ArrayOp::assign( *array, 0.0, Ghost() );
+        ArrayOp::assign( *array, 1.0, Own() );
+        halo->gather( TEST_EXECSPACE(), *array );
+        checkGather( is_dim_periodic, halo_width, *array );
+        halo->scatter( TEST_EXECSPACE(), ScatterReduce::Sum(), *array );
+        checkScatter( is_dim_periodic, halo_width, *array );
+
+        // Exchange once more with the stream-ordered variants.
+        TEST_EXECSPACE exec_space;
+        ArrayOp::assign( *array, 0.0, Ghost() );
+        ArrayOp::assign( *array, 1.0, Own() );
+        halo->enqueueGather( exec_space, *array );
+        exec_space.fence();
+        checkGather( is_dim_periodic, halo_width, *array );
+        halo->enqueueScatter( exec_space, ScatterReduce::Sum(), *array );
+        exec_space.fence();
+        checkScatter( is_dim_periodic, halo_width, *array );
+    }
+
+    // Repeat the process with an array storing the degrees of freedom
+    // outermost.
+    {
+        auto layout =
+            createArrayLayout( global_grid, array_halo_width, 4, Cell() );
+        auto array =
+            createArray<double, DofOutermost, TEST_DEVICE>( "array", layout );
+        ArrayOp::assign( *array, 0.0, Ghost() );
+        ArrayOp::assign( *array, 1.0, Own() );
+        auto halo = createHalo( *array, FullHaloPattern(), array_halo_width );
+        halo->gather( TEST_EXECSPACE(), *array );
+        checkGather( is_dim_periodic, array_halo_width, *array );
+        halo->scatter( TEST_EXECSPACE(), ScatterReduce::Sum(), *array );
+        checkScatter( is_dim_periodic, array_halo_width, *array );
     }
 
     // Repeat the process but this time with multiple arrays in a Halo
@@ -454,8 +494,462 @@ void scatterReduceTest( const ReduceFunc& reduce )
     }
 }
 
+//---------------------------------------------------------------------------//
+void stencilHaloTest()
+{
+    // Create a pattern for an upwind stencil reaching two cells back in I
+    // and one cell forward in J.
+    StencilHaloPattern<3> pattern( { { 0, 0, 0 },
+                                     { -1, 0, 0 },
+                                     { -2, 0, 0 },
+                                     { 0, 1, 0 } } );
+    auto neighbors = pattern.getNeighbors();
+    auto widths = pattern.getWidths();
+    EXPECT_EQ( neighbors.size(), 2 );
+    EXPECT_EQ( widths.size(), 2 );
+    std::array<int, 3> minus_i = { -1, 0, 0 };
+    std::array<int, 3> plus_j = { 0, 1, 0 };
+    EXPECT_EQ( neighbors[0], minus_i );
+    EXPECT_EQ( widths[0], 2 );
+    EXPECT_EQ( neighbors[1], plus_j );
+    EXPECT_EQ( widths[1], 1 );
+
+    // Create the global grid.
+    double cell_size = 0.23;
+    std::array<int, 3> global_num_cell = { 17, 20, 21 };
+    std::array<double, 3> global_low_corner = { 1.2, 3.3, -2.8 };
+    std::array<double, 3> global_high_corner = {
+        global_low_corner[0] + cell_size * global_num_cell[0],
+        global_low_corner[1] + cell_size * global_num_cell[1],
+        global_low_corner[2] + cell_size * global_num_cell[2] };
+    auto global_mesh = createUniformGlobalMesh(
+        global_low_corner, global_high_corner, global_num_cell );
+    std::array<bool, 3> is_dim_periodic = { true, true, true };
+    auto global_grid =
+        createGlobalGrid( MPI_COMM_WORLD, global_mesh, is_dim_periodic,
+                          DimBlockPartitioner<3>() );
+
+    // Create an array on the cells with 1 in the owned space and 0 in the
+    // ghosts.
+    unsigned array_halo_width = 2;
+    auto cell_layout =
+        createArrayLayout( global_grid, array_halo_width, 2, Cell() );
+    auto array = createArray<double, TEST_DEVICE>( "array", cell_layout );
+    ArrayOp::assign( *array, 0.0, Ghost() );
+    ArrayOp::assign( *array, 1.0, Own() );
+
+    // Gather.
+    auto halo = createHalo( *array, pattern );
+    halo->gather( TEST_EXECSPACE(), *array );
+
+    // Only the ghosts the stencil reads from should be filled.
+    auto host_array = Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                           array->view() );
+    auto local_grid = cell_layout->localGrid();
+    auto check = [&]( const std::array<int, 3>& n, const int filled_width ) {
+        auto ghost_space = local_grid->sharedIndexSpace( Ghost(), Cell(), n );
+        auto filled_space =
+            local_grid->sharedIndexSpace( Ghost(), Cell(), n, filled_width );
+        for ( int i = ghost_space.min( Dim::I ); i < ghost_space.max( Dim::I );
+              ++i )
+            for ( int j = ghost_space.min( Dim::J );
+                  j < ghost_space.max( Dim::J ); ++j )
+                for ( int k = ghost_space.min( Dim::K );
+                      k < ghost_space.max( Dim::K ); ++k )
+                {
+                    bool filled = filled_width > 0 &&
+                                  i >= filled_space.min( Dim::I ) &&
+                                  i < filled_space.max( Dim::I ) &&
+                                  j >= filled_space.min( Dim::J ) &&
+                                  j < filled_space.max( Dim::J ) &&
+                                  k >= filled_space.min( Dim::K ) &&
+                                  k < filled_space.max( Dim::K );
+                    for ( int l = 0; l < 2; ++l )
+                        EXPECT_EQ( host_array( i, j, k, l ),
+                                   filled ? 1.0 : 0.0 );
+                }
+    };
+    check( { -1, 0, 0 }, 2 );
+    check( { 1, 0, 0 }, 0 );
+    check( { 0, 1, 0 }, 1 );
+    check( { 0, -1, 0 }, 0 );
+    check( { 0, 0, 1 }, 0 );
+    check( { 0, 0, -1 }, 0 );
+}
+
+//---------------------------------------------------------------------------//
+void reducedPrecisionTest()
+{
+    // Create the global grid.
+    double cell_size = 0.23;
+    std::array<int, 3> global_num_cell = { 17, 20, 21 };
+    std::array<double, 3> global_low_corner = { 1.2, 3.3, -2.8 };
+    std::array<double, 3> global_high_corner = {
+        global_low_corner[0] + cell_size * global_num_cell[0],
+        global_low_corner[1] + cell_size * global_num_cell[1],
+        global_low_corner[2] + cell_size * global_num_cell[2] };
+    auto global_mesh = createUniformGlobalMesh(
+        global_low_corner, global_high_corner, global_num_cell );
+    std::array<bool, 3> is_dim_periodic = { true, true, true };
+    auto global_grid =
+        createGlobalGrid( MPI_COMM_WORLD, global_mesh, is_dim_periodic,
+                          DimBlockPartitioner<3>() );
+
+    // Create a double array on the cells and a float array on the nodes with
+    // values that can not be represented exactly in single precision.
+    unsigned array_halo_width = 2;
+    auto cell_layout =
+        createArrayLayout( global_grid, array_halo_width, 3, Cell() );
+    auto cell_array =
+        createArray<double, TEST_DEVICE>( "cell_array", cell_layout );
+    auto node_layout =
+        createArrayLayout( global_grid, array_halo_width, 1, Node() );
+    auto node_array =
+        createArray<float, TEST_DEVICE>( "node_array", node_layout );
+    ArrayOp::assign( *cell_array, 0.0, Ghost() );
+    ArrayOp::assign( *cell_array, 1.1, Own() );
+    ArrayOp::assign( *node_array, 0.0, Ghost() );
+    ArrayOp::assign( *node_array, 1.1f, Own() );
+
+    // Create a halo with reduced precision gathers.
+    auto halo = createHalo( FullHaloPattern(), array_halo_width, *cell_array,
+                            *node_array );
+    EXPECT_TRUE( Cabana::CommPrecision::Full == halo->gatherPrecision() );
+    halo->setGatherPrecision( Cabana::CommPrecision::Reduced );
+    EXPECT_TRUE( Cabana::CommPrecision::Reduced == halo->gatherPrecision() );
+
+    // Check that the owned values are unchanged and the ghosts have the given
+    // value.
+    auto check = []( const auto& array, const double ghost_value ) {
+        auto owned_space = array.layout()->indexSpace( Own(), Local() );
+        auto ghosted_space = array.layout()->indexSpace( Ghost(), Local() );
+        auto host_view = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), array.view() );
+        using value_type = typename decltype( host_view )::value_type;
+        for ( int i = ghosted_space.min( Dim::I );
+              i < ghosted_space.max( Dim::I ); ++i )
+            for ( int j = ghosted_space.min( Dim::J );
+                  j < ghosted_space.max( Dim::J ); ++j )
+                for ( int k = ghosted_space.min( Dim::K );
+                      k < ghosted_space.max( Dim::K ); ++k )
+                    for ( int l = 0; l < ghosted_space.extent( 3 ); ++l )
+                    {
+                        bool owned = i >= owned_space.min( Dim::I ) &&
+                                     i < owned_space.max( Dim::I ) &&
+                                     j >= owned_space.min( Dim::J ) &&
+                                     j < owned_space.max( Dim::J ) &&
+                                     k >= owned_space.min( Dim::K ) &&
+                                     k < owned_space.max( Dim::K );
+                        EXPECT_EQ( host_view( i, j, k, l ),
+                                   owned ? static_cast<value_type>( 1.1 )
+                                         : static_cast<value_type>(
+                                               ghost_value ) );
+                    }
+    };
+
+    // Gather with reduced precision. The doubles are rounded to float.
+    halo->gather( TEST_EXECSPACE(), *cell_array, *node_array );
+    check( *cell_array, static_cast<double>( 1.1f ) );
+    check( *node_array, 1.1f );
+
+    // Gather again with full precision.
+    halo->setGatherPrecision( Cabana::CommPrecision::Full );
+    halo->gather( TEST_EXECSPACE(), *cell_array, *node_array );
+    check( *cell_array, 1.1 );
+    check( *node_array, 1.1f );
+}
+
+//---------------------------------------------------------------------------//
+// Unique value of a degree of freedom of an entity with the given global
+// index.
+KOKKOS_INLINE_FUNCTION
+double dofValue( const int gi, const int gj, const int gk, const int l )
+{
+    return ( ( l * 32.0 + gk ) * 32.0 + gj ) * 32.0 + gi;
+}
+
+// Assign the owned entities of an array the value of their global index and
+// degree of freedom and the ghosts zero.
+template <class Array>
+void assignDofValues( const Array& array )
+{
+    using entity_type = typename Array::entity_type;
+    ArrayOp::assign( array, 0.0, Ghost() );
+    auto local_grid = array.layout()->localGrid();
+    auto l2g = IndexConversion::createL2G( *local_grid, entity_type() );
+    auto view = array.view();
+    grid_parallel_for(
+        "assign_dof_values", TEST_EXECSPACE(),
+        array.layout()->indexSpace( Own(), Local() ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k, const int l ) {
+            int gi, gj, gk;
+            l2g( i, j, k, gi, gj, gk );
+            view( i, j, k, l ) = dofValue( gi, gj, gk, l );
+        } );
+    Kokkos::fence();
+}
+
+// Check that every entity of a fully gathered periodic array holds the value
+// of its global index and degree of freedom.
+template <class Array>
+void checkDofValues( const Array& array )
+{
+    using entity_type = typename Array::entity_type;
+    using value_type = typename Array::value_type;
+    auto local_grid = array.layout()->localGrid();
+    auto l2g = IndexConversion::createL2G( *local_grid, entity_type() );
+    auto ghosted_space = array.layout()->indexSpace( Ghost(), Local() );
+    auto host_view = Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                          array.view() );
+    int num_error = 0;
+    for ( int i = 0; i < ghosted_space.extent( Dim::I ); ++i )
+        for ( int j = 0; j < ghosted_space.extent( Dim::J ); ++j )
+            for ( int k = 0; k < ghosted_space.extent( Dim::K ); ++k )
+            {
+                int gi, gj, gk;
+                l2g( i, j, k, gi, gj, gk );
+                for ( int l = 0; l < ghosted_space.extent( 3 ); ++l )
+                    if ( host_view( i, j, k, l ) !=
+                         static_cast<value_type>( dofValue( gi, gj, gk, l ) ) )
+                        ++num_error;
+            }
+    EXPECT_EQ( num_error, 0 );
+}
+
+//---------------------------------------------------------------------------//
+// Gather arrays storing the degrees of freedom innermost and outermost with
+// a different value in every degree of freedom of every entity so that each
+// ghost can be checked against its source.
+void dofLayoutTest()
+{
+    // Create the global grid.
+    double cell_size = 0.23;
+    std::array<int, 3> global_num_cell = { 17, 20, 21 };
+    std::array<double, 3> global_low_corner = { 1.2, 3.3, -2.8 };
+    std::array<double, 3> global_high_corner = {
+        global_low_corner[0] + cell_size * global_num_cell[0],
+        global_low_corner[1] + cell_size * global_num_cell[1],
+        global_low_corner[2] + cell_size * global_num_cell[2] };
+    auto global_mesh = createUniformGlobalMesh(
+        global_low_corner, global_high_corner, global_num_cell );
+    std::array<bool, 3> is_dim_periodic = { true, true, true };
+    auto global_grid =
+        createGlobalGrid( MPI_COMM_WORLD, global_mesh, is_dim_periodic,
+                          DimBlockPartitioner<3>() );
+
+    // Create arrays of both storage orders, value types and entities.
+    unsigned halo_width = 2;
+    auto cell_layout = createArrayLayout( global_grid, halo_width, 3, Cell() );
+    auto node_layout = createArrayLayout( global_grid, halo_width, 2, Node() );
+    auto inner_array =
+        createArray<double, TEST_DEVICE>( "inner_array", cell_layout );
+    auto outer_array = createArray<double, DofOutermost, TEST_DEVICE>(
+        "outer_array", cell_layout );
+    auto outer_node_array = createArray<float, DofOutermost, TEST_DEVICE>(
+        "outer_node_array", node_layout );
+
+    // Gather each array on its own and all arrays together.
+    auto gather = [&]( auto& halo, auto&... arrays ) {
+        (void)std::initializer_list<int>{ ( assignDofValues( arrays ), 0 )... };
+        halo->gather( TEST_EXECSPACE(), arrays... );
+        (void)std::initializer_list<int>{ ( checkDofValues( arrays ), 0 )... };
+    };
+    auto inner_halo = createHalo( FullHaloPattern(), halo_width, *inner_array );
+    gather( inner_halo, *inner_array );
+    auto outer_halo = createHalo( FullHaloPattern(), halo_width, *outer_array );
+    gather( outer_halo, *outer_array );
+    auto multi_halo = createHalo( FullHaloPattern(), halo_width, *inner_array,
+                                  *outer_node_array, *outer_array );
+    gather( multi_halo, *inner_array, *outer_node_array, *outer_array );
+}
+
+//---------------------------------------------------------------------------//
+// Run exchanges of different arrays back-to-back on one execution space
+// instance without fencing in between. The receives of each exchange must
+// not overwrite the buffers still being unpacked by the previous one.
+void enqueueRestartTest()
+{
+    // Create the global grid.
+    double cell_size = 0.23;
+    std::array<int, 3> global_num_cell = { 17, 20, 21 };
+    std::array<double, 3> global_low_corner = { 1.2, 3.3, -2.8 };
+    std::array<double, 3> global_high_corner = {
+        global_low_corner[0] + cell_size * global_num_cell[0],
+        global_low_corner[1] + cell_size * global_num_cell[1],
+        global_low_corner[2] + cell_size * global_num_cell[2] };
+    auto global_mesh = createUniformGlobalMesh(
+        global_low_corner, global_high_corner, global_num_cell );
+    std::array<bool, 3> is_dim_periodic = { true, true, true };
+    auto global_grid =
+        createGlobalGrid( MPI_COMM_WORLD, global_mesh, is_dim_periodic,
+                          DimBlockPartitioner<3>() );
+
+    // Create two arrays of the same layout sharing a halo.
+    unsigned halo_width = 2;
+    auto layout = createArrayLayout( global_grid, halo_width, 3, Cell() );
+    auto array_a = createArray<double, TEST_DEVICE>( "array_a", layout );
+    auto array_b = createArray<double, TEST_DEVICE>( "array_b", layout );
+    auto halo = createHalo( FullHaloPattern(), halo_width, *array_a );
+    TEST_EXECSPACE exec_space;
+
+    // Gather both arrays back-to-back.
+    assignDofValues( *array_a );
+    ArrayOp::assign( *array_b, 0.0, Ghost() );
+    ArrayOp::assign( *array_b, -1.0, Own() );
+    halo->enqueueGather( exec_space, *array_a );
+    halo->enqueueGather( exec_space, *array_b );
+    exec_space.fence();
+    checkDofValues( *array_a );
+    auto host_b = Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                       array_b->view() );
+    auto ghosted_space = layout->indexSpace( Ghost(), Local() );
+    int num_error = 0;
+    for ( int i = 0; i < ghosted_space.extent( Dim::I ); ++i )
+        for ( int j = 0; j < ghosted_space.extent( Dim::J ); ++j )
+            for ( int k = 0; k < ghosted_space.extent( Dim::K ); ++k )
+                for ( int l = 0; l < ghosted_space.extent( 3 ); ++l )
+                    if ( host_b( i, j, k, l ) != -1.0 )
+                        ++num_error;
+    EXPECT_EQ( num_error, 0 );
+
+    // Scatter both arrays back-to-back. The second array holds twice the
+    // values of the first so its owned sums are twice as large.
+    ArrayOp::assign( *array_a, 1.0, Ghost() );
+    ArrayOp::assign( *array_b, 2.0, Ghost() );
+    halo->enqueueScatter( exec_space, ScatterReduce::Sum(), *array_a );
+    halo->enqueueScatter( exec_space, ScatterReduce::Sum(), *array_b );
+    exec_space.fence();
+    checkScatter( is_dim_periodic, halo_width, *array_a );
+    auto host_a = Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                       array_a->view() );
+    host_b = Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                  array_b->view() );
+    auto owned_space = layout->indexSpace( Own(), Local() );
+    num_error = 0;
+    for ( int i = owned_space.min( Dim::I ); i < owned_space.max( Dim::I );
+          ++i )
+        for ( int j = owned_space.min( Dim::J ); j < owned_space.max( Dim::J );
+              ++j )
+            for ( int k = owned_space.min( Dim::K );
+                  k < owned_space.max( Dim::K ); ++k )
+                for ( int l = 0; l < owned_space.extent( 3 ); ++l )
+                    if ( host_b( i, j, k, l ) != 2.0 * host_a( i, j, k, l ) )
+                        ++num_error;
+    EXPECT_EQ( num_error, 0 );
+}
+
 //---------------------------------------------------------------------------//
 // RUN TESTS
+//---------------------------------------------------------------------------//
+void haloParallelForTest()
+{
+    // Create the global grid.
+    double cell_size = 0.23;
+    std::array<int, 3> global_num_cell = { 17, 20, 21 };
+    std::array<double, 3> global_low_corner = { 1.2, 3.3, -2.8 };
+    std::array<double, 3> global_high_corner = {
+        global_low_corner[0] + cell_size * global_num_cell[0],
+        global_low_corner[1] + cell_size * global_num_cell[1],
+        global_low_corner[2] + cell_size * global_num_cell[2] };
+    auto global_mesh = createUniformGlobalMesh(
+        global_low_corner, global_high_corner, global_num_cell );
+    std::array<bool, 3> is_dim_periodic = { true, true, true };
+    auto global_grid =
+        createGlobalGrid( MPI_COMM_WORLD, global_mesh, is_dim_periodic,
+                          DimBlockPartitioner<3>() );
+
+    // Create an array on the cells with 1 in the owned space and 0 in the
+    // ghosts and an array for the result of a stencil over it.
+    auto cell_layout = createArrayLayout( global_grid, 1, 1, Cell() );
+    auto array = createArray<double, TEST_DEVICE>( "array", cell_layout );
+    ArrayOp::assign( *array, 0.0, Ghost() );
+    ArrayOp::assign( *array, 1.0, Own() );
+    auto result = createArray<double, TEST_DEVICE>( "result", cell_layout );
+    ArrayOp::assign( *result, 0.0, Ghost() );
+
+    // Sum each cell and its face neighbors while gathering the halo. With
+    // the ghosts filled every owned cell sums to 7.
+    auto halo = createHalo( *array, FullHaloPattern() );
+    auto owned_space =
+        cell_layout->localGrid()->indexSpace( Own(), Cell(), Local() );
+    auto array_view = array->view();
+    auto result_view = result->view();
+    halo_parallel_for(
+        "stencil", TEST_EXECSPACE(), owned_space, 1,
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            result_view( i, j, k, 0 ) =
+                array_view( i, j, k, 0 ) + array_view( i - 1, j, k, 0 ) +
+                array_view( i + 1, j, k, 0 ) + array_view( i, j - 1, k, 0 ) +
+                array_view( i, j + 1, k, 0 ) + array_view( i, j, k - 1, 0 ) +
+                array_view( i, j, k + 1, 0 );
+        },
+        *halo, *array );
+    Kokkos::fence();
+
+    auto host_result = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), result->view() );
+    for ( int i = owned_space.min( Dim::I ); i < owned_space.max( Dim::I );
+          ++i )
+        for ( int j = owned_space.min( Dim::J ); j < owned_space.max( Dim::J );
+              ++j )
+            for ( int k = owned_space.min( Dim::K );
+                  k < owned_space.max( Dim::K ); ++k )
+                EXPECT_EQ( host_result( i, j, k, 0 ), 7.0 );
+}
+
+//---------------------------------------------------------------------------//
+void statisticsTest()
+{
+    // Create the global grid.
+    double cell_size = 0.23;
+    std::array<int, 3> global_num_cell = { 17, 20, 21 };
+    std::array<double, 3> global_low_corner = { 1.2, 3.3, -2.8 };
+    std::array<double, 3> global_high_corner = {
+        global_low_corner[0] + cell_size * global_num_cell[0],
+        global_low_corner[1] + cell_size * global_num_cell[1],
+        global_low_corner[2] + cell_size * global_num_cell[2] };
+    auto global_mesh = createUniformGlobalMesh(
+        global_low_corner, global_high_corner, global_num_cell );
+    std::array<bool, 3> is_dim_periodic = { true, true, true };
+    auto global_grid =
+        createGlobalGrid( MPI_COMM_WORLD, global_mesh, is_dim_periodic,
+                          DimBlockPartitioner<3>() );
+
+    // Create a halo with statistics attached.
+    auto cell_layout = createArrayLayout( global_grid, 1, 2, Cell() );
+    auto array = createArray<double, TEST_DEVICE>( "array", cell_layout );
+    ArrayOp::assign( *array, 1.0, Own() );
+    auto halo = createHalo( *array, FullHaloPattern() );
+    EXPECT_FALSE( halo->statistics() );
+    auto stats = std::make_shared<Cabana::CommStatistics>();
+    halo->setStatistics( stats );
+    EXPECT_EQ( halo->statistics(), stats );
+
+    // Gather and scatter. Every neighbor of the periodic grid is sent and
+    // received a slab of the same size.
+    halo->gather( TEST_EXECSPACE(), *array );
+    halo->scatter( TEST_EXECSPACE(), ScatterReduce::Sum(), *array );
+    EXPECT_EQ( stats->numOperations(), 2 );
+    EXPECT_EQ( stats->numMessagesSent(), stats->numMessagesReceived() );
+    EXPECT_EQ( stats->bytesSent(), stats->bytesReceived() );
+    EXPECT_GT( stats->bytesSent() + stats->bytesSelf(), 0 );
+    EXPECT_EQ( ( stats->bytesSent() + stats->bytesSelf() ) % sizeof( double ),
+               0 );
+    EXPECT_GE( stats->waitTime(), 0.0 );
+
+    // Reduce the statistics over all ranks.
+    auto summary = stats->summarize( MPI_COMM_WORLD );
+    EXPECT_EQ( summary.num_operations.min, 2.0 );
+    EXPECT_EQ( summary.num_operations.max, 2.0 );
+    EXPECT_LE( summary.bytes_sent.min, summary.bytes_sent.avg );
+    EXPECT_LE( summary.bytes_sent.avg, summary.bytes_sent.max );
+
+    // Reset the counters.
+    stats->reset();
+    EXPECT_EQ( stats->numOperations(), 0 );
+    EXPECT_EQ( stats->bytesSelf(), 0 );
+}
+
 //---------------------------------------------------------------------------//
 TEST( TEST_CATEGORY, not_periodic_test )
 {
@@ -548,6 +1042,32 @@ TEST( TEST_CATEGORY, scatter_reduce_replace_test )
     scatterReduceTest( ScatterReduce::Replace() );
 }
 
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, stencil_halo_test )
+{
+    stencilHaloTest();
+}
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, reduced_precision_test )
+{
+    reducedPrecisionTest();
+}
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, dof_layout_test ) { dofLayoutTest(); }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, enqueue_restart_test ) { enqueueRestartTest(); }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, halo_parallel_for_test )
+{
+    haloParallelForTest();
+}
+
+TEST( TEST_CATEGORY, statistics_test ) { statisticsTest(); }
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
@@ -183,6 +183,27 @@ poissonTest( const std::string& solver_type, const std::string& precond_type,
                 EXPECT_FLOAT_EQ( lhs_host( i, j, k, 0 ),
                                  lhs_ref_host( i, j, k, 0 ) );
 
+    // Solve with strided arrays which are staged rather than passed to
+    // HYPRE in place.
+    auto pair_layout = createArrayLayout( local_mesh, 2, Cell() );
+    auto rhs_pair = createArray<double, MemorySpace>( "rhs_pair", pair_layout );
+    ArrayOp::assign( *rhs_pair, 1.0, Own() );
+    auto lhs_pair = createArray<double, MemorySpace>( "lhs_pair", pair_layout );
+    ArrayOp::assign( *lhs_pair, 0.0, Own() );
+    auto rhs_strided = createSubarray( *rhs_pair, 1, 2 );
+    auto lhs_strided = createSubarray( *lhs_pair, 1, 2 );
+    solver->solve( *rhs_strided, *lhs_strided );
+    auto lhs_pair_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), lhs_pair->view() );
+    for ( int i = owned_space.min( Dim::I ); i < owned_space.max( Dim::I );
+          ++i )
+        for ( int j = owned_space.min( Dim::J ); j < owned_space.max( Dim::J );
+              ++j )
+            for ( int k = owned_space.min( Dim::K );
+                  k < owned_space.max( Dim::K ); ++k )
+                EXPECT_FLOAT_EQ( lhs_pair_host( i, j, k, 1 ),
+                                 lhs_host( i, j, k, 0 ) );
+
     // Setup the problem again. We would need to do this if we changed the
     // matrix entries.
     solver->setup();
@@ -209,6 +230,41 @@ poissonTest( const std::string& solver_type, const std::string& precond_type,
                   k < owned_space.max( Dim::K ); ++k )
                 EXPECT_FLOAT_EQ( lhs_host( i, j, k, 0 ),
                                  lhs_ref_host( i, j, k, 0 ) );
+
+    // Update only the diagonal entries and solve again with the same matrix
+    // structure.
+    auto diag_layout = createArrayLayout( local_mesh, 1, Cell() );
+    auto diag_entries =
+        createArray<double, MemorySpace>( "diag_entries", diag_layout );
+    ArrayOp::assign( *diag_entries, 8.0, Own() );
+    solver->updateMatrixValues( *diag_entries, { 0 } );
+    solver->setup();
+    ArrayOp::assign( *lhs, 0.0, Own() );
+    solver->solve( *rhs, *lhs );
+
+    Kokkos::parallel_for(
+        "update_ref_entries",
+        createExecutionPolicy( owned_space, TEST_EXECSPACE() ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            matrix_view( i, j, k, 0 ) = 8.0;
+            preconditioner_view( i, j, k, 0 ) = 1.0 / 8.0;
+        } );
+    ArrayOp::assign( *lhs_ref, 0.0, Own() );
+    ref_solver->solve( *rhs, *lhs_ref );
+
+    // Check the results with the updated values.
+    lhs_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), lhs->view() );
+    lhs_ref_host = Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                        lhs_ref->view() );
+    for ( int i = owned_space.min( Dim::I ); i < owned_space.max( Dim::I );
+          ++i )
+        for ( int j = owned_space.min( Dim::J ); j < owned_space.max( Dim::J );
+              ++j )
+            for ( int k = owned_space.min( Dim::K );
+                  k < owned_space.max( Dim::K ); ++k )
+                EXPECT_FLOAT_EQ( lhs_host( i, j, k, 0 ),
+                                 lhs_ref_host( i, j, k, 0 ) );
 }
 
 //---------------------------------------------------------------------------//
@@ -584,6 +584,45 @@ void inRangeTest()
     EXPECT_FALSE( space.inRange( i8 ) );
 }
 
+//---------------------------------------------------------------------------//
+void interiorBoundaryTest()
+{
+    IndexSpace<3> space( { 9, 2, 1 }, { 14, 16, 4 } );
+
+    auto interior = interiorIndexSpace( space, 1 );
+    EXPECT_EQ( interior, IndexSpace<3>( { 10, 3, 2 }, { 13, 15, 3 } ) );
+
+    // Every index is in exactly one of the interior and boundary spaces.
+    for ( long width : { 0, 1, 2 } )
+    {
+        interior = interiorIndexSpace( space, width );
+        auto boundary = boundaryIndexSpaces( space, width );
+        long size = interior.size();
+        for ( const auto& b : boundary )
+            size += b.size();
+        EXPECT_EQ( size, space.size() );
+
+        for ( long i = space.min( 0 ); i < space.max( 0 ); ++i )
+            for ( long j = space.min( 1 ); j < space.max( 1 ); ++j )
+                for ( long k = space.min( 2 ); k < space.max( 2 ); ++k )
+                {
+                    long index[3] = { i, j, k };
+                    int count = interior.inRange( index ) ? 1 : 0;
+                    for ( const auto& b : boundary )
+                        if ( b.inRange( index ) )
+                            ++count;
+                    EXPECT_EQ( count, 1 );
+
+                    bool is_interior = true;
+                    for ( int d = 0; d < 3; ++d )
+                        is_interior = is_interior &&
+                                      index[d] >= space.min( d ) + width &&
+                                      index[d] < space.max( d ) - width;
+                    EXPECT_EQ( interior.inRange( index ), is_interior );
+                }
+    }
+}
+
 //---------------------------------------------------------------------------//
 // RUN TESTS
 //---------------------------------------------------------------------------//
@@ -597,6 +636,7 @@ TEST( TEST_CATEGORY, index_space_test )
     rangeAppendTest();
     comparisonTest();
     defaultConstructorTest();
+    interiorBoundaryTest();
 }
 
 //---------------------------------------------------------------------------//
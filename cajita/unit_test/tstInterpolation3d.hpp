@@ -11,6 +11,8 @@
 
 #include <Kokkos_Core.hpp>
 
+#include <Cabana_Sort.hpp>
+
 #include <Cajita_Array.hpp>
 #include <Cajita_GlobalGrid.hpp>
 #include <Cajita_GlobalMesh.hpp>
@@ -34,6 +36,22 @@ using namespace Cajita;
 namespace Test
 {
 
+//---------------------------------------------------------------------------//
+// Point update scaling a point field.
+template <class ViewType>
+struct ScaleUpdate
+{
+    ViewType x;
+    double factor;
+
+    template <class SplineDataType>
+    KOKKOS_INLINE_FUNCTION void operator()( const SplineDataType&,
+                                            const int p ) const
+    {
+        x( p ) *= factor;
+    }
+};
+
 //---------------------------------------------------------------------------//
 void interpolationTest()
 {
@@ -147,6 +165,24 @@ void interpolationTest()
                 for ( int d = 0; d < 3; ++d )
                     EXPECT_FLOAT_EQ( vector_grid_host( i, j, k, d ), -1.75 );
 
+    // Interpolate a vector point value to a grid field storing the vector
+    // components outermost.
+    auto outer_grid_field = createArray<double, DofOutermost, TEST_DEVICE>(
+        "outer_grid_field", vector_layout );
+    auto outer_halo = createHalo( *outer_grid_field, FullHaloPattern() );
+    ArrayOp::assign( *outer_grid_field, 0.0, Ghost() );
+    p2g( vector_p2g, points, num_point, Spline<1>(), *outer_halo,
+         *outer_grid_field );
+    auto outer_grid_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), outer_grid_field->view() );
+    for ( int i = node_space.min( Dim::I ); i < node_space.max( Dim::I ); ++i )
+        for ( int j = node_space.min( Dim::J ); j < node_space.max( Dim::J );
+              ++j )
+            for ( int k = node_space.min( Dim::K );
+                  k < node_space.max( Dim::K ); ++k )
+                for ( int d = 0; d < 3; ++d )
+                    EXPECT_FLOAT_EQ( outer_grid_host( i, j, k, d ), -1.75 );
+
     // Interpolate a scalar point gradient value to the grid.
     ArrayOp::assign( *vector_grid_field, 0.0, Ghost() );
     auto scalar_grad_p2g = createScalarGradientP2G( scalar_point_field, -0.5 );
@@ -190,6 +226,123 @@ void interpolationTest()
                     EXPECT_FLOAT_EQ( vector_grid_host( i, j, k, d ) + 1.0,
                                      1.0 );
 
+    // Deterministic P2G
+    // -----------------
+
+    // Interpolate a vector point value to the grid twice with a fixed order
+    // of summation and check the results are identical.
+    ArrayOp::assign( *vector_grid_field, 0.0, Ghost() );
+    p2g( vector_p2g, points, num_point, Spline<1>(), *vector_halo,
+         *vector_grid_field, P2GReduction::Deterministic );
+    auto deterministic_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), vector_grid_field->view() );
+    ArrayOp::assign( *vector_grid_field, 0.0, Ghost() );
+    p2g( vector_p2g, points, num_point, Spline<1>(), *vector_halo,
+         *vector_grid_field, P2GReduction::Deterministic );
+    Kokkos::deep_copy( vector_grid_host, vector_grid_field->view() );
+    for ( int i = node_space.min( Dim::I ); i < node_space.max( Dim::I ); ++i )
+        for ( int j = node_space.min( Dim::J ); j < node_space.max( Dim::J );
+              ++j )
+            for ( int k = node_space.min( Dim::K );
+                  k < node_space.max( Dim::K ); ++k )
+                for ( int d = 0; d < 3; ++d )
+                {
+                    EXPECT_FLOAT_EQ( vector_grid_host( i, j, k, d ), -1.75 );
+                    EXPECT_EQ( vector_grid_host( i, j, k, d ),
+                               deterministic_host( i, j, k, d ) );
+                }
+
+    // Binned P2G
+    // ----------
+
+    // Bin pairs of consecutive points, once in order and once through a
+    // reversing permutation.
+    using bin_type = Cabana::BinningData<TEST_DEVICE>;
+    int num_bin = ( num_point + 1 ) / 2;
+    Kokkos::View<int*, TEST_DEVICE> bin_counts( "bin_counts", num_bin );
+    typename bin_type::OffsetView bin_offsets( "bin_offsets", num_bin );
+    typename bin_type::OffsetView bin_permute( "bin_permute", num_point );
+    Kokkos::parallel_for(
+        "fill_bins", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_point ),
+        KOKKOS_LAMBDA( const int p ) {
+            if ( p % 2 == 0 )
+            {
+                bin_counts( p / 2 ) = ( p + 1 < num_point ) ? 2 : 1;
+                bin_offsets( p / 2 ) = p;
+            }
+            bin_permute( p ) = num_point - 1 - p;
+        } );
+    bin_type bins( 0, num_point, bin_counts, bin_offsets, bin_permute );
+
+    for ( bool sorted : { true, false } )
+    {
+        // Interpolate a scalar point value to the grid.
+        ArrayOp::assign( *scalar_grid_field, 0.0, Ghost() );
+        p2g( scalar_p2g, points, bins, Spline<1>(), *scalar_halo,
+             *scalar_grid_field, sorted );
+        Kokkos::deep_copy( scalar_grid_host, scalar_grid_field->view() );
+        for ( int i = node_space.min( Dim::I ); i < node_space.max( Dim::I );
+              ++i )
+            for ( int j = node_space.min( Dim::J );
+                  j < node_space.max( Dim::J ); ++j )
+                for ( int k = node_space.min( Dim::K );
+                      k < node_space.max( Dim::K ); ++k )
+                    EXPECT_FLOAT_EQ( scalar_grid_host( i, j, k, 0 ), -1.75 );
+
+        // Interpolate a vector point value to the grid.
+        ArrayOp::assign( *vector_grid_field, 0.0, Ghost() );
+        p2g( vector_p2g, points, bins, Spline<1>(), *vector_halo,
+             *vector_grid_field, sorted );
+        Kokkos::deep_copy( vector_grid_host, vector_grid_field->view() );
+        for ( int i = node_space.min( Dim::I ); i < node_space.max( Dim::I );
+              ++i )
+            for ( int j = node_space.min( Dim::J );
+                  j < node_space.max( Dim::J ); ++j )
+                for ( int k = node_space.min( Dim::K );
+                      k < node_space.max( Dim::K ); ++k )
+                    for ( int d = 0; d < 3; ++d )
+                        EXPECT_FLOAT_EQ( vector_grid_host( i, j, k, d ),
+                                         -1.75 );
+    }
+
+    // Bin the points of a range after a leading point which does not
+    // contribute.
+    Kokkos::View<double* [3], TEST_DEVICE> range_points( "range_points",
+                                                         num_point + 1 );
+    Kokkos::View<double*, TEST_DEVICE> range_point_field( "range_point_field",
+                                                          num_point + 1 );
+    typename bin_type::OffsetView range_permute( "range_permute", num_point );
+    Kokkos::parallel_for(
+        "fill_range_points",
+        Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_point ),
+        KOKKOS_LAMBDA( const int p ) {
+            for ( int d = 0; d < 3; ++d )
+            {
+                range_points( p + 1, d ) = points( p, d );
+                if ( p == 0 )
+                    range_points( 0, d ) = points( 0, d );
+            }
+            range_point_field( p + 1 ) = 3.5;
+            range_permute( p ) = num_point - p;
+        } );
+    bin_type range_bins( 1, num_point + 1, bin_counts, bin_offsets,
+                         range_permute );
+    auto range_p2g = createScalarValueP2G( range_point_field, -0.5 );
+    for ( bool sorted : { true, false } )
+    {
+        ArrayOp::assign( *scalar_grid_field, 0.0, Ghost() );
+        p2g( range_p2g, range_points, range_bins, Spline<1>(), *scalar_halo,
+             *scalar_grid_field, sorted );
+        Kokkos::deep_copy( scalar_grid_host, scalar_grid_field->view() );
+        for ( int i = node_space.min( Dim::I ); i < node_space.max( Dim::I );
+              ++i )
+            for ( int j = node_space.min( Dim::J );
+                  j < node_space.max( Dim::J ); ++j )
+                for ( int k = node_space.min( Dim::K );
+                      k < node_space.max( Dim::K ); ++k )
+                    EXPECT_FLOAT_EQ( scalar_grid_host( i, j, k, 0 ), -1.75 );
+    }
+
     // G2P
     // ---
 
@@ -215,6 +368,22 @@ void interpolationTest()
         for ( int d = 0; d < 3; ++d )
             EXPECT_FLOAT_EQ( vector_point_host( p, d ), -1.75 );
 
+    // Interpolate the scalar and vector grid values to the points together.
+    Kokkos::deep_copy( scalar_point_field, 0.0 );
+    Kokkos::deep_copy( vector_point_field, 0.0 );
+    g2p( points, num_point, Spline<1>(),
+         createG2PField( *scalar_grid_field, *scalar_halo, scalar_value_g2p ),
+         createG2PField( *vector_grid_field, *vector_halo,
+                         vector_value_g2p ) );
+    Kokkos::deep_copy( scalar_point_host, scalar_point_field );
+    Kokkos::deep_copy( vector_point_host, vector_point_field );
+    for ( int p = 0; p < num_point; ++p )
+    {
+        EXPECT_FLOAT_EQ( scalar_point_host( p ), -1.75 );
+        for ( int d = 0; d < 3; ++d )
+            EXPECT_FLOAT_EQ( vector_point_host( p, d ), -1.75 );
+    }
+
     // Interpolate a scalar grid gradient to the points.
     Kokkos::deep_copy( vector_point_field, 0.0 );
     auto scalar_gradient_g2p =
@@ -246,6 +415,202 @@ void interpolationTest()
     Kokkos::deep_copy( scalar_point_host, scalar_point_field );
     for ( int p = 0; p < num_point; ++p )
         EXPECT_FLOAT_EQ( scalar_point_host( p ) + 1.0, 1.0 );
+
+    // G2P2G
+    // -----
+
+    // Interpolate a scalar grid value to the points, double it, and
+    // interpolate it back to a second grid.
+    auto result_grid_field =
+        createArray<double, TEST_DEVICE>( "result_grid_field", scalar_layout );
+    auto result_halo = createHalo( *result_grid_field, FullHaloPattern() );
+    auto result_grid_host =
+        Kokkos::create_mirror_view( result_grid_field->view() );
+    Kokkos::deep_copy( scalar_point_field, 0.0 );
+    ArrayOp::assign( *result_grid_field, 0.0, Ghost() );
+    ScaleUpdate<decltype( scalar_point_field )> scale_update{
+        scalar_point_field, 2.0 };
+    auto result_p2g = createScalarValueP2G( scalar_point_field, -0.5 );
+    g2p2g( *scalar_grid_field, *scalar_halo, points, num_point, Spline<1>(),
+           scalar_value_g2p, scale_update, result_p2g, *result_halo,
+           *result_grid_field );
+    Kokkos::deep_copy( scalar_point_host, scalar_point_field );
+    for ( int p = 0; p < num_point; ++p )
+        EXPECT_FLOAT_EQ( scalar_point_host( p ), -3.5 );
+    Kokkos::deep_copy( result_grid_host, result_grid_field->view() );
+    for ( int i = node_space.min( Dim::I ); i < node_space.max( Dim::I ); ++i )
+        for ( int j = node_space.min( Dim::J ); j < node_space.max( Dim::J );
+              ++j )
+            for ( int k = node_space.min( Dim::K );
+                  k < node_space.max( Dim::K ); ++k )
+                EXPECT_FLOAT_EQ( result_grid_host( i, j, k, 0 ), 1.75 );
+
+    // Cached spline data
+    // ------------------
+
+    // Interpolate with spline data evaluated once for both directions.
+    SplineDataCache<double, 1, 3, TEST_DEVICE> spline_cache( "spline_cache" );
+    evaluateSplineCache( *scalar_grid_field, points, num_point, Spline<1>(),
+                         spline_cache );
+    EXPECT_EQ( spline_cache.size(), static_cast<std::size_t>( num_point ) );
+
+    Kokkos::deep_copy( scalar_point_field, 0.0 );
+    g2p( *scalar_grid_field, *scalar_halo, spline_cache, Spline<1>(),
+         scalar_value_g2p );
+    Kokkos::deep_copy( scalar_point_host, scalar_point_field );
+    for ( int p = 0; p < num_point; ++p )
+        EXPECT_FLOAT_EQ( scalar_point_host( p ), -1.75 );
+
+    ArrayOp::assign( *result_grid_field, 0.0, Ghost() );
+    p2g( result_p2g, spline_cache, Spline<1>(), *result_halo,
+         *result_grid_field );
+    Kokkos::deep_copy( result_grid_host, result_grid_field->view() );
+    for ( int i = node_space.min( Dim::I ); i < node_space.max( Dim::I ); ++i )
+        for ( int j = node_space.min( Dim::J ); j < node_space.max( Dim::J );
+              ++j )
+            for ( int k = node_space.min( Dim::K );
+                  k < node_space.max( Dim::K ); ++k )
+                EXPECT_FLOAT_EQ( result_grid_host( i, j, k, 0 ), 0.875 );
+
+    // Spread the binned points with the cached spline data.
+    for ( bool sorted : { true, false } )
+    {
+        ArrayOp::assign( *result_grid_field, 0.0, Ghost() );
+        p2g( result_p2g, spline_cache, bins, Spline<1>(), *result_halo,
+             *result_grid_field, sorted );
+        Kokkos::deep_copy( result_grid_host, result_grid_field->view() );
+        for ( int i = node_space.min( Dim::I ); i < node_space.max( Dim::I );
+              ++i )
+            for ( int j = node_space.min( Dim::J );
+                  j < node_space.max( Dim::J ); ++j )
+                for ( int k = node_space.min( Dim::K );
+                      k < node_space.max( Dim::K ); ++k )
+                    EXPECT_FLOAT_EQ( result_grid_host( i, j, k, 0 ), 0.875 );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Interpolate on a geometrically stretched mesh. Linear splines reproduce a
+// linear nodal field exactly and conserve the interpolated point values.
+void nonUniformInterpolationTest()
+{
+    // Create the global mesh with cells growing by 10 percent.
+    int ncell = 24;
+    std::array<std::vector<double>, 3> edges;
+    for ( int d = 0; d < 3; ++d )
+    {
+        double dx = 0.1 * ( d + 1 );
+        edges[d].push_back( -1.0 );
+        for ( int n = 0; n < ncell; ++n, dx *= 1.1 )
+            edges[d].push_back( edges[d].back() + dx );
+    }
+    auto global_mesh = createNonUniformGlobalMesh( edges[Dim::I], edges[Dim::J],
+                                                   edges[Dim::K] );
+
+    // Create the global grid.
+    DimBlockPartitioner<3> partitioner;
+    std::array<bool, 3> is_dim_periodic = { false, false, false };
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+
+    // Create a  grid local_grid.
+    int halo_width = 1;
+    auto local_grid = createLocalGrid( global_grid, halo_width );
+    auto local_mesh = createLocalMesh<TEST_DEVICE>( *local_grid );
+
+    // Create a point at an off-center location of every cell and check that
+    // the lookup tables locate it.
+    auto cell_space = local_grid->indexSpace( Own(), Cell(), Local() );
+    int num_point = cell_space.size();
+    Kokkos::View<double* [3], TEST_DEVICE> points(
+        Kokkos::ViewAllocateWithoutInitializing( "points" ), num_point );
+    Kokkos::View<int, TEST_DEVICE> locate_errors( "locate_errors" );
+    Kokkos::parallel_for(
+        "fill_points", createExecutionPolicy( cell_space, TEST_EXECSPACE() ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            int pi = i - halo_width;
+            int pj = j - halo_width;
+            int pk = k - halo_width;
+            int pid = pi + cell_space.extent( Dim::I ) *
+                               ( pj + cell_space.extent( Dim::J ) * pk );
+            int idx[3] = { i, j, k };
+            int idx_p1[3] = { i + 1, j + 1, k + 1 };
+            double x[3];
+            double x_p1[3];
+            local_mesh.coordinates( Node(), idx, x );
+            local_mesh.coordinates( Node(), idx_p1, x_p1 );
+            for ( int d = 0; d < 3; ++d )
+            {
+                points( pid, d ) = x[d] + 0.3 * ( x_p1[d] - x[d] );
+                if ( local_mesh.locateCell( d, points( pid, d ) ) != idx[d] )
+                    Kokkos::atomic_increment( &locate_errors() );
+            }
+        } );
+    auto locate_errors_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), locate_errors );
+    EXPECT_EQ( locate_errors_host(), 0 );
+
+    // Create a linear nodal field including the ghosts.
+    auto layout = createArrayLayout( local_grid, 1, Node() );
+    auto grid_field =
+        createArray<double, TEST_DEVICE>( "grid_field", layout );
+    auto halo = createHalo( *grid_field, FullHaloPattern() );
+    auto grid_view = grid_field->view();
+    auto ghost_node_space = local_grid->indexSpace( Ghost(), Node(), Local() );
+    Kokkos::parallel_for(
+        "fill_grid",
+        createExecutionPolicy( ghost_node_space, TEST_EXECSPACE() ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            int idx[3] = { i, j, k };
+            double x[3];
+            local_mesh.coordinates( Node(), idx, x );
+            grid_view( i, j, k, 0 ) = x[0] + 2.0 * x[1] + 3.0 * x[2];
+        } );
+
+    // Interpolate the field and its gradient to the points.
+    Kokkos::View<double*, TEST_DEVICE> point_value( "point_value",
+                                                   num_point );
+    Kokkos::View<double* [3], TEST_DEVICE> point_gradient( "point_gradient",
+                                                          num_point );
+    g2p( *grid_field, *halo, points, num_point, Spline<1>(),
+         createScalarValueG2P( point_value, 1.0 ) );
+    g2p( *grid_field, *halo, points, num_point, Spline<1>(),
+         createScalarGradientG2P( point_gradient, 1.0 ) );
+    auto points_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), points );
+    auto value_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), point_value );
+    auto gradient_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), point_gradient );
+    for ( int p = 0; p < num_point; ++p )
+    {
+        double ref = points_host( p, 0 ) + 2.0 * points_host( p, 1 ) +
+                     3.0 * points_host( p, 2 );
+        EXPECT_NEAR( value_host( p ), ref, 1.0e-10 );
+        for ( int d = 0; d < 3; ++d )
+            EXPECT_NEAR( gradient_host( p, d ), d + 1.0, 1.0e-10 );
+    }
+
+    // Spread unit point values to the grid. The sum of the owned values is
+    // the number of points.
+    Kokkos::deep_copy( point_value, 1.0 );
+    ArrayOp::assign( *grid_field, 0.0, Ghost() );
+    p2g( createScalarValueP2G( point_value, 1.0 ), points, num_point,
+         Spline<1>(), *halo, *grid_field );
+    auto grid_host = Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                          grid_field->view() );
+    auto node_space = local_grid->indexSpace( Own(), Node(), Local() );
+    double local_sum = 0.0;
+    for ( int i = node_space.min( Dim::I ); i < node_space.max( Dim::I ); ++i )
+        for ( int j = node_space.min( Dim::J ); j < node_space.max( Dim::J );
+              ++j )
+            for ( int k = node_space.min( Dim::K );
+                  k < node_space.max( Dim::K ); ++k )
+                local_sum += grid_host( i, j, k, 0 );
+    double global_sum = 0.0;
+    MPI_Allreduce( &local_sum, &global_sum, 1, MPI_DOUBLE, MPI_SUM,
+                   MPI_COMM_WORLD );
+    EXPECT_NEAR( global_sum, ncell * ncell * ncell, 1.0e-8 );
 }
 
 //---------------------------------------------------------------------------//
@@ -253,6 +618,11 @@ void interpolationTest()
 //---------------------------------------------------------------------------//
 TEST( interpolation, interpolation_test ) { interpolationTest(); }
 
+TEST( interpolation, non_uniform_interpolation_test )
+{
+    nonUniformInterpolationTest();
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
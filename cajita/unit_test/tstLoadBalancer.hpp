@@ -0,0 +1,198 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_DeepCopy.hpp>
+
+#include <Cajita_Array.hpp>
+#include <Cajita_GlobalMesh.hpp>
+#include <Cajita_LoadBalancer.hpp>
+#include <Cajita_LocalMesh.hpp>
+#include <Cajita_SparseDimPartitioner.hpp>
+#include <Cajita_Types.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+using namespace Cajita;
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+void rebalanceTest()
+{
+    constexpr int cell_per_tile_dim = 4;
+    constexpr int tile_per_dim = 8;
+    constexpr int cell_per_dim = tile_per_dim * cell_per_tile_dim;
+    double cell_size = 0.1;
+    std::array<int, 3> global_num_cell = { cell_per_dim, cell_per_dim,
+                                           cell_per_dim };
+    std::array<double, 3> global_low_corner = { 0.0, 0.0, 0.0 };
+    std::array<double, 3> global_high_corner = {
+        cell_size * cell_per_dim, cell_size * cell_per_dim,
+        cell_size * cell_per_dim };
+    auto global_mesh = createUniformGlobalMesh(
+        global_low_corner, global_high_corner, global_num_cell );
+
+    // Start from a uniform partition.
+    using partitioner_type =
+        SparseDimPartitioner<TEST_DEVICE, cell_per_tile_dim>;
+    auto partitioner = std::make_shared<partitioner_type>(
+        MPI_COMM_WORLD, 1.5, cell_per_dim * cell_per_dim * cell_per_dim, 100,
+        global_num_cell );
+    auto ranks_per_dim =
+        partitioner->ranksPerDimension( MPI_COMM_WORLD, global_num_cell );
+    std::array<std::vector<int>, 3> rec_partitions;
+    for ( int d = 0; d < 3; ++d )
+    {
+        for ( int r = 0; r < ranks_per_dim[d]; ++r )
+            rec_partitions[d].push_back( r * tile_per_dim / ranks_per_dim[d] );
+        rec_partitions[d].push_back( tile_per_dim );
+    }
+    partitioner->initializeRecPartition( rec_partitions[0], rec_partitions[1],
+                                         rec_partitions[2] );
+
+    std::array<bool, 3> periodic = { false, false, false };
+    auto balancer = createLoadBalancer( MPI_COMM_WORLD, global_mesh, periodic,
+                                        1, partitioner, 1.0 );
+    auto global_grid = balancer->globalGrid();
+    for ( int d = 0; d < 3; ++d )
+    {
+        int b = global_grid->dimBlockId( d );
+        EXPECT_EQ( global_grid->globalOffset( d ),
+                   rec_partitions[d][b] * cell_per_tile_dim );
+        EXPECT_EQ( global_grid->ownedNumCell( d ),
+                   ( rec_partitions[d][b + 1] - rec_partitions[d][b] ) *
+                       cell_per_tile_dim );
+    }
+
+    // Put one particle in each owned cell and eight in each owned cell of the
+    // first tile layer in i so the initial partition is imbalanced.
+    auto local_grid = balancer->localGrid();
+    auto owned_cells = local_grid->indexSpace( Own(), Cell(), Global() );
+    int num_particle = 0;
+    for ( long i = owned_cells.min( 0 ); i < owned_cells.max( 0 ); ++i )
+        num_particle += ( i < cell_per_tile_dim ? 8 : 1 ) *
+                        owned_cells.extent( 1 ) * owned_cells.extent( 2 );
+    using member_types = Cabana::MemberTypes<double[3]>;
+    Cabana::AoSoA<member_types, Kokkos::HostSpace> particles_host(
+        "particles", num_particle );
+    auto positions_host = Cabana::slice<0>( particles_host );
+    int p = 0;
+    for ( long i = owned_cells.min( 0 ); i < owned_cells.max( 0 ); ++i )
+        for ( long j = owned_cells.min( 1 ); j < owned_cells.max( 1 ); ++j )
+            for ( long k = owned_cells.min( 2 ); k < owned_cells.max( 2 ); ++k )
+                for ( int n = 0; n < ( i < cell_per_tile_dim ? 8 : 1 ); ++n )
+                {
+                    positions_host( p, 0 ) = ( i + 0.5 ) * cell_size;
+                    positions_host( p, 1 ) = ( j + 0.5 ) * cell_size;
+                    positions_host( p, 2 ) = ( k + 0.5 ) * cell_size;
+                    ++p;
+                }
+    auto particles =
+        Cabana::create_mirror_view_and_copy( TEST_MEMSPACE(), particles_host );
+    auto positions = Cabana::slice<0>( particles );
+
+    // Fill an array with its global cell indices.
+    auto layout = createArrayLayout( local_grid, 3, Cell() );
+    auto array = createArray<double, TEST_DEVICE>( "array", layout );
+    auto array_host = Kokkos::create_mirror_view( array->view() );
+    auto owned_local = local_grid->indexSpace( Own(), Cell(), Local() );
+    for ( long i = 0; i < owned_cells.extent( 0 ); ++i )
+        for ( long j = 0; j < owned_cells.extent( 1 ); ++j )
+            for ( long k = 0; k < owned_cells.extent( 2 ); ++k )
+                for ( int n = 0; n < 3; ++n )
+                    array_host( i + owned_local.min( 0 ),
+                                j + owned_local.min( 1 ),
+                                k + owned_local.min( 2 ), n ) =
+                        ( n == 0 ? i + owned_cells.min( 0 )
+                                 : n == 1 ? j + owned_cells.min( 1 )
+                                          : k + owned_cells.min( 2 ) );
+    Kokkos::deep_copy( array->view(), array_host );
+
+    // Rebalance on the particle count.
+    balancer->rebalance( num_particle, positions, particles, array );
+
+    // The blocks still tile the global grid.
+    global_grid = balancer->globalGrid();
+    local_grid = balancer->localGrid();
+    int owned_num_cell = 1;
+    for ( int d = 0; d < 3; ++d )
+        owned_num_cell *= global_grid->ownedNumCell( d );
+    int total_num_cell = 0;
+    MPI_Allreduce( &owned_num_cell, &total_num_cell, 1, MPI_INT, MPI_SUM,
+                   MPI_COMM_WORLD );
+    EXPECT_EQ( total_num_cell, cell_per_dim * cell_per_dim * cell_per_dim );
+
+    // No particle was lost and every particle is on its owning rank.
+    int local_num_particle = particles.size();
+    int total_num_particle = 0;
+    MPI_Allreduce( &local_num_particle, &total_num_particle, 1, MPI_INT,
+                   MPI_SUM, MPI_COMM_WORLD );
+    EXPECT_EQ( total_num_particle,
+               ( 7 * cell_per_tile_dim + cell_per_dim ) * cell_per_dim *
+                   cell_per_dim );
+    auto particles_mirror =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), particles );
+    auto positions_mirror = Cabana::slice<0>( particles_mirror );
+    auto local_mesh = createLocalMesh<Kokkos::HostSpace>( *local_grid );
+    for ( std::size_t n = 0; n < particles_mirror.size(); ++n )
+        for ( int d = 0; d < 3; ++d )
+        {
+            EXPECT_GE( positions_mirror( n, d ),
+                       local_mesh.lowCorner( Own(), d ) );
+            EXPECT_LE( positions_mirror( n, d ),
+                       local_mesh.highCorner( Own(), d ) );
+        }
+
+    // The array moved with its cells.
+    EXPECT_EQ( array->layout()->localGrid(), local_grid );
+    owned_cells = local_grid->indexSpace( Own(), Cell(), Global() );
+    owned_local = local_grid->indexSpace( Own(), Cell(), Local() );
+    auto array_mirror = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), array->view() );
+    for ( long i = 0; i < owned_cells.extent( 0 ); ++i )
+        for ( long j = 0; j < owned_cells.extent( 1 ); ++j )
+            for ( long k = 0; k < owned_cells.extent( 2 ); ++k )
+            {
+                EXPECT_EQ( array_mirror( i + owned_local.min( 0 ),
+                                         j + owned_local.min( 1 ),
+                                         k + owned_local.min( 2 ), 0 ),
+                           i + owned_cells.min( 0 ) );
+                EXPECT_EQ( array_mirror( i + owned_local.min( 0 ),
+                                         j + owned_local.min( 1 ),
+                                         k + owned_local.min( 2 ), 1 ),
+                           j + owned_cells.min( 1 ) );
+                EXPECT_EQ( array_mirror( i + owned_local.min( 0 ),
+                                         j + owned_local.min( 1 ),
+                                         k + owned_local.min( 2 ), 2 ),
+                           k + owned_cells.min( 2 ) );
+            }
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, rebalance_test )
+{
+    rebalanceTest();
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
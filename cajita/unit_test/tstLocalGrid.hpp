@@ -3352,6 +3352,82 @@ void notPeriodicTest2d()
     MPI_Comm_free( &serial_comm );
 }
 
+//---------------------------------------------------------------------------//
+template <std::size_t NumSpaceDim, class EntityType>
+void checkCachedSpaces( const LocalGrid<UniformMesh<double, NumSpaceDim>>& a,
+                        const LocalGrid<UniformMesh<double, NumSpaceDim>>& b,
+                        EntityType e )
+{
+    EXPECT_TRUE( a.indexSpace( Own(), e, Local() ) ==
+                 b.indexSpace( Own(), e, Local() ) );
+    EXPECT_TRUE( a.indexSpace( Ghost(), e, Local() ) ==
+                 b.indexSpace( Ghost(), e, Local() ) );
+    EXPECT_TRUE( a.indexSpace( Own(), e, Global() ) ==
+                 b.indexSpace( Own(), e, Global() ) );
+
+    std::array<int, NumSpaceDim> off_ijk;
+    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+        off_ijk[d] = 1;
+    off_ijk[0] = -1;
+    EXPECT_TRUE( a.sharedIndexSpace( Own(), e, off_ijk ) ==
+                 b.sharedIndexSpace( Own(), e, off_ijk ) );
+    EXPECT_TRUE( a.sharedIndexSpace( Ghost(), e, off_ijk, 1 ) ==
+                 b.sharedIndexSpace( Ghost(), e, off_ijk, 1 ) );
+    EXPECT_TRUE( a.boundaryIndexSpace( Own(), e, off_ijk ) ==
+                 b.boundaryIndexSpace( Own(), e, off_ijk ) );
+    EXPECT_TRUE( a.boundaryIndexSpace( Ghost(), e, off_ijk ) ==
+                 b.boundaryIndexSpace( Ghost(), e, off_ijk ) );
+}
+
+//---------------------------------------------------------------------------//
+template <std::size_t NumSpaceDim>
+void cacheTest( const std::size_t num_entity_type )
+{
+    DimBlockPartitioner<NumSpaceDim> partitioner;
+    std::array<int, NumSpaceDim> global_num_cell;
+    std::array<double, NumSpaceDim> global_low_corner;
+    std::array<double, NumSpaceDim> global_high_corner;
+    std::array<bool, NumSpaceDim> is_dim_periodic;
+    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+    {
+        global_num_cell[d] = 21 + d;
+        global_low_corner[d] = -1.0;
+        global_high_corner[d] = 1.0;
+        is_dim_periodic[d] = false;
+    }
+    auto global_mesh = createUniformGlobalMesh(
+        global_low_corner, global_high_corner, global_num_cell );
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+
+    // Cache every space in one grid and compare with spaces computed on
+    // request in another.
+    int halo_width = 2;
+    auto local_grid = createLocalGrid( global_grid, halo_width );
+    auto precomputed_grid = createLocalGrid( global_grid, halo_width );
+    EXPECT_EQ( precomputed_grid->numCachedIndexSpace(), 0u );
+    precomputed_grid->precomputeIndexSpaces();
+
+    // Three index spaces and four shared or boundary spaces per neighbor
+    // offset for each entity type.
+    std::size_t num_offset = 1;
+    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+        num_offset *= 3;
+    std::size_t num_cached = num_entity_type * ( 3 + 4 * ( num_offset - 1 ) );
+    EXPECT_EQ( precomputed_grid->numCachedIndexSpace(), num_cached );
+
+    checkCachedSpaces( *local_grid, *precomputed_grid, Cell() );
+    checkCachedSpaces( *local_grid, *precomputed_grid, Node() );
+    checkCachedSpaces( *local_grid, *precomputed_grid, Face<Dim::I>() );
+    checkCachedSpaces( *local_grid, *precomputed_grid, Face<Dim::J>() );
+
+    // Only the requested halo width is a new entry.
+    EXPECT_EQ( precomputed_grid->numCachedIndexSpace(), num_cached + 4 );
+
+    precomputed_grid->clearIndexSpaceCache();
+    EXPECT_EQ( precomputed_grid->numCachedIndexSpace(), 0u );
+}
+
 //---------------------------------------------------------------------------//
 // RUN TESTS
 //---------------------------------------------------------------------------//
@@ -3367,6 +3443,10 @@ TEST( local_grid, 2d_api_test )
     notPeriodicTest2d();
 }
 
+TEST( local_grid, 3d_cache_test ) { cacheTest<3>( 10 ); }
+
+TEST( local_grid, 2d_cache_test ) { cacheTest<2>( 4 ); }
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
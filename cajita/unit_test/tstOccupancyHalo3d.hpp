@@ -0,0 +1,220 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cajita_Array.hpp>
+#include <Cajita_GlobalGrid.hpp>
+#include <Cajita_GlobalMesh.hpp>
+#include <Cajita_Halo.hpp>
+#include <Cajita_IndexConversion.hpp>
+#include <Cajita_OccupancyHalo.hpp>
+#include <Cajita_Parallel.hpp>
+#include <Cajita_Partitioner.hpp>
+#include <Cajita_Types.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <array>
+#include <memory>
+
+using namespace Cajita;
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+// Check that two arrays are equal in the owned or the ghost only entities.
+template <class Array>
+void checkEqual( const Array& a, const Array& b, const bool owned )
+{
+    auto owned_space = a.layout()->indexSpace( Own(), Local() );
+    auto ghosted_space = a.layout()->indexSpace( Ghost(), Local() );
+    auto a_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), a.view() );
+    auto b_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), b.view() );
+    int num_error = 0;
+    for ( long i = ghosted_space.min( 0 ); i < ghosted_space.max( 0 ); ++i )
+        for ( long j = ghosted_space.min( 1 ); j < ghosted_space.max( 1 ); ++j )
+            for ( long k = ghosted_space.min( 2 ); k < ghosted_space.max( 2 );
+                  ++k )
+            {
+                bool is_owned =
+                    ( i >= owned_space.min( 0 ) && i < owned_space.max( 0 ) &&
+                      j >= owned_space.min( 1 ) && j < owned_space.max( 1 ) &&
+                      k >= owned_space.min( 2 ) && k < owned_space.max( 2 ) );
+                if ( is_owned != owned )
+                    continue;
+                for ( long l = 0; l < ghosted_space.extent( 3 ); ++l )
+                    if ( a_host( i, j, k, l ) != b_host( i, j, k, l ) )
+                        ++num_error;
+            }
+    EXPECT_EQ( num_error, 0 );
+}
+
+//---------------------------------------------------------------------------//
+// Zero the entities of an array that are not occupied.
+template <class Array, class Mask>
+void applyMask( const Array& array, const Mask& mask )
+{
+    auto view = array.view();
+    auto space = array.layout()->indexSpace( Ghost(), Local() );
+    grid_parallel_for(
+        "apply_mask", TEST_EXECSPACE(), space,
+        KOKKOS_LAMBDA( const int i, const int j, const int k, const int l ) {
+            if ( 0 == mask( i, j, k ) )
+                view( i, j, k, l ) = 0.0;
+        } );
+    Kokkos::fence();
+}
+
+//---------------------------------------------------------------------------//
+void occupancyTest( const std::array<bool, 3>& is_dim_periodic )
+{
+    // Create the global grid.
+    double cell_size = 0.23;
+    std::array<int, 3> global_num_cell = { 17, 20, 21 };
+    std::array<double, 3> global_low_corner = { 1.2, 3.3, -2.8 };
+    std::array<double, 3> global_high_corner = {
+        global_low_corner[0] + cell_size * global_num_cell[0],
+        global_low_corner[1] + cell_size * global_num_cell[1],
+        global_low_corner[2] + cell_size * global_num_cell[2] };
+    auto global_mesh = createUniformGlobalMesh(
+        global_low_corner, global_high_corner, global_num_cell );
+    auto global_grid =
+        createGlobalGrid( MPI_COMM_WORLD, global_mesh, is_dim_periodic,
+                          DimBlockPartitioner<3>() );
+
+    // Create cell arrays.
+    unsigned halo_width = 2;
+    auto layout = createArrayLayout( global_grid, halo_width, 3, Cell() );
+    auto array = createArray<double, TEST_DEVICE>( "array", layout );
+    auto expected = createArray<double, TEST_DEVICE>( "expected", layout );
+    auto local_grid = layout->localGrid();
+    auto ghosted_space = layout->indexSpace( Ghost(), Local() );
+
+    // Occupy every third cell along the diagonals of the global grid. The
+    // mask is consistent across ranks as it depends on the global indices
+    // only.
+    Kokkos::View<int***, TEST_MEMSPACE> mask(
+        "mask", ghosted_space.extent( 0 ), ghosted_space.extent( 1 ),
+        ghosted_space.extent( 2 ) );
+    auto l2g = IndexConversion::createL2G( *local_grid, Cell() );
+    auto cell_space = local_grid->indexSpace( Ghost(), Cell(), Local() );
+    grid_parallel_for(
+        "fill_mask", TEST_EXECSPACE(), cell_space,
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            int gi, gj, gk;
+            l2g( i, j, k, gi, gj, gk );
+            mask( i, j, k ) = ( 0 == ( gi + gj + gk ) % 3 ) ? 1 : 0;
+        } );
+    Kokkos::fence();
+    Kokkos::View<int***, TEST_MEMSPACE> full_mask(
+        "full_mask", ghosted_space.extent( 0 ), ghosted_space.extent( 1 ),
+        ghosted_space.extent( 2 ) );
+    Kokkos::deep_copy( full_mask, 1 );
+    Kokkos::View<int***, TEST_MEMSPACE> empty_mask(
+        "empty_mask", ghosted_space.extent( 0 ), ghosted_space.extent( 1 ),
+        ghosted_space.extent( 2 ) );
+
+    // Reference halo.
+    auto halo = createHalo( FullHaloPattern(), halo_width, *expected );
+
+    // With single cell tiles the gather is a full gather of the masked owned
+    // data.
+    {
+        auto occupancy_halo =
+            createOccupancyHalo( FullHaloPattern(), halo_width, 1, *array );
+        EXPECT_EQ( occupancy_halo->tileSize(), 1 );
+
+        ArrayOp::assign( *array, 0.0, Ghost() );
+        ArrayOp::assign( *array, 1.0, Own() );
+        occupancy_halo->gather( TEST_EXECSPACE(), *array, mask );
+
+        ArrayOp::assign( *expected, 0.0, Ghost() );
+        ArrayOp::assign( *expected, 1.0, Own() );
+        applyMask( *expected, mask );
+        halo->gather( TEST_EXECSPACE(), *expected );
+        checkEqual( *array, *expected, false );
+
+        // Only the occupied tiles are sent.
+        EXPECT_LE( occupancy_halo->numSentTiles(),
+                   occupancy_halo->numTiles() );
+        if ( occupancy_halo->numTiles() > 0 )
+        {
+            EXPECT_GT( occupancy_halo->numSentTiles(), 0u );
+            EXPECT_LT( occupancy_halo->numSentTiles(),
+                       occupancy_halo->numTiles() );
+        }
+
+        // Scatter the occupied ghosts.
+        ArrayOp::assign( *array, 1.0, Ghost() );
+        occupancy_halo->scatter( TEST_EXECSPACE(), ScatterReduce::Sum(),
+                                 *array, mask );
+
+        ArrayOp::assign( *expected, 1.0, Ghost() );
+        applyMask( *expected, mask );
+        ArrayOp::assign( *expected, 1.0, Own() );
+        halo->scatter( TEST_EXECSPACE(), ScatterReduce::Sum(), *expected );
+        checkEqual( *array, *expected, true );
+    }
+
+    // With larger tiles and a full mask the exchanges are full exchanges.
+    {
+        auto occupancy_halo =
+            createOccupancyHalo( FullHaloPattern(), halo_width, 4, *array );
+
+        ArrayOp::assign( *array, 0.0, Ghost() );
+        ArrayOp::assign( *array, 1.0, Own() );
+        occupancy_halo->gather( TEST_EXECSPACE(), *array, full_mask );
+        EXPECT_EQ( occupancy_halo->numSentTiles(),
+                   occupancy_halo->numTiles() );
+
+        ArrayOp::assign( *expected, 0.0, Ghost() );
+        ArrayOp::assign( *expected, 1.0, Own() );
+        halo->gather( TEST_EXECSPACE(), *expected );
+        checkEqual( *array, *expected, false );
+
+        occupancy_halo->scatter( TEST_EXECSPACE(), ScatterReduce::Sum(),
+                                 *array, full_mask );
+        halo->scatter( TEST_EXECSPACE(), ScatterReduce::Sum(), *expected );
+        checkEqual( *array, *expected, true );
+
+        // Nothing is sent with an empty mask and the ghosts are unchanged.
+        ArrayOp::assign( *array, 0.0, Ghost() );
+        ArrayOp::assign( *array, 1.0, Own() );
+        occupancy_halo->gather( TEST_EXECSPACE(), *array, empty_mask );
+        EXPECT_EQ( occupancy_halo->numSentTiles(), 0u );
+        ArrayOp::assign( *expected, 0.0, Ghost() );
+        ArrayOp::assign( *expected, 1.0, Own() );
+        checkEqual( *array, *expected, false );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, periodic_occupancy_test )
+{
+    occupancyTest( { true, true, true } );
+}
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, not_periodic_occupancy_test )
+{
+    occupancyTest( { false, false, false } );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
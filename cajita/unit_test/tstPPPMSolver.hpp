@@ -0,0 +1,324 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_Sort.hpp>
+
+#include <Cajita_GlobalGrid.hpp>
+#include <Cajita_GlobalMesh.hpp>
+#include <Cajita_LocalGrid.hpp>
+#include <Cajita_PPPMSolver.hpp>
+#include <Cajita_Partitioner.hpp>
+#include <Cajita_Splines.hpp>
+#include <Cajita_Types.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+using namespace Cajita;
+
+namespace Test
+{
+
+//---------------------------------------------------------------------------//
+// Compare the long-range part of the PPPM solve to a direct Ewald sum in
+// reciprocal space.
+template <int SplineOrder>
+void longRangeTest( const double tolerance )
+{
+    // Create a periodic cube.
+    double box = 4.0;
+    double cell_size = 0.125;
+    std::array<bool, 3> is_dim_periodic = { true, true, true };
+    std::array<double, 3> low_corner = { 0.0, 0.0, 0.0 };
+    std::array<double, 3> high_corner = { box, box, box };
+    auto global_mesh =
+        createUniformGlobalMesh( low_corner, high_corner, cell_size );
+    DimBlockPartitioner<3> partitioner;
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+    auto local_grid = createLocalGrid( global_grid, SplineOrder / 2 + 1 );
+
+    // Create a neutral set of charges.
+    int num_global = 8;
+    std::vector<std::array<double, 3>> global_x = {
+        { 0.31, 1.27, 2.05 }, { 3.62, 0.44, 1.18 }, { 1.93, 2.71, 3.33 },
+        { 2.48, 3.86, 0.57 }, { 0.92, 3.14, 1.71 }, { 3.05, 2.22, 2.94 },
+        { 1.46, 0.83, 0.26 }, { 2.77, 1.59, 3.78 } };
+    std::vector<double> global_q = { 1.0, -1.0, 0.5, -0.5,
+                                     -1.5, 1.5, 2.0, -2.0 };
+
+    // Keep the charges in the owned domain of this rank.
+    std::vector<int> local_ids;
+    for ( int n = 0; n < num_global; ++n )
+    {
+        bool owned = true;
+        for ( int d = 0; d < 3; ++d )
+        {
+            double low = global_grid->globalOffset( d ) * cell_size;
+            double high = low + global_grid->ownedNumCell( d ) * cell_size;
+            owned = owned && global_x[n][d] >= low && global_x[n][d] < high;
+        }
+        if ( owned )
+            local_ids.push_back( n );
+    }
+    int num_point = local_ids.size();
+    Kokkos::View<double* [3], Kokkos::HostSpace> positions_host( "positions",
+                                                                 num_point );
+    Kokkos::View<double*, Kokkos::HostSpace> charges_host( "charges",
+                                                          num_point );
+    for ( int p = 0; p < num_point; ++p )
+    {
+        for ( int d = 0; d < 3; ++d )
+            positions_host( p, d ) = global_x[local_ids[p]][d];
+        charges_host( p ) = global_q[local_ids[p]];
+    }
+    auto positions =
+        Kokkos::create_mirror_view_and_copy( TEST_MEMSPACE(), positions_host );
+    auto charges =
+        Kokkos::create_mirror_view_and_copy( TEST_MEMSPACE(), charges_host );
+    Kokkos::View<double*, TEST_MEMSPACE> potential( "potential", num_point );
+    Kokkos::View<double* [3], TEST_MEMSPACE> field( "field", num_point );
+
+    // Solve.
+    double alpha = 1.5;
+    auto pppm = Experimental::createPPPMSolver<TEST_DEVICE>(
+        local_grid, Spline<SplineOrder>(), alpha );
+    double energy =
+        pppm->compute( positions, charges, num_point, potential, field );
+    auto potential_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), potential );
+    auto field_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), field );
+
+    // Compute the reciprocal space Ewald sum directly.
+    double volume = box * box * box;
+    double ref_energy = 0.0;
+    std::vector<double> ref_potential( num_point, 0.0 );
+    std::vector<std::array<double, 3>> ref_field(
+        num_point, std::array<double, 3>{ 0.0, 0.0, 0.0 } );
+    int n_max = 10;
+    for ( int nx = -n_max; nx <= n_max; ++nx )
+        for ( int ny = -n_max; ny <= n_max; ++ny )
+            for ( int nz = -n_max; nz <= n_max; ++nz )
+            {
+                if ( 0 == nx && 0 == ny && 0 == nz )
+                    continue;
+                std::array<double, 3> k = { 2.0 * M_PI * nx / box,
+                                            2.0 * M_PI * ny / box,
+                                            2.0 * M_PI * nz / box };
+                double k2 = k[0] * k[0] + k[1] * k[1] + k[2] * k[2];
+                double green =
+                    4.0 * M_PI * std::exp( -k2 / ( 4.0 * alpha * alpha ) ) / k2;
+                double s_re = 0.0;
+                double s_im = 0.0;
+                for ( int n = 0; n < num_global; ++n )
+                {
+                    double kr = k[0] * global_x[n][0] + k[1] * global_x[n][1] +
+                                k[2] * global_x[n][2];
+                    s_re += global_q[n] * std::cos( kr );
+                    s_im += global_q[n] * std::sin( kr );
+                }
+                ref_energy +=
+                    0.5 * green * ( s_re * s_re + s_im * s_im ) / volume;
+                for ( int p = 0; p < num_point; ++p )
+                {
+                    double kr = k[0] * positions_host( p, 0 ) +
+                                k[1] * positions_host( p, 1 ) +
+                                k[2] * positions_host( p, 2 );
+                    // S(k) exp(-ik.r)
+                    double re = s_re * std::cos( kr ) + s_im * std::sin( kr );
+                    double im = s_im * std::cos( kr ) - s_re * std::sin( kr );
+                    ref_potential[p] += green * re / volume;
+                    for ( int d = 0; d < 3; ++d )
+                        ref_field[p][d] -= green * k[d] * im / volume;
+                }
+            }
+
+    // Check the energy, potential, and field.
+    EXPECT_NEAR( energy, ref_energy, tolerance * std::abs( ref_energy ) );
+    double max_field = 0.0;
+    for ( int p = 0; p < num_point; ++p )
+        for ( int d = 0; d < 3; ++d )
+            max_field = std::max( max_field, std::abs( ref_field[p][d] ) );
+    for ( int p = 0; p < num_point; ++p )
+    {
+        EXPECT_NEAR( potential_host( p ), ref_potential[p],
+                     tolerance * std::abs( ref_potential[p] ) + tolerance );
+        for ( int d = 0; d < 3; ++d )
+            EXPECT_NEAR( field_host( p, d ), ref_field[p][d],
+                         tolerance * max_field );
+    }
+
+    // Spread the charges by bins of one particle each with the same result.
+    using bin_type = Cabana::BinningData<TEST_DEVICE>;
+    Kokkos::View<int*, TEST_DEVICE> bin_counts( "bin_counts", num_point );
+    typename bin_type::OffsetView bin_offsets( "bin_offsets", num_point );
+    typename bin_type::OffsetView bin_permute( "bin_permute", num_point );
+    Kokkos::parallel_for(
+        "fill_bins", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_point ),
+        KOKKOS_LAMBDA( const int p ) {
+            bin_counts( p ) = 1;
+            bin_offsets( p ) = p;
+            bin_permute( p ) = p;
+        } );
+    bin_type bins( 0, num_point, bin_counts, bin_offsets, bin_permute );
+    Kokkos::View<double*, TEST_MEMSPACE> binned_potential( "binned_potential",
+                                                           num_point );
+    Kokkos::View<double* [3], TEST_MEMSPACE> binned_field( "binned_field",
+                                                          num_point );
+    double binned_energy = pppm->compute( positions, charges, num_point, bins,
+                                          binned_potential, binned_field );
+    auto binned_potential_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), binned_potential );
+    auto binned_field_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), binned_field );
+    EXPECT_NEAR( binned_energy, energy, 1.0e-10 * std::abs( energy ) );
+    for ( int p = 0; p < num_point; ++p )
+    {
+        EXPECT_NEAR( binned_potential_host( p ), potential_host( p ), 1.0e-10 );
+        for ( int d = 0; d < 3; ++d )
+            EXPECT_NEAR( binned_field_host( p, d ), field_host( p, d ),
+                         1.0e-10 );
+    }
+
+    // The self energy of the Gaussian charges.
+    double sum_q2 = 0.0;
+    for ( int n = 0; n < num_global; ++n )
+        sum_q2 += global_q[n] * global_q[n];
+    EXPECT_DOUBLE_EQ( pppm->selfEnergy( sum_q2 ),
+                      -alpha / std::sqrt( M_PI ) * sum_q2 );
+}
+
+//---------------------------------------------------------------------------//
+// Compare the short-range part to a direct sum over a neighbor list.
+struct TestPairList
+{
+    Kokkos::View<int*, TEST_MEMSPACE> counts;
+    Kokkos::View<int**, TEST_MEMSPACE> neighbors;
+};
+
+} // end namespace Test
+
+namespace Cabana
+{
+template <>
+class NeighborList<Test::TestPairList>
+{
+  public:
+    using memory_space = TEST_MEMSPACE;
+    KOKKOS_INLINE_FUNCTION
+    static std::size_t numNeighbor( const Test::TestPairList& list,
+                                    const std::size_t particle_index )
+    {
+        return list.counts( particle_index );
+    }
+    KOKKOS_INLINE_FUNCTION
+    static std::size_t getNeighbor( const Test::TestPairList& list,
+                                    const std::size_t particle_index,
+                                    const std::size_t neighbor_index )
+    {
+        return list.neighbors( particle_index, neighbor_index );
+    }
+};
+} // end namespace Cabana
+
+namespace Test
+{
+
+void shortRangeTest()
+{
+    // Two particles within the cutoff and one beyond it.
+    int num_point = 3;
+    Kokkos::View<double* [3], Kokkos::HostSpace> positions_host( "positions",
+                                                                 num_point );
+    Kokkos::View<double*, Kokkos::HostSpace> charges_host( "charges",
+                                                          num_point );
+    std::array<std::array<double, 3>, 3> x = {
+        { { 0.0, 0.0, 0.0 }, { 0.6, 0.8, 0.0 }, { 5.0, 0.0, 0.0 } } };
+    std::array<double, 3> q = { 1.0, -2.0, 3.0 };
+    for ( int p = 0; p < num_point; ++p )
+    {
+        for ( int d = 0; d < 3; ++d )
+            positions_host( p, d ) = x[p][d];
+        charges_host( p ) = q[p];
+    }
+
+    // Every particle neighbors every other particle.
+    TestPairList list;
+    list.counts = Kokkos::View<int*, TEST_MEMSPACE>( "counts", num_point );
+    list.neighbors =
+        Kokkos::View<int**, TEST_MEMSPACE>( "neighbors", num_point, 2 );
+    auto counts_host = Kokkos::create_mirror_view( list.counts );
+    auto neighbors_host = Kokkos::create_mirror_view( list.neighbors );
+    for ( int p = 0; p < num_point; ++p )
+    {
+        counts_host( p ) = 2;
+        neighbors_host( p, 0 ) = ( p + 1 ) % num_point;
+        neighbors_host( p, 1 ) = ( p + 2 ) % num_point;
+    }
+    Kokkos::deep_copy( list.counts, counts_host );
+    Kokkos::deep_copy( list.neighbors, neighbors_host );
+
+    auto positions =
+        Kokkos::create_mirror_view_and_copy( TEST_MEMSPACE(), positions_host );
+    auto charges =
+        Kokkos::create_mirror_view_and_copy( TEST_MEMSPACE(), charges_host );
+    Kokkos::View<double*, TEST_MEMSPACE> potential( "potential", num_point );
+    Kokkos::View<double* [3], TEST_MEMSPACE> field( "field", num_point );
+
+    double alpha = 1.2;
+    double cutoff = 2.0;
+    Experimental::computeRealSpace( TEST_EXECSPACE(), list, positions,
+                                    charges, num_point, alpha, cutoff,
+                                    potential, field );
+    auto potential_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), potential );
+    auto field_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), field );
+
+    // Only the first two particles interact at unit distance.
+    double r = 1.0;
+    double screened = std::erfc( alpha * r ) / r;
+    double e_over_r = ( screened + 2.0 * alpha / std::sqrt( M_PI ) *
+                                       std::exp( -alpha * alpha * r * r ) ) /
+                      ( r * r );
+    EXPECT_DOUBLE_EQ( potential_host( 0 ), q[1] * screened );
+    EXPECT_DOUBLE_EQ( potential_host( 1 ), q[0] * screened );
+    EXPECT_DOUBLE_EQ( potential_host( 2 ), 0.0 );
+    for ( int d = 0; d < 3; ++d )
+    {
+        double dx = x[0][d] - x[1][d];
+        EXPECT_NEAR( field_host( 0, d ), q[1] * e_over_r * dx, 1.0e-12 );
+        EXPECT_NEAR( field_host( 1, d ), -q[0] * e_over_r * dx, 1.0e-12 );
+        EXPECT_DOUBLE_EQ( field_host( 2, d ), 0.0 );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( pppm_solver, long_range_cubic_test ) { longRangeTest<3>( 1.0e-3 ); }
+
+TEST( pppm_solver, long_range_quintic_test ) { longRangeTest<5>( 5.0e-4 ); }
+
+TEST( pppm_solver, short_range_test ) { shortRangeTest(); }
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
@@ -22,6 +22,8 @@
 
 #include <gtest/gtest.h>
 
+#include <mpi.h>
+
 using namespace Cajita;
 
 namespace Test
@@ -396,6 +398,92 @@ void parallelMultiSpaceTest()
                 }
 }
 
+//---------------------------------------------------------------------------//
+void parallelTileTest()
+{
+    // Rank-3 index space with default tiles.
+    IndexSpace<3> is3( { 2, 1, 3 }, { 11, 14, 40 } );
+    Kokkos::View<double***, TEST_DEVICE> v3( "v3", 13, 15, 42 );
+    auto tile = defaultTileSize<3>( TEST_EXECSPACE() );
+    grid_parallel_for(
+        "fill_tiled", TEST_EXECSPACE(), is3, tile,
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            v3( i, j, k ) += 1.0;
+        } );
+
+    // Tags with explicit tiles.
+    TestFunctor2 func2;
+    Kokkos::View<double**, TEST_DEVICE> v2( "v2", 13, 15 );
+    func2.v = v2;
+    IndexSpace<2> is2( { 2, 1 }, { 11, 14 } );
+    grid_parallel_for( "fill_tiled_tag", TEST_EXECSPACE(), is2, ForTag(),
+                       { 4, 2 }, func2 );
+
+    // Tune the tiles of a repeatable kernel and check that every index was
+    // still touched exactly once by it.
+    Kokkos::View<double***, TEST_DEVICE> w3( "w3", 13, 15, 42 );
+    auto candidates = tileSizeCandidates<3>( TEST_EXECSPACE() );
+    EXPECT_FALSE( candidates.empty() );
+    auto best = tuneTileSize(
+        "tune_tiled", TEST_EXECSPACE(), is3,
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            w3( i, j, k ) = v3( i, j, k );
+        },
+        candidates, 1 );
+    bool found = false;
+    for ( auto& c : candidates )
+        if ( c[0] == best[0] && c[1] == best[1] && c[2] == best[2] )
+            found = true;
+    EXPECT_TRUE( found );
+
+    // Tuning over a communicator picks the same tiles on every rank.
+    auto shared_best = tuneTileSize(
+        MPI_COMM_WORLD, "tune_tiled_shared", TEST_EXECSPACE(), is3,
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            w3( i, j, k ) = v3( i, j, k );
+        },
+        candidates, 1 );
+    for ( int d = 0; d < 3; ++d )
+    {
+        long min_tile = 0;
+        long max_tile = 0;
+        MPI_Allreduce( &shared_best[d], &min_tile, 1, MPI_LONG, MPI_MIN,
+                       MPI_COMM_WORLD );
+        MPI_Allreduce( &shared_best[d], &max_tile, 1, MPI_LONG, MPI_MAX,
+                       MPI_COMM_WORLD );
+        EXPECT_EQ( min_tile, max_tile );
+    }
+
+    auto v3_mirror =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), v3 );
+    auto w3_mirror =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), w3 );
+    for ( int i = 0; i < 13; ++i )
+        for ( int j = 0; j < 15; ++j )
+            for ( int k = 0; k < 42; ++k )
+            {
+                double result = ( is3.min( 0 ) <= i && i < is3.max( 0 ) &&
+                                  is3.min( 1 ) <= j && j < is3.max( 1 ) &&
+                                  is3.min( 2 ) <= k && k < is3.max( 2 ) )
+                                    ? 1.0
+                                    : 0.0;
+                EXPECT_EQ( v3_mirror( i, j, k ), result );
+                EXPECT_EQ( w3_mirror( i, j, k ), result );
+            }
+
+    auto v2_mirror =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), v2 );
+    for ( int i = 0; i < 13; ++i )
+        for ( int j = 0; j < 15; ++j )
+        {
+            double result = ( is2.min( 0 ) <= i && i < is2.max( 0 ) &&
+                              is2.min( 1 ) <= j && j < is2.max( 1 ) )
+                                ? 2.0
+                                : 0.0;
+            EXPECT_EQ( v2_mirror( i, j ), result );
+        }
+}
+
 //---------------------------------------------------------------------------//
 // RUN TESTS
 //---------------------------------------------------------------------------//
@@ -405,6 +493,8 @@ TEST( TEST_CATEGORY, parallel_local_grid_test ) { parallelLocalGridTest(); }
 
 TEST( TEST_CATEGORY, parallel_multispace_test ) { parallelMultiSpaceTest(); }
 
+TEST( TEST_CATEGORY, parallel_tile_test ) { parallelTileTest(); }
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
@@ -125,6 +125,32 @@ void migrateTest( const GridType global_grid, const double cell_size,
         particles = Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(),
                                                          particles_dst );
     }
+    // Migrate with a reused neighbor communication plan.
+    else if ( test_type == 2 )
+    {
+        auto migrator =
+            Cajita::createParticleGridMigrator<TEST_DEVICE>( block );
+        migrator->migrate( coords_mirror, particles_mirror );
+
+        // Every particle is now local so a second step exchanges nothing
+        // through the updated plan.
+        coords_mirror = Cabana::slice<0>( particles_mirror, "coords" );
+        migrator->migrate( coords_mirror, particles_mirror );
+
+        // Copy back to check.
+        particles = Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                         particles_mirror );
+    }
+    // Migrate with the periodic shift fused into the pack kernel.
+    else if ( test_type == 3 )
+    {
+        Cajita::particleGridMigrate<0>( *block, particles_mirror,
+                                        test_halo_size, force_comm );
+
+        // Copy back to check.
+        particles = Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                         particles_mirror );
+    }
 
     coords = Cabana::slice<0>( particles, "coords" );
     linear_ids = Cabana::slice<1>( particles, "linear_ids" );
@@ -288,6 +314,12 @@ void testParticleGridMigrate( const bool periodic )
     // Retest with separate destination AoSoA.
     migrateTest( global_grid, cell_size, 2, 2, true, 1 );
 
+    // Retest with a reused neighbor communication plan.
+    migrateTest( global_grid, cell_size, 2, 2, true, 2 );
+
+    // Retest with the periodic shift fused into the migration.
+    migrateTest( global_grid, cell_size, 2, 2, true, 3 );
+
     // Test with forced communication.
     migrateTest( global_grid, cell_size, 2, 2, true, 0 );
 
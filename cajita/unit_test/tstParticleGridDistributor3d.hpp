@@ -28,6 +28,7 @@
 #include <mpi.h>
 
 #include <algorithm>
+#include <cmath>
 #include <memory>
 #include <vector>
 
@@ -134,6 +135,32 @@ void migrateTest( const GridType global_grid, const double cell_size,
         particles = Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(),
                                                          particles_dst );
     }
+    // Migrate with a reused neighbor communication plan.
+    else if ( test_type == 2 )
+    {
+        auto migrator =
+            Cajita::createParticleGridMigrator<TEST_DEVICE>( block );
+        migrator->migrate( coords_mirror, particles_mirror );
+
+        // Every particle is now local so a second step exchanges nothing
+        // through the updated plan.
+        coords_mirror = Cabana::slice<0>( particles_mirror, "coords" );
+        migrator->migrate( coords_mirror, particles_mirror );
+
+        // Copy back to check.
+        particles = Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                         particles_mirror );
+    }
+    // Migrate with the periodic shift fused into the pack kernel.
+    else if ( test_type == 3 )
+    {
+        Cajita::particleGridMigrate<0>( *block, particles_mirror,
+                                        test_halo_size, force_comm );
+
+        // Copy back to check.
+        particles = Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                         particles_mirror );
+    }
 
     coords = Cabana::slice<0>( particles, "coords" );
     linear_ids = Cabana::slice<1>( particles, "linear_ids" );
@@ -262,6 +289,70 @@ void localOnlyTest( const GridType global_grid, const double cell_size )
         }
 }
 
+//---------------------------------------------------------------------------//
+// The objective of this test is to check the migration of particles located
+// anywhere in the global domain to their owning ranks, such as after a
+// parallel read of initial conditions.
+template <class GridType>
+void ownerMigrateTest( const GridType global_grid )
+{
+    int comm_rank;
+    MPI_Comm_rank( MPI_COMM_WORLD, &comm_rank );
+    auto block = Cajita::createLocalGrid( global_grid, 0 );
+    auto local_mesh = Cajita::createLocalMesh<Kokkos::HostSpace>( *block );
+    const auto& global_mesh = global_grid->globalMesh();
+
+    // Scatter particles over the whole domain. Particles beyond periodic
+    // boundaries are wrapped.
+    int num_particle = 97;
+    using MemberTypes = Cabana::MemberTypes<double[3], int>;
+    using ParticleContainer = Cabana::AoSoA<MemberTypes, Kokkos::HostSpace>;
+    ParticleContainer particles( "particles", num_particle );
+    auto coords = Cabana::slice<0>( particles, "coords" );
+    auto ids = Cabana::slice<1>( particles, "ids" );
+    for ( int p = 0; p < num_particle; ++p )
+    {
+        for ( int d = 0; d < 3; ++d )
+        {
+            double f = ( p + 1 ) * ( 0.618034 + 0.1 * d ) + 0.377 * comm_rank;
+            f -= std::floor( f );
+            coords( p, d ) =
+                global_mesh.lowCorner( d ) + f * global_mesh.extent( d );
+            if ( global_grid->isPeriodic( d ) && p % 5 == d )
+                coords( p, d ) += global_mesh.extent( d );
+        }
+        ids( p ) = 1;
+    }
+    auto particles_mirror =
+        Cabana::create_mirror_view_and_copy( TEST_DEVICE(), particles );
+    Cajita::particleGridOwnerMigrate<0>( *block, particles_mirror );
+    particles = Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                     particles_mirror );
+    coords = Cabana::slice<0>( particles, "coords" );
+    ids = Cabana::slice<1>( particles, "ids" );
+
+    // Check that no particles are lost.
+    int num_local = 0;
+    for ( std::size_t p = 0; p < particles.size(); ++p )
+        num_local += ids( p );
+    int num_global = 0;
+    MPI_Allreduce( &num_local, &num_global, 1, MPI_INT, MPI_SUM,
+                   MPI_COMM_WORLD );
+    int comm_size;
+    MPI_Comm_size( MPI_COMM_WORLD, &comm_size );
+    EXPECT_EQ( num_global, num_particle * comm_size );
+
+    // Check that all of the particles are now in the local domain.
+    for ( std::size_t p = 0; p < particles.size(); ++p )
+        for ( int d = 0; d < 3; ++d )
+        {
+            EXPECT_GE( coords( p, d ),
+                       local_mesh.lowCorner( Cajita::Own(), d ) );
+            EXPECT_LE( coords( p, d ),
+                       local_mesh.highCorner( Cajita::Own(), d ) );
+        }
+}
+
 auto createGrid( const Cajita::ManualPartitioner& partitioner,
                  const std::array<bool, 3>& is_periodic,
                  const double cell_size )
@@ -306,9 +397,18 @@ void testParticleGridMigrate( const bool periodic )
     // Retest with separate destination AoSoA.
     migrateTest( global_grid, cell_size, 2, 2, true, 1 );
 
+    // Retest with a reused neighbor communication plan.
+    migrateTest( global_grid, cell_size, 2, 2, true, 2 );
+
+    // Retest with the periodic shift fused into the migration.
+    migrateTest( global_grid, cell_size, 2, 2, true, 3 );
+
     // Test with forced communication.
     migrateTest( global_grid, cell_size, 2, 2, true, 0 );
 
+    // Test the migration to owning ranks from anywhere in the domain.
+    ownerMigrateTest( global_grid );
+
     // Test with different block configurations to make sure all the
     // dimensions get partitioned even at small numbers of ranks.
     if ( ranks_per_dim[0] != ranks_per_dim[1] )
@@ -0,0 +1,176 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_DeepCopy.hpp>
+
+#include <Cajita_GlobalGrid.hpp>
+#include <Cajita_GlobalMesh.hpp>
+#include <Cajita_LocalGrid.hpp>
+#include <Cajita_LocalMesh.hpp>
+#include <Cajita_ManualPartitioner.hpp>
+#include <Cajita_ParticleGridHalo.hpp>
+#include <Cajita_Types.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <array>
+#include <cmath>
+
+namespace Test
+{
+
+using Cajita::Dim;
+
+//---------------------------------------------------------------------------//
+// Check that every ghost cell of a neighbor block holds exactly one ghost.
+template <class LocalGridType, class AoSoAType>
+void checkGhosts( const LocalGridType& local_grid, const AoSoAType& particles,
+                  const std::size_t num_local, const double cell_size )
+{
+    auto local_mesh = Cajita::createLocalMesh<Kokkos::HostSpace>( local_grid );
+    auto ghost_space = local_grid.indexSpace( Cajita::Ghost(), Cajita::Cell(),
+                                              Cajita::Local() );
+    auto own_space = local_grid.indexSpace( Cajita::Own(), Cajita::Cell(),
+                                            Cajita::Local() );
+    Kokkos::View<int***, Kokkos::HostSpace> count(
+        "count", ghost_space.extent( Dim::I ), ghost_space.extent( Dim::J ),
+        ghost_space.extent( Dim::K ) );
+
+    auto coords = Cabana::slice<0>( particles );
+    for ( std::size_t p = num_local; p < particles.size(); ++p )
+    {
+        std::array<int, 3> c;
+        for ( int d = 0; d < 3; ++d )
+        {
+            c[d] = static_cast<int>( std::floor(
+                ( coords( p, d ) -
+                  local_mesh.lowCorner( Cajita::Ghost(), d ) ) /
+                cell_size ) );
+            ASSERT_GE( c[d], 0 );
+            ASSERT_LT( c[d], ghost_space.max( d ) );
+        }
+        ++count( c[Dim::I], c[Dim::J], c[Dim::K] );
+    }
+
+    for ( int i = 0; i < ghost_space.max( Dim::I ); ++i )
+        for ( int j = 0; j < ghost_space.max( Dim::J ); ++j )
+            for ( int k = 0; k < ghost_space.max( Dim::K ); ++k )
+            {
+                std::array<int, 3> c = { i, j, k };
+                std::array<int, 3> nid;
+                for ( int d = 0; d < 3; ++d )
+                    nid[d] = ( c[d] < own_space.min( d ) )
+                                 ? -1
+                                 : ( c[d] < own_space.max( d ) ? 0 : 1 );
+                bool ghost_cell = ( nid[0] != 0 || nid[1] != 0 ||
+                                    nid[2] != 0 ) &&
+                                  local_grid.neighborRank( nid ) >= 0;
+                EXPECT_EQ( count( i, j, k ), ghost_cell ? 1 : 0 );
+            }
+}
+
+//---------------------------------------------------------------------------//
+void haloTest( const bool periodic )
+{
+    int comm_size;
+    MPI_Comm_size( MPI_COMM_WORLD, &comm_size );
+    std::array<int, 3> ranks_per_dim = { 0, 0, 0 };
+    MPI_Dims_create( comm_size, 3, ranks_per_dim.data() );
+    Cajita::ManualPartitioner partitioner( ranks_per_dim );
+
+    // Create the grid.
+    double cell_size = 0.23;
+    std::array<int, 3> global_num_cell = { 18, 15, 9 };
+    std::array<double, 3> global_low_corner = { 1.2, 3.3, -2.8 };
+    std::array<double, 3> global_high_corner = {
+        global_low_corner[0] + cell_size * global_num_cell[0],
+        global_low_corner[1] + cell_size * global_num_cell[1],
+        global_low_corner[2] + cell_size * global_num_cell[2] };
+    auto global_mesh = Cajita::createUniformGlobalMesh(
+        global_low_corner, global_high_corner, global_num_cell );
+    std::array<bool, 3> is_periodic = { periodic, periodic, periodic };
+    auto global_grid = Cajita::createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                                 is_periodic, partitioner );
+    int halo_width = 1;
+    auto local_grid = Cajita::createLocalGrid( global_grid, halo_width );
+    auto local_mesh = Cajita::createLocalMesh<Kokkos::HostSpace>( *local_grid );
+
+    // Put a particle at the center of every owned cell.
+    auto own_space = local_grid->indexSpace( Cajita::Own(), Cajita::Cell(),
+                                             Cajita::Local() );
+    int num_local = own_space.size();
+    using ParticleTypes = Cabana::MemberTypes<double[3]>;
+    Cabana::AoSoA<ParticleTypes, Kokkos::HostSpace> particles_host(
+        "particles_host", num_local );
+    auto coords_host = Cabana::slice<0>( particles_host );
+    int pid = 0;
+    for ( int i = own_space.min( Dim::I ); i < own_space.max( Dim::I ); ++i )
+        for ( int j = own_space.min( Dim::J ); j < own_space.max( Dim::J );
+              ++j )
+            for ( int k = own_space.min( Dim::K );
+                  k < own_space.max( Dim::K ); ++k, ++pid )
+            {
+                std::array<int, 3> c = { i, j, k };
+                for ( int d = 0; d < 3; ++d )
+                    coords_host( pid, d ) =
+                        local_mesh.lowCorner( Cajita::Ghost(), d ) +
+                        ( c[d] + 0.5 ) * cell_size;
+            }
+    auto particles =
+        Cabana::create_mirror_view_and_copy( TEST_MEMSPACE(), particles_host );
+    auto coords = Cabana::slice<0>( particles );
+
+    // Create the halo and gather the ghosts.
+    auto halo = Cajita::createParticleHalo( *local_grid, coords, halo_width );
+    EXPECT_EQ( halo.numLocal(), static_cast<std::size_t>( num_local ) );
+    halo.gather<0>( particles );
+    EXPECT_EQ( particles.size(), halo.numLocal() + halo.numGhost() );
+    particles_host =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), particles );
+    checkGhosts( *local_grid, particles_host, num_local, cell_size );
+
+    // Move the owned particles and update the ghosts. The ghosts move with
+    // their owners.
+    double delta = 0.1 * cell_size;
+    coords = Cabana::slice<0>( particles );
+    Kokkos::parallel_for(
+        "move", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_local ),
+        KOKKOS_LAMBDA( const int p ) {
+            for ( int d = 0; d < 3; ++d )
+                coords( p, d ) += delta;
+        } );
+    halo.updatePositions( coords );
+    auto updated_host =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), particles );
+    auto updated_coords = Cabana::slice<0>( updated_host );
+    coords_host = Cabana::slice<0>( particles_host );
+    for ( std::size_t p = 0; p < particles.size(); ++p )
+        for ( int d = 0; d < 3; ++d )
+            EXPECT_NEAR( updated_coords( p, d ), coords_host( p, d ) + delta,
+                         1e-12 );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, not_periodic_test ) { haloTest( false ); }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, periodic_test ) { haloTest( true ); }
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
@@ -0,0 +1,572 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cajita_Array.hpp>
+#include <Cajita_GlobalGrid.hpp>
+#include <Cajita_GlobalMesh.hpp>
+#include <Cajita_Partitioner.hpp>
+#include <Cajita_ReferenceBatchedSolver.hpp>
+#include <Cajita_ReferenceMultigrid.hpp>
+#include <Cajita_ReferenceStructuredSolver.hpp>
+#include <Cajita_Types.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <vector>
+
+using namespace Cajita;
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+// Matrix-free 7-point Laplacian with zero values outside of the domain.
+struct LaplacianOperator
+{
+    int offset[3];
+    int num_cell[3];
+
+    template <class VectorType>
+    KOKKOS_INLINE_FUNCTION double operator()( const VectorType& v,
+                                              const int i, const int j,
+                                              const int k ) const
+    {
+        int gi = i + offset[Dim::I];
+        int gj = j + offset[Dim::J];
+        int gk = k + offset[Dim::K];
+        double result = 6.0 * v( i, j, k );
+        if ( gi - 1 >= 0 )
+            result -= v( i - 1, j, k );
+        if ( gi + 1 < num_cell[Dim::I] )
+            result -= v( i + 1, j, k );
+        if ( gj - 1 >= 0 )
+            result -= v( i, j - 1, k );
+        if ( gj + 1 < num_cell[Dim::J] )
+            result -= v( i, j + 1, k );
+        if ( gk - 1 >= 0 )
+            result -= v( i, j, k - 1 );
+        if ( gk + 1 < num_cell[Dim::K] )
+            result -= v( i, j, k + 1 );
+        return result;
+    }
+};
+
+// Matrix-free Jacobi preconditioner of the Laplacian.
+struct JacobiOperator
+{
+    template <class VectorType>
+    KOKKOS_INLINE_FUNCTION double operator()( const VectorType& v,
+                                              const int i, const int j,
+                                              const int k ) const
+    {
+        return v( i, j, k ) / 6.0;
+    }
+};
+
+//---------------------------------------------------------------------------//
+void matrixFreeTest()
+{
+    // Create the global grid.
+    double cell_size = 0.25;
+    std::array<bool, 3> is_dim_periodic = { false, false, false };
+    std::array<double, 3> global_low_corner = { -1.0, -2.0, -1.0 };
+    std::array<double, 3> global_high_corner = { 1.0, 1.0, 0.5 };
+    auto global_mesh = createUniformGlobalMesh( global_low_corner,
+                                                global_high_corner, cell_size );
+    DimBlockPartitioner<3> partitioner;
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+
+    // Create a local grid.
+    auto local_mesh = createLocalGrid( global_grid, 1 );
+    auto owned_space = local_mesh->indexSpace( Own(), Cell(), Local() );
+    auto global_space = local_mesh->indexSpace( Own(), Cell(), Global() );
+
+    // Create the RHS and the LHS of both solves.
+    auto vector_layout = createArrayLayout( local_mesh, 1, Cell() );
+    auto rhs = createArray<double, TEST_DEVICE>( "rhs", vector_layout );
+    ArrayOp::assign( *rhs, 1.0, Own() );
+    auto lhs = createArray<double, TEST_DEVICE>( "lhs", vector_layout );
+    ArrayOp::assign( *lhs, 0.0, Own() );
+    auto lhs_free = createArray<double, TEST_DEVICE>( "lhs", vector_layout );
+    ArrayOp::assign( *lhs_free, 0.0, Own() );
+
+    // 7-point 3d laplacian stencil.
+    std::vector<std::array<int, 3>> stencil = {
+        { 0, 0, 0 }, { -1, 0, 0 }, { 1, 0, 0 }, { 0, -1, 0 },
+        { 0, 1, 0 }, { 0, 0, -1 }, { 0, 0, 1 } };
+    std::vector<std::array<int, 3>> diag_stencil = { { 0, 0, 0 } };
+
+    // Solve with stored matrix and preconditioner values.
+    auto solver =
+        createReferenceConjugateGradient<double, TEST_DEVICE>( *vector_layout );
+    solver->setMatrixStencil( stencil );
+    auto matrix_view = solver->getMatrixValues().view();
+    int ncell_i = global_grid->globalNumEntity( Cell(), Dim::I );
+    int ncell_j = global_grid->globalNumEntity( Cell(), Dim::J );
+    int ncell_k = global_grid->globalNumEntity( Cell(), Dim::K );
+    Kokkos::parallel_for(
+        "fill_matrix_entries",
+        createExecutionPolicy( owned_space, TEST_EXECSPACE() ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            int gi = i + global_space.min( Dim::I ) - owned_space.min( Dim::I );
+            int gj = j + global_space.min( Dim::J ) - owned_space.min( Dim::J );
+            int gk = k + global_space.min( Dim::K ) - owned_space.min( Dim::K );
+            matrix_view( i, j, k, 0 ) = 6.0;
+            matrix_view( i, j, k, 1 ) = ( gi - 1 >= 0 ) ? -1.0 : 0.0;
+            matrix_view( i, j, k, 2 ) = ( gi + 1 < ncell_i ) ? -1.0 : 0.0;
+            matrix_view( i, j, k, 3 ) = ( gj - 1 >= 0 ) ? -1.0 : 0.0;
+            matrix_view( i, j, k, 4 ) = ( gj + 1 < ncell_j ) ? -1.0 : 0.0;
+            matrix_view( i, j, k, 5 ) = ( gk - 1 >= 0 ) ? -1.0 : 0.0;
+            matrix_view( i, j, k, 6 ) = ( gk + 1 < ncell_k ) ? -1.0 : 0.0;
+        } );
+    solver->setPreconditionerStencil( diag_stencil );
+    auto preconditioner_view = solver->getPreconditionerValues().view();
+    Kokkos::deep_copy( preconditioner_view, 1.0 / 6.0 );
+    solver->setTolerance( 1.0e-11 );
+    solver->setup();
+    solver->getTelemetry().setEnabled( true );
+    solver->solve( *rhs, *lhs );
+
+    // Check the telemetry. The residual history includes the initial
+    // residual.
+    const auto& telemetry = solver->getTelemetry();
+    EXPECT_EQ( telemetry.numIter(), solver->getNumIter() );
+    EXPECT_EQ( static_cast<int>( telemetry.residualHistory().size() ),
+               solver->getNumIter() + 1 );
+    EXPECT_DOUBLE_EQ( telemetry.residualHistory().back(),
+                      solver->getFinalRelativeResidualNorm() );
+    EXPECT_GE( telemetry.phaseTime( SolverPhase::Halo ), 0.0 );
+    EXPECT_GE( telemetry.solveTime(),
+               telemetry.phaseTime( SolverPhase::Compute ) );
+
+    // Solving again from zero instead of the converged solution repeats the
+    // first solve.
+    int num_iter = solver->getNumIter();
+    solver->setInitialGuess( SolverInitialGuess::Zero );
+    solver->solve( *rhs, *lhs );
+    EXPECT_EQ( solver->getNumIter(), num_iter );
+    EXPECT_THROW( solver->setInitialGuess( SolverInitialGuess::Previous ),
+                  std::logic_error );
+
+    // Solve with matrix-free operators.
+    auto free_solver =
+        createReferenceConjugateGradient<double, TEST_DEVICE>( *vector_layout );
+    free_solver->setMatrixOperatorStencil( stencil );
+    free_solver->setPreconditionerOperatorStencil( diag_stencil );
+    LaplacianOperator laplacian;
+    for ( int d = 0; d < 3; ++d )
+    {
+        laplacian.offset[d] = global_space.min( d ) - owned_space.min( d );
+        laplacian.num_cell[d] = global_grid->globalNumEntity( Cell(), d );
+    }
+    free_solver->setTolerance( 1.0e-11 );
+    free_solver->setup();
+    free_solver->solve( laplacian, JacobiOperator(), *rhs, *lhs_free );
+
+    // Check that both solves give the same result.
+    EXPECT_EQ( solver->getNumIter(), free_solver->getNumIter() );
+    auto lhs_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), lhs->view() );
+    auto lhs_free_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), lhs_free->view() );
+    for ( int i = owned_space.min( Dim::I ); i < owned_space.max( Dim::I );
+          ++i )
+        for ( int j = owned_space.min( Dim::J ); j < owned_space.max( Dim::J );
+              ++j )
+            for ( int k = owned_space.min( Dim::K );
+                  k < owned_space.max( Dim::K ); ++k )
+                EXPECT_FLOAT_EQ( lhs_free_host( i, j, k, 0 ),
+                                 lhs_host( i, j, k, 0 ) );
+}
+
+//---------------------------------------------------------------------------//
+void multigridTest()
+{
+    // Create the global grid.
+    double cell_size = 0.125;
+    std::array<bool, 3> is_dim_periodic = { false, false, false };
+    std::array<double, 3> global_low_corner = { 0.0, 0.0, 0.0 };
+    std::array<double, 3> global_high_corner = { 2.0, 2.0, 2.0 };
+    auto global_mesh = createUniformGlobalMesh( global_low_corner,
+                                                global_high_corner, cell_size );
+    DimBlockPartitioner<3> partitioner;
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+
+    // Create a local grid.
+    auto local_mesh = createLocalGrid( global_grid, 1 );
+    auto owned_space = local_mesh->indexSpace( Own(), Cell(), Local() );
+    auto global_space = local_mesh->indexSpace( Own(), Cell(), Global() );
+
+    // Create the RHS and the LHS of both solves.
+    auto vector_layout = createArrayLayout( local_mesh, 1, Cell() );
+    auto rhs = createArray<double, TEST_DEVICE>( "rhs", vector_layout );
+    ArrayOp::assign( *rhs, 1.0, Own() );
+    auto lhs_jacobi = createArray<double, TEST_DEVICE>( "lhs", vector_layout );
+    ArrayOp::assign( *lhs_jacobi, 0.0, Own() );
+    auto lhs_mg = createArray<double, TEST_DEVICE>( "lhs", vector_layout );
+    ArrayOp::assign( *lhs_mg, 0.0, Own() );
+
+    // Matrix-free 7-point 3d laplacian.
+    std::vector<std::array<int, 3>> stencil = {
+        { 0, 0, 0 }, { -1, 0, 0 }, { 1, 0, 0 }, { 0, -1, 0 },
+        { 0, 1, 0 }, { 0, 0, -1 }, { 0, 0, 1 } };
+    std::vector<std::array<int, 3>> diag_stencil = { { 0, 0, 0 } };
+    LaplacianOperator laplacian;
+    for ( int d = 0; d < 3; ++d )
+    {
+        laplacian.offset[d] = global_space.min( d ) - owned_space.min( d );
+        laplacian.num_cell[d] = global_grid->globalNumEntity( Cell(), d );
+    }
+
+    // Solve with the Jacobi preconditioner.
+    auto jacobi_solver =
+        createReferenceConjugateGradient<double, TEST_DEVICE>( *vector_layout );
+    jacobi_solver->setMatrixOperatorStencil( stencil );
+    jacobi_solver->setPreconditionerOperatorStencil( diag_stencil );
+    jacobi_solver->setTolerance( 1.0e-10 );
+    jacobi_solver->solve( laplacian, JacobiOperator(), *rhs, *lhs_jacobi );
+
+    // Solve with the multigrid preconditioner.
+    auto multigrid =
+        createReferenceMultigrid<double, TEST_DEVICE>( *vector_layout, 1.0 );
+    auto mg_solver =
+        createReferenceConjugateGradient<double, TEST_DEVICE>( *vector_layout );
+    mg_solver->setMatrixOperatorStencil( stencil );
+    mg_solver->setPreconditioner( multigrid );
+    mg_solver->setTolerance( 1.0e-10 );
+    mg_solver->solve( laplacian, *rhs, *lhs_mg );
+
+    // Check that both solves give the same result and that the multigrid
+    // solve takes fewer iterations.
+    EXPECT_LT( mg_solver->getNumIter(), jacobi_solver->getNumIter() );
+    auto lhs_jacobi_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), lhs_jacobi->view() );
+    auto lhs_mg_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), lhs_mg->view() );
+    for ( int i = owned_space.min( Dim::I ); i < owned_space.max( Dim::I );
+          ++i )
+        for ( int j = owned_space.min( Dim::J ); j < owned_space.max( Dim::J );
+              ++j )
+            for ( int k = owned_space.min( Dim::K );
+                  k < owned_space.max( Dim::K ); ++k )
+                EXPECT_NEAR( lhs_mg_host( i, j, k, 0 ),
+                             lhs_jacobi_host( i, j, k, 0 ), 1.0e-6 );
+}
+
+//---------------------------------------------------------------------------//
+void pipelinedTest()
+{
+    // Create the global grid.
+    double cell_size = 0.25;
+    std::array<bool, 3> is_dim_periodic = { false, false, false };
+    std::array<double, 3> global_low_corner = { -1.0, -2.0, -1.0 };
+    std::array<double, 3> global_high_corner = { 1.0, 1.0, 0.5 };
+    auto global_mesh = createUniformGlobalMesh( global_low_corner,
+                                                global_high_corner, cell_size );
+    DimBlockPartitioner<3> partitioner;
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+
+    // Create a local grid.
+    auto local_mesh = createLocalGrid( global_grid, 1 );
+    auto owned_space = local_mesh->indexSpace( Own(), Cell(), Local() );
+    auto global_space = local_mesh->indexSpace( Own(), Cell(), Global() );
+
+    // Create the RHS and the LHS of both solves.
+    auto vector_layout = createArrayLayout( local_mesh, 1, Cell() );
+    auto rhs = createArray<double, TEST_DEVICE>( "rhs", vector_layout );
+    ArrayOp::assign( *rhs, 1.0, Own() );
+    auto lhs = createArray<double, TEST_DEVICE>( "lhs", vector_layout );
+    ArrayOp::assign( *lhs, 0.0, Own() );
+    auto lhs_pipe = createArray<double, TEST_DEVICE>( "lhs", vector_layout );
+    ArrayOp::assign( *lhs_pipe, 0.0, Own() );
+
+    // Matrix-free 7-point 3d laplacian.
+    std::vector<std::array<int, 3>> stencil = {
+        { 0, 0, 0 }, { -1, 0, 0 }, { 1, 0, 0 }, { 0, -1, 0 },
+        { 0, 1, 0 }, { 0, 0, -1 }, { 0, 0, 1 } };
+    std::vector<std::array<int, 3>> diag_stencil = { { 0, 0, 0 } };
+    LaplacianOperator laplacian;
+    for ( int d = 0; d < 3; ++d )
+    {
+        laplacian.offset[d] = global_space.min( d ) - owned_space.min( d );
+        laplacian.num_cell[d] = global_grid->globalNumEntity( Cell(), d );
+    }
+
+    // Solve with standard and pipelined CG.
+    auto solver =
+        createReferenceConjugateGradient<double, TEST_DEVICE>( *vector_layout );
+    solver->setMatrixOperatorStencil( stencil );
+    solver->setPreconditionerOperatorStencil( diag_stencil );
+    solver->setTolerance( 1.0e-10 );
+    solver->solve( laplacian, JacobiOperator(), *rhs, *lhs );
+
+    auto pipe_solver =
+        createReferenceConjugateGradient<double, TEST_DEVICE>( *vector_layout );
+    pipe_solver->setMatrixOperatorStencil( stencil );
+    pipe_solver->setPreconditionerOperatorStencil( diag_stencil );
+    pipe_solver->setPipelined( true );
+    pipe_solver->setTolerance( 1.0e-10 );
+    pipe_solver->solve( laplacian, JacobiOperator(), *rhs, *lhs_pipe );
+    EXPECT_LE( pipe_solver->getFinalRelativeResidualNorm(), 1.0e-10 );
+
+    // Check that both solves give the same result.
+    auto lhs_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), lhs->view() );
+    auto lhs_pipe_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), lhs_pipe->view() );
+    for ( int i = owned_space.min( Dim::I ); i < owned_space.max( Dim::I );
+          ++i )
+        for ( int j = owned_space.min( Dim::J ); j < owned_space.max( Dim::J );
+              ++j )
+            for ( int k = owned_space.min( Dim::K );
+                  k < owned_space.max( Dim::K ); ++k )
+                EXPECT_NEAR( lhs_pipe_host( i, j, k, 0 ),
+                             lhs_host( i, j, k, 0 ), 1.0e-6 );
+}
+
+//---------------------------------------------------------------------------//
+void batchedTest()
+{
+    // Create the global grid.
+    double cell_size = 0.25;
+    std::array<bool, 3> is_dim_periodic = { false, false, false };
+    std::array<double, 3> global_low_corner = { -1.0, -2.0, -1.0 };
+    std::array<double, 3> global_high_corner = { 1.0, 1.0, 0.5 };
+    auto global_mesh = createUniformGlobalMesh( global_low_corner,
+                                                global_high_corner, cell_size );
+    DimBlockPartitioner<3> partitioner;
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+
+    // Create a local grid.
+    auto local_mesh = createLocalGrid( global_grid, 1 );
+    auto owned_space = local_mesh->indexSpace( Own(), Cell(), Local() );
+    auto global_space = local_mesh->indexSpace( Own(), Cell(), Global() );
+    int ncell_i = global_grid->globalNumEntity( Cell(), Dim::I );
+    int ncell_j = global_grid->globalNumEntity( Cell(), Dim::J );
+    int ncell_k = global_grid->globalNumEntity( Cell(), Dim::K );
+
+    // Systems with different diagonals and right hand sides.
+    const int num_system = 3;
+    auto batch_layout = createArrayLayout( local_mesh, num_system, Cell() );
+    auto rhs = createArray<double, TEST_DEVICE>( "rhs", batch_layout );
+    auto lhs = createArray<double, TEST_DEVICE>( "lhs", batch_layout );
+    ArrayOp::assign( *lhs, 0.0, Own() );
+    auto rhs_view = rhs->view();
+    Kokkos::parallel_for(
+        "fill_rhs", createExecutionPolicy( owned_space, TEST_EXECSPACE() ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            for ( int l = 0; l < num_system; ++l )
+                rhs_view( i, j, k, l ) = l + 1.0;
+        } );
+
+    // 7-point 3d laplacian stencil.
+    std::vector<std::array<int, 3>> stencil = {
+        { 0, 0, 0 }, { -1, 0, 0 }, { 1, 0, 0 }, { 0, -1, 0 },
+        { 0, 1, 0 }, { 0, 0, -1 }, { 0, 0, 1 } };
+    std::vector<std::array<int, 3>> diag_stencil = { { 0, 0, 0 } };
+
+    // Solve the batch.
+    auto solver = createReferenceBatchedConjugateGradient<double, TEST_DEVICE>(
+        *batch_layout );
+    EXPECT_EQ( solver->numSystem(), num_system );
+    solver->setMatrixStencil( stencil );
+    solver->setPreconditionerStencil( diag_stencil );
+    auto matrix_view = solver->getMatrixValues().view();
+    auto preconditioner_view = solver->getPreconditionerValues().view();
+    Kokkos::parallel_for(
+        "fill_batch_entries",
+        createExecutionPolicy( owned_space, TEST_EXECSPACE() ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            int gi = i + global_space.min( Dim::I ) - owned_space.min( Dim::I );
+            int gj = j + global_space.min( Dim::J ) - owned_space.min( Dim::J );
+            int gk = k + global_space.min( Dim::K ) - owned_space.min( Dim::K );
+            for ( int l = 0; l < num_system; ++l )
+            {
+                int n = 7 * l;
+                matrix_view( i, j, k, n ) = 6.0 + l;
+                matrix_view( i, j, k, n + 1 ) = ( gi - 1 >= 0 ) ? -1.0 : 0.0;
+                matrix_view( i, j, k, n + 2 ) =
+                    ( gi + 1 < ncell_i ) ? -1.0 : 0.0;
+                matrix_view( i, j, k, n + 3 ) = ( gj - 1 >= 0 ) ? -1.0 : 0.0;
+                matrix_view( i, j, k, n + 4 ) =
+                    ( gj + 1 < ncell_j ) ? -1.0 : 0.0;
+                matrix_view( i, j, k, n + 5 ) = ( gk - 1 >= 0 ) ? -1.0 : 0.0;
+                matrix_view( i, j, k, n + 6 ) =
+                    ( gk + 1 < ncell_k ) ? -1.0 : 0.0;
+                preconditioner_view( i, j, k, l ) = 1.0 / ( 6.0 + l );
+            }
+        } );
+    solver->setTolerance( 1.0e-11 );
+    solver->solve( *rhs, *lhs );
+
+    // Solve each system separately and compare.
+    auto lhs_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), lhs->view() );
+    auto vector_layout = createArrayLayout( local_mesh, 1, Cell() );
+    for ( int l = 0; l < num_system; ++l )
+    {
+        EXPECT_LE( solver->getFinalRelativeResidualNorm( l ), 1.0e-11 );
+
+        auto single_rhs =
+            createArray<double, TEST_DEVICE>( "rhs", vector_layout );
+        ArrayOp::assign( *single_rhs, l + 1.0, Own() );
+        auto single_lhs =
+            createArray<double, TEST_DEVICE>( "lhs", vector_layout );
+        ArrayOp::assign( *single_lhs, 0.0, Own() );
+        auto single_solver =
+            createReferenceConjugateGradient<double, TEST_DEVICE>(
+                *vector_layout );
+        single_solver->setMatrixStencil( stencil );
+        single_solver->setPreconditionerStencil( diag_stencil );
+        auto single_matrix = single_solver->getMatrixValues().view();
+        Kokkos::deep_copy(
+            single_matrix,
+            Kokkos::subview( matrix_view, Kokkos::ALL(), Kokkos::ALL(),
+                             Kokkos::ALL(),
+                             Kokkos::make_pair( 7 * l, 7 * l + 7 ) ) );
+        Kokkos::deep_copy( single_solver->getPreconditionerValues().view(),
+                           1.0 / ( 6.0 + l ) );
+        single_solver->setTolerance( 1.0e-11 );
+        single_solver->solve( *single_rhs, *single_lhs );
+
+        auto single_host = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), single_lhs->view() );
+        for ( int i = owned_space.min( Dim::I ); i < owned_space.max( Dim::I );
+              ++i )
+            for ( int j = owned_space.min( Dim::J );
+                  j < owned_space.max( Dim::J ); ++j )
+                for ( int k = owned_space.min( Dim::K );
+                      k < owned_space.max( Dim::K ); ++k )
+                    EXPECT_NEAR( lhs_host( i, j, k, l ),
+                                 single_host( i, j, k, 0 ), 1.0e-8 );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Set up a solver with the stored 7-point Laplacian and Jacobi values.
+template <class SolverType, class LocalGridType>
+void fillPoisson( SolverType& solver, const LocalGridType& local_mesh )
+{
+    auto owned_space = local_mesh.indexSpace( Own(), Cell(), Local() );
+    auto global_space = local_mesh.indexSpace( Own(), Cell(), Global() );
+    const auto& global_grid = local_mesh.globalGrid();
+    int ncell_i = global_grid.globalNumEntity( Cell(), Dim::I );
+    int ncell_j = global_grid.globalNumEntity( Cell(), Dim::J );
+    int ncell_k = global_grid.globalNumEntity( Cell(), Dim::K );
+
+    std::vector<std::array<int, 3>> stencil = {
+        { 0, 0, 0 }, { -1, 0, 0 }, { 1, 0, 0 }, { 0, -1, 0 },
+        { 0, 1, 0 }, { 0, 0, -1 }, { 0, 0, 1 } };
+    solver.setMatrixStencil( stencil );
+    auto matrix_view = solver.getMatrixValues().view();
+    Kokkos::parallel_for(
+        "fill_matrix_entries",
+        createExecutionPolicy( owned_space, TEST_EXECSPACE() ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            int gi = i + global_space.min( Dim::I ) - owned_space.min( Dim::I );
+            int gj = j + global_space.min( Dim::J ) - owned_space.min( Dim::J );
+            int gk = k + global_space.min( Dim::K ) - owned_space.min( Dim::K );
+            matrix_view( i, j, k, 0 ) = 6.0;
+            matrix_view( i, j, k, 1 ) = ( gi - 1 >= 0 ) ? -1.0 : 0.0;
+            matrix_view( i, j, k, 2 ) = ( gi + 1 < ncell_i ) ? -1.0 : 0.0;
+            matrix_view( i, j, k, 3 ) = ( gj - 1 >= 0 ) ? -1.0 : 0.0;
+            matrix_view( i, j, k, 4 ) = ( gj + 1 < ncell_j ) ? -1.0 : 0.0;
+            matrix_view( i, j, k, 5 ) = ( gk - 1 >= 0 ) ? -1.0 : 0.0;
+            matrix_view( i, j, k, 6 ) = ( gk + 1 < ncell_k ) ? -1.0 : 0.0;
+        } );
+
+    std::vector<std::array<int, 3>> diag_stencil = { { 0, 0, 0 } };
+    solver.setPreconditionerStencil( diag_stencil );
+    Kokkos::deep_copy( solver.getPreconditionerValues().view(), 1.0 / 6.0 );
+    solver.setTolerance( 1.0e-11 );
+    solver.setup();
+}
+
+void mixedPrecisionTest()
+{
+    // Create the global grid.
+    double cell_size = 0.25;
+    std::array<bool, 3> is_dim_periodic = { false, false, false };
+    std::array<double, 3> global_low_corner = { -1.0, -2.0, -1.0 };
+    std::array<double, 3> global_high_corner = { 1.0, 1.0, 0.5 };
+    auto global_mesh = createUniformGlobalMesh( global_low_corner,
+                                                global_high_corner, cell_size );
+    DimBlockPartitioner<3> partitioner;
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+
+    // Create a local grid.
+    auto local_mesh = createLocalGrid( global_grid, 1 );
+    auto owned_space = local_mesh->indexSpace( Own(), Cell(), Local() );
+
+    // Create the RHS and the LHS of both solves.
+    auto vector_layout = createArrayLayout( local_mesh, 1, Cell() );
+    auto rhs = createArray<double, TEST_DEVICE>( "rhs", vector_layout );
+    ArrayOp::assign( *rhs, 1.0, Own() );
+    auto lhs = createArray<double, TEST_DEVICE>( "lhs", vector_layout );
+    ArrayOp::assign( *lhs, 0.0, Own() );
+    auto lhs_mixed = createArray<double, TEST_DEVICE>( "lhs", vector_layout );
+    ArrayOp::assign( *lhs_mixed, 0.0, Own() );
+
+    // Solve in double precision.
+    auto solver =
+        createReferenceConjugateGradient<double, TEST_DEVICE>( *vector_layout );
+    fillPoisson( *solver, *local_mesh );
+    solver->solve( *rhs, *lhs );
+
+    // Solve with float inner iterations.
+    auto mixed_solver =
+        createReferenceMixedPrecisionSolver<double, float, TEST_DEVICE>(
+            *vector_layout );
+    fillPoisson( *mixed_solver, *local_mesh );
+    mixed_solver->solve( *rhs, *lhs_mixed );
+    EXPECT_LE( mixed_solver->getFinalRelativeResidualNorm(), 1.0e-11 );
+
+    // Check that both solves give the same result.
+    auto lhs_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), lhs->view() );
+    auto lhs_mixed_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), lhs_mixed->view() );
+    for ( int i = owned_space.min( Dim::I ); i < owned_space.max( Dim::I );
+          ++i )
+        for ( int j = owned_space.min( Dim::J ); j < owned_space.max( Dim::J );
+              ++j )
+            for ( int k = owned_space.min( Dim::K );
+                  k < owned_space.max( Dim::K ); ++k )
+                EXPECT_NEAR( lhs_mixed_host( i, j, k, 0 ),
+                             lhs_host( i, j, k, 0 ), 1.0e-8 );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( reference_structured_solver, matrix_free_test ) { matrixFreeTest(); }
+
+TEST( reference_structured_solver, multigrid_test ) { multigridTest(); }
+
+TEST( reference_structured_solver, pipelined_test ) { pipelinedTest(); }
+
+TEST( reference_structured_solver, batched_test ) { batchedTest(); }
+
+TEST( reference_structured_solver, mixed_precision_test )
+{
+    mixedPrecisionTest();
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
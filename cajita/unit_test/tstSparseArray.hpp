@@ -0,0 +1,171 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cajita_GlobalGrid.hpp>
+#include <Cajita_GlobalMesh.hpp>
+#include <Cajita_LocalGrid.hpp>
+#include <Cajita_ManualPartitioner.hpp>
+#include <Cajita_SparseArray.hpp>
+#include <Cajita_SparseIndexSpace.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <array>
+#include <memory>
+#include <set>
+
+using namespace Cajita;
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+// Field value of a global cell.
+KOKKOS_INLINE_FUNCTION
+double cellValue( const int i, const int j, const int k )
+{
+    return i + 1000.0 * j + 1000000.0 * k;
+}
+
+//---------------------------------------------------------------------------//
+// Activate every other tile of a checkerboard, fill the array, and gather
+// the ghost tiles from the neighbors.
+void gatherTest( const std::array<bool, 3>& is_dim_periodic )
+{
+    // Each rank owns 2 tiles of 4 cells per dimension.
+    constexpr int tile_dim = 4;
+    constexpr int owned_tile = 2;
+    int comm_size;
+    MPI_Comm_size( MPI_COMM_WORLD, &comm_size );
+    std::array<int, 3> ranks_per_dim = { 0, 0, 0 };
+    MPI_Dims_create( comm_size, 3, ranks_per_dim.data() );
+    std::array<int, 3> global_num_cell;
+    std::array<double, 3> global_low_corner = { 0.0, 0.0, 0.0 };
+    std::array<double, 3> global_high_corner;
+    for ( int d = 0; d < 3; ++d )
+    {
+        global_num_cell[d] = tile_dim * owned_tile * ranks_per_dim[d];
+        global_high_corner[d] = 0.1 * global_num_cell[d];
+    }
+    auto global_mesh = createSparseGlobalMesh(
+        global_low_corner, global_high_corner, global_num_cell );
+    ManualPartitioner partitioner( ranks_per_dim );
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+    auto local_grid = createLocalGrid( global_grid, tile_dim );
+
+    // Register the owned tiles on the checkerboard.
+    using map_type = SparseMap<TEST_EXECSPACE, tile_dim>;
+    auto map = std::make_shared<map_type>(
+        createSparseMap<TEST_EXECSPACE>( global_mesh, 64 ) );
+    std::array<int, 3> tile_offset;
+    for ( int d = 0; d < 3; ++d )
+        tile_offset[d] = global_grid->globalOffset( d ) / tile_dim;
+    int ti0 = tile_offset[0];
+    int tj0 = tile_offset[1];
+    int tk0 = tile_offset[2];
+    auto map_copy = *map;
+    Kokkos::parallel_for(
+        "insert", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, owned_tile ),
+        KOKKOS_LAMBDA( const int i ) {
+            for ( int j = 0; j < owned_tile; ++j )
+                for ( int k = 0; k < owned_tile; ++k )
+                {
+                    int ti = ti0 + i;
+                    int tj = tj0 + j;
+                    int tk = tk0 + k;
+                    if ( ( ti + tj + tk ) % 2 == 0 )
+                        map_copy.insertTile( ti, tj, tk );
+                }
+        } );
+    Kokkos::fence();
+    EXPECT_EQ( map->size(), 4u );
+
+    // Fill the owned tiles.
+    auto array = createSparseArray<double, TEST_DEVICE>( "array", map, 1 );
+    EXPECT_EQ( array->numTile(), 4 );
+    auto sparse_view = array->sparseView();
+    sparse_grid_parallel_for(
+        "fill", TEST_EXECSPACE(), *map,
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            sparse_view( i, j, k, 0 ) = cellValue( i, j, k );
+        } );
+    Kokkos::fence();
+
+    // Gather the ghost tiles.
+    auto halo = createSparseHalo( *array, *local_grid );
+    halo->gather( TEST_EXECSPACE(), *array );
+
+    // Collect the active tiles within one tile of the owned tiles. Periodic
+    // ghost tiles are stored at the indices of their owner.
+    int my_rank;
+    MPI_Comm_rank( MPI_COMM_WORLD, &my_rank );
+    std::set<std::array<int, 3>> expected_tiles;
+    for ( int i = -1; i < owned_tile + 1; ++i )
+        for ( int j = -1; j < owned_tile + 1; ++j )
+            for ( int k = -1; k < owned_tile + 1; ++k )
+            {
+                std::array<int, 3> tile = { i, j, k };
+                std::array<int, 3> neighbor = { 0, 0, 0 };
+                bool valid = true;
+                for ( int d = 0; d < 3; ++d )
+                {
+                    if ( tile[d] < 0 )
+                        neighbor[d] = -1;
+                    else if ( tile[d] >= owned_tile )
+                        neighbor[d] = 1;
+                    int num_tile = global_num_cell[d] / tile_dim;
+                    tile[d] += tile_offset[d];
+                    if ( tile[d] < 0 || tile[d] >= num_tile )
+                    {
+                        valid = valid && is_dim_periodic[d];
+                        tile[d] = ( tile[d] + num_tile ) % num_tile;
+                    }
+                }
+                bool owned = !neighbor[0] && !neighbor[1] && !neighbor[2];
+                if ( !owned && local_grid->neighborRank( neighbor ) == my_rank )
+                    valid = false;
+                if ( valid && ( tile[0] + tile[1] + tile[2] ) % 2 == 0 )
+                    expected_tiles.insert( tile );
+            }
+    int expected = expected_tiles.size();
+    EXPECT_EQ( static_cast<int>( map->size() ), expected );
+    EXPECT_EQ( array->numTile(), expected );
+
+    // Check the owned and gathered values.
+    Kokkos::View<int, TEST_MEMSPACE> errors( "errors" );
+    sparse_view = array->sparseView();
+    sparse_grid_parallel_for(
+        "check", TEST_EXECSPACE(), *map,
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            if ( sparse_view( i, j, k, 0 ) != cellValue( i, j, k ) )
+                Kokkos::atomic_increment( &errors() );
+        } );
+    auto errors_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), errors );
+    EXPECT_EQ( errors_host(), 0 );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, sparse_array_gather_test )
+{
+    gatherTest( { false, false, false } );
+    gatherTest( { true, true, true } );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
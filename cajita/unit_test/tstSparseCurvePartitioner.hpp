@@ -0,0 +1,136 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cajita_SparseCurvePartitioner.hpp>
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include <mpi.h>
+
+using namespace Cajita;
+
+namespace Test
+{
+
+//---------------------------------------------------------------------------//
+void curvePartitionTest()
+{
+    constexpr int size_tile_per_dim = 16;
+    constexpr int cell_per_tile_dim = 4;
+    constexpr int size_per_dim = size_tile_per_dim * cell_per_tile_dim;
+    std::array<int, 3> global_cells_per_dim = { size_per_dim, size_per_dim,
+                                                size_per_dim };
+    int comm_rank, comm_size;
+    MPI_Comm_rank( MPI_COMM_WORLD, &comm_rank );
+    MPI_Comm_size( MPI_COMM_WORLD, &comm_size );
+
+    SparseCurvePartitioner<TEST_DEVICE, cell_per_tile_dim> partitioner(
+        MPI_COMM_WORLD, global_cells_per_dim );
+    auto tiles_per_dim = partitioner.tilesPerDimension();
+    for ( int d = 0; d < 3; ++d )
+        EXPECT_EQ( tiles_per_dim[d], size_tile_per_dim );
+
+    // The initial partition shares the tiles evenly.
+    constexpr int total_tile =
+        size_tile_per_dim * size_tile_per_dim * size_tile_per_dim;
+    int owned_tile = partitioner.ownedTileNum();
+    EXPECT_GE( owned_tile, total_tile / comm_size );
+    EXPECT_LE( owned_tile, total_tile / comm_size + 1 );
+    int sum_tile = 0;
+    MPI_Allreduce( &owned_tile, &sum_tile, 1, MPI_INT, MPI_SUM,
+                   MPI_COMM_WORLD );
+    EXPECT_EQ( sum_tile, total_tile );
+
+    // Concentrate the workload in a corner: rank 0 holds 8 particles in each
+    // tile of the first 4x4x4 tiles.
+    constexpr int hot_tile_per_dim = 4;
+    constexpr int hot_tile =
+        hot_tile_per_dim * hot_tile_per_dim * hot_tile_per_dim;
+    int num_particle = ( comm_rank == 0 ) ? 8 * hot_tile : 0;
+    double dx = 0.1;
+    std::array<double, 3> global_low_corner = { -1.0, 0.5, 2.0 };
+    Kokkos::View<double* [3], TEST_MEMSPACE> positions( "positions",
+                                                       num_particle );
+    auto positions_host = Kokkos::create_mirror_view( positions );
+    for ( int p = 0; p < num_particle; ++p )
+    {
+        int tile = p / 8;
+        int tid[3] = { tile / hot_tile_per_dim / hot_tile_per_dim,
+                       ( tile / hot_tile_per_dim ) % hot_tile_per_dim,
+                       tile % hot_tile_per_dim };
+        for ( int d = 0; d < 3; ++d )
+            positions_host( p, d ) =
+                global_low_corner[d] +
+                ( tid[d] * cell_per_tile_dim + 0.5 + p % 4 ) * dx;
+    }
+    Kokkos::deep_copy( positions, positions_host );
+
+    bool is_changed = partitioner.optimizePartition(
+        positions, num_particle, global_low_corner, dx );
+    if ( comm_size > 1 )
+        EXPECT_TRUE( is_changed );
+
+    // Each rank gets at most one tile of workload above the average.
+    EXPECT_LE( partitioner.computeImbalanceFactor(),
+               1.0f + static_cast<float>( comm_size ) / hot_tile + 1e-5f );
+
+    // Every tile next to an owned tile belongs to a neighbor.
+    auto neighbors = partitioner.neighborRanks( 1 );
+    EXPECT_TRUE( std::is_sorted( neighbors.begin(), neighbors.end() ) );
+    EXPECT_TRUE( std::binary_search( neighbors.begin(), neighbors.end(),
+                                     comm_rank ) );
+    for ( int i = 0; i < size_tile_per_dim; ++i )
+        for ( int j = 0; j < size_tile_per_dim; ++j )
+            for ( int k = 0; k < size_tile_per_dim; ++k )
+            {
+                if ( partitioner.ownerRank( i, j, k ) != comm_rank )
+                    continue;
+                for ( int oi = -1; oi < 2; ++oi )
+                    for ( int oj = -1; oj < 2; ++oj )
+                        for ( int ok = -1; ok < 2; ++ok )
+                        {
+                            int ni = i + oi, nj = j + oj, nk = k + ok;
+                            if ( ni < 0 || nj < 0 || nk < 0 ||
+                                 ni >= size_tile_per_dim ||
+                                 nj >= size_tile_per_dim ||
+                                 nk >= size_tile_per_dim )
+                                continue;
+                            EXPECT_TRUE( std::binary_search(
+                                neighbors.begin(), neighbors.end(),
+                                partitioner.ownerRank( ni, nj, nk ) ) );
+                        }
+            }
+
+    // The owner view on the device matches the host owners.
+    auto owner_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), partitioner.ownerView() );
+    for ( int i = 0; i < size_tile_per_dim; ++i )
+        for ( int j = 0; j < size_tile_per_dim; ++j )
+            for ( int k = 0; k < size_tile_per_dim; ++k )
+                EXPECT_EQ( owner_host( i, j, k ),
+                           partitioner.ownerRank( i, j, k ) );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, curve_partition_test )
+{
+    curvePartitionTest();
+}
+
+//---------------------------------------------------------------------------//
+} // end namespace Test
@@ -452,6 +452,11 @@ void random_distribution_automatic_rank( int occupy_num_per_rank,
 
     auto imbalance_factor = partitioner.computeImbalanceFactor( cart_comm );
     EXPECT_FLOAT_EQ( imbalance_factor, 1.0f );
+    EXPECT_EQ( partitioner.currentRankWorkload( cart_comm ),
+               partitioner.averageRankWorkload( cart_comm ) );
+    // the average does not depend on the cartesian topology
+    EXPECT_EQ( partitioner.averageRankWorkload( MPI_COMM_WORLD ),
+               partitioner.averageRankWorkload( cart_comm ) );
 }
 
 //---------------------------------------------------------------------------//
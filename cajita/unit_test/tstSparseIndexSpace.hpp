@@ -632,6 +632,154 @@ void testSparseMapReinsert()
     }
 }
 
+void testSparseMapRegisterParticles()
+{
+    constexpr int size_tile_per_dim = 8;
+    constexpr int size_per_dim = size_tile_per_dim * 4;
+    constexpr int total_tile = size_tile_per_dim * size_tile_per_dim *
+                               size_tile_per_dim;
+
+    // Create the global mesh
+    double cell_size = 0.1;
+    std::array<int, 3> global_num_cell = { size_per_dim, size_per_dim,
+                                           size_per_dim };
+    std::array<double, 3> global_low_corner = { 1.2, 3.3, -2.8 };
+    std::array<double, 3> global_high_corner = {
+        global_low_corner[0] + cell_size * global_num_cell[0],
+        global_low_corner[1] + cell_size * global_num_cell[1],
+        global_low_corner[2] + cell_size * global_num_cell[2] };
+    auto global_mesh = createSparseGlobalMesh(
+        global_low_corner, global_high_corner, global_num_cell );
+    auto sis = createSparseMap<TEST_EXECSPACE>( global_mesh, 16 );
+
+    // Put many particles in a few random tiles, plus one outside the mesh.
+    constexpr int num_particle = 1001;
+    Kokkos::View<double* [3], Kokkos::HostSpace> host_positions(
+        "positions", num_particle );
+    std::map<int, int> tile_register;
+    int tiles[5];
+    for ( int t = 0; t < 5; ++t )
+        tiles[t] = std::rand() % total_tile;
+    for ( int p = 0; p < num_particle - 1; ++p )
+    {
+        int tile = tiles[p % 5];
+        tile_register[tile] = 1;
+        int ijk[3] = { tile / size_tile_per_dim / size_tile_per_dim,
+                       ( tile / size_tile_per_dim ) % size_tile_per_dim,
+                       tile % size_tile_per_dim };
+        for ( int d = 0; d < 3; ++d )
+            host_positions( p, d ) =
+                global_low_corner[d] +
+                cell_size * ( 4 * ijk[d] + ( p % 4 ) + 0.5 );
+    }
+    for ( int d = 0; d < 3; ++d )
+        host_positions( num_particle - 1, d ) = global_high_corner[d] + 1.0;
+    auto positions = Kokkos::create_mirror_view_and_copy( TEST_MEMSPACE(),
+                                                          host_positions );
+
+    int num_unique = registerParticles( TEST_EXECSPACE(), sis, positions,
+                                        num_particle, global_mesh );
+    int valid_tile_num = tile_register.size();
+    EXPECT_EQ( num_unique, valid_tile_num );
+    EXPECT_EQ( static_cast<int>( sis.size() ), valid_tile_num );
+    EXPECT_EQ( sis.capacity() >= sis.size(), true );
+
+    // Each registered tile has a distinct tile No.
+    Kokkos::View<int*, TEST_DEVICE> qid_res( "query_id", 5 );
+    Kokkos::View<int*, TEST_DEVICE> dev_tiles( "tiles", 5 );
+    auto host_tiles = Kokkos::create_mirror_view( dev_tiles );
+    for ( int t = 0; t < 5; ++t )
+        host_tiles( t ) = tiles[t];
+    Kokkos::deep_copy( dev_tiles, host_tiles );
+    Kokkos::parallel_for(
+        Kokkos::RangePolicy<TEST_EXECSPACE>( 0, 5 ), KOKKOS_LAMBDA( int t ) {
+            int tile = dev_tiles( t );
+            int i = tile / size_tile_per_dim / size_tile_per_dim;
+            int j = ( tile / size_tile_per_dim ) % size_tile_per_dim;
+            int k = tile % size_tile_per_dim;
+            qid_res( t ) = sis.queryTile( 4 * i, 4 * j, 4 * k );
+        } );
+    auto qid_mirror =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), qid_res );
+    std::map<int, int> tile_ids;
+    for ( int t = 0; t < 5; ++t )
+    {
+        EXPECT_EQ( qid_mirror( t ) < valid_tile_num, true );
+        tile_ids[tiles[t]] = qid_mirror( t );
+    }
+    std::map<int, int> id_register;
+    for ( auto& t : tile_ids )
+        id_register[t.second] = 1;
+    EXPECT_EQ( static_cast<int>( id_register.size() ), valid_tile_num );
+
+    // Registering the same particles again adds no tiles.
+    registerParticles( TEST_EXECSPACE(), sis, positions, num_particle,
+                       global_mesh );
+    EXPECT_EQ( static_cast<int>( sis.size() ), valid_tile_num );
+}
+
+//---------------------------------------------------------------------------//
+void testTileHashTable()
+{
+    using table_type =
+        TileHashTable<uint64_t, uint32_t, TEST_MEMSPACE, HashTypes::Morton>;
+    constexpr int num_key = 100;
+    table_type table( num_key );
+    EXPECT_EQ( table.capacity() >= static_cast<uint32_t>( num_key ), true );
+
+    // Insert every key twice, only the first insertion of each key succeeds.
+    Kokkos::View<int[1], TEST_MEMSPACE> success_count( "success" );
+    Kokkos::parallel_for(
+        Kokkos::RangePolicy<TEST_EXECSPACE>( 0, 2 * num_key ),
+        KOKKOS_LAMBDA( const int n ) {
+            auto key = static_cast<uint64_t>( 7 * ( n % num_key ) );
+            auto result = table.insert( key, n % num_key );
+            if ( result.success() )
+                Kokkos::atomic_increment( &success_count( 0 ) );
+            if ( result.failed() )
+                Kokkos::abort( "tile hash table full" );
+        } );
+    auto success_mirror = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), success_count );
+    EXPECT_EQ( success_mirror( 0 ), num_key );
+
+    // Grow the table and check the keys and values survive.
+    table.rehash( 4 * num_key );
+    EXPECT_EQ( table.capacity() >= static_cast<uint32_t>( 4 * num_key ), true );
+    Kokkos::View<int[num_key], TEST_MEMSPACE> value_res( "value" );
+    Kokkos::View<int[1], TEST_MEMSPACE> miss_res( "miss" );
+    Kokkos::parallel_for(
+        Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_key ),
+        KOKKOS_LAMBDA( const int n ) {
+            auto slot = table.find( static_cast<uint64_t>( 7 * n ) );
+            value_res( n ) =
+                ( slot != table.capacity() ) ? table.value_at( slot ) : -1;
+            if ( table.find( static_cast<uint64_t>( 7 * n + 1 ) ) !=
+                 table.capacity() )
+                Kokkos::atomic_increment( &miss_res( 0 ) );
+        } );
+    auto value_mirror =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), value_res );
+    auto miss_mirror =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), miss_res );
+    for ( int n = 0; n < num_key; ++n )
+        EXPECT_EQ( value_mirror( n ), n );
+    EXPECT_EQ( miss_mirror( 0 ), 0 );
+
+    // Clearing removes every key.
+    table.clear();
+    Kokkos::View<int[1], TEST_MEMSPACE> valid_count( "valid" );
+    Kokkos::parallel_for(
+        Kokkos::RangePolicy<TEST_EXECSPACE>( 0, table.capacity() ),
+        KOKKOS_LAMBDA( const int n ) {
+            if ( table.valid_at( n ) )
+                Kokkos::atomic_increment( &valid_count( 0 ) );
+        } );
+    auto valid_mirror =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), valid_count );
+    EXPECT_EQ( valid_mirror( 0 ), 0 );
+}
+
 //---------------------------------------------------------------------------//
 // RUN TESTS
 //---------------------------------------------------------------------------//
@@ -651,12 +799,18 @@ TEST( TEST_CATEGORY, block_space_test )
     testBlockSpace<HashTypes::Naive>();
     testBlockSpace<HashTypes::Morton>();
 }
+
+TEST( TEST_CATEGORY, tile_hash_table_test )
+{
+    testTileHashTable();
+}
 //---------------------------------------------------------------------------//
 TEST( TEST_CATEGORY, sparse_map_space_test )
 {
     testSparseMapFullInsert();
     testSparseMapSparseInsert();
     testSparseMapReinsert();
+    testSparseMapRegisterParticles();
 }
 
 //---------------------------------------------------------------------------//
@@ -0,0 +1,147 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cajita_GlobalGrid.hpp>
+#include <Cajita_GlobalMesh.hpp>
+#include <Cajita_Interpolation.hpp>
+#include <Cajita_LocalGrid.hpp>
+#include <Cajita_ManualPartitioner.hpp>
+#include <Cajita_SparseArray.hpp>
+#include <Cajita_SparseIndexSpace.hpp>
+#include <Cajita_SparseInterpolation.hpp>
+#include <Cajita_Splines.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <array>
+#include <memory>
+
+using namespace Cajita;
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+// Put a unit point at the center of every owned cell of a periodic grid,
+// interpolate the points to an empty sparse array and back. Quadratic
+// splines form a partition of unity such that every cell receives a unit
+// value and every point interpolates a unit value.
+void interpolationTest()
+{
+    // Each rank owns 2 tiles of 4 cells per dimension.
+    constexpr int tile_dim = 4;
+    constexpr int owned_cell = 8;
+    int comm_size;
+    MPI_Comm_size( MPI_COMM_WORLD, &comm_size );
+    std::array<int, 3> ranks_per_dim = { 0, 0, 0 };
+    MPI_Dims_create( comm_size, 3, ranks_per_dim.data() );
+    double cell_size = 0.1;
+    std::array<int, 3> global_num_cell;
+    std::array<double, 3> global_low_corner = { 0.0, 0.0, 0.0 };
+    std::array<double, 3> global_high_corner;
+    for ( int d = 0; d < 3; ++d )
+    {
+        global_num_cell[d] = owned_cell * ranks_per_dim[d];
+        global_high_corner[d] = cell_size * global_num_cell[d];
+    }
+    auto global_mesh = createSparseGlobalMesh(
+        global_low_corner, global_high_corner, global_num_cell );
+    ManualPartitioner partitioner( ranks_per_dim );
+    std::array<bool, 3> is_dim_periodic = { true, true, true };
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+    auto local_grid = createLocalGrid( global_grid, tile_dim );
+
+    // Create an empty array.
+    using map_type = SparseMap<TEST_EXECSPACE, tile_dim>;
+    auto map = std::make_shared<map_type>(
+        createSparseMap<TEST_EXECSPACE>( global_mesh, 64 ) );
+    auto array = createSparseArray<double, TEST_DEVICE>( "array", map, 1 );
+    auto halo = createSparseHalo( *array, *local_grid );
+    EXPECT_EQ( array->numTile(), 0 );
+
+    // Create the points.
+    int num_point = owned_cell * owned_cell * owned_cell;
+    Kokkos::View<double* [3], Kokkos::HostSpace> points_host( "points",
+                                                             num_point );
+    std::array<int, 3> offset;
+    for ( int d = 0; d < 3; ++d )
+        offset[d] = global_grid->globalOffset( d );
+    int p = 0;
+    for ( int i = 0; i < owned_cell; ++i )
+        for ( int j = 0; j < owned_cell; ++j )
+            for ( int k = 0; k < owned_cell; ++k, ++p )
+            {
+                std::array<int, 3> c = { i, j, k };
+                for ( int d = 0; d < 3; ++d )
+                    points_host( p, d ) = ( offset[d] + c[d] + 0.5 ) *
+                                          cell_size;
+            }
+    auto points =
+        Kokkos::create_mirror_view_and_copy( TEST_MEMSPACE(), points_host );
+    Kokkos::View<double*, TEST_MEMSPACE> values( "values", num_point );
+    Kokkos::deep_copy( values, 1.0 );
+
+    // Interpolate to the grid. The owned tiles and the tiles of the stencils
+    // are registered.
+    auto p2g_func = createScalarValueP2G( values, 1.0 );
+    p2g( p2g_func, points, num_point, Spline<2>(), *halo, *array,
+         *local_grid );
+    EXPECT_GE( array->numTile(), 8 );
+
+    // Check the owned cells.
+    Kokkos::View<int, TEST_MEMSPACE> errors( "errors" );
+    Kokkos::View<int, TEST_MEMSPACE> count( "count" );
+    auto sparse_view = array->sparseView();
+    int i0 = offset[0];
+    int j0 = offset[1];
+    int k0 = offset[2];
+    sparse_grid_parallel_for(
+        "check", TEST_EXECSPACE(), sparse_view.map,
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            bool owned = ( i >= i0 && i < i0 + owned_cell ) &&
+                         ( j >= j0 && j < j0 + owned_cell ) &&
+                         ( k >= k0 && k < k0 + owned_cell );
+            if ( !owned )
+                return;
+            Kokkos::atomic_increment( &count() );
+            if ( fabs( sparse_view( i, j, k, 0 ) - 1.0 ) > 1.0e-12 )
+                Kokkos::atomic_increment( &errors() );
+        } );
+    auto count_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), count );
+    auto errors_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), errors );
+    EXPECT_EQ( count_host(), num_point );
+    EXPECT_EQ( errors_host(), 0 );
+
+    // Interpolate back to the points.
+    Kokkos::deep_copy( values, 0.0 );
+    auto g2p_func = createScalarValueG2P( values, 1.0 );
+    g2p( *array, *halo, *local_grid, points, num_point, Spline<2>(),
+         g2p_func );
+    auto values_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), values );
+    for ( p = 0; p < num_point; ++p )
+        EXPECT_FLOAT_EQ( values_host( p ), 1.0 );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, sparse_interpolation_test ) { interpolationTest(); }
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
@@ -0,0 +1,131 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cajita_Array.hpp>
+#include <Cajita_GlobalGrid.hpp>
+#include <Cajita_GlobalMesh.hpp>
+#include <Cajita_LocalGrid.hpp>
+#include <Cajita_Partitioner.hpp>
+#include <Cajita_SpectralPoissonSolver.hpp>
+#include <Cajita_Types.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <array>
+#include <cmath>
+
+using namespace Cajita;
+using namespace Cajita::Experimental;
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+// Solve for a single Fourier mode per field. The right hand side of each
+// field is the mode scaled by the Laplacian eigenvalue of the kernel such
+// that the solution is the mode itself.
+void poissonTest( const SpectralPoissonKernel kernel, const int num_field )
+{
+    // Create a periodic box.
+    double cell_size = 0.125;
+    std::array<bool, 3> is_dim_periodic = { true, true, true };
+    std::array<double, 3> low_corner = { 0.0, 0.0, 0.0 };
+    std::array<double, 3> high_corner = { 1.0, 2.0, 1.5 };
+    auto global_mesh =
+        createUniformGlobalMesh( low_corner, high_corner, cell_size );
+    DimBlockPartitioner<3> partitioner;
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+    auto local_grid = createLocalGrid( global_grid, 1 );
+
+    // Create the arrays.
+    auto layout = createArrayLayout( local_grid, num_field, Node() );
+    auto lhs = createArray<double, TEST_DEVICE>( "lhs", layout );
+    auto rhs = createArray<double, TEST_DEVICE>( "rhs", layout );
+    auto solver = createSpectralPoissonSolver<double, TEST_DEVICE>(
+        *layout, kernel );
+    EXPECT_EQ( solver->numField(), num_field );
+
+    // Fill the right hand side.
+    auto own_space = local_grid->indexSpace( Own(), Node(), Local() );
+    auto rhs_host = Kokkos::create_mirror_view( rhs->view() );
+    auto mode = [&]( const int n, const int d ) { return 1 + ( n + d ) % 3; };
+    auto value = [&]( const int n, const int i, const int j, const int k ) {
+        const int index[3] = { i, j, k };
+        double phi = 1.0;
+        for ( int d = 0; d < 3; ++d )
+        {
+            double x = ( index[d] - own_space.min( d ) +
+                         global_grid->globalOffset( d ) ) *
+                       cell_size;
+            double length = high_corner[d] - low_corner[d];
+            double arg = 2.0 * M_PI * mode( n, d ) * x / length;
+            phi *= ( 0 == ( n + d ) % 2 ) ? std::sin( arg ) : std::cos( arg );
+        }
+        return phi;
+    };
+    for ( int n = 0; n < num_field; ++n )
+    {
+        double eigenvalue = 0.0;
+        for ( int d = 0; d < 3; ++d )
+        {
+            double length = high_corner[d] - low_corner[d];
+            double k = 2.0 * M_PI * mode( n, d ) / length;
+            double l = ( SpectralPoissonKernel::Continuous == kernel )
+                           ? k
+                           : 2.0 * std::sin( 0.5 * k * cell_size ) /
+                                 cell_size;
+            eigenvalue += l * l;
+        }
+        for ( int i = own_space.min( Dim::I ); i < own_space.max( Dim::I );
+              ++i )
+            for ( int j = own_space.min( Dim::J );
+                  j < own_space.max( Dim::J ); ++j )
+                for ( int k = own_space.min( Dim::K );
+                      k < own_space.max( Dim::K ); ++k )
+                    rhs_host( i, j, k, n ) = -eigenvalue * value( n, i, j, k );
+    }
+    Kokkos::deep_copy( rhs->view(), rhs_host );
+
+    // Solve and check.
+    solver->solve( *rhs, *lhs );
+    auto lhs_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), lhs->view() );
+    for ( int n = 0; n < num_field; ++n )
+        for ( int i = own_space.min( Dim::I ); i < own_space.max( Dim::I );
+              ++i )
+            for ( int j = own_space.min( Dim::J );
+                  j < own_space.max( Dim::J ); ++j )
+                for ( int k = own_space.min( Dim::K );
+                      k < own_space.max( Dim::K ); ++k )
+                    EXPECT_NEAR( lhs_host( i, j, k, n ), value( n, i, j, k ),
+                                 1.0e-10 );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( spectral_poisson_solver, solve_test )
+{
+    for ( auto kernel : { SpectralPoissonKernel::Continuous,
+                          SpectralPoissonKernel::FiniteDifference } )
+    {
+        poissonTest( kernel, 1 );
+        poissonTest( kernel, 3 );
+    }
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
@@ -281,4 +281,111 @@ TEST( cajita_splines, cubic_spline_test )
     EXPECT_FLOAT_EQ( field_grad, grid_deriv( xp ) );
 }
 
+TEST( cajita_splines, quartic_spline_test )
+{
+    // Check partition of unity for the quartic spline.
+    double xp = -1.4;
+    double low_x = -3.43;
+    double dx = 0.27;
+    double rdx = 1.0 / dx;
+    double values[Spline<4>::num_knot];
+
+    for ( double x : { -1.4, 2.1789, low_x + 5 * dx } )
+    {
+        double x0 = Spline<4>::mapToLogicalGrid( x, rdx, low_x );
+        Spline<4>::value( x0, values );
+        double sum = 0.0;
+        for ( auto v : values )
+            sum += v;
+        EXPECT_FLOAT_EQ( sum, 1.0 );
+    }
+
+    // Check the stencil by putting a point in the center of a dual cell (on a
+    // node).
+    int node_id = 4;
+    xp = low_x + ( node_id + 0.25 ) * dx;
+    double x0 = Spline<4>::mapToLogicalGrid( xp, rdx, low_x );
+    int offsets[Spline<4>::num_knot];
+    Spline<4>::offsets( offsets );
+    int stencil[Spline<4>::num_knot];
+    Spline<4>::stencil( x0, stencil );
+    for ( int n = 0; n < Spline<4>::num_knot; ++n )
+    {
+        EXPECT_EQ( int( x0 ) + offsets[n], node_id - 2 + n );
+        EXPECT_EQ( stencil[n], node_id - 2 + n );
+    }
+
+    // Check the interpolation of a function.
+    auto grid_func = [=]( const double x ) { return 4.32 * x - 0.31; };
+    double field[Spline<4>::num_knot];
+    for ( int n = 0; n < Spline<4>::num_knot; ++n )
+        field[n] = grid_func( low_x + ( node_id - 2 + n ) * dx );
+    Spline<4>::value( x0, values );
+    double field_xp = 0.0;
+    for ( int n = 0; n < Spline<4>::num_knot; ++n )
+        field_xp += field[n] * values[n];
+    EXPECT_FLOAT_EQ( field_xp, grid_func( xp ) );
+
+    // Check the derivative of a function.
+    Spline<4>::gradient( x0, rdx, values );
+    double field_grad = 0.0;
+    for ( int n = 0; n < Spline<4>::num_knot; ++n )
+        field_grad += field[n] * values[n];
+    auto grid_deriv = [=]( const double ) { return 4.32; };
+    EXPECT_FLOAT_EQ( field_grad, grid_deriv( xp ) );
+}
+
+TEST( cajita_splines, quintic_spline_test )
+{
+    // Check partition of unity for the quintic spline.
+    double xp = -1.4;
+    double low_x = -3.43;
+    double dx = 0.27;
+    double rdx = 1.0 / dx;
+    double values[Spline<5>::num_knot];
+
+    for ( double x : { -1.4, 2.1789, low_x + 5 * dx } )
+    {
+        double x0 = Spline<5>::mapToLogicalGrid( x, rdx, low_x );
+        Spline<5>::value( x0, values );
+        double sum = 0.0;
+        for ( auto v : values )
+            sum += v;
+        EXPECT_FLOAT_EQ( sum, 1.0 );
+    }
+
+    // Check the stencil by putting a point in the center of a primal cell.
+    int cell_id = 4;
+    xp = low_x + ( cell_id + 0.75 ) * dx;
+    double x0 = Spline<5>::mapToLogicalGrid( xp, rdx, low_x );
+    int offsets[Spline<5>::num_knot];
+    Spline<5>::offsets( offsets );
+    int stencil[Spline<5>::num_knot];
+    Spline<5>::stencil( x0, stencil );
+    for ( int n = 0; n < Spline<5>::num_knot; ++n )
+    {
+        EXPECT_EQ( int( x0 ) + offsets[n], cell_id - 2 + n );
+        EXPECT_EQ( stencil[n], cell_id - 2 + n );
+    }
+
+    // Check the interpolation of a function.
+    auto grid_func = [=]( const double x ) { return 4.32 * x - 0.31; };
+    double field[Spline<5>::num_knot];
+    for ( int n = 0; n < Spline<5>::num_knot; ++n )
+        field[n] = grid_func( low_x + ( cell_id - 2 + n ) * dx );
+    Spline<5>::value( x0, values );
+    double field_xp = 0.0;
+    for ( int n = 0; n < Spline<5>::num_knot; ++n )
+        field_xp += field[n] * values[n];
+    EXPECT_FLOAT_EQ( field_xp, grid_func( xp ) );
+
+    // Check the derivative of a function.
+    Spline<5>::gradient( x0, rdx, values );
+    double field_grad = 0.0;
+    for ( int n = 0; n < Spline<5>::num_knot; ++n )
+        field_grad += field[n] * values[n];
+    auto grid_deriv = [=]( const double ) { return 4.32; };
+    EXPECT_FLOAT_EQ( field_grad, grid_deriv( xp ) );
+}
+
 } // end namespace Test
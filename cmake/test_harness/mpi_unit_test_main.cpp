@@ -15,9 +15,27 @@
 
 #include <mpi.h>
 
+#include <cstdlib>
+#include <iostream>
+
 int main( int argc, char* argv[] )
 {
-    MPI_Init( &argc, &argv );
+    // Full thread support is only requested if the environment asks for it,
+    // e.g. to run the communication progress tests. These are skipped
+    // otherwise.
+    if ( std::getenv( "CABANA_TEST_MPI_THREAD_MULTIPLE" ) )
+    {
+        int provided;
+        MPI_Init_thread( &argc, &argv, MPI_THREAD_MULTIPLE, &provided );
+        if ( provided < MPI_THREAD_MULTIPLE )
+            std::cerr << "MPI_THREAD_MULTIPLE was requested but not provided; "
+                         "tests requiring it will be skipped"
+                      << std::endl;
+    }
+    else
+    {
+        MPI_Init( &argc, &argv );
+    }
     Kokkos::initialize( argc, argv );
     ::testing::InitGoogleTest( &argc, argv );
     int return_val = RUN_ALL_TESTS();
@@ -26,6 +26,7 @@
 
 #include <Kokkos_Core.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <string>
@@ -60,6 +61,41 @@ struct is_aosoa : public is_aosoa_impl<typename std::remove_cv<T>::type>::type
 {
 };
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief Capacity growth policies for AoSoA::resize.
+
+  A growth policy is given the current capacity of a container and a
+  requested number of tuples larger than that capacity and returns the
+  number of tuples to allocate, which must be at least the requested
+  number. User-defined policies may be any function with this signature.
+*/
+namespace GrowthPolicy
+{
+//! Growth policy function type.
+using Function = std::size_t ( * )( const std::size_t capacity,
+                                    const std::size_t n );
+
+//! Allocate exactly the requested number of tuples.
+inline std::size_t exact( const std::size_t, const std::size_t n )
+{
+    return n;
+}
+
+//! Grow the capacity by at least a factor of 1.5.
+inline std::size_t oneAndHalf( const std::size_t capacity,
+                               const std::size_t n )
+{
+    return std::max( n, capacity + capacity / 2 );
+}
+
+//! Grow the capacity by at least a factor of 2.
+inline std::size_t doubling( const std::size_t capacity, const std::size_t n )
+{
+    return std::max( n, 2 * capacity );
+}
+} // end namespace GrowthPolicy
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Create a slice from an AoSoA.
@@ -204,6 +240,7 @@ class AoSoA
         : _size( 0 )
         , _capacity( 0 )
         , _num_soa( 0 )
+        , _growth_policy( GrowthPolicy::exact )
         , _data( Kokkos::ViewAllocateWithoutInitializing( label ), 0 )
     {
         static_assert(
@@ -222,6 +259,7 @@ class AoSoA
         : _size( n )
         , _capacity( 0 )
         , _num_soa( 0 )
+        , _growth_policy( GrowthPolicy::exact )
         , _data( Kokkos::ViewAllocateWithoutInitializing( label ), 0 )
     {
         static_assert(
@@ -243,6 +281,7 @@ class AoSoA
         : _size( n )
         , _capacity( num_soa * vector_length )
         , _num_soa( num_soa )
+        , _growth_policy( GrowthPolicy::exact )
         , _data( ptr, num_soa )
     {
         static_assert( memory_traits::is_unmanaged,
@@ -312,7 +351,8 @@ class AoSoA
       by inserting at the end as many tuples as needed to reach a size of n.
 
       If n is also greater than the current container capacity, an automatic
-      reallocation of the allocated storage space takes place.
+      reallocation of the allocated storage space takes place. The new
+      capacity is given by the growth policy of the container.
 
       Notice that this function changes the actual content of the container by
       inserting or erasing tuples from it. If reallocation occurs, all slices
@@ -325,7 +365,8 @@ class AoSoA
                        "Cannot resize unmanaged memory" );
 
         // Reserve memory if needed.
-        reserve( n );
+        if ( n > _capacity )
+            reserve( _growth_policy( _capacity, n ) );
 
         // Update the sizes of the data. This is potentially different than
         // the amount of allocated data.
@@ -390,6 +431,28 @@ class AoSoA
         _data = resized_data;
     }
 
+    /*!
+      \brief Set the policy used by resize() to grow the capacity.
+
+      \param policy The growth policy. The default policy, GrowthPolicy::exact,
+      allocates exactly the requested number of tuples. Geometric policies
+      such as GrowthPolicy::doubling amortize reallocations over repeated
+      small increases in size.
+
+      The policy does not affect reserve(), which always allocates the
+      requested capacity.
+    */
+    void setGrowthPolicy( GrowthPolicy::Function policy )
+    {
+        _growth_policy = policy;
+    }
+
+    /*!
+      \brief Get the policy used by resize() to grow the capacity.
+      \return The growth policy.
+    */
+    GrowthPolicy::Function growthPolicy() const { return _growth_policy; }
+
     /*!
       \brief Remove unused capacity.
 
@@ -504,6 +567,9 @@ class AoSoA
     // Number of structs-of-arrays in the array.
     size_type _num_soa;
 
+    // Capacity growth policy used when resizing.
+    GrowthPolicy::Function _growth_policy;
+
     // Structs-of-Arrays managed data. This Kokkos View manages the block of
     // memory owned by this class such that the copy constructor and
     // assignment operator for this class perform a shallow and reference
@@ -0,0 +1,171 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_AppendBuffer.hpp
+  \brief Device-side appending of tuples to an AoSoA
+*/
+#ifndef CABANA_APPENDBUFFER_HPP
+#define CABANA_APPENDBUFFER_HPP
+
+#include <Cabana_AoSoA.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <stdexcept>
+#include <type_traits>
+
+namespace Cabana
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief Buffer for appending tuples to an AoSoA from within a kernel.
+
+  \tparam AoSoA_t The AoSoA type.
+
+  Construction reserves capacity in the AoSoA for a maximum number of new
+  tuples. Kernels then append tuples behind the current end of the AoSoA
+  through an atomic cursor without knowing the final count in advance. A
+  host-side commit() resizes the AoSoA to include the appended tuples.
+
+  The AoSoA must not be resized or reserved between construction of the
+  buffer and commit().
+*/
+template <class AoSoA_t>
+class AppendBuffer
+{
+  public:
+    static_assert( is_aosoa<AoSoA_t>::value, "AppendBuffer requires an AoSoA" );
+
+    //! AoSoA type.
+    using aosoa_type = AoSoA_t;
+
+    //! Kokkos memory space.
+    using memory_space = typename aosoa_type::memory_space;
+
+    //! Kokkos execution space.
+    using execution_space = typename aosoa_type::execution_space;
+
+    //! Size type.
+    using size_type = typename aosoa_type::size_type;
+
+    //! Tuple type.
+    using tuple_type = typename aosoa_type::tuple_type;
+
+    /*!
+      \brief Constructor.
+
+      \param aosoa The AoSoA to append to.
+
+      \param max_append The maximum number of tuples which may be appended
+      before the next commit. Capacity for them is reserved in the AoSoA.
+    */
+    AppendBuffer( aosoa_type& aosoa, const size_type max_append )
+        : _begin( aosoa.size() )
+        , _max_append( max_append )
+        , _cursor( "append_cursor" )
+        , _count( "append_count" )
+    {
+        aosoa.reserve( _begin + _max_append );
+        _aosoa = aosoa;
+    }
+
+    /*!
+      \brief Append a tuple.
+
+      \param tpl The tuple to append.
+
+      \return The index of the tuple in the AoSoA, or -1 if the reserved
+      capacity is exhausted and the tuple was dropped.
+    */
+    KOKKOS_INLINE_FUNCTION
+    long append( const tuple_type& tpl ) const
+    {
+        auto idx = claim( 1 );
+        if ( idx >= 0 )
+            _aosoa.setTuple( idx, tpl );
+        return idx;
+    }
+
+    /*!
+      \brief Claim a contiguous range of new tuples to write directly, for
+      example through slices of the AoSoA.
+
+      \param n The number of tuples to claim.
+
+      \return The index of the first claimed tuple in the AoSoA, or -1 if the
+      reserved capacity is exhausted and nothing was claimed.
+    */
+    KOKKOS_INLINE_FUNCTION
+    long claim( const size_type n ) const
+    {
+        size_type offset = Kokkos::atomic_fetch_add( &_cursor(), n );
+        if ( offset + n > _max_append )
+            return -1;
+        Kokkos::atomic_add( &_count(), n );
+        return _begin + offset;
+    }
+
+    /*!
+      \brief Resize the AoSoA to include all tuples appended since
+      construction or the previous commit and reset the buffer to append
+      into the remaining capacity.
+
+      \param aosoa The AoSoA the buffer was created with.
+
+      \return The number of tuples committed. Tuples which did not fit in the
+      reserved capacity are not included.
+    */
+    size_type commit( aosoa_type& aosoa )
+    {
+        if ( aosoa.size() != _begin )
+            throw std::runtime_error( "AoSoA was resized during appending" );
+
+        size_type num_append = appended();
+
+        aosoa.resize( _begin + num_append );
+        _begin += num_append;
+        _max_append -= num_append;
+        Kokkos::deep_copy( _cursor, 0 );
+        Kokkos::deep_copy( _count, 0 );
+
+        return num_append;
+    }
+
+    /*!
+      \brief Get the number of tuples that may still be appended.
+    */
+    size_type available() const { return _max_append - appended(); }
+
+  private:
+    // Get the number of tuples appended since the last commit. A claim that
+    // does not fit fails in full and so do all claims after it, such that
+    // the successful claims are contiguous.
+    size_type appended() const
+    {
+        auto count_host =
+            Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), _count );
+        return count_host();
+    }
+
+  private:
+    aosoa_type _aosoa;
+    size_type _begin;
+    size_type _max_append;
+    Kokkos::View<size_type, memory_space> _cursor;
+    Kokkos::View<size_type, memory_space> _count;
+};
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_APPENDBUFFER_HPP
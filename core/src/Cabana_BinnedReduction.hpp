@@ -0,0 +1,331 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_BinnedReduction.hpp
+  \brief Histograms and per-bin reductions of particle data
+*/
+#ifndef CABANA_BINNEDREDUCTION_HPP
+#define CABANA_BINNEDREDUCTION_HPP
+
+#include <Cabana_Sort.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ScatterView.hpp>
+
+#include <type_traits>
+
+namespace Cabana
+{
+//---------------------------------------------------------------------------//
+// Binned reduction operations.
+//---------------------------------------------------------------------------//
+//! Sum the values of each bin.
+struct BinnedSum
+{
+    //! Scatter operation used with unsorted keys.
+    using scatter_op = Kokkos::Experimental::ScatterSum;
+
+    //! Kokkos reducer used for segmented reductions.
+    template <class T>
+    using reducer = Kokkos::Sum<T>;
+
+    //! Identity value of empty bins.
+    template <class T>
+    KOKKOS_INLINE_FUNCTION static T identity()
+    {
+        return Kokkos::reduction_identity<T>::sum();
+    }
+
+    //! Join a value into a reduction result.
+    template <class T>
+    KOKKOS_INLINE_FUNCTION static void join( T& result, const T value )
+    {
+        result += value;
+    }
+};
+
+//! Take the minimum of the values of each bin.
+struct BinnedMin
+{
+    //! Scatter operation used with unsorted keys.
+    using scatter_op = Kokkos::Experimental::ScatterMin;
+
+    //! Kokkos reducer used for segmented reductions.
+    template <class T>
+    using reducer = Kokkos::Min<T>;
+
+    //! Identity value of empty bins.
+    template <class T>
+    KOKKOS_INLINE_FUNCTION static T identity()
+    {
+        return Kokkos::reduction_identity<T>::min();
+    }
+
+    //! Join a value into a reduction result.
+    template <class T>
+    KOKKOS_INLINE_FUNCTION static void join( T& result, const T value )
+    {
+        if ( value < result )
+            result = value;
+    }
+};
+
+//! Take the maximum of the values of each bin.
+struct BinnedMax
+{
+    //! Scatter operation used with unsorted keys.
+    using scatter_op = Kokkos::Experimental::ScatterMax;
+
+    //! Kokkos reducer used for segmented reductions.
+    template <class T>
+    using reducer = Kokkos::Max<T>;
+
+    //! Identity value of empty bins.
+    template <class T>
+    KOKKOS_INLINE_FUNCTION static T identity()
+    {
+        return Kokkos::reduction_identity<T>::max();
+    }
+
+    //! Join a value into a reduction result.
+    template <class T>
+    KOKKOS_INLINE_FUNCTION static void join( T& result, const T value )
+    {
+        if ( value > result )
+            result = value;
+    }
+};
+
+namespace Impl
+{
+//! \cond Impl
+//---------------------------------------------------------------------------//
+// Reduce contiguous segments of values, one team per bin. The values of bin
+// b are value( i ) for i in [ begin( b ), end( b ) ). Empty bins get the
+// identity of the reducer.
+template <class Op, class ResultView, class BeginFunc, class EndFunc,
+          class ValueFunc>
+void segmentedReduce( const ResultView& result, const BeginFunc& begin,
+                      const EndFunc& end, const ValueFunc& value )
+{
+    using execution_space = typename ResultView::execution_space;
+    using value_type = typename ResultView::non_const_value_type;
+    using team_policy = Kokkos::TeamPolicy<execution_space>;
+    Kokkos::parallel_for(
+        "Cabana::binnedReduce::segmented",
+        team_policy( result.extent( 0 ), Kokkos::AUTO ),
+        KOKKOS_LAMBDA( const typename team_policy::member_type& team ) {
+            int b = team.league_rank();
+            auto first = begin( b );
+            auto last = end( b );
+            value_type bin_result;
+            Kokkos::parallel_reduce(
+                Kokkos::TeamThreadRange( team, first, last ),
+                [&]( const decltype( first ) i, value_type& r ) {
+                    Op::join( r, value( i ) );
+                },
+                typename Op::template reducer<value_type>( bin_result ) );
+            Kokkos::single( Kokkos::PerTeam( team ),
+                            [&]() { result( b ) = bin_result; } );
+        } );
+}
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Reduce values over the bins of a binning without atomics.
+
+  Every bin is reduced by one team over the tuples the binning assigned to
+  it, so no atomic operations are needed.
+
+  \param bin_data The binning of the tuples, e.g. from binByKey().
+  \param values Slice or view of scalar values indexed by tuple.
+  \param op The reduction operation (BinnedSum, BinnedMin, or BinnedMax).
+  \return The reduction of each bin. Empty bins hold the identity of the
+  operation.
+*/
+template <class Op, class DeviceType, class ValuesType>
+Kokkos::View<std::remove_const_t<typename ValuesType::value_type>*,
+             DeviceType>
+binnedReduce( const BinningData<DeviceType>& bin_data,
+              const ValuesType& values, const Op& )
+{
+    using value_type = std::remove_const_t<typename ValuesType::value_type>;
+    Kokkos::View<value_type*, DeviceType> result(
+        Kokkos::ViewAllocateWithoutInitializing( "binned_reduce" ),
+        bin_data.numBin() );
+    Impl::segmentedReduce<Op>(
+        result,
+        KOKKOS_LAMBDA( const int b ) { return bin_data.binOffset( b ); },
+        KOKKOS_LAMBDA( const int b ) {
+            return bin_data.binOffset( b ) + bin_data.binSize( b );
+        },
+        KOKKOS_LAMBDA( const std::size_t i ) {
+            return values( bin_data.permutation( i ) );
+        } );
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Reduce values by integer key.
+
+  Values with keys outside of [0, nbin) are ignored. If the keys are sorted
+  in ascending order each bin is a contiguous segment which is reduced by
+  one team without atomics. Otherwise values are scattered into their bins
+  with Kokkos::ScatterView (duplicated on the host, atomic on devices).
+
+  \param keys Slice or view of the integer bin of each value.
+  \param nbin The number of bins.
+  \param values Slice or view of scalar values.
+  \param op The reduction operation (BinnedSum, BinnedMin, or BinnedMax).
+  \param keys_sorted Whether the keys are sorted in ascending order.
+  \return The reduction of each bin. Empty bins hold the identity of the
+  operation.
+*/
+template <class Op, class KeysType, class ValuesType>
+Kokkos::View<std::remove_const_t<typename ValuesType::value_type>*,
+             typename ValuesType::device_type>
+binnedReduce( const KeysType& keys, const int nbin, const ValuesType& values,
+              const Op&, const bool keys_sorted = false )
+{
+    using device_type = typename ValuesType::device_type;
+    using execution_space = typename device_type::execution_space;
+    using value_type = std::remove_const_t<typename ValuesType::value_type>;
+    using result_view = Kokkos::View<value_type*, device_type>;
+    std::size_t num_value = values.size();
+
+    result_view result(
+        Kokkos::ViewAllocateWithoutInitializing( "binned_reduce" ), nbin );
+
+    if ( keys_sorted )
+    {
+        // Find the beginning of each key segment, skipping leading keys
+        // below the first bin.
+        Kokkos::View<std::size_t*, device_type> segments( "segments",
+                                                          nbin + 1 );
+        Kokkos::parallel_for(
+            "Cabana::binnedReduce::segments",
+            Kokkos::RangePolicy<execution_space>( 0, nbin + 1 ),
+            KOKKOS_LAMBDA( const int b ) {
+                std::size_t lo = 0;
+                std::size_t hi = num_value;
+                while ( lo < hi )
+                {
+                    std::size_t mid = lo + ( hi - lo ) / 2;
+                    if ( keys( mid ) < b )
+                        lo = mid + 1;
+                    else
+                        hi = mid;
+                }
+                segments( b ) = lo;
+            } );
+        Impl::segmentedReduce<Op>(
+            result, KOKKOS_LAMBDA( const int b ) { return segments( b ); },
+            KOKKOS_LAMBDA( const int b ) { return segments( b + 1 ); },
+            KOKKOS_LAMBDA( const std::size_t i ) { return values( i ); } );
+    }
+    else
+    {
+        Kokkos::parallel_for(
+            "Cabana::binnedReduce::init",
+            Kokkos::RangePolicy<execution_space>( 0, nbin ),
+            KOKKOS_LAMBDA( const int b ) {
+                result( b ) = Op::template identity<value_type>();
+            } );
+        Kokkos::Experimental::ScatterView<
+            value_type*, typename result_view::array_layout, device_type,
+            typename Op::scatter_op>
+            result_sv( result );
+        Kokkos::parallel_for(
+            "Cabana::binnedReduce::scatter",
+            Kokkos::RangePolicy<execution_space>( 0, num_value ),
+            KOKKOS_LAMBDA( const std::size_t i ) {
+                auto b = keys( i );
+                if ( b >= 0 && b < nbin )
+                {
+                    auto access = result_sv.access();
+                    access( b ).update( values( i ) );
+                }
+            } );
+        Kokkos::Experimental::contribute( result, result_sv );
+    }
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Get the number of tuples in each bin of a binning.
+  \param bin_data The binning of the tuples, e.g. from binByKey().
+  \return The count of each bin.
+*/
+template <class DeviceType>
+Kokkos::View<int*, DeviceType>
+histogram( const BinningData<DeviceType>& bin_data )
+{
+    using execution_space = typename DeviceType::execution_space;
+    Kokkos::View<int*, DeviceType> counts(
+        Kokkos::ViewAllocateWithoutInitializing( "histogram" ),
+        bin_data.numBin() );
+    Kokkos::parallel_for(
+        "Cabana::histogram::bin_size",
+        Kokkos::RangePolicy<execution_space>( 0, bin_data.numBin() ),
+        KOKKOS_LAMBDA( const int b ) { counts( b ) = bin_data.binSize( b ); } );
+    return counts;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Count values into uniform bins.
+
+  The range [min, max] is divided into nbin equal bins. Values equal to max
+  are counted in the last bin and values outside of the range are ignored.
+
+  \param values Slice or view of scalar values.
+  \param nbin The number of bins.
+  \param min The lower edge of the first bin.
+  \param max The upper edge of the last bin.
+  \return The count of each bin.
+*/
+template <class ValuesType>
+Kokkos::View<int*, typename ValuesType::device_type>
+histogram( const ValuesType& values, const int nbin, const double min,
+           const double max )
+{
+    using device_type = typename ValuesType::device_type;
+    using execution_space = typename device_type::execution_space;
+
+    Kokkos::View<int*, device_type> counts( "histogram", nbin );
+    auto counts_sv = Kokkos::Experimental::create_scatter_view( counts );
+    double inv_width = nbin / ( max - min );
+    Kokkos::parallel_for(
+        "Cabana::histogram::count",
+        Kokkos::RangePolicy<execution_space>( 0, values.size() ),
+        KOKKOS_LAMBDA( const std::size_t i ) {
+            double v = values( i );
+            if ( v >= min && v <= max )
+            {
+                int b = static_cast<int>( ( v - min ) * inv_width );
+                auto access = counts_sv.access();
+                access( ( b < nbin ) ? b : nbin - 1 ) += 1;
+            }
+        } );
+    Kokkos::Experimental::contribute( counts, counts_sv );
+    return counts;
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_BINNEDREDUCTION_HPP
@@ -0,0 +1,428 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_BondedTopology.hpp
+  \brief Bonded interaction topology (bond, angle, and dihedral lists)
+*/
+#ifndef CABANA_BONDEDTOPOLOGY_HPP
+#define CABANA_BONDEDTOPOLOGY_HPP
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_Distributor.hpp>
+#include <Cabana_GlobalIdMap.hpp>
+#include <Cabana_Parallel.hpp>
+#include <Cabana_Slice.hpp>
+#include <impl/Cabana_Profiling.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Cabana
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief List of bonded interactions between groups of particles.
+
+  \tparam MemorySpace The memory space of the list.
+  \tparam NumAtom The number of particles in each interaction (2 for bonds,
+  3 for angles, 4 for dihedrals).
+  \tparam IdType The type of the global particle ids.
+
+  Each interaction is stored by the global ids of its particles such that the
+  list remains valid when particles are migrated and reordered. Kernels
+  instead use the local indices of the particles, which are resolved from the
+  global ids with update() after every change of the local particle data
+  (migration, sorting, halo gather), either from the ids of the local
+  particles or from a GlobalIdMap maintained across the redistribution. A
+  typical redistribution step is:
+
+  \code
+  // Move each interaction to the new owner of its first particle.
+  bonds.migrate( comm, export_ranks, neighbor_ranks );
+  // Move the particles themselves.
+  Cabana::migrate( particle_distributor, particles );
+  // Gather the ghosts the interactions reach.
+  Cabana::gather( particle_halo, particles );
+  // Map the global ids of each interaction to local indices.
+  bonds.update( ids, num_owned, num_owned + num_ghost );
+  \endcode
+
+  Each interaction is owned by the rank owning its first particle. Other
+  particles of the interaction must be locally owned or ghosted for it to be
+  resolved. When a particle is present more than once locally the owned copy
+  is used; otherwise one of its ghost copies is chosen and, for periodic
+  boundaries, kernels should apply the minimum image convention.
+*/
+template <class MemorySpace, std::size_t NumAtom, class IdType = int>
+class BondList
+{
+  public:
+    //! Memory space.
+    using memory_space = MemorySpace;
+
+    //! Default execution space.
+    using execution_space = typename memory_space::execution_space;
+
+    //! Global particle id type.
+    using id_type = IdType;
+
+    //! Number of particles in each interaction.
+    static constexpr std::size_t num_atom = NumAtom;
+
+    //! AoSoA of the global particle ids of each interaction.
+    using aosoa_type = AoSoA<MemberTypes<IdType[NumAtom]>, memory_space>;
+
+    //! View of the local particle indices of each interaction.
+    using index_view_type = Kokkos::View<int* [NumAtom], memory_space>;
+
+    static_assert( NumAtom > 1, "Interactions need at least two particles" );
+
+    /*!
+      \brief Constructor.
+
+      \param label The label of the list.
+
+      \param num_bond The number of interactions in the list.
+    */
+    BondList( const std::string& label = "BondList",
+              const std::size_t num_bond = 0 )
+        : _ids( label + "::ids", num_bond )
+        , _indices( Kokkos::ViewAllocateWithoutInitializing( label +
+                                                             "::indices" ),
+                    num_bond )
+        , _id_map( label + "::id_map" )
+        , _num_unresolved( num_bond )
+    {
+        Kokkos::deep_copy( _indices, -1 );
+    }
+
+    //! Get the number of interactions.
+    std::size_t size() const { return _ids.size(); }
+
+    /*!
+      \brief Resize the list. Interactions are unresolved until the next
+      update.
+
+      \param num_bond The number of interactions in the list.
+    */
+    void resize( const std::size_t num_bond )
+    {
+        _ids.resize( num_bond );
+        invalidate();
+    }
+
+    /*!
+      \brief Get the global particle ids of the interactions. The ids may be
+      assigned through a slice of this AoSoA after resizing the list.
+    */
+    aosoa_type& ids() { return _ids; }
+
+    //! Get the global particle ids of the interactions.
+    const aosoa_type& ids() const { return _ids; }
+
+    /*!
+      \brief Get the local particle indices of the interactions. An index of
+      -1 marks a particle which is not present locally.
+    */
+    index_view_type indices() const { return _indices; }
+
+    //! Get the number of interactions not fully resolved by the last update.
+    std::size_t numUnresolved() const { return _num_unresolved; }
+
+    /*!
+      \brief Map the global ids of each interaction to local particle
+      indices.
+
+      \param particle_ids The global ids of the local particles, owned
+      particles first followed by ghosts.
+
+      \param num_owned The number of locally owned particles.
+
+      \param num_total The number of owned and ghosted particles.
+
+      \return The number of interactions with at least one particle not
+      present locally.
+    */
+    template <class IdSliceType>
+    std::size_t update( const IdSliceType& particle_ids,
+                        const std::size_t num_owned,
+                        const std::size_t num_total )
+    {
+        _id_map.build( particle_ids, num_owned, num_total );
+        return update( _id_map );
+    }
+
+    /*!
+      \brief Map the global ids of each interaction to local particle indices
+      with a global id map maintained by the caller.
+
+      \param id_map The map of the global ids of the local particles.
+
+      \return The number of interactions with at least one particle not
+      present locally.
+    */
+    std::size_t update( const GlobalIdMap<memory_space, IdType>& id_map )
+    {
+        Impl::ScopedProfileRegion region( "Cabana::BondList::update" );
+
+        if ( _indices.extent( 0 ) != size() )
+            Kokkos::realloc( _indices, size() );
+        auto bond_ids = slice<0>( _ids );
+        auto indices = _indices;
+        std::size_t num_unresolved = 0;
+        Kokkos::parallel_reduce(
+            "Cabana::BondList::resolve",
+            Kokkos::RangePolicy<execution_space>( 0, size() ),
+            KOKKOS_LAMBDA( const int b, std::size_t& unresolved ) {
+                bool resolved = true;
+                for ( std::size_t n = 0; n < NumAtom; ++n )
+                {
+                    indices( b, n ) = id_map.find( bond_ids( b, n ) );
+                    if ( indices( b, n ) < 0 )
+                        resolved = false;
+                }
+                if ( !resolved )
+                    ++unresolved;
+            },
+            num_unresolved );
+        _num_unresolved = num_unresolved;
+        return _num_unresolved;
+    }
+
+    /*!
+      \brief Migrate each interaction to the destination rank of its first
+      particle. Interactions are unresolved until the next update.
+
+      This must be called before the particles are migrated as the local
+      indices of the last update are used to find the destination of each
+      interaction. Interactions whose first particle is removed (an export
+      rank of -1) are removed. Interactions whose first particle is not owned
+      stay on this rank.
+
+      \param comm The MPI communicator over which to migrate.
+
+      \param particle_export_ranks The destination rank of each locally owned
+      particle, as given to the particle distributor.
+
+      \param neighbor_ranks List of ranks this rank will send to and receive
+      from, as given to the particle distributor.
+    */
+    template <class ExportRankViewType>
+    void migrate( MPI_Comm comm,
+                  const ExportRankViewType& particle_export_ranks,
+                  const std::vector<int>& neighbor_ranks )
+    {
+        Impl::ScopedProfileRegion region( "Cabana::BondList::migrate" );
+        Distributor<memory_space> distributor(
+            comm, exportRanks( comm, particle_export_ranks ),
+            neighbor_ranks );
+        Cabana::migrate( distributor, _ids );
+        invalidate();
+    }
+
+    /*!
+      \brief Migrate each interaction to the destination rank of its first
+      particle when the communication topology is not known. Interactions are
+      unresolved until the next update.
+
+      \param comm The MPI communicator over which to migrate.
+
+      \param particle_export_ranks The destination rank of each locally owned
+      particle, as given to the particle distributor.
+    */
+    template <class ExportRankViewType>
+    void migrate( MPI_Comm comm,
+                  const ExportRankViewType& particle_export_ranks )
+    {
+        Impl::ScopedProfileRegion region( "Cabana::BondList::migrate" );
+        Distributor<memory_space> distributor(
+            comm, exportRanks( comm, particle_export_ranks ) );
+        Cabana::migrate( distributor, _ids );
+        invalidate();
+    }
+
+  private:
+    // Get the destination rank of each interaction.
+    template <class ExportRankViewType>
+    Kokkos::View<int*, memory_space>
+    exportRanks( MPI_Comm comm,
+                 const ExportRankViewType& particle_export_ranks ) const
+    {
+        if ( _indices.extent( 0 ) != size() )
+            throw std::runtime_error(
+                "BondList must be updated before migration" );
+
+        int comm_rank = -1;
+        MPI_Comm_rank( comm, &comm_rank );
+
+        Kokkos::View<int*, memory_space> export_ranks(
+            Kokkos::ViewAllocateWithoutInitializing( "bond_export_ranks" ),
+            size() );
+        auto indices = _indices;
+        const int num_owned = particle_export_ranks.size();
+        Kokkos::parallel_for(
+            "Cabana::BondList::exportRanks",
+            Kokkos::RangePolicy<execution_space>( 0, size() ),
+            KOKKOS_LAMBDA( const int b ) {
+                int first = indices( b, 0 );
+                export_ranks( b ) = ( first >= 0 && first < num_owned )
+                                        ? particle_export_ranks( first )
+                                        : comm_rank;
+            } );
+        Kokkos::fence();
+        return export_ranks;
+    }
+
+    // Mark every interaction as unresolved.
+    void invalidate()
+    {
+        Kokkos::realloc( _indices, size() );
+        Kokkos::deep_copy( _indices, -1 );
+        _num_unresolved = size();
+    }
+
+  private:
+    aosoa_type _ids;
+    index_view_type _indices;
+    GlobalIdMap<memory_space, IdType> _id_map;
+    std::size_t _num_unresolved;
+};
+
+//---------------------------------------------------------------------------//
+//! List of two-particle bonds.
+template <class MemorySpace, class IdType = int>
+using Bonds = BondList<MemorySpace, 2, IdType>;
+
+//! List of three-particle angles.
+template <class MemorySpace, class IdType = int>
+using Angles = BondList<MemorySpace, 3, IdType>;
+
+//! List of four-particle dihedrals.
+template <class MemorySpace, class IdType = int>
+using Dihedrals = BondList<MemorySpace, 4, IdType>;
+
+//---------------------------------------------------------------------------//
+//! \cond Impl
+template <class>
+struct is_bond_list_impl : public std::false_type
+{
+};
+
+template <class MemorySpace, std::size_t NumAtom, class IdType>
+struct is_bond_list_impl<BondList<MemorySpace, NumAtom, IdType>>
+    : public std::true_type
+{
+};
+//! \endcond
+
+//! BondList static type checker.
+template <class T>
+struct is_bond_list : public is_bond_list_impl<typename std::remove_cv<T>::type>
+{
+};
+
+//---------------------------------------------------------------------------//
+namespace Impl
+{
+//! \cond Impl
+// Call the functor with the interaction index and its local particle indices.
+template <class WorkTag, class FunctorType, class IndexViewType,
+          std::size_t... Is>
+KOKKOS_FORCEINLINE_FUNCTION void
+bondTagDispatch( const FunctorType& functor, const IndexViewType& indices,
+                 const int b, std::index_sequence<Is...> )
+{
+    functorTagDispatch<WorkTag>( functor, b, indices( b, Is )... );
+}
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Execute functor in parallel according to the execution policy over
+  the resolved interactions of a bond list.
+
+  \tparam FunctorType The functor type to execute.
+  \tparam BondListType The bond list type.
+  \tparam ExecParams The Kokkos range policy parameters.
+
+  \param exec_policy The policy over interactions over which to execute the
+  functor.
+  \param functor The functor to execute in parallel
+  \param bonds The bond list over which to execute.
+  \param str Optional name for the functor. Will be forwarded if non-empty to
+  the Kokkos::parallel_for called by this code and can be used for
+  identification and profiling purposes.
+
+  The functor is called with the index of the interaction followed by the
+  local index of each of its particles, e.g. for angles:
+
+  \code
+  class FunctorType {
+  public:
+  void operator() ( const int b, const int i, const int j, const int k ) const;
+  };
+  \endcode
+
+  Interactions with a particle not present locally are skipped.
+*/
+template <class FunctorType, class BondListType, class... ExecParameters>
+inline void
+bond_parallel_for( const Kokkos::RangePolicy<ExecParameters...>& exec_policy,
+                   const FunctorType& functor, const BondListType& bonds,
+                   const std::string& str = "",
+                   typename std::enable_if<is_bond_list<BondListType>::value,
+                                           int>::type* = 0 )
+{
+    using work_tag = typename Kokkos::RangePolicy<ExecParameters...>::work_tag;
+
+    using execution_space =
+        typename Kokkos::RangePolicy<ExecParameters...>::execution_space;
+
+    using memory_space = typename BondListType::memory_space;
+
+    static_assert( is_accessible_from<memory_space, execution_space>{}, "" );
+
+    constexpr std::size_t num_atom = BondListType::num_atom;
+
+    using linear_policy_type = Kokkos::RangePolicy<execution_space, void, void>;
+    linear_policy_type linear_exec_policy( exec_policy.begin(),
+                                           exec_policy.end() );
+
+    auto indices = bonds.indices();
+    auto bond_func = KOKKOS_LAMBDA( const int b )
+    {
+        for ( std::size_t n = 0; n < num_atom; ++n )
+            if ( indices( b, n ) < 0 )
+                return;
+        Impl::bondTagDispatch<work_tag>( functor, indices, b,
+                                         std::make_index_sequence<num_atom>() );
+    };
+    if ( str.empty() )
+        Kokkos::parallel_for( linear_exec_policy, bond_func );
+    else
+        Kokkos::parallel_for( str, linear_exec_policy, bond_func );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_BONDEDTOPOLOGY_HPP
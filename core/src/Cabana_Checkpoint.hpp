@@ -0,0 +1,221 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_Checkpoint.hpp
+  \brief Raw binary checkpoint and restart of AoSoA data
+*/
+#ifndef CABANA_CHECKPOINT_HPP
+#define CABANA_CHECKPOINT_HPP
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_DeepCopy.hpp>
+#include <Cabana_MemberTypes.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace Cabana
+{
+namespace Impl
+{
+//! \cond Impl
+//---------------------------------------------------------------------------//
+// Checkpoint file header. The data following the header is written exactly
+// as it is laid out in memory.
+struct CheckpointHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t vector_length;
+    std::uint64_t block_bytes;
+    std::uint64_t signature;
+    std::uint64_t size;
+    std::uint64_t num_blocks;
+};
+
+constexpr char checkpoint_magic[8] = { 'C', 'A', 'B', 'A', 'N', 'A', 'C', 'P' };
+constexpr std::uint32_t checkpoint_version = 1;
+
+//---------------------------------------------------------------------------//
+// FNV-1a hash step used to build layout signatures.
+inline std::uint64_t signatureHash( std::uint64_t hash,
+                                    const std::uint64_t value )
+{
+    for ( int b = 0; b < 8; ++b )
+    {
+        hash ^= ( value >> ( 8 * b ) ) & 0xff;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+constexpr std::uint64_t signature_seed = 14695981039346656037ull;
+
+// Signature of a single member type: scalar kind, scalar size, and extents.
+template <class T>
+std::uint64_t memberSignature( std::uint64_t hash )
+{
+    using scalar_type = typename std::remove_all_extents<T>::type;
+    hash = signatureHash( hash, sizeof( scalar_type ) );
+    hash = signatureHash( hash, std::is_floating_point<scalar_type>::value
+                                    ? 1
+                                    : std::is_signed<scalar_type>::value ? 2
+                                                                         : 3 );
+    hash = signatureHash( hash, std::rank<T>::value );
+    hash = signatureHash( hash, std::extent<T, 0>::value );
+    hash = signatureHash( hash, std::extent<T, 1>::value );
+    hash = signatureHash( hash, std::extent<T, 2>::value );
+    return hash;
+}
+
+// Signature of all member types in order.
+template <class... Types>
+std::uint64_t typeSignature( MemberTypes<Types...> )
+{
+    std::uint64_t hash = signature_seed;
+    int expand[] = { 0, ( hash = memberSignature<Types>( hash ), 0 )... };
+    (void)expand;
+    return hash;
+}
+
+//---------------------------------------------------------------------------//
+// Write a header and raw data.
+inline void writeCheckpoint( const std::string& path,
+                             CheckpointHeader header, const void* data )
+{
+    std::memcpy( header.magic, checkpoint_magic, sizeof( header.magic ) );
+    header.version = checkpoint_version;
+
+    std::ofstream file( path, std::ios::binary | std::ios::trunc );
+    if ( !file )
+        throw std::runtime_error( "Could not open checkpoint " + path );
+    file.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+    file.write( static_cast<const char*>( data ),
+                header.block_bytes * header.num_blocks );
+    if ( !file )
+        throw std::runtime_error( "Could not write checkpoint " + path );
+}
+
+// Open a checkpoint and read and validate its header against the expected
+// layout.
+inline CheckpointHeader readCheckpointHeader( std::ifstream& file,
+                                              const std::string& path,
+                                              const CheckpointHeader& expected )
+{
+    if ( !file )
+        throw std::runtime_error( "Could not open checkpoint " + path );
+    CheckpointHeader header;
+    file.read( reinterpret_cast<char*>( &header ), sizeof( header ) );
+    if ( !file ||
+         0 != std::memcmp( header.magic, checkpoint_magic,
+                           sizeof( header.magic ) ) ||
+         checkpoint_version != header.version )
+        throw std::runtime_error( path + " is not a Cabana checkpoint" );
+    if ( expected.vector_length != header.vector_length ||
+         expected.block_bytes != header.block_bytes ||
+         expected.signature != header.signature )
+        throw std::runtime_error( "Checkpoint " + path +
+                                  " does not match the restart data layout" );
+    return header;
+}
+
+// Read the raw data following a header.
+inline void readCheckpointData( std::ifstream& file, const std::string& path,
+                                const CheckpointHeader& header, void* data )
+{
+    file.read( static_cast<char*>( data ),
+               header.block_bytes * header.num_blocks );
+    if ( !file )
+        throw std::runtime_error( "Could not read checkpoint " + path );
+}
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Write the raw SoA blocks of an AoSoA to a checkpoint file.
+
+  The blocks are written exactly as laid out in memory after a small header
+  recording the vector length and a signature of the member types, so no
+  per-member serialization is done. Host AoSoAs are written without any
+  copy; other memory spaces are staged through a host mirror.
+
+  \param aosoa The AoSoA to write.
+  \param path The checkpoint file path, e.g. one per rank.
+*/
+template <class AoSoA_t>
+void checkpoint( const AoSoA_t& aosoa, const std::string& path )
+{
+    static_assert( is_aosoa<AoSoA_t>::value, "checkpoint() requires an AoSoA" );
+
+    auto host_aosoa =
+        create_mirror_view_and_copy( Kokkos::HostSpace(), aosoa );
+
+    Impl::CheckpointHeader header;
+    header.vector_length = AoSoA_t::vector_length;
+    header.block_bytes = sizeof( typename AoSoA_t::soa_type );
+    header.signature =
+        Impl::typeSignature( typename AoSoA_t::member_types() );
+    header.size = aosoa.size();
+    header.num_blocks = aosoa.numSoA();
+    Impl::writeCheckpoint( path, header, host_aosoa.data() );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Restore an AoSoA from a checkpoint file written by checkpoint().
+
+  The AoSoA is resized to the checkpointed size and its SoA blocks are read
+  directly into its memory if it is host accessible, otherwise through a
+  host mirror. The vector length and member types must match those of the
+  checkpoint.
+
+  \param aosoa The AoSoA to restore.
+  \param path The checkpoint file path.
+*/
+template <class AoSoA_t>
+void restart( AoSoA_t& aosoa, const std::string& path )
+{
+    static_assert( is_aosoa<AoSoA_t>::value, "restart() requires an AoSoA" );
+
+    Impl::CheckpointHeader expected;
+    expected.vector_length = AoSoA_t::vector_length;
+    expected.block_bytes = sizeof( typename AoSoA_t::soa_type );
+    expected.signature =
+        Impl::typeSignature( typename AoSoA_t::member_types() );
+
+    std::ifstream file( path, std::ios::binary );
+    auto header = Impl::readCheckpointHeader( file, path, expected );
+
+    aosoa.resize( header.size );
+    if ( aosoa.numSoA() != header.num_blocks )
+        throw std::runtime_error( "Checkpoint " + path +
+                                  " has an inconsistent block count" );
+
+    auto host_aosoa = create_mirror_view( Kokkos::HostSpace(), aosoa );
+    Impl::readCheckpointData( file, path, header, host_aosoa.data() );
+    if ( static_cast<void*>( host_aosoa.data() ) !=
+         static_cast<void*>( aosoa.data() ) )
+        deep_copy( aosoa, host_aosoa );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_CHECKPOINT_HPP
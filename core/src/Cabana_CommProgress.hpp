@@ -0,0 +1,180 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_CommProgress.hpp
+  \brief Communication progress thread
+*/
+#ifndef CABANA_COMMPROGRESS_HPP
+#define CABANA_COMMPROGRESS_HPP
+
+#include <mpi.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace Cabana
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief Thread driving MPI progress while split-phase communication is in
+  flight.
+
+  Many MPI implementations only progress non-blocking messages inside MPI
+  calls. When every thread of a CPU backend is busy in a compute kernel
+  between starting and finishing a halo exchange the messages therefore do
+  not move until the exchange is finished. A progress thread polls MPI while
+  at least one operation is outstanding and sleeps otherwise.
+
+  Progress may be attached to communication plans (e.g. a Halo) and to Cajita
+  halos with their setProgress() member. Split-phase operations of these
+  objects are registered with begin() when their messages are posted and
+  with end() once they are complete. The same progress thread may be
+  attached to several objects.
+
+  The thread polls with MPI_Iprobe on a private communicator rather than
+  testing the requests of the operations, as MPI does not allow a request to
+  be completed by two threads concurrently. Any MPI call progresses all
+  outstanding messages of the process in common implementations.
+
+  \note Requires MPI to be initialized with MPI_THREAD_MULTIPLE. The
+  progress thread should be pinned to a core not used by the compute
+  threads, e.g. by leaving one core per rank free of OpenMP threads.
+*/
+class CommProgress
+{
+  public:
+    /*!
+      \brief Constructor. Starts the progress thread. This is a collective
+      operation over the given communicator.
+
+      \param comm The communicator from which the private polling
+      communicator is duplicated.
+
+      \param poll_interval Time to sleep between polls. By default the
+      thread yields between polls.
+    */
+    CommProgress( MPI_Comm comm = MPI_COMM_WORLD,
+                  const std::chrono::microseconds poll_interval =
+                      std::chrono::microseconds( 0 ) )
+        : _poll_interval( poll_interval )
+        , _num_active( 0 )
+        , _stop( false )
+        , _num_polls( 0 )
+    {
+        if ( !threadSupport() )
+            throw std::runtime_error(
+                "CommProgress requires MPI_THREAD_MULTIPLE" );
+        MPI_Comm_dup( comm, &_comm );
+        _thread = std::thread( [this]() { run(); } );
+    }
+
+    //! Destructor. Stops the progress thread.
+    ~CommProgress()
+    {
+        {
+            std::lock_guard<std::mutex> lock( _mutex );
+            _stop = true;
+        }
+        _condition.notify_all();
+        _thread.join();
+        MPI_Comm_free( &_comm );
+    }
+
+    CommProgress( const CommProgress& ) = delete;
+    CommProgress& operator=( const CommProgress& ) = delete;
+
+    /*!
+      \brief Determine if MPI was initialized with the thread support needed
+      for a progress thread.
+    */
+    static bool threadSupport()
+    {
+        int provided = MPI_THREAD_SINGLE;
+        MPI_Query_thread( &provided );
+        return ( provided >= MPI_THREAD_MULTIPLE );
+    }
+
+    //! Register an operation with outstanding messages. Wakes the thread.
+    void begin()
+    {
+        {
+            std::lock_guard<std::mutex> lock( _mutex );
+            ++_num_active;
+        }
+        _condition.notify_one();
+    }
+
+    //! Register the completion of an operation.
+    void end()
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+        if ( _num_active > 0 )
+            --_num_active;
+    }
+
+    //! Get the number of outstanding operations.
+    std::size_t numActive() const
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+        return _num_active;
+    }
+
+    //! Get the number of polls made by the thread.
+    std::size_t numPolls() const { return _num_polls.load(); }
+
+  private:
+    // Poll while operations are outstanding and sleep otherwise.
+    void run()
+    {
+        while ( true )
+        {
+            {
+                std::unique_lock<std::mutex> lock( _mutex );
+                _condition.wait(
+                    lock, [this]() { return _stop || _num_active > 0; } );
+                if ( _stop )
+                    return;
+            }
+
+            int flag = 0;
+            MPI_Iprobe( MPI_ANY_SOURCE, MPI_ANY_TAG, _comm, &flag,
+                        MPI_STATUS_IGNORE );
+            ++_num_polls;
+
+            if ( _poll_interval.count() > 0 )
+                std::this_thread::sleep_for( _poll_interval );
+            else
+                std::this_thread::yield();
+        }
+    }
+
+  private:
+    MPI_Comm _comm;
+    std::chrono::microseconds _poll_interval;
+    mutable std::mutex _mutex;
+    std::condition_variable _condition;
+    std::size_t _num_active;
+    bool _stop;
+    std::atomic<std::size_t> _num_polls;
+    std::thread _thread;
+};
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_COMMPROGRESS_HPP
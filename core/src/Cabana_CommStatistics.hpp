@@ -0,0 +1,304 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_CommStatistics.hpp
+  \brief Communication statistics counters
+*/
+#ifndef CABANA_COMMSTATISTICS_HPP
+#define CABANA_COMMSTATISTICS_HPP
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <array>
+#include <cstddef>
+#include <iomanip>
+#include <ostream>
+#include <string>
+
+namespace Cabana
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief Range of a communication statistic over the ranks of a communicator.
+*/
+struct CommStatisticRange
+{
+    //! Minimum over all ranks.
+    double min;
+    //! Maximum over all ranks.
+    double max;
+    //! Average over all ranks.
+    double avg;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Summary of the communication statistics of all ranks of a
+  communicator.
+*/
+struct CommStatisticsSummary
+{
+    //! Number of communication operations.
+    CommStatisticRange num_operations;
+    //! Number of messages sent to other ranks.
+    CommStatisticRange num_messages_sent;
+    //! Number of messages received from other ranks.
+    CommStatisticRange num_messages_received;
+    //! Number of bytes sent to other ranks.
+    CommStatisticRange bytes_sent;
+    //! Number of bytes received from other ranks.
+    CommStatisticRange bytes_received;
+    //! Number of bytes copied from this rank to itself.
+    CommStatisticRange bytes_self;
+    //! Time in seconds spent waiting on communication.
+    CommStatisticRange wait_time;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Accumulator of the communication statistics of a rank.
+
+  Statistics may be attached to communication plans (e.g. a Halo or a
+  Distributor) and to Cajita halos with their setStatistics() member. Every
+  operation executed by a plan with statistics attached adds the number of
+  messages and bytes it exchanges with other ranks, the number of bytes the
+  rank exchanges with itself, and the time spent blocked on MPI completion
+  calls and barriers. The same statistics may be attached to several plans
+  to accumulate their totals. Statistics are not thread safe.
+*/
+class CommStatistics
+{
+  public:
+    //! Default constructor. All counters are zero.
+    CommStatistics() { reset(); }
+
+    //! Set all counters to zero.
+    void reset()
+    {
+        _num_operations = 0;
+        _num_messages_sent = 0;
+        _num_messages_received = 0;
+        _bytes_sent = 0;
+        _bytes_received = 0;
+        _bytes_self = 0;
+        _wait_time = 0.0;
+    }
+
+    /*!
+      \brief Record a communication operation.
+
+      \param num_messages_sent The number of messages sent to other ranks.
+
+      \param bytes_sent The number of bytes sent to other ranks.
+
+      \param num_messages_received The number of messages received from other
+      ranks.
+
+      \param bytes_received The number of bytes received from other ranks.
+
+      \param bytes_self The number of bytes copied from this rank to itself.
+    */
+    void recordOperation( const std::size_t num_messages_sent,
+                          const std::size_t bytes_sent,
+                          const std::size_t num_messages_received,
+                          const std::size_t bytes_received,
+                          const std::size_t bytes_self )
+    {
+        ++_num_operations;
+        _num_messages_sent += num_messages_sent;
+        _bytes_sent += bytes_sent;
+        _num_messages_received += num_messages_received;
+        _bytes_received += bytes_received;
+        _bytes_self += bytes_self;
+    }
+
+    //! Record time in seconds spent waiting on communication.
+    void recordWait( const double seconds ) { _wait_time += seconds; }
+
+    //! Get the number of communication operations.
+    std::size_t numOperations() const { return _num_operations; }
+
+    //! Get the number of messages sent to other ranks.
+    std::size_t numMessagesSent() const { return _num_messages_sent; }
+
+    //! Get the number of messages received from other ranks.
+    std::size_t numMessagesReceived() const { return _num_messages_received; }
+
+    //! Get the number of bytes sent to other ranks.
+    std::size_t bytesSent() const { return _bytes_sent; }
+
+    //! Get the number of bytes received from other ranks.
+    std::size_t bytesReceived() const { return _bytes_received; }
+
+    //! Get the number of bytes copied from this rank to itself.
+    std::size_t bytesSelf() const { return _bytes_self; }
+
+    //! Get the time in seconds spent waiting on communication.
+    double waitTime() const { return _wait_time; }
+
+    /*!
+      \brief Reduce the statistics of all ranks of a communicator. This is a
+      collective operation.
+
+      \param comm The communicator over which to reduce.
+
+      \return The minimum, maximum, and average of each statistic.
+    */
+    CommStatisticsSummary summarize( MPI_Comm comm ) const
+    {
+        std::array<double, 7> local = {
+            static_cast<double>( _num_operations ),
+            static_cast<double>( _num_messages_sent ),
+            static_cast<double>( _num_messages_received ),
+            static_cast<double>( _bytes_sent ),
+            static_cast<double>( _bytes_received ),
+            static_cast<double>( _bytes_self ),
+            _wait_time };
+        std::array<double, 7> min;
+        std::array<double, 7> max;
+        std::array<double, 7> sum;
+        MPI_Allreduce( local.data(), min.data(), local.size(), MPI_DOUBLE,
+                       MPI_MIN, comm );
+        MPI_Allreduce( local.data(), max.data(), local.size(), MPI_DOUBLE,
+                       MPI_MAX, comm );
+        MPI_Allreduce( local.data(), sum.data(), local.size(), MPI_DOUBLE,
+                       MPI_SUM, comm );
+        int comm_size = 1;
+        MPI_Comm_size( comm, &comm_size );
+
+        auto range = [&]( const int i ) {
+            return CommStatisticRange{ min[i], max[i], sum[i] / comm_size };
+        };
+        CommStatisticsSummary summary;
+        summary.num_operations = range( 0 );
+        summary.num_messages_sent = range( 1 );
+        summary.num_messages_received = range( 2 );
+        summary.bytes_sent = range( 3 );
+        summary.bytes_received = range( 4 );
+        summary.bytes_self = range( 5 );
+        summary.wait_time = range( 6 );
+        return summary;
+    }
+
+    /*!
+      \brief Write the statistics of this rank.
+
+      \param stream The stream to write to.
+    */
+    void report( std::ostream& stream ) const
+    {
+        stream << "operations " << _num_operations << "\n"
+               << "messages_sent " << _num_messages_sent << "\n"
+               << "messages_received " << _num_messages_received << "\n"
+               << "bytes_sent " << _bytes_sent << "\n"
+               << "bytes_received " << _bytes_received << "\n"
+               << "bytes_self " << _bytes_self << "\n"
+               << "wait_time " << _wait_time << std::endl;
+    }
+
+    /*!
+      \brief Write the minimum, maximum, and average of the statistics over
+      all ranks of a communicator. This is a collective operation and only
+      rank 0 of the communicator writes to the stream.
+
+      \param stream The stream to write to.
+
+      \param comm The communicator over which to reduce.
+    */
+    void report( std::ostream& stream, MPI_Comm comm ) const
+    {
+        auto summary = summarize( comm );
+        int comm_rank = -1;
+        MPI_Comm_rank( comm, &comm_rank );
+        if ( 0 != comm_rank )
+            return;
+
+        auto write = [&]( const std::string& name,
+                          const CommStatisticRange& range ) {
+            stream << std::left << std::setw( 18 ) << name << " min "
+                   << range.min << " max " << range.max << " avg "
+                   << range.avg << "\n";
+        };
+        stream << std::setw( 18 ) << "statistic"
+               << " min/max/avg over ranks\n";
+        write( "operations", summary.num_operations );
+        write( "messages_sent", summary.num_messages_sent );
+        write( "messages_received", summary.num_messages_received );
+        write( "bytes_sent", summary.bytes_sent );
+        write( "bytes_received", summary.bytes_received );
+        write( "bytes_self", summary.bytes_self );
+        write( "wait_time", summary.wait_time );
+        stream << std::right << std::flush;
+    }
+
+  private:
+    std::size_t _num_operations;
+    std::size_t _num_messages_sent;
+    std::size_t _num_messages_received;
+    std::size_t _bytes_sent;
+    std::size_t _bytes_received;
+    std::size_t _bytes_self;
+    double _wait_time;
+};
+
+namespace Impl
+{
+//! \cond Impl
+//---------------------------------------------------------------------------//
+// Wait on communication. A profiling region with the given name is pushed on
+// construction and popped when the wait is stopped or the object is
+// destroyed. If statistics are given the elapsed time is recorded in them.
+class CommWait
+{
+  public:
+    CommWait( const std::string& name, CommStatistics* stats )
+        : _stats( stats )
+        , _active( true )
+        , _start( 0.0 )
+    {
+        Kokkos::Profiling::pushRegion( name );
+        if ( _stats )
+            _start = MPI_Wtime();
+    }
+
+    ~CommWait() { stop(); }
+
+    CommWait( const CommWait& ) = delete;
+    CommWait& operator=( const CommWait& ) = delete;
+
+    void stop()
+    {
+        if ( !_active )
+            return;
+        _active = false;
+        if ( _stats )
+            _stats->recordWait( MPI_Wtime() - _start );
+        Kokkos::Profiling::popRegion();
+    }
+
+  private:
+    CommStatistics* _stats;
+    bool _active;
+    double _start;
+};
+
+//---------------------------------------------------------------------------//
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_COMMSTATISTICS_HPP
@@ -17,16 +17,26 @@
 #define CABANA_COMMUNICATIONPLAN_HPP
 
 #include <CabanaCore_config.hpp>
+#include <Cabana_CommProgress.hpp>
+#include <Cabana_CommStatistics.hpp>
+#include <Cabana_Sort.hpp>
+#include <impl/Cabana_Profiling.hpp>
 
 #include <Kokkos_Core.hpp>
 #include <Kokkos_ScatterView.hpp>
 
 #include <mpi.h>
+#ifdef Cabana_HAVE_MPI_EXT
+#include <mpi-ext.h>
+#endif
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <exception>
 #include <memory>
 #include <numeric>
+#include <stdexcept>
 #include <type_traits>
 #include <vector>
 
@@ -43,47 +53,8 @@ struct CountSendsAndCreateSteeringDuplicated
 struct CountSendsAndCreateSteeringAtomic
 {
 };
-
-//---------------------------------------------------------------------------//
-// Count sends and create steering algorithm selector.
-template <class ExecutionSpace>
-struct CountSendsAndCreateSteeringAlgorithm;
-
-// CUDA and HIP use atomics.
-#ifdef KOKKOS_ENABLE_CUDA
-template <>
-struct CountSendsAndCreateSteeringAlgorithm<Kokkos::Cuda>
+struct CountSendsAndCreateSteeringSort
 {
-    using type = CountSendsAndCreateSteeringAtomic;
-};
-#endif // end KOKKOS_ENABLE_CUDA
-#ifdef KOKKOS_ENABLE_HIP
-template <>
-struct CountSendsAndCreateSteeringAlgorithm<Kokkos::Experimental::HIP>
-{
-    using type = CountSendsAndCreateSteeringAtomic;
-};
-#endif // end KOKKOS_ENABLE_HIP
-#ifdef KOKKOS_ENABLE_SYCL
-template <>
-struct CountSendsAndCreateSteeringAlgorithm<Kokkos::Experimental::SYCL>
-{
-    using type = CountSendsAndCreateSteeringAtomic;
-};
-#endif // end KOKKOS_ENABLE_SYCL
-#ifdef KOKKOS_ENABLE_OPENMPTARGET
-template <>
-struct CountSendsAndCreateSteeringAlgorithm<Kokkos::Experimental::OpenMPTarget>
-{
-    using type = CountSendsAndCreateSteeringAtomic;
-};
-#endif // end KOKKOS_ENABLE_OPENMPTARGET
-
-// The default is to use duplication.
-template <class ExecutionSpace>
-struct CountSendsAndCreateSteeringAlgorithm
-{
-    using type = CountSendsAndCreateSteeringDuplicated;
 };
 
 //---------------------------------------------------------------------------//
@@ -354,6 +325,156 @@ auto countSendsAndCreateSteering( const ExportRankView element_export_ranks,
     return std::make_pair( neighbor_counts, neighbor_ids );
 }
 
+//---------------------------------------------------------------------------//
+// Count sends and generate the steering vector. Sorted version.
+template <class ExportRankView>
+auto countSendsAndCreateSteering( const ExportRankView element_export_ranks,
+                                  const int comm_size,
+                                  CountSendsAndCreateSteeringSort )
+    -> std::pair<Kokkos::View<int*, typename ExportRankView::device_type>,
+                 Kokkos::View<typename ExportRankView::size_type*,
+                              typename ExportRankView::device_type>>
+{
+    using device_type = typename ExportRankView::device_type;
+    using execution_space = typename ExportRankView::execution_space;
+    using size_type = typename ExportRankView::size_type;
+
+    std::size_t num_element = element_export_ranks.size();
+    execution_space exec_space;
+
+    // Create views.
+    Kokkos::View<int*, device_type> neighbor_counts(
+        Kokkos::ViewAllocateWithoutInitializing( "neighbor_counts" ),
+        comm_size );
+    Kokkos::View<size_type*, device_type> neighbor_ids(
+        Kokkos::ViewAllocateWithoutInitializing( "neighbor_ids" ),
+        num_element );
+    Kokkos::View<int*, device_type> keys(
+        Kokkos::ViewAllocateWithoutInitializing( "export_rank_keys" ),
+        num_element );
+    Kokkos::View<size_type*, device_type> rank_begin( "rank_begin",
+                                                      comm_size + 1 );
+    Kokkos::View<size_type*, device_type> rank_end( "rank_end",
+                                                    comm_size + 1 );
+
+    // Sort the elements by destination rank with a stable radix sort. The
+    // elements that are not exported are sorted behind all ranks.
+    Kokkos::parallel_for(
+        "Cabana::CommunicationPlan::sortKeys",
+        Kokkos::RangePolicy<execution_space>( exec_space, 0, num_element ),
+        KOKKOS_LAMBDA( const size_type i ) {
+            keys( i ) = ( element_export_ranks( i ) >= 0 )
+                            ? element_export_ranks( i )
+                            : comm_size;
+        } );
+    auto permute_vector =
+        radixPermutation<execution_space, Kokkos::View<int*, device_type>,
+                         device_type>( exec_space, keys, 0, num_element );
+
+    // Find the range of the sorted elements sent to each rank.
+    Kokkos::parallel_for(
+        "Cabana::CommunicationPlan::rankRanges",
+        Kokkos::RangePolicy<execution_space>( exec_space, 0, num_element ),
+        KOKKOS_LAMBDA( const size_type k ) {
+            int r = keys( permute_vector( k ) );
+            if ( k == 0 || keys( permute_vector( k - 1 ) ) != r )
+                rank_begin( r ) = k;
+            if ( k + 1 == num_element || keys( permute_vector( k + 1 ) ) != r )
+                rank_end( r ) = k + 1;
+        } );
+
+    // Count the sends to each rank.
+    Kokkos::parallel_for(
+        "Cabana::CommunicationPlan::sortedCount",
+        Kokkos::RangePolicy<execution_space>( exec_space, 0, comm_size ),
+        KOKKOS_LAMBDA( const int r ) {
+            neighbor_counts( r ) = rank_end( r ) - rank_begin( r );
+        } );
+
+    // The location of each export element in the send buffer of its
+    // destination rank is its position in the sorted range of that rank.
+    Kokkos::parallel_for(
+        "Cabana::CommunicationPlan::sortedSteering",
+        Kokkos::RangePolicy<execution_space>( exec_space, 0, num_element ),
+        KOKKOS_LAMBDA( const size_type k ) {
+            auto i = permute_vector( k );
+            int r = keys( i );
+            if ( r < comm_size )
+                neighbor_ids( i ) = k - rank_begin( r );
+        } );
+    Kokkos::fence();
+
+    // Return the counts and ids.
+    return std::make_pair( neighbor_counts, neighbor_ids );
+}
+
+//---------------------------------------------------------------------------//
+// Count sends and create steering algorithm choices.
+enum class CountSendsAndCreateSteeringChoice
+{
+    Duplicated,
+    Atomic,
+    Sort
+};
+
+//---------------------------------------------------------------------------//
+// Count sends and create steering algorithm selector.
+//
+// The duplicated algorithm keeps a count per neighbor and an id per element
+// for every thread and reduces over the threads for every element, so it is
+// only used in host spaces while these copies stay small. Otherwise the
+// atomic algorithm is used for up to 64 neighbors, where it builds team
+// histograms in scratch memory instead of contending on global counters, and
+// the sort algorithm is used for more neighbors.
+template <class ExecutionSpace>
+CountSendsAndCreateSteeringChoice
+selectCountSendsAndCreateSteering( const int num_neighbor,
+                                   const std::size_t num_element,
+                                   const int concurrency )
+{
+    const bool host_space =
+        Kokkos::SpaceAccessibility<
+            Kokkos::HostSpace,
+            typename ExecutionSpace::memory_space>::accessible;
+    const std::size_t copy_size = num_element + num_neighbor;
+    const std::size_t max_dup_size = std::max( 16 * copy_size,
+                                               std::size_t( 1 ) << 22 );
+    if ( host_space && concurrency * copy_size <= max_dup_size )
+        return CountSendsAndCreateSteeringChoice::Duplicated;
+    else if ( num_neighbor <= 64 )
+        return CountSendsAndCreateSteeringChoice::Atomic;
+    else
+        return CountSendsAndCreateSteeringChoice::Sort;
+}
+
+//---------------------------------------------------------------------------//
+// Count sends and generate the steering vector with the algorithm selected
+// for the execution space and problem size.
+template <class ExportRankView>
+auto countSendsAndCreateSteering( const ExportRankView element_export_ranks,
+                                  const int comm_size )
+    -> std::pair<Kokkos::View<int*, typename ExportRankView::device_type>,
+                 Kokkos::View<typename ExportRankView::size_type*,
+                              typename ExportRankView::device_type>>
+{
+    using execution_space = typename ExportRankView::execution_space;
+    auto choice = selectCountSendsAndCreateSteering<execution_space>(
+        comm_size, element_export_ranks.size(),
+        execution_space().concurrency() );
+    if ( choice == CountSendsAndCreateSteeringChoice::Duplicated )
+        return countSendsAndCreateSteering(
+            element_export_ranks, comm_size,
+            CountSendsAndCreateSteeringDuplicated() );
+    else if ( choice == CountSendsAndCreateSteeringChoice::Atomic )
+        return countSendsAndCreateSteering(
+            element_export_ranks, comm_size,
+            CountSendsAndCreateSteeringAtomic() );
+    else
+        return countSendsAndCreateSteering(
+            element_export_ranks, comm_size,
+            CountSendsAndCreateSteeringSort() );
+}
+
 //---------------------------------------------------------------------------//
 // Return unique neighbor ranks, with the current rank first.
 inline std::vector<int> getUniqueTopology( std::vector<int> topology )
@@ -377,10 +498,232 @@ inline std::vector<int> getUniqueTopology( std::vector<int> topology )
     return topology;
 }
 
+//---------------------------------------------------------------------------//
+// Determine if MPI can directly communicate device memory. If GPU-aware MPI
+// was disabled at configure time this is always false. Otherwise, it is
+// queried from MPI when the implementation supports it.
+inline bool isGpuAwareMpi()
+{
+#ifndef Cabana_ENABLE_GPU_AWARE_MPI
+    return false;
+#elif defined( KOKKOS_ENABLE_CUDA ) && defined( MPIX_CUDA_AWARE_SUPPORT ) &&   \
+    MPIX_CUDA_AWARE_SUPPORT
+    return ( 1 == MPIX_Query_cuda_support() );
+#elif defined( KOKKOS_ENABLE_HIP ) && defined( MPIX_ROCM_AWARE_SUPPORT ) &&    \
+    MPIX_ROCM_AWARE_SUPPORT
+    return ( 1 == MPIX_Query_rocm_support() );
+#else
+    return true;
+#endif
+}
+
+//---------------------------------------------------------------------------//
+// Memory space used to stage messages of data in a given memory space through
+// the host. Pinned memory is used when available.
+template <class MemorySpace>
+struct CommStagingSpace
+{
+    using type = Kokkos::HostSpace;
+};
+
+#ifdef KOKKOS_ENABLE_CUDA
+template <>
+struct CommStagingSpace<Kokkos::CudaSpace>
+{
+    using type = Kokkos::CudaHostPinnedSpace;
+};
+#endif // end KOKKOS_ENABLE_CUDA
+#ifdef KOKKOS_ENABLE_HIP
+template <>
+struct CommStagingSpace<Kokkos::Experimental::HIPSpace>
+{
+    using type = Kokkos::Experimental::HIPHostPinnedSpace;
+};
+#endif // end KOKKOS_ENABLE_HIP
+
+//---------------------------------------------------------------------------//
+// Send and receive byte buffers used for a communication operation. If the
+// messages are staged, the send data is asynchronously copied to host
+// buffers on construction and MPI operates on the host buffers. Otherwise,
+// MPI directly uses the given buffers.
+template <class MemorySpace>
+class CommStaging
+{
+  public:
+    using memory_space = MemorySpace;
+    using staging_space = typename CommStagingSpace<memory_space>::type;
+    using buffer_type = Kokkos::View<char*, memory_space>;
+    using host_buffer_type = Kokkos::View<char*, staging_space>;
+
+    // Direct communication constructor.
+    CommStaging( const buffer_type& send_buffer,
+                 const buffer_type& recv_buffer )
+        : _staged( false )
+        , _send_buffer( send_buffer )
+        , _recv_buffer( recv_buffer )
+        , _recv_bytes( 0 )
+    {
+    }
+
+    // Staged communication constructor. The host buffers must be at least as
+    // large as the number of bytes to send and receive.
+    template <class ExecutionSpace>
+    CommStaging( const ExecutionSpace& exec_space,
+                 const buffer_type& send_buffer,
+                 const std::size_t send_bytes,
+                 const buffer_type& recv_buffer,
+                 const std::size_t recv_bytes,
+                 const host_buffer_type& host_send_buffer,
+                 const host_buffer_type& host_recv_buffer )
+        : _staged( true )
+        , _send_buffer( send_buffer )
+        , _recv_buffer( recv_buffer )
+        , _host_send_buffer( host_send_buffer )
+        , _host_recv_buffer( host_recv_buffer )
+        , _recv_bytes( recv_bytes )
+    {
+        std::pair<std::size_t, std::size_t> range = { 0, send_bytes };
+        Kokkos::deep_copy( exec_space,
+                           Kokkos::subview( _host_send_buffer, range ),
+                           Kokkos::subview( _send_buffer, range ) );
+    }
+
+    // Determine if messages are staged through the host.
+    bool staged() const { return _staged; }
+
+    // Get the data to send. This will wait for the staging copy to finish.
+    char* sendData() const
+    {
+        if ( _staged )
+        {
+            Kokkos::fence();
+            return _host_send_buffer.data();
+        }
+        return _send_buffer.data();
+    }
+
+    // Get the location to receive data.
+    char* recvData() const
+    {
+        return ( _staged ) ? _host_recv_buffer.data() : _recv_buffer.data();
+    }
+
+    // Complete the receipt of the data after the messages are done by
+    // copying it to the receive buffer if staged.
+    void finishRecv() const { finishRecv( 0, _recv_bytes ); }
+
+    // Complete the receipt of a range of the data after the messages
+    // containing it are done.
+    void finishRecv( const std::size_t offset,
+                     const std::size_t num_bytes ) const
+    {
+        if ( _staged && num_bytes > 0 )
+        {
+            std::pair<std::size_t, std::size_t> range = { offset,
+                                                          offset + num_bytes };
+            Kokkos::deep_copy( Kokkos::subview( _recv_buffer, range ),
+                               Kokkos::subview( _host_recv_buffer, range ) );
+        }
+    }
+
+  private:
+    bool _staged;
+    buffer_type _send_buffer;
+    buffer_type _recv_buffer;
+    host_buffer_type _host_send_buffer;
+    host_buffer_type _host_recv_buffer;
+    std::size_t _recv_bytes;
+};
+
+//---------------------------------------------------------------------------//
+// Type used to send a value of the given type with reduced precision. Double
+// values are sent as float and all other types are sent unchanged.
+template <class T>
+struct ReducedPrecision
+{
+    using type = T;
+};
+
+template <>
+struct ReducedPrecision<double>
+{
+    using type = float;
+};
+
 //---------------------------------------------------------------------------//
 //! \endcond
 } // end namespace Impl
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief Transport used to communicate data that lives in device memory.
+
+  Direct - device buffers are passed directly to MPI. This requires GPU-aware
+  MPI.
+
+  HostStaged - device buffers are copied to pinned host buffers before
+  sending and received data is copied back to the device.
+
+  Automatic - messages are staged through the host if MPI is not GPU-aware or
+  if the message size is below the staging threshold of the plan. Otherwise
+  they are passed directly to MPI.
+
+  The transport has no effect on data in host-accessible memory which is
+  always passed directly to MPI.
+*/
+enum class CommTransport
+{
+    Direct,
+    HostStaged,
+    Automatic
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief MPI backend used to exchange data with the neighbors of a plan.
+
+  PointToPoint - one non-blocking send and receive is posted for each
+  neighbor.
+
+  NeighborCollective - a distributed graph communicator is created for the
+  plan topology and data is exchanged with a single non-blocking neighborhood
+  collective (MPI_Ineighbor_alltoallv) such that the MPI library may
+  optimize the exchange pattern.
+
+  NodeShared - neighbors on the same shared-memory node are recognized with
+  MPI_Comm_split_type and exchange data through an MPI shared memory window
+  instead of MPI messages. A single copy is made by the receiver directly out
+  of the memory of the sender. Neighbors on other nodes still use
+  point-to-point messages. The exchange is blocking and is collective over
+  the ranks of the plan on each node. Data in memory that is not host
+  accessible is always staged through the host with this backend.
+*/
+enum class CommBackend
+{
+    PointToPoint,
+    NeighborCollective,
+    NodeShared
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Precision of the data sent by a halo gather.
+
+  Full - data is sent with the value type of the field.
+
+  Reduced - double precision fields are sent as single precision and widened
+  again when the ghosts are unpacked. The ghosted values are therefore only
+  accurate to single precision. This halves the message size of these fields
+  and is intended for ghosts that do not need full precision, such as the
+  positions used for a neighbor search. Other value types are sent
+  unchanged.
+*/
+enum class CommPrecision
+{
+    Full,
+    Reduced
+};
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Communication plan base class.
@@ -431,6 +774,10 @@ class CommunicationPlan
       \return The MPI communicator for this plan.
     */
     CommunicationPlan( MPI_Comm comm )
+        : _transport( CommTransport::Automatic )
+        , _staging_threshold( 0 )
+        , _gpu_aware_mpi( Impl::isGpuAwareMpi() )
+        , _backend( CommBackend::PointToPoint )
     {
         _comm_ptr.reset(
             // Duplicate the communicator and store in a std::shared_ptr so that
@@ -546,6 +893,146 @@ class CommunicationPlan
         return _export_steering;
     }
 
+    /*!
+      \brief Set the transport used to communicate data in device memory.
+
+      \param transport The transport to use.
+
+      \param staging_threshold When using the automatic transport, operations
+      communicating fewer than this number of bytes in total are staged
+      through host memory even if MPI is GPU-aware.
+    */
+    void setTransport( const CommTransport transport,
+                       const std::size_t staging_threshold = 0 )
+    {
+        _transport = transport;
+        _staging_threshold = staging_threshold;
+    }
+
+    /*!
+      \brief Get the transport used to communicate data in device memory.
+    */
+    CommTransport transport() const { return _transport; }
+
+    /*!
+      \brief Get the automatic transport staging threshold in bytes.
+    */
+    std::size_t stagingThreshold() const { return _staging_threshold; }
+
+    /*!
+      \brief Determine if the messages of an operation will be staged through
+      host memory.
+
+      \param num_bytes The total number of bytes communicated by the
+      operation.
+
+      \return True if the messages should be staged through host memory.
+    */
+    bool stageMessages( const std::size_t num_bytes ) const
+    {
+        if ( Kokkos::SpaceAccessibility<Kokkos::HostSpace,
+                                        memory_space>::accessible )
+            return false;
+
+        // Shared memory windows are allocated in host memory.
+        if ( CommBackend::NodeShared == _backend )
+            return true;
+
+        switch ( _transport )
+        {
+        case CommTransport::Direct:
+            return false;
+        case CommTransport::HostStaged:
+            return true;
+        default:
+            return ( !_gpu_aware_mpi || num_bytes < _staging_threshold );
+        }
+    }
+
+    /*!
+      \brief Set the backend used to exchange data with the neighbors.
+
+      \param backend The backend to use.
+
+      \note This is a collective operation over the plan communicator as the
+      neighborhood communicator is created for the current topology when
+      selecting the neighbor collective backend and the node communicator is
+      created when selecting the node shared backend. They are updated
+      whenever the topology of the plan is rebuilt.
+    */
+    void setBackend( const CommBackend backend )
+    {
+        _backend = backend;
+        updateNeighborComm();
+    }
+
+    /*!
+      \brief Get the backend used to exchange data with the neighbors.
+    */
+    CommBackend backend() const { return _backend; }
+
+    /*!
+      \brief Get the distributed graph communicator of the plan topology. The
+      neighbors of the graph are ordered by their local neighbor id. This is
+      only valid when using the neighbor collective backend.
+    */
+    MPI_Comm neighborComm() const { return *_neighbor_comm_ptr; }
+
+    /*!
+      \brief Get the communicator of the ranks of the plan on the same
+      shared-memory node as this rank. This is only valid when using the node
+      shared backend.
+    */
+    MPI_Comm nodeComm() const { return *_node_comm_ptr; }
+
+    /*!
+      \brief Given a local neighbor id get its rank in the node communicator.
+      This is only valid when using the node shared backend.
+
+      \param neighbor The local id of the neighbor.
+
+      \return The rank of the neighbor in the node communicator or -1 if the
+      neighbor is on another node.
+    */
+    int neighborNodeRank( const int neighbor ) const
+    {
+        return _neighbor_node_ranks[neighbor];
+    }
+
+    /*!
+      \brief Attach statistics in which the communication operations executed
+      with this plan are recorded.
+
+      \param stats The statistics. Pass nullptr to stop recording.
+    */
+    void setStatistics( const std::shared_ptr<CommStatistics>& stats )
+    {
+        _stats = stats;
+    }
+
+    /*!
+      \brief Get the statistics attached to the plan. This is nullptr if none
+      are attached.
+    */
+    std::shared_ptr<CommStatistics> statistics() const { return _stats; }
+
+    /*!
+      \brief Attach a progress thread driving the messages of split-phase
+      operations executed with this plan while they are in flight.
+
+      \param progress The progress thread. Pass nullptr to detach.
+    */
+    void setProgress( const std::shared_ptr<CommProgress>& progress )
+    {
+        _progress = progress;
+    }
+
+    /*!
+      \brief Get the progress thread attached to the plan. This is nullptr if
+      none is attached.
+    */
+    std::shared_ptr<CommProgress> progress() const { return _progress; }
+
     // The functions in the public block below would normally be protected but
     // we make them public to allow using private class data in CUDA kernels
     // with lambda functions.
@@ -590,17 +1077,175 @@ class CommunicationPlan
     createFromExportsAndTopology( const ViewType& element_export_ranks,
                                   const std::vector<int>& neighbor_ranks )
     {
+        Impl::ScopedProfileRegion region(
+            "Cabana::CommunicationPlan::createFromExportsAndTopology" );
+
         // Store the number of export elements.
         _num_export_element = element_export_ranks.size();
 
         // Store the unique neighbors (this rank first).
         _neighbors = Impl::getUniqueTopology( neighbor_ranks );
-        int num_n = _neighbors.size();
 
         // Get the size of this communicator.
         int comm_size = -1;
         MPI_Comm_size( comm(), &comm_size );
 
+        // Count the number of sends this rank will do to other ranks. Keep
+        // track of which slot we get in our neighbor's send buffer.
+        auto counts_and_ids = Impl::countSendsAndCreateSteering(
+            element_export_ranks, comm_size );
+
+        // Copy the counts to the host.
+        auto neighbor_counts_host = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), counts_and_ids.first );
+
+        // Exchange the counts with the neighbors.
+        exchangeNeighborCounts( neighbor_counts_host );
+
+        // Update the neighborhood communicator for the new topology.
+        updateNeighborComm();
+
+        // Barrier before continuing to ensure synchronization.
+        Kokkos::Profiling::pushRegion( "Cabana::CommunicationPlan::wait" );
+        MPI_Barrier( comm() );
+        Kokkos::Profiling::popRegion();
+
+        // Return the neighbor ids.
+        return counts_and_ids.second;
+    }
+
+    /*!
+      \brief Update the plan for a new set of exports using the current
+      topology. Use this when the exports change but the ranks they are sent
+      to are (mostly) the same as when the plan was last created as it avoids
+      determining the topology of the point-to-point communication. Only the
+      export and import counts are recomputed and exchanged with the existing
+      neighbors.
+
+      \param element_export_ranks The destination rank in the target
+      decomposition of each locally owned element in the source
+      decomposition. An export rank of -1 will signal that this element is
+      *not* to be exported. The input is expected to be a Kokkos view or
+      Cabana slice in the same memory space as the communication plan.
+
+      \return The location of each export element in the send buffer for its
+      given neighbor.
+
+      \note If any rank exports to a rank that is not in its current
+      neighbor list the topology is rebuilt as in createFromExportsOnly(). This
+      is determined collectively so either all ranks rebuild or none do.
+
+      \note Neighbors that no longer exchange data with this rank are kept in
+      the topology with zero export and import counts.
+    */
+    template <class ViewType>
+    Kokkos::View<size_type*, device_type>
+    updateFromExports( const ViewType& element_export_ranks )
+    {
+        Impl::ScopedProfileRegion region(
+            "Cabana::CommunicationPlan::updateFromExports" );
+
+        // Get the size of this communicator.
+        int comm_size = -1;
+        MPI_Comm_size( comm(), &comm_size );
+
+        // Count the number of sends this rank will do to other ranks. Keep
+        // track of which slot we get in our neighbor's send buffer.
+        auto counts_and_ids = Impl::countSendsAndCreateSteering(
+            element_export_ranks, comm_size );
+
+        // Copy the counts to the host.
+        auto neighbor_counts_host = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), counts_and_ids.first );
+
+        // Determine if every export goes to a current neighbor on all ranks.
+        std::size_t num_export = 0;
+        for ( int r = 0; r < comm_size; ++r )
+            num_export += neighbor_counts_host( r );
+        std::size_t num_neighbor_export = 0;
+        for ( auto n : _neighbors )
+            num_neighbor_export += neighbor_counts_host( n );
+        int topology_valid = ( num_export == num_neighbor_export ) ? 1 : 0;
+        MPI_Allreduce( MPI_IN_PLACE, &topology_valid, 1, MPI_INT, MPI_MIN,
+                       comm() );
+
+        // If the topology has changed rebuild it.
+        if ( !topology_valid )
+            return createFromExportsOnly( element_export_ranks );
+
+        // Store the number of export elements.
+        _num_export_element = element_export_ranks.size();
+
+        // Exchange the counts with the existing neighbors. The topology is
+        // unchanged so the neighborhood communicator is still valid.
+        exchangeNeighborCounts( neighbor_counts_host );
+
+        // Barrier before continuing to ensure synchronization.
+        Kokkos::Profiling::pushRegion( "Cabana::CommunicationPlan::wait" );
+        MPI_Barrier( comm() );
+        Kokkos::Profiling::popRegion();
+
+        // Return the neighbor ids.
+        return counts_and_ids.second;
+    }
+
+    /*!
+      \brief Update the plan for a new set of exports that are all sent to
+      the current neighbors. Use this when the topology is fixed, e.g. the
+      nearest neighbors of a grid block, as only the export and import counts
+      are exchanged with the neighbors: there is no global reduction, barrier,
+      or neighborhood communicator rebuild.
+
+      \param element_export_ranks The destination rank in the target
+      decomposition of each locally owned element in the source
+      decomposition. Each export rank must be one of the current neighbors or
+      -1 to signal that this element is *not* to be exported. The input is
+      expected to be a Kokkos view or Cabana slice in the same memory space as
+      the communication plan.
+
+      \return The location of each export element in the send buffer for its
+      given neighbor.
+    */
+    template <class ViewType>
+    Kokkos::View<size_type*, device_type>
+    updateFromExportsAndTopology( const ViewType& element_export_ranks )
+    {
+        Impl::ScopedProfileRegion region(
+            "Cabana::CommunicationPlan::updateFromExportsAndTopology" );
+
+        // Store the number of export elements.
+        _num_export_element = element_export_ranks.size();
+
+        // Get the size of this communicator.
+        int comm_size = -1;
+        MPI_Comm_size( comm(), &comm_size );
+
+        // Count the number of sends this rank will do to other ranks. Keep
+        // track of which slot we get in our neighbor's send buffer.
+        auto counts_and_ids = Impl::countSendsAndCreateSteering(
+            element_export_ranks, comm_size );
+
+        // Copy the counts to the host.
+        auto neighbor_counts_host = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), counts_and_ids.first );
+
+        // Exchange the counts with the existing neighbors. The topology is
+        // unchanged so the neighborhood communicator is still valid.
+        exchangeNeighborCounts( neighbor_counts_host );
+
+        // Return the neighbor ids.
+        return counts_and_ids.second;
+    }
+
+    //! \cond Impl
+    // Given the number of exports to each rank in the communicator, compute
+    // the export counts of the current neighbors and exchange them to get the
+    // import counts.
+    template <class CountView>
+    void exchangeNeighborCounts( const CountView& neighbor_counts_host )
+    {
+        int num_n = _neighbors.size();
+
         // Get the MPI rank we are currently on.
         int my_rank = -1;
         MPI_Comm_rank( comm(), &my_rank );
@@ -613,17 +1258,6 @@ class CommunicationPlan
         _num_export.assign( num_n, 0 );
         _num_import.assign( num_n, 0 );
 
-        // Count the number of sends this rank will do to other ranks. Keep
-        // track of which slot we get in our neighbor's send buffer.
-        auto counts_and_ids = Impl::countSendsAndCreateSteering(
-            element_export_ranks, comm_size,
-            typename Impl::CountSendsAndCreateSteeringAlgorithm<
-                execution_space>::type() );
-
-        // Copy the counts to the host.
-        auto neighbor_counts_host = Kokkos::create_mirror_view_and_copy(
-            Kokkos::HostSpace(), counts_and_ids.first );
-
         // Get the export counts.
         for ( int n = 0; n < num_n; ++n )
             _num_export[n] = neighbor_counts_host( _neighbors[n] );
@@ -649,8 +1283,10 @@ class CommunicationPlan
 
         // Wait on receives.
         std::vector<MPI_Status> status( requests.size() );
+        Kokkos::Profiling::pushRegion( "Cabana::CommunicationPlan::wait" );
         const int ec =
             MPI_Waitall( requests.size(), requests.data(), status.data() );
+        Kokkos::Profiling::popRegion();
         if ( MPI_SUCCESS != ec )
             throw std::logic_error( "Failed MPI Communication" );
 
@@ -659,13 +1295,8 @@ class CommunicationPlan
             std::accumulate( _num_export.begin(), _num_export.end(), 0 );
         _total_num_import =
             std::accumulate( _num_import.begin(), _num_import.end(), 0 );
-
-        // Barrier before continuing to ensure synchronization.
-        MPI_Barrier( comm() );
-
-        // Return the neighbor ids.
-        return counts_and_ids.second;
     }
+    //! \endcond
 
     /*!
       \brief Export rank creator. Use this when you don't know who you will
@@ -699,6 +1330,9 @@ class CommunicationPlan
     Kokkos::View<size_type*, device_type>
     createFromExportsOnly( const ViewType& element_export_ranks )
     {
+        Impl::ScopedProfileRegion region(
+            "Cabana::CommunicationPlan::createFromExportsOnly" );
+
         // Store the number of export elements.
         _num_export_element = element_export_ranks.size();
 
@@ -717,9 +1351,7 @@ class CommunicationPlan
         // Count the number of sends this rank will do to other ranks. Keep
         // track of which slot we get in our neighbor's send buffer.
         auto counts_and_ids = Impl::countSendsAndCreateSteering(
-            element_export_ranks, comm_size,
-            typename Impl::CountSendsAndCreateSteeringAlgorithm<
-                execution_space>::type() );
+            element_export_ranks, comm_size );
 
         // Copy the counts to the host.
         auto neighbor_counts_host = Kokkos::create_mirror_view_and_copy(
@@ -781,8 +1413,10 @@ class CommunicationPlan
 
         // Wait on non-blocking receives.
         std::vector<MPI_Status> status( requests.size() );
+        Kokkos::Profiling::pushRegion( "Cabana::CommunicationPlan::wait" );
         const int ec =
             MPI_Waitall( requests.size(), requests.data(), status.data() );
+        Kokkos::Profiling::popRegion();
         if ( MPI_SUCCESS != ec )
             throw std::logic_error( "Failed MPI Communication" );
 
@@ -822,8 +1456,13 @@ class CommunicationPlan
             }
         }
 
+        // Update the neighborhood communicator for the new topology.
+        updateNeighborComm();
+
         // Barrier before continuing to ensure synchronization.
+        Kokkos::Profiling::pushRegion( "Cabana::CommunicationPlan::wait" );
         MPI_Barrier( comm() );
+        Kokkos::Profiling::popRegion();
 
         // Return the neighbor ids.
         return counts_and_ids.second;
@@ -887,6 +1526,9 @@ class CommunicationPlan
                          const RankViewType& element_export_ranks,
                          const IdViewType& element_export_ids )
     {
+        Impl::ScopedProfileRegion region(
+            "Cabana::CommunicationPlan::createSteering" );
+
         if ( !use_iota &&
              ( element_export_ids.size() != element_export_ranks.size() ) )
             throw std::runtime_error( "Export ids and ranks different sizes!" );
@@ -930,9 +1572,92 @@ class CommunicationPlan
     }
     //! \endcond
 
+  private:
+    // Create the distributed graph communicator for the current topology if
+    // the neighbor collective backend is in use. The neighbor relationship is
+    // symmetric so the sources and destinations are the same. If the node
+    // shared backend is in use find the neighbors on this node instead.
+    void updateNeighborComm()
+    {
+        updateNodeTopology();
+
+        if ( CommBackend::NeighborCollective != _backend )
+        {
+            _neighbor_comm_ptr.reset();
+            return;
+        }
+
+        auto neighbors = _neighbors;
+        auto comm = *_comm_ptr;
+        _neighbor_comm_ptr.reset(
+            [comm, neighbors]() {
+                auto p = std::make_unique<MPI_Comm>();
+                MPI_Dist_graph_create_adjacent(
+                    comm, neighbors.size(), neighbors.data(), MPI_UNWEIGHTED,
+                    neighbors.size(), neighbors.data(), MPI_UNWEIGHTED,
+                    MPI_INFO_NULL, 0, p.get() );
+                return p.release();
+            }(),
+            []( MPI_Comm* p ) {
+                MPI_Comm_free( p );
+                delete p;
+            } );
+    }
+
+    // Split the plan communicator by shared-memory node if the node shared
+    // backend is in use and find the node rank of each neighbor.
+    void updateNodeTopology()
+    {
+        if ( CommBackend::NodeShared != _backend )
+        {
+            _node_comm_ptr.reset();
+            _neighbor_node_ranks.clear();
+            return;
+        }
+
+        if ( !_node_comm_ptr )
+        {
+            auto comm = *_comm_ptr;
+            _node_comm_ptr.reset(
+                [comm]() {
+                    auto p = std::make_unique<MPI_Comm>();
+                    MPI_Comm_split_type( comm, MPI_COMM_TYPE_SHARED, 0,
+                                         MPI_INFO_NULL, p.get() );
+                    return p.release();
+                }(),
+                []( MPI_Comm* p ) {
+                    MPI_Comm_free( p );
+                    delete p;
+                } );
+        }
+
+        MPI_Group group;
+        MPI_Group node_group;
+        MPI_Comm_group( *_comm_ptr, &group );
+        MPI_Comm_group( *_node_comm_ptr, &node_group );
+        _neighbor_node_ranks.resize( _neighbors.size() );
+        MPI_Group_translate_ranks( group, _neighbors.size(),
+                                   _neighbors.data(), node_group,
+                                   _neighbor_node_ranks.data() );
+        for ( auto& r : _neighbor_node_ranks )
+            if ( MPI_UNDEFINED == r )
+                r = -1;
+        MPI_Group_free( &group );
+        MPI_Group_free( &node_group );
+    }
+
   private:
     std::shared_ptr<MPI_Comm> _comm_ptr;
+    std::shared_ptr<MPI_Comm> _neighbor_comm_ptr;
+    std::shared_ptr<MPI_Comm> _node_comm_ptr;
+    CommTransport _transport;
+    std::size_t _staging_threshold;
+    bool _gpu_aware_mpi;
+    CommBackend _backend;
+    std::shared_ptr<CommStatistics> _stats;
+    std::shared_ptr<CommProgress> _progress;
     std::vector<int> _neighbors;
+    std::vector<int> _neighbor_node_ranks;
     std::size_t _total_num_export;
     std::size_t _total_num_import;
     std::vector<std::size_t> _num_export;
@@ -941,6 +1666,249 @@ class CommunicationPlan
     Kokkos::View<std::size_t*, device_type> _export_steering;
 };
 
+//---------------------------------------------------------------------------//
+namespace Impl
+{
+//! \cond Impl
+//---------------------------------------------------------------------------//
+// Create the communication staging for an operation of a plan. Host staging
+// buffers are allocated if the plan stages the messages.
+template <class Plan_t, class Buffer>
+CommStaging<typename Plan_t::memory_space>
+createCommStaging( const Plan_t& plan, const Buffer& send_buffer,
+                   const std::size_t send_bytes, const Buffer& recv_buffer,
+                   const std::size_t recv_bytes )
+{
+    using staging_type = CommStaging<typename Plan_t::memory_space>;
+    using host_buffer_type = typename staging_type::host_buffer_type;
+
+    if ( !plan.stageMessages( send_bytes + recv_bytes ) )
+        return staging_type( send_buffer, recv_buffer );
+
+    host_buffer_type host_send_buffer(
+        Kokkos::ViewAllocateWithoutInitializing( "host_send_buffer" ),
+        send_bytes );
+    host_buffer_type host_recv_buffer(
+        Kokkos::ViewAllocateWithoutInitializing( "host_recv_buffer" ),
+        recv_bytes );
+    return staging_type( typename Plan_t::execution_space(), send_buffer,
+                         send_bytes, recv_buffer, recv_bytes,
+                         host_send_buffer, host_recv_buffer );
+}
+
+//---------------------------------------------------------------------------//
+// Post a non-blocking neighborhood exchange over the graph communicator of a
+// plan. The counts and displacements are in bytes and are given for each
+// local neighbor id.
+template <class Plan_t>
+MPI_Request postNeighborAlltoallv( const Plan_t& plan, const char* send_data,
+                                   const std::vector<int>& send_counts,
+                                   const std::vector<int>& send_displs,
+                                   char* recv_data,
+                                   const std::vector<int>& recv_counts,
+                                   const std::vector<int>& recv_displs )
+{
+    MPI_Request request;
+    const int ec = MPI_Ineighbor_alltoallv(
+        send_data, send_counts.data(), send_displs.data(), MPI_BYTE,
+        recv_data, recv_counts.data(), recv_displs.data(), MPI_BYTE,
+        plan.neighborComm(), &request );
+    if ( MPI_SUCCESS != ec )
+        throw std::logic_error( "Failed MPI Communication" );
+    return request;
+}
+
+//---------------------------------------------------------------------------//
+// Exchange data with the neighbors of a plan using the node shared backend
+// and wait for the exchange to complete. The counts and displacements are in
+// bytes and are given for each local neighbor id as for
+// postNeighborAlltoallv(). Messages to neighbors on other nodes are posted
+// first. The data for neighbors on this node is then copied into a shared
+// window preceded by a header of (node rank, offset, size) entries through
+// which each receiver finds and copies its data.
+template <class Plan_t>
+void exchangeNodeShared( const Plan_t& plan, const char* send_data,
+                         const std::vector<int>& send_counts,
+                         const std::vector<int>& send_displs,
+                         char* recv_data, const std::vector<int>& recv_counts,
+                         const std::vector<int>& recv_displs )
+{
+    const int num_n = plan.numNeighbor();
+    MPI_Comm node_comm = plan.nodeComm();
+    int my_node_rank = -1;
+    MPI_Comm_rank( node_comm, &my_node_rank );
+
+    // Post the messages to neighbors on other nodes.
+    const int mpi_tag = 3456;
+    std::vector<MPI_Request> requests;
+    requests.reserve( 2 * num_n );
+    for ( int n = 0; n < num_n; ++n )
+    {
+        if ( plan.neighborNodeRank( n ) >= 0 )
+            continue;
+        if ( recv_counts[n] > 0 )
+        {
+            requests.push_back( MPI_Request() );
+            MPI_Irecv( recv_data + recv_displs[n], recv_counts[n], MPI_BYTE,
+                       plan.neighborRank( n ), mpi_tag, plan.comm(),
+                       &( requests.back() ) );
+        }
+        if ( send_counts[n] > 0 )
+        {
+            requests.push_back( MPI_Request() );
+            MPI_Isend( send_data + send_displs[n], send_counts[n], MPI_BYTE,
+                       plan.neighborRank( n ), mpi_tag, plan.comm(),
+                       &( requests.back() ) );
+        }
+    }
+
+    // Size the shared segment of this rank.
+    std::size_t num_entry = 0;
+    std::size_t data_bytes = 0;
+    for ( int n = 0; n < num_n; ++n )
+    {
+        if ( plan.neighborNodeRank( n ) >= 0 && send_counts[n] > 0 )
+        {
+            ++num_entry;
+            data_bytes += send_counts[n];
+        }
+    }
+    const std::size_t header_bytes =
+        ( 1 + 3 * num_entry ) * sizeof( std::int64_t );
+
+    // Allocate the window and fill the segment of this rank.
+    char* segment = nullptr;
+    MPI_Win win;
+    MPI_Win_allocate_shared( header_bytes + data_bytes, 1, MPI_INFO_NULL,
+                             node_comm, &segment, &win );
+    MPI_Win_lock_all( MPI_MODE_NOCHECK, win );
+    std::int64_t* header = reinterpret_cast<std::int64_t*>( segment );
+    header[0] = num_entry;
+    std::size_t offset = header_bytes;
+    std::size_t e = 0;
+    for ( int n = 0; n < num_n; ++n )
+    {
+        if ( plan.neighborNodeRank( n ) >= 0 && send_counts[n] > 0 )
+        {
+            header[1 + 3 * e] = plan.neighborNodeRank( n );
+            header[2 + 3 * e] = offset;
+            header[3 + 3 * e] = send_counts[n];
+            std::memcpy( segment + offset, send_data + send_displs[n],
+                         send_counts[n] );
+            offset += send_counts[n];
+            ++e;
+        }
+    }
+
+    // Wait for every rank on the node to fill its segment.
+    Impl::CommWait comm_wait( "Cabana::NodeShared::wait",
+                              plan.statistics().get() );
+    MPI_Win_sync( win );
+    MPI_Barrier( node_comm );
+    MPI_Win_sync( win );
+    comm_wait.stop();
+
+    // Copy the data of the neighbors on this node out of their segments.
+    // Errors are reported only after the window is released since freeing
+    // it is collective over the node.
+    const char* copy_error = nullptr;
+    for ( int n = 0; n < num_n && nullptr == copy_error; ++n )
+    {
+        if ( plan.neighborNodeRank( n ) < 0 || recv_counts[n] == 0 )
+            continue;
+        MPI_Aint size;
+        int disp_unit;
+        char* remote = nullptr;
+        MPI_Win_shared_query( win, plan.neighborNodeRank( n ), &size,
+                              &disp_unit, &remote );
+        const std::int64_t* remote_header =
+            reinterpret_cast<const std::int64_t*>( remote );
+        bool found = false;
+        for ( std::int64_t r = 0; r < remote_header[0]; ++r )
+        {
+            if ( remote_header[1 + 3 * r] == my_node_rank )
+            {
+                found = true;
+                if ( remote_header[3 + 3 * r] != recv_counts[n] )
+                    copy_error = "Node shared message size mismatch";
+                else
+                    std::memcpy( recv_data + recv_displs[n],
+                                 remote + remote_header[2 + 3 * r],
+                                 recv_counts[n] );
+                break;
+            }
+        }
+        if ( !found )
+            copy_error = "Node shared message not found";
+    }
+
+    // The window is freed once every rank on the node has copied its data.
+    MPI_Win_unlock_all( win );
+    MPI_Win_free( &win );
+
+    // Wait for the messages to other nodes. They complete before any error
+    // is reported so that no request refers to the buffers afterwards.
+    Impl::CommWait message_wait( "Cabana::NodeShared::wait",
+                                 plan.statistics().get() );
+    const int ec = MPI_Waitall( requests.size(), requests.data(),
+                                MPI_STATUSES_IGNORE );
+    message_wait.stop();
+    if ( nullptr != copy_error )
+        throw std::logic_error( copy_error );
+    if ( MPI_SUCCESS != ec )
+        throw std::logic_error( "Failed MPI Communication" );
+}
+
+//---------------------------------------------------------------------------//
+// Record an operation of a plan in its statistics if any are attached.
+// Forward operations send exports and receive imports while reverse
+// operations do the opposite. Data exchanged with this rank is recorded as
+// self-copied whether or not it is passed through MPI.
+template <class Plan_t>
+void recordCommOperation( const Plan_t& plan, const bool forward,
+                          const std::size_t element_bytes )
+{
+    auto stats = plan.statistics();
+    if ( !stats )
+        return;
+
+    int my_rank = -1;
+    MPI_Comm_rank( plan.comm(), &my_rank );
+
+    std::size_t num_messages_sent = 0;
+    std::size_t bytes_sent = 0;
+    std::size_t num_messages_received = 0;
+    std::size_t bytes_received = 0;
+    std::size_t bytes_self = 0;
+    for ( int n = 0; n < plan.numNeighbor(); ++n )
+    {
+        std::size_t send_bytes =
+            element_bytes *
+            ( ( forward ) ? plan.numExport( n ) : plan.numImport( n ) );
+        std::size_t recv_bytes =
+            element_bytes *
+            ( ( forward ) ? plan.numImport( n ) : plan.numExport( n ) );
+        if ( plan.neighborRank( n ) == my_rank )
+        {
+            bytes_self += send_bytes;
+        }
+        else
+        {
+            num_messages_sent += ( send_bytes > 0 ) ? 1 : 0;
+            bytes_sent += send_bytes;
+            num_messages_received += ( recv_bytes > 0 ) ? 1 : 0;
+            bytes_received += recv_bytes;
+        }
+    }
+    stats->recordOperation( num_messages_sent, bytes_sent,
+                            num_messages_received, bytes_received,
+                            bytes_self );
+}
+
+//---------------------------------------------------------------------------//
+//! \endcond
+} // end namespace Impl
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Cabana
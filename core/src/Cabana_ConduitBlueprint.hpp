@@ -0,0 +1,258 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_ConduitBlueprint.hpp
+  \brief Conduit Blueprint particle meshes for in-situ analysis
+*/
+#ifndef CABANA_CONDUITBLUEPRINT_HPP
+#define CABANA_CONDUITBLUEPRINT_HPP
+
+#include <Cabana_Slice.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <conduit.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Cabana
+{
+namespace Experimental
+{
+namespace ConduitBlueprint
+{
+namespace Impl
+{
+//! \cond Impl
+//---------------------------------------------------------------------------//
+// Number of scalar components of each particle in a slice.
+template <class SliceType>
+std::size_t componentCount( const SliceType& slice )
+{
+    std::size_t count = 1;
+    for ( std::size_t d = 2; d < SliceType::kokkos_view::Rank; ++d )
+        count *= slice.extent( d );
+    return count;
+}
+
+//---------------------------------------------------------------------------//
+// Gather the components of a slice into a component-major contiguous view.
+template <class SliceType, class ViewType>
+void gatherSlice( const SliceType& slice, const std::size_t n,
+                  const ViewType& view,
+                  std::integral_constant<std::size_t, 2> )
+{
+    Kokkos::parallel_for(
+        "Cabana::ConduitBlueprint::gather",
+        Kokkos::RangePolicy<typename SliceType::execution_space>( 0, n ),
+        KOKKOS_LAMBDA( const int p ) { view( p ) = slice( p ); } );
+}
+
+template <class SliceType, class ViewType>
+void gatherSlice( const SliceType& slice, const std::size_t n,
+                  const ViewType& view,
+                  std::integral_constant<std::size_t, 3> )
+{
+    int d0 = slice.extent( 2 );
+    Kokkos::parallel_for(
+        "Cabana::ConduitBlueprint::gather",
+        Kokkos::RangePolicy<typename SliceType::execution_space>( 0, n ),
+        KOKKOS_LAMBDA( const int p ) {
+            for ( int i = 0; i < d0; ++i )
+                view( i * n + p ) = slice( p, i );
+        } );
+}
+
+template <class SliceType, class ViewType>
+void gatherSlice( const SliceType& slice, const std::size_t n,
+                  const ViewType& view,
+                  std::integral_constant<std::size_t, 4> )
+{
+    int d0 = slice.extent( 2 );
+    int d1 = slice.extent( 3 );
+    Kokkos::parallel_for(
+        "Cabana::ConduitBlueprint::gather",
+        Kokkos::RangePolicy<typename SliceType::execution_space>( 0, n ),
+        KOKKOS_LAMBDA( const int p ) {
+            for ( int i = 0; i < d0; ++i )
+                for ( int j = 0; j < d1; ++j )
+                    view( ( i * d1 + j ) * n + p ) = slice( p, i, j );
+        } );
+}
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Publish particle slices as a Conduit Blueprint point mesh.
+
+  The positions become an explicit coordinate set with a point topology and
+  every field slice becomes a vertex-associated field named by the slice
+  label, with vector and matrix members published as multi-component arrays
+  ("0", "1", ...). The resulting node can be handed directly to Ascent or
+  Catalyst for in-situ analysis.
+
+  AoSoA members are not uniformly strided across SoA blocks, so each slice
+  is gathered once per publish into contiguous staging memory owned by the
+  adapter; the published node references that memory without further
+  copies. Staging memory lives in MemorySpace, which may be a device space
+  for consumers that accept device data. The node is valid until the next
+  publish or until the adapter is destroyed.
+
+  \tparam MemorySpace Memory space of the staged data.
+*/
+template <class MemorySpace>
+class ParticleAdapter
+{
+  public:
+    //! Memory space.
+    using memory_space = MemorySpace;
+
+    /*!
+      \brief Constructor.
+      \param mesh_name Name of the Blueprint topology and coordinate set
+      prefix.
+    */
+    ParticleAdapter( const std::string& mesh_name = "particles" )
+        : _mesh_name( mesh_name )
+    {
+    }
+
+    /*!
+      \brief Publish the particles into a Conduit node.
+
+      \param node The Blueprint mesh node to fill.
+      \param n_local The number of local particles.
+      \param positions Position slice with 2 or 3 components.
+      \param fields Further slices to publish as fields. Each must be
+      labeled.
+    */
+    template <class PositionSlice, class... FieldSlices>
+    void publish( conduit::Node& node, const std::size_t n_local,
+                  const PositionSlice& positions,
+                  const FieldSlices&... fields )
+    {
+        static_assert( is_slice<PositionSlice>::value,
+                       "Blueprint positions must be a slice" );
+        static_assert( 3 == PositionSlice::kokkos_view::Rank,
+                       "Blueprint positions must be a vector member" );
+
+        _staging.clear();
+        std::string coords = _mesh_name + "_coords";
+
+        // Coordinates.
+        auto num_dim = positions.extent( 2 );
+        if ( num_dim < 2 || num_dim > 3 )
+            throw std::logic_error(
+                "Blueprint positions must have 2 or 3 components" );
+        auto x = stage( positions, n_local );
+        const char* axes[3] = { "x", "y", "z" };
+        node["coordsets/" + coords + "/type"] = "explicit";
+        for ( std::size_t d = 0; d < num_dim; ++d )
+            node["coordsets/" + coords + "/values/" + axes[d]].set_external(
+                x.data() + d * n_local, n_local );
+
+        // Point topology with trivial connectivity.
+        Kokkos::View<int*, memory_space> connectivity(
+            Kokkos::ViewAllocateWithoutInitializing( "connectivity" ),
+            n_local );
+        Kokkos::parallel_for(
+            "Cabana::ConduitBlueprint::connectivity",
+            Kokkos::RangePolicy<typename memory_space::execution_space>(
+                0, n_local ),
+            KOKKOS_LAMBDA( const int p ) { connectivity( p ) = p; } );
+        Kokkos::fence();
+        _connectivity = connectivity;
+        node["topologies/" + _mesh_name + "/type"] = "unstructured";
+        node["topologies/" + _mesh_name + "/coordset"] = coords;
+        node["topologies/" + _mesh_name + "/elements/shape"] = "point";
+        node["topologies/" + _mesh_name + "/elements/connectivity"]
+            .set_external( connectivity.data(), n_local );
+
+        publishFields( node, n_local, fields... );
+    }
+
+  private:
+    // Stage a slice into contiguous component-major memory.
+    template <class SliceType>
+    auto stage( const SliceType& slice, const std::size_t n_local )
+    {
+        using value_type = typename SliceType::value_type;
+        using slice_memory_space = typename SliceType::memory_space;
+
+        std::size_t num_comp = Impl::componentCount( slice );
+        Kokkos::View<value_type*, slice_memory_space> gathered(
+            Kokkos::ViewAllocateWithoutInitializing( slice.label() ),
+            num_comp * n_local );
+        Impl::gatherSlice(
+            slice, n_local, gathered,
+            std::integral_constant<std::size_t,
+                                   SliceType::kokkos_view::Rank>() );
+        Kokkos::fence();
+        auto staged =
+            Kokkos::create_mirror_view_and_copy( memory_space(), gathered );
+
+        // Keep the staging allocation alive with the published node.
+        _staging.push_back( std::make_shared<decltype( staged )>( staged ) );
+        return staged;
+    }
+
+    void publishFields( conduit::Node&, const std::size_t ) {}
+
+    template <class SliceType, class... FieldSlices>
+    void publishFields( conduit::Node& node, const std::size_t n_local,
+                        const SliceType& slice, const FieldSlices&... fields )
+    {
+        static_assert( is_slice<SliceType>::value,
+                       "Blueprint fields must be slices" );
+        std::string name = slice.label();
+        if ( name.empty() )
+            throw std::logic_error(
+                "Blueprint particle fields require labeled slices" );
+
+        auto staged = stage( slice, n_local );
+        std::string path = "fields/" + name;
+        node[path + "/association"] = "vertex";
+        node[path + "/topology"] = _mesh_name;
+        std::size_t num_comp = Impl::componentCount( slice );
+        if ( 2 == SliceType::kokkos_view::Rank )
+        {
+            node[path + "/values"].set_external( staged.data(), n_local );
+        }
+        else
+        {
+            for ( std::size_t c = 0; c < num_comp; ++c )
+                node[path + "/values/" + std::to_string( c )].set_external(
+                    staged.data() + c * n_local, n_local );
+        }
+
+        publishFields( node, n_local, fields... );
+    }
+
+  private:
+    std::string _mesh_name;
+    Kokkos::View<int*, memory_space> _connectivity;
+    std::vector<std::shared_ptr<void>> _staging;
+};
+
+//---------------------------------------------------------------------------//
+
+} // end namespace ConduitBlueprint
+} // end namespace Experimental
+} // end namespace Cabana
+
+#endif // end CABANA_CONDUITBLUEPRINT_HPP
@@ -19,23 +19,54 @@
 #include <CabanaCore_config.hpp>
 
 #include <Cabana_AoSoA.hpp>
+#include <Cabana_AppendBuffer.hpp>
+#include <Cabana_BinnedReduction.hpp>
+#include <Cabana_Checkpoint.hpp>
 #include <Cabana_DeepCopy.hpp>
+#include <Cabana_Graph.hpp>
+#include <Cabana_GroupedAoSoA.hpp>
+#include <Cabana_HashedCellList.hpp>
 #include <Cabana_LinkedCellList.hpp>
 #include <Cabana_MemberTypes.hpp>
+#include <Cabana_MemoryTracker.hpp>
 #include <Cabana_NeighborList.hpp>
 #include <Cabana_Parallel.hpp>
 #include <Cabana_ParameterPack.hpp>
+#include <Cabana_ParticleInit.hpp>
+#include <Cabana_Prefetch.hpp>
+#include <Cabana_ReducedPrecision.hpp>
+#include <Cabana_Remove.hpp>
+#include <Cabana_Resample.hpp>
+#include <Cabana_ScatterSlice.hpp>
+#include <Cabana_ScratchSlice.hpp>
+#include <Cabana_SimdBatch.hpp>
 #include <Cabana_Slice.hpp>
+#include <Cabana_SliceBundle.hpp>
 #include <Cabana_SoA.hpp>
 #include <Cabana_Sort.hpp>
+#include <Cabana_TaskGraph.hpp>
 #include <Cabana_Tuple.hpp>
 #include <Cabana_Types.hpp>
 #include <Cabana_VerletList.hpp>
 #include <Cabana_Version.hpp>
 
 #ifdef Cabana_ENABLE_MPI
+#include <Cabana_BondedTopology.hpp>
+#include <Cabana_CommProgress.hpp>
+#include <Cabana_CommStatistics.hpp>
 #include <Cabana_Distributor.hpp>
+#include <Cabana_GlobalIdMap.hpp>
+#include <Cabana_GlobalSort.hpp>
 #include <Cabana_Halo.hpp>
+#include <Cabana_ParallelIO.hpp>
+#endif
+
+#ifdef Cabana_ENABLE_HDF5
+#include <Cabana_HDF5ParticleIO.hpp>
+#endif
+
+#ifdef Cabana_ENABLE_CONDUIT
+#include <Cabana_ConduitBlueprint.hpp>
 #endif
 
 #ifdef Cabana_ENABLE_ARBORX
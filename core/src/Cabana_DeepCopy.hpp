@@ -23,7 +23,10 @@
 #include <Kokkos_Core.hpp>
 #include <Kokkos_ExecPolicy.hpp>
 
+#include <cstddef>
 #include <exception>
+#include <initializer_list>
+#include <string>
 #include <type_traits>
 
 namespace Cabana
@@ -255,6 +258,301 @@ inline void deep_copy( AoSoA_t& aosoa,
     Kokkos::fence();
 }
 
+//---------------------------------------------------------------------------//
+// Ranged and member-subset deep copies.
+//---------------------------------------------------------------------------//
+namespace Impl
+{
+//! \cond Impl
+// Check that a copy range is within both AoSoAs.
+template <class DstAoSoA, class SrcAoSoA>
+void checkDeepCopyRange( const DstAoSoA& dst, const std::size_t dst_begin,
+                         const SrcAoSoA& src, const std::size_t src_begin,
+                         const std::size_t count )
+{
+    if ( dst_begin + count > dst.size() || src_begin + count > src.size() )
+    {
+        throw std::runtime_error(
+            "Attempted to deep copy an AoSoA range out of bounds" );
+    }
+}
+
+// Copy a range of tuples between AoSoAs in the same memory space.
+template <class DstAoSoA, class SrcAoSoA>
+void deepCopyTupleRange( DstAoSoA& dst, const std::size_t dst_begin,
+                         const SrcAoSoA& src, const std::size_t src_begin,
+                         const std::size_t count )
+{
+    auto copy_func = KOKKOS_LAMBDA( const std::size_t i )
+    {
+        dst.setTuple( dst_begin + i, src.getTuple( src_begin + i ) );
+    };
+    Kokkos::RangePolicy<typename DstAoSoA::execution_space> exec_policy(
+        0, count );
+    Kokkos::parallel_for( "Cabana::deep_copy::range", exec_policy,
+                          copy_func );
+    Kokkos::fence();
+}
+
+// Copy a range of elements of one member between AoSoAs in the same memory
+// space.
+template <std::size_t M, class DstAoSoA, class SrcAoSoA>
+void deepCopyMemberRange( DstAoSoA& dst, const std::size_t dst_begin,
+                          const SrcAoSoA& src, const std::size_t src_begin,
+                          const std::size_t count )
+{
+    static_assert(
+        std::is_same<typename DstAoSoA::template member_data_type<M>,
+                     typename SrcAoSoA::template member_data_type<M>>::value,
+        "Attempted to deep copy AoSoA members of different types" );
+
+    auto dst_slice = Cabana::slice<M>( dst );
+    auto src_slice = Cabana::slice<M>( src );
+    using dst_slice_type = decltype( dst_slice );
+    using src_slice_type = decltype( src_slice );
+
+    std::size_t num_comp = 1;
+    for ( std::size_t d = 2; d < dst_slice.rank(); ++d )
+        num_comp *= dst_slice.extent( d );
+
+    auto dst_data = dst_slice.data();
+    const auto src_data = src_slice.data();
+    auto dst_stride = dst_slice.stride( 0 );
+    auto src_stride = src_slice.stride( 0 );
+    auto copy_func = KOKKOS_LAMBDA( const std::size_t i )
+    {
+        auto src_offset =
+            src_slice_type::index_type::s( src_begin + i ) * src_stride +
+            src_slice_type::index_type::a( src_begin + i );
+        auto dst_offset =
+            dst_slice_type::index_type::s( dst_begin + i ) * dst_stride +
+            dst_slice_type::index_type::a( dst_begin + i );
+        for ( std::size_t n = 0; n < num_comp; ++n )
+            dst_data[dst_offset + dst_slice_type::vector_length * n] =
+                src_data[src_offset + src_slice_type::vector_length * n];
+    };
+    Kokkos::RangePolicy<typename DstAoSoA::execution_space> exec_policy(
+        0, count );
+    Kokkos::parallel_for( "Cabana::deep_copy::member_range", exec_policy,
+                          copy_func );
+    Kokkos::fence();
+}
+
+// Copy the SoAs of the source holding a range into the given memory space.
+// Returns the staged SoAs and the index of the first element of the range
+// in them.
+template <class MemorySpace, class SrcAoSoA>
+AoSoA<typename SrcAoSoA::member_types, MemorySpace, SrcAoSoA::vector_length>
+stageDeepCopyRange( const SrcAoSoA& src, const std::size_t src_begin,
+                    const std::size_t count, std::size_t& staged_begin )
+{
+    using index_type = typename SrcAoSoA::index_type;
+    auto first_soa = index_type::s( src_begin );
+    auto num_soa = index_type::s( src_begin + count - 1 ) - first_soa + 1;
+    AoSoA<typename SrcAoSoA::member_types, MemorySpace,
+          SrcAoSoA::vector_length>
+        staged( std::string( src.label() ).append( "_staged" ),
+                num_soa * SrcAoSoA::vector_length );
+    Kokkos::Impl::DeepCopy<MemorySpace, typename SrcAoSoA::memory_space>(
+        staged.data(), src.data() + first_soa,
+        num_soa * sizeof( typename SrcAoSoA::soa_type ) );
+    staged_begin = src_begin - first_soa * SrcAoSoA::vector_length;
+    return staged;
+}
+
+// Copy a range of tuples element-by-element. Sources in another memory space
+// are staged in the destination space first.
+template <class DstAoSoA, class SrcAoSoA>
+void deepCopyTupleRange( DstAoSoA& dst, const std::size_t dst_begin,
+                         const SrcAoSoA& src, const std::size_t src_begin,
+                         const std::size_t count, std::true_type )
+{
+    deepCopyTupleRange( dst, dst_begin, src, src_begin, count );
+}
+
+template <class DstAoSoA, class SrcAoSoA>
+void deepCopyTupleRange( DstAoSoA& dst, const std::size_t dst_begin,
+                         const SrcAoSoA& src, const std::size_t src_begin,
+                         const std::size_t count, std::false_type )
+{
+    std::size_t staged_begin;
+    auto staged = stageDeepCopyRange<typename DstAoSoA::memory_space>(
+        src, src_begin, count, staged_begin );
+    deepCopyTupleRange( dst, dst_begin, staged, staged_begin, count );
+}
+
+// Copy a range of the given members element-by-element. Sources in another
+// memory space are staged in the destination space first.
+template <std::size_t... Ms, class DstAoSoA, class SrcAoSoA>
+void deepCopyMembersRange( DstAoSoA& dst, const std::size_t dst_begin,
+                           const SrcAoSoA& src, const std::size_t src_begin,
+                           const std::size_t count, std::true_type )
+{
+    (void)std::initializer_list<int>{ (
+        deepCopyMemberRange<Ms>( dst, dst_begin, src, src_begin, count ),
+        0 )... };
+}
+
+template <std::size_t... Ms, class DstAoSoA, class SrcAoSoA>
+void deepCopyMembersRange( DstAoSoA& dst, const std::size_t dst_begin,
+                           const SrcAoSoA& src, const std::size_t src_begin,
+                           const std::size_t count, std::false_type )
+{
+    std::size_t staged_begin;
+    auto staged = stageDeepCopyRange<typename DstAoSoA::memory_space>(
+        src, src_begin, count, staged_begin );
+    deepCopyMembersRange<Ms...>( dst, dst_begin, staged, staged_begin, count,
+                                 std::true_type() );
+}
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Deep copy a range of data between compatible AoSoA objects.
+
+  \param dst The destination for the copied data.
+
+  \param dst_begin The index of the first destination element to copy to.
+
+  \param src The source of the copied data.
+
+  \param src_begin The index of the first source element to copy.
+
+  \param count The number of elements to copy.
+
+  Only AoSoA objects with the same set of member data types may be copied.
+  If both AoSoAs have the same inner array size and the ranges start at the
+  same position in their structs, the whole structs within the range are
+  copied byte-wise and only the partial structs at the ends element-by-element.
+*/
+template <class DstAoSoA, class SrcAoSoA>
+inline void
+deep_copy( DstAoSoA& dst, const std::size_t dst_begin, const SrcAoSoA& src,
+           const std::size_t src_begin, const std::size_t count,
+           typename std::enable_if<( is_aosoa<DstAoSoA>::value &&
+                                     is_aosoa<SrcAoSoA>::value )>::type* = 0 )
+{
+    using dst_type = DstAoSoA;
+    using src_type = SrcAoSoA;
+    using dst_soa_type = typename dst_type::soa_type;
+    using src_soa_type = typename src_type::soa_type;
+    using same_space =
+        std::is_same<typename dst_type::memory_space,
+                     typename src_type::memory_space>;
+
+    static_assert(
+        std::is_same<typename dst_type::member_types,
+                     typename src_type::member_types>::value,
+        "Attempted to deep copy AoSoA objects of different member types" );
+
+    Impl::checkDeepCopyRange( dst, dst_begin, src, src_begin, count );
+    if ( count == 0 )
+        return;
+
+    // Copy element-by-element if the structs do not align.
+    constexpr std::size_t vector_length = dst_type::vector_length;
+    if ( !std::is_same<dst_soa_type, src_soa_type>::value ||
+         ( dst_begin % vector_length != src_begin % vector_length ) )
+    {
+        Impl::deepCopyTupleRange( dst, dst_begin, src, src_begin, count,
+                                  same_space() );
+        return;
+    }
+
+    // Otherwise copy the partial struct at the front element-by-element, the
+    // whole structs byte-wise, and the partial struct at the back
+    // element-by-element.
+    std::size_t head =
+        ( vector_length - dst_begin % vector_length ) % vector_length;
+    if ( head > count )
+        head = count;
+    std::size_t num_soa = ( count - head ) / vector_length;
+    std::size_t tail = count - head - num_soa * vector_length;
+
+    if ( head > 0 )
+        Impl::deepCopyTupleRange( dst, dst_begin, src, src_begin, head,
+                                  same_space() );
+    if ( num_soa > 0 )
+        Kokkos::Impl::DeepCopy<typename dst_type::memory_space,
+                               typename src_type::memory_space>(
+            dst.data() + ( dst_begin + head ) / vector_length,
+            src.data() + ( src_begin + head ) / vector_length,
+            num_soa * sizeof( dst_soa_type ) );
+    if ( tail > 0 )
+        Impl::deepCopyTupleRange( dst, dst_begin + count - tail, src,
+                                  src_begin + count - tail, tail,
+                                  same_space() );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Deep copy a range of a subset of members between AoSoA objects.
+
+  \tparam Ms The indices of the members to copy.
+
+  \param dst The destination for the copied data.
+
+  \param dst_begin The index of the first destination element to copy to.
+
+  \param src The source of the copied data.
+
+  \param src_begin The index of the first source element to copy.
+
+  \param count The number of elements to copy.
+
+  The copied members must have the same data type in both AoSoAs. Other
+  members of the destination are not modified.
+*/
+template <std::size_t... Ms, class DstAoSoA, class SrcAoSoA>
+inline void
+deep_copy( DstAoSoA& dst, const std::size_t dst_begin, const SrcAoSoA& src,
+           const std::size_t src_begin, const std::size_t count,
+           typename std::enable_if<( sizeof...( Ms ) > 0 &&
+                                     is_aosoa<DstAoSoA>::value &&
+                                     is_aosoa<SrcAoSoA>::value )>::type* = 0 )
+{
+    using same_space =
+        std::is_same<typename DstAoSoA::memory_space,
+                     typename SrcAoSoA::memory_space>;
+
+    Impl::checkDeepCopyRange( dst, dst_begin, src, src_begin, count );
+    if ( count == 0 )
+        return;
+
+    Impl::deepCopyMembersRange<Ms...>( dst, dst_begin, src, src_begin, count,
+                                       same_space() );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Deep copy a subset of members between AoSoA objects.
+
+  \tparam Ms The indices of the members to copy.
+
+  \param dst The destination for the copied data.
+
+  \param src The source of the copied data.
+
+  Only AoSoA objects of the same size may be copied. The copied members must
+  have the same data type in both AoSoAs. Other members of the destination
+  are not modified.
+*/
+template <std::size_t... Ms, class DstAoSoA, class SrcAoSoA>
+inline void
+deep_copy( DstAoSoA& dst, const SrcAoSoA& src,
+           typename std::enable_if<( sizeof...( Ms ) > 0 &&
+                                     is_aosoa<DstAoSoA>::value &&
+                                     is_aosoa<SrcAoSoA>::value )>::type* = 0 )
+{
+    if ( dst.size() != src.size() )
+    {
+        throw std::runtime_error(
+            "Attempted to deep copy AoSoA objects of different sizes" );
+    }
+    deep_copy<Ms...>( dst, 0, src, 0, src.size() );
+}
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Deep copy data between compatible Slice objects.
@@ -387,6 +685,352 @@ inline void deep_copy( Slice_t& slice,
     Kokkos::deep_copy( slice.view(), scalar );
 }
 
+//---------------------------------------------------------------------------//
+// Asynchronous deep copies on an execution space instance.
+//---------------------------------------------------------------------------//
+namespace Impl
+{
+//! \cond Impl
+// Byte-wise copy between memory spaces enqueued on an execution space
+// instance.
+template <class DstMemorySpace, class SrcMemorySpace, class ExecutionSpace>
+void deepCopyBytes( const ExecutionSpace& exec_space, void* dst,
+                    const void* src, const std::size_t bytes )
+{
+    Kokkos::View<char*, DstMemorySpace, Kokkos::MemoryUnmanaged> dst_bytes(
+        static_cast<char*>( dst ), bytes );
+    Kokkos::View<const char*, SrcMemorySpace, Kokkos::MemoryUnmanaged>
+        src_bytes( static_cast<const char*>( src ), bytes );
+    Kokkos::deep_copy( exec_space, dst_bytes, src_bytes );
+}
+
+// Copy an AoSoA element-by-element with a kernel on an execution space
+// instance which can access both AoSoAs.
+template <class ExecutionSpace, class DstAoSoA, class SrcAoSoA>
+void deepCopyTuples( const ExecutionSpace& exec_space, DstAoSoA& dst,
+                     const SrcAoSoA& src )
+{
+    auto copy_func = KOKKOS_LAMBDA( const std::size_t i )
+    {
+        dst.setTuple( i, src.getTuple( i ) );
+    };
+    Kokkos::RangePolicy<ExecutionSpace> exec_policy( exec_space, 0,
+                                                     dst.size() );
+    Kokkos::parallel_for( "Cabana::deep_copy", exec_policy, copy_func );
+}
+
+// Tags for AoSoAs of the same layout and otherwise for the memory spaces
+// accessible from the execution space.
+struct DeepCopySameLayout
+{
+};
+struct DeepCopyAccessBoth
+{
+};
+struct DeepCopyAccessDst
+{
+};
+struct DeepCopyAccessSrc
+{
+};
+struct DeepCopyAccessNone
+{
+};
+
+// Same layout: copy byte-wise.
+template <class ExecutionSpace, class DstAoSoA, class SrcAoSoA>
+void deepCopyLayout( const ExecutionSpace& exec_space, DstAoSoA& dst,
+                     const SrcAoSoA& src, DeepCopySameLayout )
+{
+    deepCopyBytes<typename DstAoSoA::memory_space,
+                  typename SrcAoSoA::memory_space>(
+        exec_space, dst.data(), src.data(),
+        dst.numSoA() * sizeof( typename DstAoSoA::soa_type ) );
+}
+
+// Both AoSoAs are accessible: convert the layout directly.
+template <class ExecutionSpace, class DstAoSoA, class SrcAoSoA>
+void deepCopyLayout( const ExecutionSpace& exec_space, DstAoSoA& dst,
+                     const SrcAoSoA& src, DeepCopyAccessBoth )
+{
+    deepCopyTuples( exec_space, dst, src );
+}
+
+// Only the destination is accessible: stage the source in the destination
+// space and convert the layout there. The staging buffer is released on
+// return so the instance is fenced.
+template <class ExecutionSpace, class DstAoSoA, class SrcAoSoA>
+void deepCopyLayout( const ExecutionSpace& exec_space, DstAoSoA& dst,
+                     const SrcAoSoA& src, DeepCopyAccessDst )
+{
+    auto staging = create_mirror( typename DstAoSoA::memory_space(), src );
+    deepCopyBytes<typename DstAoSoA::memory_space,
+                  typename SrcAoSoA::memory_space>(
+        exec_space, staging.data(), src.data(),
+        src.numSoA() * sizeof( typename SrcAoSoA::soa_type ) );
+    deepCopyTuples( exec_space, dst, staging );
+    exec_space.fence();
+}
+
+// Only the source is accessible: convert the layout in the source space and
+// copy the result to the destination. The staging buffer is released on
+// return so the instance is fenced.
+template <class ExecutionSpace, class DstAoSoA, class SrcAoSoA>
+void deepCopyLayout( const ExecutionSpace& exec_space, DstAoSoA& dst,
+                     const SrcAoSoA& src, DeepCopyAccessSrc )
+{
+    AoSoA<typename DstAoSoA::member_types, typename SrcAoSoA::memory_space,
+          DstAoSoA::vector_length>
+        staging( std::string( src.label() ).append( "_staging" ),
+                 src.size() );
+    deepCopyTuples( exec_space, staging, src );
+    deepCopyBytes<typename DstAoSoA::memory_space,
+                  typename SrcAoSoA::memory_space>(
+        exec_space, dst.data(), staging.data(),
+        dst.numSoA() * sizeof( typename DstAoSoA::soa_type ) );
+    exec_space.fence();
+}
+
+// Neither AoSoA is accessible.
+template <class ExecutionSpace, class DstAoSoA, class SrcAoSoA>
+void deepCopyLayout( const ExecutionSpace&, DstAoSoA&, const SrcAoSoA&,
+                     DeepCopyAccessNone )
+{
+    static_assert( !std::is_same<ExecutionSpace, ExecutionSpace>::value,
+                   "Asynchronous deep copy between different layouts "
+                   "requires an execution space which can access one of "
+                   "the AoSoAs" );
+}
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Asynchronously deep copy data between compatible AoSoA objects.
+
+  \param exec_space The execution space instance to enqueue the copy on.
+
+  \param dst The destination for the copied data.
+
+  \param src The source of the copied data.
+
+  Only AoSoA objects with the same set of member data types and size may be
+  copied. The copy is complete after fencing the execution space instance.
+  AoSoAs with the same inner array size are copied byte-wise. Otherwise the
+  layout is converted with a kernel on the instance, which must be able to
+  access at least one of the AoSoAs. If it can not access both, the copy is
+  staged through a temporary and completes before return.
+*/
+template <class ExecutionSpace, class DstAoSoA, class SrcAoSoA>
+inline void
+deep_copy( const ExecutionSpace& exec_space, DstAoSoA& dst, const SrcAoSoA& src,
+           typename std::enable_if<
+               ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+                 is_aosoa<DstAoSoA>::value &&
+                 is_aosoa<SrcAoSoA>::value )>::type* = 0 )
+{
+    using dst_type = DstAoSoA;
+    using src_type = SrcAoSoA;
+    using dst_memory_space = typename dst_type::memory_space;
+    using src_memory_space = typename src_type::memory_space;
+    using dst_soa_type = typename dst_type::soa_type;
+    using src_soa_type = typename src_type::soa_type;
+
+    // Check that the data types are the same.
+    static_assert(
+        std::is_same<typename dst_type::member_types,
+                     typename src_type::member_types>::value,
+        "Attempted to deep copy AoSoA objects of different member types" );
+
+    // Check for the same number of values.
+    if ( dst.size() != src.size() )
+    {
+        throw std::runtime_error(
+            "Attempted to deep copy AoSoA objects of different sizes" );
+    }
+
+    // Return if both pointers are null or the AoSoA memory occupies the same
+    // space.
+    void* dst_data = dst.data();
+    const void* src_data = src.data();
+    if ( dst_data == nullptr && src_data == nullptr )
+    {
+        return;
+    }
+    if ( ( dst_data == src_data ) &&
+         ( dst.numSoA() * sizeof( dst_soa_type ) ==
+           src.numSoA() * sizeof( src_soa_type ) ) )
+    {
+        return;
+    }
+
+    // Copy byte-wise for the same layout and otherwise convert the layout
+    // with a kernel on the instance.
+    constexpr bool access_dst =
+        Kokkos::SpaceAccessibility<ExecutionSpace,
+                                   dst_memory_space>::accessible;
+    constexpr bool access_src =
+        Kokkos::SpaceAccessibility<ExecutionSpace,
+                                   src_memory_space>::accessible;
+    using access_tag = typename std::conditional<
+        std::is_same<dst_soa_type, src_soa_type>::value,
+        Impl::DeepCopySameLayout,
+        typename std::conditional<
+            access_dst,
+            typename std::conditional<access_src, Impl::DeepCopyAccessBoth,
+                                      Impl::DeepCopyAccessDst>::type,
+            typename std::conditional<access_src, Impl::DeepCopyAccessSrc,
+                                      Impl::DeepCopyAccessNone>::type>::
+            type>::type;
+    Impl::deepCopyLayout( exec_space, dst, src, access_tag() );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Asynchronously fill an AoSoA with a tuple.
+
+  \param exec_space The execution space instance to enqueue the fill on. It
+  must be able to access the AoSoA.
+
+  \param aosoa The AoSoA to fill.
+
+  \param tuple The tuple to assign. All AoSoA elements will be assigned this
+  value.
+*/
+template <class ExecutionSpace, class AoSoA_t>
+inline void deep_copy(
+    const ExecutionSpace& exec_space, AoSoA_t& aosoa,
+    const typename AoSoA_t::tuple_type& tuple,
+    typename std::enable_if<
+        Kokkos::is_execution_space<ExecutionSpace>::value>::type* = 0 )
+{
+    static_assert( is_aosoa<AoSoA_t>::value,
+                   "Only AoSoAs can be assigned tuples" );
+    auto assign_func = KOKKOS_LAMBDA( const std::size_t i )
+    {
+        aosoa.setTuple( i, tuple );
+    };
+    Kokkos::RangePolicy<ExecutionSpace> exec_policy( exec_space, 0,
+                                                     aosoa.size() );
+    Kokkos::parallel_for( "Cabana::deep_copy", exec_policy, assign_func );
+}
+
+//---------------------------------------------------------------------------//
+namespace Impl
+{
+//! \cond Impl
+// Copy slice elements directly with a kernel on an execution space instance
+// which can access both slices.
+template <class ExecutionSpace, class DstSlice, class SrcSlice>
+void deepCopySlice( const ExecutionSpace& exec_space, DstSlice& dst,
+                    const SrcSlice& src, std::true_type )
+{
+    std::size_t num_comp = 1;
+    for ( std::size_t d = 2; d < dst.rank(); ++d )
+        num_comp *= dst.extent( d );
+
+    auto dst_data = dst.data();
+    const auto src_data = src.data();
+    auto copy_func = KOKKOS_LAMBDA( const std::size_t i )
+    {
+        auto src_offset = SrcSlice::index_type::s( i ) * src.stride( 0 ) +
+                          SrcSlice::index_type::a( i );
+        auto dst_offset = DstSlice::index_type::s( i ) * dst.stride( 0 ) +
+                          DstSlice::index_type::a( i );
+        for ( std::size_t n = 0; n < num_comp; ++n )
+            dst_data[dst_offset + DstSlice::vector_length * n] =
+                src_data[src_offset + SrcSlice::vector_length * n];
+    };
+    Kokkos::RangePolicy<ExecutionSpace> exec_policy( exec_space, 0,
+                                                     dst.size() );
+    Kokkos::parallel_for( "Cabana::deep_copy", exec_policy, copy_func );
+}
+
+// Otherwise the copy is staged through temporaries in both spaces. Work
+// already enqueued on the instance is completed first.
+template <class ExecutionSpace, class DstSlice, class SrcSlice>
+void deepCopySlice( const ExecutionSpace& exec_space, DstSlice& dst,
+                    const SrcSlice& src, std::false_type )
+{
+    exec_space.fence();
+    deep_copy( dst, src );
+}
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Asynchronously deep copy data between compatible Slice objects.
+
+  \param exec_space The execution space instance to enqueue the copy on.
+
+  \param dst The destination for the copied data.
+
+  \param src The source of the copied data.
+
+  Only Slice objects with the same set of member data types and size may be
+  copied. If the instance can access both slices the copy is a single kernel
+  and is complete after fencing the instance. Otherwise the copy is staged
+  through temporaries and completes before return.
+*/
+template <class ExecutionSpace, class DstSlice, class SrcSlice>
+inline void
+deep_copy( const ExecutionSpace& exec_space, DstSlice& dst, const SrcSlice& src,
+           typename std::enable_if<
+               ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+                 is_slice<DstSlice>::value &&
+                 is_slice<SrcSlice>::value )>::type* = 0 )
+{
+    static_assert(
+        std::is_same<typename DstSlice::value_type,
+                     typename SrcSlice::value_type>::value,
+        "Attempted to deep copy Slice objects of different value types" );
+
+    if ( dst.size() != src.size() )
+    {
+        throw std::runtime_error(
+            "Attempted to deep copy Slice objects of different sizes" );
+    }
+
+    if ( dst.data() == src.data() &&
+         ( dst.numSoA() * dst.stride( 0 ) == src.numSoA() * src.stride( 0 ) ) )
+    {
+        return;
+    }
+
+    constexpr bool access_dst =
+        Kokkos::SpaceAccessibility<ExecutionSpace,
+                                   typename DstSlice::memory_space>::accessible;
+    constexpr bool access_src =
+        Kokkos::SpaceAccessibility<ExecutionSpace,
+                                   typename SrcSlice::memory_space>::accessible;
+    using accessible = std::integral_constant<bool, access_dst && access_src>;
+    Impl::deepCopySlice( exec_space, dst, src, accessible() );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Asynchronously fill a slice with a scalar.
+
+  \param exec_space The execution space instance to enqueue the fill on.
+
+  \param slice The slice to fill.
+
+  \param scalar The scalar to assign. All slice elements will be assigned this
+  value.
+*/
+template <class ExecutionSpace, class Slice_t>
+inline void deep_copy(
+    const ExecutionSpace& exec_space, Slice_t& slice,
+    const typename Slice_t::value_type scalar,
+    typename std::enable_if<
+        Kokkos::is_execution_space<ExecutionSpace>::value>::type* = 0 )
+{
+    static_assert( is_slice<Slice_t>::value,
+                   "Only slices can be assigned scalars" );
+    Kokkos::deep_copy( exec_space, slice.view(), scalar );
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Cabana
@@ -18,13 +18,18 @@
 
 #include <Cabana_AoSoA.hpp>
 #include <Cabana_CommunicationPlan.hpp>
+#include <Cabana_GroupedAoSoA.hpp>
 #include <Cabana_Slice.hpp>
+#include <impl/Cabana_CommunicationPacking.hpp>
+#include <impl/Cabana_Profiling.hpp>
 
 #include <Kokkos_Core.hpp>
 
 #include <mpi.h>
 
 #include <exception>
+#include <initializer_list>
+#include <utility>
 #include <vector>
 
 namespace Cabana
@@ -100,6 +105,8 @@ class Distributor : public CommunicationPlan<DeviceType>
                  const std::vector<int>& neighbor_ranks )
         : CommunicationPlan<DeviceType>( comm )
     {
+        Impl::ScopedProfileRegion region( "Cabana::Distributor::Distributor" );
+
         auto neighbor_ids = this->createFromExportsAndTopology(
             element_export_ranks, neighbor_ranks );
         this->createExportSteering( neighbor_ids, element_export_ranks );
@@ -136,9 +143,65 @@ class Distributor : public CommunicationPlan<DeviceType>
     Distributor( MPI_Comm comm, const ViewType& element_export_ranks )
         : CommunicationPlan<DeviceType>( comm )
     {
+        Impl::ScopedProfileRegion region( "Cabana::Distributor::Distributor" );
+
         auto neighbor_ids = this->createFromExportsOnly( element_export_ranks );
         this->createExportSteering( neighbor_ids, element_export_ranks );
     }
+
+    /*!
+      \brief Update the distributor for a new set of export ranks. The
+      current topology is reused if all of the new exports are sent to
+      existing neighbors. Otherwise, the topology is recomputed as in the
+      export rank constructor.
+
+      \tparam ViewType The container type for the export element ranks. This
+      container type can be either a Kokkos View or a Cabana Slice.
+
+      \param element_export_ranks The destination rank in the target
+      decomposition of each locally owned element in the source
+      decomposition. An export rank of -1 will signal that this element is
+      *not* to be exported and will be ignored in the data migration. The
+      input is expected to be a Kokkos view or Cabana slice in the same
+      memory space as the distributor.
+
+      \note This is a collective operation over the distributor
+      communicator.
+    */
+    template <class ViewType>
+    void update( const ViewType& element_export_ranks )
+    {
+        Impl::ScopedProfileRegion region( "Cabana::Distributor::update" );
+
+        auto neighbor_ids = this->updateFromExports( element_export_ranks );
+        this->createExportSteering( neighbor_ids, element_export_ranks );
+    }
+
+    /*!
+      \brief Update the distributor for a new set of export ranks that are all
+      sent to the current neighbors. Only the export and import counts are
+      exchanged with the neighbors so no global communication is needed.
+
+      \tparam ViewType The container type for the export element ranks. This
+      container type can be either a Kokkos View or a Cabana Slice.
+
+      \param element_export_ranks The destination rank in the target
+      decomposition of each locally owned element in the source
+      decomposition. Each export rank must be one of the current neighbors or
+      -1 to signal that this element is *not* to be exported. The input is
+      expected to be a Kokkos view or Cabana slice in the same memory space
+      as the distributor.
+    */
+    template <class ViewType>
+    void updateWithTopology( const ViewType& element_export_ranks )
+    {
+        Impl::ScopedProfileRegion region(
+            "Cabana::Distributor::updateWithTopology" );
+
+        auto neighbor_ids =
+            this->updateFromExportsAndTopology( element_export_ranks );
+        this->createExportSteering( neighbor_ids, element_export_ranks );
+    }
 };
 
 //---------------------------------------------------------------------------//
@@ -165,12 +228,195 @@ struct is_distributor
 namespace Impl
 {
 //! \cond Impl
+//---------------------------------------------------------------------------//
+// Create the communication staging for a distributor operation from raw
+// send and receive data with the given sizes in bytes.
+template <class Distributor_t, class T>
+CommStaging<typename Distributor_t::memory_space>
+createDistributorStaging( const Distributor_t& distributor, T* send_data,
+                          const std::size_t send_bytes, T* recv_data,
+                          const std::size_t recv_bytes )
+{
+    using buffer_type =
+        typename CommStaging<typename Distributor_t::memory_space>::buffer_type;
+    return createCommStaging(
+        distributor,
+        buffer_type( reinterpret_cast<char*>( send_data ), send_bytes ),
+        send_bytes,
+        buffer_type( reinterpret_cast<char*>( recv_data ), recv_bytes ),
+        recv_bytes );
+}
+
+//---------------------------------------------------------------------------//
+// Exchange the data of a distributor operation with a single neighborhood
+// collective or through node shared memory and wait for it to complete. The
+// data staying on this rank is not communicated and is expected to be first
+// in the receive data. If the send data also contains the staying elements
+// first they are skipped.
+template <class Distributor_t, class Staging>
+void exchangeCollective( const Distributor_t& distributor,
+                         const Staging& staging,
+                         const std::size_t element_bytes,
+                         const bool send_includes_stay )
+{
+    // Get the MPI rank we are currently on.
+    int my_rank = -1;
+    MPI_Comm_rank( distributor.comm(), &my_rank );
+
+    // Compute the byte counts and displacements for each neighbor.
+    int num_n = distributor.numNeighbor();
+    std::vector<int> send_counts( num_n, 0 );
+    std::vector<int> send_displs( num_n, 0 );
+    std::vector<int> recv_counts( num_n, 0 );
+    std::vector<int> recv_displs( num_n, 0 );
+    std::size_t send_offset = 0;
+    std::size_t recv_offset = 0;
+    std::size_t num_stay = 0;
+    for ( int n = 0; n < num_n; ++n )
+    {
+        std::size_t send_bytes = distributor.numExport( n ) * element_bytes;
+        std::size_t recv_bytes = distributor.numImport( n ) * element_bytes;
+        send_displs[n] = send_offset;
+        recv_displs[n] = recv_offset;
+        if ( distributor.neighborRank( n ) != my_rank )
+        {
+            send_counts[n] = send_bytes;
+            recv_counts[n] = recv_bytes;
+            send_offset += send_bytes;
+        }
+        else
+        {
+            num_stay = distributor.numImport( n );
+            if ( send_includes_stay )
+                send_offset += send_bytes;
+        }
+        recv_offset += recv_bytes;
+    }
+
+    // Exchange and wait.
+    if ( CommBackend::NodeShared == distributor.backend() )
+    {
+        exchangeNodeShared( distributor, staging.sendData(), send_counts,
+                            send_displs, staging.recvData(), recv_counts,
+                            recv_displs );
+    }
+    else
+    {
+        MPI_Request request = postNeighborAlltoallv(
+            distributor, staging.sendData(), send_counts, send_displs,
+            staging.recvData(), recv_counts, recv_displs );
+        MPI_Status status;
+        Impl::CommWait comm_wait( "Cabana::migrate::wait",
+                                  distributor.statistics().get() );
+        const int ec = MPI_Wait( &request, &status );
+        comm_wait.stop();
+        if ( MPI_SUCCESS != ec )
+            throw std::logic_error( "Failed MPI Communication" );
+    }
+
+    // Complete the receipt of the data that was not staying.
+    staging.finishRecv( num_stay * element_bytes,
+                        recv_offset - num_stay * element_bytes );
+}
+
+//---------------------------------------------------------------------------//
+// Exchange the data of a distributor operation with point-to-point messages
+// and wait for them to complete. Both the send and receive data are expected
+// to contain the elements staying on this rank first and these are not
+// communicated.
+template <class Distributor_t, class Staging>
+void exchangePointToPoint( const Distributor_t& distributor,
+                           const Staging& staging,
+                           const std::size_t element_bytes )
+{
+    // Get the MPI rank we are currently on.
+    int my_rank = -1;
+    MPI_Comm_rank( distributor.comm(), &my_rank );
+
+    // Get the number of neighbors.
+    int num_n = distributor.numNeighbor();
+
+    // Get the number of elements staying on this rank.
+    std::size_t num_stay =
+        ( num_n > 0 && distributor.neighborRank( 0 ) == my_rank )
+            ? distributor.numExport( 0 )
+            : 0;
+
+    char* send_data = staging.sendData();
+    char* recv_data = staging.recvData();
+
+    // The distributor has its own communication space so choose any tag.
+    const int mpi_tag = 1234;
+
+    // Post non-blocking receives.
+    std::vector<MPI_Request> requests;
+    requests.reserve( 2 * num_n );
+    std::size_t recv_offset = 0;
+    for ( int n = 0; n < num_n; ++n )
+    {
+        std::size_t recv_bytes = distributor.numImport( n ) * element_bytes;
+        if ( ( recv_bytes > 0 ) &&
+             ( distributor.neighborRank( n ) != my_rank ) )
+        {
+            requests.push_back( MPI_Request() );
+            MPI_Irecv( recv_data + recv_offset, recv_bytes, MPI_BYTE,
+                       distributor.neighborRank( n ), mpi_tag,
+                       distributor.comm(), &( requests.back() ) );
+        }
+        recv_offset += recv_bytes;
+    }
+
+    // Post non-blocking sends.
+    std::size_t send_offset = 0;
+    for ( int n = 0; n < num_n; ++n )
+    {
+        std::size_t send_bytes = distributor.numExport( n ) * element_bytes;
+        if ( ( send_bytes > 0 ) &&
+             ( distributor.neighborRank( n ) != my_rank ) )
+        {
+            requests.push_back( MPI_Request() );
+            MPI_Isend( send_data + send_offset, send_bytes, MPI_BYTE,
+                       distributor.neighborRank( n ), mpi_tag,
+                       distributor.comm(), &( requests.back() ) );
+        }
+        send_offset += send_bytes;
+    }
+
+    // Wait on non-blocking communication.
+    std::vector<MPI_Status> status( requests.size() );
+    Impl::CommWait comm_wait( "Cabana::migrate::wait",
+                              distributor.statistics().get() );
+    const int ec =
+        MPI_Waitall( requests.size(), requests.data(), status.data() );
+    comm_wait.stop();
+    if ( MPI_SUCCESS != ec )
+        throw std::logic_error( "Failed MPI Communication" );
+
+    // Complete the receipt of the data that was not staying.
+    staging.finishRecv( num_stay * element_bytes,
+                        recv_offset - num_stay * element_bytes );
+}
+
+//---------------------------------------------------------------------------//
+// Pack transform leaving the exported tuples unchanged.
+struct IdentityPackTransform
+{
+    template <class Tuple>
+    KOKKOS_INLINE_FUNCTION void operator()( const std::size_t, Tuple& ) const
+    {
+    }
+};
+
 //---------------------------------------------------------------------------//
 // Synchronously move data between a source and destination AoSoA by executing
-// the forward communication plan.
-template <class Distributor_t, class AoSoA_t>
+// the forward communication plan. Each exported tuple is passed through the
+// transform as it is packed. The packing and unpacking kernels are enqueued
+// on the given execution space instance.
+template <class ExecutionSpace, class Distributor_t, class AoSoA_t,
+          class PackTransform>
 void distributeData(
-    const Distributor_t& distributor, const AoSoA_t& src, AoSoA_t& dst,
+    const ExecutionSpace& exec_space, const Distributor_t& distributor,
+    const AoSoA_t& src, AoSoA_t& dst, const PackTransform& transform,
     typename std::enable_if<( is_distributor<Distributor_t>::value &&
                               is_aosoa<AoSoA_t>::value ),
                             int>::type* = 0 )
@@ -213,90 +459,517 @@ void distributeData(
     // buffer or the receive buffer if the data is staying. We know that the
     // steering vector is ordered such that the data staying on this rank
     // comes first.
+    Kokkos::Profiling::pushRegion( "Cabana::migrate::pack" );
     auto build_send_buffer_func = KOKKOS_LAMBDA( const std::size_t i )
     {
         auto tpl = src.getTuple( steering( i ) );
+        transform( steering( i ), tpl );
         if ( i < num_stay )
             recv_buffer( i ) = tpl;
         else
             send_buffer( i - num_stay ) = tpl;
     };
-    Kokkos::RangePolicy<typename Distributor_t::execution_space>
-        build_send_buffer_policy( 0, distributor.totalNumExport() );
+    Kokkos::RangePolicy<ExecutionSpace> build_send_buffer_policy(
+        exec_space, 0, distributor.totalNumExport() );
     Kokkos::parallel_for( "Cabana::Impl::distributeData::build_send_buffer",
                           build_send_buffer_policy, build_send_buffer_func );
-    Kokkos::fence();
+    exec_space.fence();
+
+    // Stage the messages through the host if needed.
+    const std::size_t element_bytes = sizeof( typename AoSoA_t::tuple_type );
+    auto staging = createDistributorStaging(
+        distributor, send_buffer.data(), num_send * element_bytes,
+        recv_buffer.data(), distributor.totalNumImport() * element_bytes );
+    Kokkos::Profiling::popRegion();
+    recordCommOperation( distributor, true, element_bytes );
+
+    // Extract the receive buffer into the destination AoSoA. The source
+    // data has been completely packed so this is safe to do for each
+    // neighbor as their data arrives, even for in-place migration.
+    auto extract_recv_buffer_func = KOKKOS_LAMBDA( const std::size_t i )
+    {
+        dst.setTuple( i, recv_buffer( i ) );
+    };
+
+    // Exchange with a single neighborhood collective or through node shared
+    // memory if requested.
+    if ( CommBackend::PointToPoint != distributor.backend() )
+    {
+        exchangeCollective( distributor, staging, element_bytes, false );
+        Kokkos::RangePolicy<ExecutionSpace> extract_recv_buffer_policy(
+            exec_space, 0, distributor.totalNumImport() );
+        Kokkos::parallel_for(
+            "Cabana::Impl::distributeData::extract_recv_buffer",
+            extract_recv_buffer_policy, extract_recv_buffer_func );
+        exec_space.fence();
+        Impl::CommWait barrier_wait( "Cabana::migrate::wait",
+                                     distributor.statistics().get() );
+        MPI_Barrier( distributor.comm() );
+        barrier_wait.stop();
+        return;
+    }
+
+    char* send_data = staging.sendData();
+    char* recv_data = staging.recvData();
 
     // The distributor has its own communication space so choose any tag.
     const int mpi_tag = 1234;
 
     // Post non-blocking receives.
-    std::vector<MPI_Request> requests;
-    requests.reserve( num_n );
-    std::pair<std::size_t, std::size_t> recv_range = { 0, 0 };
+    std::vector<MPI_Request> recv_requests;
+    std::vector<int> recv_neighbors;
+    std::vector<std::size_t> recv_offsets( num_n, 0 );
+    recv_requests.reserve( num_n );
+    recv_neighbors.reserve( num_n );
     for ( int n = 0; n < num_n; ++n )
     {
-        recv_range.second = recv_range.first + distributor.numImport( n );
+        if ( n > 0 )
+            recv_offsets[n] =
+                recv_offsets[n - 1] + distributor.numImport( n - 1 );
 
         if ( ( distributor.numImport( n ) > 0 ) &&
              ( distributor.neighborRank( n ) != my_rank ) )
         {
-            auto recv_subview = Kokkos::subview( recv_buffer, recv_range );
+            recv_requests.push_back( MPI_Request() );
+            recv_neighbors.push_back( n );
 
-            requests.push_back( MPI_Request() );
-
-            MPI_Irecv( recv_subview.data(),
-                       recv_subview.size() *
-                           sizeof( typename AoSoA_t::tuple_type ),
+            MPI_Irecv( recv_data + recv_offsets[n] * element_bytes,
+                       distributor.numImport( n ) * element_bytes,
                        MPI_BYTE, distributor.neighborRank( n ), mpi_tag,
-                       distributor.comm(), &( requests.back() ) );
+                       distributor.comm(), &( recv_requests.back() ) );
         }
-
-        recv_range.first = recv_range.second;
     }
 
-    // Do blocking sends.
-    std::pair<std::size_t, std::size_t> send_range = { 0, 0 };
+    // Post non-blocking sends.
+    std::vector<MPI_Request> send_requests;
+    send_requests.reserve( num_n );
+    std::size_t send_offset = 0;
     for ( int n = 0; n < num_n; ++n )
     {
         if ( ( distributor.numExport( n ) > 0 ) &&
              ( distributor.neighborRank( n ) != my_rank ) )
         {
-            send_range.second = send_range.first + distributor.numExport( n );
+            send_requests.push_back( MPI_Request() );
 
-            auto send_subview = Kokkos::subview( send_buffer, send_range );
-
-            MPI_Send( send_subview.data(),
-                      send_subview.size() *
-                          sizeof( typename AoSoA_t::tuple_type ),
-                      MPI_BYTE, distributor.neighborRank( n ), mpi_tag,
-                      distributor.comm() );
+            MPI_Isend( send_data + send_offset * element_bytes,
+                       distributor.numExport( n ) * element_bytes,
+                       MPI_BYTE, distributor.neighborRank( n ), mpi_tag,
+                       distributor.comm(), &( send_requests.back() ) );
 
-            send_range.first = send_range.second;
+            send_offset += distributor.numExport( n );
         }
     }
 
-    // Wait on non-blocking receives.
-    std::vector<MPI_Status> status( requests.size() );
-    const int ec =
-        MPI_Waitall( requests.size(), requests.data(), status.data() );
+    // Extract the data staying on this rank while the messages are in
+    // flight.
+    Kokkos::RangePolicy<ExecutionSpace> extract_stay_policy(
+        exec_space, 0, num_stay );
+    Kokkos::parallel_for( "Cabana::Impl::distributeData::extract_recv_buffer",
+                          extract_stay_policy, extract_recv_buffer_func );
+
+    // Extract the data from each neighbor as it arrives.
+    for ( std::size_t r = 0; r < recv_requests.size(); ++r )
+    {
+        int unpack_index = -1;
+        MPI_Status status;
+        Impl::CommWait comm_wait( "Cabana::migrate::wait",
+                                  distributor.statistics().get() );
+        const int ec = MPI_Waitany( recv_requests.size(),
+                                    recv_requests.data(), &unpack_index,
+                                    &status );
+        comm_wait.stop();
+        if ( MPI_SUCCESS != ec )
+            throw std::logic_error( "Failed MPI Communication" );
+
+        Kokkos::Profiling::pushRegion( "Cabana::migrate::unpack" );
+        int n = recv_neighbors[unpack_index];
+        staging.finishRecv( recv_offsets[n] * element_bytes,
+                            distributor.numImport( n ) * element_bytes );
+        Kokkos::RangePolicy<ExecutionSpace> extract_recv_buffer_policy(
+            exec_space, recv_offsets[n],
+            recv_offsets[n] + distributor.numImport( n ) );
+        Kokkos::parallel_for(
+            "Cabana::Impl::distributeData::extract_recv_buffer",
+            extract_recv_buffer_policy, extract_recv_buffer_func );
+        Kokkos::Profiling::popRegion();
+    }
+    Kokkos::Profiling::pushRegion( "Cabana::migrate::unpack" );
+    exec_space.fence();
+    Kokkos::Profiling::popRegion();
+
+    // Wait on non-blocking sends.
+    Impl::CommWait comm_wait( "Cabana::migrate::wait",
+                              distributor.statistics().get() );
+    std::vector<MPI_Status> send_status( send_requests.size() );
+    const int ec = MPI_Waitall( send_requests.size(), send_requests.data(),
+                                send_status.data() );
+    comm_wait.stop();
     if ( MPI_SUCCESS != ec )
         throw std::logic_error( "Failed MPI Communication" );
 
+    // Barrier before completing to ensure synchronization.
+    Impl::CommWait barrier_wait( "Cabana::migrate::wait",
+                                 distributor.statistics().get() );
+    MPI_Barrier( distributor.comm() );
+    barrier_wait.stop();
+}
+
+//---------------------------------------------------------------------------//
+// Synchronously move a subset of the members of a source AoSoA into a
+// destination AoSoA by executing the forward communication plan. All members
+// are packed into a single fused buffer such that only one message is sent
+// to each neighbor.
+template <std::size_t... M, class Distributor_t, class AoSoA_t>
+void distributeFusedMembers(
+    const Distributor_t& distributor, const AoSoA_t& src, AoSoA_t& dst,
+    typename std::enable_if<( is_distributor<Distributor_t>::value &&
+                              is_aosoa<AoSoA_t>::value ),
+                            int>::type* = 0 )
+{
+    using execution_space = typename Distributor_t::execution_space;
+    using memory_space = typename Distributor_t::memory_space;
+
+    // Get the MPI rank we are currently on.
+    int my_rank = -1;
+    MPI_Comm_rank( distributor.comm(), &my_rank );
+
+    // Get the number of neighbors.
+    int num_n = distributor.numNeighbor();
+
+    // Calculate the number of elements that are staying on this rank and
+    // therefore can be directly copied. If any of the neighbor ranks are this
+    // rank it will be stored in first position (i.e. the first neighbor in
+    // the local list is always yourself if you are sending to yourself).
+    std::size_t num_stay =
+        ( num_n > 0 && distributor.neighborRank( 0 ) == my_rank )
+            ? distributor.numExport( 0 )
+            : 0;
+
+    // Compute the layout of each element in the fused buffers.
+    auto layout = createFusedRecordLayout( slice<M>( src )... );
+
+    // Allocate a send buffer and pack all exports into it. The steering
+    // vector is ordered such that the data staying on this rank comes
+    // first.
+    Kokkos::View<char*, memory_space> send_buffer(
+        Kokkos::ViewAllocateWithoutInitializing( "distributor_send_buffer" ),
+        distributor.totalNumExport() * layout.bytes );
+    packFusedSlices<execution_space>( distributor.getExportSteering(),
+                                      send_buffer, layout, slice<M>( src )... );
+
+    // Allocate a receive buffer and copy in the data that is staying.
+    Kokkos::View<char*, memory_space> recv_buffer(
+        Kokkos::ViewAllocateWithoutInitializing( "distributor_recv_buffer" ),
+        distributor.totalNumImport() * layout.bytes );
+    if ( num_stay > 0 )
+    {
+        std::pair<std::size_t, std::size_t> stay_range = {
+            0, num_stay * layout.bytes };
+        Kokkos::deep_copy( Kokkos::subview( recv_buffer, stay_range ),
+                           Kokkos::subview( send_buffer, stay_range ) );
+    }
+
+    // Stage the messages through the host if needed.
+    auto staging = createDistributorStaging(
+        distributor, send_buffer.data(),
+        distributor.totalNumExport() * layout.bytes, recv_buffer.data(),
+        distributor.totalNumImport() * layout.bytes );
+
+    // Exchange the data leaving this rank.
+    recordCommOperation( distributor, true, layout.bytes );
+    if ( CommBackend::PointToPoint != distributor.backend() )
+        exchangeCollective( distributor, staging, layout.bytes, true );
+    else
+        exchangePointToPoint( distributor, staging, layout.bytes );
+
     // Extract the receive buffer into the destination AoSoA.
+    unpackFusedSlices<execution_space>( 0, distributor.totalNumImport(),
+                                        recv_buffer, layout,
+                                        slice<M>( dst )... );
+
+    // Barrier before completing to ensure synchronization.
+    Impl::CommWait barrier_wait( "Cabana::migrate::wait",
+                                 distributor.statistics().get() );
+    MPI_Barrier( distributor.comm() );
+    barrier_wait.stop();
+}
+
+//---------------------------------------------------------------------------//
+// Synchronously migrate an AoSoA in-place by executing the forward
+// communication plan without moving the elements staying on this rank. The
+// positions left by departing elements are filled with staying elements from
+// beyond the new size and then with the received elements such that the
+// data moved is proportional to the number of elements sent and received.
+// The kernels are enqueued on the given execution space instance.
+template <class ExecutionSpace, class Distributor_t, class AoSoA_t>
+void distributeInPlace(
+    const ExecutionSpace& exec_space, const Distributor_t& distributor,
+    AoSoA_t& aosoa,
+    typename std::enable_if<( is_distributor<Distributor_t>::value &&
+                              is_aosoa<AoSoA_t>::value ),
+                            int>::type* = 0 )
+{
+    using memory_space = typename Distributor_t::memory_space;
+    using tuple_type = typename AoSoA_t::tuple_type;
+
+    // Get the MPI rank we are currently on.
+    int my_rank = -1;
+    MPI_Comm_rank( distributor.comm(), &my_rank );
+
+    // Get the number of neighbors.
+    int num_n = distributor.numNeighbor();
+
+    // Calculate the number of elements that are staying on this rank. They
+    // are first in the steering vector.
+    std::size_t num_stay =
+        ( num_n > 0 && distributor.neighborRank( 0 ) == my_rank )
+            ? distributor.numExport( 0 )
+            : 0;
+    const std::size_t num_src = distributor.exportSize();
+    const std::size_t num_dst = distributor.totalNumImport();
+    const std::size_t num_send = distributor.totalNumExport() - num_stay;
+    const std::size_t num_recv = num_dst - num_stay;
+
+    // Pack the elements leaving this rank.
+    Kokkos::Profiling::pushRegion( "Cabana::migrate::pack" );
+    auto steering = distributor.getExportSteering();
+    Kokkos::View<tuple_type*, memory_space> send_buffer(
+        Kokkos::ViewAllocateWithoutInitializing( "distributor_send_buffer" ),
+        num_send );
+    auto build_send_buffer_func = KOKKOS_LAMBDA( const std::size_t i )
+    {
+        send_buffer( i ) = aosoa.getTuple( steering( i + num_stay ) );
+    };
+    Kokkos::parallel_for(
+        "Cabana::Impl::distributeInPlace::build_send_buffer",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_send ),
+        build_send_buffer_func );
+    exec_space.fence();
+
+    // Stage the messages through the host if needed.
+    const std::size_t element_bytes = sizeof( tuple_type );
+    Kokkos::View<tuple_type*, memory_space> recv_buffer(
+        Kokkos::ViewAllocateWithoutInitializing( "distributor_recv_buffer" ),
+        num_recv );
+    auto staging = createDistributorStaging(
+        distributor, send_buffer.data(), num_send * element_bytes,
+        recv_buffer.data(), num_recv * element_bytes );
+    Kokkos::Profiling::popRegion();
+    recordCommOperation( distributor, true, element_bytes );
+
+    // Post the receives and sends of the elements not staying on this
+    // rank. The received elements are contiguous by neighbor.
+    char* send_data = staging.sendData();
+    char* recv_data = staging.recvData();
+    const int mpi_tag = 1234;
+    std::vector<MPI_Request> recv_requests;
+    std::vector<std::size_t> recv_offsets;
+    std::vector<std::size_t> recv_sizes;
+    std::vector<MPI_Request> send_requests;
+    if ( CommBackend::PointToPoint != distributor.backend() )
+    {
+        std::vector<int> send_counts( num_n, 0 );
+        std::vector<int> send_displs( num_n, 0 );
+        std::vector<int> recv_counts( num_n, 0 );
+        std::vector<int> recv_displs( num_n, 0 );
+        std::size_t send_offset = 0;
+        std::size_t recv_offset = 0;
+        for ( int n = 0; n < num_n; ++n )
+        {
+            send_displs[n] = send_offset;
+            recv_displs[n] = recv_offset;
+            if ( distributor.neighborRank( n ) != my_rank )
+            {
+                send_counts[n] = distributor.numExport( n ) * element_bytes;
+                recv_counts[n] = distributor.numImport( n ) * element_bytes;
+                send_offset += send_counts[n];
+                recv_offset += recv_counts[n];
+            }
+        }
+        // The node shared exchange completes before returning and its data
+        // is extracted with the other received elements below.
+        if ( CommBackend::NodeShared == distributor.backend() )
+        {
+            exchangeNodeShared( distributor, send_data, send_counts,
+                                send_displs, recv_data, recv_counts,
+                                recv_displs );
+            recv_requests.push_back( MPI_REQUEST_NULL );
+        }
+        else
+        {
+            recv_requests.push_back( postNeighborAlltoallv(
+                distributor, send_data, send_counts, send_displs, recv_data,
+                recv_counts, recv_displs ) );
+        }
+        recv_offsets.push_back( 0 );
+        recv_sizes.push_back( num_recv );
+    }
+    else
+    {
+        std::size_t recv_offset = 0;
+        std::size_t send_offset = 0;
+        for ( int n = 0; n < num_n; ++n )
+        {
+            if ( distributor.neighborRank( n ) == my_rank )
+                continue;
+            std::size_t num_import = distributor.numImport( n );
+            if ( num_import > 0 )
+            {
+                recv_requests.push_back( MPI_Request() );
+                recv_offsets.push_back( recv_offset );
+                recv_sizes.push_back( num_import );
+                MPI_Irecv( recv_data + recv_offset * element_bytes,
+                           num_import * element_bytes, MPI_BYTE,
+                           distributor.neighborRank( n ), mpi_tag,
+                           distributor.comm(), &( recv_requests.back() ) );
+            }
+            recv_offset += num_import;
+        }
+        for ( int n = 0; n < num_n; ++n )
+        {
+            if ( distributor.neighborRank( n ) == my_rank )
+                continue;
+            std::size_t num_export = distributor.numExport( n );
+            if ( num_export > 0 )
+            {
+                send_requests.push_back( MPI_Request() );
+                MPI_Isend( send_data + send_offset * element_bytes,
+                           num_export * element_bytes, MPI_BYTE,
+                           distributor.neighborRank( n ), mpi_tag,
+                           distributor.comm(), &( send_requests.back() ) );
+            }
+            send_offset += num_export;
+        }
+    }
+
+    // Grow the AoSoA if needed while the messages are in flight. The
+    // existing data is preserved.
+    if ( num_dst > num_src )
+        aosoa.resize( num_dst );
+
+    // Mark the elements staying on this rank.
+    Kokkos::View<int*, memory_space> stay(
+        Kokkos::view_alloc( exec_space, "distributor_stay" ), num_src );
+    Kokkos::parallel_for(
+        "Cabana::Impl::distributeInPlace::mark_stay",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_stay ),
+        KOKKOS_LAMBDA( const std::size_t i ) { stay( steering( i ) ) = 1; } );
+
+    // Find the staying elements beyond the new size. These must move.
+    const std::size_t num_high_begin = ( num_dst < num_src ) ? num_dst : 0;
+    const std::size_t num_high_end = ( num_dst < num_src ) ? num_src : 0;
+    std::size_t num_high = 0;
+    Kokkos::parallel_reduce(
+        "Cabana::Impl::distributeInPlace::count_high",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, num_high_begin,
+                                             num_high_end ),
+        KOKKOS_LAMBDA( const std::size_t i, std::size_t& count ) {
+            count += stay( i );
+        },
+        num_high );
+    Kokkos::View<std::size_t*, memory_space> high(
+        Kokkos::ViewAllocateWithoutInitializing( "distributor_high" ),
+        num_high );
+    Kokkos::parallel_scan(
+        "Cabana::Impl::distributeInPlace::find_high",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, num_high_begin,
+                                             num_high_end ),
+        KOKKOS_LAMBDA( const std::size_t i, std::size_t& offset,
+                       const bool final_pass ) {
+            if ( stay( i ) )
+            {
+                if ( final_pass )
+                    high( offset ) = i;
+                ++offset;
+            }
+        } );
+
+    // Find the positions within the new size not holding a staying element.
+    // These are filled first by the staying elements beyond the new size and
+    // then by the received elements.
+    Kokkos::View<std::size_t*, memory_space> holes(
+        Kokkos::ViewAllocateWithoutInitializing( "distributor_holes" ),
+        num_high + num_recv );
+    Kokkos::parallel_scan(
+        "Cabana::Impl::distributeInPlace::find_holes",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_dst ),
+        KOKKOS_LAMBDA( const std::size_t i, std::size_t& offset,
+                       const bool final_pass ) {
+            if ( i >= num_src || !stay( i ) )
+            {
+                if ( final_pass )
+                    holes( offset ) = i;
+                ++offset;
+            }
+        } );
+
+    // Move the staying elements beyond the new size into the first holes.
+    // The holes are all below the new size so the moves do not overlap.
+    Kokkos::parallel_for(
+        "Cabana::Impl::distributeInPlace::move_high",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_high ),
+        KOKKOS_LAMBDA( const std::size_t i ) {
+            aosoa.setTuple( holes( i ), aosoa.getTuple( high( i ) ) );
+        } );
+
+    // Extract the received elements into the remaining holes as they arrive.
     auto extract_recv_buffer_func = KOKKOS_LAMBDA( const std::size_t i )
     {
-        dst.setTuple( i, recv_buffer( i ) );
+        aosoa.setTuple( holes( num_high + i ), recv_buffer( i ) );
     };
-    Kokkos::RangePolicy<typename Distributor_t::execution_space>
-        extract_recv_buffer_policy( 0, distributor.totalNumImport() );
-    Kokkos::parallel_for( "Cabana::Impl::distributeData::extract_recv_buffer",
-                          extract_recv_buffer_policy,
-                          extract_recv_buffer_func );
-    Kokkos::fence();
+    for ( std::size_t r = 0; r < recv_requests.size(); ++r )
+    {
+        int unpack_index = -1;
+        MPI_Status status;
+        Impl::CommWait comm_wait( "Cabana::migrate::wait",
+                                  distributor.statistics().get() );
+        const int ec = MPI_Waitany( recv_requests.size(),
+                                    recv_requests.data(), &unpack_index,
+                                    &status );
+        comm_wait.stop();
+        if ( MPI_SUCCESS != ec )
+            throw std::logic_error( "Failed MPI Communication" );
+
+        // The null request of a completed node shared exchange is the only
+        // request.
+        if ( MPI_UNDEFINED == unpack_index )
+            unpack_index = r;
+
+        Kokkos::Profiling::pushRegion( "Cabana::migrate::unpack" );
+        staging.finishRecv( recv_offsets[unpack_index] * element_bytes,
+                            recv_sizes[unpack_index] * element_bytes );
+        Kokkos::parallel_for(
+            "Cabana::Impl::distributeInPlace::extract_recv_buffer",
+            Kokkos::RangePolicy<ExecutionSpace>(
+                exec_space, recv_offsets[unpack_index],
+                recv_offsets[unpack_index] + recv_sizes[unpack_index] ),
+            extract_recv_buffer_func );
+        Kokkos::Profiling::popRegion();
+    }
+    Kokkos::Profiling::pushRegion( "Cabana::migrate::unpack" );
+    exec_space.fence();
+    Kokkos::Profiling::popRegion();
+
+    // Wait on non-blocking sends.
+    Impl::CommWait comm_wait( "Cabana::migrate::wait",
+                              distributor.statistics().get() );
+    std::vector<MPI_Status> send_status( send_requests.size() );
+    const int ec = MPI_Waitall( send_requests.size(), send_requests.data(),
+                                send_status.data() );
+    comm_wait.stop();
+    if ( MPI_SUCCESS != ec )
+        throw std::logic_error( "Failed MPI Communication" );
+
+    // Shrink the AoSoA if needed now that the elements beyond the new size
+    // have moved.
+    if ( num_dst < num_src )
+        aosoa.resize( num_dst );
 
     // Barrier before completing to ensure synchronization.
+    Impl::CommWait barrier_wait( "Cabana::migrate::wait",
+                                 distributor.statistics().get() );
     MPI_Barrier( distributor.comm() );
+    barrier_wait.stop();
 }
 
 //---------------------------------------------------------------------------//
@@ -323,6 +996,42 @@ void distributeData(
   \param dst The AoSoA to which the migrated data will be written. Must be the
   same size as the number of imports given by the distributor on this
   rank. Call totalNumImport() on the distributor to get this size value.
+
+  \param exec_space The execution space instance on which the packing and
+  unpacking kernels are enqueued.
+*/
+template <class ExecutionSpace, class Distributor_t, class AoSoA_t>
+void migrate( const ExecutionSpace& exec_space,
+              const Distributor_t& distributor, const AoSoA_t& src,
+              AoSoA_t& dst,
+              typename std::enable_if<
+                  ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+                    is_distributor<Distributor_t>::value &&
+                    is_aosoa<AoSoA_t>::value ),
+                  int>::type* = 0 )
+{
+    Impl::ScopedProfileRegion region( "Cabana::migrate" );
+
+    // Check that src and dst are the right size.
+    if ( src.size() != distributor.exportSize() )
+        throw std::runtime_error( "Source is the wrong size for migration!" );
+    if ( dst.size() != distributor.totalNumImport() )
+        throw std::runtime_error(
+            "Destination is the wrong size for migration!" );
+
+    // Move the data.
+    Impl::distributeData( exec_space, distributor, src, dst,
+                          Impl::IdentityPackTransform() );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Synchronously migrate data between two different decompositions using
+  the distributor forward communication plan on the default execution space
+  instance. Multiple AoSoA version.
+
+  \see migrate( const ExecutionSpace&, const Distributor_t&, const AoSoA_t&,
+  AoSoA_t& )
 */
 template <class Distributor_t, class AoSoA_t>
 void migrate( const Distributor_t& distributor, const AoSoA_t& src,
@@ -331,6 +1040,93 @@ void migrate( const Distributor_t& distributor, const AoSoA_t& src,
                                         is_aosoa<AoSoA_t>::value ),
                                       int>::type* = 0 )
 {
+    migrate( typename Distributor_t::execution_space(), distributor, src,
+             dst );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Synchronously migrate data between two different decompositions using
+  the distributor forward communication plan, transforming each element as it
+  is packed for sending. Multiple AoSoA version.
+
+  \tparam Distributor_t Distributor type - must be a distributor.
+
+  \tparam AoSoA_t AoSoA type - must be an AoSoA.
+
+  \tparam PackTransform Functor with a const operator()( const std::size_t i,
+  tuple_type& tuple ) called on the tuple of each exported element i of the
+  source before it is sent.
+
+  \param distributor The distributor to use for the migration.
+
+  \param src The AoSoA containing the data to be migrated. Must have the same
+  number of elements as the inputs used to construct the distributor.
+
+  \param dst The AoSoA to which the migrated data will be written. Must be the
+  same size as the number of imports given by the distributor on this
+  rank.
+
+  \param transform The transform applied to each exported element.
+*/
+template <class Distributor_t, class AoSoA_t, class PackTransform>
+void migrate( const Distributor_t& distributor, const AoSoA_t& src,
+              AoSoA_t& dst, const PackTransform& transform,
+              typename std::enable_if<( is_distributor<Distributor_t>::value &&
+                                        is_aosoa<AoSoA_t>::value ),
+                                      int>::type* = 0 )
+{
+    Impl::ScopedProfileRegion region( "Cabana::migrate" );
+
+    // Check that src and dst are the right size.
+    if ( src.size() != distributor.exportSize() )
+        throw std::runtime_error( "Source is the wrong size for migration!" );
+    if ( dst.size() != distributor.totalNumImport() )
+        throw std::runtime_error(
+            "Destination is the wrong size for migration!" );
+
+    // Move the data.
+    Impl::distributeData( typename Distributor_t::execution_space(),
+                          distributor, src, dst, transform );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Synchronously migrate a subset of the AoSoA members between two
+  different decompositions using the distributor forward communication
+  plan. Multiple AoSoA version.
+
+  Only the given members are communicated and written to the destination. The
+  members are packed into a single fused buffer such that one message is sent
+  to each neighbor. For example, migrate<0,2>( distributor, src, dst ) will
+  only migrate members 0 and 2.
+
+  \tparam M0 The index of the first member to migrate.
+
+  \tparam M The indices of the remaining members to migrate.
+
+  \tparam Distributor_t Distributor type - must be a distributor.
+
+  \tparam AoSoA_t AoSoA type - must be an AoSoA.
+
+  \param distributor The distributor to use for the migration.
+
+  \param src The AoSoA containing the data to be migrated. Must have the same
+  number of elements as the inputs used to construct the distributor.
+
+  \param dst The AoSoA to which the migrated data will be written. Must be the
+  same size as the number of imports given by the distributor on this
+  rank. Call totalNumImport() on the distributor to get this size value.
+*/
+template <std::size_t M0, std::size_t... M, class Distributor_t, class AoSoA_t>
+void migrate( const Distributor_t& distributor, const AoSoA_t& src,
+              AoSoA_t& dst,
+              typename std::enable_if<( is_distributor<Distributor_t>::value &&
+                                        is_aosoa<AoSoA_t>::value ),
+                                      int>::type* = 0 )
+{
+    Impl::ScopedProfileRegion region( "Cabana::migrate" );
+
     // Check that src and dst are the right size.
     if ( src.size() != distributor.exportSize() )
         throw std::runtime_error( "Source is the wrong size for migration!" );
@@ -339,7 +1135,7 @@ void migrate( const Distributor_t& distributor, const AoSoA_t& src,
             "Destination is the wrong size for migration!" );
 
     // Move the data.
-    Impl::distributeData( distributor, src, dst );
+    Impl::distributeFusedMembers<M0, M...>( distributor, src, dst );
 }
 
 //---------------------------------------------------------------------------//
@@ -372,6 +1168,8 @@ void migrate( const Distributor_t& distributor, AoSoA_t& aosoa,
                                         is_aosoa<AoSoA_t>::value ),
                                       int>::type* = 0 )
 {
+    Impl::ScopedProfileRegion region( "Cabana::migrate" );
+
     // Check that the AoSoA is the right size.
     if ( aosoa.size() != distributor.exportSize() )
         throw std::runtime_error( "AoSoA is the wrong size for migration!" );
@@ -387,7 +1185,9 @@ void migrate( const Distributor_t& distributor, AoSoA_t& aosoa,
         aosoa.resize( distributor.totalNumImport() );
 
     // Move the data.
-    Impl::distributeData( distributor, aosoa, aosoa );
+    Impl::distributeData( typename Distributor_t::execution_space(),
+                          distributor, aosoa, aosoa,
+                          Impl::IdentityPackTransform() );
 
     // If the destination decomposition is smaller than the source
     // decomposition resize after we have moved the data.
@@ -395,6 +1195,254 @@ void migrate( const Distributor_t& distributor, AoSoA_t& aosoa,
         aosoa.resize( distributor.totalNumImport() );
 }
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief Synchronously migrate data between two different decompositions using
+  the distributor forward communication plan, transforming each element as it
+  is packed for sending. Single AoSoA version that will resize in-place.
+
+  The transform is fused into the pack kernel so elements that must be
+  modified when they migrate, e.g. positions shifted across a periodic
+  boundary, are only touched once.
+
+  \tparam Distributor_t Distributor type - must be a distributor.
+
+  \tparam AoSoA_t AoSoA type - must be an AoSoA.
+
+  \tparam PackTransform Functor with a const operator()( const std::size_t i,
+  tuple_type& tuple ) called on the tuple of each exported element i of the
+  AoSoA before it is sent.
+
+  \param distributor The distributor to use for the migration.
+
+  \param aosoa The AoSoA containing the data to be migrated. Upon input, must
+  have the same number of elements as the inputs used to construct the
+  destributor. At output, it will be the same size as the number of import
+  elements on this rank provided by the distributor.
+
+  \param transform The transform applied to each exported element.
+*/
+template <class Distributor_t, class AoSoA_t, class PackTransform>
+void migrate( const Distributor_t& distributor, AoSoA_t& aosoa,
+              const PackTransform& transform,
+              typename std::enable_if<( is_distributor<Distributor_t>::value &&
+                                        is_aosoa<AoSoA_t>::value &&
+                                        !is_aosoa<PackTransform>::value ),
+                                      int>::type* = 0 )
+{
+    Impl::ScopedProfileRegion region( "Cabana::migrate" );
+
+    // Check that the AoSoA is the right size.
+    if ( aosoa.size() != distributor.exportSize() )
+        throw std::runtime_error( "AoSoA is the wrong size for migration!" );
+
+    // Determine if the source of destination decomposition has more data on
+    // this rank.
+    bool dst_is_bigger =
+        ( distributor.totalNumImport() > distributor.exportSize() );
+
+    // If the destination decomposition is bigger than the source
+    // decomposition resize now so we have enough space to do the operation.
+    if ( dst_is_bigger )
+        aosoa.resize( distributor.totalNumImport() );
+
+    // Move the data.
+    Impl::distributeData( typename Distributor_t::execution_space(),
+                          distributor, aosoa, aosoa,
+                          transform );
+
+    // If the destination decomposition is smaller than the source
+    // decomposition resize after we have moved the data.
+    if ( !dst_is_bigger )
+        aosoa.resize( distributor.totalNumImport() );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Synchronously migrate data between two different decompositions using
+  the distributor forward communication plan without moving the elements
+  staying on this rank. Single AoSoA version that will resize in-place.
+
+  Unlike migrate( distributor, aosoa ), which repacks every element, the
+  elements staying on this rank keep their position unless it is beyond the
+  new size of the AoSoA. The positions of departing elements are filled with
+  those staying elements first and then with the received elements. The
+  data moved is therefore proportional to the number of elements sent and
+  received rather than the number of local elements, which is much cheaper
+  when most elements stay. The order of the elements differs from that of
+  migrate( distributor, aosoa ).
+
+  \tparam Distributor_t Distributor type - must be a distributor.
+
+  \tparam AoSoA_t AoSoA type - must be an AoSoA.
+
+  \param distributor The distributor to use for the migration.
+
+  \param aosoa The AoSoA containing the data to be migrated. Upon input, must
+  have the same number of elements as the inputs used to construct the
+  destributor. At output, it will be the same size as the number of import
+  elements on this rank provided by the distributor.
+
+  \param exec_space The execution space instance on which the packing,
+  compaction, and unpacking kernels are enqueued.
+*/
+template <class ExecutionSpace, class Distributor_t, class AoSoA_t>
+void migrateInPlace(
+    const ExecutionSpace& exec_space, const Distributor_t& distributor,
+    AoSoA_t& aosoa,
+    typename std::enable_if<
+        ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+          is_distributor<Distributor_t>::value && is_aosoa<AoSoA_t>::value ),
+        int>::type* = 0 )
+{
+    Impl::ScopedProfileRegion region( "Cabana::migrate" );
+
+    // Check that the AoSoA is the right size.
+    if ( aosoa.size() != distributor.exportSize() )
+        throw std::runtime_error( "AoSoA is the wrong size for migration!" );
+
+    // Move the data.
+    Impl::distributeInPlace( exec_space, distributor, aosoa );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Synchronously migrate data in-place on the default execution space
+  instance.
+
+  \see migrateInPlace( const ExecutionSpace&, const Distributor_t&,
+  AoSoA_t& )
+*/
+template <class Distributor_t, class AoSoA_t>
+void migrateInPlace(
+    const Distributor_t& distributor, AoSoA_t& aosoa,
+    typename std::enable_if<( is_distributor<Distributor_t>::value &&
+                              is_aosoa<AoSoA_t>::value ),
+                            int>::type* = 0 )
+{
+    migrateInPlace( typename Distributor_t::execution_space(), distributor,
+                    aosoa );
+}
+
+//---------------------------------------------------------------------------//
+//! \cond Impl
+namespace Impl
+{
+// Migrate every group of a GroupedAoSoA.
+template <class ExecutionSpace, class Distributor_t, class AoSoA_t,
+          std::size_t... G>
+void migrateGroups( const ExecutionSpace& exec_space,
+                    const Distributor_t& distributor, const AoSoA_t& src,
+                    AoSoA_t& dst, std::index_sequence<G...> )
+{
+    int dummy[] = { ( migrate( exec_space, distributor,
+                               src.template group<G>(),
+                               dst.template group<G>() ),
+                      0 )... };
+    (void)dummy;
+}
+
+template <class Distributor_t, class AoSoA_t, std::size_t... G>
+void migrateGroups( const Distributor_t& distributor, AoSoA_t& aosoa,
+                    std::index_sequence<G...> )
+{
+    int dummy[] = { ( migrate( distributor, aosoa.template group<G>() ),
+                      0 )... };
+    (void)dummy;
+}
+} // end namespace Impl
+//! \endcond
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Synchronously migrate data between two different decompositions using
+  the distributor forward communication plan. GroupedAoSoA version.
+
+  Every group is migrated in turn with the same plan such that the groups
+  stay consistent.
+
+  \tparam Distributor_t Distributor type - must be a distributor.
+
+  \tparam AoSoA_t GroupedAoSoA type - must be a GroupedAoSoA.
+
+  \param exec_space The execution space instance on which the packing and
+  unpacking kernels are enqueued.
+
+  \param distributor The distributor to use for the migration.
+
+  \param src The GroupedAoSoA containing the data to be migrated. Must have
+  the same number of elements as the inputs used to construct the
+  distributor.
+
+  \param dst The GroupedAoSoA to which the migrated data will be written.
+  Must be the same size as the number of imports given by the distributor on
+  this rank.
+*/
+template <class ExecutionSpace, class Distributor_t, class AoSoA_t>
+void migrate( const ExecutionSpace& exec_space,
+              const Distributor_t& distributor, const AoSoA_t& src,
+              AoSoA_t& dst,
+              typename std::enable_if<
+                  ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+                    is_distributor<Distributor_t>::value &&
+                    is_grouped_aosoa<AoSoA_t>::value ),
+                  int>::type* = 0 )
+{
+    Impl::ScopedProfileRegion region( "Cabana::migrate" );
+    Impl::migrateGroups(
+        exec_space, distributor, src, dst,
+        std::make_index_sequence<AoSoA_t::number_of_groups>() );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Synchronously migrate data between two different decompositions using
+  the distributor forward communication plan on the default execution space
+  instance. Multiple GroupedAoSoA version.
+
+  \see migrate( const ExecutionSpace&, const Distributor_t&, const AoSoA_t&,
+  AoSoA_t& )
+*/
+template <class Distributor_t, class AoSoA_t>
+void migrate( const Distributor_t& distributor, const AoSoA_t& src,
+              AoSoA_t& dst,
+              typename std::enable_if<( is_distributor<Distributor_t>::value &&
+                                        is_grouped_aosoa<AoSoA_t>::value ),
+                                      int>::type* = 0 )
+{
+    migrate( typename Distributor_t::execution_space(), distributor, src,
+             dst );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Synchronously migrate data between two different decompositions using
+  the distributor forward communication plan. Single GroupedAoSoA version
+  that will resize all groups in-place.
+
+  \tparam Distributor_t Distributor type - must be a distributor.
+
+  \tparam AoSoA_t GroupedAoSoA type - must be a GroupedAoSoA.
+
+  \param distributor The distributor to use for the migration.
+
+  \param aosoa The GroupedAoSoA containing the data to be migrated. Upon
+  input, must have the same number of elements as the inputs used to
+  construct the distributor. At output, it will be the same size as the
+  number of import elements on this rank provided by the distributor.
+*/
+template <class Distributor_t, class AoSoA_t>
+void migrate( const Distributor_t& distributor, AoSoA_t& aosoa,
+              typename std::enable_if<( is_distributor<Distributor_t>::value &&
+                                        is_grouped_aosoa<AoSoA_t>::value ),
+                                      int>::type* = 0 )
+{
+    Impl::ScopedProfileRegion region( "Cabana::migrate" );
+    Impl::migrateGroups(
+        distributor, aosoa,
+        std::make_index_sequence<AoSoA_t::number_of_groups>() );
+}
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Synchronously migrate data between two different decompositions using
@@ -417,14 +1465,22 @@ void migrate( const Distributor_t& distributor, AoSoA_t& aosoa,
   \param dst The slice to which the migrated data will be written. Must be the
   same size as the number of imports given by the distributor on this
   rank. Call totalNumImport() on the distributor to get this size value.
+
+  \param exec_space The execution space instance on which the packing and
+  unpacking kernels are enqueued.
 */
-template <class Distributor_t, class Slice_t>
-void migrate( const Distributor_t& distributor, const Slice_t& src,
+template <class ExecutionSpace, class Distributor_t, class Slice_t>
+void migrate( const ExecutionSpace& exec_space,
+              const Distributor_t& distributor, const Slice_t& src,
               Slice_t& dst,
-              typename std::enable_if<( is_distributor<Distributor_t>::value &&
-                                        is_slice<Slice_t>::value ),
-                                      int>::type* = 0 )
+              typename std::enable_if<
+                  ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+                    is_distributor<Distributor_t>::value &&
+                    is_slice<Slice_t>::value ),
+                  int>::type* = 0 )
 {
+    Impl::ScopedProfileRegion region( "Cabana::migrate" );
+
     // Check that src and dst are the right size.
     if ( src.size() != distributor.exportSize() )
         throw std::runtime_error( "Source is the wrong size for migration!" );
@@ -494,89 +1550,170 @@ void migrate( const Distributor_t& distributor, const Slice_t& src,
                 send_buffer( i - num_stay, n ) =
                     src_data[src_offset + n * Slice_t::vector_length];
     };
-    Kokkos::RangePolicy<typename Distributor_t::execution_space>
-        build_send_buffer_policy( 0, distributor.totalNumExport() );
+    Kokkos::RangePolicy<ExecutionSpace> build_send_buffer_policy(
+        exec_space, 0, distributor.totalNumExport() );
     Kokkos::parallel_for( "Cabana::migrate::build_send_buffer",
                           build_send_buffer_policy, build_send_buffer_func );
-    Kokkos::fence();
+    exec_space.fence();
+
+    // Stage the messages through the host if needed.
+    const std::size_t element_bytes =
+        num_comp * sizeof( typename Slice_t::value_type );
+    auto staging = Impl::createDistributorStaging(
+        distributor, send_buffer.data(), num_send * element_bytes,
+        recv_buffer.data(), distributor.totalNumImport() * element_bytes );
+    Impl::recordCommOperation( distributor, true, element_bytes );
+
+    // Extract the data from the receive buffer into the destination Slice.
+    // The source data has been completely packed so this is safe to do for
+    // each neighbor as their data arrives, even for in-place migration.
+    auto extract_recv_buffer_func = KOKKOS_LAMBDA( const std::size_t i )
+    {
+        auto s = Slice_t::index_type::s( i );
+        auto a = Slice_t::index_type::a( i );
+        std::size_t dst_offset = s * dst.stride( 0 ) + a;
+        for ( std::size_t n = 0; n < num_comp; ++n )
+            dst_data[dst_offset + n * Slice_t::vector_length] =
+                recv_buffer( i, n );
+    };
+
+    // Exchange with a single neighborhood collective or through node shared
+    // memory if requested.
+    if ( CommBackend::PointToPoint != distributor.backend() )
+    {
+        Impl::exchangeCollective( distributor, staging, element_bytes, false );
+        Kokkos::RangePolicy<ExecutionSpace> extract_recv_buffer_policy(
+            exec_space, 0, distributor.totalNumImport() );
+        Kokkos::parallel_for( "Cabana::migrate::extract_recv_buffer",
+                              extract_recv_buffer_policy,
+                              extract_recv_buffer_func );
+        exec_space.fence();
+        Impl::CommWait barrier_wait( "Cabana::migrate::wait",
+                                     distributor.statistics().get() );
+        MPI_Barrier( distributor.comm() );
+        barrier_wait.stop();
+        return;
+    }
+
+    char* send_data = staging.sendData();
+    char* recv_data = staging.recvData();
 
     // The distributor has its own communication space so choose any tag.
     const int mpi_tag = 1234;
 
     // Post non-blocking receives.
-    std::vector<MPI_Request> requests;
-    requests.reserve( num_n );
-    std::pair<std::size_t, std::size_t> recv_range = { 0, 0 };
+    std::vector<MPI_Request> recv_requests;
+    std::vector<int> recv_neighbors;
+    std::vector<std::size_t> recv_offsets( num_n, 0 );
+    recv_requests.reserve( num_n );
+    recv_neighbors.reserve( num_n );
     for ( int n = 0; n < num_n; ++n )
     {
-        recv_range.second = recv_range.first + distributor.numImport( n );
+        if ( n > 0 )
+            recv_offsets[n] =
+                recv_offsets[n - 1] + distributor.numImport( n - 1 );
 
         if ( ( distributor.numImport( n ) > 0 ) &&
              ( distributor.neighborRank( n ) != my_rank ) )
         {
-            auto recv_subview =
-                Kokkos::subview( recv_buffer, recv_range, Kokkos::ALL );
+            recv_requests.push_back( MPI_Request() );
+            recv_neighbors.push_back( n );
 
-            requests.push_back( MPI_Request() );
-
-            MPI_Irecv( recv_subview.data(),
-                       recv_subview.size() *
-                           sizeof( typename Slice_t::value_type ),
+            MPI_Irecv( recv_data + recv_offsets[n] * element_bytes,
+                       distributor.numImport( n ) * element_bytes,
                        MPI_BYTE, distributor.neighborRank( n ), mpi_tag,
-                       distributor.comm(), &( requests.back() ) );
+                       distributor.comm(), &( recv_requests.back() ) );
         }
-
-        recv_range.first = recv_range.second;
     }
 
-    // Do blocking sends.
-    std::pair<std::size_t, std::size_t> send_range = { 0, 0 };
+    // Post non-blocking sends.
+    std::vector<MPI_Request> send_requests;
+    send_requests.reserve( num_n );
+    std::size_t send_offset = 0;
     for ( int n = 0; n < num_n; ++n )
     {
         if ( ( distributor.numExport( n ) > 0 ) &&
              ( distributor.neighborRank( n ) != my_rank ) )
         {
-            send_range.second = send_range.first + distributor.numExport( n );
-
-            auto send_subview =
-                Kokkos::subview( send_buffer, send_range, Kokkos::ALL );
+            send_requests.push_back( MPI_Request() );
 
-            MPI_Send( send_subview.data(),
-                      send_subview.size() *
-                          sizeof( typename Slice_t::value_type ),
-                      MPI_BYTE, distributor.neighborRank( n ), mpi_tag,
-                      distributor.comm() );
+            MPI_Isend( send_data + send_offset * element_bytes,
+                       distributor.numExport( n ) * element_bytes,
+                       MPI_BYTE, distributor.neighborRank( n ), mpi_tag,
+                       distributor.comm(), &( send_requests.back() ) );
 
-            send_range.first = send_range.second;
+            send_offset += distributor.numExport( n );
         }
     }
 
-    // Wait on non-blocking receives.
-    std::vector<MPI_Status> status( requests.size() );
-    const int ec =
-        MPI_Waitall( requests.size(), requests.data(), status.data() );
-    if ( MPI_SUCCESS != ec )
-        throw std::logic_error( "Failed MPI Communication" );
+    // Extract the data staying on this rank while the messages are in
+    // flight.
+    Kokkos::RangePolicy<ExecutionSpace> extract_stay_policy(
+        exec_space, 0, num_stay );
+    Kokkos::parallel_for( "Cabana::migrate::extract_recv_buffer",
+                          extract_stay_policy, extract_recv_buffer_func );
 
-    // Extract the data from the receive buffer into the destination Slice.
-    auto extract_recv_buffer_func = KOKKOS_LAMBDA( const std::size_t i )
+    // Extract the data from each neighbor as it arrives.
+    for ( std::size_t r = 0; r < recv_requests.size(); ++r )
     {
-        auto s = Slice_t::index_type::s( i );
-        auto a = Slice_t::index_type::a( i );
-        std::size_t dst_offset = s * dst.stride( 0 ) + a;
-        for ( std::size_t n = 0; n < num_comp; ++n )
-            dst_data[dst_offset + n * Slice_t::vector_length] =
-                recv_buffer( i, n );
-    };
-    Kokkos::RangePolicy<typename Distributor_t::execution_space>
-        extract_recv_buffer_policy( 0, distributor.totalNumImport() );
-    Kokkos::parallel_for( "Cabana::migrate::extract_recv_buffer",
-                          extract_recv_buffer_policy,
-                          extract_recv_buffer_func );
-    Kokkos::fence();
+        int unpack_index = -1;
+        MPI_Status status;
+        Impl::CommWait comm_wait( "Cabana::migrate::wait",
+                                  distributor.statistics().get() );
+        const int ec = MPI_Waitany( recv_requests.size(),
+                                    recv_requests.data(), &unpack_index,
+                                    &status );
+        comm_wait.stop();
+        if ( MPI_SUCCESS != ec )
+            throw std::logic_error( "Failed MPI Communication" );
+
+        int n = recv_neighbors[unpack_index];
+        staging.finishRecv( recv_offsets[n] * element_bytes,
+                            distributor.numImport( n ) * element_bytes );
+        Kokkos::RangePolicy<ExecutionSpace> extract_recv_buffer_policy(
+            exec_space, recv_offsets[n],
+            recv_offsets[n] + distributor.numImport( n ) );
+        Kokkos::parallel_for( "Cabana::migrate::extract_recv_buffer",
+                              extract_recv_buffer_policy,
+                              extract_recv_buffer_func );
+    }
+    exec_space.fence();
+
+    // Wait on non-blocking sends.
+    std::vector<MPI_Status> send_status( send_requests.size() );
+    Impl::CommWait comm_wait( "Cabana::migrate::wait",
+                              distributor.statistics().get() );
+    const int ec = MPI_Waitall( send_requests.size(), send_requests.data(),
+                                send_status.data() );
+    comm_wait.stop();
+    if ( MPI_SUCCESS != ec )
+        throw std::logic_error( "Failed MPI Communication" );
 
     // Barrier before completing to ensure synchronization.
+    Impl::CommWait barrier_wait( "Cabana::migrate::wait",
+                                 distributor.statistics().get() );
     MPI_Barrier( distributor.comm() );
+    barrier_wait.stop();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Synchronously migrate data between two different decompositions using
+  the distributor forward communication plan on the default execution space
+  instance. Slice version.
+
+  \see migrate( const ExecutionSpace&, const Distributor_t&, const Slice_t&,
+  Slice_t& )
+*/
+template <class Distributor_t, class Slice_t>
+void migrate( const Distributor_t& distributor, const Slice_t& src,
+              Slice_t& dst,
+              typename std::enable_if<( is_distributor<Distributor_t>::value &&
+                                        is_slice<Slice_t>::value ),
+                                      int>::type* = 0 )
+{
+    migrate( typename Distributor_t::execution_space(), distributor, src,
+             dst );
 }
 
 //---------------------------------------------------------------------------//
@@ -17,9 +17,12 @@
 #define CABANA_EXECUTIONPOLICY_HPP
 
 #include <impl/Cabana_Index.hpp>
+#include <impl/Cabana_PerformanceTraits.hpp>
 
 #include <Kokkos_Core.hpp>
 
+#include <stdexcept>
+#include <string>
 #include <type_traits>
 
 namespace Cabana
@@ -156,6 +159,98 @@ class SimdPolicy
     index_type _array_end;
 };
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief Get the preferred vector length for an execution space at runtime.
+
+  For host execution spaces this is detected from the running CPU. For device
+  execution spaces this is the compile-time default for the space.
+
+  \tparam ExecutionSpace The execution space.
+*/
+template <class ExecutionSpace>
+int preferredVectorLength()
+{
+    constexpr int default_length =
+        Impl::PerformanceTraits<ExecutionSpace>::vector_length;
+    return std::is_same<typename ExecutionSpace::memory_space,
+                        Kokkos::HostSpace>::value
+               ? Impl::hostVectorLength( default_length )
+               : default_length;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief A compile-time list of vector lengths to instantiate kernels for.
+*/
+template <int... VectorLengths>
+struct VectorLengthList
+{
+};
+
+//---------------------------------------------------------------------------//
+//! \cond Impl
+namespace Impl
+{
+template <class FunctorType>
+void dispatchVectorLength( const int vector_length, const FunctorType&,
+                           VectorLengthList<> )
+{
+    throw std::runtime_error( "Vector length " +
+                              std::to_string( vector_length ) +
+                              " is not in the instantiated list" );
+}
+
+template <class FunctorType, int VectorLength, int... VectorLengths>
+void dispatchVectorLength(
+    const int vector_length, const FunctorType& functor,
+    VectorLengthList<VectorLength, VectorLengths...> )
+{
+    if ( vector_length == VectorLength )
+        functor( std::integral_constant<int, VectorLength>() );
+    else
+        dispatchVectorLength( vector_length, functor,
+                              VectorLengthList<VectorLengths...>() );
+}
+} // end namespace Impl
+//! \endcond
+
+/*!
+  \brief Call a functor with the compile-time vector length matching a
+  runtime vector length.
+
+  Kernels are instantiated for every vector length in the list and only the
+  matching instantiation runs. The functor is called with a
+  std::integral_constant<int, VectorLength> and is typically a class with a
+  templated call operator which creates an AoSoA and a SimdPolicy with the
+  given vector length and launches simd_parallel_for:
+
+  \code
+  struct Kernel {
+  template <class VectorLength>
+  void operator()( VectorLength ) const {
+  run<VectorLength::value>(); }
+  };
+  dispatchVectorLength( preferredVectorLength<ExecutionSpace>(),
+  VectorLengthList<4, 8, 16, 32>(), Kernel() );
+  \endcode
+
+  \param vector_length The runtime vector length.
+
+  \param list The vector lengths to instantiate.
+
+  \param functor The functor to call.
+
+  An exception is thrown if the vector length is not in the list.
+*/
+template <int... VectorLengths, class FunctorType>
+void dispatchVectorLength( const int vector_length,
+                           VectorLengthList<VectorLengths...> list,
+                           const FunctorType& functor )
+{
+    Impl::dispatchVectorLength( vector_length, functor, list );
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Cabana
@@ -24,6 +24,7 @@
 #include <Kokkos_Core.hpp>
 
 #include <cassert>
+#include <cmath>
 
 namespace Cabana
 {
@@ -69,6 +70,386 @@ auto makePredicates(
     return Impl::SubsliceAndRadius<stdcxx20::remove_cvref_t<Slice>>{
         std::forward<Slice>( slice ), first, last, radius };
 }
+
+template <typename Slice, typename RadiusSlice>
+struct SubsliceAndRadii
+{
+    using slice_type = Slice;
+    using memory_space = typename Slice::memory_space;
+    Slice slice;
+    using size_type = typename Slice::size_type;
+    size_type first;
+    size_type last;
+    RadiusSlice radii;
+};
+
+template <typename Slice, typename RadiusSlice,
+          typename = std::enable_if_t<
+              Cabana::is_slice<std::remove_reference_t<Slice>>::value &&
+              Cabana::is_slice<RadiusSlice>::value>>
+auto makePredicates(
+    Slice&& slice, typename stdcxx20::remove_cvref_t<Slice>::size_type first,
+    typename stdcxx20::remove_cvref_t<Slice>::size_type last,
+    RadiusSlice const& radii )
+{
+    return Impl::SubsliceAndRadii<stdcxx20::remove_cvref_t<Slice>,
+                                  RadiusSlice>{ std::forward<Slice>( slice ),
+                                                first, last, radii };
+}
+//! \endcond
+} // namespace Impl
+
+//---------------------------------------------------------------------------//
+// Contact shapes
+//---------------------------------------------------------------------------//
+//! \cond Impl
+namespace Impl
+{
+// Axis-aligned box from double precision corners.
+KOKKOS_INLINE_FUNCTION
+ArborX::Box makeBox( const double lo[3], const double hi[3] )
+{
+    return ArborX::Box{ ArborX::Point{ static_cast<float>( lo[0] ),
+                                       static_cast<float>( lo[1] ),
+                                       static_cast<float>( lo[2] ) },
+                        ArborX::Point{ static_cast<float>( hi[0] ),
+                                       static_cast<float>( hi[1] ),
+                                       static_cast<float>( hi[2] ) } };
+}
+
+KOKKOS_INLINE_FUNCTION
+double clampUnit( const double v )
+{
+    return ( v < 0.0 ) ? 0.0 : ( v > 1.0 ) ? 1.0 : v;
+}
+
+KOKKOS_INLINE_FUNCTION
+double dot3( const double a[3], const double b[3] )
+{
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+// Squared distance between the segments p1 + s * d1 and p2 + t * d2 with s
+// and t in [0,1].
+KOKKOS_INLINE_FUNCTION
+double segmentDistanceSquared( const double p1[3], const double d1[3],
+                               const double p2[3], const double d2[3] )
+{
+    double r[3] = { p1[0] - p2[0], p1[1] - p2[1], p1[2] - p2[2] };
+    double a = dot3( d1, d1 );
+    double e = dot3( d2, d2 );
+    double f = dot3( d2, r );
+    double s = 0.0;
+    double t = 0.0;
+    if ( a > 0.0 && e > 0.0 )
+    {
+        double b = dot3( d1, d2 );
+        double c = dot3( d1, r );
+        double denom = a * e - b * b;
+        s = ( denom > 0.0 ) ? clampUnit( ( b * f - c * e ) / denom ) : 0.0;
+        t = ( b * s + f ) / e;
+        if ( t < 0.0 )
+        {
+            t = 0.0;
+            s = clampUnit( -c / a );
+        }
+        else if ( t > 1.0 )
+        {
+            t = 1.0;
+            s = clampUnit( ( b - c ) / a );
+        }
+    }
+    else if ( a > 0.0 )
+    {
+        s = clampUnit( -dot3( d1, r ) / a );
+    }
+    else if ( e > 0.0 )
+    {
+        t = clampUnit( f / e );
+    }
+    double dist_sqr = 0.0;
+    for ( int d = 0; d < 3; ++d )
+    {
+        double dx = r[d] + s * d1[d] - t * d2[d];
+        dist_sqr += dx * dx;
+    }
+    return dist_sqr;
+}
+} // namespace Impl
+//! \endcond
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Spheres with per-particle radii for contact detection.
+
+  Two spheres are in contact if the distance between their centers is at
+  most the sum of their radii.
+*/
+template <typename PositionSlice, typename RadiusSlice>
+struct SphereShapes
+{
+    //! Kokkos memory space.
+    using memory_space = typename PositionSlice::memory_space;
+    //! Size type.
+    using size_type = typename PositionSlice::size_type;
+    //! Sphere centers.
+    PositionSlice positions;
+    //! Sphere radii.
+    RadiusSlice radii;
+
+    //! Get the number of shapes.
+    KOKKOS_FUNCTION size_type size() const { return positions.size(); }
+
+    //! Get the bounding box of a shape.
+    KOKKOS_FUNCTION ArborX::Box bounds( const size_type i ) const
+    {
+        double lo[3];
+        double hi[3];
+        for ( int d = 0; d < 3; ++d )
+        {
+            lo[d] = positions( i, d ) - radii( i );
+            hi[d] = positions( i, d ) + radii( i );
+        }
+        return Impl::makeBox( lo, hi );
+    }
+
+    //! Determine if two shapes are in contact.
+    KOKKOS_FUNCTION bool contact( const size_type i, const size_type j ) const
+    {
+        double dist_sqr = 0.0;
+        for ( int d = 0; d < 3; ++d )
+        {
+            double dx = positions( i, d ) - positions( j, d );
+            dist_sqr += dx * dx;
+        }
+        double r = radii( i ) + radii( j );
+        return dist_sqr <= r * r;
+    }
+};
+
+//! Create spheres from the center and radius slices.
+template <typename PositionSlice, typename RadiusSlice>
+SphereShapes<PositionSlice, RadiusSlice>
+makeSphereShapes( const PositionSlice& positions, const RadiusSlice& radii )
+{
+    return { positions, radii };
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Capsules with per-particle axes and radii for contact detection.
+
+  A capsule is the set of points within its radius of the segment from
+  center - axis to center + axis, where the axis is half of the segment.
+  Two capsules are in contact if the distance between their segments is at
+  most the sum of their radii. A capsule with a zero axis is a sphere.
+*/
+template <typename PositionSlice, typename AxisSlice, typename RadiusSlice>
+struct CapsuleShapes
+{
+    //! Kokkos memory space.
+    using memory_space = typename PositionSlice::memory_space;
+    //! Size type.
+    using size_type = typename PositionSlice::size_type;
+    //! Capsule centers.
+    PositionSlice positions;
+    //! Capsule half segments.
+    AxisSlice axes;
+    //! Capsule radii.
+    RadiusSlice radii;
+
+    //! Get the number of shapes.
+    KOKKOS_FUNCTION size_type size() const { return positions.size(); }
+
+    //! Get the bounding box of a shape.
+    KOKKOS_FUNCTION ArborX::Box bounds( const size_type i ) const
+    {
+        double lo[3];
+        double hi[3];
+        for ( int d = 0; d < 3; ++d )
+        {
+            double a = fabs( axes( i, d ) );
+            lo[d] = positions( i, d ) - a - radii( i );
+            hi[d] = positions( i, d ) + a + radii( i );
+        }
+        return Impl::makeBox( lo, hi );
+    }
+
+    //! Determine if two shapes are in contact.
+    KOKKOS_FUNCTION bool contact( const size_type i, const size_type j ) const
+    {
+        double pi[3];
+        double di[3];
+        double pj[3];
+        double dj[3];
+        for ( int d = 0; d < 3; ++d )
+        {
+            pi[d] = positions( i, d ) - axes( i, d );
+            di[d] = 2.0 * axes( i, d );
+            pj[d] = positions( j, d ) - axes( j, d );
+            dj[d] = 2.0 * axes( j, d );
+        }
+        double r = radii( i ) + radii( j );
+        return Impl::segmentDistanceSquared( pi, di, pj, dj ) <= r * r;
+    }
+};
+
+//! Create capsules from the center, half segment, and radius slices.
+template <typename PositionSlice, typename AxisSlice, typename RadiusSlice>
+CapsuleShapes<PositionSlice, AxisSlice, RadiusSlice>
+makeCapsuleShapes( const PositionSlice& positions, const AxisSlice& axes,
+                   const RadiusSlice& radii )
+{
+    return { positions, axes, radii };
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Oriented boxes for contact detection.
+
+  A box has a center, half extents along its own axes, and an orientation
+  whose row d, orientations(i,d,:), is the unit vector of box axis d in the
+  global frame. Two boxes are in contact if no separating axis exists among
+  the 15 candidate axes of the boxes.
+*/
+template <typename PositionSlice, typename ExtentSlice,
+          typename OrientationSlice>
+struct BoxShapes
+{
+    //! Kokkos memory space.
+    using memory_space = typename PositionSlice::memory_space;
+    //! Size type.
+    using size_type = typename PositionSlice::size_type;
+    //! Box centers.
+    PositionSlice positions;
+    //! Box half extents along the box axes.
+    ExtentSlice half_extents;
+    //! Box axes as rows.
+    OrientationSlice orientations;
+
+    //! Get the number of shapes.
+    KOKKOS_FUNCTION size_type size() const { return positions.size(); }
+
+    //! Get the bounding box of a shape.
+    KOKKOS_FUNCTION ArborX::Box bounds( const size_type i ) const
+    {
+        double lo[3];
+        double hi[3];
+        for ( int k = 0; k < 3; ++k )
+        {
+            double extent = 0.0;
+            for ( int d = 0; d < 3; ++d )
+                extent += fabs( orientations( i, d, k ) ) *
+                          half_extents( i, d );
+            lo[k] = positions( i, k ) - extent;
+            hi[k] = positions( i, k ) + extent;
+        }
+        return Impl::makeBox( lo, hi );
+    }
+
+    //! Determine if two shapes are in contact.
+    KOKKOS_FUNCTION bool contact( const size_type i, const size_type j ) const
+    {
+        // Rotation of box j in the frame of box i and the center distance
+        // in the frame of box i. The rotation magnitudes are padded against
+        // parallel edges.
+        double r[3][3];
+        double abs_r[3][3];
+        double t[3];
+        for ( int a = 0; a < 3; ++a )
+        {
+            t[a] = 0.0;
+            for ( int k = 0; k < 3; ++k )
+                t[a] += ( positions( j, k ) - positions( i, k ) ) *
+                        orientations( i, a, k );
+            for ( int b = 0; b < 3; ++b )
+            {
+                r[a][b] = 0.0;
+                for ( int k = 0; k < 3; ++k )
+                    r[a][b] +=
+                        orientations( i, a, k ) * orientations( j, b, k );
+                abs_r[a][b] = fabs( r[a][b] ) + 1.0e-12;
+            }
+        }
+
+        // Axes of box i.
+        for ( int a = 0; a < 3; ++a )
+        {
+            double rj = 0.0;
+            for ( int b = 0; b < 3; ++b )
+                rj += half_extents( j, b ) * abs_r[a][b];
+            if ( fabs( t[a] ) > half_extents( i, a ) + rj )
+                return false;
+        }
+
+        // Axes of box j.
+        for ( int b = 0; b < 3; ++b )
+        {
+            double ri = 0.0;
+            double tb = 0.0;
+            for ( int a = 0; a < 3; ++a )
+            {
+                ri += half_extents( i, a ) * abs_r[a][b];
+                tb += t[a] * r[a][b];
+            }
+            if ( fabs( tb ) > ri + half_extents( j, b ) )
+                return false;
+        }
+
+        // Cross products of the axes of both boxes.
+        for ( int a = 0; a < 3; ++a )
+        {
+            int a1 = ( a + 1 ) % 3;
+            int a2 = ( a + 2 ) % 3;
+            for ( int b = 0; b < 3; ++b )
+            {
+                int b1 = ( b + 1 ) % 3;
+                int b2 = ( b + 2 ) % 3;
+                double ri = half_extents( i, a1 ) * abs_r[a2][b] +
+                            half_extents( i, a2 ) * abs_r[a1][b];
+                double rj = half_extents( j, b1 ) * abs_r[a][b2] +
+                            half_extents( j, b2 ) * abs_r[a][b1];
+                if ( fabs( t[a2] * r[a1][b] - t[a1] * r[a2][b] ) > ri + rj )
+                    return false;
+            }
+        }
+        return true;
+    }
+};
+
+//! Create oriented boxes from the center, half extent, and orientation
+//! slices.
+template <typename PositionSlice, typename ExtentSlice,
+          typename OrientationSlice>
+BoxShapes<PositionSlice, ExtentSlice, OrientationSlice>
+makeBoxShapes( const PositionSlice& positions, const ExtentSlice& half_extents,
+               const OrientationSlice& orientations )
+{
+    return { positions, half_extents, orientations };
+}
+
+//! \cond Impl
+namespace Impl
+{
+// Bounding boxes of all shapes as tree primitives.
+template <typename Shapes>
+struct ShapeBounds
+{
+    using memory_space = typename Shapes::memory_space;
+    using size_type = typename Shapes::size_type;
+    Shapes shapes;
+};
+
+// Bounding boxes of a range of shapes as intersection queries.
+template <typename Shapes>
+struct ShapeQueries
+{
+    using memory_space = typename Shapes::memory_space;
+    using size_type = typename Shapes::size_type;
+    Shapes shapes;
+    size_type first;
+    size_type last;
+};
 //! \endcond
 } // namespace Impl
 } // namespace Experimental
@@ -118,6 +499,80 @@ struct AccessTraits<SliceLike, PredicatesTag>
         return attach( intersects( Sphere{ point, x.radius } ), (int)i );
     }
 };
+//! Neighbor access trait for per-particle radii.
+template <typename Slice, typename RadiusSlice>
+struct AccessTraits<
+    Cabana::Experimental::Impl::SubsliceAndRadii<Slice, RadiusSlice>,
+    PredicatesTag>
+{
+    //! Predicates type.
+    using predicates_type =
+        Cabana::Experimental::Impl::SubsliceAndRadii<Slice, RadiusSlice>;
+    //! Kokkos memory space.
+    using memory_space = typename Slice::memory_space;
+    //! Size type.
+    using size_type = typename Slice::size_type;
+    //! Get number of particles.
+    static KOKKOS_FUNCTION size_type size( predicates_type const& x )
+    {
+        return x.last - x.first;
+    }
+    //! Get the particle at the index with its own radius.
+    static KOKKOS_FUNCTION auto get( predicates_type const& x, size_type i )
+    {
+        assert( i < size( x ) );
+        auto const point =
+            AccessTraits<Slice, PrimitivesTag>::get( x.slice, x.first + i );
+        auto const radius = static_cast<float>( x.radii( x.first + i ) );
+        return attach( intersects( Sphere{ point, radius } ), (int)i );
+    }
+};
+//! Primitive access trait for contact shape bounding boxes.
+template <typename Shapes>
+struct AccessTraits<Cabana::Experimental::Impl::ShapeBounds<Shapes>,
+                    PrimitivesTag>
+{
+    //! Primitives type.
+    using primitives_type = Cabana::Experimental::Impl::ShapeBounds<Shapes>;
+    //! Kokkos memory space.
+    using memory_space = typename Shapes::memory_space;
+    //! Size type.
+    using size_type = typename Shapes::size_type;
+    //! Get number of shapes.
+    static KOKKOS_FUNCTION size_type size( primitives_type const& x )
+    {
+        return x.shapes.size();
+    }
+    //! Get the bounding box of the shape at the index.
+    static KOKKOS_FUNCTION Box get( primitives_type const& x, size_type i )
+    {
+        return x.shapes.bounds( i );
+    }
+};
+//! Predicate access trait for contact shape bounding boxes.
+template <typename Shapes>
+struct AccessTraits<Cabana::Experimental::Impl::ShapeQueries<Shapes>,
+                    PredicatesTag>
+{
+    //! Predicates type.
+    using predicates_type = Cabana::Experimental::Impl::ShapeQueries<Shapes>;
+    //! Kokkos memory space.
+    using memory_space = typename Shapes::memory_space;
+    //! Size type.
+    using size_type = typename Shapes::size_type;
+    //! Get number of shapes.
+    static KOKKOS_FUNCTION size_type size( predicates_type const& x )
+    {
+        return x.last - x.first;
+    }
+    //! Get the intersection query with the bounding box of the shape at the
+    //! index.
+    static KOKKOS_FUNCTION auto get( predicates_type const& x, size_type i )
+    {
+        assert( i < size( x ) );
+        return attach( intersects( x.shapes.bounds( x.first + i ) ), (int)i );
+    }
+};
 } // namespace ArborX
 
 namespace Cabana
@@ -146,17 +601,32 @@ struct CollisionFilter<HalfNeighborTag>
     KOKKOS_FUNCTION static bool keep( int i, int j ) noexcept { return i > j; }
 };
 
+// Keep the candidate pairs of a query whose shapes are in contact. The
+// predicate index is relative to the first queried particle.
+template <typename Shapes, typename Tag>
+struct ContactFilter
+{
+    Shapes shapes;
+    typename Shapes::size_type first;
+    KOKKOS_FUNCTION bool keep( int i, int j ) const
+    {
+        int const p = first + i;
+        return CollisionFilter<Tag>::keep( p, j ) && shapes.contact( p, j );
+    }
+};
+
 // Custom callback for ArborX::BVH::query()
-template <typename Tag>
+template <typename Tag, typename Filter = CollisionFilter<Tag>>
 struct NeighborDiscriminatorCallback
 {
+    Filter filter;
     template <typename Predicate, typename OutputFunctor>
     KOKKOS_FUNCTION void operator()( Predicate const& predicate,
                                      int primitive_index,
                                      OutputFunctor const& out ) const
     {
         int const predicate_index = getData( predicate );
-        if ( CollisionFilter<Tag>::keep( predicate_index, primitive_index ) )
+        if ( filter.keep( predicate_index, primitive_index ) )
         {
             out( primitive_index );
         }
@@ -164,16 +634,18 @@ struct NeighborDiscriminatorCallback
 };
 
 // Count in the first pass
-template <typename Counts, typename Tag>
+template <typename Counts, typename Tag,
+          typename Filter = CollisionFilter<Tag>>
 struct NeighborDiscriminatorCallback2D_FirstPass
 {
     Counts counts;
+    Filter filter;
     template <typename Predicate>
     KOKKOS_FUNCTION void operator()( Predicate const& predicate,
                                      int primitive_index ) const
     {
         int const predicate_index = getData( predicate );
-        if ( CollisionFilter<Tag>::keep( predicate_index, primitive_index ) )
+        if ( filter.keep( predicate_index, primitive_index ) )
         {
             ++counts( predicate_index ); // WARNING see below**
         }
@@ -181,18 +653,20 @@ struct NeighborDiscriminatorCallback2D_FirstPass
 };
 
 // Preallocate and attempt fill in the first pass
-template <typename Counts, typename Neighbors, typename Tag>
+template <typename Counts, typename Neighbors, typename Tag,
+          typename Filter = CollisionFilter<Tag>>
 struct NeighborDiscriminatorCallback2D_FirstPass_BufferOptimization
 {
     Counts counts;
     Neighbors neighbors;
+    Filter filter;
     template <typename Predicate>
     KOKKOS_FUNCTION void operator()( Predicate const& predicate,
                                      int primitive_index ) const
     {
         int const predicate_index = getData( predicate );
         auto& count = counts( predicate_index );
-        if ( CollisionFilter<Tag>::keep( predicate_index, primitive_index ) )
+        if ( filter.keep( predicate_index, primitive_index ) )
         {
             if ( count < (int)neighbors.extent( 1 ) )
             {
@@ -208,18 +682,20 @@ struct NeighborDiscriminatorCallback2D_FirstPass_BufferOptimization
 };
 
 // Fill in the second pass
-template <typename Counts, typename Neighbors, typename Tag>
+template <typename Counts, typename Neighbors, typename Tag,
+          typename Filter = CollisionFilter<Tag>>
 struct NeighborDiscriminatorCallback2D_SecondPass
 {
     Counts counts;
     Neighbors neighbors;
+    Filter filter;
     template <typename Predicate>
     KOKKOS_FUNCTION void operator()( Predicate const& predicate,
                                      int primitive_index ) const
     {
         int const predicate_index = getData( predicate );
         auto& count = counts( predicate_index );
-        if ( CollisionFilter<Tag>::keep( predicate_index, primitive_index ) )
+        if ( filter.keep( predicate_index, primitive_index ) )
         {
             assert( count < (int)neighbors.extent( 1 ) );
             neighbors( predicate_index, count++ ) =
@@ -228,6 +704,40 @@ struct NeighborDiscriminatorCallback2D_SecondPass
     }
 };
 
+// Filter the candidates of a stale tree by their current distance and
+// attempt to fill the preallocated buffer.
+template <typename Slice, typename Counts, typename Neighbors, typename Tag>
+struct NeighborDiscriminatorCallback2D_Distance
+{
+    Slice positions;
+    typename Slice::size_type first;
+    typename Slice::value_type rsqr;
+    Counts counts;
+    Neighbors neighbors;
+    template <typename Predicate>
+    KOKKOS_FUNCTION void operator()( Predicate const& predicate,
+                                     int primitive_index ) const
+    {
+        int const predicate_index = getData( predicate );
+        if ( !CollisionFilter<Tag>::keep( predicate_index, primitive_index ) )
+            return;
+        typename Slice::value_type dist_sqr = 0.0;
+        for ( int d = 0; d < 3; ++d )
+        {
+            auto const dx = positions( first + predicate_index, d ) -
+                            positions( primitive_index, d );
+            dist_sqr += dx * dx;
+        }
+        if ( dist_sqr > rsqr )
+            return;
+        auto& count = counts( predicate_index );
+        if ( count < (int)neighbors.extent( 1 ) )
+            neighbors( predicate_index, count ) =
+                primitive_index; // WARNING see below**
+        ++count;
+    }
+};
+
 // NOTE** Taking advantage of the knowledge that one predicate is processed by a
 // single thread.  Count increment should be atomic otherwise.
 
@@ -248,6 +758,41 @@ struct CrsGraph
     typename MemorySpace::size_type total;
 };
 
+//! \cond Impl
+namespace Impl
+{
+// Query a new tree of all primitives with the given predicates into a 1D
+// compressed layout. Candidates are kept by the filter.
+template <typename DeviceType, typename Primitives, typename Predicates,
+          typename Filter, typename Tag>
+auto makeCrsNeighborList(
+    Tag, Primitives const& primitives, Predicates const& predicates,
+    Filter const& filter,
+    typename DeviceType::memory_space::size_type first, int buffer_size )
+{
+    assert( buffer_size >= 0 );
+
+    using MemorySpace = typename DeviceType::memory_space;
+    using ExecutionSpace = typename DeviceType::execution_space;
+    ExecutionSpace space{};
+
+    ArborX::BVH<MemorySpace> bvh( space, primitives );
+
+    Kokkos::View<int*, DeviceType> indices(
+        Kokkos::view_alloc( "indices", Kokkos::WithoutInitializing ), 0 );
+    Kokkos::View<int*, DeviceType> offset(
+        Kokkos::view_alloc( "offset", Kokkos::WithoutInitializing ), 0 );
+    bvh.query(
+        space, predicates,
+        NeighborDiscriminatorCallback<Tag, Filter>{ filter }, indices, offset,
+        ArborX::Experimental::TraversalPolicy().setBufferSize( buffer_size ) );
+
+    return CrsGraph<MemorySpace, Tag>{ std::move( indices ),
+                                       std::move( offset ), first, bvh.size() };
+}
+} // namespace Impl
+//! \endcond
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Neighbor list implementation using ArborX for particles within the
@@ -275,25 +820,49 @@ auto makeNeighborList( Tag, Slice const& coordinate_slice,
                        typename Slice::size_type last,
                        typename Slice::value_type radius, int buffer_size = 0 )
 {
-    assert( buffer_size >= 0 );
+    return Impl::makeCrsNeighborList<DeviceType>(
+        Tag{}, coordinate_slice,
+        Impl::makePredicates( coordinate_slice, first, last, radius ),
+        Impl::CollisionFilter<Tag>{}, first, buffer_size );
+}
 
-    using MemorySpace = typename DeviceType::memory_space;
-    using ExecutionSpace = typename DeviceType::execution_space;
-    ExecutionSpace space{};
+//---------------------------------------------------------------------------//
+/*!
+  \brief Neighbor list implementation using ArborX for particles within a
+  per-particle interaction distance with a 1D compressed layout for particles
+  and neighbors.
 
-    ArborX::BVH<MemorySpace> bvh( space, coordinate_slice );
+  \tparam Slice The position slice type.
+  \tparam RadiusSlice The radius slice type.
+  \tparam DeviceType The device type to use for building and storing the
+  neighbor list.
 
-    Kokkos::View<int*, DeviceType> indices(
-        Kokkos::view_alloc( "indices", Kokkos::WithoutInitializing ), 0 );
-    Kokkos::View<int*, DeviceType> offset(
-        Kokkos::view_alloc( "offset", Kokkos::WithoutInitializing ), 0 );
-    bvh.query(
-        space, Impl::makePredicates( coordinate_slice, first, last, radius ),
-        Impl::NeighborDiscriminatorCallback<Tag>{}, indices, offset,
-        ArborX::Experimental::TraversalPolicy().setBufferSize( buffer_size ) );
+  \param coordinate_slice The slice containing the particle positions.
+  \param first The beginning particle index to compute neighbors for.
+  \param last The end particle index to compute neighbors for.
+  \param radii The slice containing the radius of the neighborhood of each
+  particle. The neighbors of a particle are the particles within its own
+  radius, such that the list is not symmetric and only full lists are
+  supported.
+  \param buffer_size Optional guess for maximum number of neighbors.
 
-    return CrsGraph<MemorySpace, Tag>{ std::move( indices ),
-                                       std::move( offset ), first, bvh.size() };
+  Each particle is queried with a sphere of its own radius such that small
+  particles do not search the volume of the largest cutoff.
+*/
+template <typename DeviceType, typename Slice, typename RadiusSlice,
+          typename Tag>
+auto makeNeighborList(
+    Tag, Slice const& coordinate_slice, typename Slice::size_type first,
+    typename Slice::size_type last, RadiusSlice const& radii,
+    int buffer_size = 0,
+    std::enable_if_t<Cabana::is_slice<RadiusSlice>::value, int>* = 0 )
+{
+    static_assert( std::is_same<Tag, FullNeighborTag>::value,
+                   "Per-particle radii require a full neighbor list" );
+    return Impl::makeCrsNeighborList<DeviceType>(
+        Tag{}, coordinate_slice,
+        Impl::makePredicates( coordinate_slice, first, last, radii ),
+        Impl::CollisionFilter<Tag>{}, first, buffer_size );
 }
 
 //! 2d ArborX neighbor list storage layout.
@@ -310,6 +879,74 @@ struct Dense
     typename MemorySpace::size_type total;
 };
 
+//! \cond Impl
+namespace Impl
+{
+// Query a new tree of all primitives with the given predicates into a 2D
+// layout. Candidates are kept by the filter.
+template <typename DeviceType, typename Primitives, typename Predicates,
+          typename Filter, typename Tag>
+auto makeDenseNeighborList(
+    Tag, Primitives const& primitives, Predicates const& predicates,
+    Filter const& filter,
+    typename DeviceType::memory_space::size_type first, int buffer_size )
+{
+    assert( buffer_size >= 0 );
+
+    using MemorySpace = typename DeviceType::memory_space;
+    using ExecutionSpace = typename DeviceType::execution_space;
+    ExecutionSpace space{};
+
+    ArborX::BVH<MemorySpace> bvh( space, primitives );
+
+    auto const n_queries =
+        ArborX::AccessTraits<Predicates, ArborX::PredicatesTag>::size(
+            predicates );
+
+    Kokkos::View<int**, DeviceType> neighbors;
+    Kokkos::View<int*, DeviceType> counts( "counts", n_queries );
+    if ( buffer_size > 0 )
+    {
+        neighbors = Kokkos::View<int**, DeviceType>(
+            Kokkos::view_alloc( "neighbors", Kokkos::WithoutInitializing ),
+            n_queries, buffer_size );
+        bvh.query(
+            space, predicates,
+            NeighborDiscriminatorCallback2D_FirstPass_BufferOptimization<
+                decltype( counts ), decltype( neighbors ), Tag, Filter>{
+                counts, neighbors, filter } );
+    }
+    else
+    {
+        bvh.query( space, predicates,
+                   NeighborDiscriminatorCallback2D_FirstPass<
+                       decltype( counts ), Tag, Filter>{ counts, filter } );
+    }
+
+    auto const max_neighbors = ArborX::max( space, counts );
+    if ( max_neighbors <= buffer_size )
+    {
+        // NOTE We do not bother shrinking to eliminate the excess allocation.
+        // NOTE If buffer_size is 0, neighbors is default constructed.  This is
+        // fine with the current design/implementation of NeighborList access
+        // traits.
+        return Dense<MemorySpace, Tag>{ counts, neighbors, first, bvh.size() };
+    }
+
+    neighbors = Kokkos::View<int**, DeviceType>(
+        Kokkos::view_alloc( "neighbors", Kokkos::WithoutInitializing ),
+        n_queries, max_neighbors ); // realloc storage for neighbors
+    Kokkos::deep_copy( counts, 0 ); // reset counts to zero
+    bvh.query( space, predicates,
+               NeighborDiscriminatorCallback2D_SecondPass<
+                   decltype( counts ), decltype( neighbors ), Tag, Filter>{
+                   counts, neighbors, filter } );
+
+    return Dense<MemorySpace, Tag>{ counts, neighbors, first, bvh.size() };
+}
+} // namespace Impl
+//! \endcond
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Neighbor list implementation using ArborX for particles within the
@@ -339,62 +976,404 @@ auto make2DNeighborList( Tag, Slice const& coordinate_slice,
                          typename Slice::value_type radius,
                          int buffer_size = 0 )
 {
-    assert( buffer_size >= 0 );
+    return Impl::makeDenseNeighborList<DeviceType>(
+        Tag{}, coordinate_slice,
+        Impl::makePredicates( coordinate_slice, first, last, radius ),
+        Impl::CollisionFilter<Tag>{}, first, buffer_size );
+}
 
-    using MemorySpace = typename DeviceType::memory_space;
-    using ExecutionSpace = typename DeviceType::execution_space;
-    ExecutionSpace space{};
+//---------------------------------------------------------------------------//
+/*!
+  \brief Neighbor list implementation using ArborX for particles within a
+  per-particle interaction distance with a 2D layout for particles and
+  neighbors.
 
-    ArborX::BVH<MemorySpace> bvh( space, coordinate_slice );
+  \tparam Slice The position slice type.
+  \tparam RadiusSlice The radius slice type.
+  \tparam DeviceType The device type to use for building and storing the
+  neighbor list.
 
-    auto const predicates =
-        Impl::makePredicates( coordinate_slice, first, last, radius );
+  \param coordinate_slice The slice containing the particle positions.
+  \param first The beginning particle index to compute neighbors for.
+  \param last The end particle index to compute neighbors for.
+  \param radii The slice containing the radius of the neighborhood of each
+  particle. The neighbors of a particle are the particles within its own
+  radius, such that the list is not symmetric and only full lists are
+  supported.
+  \param buffer_size Optional guess for maximum number of neighbors per
+  particle.
+*/
+template <typename DeviceType, typename Slice, typename RadiusSlice,
+          typename Tag>
+auto make2DNeighborList(
+    Tag, Slice const& coordinate_slice, typename Slice::size_type first,
+    typename Slice::size_type last, RadiusSlice const& radii,
+    int buffer_size = 0,
+    std::enable_if_t<Cabana::is_slice<RadiusSlice>::value, int>* = 0 )
+{
+    static_assert( std::is_same<Tag, FullNeighborTag>::value,
+                   "Per-particle radii require a full neighbor list" );
+    return Impl::makeDenseNeighborList<DeviceType>(
+        Tag{}, coordinate_slice,
+        Impl::makePredicates( coordinate_slice, first, last, radii ),
+        Impl::CollisionFilter<Tag>{}, first, buffer_size );
+}
 
-    auto const n_queries =
-        ArborX::AccessTraits<decltype( predicates ),
-                             ArborX::PredicatesTag>::size( predicates );
+//---------------------------------------------------------------------------//
+/*!
+  \brief Contact list implementation using ArborX for particles with finite
+  shapes with a 1D compressed layout for particles and their contacts.
 
-    Kokkos::View<int**, DeviceType> neighbors;
-    Kokkos::View<int*, DeviceType> counts( "counts", n_queries );
-    if ( buffer_size > 0 )
+  \tparam DeviceType The device type to use for building and storing the
+  contact list.
+  \tparam Shapes The contact shapes type, e.g. SphereShapes, CapsuleShapes,
+  or BoxShapes.
+  \tparam AlgorithmTag Tag indicating whether to build a full or half contact
+  list.
+
+  \param shapes The shapes of all particles.
+  \param first The beginning particle index to compute contacts for.
+  \param last The end particle index to compute contacts for.
+  \param buffer_size Optional guess for maximum number of contacts.
+
+  The tree is built over the bounding boxes of the shapes and queried with
+  the bounding boxes of the particles in [first,last). Candidates are kept
+  if the shapes are in contact. The list is used with neighbor_parallel_for
+  and neighbor_parallel_reduce as any other neighbor list.
+*/
+template <typename DeviceType, typename Shapes, typename Tag>
+auto makeContactList( Tag, Shapes const& shapes,
+                      typename Shapes::size_type first,
+                      typename Shapes::size_type last, int buffer_size = 0 )
+{
+    return Impl::makeCrsNeighborList<DeviceType>(
+        Tag{}, Impl::ShapeBounds<Shapes>{ shapes },
+        Impl::ShapeQueries<Shapes>{ shapes, first, last },
+        Impl::ContactFilter<Shapes, Tag>{ shapes, first }, first,
+        buffer_size );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Contact list implementation using ArborX for particles with finite
+  shapes with a 2D layout for particles and their contacts.
+
+  \tparam DeviceType The device type to use for building and storing the
+  contact list.
+  \tparam Shapes The contact shapes type, e.g. SphereShapes, CapsuleShapes,
+  or BoxShapes.
+  \tparam AlgorithmTag Tag indicating whether to build a full or half contact
+  list.
+
+  \param shapes The shapes of all particles.
+  \param first The beginning particle index to compute contacts for.
+  \param last The end particle index to compute contacts for.
+  \param buffer_size Optional guess for maximum number of contacts per
+  particle.
+*/
+template <typename DeviceType, typename Shapes, typename Tag>
+auto make2DContactList( Tag, Shapes const& shapes,
+                        typename Shapes::size_type first,
+                        typename Shapes::size_type last, int buffer_size = 0 )
+{
+    return Impl::makeDenseNeighborList<DeviceType>(
+        Tag{}, Impl::ShapeBounds<Shapes>{ shapes },
+        Impl::ShapeQueries<Shapes>{ shapes, first, last },
+        Impl::ContactFilter<Shapes, Tag>{ shapes, first }, first,
+        buffer_size );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Persistent ArborX neighbor list with a 2D layout which keeps its tree
+  and neighbor storage between updates.
+
+  \tparam DeviceType The device type to use for building and storing the
+  neighbor list.
+  \tparam Tag Tag indicating whether to build a full or half neighbor list.
+
+  The tree is built from the positions at the last rebuild. Later updates
+  query the same tree with the radius enlarged by the largest particle
+  displacement since that rebuild and discard candidates by their current
+  distance, such that the list is exact for any displacement. The tree is
+  rebuilt once the largest displacement exceeds the skin, after a fixed
+  number of updates, or when the number of particles changes. The neighbor
+  storage is only reallocated when a particle has more neighbors than the
+  current capacity.
+
+  Neighbor list implementation most appropriate for slowly moving particles
+  with highly varying densities.
+*/
+template <typename DeviceType, typename Tag>
+class PersistentNeighborList
+{
+  public:
+    //! Kokkos memory space.
+    using memory_space = typename DeviceType::memory_space;
+    //! Kokkos execution space.
+    using execution_space = typename DeviceType::execution_space;
+    //! Neighbor storage type.
+    using list_type = Dense<memory_space, Tag>;
+
+    /*!
+      \brief Constructor.
+
+      \param radius The radius of the neighborhood. Particles within this
+      radius are considered neighbors.
+      \param skin The largest particle displacement for which the tree is
+      reused.
+      \param rebuild_interval Optional number of updates after which the tree
+      is always rebuilt. If zero the tree is only rebuilt when the skin is
+      exceeded.
+      \param buffer_size Optional guess for maximum number of neighbors per
+      particle.
+    */
+    PersistentNeighborList( Tag, const double radius, const double skin,
+                            const int rebuild_interval = 0,
+                            const int buffer_size = 0 )
+        : _radius( radius )
+        , _skin( skin )
+        , _rebuild_interval( rebuild_interval )
+        , _updates_since_build( 0 )
+        , _num_build( 0 )
+        , _num_refill( 0 )
     {
-        neighbors = Kokkos::View<int**, DeviceType>(
-            Kokkos::view_alloc( "neighbors", Kokkos::WithoutInitializing ),
-            n_queries, buffer_size );
-        bvh.query(
-            space, predicates,
-            Impl::NeighborDiscriminatorCallback2D_FirstPass_BufferOptimization<
-                decltype( counts ), decltype( neighbors ), Tag>{ counts,
-                                                                 neighbors } );
+        assert( buffer_size >= 0 );
+        assert( rebuild_interval >= 0 );
+        _list.cnt = Kokkos::View<int*, memory_space>( "counts", 0 );
+        _list.val = Kokkos::View<int**, memory_space>(
+            Kokkos::view_alloc( "neighbors", Kokkos::WithoutInitializing ), 0,
+            buffer_size );
+        _list.shift = 0;
+        _list.total = 0;
     }
-    else
+
+    /*!
+      \brief Update the neighbor list for the current particle positions.
+
+      \param coordinate_slice The slice containing the particle positions.
+      \param first The beginning particle index to compute neighbors for.
+      \param last The end particle index to compute neighbors for.
+
+      \return True if the tree was rebuilt.
+    */
+    template <class Slice>
+    bool update( Slice const& coordinate_slice,
+                 typename Slice::size_type first,
+                 typename Slice::size_type last )
     {
-        bvh.query(
-            space, predicates,
-            Impl::NeighborDiscriminatorCallback2D_FirstPass<decltype( counts ),
-                                                            Tag>{ counts } );
+        double max_disp = 0.0;
+        bool rebuild = ( _num_build == 0 ||
+                         coordinate_slice.size() != _reference.extent( 0 ) );
+        if ( !rebuild )
+        {
+            max_disp = std::sqrt( maxDisplacementSquared( coordinate_slice ) );
+            rebuild = ( max_disp > _skin ||
+                        ( _rebuild_interval > 0 &&
+                          _updates_since_build >= _rebuild_interval ) );
+        }
+
+        if ( rebuild )
+        {
+            build( coordinate_slice );
+            max_disp = 0.0;
+        }
+        else
+        {
+            ++_updates_since_build;
+        }
+
+        query( coordinate_slice, first, last, max_disp );
+        return rebuild;
     }
 
-    auto const max_neighbors = ArborX::max( space, counts );
-    if ( max_neighbors <= buffer_size )
+    /*!
+      \brief Force a rebuild of the tree and update the neighbor list.
+
+      \param coordinate_slice The slice containing the particle positions.
+      \param first The beginning particle index to compute neighbors for.
+      \param last The end particle index to compute neighbors for.
+    */
+    template <class Slice>
+    void rebuild( Slice const& coordinate_slice,
+                  typename Slice::size_type first,
+                  typename Slice::size_type last )
     {
-        // NOTE We do not bother shrinking to eliminate the excess allocation.
-        // NOTE If buffer_size is 0, neighbors is default constructed.  This is
-        // fine with the current design/implementation of NeighborList access
-        // traits.
-        return Dense<MemorySpace, Tag>{ counts, neighbors, first, bvh.size() };
+        build( coordinate_slice );
+        query( coordinate_slice, first, last, 0.0 );
     }
 
-    neighbors = Kokkos::View<int**, DeviceType>(
-        Kokkos::view_alloc( "neighbors", Kokkos::WithoutInitializing ),
-        n_queries, max_neighbors ); // realloc storage for neighbors
-    Kokkos::deep_copy( counts, 0 ); // reset counts to zero
-    bvh.query( space, predicates,
-               Impl::NeighborDiscriminatorCallback2D_SecondPass<
-                   decltype( counts ), decltype( neighbors ), Tag>{
-                   counts, neighbors } );
+    //! Get the neighbor list of the last update.
+    const list_type& list() const { return _list; }
 
-    return Dense<MemorySpace, Tag>{ counts, neighbors, first, bvh.size() };
+    //! Get the number of tree builds.
+    int numBuild() const { return _num_build; }
+
+    //! Get the number of updates in which the neighbor storage overflowed.
+    int numRefill() const { return _num_refill; }
+
+  private:
+    // Build the tree and store the reference positions.
+    template <class Slice>
+    void build( Slice const& coordinate_slice )
+    {
+        execution_space space{};
+        _bvh = ArborX::BVH<memory_space>( space, coordinate_slice );
+
+        Kokkos::realloc( _reference, coordinate_slice.size() );
+        auto reference = _reference;
+        Kokkos::parallel_for(
+            "Cabana::PersistentNeighborList::store_reference",
+            Kokkos::RangePolicy<execution_space>( 0, coordinate_slice.size() ),
+            KOKKOS_LAMBDA( const int p ) {
+                for ( int d = 0; d < 3; ++d )
+                    reference( p, d ) = coordinate_slice( p, d );
+            } );
+        Kokkos::fence();
+
+        _updates_since_build = 0;
+        ++_num_build;
+    }
+
+    // Get the largest squared displacement since the last build.
+    template <class Slice>
+    double maxDisplacementSquared( Slice const& coordinate_slice ) const
+    {
+        auto reference = _reference;
+        double max_sqr = 0.0;
+        Kokkos::parallel_reduce(
+            "Cabana::PersistentNeighborList::max_displacement",
+            Kokkos::RangePolicy<execution_space>( 0, coordinate_slice.size() ),
+            KOKKOS_LAMBDA( const int p, double& result ) {
+                double dist_sqr = 0.0;
+                for ( int d = 0; d < 3; ++d )
+                {
+                    double dx = coordinate_slice( p, d ) - reference( p, d );
+                    dist_sqr += dx * dx;
+                }
+                if ( dist_sqr > result )
+                    result = dist_sqr;
+            },
+            Kokkos::Max<double>( max_sqr ) );
+        return max_sqr;
+    }
+
+    // Query the tree with the radius enlarged by the displacement since the
+    // last build. The neighbor storage is reused when large enough.
+    template <class Slice>
+    void query( Slice const& coordinate_slice, typename Slice::size_type first,
+                typename Slice::size_type last, const double max_disp )
+    {
+        using value_type = typename Slice::value_type;
+        execution_space space{};
+
+        auto const predicates = Impl::makePredicates(
+            coordinate_slice, first, last,
+            static_cast<value_type>( _radius + max_disp ) );
+        auto const n_queries =
+            ArborX::AccessTraits<decltype( predicates ),
+                                 ArborX::PredicatesTag>::size( predicates );
+
+        if ( _list.cnt.extent( 0 ) != n_queries )
+            Kokkos::realloc( _list.cnt, n_queries );
+        if ( _list.val.extent( 0 ) < n_queries )
+            Kokkos::realloc( _list.val, n_queries, _list.val.extent( 1 ) );
+
+        using callback_type = Impl::NeighborDiscriminatorCallback2D_Distance<
+            Slice, decltype( _list.cnt ), decltype( _list.val ), Tag>;
+        auto const rsqr = static_cast<value_type>( _radius * _radius );
+
+        Kokkos::deep_copy( _list.cnt, 0 );
+        _bvh.query( space, predicates,
+                    callback_type{ coordinate_slice, first, rsqr, _list.cnt,
+                                   _list.val } );
+
+        // Grow the storage and query again if a particle has more neighbors
+        // than fit.
+        auto const max_neighbors = ArborX::max( space, _list.cnt );
+        if ( max_neighbors > (int)_list.val.extent( 1 ) )
+        {
+            Kokkos::realloc( _list.val, _list.val.extent( 0 ), max_neighbors );
+            ++_num_refill;
+            Kokkos::deep_copy( _list.cnt, 0 );
+            _bvh.query( space, predicates,
+                        callback_type{ coordinate_slice, first, rsqr,
+                                       _list.cnt, _list.val } );
+        }
+
+        _list.shift = first;
+        _list.total = _bvh.size();
+    }
+
+  private:
+    double _radius;
+    double _skin;
+    int _rebuild_interval;
+    int _updates_since_build;
+    int _num_build;
+    int _num_refill;
+    ArborX::BVH<memory_space> _bvh;
+    Kokkos::View<double* [3], memory_space> _reference;
+    list_type _list;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Get the statistics of an ArborX neighbor list with a 1D compressed
+  layout.
+*/
+template <typename MemorySpace, typename Tag>
+NeighborListStats neighborListStats( CrsGraph<MemorySpace, Tag> const& list )
+{
+    NeighborListStats stats;
+    auto row_ptr = list.row_ptr;
+    std::size_t num_row =
+        ( row_ptr.extent( 0 ) > 0 ) ? row_ptr.extent( 0 ) - 1 : 0;
+    Cabana::Impl::neighborCountStats(
+        typename MemorySpace::execution_space{}, 0, num_row,
+        KOKKOS_LAMBDA( const std::size_t i ) {
+            return static_cast<std::size_t>( row_ptr( i + 1 ) - row_ptr( i ) );
+        },
+        stats );
+    stats.memory_bytes = Cabana::Impl::viewBytes( list.col_ind ) +
+                         Cabana::Impl::viewBytes( list.row_ptr );
+    stats.num_build = 1;
+    return stats;
+}
+
+/*!
+  \brief Get the statistics of an ArborX neighbor list with a 2D layout.
+*/
+template <typename MemorySpace, typename Tag>
+NeighborListStats neighborListStats( Dense<MemorySpace, Tag> const& list )
+{
+    NeighborListStats stats;
+    auto cnt = list.cnt;
+    Cabana::Impl::neighborCountStats(
+        typename MemorySpace::execution_space{}, 0, cnt.extent( 0 ),
+        KOKKOS_LAMBDA( const std::size_t i ) {
+            return static_cast<std::size_t>( cnt( i ) );
+        },
+        stats );
+    stats.memory_bytes = Cabana::Impl::viewBytes( list.cnt ) +
+                         Cabana::Impl::viewBytes( list.val );
+    stats.num_build = 1;
+    return stats;
+}
+
+/*!
+  \brief Get the statistics of the last update of a persistent ArborX
+  neighbor list. The number of builds counts the tree builds and the number
+  of refills counts the updates in which the neighbor storage overflowed.
+*/
+template <typename DeviceType, typename Tag>
+NeighborListStats
+neighborListStats( PersistentNeighborList<DeviceType, Tag> const& list )
+{
+    auto stats = neighborListStats( list.list() );
+    stats.num_build = list.numBuild();
+    stats.num_refill = list.numRefill();
+    return stats;
 }
 
 } // namespace Experimental
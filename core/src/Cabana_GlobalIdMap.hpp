@@ -0,0 +1,320 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_GlobalIdMap.hpp
+  \brief Global id to local index map maintained across migration and halos
+*/
+#ifndef CABANA_GLOBALIDMAP_HPP
+#define CABANA_GLOBALIDMAP_HPP
+
+#include <Cabana_Distributor.hpp>
+#include <Cabana_Halo.hpp>
+#include <impl/Cabana_Profiling.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_UnorderedMap.hpp>
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace Cabana
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief Map from the global id of a particle to its local index.
+
+  \tparam MemorySpace The memory space of the map.
+  \tparam IdType The type of the global particle ids.
+
+  The map is built once from the ids of the local particles and then updated
+  incrementally from the steering information of the communication plans
+  moving the particles: an update after a migration only erases the
+  departing particles, renumbers the particles staying on this rank, and
+  inserts the arrivals, and an update after a halo gather only replaces the
+  ghosts. The ids of the particles which did not move are never read. A
+  typical redistribution step is:
+
+  \code
+  Cabana::migrate( distributor, particles );
+  id_map.update( distributor, Cabana::slice<ID>( particles ) );
+  particles.resize( halo.numLocal() + halo.numGhost() );
+  Cabana::gather( halo, particles );
+  id_map.update( halo, Cabana::slice<ID>( particles ) );
+  \endcode
+
+  Owned particles take precedence over ghosts with the same id. If a
+  particle has several ghost copies (e.g. periodic images) and is not owned,
+  one of the copies is chosen.
+
+  The map may be copied into kernels to look up local indices with find().
+
+  \note Distributor updates assume the ordering of migrate( distributor,
+  aosoa ) and migrate( distributor, src, dst ), in which the particles staying
+  on this rank come first in the order of the export steering. Use build()
+  after migrateInPlace().
+*/
+template <class MemorySpace, class IdType = int>
+class GlobalIdMap
+{
+  public:
+    //! Memory space.
+    using memory_space = MemorySpace;
+
+    //! Default execution space.
+    using execution_space = typename memory_space::execution_space;
+
+    //! Global particle id type.
+    using id_type = IdType;
+
+    //! Hash map type.
+    using map_type = Kokkos::UnorderedMap<IdType, int, memory_space>;
+
+    /*!
+      \brief Constructor.
+
+      \param label The label of the map.
+    */
+    GlobalIdMap( const std::string& label = "GlobalIdMap" )
+        : _ids( label + "::ids", 0 )
+        , _map( 0 )
+        , _num_owned( 0 )
+    {
+    }
+
+    //! Get the number of locally owned particles.
+    std::size_t numOwned() const { return _num_owned; }
+
+    //! Get the number of ghosted particles.
+    std::size_t numGhost() const { return _ids.size() - _num_owned; }
+
+    /*!
+      \brief Get the local index of a particle.
+
+      \param id The global id of the particle.
+
+      \return The local index or -1 if the particle is not present locally.
+    */
+    KOKKOS_INLINE_FUNCTION
+    int find( const IdType id ) const
+    {
+        auto slot = _map.find( id );
+        return _map.valid_at( slot ) ? _map.value_at( slot ) : -1;
+    }
+
+    //! Get the global id of a local particle.
+    KOKKOS_INLINE_FUNCTION
+    IdType globalId( const int local_index ) const
+    {
+        return _ids( local_index );
+    }
+
+    /*!
+      \brief Build the map from the ids of all local particles.
+
+      \param particle_ids The global ids of the local particles, owned
+      particles first followed by ghosts.
+
+      \param num_owned The number of locally owned particles.
+
+      \param num_total The number of owned and ghosted particles.
+    */
+    template <class IdSliceType>
+    void build( const IdSliceType& particle_ids, const std::size_t num_owned,
+                const std::size_t num_total )
+    {
+        Impl::ScopedProfileRegion region( "Cabana::GlobalIdMap::build" );
+
+        _map.clear();
+        if ( _map.capacity() < num_total )
+            _map.rehash( num_total );
+        Kokkos::realloc( _ids, num_total );
+        _num_owned = num_owned;
+        insert( particle_ids, 0, num_owned );
+        insert( particle_ids, num_owned, num_total );
+    }
+
+    /*!
+      \brief Update the map after a migration. Ghosts are removed.
+
+      \param distributor The distributor used for the migration. It must
+      have been created from the locally owned particles of this map.
+
+      \param particle_ids The global ids of the particles after the
+      migration. Only the ids of the arriving particles are read.
+    */
+    template <class DistributorType, class IdSliceType>
+    void update( const DistributorType& distributor,
+                 const IdSliceType& particle_ids,
+                 typename std::enable_if<
+                     is_distributor<DistributorType>::value, int>::type* = 0 )
+    {
+        Impl::ScopedProfileRegion region( "Cabana::GlobalIdMap::update" );
+
+        if ( distributor.exportSize() != _num_owned )
+            throw std::runtime_error(
+                "Distributor does not match the owned particles of the map" );
+        if ( particle_ids.size() < distributor.totalNumImport() )
+            throw std::runtime_error( "Too few particle ids for migration" );
+
+        // The particles staying on this rank come first in the export
+        // steering and are placed first in the new decomposition.
+        int my_rank = -1;
+        MPI_Comm_rank( distributor.comm(), &my_rank );
+        const std::size_t num_stay =
+            ( distributor.numNeighbor() > 0 &&
+              distributor.neighborRank( 0 ) == my_rank )
+                ? distributor.numExport( 0 )
+                : 0;
+        const std::size_t num_import = distributor.totalNumImport();
+
+        // Find the new index of the staying particles.
+        auto steering = distributor.getExportSteering();
+        Kokkos::View<int*, memory_space> new_index( "new_index",
+                                                    _ids.size() );
+        Kokkos::deep_copy( new_index, -1 );
+        Kokkos::View<IdType*, memory_space> new_ids(
+            Kokkos::ViewAllocateWithoutInitializing( _ids.label() ),
+            num_import );
+        auto ids = _ids;
+        auto map = _map;
+        Kokkos::parallel_for(
+            "Cabana::GlobalIdMap::renumber",
+            Kokkos::RangePolicy<execution_space>( 0, num_stay ),
+            KOKKOS_LAMBDA( const int i ) {
+                auto id = ids( steering( i ) );
+                new_index( steering( i ) ) = i;
+                new_ids( i ) = id;
+                map.value_at( map.find( id ) ) = i;
+            } );
+        Kokkos::fence();
+
+        // Erase the departing particles and the ghosts. Ghosts with an owned
+        // copy do not hold the entry of their id.
+        _map.begin_erase();
+        Kokkos::parallel_for(
+            "Cabana::GlobalIdMap::erase",
+            Kokkos::RangePolicy<execution_space>( 0, ids.size() ),
+            KOKKOS_LAMBDA( const int i ) {
+                if ( new_index( i ) < 0 )
+                {
+                    auto slot = map.find( ids( i ) );
+                    if ( map.valid_at( slot ) && map.value_at( slot ) == i )
+                        map.erase( ids( i ) );
+                }
+            } );
+        Kokkos::fence();
+        _map.end_erase();
+
+        // Insert the arrivals.
+        _ids = new_ids;
+        _num_owned = num_import;
+        if ( _map.capacity() < num_import )
+            _map.rehash( num_import );
+        insert( particle_ids, num_stay, num_import );
+    }
+
+    /*!
+      \brief Update the map after a halo gather. The previous ghosts are
+      replaced.
+
+      \param halo The halo used for the gather. It must have been created
+      from the locally owned particles of this map.
+
+      \param particle_ids The global ids of the owned and ghosted particles
+      after the gather. Only the ids of the ghosts are read.
+    */
+    template <class HaloType, class IdSliceType>
+    void update( const HaloType& halo, const IdSliceType& particle_ids,
+                 typename std::enable_if<is_halo<HaloType>::value,
+                                         int>::type* = 0 )
+    {
+        Impl::ScopedProfileRegion region( "Cabana::GlobalIdMap::update" );
+
+        if ( halo.numLocal() != _num_owned )
+            throw std::runtime_error(
+                "Halo does not match the owned particles of the map" );
+        const std::size_t num_total = halo.numLocal() + halo.numGhost();
+        if ( particle_ids.size() < num_total )
+            throw std::runtime_error( "Too few particle ids for halo" );
+
+        // Erase the previous ghosts.
+        eraseGhosts();
+
+        // Insert the new ghosts.
+        Kokkos::resize( _ids, num_total );
+        if ( _map.capacity() < num_total )
+            _map.rehash( num_total );
+        insert( particle_ids, _num_owned, num_total );
+    }
+
+    //! Get the hash map.
+    const map_type& map() const { return _map; }
+
+  private:
+    // Insert particles into the map, growing it as needed. Entries already in
+    // the map are kept such that owned particles take precedence.
+    template <class IdSliceType>
+    void insert( const IdSliceType& particle_ids, const std::size_t begin,
+                 const std::size_t end )
+    {
+        Kokkos::RangePolicy<execution_space> policy( begin, end );
+        bool failed = true;
+        while ( failed )
+        {
+            auto ids = _ids;
+            auto map = _map;
+            Kokkos::parallel_for(
+                "Cabana::GlobalIdMap::insert", policy,
+                KOKKOS_LAMBDA( const int i ) {
+                    ids( i ) = static_cast<IdType>( particle_ids( i ) );
+                    map.insert( ids( i ), i );
+                } );
+            Kokkos::fence();
+            failed = _map.failed_insert();
+            if ( failed )
+                _map.rehash( 2 * _map.capacity() + end - begin );
+        }
+    }
+
+    // Erase the entries held by ghosts.
+    void eraseGhosts()
+    {
+        auto ids = _ids;
+        auto map = _map;
+        _map.begin_erase();
+        Kokkos::parallel_for(
+            "Cabana::GlobalIdMap::erase",
+            Kokkos::RangePolicy<execution_space>( _num_owned, ids.size() ),
+            KOKKOS_LAMBDA( const int i ) {
+                auto slot = map.find( ids( i ) );
+                if ( map.valid_at( slot ) && map.value_at( slot ) == i )
+                    map.erase( ids( i ) );
+            } );
+        Kokkos::fence();
+        _map.end_erase();
+    }
+
+  private:
+    Kokkos::View<IdType*, memory_space> _ids;
+    map_type _map;
+    std::size_t _num_owned;
+};
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_GLOBALIDMAP_HPP
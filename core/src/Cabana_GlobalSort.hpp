@@ -0,0 +1,251 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_GlobalSort.hpp
+  \brief Distributed sample sort of particles by key across ranks
+*/
+#ifndef CABANA_GLOBALSORT_HPP
+#define CABANA_GLOBALSORT_HPP
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_Distributor.hpp>
+#include <Cabana_Slice.hpp>
+#include <Cabana_Sort.hpp>
+#include <impl/Cabana_Profiling.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Cabana
+{
+namespace Impl
+{
+//! \cond Impl
+//---------------------------------------------------------------------------//
+// Select the keys splitting the global key distribution into one range per
+// rank. Every rank sorts its keys and contributes regular samples, each
+// standing for its share of the local keys, such that ranks with more keys
+// weigh more. The splitters are the samples at equal cumulative weights.
+template <class ExecutionSpace, class KeySliceType>
+std::vector<typename KeySliceType::value_type>
+selectSplitters( const ExecutionSpace& exec_space, MPI_Comm comm,
+                 const KeySliceType& keys, const int num_sample )
+{
+    using key_type = typename KeySliceType::value_type;
+    using device_type = typename KeySliceType::device_type;
+
+    int comm_size = -1;
+    MPI_Comm_size( comm, &comm_size );
+
+    // Sample the sorted local keys at the centers of equal ranges.
+    std::size_t num_local = keys.size();
+    int local_sample =
+        static_cast<int>( std::min<std::size_t>( num_sample, num_local ) );
+    auto key_view = copySliceToKeys( exec_space, keys );
+    auto sorted = radixSort( exec_space, key_view, 0, num_local );
+    Kokkos::View<key_type*, device_type> samples( "global_sort_samples",
+                                                  local_sample );
+    Kokkos::parallel_for(
+        "Cabana::globalSortByKey::sample",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, local_sample ),
+        KOKKOS_LAMBDA( const int i ) {
+            std::size_t n = ( 2 * i + 1 ) * num_local / ( 2 * local_sample );
+            samples( i ) = key_view( sorted.permutation( n ) );
+        } );
+    exec_space.fence();
+    auto samples_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), samples );
+
+    // Gather the samples and the number of keys they stand for.
+    std::vector<int> sample_bytes( comm_size );
+    int local_bytes = local_sample * sizeof( key_type );
+    MPI_Allgather( &local_bytes, 1, MPI_INT, sample_bytes.data(), 1, MPI_INT,
+                   comm );
+    std::vector<int> sample_displs( comm_size, 0 );
+    for ( int r = 1; r < comm_size; ++r )
+        sample_displs[r] = sample_displs[r - 1] + sample_bytes[r - 1];
+    std::vector<key_type> all_samples(
+        ( sample_displs.back() + sample_bytes.back() ) / sizeof( key_type ) );
+    MPI_Allgatherv( samples_host.data(), local_bytes, MPI_BYTE,
+                    all_samples.data(), sample_bytes.data(),
+                    sample_displs.data(), MPI_BYTE, comm );
+    double local_weight =
+        ( local_sample > 0 ) ? double( num_local ) / local_sample : 0.0;
+    std::vector<double> weights( comm_size );
+    MPI_Allgather( &local_weight, 1, MPI_DOUBLE, weights.data(), 1,
+                   MPI_DOUBLE, comm );
+
+    std::vector<std::pair<key_type, double>> weighted;
+    weighted.reserve( all_samples.size() );
+    double total_weight = 0.0;
+    for ( int r = 0; r < comm_size; ++r )
+    {
+        int num_r = sample_bytes[r] / sizeof( key_type );
+        for ( int s = 0; s < num_r; ++s )
+            weighted.emplace_back(
+                all_samples[sample_displs[r] / sizeof( key_type ) + s],
+                weights[r] );
+        total_weight += num_r * weights[r];
+    }
+    std::sort( weighted.begin(), weighted.end(),
+               []( const std::pair<key_type, double>& a,
+                   const std::pair<key_type, double>& b ) {
+                   return a.first < b.first;
+               } );
+
+    // Choose the splitters at equal cumulative weights. Missing splitters
+    // (e.g. without keys) send all remaining keys to the last assigned rank.
+    std::vector<key_type> splitters;
+    splitters.reserve( comm_size - 1 );
+    double cumulative = 0.0;
+    for ( auto& sample : weighted )
+    {
+        cumulative += sample.second;
+        while ( static_cast<int>( splitters.size() ) < comm_size - 1 &&
+                cumulative >= total_weight * ( splitters.size() + 1 ) /
+                                  comm_size )
+            splitters.push_back( sample.first );
+    }
+    key_type last_splitter =
+        weighted.empty() ? key_type() : weighted.back().first;
+    while ( static_cast<int>( splitters.size() ) < comm_size - 1 )
+        splitters.push_back( last_splitter );
+    return splitters;
+}
+
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Sort an AoSoA by key across all ranks of a communicator.
+
+  \tparam KeySliceType Slice type for keys. The keys must be integers.
+
+  \tparam AoSoA_t AoSoA type.
+
+  \param comm The communicator of the ranks to sort across.
+
+  \param keys The key of every element of the AoSoA, e.g. a slice of the
+  global particle ids.
+
+  \param aosoa The AoSoA to sort. At output, it holds the elements of a
+  contiguous range of keys sorted in increasing order, and the ranges of the
+  ranks increase with the rank. The size changes.
+
+  \param num_sample Optional number of keys every rank samples to select the
+  ranges. More samples give better balanced ranges.
+
+  The sort is a sample sort: every rank samples its sorted keys, the samples
+  weighted by the number of keys they stand for select the key ranges of the
+  ranks such that every rank receives about the same number of elements
+  regardless of the distribution of the keys, the elements are migrated to
+  the ranks owning their keys, and every rank sorts its elements with the
+  stable radix sort. Elements with equal keys are kept on the same rank.
+
+  \note The key slice is not used after the migration such that it may be a
+  slice of the AoSoA. Slices of the AoSoA must be recreated afterwards.
+*/
+template <class KeySliceType, class AoSoA_t>
+void globalSortByKey( MPI_Comm comm, const KeySliceType& keys, AoSoA_t& aosoa,
+                      const int num_sample = 64,
+                      typename std::enable_if<( is_slice<KeySliceType>::value &&
+                                                is_aosoa<AoSoA_t>::value ),
+                                              int>::type* = 0 )
+{
+    Impl::ScopedProfileRegion region( "Cabana::globalSortByKey" );
+
+    using device_type = typename AoSoA_t::device_type;
+    using execution_space = typename device_type::execution_space;
+    using key_type = typename KeySliceType::value_type;
+    static_assert( std::is_integral<key_type>::value,
+                   "Global sorting requires integer keys" );
+
+    if ( keys.size() != aosoa.size() )
+        throw std::runtime_error( "Keys are the wrong size for sorting!" );
+    if ( num_sample < 1 )
+        throw std::runtime_error( "At least one sample is required!" );
+
+    int comm_size = -1;
+    MPI_Comm_size( comm, &comm_size );
+    execution_space exec_space;
+
+    // Copy the keys into an AoSoA that migrates with the data.
+    std::size_t num_local = aosoa.size();
+    AoSoA<MemberTypes<key_type>, device_type> key_aosoa( "global_sort_keys",
+                                                         num_local );
+    auto key_slice = slice<0>( key_aosoa );
+    Kokkos::parallel_for(
+        "Cabana::globalSortByKey::copy_keys",
+        Kokkos::RangePolicy<execution_space>( exec_space, 0, num_local ),
+        KOKKOS_LAMBDA( const std::size_t i ) { key_slice( i ) = keys( i ); } );
+    exec_space.fence();
+
+    // Select the key ranges of the ranks.
+    auto splitters_host =
+        Impl::selectSplitters( exec_space, comm, key_slice, num_sample );
+    int num_splitter = comm_size - 1;
+    Kokkos::View<key_type*, device_type> splitters( "global_sort_splitters",
+                                                    num_splitter );
+    Kokkos::deep_copy(
+        splitters,
+        Kokkos::View<key_type*, Kokkos::HostSpace,
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged>>(
+            splitters_host.data(), num_splitter ) );
+
+    // The destination of a key is the number of splitters less than it.
+    Kokkos::View<int*, device_type> export_ranks(
+        Kokkos::ViewAllocateWithoutInitializing( "global_sort_export_ranks" ),
+        num_local );
+    Kokkos::parallel_for(
+        "Cabana::globalSortByKey::export_ranks",
+        Kokkos::RangePolicy<execution_space>( exec_space, 0, num_local ),
+        KOKKOS_LAMBDA( const std::size_t i ) {
+            key_type key = key_slice( i );
+            int lo = 0;
+            int hi = num_splitter;
+            while ( lo < hi )
+            {
+                int mid = ( lo + hi ) / 2;
+                if ( splitters( mid ) < key )
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            export_ranks( i ) = lo;
+        } );
+    exec_space.fence();
+
+    // Move the elements and their keys to the ranks owning their keys.
+    Distributor<device_type> distributor( comm, export_ranks );
+    migrate( distributor, aosoa );
+    migrate( distributor, key_aosoa );
+
+    // Sort the local elements.
+    auto key_view = Impl::copySliceToKeys( exec_space, slice<0>( key_aosoa ) );
+    auto binning_data =
+        Impl::radixSort( exec_space, key_view, 0, key_view.extent( 0 ) );
+    permute( exec_space, binning_data, aosoa );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_GLOBALSORT_HPP
@@ -0,0 +1,244 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_Graph.hpp
+  \brief Kokkos graph nodes for SIMD and neighbor parallel kernels
+*/
+#ifndef CABANA_GRAPH_HPP
+#define CABANA_GRAPH_HPP
+
+#include <Cabana_ExecutionPolicy.hpp>
+#include <Cabana_NeighborList.hpp>
+#include <Cabana_Parallel.hpp>
+#include <Cabana_Types.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#if KOKKOS_VERSION >= 30300
+#include <Kokkos_Graph.hpp>
+#endif
+
+#include <string>
+
+#if KOKKOS_VERSION >= 30300
+
+namespace Cabana
+{
+namespace Experimental
+{
+//---------------------------------------------------------------------------//
+// Graph nodes
+//---------------------------------------------------------------------------//
+/*
+  The functions below add the kernels of the corresponding Cabana parallel
+  functions as nodes of a Kokkos::Experimental::Graph such that a sequence
+  of kernels, e.g. the force and integration kernels of a timestep, is
+  launched at once when the graph is submitted. Each returns the new node,
+  which runs after the given node.
+
+  Only operations consisting of kernels alone can be recorded. Neighbor list
+  builds, sorting, and halo exchange allocate memory, reduce to the host, or
+  communicate, and so run between graph submissions. The nodes capture the
+  functor and neighbor list by value: a graph must be recreated if the list
+  or the data used by the functors is reallocated.
+*/
+
+/*!
+  \brief Add a vectorized functor with a 2d execution policy to a graph.
+
+  \param node The node after which to execute the functor.
+
+  \param exec_policy The 2D range policy over which to execute the functor.
+
+  \param functor The vectorized functor to execute in parallel. Must accept
+  both a struct and array index.
+
+  \param str Name for the functor.
+
+  \return The node executing the functor.
+
+  \see Cabana::simd_parallel_for
+*/
+template <class NodeType, class FunctorType, int VectorLength,
+          class... ExecParameters>
+auto then_simd_parallel_for(
+    const NodeType& node,
+    const SimdPolicy<VectorLength, ExecParameters...>& exec_policy,
+    const FunctorType& functor, const std::string& str = "" )
+{
+    using simd_policy = SimdPolicy<VectorLength, ExecParameters...>;
+
+    using work_tag = typename simd_policy::work_tag;
+
+    using team_policy = typename simd_policy::base_type;
+
+    using index_type = typename team_policy::index_type;
+
+    auto simd_func =
+        KOKKOS_LAMBDA( const typename team_policy::member_type& team )
+    {
+        index_type s = team.league_rank() + exec_policy.structBegin();
+        Kokkos::parallel_for(
+            Kokkos::ThreadVectorRange( team, exec_policy.arrayBegin( s ),
+                                       exec_policy.arrayEnd( s ) ),
+            [&]( const index_type a ) {
+                Impl::functorTagDispatch<work_tag>( functor, s, a );
+            } );
+    };
+    return node.then_parallel_for(
+        str, dynamic_cast<const team_policy&>( exec_policy ), simd_func );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Add a functor over particle first neighbors with thread-local serial
+  loops to a graph.
+
+  \param node The node after which to execute the functor.
+
+  \param exec_policy The policy over which to execute the functor.
+
+  \param functor The functor to execute in parallel.
+
+  \param list The neighbor list over which to execute the neighbor
+  operations.
+
+  \param FirstNeighborsTag Tag indicating operations over particle first
+  neighbors.
+
+  \param SerialOpTag Tag indicating a serial loop strategy over neighbors.
+
+  \param str Name for the functor.
+
+  \return The node executing the functor.
+
+  \see Cabana::neighbor_parallel_for
+*/
+template <class NodeType, class FunctorType, class NeighborListType,
+          class... ExecParameters>
+auto then_neighbor_parallel_for(
+    const NodeType& node,
+    const Kokkos::RangePolicy<ExecParameters...>& exec_policy,
+    const FunctorType& functor, const NeighborListType& list,
+    const FirstNeighborsTag, const SerialOpTag, const std::string& str = "" )
+{
+    using work_tag = typename Kokkos::RangePolicy<ExecParameters...>::work_tag;
+
+    using execution_space =
+        typename Kokkos::RangePolicy<ExecParameters...>::execution_space;
+
+    using index_type =
+        typename Kokkos::RangePolicy<ExecParameters...>::index_type;
+
+    using neighbor_list_traits = NeighborList<NeighborListType>;
+
+    using memory_space = typename neighbor_list_traits::memory_space;
+
+    using linear_policy_type = Kokkos::RangePolicy<execution_space, void, void>;
+    linear_policy_type linear_exec_policy( exec_policy.space(),
+                                           exec_policy.begin(),
+                                           exec_policy.end() );
+
+    static_assert( is_accessible_from<memory_space, execution_space>{}, "" );
+
+    auto neigh_func = KOKKOS_LAMBDA( const index_type i )
+    {
+        for ( index_type n = 0;
+              n < neighbor_list_traits::numNeighbor( list, i ); ++n )
+            Impl::functorTagDispatch<work_tag>(
+                functor, i,
+                static_cast<index_type>(
+                    neighbor_list_traits::getNeighbor( list, i, n ) ) );
+    };
+    return node.then_parallel_for( str, linear_exec_policy, neigh_func );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Add a functor over particle first and second neighbors with
+  thread-local serial loops to a graph.
+
+  \param node The node after which to execute the functor.
+
+  \param exec_policy The policy over which to execute the functor.
+
+  \param functor The functor to execute in parallel.
+
+  \param list The neighbor list over which to execute the neighbor
+  operations.
+
+  \param SecondNeighborsTag Tag indicating operations over particle first and
+  second neighbors.
+
+  \param SerialOpTag Tag indicating a serial loop strategy over neighbors.
+
+  \param str Name for the functor.
+
+  \return The node executing the functor.
+
+  \see Cabana::neighbor_parallel_for
+*/
+template <class NodeType, class FunctorType, class NeighborListType,
+          class... ExecParameters>
+auto then_neighbor_parallel_for(
+    const NodeType& node,
+    const Kokkos::RangePolicy<ExecParameters...>& exec_policy,
+    const FunctorType& functor, const NeighborListType& list,
+    const SecondNeighborsTag, const SerialOpTag, const std::string& str = "" )
+{
+    using work_tag = typename Kokkos::RangePolicy<ExecParameters...>::work_tag;
+
+    using execution_space =
+        typename Kokkos::RangePolicy<ExecParameters...>::execution_space;
+
+    using index_type =
+        typename Kokkos::RangePolicy<ExecParameters...>::index_type;
+
+    using neighbor_list_traits = NeighborList<NeighborListType>;
+
+    using memory_space = typename neighbor_list_traits::memory_space;
+
+    using linear_policy_type = Kokkos::RangePolicy<execution_space, void, void>;
+    linear_policy_type linear_exec_policy( exec_policy.space(),
+                                           exec_policy.begin(),
+                                           exec_policy.end() );
+
+    static_assert( is_accessible_from<memory_space, execution_space>{}, "" );
+
+    auto neigh_func = KOKKOS_LAMBDA( const index_type i )
+    {
+        const index_type nn = neighbor_list_traits::numNeighbor( list, i );
+
+        for ( index_type n = 0; n < nn; ++n )
+        {
+            const index_type j =
+                neighbor_list_traits::getNeighbor( list, i, n );
+
+            for ( index_type a = n + 1; a < nn; ++a )
+            {
+                const index_type k =
+                    neighbor_list_traits::getNeighbor( list, i, a );
+                Impl::functorTagDispatch<work_tag>( functor, i, j, k );
+            }
+        }
+    };
+    return node.then_parallel_for( str, linear_exec_policy, neigh_func );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Experimental
+} // end namespace Cabana
+
+#endif // end KOKKOS_VERSION >= 30300
+
+#endif // end CABANA_GRAPH_HPP
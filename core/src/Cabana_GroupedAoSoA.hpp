@@ -0,0 +1,365 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_GroupedAoSoA.hpp
+  \brief AoSoA with members partitioned into separately stored groups
+*/
+#ifndef CABANA_GROUPEDAOSOA_HPP
+#define CABANA_GROUPEDAOSOA_HPP
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_MemberTypes.hpp>
+#include <Cabana_ParameterPack.hpp>
+#include <impl/Cabana_PerformanceTraits.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace Cabana
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief Sequence of member groups of a GroupedAoSoA. Each group must be an
+  instance of \c MemberTypes.
+*/
+template <class... Groups>
+struct MemberGroups
+{
+    //! Number of groups.
+    static constexpr std::size_t size = sizeof...( Groups );
+};
+
+//---------------------------------------------------------------------------//
+//! \cond Impl
+namespace Impl
+{
+// Concatenate the member types of all groups.
+template <class... Groups>
+struct ConcatMemberTypes;
+
+template <class... Types>
+struct ConcatMemberTypes<MemberTypes<Types...>>
+{
+    using type = MemberTypes<Types...>;
+};
+
+template <class... Types0, class... Types1, class... Groups>
+struct ConcatMemberTypes<MemberTypes<Types0...>, MemberTypes<Types1...>,
+                         Groups...>
+    : ConcatMemberTypes<MemberTypes<Types0..., Types1...>, Groups...>
+{
+};
+
+// Find the group G and the index within the group of the member M of the
+// concatenated member types.
+template <std::size_t G, std::size_t M>
+struct GroupedMemberIndexFound
+{
+    static constexpr std::size_t group = G;
+    static constexpr std::size_t local = M;
+};
+
+template <std::size_t M, std::size_t G, class... Groups>
+struct GroupedMemberIndex;
+
+template <std::size_t M, std::size_t G, class Group, class... Groups>
+struct GroupedMemberIndex<M, G, Group, Groups...>
+    : std::conditional<( M < Group::size ), GroupedMemberIndexFound<G, M>,
+                       GroupedMemberIndex<M - Group::size, G + 1,
+                                          Groups...>>::type
+{
+};
+} // end namespace Impl
+//! \endcond
+
+//---------------------------------------------------------------------------//
+// GroupedAoSoA forward declaration.
+template <class Groups, class DeviceType,
+          int VectorLength = Impl::PerformanceTraits<
+              typename DeviceType::execution_space>::vector_length>
+class GroupedAoSoA;
+
+//---------------------------------------------------------------------------//
+//! \cond Impl
+template <class>
+struct is_grouped_aosoa_impl : public std::false_type
+{
+};
+
+template <class Groups, class DeviceType, int VectorLength>
+struct is_grouped_aosoa_impl<GroupedAoSoA<Groups, DeviceType, VectorLength>>
+    : public std::true_type
+{
+};
+//! \endcond
+
+//! GroupedAoSoA static type checker.
+template <class T>
+struct is_grouped_aosoa
+    : public is_grouped_aosoa_impl<typename std::remove_cv<T>::type>::type
+{
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Array-of-Struct-of-Arrays with members partitioned into groups.
+
+  Each group of members is stored in its own AoSoA such that kernels which
+  only access the members of one group, e.g. the positions, velocities, and
+  forces used every step, do not load the cache lines of the other groups,
+  e.g. identifiers and tags. All groups have the same size, capacity, and
+  vector length and are resized together.
+
+  Members are indexed in the order of the concatenated groups and sliced
+  with the same slice<M>() function as an AoSoA:
+  \code
+  using Hot = MemberTypes<double[3], double[3], double[3]>;
+  using Cold = MemberTypes<int, int, double>;
+  GroupedAoSoA<MemberGroups<Hot, Cold>, DeviceType> particles( "p", n );
+  auto x = slice<0>( particles ); // Hot group.
+  auto id = slice<3>( particles ); // Cold group.
+  \endcode
+
+  The groups are regular AoSoAs available through group<G>() and may be
+  communicated or sorted on their own. Migration and halo gathers of the
+  GroupedAoSoA move all groups.
+
+  \note There is no tuple access to all members at once.
+
+  \tparam Groups (required) The member groups, an instance of MemberGroups.
+  \tparam DeviceType (required) The device type.
+  \tparam VectorLength (optional) The vector length of all groups.
+*/
+template <class... Groups, class DeviceType, int VectorLength>
+class GroupedAoSoA<MemberGroups<Groups...>, DeviceType, VectorLength>
+{
+  public:
+    //! GroupedAoSoA type.
+    using aosoa_type =
+        GroupedAoSoA<MemberGroups<Groups...>, DeviceType, VectorLength>;
+
+    //! Member groups.
+    using member_groups = MemberGroups<Groups...>;
+
+    static_assert( sizeof...( Groups ) > 0,
+                   "GroupedAoSoA requires at least one group" );
+
+    //! Concatenated member data types of all groups.
+    using member_types = typename Impl::ConcatMemberTypes<Groups...>::type;
+
+    //! Device type.
+    using device_type = DeviceType;
+
+    //! Memory space.
+    using memory_space = typename device_type::memory_space;
+
+    //! Execution space.
+    using execution_space = typename device_type::execution_space;
+
+    //! Vector length.
+    static constexpr int vector_length = VectorLength;
+
+    //! Size type.
+    using size_type = typename memory_space::size_type;
+
+    //! Number of member types.
+    static constexpr std::size_t number_of_members = member_types::size;
+
+    //! Number of groups.
+    static constexpr std::size_t number_of_groups = sizeof...( Groups );
+
+    //! AoSoA type of the group at a given index G.
+    template <std::size_t G>
+    using group_type =
+        AoSoA<typename PackTypeAtIndex<G, Groups...>::type, device_type,
+              vector_length>;
+
+    //! Index of the group storing the member at a given index M.
+    template <std::size_t M>
+    using member_group = std::integral_constant<
+        std::size_t, Impl::GroupedMemberIndex<M, 0, Groups...>::group>;
+
+    //! Index within its group of the member at a given index M.
+    template <std::size_t M>
+    using member_group_index = std::integral_constant<
+        std::size_t, Impl::GroupedMemberIndex<M, 0, Groups...>::local>;
+
+    //! Member data type at a given index M.
+    template <std::size_t M>
+    using member_data_type = typename MemberTypeAtIndex<M, member_types>::type;
+
+    //! Struct member array element value type at a given index M.
+    template <std::size_t M>
+    using member_value_type =
+        typename std::remove_all_extents<member_data_type<M>>::type;
+
+    //! Member slice type at a given member index M.
+    template <std::size_t M>
+    using member_slice_type = typename group_type<member_group<M>::value>::
+        template member_slice_type<member_group_index<M>::value>;
+
+  public:
+    /*!
+      \brief Allocate a container with n tuples.
+
+      \param label A label for the data structure. The groups are labeled
+      with the group index appended.
+
+      \param n The number of tuples in the container.
+    */
+    GroupedAoSoA( const std::string& label = "", const size_type n = 0 )
+        : _label( label )
+        , _groups( createGroups(
+              label, std::make_index_sequence<number_of_groups>() ) )
+    {
+        resize( n );
+    }
+
+    //! Returns the data structure label.
+    std::string label() const { return _label; }
+
+    //! Returns the number of tuples in the container.
+    size_type size() const { return group<0>().size(); }
+
+    //! Returns if the container is empty or not.
+    bool empty() const { return ( size() == 0 ); }
+
+    //! Returns the number of tuples allocated in every group.
+    size_type capacity() const { return group<0>().capacity(); }
+
+    //! Get the number of structs-of-arrays in every group.
+    size_type numSoA() const { return group<0>().numSoA(); }
+
+    /*!
+      \brief Resize all groups to contain n tuples.
+      \see AoSoA::resize
+    */
+    void resize( const size_type n )
+    {
+        forEachGroup( [=]( auto& group ) { group.resize( n ); } );
+    }
+
+    /*!
+      \brief Reserve at least n tuples in all groups.
+      \see AoSoA::reserve
+    */
+    void reserve( const size_type n )
+    {
+        forEachGroup( [=]( auto& group ) { group.reserve( n ); } );
+    }
+
+    /*!
+      \brief Remove unused capacity from all groups.
+      \see AoSoA::shrinkToFit
+    */
+    void shrinkToFit()
+    {
+        forEachGroup( []( auto& group ) { group.shrinkToFit(); } );
+    }
+
+    /*!
+      \brief Set the policy used by resize() to grow the capacity of all
+      groups.
+      \see AoSoA::setGrowthPolicy
+    */
+    void setGrowthPolicy( GrowthPolicy::Function policy )
+    {
+        forEachGroup(
+            [=]( auto& group ) { group.setGrowthPolicy( policy ); } );
+    }
+
+    //! Get the policy used by resize() to grow the capacity.
+    GrowthPolicy::Function growthPolicy() const
+    {
+        return group<0>().growthPolicy();
+    }
+
+    /*!
+      \brief Get the AoSoA of a group.
+
+      The group may be resized only through the GroupedAoSoA such that all
+      groups keep the same size.
+    */
+    template <std::size_t G>
+    group_type<G>& group()
+    {
+        return std::get<G>( _groups );
+    }
+
+    //! Get the AoSoA of a group.
+    template <std::size_t G>
+    const group_type<G>& group() const
+    {
+        return std::get<G>( _groups );
+    }
+
+  private:
+    // Create the AoSoAs of the groups.
+    template <std::size_t... G>
+    static std::tuple<group_type<G>...>
+    createGroups( const std::string& label, std::index_sequence<G...> )
+    {
+        return std::tuple<group_type<G>...>(
+            group_type<G>( label + "_" + std::to_string( G ) )... );
+    }
+
+    // Apply a function to the AoSoA of every group.
+    template <class Function>
+    void forEachGroup( const Function& function )
+    {
+        forEachGroup( function,
+                      std::make_index_sequence<number_of_groups>() );
+    }
+
+    template <class Function, std::size_t... G>
+    void forEachGroup( const Function& function, std::index_sequence<G...> )
+    {
+        int dummy[] = { ( function( std::get<G>( _groups ) ), 0 )... };
+        (void)dummy;
+    }
+
+  private:
+    std::string _label;
+    std::tuple<AoSoA<Groups, device_type, vector_length>...> _groups;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create a slice from a GroupedAoSoA. The slice views the AoSoA of the
+  group storing the member.
+
+  \tparam M Slice index in the concatenated member types.
+
+  \param aosoa GroupedAoSoA to slice from.
+  \param slice_label Optional slice label.
+*/
+template <std::size_t M, class Groups, class DeviceType, int VectorLength>
+typename GroupedAoSoA<Groups, DeviceType,
+                      VectorLength>::template member_slice_type<M>
+slice( const GroupedAoSoA<Groups, DeviceType, VectorLength>& aosoa,
+       const std::string& slice_label = "" )
+{
+    using aosoa_type = GroupedAoSoA<Groups, DeviceType, VectorLength>;
+    return slice<aosoa_type::template member_group_index<M>::value>(
+        aosoa.template group<aosoa_type::template member_group<M>::value>(),
+        slice_label );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_GROUPEDAOSOA_HPP
@@ -0,0 +1,563 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_HDF5ParticleIO.hpp
+  \brief Parallel HDF5 particle output and checkpoint input
+*/
+#ifndef CABANA_HDF5PARTICLEIO_HPP
+#define CABANA_HDF5PARTICLEIO_HPP
+
+#include <Cabana_Slice.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <hdf5.h>
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace Cabana
+{
+namespace Experimental
+{
+namespace HDF5ParticleOutput
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief Parameters controlling parallel HDF5 file access.
+*/
+struct HDF5Config
+{
+    //! Use collective (true) or independent (false) data transfers.
+    bool collective = true;
+
+    //! Use collective metadata reads and writes.
+    bool meta_collective = true;
+
+    //! Number of particles per dataset chunk. Zero writes contiguous datasets.
+    hsize_t chunk_size = 0;
+
+    //! Align file objects larger than the threshold to the alignment, e.g.
+    //! to the parallel file system stripe size.
+    bool align = false;
+    //! Alignment threshold in bytes.
+    hsize_t threshold = 0;
+    //! Alignment in bytes.
+    hsize_t alignment = 16777216;
+};
+
+namespace Impl
+{
+//! \cond Impl
+//---------------------------------------------------------------------------//
+// HDF5 native type traits.
+template <class T>
+struct HDF5Traits;
+
+template <>
+struct HDF5Traits<char>
+{
+    static hid_t type() { return H5T_NATIVE_CHAR; }
+};
+
+template <>
+struct HDF5Traits<short>
+{
+    static hid_t type() { return H5T_NATIVE_SHORT; }
+};
+
+template <>
+struct HDF5Traits<int>
+{
+    static hid_t type() { return H5T_NATIVE_INT; }
+};
+
+template <>
+struct HDF5Traits<unsigned int>
+{
+    static hid_t type() { return H5T_NATIVE_UINT; }
+};
+
+template <>
+struct HDF5Traits<long>
+{
+    static hid_t type() { return H5T_NATIVE_LONG; }
+};
+
+template <>
+struct HDF5Traits<unsigned long>
+{
+    static hid_t type() { return H5T_NATIVE_ULONG; }
+};
+
+template <>
+struct HDF5Traits<long long>
+{
+    static hid_t type() { return H5T_NATIVE_LLONG; }
+};
+
+template <>
+struct HDF5Traits<unsigned long long>
+{
+    static hid_t type() { return H5T_NATIVE_ULLONG; }
+};
+
+template <>
+struct HDF5Traits<float>
+{
+    static hid_t type() { return H5T_NATIVE_FLOAT; }
+};
+
+template <>
+struct HDF5Traits<double>
+{
+    static hid_t type() { return H5T_NATIVE_DOUBLE; }
+};
+
+//---------------------------------------------------------------------------//
+// Check an HDF5 return value.
+inline void checkHDF5( const herr_t status, const std::string& what )
+{
+    if ( status < 0 )
+        throw std::runtime_error( "HDF5 error in " + what );
+}
+
+//---------------------------------------------------------------------------//
+// Get the file name of a time step.
+inline std::string fileName( const std::string& prefix, const int step )
+{
+    std::stringstream filename;
+    filename << prefix << "_" << step << ".h5";
+    return filename.str();
+}
+
+//---------------------------------------------------------------------------//
+// Create the file access property list of a configuration.
+inline hid_t fileAccess( const HDF5Config& h5_config, MPI_Comm comm )
+{
+    hid_t plist_id = H5Pcreate( H5P_FILE_ACCESS );
+    checkHDF5( H5Pset_fapl_mpio( plist_id, comm, MPI_INFO_NULL ),
+               "H5Pset_fapl_mpio" );
+#if H5_VERSION_GE( 1, 10, 0 )
+    if ( h5_config.meta_collective )
+    {
+        H5Pset_all_coll_metadata_ops( plist_id, true );
+        H5Pset_coll_metadata_write( plist_id, true );
+    }
+#endif
+    if ( h5_config.align )
+        H5Pset_alignment( plist_id, h5_config.threshold, h5_config.alignment );
+    return plist_id;
+}
+
+//---------------------------------------------------------------------------//
+// Create the data transfer property list of a configuration.
+inline hid_t dataTransfer( const HDF5Config& h5_config )
+{
+    hid_t plist_id = H5Pcreate( H5P_DATASET_XFER );
+    H5Pset_dxpl_mpio( plist_id, h5_config.collective ? H5FD_MPIO_COLLECTIVE
+                                                     : H5FD_MPIO_INDEPENDENT );
+    return plist_id;
+}
+
+//---------------------------------------------------------------------------//
+// Select the particles of this rank in the file and memory spaces. Ranks
+// without particles still take part in collective transfers with empty
+// selections.
+inline void selectLocal( hid_t filespace_id, hid_t memspace_id,
+                         const hsize_t offset[2], const hsize_t count[2] )
+{
+    if ( 0 == count[0] )
+    {
+        H5Sselect_none( filespace_id );
+        H5Sselect_none( memspace_id );
+    }
+    else
+    {
+        H5Sselect_hyperslab( filespace_id, H5S_SELECT_SET, offset, nullptr,
+                             count, nullptr );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Number of values per particle of a slice member.
+template <class SliceType>
+std::size_t componentCount( const SliceType& slice )
+{
+    std::size_t count = 1;
+    for ( std::size_t d = 2; d < slice.rank(); ++d )
+        count *= slice.extent( d );
+    return count;
+}
+
+//---------------------------------------------------------------------------//
+// Copy the first n particles of a slice member to/from a contiguous
+// (particle, component) view in the slice memory space.
+template <class SliceType, class ViewType>
+std::enable_if_t<2 == SliceType::kokkos_view::Rank, void>
+copySliceToView( const SliceType& slice, const std::size_t n, ViewType& view )
+{
+    Kokkos::parallel_for(
+        "Cabana::HDF5ParticleOutput::copySlice",
+        Kokkos::RangePolicy<typename SliceType::execution_space>( 0, n ),
+        KOKKOS_LAMBDA( const int p ) { view( p, 0 ) = slice( p ); } );
+}
+
+template <class SliceType, class ViewType>
+std::enable_if_t<3 == SliceType::kokkos_view::Rank, void>
+copySliceToView( const SliceType& slice, const std::size_t n, ViewType& view )
+{
+    Kokkos::parallel_for(
+        "Cabana::HDF5ParticleOutput::copySlice",
+        Kokkos::RangePolicy<typename SliceType::execution_space>( 0, n ),
+        KOKKOS_LAMBDA( const int p ) {
+            for ( std::size_t d = 0; d < slice.extent( 2 ); ++d )
+                view( p, d ) = slice( p, d );
+        } );
+}
+
+template <class SliceType, class ViewType>
+std::enable_if_t<4 == SliceType::kokkos_view::Rank, void>
+copySliceToView( const SliceType& slice, const std::size_t n, ViewType& view )
+{
+    Kokkos::parallel_for(
+        "Cabana::HDF5ParticleOutput::copySlice",
+        Kokkos::RangePolicy<typename SliceType::execution_space>( 0, n ),
+        KOKKOS_LAMBDA( const int p ) {
+            for ( std::size_t d0 = 0; d0 < slice.extent( 2 ); ++d0 )
+                for ( std::size_t d1 = 0; d1 < slice.extent( 3 ); ++d1 )
+                    view( p, d0 * slice.extent( 3 ) + d1 ) =
+                        slice( p, d0, d1 );
+        } );
+}
+
+template <class SliceType, class ViewType>
+std::enable_if_t<2 == SliceType::kokkos_view::Rank, void>
+copyViewToSlice( const ViewType& view, const std::size_t n, SliceType& slice )
+{
+    Kokkos::parallel_for(
+        "Cabana::HDF5ParticleOutput::copyView",
+        Kokkos::RangePolicy<typename SliceType::execution_space>( 0, n ),
+        KOKKOS_LAMBDA( const int p ) { slice( p ) = view( p, 0 ); } );
+}
+
+template <class SliceType, class ViewType>
+std::enable_if_t<3 == SliceType::kokkos_view::Rank, void>
+copyViewToSlice( const ViewType& view, const std::size_t n, SliceType& slice )
+{
+    Kokkos::parallel_for(
+        "Cabana::HDF5ParticleOutput::copyView",
+        Kokkos::RangePolicy<typename SliceType::execution_space>( 0, n ),
+        KOKKOS_LAMBDA( const int p ) {
+            for ( std::size_t d = 0; d < slice.extent( 2 ); ++d )
+                slice( p, d ) = view( p, d );
+        } );
+}
+
+template <class SliceType, class ViewType>
+std::enable_if_t<4 == SliceType::kokkos_view::Rank, void>
+copyViewToSlice( const ViewType& view, const std::size_t n, SliceType& slice )
+{
+    Kokkos::parallel_for(
+        "Cabana::HDF5ParticleOutput::copyView",
+        Kokkos::RangePolicy<typename SliceType::execution_space>( 0, n ),
+        KOKKOS_LAMBDA( const int p ) {
+            for ( std::size_t d0 = 0; d0 < slice.extent( 2 ); ++d0 )
+                for ( std::size_t d1 = 0; d1 < slice.extent( 3 ); ++d1 )
+                    slice( p, d0, d1 ) =
+                        view( p, d0 * slice.extent( 3 ) + d1 );
+        } );
+}
+
+//---------------------------------------------------------------------------//
+// Write one slice member as a (global particle, component) dataset. Each
+// rank writes its particles at its offset in the global particle order.
+template <class SliceType>
+void writeField( const HDF5Config& h5_config, hid_t file_id, hid_t dxpl_id,
+                 const std::size_t n_offset, const std::size_t n_global,
+                 const std::size_t n_local, const SliceType& slice )
+{
+    using value_type = typename SliceType::value_type;
+    using memory_space = typename SliceType::memory_space;
+
+    std::string name = slice.label();
+    if ( name.empty() )
+        throw std::logic_error(
+            "HDF5 particle output requires labeled slices" );
+
+    // Gather the member into contiguous memory and stage it on the host.
+    const std::size_t num_comp = componentCount( slice );
+    Kokkos::View<value_type**, Kokkos::LayoutRight, memory_space> view(
+        Kokkos::ViewAllocateWithoutInitializing( slice.label() ), n_local,
+        num_comp );
+    copySliceToView( slice, n_local, view );
+    auto host_view =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), view );
+
+    hsize_t dims_global[2] = { n_global, num_comp };
+    hsize_t dims_local[2] = { n_local, num_comp };
+    hsize_t offset[2] = { n_offset, 0 };
+    hid_t filespace_id = H5Screate_simple( 2, dims_global, nullptr );
+    hid_t memspace_id = H5Screate_simple( 2, dims_local, nullptr );
+
+    // Optionally chunk the dataset along the particles.
+    hid_t dcpl_id = H5Pcreate( H5P_DATASET_CREATE );
+    if ( h5_config.chunk_size > 0 && n_global > 0 )
+    {
+        hsize_t chunk_dims[2] = {
+            std::min<hsize_t>( h5_config.chunk_size, n_global ), num_comp };
+        checkHDF5( H5Pset_chunk( dcpl_id, 2, chunk_dims ), "H5Pset_chunk" );
+    }
+
+    hid_t dset_id =
+        H5Dcreate( file_id, name.c_str(), HDF5Traits<value_type>::type(),
+                   filespace_id, H5P_DEFAULT, dcpl_id, H5P_DEFAULT );
+    if ( dset_id < 0 )
+        throw std::runtime_error( "HDF5 error creating dataset " + name );
+
+    selectLocal( filespace_id, memspace_id, offset, dims_local );
+    checkHDF5( H5Dwrite( dset_id, HDF5Traits<value_type>::type(),
+                         memspace_id, filespace_id, dxpl_id,
+                         host_view.data() ),
+               "H5Dwrite " + name );
+
+    H5Dclose( dset_id );
+    H5Pclose( dcpl_id );
+    H5Sclose( memspace_id );
+    H5Sclose( filespace_id );
+}
+
+//---------------------------------------------------------------------------//
+inline void writeFields( const HDF5Config&, hid_t, hid_t, const std::size_t,
+                         const std::size_t, const std::size_t )
+{
+}
+
+template <class SliceType, class... FieldSliceTypes>
+void writeFields( const HDF5Config& h5_config, hid_t file_id, hid_t dxpl_id,
+                  const std::size_t n_offset, const std::size_t n_global,
+                  const std::size_t n_local, const SliceType& slice,
+                  const FieldSliceTypes&... fields )
+{
+    writeField( h5_config, file_id, dxpl_id, n_offset, n_global, n_local,
+                slice );
+    writeFields( h5_config, file_id, dxpl_id, n_offset, n_global, n_local,
+                 fields... );
+}
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Write particle fields to one parallel HDF5 file per time step.
+
+  Every slice is written as a (global particle, component) dataset named by
+  the slice label, with each rank's particles at its prefix-sum offset. All
+  ranks write into the same file through MPI-IO, collectively by default.
+  The time and step are stored as attributes of the root group.
+
+  \param h5_config HDF5 access configuration.
+  \param prefix File name prefix. The file is <prefix>_<step>.h5.
+  \param comm The communicator of all ranks holding particles.
+  \param step The time step index.
+  \param time The time of the step.
+  \param n_local The number of particles to write from this rank.
+  \param fields The labeled slices to write.
+*/
+template <class... FieldSliceTypes>
+void writeTimeStep( const HDF5Config& h5_config, const std::string& prefix,
+                    MPI_Comm comm, const int step, const double time,
+                    const std::size_t n_local,
+                    const FieldSliceTypes&... fields )
+{
+    static_assert( sizeof...( FieldSliceTypes ) > 0,
+                   "At least one slice must be written" );
+
+    // Get the offset of this rank in the global particle order.
+    unsigned long long n_count = n_local;
+    unsigned long long n_offset = 0;
+    unsigned long long n_global = 0;
+    MPI_Exscan( &n_count, &n_offset, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM,
+                comm );
+    MPI_Allreduce( &n_count, &n_global, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM,
+                   comm );
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    if ( 0 == comm_rank )
+        n_offset = 0;
+
+    hid_t fapl_id = Impl::fileAccess( h5_config, comm );
+    std::string filename = Impl::fileName( prefix, step );
+    hid_t file_id =
+        H5Fcreate( filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, fapl_id );
+    if ( file_id < 0 )
+        throw std::runtime_error( "HDF5 error creating " + filename );
+
+    // Store the time step information.
+    hid_t attr_space_id = H5Screate( H5S_SCALAR );
+    hid_t attr_id = H5Acreate( file_id, "Time", H5T_NATIVE_DOUBLE,
+                               attr_space_id, H5P_DEFAULT, H5P_DEFAULT );
+    H5Awrite( attr_id, H5T_NATIVE_DOUBLE, &time );
+    H5Aclose( attr_id );
+    attr_id = H5Acreate( file_id, "Step", H5T_NATIVE_INT, attr_space_id,
+                         H5P_DEFAULT, H5P_DEFAULT );
+    H5Awrite( attr_id, H5T_NATIVE_INT, &step );
+    H5Aclose( attr_id );
+    H5Sclose( attr_space_id );
+
+    hid_t dxpl_id = Impl::dataTransfer( h5_config );
+    Impl::writeFields( h5_config, file_id, dxpl_id, n_offset, n_global,
+                       n_local, fields... );
+
+    H5Pclose( dxpl_id );
+    H5Fclose( file_id );
+    H5Pclose( fapl_id );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Get the global number of particles of a dataset written by
+  writeTimeStep.
+
+  Reading initial conditions in parallel, every rank can read the range
+  given by Cabana::IO::localRange() of this number with readTimeStep().
+
+  \param h5_config HDF5 access configuration.
+  \param prefix File name prefix. The file is <prefix>_<step>.h5.
+  \param comm The communicator of all ranks reading the file.
+  \param step The time step index.
+  \param dataset_name The name of the dataset.
+  \return The global number of particles.
+*/
+inline std::size_t numParticles( const HDF5Config& h5_config,
+                                 const std::string& prefix, MPI_Comm comm,
+                                 const int step,
+                                 const std::string& dataset_name )
+{
+    hid_t fapl_id = Impl::fileAccess( h5_config, comm );
+    std::string filename = Impl::fileName( prefix, step );
+    hid_t file_id = H5Fopen( filename.c_str(), H5F_ACC_RDONLY, fapl_id );
+    if ( file_id < 0 )
+        throw std::runtime_error( "HDF5 error opening " + filename );
+    hid_t dset_id = H5Dopen( file_id, dataset_name.c_str(), H5P_DEFAULT );
+    if ( dset_id < 0 )
+        throw std::runtime_error( "HDF5 error opening dataset " +
+                                  dataset_name );
+    hid_t filespace_id = H5Dget_space( dset_id );
+    hsize_t dims_global[2];
+    H5Sget_simple_extent_dims( filespace_id, dims_global, nullptr );
+
+    H5Sclose( filespace_id );
+    H5Dclose( dset_id );
+    H5Fclose( file_id );
+    H5Pclose( fapl_id );
+    return dims_global[0];
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Read a particle field written by writeTimeStep.
+
+  Each rank reads the next n_local particles of the global particle order,
+  so reading with the same particle counts per rank restores a checkpoint.
+
+  \param h5_config HDF5 access configuration.
+  \param prefix File name prefix. The file is <prefix>_<step>.h5.
+  \param comm The communicator of all ranks holding particles.
+  \param step The time step index.
+  \param n_local The number of particles to read into this rank.
+  \param dataset_name The name of the dataset to read.
+  \param time The time of the step.
+  \param field The slice to read into. It must hold at least n_local
+  particles with the same number of values per particle as the dataset.
+*/
+template <class FieldSliceType>
+void readTimeStep( const HDF5Config& h5_config, const std::string& prefix,
+                   MPI_Comm comm, const int step, const std::size_t n_local,
+                   const std::string& dataset_name, double& time,
+                   FieldSliceType& field )
+{
+    using value_type = typename FieldSliceType::value_type;
+    using memory_space = typename FieldSliceType::memory_space;
+
+    unsigned long long n_count = n_local;
+    unsigned long long n_offset = 0;
+    MPI_Exscan( &n_count, &n_offset, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM,
+                comm );
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    if ( 0 == comm_rank )
+        n_offset = 0;
+
+    hid_t fapl_id = Impl::fileAccess( h5_config, comm );
+    std::string filename = Impl::fileName( prefix, step );
+    hid_t file_id = H5Fopen( filename.c_str(), H5F_ACC_RDONLY, fapl_id );
+    if ( file_id < 0 )
+        throw std::runtime_error( "HDF5 error opening " + filename );
+
+    hid_t attr_id = H5Aopen( file_id, "Time", H5P_DEFAULT );
+    H5Aread( attr_id, H5T_NATIVE_DOUBLE, &time );
+    H5Aclose( attr_id );
+
+    hid_t dset_id = H5Dopen( file_id, dataset_name.c_str(), H5P_DEFAULT );
+    if ( dset_id < 0 )
+        throw std::runtime_error( "HDF5 error opening dataset " +
+                                  dataset_name );
+    hid_t filespace_id = H5Dget_space( dset_id );
+    hsize_t dims_global[2];
+    H5Sget_simple_extent_dims( filespace_id, dims_global, nullptr );
+    const std::size_t num_comp = Impl::componentCount( field );
+    if ( dims_global[1] != num_comp )
+        throw std::logic_error( "HDF5 dataset " + dataset_name +
+                                " does not match the slice extents" );
+    if ( n_offset + n_local > dims_global[0] )
+        throw std::logic_error( "HDF5 dataset " + dataset_name +
+                                " has fewer particles than requested" );
+
+    auto host_view = Kokkos::View<value_type**, Kokkos::LayoutRight,
+                                  Kokkos::HostSpace>(
+        Kokkos::ViewAllocateWithoutInitializing( dataset_name ), n_local,
+        num_comp );
+    hsize_t dims_local[2] = { n_local, num_comp };
+    hsize_t offset[2] = { n_offset, 0 };
+    hid_t memspace_id = H5Screate_simple( 2, dims_local, nullptr );
+    Impl::selectLocal( filespace_id, memspace_id, offset, dims_local );
+    hid_t dxpl_id = Impl::dataTransfer( h5_config );
+    Impl::checkHDF5( H5Dread( dset_id, Impl::HDF5Traits<value_type>::type(),
+                              memspace_id, filespace_id, dxpl_id,
+                              host_view.data() ),
+                     "H5Dread " + dataset_name );
+
+    H5Pclose( dxpl_id );
+    H5Sclose( memspace_id );
+    H5Sclose( filespace_id );
+    H5Dclose( dset_id );
+    H5Fclose( file_id );
+    H5Pclose( fapl_id );
+
+    auto view = Kokkos::create_mirror_view_and_copy( memory_space(),
+                                                     host_view );
+    Impl::copyViewToSlice( view, n_local, field );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace HDF5ParticleOutput
+} // end namespace Experimental
+} // end namespace Cabana
+
+#endif // end CABANA_HDF5PARTICLEIO_HPP
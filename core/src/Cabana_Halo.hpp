@@ -18,17 +18,157 @@
 
 #include <Cabana_AoSoA.hpp>
 #include <Cabana_CommunicationPlan.hpp>
+#include <Cabana_GroupedAoSoA.hpp>
 #include <Cabana_Slice.hpp>
+#include <impl/Cabana_CommunicationPacking.hpp>
+#include <impl/Cabana_Profiling.hpp>
 
 #include <Kokkos_Core.hpp>
 
 #include <mpi.h>
 
+#include <cstdlib>
 #include <exception>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace Cabana
 {
+namespace Impl
+{
+//! \cond Impl
+//---------------------------------------------------------------------------//
+// Persistent, grow-only communication buffers. Buffers are stored as raw
+// bytes so the same allocation can be reused by gather and scatter operations
+// on any data type. Memory is only reallocated when a request exceeds the
+// current capacity. While a split-phase operation is in flight the buffers
+// are locked and any other operation will instead get temporary buffers.
+// Host buffers are only allocated if messages are staged through the host.
+template <class MemorySpace>
+class HaloBuffers
+{
+  public:
+    using memory_space = MemorySpace;
+    using buffer_type = Kokkos::View<char*, memory_space>;
+    using staging_space = typename CommStagingSpace<memory_space>::type;
+    using host_buffer_type = Kokkos::View<char*, staging_space>;
+
+    // Get a send buffer with a capacity of at least the given number of
+    // bytes.
+    buffer_type sendBuffer( const std::size_t num_bytes )
+    {
+        return get( _send_buffer, num_bytes, "halo_send_buffer" );
+    }
+
+    // Get a receive buffer with a capacity of at least the given number of
+    // bytes.
+    buffer_type recvBuffer( const std::size_t num_bytes )
+    {
+        return get( _recv_buffer, num_bytes, "halo_recv_buffer" );
+    }
+
+    // Get a host send staging buffer with a capacity of at least the given
+    // number of bytes.
+    host_buffer_type hostSendBuffer( const std::size_t num_bytes )
+    {
+        return get( _host_send_buffer, num_bytes, "halo_host_send_buffer" );
+    }
+
+    // Get a host receive staging buffer with a capacity of at least the given
+    // number of bytes.
+    host_buffer_type hostRecvBuffer( const std::size_t num_bytes )
+    {
+        return get( _host_recv_buffer, num_bytes, "halo_host_recv_buffer" );
+    }
+
+    // Get the current send buffer capacity in bytes.
+    std::size_t sendCapacity() const { return _send_buffer.size(); }
+
+    // Get the current receive buffer capacity in bytes.
+    std::size_t recvCapacity() const { return _recv_buffer.size(); }
+
+    // Lock the buffers for use by an operation in flight.
+    void lock() { _locked = true; }
+
+    // Unlock the buffers.
+    void unlock() { _locked = false; }
+
+    // Determine if the buffers are locked.
+    bool locked() const { return _locked; }
+
+    // Release all buffer memory.
+    void release()
+    {
+        _send_buffer = buffer_type();
+        _recv_buffer = buffer_type();
+        _host_send_buffer = host_buffer_type();
+        _host_recv_buffer = host_buffer_type();
+    }
+
+  private:
+    template <class Buffer>
+    Buffer get( Buffer& buffer, const std::size_t num_bytes,
+                const std::string& label )
+    {
+        // If the buffers are in use by another operation allocate a
+        // temporary.
+        if ( _locked )
+            return Buffer( Kokkos::ViewAllocateWithoutInitializing( label ),
+                           num_bytes );
+
+        if ( buffer.size() < num_bytes )
+        {
+            // Free the old buffer before allocating the new one to reduce the
+            // peak memory footprint.
+            buffer = Buffer();
+            buffer = Buffer( Kokkos::ViewAllocateWithoutInitializing( label ),
+                             num_bytes );
+        }
+        return buffer;
+    }
+
+  private:
+    buffer_type _send_buffer;
+    buffer_type _recv_buffer;
+    host_buffer_type _host_send_buffer;
+    host_buffer_type _host_recv_buffer;
+    bool _locked = false;
+};
+
+//---------------------------------------------------------------------------//
+// Get an unmanaged, typed, 1D view of a raw communication buffer.
+template <class T, class MemorySpace>
+Kokkos::View<T*, MemorySpace, Kokkos::MemoryTraits<Kokkos::Unmanaged>>
+typedBuffer( const Kokkos::View<char*, MemorySpace>& buffer,
+             const std::size_t n )
+{
+    return Kokkos::View<T*, MemorySpace,
+                        Kokkos::MemoryTraits<Kokkos::Unmanaged>>(
+        reinterpret_cast<T*>( buffer.data() ), n );
+}
+
+//---------------------------------------------------------------------------//
+// Get an unmanaged, typed, 2D layout-right view of a raw communication buffer
+// such that the components of each element are consecutive.
+template <class T, class MemorySpace>
+Kokkos::View<T**, Kokkos::LayoutRight, MemorySpace,
+             Kokkos::MemoryTraits<Kokkos::Unmanaged>>
+typedBuffer( const Kokkos::View<char*, MemorySpace>& buffer,
+             const std::size_t n, const std::size_t num_comp )
+{
+    return Kokkos::View<T**, Kokkos::LayoutRight, MemorySpace,
+                        Kokkos::MemoryTraits<Kokkos::Unmanaged>>(
+        reinterpret_cast<T*>( buffer.data() ), n, num_comp );
+}
+
+//---------------------------------------------------------------------------//
+//! \endcond
+} // end namespace Impl
+
 //---------------------------------------------------------------------------//
 /*!
   \brief A communication plan for scattering and gathering of ghosted data.
@@ -53,11 +193,22 @@ namespace Cabana
   Import - the ghost data that we get from other ranks. The rank we get a
   ghost from is the unique owner of that data. Import is used in the context
   of the forward communication plan (the gather).
+
+  The halo owns persistent send and receive buffers which are reused by every
+  scatter and gather operation performed with it. These buffers only grow
+  when an operation requires more memory than is currently allocated. Copies
+  of a halo share the same buffers.
 */
 template <class DeviceType>
 class Halo : public CommunicationPlan<DeviceType>
 {
   public:
+    //! Memory space.
+    using memory_space = typename CommunicationPlan<DeviceType>::memory_space;
+
+    //! Persistent communication buffer type.
+    using buffers_type = Impl::HaloBuffers<memory_space>;
+
     /*!
       \brief Neighbor and export rank constructor. Use this when you already
       know which ranks neighbor each other (i.e. every rank already knows who
@@ -105,7 +256,11 @@ class Halo : public CommunicationPlan<DeviceType>
           const std::vector<int>& neighbor_ranks )
         : CommunicationPlan<DeviceType>( comm )
         , _num_local( num_local )
+        , _buffers( std::make_shared<buffers_type>() )
+        , _gather_precision( CommPrecision::Full )
     {
+        Impl::ScopedProfileRegion region( "Cabana::Halo::Halo" );
+
         if ( element_export_ids.size() != element_export_ranks.size() )
             throw std::runtime_error( "Export ids and ranks different sizes!" );
 
@@ -154,7 +309,11 @@ class Halo : public CommunicationPlan<DeviceType>
           const RankViewType& element_export_ranks )
         : CommunicationPlan<DeviceType>( comm )
         , _num_local( num_local )
+        , _buffers( std::make_shared<buffers_type>() )
+        , _gather_precision( CommPrecision::Full )
     {
+        Impl::ScopedProfileRegion region( "Cabana::Halo::Halo" );
+
         if ( element_export_ids.size() != element_export_ranks.size() )
             throw std::runtime_error( "Export ids and ranks different sizes!" );
 
@@ -163,6 +322,46 @@ class Halo : public CommunicationPlan<DeviceType>
                                     element_export_ids );
     }
 
+    /*!
+      \brief Update the halo for a new set of exports. The current topology
+      is reused if all of the new exports are sent to existing
+      neighbors. Otherwise, the topology is recomputed as in the export rank
+      constructor. The persistent communication buffers are kept.
+
+      \tparam IdViewType The container type for the export element ids. This
+      container type can be either a Kokkos View or a Cabana Slice.
+
+      \tparam RankViewType The container type for the export element
+      ranks. This container type can be either a Kokkos View or a Cabana
+      Slice.
+
+      \param num_local The number of locally-owned elements on this rank.
+
+      \param element_export_ids The local ids of the elements that will be
+      sent to other ranks to be used as ghosts. Must be the same length as
+      element_export_ranks.
+
+      \param element_export_ranks The ranks to which we will export each
+      element in element_export_ids.
+
+      \note This is a collective operation over the halo communicator.
+    */
+    template <class IdViewType, class RankViewType>
+    void update( const std::size_t num_local,
+                 const IdViewType& element_export_ids,
+                 const RankViewType& element_export_ranks )
+    {
+        Impl::ScopedProfileRegion region( "Cabana::Halo::update" );
+
+        if ( element_export_ids.size() != element_export_ranks.size() )
+            throw std::runtime_error( "Export ids and ranks different sizes!" );
+
+        _num_local = num_local;
+        auto neighbor_ids = this->updateFromExports( element_export_ranks );
+        this->createExportSteering( neighbor_ids, element_export_ranks,
+                                    element_export_ids );
+    }
+
     /*!
       \brief Get the number of elements locally owned by this rank.
 
@@ -179,8 +378,43 @@ class Halo : public CommunicationPlan<DeviceType>
     */
     std::size_t numGhost() const { return this->totalNumImport(); }
 
+    /*!
+      \brief Get the persistent communication buffers used by the scatter and
+      gather operations of this halo.
+
+      \return The communication buffers of this halo.
+    */
+    buffers_type& buffers() const { return *_buffers; }
+
+    /*!
+      \brief Release the memory held by the persistent communication
+      buffers. The buffers will be reallocated by the next scatter or gather.
+    */
+    void releaseBuffers() const { _buffers->release(); }
+
+    /*!
+      \brief Set the precision of the data sent by slice gathers performed
+      with this halo. AoSoA and multiple slice gathers as well as scatters
+      always send full precision data.
+
+      \param precision The gather precision. All ranks must use the same
+      precision.
+    */
+    void setGatherPrecision( const CommPrecision precision )
+    {
+        _gather_precision = precision;
+    }
+
+    /*!
+      \brief Get the precision of the data sent by slice gathers.
+      \return The gather precision.
+    */
+    CommPrecision gatherPrecision() const { return _gather_precision; }
+
   private:
     std::size_t _num_local;
+    std::shared_ptr<buffers_type> _buffers;
+    CommPrecision _gather_precision;
 };
 
 //---------------------------------------------------------------------------//
@@ -204,272 +438,1293 @@ struct is_halo : public is_halo_impl<typename std::remove_cv<T>::type>::type
 
 //---------------------------------------------------------------------------//
 /*!
-  \brief Synchronously gather data from the local decomposition to the ghosts
-  using the halo forward communication plan. AoSoA version. This is a
-  uniquely-owned to multiply-owned communication.
-
-  A gather sends data from a locally owned elements to one or many ranks on
-  which they exist as ghosts. A locally owned element may be sent to as many
-  ranks as desired to be used as a ghost on those ranks. The value of the
-  element in the locally owned decomposition will be the value assigned to the
-  element in the ghosted decomposition.
-
-  \tparam Halo_t Halo type - must be a Halo.
+  \brief Handle for a split-phase halo communication.
 
-  \tparam AoSoA_t AoSoA type - must be an AoSoA.
-
-  \param halo The halo to use for the gather.
+  A request is returned by the split-phase halo operations (e.g. gatherStart)
+  after the local data has been packed and all sends and receives have been
+  posted. Calling finish() waits on the communication and unpacks the received
+  data. Work that does not depend on the ghosted data may be performed between
+  starting the operation and finishing it.
 
-  \param aosoa The AoSoA on which to perform the gather. The AoSoA should have
-  a size equivalent to halo.numGhost() + halo.numLocal(). The locally owned
-  elements are expected to appear first (i.e. in the first halo.numLocal()
-  elements) and the ghosted elements are expected to appear second (i.e. in
-  the next halo.numGhost() elements()).
+  \note Requests may be moved but not copied. A request that is destroyed
+  before it is finished will complete the communication in its destructor.
 */
-template <class Halo_t, class AoSoA_t>
-void gather( const Halo_t& halo, AoSoA_t& aosoa,
-             typename std::enable_if<( is_halo<Halo_t>::value &&
-                                       is_aosoa<AoSoA_t>::value ),
-                                     int>::type* = 0 )
+class HaloRequest
 {
-    // Check that the AoSoA is the right size.
-    if ( aosoa.size() != halo.numLocal() + halo.numGhost() )
-        throw std::runtime_error( "AoSoA is the wrong size for gather!" );
+  public:
+    //! Default constructor. Creates an inactive request.
+    HaloRequest()
+        : _active( false )
+    {
+    }
 
-    // Allocate a send buffer.
-    Kokkos::View<typename AoSoA_t::tuple_type*, typename Halo_t::memory_space>
-        send_buffer(
-            Kokkos::ViewAllocateWithoutInitializing( "halo_send_buffer" ),
-            halo.totalNumExport() );
+    /*!
+      \brief Constructor.
 
-    // Get the steering vector for the sends.
-    auto steering = halo.getExportSteering();
+      \param requests The outstanding MPI requests of the operation.
 
-    // Gather from the local data into a tuple-contiguous send buffer.
-    auto gather_send_buffer_func = KOKKOS_LAMBDA( const std::size_t i )
-    {
-        send_buffer( i ) = aosoa.getTuple( steering( i ) );
-    };
-    Kokkos::RangePolicy<typename Halo_t::execution_space>
-        gather_send_buffer_policy( 0, halo.totalNumExport() );
-    Kokkos::parallel_for( "Cabana::gather::gather_send_buffer",
-                          gather_send_buffer_policy, gather_send_buffer_func );
-    Kokkos::fence();
+      \param unpack Function to call when the MPI requests are complete.
 
-    // Allocate a receive buffer.
-    Kokkos::View<typename AoSoA_t::tuple_type*, typename Halo_t::memory_space>
-        recv_buffer(
-            Kokkos::ViewAllocateWithoutInitializing( "halo_recv_buffer" ),
-            halo.totalNumImport() );
+      \param release Function to call after the unpack or if the
+      communication fails, releasing the resources of the operation.
 
-    // The halo has it's own communication space so choose any mpi tag.
-    const int mpi_tag = 2345;
+      \param stats Statistics in which to record the time spent waiting on
+      the requests. May be nullptr.
 
-    // Post non-blocking receives.
-    int num_n = halo.numNeighbor();
-    std::vector<MPI_Request> requests( num_n );
-    std::pair<std::size_t, std::size_t> recv_range = { 0, 0 };
-    for ( int n = 0; n < num_n; ++n )
+      \param progress Progress thread driving the requests until the
+      operation is finished. May be nullptr.
+    */
+    HaloRequest( std::vector<MPI_Request>&& requests,
+                 std::function<void()>&& unpack,
+                 std::function<void()>&& release,
+                 const std::shared_ptr<CommStatistics>& stats = nullptr,
+                 const std::shared_ptr<CommProgress>& progress = nullptr )
+        : _requests( std::move( requests ) )
+        , _unpack( std::move( unpack ) )
+        , _release( std::move( release ) )
+        , _stats( stats )
+        , _progress( progress )
+        , _active( true )
     {
-        recv_range.second = recv_range.first + halo.numImport( n );
-
-        auto recv_subview = Kokkos::subview( recv_buffer, recv_range );
-
-        MPI_Irecv( recv_subview.data(),
-                   recv_subview.size() * sizeof( typename AoSoA_t::tuple_type ),
-                   MPI_BYTE, halo.neighborRank( n ), mpi_tag, halo.comm(),
-                   &( requests[n] ) );
+        if ( _progress )
+            _progress->begin();
+    }
 
-        recv_range.first = recv_range.second;
+    //! Move constructor.
+    HaloRequest( HaloRequest&& other )
+        : _requests( std::move( other._requests ) )
+        , _unpack( std::move( other._unpack ) )
+        , _release( std::move( other._release ) )
+        , _stats( std::move( other._stats ) )
+        , _progress( std::move( other._progress ) )
+        , _active( other._active )
+    {
+        other._active = false;
     }
 
-    // Do blocking sends.
-    std::pair<std::size_t, std::size_t> send_range = { 0, 0 };
-    for ( int n = 0; n < num_n; ++n )
+    //! Move assignment.
+    HaloRequest& operator=( HaloRequest&& other )
     {
-        send_range.second = send_range.first + halo.numExport( n );
+        if ( this != &other )
+        {
+            if ( _active )
+                finish();
+            _requests = std::move( other._requests );
+            _unpack = std::move( other._unpack );
+            _release = std::move( other._release );
+            _stats = std::move( other._stats );
+            _progress = std::move( other._progress );
+            _active = other._active;
+            other._active = false;
+        }
+        return *this;
+    }
 
-        auto send_subview = Kokkos::subview( send_buffer, send_range );
+    HaloRequest( const HaloRequest& ) = delete;
+    HaloRequest& operator=( const HaloRequest& ) = delete;
 
-        MPI_Send( send_subview.data(),
-                  send_subview.size() * sizeof( typename AoSoA_t::tuple_type ),
-                  MPI_BYTE, halo.neighborRank( n ), mpi_tag, halo.comm() );
+    /*!
+      \brief Destructor. Completes the operation if it is still in flight.
 
-        send_range.first = send_range.second;
+      A destructor can not report a failed completion by throwing, and the
+      buffers of failed communication can not be released safely, so a
+      failure here aborts with a message. Call finish() explicitly to handle
+      communication errors.
+    */
+    ~HaloRequest()
+    {
+        if ( !_active )
+            return;
+        try
+        {
+            finish();
+        }
+        catch ( const std::exception& e )
+        {
+            std::cerr << "Cabana::HaloRequest: completing the request in its "
+                         "destructor failed: "
+                      << e.what() << std::endl;
+            std::abort();
+        }
     }
 
-    // Wait on non-blocking receives.
-    std::vector<MPI_Status> status( num_n );
-    const int ec =
-        MPI_Waitall( requests.size(), requests.data(), status.data() );
-    if ( MPI_SUCCESS != ec )
-        throw std::logic_error( "Failed MPI Communication" );
+    /*!
+      \brief Determine if the operation is still in flight.
 
-    // Extract the receive buffer into the ghosted elements.
-    std::size_t num_local = halo.numLocal();
-    auto extract_recv_buffer_func = KOKKOS_LAMBDA( const std::size_t i )
+      \return True if the operation has been started but not finished.
+    */
+    bool active() const { return _active; }
+
+    /*!
+      \brief Wait for the communication to complete and unpack the received
+      data. This is a no-op if the request is not active. If the
+      communication fails the halo buffers are unlocked and an exception is
+      thrown.
+    */
+    void finish()
     {
-        std::size_t ghost_idx = i + num_local;
-        aosoa.setTuple( ghost_idx, recv_buffer( i ) );
-    };
-    Kokkos::RangePolicy<typename Halo_t::execution_space>
-        extract_recv_buffer_policy( 0, halo.totalNumImport() );
-    Kokkos::parallel_for( "Cabana::gather::extract_recv_buffer",
-                          extract_recv_buffer_policy,
-                          extract_recv_buffer_func );
-    Kokkos::fence();
+        if ( !_active )
+            return;
+
+        Impl::ScopedProfileRegion region( "Cabana::gatherFinish" );
+
+        // Mark the request as complete first so it is not finished twice if
+        // communication fails.
+        _active = false;
+
+        // Wait on all sends and receives.
+        Impl::CommWait comm_wait( "Cabana::Halo::wait", _stats.get() );
+        std::vector<MPI_Status> status( _requests.size() );
+        const int ec =
+            MPI_Waitall( _requests.size(), _requests.data(), status.data() );
+        comm_wait.stop();
+        if ( _progress )
+            _progress->end();
+        auto unpack = std::move( _unpack );
+        _unpack = std::function<void()>();
+        auto release = std::move( _release );
+        _release = std::function<void()>();
+
+        // Release the resources of the operation before reporting a failure
+        // so a failed request does not keep the shared halo buffers locked.
+        if ( MPI_SUCCESS != ec )
+        {
+            release();
+            throw std::logic_error( "Failed MPI Communication" );
+        }
+
+        // Unpack.
+        Kokkos::Profiling::pushRegion( "Cabana::Halo::unpack" );
+        unpack();
+        Kokkos::Profiling::popRegion();
+        release();
+    }
 
-    // Barrier before completing to ensure synchronization.
-    MPI_Barrier( halo.comm() );
-}
+  private:
+    std::vector<MPI_Request> _requests;
+    std::function<void()> _unpack;
+    std::function<void()> _release;
+    std::shared_ptr<CommStatistics> _stats;
+    std::shared_ptr<CommProgress> _progress;
+    bool _active;
+};
 
 //---------------------------------------------------------------------------//
 /*!
-  \brief Synchronously gather data from the local decomposition to the ghosts
-  using the halo forward communication plan. Slice version. This is a
-  uniquely-owned to multiply-owned communication.
-
-  A gather sends data from a locally owned elements to one or many ranks on
-  which they exist as ghosts. A locally owned element may be sent to as many
-  ranks as desired to be used as a ghost on those ranks. The value of the
-  element in the locally owned decomposition will be the value assigned to the
-  element in the ghosted decomposition.
-
-  \tparam Halo_t Halo type - must be a Halo.
-
-  \tparam Slice_t Slice type - must be a Slice.
-
-  \param halo The halo to use for the gather.
+  \brief Complete a split-phase halo operation.
 
-  \param slice The Slice on which to perform the gather. The Slice should have
-  a size equivalent to halo.numGhost() + halo.numLocal(). The locally owned
-  elements are expected to appear first (i.e. in the first halo.numLocal()
-  elements) and the ghosted elements are expected to appear second (i.e. in
-  the next halo.numGhost() elements()).
+  \param request The request returned when starting the operation.
 */
-template <class Halo_t, class Slice_t>
-void gather( const Halo_t& halo, Slice_t& slice,
-             typename std::enable_if<( is_halo<Halo_t>::value &&
-                                       is_slice<Slice_t>::value ),
-                                     int>::type* = 0 )
-{
-    // Check that the Slice is the right size.
-    if ( slice.size() != halo.numLocal() + halo.numGhost() )
-        throw std::runtime_error( "Slice is the wrong size for gather!" );
+inline void gatherFinish( HaloRequest& request ) { request.finish(); }
 
-    // Get the number of components in the slice.
-    std::size_t num_comp = 1;
-    for ( std::size_t d = 2; d < slice.rank(); ++d )
-        num_comp *= slice.extent( d );
+//---------------------------------------------------------------------------//
+namespace Impl
+{
+//! \cond Impl
+//---------------------------------------------------------------------------//
+// Create the communication staging for a halo operation with the given
+// number of bytes to send and receive. If the halo stages messages through
+// the host the persistent host buffers of the halo are used and the staging
+// copy is enqueued on the given execution space instance.
+template <class ExecutionSpace, class Halo_t, class Buffer>
+CommStaging<typename Halo_t::memory_space>
+createHaloStaging( const ExecutionSpace& exec_space, const Halo_t& halo,
+                   const Buffer& send_buffer, const std::size_t send_bytes,
+                   const Buffer& recv_buffer, const std::size_t recv_bytes )
+{
+    using staging_type = CommStaging<typename Halo_t::memory_space>;
+    if ( !halo.stageMessages( send_bytes + recv_bytes ) )
+        return staging_type( send_buffer, recv_buffer );
+    return staging_type( exec_space, send_buffer,
+                         send_bytes, recv_buffer, recv_bytes,
+                         halo.buffers().hostSendBuffer( send_bytes ),
+                         halo.buffers().hostRecvBuffer( recv_bytes ) );
+}
 
-    // Get the raw slice data.
-    auto slice_data = slice.data();
+//---------------------------------------------------------------------------//
+// Post the receives and sends for a halo operation. The send and receive
+// data of the staging are expected to be contiguous by neighbor with elements
+// of the given size in bytes. Forward operations receive imports and send
+// exports while reverse operations do the opposite.
+template <class Halo_t, class Staging>
+std::vector<MPI_Request>
+postHaloMessages( const Halo_t& halo, const bool forward,
+                  const Staging& staging, const std::size_t element_bytes )
+{
+    recordCommOperation( halo, forward, element_bytes );
 
-    // Allocate a send buffer. Note this one is layout right so the components
-    // are consecutive.
-    Kokkos::View<typename Slice_t::value_type**, Kokkos::LayoutRight,
-                 typename Halo_t::memory_space>
-        send_buffer(
-            Kokkos::ViewAllocateWithoutInitializing( "halo_send_buffer" ),
-            halo.totalNumExport(), num_comp );
+    char* send_data = staging.sendData();
+    char* recv_data = staging.recvData();
 
-    // Get the steering vector for the sends.
-    auto steering = halo.getExportSteering();
+    int num_n = halo.numNeighbor();
 
-    // Gather from the local data into a tuple-contiguous send buffer.
-    auto gather_send_buffer_func = KOKKOS_LAMBDA( const std::size_t i )
+    // Exchange with a single neighborhood collective or through node shared
+    // memory if requested.
+    if ( CommBackend::PointToPoint != halo.backend() )
     {
-        auto s = Slice_t::index_type::s( steering( i ) );
-        auto a = Slice_t::index_type::a( steering( i ) );
-        std::size_t slice_offset = s * slice.stride( 0 ) + a;
-        for ( std::size_t n = 0; n < num_comp; ++n )
-            send_buffer( i, n ) =
-                slice_data[slice_offset + n * Slice_t::vector_length];
-    };
-    Kokkos::RangePolicy<typename Halo_t::execution_space>
-        gather_send_buffer_policy( 0, halo.totalNumExport() );
-    Kokkos::parallel_for( "Cabana::gather::gather_send_buffer",
-                          gather_send_buffer_policy, gather_send_buffer_func );
-    Kokkos::fence();
-
-    // Allocate a receive buffer. Note this one is layout right so the
-    // components are consecutive.
-    Kokkos::View<typename Slice_t::value_type**, Kokkos::LayoutRight,
-                 typename Halo_t::memory_space>
-        recv_buffer(
-            Kokkos::ViewAllocateWithoutInitializing( "halo_recv_buffer" ),
-            halo.totalNumImport(), num_comp );
+        std::vector<int> send_counts( num_n );
+        std::vector<int> send_displs( num_n, 0 );
+        std::vector<int> recv_counts( num_n );
+        std::vector<int> recv_displs( num_n, 0 );
+        for ( int n = 0; n < num_n; ++n )
+        {
+            send_counts[n] =
+                element_bytes *
+                ( ( forward ) ? halo.numExport( n ) : halo.numImport( n ) );
+            recv_counts[n] =
+                element_bytes *
+                ( ( forward ) ? halo.numImport( n ) : halo.numExport( n ) );
+            if ( n > 0 )
+            {
+                send_displs[n] = send_displs[n - 1] + send_counts[n - 1];
+                recv_displs[n] = recv_displs[n - 1] + recv_counts[n - 1];
+            }
+        }
+        // The node shared exchange completes before returning.
+        if ( CommBackend::NodeShared == halo.backend() )
+        {
+            exchangeNodeShared( halo, send_data, send_counts, send_displs,
+                                recv_data, recv_counts, recv_displs );
+            return std::vector<MPI_Request>();
+        }
+        return std::vector<MPI_Request>(
+            1, postNeighborAlltoallv( halo, send_data, send_counts,
+                                      send_displs, recv_data, recv_counts,
+                                      recv_displs ) );
+    }
 
     // The halo has it's own communication space so choose any mpi tag.
     const int mpi_tag = 2345;
 
+    std::vector<MPI_Request> requests( 2 * num_n );
+
     // Post non-blocking receives.
-    int num_n = halo.numNeighbor();
-    std::vector<MPI_Request> requests( num_n );
-    std::pair<std::size_t, std::size_t> recv_range = { 0, 0 };
+    std::size_t recv_offset = 0;
     for ( int n = 0; n < num_n; ++n )
     {
-        recv_range.second = recv_range.first + halo.numImport( n );
-
-        auto recv_subview =
-            Kokkos::subview( recv_buffer, recv_range, Kokkos::ALL );
-
-        MPI_Irecv( recv_subview.data(),
-                   recv_subview.size() * sizeof( typename Slice_t::value_type ),
+        std::size_t num_recv =
+            ( forward ) ? halo.numImport( n ) : halo.numExport( n );
+        MPI_Irecv( recv_data + recv_offset, num_recv * element_bytes,
                    MPI_BYTE, halo.neighborRank( n ), mpi_tag, halo.comm(),
                    &( requests[n] ) );
-
-        recv_range.first = recv_range.second;
+        recv_offset += num_recv * element_bytes;
     }
 
-    // Do blocking sends.
-    std::pair<std::size_t, std::size_t> send_range = { 0, 0 };
+    // Post non-blocking sends.
+    std::size_t send_offset = 0;
     for ( int n = 0; n < num_n; ++n )
     {
-        send_range.second = send_range.first + halo.numExport( n );
-
-        auto send_subview =
-            Kokkos::subview( send_buffer, send_range, Kokkos::ALL );
-
-        MPI_Send( send_subview.data(),
-                  send_subview.size() * sizeof( typename Slice_t::value_type ),
-                  MPI_BYTE, halo.neighborRank( n ), mpi_tag, halo.comm() );
-
-        send_range.first = send_range.second;
+        std::size_t num_send =
+            ( forward ) ? halo.numExport( n ) : halo.numImport( n );
+        MPI_Isend( send_data + send_offset, num_send * element_bytes,
+                   MPI_BYTE, halo.neighborRank( n ), mpi_tag, halo.comm(),
+                   &( requests[num_n + n] ) );
+        send_offset += num_send * element_bytes;
     }
 
-    // Wait on non-blocking receives.
-    std::vector<MPI_Status> status( num_n );
-    const int ec =
-        MPI_Waitall( requests.size(), requests.data(), status.data() );
-    if ( MPI_SUCCESS != ec )
-        throw std::logic_error( "Failed MPI Communication" );
+    return requests;
+}
+
+//---------------------------------------------------------------------------//
+// Extract a gather receive buffer into the ghosted elements. AoSoA version.
+template <class ExecutionSpace, class Halo_t, class AoSoA_t, class RecvBytes>
+void gatherUnpack( const ExecutionSpace& exec_space, const Halo_t& halo,
+                   AoSoA_t& aosoa,
+                   const RecvBytes& recv_bytes,
+                   typename std::enable_if<is_aosoa<AoSoA_t>::value,
+                                           int>::type* = 0 )
+{
+    auto recv_buffer = typedBuffer<typename AoSoA_t::tuple_type>(
+        recv_bytes, halo.totalNumImport() );
 
-    // Extract the receive buffer into the ghosted elements.
     std::size_t num_local = halo.numLocal();
     auto extract_recv_buffer_func = KOKKOS_LAMBDA( const std::size_t i )
     {
         std::size_t ghost_idx = i + num_local;
-        auto s = Slice_t::index_type::s( ghost_idx );
-        auto a = Slice_t::index_type::a( ghost_idx );
-        std::size_t slice_offset = s * slice.stride( 0 ) + a;
-        for ( std::size_t n = 0; n < num_comp; ++n )
-            slice_data[slice_offset + Slice_t::vector_length * n] =
-                recv_buffer( i, n );
+        aosoa.setTuple( ghost_idx, recv_buffer( i ) );
     };
-    Kokkos::RangePolicy<typename Halo_t::execution_space>
-        extract_recv_buffer_policy( 0, halo.totalNumImport() );
+    Kokkos::RangePolicy<ExecutionSpace> extract_recv_buffer_policy(
+        exec_space, 0, halo.totalNumImport() );
     Kokkos::parallel_for( "Cabana::gather::extract_recv_buffer",
                           extract_recv_buffer_policy,
                           extract_recv_buffer_func );
-    Kokkos::fence();
-
-    // Barrier before completing to ensure synchronization.
-    MPI_Barrier( halo.comm() );
+    exec_space.fence();
 }
 
 //---------------------------------------------------------------------------//
-/*!
+// Extract a gather receive buffer into the ghosted elements. Slice
+// version. The buffer holds the data with the given wire type.
+template <class WireType, class ExecutionSpace, class Halo_t, class Slice_t,
+          class RecvBytes>
+void gatherUnpack( const ExecutionSpace& exec_space, const Halo_t& halo,
+                   Slice_t& slice,
+                   const RecvBytes& recv_bytes,
+                   typename std::enable_if<is_slice<Slice_t>::value,
+                                           int>::type* = 0 )
+{
+    using value_type = typename Slice_t::value_type;
+
+    // Get the number of components in the slice.
+    std::size_t num_comp = 1;
+    for ( std::size_t d = 2; d < slice.rank(); ++d )
+        num_comp *= slice.extent( d );
+
+    // Get the raw slice data.
+    auto slice_data = slice.data();
+
+    auto recv_buffer =
+        typedBuffer<WireType>( recv_bytes, halo.totalNumImport(), num_comp );
+
+    std::size_t num_local = halo.numLocal();
+    auto extract_recv_buffer_func = KOKKOS_LAMBDA( const std::size_t i )
+    {
+        std::size_t ghost_idx = i + num_local;
+        auto s = Slice_t::index_type::s( ghost_idx );
+        auto a = Slice_t::index_type::a( ghost_idx );
+        std::size_t slice_offset = s * slice.stride( 0 ) + a;
+        for ( std::size_t n = 0; n < num_comp; ++n )
+            slice_data[slice_offset + Slice_t::vector_length * n] =
+                static_cast<value_type>( recv_buffer( i, n ) );
+    };
+    Kokkos::RangePolicy<ExecutionSpace> extract_recv_buffer_policy(
+        exec_space, 0, halo.totalNumImport() );
+    Kokkos::parallel_for( "Cabana::gather::extract_recv_buffer",
+                          extract_recv_buffer_policy,
+                          extract_recv_buffer_func );
+    exec_space.fence();
+}
+
+//---------------------------------------------------------------------------//
+// Start a split-phase gather of several slices. All slices are packed into a
+// single fused buffer such that only one message is sent to each neighbor.
+template <class Halo_t, class... Slices>
+HaloRequest gatherStartFused( const Halo_t& halo, const Slices&... slices )
+{
+    static_assert( is_halo<Halo_t>::value, "Halo type must be a Halo" );
+    static_assert( AllOf<is_slice, Slices...>::value,
+                   "Fused gather requires slices" );
+
+    using execution_space = typename Halo_t::execution_space;
+
+    // Compute the layout of each element in the fused buffers.
+    auto layout = createFusedRecordLayout( slices... );
+
+    // Get the send buffer and pack the local data into it.
+    auto send_bytes =
+        halo.buffers().sendBuffer( halo.totalNumExport() * layout.bytes );
+    packFusedSlices<execution_space>( halo.getExportSteering(), send_bytes,
+                                      layout, slices... );
+
+    // Get the receive buffer.
+    auto recv_bytes =
+        halo.buffers().recvBuffer( halo.totalNumImport() * layout.bytes );
+
+    // Stage the messages through the host if needed.
+    auto staging = createHaloStaging(
+        execution_space(), halo, send_bytes,
+        halo.totalNumExport() * layout.bytes, recv_bytes,
+        halo.totalNumImport() * layout.bytes );
+
+    // Lock the halo buffers while the messages are in flight. If they were
+    // already locked we got temporaries.
+    bool lock_buffers = !halo.buffers().locked();
+    if ( lock_buffers )
+        halo.buffers().lock();
+
+    // Post sends and receives.
+    auto requests = postHaloMessages( halo, true, staging, layout.bytes );
+
+    // Extract the receive buffer into the ghosted elements when finished. The
+    // staging is captured to keep the byte buffers alive until then.
+    auto unpack = [=]() mutable {
+        staging.finishRecv();
+        unpackFusedSlices<execution_space>( halo.numLocal(),
+                                            halo.totalNumImport(), recv_bytes,
+                                            layout, slices... );
+    };
+
+    // Unlock the halo buffers once the operation is complete or has failed.
+    auto release = [=]() {
+        if ( lock_buffers )
+            halo.buffers().unlock();
+    };
+
+    return HaloRequest( std::move( requests ), std::move( unpack ),
+                        std::move( release ), halo.statistics(),
+                        halo.progress() );
+}
+
+//---------------------------------------------------------------------------//
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Start a split-phase gather of data from the local decomposition to
+  the ghosts using the halo forward communication plan. AoSoA version.
+
+  The locally owned data is packed and all sends and receives are posted
+  before returning. The ghosted elements of the AoSoA are not updated until
+  finish() is called on the returned request. The locally owned elements of
+  the AoSoA must not be modified until then.
+
+  \tparam Halo_t Halo type - must be a Halo.
+
+  \tparam AoSoA_t AoSoA type - must be an AoSoA.
+
+  \param halo The halo to use for the gather.
+
+  \param aosoa The AoSoA on which to perform the gather. The AoSoA should have
+  a size equivalent to halo.numGhost() + halo.numLocal(). The locally owned
+  elements are expected to appear first (i.e. in the first halo.numLocal()
+  elements) and the ghosted elements are expected to appear second (i.e. in
+  the next halo.numGhost() elements()).
+
+  \return A request to finish the gather.
+
+  \note The packing and unpacking kernels are enqueued on the given execution
+  space instance which is fenced before the messages are posted and again
+  when the request is finished.
+*/
+template <class ExecutionSpace, class Halo_t, class AoSoA_t>
+HaloRequest
+gatherStart( const ExecutionSpace& exec_space, const Halo_t& halo,
+             AoSoA_t& aosoa,
+             typename std::enable_if<
+                 ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+                   is_halo<Halo_t>::value && is_aosoa<AoSoA_t>::value ),
+                 int>::type* = 0 )
+{
+    Impl::ScopedProfileRegion region( "Cabana::gatherStart" );
+
+    // Check that the AoSoA is the right size.
+    if ( aosoa.size() != halo.numLocal() + halo.numGhost() )
+        throw std::runtime_error( "AoSoA is the wrong size for gather!" );
+
+    using tuple_type = typename AoSoA_t::tuple_type;
+
+    // Get the send buffer.
+    auto send_bytes = halo.buffers().sendBuffer( halo.totalNumExport() *
+                                                 sizeof( tuple_type ) );
+    auto send_buffer =
+        Impl::typedBuffer<tuple_type>( send_bytes, halo.totalNumExport() );
+
+    // Get the steering vector for the sends.
+    auto steering = halo.getExportSteering();
+
+    // Gather from the local data into a tuple-contiguous send buffer.
+    auto gather_send_buffer_func = KOKKOS_LAMBDA( const std::size_t i )
+    {
+        send_buffer( i ) = aosoa.getTuple( steering( i ) );
+    };
+    Kokkos::RangePolicy<ExecutionSpace> gather_send_buffer_policy(
+        exec_space, 0, halo.totalNumExport() );
+    Kokkos::parallel_for( "Cabana::gather::gather_send_buffer",
+                          gather_send_buffer_policy, gather_send_buffer_func );
+    exec_space.fence();
+
+    // Get the receive buffer.
+    auto recv_bytes = halo.buffers().recvBuffer( halo.totalNumImport() *
+                                                 sizeof( tuple_type ) );
+
+    // Stage the messages through the host if needed.
+    auto staging = Impl::createHaloStaging(
+        exec_space, halo, send_bytes,
+        halo.totalNumExport() * sizeof( tuple_type ),
+        recv_bytes, halo.totalNumImport() * sizeof( tuple_type ) );
+
+    // Lock the halo buffers while the messages are in flight. If they were
+    // already locked we got temporaries.
+    bool lock_buffers = !halo.buffers().locked();
+    if ( lock_buffers )
+        halo.buffers().lock();
+
+    // Post sends and receives.
+    auto requests =
+        Impl::postHaloMessages( halo, true, staging, sizeof( tuple_type ) );
+
+    // Extract the receive buffer into the ghosted elements when finished. The
+    // staging is captured to keep the byte buffers alive until then.
+    auto unpack = [=]() mutable {
+        staging.finishRecv();
+        Impl::gatherUnpack( exec_space, halo, aosoa, recv_bytes );
+    };
+
+    // Unlock the halo buffers once the operation is complete or has failed.
+    auto release = [=]() {
+        if ( lock_buffers )
+            halo.buffers().unlock();
+    };
+
+    return HaloRequest( std::move( requests ), std::move( unpack ),
+                        std::move( release ), halo.statistics(),
+                        halo.progress() );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Start a split-phase gather of data from the local decomposition to
+  the ghosts using the halo forward communication plan on the default
+  execution space instance. AoSoA version.
+
+  \see gatherStart( const ExecutionSpace&, const Halo_t&, AoSoA_t& )
+*/
+template <class Halo_t, class AoSoA_t>
+HaloRequest
+gatherStart( const Halo_t& halo, AoSoA_t& aosoa,
+             typename std::enable_if<( is_halo<Halo_t>::value &&
+                                       is_aosoa<AoSoA_t>::value ),
+                                     int>::type* = 0 )
+{
+    return gatherStart( typename Halo_t::execution_space(), halo, aosoa );
+}
+
+//---------------------------------------------------------------------------//
+namespace Impl
+{
+//! \cond Impl
+// Start a split-phase gather of a slice. The slice data is sent with the
+// given wire type.
+template <class WireType, class ExecutionSpace, class Halo_t, class Slice_t>
+HaloRequest gatherStartSlice( const ExecutionSpace& exec_space,
+                              const Halo_t& halo, Slice_t& slice )
+{
+    // Get the number of components in the slice.
+    std::size_t num_comp = 1;
+    for ( std::size_t d = 2; d < slice.rank(); ++d )
+        num_comp *= slice.extent( d );
+
+    // Get the raw slice data.
+    auto slice_data = slice.data();
+
+    // Get the send buffer. Note this one is layout right so the components
+    // are consecutive.
+    auto send_bytes = halo.buffers().sendBuffer(
+        halo.totalNumExport() * num_comp * sizeof( WireType ) );
+    auto send_buffer =
+        typedBuffer<WireType>( send_bytes, halo.totalNumExport(), num_comp );
+
+    // Get the steering vector for the sends.
+    auto steering = halo.getExportSteering();
+
+    // Gather from the local data into a tuple-contiguous send buffer.
+    auto gather_send_buffer_func = KOKKOS_LAMBDA( const std::size_t i )
+    {
+        auto s = Slice_t::index_type::s( steering( i ) );
+        auto a = Slice_t::index_type::a( steering( i ) );
+        std::size_t slice_offset = s * slice.stride( 0 ) + a;
+        for ( std::size_t n = 0; n < num_comp; ++n )
+            send_buffer( i, n ) = static_cast<WireType>(
+                slice_data[slice_offset + n * Slice_t::vector_length] );
+    };
+    Kokkos::RangePolicy<ExecutionSpace> gather_send_buffer_policy(
+        exec_space, 0, halo.totalNumExport() );
+    Kokkos::parallel_for( "Cabana::gather::gather_send_buffer",
+                          gather_send_buffer_policy, gather_send_buffer_func );
+    exec_space.fence();
+
+    // Get the receive buffer.
+    auto recv_bytes = halo.buffers().recvBuffer(
+        halo.totalNumImport() * num_comp * sizeof( WireType ) );
+
+    // Stage the messages through the host if needed.
+    std::size_t element_bytes = num_comp * sizeof( WireType );
+    auto staging = createHaloStaging(
+        exec_space, halo, send_bytes, halo.totalNumExport() * element_bytes,
+        recv_bytes, halo.totalNumImport() * element_bytes );
+
+    // Lock the halo buffers while the messages are in flight. If they were
+    // already locked we got temporaries.
+    bool lock_buffers = !halo.buffers().locked();
+    if ( lock_buffers )
+        halo.buffers().lock();
+
+    // Post sends and receives.
+    auto requests = postHaloMessages( halo, true, staging, element_bytes );
+
+    // Extract the receive buffer into the ghosted elements when finished. The
+    // staging is captured to keep the byte buffers alive until then.
+    auto unpack = [=]() mutable {
+        staging.finishRecv();
+        gatherUnpack<WireType>( exec_space, halo, slice, recv_bytes );
+    };
+
+    // Unlock the halo buffers once the operation is complete or has failed.
+    auto release = [=]() {
+        if ( lock_buffers )
+            halo.buffers().unlock();
+    };
+
+    return HaloRequest( std::move( requests ), std::move( unpack ),
+                        std::move( release ), halo.statistics(),
+                        halo.progress() );
+}
+
+//---------------------------------------------------------------------------//
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Start a split-phase gather of data from the local decomposition to
+  the ghosts using the halo forward communication plan. Slice version.
+
+  The locally owned data is packed and all sends and receives are posted
+  before returning. The ghosted elements of the slice are not updated until
+  finish() is called on the returned request. The locally owned elements of
+  the slice must not be modified until then.
+
+  \tparam Halo_t Halo type - must be a Halo.
+
+  \tparam Slice_t Slice type - must be a Slice.
+
+  \param halo The halo to use for the gather.
+
+  \param slice The Slice on which to perform the gather. The Slice should have
+  a size equivalent to halo.numGhost() + halo.numLocal(). The locally owned
+  elements are expected to appear first (i.e. in the first halo.numLocal()
+  elements) and the ghosted elements are expected to appear second (i.e. in
+  the next halo.numGhost() elements()).
+
+  \return A request to finish the gather.
+
+  \note If the gather precision of the halo is reduced the ghosted values are
+  only accurate to the reduced precision.
+
+  \note The packing and unpacking kernels are enqueued on the given execution
+  space instance which is fenced before the messages are posted and again
+  when the request is finished.
+*/
+template <class ExecutionSpace, class Halo_t, class Slice_t>
+HaloRequest
+gatherStart( const ExecutionSpace& exec_space, const Halo_t& halo,
+             Slice_t& slice,
+             typename std::enable_if<
+                 ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+                   is_halo<Halo_t>::value && is_slice<Slice_t>::value ),
+                 int>::type* = 0 )
+{
+    Impl::ScopedProfileRegion region( "Cabana::gatherStart" );
+
+    // Check that the Slice is the right size.
+    if ( slice.size() != halo.numLocal() + halo.numGhost() )
+        throw std::runtime_error( "Slice is the wrong size for gather!" );
+
+    using value_type = typename Slice_t::value_type;
+    if ( CommPrecision::Reduced == halo.gatherPrecision() )
+        return Impl::gatherStartSlice<
+            typename Impl::ReducedPrecision<value_type>::type>( exec_space,
+                                                                halo, slice );
+    return Impl::gatherStartSlice<value_type>( exec_space, halo, slice );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Start a split-phase gather of data from the local decomposition to
+  the ghosts using the halo forward communication plan on the default
+  execution space instance. Slice version.
+
+  \see gatherStart( const ExecutionSpace&, const Halo_t&, Slice_t& )
+*/
+template <class Halo_t, class Slice_t>
+HaloRequest
+gatherStart( const Halo_t& halo, Slice_t& slice,
+             typename std::enable_if<( is_halo<Halo_t>::value &&
+                                       is_slice<Slice_t>::value ),
+                                     int>::type* = 0 )
+{
+    return gatherStart( typename Halo_t::execution_space(), halo, slice );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Synchronously gather data from the local decomposition to the ghosts
+  using the halo forward communication plan. AoSoA version. This is a
+  uniquely-owned to multiply-owned communication.
+
+  A gather sends data from a locally owned elements to one or many ranks on
+  which they exist as ghosts. A locally owned element may be sent to as many
+  ranks as desired to be used as a ghost on those ranks. The value of the
+  element in the locally owned decomposition will be the value assigned to the
+  element in the ghosted decomposition.
+
+  \tparam Halo_t Halo type - must be a Halo.
+
+  \tparam AoSoA_t AoSoA type - must be an AoSoA.
+
+  \param halo The halo to use for the gather.
+
+  \param aosoa The AoSoA on which to perform the gather. The AoSoA should have
+  a size equivalent to halo.numGhost() + halo.numLocal(). The locally owned
+  elements are expected to appear first (i.e. in the first halo.numLocal()
+  elements) and the ghosted elements are expected to appear second (i.e. in
+  the next halo.numGhost() elements()).
+
+  \param exec_space The execution space instance on which the packing and
+  unpacking kernels are enqueued.
+*/
+template <class ExecutionSpace, class Halo_t, class AoSoA_t>
+void gather( const ExecutionSpace& exec_space, const Halo_t& halo,
+             AoSoA_t& aosoa,
+             typename std::enable_if<
+                 ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+                   is_halo<Halo_t>::value && is_aosoa<AoSoA_t>::value ),
+                 int>::type* = 0 )
+{
+    Impl::ScopedProfileRegion region( "Cabana::gather" );
+
+    auto request = gatherStart( exec_space, halo, aosoa );
+    request.finish();
+
+    // Barrier before completing to ensure synchronization.
+    Impl::CommWait barrier_wait( "Cabana::Halo::wait",
+                                 halo.statistics().get() );
+    MPI_Barrier( halo.comm() );
+    barrier_wait.stop();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Synchronously gather data from the local decomposition to the ghosts
+  using the halo forward communication plan on the default execution space
+  instance. AoSoA version.
+
+  \see gather( const ExecutionSpace&, const Halo_t&, AoSoA_t& )
+*/
+template <class Halo_t, class AoSoA_t>
+void gather( const Halo_t& halo, AoSoA_t& aosoa,
+             typename std::enable_if<( is_halo<Halo_t>::value &&
+                                       is_aosoa<AoSoA_t>::value ),
+                                     int>::type* = 0 )
+{
+    gather( typename Halo_t::execution_space(), halo, aosoa );
+}
+
+//---------------------------------------------------------------------------//
+//! \cond Impl
+namespace Impl
+{
+// Gather every group of a GroupedAoSoA. All groups are started before any
+// is finished.
+template <class ExecutionSpace, class Halo_t, class AoSoA_t, std::size_t... G>
+void gatherGroups( const ExecutionSpace& exec_space, const Halo_t& halo,
+                   AoSoA_t& aosoa, std::index_sequence<G...> )
+{
+    HaloRequest requests[] = { gatherStart( exec_space, halo,
+                                            aosoa.template group<G>() )... };
+    for ( auto& request : requests )
+        request.finish();
+}
+} // end namespace Impl
+//! \endcond
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Synchronously gather data from the local decomposition to the ghosts
+  using the halo forward communication plan. GroupedAoSoA version.
+
+  The gathers of all groups are started before any is finished.
+
+  \tparam Halo_t Halo type - must be a Halo.
+
+  \tparam AoSoA_t GroupedAoSoA type - must be a GroupedAoSoA.
+
+  \param exec_space The execution space instance on which the packing and
+  unpacking kernels are enqueued.
+
+  \param halo The halo to use for the gather.
+
+  \param aosoa The GroupedAoSoA on which to perform the gather. It should have
+  a size equivalent to halo.numGhost() + halo.numLocal() with the locally
+  owned elements first.
+*/
+template <class ExecutionSpace, class Halo_t, class AoSoA_t>
+void gather( const ExecutionSpace& exec_space, const Halo_t& halo,
+             AoSoA_t& aosoa,
+             typename std::enable_if<
+                 ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+                   is_halo<Halo_t>::value && is_grouped_aosoa<AoSoA_t>::value ),
+                 int>::type* = 0 )
+{
+    Impl::ScopedProfileRegion region( "Cabana::gather" );
+
+    Impl::gatherGroups(
+        exec_space, halo, aosoa,
+        std::make_index_sequence<AoSoA_t::number_of_groups>() );
+
+    // Barrier before completing to ensure synchronization.
+    Impl::CommWait barrier_wait( "Cabana::Halo::wait",
+                                 halo.statistics().get() );
+    MPI_Barrier( halo.comm() );
+    barrier_wait.stop();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Synchronously gather data from the local decomposition to the ghosts
+  using the halo forward communication plan on the default execution space
+  instance. GroupedAoSoA version.
+
+  \see gather( const ExecutionSpace&, const Halo_t&, AoSoA_t& )
+*/
+template <class Halo_t, class AoSoA_t>
+void gather( const Halo_t& halo, AoSoA_t& aosoa,
+             typename std::enable_if<( is_halo<Halo_t>::value &&
+                                       is_grouped_aosoa<AoSoA_t>::value ),
+                                     int>::type* = 0 )
+{
+    gather( typename Halo_t::execution_space(), halo, aosoa );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Synchronously gather data from the local decomposition to the ghosts
+  using the halo forward communication plan. Slice version. This is a
+  uniquely-owned to multiply-owned communication.
+
+  A gather sends data from a locally owned elements to one or many ranks on
+  which they exist as ghosts. A locally owned element may be sent to as many
+  ranks as desired to be used as a ghost on those ranks. The value of the
+  element in the locally owned decomposition will be the value assigned to the
+  element in the ghosted decomposition.
+
+  \tparam Halo_t Halo type - must be a Halo.
+
+  \tparam Slice_t Slice type - must be a Slice.
+
+  \param halo The halo to use for the gather.
+
+  \param slice The Slice on which to perform the gather. The Slice should have
+  a size equivalent to halo.numGhost() + halo.numLocal(). The locally owned
+  elements are expected to appear first (i.e. in the first halo.numLocal()
+  elements) and the ghosted elements are expected to appear second (i.e. in
+  the next halo.numGhost() elements()).
+
+  \param exec_space The execution space instance on which the packing and
+  unpacking kernels are enqueued.
+*/
+template <class ExecutionSpace, class Halo_t, class Slice_t>
+void gather( const ExecutionSpace& exec_space, const Halo_t& halo,
+             Slice_t& slice,
+             typename std::enable_if<
+                 ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+                   is_halo<Halo_t>::value && is_slice<Slice_t>::value ),
+                 int>::type* = 0 )
+{
+    Impl::ScopedProfileRegion region( "Cabana::gather" );
+
+    auto request = gatherStart( exec_space, halo, slice );
+    request.finish();
+
+    // Barrier before completing to ensure synchronization.
+    Impl::CommWait barrier_wait( "Cabana::Halo::wait",
+                                 halo.statistics().get() );
+    MPI_Barrier( halo.comm() );
+    barrier_wait.stop();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Synchronously gather data from the local decomposition to the ghosts
+  using the halo forward communication plan on the default execution space
+  instance. Slice version.
+
+  \see gather( const ExecutionSpace&, const Halo_t&, Slice_t& )
+*/
+template <class Halo_t, class Slice_t>
+void gather( const Halo_t& halo, Slice_t& slice,
+             typename std::enable_if<( is_halo<Halo_t>::value &&
+                                       is_slice<Slice_t>::value ),
+                                     int>::type* = 0 )
+{
+    gather( typename Halo_t::execution_space(), halo, slice );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Start a split-phase gather of data from the local decomposition to
+  the ghosts using the halo forward communication plan. Multiple slice
+  version.
+
+  All slices are packed into a single fused buffer such that one message is
+  sent to each neighbor regardless of the number of slices. The ghosted
+  elements of the slices are not updated until finish() is called on the
+  returned request.
+
+  \tparam Halo_t Halo type - must be a Halo.
+
+  \tparam Slice0 Slice type - must be a Slice.
+
+  \tparam Slice1 Slice type - must be a Slice.
+
+  \tparam Slices Slice types - must be Slices.
+
+  \param halo The halo to use for the gather.
+
+  \param slice0 The first slice on which to perform the gather.
+
+  \param slice1 The second slice on which to perform the gather.
+
+  \param slices The remaining slices on which to perform the gather.
+
+  All slices should have a size equivalent to halo.numGhost() +
+  halo.numLocal(). The locally owned elements are expected to appear first
+  (i.e. in the first halo.numLocal() elements) and the ghosted elements are
+  expected to appear second (i.e. in the next halo.numGhost() elements()).
+
+  \return A request to finish the gather.
+*/
+template <class Halo_t, class Slice0, class Slice1, class... Slices>
+typename std::enable_if<( is_halo<Halo_t>::value &&
+                          Impl::AllOf<is_slice, Slice0, Slice1,
+                                      Slices...>::value ),
+                        HaloRequest>::type
+gatherStart( const Halo_t& halo, Slice0& slice0, Slice1& slice1,
+             Slices&... slices )
+{
+    Impl::ScopedProfileRegion region( "Cabana::gatherStart" );
+
+    // Check that the slices are the right size.
+    std::size_t size = halo.numLocal() + halo.numGhost();
+    if ( slice0.size() != size || slice1.size() != size )
+        throw std::runtime_error( "Slice is the wrong size for gather!" );
+    (void)std::initializer_list<int>{ (
+        ( slices.size() != size )
+            ? throw std::runtime_error( "Slice is the wrong size for gather!" )
+            : 0 )... };
+
+    return Impl::gatherStartFused( halo, slice0, slice1, slices... );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Synchronously gather data from the local decomposition to the ghosts
+  using the halo forward communication plan. Multiple slice version.
+
+  All slices are packed into a single fused buffer such that one message is
+  sent to each neighbor regardless of the number of slices.
+
+  \tparam Halo_t Halo type - must be a Halo.
+
+  \tparam Slice0 Slice type - must be a Slice.
+
+  \tparam Slice1 Slice type - must be a Slice.
+
+  \tparam Slices Slice types - must be Slices.
+
+  \param halo The halo to use for the gather.
+
+  \param slice0 The first slice on which to perform the gather.
+
+  \param slice1 The second slice on which to perform the gather.
+
+  \param slices The remaining slices on which to perform the gather.
+
+  All slices should have a size equivalent to halo.numGhost() +
+  halo.numLocal(). The locally owned elements are expected to appear first
+  (i.e. in the first halo.numLocal() elements) and the ghosted elements are
+  expected to appear second (i.e. in the next halo.numGhost() elements()).
+*/
+template <class Halo_t, class Slice0, class Slice1, class... Slices>
+typename std::enable_if<( is_halo<Halo_t>::value &&
+                          Impl::AllOf<is_slice, Slice0, Slice1,
+                                      Slices...>::value ),
+                        void>::type
+gather( const Halo_t& halo, Slice0& slice0, Slice1& slice1, Slices&... slices )
+{
+    Impl::ScopedProfileRegion region( "Cabana::gather" );
+
+    auto request = gatherStart( halo, slice0, slice1, slices... );
+    request.finish();
+
+    // Barrier before completing to ensure synchronization.
+    Impl::CommWait barrier_wait( "Cabana::Halo::wait",
+                                 halo.statistics().get() );
+    MPI_Barrier( halo.comm() );
+    barrier_wait.stop();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Start a split-phase gather of a subset of the AoSoA members from the
+  local decomposition to the ghosts using the halo forward communication
+  plan.
+
+  Only the given members are communicated. The members are packed into a
+  single fused buffer such that one message is sent to each neighbor. The
+  ghosted elements of the AoSoA are not updated until finish() is called on
+  the returned request.
+
+  \tparam M0 The index of the first member to gather.
+
+  \tparam M The indices of the remaining members to gather.
+
+  \tparam Halo_t Halo type - must be a Halo.
+
+  \tparam AoSoA_t AoSoA type - must be an AoSoA.
+
+  \param halo The halo to use for the gather.
+
+  \param aosoa The AoSoA on which to perform the gather. The AoSoA should have
+  a size equivalent to halo.numGhost() + halo.numLocal(). The locally owned
+  elements are expected to appear first (i.e. in the first halo.numLocal()
+  elements) and the ghosted elements are expected to appear second (i.e. in
+  the next halo.numGhost() elements()).
+
+  \return A request to finish the gather.
+*/
+template <std::size_t M0, std::size_t... M, class Halo_t, class AoSoA_t>
+HaloRequest
+gatherStart( const Halo_t& halo, AoSoA_t& aosoa,
+             typename std::enable_if<( is_halo<Halo_t>::value &&
+                                       is_aosoa<AoSoA_t>::value ),
+                                     int>::type* = 0 )
+{
+    Impl::ScopedProfileRegion region( "Cabana::gatherStart" );
+
+    // Check that the AoSoA is the right size.
+    if ( aosoa.size() != halo.numLocal() + halo.numGhost() )
+        throw std::runtime_error( "AoSoA is the wrong size for gather!" );
+
+    return Impl::gatherStartFused( halo, slice<M0>( aosoa ),
+                                   slice<M>( aosoa )... );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Synchronously gather a subset of the AoSoA members from the local
+  decomposition to the ghosts using the halo forward communication plan.
+
+  Only the given members are communicated. The members are packed into a
+  single fused buffer such that one message is sent to each neighbor. For
+  example, gather<0,3,5>( halo, aosoa ) will only update members 0, 3, and 5
+  of the ghosted elements.
+
+  \tparam M0 The index of the first member to gather.
+
+  \tparam M The indices of the remaining members to gather.
+
+  \tparam Halo_t Halo type - must be a Halo.
+
+  \tparam AoSoA_t AoSoA type - must be an AoSoA.
+
+  \param halo The halo to use for the gather.
+
+  \param aosoa The AoSoA on which to perform the gather. The AoSoA should have
+  a size equivalent to halo.numGhost() + halo.numLocal(). The locally owned
+  elements are expected to appear first (i.e. in the first halo.numLocal()
+  elements) and the ghosted elements are expected to appear second (i.e. in
+  the next halo.numGhost() elements()).
+*/
+template <std::size_t M0, std::size_t... M, class Halo_t, class AoSoA_t>
+void gather( const Halo_t& halo, AoSoA_t& aosoa,
+             typename std::enable_if<( is_halo<Halo_t>::value &&
+                                       is_aosoa<AoSoA_t>::value ),
+                                     int>::type* = 0 )
+{
+    Impl::ScopedProfileRegion region( "Cabana::gather" );
+
+    auto request = gatherStart<M0, M...>( halo, aosoa );
+    request.finish();
+
+    // Barrier before completing to ensure synchronization.
+    Impl::CommWait barrier_wait( "Cabana::Halo::wait",
+                                 halo.statistics().get() );
+    MPI_Barrier( halo.comm() );
+    barrier_wait.stop();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Start a split-phase update of the ghosted values of a slice with
+  the current values of their owners.
+
+  This is the update-only mode of the gather for steps in which the set of
+  ghosts is unchanged, e.g. between rebuilds of a neighbor list with a skin
+  where only the ghost positions change. The halo plan, steering, and
+  persistent buffers of the last full gather are reused and only the given
+  slice is sent into the existing ghost slots. Unlike gatherStart() the slice
+  may be larger than the halo: it must hold at least halo.numLocal() +
+  halo.numGhost() elements, owned elements first and ghosts in the slots
+  filled by the last gather, and is never resized. A smaller slice throws.
+
+  \tparam Halo_t Halo type - must be a Halo.
+
+  \tparam Slice_t Slice type - must be a Slice.
+
+  \param halo The halo used to create the ghosts.
+
+  \param slice The slice whose ghosted values are updated.
+
+  \return A request to finish the update.
+
+  \note If the gather precision of the halo is reduced the ghosted values are
+  only accurate to the reduced precision.
+*/
+template <class Halo_t, class Slice_t>
+HaloRequest
+updateGhostsStart( const Halo_t& halo, Slice_t& slice,
+                   typename std::enable_if<( is_halo<Halo_t>::value &&
+                                             is_slice<Slice_t>::value ),
+                                           int>::type* = 0 )
+{
+    Impl::ScopedProfileRegion region( "Cabana::updateGhostsStart" );
+
+    // Check that the slice holds the owned elements and the ghosts.
+    if ( slice.size() < halo.numLocal() + halo.numGhost() )
+        throw std::runtime_error( "Slice is too small for updateGhosts!" );
+
+    using value_type = typename Slice_t::value_type;
+    using execution_space = typename Halo_t::execution_space;
+    if ( CommPrecision::Reduced == halo.gatherPrecision() )
+        return Impl::gatherStartSlice<
+            typename Impl::ReducedPrecision<value_type>::type>(
+            execution_space(), halo, slice );
+    return Impl::gatherStartSlice<value_type>( execution_space(), halo,
+                                               slice );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Start a split-phase update of the ghosted values of several slices
+  with the current values of their owners. All slices are packed into a
+  single fused buffer such that one message is sent to each neighbor.
+
+  \tparam Halo_t Halo type - must be a Halo.
+
+  \tparam Slice0 Slice type - must be a Slice.
+
+  \tparam Slice1 Slice type - must be a Slice.
+
+  \tparam Slices Slice types - must be Slices.
+
+  \param halo The halo used to create the ghosts.
+
+  \param slice0 The first slice whose ghosted values are updated.
+
+  \param slice1 The second slice whose ghosted values are updated.
+
+  \param slices The remaining slices whose ghosted values are updated.
+
+  \return A request to finish the update.
+
+  \see updateGhostsStart( const Halo_t&, Slice_t& )
+*/
+template <class Halo_t, class Slice0, class Slice1, class... Slices>
+typename std::enable_if<( is_halo<Halo_t>::value &&
+                          Impl::AllOf<is_slice, Slice0, Slice1,
+                                      Slices...>::value ),
+                        HaloRequest>::type
+updateGhostsStart( const Halo_t& halo, Slice0& slice0, Slice1& slice1,
+                   Slices&... slices )
+{
+    Impl::ScopedProfileRegion region( "Cabana::updateGhostsStart" );
+
+    // Check that the slices hold the owned elements and the ghosts.
+    std::size_t size = halo.numLocal() + halo.numGhost();
+    if ( slice0.size() < size || slice1.size() < size )
+        throw std::runtime_error( "Slice is too small for updateGhosts!" );
+    (void)std::initializer_list<int>{ (
+        ( slices.size() < size )
+            ? throw std::runtime_error( "Slice is too small for updateGhosts!" )
+            : 0 )... };
+
+    return Impl::gatherStartFused( halo, slice0, slice1, slices... );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Start a split-phase update of the ghosted values of a subset of the
+  AoSoA members with the current values of their owners.
+
+  \tparam M0 The index of the first member to update.
+
+  \tparam M The indices of the remaining members to update.
+
+  \tparam Halo_t Halo type - must be a Halo.
+
+  \tparam AoSoA_t AoSoA type - must be an AoSoA.
+
+  \param halo The halo used to create the ghosts.
+
+  \param aosoa The AoSoA whose ghosted members are updated.
+
+  \return A request to finish the update.
+
+  \see updateGhostsStart( const Halo_t&, Slice_t& )
+*/
+template <std::size_t M0, std::size_t... M, class Halo_t, class AoSoA_t>
+HaloRequest
+updateGhostsStart( const Halo_t& halo, AoSoA_t& aosoa,
+                   typename std::enable_if<( is_halo<Halo_t>::value &&
+                                             is_aosoa<AoSoA_t>::value ),
+                                           int>::type* = 0 )
+{
+    Impl::ScopedProfileRegion region( "Cabana::updateGhostsStart" );
+
+    // Check that the AoSoA holds the owned elements and the ghosts.
+    if ( aosoa.size() < halo.numLocal() + halo.numGhost() )
+        throw std::runtime_error( "AoSoA is too small for updateGhosts!" );
+
+    return Impl::gatherStartFused( halo, slice<M0>( aosoa ),
+                                   slice<M>( aosoa )... );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Update the ghosted values of one or more slices with the current
+  values of their owners.
+
+  This completes the update before returning but, unlike gather(), does not
+  synchronize the ranks of the halo communicator after it.
+
+  \param halo The halo used to create the ghosts.
+
+  \param slices The slices whose ghosted values are updated.
+
+  \see updateGhostsStart( const Halo_t&, Slice_t& )
+*/
+template <class Halo_t, class... Slices>
+typename std::enable_if<( is_halo<Halo_t>::value &&
+                          Impl::AllOf<is_slice, Slices...>::value ),
+                        void>::type
+updateGhosts( const Halo_t& halo, Slices&... slices )
+{
+    Impl::ScopedProfileRegion region( "Cabana::updateGhosts" );
+
+    auto request = updateGhostsStart( halo, slices... );
+    request.finish();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Update the ghosted values of a subset of the AoSoA members with the
+  current values of their owners.
+
+  \tparam M0 The index of the first member to update.
+
+  \tparam M The indices of the remaining members to update.
+
+  \param halo The halo used to create the ghosts.
+
+  \param aosoa The AoSoA whose ghosted members are updated.
+
+  \see updateGhostsStart( const Halo_t&, Slice_t& )
+*/
+template <std::size_t M0, std::size_t... M, class Halo_t, class AoSoA_t>
+void updateGhosts( const Halo_t& halo, AoSoA_t& aosoa,
+                   typename std::enable_if<( is_halo<Halo_t>::value &&
+                                             is_aosoa<AoSoA_t>::value ),
+                                           int>::type* = 0 )
+{
+    Impl::ScopedProfileRegion region( "Cabana::updateGhosts" );
+
+    auto request = updateGhostsStart<M0, M...>( halo, aosoa );
+    request.finish();
+}
+
+//---------------------------------------------------------------------------//
+/*!
   \brief Synchronously scatter data from the ghosts to the local decomposition
   of a slice using the halo reverse communication plan. This is a
   multiply-owned to uniquely owned communication.
@@ -491,13 +1746,20 @@ void gather( const Halo_t& halo, Slice_t& slice,
   elements are expected to appear first (i.e. in the first halo.numLocal()
   elements) and the ghosted elements are expected to appear second (i.e. in
   the next halo.numGhost() elements()).
+
+  \param exec_space The execution space instance on which the packing and
+  unpacking kernels are enqueued.
 */
-template <class Halo_t, class Slice_t>
-void scatter( const Halo_t& halo, Slice_t& slice,
-              typename std::enable_if<( is_halo<Halo_t>::value &&
-                                        is_slice<Slice_t>::value ),
-                                      int>::type* = 0 )
+template <class ExecutionSpace, class Halo_t, class Slice_t>
+void scatter( const ExecutionSpace& exec_space, const Halo_t& halo,
+              Slice_t& slice,
+              typename std::enable_if<
+                  ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+                    is_halo<Halo_t>::value && is_slice<Slice_t>::value ),
+                  int>::type* = 0 )
 {
+    Impl::ScopedProfileRegion region( "Cabana::scatter" );
+
     // Check that the Slice is the right size.
     if ( slice.size() != halo.numLocal() + halo.numGhost() )
         throw std::runtime_error( "Slice is the wrong size for scatter!" );
@@ -507,21 +1769,23 @@ void scatter( const Halo_t& halo, Slice_t& slice,
     for ( std::size_t d = 2; d < slice.rank(); ++d )
         num_comp *= slice.extent( d );
 
+    using value_type = typename Slice_t::value_type;
+
     // Get the raw slice data. Wrap in a 1D Kokkos View so we can unroll the
     // components of each slice element.
-    Kokkos::View<typename Slice_t::value_type*, typename Slice_t::memory_space,
+    Kokkos::View<value_type*, typename Slice_t::memory_space,
                  Kokkos::MemoryTraits<Kokkos::Unmanaged>>
         slice_data( slice.data(), slice.numSoA() * slice.stride( 0 ) );
 
-    // Allocate a send buffer. Note this one is layout right so the components
+    // Get the send buffer. Note this one is layout right so the components
     // are consecutive.
-    Kokkos::View<typename Slice_t::value_type**, Kokkos::LayoutRight,
-                 typename Halo_t::memory_space>
-        send_buffer(
-            Kokkos::ViewAllocateWithoutInitializing( "halo_send_buffer" ),
-            halo.totalNumImport(), num_comp );
+    auto send_bytes = halo.buffers().sendBuffer(
+        halo.totalNumImport() * num_comp * sizeof( value_type ) );
+    auto send_buffer = Impl::typedBuffer<value_type>(
+        send_bytes, halo.totalNumImport(), num_comp );
 
     // Extract the send buffer from the ghosted elements.
+    Kokkos::Profiling::pushRegion( "Cabana::scatter::pack" );
     std::size_t num_local = halo.numLocal();
     auto extract_send_buffer_func = KOKKOS_LAMBDA( const std::size_t i )
     {
@@ -533,70 +1797,47 @@ void scatter( const Halo_t& halo, Slice_t& slice,
             send_buffer( i, n ) =
                 slice_data( slice_offset + Slice_t::vector_length * n );
     };
-    Kokkos::RangePolicy<typename Halo_t::execution_space>
-        extract_send_buffer_policy( 0, halo.totalNumImport() );
+    Kokkos::RangePolicy<ExecutionSpace> extract_send_buffer_policy(
+        exec_space, 0, halo.totalNumImport() );
     Kokkos::parallel_for( "Cabana::scatter::extract_send_buffer",
                           extract_send_buffer_policy,
                           extract_send_buffer_func );
-    Kokkos::fence();
+    exec_space.fence();
+    Kokkos::Profiling::popRegion();
 
-    // Allocate a receive buffer. Note this one is layout right so the
+    // Get the receive buffer. Note this one is layout right so the
     // components are consecutive.
-    Kokkos::View<typename Slice_t::value_type**, Kokkos::LayoutRight,
-                 typename Halo_t::memory_space>
-        recv_buffer(
-            Kokkos::ViewAllocateWithoutInitializing( "halo_recv_buffer" ),
-            halo.totalNumExport(), num_comp );
-
-    // The halo has it's own communication space so choose any mpi tag.
-    const int mpi_tag = 2345;
-
-    // Post non-blocking receives.
-    int num_n = halo.numNeighbor();
-    std::vector<MPI_Request> requests( num_n );
-    std::pair<std::size_t, std::size_t> recv_range = { 0, 0 };
-    for ( int n = 0; n < num_n; ++n )
-    {
-        recv_range.second = recv_range.first + halo.numExport( n );
-
-        auto recv_subview =
-            Kokkos::subview( recv_buffer, recv_range, Kokkos::ALL );
-
-        MPI_Irecv( recv_subview.data(),
-                   recv_subview.size() * sizeof( typename Slice_t::value_type ),
-                   MPI_BYTE, halo.neighborRank( n ), mpi_tag, halo.comm(),
-                   &( requests[n] ) );
-
-        recv_range.first = recv_range.second;
-    }
-
-    // Do blocking sends.
-    std::pair<std::size_t, std::size_t> send_range = { 0, 0 };
-    for ( int n = 0; n < num_n; ++n )
-    {
-        send_range.second = send_range.first + halo.numImport( n );
-
-        auto send_subview =
-            Kokkos::subview( send_buffer, send_range, Kokkos::ALL );
-
-        MPI_Send( send_subview.data(),
-                  send_subview.size() * sizeof( typename Slice_t::value_type ),
-                  MPI_BYTE, halo.neighborRank( n ), mpi_tag, halo.comm() );
-
-        send_range.first = send_range.second;
-    }
-
-    // Wait on non-blocking receives.
-    std::vector<MPI_Status> status( num_n );
+    auto recv_bytes = halo.buffers().recvBuffer(
+        halo.totalNumExport() * num_comp * sizeof( value_type ) );
+    auto recv_buffer = Impl::typedBuffer<value_type>(
+        recv_bytes, halo.totalNumExport(), num_comp );
+
+    // Stage the messages through the host if needed.
+    std::size_t element_bytes = num_comp * sizeof( value_type );
+    auto staging = Impl::createHaloStaging(
+        exec_space, halo, send_bytes, halo.totalNumImport() * element_bytes,
+        recv_bytes, halo.totalNumExport() * element_bytes );
+
+    // Post sends and receives using the reverse communication plan.
+    auto requests =
+        Impl::postHaloMessages( halo, false, staging, element_bytes );
+
+    // Wait on the communication.
+    Impl::CommWait comm_wait( "Cabana::scatter::wait",
+                              halo.statistics().get() );
+    std::vector<MPI_Status> status( requests.size() );
     const int ec =
         MPI_Waitall( requests.size(), requests.data(), status.data() );
+    comm_wait.stop();
     if ( MPI_SUCCESS != ec )
         throw std::logic_error( "Failed MPI Communication" );
+    staging.finishRecv();
 
     // Get the steering vector for the sends.
     auto steering = halo.getExportSteering();
 
     // Scatter the ghosts in the receive buffer into the local values.
+    Kokkos::Profiling::pushRegion( "Cabana::scatter::unpack" );
     auto scatter_recv_buffer_func = KOKKOS_LAMBDA( const std::size_t i )
     {
         auto s = Slice_t::index_type::s( steering( i ) );
@@ -607,15 +1848,36 @@ void scatter( const Halo_t& halo, Slice_t& slice,
                 &slice_data( slice_offset + Slice_t::vector_length * n ),
                 recv_buffer( i, n ) );
     };
-    Kokkos::RangePolicy<typename Halo_t::execution_space>
-        scatter_recv_buffer_policy( 0, halo.totalNumExport() );
+    Kokkos::RangePolicy<ExecutionSpace> scatter_recv_buffer_policy(
+        exec_space, 0, halo.totalNumExport() );
     Kokkos::parallel_for( "Cabana::scatter::scatter_recv_buffer",
                           scatter_recv_buffer_policy,
                           scatter_recv_buffer_func );
-    Kokkos::fence();
+    exec_space.fence();
+    Kokkos::Profiling::popRegion();
 
     // Barrier before completing to ensure synchronization.
+    Impl::CommWait barrier_wait( "Cabana::scatter::wait",
+                                 halo.statistics().get() );
     MPI_Barrier( halo.comm() );
+    barrier_wait.stop();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Synchronously scatter data from the ghosts to the local decomposition
+  of a slice using the halo reverse communication plan on the default
+  execution space instance.
+
+  \see scatter( const ExecutionSpace&, const Halo_t&, Slice_t& )
+*/
+template <class Halo_t, class Slice_t>
+void scatter( const Halo_t& halo, Slice_t& slice,
+              typename std::enable_if<( is_halo<Halo_t>::value &&
+                                        is_slice<Slice_t>::value ),
+                                      int>::type* = 0 )
+{
+    scatter( typename Halo_t::execution_space(), halo, slice );
 }
 
 //---------------------------------------------------------------------------//
@@ -0,0 +1,435 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_HashedCellList.hpp
+  \brief Cell list binning of an unbounded domain into hashed cells
+*/
+#ifndef CABANA_HASHEDCELLLIST_HPP
+#define CABANA_HASHEDCELLLIST_HPP
+
+#include <Cabana_LinkedCellList.hpp>
+#include <Cabana_Slice.hpp>
+#include <Cabana_Sort.hpp>
+#include <impl/Cabana_Profiling.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_UnorderedMap.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+namespace Cabana
+{
+namespace Impl
+{
+//! \cond Impl
+//---------------------------------------------------------------------------//
+// Get the cell coordinate of a position. Coordinates are clamped far outside
+// of any realistic domain such that the conversion is always defined.
+KOKKOS_INLINE_FUNCTION
+std::int64_t hashedCellCoordinate( const double x, const double dx )
+{
+    const double limit = 4.0e18;
+    double c = floor( x / dx );
+    c = ( c >= -limit ) ? c : -limit;
+    c = ( c <= limit ) ? c : limit;
+    return static_cast<std::int64_t>( c );
+}
+
+//---------------------------------------------------------------------------//
+// Get the hash key of a cell. The coordinates wrap around every 2^21 cells.
+KOKKOS_INLINE_FUNCTION
+std::uint64_t hashedCellKey( const std::int64_t i, const std::int64_t j,
+                             const std::int64_t k )
+{
+    return mortonKey( static_cast<std::uint32_t>( i & 0x1fffff ),
+                      static_cast<std::uint32_t>( j & 0x1fffff ),
+                      static_cast<std::uint32_t>( k & 0x1fffff ) );
+}
+
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Cell list binning particles into the occupied cells of an unbounded
+  regular Cartesian grid.
+
+  Unlike LinkedCellList no grid bounds are needed and the memory scales with
+  the number of occupied cells rather than with the bounding box of the
+  particles, such that a single escaping particle or a sparse particle cloud
+  does not allocate a dense grid. The cells are ordered by the Morton keys of
+  their coordinates, which wrap around every 2^21 cells in each dimension,
+  and are found through a device hash map of their keys. Cells 2^21 cells
+  apart therefore share a bin. Neighbor searches must compare distances and
+  only find additional candidates in such bins.
+
+  The binning data can be used to permute particles as with LinkedCellList.
+*/
+template <class DeviceType>
+class HashedCellList
+{
+  public:
+    //! Kokkos device_type.
+    using device_type = DeviceType;
+    //! Kokkos memory space.
+    using memory_space = typename device_type::memory_space;
+    //! Kokkos execution space.
+    using execution_space = typename device_type::execution_space;
+    //! Memory space size type.
+    using size_type = typename memory_space::size_type;
+    //! Hash map type of the cell keys.
+    using map_type = Kokkos::UnorderedMap<std::uint64_t, int, memory_space>;
+
+    /*!
+      \brief Default constructor.
+    */
+    HashedCellList()
+        : _map( 0 )
+    {
+        for ( int d = 0; d < 3; ++d )
+            _dx[d] = 1.0;
+    }
+
+    /*!
+      \brief Slice constructor
+
+      \tparam SliceType Slice type for positions.
+
+      \param positions Slice of positions.
+
+      \param cell_size Cell sizes in each cardinal direction.
+    */
+    template <class SliceType>
+    HashedCellList(
+        SliceType positions, const typename SliceType::value_type cell_size[3],
+        typename std::enable_if<( is_slice<SliceType>::value ), int>::type* =
+            0 )
+        : _map( 0 )
+    {
+        setCellSize( cell_size );
+        build( positions, 0, positions.size() );
+    }
+
+    /*!
+      \brief Slice range constructor building on an execution space instance.
+
+      \tparam ExecutionSpace The execution space type.
+
+      \tparam SliceType Slice type for positions.
+
+      \param exec_space The execution space instance to build on.
+
+      \param positions Slice of positions.
+
+      \param begin The beginning index of the slice range to bin.
+
+      \param end The end index of the slice range to bin.
+
+      \param cell_size Cell sizes in each cardinal direction.
+    */
+    template <class ExecutionSpace, class SliceType>
+    HashedCellList(
+        const ExecutionSpace& exec_space, SliceType positions,
+        const std::size_t begin, const std::size_t end,
+        const typename SliceType::value_type cell_size[3],
+        typename std::enable_if<
+            ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+              is_slice<SliceType>::value ),
+            int>::type* = 0 )
+        : _map( 0 )
+    {
+        setCellSize( cell_size );
+        build( exec_space, positions, begin, end );
+    }
+
+    /*!
+      \brief Slice range constructor
+
+      \tparam SliceType Slice type for positions.
+
+      \param positions Slice of positions.
+
+      \param begin The beginning index of the slice range to bin.
+
+      \param end The end index of the slice range to bin.
+
+      \param cell_size Cell sizes in each cardinal direction.
+    */
+    template <class SliceType>
+    HashedCellList(
+        SliceType positions, const std::size_t begin, const std::size_t end,
+        const typename SliceType::value_type cell_size[3],
+        typename std::enable_if<( is_slice<SliceType>::value ), int>::type* =
+            0 )
+        : _map( 0 )
+    {
+        setCellSize( cell_size );
+        build( positions, begin, end );
+    }
+
+    /*!
+      \brief Get the number of occupied cells.
+    */
+    KOKKOS_INLINE_FUNCTION
+    int numCell() const { return _bin_data.numBin(); }
+
+    /*!
+      \brief Get the cell size in a given dimension.
+      \param dim The dimension to get the cell size for.
+    */
+    KOKKOS_INLINE_FUNCTION
+    double cellSize( const int dim ) const { return _dx[dim]; }
+
+    /*!
+      \brief Given a position get the ijk indices of the cell containing it.
+      The indices are not wrapped.
+    */
+    KOKKOS_INLINE_FUNCTION
+    void locatePoint( const double xp, const double yp, const double zp,
+                      std::int64_t& i, std::int64_t& j, std::int64_t& k ) const
+    {
+        i = Impl::hashedCellCoordinate( xp, _dx[0] );
+        j = Impl::hashedCellCoordinate( yp, _dx[1] );
+        k = Impl::hashedCellCoordinate( zp, _dx[2] );
+    }
+
+    /*!
+      \brief Get the squared distance from a point to the closest point of a
+      cell. The distance is zero if the point is in the cell.
+    */
+    KOKKOS_INLINE_FUNCTION
+    double minDistanceToPoint( const double xp, const double yp,
+                               const double zp, const std::int64_t i,
+                               const std::int64_t j,
+                               const std::int64_t k ) const
+    {
+        const double p[3] = { xp, yp, zp };
+        const std::int64_t ijk[3] = { i, j, k };
+        double dist_sqr = 0.0;
+        for ( int d = 0; d < 3; ++d )
+        {
+            double low = ijk[d] * _dx[d];
+            double r = ( p[d] < low ) ? low - p[d] : p[d] - low - _dx[d];
+            r = ( r > 0.0 ) ? r : 0.0;
+            dist_sqr += r * r;
+        }
+        return dist_sqr;
+    }
+
+    /*!
+      \brief Find the occupied cell binning a cell.
+      \return The cell index, or -1 if the cell is empty.
+    */
+    KOKKOS_INLINE_FUNCTION
+    int findCell( const std::int64_t i, const std::int64_t j,
+                  const std::int64_t k ) const
+    {
+        auto slot = _map.find( Impl::hashedCellKey( i, j, k ) );
+        return _map.valid_at( slot ) ? _map.value_at( slot ) : -1;
+    }
+
+    /*!
+      \brief Given an occupied cell get the number of particles it contains.
+    */
+    KOKKOS_INLINE_FUNCTION
+    int binSize( const int cell ) const { return _bin_data.binSize( cell ); }
+
+    /*!
+      \brief Given an occupied cell get the particle index at which it sorts.
+    */
+    KOKKOS_INLINE_FUNCTION
+    size_type binOffset( const int cell ) const
+    {
+        return _bin_data.binOffset( cell );
+    }
+
+    /*!
+      \brief Given a local particle id in the binned layout, get the id of the
+      particle in the old (unbinned) layout.
+    */
+    KOKKOS_INLINE_FUNCTION
+    size_type permutation( const int particle_id ) const
+    {
+        return _bin_data.permutation( particle_id );
+    }
+
+    /*!
+      \brief The beginning particle index binned by the cell list.
+    */
+    KOKKOS_INLINE_FUNCTION
+    std::size_t rangeBegin() const { return _bin_data.rangeBegin(); }
+
+    /*!
+      \brief The ending particle index binned by the cell list.
+    */
+    KOKKOS_INLINE_FUNCTION
+    std::size_t rangeEnd() const { return _bin_data.rangeEnd(); }
+
+    /*!
+      \brief Get the 1d bin data of the occupied cells.
+    */
+    BinningData<DeviceType> binningData() const { return _bin_data; }
+
+    /*!
+      \brief Build the cell list with a subset of particles.
+
+      \tparam ExecutionSpace The execution space type.
+
+      \tparam SliceType Slice type for positions.
+
+      \param exec_space The execution space instance to build on. Only this
+      instance is fenced.
+
+      \param positions Slice of positions.
+
+      \param begin The beginning index of the slice range to bin.
+
+      \param end The end index of the slice range to bin.
+    */
+    template <class ExecutionSpace, class SliceType>
+    void build( const ExecutionSpace& exec_space, SliceType positions,
+                const std::size_t begin, const std::size_t end )
+    {
+        static_assert( Kokkos::is_execution_space<ExecutionSpace>::value,
+                       "Expected an execution space instance" );
+
+        Impl::ScopedProfileRegion region( "Cabana::HashedCellList::build" );
+
+        using size_view = Kokkos::View<size_type*, device_type>;
+        std::size_t num_particle = end - begin;
+
+        // Sort the particles by the keys of their cells.
+        Kokkos::View<std::uint64_t*, device_type> keys(
+            Kokkos::ViewAllocateWithoutInitializing( "hashed_cell_keys" ),
+            end );
+        double dx[3] = { _dx[0], _dx[1], _dx[2] };
+        Kokkos::parallel_for(
+            "Cabana::HashedCellList::build::keys",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, begin, end ),
+            KOKKOS_LAMBDA( const std::size_t p ) {
+                keys( p ) = Impl::hashedCellKey(
+                    Impl::hashedCellCoordinate( positions( p, 0 ), dx[0] ),
+                    Impl::hashedCellCoordinate( positions( p, 1 ), dx[1] ),
+                    Impl::hashedCellCoordinate( positions( p, 2 ), dx[2] ) );
+            } );
+        auto permutes =
+            Impl::radixPermutation<ExecutionSpace, decltype( keys ),
+                                   device_type>( exec_space, keys, begin,
+                                                 end );
+
+        // Each run of equal keys in the sorted order is an occupied cell.
+        Kokkos::RangePolicy<ExecutionSpace> sorted_range( exec_space, 0,
+                                                          num_particle );
+        int num_cell = 0;
+        Kokkos::parallel_reduce(
+            "Cabana::HashedCellList::build::count_cells", sorted_range,
+            KOKKOS_LAMBDA( const std::size_t n, int& count ) {
+                if ( 0 == n ||
+                     keys( permutes( n ) ) != keys( permutes( n - 1 ) ) )
+                    ++count;
+            },
+            num_cell );
+        size_view offsets(
+            Kokkos::ViewAllocateWithoutInitializing( "hashed_cell_offsets" ),
+            num_cell );
+        Kokkos::parallel_scan(
+            "Cabana::HashedCellList::build::offsets", sorted_range,
+            KOKKOS_LAMBDA( const std::size_t n, int& update,
+                           const bool final_pass ) {
+                if ( 0 == n ||
+                     keys( permutes( n ) ) != keys( permutes( n - 1 ) ) )
+                {
+                    if ( final_pass )
+                        offsets( update ) = n;
+                    ++update;
+                }
+            } );
+
+        // Count the particles of the cells and hash the cell keys.
+        _map.clear();
+        if ( _map.capacity() < static_cast<std::size_t>( num_cell ) )
+            _map.rehash( num_cell );
+        auto map = _map;
+        Kokkos::View<int*, device_type> counts(
+            Kokkos::ViewAllocateWithoutInitializing( "hashed_cell_counts" ),
+            num_cell );
+        Kokkos::parallel_for(
+            "Cabana::HashedCellList::build::hash",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_cell ),
+            KOKKOS_LAMBDA( const int c ) {
+                size_type next =
+                    ( c + 1 < num_cell ) ? offsets( c + 1 ) : num_particle;
+                counts( c ) = next - offsets( c );
+                map.insert( keys( permutes( offsets( c ) ) ), c );
+            } );
+        exec_space.fence();
+        if ( _map.failed_insert() )
+            throw std::runtime_error( "Failed to hash the occupied cells" );
+
+        _bin_data = BinningData<device_type>( begin, end, counts, offsets,
+                                              permutes );
+    }
+
+    /*!
+      \brief Build the cell list with a subset of particles on the default
+      execution space instance.
+
+      \tparam SliceType Slice type for positions.
+
+      \param positions Slice of positions.
+
+      \param begin The beginning index of the slice range to bin.
+
+      \param end The end index of the slice range to bin.
+    */
+    template <class SliceType>
+    void build( SliceType positions, const std::size_t begin,
+                const std::size_t end )
+    {
+        build( execution_space{}, positions, begin, end );
+    }
+
+  private:
+    template <class Scalar>
+    void setCellSize( const Scalar cell_size[3] )
+    {
+        for ( int d = 0; d < 3; ++d )
+        {
+            if ( !( cell_size[d] > 0 ) )
+                throw std::runtime_error( "Cell sizes must be positive" );
+            _dx[d] = cell_size[d];
+        }
+    }
+
+    double _dx[3];
+    BinningData<DeviceType> _bin_data;
+    map_type _map;
+};
+
+//---------------------------------------------------------------------------//
+//! \cond Impl
+// Hashed cell lists permute particles like linked cell lists.
+template <typename DeviceType>
+struct is_linked_cell_list_impl<HashedCellList<DeviceType>>
+    : public std::true_type
+{
+};
+//! \endcond
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_HASHEDCELLLIST_HPP
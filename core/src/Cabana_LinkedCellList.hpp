@@ -19,10 +19,14 @@
 #include <Cabana_Slice.hpp>
 #include <Cabana_Sort.hpp>
 #include <impl/Cabana_CartesianGrid.hpp>
+#include <impl/Cabana_Profiling.hpp>
 
 #include <Kokkos_Core.hpp>
 #include <Kokkos_ScatterView.hpp>
 
+#include <type_traits>
+#include <utility>
+
 namespace Cabana
 {
 //---------------------------------------------------------------------------//
@@ -81,6 +85,42 @@ class LinkedCellList
         build( positions, 0, np );
     }
 
+    /*!
+      \brief Slice constructor building on an execution space instance.
+
+      \tparam ExecutionSpace The execution space type.
+
+      \tparam SliceType Slice type for positions.
+
+      \param exec_space The execution space instance to build on.
+
+      \param positions Slice of positions.
+
+      \param grid_delta Grid sizes in each cardinal direction.
+
+      \param grid_min Grid minimum value in each direction.
+
+      \param grid_max Grid maximum value in each direction.
+    */
+    template <class ExecutionSpace, class SliceType>
+    LinkedCellList(
+        const ExecutionSpace& exec_space, SliceType positions,
+        const typename SliceType::value_type grid_delta[3],
+        const typename SliceType::value_type grid_min[3],
+        const typename SliceType::value_type grid_max[3],
+        typename std::enable_if<
+            ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+              is_slice<SliceType>::value ),
+            int>::type* = 0 )
+        : _grid( grid_min[0], grid_min[1], grid_min[2], grid_max[0],
+                 grid_max[1], grid_max[2], grid_delta[0], grid_delta[1],
+                 grid_delta[2] )
+    {
+        std::size_t np = positions.size();
+        allocate( totalBins(), np );
+        build( exec_space, positions, 0, np );
+    }
+
     /*!
       \brief Slice range constructor
 
@@ -114,6 +154,46 @@ class LinkedCellList
         build( positions, begin, end );
     }
 
+    /*!
+      \brief Slice range constructor building on an execution space instance.
+
+      \tparam ExecutionSpace The execution space type.
+
+      \tparam SliceType Slice type for positions.
+
+      \param exec_space The execution space instance to build on.
+
+      \param positions Slice of positions.
+
+      \param begin The beginning index of the AoSoA range to sort.
+
+      \param end The end index of the AoSoA range to sort.
+
+      \param grid_delta Grid sizes in each cardinal direction.
+
+      \param grid_min Grid minimum value in each direction.
+
+      \param grid_max Grid maximum value in each direction.
+    */
+    template <class ExecutionSpace, class SliceType>
+    LinkedCellList(
+        const ExecutionSpace& exec_space, SliceType positions,
+        const std::size_t begin, const std::size_t end,
+        const typename SliceType::value_type grid_delta[3],
+        const typename SliceType::value_type grid_min[3],
+        const typename SliceType::value_type grid_max[3],
+        typename std::enable_if<
+            ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+              is_slice<SliceType>::value ),
+            int>::type* = 0 )
+        : _grid( grid_min[0], grid_min[1], grid_min[2], grid_max[0],
+                 grid_max[1], grid_max[2], grid_delta[0], grid_delta[1],
+                 grid_delta[2] )
+    {
+        allocate( totalBins(), end - begin );
+        build( exec_space, positions, begin, end );
+    }
+
     /*!
       \brief Get the total number of bins.
       \return the total number of bins.
@@ -129,6 +209,14 @@ class LinkedCellList
     KOKKOS_INLINE_FUNCTION
     int numBin( const int dim ) const { return _grid.numBin( dim ); }
 
+    /*!
+      \brief Get the bin width in a given dimension.
+      \param dim The dimension to get the bin width for.
+      \return The bin width.
+    */
+    KOKKOS_INLINE_FUNCTION
+    double binWidth( const int dim ) const { return _grid.cellSize( dim ); }
+
     /*!
       \brief Given the ijk index of a bin get its cardinal index.
       \param i The i bin index (x).
@@ -161,6 +249,22 @@ class LinkedCellList
         _grid.ijkBinIndex( cardinal, i, j, k );
     }
 
+    /*!
+      \brief Given a position get the ijk indices of the bin containing it.
+      \param xp The x coordinate.
+      \param yp The y coordinate.
+      \param zp The z coordinate.
+      \param i The i bin index (x).
+      \param j The j bin index (y).
+      \param k The k bin index (z).
+    */
+    KOKKOS_INLINE_FUNCTION
+    void locatePoint( const double xp, const double yp, const double zp,
+                      int& i, int& j, int& k ) const
+    {
+        _grid.locatePoint( xp, yp, zp, i, j, k );
+    }
+
     /*!
       \brief Given a bin get the number of particles it contains.
       \param i The i bin index (x).
@@ -217,33 +321,59 @@ class LinkedCellList
     */
     BinningData<DeviceType> binningData() const { return _bin_data; }
 
+    /*!
+      \brief Reserve the permutation vector for a number of particles such
+      that later builds with up to this many particles do not allocate.
+
+      \param nparticles The number of particles to reserve space for.
+    */
+    void reserve( const std::size_t nparticles )
+    {
+        if ( _permutes.extent( 0 ) < nparticles )
+        {
+            Kokkos::resize( _permutes, nparticles );
+            Kokkos::resize( _cell_ids, nparticles );
+        }
+    }
+
     /*!
       \brief Build the linked cell list with a subset of particles.
 
+      \tparam ExecutionSpace The execution space type.
+
       \tparam SliceType Slice type for positions.
 
+      \param exec_space The execution space instance to build on. Only this
+      instance is fenced.
+
       \param positions Slice of positions.
 
       \param begin The beginning index of the slice range to sort.
 
       \param end The end index of the slice range to sort.
     */
-    template <class SliceType>
-    void build( SliceType positions, const std::size_t begin,
-                const std::size_t end )
+    template <class ExecutionSpace, class SliceType>
+    void build( const ExecutionSpace& exec_space, SliceType positions,
+                const std::size_t begin, const std::size_t end )
     {
+        static_assert( Kokkos::is_execution_space<ExecutionSpace>::value,
+                       "Expected an execution space instance" );
+
+        Impl::ScopedProfileRegion region( "Cabana::LinkedCellList::build" );
+
         // Resize the binning data. Note that the permutation vector spans
-        // only the length of begin-end;
+        // only the length of begin-end. The cell data is kept as long as the
+        // grid is unchanged and the permutation vector only grows such that
+        // repeated builds do not allocate.
         std::size_t ncell = totalBins();
         if ( _counts.extent( 0 ) != ncell )
         {
-            Kokkos::resize( _counts, ncell );
-            Kokkos::resize( _offsets, ncell );
+            allocateCells( ncell );
         }
         std::size_t nparticles = end - begin;
-        if ( _permutes.extent( 0 ) != nparticles )
+        if ( _permutes.extent( 0 ) < nparticles )
         {
-            Kokkos::resize( _permutes, nparticles );
+            allocatePermutes( nparticles );
         }
 
         // Get local copies of class data for lambda function capture.
@@ -251,11 +381,19 @@ class LinkedCellList
         auto counts = _counts;
         auto offsets = _offsets;
         auto permutes = _permutes;
+        auto cell_ids = _cell_ids;
 
         // Count.
-        Kokkos::RangePolicy<execution_space> particle_range( begin, end );
-        Kokkos::deep_copy( _counts, 0 );
-        auto counts_sv = Kokkos::Experimental::create_scatter_view( _counts );
+        Kokkos::RangePolicy<ExecutionSpace> particle_range( exec_space, begin,
+                                                            end );
+        Kokkos::deep_copy( exec_space, _counts, 0 );
+#if KOKKOS_VERSION >= 30300
+        _counts_sv.reset( exec_space );
+#else
+        _counts_sv.reset();
+        execution_space().fence();
+#endif
+        auto counts_sv = _counts_sv;
         auto cell_count = KOKKOS_LAMBDA( const std::size_t p )
         {
             int i, j, k;
@@ -266,11 +404,16 @@ class LinkedCellList
         };
         Kokkos::parallel_for( "Cabana::LinkedCellList::build::cell_count",
                               particle_range, cell_count );
-        Kokkos::fence();
+#if KOKKOS_VERSION >= 30300
+        Kokkos::Experimental::contribute( exec_space, _counts, counts_sv );
+#else
+        exec_space.fence();
         Kokkos::Experimental::contribute( _counts, counts_sv );
+        execution_space().fence();
+#endif
 
         // Compute offsets.
-        Kokkos::RangePolicy<execution_space> cell_range( 0, ncell );
+        Kokkos::RangePolicy<ExecutionSpace> cell_range( exec_space, 0, ncell );
         auto offset_scan = KOKKOS_LAMBDA( const std::size_t c, int& update,
                                           const bool final_pass )
         {
@@ -280,10 +423,9 @@ class LinkedCellList
         };
         Kokkos::parallel_scan( "Cabana::LinkedCellList::build::offset_scan",
                                cell_range, offset_scan );
-        Kokkos::fence();
 
         // Reset counts.
-        Kokkos::deep_copy( _counts, 0 );
+        Kokkos::deep_copy( exec_space, _counts, 0 );
 
         // Compute the permutation vector.
         auto create_permute = KOKKOS_LAMBDA( const std::size_t p )
@@ -294,19 +436,60 @@ class LinkedCellList
             auto cell_id = grid.cardinalCellIndex( i, j, k );
             int c = Kokkos::atomic_fetch_add( &counts( cell_id ), 1 );
             permutes( offsets( cell_id ) + c ) = p;
+            cell_ids( p - begin ) = cell_id;
         };
         Kokkos::parallel_for( "Cabana::LinkedCellList::build::create_permute",
                               particle_range, create_permute );
-        Kokkos::fence();
+        exec_space.fence();
 
         // Create the binning data.
-        _bin_data =
-            BinningData<DeviceType>( begin, end, _counts, _offsets, _permutes );
+        _bin_data = BinningData<DeviceType>(
+            begin, end, _counts, _offsets,
+            Kokkos::subview( _permutes,
+                             Kokkos::pair<std::size_t, std::size_t>(
+                                 0, nparticles ) ) );
+    }
+
+    /*!
+      \brief Build the linked cell list with a subset of particles on the
+      default execution space instance.
+
+      \tparam SliceType Slice type for positions.
+
+      \param positions Slice of positions.
+
+      \param begin The beginning index of the slice range to sort.
+
+      \param end The end index of the slice range to sort.
+    */
+    template <class SliceType>
+    void build( SliceType positions, const std::size_t begin,
+                const std::size_t end )
+    {
+        build( execution_space(), positions, begin, end );
     }
 
     /*!
       \brief Build the linked cell list with all particles.
 
+      \tparam ExecutionSpace The execution space type.
+
+      \tparam SliceType Slice type for positions.
+
+      \param exec_space The execution space instance to build on.
+
+      \param positions Slice of positions.
+    */
+    template <class ExecutionSpace, class SliceType>
+    void build( const ExecutionSpace& exec_space, SliceType positions )
+    {
+        build( exec_space, positions, 0, positions.size() );
+    }
+
+    /*!
+      \brief Build the linked cell list with all particles on the default
+      execution space instance.
+
       \tparam SliceType Slice type for positions.
 
       \param positions Slice of positions.
@@ -314,7 +497,186 @@ class LinkedCellList
     template <class SliceType>
     void build( SliceType positions )
     {
-        build( positions, 0, positions.size() );
+        build( execution_space(), positions, 0, positions.size() );
+    }
+
+    /*!
+      \brief Update the linked cell list after the particles of the last build
+      moved.
+
+      \tparam ExecutionSpace The execution space type.
+
+      \tparam SliceType Slice type for positions.
+
+      \param exec_space The execution space instance to update on.
+
+      \param positions Slice of positions. The particles in the range of the
+      last build must be the same particles in the same order as in that
+      build, i.e. the particles must not have been permuted with this list
+      since then.
+
+      Every particle is located again and every particle is written to the
+      new permutation: the particles that stayed in their cell keep their
+      relative order and are copied to the new cell offsets, and the
+      particles that changed cell are appended to their new cells. Only the
+      cell count updates are limited to the particles that changed cell. The
+      list is left untouched if no particle changed cell.
+    */
+    template <class ExecutionSpace, class SliceType>
+    void update( const ExecutionSpace& exec_space, SliceType positions )
+    {
+        static_assert( Kokkos::is_execution_space<ExecutionSpace>::value,
+                       "Expected an execution space instance" );
+
+        Impl::ScopedProfileRegion region( "Cabana::LinkedCellList::update" );
+
+        std::size_t begin = _bin_data.rangeBegin();
+        std::size_t end = _bin_data.rangeEnd();
+        std::size_t nparticles = end - begin;
+        std::size_t ncell = totalBins();
+
+        // Allocate the update buffers.
+        if ( _update_counts.extent( 0 ) != ncell )
+        {
+            _update_counts = CountView(
+                Kokkos::view_alloc( Kokkos::WithoutInitializing, "counts" ),
+                ncell );
+            _update_offsets = OffsetView(
+                Kokkos::view_alloc( Kokkos::WithoutInitializing, "offsets" ),
+                ncell );
+        }
+        if ( _update_permutes.extent( 0 ) < _permutes.extent( 0 ) )
+        {
+            _update_permutes = OffsetView(
+                Kokkos::view_alloc( Kokkos::WithoutInitializing, "permutes" ),
+                _permutes.extent( 0 ) );
+            _update_cell_ids = Kokkos::View<int*, device_type>(
+                Kokkos::view_alloc( Kokkos::WithoutInitializing, "cell_ids" ),
+                _permutes.extent( 0 ) );
+            _movers = Kokkos::View<int*, device_type>(
+                Kokkos::view_alloc( Kokkos::WithoutInitializing, "movers" ),
+                _permutes.extent( 0 ) );
+        }
+
+        // Get local copies of class data for lambda function capture.
+        auto grid = _grid;
+        auto counts = _counts;
+        auto offsets = _offsets;
+        auto permutes = _permutes;
+        auto cell_ids = _cell_ids;
+        auto new_counts = _update_counts;
+        auto new_offsets = _update_offsets;
+        auto new_permutes = _update_permutes;
+        auto new_cell_ids = _update_cell_ids;
+        auto movers = _movers;
+
+        // Locate the particles and compact the ones that changed cell.
+        Kokkos::RangePolicy<ExecutionSpace> particle_range( exec_space, 0,
+                                                            nparticles );
+        auto find_movers = KOKKOS_LAMBDA( const std::size_t b, int& update,
+                                          const bool final_pass )
+        {
+            std::size_t p = b + begin;
+            int i, j, k;
+            grid.locatePoint( positions( p, 0 ), positions( p, 1 ),
+                              positions( p, 2 ), i, j, k );
+            int cell_id = grid.cardinalCellIndex( i, j, k );
+            if ( final_pass )
+            {
+                new_cell_ids( b ) = cell_id;
+                if ( cell_id != cell_ids( b ) )
+                    movers( update ) = b;
+            }
+            if ( cell_id != cell_ids( b ) )
+                ++update;
+        };
+        int num_mover = 0;
+        Kokkos::parallel_scan( "Cabana::LinkedCellList::update::find_movers",
+                               particle_range, find_movers, num_mover );
+        exec_space.fence();
+        if ( 0 == num_mover )
+            return;
+
+        // Move the counts of the particles that changed cell.
+        Kokkos::deep_copy( exec_space, _update_counts, _counts );
+        Kokkos::RangePolicy<ExecutionSpace> mover_range( exec_space, 0,
+                                                         num_mover );
+        auto move_counts = KOKKOS_LAMBDA( const int m )
+        {
+            int b = movers( m );
+            Kokkos::atomic_decrement( &new_counts( cell_ids( b ) ) );
+            Kokkos::atomic_increment( &new_counts( new_cell_ids( b ) ) );
+        };
+        Kokkos::parallel_for( "Cabana::LinkedCellList::update::move_counts",
+                              mover_range, move_counts );
+
+        // Compute offsets.
+        Kokkos::RangePolicy<ExecutionSpace> cell_range( exec_space, 0, ncell );
+        auto offset_scan = KOKKOS_LAMBDA( const std::size_t c, int& update,
+                                          const bool final_pass )
+        {
+            if ( final_pass )
+                new_offsets( c ) = update;
+            update += new_counts( c );
+        };
+        Kokkos::parallel_scan( "Cabana::LinkedCellList::update::offset_scan",
+                               cell_range, offset_scan );
+
+        // Move the particles that stayed in their cell to the new offsets. The
+        // old counts are reused to count the particles added to each cell.
+        auto move_stayers = KOKKOS_LAMBDA( const std::size_t c )
+        {
+            int n = 0;
+            for ( std::size_t b = offsets( c ); b < offsets( c ) + counts( c );
+                  ++b )
+            {
+                std::size_t p = permutes( b );
+                if ( new_cell_ids( p - begin ) == static_cast<int>( c ) )
+                {
+                    new_permutes( new_offsets( c ) + n ) = p;
+                    ++n;
+                }
+            }
+            counts( c ) = n;
+        };
+        Kokkos::parallel_for( "Cabana::LinkedCellList::update::move_stayers",
+                              cell_range, move_stayers );
+
+        // Add the particles that changed cell.
+        auto add_movers = KOKKOS_LAMBDA( const int m )
+        {
+            int b = movers( m );
+            int cell_id = new_cell_ids( b );
+            int n = Kokkos::atomic_fetch_add( &counts( cell_id ), 1 );
+            new_permutes( new_offsets( cell_id ) + n ) = b + begin;
+        };
+        Kokkos::parallel_for( "Cabana::LinkedCellList::update::add_movers",
+                              mover_range, add_movers );
+        exec_space.fence();
+
+        // Swap in the new binning. The counts were already updated in place.
+        std::swap( _offsets, _update_offsets );
+        std::swap( _permutes, _update_permutes );
+        std::swap( _cell_ids, _update_cell_ids );
+        _bin_data = BinningData<DeviceType>(
+            begin, end, _counts, _offsets,
+            Kokkos::subview( _permutes,
+                             Kokkos::pair<std::size_t, std::size_t>(
+                                 0, nparticles ) ) );
+    }
+
+    /*!
+      \brief Update the linked cell list after the particles of the last build
+      moved on the default execution space instance.
+
+      \tparam SliceType Slice type for positions.
+
+      \param positions Slice of positions.
+    */
+    template <class SliceType>
+    void update( SliceType positions )
+    {
+        update( execution_space(), positions );
     }
 
   private:
@@ -325,7 +687,30 @@ class LinkedCellList
     OffsetView _offsets;
     OffsetView _permutes;
 
+    // Cell count scatter view, kept with the counts such that it is not
+    // recreated for each build.
+    using CountScatterView =
+        decltype( Kokkos::Experimental::create_scatter_view(
+            std::declval<CountView>() ) );
+    CountScatterView _counts_sv;
+
+    // Cell of each binned particle.
+    Kokkos::View<int*, device_type> _cell_ids;
+
+    // Buffers for incremental updates.
+    CountView _update_counts;
+    OffsetView _update_offsets;
+    OffsetView _update_permutes;
+    Kokkos::View<int*, device_type> _update_cell_ids;
+    Kokkos::View<int*, device_type> _movers;
+
     void allocate( const int ncell, const int nparticles )
+    {
+        allocateCells( ncell );
+        allocatePermutes( nparticles );
+    }
+
+    void allocateCells( const int ncell )
     {
         _counts = CountView(
             Kokkos::view_alloc( Kokkos::WithoutInitializing, "counts" ),
@@ -333,9 +718,17 @@ class LinkedCellList
         _offsets = OffsetView(
             Kokkos::view_alloc( Kokkos::WithoutInitializing, "offsets" ),
             ncell );
+        _counts_sv = Kokkos::Experimental::create_scatter_view( _counts );
+    }
+
+    void allocatePermutes( const int nparticles )
+    {
         _permutes = OffsetView(
             Kokkos::view_alloc( Kokkos::WithoutInitializing, "permutes" ),
             nparticles );
+        _cell_ids = Kokkos::View<int*, device_type>(
+            Kokkos::view_alloc( Kokkos::WithoutInitializing, "cell_ids" ),
+            nparticles );
     }
 };
 
@@ -360,6 +753,35 @@ struct is_linked_cell_list
 {
 };
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief Given a linked cell list permute an AoSoA.
+
+  \tparam ExecutionSpace The execution space type.
+
+  \tparam LinkedCellListType The linked cell list type.
+
+  \tparam AoSoA_t The AoSoA type.
+
+  \param exec_space The execution space instance to permute on.
+
+  \param linked_cell_list The linked cell list to permute the AoSoA with.
+
+  \param aosoa The AoSoA to permute.
+ */
+template <class ExecutionSpace, class LinkedCellListType, class AoSoA_t>
+void permute(
+    const ExecutionSpace& exec_space,
+    const LinkedCellListType& linked_cell_list, AoSoA_t& aosoa,
+    typename std::enable_if<
+        ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+          is_linked_cell_list<LinkedCellListType>::value &&
+          is_aosoa<AoSoA_t>::value ),
+        int>::type* = 0 )
+{
+    permute( exec_space, linked_cell_list.binningData(), aosoa );
+}
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Given a linked cell list permute an AoSoA.
@@ -382,6 +804,35 @@ void permute(
     permute( linked_cell_list.binningData(), aosoa );
 }
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief Given a linked cell list permute a slice.
+
+  \tparam ExecutionSpace The execution space type.
+
+  \tparam LinkedCellListType The linked cell list type.
+
+  \tparam SliceType The slice type.
+
+  \param exec_space The execution space instance to permute on.
+
+  \param linked_cell_list The linked cell list to permute the slice with.
+
+  \param slice The slice to permute.
+ */
+template <class ExecutionSpace, class LinkedCellListType, class SliceType>
+void permute(
+    const ExecutionSpace& exec_space,
+    const LinkedCellListType& linked_cell_list, SliceType& slice,
+    typename std::enable_if<
+        ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+          is_linked_cell_list<LinkedCellListType>::value &&
+          is_slice<SliceType>::value ),
+        int>::type* = 0 )
+{
+    permute( exec_space, linked_cell_list.binningData(), slice );
+}
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Given a linked cell list permute a slice.
@@ -404,6 +855,61 @@ void permute(
     permute( linked_cell_list.binningData(), slice );
 }
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief Given a linked cell list permute several slices together.
+
+  \tparam LinkedCellListType The linked cell list type.
+
+  \tparam SliceTypes The slice types.
+
+  \param linked_cell_list The linked cell list to permute the slices with.
+
+  \param slice_a The first slice to permute.
+
+  \param slice_b The second slice to permute.
+
+  \param slices The remaining slices to permute.
+ */
+template <class LinkedCellListType, class SliceTypeA, class SliceTypeB,
+          class... SliceTypes>
+typename std::enable_if<( is_linked_cell_list<LinkedCellListType>::value &&
+                          is_slice<SliceTypeA>::value &&
+                          is_slice<SliceTypeB>::value ),
+                        void>::type
+permute( const LinkedCellListType& linked_cell_list, SliceTypeA& slice_a,
+         SliceTypeB& slice_b, SliceTypes&... slices )
+{
+    permute( linked_cell_list.binningData(), slice_a, slice_b, slices... );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Given a linked cell list permute an AoSoA one member at a time with a
+  bounded scratch allocation.
+
+  \tparam LinkedCellListType The linked cell list type.
+
+  \tparam AoSoA_t The AoSoA type.
+
+  \param linked_cell_list The linked cell list to permute the AoSoA with.
+
+  \param aosoa The AoSoA to permute.
+
+  \param max_scratch_bytes The maximum scratch allocation in bytes.
+ */
+template <class LinkedCellListType, class AoSoA_t>
+void permuteMemberwise(
+    const LinkedCellListType& linked_cell_list, AoSoA_t& aosoa,
+    const std::size_t max_scratch_bytes,
+    typename std::enable_if<( is_linked_cell_list<LinkedCellListType>::value &&
+                              is_aosoa<AoSoA_t>::value ),
+                            int>::type* = 0 )
+{
+    permuteMemberwise( linked_cell_list.binningData(), aosoa,
+                       max_scratch_bytes );
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Cabana
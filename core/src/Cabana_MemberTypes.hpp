@@ -16,6 +16,8 @@
 #ifndef CABANA_MEMBERTYPES_HPP
 #define CABANA_MEMBERTYPES_HPP
 
+#include <Cabana_ReducedPrecision.hpp>
+
 #include <cstdlib>
 #include <type_traits>
 
@@ -97,8 +99,10 @@ struct CheckMemberTypesImpl<0, T, Types...>
                    "Member types must be trivial" );
 
     using value_type = typename std::remove_all_extents<type>::type;
-    static_assert( std::is_arithmetic<value_type>::value,
-                   "Member value types must be arithmetic" );
+    static_assert( std::is_arithmetic<value_type>::value ||
+                       is_reduced_precision<value_type>::value,
+                   "Member value types must be arithmetic or reduced "
+                   "precision" );
 
     // Return true so we get the whole stack to evaluate all the assertions.
     static constexpr bool value = true;
@@ -112,8 +116,10 @@ struct CheckMemberTypesImpl
                    "Member types must be trivial" );
 
     using value_type = typename std::remove_all_extents<type>::type;
-    static_assert( std::is_arithmetic<value_type>::value,
-                   "Member value types must be arithmetic" );
+    static_assert( std::is_arithmetic<value_type>::value ||
+                       is_reduced_precision<value_type>::value,
+                   "Member value types must be arithmetic or reduced "
+                   "precision" );
 
     static constexpr bool value = CheckMemberTypesImpl<M - 1, Types...>::value;
 };
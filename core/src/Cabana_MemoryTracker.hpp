@@ -0,0 +1,327 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_MemoryTracker.hpp
+  \brief Tracking of the memory allocated by Cabana and Cajita operations
+*/
+#ifndef CABANA_MEMORYTRACKER_HPP
+#define CABANA_MEMORYTRACKER_HPP
+
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if KOKKOS_VERSION >= 30300
+
+namespace Cabana
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief Memory usage of a category or label of tracked allocations.
+*/
+struct MemoryUsage
+{
+    //! Bytes currently allocated.
+    std::size_t current_bytes = 0;
+    //! Largest number of bytes allocated at once since the last reset.
+    std::size_t peak_bytes = 0;
+    //! Number of allocations since the last reset.
+    std::size_t num_allocations = 0;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Tracker of the memory allocated by Cabana and Cajita operations.
+
+  While the tracker is running every Kokkos allocation made inside a Cabana
+  or Cajita operation is recorded with its label and the operation that owns
+  it. The owner is the outermost "Cabana::" or "Cajita::" profiling region
+  open when the allocation is made, e.g. "Cabana::VerletList::build" or
+  "Cabana::gather", such that transient buffers (e.g. sort and permute
+  temporaries, distributor buffers) are attributed to the operation creating
+  them and persistent buffers (e.g. halo buffers, neighbor lists) are
+  attributed to the operation that last grew them. Allocations made outside
+  of these operations are not tracked. Deallocations are matched to their
+  allocation such that memory freed outside of an operation (e.g. when a
+  neighbor list is destroyed) is accounted for.
+
+  The tracker is implemented with the Kokkos Tools allocation and region
+  callbacks. Callbacks installed before the tracker is started (e.g. by a
+  loaded tool library) are still called while it is running and restored
+  when it is stopped.
+
+  \note Tracking requires Kokkos 3.3 or later.
+*/
+class MemoryTracker
+{
+  public:
+    /*!
+      \brief Start tracking allocations. Usage counters are reset.
+    */
+    static void start()
+    {
+        auto& s = state();
+        std::lock_guard<std::mutex> lock( s.mutex );
+        if ( s.running )
+            return;
+        s.running = true;
+        s.regions.clear();
+        s.allocations.clear();
+        s.categories.clear();
+        s.labels.clear();
+        s.total = MemoryUsage();
+
+        s.previous = Kokkos::Tools::Experimental::get_callbacks();
+        Kokkos::Tools::Experimental::set_push_region_callback( pushRegion );
+        Kokkos::Tools::Experimental::set_pop_region_callback( popRegion );
+        Kokkos::Tools::Experimental::set_allocate_data_callback(
+            allocateData );
+        Kokkos::Tools::Experimental::set_deallocate_data_callback(
+            deallocateData );
+    }
+
+    /*!
+      \brief Stop tracking allocations and restore the previous callbacks.
+      The usage recorded so far may still be queried.
+    */
+    static void stop()
+    {
+        auto& s = state();
+        std::lock_guard<std::mutex> lock( s.mutex );
+        if ( !s.running )
+            return;
+        s.running = false;
+        Kokkos::Tools::Experimental::set_push_region_callback(
+            s.previous.push_region );
+        Kokkos::Tools::Experimental::set_pop_region_callback(
+            s.previous.pop_region );
+        Kokkos::Tools::Experimental::set_allocate_data_callback(
+            s.previous.allocate_data );
+        Kokkos::Tools::Experimental::set_deallocate_data_callback(
+            s.previous.deallocate_data );
+    }
+
+    //! Determine if allocations are being tracked.
+    static bool running()
+    {
+        auto& s = state();
+        std::lock_guard<std::mutex> lock( s.mutex );
+        return s.running;
+    }
+
+    /*!
+      \brief Reset the peaks to the current usage and the allocation counts
+      to zero, e.g. at the start of a time step.
+    */
+    static void resetPeaks()
+    {
+        auto& s = state();
+        std::lock_guard<std::mutex> lock( s.mutex );
+        auto reset = []( MemoryUsage& usage ) {
+            usage.peak_bytes = usage.current_bytes;
+            usage.num_allocations = 0;
+        };
+        reset( s.total );
+        for ( auto& c : s.categories )
+            reset( c.second );
+        for ( auto& c : s.labels )
+            for ( auto& l : c.second )
+                reset( l.second );
+    }
+
+    //! Get the usage of all tracked allocations.
+    static MemoryUsage total()
+    {
+        auto& s = state();
+        std::lock_guard<std::mutex> lock( s.mutex );
+        return s.total;
+    }
+
+    //! Get the usage of each owning operation.
+    static std::map<std::string, MemoryUsage> categories()
+    {
+        auto& s = state();
+        std::lock_guard<std::mutex> lock( s.mutex );
+        return s.categories;
+    }
+
+    //! Get the usage of each allocation label of an owning operation.
+    static std::map<std::string, MemoryUsage>
+    labels( const std::string& category )
+    {
+        auto& s = state();
+        std::lock_guard<std::mutex> lock( s.mutex );
+        auto it = s.labels.find( category );
+        return ( it == s.labels.end() ) ? std::map<std::string, MemoryUsage>()
+                                        : it->second;
+    }
+
+    /*!
+      \brief Write the current and peak usage of each owning operation and
+      its allocation labels, ordered by peak usage.
+
+      \param stream The stream to write to.
+    */
+    static void report( std::ostream& stream )
+    {
+        auto by_peak = []( const std::map<std::string, MemoryUsage>& usage ) {
+            std::vector<std::pair<std::string, MemoryUsage>> sorted(
+                usage.begin(), usage.end() );
+            std::stable_sort( sorted.begin(), sorted.end(),
+                              []( const auto& a, const auto& b ) {
+                                  return a.second.peak_bytes >
+                                         b.second.peak_bytes;
+                              } );
+            return sorted;
+        };
+        auto write = [&]( const std::string& name, const MemoryUsage& u ) {
+            stream << name << " current " << u.current_bytes << " peak "
+                   << u.peak_bytes << " allocations " << u.num_allocations
+                   << "\n";
+        };
+
+        write( "total", total() );
+        for ( auto& c : by_peak( categories() ) )
+        {
+            write( c.first, c.second );
+            for ( auto& l : by_peak( labels( c.first ) ) )
+                write( "    " + l.first, l.second );
+        }
+        stream << std::flush;
+    }
+
+  private:
+    // A live tracked allocation.
+    struct Allocation
+    {
+        std::string category;
+        std::string label;
+        std::size_t bytes;
+    };
+
+    // Tracker state.
+    struct State
+    {
+        std::mutex mutex;
+        bool running = false;
+        Kokkos::Tools::Experimental::EventSet previous{};
+        std::vector<std::string> regions;
+        std::map<const void*, Allocation> allocations;
+        std::map<std::string, MemoryUsage> categories;
+        std::map<std::string, std::map<std::string, MemoryUsage>> labels;
+        MemoryUsage total;
+    };
+
+    static State& state()
+    {
+        static State s;
+        return s;
+    }
+
+    static void add( MemoryUsage& usage, const std::size_t bytes )
+    {
+        usage.current_bytes += bytes;
+        usage.peak_bytes = std::max( usage.peak_bytes, usage.current_bytes );
+        ++usage.num_allocations;
+    }
+
+    static void remove( MemoryUsage& usage, const std::size_t bytes )
+    {
+        usage.current_bytes -= std::min( usage.current_bytes, bytes );
+    }
+
+    static void pushRegion( const char* name )
+    {
+        auto& s = state();
+        {
+            std::lock_guard<std::mutex> lock( s.mutex );
+            s.regions.emplace_back( name );
+        }
+        if ( s.previous.push_region )
+            s.previous.push_region( name );
+    }
+
+    static void popRegion()
+    {
+        auto& s = state();
+        {
+            std::lock_guard<std::mutex> lock( s.mutex );
+            if ( !s.regions.empty() )
+                s.regions.pop_back();
+        }
+        if ( s.previous.pop_region )
+            s.previous.pop_region();
+    }
+
+    static void allocateData( const Kokkos::Profiling::SpaceHandle handle,
+                              const char* label, const void* ptr,
+                              const std::uint64_t size )
+    {
+        auto& s = state();
+        {
+            std::lock_guard<std::mutex> lock( s.mutex );
+            auto owner = std::find_if(
+                s.regions.begin(), s.regions.end(),
+                []( const std::string& r ) {
+                    return 0 == r.compare( 0, 8, "Cabana::" ) ||
+                           0 == r.compare( 0, 8, "Cajita::" );
+                } );
+            if ( owner != s.regions.end() && nullptr != ptr )
+            {
+                Allocation a{ *owner, label, size };
+                add( s.total, a.bytes );
+                add( s.categories[a.category], a.bytes );
+                add( s.labels[a.category][a.label], a.bytes );
+                s.allocations[ptr] = std::move( a );
+            }
+        }
+        if ( s.previous.allocate_data )
+            s.previous.allocate_data( handle, label, ptr, size );
+    }
+
+    static void deallocateData( const Kokkos::Profiling::SpaceHandle handle,
+                                const char* label, const void* ptr,
+                                const std::uint64_t size )
+    {
+        auto& s = state();
+        {
+            std::lock_guard<std::mutex> lock( s.mutex );
+            auto it = s.allocations.find( ptr );
+            if ( it != s.allocations.end() )
+            {
+                const auto& a = it->second;
+                remove( s.total, a.bytes );
+                remove( s.categories[a.category], a.bytes );
+                remove( s.labels[a.category][a.label], a.bytes );
+                s.allocations.erase( it );
+            }
+        }
+        if ( s.previous.deallocate_data )
+            s.previous.deallocate_data( handle, label, ptr, size );
+    }
+};
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end KOKKOS_VERSION >= 30300
+
+#endif // end CABANA_MEMORYTRACKER_HPP
@@ -18,6 +18,8 @@
 
 #include <Kokkos_Core.hpp>
 
+#include <cstddef>
+
 namespace Cabana
 {
 //---------------------------------------------------------------------------//
@@ -71,6 +73,83 @@ class NeighborList
                                     const std::size_t neighbor_index );
 };
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief Statistics of the last build of a neighbor list.
+
+  Used to tune build parameters such as the cell size ratio and the
+  preallocated number of neighbors per particle.
+*/
+struct NeighborListStats
+{
+    //! Number of particles the neighbors were computed for.
+    std::size_t num_particle = 0;
+
+    //! Total number of stored neighbors.
+    std::size_t total_neighbor = 0;
+
+    //! Maximum number of neighbors of a particle.
+    std::size_t max_neighbor = 0;
+
+    //! Mean number of neighbors per particle.
+    double mean_neighbor = 0.0;
+
+    //! Memory used by the neighbor data in bytes.
+    std::size_t memory_bytes = 0;
+
+    //! Number of builds of the list.
+    int num_build = 0;
+
+    //! Number of builds in which the preallocated neighbor storage
+    //! overflowed and the list was refilled.
+    int num_refill = 0;
+};
+
+//---------------------------------------------------------------------------//
+namespace Impl
+{
+//! \cond Impl
+// Get the memory used by the data of a view in bytes.
+template <class ViewType>
+std::size_t viewBytes( const ViewType& view )
+{
+    return view.span() * sizeof( typename ViewType::value_type );
+}
+
+// Compute the neighbor count statistics over a range of particles given the
+// number of neighbors of each particle.
+template <class ExecutionSpace, class CountFunctor>
+void neighborCountStats( ExecutionSpace, const std::size_t begin,
+                         const std::size_t end, const CountFunctor& count,
+                         NeighborListStats& stats )
+{
+    Kokkos::RangePolicy<ExecutionSpace> policy( begin, end );
+    std::size_t total = 0;
+    Kokkos::parallel_reduce(
+        "Cabana::neighborListStats::total", policy,
+        KOKKOS_LAMBDA( const std::size_t i, std::size_t& result ) {
+            result += count( i );
+        },
+        total );
+    std::size_t max_n = 0;
+    Kokkos::parallel_reduce(
+        "Cabana::neighborListStats::max", policy,
+        KOKKOS_LAMBDA( const std::size_t i, std::size_t& result ) {
+            std::size_t n = count( i );
+            if ( n > result )
+                result = n;
+        },
+        Kokkos::Max<std::size_t>( max_n ) );
+
+    stats.num_particle = end - begin;
+    stats.total_neighbor = total;
+    stats.max_neighbor = max_n;
+    stats.mean_neighbor =
+        ( end > begin ) ? static_cast<double>( total ) / ( end - begin ) : 0.0;
+}
+//! \endcond
+} // end namespace Impl
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Cabana
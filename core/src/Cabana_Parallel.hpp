@@ -18,11 +18,16 @@
 
 #include <Cabana_ExecutionPolicy.hpp>
 #include <Cabana_NeighborList.hpp>
+#include <Cabana_ScratchSlice.hpp>
+#include <Cabana_SimdBatch.hpp>
 #include <Cabana_Types.hpp> // is_accessible_from
 
 #include <Kokkos_Core.hpp>
 
+#include <array>
+#include <cmath>
 #include <cstdlib>
+#include <stdexcept>
 #include <type_traits>
 
 namespace Cabana
@@ -152,6 +157,349 @@ inline void simd_parallel_for(
             str, dynamic_cast<const team_policy&>( exec_policy ), simd_func );
 }
 
+//---------------------------------------------------------------------------//
+//! Execute a SIMD functor once per struct to operate on batches of array
+//! elements.
+class SimdBatchTag
+{
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Execute a functor once per struct over a 2D range of indices.
+
+  \tparam FunctorType The functor type to execute.
+
+  \tparam VectorLength The length of the inner arrays of the structs.
+
+  \tparam ExecParameters Execution policy parameters.
+
+  \param exec_policy The 2D range policy over which to execute the functor.
+
+  \param functor The functor to execute.
+
+  \param str Optional name for the functor.
+
+  The functor is called as <tt>functor( s, a_begin, a_end )</tt> for every
+  struct index s in the policy, where [a_begin,a_end) is the range of array
+  elements of the struct inside the policy. The functor operates on all array
+  elements of the struct at once, typically by loading and storing
+  Cabana::SimdBatch values with loadBatch() and storeBatch(), so the inner
+  loop is explicitly vectorized rather than relying on the compiler to
+  vectorize the array index loop. This is intended for host execution spaces
+  where each struct maps to SIMD lanes of a single thread.
+*/
+template <class FunctorType, int VectorLength, class... ExecParameters>
+inline void simd_parallel_for(
+    const SimdPolicy<VectorLength, ExecParameters...>& exec_policy,
+    const FunctorType& functor, const SimdBatchTag&,
+    const std::string& str = "" )
+{
+    using simd_policy = SimdPolicy<VectorLength, ExecParameters...>;
+
+    using work_tag = typename simd_policy::work_tag;
+
+    using execution_space = typename simd_policy::execution_space;
+
+    using index_type = typename simd_policy::index_type;
+
+    Kokkos::RangePolicy<execution_space, index_type> struct_policy(
+        exec_policy.structBegin(), exec_policy.structEnd() );
+
+    auto batch_func = KOKKOS_LAMBDA( const index_type s )
+    {
+        Impl::functorTagDispatch<work_tag>( functor, s,
+                                            exec_policy.arrayBegin( s ),
+                                            exec_policy.arrayEnd( s ) );
+    };
+    if ( str.empty() )
+        Kokkos::parallel_for( struct_policy, batch_func );
+    else
+        Kokkos::parallel_for( str, struct_policy, batch_func );
+}
+
+//---------------------------------------------------------------------------//
+// SIMD Parallel Reduce
+//---------------------------------------------------------------------------//
+//! \cond Impl
+namespace Impl
+{
+// Reduce the array elements of a struct and join struct results for a
+// scalar sum.
+template <class ReduceType, bool = Kokkos::is_reducer<ReduceType>::value>
+struct SimdReduceTraits
+{
+    using value_type = ReduceType;
+
+    template <class RangeType, class LaneFunctor>
+    KOKKOS_INLINE_FUNCTION static void
+    reduceStruct( const RangeType& range, const LaneFunctor& lane_functor,
+                  value_type& struct_val )
+    {
+        struct_val = 0;
+        Kokkos::parallel_reduce( range, lane_functor, struct_val );
+    }
+
+    KOKKOS_INLINE_FUNCTION static void join( value_type& dst,
+                                             const value_type& src )
+    {
+        dst += src;
+    }
+};
+
+// Reduce the array elements of a struct and join struct results for a
+// Kokkos reducer.
+template <class ReduceType>
+struct SimdReduceTraits<ReduceType, true>
+{
+    using value_type = typename ReduceType::value_type;
+
+    template <class RangeType, class LaneFunctor>
+    KOKKOS_INLINE_FUNCTION static void
+    reduceStruct( const RangeType& range, const LaneFunctor& lane_functor,
+                  value_type& struct_val )
+    {
+        Kokkos::parallel_reduce( range, lane_functor,
+                                 ReduceType( struct_val ) );
+    }
+
+    KOKKOS_INLINE_FUNCTION static void join( value_type& dst,
+                                             const value_type& src )
+    {
+        ReduceType( dst ).join( dst, src );
+    }
+};
+} // end namespace Impl
+//! \endcond
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Execute a vectorized reduction functor in parallel with a 2d
+  execution policy.
+
+  \tparam FunctorType The functor type to execute.
+
+  \tparam VectorLength The length of the vector over which to execute the
+  vectorized code.
+
+  \tparam ExecParameters Execution policy parameters.
+
+  \tparam ReduceType The reduction type: a scalar, which is summed, or a
+  Kokkos reducer such as Kokkos::Max.
+
+  \param exec_policy The 2D range policy over which to execute the functor.
+
+  \param functor The vectorized functor to execute in parallel. Must accept a
+  struct index, an array index, and the reduction value.
+
+  \param reduce_val The reduction result, or the reducer holding it.
+
+  \param str Optional name for the functor. Will be forwarded if non-empty to
+  the Kokkos::parallel_reduce called by this code and can be used for
+  identification and profiling purposes.
+
+  The counterpart of simd_parallel_for for reductions over slices, e.g. the
+  kinetic energy or the maximum velocity:
+
+  \code
+  class FunctorType {
+  public:
+  void operator() ( const int s, const int a, double& sum ) const ;
+  };
+  \endcode
+
+  Every array element of a struct accumulates into the partial result of its
+  vector lane, such that the array index loop vectorizes as it does in
+  simd_parallel_for. The lane partials are combined at the end of each struct
+  and the struct results are then reduced across the policy.
+
+  \note The work tag gets applied at the user functor level, not at the level
+  of the functor in this implementation that wraps the user functor.
+*/
+template <class FunctorType, int VectorLength, class ReduceType,
+          class... ExecParameters>
+inline void simd_parallel_reduce(
+    const SimdPolicy<VectorLength, ExecParameters...>& exec_policy,
+    const FunctorType& functor, ReduceType&& reduce_val,
+    const std::string& str = "" )
+{
+    using simd_policy = SimdPolicy<VectorLength, ExecParameters...>;
+
+    using work_tag = typename simd_policy::work_tag;
+
+    using team_policy = typename simd_policy::base_type;
+
+    using index_type = typename team_policy::index_type;
+
+    using reduce_traits =
+        Impl::SimdReduceTraits<typename std::decay<ReduceType>::type>;
+
+    using value_type = typename reduce_traits::value_type;
+
+    auto simd_reduce = KOKKOS_LAMBDA(
+        const typename team_policy::member_type& team, value_type& ival )
+    {
+        index_type s = team.league_rank() + exec_policy.structBegin();
+        value_type struct_val;
+        reduce_traits::reduceStruct(
+            Kokkos::ThreadVectorRange( team, exec_policy.arrayBegin( s ),
+                                       exec_policy.arrayEnd( s ) ),
+            [&]( const index_type a, value_type& lane_val ) {
+                Impl::functorTagDispatch<work_tag>( functor, s, a, lane_val );
+            },
+            struct_val );
+        Kokkos::single( Kokkos::PerThread( team ), [&]() {
+            reduce_traits::join( ival, struct_val );
+        } );
+    };
+    if ( str.empty() )
+        Kokkos::parallel_reduce(
+            dynamic_cast<const team_policy&>( exec_policy ), simd_reduce,
+            reduce_val );
+    else
+        Kokkos::parallel_reduce(
+            str, dynamic_cast<const team_policy&>( exec_policy ), simd_reduce,
+            reduce_val );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Execute a team functor over contiguous blocks of structs.
+
+  \tparam FunctorType The functor type to execute.
+
+  \tparam VectorLength The length of the inner arrays of the structs.
+
+  \tparam ExecParameters Execution policy parameters.
+
+  \param exec_policy The 2D range policy over which to execute the functor.
+
+  \param structs_per_team The number of structs in the block owned by each
+  team.
+
+  \param scratch_size The team scratch size in bytes, for example the sum of
+  ScratchSlice::scratchSize() for the slices staged by the functor.
+
+  \param functor The functor to execute.
+
+  \param str Optional name for the functor.
+
+  The functor is called as <tt>functor( team, s_begin, s_end )</tt> for every
+  block of structs [s_begin,s_end) in the policy, where team is the Kokkos
+  team member. The functor may stage slices of the block with ScratchSlice
+  and then reuse them from team scratch across several passes over the
+  block. The first and last structs of the policy may only be partially in
+  the policy range, so array indices should be bounded with the arrayBegin()
+  and arrayEnd() functions of the policy.
+*/
+template <class FunctorType, int VectorLength, class... ExecParameters>
+inline void simd_team_parallel_for(
+    const SimdPolicy<VectorLength, ExecParameters...>& exec_policy,
+    const int structs_per_team, const std::size_t scratch_size,
+    const FunctorType& functor, const std::string& str = "" )
+{
+    using simd_policy = SimdPolicy<VectorLength, ExecParameters...>;
+
+    using work_tag = typename simd_policy::work_tag;
+
+    using execution_space = typename simd_policy::execution_space;
+
+    using index_type = typename simd_policy::index_type;
+
+    using team_policy = Kokkos::TeamPolicy<execution_space>;
+
+    index_type struct_begin = exec_policy.structBegin();
+    index_type struct_end = exec_policy.structEnd();
+    index_type num_team =
+        ( struct_end - struct_begin + structs_per_team - 1 ) / structs_per_team;
+
+    team_policy policy( num_team, Kokkos::AUTO, VectorLength );
+    policy.set_scratch_size( 0, Kokkos::PerTeam( scratch_size ) );
+
+    auto team_func =
+        KOKKOS_LAMBDA( const typename team_policy::member_type& team )
+    {
+        index_type s_begin =
+            struct_begin + team.league_rank() * structs_per_team;
+        index_type s_end = ( s_begin + structs_per_team < struct_end )
+                               ? s_begin + structs_per_team
+                               : struct_end;
+        Impl::functorTagDispatch<work_tag>( functor, team, s_begin, s_end );
+    };
+    if ( str.empty() )
+        Kokkos::parallel_for( policy, team_func );
+    else
+        Kokkos::parallel_for( str, policy, team_func );
+}
+
+//---------------------------------------------------------------------------//
+// Fused Functors
+//---------------------------------------------------------------------------//
+/*!
+  \brief Functor calling several functors in order with the same arguments.
+
+  \tparam Functors The functor types to fuse.
+
+  A fused functor can be passed to any of the parallel for and reduce
+  functions to evaluate several operations in a single sweep, such that
+  the neighbor list and other shared data are read once for all of them.
+  All functors must accept the same arguments, including the work tag of the
+  execution policy if one is given. For reductions all functors contribute
+  to the same reduction value.
+*/
+template <class... Functors>
+class FusedFunctor;
+
+//! \cond Impl
+template <>
+class FusedFunctor<>
+{
+  public:
+    template <class... Args>
+    KOKKOS_FORCEINLINE_FUNCTION void operator()( Args&&... ) const
+    {
+    }
+};
+//! \endcond
+
+//! Functor calling several functors in order with the same arguments.
+template <class Functor, class... Functors>
+class FusedFunctor<Functor, Functors...>
+{
+  public:
+    //! Constructor.
+    FusedFunctor( const Functor& functor, const Functors&... functors )
+        : _functor( functor )
+        , _functors( functors... )
+    {
+    }
+
+    //! Call all functors in order.
+    template <class... Args>
+    KOKKOS_FORCEINLINE_FUNCTION void operator()( Args&&... args ) const
+    {
+        _functor( args... );
+        _functors( args... );
+    }
+
+  private:
+    Functor _functor;
+    FusedFunctor<Functors...> _functors;
+};
+
+/*!
+  \brief Fuse several functors into one functor calling them in order.
+
+  \param functors The functors to fuse.
+
+  \return The fused functor.
+*/
+template <class... Functors>
+FusedFunctor<Functors...> fuseFunctors( const Functors&... functors )
+{
+    return FusedFunctor<Functors...>( functors... );
+}
+
 //---------------------------------------------------------------------------//
 // Neighbor Parallel For
 //---------------------------------------------------------------------------//
@@ -182,6 +530,136 @@ class TeamVectorOpTag
 {
 };
 
+//! Neighbor operations are executed with team parallelism from neighbor cell
+//! data tiled in team scratch memory.
+class TiledOpTag
+{
+};
+
+//! Neighbor operations are executed with a strategy selected from the
+//! neighbor list statistics of each call.
+class AutoOpTag
+{
+};
+
+//! Neighbor operations are executed with one thread per particle-neighbor
+//! pair.
+class PairOpTag
+{
+};
+
+//---------------------------------------------------------------------------//
+//! \cond Impl
+namespace Impl
+{
+// Neighbor operation strategies available for automatic selection.
+enum class NeighborOpStrategy
+{
+    Serial,
+    Team
+};
+
+// Team operation tag used by the team strategy for each neighbor tag.
+template <class NeighborTag>
+struct AutoTeamOpTag
+{
+    using type = TeamOpTag;
+};
+
+template <>
+struct AutoTeamOpTag<SecondNeighborsTag>
+{
+    using type = TeamVectorOpTag;
+};
+
+// Average neighbor count at which team parallelism over the neighbors of a
+// particle is used on devices.
+constexpr double autoOpTeamThreshold() { return 32.0; }
+
+// Get the average number of neighbors of the particles in a range.
+template <class ExecutionSpace, class NeighborListType>
+double averageNeighborCount( const ExecutionSpace& exec_space,
+                             const NeighborListType& list,
+                             const std::size_t begin, const std::size_t end )
+{
+    using neighbor_list_traits = NeighborList<NeighborListType>;
+    if ( end <= begin )
+        return 0.0;
+    std::size_t total = 0;
+    Kokkos::parallel_reduce(
+        "Cabana::neighbor_parallel_for::average_neighbors",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, begin, end ),
+        KOKKOS_LAMBDA( const std::size_t i, std::size_t& result ) {
+            result += neighbor_list_traits::numNeighbor( list, i );
+        },
+        total );
+    return static_cast<double>( total ) / ( end - begin );
+}
+
+// Select the neighbor operation strategy for the particles of a list in a
+// range. Nothing is cached: the choice follows the given list on every call
+// at the cost of a reduction over its neighbor counts on devices.
+template <class ExecutionSpace, class NeighborListType>
+NeighborOpStrategy selectNeighborOp( const ExecutionSpace& exec_space,
+                                     const NeighborListType& list,
+                                     const std::size_t begin,
+                                     const std::size_t end )
+{
+    // Host threads are best used one particle each.
+    if ( Kokkos::SpaceAccessibility<ExecutionSpace,
+                                    Kokkos::HostSpace>::accessible )
+        return NeighborOpStrategy::Serial;
+    return ( averageNeighborCount( exec_space, list, begin, end ) >=
+             autoOpTeamThreshold() )
+               ? NeighborOpStrategy::Team
+               : NeighborOpStrategy::Serial;
+}
+
+// Compute the offsets of the neighbors of each particle in a range in the
+// flattened list of particle-neighbor pairs. Returns the number of pairs.
+template <class ExecutionSpace, class NeighborListType, class OffsetView>
+std::size_t neighborPairOffsets( const NeighborListType& list,
+                                 const std::size_t begin,
+                                 const std::size_t end, OffsetView& offsets )
+{
+    using neighbor_list_traits = NeighborList<NeighborListType>;
+    Kokkos::realloc( offsets, end - begin + 1 );
+    std::size_t num_pair = 0;
+    Kokkos::parallel_scan(
+        "Cabana::neighbor_parallel_for::pair_offsets",
+        Kokkos::RangePolicy<ExecutionSpace>( 0, end - begin + 1 ),
+        KOKKOS_LAMBDA( const std::size_t i, std::size_t& update,
+                       const bool final_pass ) {
+            if ( final_pass )
+                offsets( i ) = update;
+            if ( i < end - begin )
+                update += neighbor_list_traits::numNeighbor( list, begin + i );
+        },
+        num_pair );
+    return num_pair;
+}
+
+// Find the range-relative particle of a pair in the flattened list. This is
+// the particle i with offsets(i) <= pair < offsets(i+1).
+template <class OffsetView>
+KOKKOS_INLINE_FUNCTION std::size_t
+neighborPairParticle( const OffsetView& offsets, const std::size_t pair )
+{
+    std::size_t lo = 0;
+    std::size_t hi = offsets.extent( 0 ) - 1;
+    while ( hi - lo > 1 )
+    {
+        std::size_t mid = ( lo + hi ) / 2;
+        if ( offsets( mid ) <= pair )
+            lo = mid;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+} // end namespace Impl
+//! \endcond
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Execute functor in parallel according to the execution policy over
@@ -240,7 +718,7 @@ inline void neighbor_parallel_for(
     auto begin = exec_policy.begin();
     auto end = exec_policy.end();
     using linear_policy_type = Kokkos::RangePolicy<execution_space, void, void>;
-    linear_policy_type linear_exec_policy( begin, end );
+    linear_policy_type linear_exec_policy( exec_policy.space(), begin, end );
 
     static_assert( is_accessible_from<memory_space, execution_space>{}, "" );
 
@@ -304,53 +782,651 @@ inline void neighbor_parallel_for(
 
     static_assert( is_accessible_from<memory_space, execution_space>{}, "" );
 
-    auto neigh_func = KOKKOS_LAMBDA( const index_type i )
+    auto neigh_func = KOKKOS_LAMBDA( const index_type i )
+    {
+        const index_type nn = neighbor_list_traits::numNeighbor( list, i );
+
+        for ( index_type n = 0; n < nn; ++n )
+        {
+            const index_type j =
+                neighbor_list_traits::getNeighbor( list, i, n );
+
+            for ( index_type a = n + 1; a < nn; ++a )
+            {
+                const index_type k =
+                    neighbor_list_traits::getNeighbor( list, i, a );
+                Impl::functorTagDispatch<work_tag>( functor, i, j, k );
+            }
+        }
+    };
+    if ( str.empty() )
+        Kokkos::parallel_for( linear_exec_policy, neigh_func );
+    else
+        Kokkos::parallel_for( str, linear_exec_policy, neigh_func );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Execute functor in parallel according to the execution policy over
+  particles with team parallelism over particle first neighbors.
+
+  \tparam FunctorType The functor type to execute.
+  \tparam NeighborListType The neighbor list type.
+  \tparam ExecParams The Kokkos range policy parameters.
+
+  \param exec_policy The policy over which to execute the functor.
+  \param functor The functor to execute in parallel
+  \param list The neighbor list over which to execute the neighbor operations.
+  \param FirstNeighborsTag Tag indicating operations over particle first
+  neighbors.
+  \param TeamOpTag Tag indicating a team parallel strategy over neighbors.
+  \param str Optional name for the functor. Will be forwarded if non-empty to
+  the Kokkos::parallel_for called by this code and can be used for
+  identification and profiling purposes.
+*/
+template <class FunctorType, class NeighborListType, class... ExecParameters>
+inline void neighbor_parallel_for(
+    const Kokkos::RangePolicy<ExecParameters...>& exec_policy,
+    const FunctorType& functor, const NeighborListType& list,
+    const FirstNeighborsTag, const TeamOpTag, const std::string& str = "" )
+{
+    using work_tag = typename Kokkos::RangePolicy<ExecParameters...>::work_tag;
+
+    using execution_space =
+        typename Kokkos::RangePolicy<ExecParameters...>::execution_space;
+
+    using kokkos_policy =
+        Kokkos::TeamPolicy<execution_space, Kokkos::Schedule<Kokkos::Dynamic>>;
+    kokkos_policy team_policy( exec_policy.end() - exec_policy.begin(),
+                               Kokkos::AUTO );
+
+    using index_type = typename kokkos_policy::index_type;
+
+    using neighbor_list_traits = NeighborList<NeighborListType>;
+
+    using memory_space = typename neighbor_list_traits::memory_space;
+
+    static_assert( is_accessible_from<memory_space, execution_space>{}, "" );
+
+    const auto range_begin = exec_policy.begin();
+
+    auto neigh_func =
+        KOKKOS_LAMBDA( const typename kokkos_policy::member_type& team )
+    {
+        index_type i = team.league_rank() + range_begin;
+        Kokkos::parallel_for(
+            Kokkos::TeamThreadRange(
+                team, neighbor_list_traits::numNeighbor( list, i ) ),
+            [&]( const index_type n ) {
+                Impl::functorTagDispatch<work_tag>(
+                    functor, i,
+                    static_cast<index_type>(
+                        neighbor_list_traits::getNeighbor( list, i, n ) ) );
+            } );
+    };
+    if ( str.empty() )
+        Kokkos::parallel_for( team_policy, neigh_func );
+    else
+        Kokkos::parallel_for( str, team_policy, neigh_func );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Execute functor in parallel according to the execution policy over
+  particles with team parallelism over particle first neighbors and serial loop
+  over second neighbors.
+
+  \tparam FunctorType The functor type to execute.
+  \tparam NeighborListType The neighbor list type.
+  \tparam ExecParams The Kokkos range policy parameters.
+
+  \param exec_policy The policy over which to execute the functor.
+  \param functor The functor to execute in parallel
+  \param list The neighbor list over which to execute the neighbor operations.
+  \param SecondNeighborsTag Tag indicating operations over particle first and
+  second neighbors.
+  \param TeamOpTag Tag indicating a team parallel strategy over particle first
+  neighbors and serial execution over second neighbors.
+  \param str Optional name for the functor. Will be forwarded if non-empty to
+  the Kokkos::parallel_for called by this code and can be used for
+  identification and profiling purposes.
+*/
+template <class FunctorType, class NeighborListType, class... ExecParameters>
+inline void neighbor_parallel_for(
+    const Kokkos::RangePolicy<ExecParameters...>& exec_policy,
+    const FunctorType& functor, const NeighborListType& list,
+    const SecondNeighborsTag, const TeamOpTag, const std::string& str = "" )
+{
+    using work_tag = typename Kokkos::RangePolicy<ExecParameters...>::work_tag;
+
+    using execution_space =
+        typename Kokkos::RangePolicy<ExecParameters...>::execution_space;
+
+    using kokkos_policy =
+        Kokkos::TeamPolicy<execution_space, Kokkos::Schedule<Kokkos::Dynamic>>;
+    kokkos_policy team_policy( exec_policy.end() - exec_policy.begin(),
+                               Kokkos::AUTO );
+
+    using index_type = typename kokkos_policy::index_type;
+
+    using neighbor_list_traits = NeighborList<NeighborListType>;
+
+    using memory_space = typename neighbor_list_traits::memory_space;
+
+    static_assert( is_accessible_from<memory_space, execution_space>{}, "" );
+
+    const auto range_begin = exec_policy.begin();
+
+    auto neigh_func =
+        KOKKOS_LAMBDA( const typename kokkos_policy::member_type& team )
+    {
+        index_type i = team.league_rank() + range_begin;
+
+        const index_type nn = neighbor_list_traits::numNeighbor( list, i );
+        Kokkos::parallel_for(
+            Kokkos::TeamThreadRange( team, nn ), [&]( const index_type n ) {
+                const index_type j =
+                    neighbor_list_traits::getNeighbor( list, i, n );
+
+                for ( index_type a = n + 1; a < nn; ++a )
+                {
+                    const index_type k =
+                        neighbor_list_traits::getNeighbor( list, i, a );
+                    Impl::functorTagDispatch<work_tag>( functor, i, j, k );
+                }
+            } );
+    };
+    if ( str.empty() )
+        Kokkos::parallel_for( team_policy, neigh_func );
+    else
+        Kokkos::parallel_for( str, team_policy, neigh_func );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Execute functor in parallel according to the execution policy over
+  particles with team parallelism over particle first neighbors and vector loop
+  parallelism over second neighbors.
+
+  \tparam FunctorType The functor type to execute.
+  \tparam NeighborListType The neighbor list type.
+  \tparam ExecParams The Kokkos range policy parameters.
+
+  \param exec_policy The policy over which to execute the functor.
+  \param functor The functor to execute in parallel
+  \param list The neighbor list over which to execute the neighbor operations.
+  \param SecondNeighborsTag Tag indicating operations over particle first and
+  second neighbors.
+  \param TeamVectorOpTag Tag indicating a team parallel strategy over particle
+  first neighbors and vector parallel loop strategy over second neighbors.
+  \param str Optional name for the functor. Will be forwarded if non-empty to
+  the Kokkos::parallel_for called by this code and can be used for
+  identification and profiling purposes.
+*/
+template <class FunctorType, class NeighborListType, class... ExecParameters>
+inline void neighbor_parallel_for(
+    const Kokkos::RangePolicy<ExecParameters...>& exec_policy,
+    const FunctorType& functor, const NeighborListType& list,
+    const SecondNeighborsTag, const TeamVectorOpTag,
+    const std::string& str = "" )
+{
+    using work_tag = typename Kokkos::RangePolicy<ExecParameters...>::work_tag;
+
+    using execution_space =
+        typename Kokkos::RangePolicy<ExecParameters...>::execution_space;
+
+    using kokkos_policy =
+        Kokkos::TeamPolicy<execution_space, Kokkos::Schedule<Kokkos::Dynamic>>;
+    kokkos_policy team_policy( exec_policy.end() - exec_policy.begin(),
+                               Kokkos::AUTO );
+
+    using index_type = typename kokkos_policy::index_type;
+
+    using neighbor_list_traits = NeighborList<NeighborListType>;
+
+    using memory_space = typename neighbor_list_traits::memory_space;
+
+    static_assert( is_accessible_from<memory_space, execution_space>{}, "" );
+
+    const auto range_begin = exec_policy.begin();
+
+    auto neigh_func =
+        KOKKOS_LAMBDA( const typename kokkos_policy::member_type& team )
+    {
+        index_type i = team.league_rank() + range_begin;
+
+        const index_type nn = neighbor_list_traits::numNeighbor( list, i );
+        Kokkos::parallel_for(
+            Kokkos::TeamThreadRange( team, nn ), [&]( const index_type n ) {
+                const index_type j =
+                    neighbor_list_traits::getNeighbor( list, i, n );
+
+                Kokkos::parallel_for(
+                    Kokkos::ThreadVectorRange( team, n + 1, nn ),
+                    [&]( const index_type a ) {
+                        const index_type k =
+                            neighbor_list_traits::getNeighbor( list, i, a );
+                        Impl::functorTagDispatch<work_tag>( functor, i, j, k );
+                    } );
+            } );
+    };
+    if ( str.empty() )
+        Kokkos::parallel_for( team_policy, neigh_func );
+    else
+        Kokkos::parallel_for( str, team_policy, neigh_func );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Execute functor in parallel according to the execution policy over
+  particles with team parallelism over particle first neighbors and vector
+  loop parallelism over second neighbors using neighbor geometry cached in
+  team scratch memory.
+
+  \tparam FunctorType The functor type to execute.
+  \tparam NeighborListType The neighbor list type.
+  \tparam PositionSlice The position slice type.
+  \tparam ExecParams The Kokkos range policy parameters.
+
+  \param exec_policy The policy over which to execute the functor.
+  \param functor The functor to execute in parallel
+  \param list The neighbor list over which to execute the neighbor operations.
+  \param positions The particle positions.
+  \param SecondNeighborsTag Tag indicating operations over particle first and
+  second neighbors.
+  \param TeamVectorOpTag Tag indicating a team parallel strategy over particle
+  first neighbors and vector parallel loop strategy over second neighbors.
+  \param str Optional name for the functor. Will be forwarded if non-empty to
+  the Kokkos::parallel_for called by this code and can be used for
+  identification and profiling purposes.
+
+  Each team first computes the displacement and distance from its particle
+  to every neighbor into a NeighborPairCache in scratch level 0. The functor
+  is then called as functor( i, j, k, cache ) for every pair of neighbors
+  with j < k in the neighbor order, where i is the particle index and j and
+  k are the cache indices of the neighbors. The particle index of a cached
+  neighbor is given by cache.neighbor( n ).
+*/
+template <class FunctorType, class NeighborListType, class PositionSlice,
+          class... ExecParameters>
+inline void neighbor_parallel_for(
+    const Kokkos::RangePolicy<ExecParameters...>& exec_policy,
+    const FunctorType& functor, const NeighborListType& list,
+    const PositionSlice& positions, const SecondNeighborsTag,
+    const TeamVectorOpTag, const std::string& str = "" )
+{
+    using work_tag = typename Kokkos::RangePolicy<ExecParameters...>::work_tag;
+
+    using execution_space =
+        typename Kokkos::RangePolicy<ExecParameters...>::execution_space;
+
+    using kokkos_policy =
+        Kokkos::TeamPolicy<execution_space, Kokkos::Schedule<Kokkos::Dynamic>>;
+
+    using index_type = typename kokkos_policy::index_type;
+
+    using neighbor_list_traits = NeighborList<NeighborListType>;
+
+    using memory_space = typename neighbor_list_traits::memory_space;
+
+    using cache_type = NeighborPairCache<PositionSlice>;
+
+    static_assert( is_accessible_from<memory_space, execution_space>{}, "" );
+
+    const auto range_begin = exec_policy.begin();
+
+    // Size the scratch for the particle with the most neighbors.
+    int max_neighbor = 0;
+    Kokkos::parallel_reduce(
+        "Cabana::neighbor_parallel_for::max_neighbor",
+        Kokkos::RangePolicy<execution_space>( exec_policy.begin(),
+                                              exec_policy.end() ),
+        KOKKOS_LAMBDA( const index_type i, int& result ) {
+            int nn = neighbor_list_traits::numNeighbor( list, i );
+            if ( nn > result )
+                result = nn;
+        },
+        Kokkos::Max<int>( max_neighbor ) );
+
+    kokkos_policy team_policy( exec_policy.end() - exec_policy.begin(),
+                               Kokkos::AUTO );
+    team_policy.set_scratch_size(
+        0, Kokkos::PerTeam( cache_type::scratchSize( max_neighbor ) ) );
+
+    auto neigh_func =
+        KOKKOS_LAMBDA( const typename kokkos_policy::member_type& team )
+    {
+        index_type i = team.league_rank() + range_begin;
+
+        cache_type cache( team, max_neighbor );
+        cache.load( team, list, positions, i );
+        team.team_barrier();
+
+        const int nn = cache.size();
+        Kokkos::parallel_for(
+            Kokkos::TeamThreadRange( team, nn ), [&]( const int n ) {
+                Kokkos::parallel_for(
+                    Kokkos::ThreadVectorRange( team, n + 1, nn ),
+                    [&]( const int a ) {
+                        Impl::functorTagDispatch<work_tag>( functor, i, n, a,
+                                                            cache );
+                    } );
+            } );
+    };
+    if ( str.empty() )
+        Kokkos::parallel_for( team_policy, neigh_func );
+    else
+        Kokkos::parallel_for( str, team_policy, neigh_func );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Execute functor in parallel according to the execution policy over
+  particles and their first or second neighbors with an automatically
+  selected strategy.
+
+  \tparam FunctorType The functor type to execute.
+  \tparam NeighborListType The neighbor list type.
+  \tparam NeighborTag The tag indicating first or second neighbors.
+  \tparam ExecParams The Kokkos range policy parameters.
+
+  \param exec_policy The policy over which to execute the functor.
+  \param functor The functor to execute in parallel
+  \param list The neighbor list over which to execute the neighbor operations.
+  \param NeighborTag Tag indicating operations over particle first or second
+  neighbors.
+  \param AutoOpTag Tag indicating an automatically selected strategy.
+  \param str Optional name for the functor. Will be forwarded if non-empty to
+  the Kokkos::parallel_for called by this code and can be used for
+  identification and profiling purposes.
+
+  Host backends always use the serial strategy. On devices team parallelism
+  over the neighbors of each particle (with vector parallelism over second
+  neighbors) is used when the average neighbor count over the policy range
+  is at least Impl::autoOpTeamThreshold(). The strategy is selected on every
+  call from the given list, which on devices costs a reduction over the
+  neighbor counts of the policy range on the policy instance. The functor
+  must be safe for concurrent calls for the same particle as with
+  TeamOpTag.
+*/
+template <class FunctorType, class NeighborListType, class NeighborTag,
+          class... ExecParameters>
+inline typename std::enable_if<
+    ( std::is_same<NeighborTag, FirstNeighborsTag>::value ||
+      std::is_same<NeighborTag, SecondNeighborsTag>::value ),
+    void>::type
+neighbor_parallel_for(
+    const Kokkos::RangePolicy<ExecParameters...>& exec_policy,
+    const FunctorType& functor, const NeighborListType& list, const NeighborTag,
+    const AutoOpTag, const std::string& str = "" )
+{
+    auto strategy = Impl::selectNeighborOp( exec_policy.space(), list,
+                                            exec_policy.begin(),
+                                            exec_policy.end() );
+
+    if ( strategy == Impl::NeighborOpStrategy::Serial )
+        neighbor_parallel_for( exec_policy, functor, list, NeighborTag(),
+                               SerialOpTag(), str );
+    else
+        neighbor_parallel_for(
+            exec_policy, functor, list, NeighborTag(),
+            typename Impl::AutoTeamOpTag<NeighborTag>::type(), str );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Execute functor in parallel according to the execution policy over
+  particles with one thread per particle-neighbor pair.
+
+  \tparam FunctorType The functor type to execute.
+  \tparam NeighborListType The neighbor list type.
+  \tparam ExecParams The Kokkos range policy parameters.
+
+  \param exec_policy The policy over which to execute the functor.
+  \param functor The functor to execute in parallel
+  \param list The neighbor list over which to execute the neighbor operations.
+  \param FirstNeighborsTag Tag indicating operations over particle first
+  neighbors.
+  \param PairOpTag Tag indicating a parallel strategy over all
+  particle-neighbor pairs.
+  \param str Optional name for the functor. Will be forwarded if non-empty to
+  the Kokkos::parallel_for called by this code and can be used for
+  identification and profiling purposes.
+
+  The neighbors of all particles in the policy range are flattened into a
+  single list of pairs and every thread executes one pair, which balances
+  the work when neighbor counts vary widely between particles. The particle
+  of each pair is found with a binary search over the pair offsets. The
+  functor is called concurrently for the same particle and must update
+  per-particle results atomically as with TeamOpTag.
+*/
+template <class FunctorType, class NeighborListType, class... ExecParameters>
+inline void neighbor_parallel_for(
+    const Kokkos::RangePolicy<ExecParameters...>& exec_policy,
+    const FunctorType& functor, const NeighborListType& list,
+    const FirstNeighborsTag, const PairOpTag, const std::string& str = "" )
+{
+    using work_tag = typename Kokkos::RangePolicy<ExecParameters...>::work_tag;
+
+    using execution_space =
+        typename Kokkos::RangePolicy<ExecParameters...>::execution_space;
+
+    using index_type =
+        typename Kokkos::RangePolicy<ExecParameters...>::index_type;
+
+    using neighbor_list_traits = NeighborList<NeighborListType>;
+
+    using memory_space = typename neighbor_list_traits::memory_space;
+
+    static_assert( is_accessible_from<memory_space, execution_space>{}, "" );
+
+    const std::size_t begin = exec_policy.begin();
+    const std::size_t end = exec_policy.end();
+
+    Kokkos::View<std::size_t*, memory_space> offsets( "pair_offsets", 0 );
+    std::size_t num_pair = Impl::neighborPairOffsets<execution_space>(
+        list, begin, end, offsets );
+
+    auto neigh_func = KOKKOS_LAMBDA( const std::size_t pair )
+    {
+        std::size_t i = Impl::neighborPairParticle( offsets, pair );
+        index_type p = begin + i;
+        Impl::functorTagDispatch<work_tag>(
+            functor, p,
+            static_cast<index_type>( neighbor_list_traits::getNeighbor(
+                list, p, pair - offsets( i ) ) ) );
+    };
+    Kokkos::RangePolicy<execution_space> pair_policy( 0, num_pair );
+    if ( str.empty() )
+        Kokkos::parallel_for( pair_policy, neigh_func );
+    else
+        Kokkos::parallel_for( str, pair_policy, neigh_func );
+}
+
+//---------------------------------------------------------------------------//
+namespace Impl
+{
+//! \cond Impl
+// Get the periodic dimensions of a neighbor list if it has them.
+template <class NeighborListType>
+auto listPeriodic( const NeighborListType& list, int )
+    -> decltype( list.periodic() )
+{
+    return list.periodic();
+}
+
+template <class NeighborListType>
+std::array<bool, 3> listPeriodic( const NeighborListType&, long )
+{
+    return { false, false, false };
+}
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Execute functor in parallel according to the execution policy over
+  particles in waves of independent cells with thread-local serial loops over
+  particle first neighbors.
+
+  \tparam FunctorType The functor type to execute.
+  \tparam NeighborListType The neighbor list type.
+  \tparam LinkedCellListType The linked cell list type.
+  \tparam ExecParams The Kokkos range policy parameters.
+
+  \param exec_policy The policy over which to execute the functor.
+  \param functor The functor to execute in parallel
+  \param list The neighbor list over which to execute the neighbor operations.
+  \param cells The linked cell list binning the particles in the policy range.
+  \param neighborhood_radius The radius within which all neighbors in the list
+  are found.
+  \param FirstNeighborsTag Tag indicating operations over particle first
+  neighbors.
+  \param SerialOpTag Tag indicating a serial loop strategy over neighbors.
+  \param str Optional name for the functor. Will be forwarded if non-empty to
+  the Kokkos::parallel_for called by this code and can be used for
+  identification and profiling purposes.
+
+  The cells are colored such that two cells of the same color are further
+  apart than twice the neighborhood radius. The colors are executed one after
+  the other with one thread per cell looping over the particles in the cell.
+  Particles operated on concurrently then never share a neighbor and the
+  functor may update both the particle and the neighbor without atomics. This
+  is intended for half neighbor lists where each pair is visited once.
+
+  The colors are executed in order on the instance of the execution policy.
+  In a periodic dimension the first and last cells of a color are only far
+  enough apart if the number of cells is a multiple of the color stride.
+  Lists reporting a periodic dimension through periodic() are therefore
+  rejected unless this holds; the coloring of other lists whose neighbors
+  wrap around the cell grid is not conflict-free.
+*/
+template <class FunctorType, class NeighborListType, class LinkedCellListType,
+          class... ExecParameters>
+inline void neighbor_parallel_for(
+    const Kokkos::RangePolicy<ExecParameters...>& exec_policy,
+    const FunctorType& functor, const NeighborListType& list,
+    const LinkedCellListType& cells, const double neighborhood_radius,
+    const FirstNeighborsTag, const SerialOpTag, const std::string& str = "" )
+{
+    using work_tag = typename Kokkos::RangePolicy<ExecParameters...>::work_tag;
+
+    using execution_space =
+        typename Kokkos::RangePolicy<ExecParameters...>::execution_space;
+
+    using index_type =
+        typename Kokkos::RangePolicy<ExecParameters...>::index_type;
+
+    using neighbor_list_traits = NeighborList<NeighborListType>;
+
+    using memory_space = typename neighbor_list_traits::memory_space;
+
+    static_assert( is_accessible_from<memory_space, execution_space>{}, "" );
+
+    const index_type begin = exec_policy.begin();
+    const index_type end = exec_policy.end();
+
+    // Cells of the same color are separated by more than twice the number of
+    // cells spanned by the neighborhood radius in each dimension. Colors
+    // only stay separated across a periodic boundary if the stride divides
+    // the number of cells.
+    auto periodic = Impl::listPeriodic( list, 0 );
+    int num_cell[3];
+    int stride[3];
+    for ( int d = 0; d < 3; ++d )
     {
-        const index_type nn = neighbor_list_traits::numNeighbor( list, i );
-
-        for ( index_type n = 0; n < nn; ++n )
-        {
-            const index_type j =
-                neighbor_list_traits::getNeighbor( list, i, n );
-
-            for ( index_type a = n + 1; a < nn; ++a )
+        num_cell[d] = cells.numBin( d );
+        int range = std::ceil( neighborhood_radius / cells.binWidth( d ) );
+        stride[d] = 2 * range + 1;
+        if ( periodic[d] && 0 != num_cell[d] % stride[d] )
+            throw std::runtime_error(
+                "Periodic cell count must be a multiple of the color stride" );
+    }
+
+    for ( int ci = 0; ci < stride[0]; ++ci )
+        for ( int cj = 0; cj < stride[1]; ++cj )
+            for ( int ck = 0; ck < stride[2]; ++ck )
             {
-                const index_type k =
-                    neighbor_list_traits::getNeighbor( list, i, a );
-                Impl::functorTagDispatch<work_tag>( functor, i, j, k );
+                // Number of cells of this color in each dimension.
+                int ni = ( num_cell[0] - ci + stride[0] - 1 ) / stride[0];
+                int nj = ( num_cell[1] - cj + stride[1] - 1 ) / stride[1];
+                int nk = ( num_cell[2] - ck + stride[2] - 1 ) / stride[2];
+                if ( ni <= 0 || nj <= 0 || nk <= 0 )
+                    continue;
+
+                auto neigh_func = KOKKOS_LAMBDA( const int c )
+                {
+                    int i = ci + stride[0] * ( c / ( nj * nk ) );
+                    int j = cj + stride[1] * ( ( c / nk ) % nj );
+                    int k = ck + stride[2] * ( c % nk );
+                    int offset = cells.binOffset( i, j, k );
+                    int size = cells.binSize( i, j, k );
+                    for ( int b = offset; b < offset + size; ++b )
+                    {
+                        index_type p = cells.permutation( b );
+                        if ( p < begin || p >= end )
+                            continue;
+                        for ( index_type n = 0;
+                              n < neighbor_list_traits::numNeighbor( list, p );
+                              ++n )
+                            Impl::functorTagDispatch<work_tag>(
+                                functor, p,
+                                static_cast<index_type>(
+                                    neighbor_list_traits::getNeighbor( list, p,
+                                                                       n ) ) );
+                    }
+                };
+                Kokkos::RangePolicy<execution_space> color_policy(
+                    exec_policy.space(), 0, ni * nj * nk );
+                if ( str.empty() )
+                    Kokkos::parallel_for( color_policy, neigh_func );
+                else
+                    Kokkos::parallel_for( str, color_policy, neigh_func );
             }
-        }
-    };
-    if ( str.empty() )
-        Kokkos::parallel_for( linear_exec_policy, neigh_func );
-    else
-        Kokkos::parallel_for( str, linear_exec_policy, neigh_func );
 }
 
 //---------------------------------------------------------------------------//
 /*!
   \brief Execute functor in parallel according to the execution policy over
-  particles with team parallelism over particle first neighbors.
+  particles with one team per cell operating on all particles in the
+  neighboring cells from team scratch memory.
 
   \tparam FunctorType The functor type to execute.
-  \tparam NeighborListType The neighbor list type.
+  \tparam LinkedCellListType The linked cell list type.
+  \tparam SliceType The slice type of the tiled particle data.
   \tparam ExecParams The Kokkos range policy parameters.
 
   \param exec_policy The policy over which to execute the functor.
   \param functor The functor to execute in parallel
-  \param list The neighbor list over which to execute the neighbor operations.
+  \param cells The linked cell list binning the particles. The slice must be
+  permuted with the cell list such that the particles of each cell are
+  contiguous.
+  \param neighborhood_radius The radius within which neighbors are needed.
+  All particles in cells within this radius of a cell are visited.
+  \param slice The slice to tile in scratch memory, typically positions.
   \param FirstNeighborsTag Tag indicating operations over particle first
   neighbors.
-  \param TeamOpTag Tag indicating a team parallel strategy over neighbors.
+  \param TiledOpTag Tag indicating a team parallel strategy over particles
+  in a cell with neighbor data tiled in scratch memory.
   \param str Optional name for the functor. Will be forwarded if non-empty to
   the Kokkos::parallel_for called by this code and can be used for
   identification and profiling purposes.
+
+  Each team cooperatively loads the slice data of the union of the cells in
+  the stencil of its cell into a NeighborTile in scratch level 0. Each
+  thread then loops serially over the tile for one particle of the cell. The
+  functor is called as functor( i, j, tile ) for every particle i in the
+  policy range with tile indices i and j. The slice index of a tile particle
+  is given by tile.particle( n ). No distance check is done and the functor
+  is called for every particle pair of the stencil except i with itself.
 */
-template <class FunctorType, class NeighborListType, class... ExecParameters>
+template <class FunctorType, class LinkedCellListType, class SliceType,
+          class... ExecParameters>
 inline void neighbor_parallel_for(
     const Kokkos::RangePolicy<ExecParameters...>& exec_policy,
-    const FunctorType& functor, const NeighborListType& list,
-    const FirstNeighborsTag, const TeamOpTag, const std::string& str = "" )
+    const FunctorType& functor, const LinkedCellListType& cells,
+    const double neighborhood_radius, const SliceType& slice,
+    const FirstNeighborsTag, const TiledOpTag, const std::string& str = "" )
 {
     using work_tag = typename Kokkos::RangePolicy<ExecParameters...>::work_tag;
 
@@ -359,31 +1435,60 @@ inline void neighbor_parallel_for(
 
     using kokkos_policy =
         Kokkos::TeamPolicy<execution_space, Kokkos::Schedule<Kokkos::Dynamic>>;
-    kokkos_policy team_policy( exec_policy.end() - exec_policy.begin(),
-                               Kokkos::AUTO );
 
     using index_type = typename kokkos_policy::index_type;
 
-    using neighbor_list_traits = NeighborList<NeighborListType>;
-
-    using memory_space = typename neighbor_list_traits::memory_space;
-
-    static_assert( is_accessible_from<memory_space, execution_space>{}, "" );
-
-    const auto range_begin = exec_policy.begin();
+    using tile_type = NeighborTile<SliceType>;
+
+    const index_type begin = exec_policy.begin();
+    const index_type end = exec_policy.end();
+
+    // Number of neighbor cells on each side spanned by the radius.
+    int range[3];
+    for ( int d = 0; d < 3; ++d )
+        range[d] = std::ceil( neighborhood_radius / cells.binWidth( d ) );
+
+    // Size the scratch for the largest tile.
+    int max_tile = 0;
+    Kokkos::parallel_reduce(
+        "Cabana::neighbor_parallel_for::max_tile",
+        Kokkos::RangePolicy<execution_space>( 0, cells.totalBins() ),
+        KOKKOS_LAMBDA( const int c, int& result ) {
+            int i, j, k;
+            cells.ijkBinIndex( c, i, j, k );
+            int size = tile_type::tileSize( cells, i, j, k, range );
+            if ( size > result )
+                result = size;
+        },
+        Kokkos::Max<int>( max_tile ) );
+
+    kokkos_policy team_policy( cells.totalBins(), Kokkos::AUTO );
+    team_policy.set_scratch_size(
+        0, Kokkos::PerTeam( tile_type::scratchSize( slice, max_tile ) ) );
 
     auto neigh_func =
         KOKKOS_LAMBDA( const typename kokkos_policy::member_type& team )
     {
-        index_type i = team.league_rank() + range_begin;
+        int ci, cj, ck;
+        cells.ijkBinIndex( team.league_rank(), ci, cj, ck );
+        const int num_i = cells.binSize( ci, cj, ck );
+        if ( num_i == 0 )
+            return;
+
+        tile_type tile( team, slice, max_tile );
+        tile.load( team, cells, ci, cj, ck, range );
+        team.team_barrier();
+
         Kokkos::parallel_for(
-            Kokkos::TeamThreadRange(
-                team, neighbor_list_traits::numNeighbor( list, i ) ),
-            [&]( const index_type n ) {
-                Impl::functorTagDispatch<work_tag>(
-                    functor, i,
-                    static_cast<index_type>(
-                        neighbor_list_traits::getNeighbor( list, i, n ) ) );
+            Kokkos::TeamThreadRange( team, num_i ), [&]( const int n ) {
+                const int i = tile.center() + n;
+                const index_type p = tile.particle( i );
+                if ( p < begin || p >= end )
+                    return;
+                for ( int j = 0; j < tile.size(); ++j )
+                    if ( j != i )
+                        Impl::functorTagDispatch<work_tag>( functor, i, j,
+                                                            tile );
             } );
     };
     if ( str.empty() )
@@ -392,105 +1497,164 @@ inline void neighbor_parallel_for(
         Kokkos::parallel_for( str, team_policy, neigh_func );
 }
 
+//---------------------------------------------------------------------------//
+//! \cond Impl
+namespace Impl
+{
+// Get the bounds [lo,hi) of the bins within a number of bins of the bin
+// containing a particle.
+template <class LinkedCellListType, class PositionSlice>
+KOKKOS_INLINE_FUNCTION void
+cellStencil( const LinkedCellListType& cells, const PositionSlice& positions,
+             const std::size_t p, const int range[3], int lo[3], int hi[3] )
+{
+    int ijk[3];
+    cells.locatePoint( positions( p, 0 ), positions( p, 1 ),
+                       positions( p, 2 ), ijk[0], ijk[1], ijk[2] );
+    for ( int d = 0; d < 3; ++d )
+    {
+        lo[d] = ( ijk[d] > range[d] ) ? ijk[d] - range[d] : 0;
+        hi[d] = ( ijk[d] + range[d] < cells.numBin( d ) )
+                    ? ijk[d] + range[d] + 1
+                    : cells.numBin( d );
+    }
+}
+
+// Get whether two particles are within a cutoff distance.
+template <class PositionSlice>
+KOKKOS_INLINE_FUNCTION bool withinCutoff( const PositionSlice& positions,
+                                          const std::size_t p,
+                                          const std::size_t n,
+                                          const double cutoff_sqr )
+{
+    double dsqr = 0.0;
+    for ( int d = 0; d < 3; ++d )
+    {
+        double dx = positions( p, d ) - positions( n, d );
+        dsqr += dx * dx;
+    }
+    return dsqr <= cutoff_sqr;
+}
+} // end namespace Impl
+//! \endcond
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Execute functor in parallel according to the execution policy over
-  particles with team parallelism over particle first neighbors and serial loop
-  over second neighbors.
+  particles with thread-local serial loops over the particle first neighbors
+  found on the fly in a linked cell list.
 
   \tparam FunctorType The functor type to execute.
-  \tparam NeighborListType The neighbor list type.
+  \tparam LinkedCellListType The linked cell list type.
+  \tparam PositionSlice The position slice type.
   \tparam ExecParams The Kokkos range policy parameters.
 
   \param exec_policy The policy over which to execute the functor.
   \param functor The functor to execute in parallel
-  \param list The neighbor list over which to execute the neighbor operations.
-  \param SecondNeighborsTag Tag indicating operations over particle first and
-  second neighbors.
-  \param TeamOpTag Tag indicating a team parallel strategy over particle first
-  neighbors and serial execution over second neighbors.
+  \param cells The linked cell list binning the particles.
+  \param cutoff The radius within which neighbors are found.
+  \param positions The positions binned by the cell list.
+  \param FirstNeighborsTag Tag indicating operations over particle first
+  neighbors.
+  \param SerialOpTag Tag indicating a serial loop strategy over neighbors.
   \param str Optional name for the functor. Will be forwarded if non-empty to
   the Kokkos::parallel_for called by this code and can be used for
   identification and profiling purposes.
+
+  The functor is called as functor( i, j ) for every particle i in the policy
+  range and every particle j binned by the cell list within the cutoff of i,
+  excluding i itself, as for a full neighbor list. No neighbor indices are
+  stored: the bins around each particle are searched in every call, which is
+  cheaper than building a VerletList for kernels executed once per list
+  build. The particles need not be permuted with the cell list.
 */
-template <class FunctorType, class NeighborListType, class... ExecParameters>
+template <class FunctorType, class LinkedCellListType, class PositionSlice,
+          class... ExecParameters>
 inline void neighbor_parallel_for(
     const Kokkos::RangePolicy<ExecParameters...>& exec_policy,
-    const FunctorType& functor, const NeighborListType& list,
-    const SecondNeighborsTag, const TeamOpTag, const std::string& str = "" )
+    const FunctorType& functor, const LinkedCellListType& cells,
+    const double cutoff, const PositionSlice& positions,
+    const FirstNeighborsTag, const SerialOpTag, const std::string& str = "" )
 {
     using work_tag = typename Kokkos::RangePolicy<ExecParameters...>::work_tag;
 
     using execution_space =
         typename Kokkos::RangePolicy<ExecParameters...>::execution_space;
 
-    using kokkos_policy =
-        Kokkos::TeamPolicy<execution_space, Kokkos::Schedule<Kokkos::Dynamic>>;
-    kokkos_policy team_policy( exec_policy.end() - exec_policy.begin(),
-                               Kokkos::AUTO );
-
-    using index_type = typename kokkos_policy::index_type;
-
-    using neighbor_list_traits = NeighborList<NeighborListType>;
-
-    using memory_space = typename neighbor_list_traits::memory_space;
+    using index_type =
+        typename Kokkos::RangePolicy<ExecParameters...>::index_type;
 
-    static_assert( is_accessible_from<memory_space, execution_space>{}, "" );
+    using linear_policy_type = Kokkos::RangePolicy<execution_space, void, void>;
+    linear_policy_type linear_exec_policy( exec_policy.begin(),
+                                           exec_policy.end() );
 
-    const auto range_begin = exec_policy.begin();
+    // Number of bins on each side spanned by the cutoff.
+    int range[3];
+    for ( int d = 0; d < 3; ++d )
+        range[d] = std::ceil( cutoff / cells.binWidth( d ) );
+    const double cutoff_sqr = cutoff * cutoff;
 
-    auto neigh_func =
-        KOKKOS_LAMBDA( const typename kokkos_policy::member_type& team )
+    auto neigh_func = KOKKOS_LAMBDA( const index_type i )
     {
-        index_type i = team.league_rank() + range_begin;
-
-        const index_type nn = neighbor_list_traits::numNeighbor( list, i );
-        Kokkos::parallel_for(
-            Kokkos::TeamThreadRange( team, nn ), [&]( const index_type n ) {
-                const index_type j =
-                    neighbor_list_traits::getNeighbor( list, i, n );
-
-                for ( index_type a = n + 1; a < nn; ++a )
+        int lo[3];
+        int hi[3];
+        Impl::cellStencil( cells, positions, i, range, lo, hi );
+        for ( int ci = lo[0]; ci < hi[0]; ++ci )
+            for ( int cj = lo[1]; cj < hi[1]; ++cj )
+                for ( int ck = lo[2]; ck < hi[2]; ++ck )
                 {
-                    const index_type k =
-                        neighbor_list_traits::getNeighbor( list, i, a );
-                    Impl::functorTagDispatch<work_tag>( functor, i, j, k );
+                    int offset = cells.binOffset( ci, cj, ck );
+                    int size = cells.binSize( ci, cj, ck );
+                    for ( int b = offset; b < offset + size; ++b )
+                    {
+                        index_type j = cells.permutation( b );
+                        if ( j != i &&
+                             Impl::withinCutoff( positions, i, j, cutoff_sqr ) )
+                            Impl::functorTagDispatch<work_tag>( functor, i, j );
+                    }
                 }
-            } );
     };
     if ( str.empty() )
-        Kokkos::parallel_for( team_policy, neigh_func );
+        Kokkos::parallel_for( linear_exec_policy, neigh_func );
     else
-        Kokkos::parallel_for( str, team_policy, neigh_func );
+        Kokkos::parallel_for( str, linear_exec_policy, neigh_func );
 }
 
 //---------------------------------------------------------------------------//
 /*!
   \brief Execute functor in parallel according to the execution policy over
-  particles with team parallelism over particle first neighbors and vector loop
-  parallelism over second neighbors.
+  particles with team parallelism over the bins containing the particle first
+  neighbors found on the fly in a linked cell list.
 
   \tparam FunctorType The functor type to execute.
-  \tparam NeighborListType The neighbor list type.
+  \tparam LinkedCellListType The linked cell list type.
+  \tparam PositionSlice The position slice type.
   \tparam ExecParams The Kokkos range policy parameters.
 
   \param exec_policy The policy over which to execute the functor.
   \param functor The functor to execute in parallel
-  \param list The neighbor list over which to execute the neighbor operations.
-  \param SecondNeighborsTag Tag indicating operations over particle first and
-  second neighbors.
-  \param TeamVectorOpTag Tag indicating a team parallel strategy over particle
-  first neighbors and vector parallel loop strategy over second neighbors.
+  \param cells The linked cell list binning the particles.
+  \param cutoff The radius within which neighbors are found.
+  \param positions The positions binned by the cell list.
+  \param FirstNeighborsTag Tag indicating operations over particle first
+  neighbors.
+  \param TeamOpTag Tag indicating a team parallel strategy over particle
+  neighbors.
   \param str Optional name for the functor. Will be forwarded if non-empty to
   the Kokkos::parallel_for called by this code and can be used for
   identification and profiling purposes.
+
+  \see neighbor_parallel_for with a linked cell list and SerialOpTag. The
+  threads of the team of each particle search different bins, such that the
+  functor may be called concurrently for the same particle.
 */
-template <class FunctorType, class NeighborListType, class... ExecParameters>
+template <class FunctorType, class LinkedCellListType, class PositionSlice,
+          class... ExecParameters>
 inline void neighbor_parallel_for(
     const Kokkos::RangePolicy<ExecParameters...>& exec_policy,
-    const FunctorType& functor, const NeighborListType& list,
-    const SecondNeighborsTag, const TeamVectorOpTag,
-    const std::string& str = "" )
+    const FunctorType& functor, const LinkedCellListType& cells,
+    const double cutoff, const PositionSlice& positions,
+    const FirstNeighborsTag, const TeamOpTag, const std::string& str = "" )
 {
     using work_tag = typename Kokkos::RangePolicy<ExecParameters...>::work_tag;
 
@@ -504,32 +1668,38 @@ inline void neighbor_parallel_for(
 
     using index_type = typename kokkos_policy::index_type;
 
-    using neighbor_list_traits = NeighborList<NeighborListType>;
-
-    using memory_space = typename neighbor_list_traits::memory_space;
-
-    static_assert( is_accessible_from<memory_space, execution_space>{}, "" );
-
     const auto range_begin = exec_policy.begin();
 
+    // Number of bins on each side spanned by the cutoff.
+    int range[3];
+    for ( int d = 0; d < 3; ++d )
+        range[d] = std::ceil( cutoff / cells.binWidth( d ) );
+    const double cutoff_sqr = cutoff * cutoff;
+
     auto neigh_func =
         KOKKOS_LAMBDA( const typename kokkos_policy::member_type& team )
     {
         index_type i = team.league_rank() + range_begin;
-
-        const index_type nn = neighbor_list_traits::numNeighbor( list, i );
+        int lo[3];
+        int hi[3];
+        Impl::cellStencil( cells, positions, i, range, lo, hi );
+        int nj = hi[1] - lo[1];
+        int nk = hi[2] - lo[2];
         Kokkos::parallel_for(
-            Kokkos::TeamThreadRange( team, nn ), [&]( const index_type n ) {
-                const index_type j =
-                    neighbor_list_traits::getNeighbor( list, i, n );
-
-                Kokkos::parallel_for(
-                    Kokkos::ThreadVectorRange( team, n + 1, nn ),
-                    [&]( const index_type a ) {
-                        const index_type k =
-                            neighbor_list_traits::getNeighbor( list, i, a );
-                        Impl::functorTagDispatch<work_tag>( functor, i, j, k );
-                    } );
+            Kokkos::TeamThreadRange( team, ( hi[0] - lo[0] ) * nj * nk ),
+            [&]( const int c ) {
+                int ci = lo[0] + c / ( nj * nk );
+                int cj = lo[1] + ( c / nk ) % nj;
+                int ck = lo[2] + c % nk;
+                int offset = cells.binOffset( ci, cj, ck );
+                int size = cells.binSize( ci, cj, ck );
+                for ( int b = offset; b < offset + size; ++b )
+                {
+                    index_type j = cells.permutation( b );
+                    if ( j != i &&
+                         Impl::withinCutoff( positions, i, j, cutoff_sqr ) )
+                        Impl::functorTagDispatch<work_tag>( functor, i, j );
+                }
             } );
     };
     if ( str.empty() )
@@ -938,6 +2108,148 @@ inline void neighbor_parallel_reduce(
         Kokkos::parallel_reduce( str, team_policy, neigh_reduce, reduce_val );
 }
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief Execute functor reduction in parallel according to the execution policy
+  over particles with one thread per particle-neighbor pair.
+
+  \tparam FunctorType The functor type to execute.
+  \tparam NeighborListType The neighbor list type.
+  \tparam ExecParams The Kokkos range policy parameters.
+  \tparam ReduceType The reduction type.
+
+  \param exec_policy The policy over which to execute the functor.
+  \param functor The functor to execute in parallel
+  \param list The neighbor list over which to execute the neighbor operations.
+  \param FirstNeighborsTag Tag indicating operations over particle first
+  neighbors.
+  \param PairOpTag Tag indicating a parallel strategy over all
+  particle-neighbor pairs.
+  \param reduce_val Scalar to be reduced across particles and neighbors.
+  \param str Optional name for the functor. Will be forwarded if non-empty to
+  the Kokkos::parallel_reduce called by this code and can be used for
+  identification and profiling purposes.
+*/
+template <class FunctorType, class NeighborListType, class ReduceType,
+          class... ExecParameters>
+inline void neighbor_parallel_reduce(
+    const Kokkos::RangePolicy<ExecParameters...>& exec_policy,
+    const FunctorType& functor, const NeighborListType& list,
+    const FirstNeighborsTag, const PairOpTag, ReduceType& reduce_val,
+    const std::string& str = "" )
+{
+    using work_tag = typename Kokkos::RangePolicy<ExecParameters...>::work_tag;
+
+    using execution_space =
+        typename Kokkos::RangePolicy<ExecParameters...>::execution_space;
+
+    using index_type =
+        typename Kokkos::RangePolicy<ExecParameters...>::index_type;
+
+    using neighbor_list_traits = NeighborList<NeighborListType>;
+
+    using memory_space = typename neighbor_list_traits::memory_space;
+
+    static_assert( is_accessible_from<memory_space, execution_space>{}, "" );
+
+    const std::size_t begin = exec_policy.begin();
+    const std::size_t end = exec_policy.end();
+
+    Kokkos::View<std::size_t*, memory_space> offsets( "pair_offsets", 0 );
+    std::size_t num_pair = Impl::neighborPairOffsets<execution_space>(
+        list, begin, end, offsets );
+
+    auto neigh_reduce =
+        KOKKOS_LAMBDA( const std::size_t pair, ReduceType& ival )
+    {
+        std::size_t i = Impl::neighborPairParticle( offsets, pair );
+        index_type p = begin + i;
+        Impl::functorTagDispatch<work_tag>(
+            functor, p,
+            static_cast<index_type>( neighbor_list_traits::getNeighbor(
+                list, p, pair - offsets( i ) ) ),
+            ival );
+    };
+    Kokkos::RangePolicy<execution_space> pair_policy( 0, num_pair );
+    if ( str.empty() )
+        Kokkos::parallel_reduce( pair_policy, neigh_reduce, reduce_val );
+    else
+        Kokkos::parallel_reduce( str, pair_policy, neigh_reduce, reduce_val );
+}
+
+//---------------------------------------------------------------------------//
+// Neighbor Parallel Scan
+//---------------------------------------------------------------------------//
+/*!
+  \brief Execute functor scan in parallel according to the execution policy
+  over particles with a thread-local serial loop over particle first
+  neighbors.
+
+  \tparam FunctorType The functor type to execute.
+  \tparam NeighborListType The neighbor list type.
+  \tparam ScanType The scan value type.
+  \tparam ExecParams The Kokkos range policy parameters.
+
+  \param exec_policy The policy over which to execute the functor.
+  \param functor The functor to execute in parallel
+  \param list The neighbor list over which to execute the neighbor operations.
+  \param FirstNeighborsTag Tag indicating operations over particle first
+  neighbors.
+  \param total The scan total over all particles and neighbors.
+  \param str Optional name for the functor. Will be forwarded if non-empty to
+  the Kokkos::parallel_scan called by this code and can be used for
+  identification and profiling purposes.
+
+  The functor is called as functor( i, j, update, final_pass ) for every
+  particle i and neighbor j in order of the particles and of the neighbors
+  of each particle, with the same semantics as the Kokkos::parallel_scan
+  functor arguments. This allows per-pair output, such as a compacted list
+  of the pairs satisfying a condition, to be written in a single pass once
+  the total is known from a previous scan.
+*/
+template <class FunctorType, class NeighborListType, class ScanType,
+          class... ExecParameters>
+inline void neighbor_parallel_scan(
+    const Kokkos::RangePolicy<ExecParameters...>& exec_policy,
+    const FunctorType& functor, const NeighborListType& list,
+    const FirstNeighborsTag, ScanType& total, const std::string& str = "" )
+{
+    using work_tag = typename Kokkos::RangePolicy<ExecParameters...>::work_tag;
+
+    using execution_space =
+        typename Kokkos::RangePolicy<ExecParameters...>::execution_space;
+
+    using index_type =
+        typename Kokkos::RangePolicy<ExecParameters...>::index_type;
+
+    using neighbor_list_traits = NeighborList<NeighborListType>;
+
+    using memory_space = typename neighbor_list_traits::memory_space;
+
+    auto begin = exec_policy.begin();
+    auto end = exec_policy.end();
+    using linear_policy_type = Kokkos::RangePolicy<execution_space, void, void>;
+    linear_policy_type linear_exec_policy( exec_policy.space(), begin, end );
+
+    static_assert( is_accessible_from<memory_space, execution_space>{}, "" );
+
+    auto neigh_scan = KOKKOS_LAMBDA( const index_type i, ScanType& update,
+                                     const bool final_pass )
+    {
+        for ( index_type n = 0;
+              n < neighbor_list_traits::numNeighbor( list, i ); ++n )
+            Impl::functorTagDispatch<work_tag>(
+                functor, i,
+                static_cast<index_type>(
+                    neighbor_list_traits::getNeighbor( list, i, n ) ),
+                update, final_pass );
+    };
+    if ( str.empty() )
+        Kokkos::parallel_scan( linear_exec_policy, neigh_scan, total );
+    else
+        Kokkos::parallel_scan( str, linear_exec_policy, neigh_scan, total );
+}
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Execute functor in serial within existing parallel kernel over particle
@@ -0,0 +1,252 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_ParallelIO.hpp
+  \brief Parallel reading of particle files by all ranks
+*/
+#ifndef CABANA_PARALLELIO_HPP
+#define CABANA_PARALLELIO_HPP
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_Checkpoint.hpp>
+#include <Cabana_DeepCopy.hpp>
+#include <impl/Cabana_Profiling.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace Cabana
+{
+namespace IO
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief Method used by every rank to read its part of a particle file.
+
+  MMap - the byte range of the rank is mapped with mmap and copied. This
+  suits files on a shared or node-local filesystem mounted on every node.
+
+  MPIIO - the ranks read their byte ranges with a collective MPI-IO read,
+  which lets the MPI library aggregate the requests for parallel
+  filesystems.
+*/
+enum class ReadMethod
+{
+    MMap,
+    MPIIO
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Get the contiguous range of a global number of items read by this
+  rank when the items are split evenly over the ranks in whole blocks.
+
+  \param num_global The global number of items.
+
+  \param block_size The number of items of a block, e.g. the vector length
+  of an AoSoA. The ranges begin on block boundaries.
+
+  \param comm The communicator of the reading ranks.
+
+  \return The begin and end of the items of this rank.
+
+  The ranges of consecutive ranks are consecutive, so they also give the
+  local counts of readers such as HDF5ParticleOutput::readTimeStep().
+*/
+inline std::pair<std::size_t, std::size_t>
+localRange( const std::size_t num_global, const std::size_t block_size,
+            MPI_Comm comm )
+{
+    int comm_rank = -1;
+    int comm_size = -1;
+    MPI_Comm_rank( comm, &comm_rank );
+    MPI_Comm_size( comm, &comm_size );
+    std::uint64_t num_block = ( num_global + block_size - 1 ) / block_size;
+    std::uint64_t block_begin = num_block * comm_rank / comm_size;
+    std::uint64_t block_end = num_block * ( comm_rank + 1 ) / comm_size;
+    std::size_t begin = block_begin * block_size;
+    std::size_t end = block_end * block_size;
+    begin = ( begin < num_global ) ? begin : num_global;
+    end = ( end < num_global ) ? end : num_global;
+    return std::make_pair( begin, end );
+}
+
+namespace Impl
+{
+//! \cond Impl
+//---------------------------------------------------------------------------//
+// Read a byte range of a file through a memory map.
+inline void readMapped( const std::string& path, const std::uint64_t offset,
+                        const std::uint64_t length, void* data )
+{
+    if ( 0 == length )
+        return;
+    int fd = open( path.c_str(), O_RDONLY );
+    if ( fd < 0 )
+        throw std::runtime_error( "Could not open particle file " + path );
+
+    // Map from the page containing the first byte.
+    std::uint64_t page = sysconf( _SC_PAGE_SIZE );
+    std::uint64_t map_offset = offset - offset % page;
+    std::uint64_t map_length = length + ( offset - map_offset );
+    void* map = mmap( nullptr, map_length, PROT_READ, MAP_PRIVATE, fd,
+                      static_cast<off_t>( map_offset ) );
+    if ( MAP_FAILED == map )
+    {
+        close( fd );
+        throw std::runtime_error( "Could not map particle file " + path );
+    }
+    madvise( map, map_length, MADV_SEQUENTIAL );
+    std::memcpy( data, static_cast<const char*>( map ) + offset - map_offset,
+                 length );
+    munmap( map, map_length );
+    close( fd );
+}
+
+//---------------------------------------------------------------------------//
+// Read a number of blocks of a file with a collective MPI-IO read.
+inline void readCollective( MPI_Comm comm, const std::string& path,
+                            const std::uint64_t offset,
+                            const std::uint64_t block_bytes,
+                            const std::uint64_t num_block, void* data )
+{
+    MPI_File file;
+    if ( MPI_SUCCESS != MPI_File_open( comm, path.c_str(), MPI_MODE_RDONLY,
+                                       MPI_INFO_NULL, &file ) )
+        throw std::runtime_error( "Could not open particle file " + path );
+    MPI_Datatype block_type;
+    MPI_Type_contiguous( static_cast<int>( block_bytes ), MPI_BYTE,
+                         &block_type );
+    MPI_Type_commit( &block_type );
+    int error = MPI_File_read_at_all(
+        file, static_cast<MPI_Offset>( offset ), data,
+        static_cast<int>( num_block ), block_type, MPI_STATUS_IGNORE );
+    MPI_Type_free( &block_type );
+    MPI_File_close( &file );
+    if ( MPI_SUCCESS != error )
+        throw std::runtime_error( "Could not read particle file " + path );
+}
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Read a particle file in parallel with every rank reading its range
+  of the particles.
+
+  \tparam AoSoA_t The AoSoA type.
+
+  \param comm The communicator of the reading ranks.
+
+  \param path The particle file in the raw format written by checkpoint(),
+  e.g. by a preprocessing tool holding all particles in one AoSoA.
+
+  \param aosoa The AoSoA to read into. It is resized to the particles of
+  this rank. The vector length and member types must match those of the
+  file.
+
+  \param method The method used to read the file.
+
+  The header is read by the first rank and broadcast. The SoA blocks of the
+  file are then split evenly over the ranks with localRange() and every rank
+  reads its blocks directly into the memory of the AoSoA if it is host
+  accessible, otherwise through a host mirror. The blocks need no decoding
+  because the file holds them as laid out in memory. The particles are
+  generally not on their owning ranks afterwards, e.g.
+  Cajita::particleGridOwnerMigrate() moves them there with a single
+  migration.
+*/
+template <class AoSoA_t>
+void readParticles( MPI_Comm comm, const std::string& path, AoSoA_t& aosoa,
+                    const ReadMethod method = ReadMethod::MPIIO )
+{
+    static_assert( is_aosoa<AoSoA_t>::value,
+                   "readParticles() requires an AoSoA" );
+    Cabana::Impl::ScopedProfileRegion region( "Cabana::IO::readParticles" );
+
+    int comm_rank = -1;
+    MPI_Comm_rank( comm, &comm_rank );
+
+    // Read and validate the header on the first rank.
+    Cabana::Impl::CheckpointHeader expected;
+    expected.vector_length = AoSoA_t::vector_length;
+    expected.block_bytes = sizeof( typename AoSoA_t::soa_type );
+    expected.signature =
+        Cabana::Impl::typeSignature( typename AoSoA_t::member_types() );
+    Cabana::Impl::CheckpointHeader header;
+    int valid = 1;
+    std::string error;
+    if ( 0 == comm_rank )
+    {
+        try
+        {
+            std::ifstream file( path, std::ios::binary );
+            header = Cabana::Impl::readCheckpointHeader( file, path, expected );
+        }
+        catch ( const std::exception& e )
+        {
+            valid = 0;
+            error = e.what();
+        }
+    }
+    MPI_Bcast( &valid, 1, MPI_INT, 0, comm );
+    if ( !valid )
+        throw std::runtime_error( ( 0 == comm_rank )
+                                      ? error
+                                      : "Could not read particle file " +
+                                            path );
+    MPI_Bcast( &header, sizeof( header ), MPI_BYTE, 0, comm );
+
+    // Get the blocks of this rank.
+    auto range = localRange( header.size, header.vector_length, comm );
+    std::uint64_t block_begin = range.first / header.vector_length;
+    std::uint64_t num_block =
+        ( range.second - range.first + header.vector_length - 1 ) /
+        header.vector_length;
+    aosoa.resize( range.second - range.first );
+    if ( aosoa.numSoA() != num_block )
+        throw std::runtime_error( "Particle file " + path +
+                                  " has an inconsistent block count" );
+
+    // Read the blocks.
+    auto host_aosoa = create_mirror_view( Kokkos::HostSpace(), aosoa );
+    std::uint64_t offset =
+        sizeof( header ) + block_begin * header.block_bytes;
+    if ( ReadMethod::MMap == method )
+        Impl::readMapped( path, offset, num_block * header.block_bytes,
+                          host_aosoa.data() );
+    else
+        Impl::readCollective( comm, path, offset, header.block_bytes,
+                              num_block, host_aosoa.data() );
+    if ( static_cast<void*>( host_aosoa.data() ) !=
+         static_cast<void*>( aosoa.data() ) )
+        deep_copy( aosoa, host_aosoa );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace IO
+} // end namespace Cabana
+
+#endif // end CABANA_PARALLELIO_HPP
@@ -0,0 +1,353 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_ParticleInit.hpp
+  \brief Device-parallel particle position generators
+*/
+#ifndef CABANA_PARTICLEINIT_HPP
+#define CABANA_PARTICLEINIT_HPP
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_LinkedCellList.hpp>
+#include <Cabana_Remove.hpp>
+#include <Cabana_Slice.hpp>
+#include <impl/Cabana_Profiling.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Random.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+namespace Cabana
+{
+namespace Impl
+{
+//! \cond Impl
+//---------------------------------------------------------------------------//
+// Get the range of global lattice indices whose points lie in [min, max).
+inline void latticeRange( const double min, const double max,
+                          const double origin, const double spacing,
+                          long& begin, long& end )
+{
+    begin = static_cast<long>( std::ceil( ( min - origin ) / spacing - 0.5 ) );
+    end = static_cast<long>( std::ceil( ( max - origin ) / spacing - 0.5 ) );
+    end = ( end > begin ) ? end : begin;
+}
+
+//---------------------------------------------------------------------------//
+// Check the bounds of a box.
+inline void checkBox( const double box_min[3], const double box_max[3] )
+{
+    for ( int d = 0; d < 3; ++d )
+        if ( !( box_max[d] > box_min[d] ) )
+            throw std::runtime_error( "Particle box bounds are empty" );
+}
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create particles on a regular lattice within a box.
+
+  \tparam PositionIndex The member index of the particle position.
+  \tparam ExecutionSpace Kokkos execution space.
+  \tparam AoSoA_t The AoSoA type.
+
+  \param exec_space Kokkos execution space.
+
+  \param aosoa The particles. The created particles are appended behind the
+  existing particles. Only their positions are initialized.
+
+  \param origin The origin of the global lattice.
+
+  \param spacing The lattice spacing in each dimension.
+
+  \param box_min The lower bounds of the box, e.g. the local subdomain.
+
+  \param box_max The upper bounds of the box.
+
+  \param jitter The fraction of the lattice spacing over which every point is
+  moved randomly, between 0 and 1. A particle stays within the lattice cell
+  centered on its point.
+
+  \param seed The seed of the random jitter.
+
+  \return The number of created particles.
+
+  The points are at origin + (i + 1/2) * spacing for the global lattice
+  indices i whose points lie in [box_min, box_max). Ranks using the same
+  origin and spacing with their subdomain bounds therefore create every
+  point of the global lattice exactly once.
+*/
+template <std::size_t PositionIndex, class ExecutionSpace, class AoSoA_t>
+std::size_t createLatticeParticles(
+    const ExecutionSpace& exec_space, AoSoA_t& aosoa, const double origin[3],
+    const double spacing[3], const double box_min[3], const double box_max[3],
+    const double jitter = 0.0, const std::uint64_t seed = 0,
+    typename std::enable_if<( is_aosoa<AoSoA_t>::value &&
+                              Kokkos::is_execution_space<
+                                  ExecutionSpace>::value ),
+                            int>::type* = 0 )
+{
+    Impl::ScopedProfileRegion region( "Cabana::createLatticeParticles" );
+
+    Impl::checkBox( box_min, box_max );
+    if ( !( jitter >= 0.0 && jitter <= 1.0 ) )
+        throw std::runtime_error( "Lattice jitter must be in [0, 1]" );
+
+    Kokkos::Array<long, 3> begin;
+    Kokkos::Array<long, 3> num;
+    Kokkos::Array<double, 3> x0;
+    Kokkos::Array<double, 3> dx;
+    for ( int d = 0; d < 3; ++d )
+    {
+        if ( !( spacing[d] > 0.0 ) )
+            throw std::runtime_error( "Lattice spacing must be positive" );
+        long end;
+        Impl::latticeRange( box_min[d], box_max[d], origin[d], spacing[d],
+                            begin[d], end );
+        num[d] = end - begin[d];
+        x0[d] = origin[d];
+        dx[d] = spacing[d];
+    }
+
+    std::size_t num_create = num[0] * num[1] * num[2];
+    std::size_t offset = aosoa.size();
+    aosoa.resize( offset + num_create );
+    auto x = slice<PositionIndex>( aosoa );
+
+    Kokkos::Random_XorShift64_Pool<ExecutionSpace> pool( seed );
+    Kokkos::parallel_for(
+        "Cabana::createLatticeParticles",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_create ),
+        KOKKOS_LAMBDA( const std::size_t n ) {
+            long ijk[3] = { static_cast<long>( n ) % num[0],
+                            ( static_cast<long>( n ) / num[0] ) % num[1],
+                            static_cast<long>( n ) / ( num[0] * num[1] ) };
+            auto gen = pool.get_state();
+            for ( int d = 0; d < 3; ++d )
+            {
+                double shift =
+                    ( jitter > 0.0 ) ? jitter * ( gen.drand() - 0.5 ) : 0.0;
+                x( offset + n, d ) =
+                    x0[d] + ( begin[d] + ijk[d] + 0.5 + shift ) * dx[d];
+            }
+            pool.free_state( gen );
+        } );
+    Kokkos::fence();
+
+    return num_create;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create uniformly random particles within a box.
+
+  \tparam PositionIndex The member index of the particle position.
+  \tparam ExecutionSpace Kokkos execution space.
+  \tparam AoSoA_t The AoSoA type.
+
+  \param exec_space Kokkos execution space.
+
+  \param aosoa The particles. The created particles are appended behind the
+  existing particles. Only their positions are initialized.
+
+  \param num_create The number of particles to create.
+
+  \param box_min The lower bounds of the box, e.g. the local subdomain.
+
+  \param box_max The upper bounds of the box.
+
+  \param seed The seed of the random positions. Ranks should use different
+  seeds.
+*/
+template <std::size_t PositionIndex, class ExecutionSpace, class AoSoA_t>
+void createRandomParticles(
+    const ExecutionSpace& exec_space, AoSoA_t& aosoa,
+    const std::size_t num_create, const double box_min[3],
+    const double box_max[3], const std::uint64_t seed = 0,
+    typename std::enable_if<( is_aosoa<AoSoA_t>::value &&
+                              Kokkos::is_execution_space<
+                                  ExecutionSpace>::value ),
+                            int>::type* = 0 )
+{
+    Impl::ScopedProfileRegion region( "Cabana::createRandomParticles" );
+
+    Impl::checkBox( box_min, box_max );
+    Kokkos::Array<double, 3> lo = { box_min[0], box_min[1], box_min[2] };
+    Kokkos::Array<double, 3> hi = { box_max[0], box_max[1], box_max[2] };
+
+    std::size_t offset = aosoa.size();
+    aosoa.resize( offset + num_create );
+    auto x = slice<PositionIndex>( aosoa );
+
+    Kokkos::Random_XorShift64_Pool<ExecutionSpace> pool( seed );
+    Kokkos::parallel_for(
+        "Cabana::createRandomParticles",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_create ),
+        KOKKOS_LAMBDA( const std::size_t n ) {
+            auto gen = pool.get_state();
+            for ( int d = 0; d < 3; ++d )
+                x( offset + n, d ) = gen.drand( lo[d], hi[d] );
+            pool.free_state( gen );
+        } );
+    Kokkos::fence();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create random particles within a box keeping a minimum distance
+  between them (Poisson-disk sampling).
+
+  \tparam PositionIndex The member index of the particle position.
+  \tparam ExecutionSpace Kokkos execution space.
+  \tparam AoSoA_t The AoSoA type.
+
+  \param exec_space Kokkos execution space.
+
+  \param aosoa The particles. The created particles are appended behind the
+  existing particles. Only their positions are initialized.
+
+  \param num_candidate The number of random candidate positions.
+
+  \param box_min The lower bounds of the box, e.g. the local subdomain.
+
+  \param box_max The upper bounds of the box.
+
+  \param min_dist The minimum distance between the created particles.
+
+  \param seed The seed of the random candidates. Ranks should use different
+  seeds.
+
+  \return The number of created particles.
+
+  Uniformly random candidates are binned in a linked cell list with cells of
+  at least the minimum distance. A candidate is accepted once every closer
+  candidate with a lower index is rejected, and rejected once one of them is
+  accepted. The rounds of this decision run in parallel and accept the same
+  candidates as inserting them serially in index order. The distance is not
+  kept to existing particles or across boxes of different ranks.
+*/
+template <std::size_t PositionIndex, class ExecutionSpace, class AoSoA_t>
+std::size_t createPoissonDiskParticles(
+    const ExecutionSpace& exec_space, AoSoA_t& aosoa,
+    const std::size_t num_candidate, const double box_min[3],
+    const double box_max[3], const double min_dist,
+    const std::uint64_t seed = 0,
+    typename std::enable_if<( is_aosoa<AoSoA_t>::value &&
+                              Kokkos::is_execution_space<
+                                  ExecutionSpace>::value ),
+                            int>::type* = 0 )
+{
+    Impl::ScopedProfileRegion region( "Cabana::createPoissonDiskParticles" );
+
+    using memory_space = typename AoSoA_t::memory_space;
+
+    if ( !( min_dist > 0.0 ) )
+        throw std::runtime_error( "Minimum particle distance must be "
+                                  "positive" );
+
+    std::size_t offset = aosoa.size();
+    createRandomParticles<PositionIndex>( exec_space, aosoa, num_candidate,
+                                          box_min, box_max, seed );
+    auto x = slice<PositionIndex>( aosoa );
+    std::size_t num_data = aosoa.size();
+
+    // Bin the candidates.
+    double grid_delta[3] = { min_dist, min_dist, min_dist };
+    LinkedCellList<typename AoSoA_t::device_type> cell_list(
+        exec_space, x, offset, num_data, grid_delta, box_min, box_max );
+
+    // Decide the candidates in rounds. A status of 0 is undecided, 1 is
+    // accepted and 2 is rejected.
+    Kokkos::View<int*, memory_space> status( "poisson_disk_status",
+                                             num_candidate );
+    double min_dist_sqr = min_dist * min_dist;
+    auto decide_op = KOKKOS_LAMBDA( const std::size_t n, std::size_t& left )
+    {
+        if ( status( n ) != 0 )
+            return;
+        std::size_t p = offset + n;
+        int ic, jc, kc;
+        cell_list.locatePoint( x( p, 0 ), x( p, 1 ), x( p, 2 ), ic, jc, kc );
+        bool decided = true;
+        for ( int i = ic - 1; i <= ic + 1; ++i )
+            for ( int j = jc - 1; j <= jc + 1; ++j )
+                for ( int k = kc - 1; k <= kc + 1; ++k )
+                {
+                    if ( i < 0 || i >= cell_list.numBin( 0 ) || j < 0 ||
+                         j >= cell_list.numBin( 1 ) || k < 0 ||
+                         k >= cell_list.numBin( 2 ) )
+                        continue;
+                    std::size_t bin_offset = cell_list.binOffset( i, j, k );
+                    int bin_size = cell_list.binSize( i, j, k );
+                    for ( int b = 0; b < bin_size; ++b )
+                    {
+                        std::size_t q = cell_list.permutation( bin_offset + b );
+                        if ( q >= p )
+                            continue;
+                        double dist_sqr = 0.0;
+                        for ( int d = 0; d < 3; ++d )
+                            dist_sqr +=
+                                ( x( p, d ) - x( q, d ) ) *
+                                ( x( p, d ) - x( q, d ) );
+                        if ( dist_sqr >= min_dist_sqr )
+                            continue;
+                        int s = status( q - offset );
+                        if ( s == 1 )
+                        {
+                            status( n ) = 2;
+                            return;
+                        }
+                        decided = decided && ( s == 2 );
+                    }
+                }
+        if ( decided )
+            status( n ) = 1;
+        else
+            ++left;
+    };
+    std::size_t num_left = num_candidate;
+    while ( num_left > 0 )
+    {
+        Kokkos::parallel_reduce(
+            "Cabana::createPoissonDiskParticles::decide",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                                 num_candidate ),
+            decide_op, num_left );
+    }
+
+    // Remove the rejected candidates.
+    Kokkos::View<int*, memory_space> keep_mask(
+        Kokkos::ViewAllocateWithoutInitializing( "poisson_disk_keep" ),
+        num_data );
+    Kokkos::parallel_for(
+        "Cabana::createPoissonDiskParticles::mask",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_data ),
+        KOKKOS_LAMBDA( const std::size_t p ) {
+            keep_mask( p ) = ( p < offset || status( p - offset ) == 1 );
+        } );
+    Kokkos::fence();
+    compact( aosoa, keep_mask );
+
+    return aosoa.size() - offset;
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_PARTICLEINIT_HPP
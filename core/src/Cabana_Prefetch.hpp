@@ -0,0 +1,313 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_Prefetch.hpp
+  \brief Prefetching and advice hints for AoSoAs in unified memory
+*/
+#ifndef CABANA_PREFETCH_HPP
+#define CABANA_PREFETCH_HPP
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_Slice.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace Cabana
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief Advice hints for data in unified memory.
+*/
+enum class MemoryAdvice
+{
+    //! The data is mostly read and may be duplicated on each accessor.
+    ReadMostly,
+    //! The data should reside with the given execution space.
+    PreferredLocation,
+    //! The data is accessed by the given execution space and should stay
+    //! mapped to it.
+    AccessedBy
+};
+
+namespace Impl
+{
+//! \cond Impl
+//---------------------------------------------------------------------------//
+// Unified memory hints. Memory spaces without unified memory ignore them.
+template <class MemorySpace>
+struct UnifiedMemory
+{
+    template <class ExecutionSpace>
+    static void prefetch( const void*, const std::size_t,
+                          const ExecutionSpace& )
+    {
+    }
+
+    template <class ExecutionSpace>
+    static void advise( const void*, const std::size_t, const MemoryAdvice,
+                        const bool, const ExecutionSpace& )
+    {
+    }
+};
+
+#ifdef KOKKOS_ENABLE_CUDA
+template <>
+struct UnifiedMemory<Kokkos::CudaUVMSpace>
+{
+    static void check( const cudaError_t error, const char* name )
+    {
+        if ( error != cudaSuccess )
+            throw std::runtime_error( std::string( name ) + " failed: " +
+                                      cudaGetErrorString( error ) );
+    }
+
+    // Device and stream of an execution space. Host execution spaces use
+    // the CPU and the default device stream.
+    static void target( const Kokkos::Cuda& exec_space, int& device,
+                        cudaStream_t& stream )
+    {
+        device = exec_space.cuda_device();
+        stream = exec_space.cuda_stream();
+    }
+
+    template <class ExecutionSpace>
+    static void target( const ExecutionSpace&, int& device,
+                        cudaStream_t& stream )
+    {
+        device = cudaCpuDeviceId;
+        stream = Kokkos::Cuda().cuda_stream();
+    }
+
+    template <class ExecutionSpace>
+    static void prefetch( const void* ptr, const std::size_t bytes,
+                          const ExecutionSpace& exec_space )
+    {
+        int device;
+        cudaStream_t stream;
+        target( exec_space, device, stream );
+        check( cudaMemPrefetchAsync( ptr, bytes, device, stream ),
+               "cudaMemPrefetchAsync" );
+    }
+
+    template <class ExecutionSpace>
+    static void advise( const void* ptr, const std::size_t bytes,
+                        const MemoryAdvice advice, const bool set,
+                        const ExecutionSpace& exec_space )
+    {
+        int device;
+        cudaStream_t stream;
+        target( exec_space, device, stream );
+        cudaMemoryAdvise cuda_advice;
+        switch ( advice )
+        {
+        case MemoryAdvice::ReadMostly:
+            cuda_advice =
+                set ? cudaMemAdviseSetReadMostly : cudaMemAdviseUnsetReadMostly;
+            break;
+        case MemoryAdvice::PreferredLocation:
+            cuda_advice = set ? cudaMemAdviseSetPreferredLocation
+                              : cudaMemAdviseUnsetPreferredLocation;
+            break;
+        default:
+            cuda_advice =
+                set ? cudaMemAdviseSetAccessedBy : cudaMemAdviseUnsetAccessedBy;
+            break;
+        }
+        check( cudaMemAdvise( ptr, bytes, cuda_advice, device ),
+               "cudaMemAdvise" );
+    }
+};
+#endif // end KOKKOS_ENABLE_CUDA
+
+#if defined( KOKKOS_ENABLE_HIP ) && ( KOKKOS_VERSION >= 30700 )
+template <>
+struct UnifiedMemory<Kokkos::Experimental::HIPManagedSpace>
+{
+    static void check( const hipError_t error, const char* name )
+    {
+        if ( error != hipSuccess )
+            throw std::runtime_error( std::string( name ) + " failed: " +
+                                      hipGetErrorString( error ) );
+    }
+
+    // Device and stream of an execution space. Host execution spaces use
+    // the CPU and the default device stream.
+    static void target( const Kokkos::Experimental::HIP& exec_space,
+                        int& device, hipStream_t& stream )
+    {
+        device = exec_space.hip_device();
+        stream = exec_space.hip_stream();
+    }
+
+    template <class ExecutionSpace>
+    static void target( const ExecutionSpace&, int& device,
+                        hipStream_t& stream )
+    {
+        device = hipCpuDeviceId;
+        stream = Kokkos::Experimental::HIP().hip_stream();
+    }
+
+    template <class ExecutionSpace>
+    static void prefetch( const void* ptr, const std::size_t bytes,
+                          const ExecutionSpace& exec_space )
+    {
+        int device;
+        hipStream_t stream;
+        target( exec_space, device, stream );
+        check( hipMemPrefetchAsync( ptr, bytes, device, stream ),
+               "hipMemPrefetchAsync" );
+    }
+
+    template <class ExecutionSpace>
+    static void advise( const void* ptr, const std::size_t bytes,
+                        const MemoryAdvice advice, const bool set,
+                        const ExecutionSpace& exec_space )
+    {
+        int device;
+        hipStream_t stream;
+        target( exec_space, device, stream );
+        hipMemoryAdvise hip_advice;
+        switch ( advice )
+        {
+        case MemoryAdvice::ReadMostly:
+            hip_advice =
+                set ? hipMemAdviseSetReadMostly : hipMemAdviseUnsetReadMostly;
+            break;
+        case MemoryAdvice::PreferredLocation:
+            hip_advice = set ? hipMemAdviseSetPreferredLocation
+                             : hipMemAdviseUnsetPreferredLocation;
+            break;
+        default:
+            hip_advice =
+                set ? hipMemAdviseSetAccessedBy : hipMemAdviseUnsetAccessedBy;
+            break;
+        }
+        check( hipMemAdvise( ptr, bytes, hip_advice, device ),
+               "hipMemAdvise" );
+    }
+};
+#endif // end KOKKOS_ENABLE_HIP
+
+//---------------------------------------------------------------------------//
+// Number of bytes spanned by the SoAs of an AoSoA in use.
+template <class AoSoA_t>
+std::size_t unifiedMemoryBytes(
+    const AoSoA_t& aosoa,
+    typename std::enable_if<is_aosoa<AoSoA_t>::value, int>::type* = 0 )
+{
+    return aosoa.numSoA() * sizeof( typename AoSoA_t::soa_type );
+}
+
+// Number of bytes from the first to the last element of a slice in use.
+template <class SliceType>
+std::size_t unifiedMemoryBytes(
+    const SliceType& slice,
+    typename std::enable_if<is_slice<SliceType>::value, int>::type* = 0 )
+{
+    if ( slice.numSoA() == 0 )
+        return 0;
+    std::size_t num_comp = 1;
+    for ( std::size_t d = 2; d < slice.rank(); ++d )
+        num_comp *= slice.extent( d );
+    return ( ( slice.numSoA() - 1 ) * SliceType::soa_stride +
+             SliceType::vector_length * num_comp ) *
+           sizeof( typename SliceType::value_type );
+}
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Asynchronously migrate the data of an AoSoA or slice in unified
+  memory to an execution space.
+
+  \param data The AoSoA or slice to migrate.
+
+  \param exec_space The execution space to migrate to. Device execution
+  spaces migrate to their device and queue the migration on their stream.
+  Host execution spaces migrate to the host on the default device stream.
+
+  Data outside of unified memory is not affected. The members of a slice are
+  stored interleaved with the other members of its AoSoA and memory migrates
+  in whole pages, so prefetching a slice also migrates the other members
+  sharing its pages.
+*/
+template <class DataType, class ExecutionSpace>
+void prefetch( const DataType& data, const ExecutionSpace& exec_space )
+{
+    static_assert( is_aosoa<DataType>::value || is_slice<DataType>::value,
+                   "prefetch requires an AoSoA or slice" );
+    std::size_t bytes = Impl::unifiedMemoryBytes( data );
+    if ( bytes > 0 )
+        Impl::UnifiedMemory<typename DataType::memory_space>::prefetch(
+            data.data(), bytes, exec_space );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Set an advice hint on the data of an AoSoA or slice in unified
+  memory.
+
+  \param data The AoSoA or slice to advise on.
+
+  \param advice The advice to set.
+
+  \param exec_space The execution space the preferred location or accessor
+  advice refers to. Ignored for read-mostly advice.
+
+  Data outside of unified memory is not affected. The hint remains set for
+  the current allocation of the data until cleared.
+*/
+template <class DataType, class ExecutionSpace>
+void memAdvise( const DataType& data, const MemoryAdvice advice,
+                const ExecutionSpace& exec_space )
+{
+    static_assert( is_aosoa<DataType>::value || is_slice<DataType>::value,
+                   "memAdvise requires an AoSoA or slice" );
+    std::size_t bytes = Impl::unifiedMemoryBytes( data );
+    if ( bytes > 0 )
+        Impl::UnifiedMemory<typename DataType::memory_space>::advise(
+            data.data(), bytes, advice, true, exec_space );
+}
+
+/*!
+  \brief Clear an advice hint on the data of an AoSoA or slice in unified
+  memory.
+
+  \param data The AoSoA or slice to clear the advice of.
+
+  \param advice The advice to clear.
+
+  \param exec_space The execution space the advice was set for.
+*/
+template <class DataType, class ExecutionSpace>
+void clearMemAdvise( const DataType& data, const MemoryAdvice advice,
+                     const ExecutionSpace& exec_space )
+{
+    static_assert( is_aosoa<DataType>::value || is_slice<DataType>::value,
+                   "clearMemAdvise requires an AoSoA or slice" );
+    std::size_t bytes = Impl::unifiedMemoryBytes( data );
+    if ( bytes > 0 )
+        Impl::UnifiedMemory<typename DataType::memory_space>::advise(
+            data.data(), bytes, advice, false, exec_space );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_PREFETCH_HPP
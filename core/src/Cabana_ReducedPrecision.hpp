@@ -0,0 +1,290 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_ReducedPrecision.hpp
+  \brief Reduced precision floating point member storage types
+*/
+#ifndef CABANA_REDUCEDPRECISION_HPP
+#define CABANA_REDUCEDPRECISION_HPP
+
+#include <Kokkos_Core.hpp>
+
+#include <cstdint>
+#include <type_traits>
+
+namespace Cabana
+{
+namespace Impl
+{
+//! \cond Impl
+//---------------------------------------------------------------------------//
+// Reinterpret the bits of a float.
+KOKKOS_INLINE_FUNCTION
+std::uint32_t floatBits( const float f )
+{
+    union
+    {
+        float f;
+        std::uint32_t u;
+    } bits;
+    bits.f = f;
+    return bits.u;
+}
+
+KOKKOS_INLINE_FUNCTION
+float bitsFloat( const std::uint32_t u )
+{
+    union
+    {
+        std::uint32_t u;
+        float f;
+    } bits;
+    bits.u = u;
+    return bits.f;
+}
+
+//---------------------------------------------------------------------------//
+// Round the bits shifted out of a value to the nearest, ties to even.
+KOKKOS_INLINE_FUNCTION
+std::uint32_t roundShift( const std::uint32_t value, const int shift )
+{
+    std::uint32_t result = value >> shift;
+    std::uint32_t remainder = value & ( ( 1u << shift ) - 1u );
+    std::uint32_t half = 1u << ( shift - 1 );
+    if ( remainder > half || ( remainder == half && ( result & 1u ) ) )
+        ++result;
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+// Convert a float to IEEE binary16 bits. A carry of the rounded mantissa
+// into the exponent gives the correct next power of two.
+KOKKOS_INLINE_FUNCTION
+std::uint16_t floatToHalfBits( const float f )
+{
+    const std::uint32_t x = floatBits( f );
+    const std::uint32_t sign = ( x >> 16 ) & 0x8000u;
+    const std::uint32_t abs = x & 0x7fffffffu;
+
+    // Infinity and NaN.
+    if ( abs >= 0x7f800000u )
+        return sign | 0x7c00u | ( ( abs > 0x7f800000u ) ? 0x0200u : 0u );
+
+    // Overflow to infinity.
+    if ( abs >= 0x47800000u )
+        return sign | 0x7c00u;
+
+    // Subnormal or zero.
+    if ( abs < 0x38800000u )
+    {
+        if ( abs < 0x33000000u )
+            return sign;
+        const int exponent = abs >> 23;
+        const std::uint32_t mantissa = ( abs & 0x007fffffu ) | 0x00800000u;
+        return sign | roundShift( mantissa, 126 - exponent );
+    }
+
+    // Normal.
+    return sign | roundShift( abs - ( 112u << 23 ), 13 );
+}
+
+//---------------------------------------------------------------------------//
+// Convert IEEE binary16 bits to a float.
+KOKKOS_INLINE_FUNCTION
+float halfBitsToFloat( const std::uint16_t h )
+{
+    const std::uint32_t sign = std::uint32_t( h & 0x8000u ) << 16;
+    std::uint32_t exponent = ( h >> 10 ) & 0x1fu;
+    std::uint32_t mantissa = h & 0x03ffu;
+
+    // Infinity and NaN.
+    if ( 0x1fu == exponent )
+        return bitsFloat( sign | 0x7f800000u | ( mantissa << 13 ) );
+
+    // Zero and subnormal. Subnormals are normalized.
+    if ( 0u == exponent )
+    {
+        if ( 0u == mantissa )
+            return bitsFloat( sign );
+        exponent = 113;
+        while ( !( mantissa & 0x0400u ) )
+        {
+            mantissa <<= 1;
+            --exponent;
+        }
+        return bitsFloat( sign | ( exponent << 23 ) |
+                          ( ( mantissa & 0x03ffu ) << 13 ) );
+    }
+
+    // Normal.
+    return bitsFloat( sign | ( ( exponent + 112u ) << 23 ) |
+                      ( mantissa << 13 ) );
+}
+
+//---------------------------------------------------------------------------//
+// Convert a float to bfloat16 bits with round to nearest even.
+KOKKOS_INLINE_FUNCTION
+std::uint16_t floatToBFloat16Bits( const float f )
+{
+    const std::uint32_t x = floatBits( f );
+    if ( ( x & 0x7fffffffu ) > 0x7f800000u )
+        return ( x >> 16 ) | 0x0040u;
+    return ( x + 0x7fffu + ( ( x >> 16 ) & 1u ) ) >> 16;
+}
+
+//---------------------------------------------------------------------------//
+// Convert bfloat16 bits to a float.
+KOKKOS_INLINE_FUNCTION
+float bfloat16BitsToFloat( const std::uint16_t b )
+{
+    return bitsFloat( std::uint32_t( b ) << 16 );
+}
+
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Storage type of a reduced precision floating point member.
+
+  Stores a value in 16 bits and converts it to and from float on access
+  such that kernels read and write slices of reduced precision members as
+  they would slices of float members:
+  \code
+  using DataTypes = MemberTypes<double[3], Half[3], int>;
+  ...
+  float v = slice_v( i, d ); // Widened on load.
+  slice_v( i, d ) = 0.5 * v; // Rounded on store.
+  \endcode
+
+  \tparam Bits The bit conversions of the storage format.
+*/
+template <class Bits>
+struct ReducedPrecisionStorage
+{
+    //! Stored bits.
+    std::uint16_t bits;
+
+    //! Default constructor. The value is uninitialized.
+    KOKKOS_DEFAULTED_FUNCTION ReducedPrecisionStorage() = default;
+
+    //! Construct from a float, rounding to nearest even.
+    KOKKOS_INLINE_FUNCTION ReducedPrecisionStorage( const float value )
+        : bits( Bits::fromFloat( value ) )
+    {
+    }
+
+    //! Assign a float, rounding to nearest even.
+    KOKKOS_INLINE_FUNCTION ReducedPrecisionStorage&
+    operator=( const float value )
+    {
+        bits = Bits::fromFloat( value );
+        return *this;
+    }
+
+    //! Widen to float.
+    KOKKOS_INLINE_FUNCTION operator float() const
+    {
+        return Bits::toFloat( bits );
+    }
+
+    //! Add a value.
+    KOKKOS_INLINE_FUNCTION ReducedPrecisionStorage&
+    operator+=( const float value )
+    {
+        return *this = float( *this ) + value;
+    }
+
+    //! Subtract a value.
+    KOKKOS_INLINE_FUNCTION ReducedPrecisionStorage&
+    operator-=( const float value )
+    {
+        return *this = float( *this ) - value;
+    }
+
+    //! Multiply by a value.
+    KOKKOS_INLINE_FUNCTION ReducedPrecisionStorage&
+    operator*=( const float value )
+    {
+        return *this = float( *this ) * value;
+    }
+
+    //! Divide by a value.
+    KOKKOS_INLINE_FUNCTION ReducedPrecisionStorage&
+    operator/=( const float value )
+    {
+        return *this = float( *this ) / value;
+    }
+};
+
+//---------------------------------------------------------------------------//
+//! \cond Impl
+namespace Impl
+{
+struct HalfBits
+{
+    KOKKOS_INLINE_FUNCTION static std::uint16_t fromFloat( const float f )
+    {
+        return floatToHalfBits( f );
+    }
+    KOKKOS_INLINE_FUNCTION static float toFloat( const std::uint16_t b )
+    {
+        return halfBitsToFloat( b );
+    }
+};
+
+struct BFloat16Bits
+{
+    KOKKOS_INLINE_FUNCTION static std::uint16_t fromFloat( const float f )
+    {
+        return floatToBFloat16Bits( f );
+    }
+    KOKKOS_INLINE_FUNCTION static float toFloat( const std::uint16_t b )
+    {
+        return bfloat16BitsToFloat( b );
+    }
+};
+} // end namespace Impl
+//! \endcond
+
+//! IEEE binary16 member storage: 11 significant bits, range 6e-8 to 65504.
+using Half = ReducedPrecisionStorage<Impl::HalfBits>;
+
+//! bfloat16 member storage: 8 significant bits, the range of float.
+using BFloat16 = ReducedPrecisionStorage<Impl::BFloat16Bits>;
+
+//---------------------------------------------------------------------------//
+//! \cond Impl
+template <class>
+struct is_reduced_precision_impl : public std::false_type
+{
+};
+
+template <class Bits>
+struct is_reduced_precision_impl<ReducedPrecisionStorage<Bits>>
+    : public std::true_type
+{
+};
+//! \endcond
+
+//! Reduced precision storage type checker.
+template <class T>
+struct is_reduced_precision
+    : public is_reduced_precision_impl<typename std::remove_cv<T>::type>::type
+{
+};
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_REDUCEDPRECISION_HPP
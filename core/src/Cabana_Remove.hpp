@@ -0,0 +1,159 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_Remove.hpp
+  \brief Removal of AoSoA elements by stream compaction
+*/
+#ifndef CABANA_REMOVE_HPP
+#define CABANA_REMOVE_HPP
+
+#include <Cabana_AoSoA.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <stdexcept>
+#include <type_traits>
+
+namespace Cabana
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief Compact an AoSoA, keeping only the elements selected by a mask.
+
+  The number of kept elements determines the new size of the AoSoA. Kept
+  elements already in the front of the AoSoA stay in place and kept elements
+  beyond the new size are moved into the holes left by removed elements in
+  the front, such that only min(num_removed, num_kept) elements are moved.
+  The relative order of the kept elements is therefore not preserved.
+
+  \tparam AoSoA_t The AoSoA type.
+
+  \tparam MaskView The Kokkos::View type of the mask.
+
+  \param aosoa The AoSoA to compact.
+
+  \param keep_mask The mask of elements to keep. Element i is kept if
+  keep_mask(i) is non-zero. A mask value is needed for every element of the
+  AoSoA.
+*/
+template <class AoSoA_t, class MaskView>
+void compact( AoSoA_t& aosoa, const MaskView& keep_mask,
+              typename std::enable_if<( is_aosoa<AoSoA_t>::value &&
+                                        Kokkos::is_view<MaskView>::value ),
+                                      int>::type* = 0 )
+{
+    using execution_space = typename AoSoA_t::execution_space;
+    using device_type = typename AoSoA_t::device_type;
+
+    std::size_t num_data = aosoa.size();
+    if ( keep_mask.extent( 0 ) < num_data )
+        throw std::runtime_error( "Mask is smaller than the AoSoA" );
+
+    // Count the kept elements.
+    std::size_t num_keep = 0;
+    Kokkos::parallel_reduce(
+        "Cabana::compact::count_keep",
+        Kokkos::RangePolicy<execution_space>( 0, num_data ),
+        KOKKOS_LAMBDA( const std::size_t i, std::size_t& result ) {
+            if ( keep_mask( i ) )
+                ++result;
+        },
+        num_keep );
+    std::size_t num_removed = num_data - num_keep;
+
+    // Find the holes in the front and the kept elements in the back. There
+    // is one hole for every kept element in the back.
+    Kokkos::View<std::size_t*, device_type> holes(
+        Kokkos::ViewAllocateWithoutInitializing( "holes" ), num_removed );
+    Kokkos::View<std::size_t*, device_type> movers(
+        Kokkos::ViewAllocateWithoutInitializing( "movers" ), num_removed );
+    std::size_t num_move = 0;
+    Kokkos::parallel_scan(
+        "Cabana::compact::find_holes",
+        Kokkos::RangePolicy<execution_space>( 0, num_keep ),
+        KOKKOS_LAMBDA( const std::size_t i, std::size_t& update,
+                       const bool final_pass ) {
+            if ( !keep_mask( i ) )
+            {
+                if ( final_pass )
+                    holes( update ) = i;
+                ++update;
+            }
+        },
+        num_move );
+    Kokkos::parallel_scan(
+        "Cabana::compact::find_movers",
+        Kokkos::RangePolicy<execution_space>( num_keep, num_data ),
+        KOKKOS_LAMBDA( const std::size_t i, std::size_t& update,
+                       const bool final_pass ) {
+            if ( keep_mask( i ) )
+            {
+                if ( final_pass )
+                    movers( update ) = i;
+                ++update;
+            }
+        } );
+
+    // Fill the holes.
+    Kokkos::parallel_for(
+        "Cabana::compact::fill_holes",
+        Kokkos::RangePolicy<execution_space>( 0, num_move ),
+        KOKKOS_LAMBDA( const std::size_t n ) {
+            aosoa.setTuple( holes( n ), aosoa.getTuple( movers( n ) ) );
+        } );
+    Kokkos::fence();
+
+    aosoa.resize( num_keep );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Remove the elements of an AoSoA for which a predicate is true.
+
+  The AoSoA is compacted as in compact() and the order of the remaining
+  elements is not preserved.
+
+  \tparam AoSoA_t The AoSoA type.
+
+  \tparam Predicate The predicate type.
+
+  \param aosoa The AoSoA to remove elements from.
+
+  \param pred The predicate. Element i is removed if pred(i) returns true.
+  The predicate is evaluated in the execution space of the AoSoA.
+*/
+template <class AoSoA_t, class Predicate>
+void remove_if( AoSoA_t& aosoa, const Predicate& pred,
+                typename std::enable_if<( is_aosoa<AoSoA_t>::value ),
+                                        int>::type* = 0 )
+{
+    using execution_space = typename AoSoA_t::execution_space;
+    using device_type = typename AoSoA_t::device_type;
+
+    Kokkos::View<int*, device_type> keep_mask(
+        Kokkos::ViewAllocateWithoutInitializing( "keep_mask" ), aosoa.size() );
+    Kokkos::parallel_for(
+        "Cabana::remove_if::evaluate",
+        Kokkos::RangePolicy<execution_space>( 0, aosoa.size() ),
+        KOKKOS_LAMBDA( const std::size_t i ) {
+            keep_mask( i ) = pred( i ) ? 0 : 1;
+        } );
+    Kokkos::fence();
+
+    compact( aosoa, keep_mask );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_REMOVE_HPP
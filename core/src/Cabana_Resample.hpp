@@ -0,0 +1,285 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_Resample.hpp
+  \brief Per-cell particle resampling by merging and splitting
+*/
+#ifndef CABANA_RESAMPLE_HPP
+#define CABANA_RESAMPLE_HPP
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_AppendBuffer.hpp>
+#include <Cabana_LinkedCellList.hpp>
+#include <Cabana_Remove.hpp>
+#include <Cabana_Slice.hpp>
+#include <Cabana_Tuple.hpp>
+#include <impl/Cabana_Profiling.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+namespace Cabana
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief Get the number of particles in every cell of a linked cell list.
+
+  \param cell_list The linked cell list.
+
+  \return The particle count of every cell by cardinal cell index.
+*/
+template <class DeviceType>
+Kokkos::View<int*, DeviceType>
+cellCounts( const LinkedCellList<DeviceType>& cell_list )
+{
+    using execution_space = typename DeviceType::execution_space;
+    auto bin_data = cell_list.binningData();
+    Kokkos::View<int*, DeviceType> counts(
+        Kokkos::ViewAllocateWithoutInitializing( "cell_counts" ),
+        cell_list.totalBins() );
+    Kokkos::parallel_for(
+        "Cabana::cellCounts",
+        Kokkos::RangePolicy<execution_space>( 0, counts.extent( 0 ) ),
+        KOKKOS_LAMBDA( const int c ) { counts( c ) = bin_data.binSize( c ); } );
+    Kokkos::fence();
+    return counts;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Resampling rule conserving weight, weighted position, and momentum.
+
+  \tparam WeightIndex The member index of the particle weight.
+  \tparam PositionIndex The member index of the particle position.
+  \tparam VelocityIndex The member index of the particle velocity.
+
+  A merge replaces two particles by one with their total weight at their
+  weighted center moving with their weighted mean velocity. Kinetic energy
+  is not conserved. A split replaces a particle by two copies with half of
+  its weight, which conserves all moments.
+
+  Rules used with resample() provide the same two functions for other
+  conservation laws. A merge returning false keeps both particles.
+*/
+template <std::size_t WeightIndex, std::size_t PositionIndex,
+          std::size_t VelocityIndex>
+struct ConservingResampleRule
+{
+    //! Merge particle b into particle a.
+    template <class Tuple_t>
+    KOKKOS_INLINE_FUNCTION bool merge( Tuple_t& a, const Tuple_t& b ) const
+    {
+        double wa = get<WeightIndex>( a );
+        double wb = get<WeightIndex>( b );
+        double w = wa + wb;
+        if ( !( w > 0.0 ) )
+            return false;
+        for ( int d = 0; d < 3; ++d )
+        {
+            get<PositionIndex>( a, d ) = ( wa * get<PositionIndex>( a, d ) +
+                                           wb * get<PositionIndex>( b, d ) ) /
+                                         w;
+            get<VelocityIndex>( a, d ) = ( wa * get<VelocityIndex>( a, d ) +
+                                           wb * get<VelocityIndex>( b, d ) ) /
+                                         w;
+        }
+        get<WeightIndex>( a ) = w;
+        return true;
+    }
+
+    //! Split a parent particle into itself and a child.
+    template <class Tuple_t>
+    KOKKOS_INLINE_FUNCTION void split( Tuple_t& parent, Tuple_t& child ) const
+    {
+        get<WeightIndex>( parent ) *= 0.5;
+        get<WeightIndex>( child ) = get<WeightIndex>( parent );
+    }
+};
+
+//---------------------------------------------------------------------------//
+//! Number of particles changed by a resampling.
+struct ResampleResult
+{
+    //! Number of merges, each removing one particle.
+    std::size_t num_merge = 0;
+    //! Number of splits, each adding one particle.
+    std::size_t num_split = 0;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Resample the particles of a linked cell list towards a range of
+  particles per cell.
+
+  \tparam AoSoA_t The AoSoA type.
+  \tparam DeviceType The linked cell list device type.
+  \tparam WeightSlice The weight slice type.
+  \tparam Rule The merge and split rule type, e.g. ConservingResampleRule.
+
+  \param aosoa The particles. The cell list must be built on their current
+  order. The size and order change.
+
+  \param cell_list The linked cell list of the particles.
+
+  \param weights The weight of every particle.
+
+  \param min_per_cell Cells with fewer particles split their heaviest
+  particles, each at most once, to approach this count.
+
+  \param max_per_cell Cells with more particles merge pairs of their lightest
+  particles, each at most once, to approach this count.
+
+  \param rule The rule merging two particles and splitting one. Rules act on
+  tuples of the AoSoA.
+
+  \return The number of merges and splits.
+
+  Particles are ranked by weight within their cell with a cost quadratic in
+  the number of particles in the cell, which suits the per-cell counts of
+  PIC. Split children are appended with an AppendBuffer and merged particles
+  are removed with compact(), such that the order of the particles is not
+  preserved and the cell list must be rebuilt afterwards. Particles outside
+  of the range of the cell list are not resampled.
+*/
+template <class AoSoA_t, class DeviceType, class WeightSlice, class Rule>
+ResampleResult
+resample( AoSoA_t& aosoa, const LinkedCellList<DeviceType>& cell_list,
+          const WeightSlice& weights, const int min_per_cell,
+          const int max_per_cell, const Rule& rule,
+          typename std::enable_if<( is_aosoa<AoSoA_t>::value &&
+                                    is_slice<WeightSlice>::value ),
+                                  int>::type* = 0 )
+{
+    Impl::ScopedProfileRegion region( "Cabana::resample" );
+
+    using execution_space = typename AoSoA_t::execution_space;
+    using memory_space = typename AoSoA_t::memory_space;
+    using team_policy = Kokkos::TeamPolicy<execution_space>;
+    using member_type = typename team_policy::member_type;
+    using tuple_type = typename AoSoA_t::tuple_type;
+
+    if ( min_per_cell > max_per_cell )
+        throw std::runtime_error( "Minimum particles per cell exceeds the "
+                                  "maximum" );
+
+    auto bin_data = cell_list.binningData();
+    int num_cell = cell_list.totalBins();
+    std::size_t num_binned = cell_list.rangeEnd() - cell_list.rangeBegin();
+
+    // Order the particles of every cell to resample by increasing weight.
+    Kokkos::View<int*, memory_space> order(
+        Kokkos::ViewAllocateWithoutInitializing( "resample_order" ),
+        num_binned );
+    auto rank_op = KOKKOS_LAMBDA( const member_type& team )
+    {
+        int c = team.league_rank();
+        int n = bin_data.binSize( c );
+        if ( n >= min_per_cell && n <= max_per_cell )
+            return;
+        std::size_t offset = bin_data.binOffset( c );
+        Kokkos::parallel_for( Kokkos::TeamThreadRange( team, n ),
+                              [&]( const int a ) {
+                                  int p = bin_data.permutation( offset + a );
+                                  auto wp = weights( p );
+                                  int rank = 0;
+                                  for ( int b = 0; b < n; ++b )
+                                  {
+                                      auto wq = weights( bin_data.permutation(
+                                          offset + b ) );
+                                      if ( wq < wp || ( wq == wp && b < a ) )
+                                          ++rank;
+                                  }
+                                  order( offset + rank ) = p;
+                              } );
+    };
+    Kokkos::parallel_for( "Cabana::resample::rank",
+                          team_policy( num_cell, Kokkos::AUTO ), rank_op );
+
+    // Count the splits.
+    std::size_t num_split = 0;
+    Kokkos::parallel_reduce(
+        "Cabana::resample::count_split",
+        Kokkos::RangePolicy<execution_space>( 0, num_cell ),
+        KOKKOS_LAMBDA( const int c, std::size_t& result ) {
+            int n = bin_data.binSize( c );
+            if ( n > 0 && n < min_per_cell )
+                result += ( min_per_cell - n < n ) ? min_per_cell - n : n;
+        },
+        num_split );
+
+    // Merge the lightest pairs of crowded cells and split the heaviest
+    // particles of sparse cells.
+    std::size_t num_data = aosoa.size();
+    Kokkos::View<int*, memory_space> keep_mask( "resample_keep_mask",
+                                                num_data + num_split );
+    Kokkos::deep_copy( keep_mask, 1 );
+    AppendBuffer<AoSoA_t> buffer( aosoa, num_split );
+    AoSoA_t particles = aosoa;
+    auto resample_op = KOKKOS_LAMBDA( const member_type& team )
+    {
+        int c = team.league_rank();
+        int n = bin_data.binSize( c );
+        std::size_t offset = bin_data.binOffset( c );
+        if ( n > max_per_cell )
+        {
+            int num_merge = ( n - max_per_cell < n / 2 ) ? n - max_per_cell
+                                                         : n / 2;
+            Kokkos::parallel_for(
+                Kokkos::TeamThreadRange( team, num_merge ),
+                [&]( const int m ) {
+                    int i = order( offset + 2 * m );
+                    int j = order( offset + 2 * m + 1 );
+                    tuple_type ti = particles.getTuple( i );
+                    tuple_type tj = particles.getTuple( j );
+                    if ( rule.merge( ti, tj ) )
+                    {
+                        particles.setTuple( i, ti );
+                        keep_mask( j ) = 0;
+                    }
+                } );
+        }
+        else if ( n > 0 && n < min_per_cell )
+        {
+            int split = ( min_per_cell - n < n ) ? min_per_cell - n : n;
+            Kokkos::parallel_for( Kokkos::TeamThreadRange( team, split ),
+                                  [&]( const int s ) {
+                                      int i = order( offset + n - 1 - s );
+                                      tuple_type parent =
+                                          particles.getTuple( i );
+                                      tuple_type child = parent;
+                                      rule.split( parent, child );
+                                      particles.setTuple( i, parent );
+                                      buffer.append( child );
+                                  } );
+        }
+    };
+    Kokkos::parallel_for( "Cabana::resample::merge_split",
+                          team_policy( num_cell, Kokkos::AUTO ), resample_op );
+    Kokkos::fence();
+
+    // Append the children and remove the merged particles.
+    ResampleResult result;
+    result.num_split = buffer.commit( aosoa );
+    std::size_t num_before_compact = aosoa.size();
+    compact( aosoa, keep_mask );
+    result.num_merge = num_before_compact - aosoa.size();
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_RESAMPLE_HPP
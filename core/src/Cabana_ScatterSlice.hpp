@@ -0,0 +1,305 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_ScatterSlice.hpp
+  \brief Scatter-add contributions into slices
+*/
+#ifndef CABANA_SCATTERSLICE_HPP
+#define CABANA_SCATTERSLICE_HPP
+
+#include <Cabana_Slice.hpp>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ScatterView.hpp>
+
+#include <type_traits>
+
+namespace Cabana
+{
+namespace Impl
+{
+//! \cond Impl
+// Scatter access of a slice. Contributions are added atomically into the
+// slice.
+template <class SliceType, class ScatterType, bool Duplicated>
+struct ScatterSliceAccess
+{
+    typename SliceType::atomic_access_slice slice;
+
+    KOKKOS_INLINE_FUNCTION
+    static ScatterSliceAccess create( const SliceType& slice,
+                                      const ScatterType&, const std::size_t* )
+    {
+        return ScatterSliceAccess{ slice };
+    }
+
+    template <class... Indices>
+    KOKKOS_FORCEINLINE_FUNCTION decltype( auto )
+    operator()( const std::size_t i, const Indices... d ) const
+    {
+        return slice( i, d... );
+    }
+};
+
+// Scatter access of a slice with a duplicated buffer. Contributions are
+// added into the duplicate of the calling thread. The components of an
+// element are flattened in row-major order.
+template <class SliceType, class ScatterType>
+struct ScatterSliceAccess<SliceType, ScatterType, true>
+{
+    decltype( std::declval<ScatterType>().access() ) buffer;
+    std::size_t extent[2];
+
+    KOKKOS_INLINE_FUNCTION
+    static ScatterSliceAccess create( const SliceType&,
+                                      const ScatterType& scatter,
+                                      const std::size_t* extents )
+    {
+        return ScatterSliceAccess{ scatter.access(),
+                                   { extents[0], extents[1] } };
+    }
+
+    KOKKOS_FORCEINLINE_FUNCTION decltype( auto )
+    operator()( const std::size_t i ) const
+    {
+        return buffer( i, 0 );
+    }
+
+    KOKKOS_FORCEINLINE_FUNCTION decltype( auto )
+    operator()( const std::size_t i, const std::size_t d0 ) const
+    {
+        return buffer( i, d0 );
+    }
+
+    KOKKOS_FORCEINLINE_FUNCTION decltype( auto )
+    operator()( const std::size_t i, const std::size_t d0,
+                const std::size_t d1 ) const
+    {
+        return buffer( i, d0 * extent[0] + d1 );
+    }
+
+    KOKKOS_FORCEINLINE_FUNCTION decltype( auto )
+    operator()( const std::size_t i, const std::size_t d0,
+                const std::size_t d1, const std::size_t d2 ) const
+    {
+        return buffer( i, ( d0 * extent[0] + d1 ) * extent[1] + d2 );
+    }
+};
+
+// Add the flattened buffer of an element into a slice of the given raw
+// rank.
+template <std::size_t RawRank>
+struct ScatterSliceAdd;
+
+template <>
+struct ScatterSliceAdd<2>
+{
+    template <class SliceType, class BufferType>
+    KOKKOS_INLINE_FUNCTION static void apply( const SliceType& slice,
+                                              const BufferType& buffer,
+                                              const std::size_t i )
+    {
+        slice( i ) += buffer( i, 0 );
+    }
+};
+
+template <>
+struct ScatterSliceAdd<3>
+{
+    template <class SliceType, class BufferType>
+    KOKKOS_INLINE_FUNCTION static void apply( const SliceType& slice,
+                                              const BufferType& buffer,
+                                              const std::size_t i )
+    {
+        for ( std::size_t d0 = 0; d0 < slice.extent( 2 ); ++d0 )
+            slice( i, d0 ) += buffer( i, d0 );
+    }
+};
+
+template <>
+struct ScatterSliceAdd<4>
+{
+    template <class SliceType, class BufferType>
+    KOKKOS_INLINE_FUNCTION static void apply( const SliceType& slice,
+                                              const BufferType& buffer,
+                                              const std::size_t i )
+    {
+        std::size_t c = 0;
+        for ( std::size_t d0 = 0; d0 < slice.extent( 2 ); ++d0 )
+            for ( std::size_t d1 = 0; d1 < slice.extent( 3 ); ++d1, ++c )
+                slice( i, d0, d1 ) += buffer( i, c );
+    }
+};
+
+template <>
+struct ScatterSliceAdd<5>
+{
+    template <class SliceType, class BufferType>
+    KOKKOS_INLINE_FUNCTION static void apply( const SliceType& slice,
+                                              const BufferType& buffer,
+                                              const std::size_t i )
+    {
+        std::size_t c = 0;
+        for ( std::size_t d0 = 0; d0 < slice.extent( 2 ); ++d0 )
+            for ( std::size_t d1 = 0; d1 < slice.extent( 3 ); ++d1 )
+                for ( std::size_t d2 = 0; d2 < slice.extent( 4 ); ++d2, ++c )
+                    slice( i, d0, d1, d2 ) += buffer( i, c );
+    }
+};
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Sum contributions from many threads into a slice.
+
+  \tparam SliceType The slice type.
+
+  \tparam Duplication Kokkos::Experimental::ScatterDuplicated to give each
+  thread its own buffer or Kokkos::Experimental::ScatterNonDuplicated to add
+  atomically into the slice. Defaults to the choice of Kokkos::ScatterView
+  for the execution space of the slice, which duplicates on threaded host
+  backends and uses atomics on devices.
+
+  Kernels get an accessor with access() and add to its elements with the
+  indices of the slice, as with Kokkos::Experimental::ScatterView. The
+  contributions are only guaranteed to be in the slice after contribute().
+*/
+template <class SliceType,
+          class Duplication =
+              typename Kokkos::Impl::Experimental::DefaultDuplication<
+                  typename SliceType::execution_space>::type>
+class ScatterSlice
+{
+  public:
+    static_assert( is_slice<SliceType>::value,
+                   "ScatterSlice requires a slice" );
+
+    //! Slice type.
+    using slice_type = SliceType;
+
+    //! Value type.
+    using value_type = typename slice_type::value_type;
+
+    //! Kokkos memory space.
+    using memory_space = typename slice_type::memory_space;
+
+    //! Kokkos execution space.
+    using execution_space = typename slice_type::execution_space;
+
+    //! Whether each thread adds into its own buffer.
+    static constexpr bool is_duplicated =
+        std::is_same<Duplication,
+                     Kokkos::Experimental::ScatterDuplicated>::value;
+
+    //! Contribution buffer type with one row per slice element.
+    using buffer_type = Kokkos::View<value_type**, Kokkos::LayoutRight,
+                                     memory_space>;
+
+    //! Duplicated buffer type.
+    using scatter_type = Kokkos::Experimental::ScatterView<
+        value_type**, Kokkos::LayoutRight,
+        Kokkos::Device<execution_space, memory_space>,
+        Kokkos::Experimental::ScatterSum, Duplication>;
+
+    //! Accessor type.
+    using access_type =
+        Impl::ScatterSliceAccess<slice_type, scatter_type, is_duplicated>;
+
+    /*!
+      \brief Constructor.
+
+      \param slice The slice to contribute to. For duplicated scatters a
+      buffer of the size of the slice is allocated for each thread.
+    */
+    ScatterSlice( const slice_type& slice )
+        : _slice( slice )
+    {
+        _num_comp = 1;
+        for ( std::size_t d = 2; d < slice.rank(); ++d )
+            _num_comp *= slice.extent( d );
+        _extents[0] = ( slice.rank() > 3 ) ? slice.extent( 3 ) : 1;
+        _extents[1] = ( slice.rank() > 4 ) ? slice.extent( 4 ) : 1;
+
+        if ( is_duplicated )
+        {
+            _buffer = buffer_type( "Cabana::ScatterSlice::buffer",
+                                   slice.size(), _num_comp );
+            _scatter = scatter_type( _buffer );
+        }
+    }
+
+    /*!
+      \brief Get the accessor for contributions. Must be called inside the
+      kernel which contributes.
+    */
+    KOKKOS_INLINE_FUNCTION
+    access_type access() const
+    {
+        return access_type::create( _slice, _scatter, _extents );
+    }
+
+    /*!
+      \brief Add the contributions made since construction or the last
+      contribute() into the slice and reset them.
+    */
+    void contribute()
+    {
+        if ( !is_duplicated )
+            return;
+
+        Kokkos::Experimental::contribute( _buffer, _scatter );
+        addBuffer( _slice );
+        reset();
+    }
+
+    /*!
+      \brief Discard the contributions made since construction or the last
+      contribute().
+    */
+    void reset()
+    {
+        if ( !is_duplicated )
+            return;
+
+        _scatter.reset();
+        Kokkos::deep_copy( _buffer, 0 );
+    }
+
+  private:
+    // Add the summed contributions into the slice.
+    void addBuffer( const slice_type& slice )
+    {
+        using add_type = Impl::ScatterSliceAdd<slice_type::kokkos_view::Rank>;
+        auto buffer = _buffer;
+        Kokkos::parallel_for(
+            "Cabana::ScatterSlice::contribute",
+            Kokkos::RangePolicy<execution_space>( 0, slice.size() ),
+            KOKKOS_LAMBDA( const std::size_t i ) {
+                add_type::apply( slice, buffer, i );
+            } );
+        Kokkos::fence();
+    }
+
+  private:
+    slice_type _slice;
+    std::size_t _num_comp;
+    std::size_t _extents[2];
+    buffer_type _buffer;
+    scatter_type _scatter;
+};
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_SCATTERSLICE_HPP
@@ -0,0 +1,617 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_ScratchSlice.hpp
+  \brief Team scratch copies of slice data over blocks of structs, cell
+  neighborhoods and particle neighbors
+*/
+#ifndef CABANA_SCRATCHSLICE_HPP
+#define CABANA_SCRATCHSLICE_HPP
+
+#include <Cabana_NeighborList.hpp>
+#include <Cabana_Slice.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <cmath>
+#include <type_traits>
+
+namespace Cabana
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief A copy of slice data in team scratch memory over a contiguous block
+  of structs.
+
+  \tparam SliceType The slice type.
+
+  The scratch data is indexed like the slice with absolute struct and array
+  indices, which must be inside the block of structs the scratch slice was
+  created for. Each component is stored contiguously over the array elements
+  of the block such that the team loads and stores with unit stride.
+*/
+template <class SliceType>
+class ScratchSlice
+{
+  public:
+    static_assert( is_slice<SliceType>::value,
+                   "ScratchSlice requires a slice" );
+
+    //! Value type.
+    using value_type =
+        typename std::remove_const<typename SliceType::value_type>::type;
+
+    //! Kokkos execution space.
+    using execution_space = typename SliceType::execution_space;
+
+    //! Kokkos scratch memory space.
+    using scratch_memory_space = typename execution_space::scratch_memory_space;
+
+    //! Scratch view type.
+    using view_type =
+        Kokkos::View<value_type**, Kokkos::LayoutRight, scratch_memory_space,
+                     Kokkos::MemoryUnmanaged>;
+
+    //! Vector length.
+    static constexpr int vector_length = SliceType::vector_length;
+
+    /*!
+      \brief Get the scratch size needed for a block of structs.
+
+      \param slice The slice to copy.
+
+      \param num_struct The number of structs in the block.
+
+      \return The scratch size in bytes.
+    */
+    static std::size_t scratchSize( const SliceType& slice,
+                                    const int num_struct )
+    {
+        return view_type::shmem_size( numComp( slice ),
+                                      num_struct * vector_length );
+    }
+
+    /*!
+      \brief Allocate the scratch slice from team scratch level 0. The data
+      is not copied until load() is called.
+
+      \param team The team member.
+
+      \param slice The slice to copy.
+
+      \param s_begin The first struct of the block.
+
+      \param s_end One past the last struct of the block.
+    */
+    template <class TeamMember>
+    KOKKOS_INLINE_FUNCTION ScratchSlice( const TeamMember& team,
+                                         const SliceType& slice,
+                                         const int s_begin, const int s_end )
+        : _slice( slice )
+        , _s_begin( s_begin )
+        , _num_struct( s_end - s_begin )
+        , _num_comp( numComp( slice ) )
+        , _d1( slice.rank() > 3 ? slice.extent( 3 ) : 1 )
+        , _d2( slice.rank() > 4 ? slice.extent( 4 ) : 1 )
+        , _data( team.team_scratch( 0 ), _num_comp,
+                 _num_struct * vector_length )
+    {
+    }
+
+    /*!
+      \brief Cooperatively copy the block from the slice into scratch. A team
+      barrier is needed before the scratch data is read.
+    */
+    template <class TeamMember>
+    KOKKOS_INLINE_FUNCTION void load( const TeamMember& team ) const
+    {
+        auto slice_data = _slice.data();
+        Kokkos::parallel_for(
+            Kokkos::TeamThreadRange( team, _num_comp * _num_struct ),
+            [&]( const int k ) {
+                int n = k / _num_struct;
+                int ls = k % _num_struct;
+                std::size_t offset =
+                    ( _s_begin + ls ) * _slice.stride( 0 ) + n * vector_length;
+                Kokkos::parallel_for(
+                    Kokkos::ThreadVectorRange( team, vector_length ),
+                    [&]( const int a ) {
+                        _data( n, ls * vector_length + a ) =
+                            slice_data[offset + a];
+                    } );
+            } );
+    }
+
+    /*!
+      \brief Cooperatively copy the block from scratch back into the slice. A
+      team barrier is needed before this if the scratch data was written.
+    */
+    template <class TeamMember>
+    KOKKOS_INLINE_FUNCTION void store( const TeamMember& team ) const
+    {
+        auto slice_data = _slice.data();
+        Kokkos::parallel_for(
+            Kokkos::TeamThreadRange( team, _num_comp * _num_struct ),
+            [&]( const int k ) {
+                int n = k / _num_struct;
+                int ls = k % _num_struct;
+                std::size_t offset =
+                    ( _s_begin + ls ) * _slice.stride( 0 ) + n * vector_length;
+                Kokkos::parallel_for(
+                    Kokkos::ThreadVectorRange( team, vector_length ),
+                    [&]( const int a ) {
+                        slice_data[offset + a] =
+                            _data( n, ls * vector_length + a );
+                    } );
+            } );
+    }
+
+    //! Access for rank 0 members.
+    KOKKOS_FORCEINLINE_FUNCTION
+    value_type& access( const int s, const int a ) const
+    {
+        return _data( 0, element( s, a ) );
+    }
+
+    //! Access for rank 1 members.
+    KOKKOS_FORCEINLINE_FUNCTION
+    value_type& access( const int s, const int a, const int d0 ) const
+    {
+        return _data( d0, element( s, a ) );
+    }
+
+    //! Access for rank 2 members.
+    KOKKOS_FORCEINLINE_FUNCTION
+    value_type& access( const int s, const int a, const int d0,
+                        const int d1 ) const
+    {
+        return _data( d0 * _d1 + d1, element( s, a ) );
+    }
+
+    //! Access for rank 3 members.
+    KOKKOS_FORCEINLINE_FUNCTION
+    value_type& access( const int s, const int a, const int d0, const int d1,
+                        const int d2 ) const
+    {
+        return _data( ( d0 * _d1 + d1 ) * _d2 + d2, element( s, a ) );
+    }
+
+  private:
+    // Get the number of components in each element of a slice.
+    KOKKOS_INLINE_FUNCTION
+    static int numComp( const SliceType& slice )
+    {
+        int num_comp = 1;
+        for ( std::size_t d = 2; d < slice.rank(); ++d )
+            num_comp *= slice.extent( d );
+        return num_comp;
+    }
+
+    // Get the element index in the block.
+    KOKKOS_FORCEINLINE_FUNCTION
+    int element( const int s, const int a ) const
+    {
+        return ( s - _s_begin ) * vector_length + a;
+    }
+
+  private:
+    SliceType _slice;
+    int _s_begin;
+    int _num_struct;
+    int _num_comp;
+    int _d1;
+    int _d2;
+    view_type _data;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief A copy of slice data in team scratch memory for the particles of a
+  cell and all cells in its neighborhood stencil.
+
+  \tparam SliceType The slice type.
+
+  The particles must be sorted by the linked cell list the tile is loaded
+  from such that the particles of each cell are contiguous. The cells of a
+  stencil row with fixed i and j indices are then also contiguous and the
+  tile is loaded one row at a time. Particles are indexed by their position
+  in the tile and each component is stored contiguously over the tile.
+*/
+template <class SliceType>
+class NeighborTile
+{
+  public:
+    static_assert( is_slice<SliceType>::value,
+                   "NeighborTile requires a slice" );
+
+    //! Value type.
+    using value_type =
+        typename std::remove_const<typename SliceType::value_type>::type;
+
+    //! Kokkos execution space.
+    using execution_space = typename SliceType::execution_space;
+
+    //! Kokkos scratch memory space.
+    using scratch_memory_space = typename execution_space::scratch_memory_space;
+
+    //! Scratch data view type.
+    using view_type =
+        Kokkos::View<value_type**, Kokkos::LayoutRight, scratch_memory_space,
+                     Kokkos::MemoryUnmanaged>;
+
+    //! Scratch particle index view type.
+    using index_view_type = Kokkos::View<int*, scratch_memory_space,
+                                         Kokkos::MemoryUnmanaged>;
+
+    //! Vector length.
+    static constexpr int vector_length = SliceType::vector_length;
+
+    /*!
+      \brief Get the scratch size needed for a tile.
+
+      \param slice The slice to copy.
+
+      \param max_size The maximum number of particles in the tile.
+
+      \return The scratch size in bytes.
+    */
+    static std::size_t scratchSize( const SliceType& slice,
+                                    const int max_size )
+    {
+        return view_type::shmem_size( numComp( slice ), max_size ) +
+               index_view_type::shmem_size( max_size );
+    }
+
+    /*!
+      \brief Get the number of particles in the stencil of a cell.
+
+      \param cells The linked cell list.
+
+      \param ci The i cell index.
+
+      \param cj The j cell index.
+
+      \param ck The k cell index.
+
+      \param range The number of neighbor cells in the stencil on each side
+      of the cell in each dimension.
+
+      \return The number of particles in the tile of the cell.
+    */
+    template <class CellListType>
+    KOKKOS_INLINE_FUNCTION static int
+    tileSize( const CellListType& cells, const int ci, const int cj,
+              const int ck, const int range[3] )
+    {
+        int lo[3];
+        int hi[3];
+        stencilBounds( cells, ci, cj, ck, range, lo, hi );
+        int size = 0;
+        for ( int ii = lo[0]; ii <= hi[0]; ++ii )
+            for ( int jj = lo[1]; jj <= hi[1]; ++jj )
+                size += rowSize( cells, ii, jj, lo[2], hi[2] );
+        return size;
+    }
+
+    /*!
+      \brief Allocate the tile from team scratch level 0. The data is not
+      copied until load() is called.
+
+      \param team The team member.
+
+      \param slice The slice to copy.
+
+      \param max_size The maximum number of particles in the tile.
+    */
+    template <class TeamMember>
+    KOKKOS_INLINE_FUNCTION NeighborTile( const TeamMember& team,
+                                         const SliceType& slice,
+                                         const int max_size )
+        : _slice( slice )
+        , _size( 0 )
+        , _center( 0 )
+        , _num_comp( numComp( slice ) )
+        , _d1( slice.rank() > 3 ? slice.extent( 3 ) : 1 )
+        , _d2( slice.rank() > 4 ? slice.extent( 4 ) : 1 )
+        , _data( team.team_scratch( 0 ), _num_comp, max_size )
+        , _index( team.team_scratch( 0 ), max_size )
+    {
+    }
+
+    /*!
+      \brief Cooperatively copy the particles in the stencil of a cell into
+      the tile. A team barrier is needed before the tile is read.
+
+      \param team The team member.
+
+      \param cells The linked cell list the slice is sorted with.
+
+      \param ci The i cell index.
+
+      \param cj The j cell index.
+
+      \param ck The k cell index.
+
+      \param range The number of neighbor cells in the stencil on each side
+      of the cell in each dimension.
+    */
+    template <class TeamMember, class CellListType>
+    KOKKOS_INLINE_FUNCTION void load( const TeamMember& team,
+                                      const CellListType& cells, const int ci,
+                                      const int cj, const int ck,
+                                      const int range[3] )
+    {
+        int lo[3];
+        int hi[3];
+        stencilBounds( cells, ci, cj, ck, range, lo, hi );
+        int num_j = hi[1] - lo[1] + 1;
+        int num_row = ( hi[0] - lo[0] + 1 ) * num_j;
+
+        // Every thread computes the tile size and the position of the
+        // center cell in the tile.
+        _size = 0;
+        for ( int r = 0; r < num_row; ++r )
+        {
+            int ii = lo[0] + r / num_j;
+            int jj = lo[1] + r % num_j;
+            if ( ii == ci && jj == cj )
+                _center = _size + cells.binOffset( ci, cj, ck ) -
+                          cells.binOffset( ii, jj, lo[2] );
+            _size += rowSize( cells, ii, jj, lo[2], hi[2] );
+        }
+
+        // Copy the rows.
+        auto slice_data = _slice.data();
+        std::size_t range_begin = cells.rangeBegin();
+        Kokkos::parallel_for(
+            Kokkos::TeamThreadRange( team, num_row ), [&]( const int r ) {
+                int tile_offset = 0;
+                for ( int q = 0; q < r; ++q )
+                    tile_offset += rowSize( cells, lo[0] + q / num_j,
+                                            lo[1] + q % num_j, lo[2], hi[2] );
+                int ii = lo[0] + r / num_j;
+                int jj = lo[1] + r % num_j;
+                std::size_t row_begin =
+                    range_begin + cells.binOffset( ii, jj, lo[2] );
+                Kokkos::parallel_for(
+                    Kokkos::ThreadVectorRange(
+                        team, rowSize( cells, ii, jj, lo[2], hi[2] ) ),
+                    [&]( const int n ) {
+                        std::size_t p = row_begin + n;
+                        std::size_t offset =
+                            ( p / vector_length ) * _slice.stride( 0 ) +
+                            p % vector_length;
+                        for ( int c = 0; c < _num_comp; ++c )
+                            _data( c, tile_offset + n ) =
+                                slice_data[offset + c * vector_length];
+                        _index( tile_offset + n ) = p;
+                    } );
+            } );
+    }
+
+    //! Get the number of particles in the tile.
+    KOKKOS_INLINE_FUNCTION
+    int size() const { return _size; }
+
+    //! Get the tile index of the first particle of the center cell.
+    KOKKOS_INLINE_FUNCTION
+    int center() const { return _center; }
+
+    //! Get the slice index of a particle in the tile.
+    KOKKOS_FORCEINLINE_FUNCTION
+    int particle( const int n ) const { return _index( n ); }
+
+    //! Access for rank 0 members.
+    KOKKOS_FORCEINLINE_FUNCTION
+    value_type& access( const int n ) const { return _data( 0, n ); }
+
+    //! Access for rank 1 members.
+    KOKKOS_FORCEINLINE_FUNCTION
+    value_type& access( const int n, const int d0 ) const
+    {
+        return _data( d0, n );
+    }
+
+    //! Access for rank 2 members.
+    KOKKOS_FORCEINLINE_FUNCTION
+    value_type& access( const int n, const int d0, const int d1 ) const
+    {
+        return _data( d0 * _d1 + d1, n );
+    }
+
+    //! Access for rank 3 members.
+    KOKKOS_FORCEINLINE_FUNCTION
+    value_type& access( const int n, const int d0, const int d1,
+                        const int d2 ) const
+    {
+        return _data( ( d0 * _d1 + d1 ) * _d2 + d2, n );
+    }
+
+  private:
+    // Get the number of components in each element of a slice.
+    KOKKOS_INLINE_FUNCTION
+    static int numComp( const SliceType& slice )
+    {
+        int num_comp = 1;
+        for ( std::size_t d = 2; d < slice.rank(); ++d )
+            num_comp *= slice.extent( d );
+        return num_comp;
+    }
+
+    // Get the cell index bounds of the stencil of a cell.
+    template <class CellListType>
+    KOKKOS_INLINE_FUNCTION static void
+    stencilBounds( const CellListType& cells, const int ci, const int cj,
+                   const int ck, const int range[3], int lo[3], int hi[3] )
+    {
+        const int c[3] = { ci, cj, ck };
+        for ( int d = 0; d < 3; ++d )
+        {
+            lo[d] = ( c[d] - range[d] > 0 ) ? c[d] - range[d] : 0;
+            hi[d] = ( c[d] + range[d] < cells.numBin( d ) - 1 )
+                        ? c[d] + range[d]
+                        : cells.numBin( d ) - 1;
+        }
+    }
+
+    // Get the number of particles in a contiguous row of cells.
+    template <class CellListType>
+    KOKKOS_INLINE_FUNCTION static int rowSize( const CellListType& cells,
+                                               const int ii, const int jj,
+                                               const int k_lo, const int k_hi )
+    {
+        return cells.binOffset( ii, jj, k_hi ) + cells.binSize( ii, jj, k_hi ) -
+               cells.binOffset( ii, jj, k_lo );
+    }
+
+  private:
+    SliceType _slice;
+    int _size;
+    int _center;
+    int _num_comp;
+    int _d1;
+    int _d2;
+    view_type _data;
+    index_view_type _index;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Displacements and distances from a particle to each of its
+  neighbors cached in team scratch memory.
+
+  \tparam PositionSlice The position slice type.
+
+  The cache is computed once per particle such that operations over pairs of
+  neighbors of the particle, such as three-body interactions, read the
+  neighbor geometry from scratch instead of recomputing it.
+*/
+template <class PositionSlice>
+class NeighborPairCache
+{
+  public:
+    static_assert( is_slice<PositionSlice>::value,
+                   "NeighborPairCache requires a position slice" );
+
+    //! Value type.
+    using value_type =
+        typename std::remove_const<typename PositionSlice::value_type>::type;
+
+    //! Kokkos execution space.
+    using execution_space = typename PositionSlice::execution_space;
+
+    //! Kokkos scratch memory space.
+    using scratch_memory_space = typename execution_space::scratch_memory_space;
+
+    //! Scratch view type holding the displacement and the distance.
+    using view_type =
+        Kokkos::View<value_type* [4], Kokkos::LayoutRight, scratch_memory_space,
+                     Kokkos::MemoryUnmanaged>;
+
+    //! Scratch neighbor index view type.
+    using index_view_type = Kokkos::View<int*, scratch_memory_space,
+                                         Kokkos::MemoryUnmanaged>;
+
+    /*!
+      \brief Get the scratch size needed for a cache.
+
+      \param max_neighbor The maximum number of neighbors of a particle.
+
+      \return The scratch size in bytes.
+    */
+    static std::size_t scratchSize( const int max_neighbor )
+    {
+        return view_type::shmem_size( max_neighbor ) +
+               index_view_type::shmem_size( max_neighbor );
+    }
+
+    /*!
+      \brief Allocate the cache from team scratch level 0. The cache is not
+      computed until load() is called.
+
+      \param team The team member.
+
+      \param max_neighbor The maximum number of neighbors of a particle.
+    */
+    template <class TeamMember>
+    KOKKOS_INLINE_FUNCTION NeighborPairCache( const TeamMember& team,
+                                              const int max_neighbor )
+        : _size( 0 )
+        , _data( team.team_scratch( 0 ), max_neighbor )
+        , _index( team.team_scratch( 0 ), max_neighbor )
+    {
+    }
+
+    /*!
+      \brief Cooperatively compute the neighbor geometry of a particle. A
+      team barrier is needed before the cache is read.
+
+      \param team The team member.
+
+      \param list The neighbor list.
+
+      \param positions The particle positions.
+
+      \param i The particle index.
+    */
+    template <class TeamMember, class NeighborListType>
+    KOKKOS_INLINE_FUNCTION void load( const TeamMember& team,
+                                      const NeighborListType& list,
+                                      const PositionSlice& positions,
+                                      const int i )
+    {
+        using neighbor_list_traits = NeighborList<NeighborListType>;
+        _size = neighbor_list_traits::numNeighbor( list, i );
+        Kokkos::parallel_for(
+            Kokkos::TeamThreadRange( team, _size ), [&]( const int n ) {
+                const int j = neighbor_list_traits::getNeighbor( list, i, n );
+                value_type rsqr = 0.0;
+                for ( int d = 0; d < 3; ++d )
+                {
+                    _data( n, d ) = positions( j, d ) - positions( i, d );
+                    rsqr += _data( n, d ) * _data( n, d );
+                }
+                _data( n, 3 ) = std::sqrt( rsqr );
+                _index( n ) = j;
+            } );
+    }
+
+    //! Get the number of neighbors in the cache.
+    KOKKOS_INLINE_FUNCTION
+    int size() const { return _size; }
+
+    //! Get the particle index of a cached neighbor.
+    KOKKOS_FORCEINLINE_FUNCTION
+    int neighbor( const int n ) const { return _index( n ); }
+
+    //! Get a component of the displacement from the particle to a neighbor.
+    KOKKOS_FORCEINLINE_FUNCTION
+    value_type displacement( const int n, const int d ) const
+    {
+        return _data( n, d );
+    }
+
+    //! Get the distance from the particle to a neighbor.
+    KOKKOS_FORCEINLINE_FUNCTION
+    value_type distance( const int n ) const { return _data( n, 3 ); }
+
+  private:
+    int _size;
+    view_type _data;
+    index_view_type _index;
+};
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_SCRATCHSLICE_HPP
@@ -0,0 +1,278 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_SimdBatch.hpp
+  \brief Fixed-width value batches over the inner arrays of a slice
+*/
+#ifndef CABANA_SIMDBATCH_HPP
+#define CABANA_SIMDBATCH_HPP
+
+#include <Cabana_Slice.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <type_traits>
+
+namespace Cabana
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief A batch of values, one per array element of a struct.
+
+  \tparam T The value type.
+
+  \tparam N The number of values in the batch. This is the vector length of
+  the slices the batch is loaded from.
+
+  All operations are fixed-width elementwise loops over contiguous storage
+  such that the compiler maps them directly to SIMD instructions.
+*/
+template <class T, int N>
+struct SimdBatch
+{
+    //! Value type.
+    using value_type = T;
+
+    //! Number of values in the batch.
+    static constexpr int size = N;
+
+    //! Batch values.
+    T v[N];
+
+    //! Default constructor. Values are uninitialized.
+    SimdBatch() = default;
+
+    //! Broadcast a value to all elements.
+    KOKKOS_FORCEINLINE_FUNCTION
+    SimdBatch( const T value )
+    {
+        for ( int n = 0; n < N; ++n )
+            v[n] = value;
+    }
+
+    //! Element access.
+    KOKKOS_FORCEINLINE_FUNCTION
+    T& operator[]( const int n ) { return v[n]; }
+
+    //! Element access.
+    KOKKOS_FORCEINLINE_FUNCTION
+    const T& operator[]( const int n ) const { return v[n]; }
+
+    //! Elementwise addition.
+    KOKKOS_FORCEINLINE_FUNCTION
+    SimdBatch& operator+=( const SimdBatch& rhs )
+    {
+        for ( int n = 0; n < N; ++n )
+            v[n] += rhs.v[n];
+        return *this;
+    }
+
+    //! Elementwise subtraction.
+    KOKKOS_FORCEINLINE_FUNCTION
+    SimdBatch& operator-=( const SimdBatch& rhs )
+    {
+        for ( int n = 0; n < N; ++n )
+            v[n] -= rhs.v[n];
+        return *this;
+    }
+
+    //! Elementwise multiplication.
+    KOKKOS_FORCEINLINE_FUNCTION
+    SimdBatch& operator*=( const SimdBatch& rhs )
+    {
+        for ( int n = 0; n < N; ++n )
+            v[n] *= rhs.v[n];
+        return *this;
+    }
+
+    //! Elementwise division.
+    KOKKOS_FORCEINLINE_FUNCTION
+    SimdBatch& operator/=( const SimdBatch& rhs )
+    {
+        for ( int n = 0; n < N; ++n )
+            v[n] /= rhs.v[n];
+        return *this;
+    }
+};
+
+//---------------------------------------------------------------------------//
+//! \cond Impl
+template <class T, int N>
+KOKKOS_FORCEINLINE_FUNCTION SimdBatch<T, N>
+operator+( SimdBatch<T, N> lhs, const SimdBatch<T, N>& rhs )
+{
+    return lhs += rhs;
+}
+
+template <class T, int N>
+KOKKOS_FORCEINLINE_FUNCTION SimdBatch<T, N>
+operator-( SimdBatch<T, N> lhs, const SimdBatch<T, N>& rhs )
+{
+    return lhs -= rhs;
+}
+
+template <class T, int N>
+KOKKOS_FORCEINLINE_FUNCTION SimdBatch<T, N>
+operator*( SimdBatch<T, N> lhs, const SimdBatch<T, N>& rhs )
+{
+    return lhs *= rhs;
+}
+
+template <class T, int N>
+KOKKOS_FORCEINLINE_FUNCTION SimdBatch<T, N>
+operator/( SimdBatch<T, N> lhs, const SimdBatch<T, N>& rhs )
+{
+    return lhs /= rhs;
+}
+
+template <class T, int N>
+KOKKOS_FORCEINLINE_FUNCTION SimdBatch<T, N>
+operator+( SimdBatch<T, N> lhs, const T rhs )
+{
+    return lhs += SimdBatch<T, N>( rhs );
+}
+
+template <class T, int N>
+KOKKOS_FORCEINLINE_FUNCTION SimdBatch<T, N>
+operator+( const T lhs, const SimdBatch<T, N>& rhs )
+{
+    return SimdBatch<T, N>( lhs ) += rhs;
+}
+
+template <class T, int N>
+KOKKOS_FORCEINLINE_FUNCTION SimdBatch<T, N>
+operator-( SimdBatch<T, N> lhs, const T rhs )
+{
+    return lhs -= SimdBatch<T, N>( rhs );
+}
+
+template <class T, int N>
+KOKKOS_FORCEINLINE_FUNCTION SimdBatch<T, N>
+operator-( const T lhs, const SimdBatch<T, N>& rhs )
+{
+    return SimdBatch<T, N>( lhs ) -= rhs;
+}
+
+template <class T, int N>
+KOKKOS_FORCEINLINE_FUNCTION SimdBatch<T, N>
+operator*( SimdBatch<T, N> lhs, const T rhs )
+{
+    return lhs *= SimdBatch<T, N>( rhs );
+}
+
+template <class T, int N>
+KOKKOS_FORCEINLINE_FUNCTION SimdBatch<T, N>
+operator*( const T lhs, const SimdBatch<T, N>& rhs )
+{
+    return SimdBatch<T, N>( lhs ) *= rhs;
+}
+
+template <class T, int N>
+KOKKOS_FORCEINLINE_FUNCTION SimdBatch<T, N>
+operator/( SimdBatch<T, N> lhs, const T rhs )
+{
+    return lhs /= SimdBatch<T, N>( rhs );
+}
+
+template <class T, int N>
+KOKKOS_FORCEINLINE_FUNCTION SimdBatch<T, N>
+operator/( const T lhs, const SimdBatch<T, N>& rhs )
+{
+    return SimdBatch<T, N>( lhs ) /= rhs;
+}
+
+template <class T, int N>
+KOKKOS_FORCEINLINE_FUNCTION SimdBatch<T, N>
+operator-( const SimdBatch<T, N>& rhs )
+{
+    SimdBatch<T, N> result;
+    for ( int n = 0; n < N; ++n )
+        result.v[n] = -rhs.v[n];
+    return result;
+}
+//! \endcond
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Load the batch of a slice component over all array elements of a
+  struct.
+
+  \param slice The slice to load from.
+
+  \param s The struct index.
+
+  \param d The component indices of the slice member, if any.
+
+  \return The batch holding the component for every array element of the
+  struct. Elements beyond the slice size are loaded from padding and are
+  unspecified.
+*/
+template <class SliceType, class... Indices>
+KOKKOS_FORCEINLINE_FUNCTION
+    SimdBatch<typename SliceType::value_type, SliceType::vector_length>
+    loadBatch( const SliceType& slice, const std::size_t s,
+               const Indices... d )
+{
+    static_assert( is_slice<SliceType>::value, "loadBatch requires a slice" );
+    SimdBatch<typename SliceType::value_type, SliceType::vector_length> batch;
+    const auto* ptr = &slice.access( s, 0, d... );
+    for ( int n = 0; n < SliceType::vector_length; ++n )
+        batch.v[n] = ptr[n];
+    return batch;
+}
+
+/*!
+  \brief Store a batch into a slice component over a range of array elements
+  of a struct.
+
+  \param slice The slice to store into.
+
+  \param s The struct index.
+
+  \param a_begin The first array element to store.
+
+  \param a_end One past the last array element to store.
+
+  \param batch The batch to store.
+
+  \param d The component indices of the slice member, if any.
+
+  Storing the full array range vectorizes without masking. Array elements
+  outside the given range are not modified.
+*/
+template <class SliceType, class... Indices>
+KOKKOS_FORCEINLINE_FUNCTION void storeBatch(
+    const SliceType& slice, const std::size_t s, const int a_begin,
+    const int a_end,
+    const SimdBatch<typename SliceType::value_type, SliceType::vector_length>&
+        batch,
+    const Indices... d )
+{
+    static_assert( is_slice<SliceType>::value, "storeBatch requires a slice" );
+    auto* ptr = &slice.access( s, 0, d... );
+    if ( a_begin == 0 && a_end == SliceType::vector_length )
+    {
+        for ( int n = 0; n < SliceType::vector_length; ++n )
+            ptr[n] = batch.v[n];
+    }
+    else
+    {
+        for ( int n = a_begin; n < a_end; ++n )
+            ptr[n] = batch.v[n];
+    }
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_SIMDBATCH_HPP
@@ -857,6 +857,71 @@ struct is_slice : public is_slice_impl<typename std::remove_cv<T>::type>::type
 {
 };
 
+//---------------------------------------------------------------------------//
+//! \cond Impl
+namespace Impl
+{
+// Runtime-extent data type of the given rank.
+template <class T, std::size_t Rank>
+struct StridedViewDataType
+{
+    using type = typename StridedViewDataType<T*, Rank - 1>::type;
+};
+
+template <class T>
+struct StridedViewDataType<T, 0>
+{
+    using type = T;
+};
+} // end namespace Impl
+//! \endcond
+
+/*!
+  \brief Standard Kokkos view type of the raw data of a slice.
+*/
+template <class SliceType>
+using slice_strided_view_type = Kokkos::View<
+    typename Impl::StridedViewDataType<
+        typename SliceType::value_type,
+        SliceType::kokkos_view::Rank>::type,
+    Kokkos::LayoutStride, typename SliceType::device_type,
+    Kokkos::MemoryUnmanaged>;
+
+/*!
+  \brief Create a standard Kokkos view of the raw data of a slice without
+  copying it.
+
+  \param slice The slice to view.
+
+  \return An unmanaged view with LayoutStride indexed by the struct index,
+  the array index, and then the member dimensions, e.g. view(s, a, d) for a
+  vector member. The extent of the struct dimension is the number of structs
+  and the extent of the array dimension is the vector length. The stride of
+  the struct dimension is the stride between the structs of the AoSoA in
+  values, which includes the other members. Array elements of the last
+  struct beyond the slice size are padding.
+
+  The view shares the memory of the slice and so is only valid while the
+  AoSoA is not resized or deallocated.
+*/
+template <class SliceType>
+slice_strided_view_type<SliceType> stridedView( const SliceType& slice )
+{
+    static_assert( is_slice<SliceType>::value, "stridedView requires a slice" );
+    std::size_t n[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+    std::size_t stride[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+    for ( std::size_t d = 0; d < slice.rank(); ++d )
+    {
+        n[d] = slice.extent( d );
+        stride[d] = slice.stride( d );
+    }
+    Kokkos::LayoutStride layout( n[0], stride[0], n[1], stride[1], n[2],
+                                 stride[2], n[3], stride[3], n[4], stride[4],
+                                 n[5], stride[5], n[6], stride[6], n[7],
+                                 stride[7] );
+    return slice_strided_view_type<SliceType>( slice.data(), layout );
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Cabana
@@ -0,0 +1,251 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_SliceBundle.hpp
+  \brief Compile-time bundles of named AoSoA members for kernel capture
+*/
+#ifndef CABANA_SLICEBUNDLE_HPP
+#define CABANA_SLICEBUNDLE_HPP
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_SoA.hpp>
+#include <impl/Cabana_Index.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+namespace Cabana
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief Name an AoSoA member with a tag type.
+
+  \tparam Tag The tag type naming the member, e.g. an empty struct Position.
+  \tparam M The index of the member in the AoSoA member types.
+*/
+template <class Tag, std::size_t M>
+struct NamedMember
+{
+    //! Tag type.
+    using tag = Tag;
+
+    //! Member index.
+    static constexpr std::size_t index = M;
+};
+
+//! \cond Impl
+namespace Impl
+{
+template <class Tag, class... NamedMembers>
+struct NamedMemberIndex;
+
+template <class Tag>
+struct NamedMemberIndex<Tag>
+{
+    static_assert( !std::is_same<Tag, Tag>::value,
+                   "Member tag is not part of the slice bundle" );
+};
+
+template <class Tag, class First, class... Rest>
+struct NamedMemberIndex<Tag, First, Rest...>
+    : std::conditional<
+          std::is_same<Tag, typename First::tag>::value,
+          std::integral_constant<std::size_t, First::index>,
+          NamedMemberIndex<Tag, Rest...>>::type
+{
+};
+} // end namespace Impl
+//! \endcond
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Named members of an AoSoA captured as a single pointer.
+
+  \tparam AoSoA_t The AoSoA type.
+  \tparam NamedMembers The NamedMember types of the bundled members.
+
+  A kernel using many members of an AoSoA would otherwise capture one Slice
+  per member, each with its own pointer, size, and strides. The bundle
+  instead holds the pointer to the SoA array and the number of tuples. The
+  location of a member within an SoA is fixed by the SoA type, so every
+  member access is the SoA base address plus a compile-time offset. Members
+  are accessed by tag:
+
+  \code
+  struct Position {};
+  struct Velocity {};
+  auto bundle = Cabana::makeSliceBundle<Cabana::NamedMember<Position, 0>,
+                                        Cabana::NamedMember<Velocity, 1>>(
+      aosoa );
+  ...
+  bundle.get<Position>( i, d ) += dt * bundle.get<Velocity>( i, d );
+  \endcode
+
+  Like a Slice, the bundle does not own the data and is invalidated by
+  resizing the AoSoA.
+*/
+template <class AoSoA_t, class... NamedMembers>
+class SliceBundle
+{
+  public:
+    static_assert( is_aosoa<AoSoA_t>::value,
+                   "SliceBundle only for AoSoA objects" );
+
+    //! AoSoA type.
+    using aosoa_type = AoSoA_t;
+
+    //! SoA type.
+    using soa_type = typename AoSoA_t::soa_type;
+
+    //! Memory space.
+    using memory_space = typename AoSoA_t::memory_space;
+
+    //! Execution space.
+    using execution_space = typename AoSoA_t::execution_space;
+
+    //! Size type.
+    using size_type = typename AoSoA_t::size_type;
+
+    //! Index type.
+    using index_type = typename AoSoA_t::index_type;
+
+    //! Vector length.
+    static constexpr int vector_length = AoSoA_t::vector_length;
+
+    //! Number of bundled members.
+    static constexpr std::size_t number_of_members = sizeof...( NamedMembers );
+
+    //! Index of the member with the given tag.
+    template <class Tag>
+    using member_index = Impl::NamedMemberIndex<Tag, NamedMembers...>;
+
+    //! Reference type of the member with the given tag.
+    template <class Tag>
+    using reference_type = typename soa_type::template member_reference_type<
+        member_index<Tag>::value>;
+
+    //! Default constructor.
+    SliceBundle()
+        : _data( nullptr )
+        , _size( 0 )
+    {
+    }
+
+    //! Create a bundle of the members of an AoSoA.
+    SliceBundle( const AoSoA_t& aosoa )
+        : _data( aosoa.data() )
+        , _size( aosoa.size() )
+    {
+    }
+
+    //! Get the number of tuples.
+    KOKKOS_FORCEINLINE_FUNCTION
+    size_type size() const { return _size; }
+
+    //! Get the number of SoAs.
+    KOKKOS_FORCEINLINE_FUNCTION
+    size_type numSoA() const
+    {
+        return ( _size + vector_length - 1 ) / vector_length;
+    }
+
+    /*!
+      \brief Access a member of a tuple.
+
+      \tparam Tag The tag of the member.
+
+      \param i The tuple index.
+
+      \param indices The indices of the member dimensions, if any.
+    */
+    template <class Tag, class... Indices>
+    KOKKOS_FORCEINLINE_FUNCTION reference_type<Tag>
+    get( const size_type i, const Indices... indices ) const
+    {
+        return Cabana::get<member_index<Tag>::value>(
+            _data[index_type::s( i )], index_type::a( i ), indices... );
+    }
+
+    /*!
+      \brief Access a member of a tuple by its SoA and array indices, e.g.
+      in a simd_parallel_for() kernel.
+
+      \tparam Tag The tag of the member.
+
+      \param s The SoA index.
+
+      \param a The array index within the SoA.
+
+      \param indices The indices of the member dimensions, if any.
+    */
+    template <class Tag, class... Indices>
+    KOKKOS_FORCEINLINE_FUNCTION reference_type<Tag>
+    access( const size_type s, const size_type a,
+            const Indices... indices ) const
+    {
+        return Cabana::get<member_index<Tag>::value>( _data[s], a,
+                                                      indices... );
+    }
+
+    //! Get the SoA array.
+    KOKKOS_FORCEINLINE_FUNCTION
+    soa_type* data() const { return _data; }
+
+  private:
+    soa_type* _data;
+    size_type _size;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create a bundle of named members of an AoSoA.
+
+  \tparam NamedMembers The NamedMember types of the bundled members.
+
+  \param aosoa The AoSoA.
+
+  \return The slice bundle.
+*/
+template <class... NamedMembers, class AoSoA_t>
+SliceBundle<AoSoA_t, NamedMembers...> makeSliceBundle( const AoSoA_t& aosoa )
+{
+    return SliceBundle<AoSoA_t, NamedMembers...>( aosoa );
+}
+
+//---------------------------------------------------------------------------//
+//! \cond Impl
+template <class>
+struct is_slice_bundle_impl : public std::false_type
+{
+};
+
+template <class AoSoA_t, class... NamedMembers>
+struct is_slice_bundle_impl<SliceBundle<AoSoA_t, NamedMembers...>>
+    : public std::true_type
+{
+};
+//! \endcond
+
+//! SliceBundle static type checker.
+template <class T>
+struct is_slice_bundle
+    : public is_slice_bundle_impl<typename std::remove_cv<T>::type>::type
+{
+};
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_SLICEBUNDLE_HPP
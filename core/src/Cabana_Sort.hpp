@@ -19,11 +19,17 @@
 #include <Cabana_AoSoA.hpp>
 #include <Cabana_DeepCopy.hpp>
 #include <Cabana_Slice.hpp>
+#include <impl/Cabana_Profiling.hpp>
 
 #include <Kokkos_Core.hpp>
 #include <Kokkos_Sort.hpp>
 
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
 #include <type_traits>
+#include <utility>
 
 namespace Cabana
 {
@@ -157,15 +163,29 @@ namespace Impl
 //---------------------------------------------------------------------------//
 //! Create a permutation vector over a range subset using a comparator over the
 //! given Kokkos View of keys.
-template <class KeyViewType, class Comparator,
+template <class ExecutionSpace, class KeyViewType, class Comparator,
           class DeviceType = typename KeyViewType::device_type>
 BinningData<DeviceType>
-kokkosBinSort( KeyViewType keys, Comparator comp, const bool sort_within_bins,
+kokkosBinSort( const ExecutionSpace& exec_space, KeyViewType keys,
+               Comparator comp, const bool sort_within_bins,
                const std::size_t begin, const std::size_t end )
 {
+    Impl::ScopedProfileRegion region( ( sort_within_bins )
+                                          ? "Cabana::sortByKey"
+                                          : "Cabana::binByKey" );
+
+#if KOKKOS_VERSION >= 40100
+    Kokkos::BinSort<KeyViewType, Comparator, DeviceType> bin_sort(
+        exec_space, keys, begin, end, comp, sort_within_bins );
+    bin_sort.create_permute_vector( exec_space );
+#else
+    // Older versions of BinSort only run on the default instance.
+    exec_space.fence();
     Kokkos::BinSort<KeyViewType, Comparator, DeviceType> bin_sort(
         keys, begin, end, comp, sort_within_bins );
     bin_sort.create_permute_vector();
+    typename DeviceType::execution_space().fence();
+#endif
     return BinningData<DeviceType>( begin, end, bin_sort.get_bin_count(),
                                     bin_sort.get_bin_offsets(),
                                     bin_sort.get_permute_vector() );
@@ -173,66 +193,448 @@ kokkosBinSort( KeyViewType keys, Comparator comp, const bool sort_within_bins,
 
 //---------------------------------------------------------------------------//
 //! Given a set of keys, find the minimum and maximum over the given range.
-template <class KeyViewType,
-          class DeviceType = typename KeyViewType::device_type>
+template <class ExecutionSpace, class KeyViewType>
 Kokkos::MinMaxScalar<typename KeyViewType::non_const_value_type>
-keyMinMax( KeyViewType keys, const std::size_t begin, const std::size_t end )
+keyMinMax( const ExecutionSpace& exec_space, KeyViewType keys,
+           const std::size_t begin, const std::size_t end )
 {
     Kokkos::MinMaxScalar<typename KeyViewType::non_const_value_type> result;
     Kokkos::MinMax<typename KeyViewType::non_const_value_type> reducer(
         result );
     Kokkos::parallel_reduce(
         "Cabana::keyMinMax",
-        Kokkos::RangePolicy<typename DeviceType::execution_space>( begin, end ),
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, begin, end ),
         Kokkos::Impl::min_max_functor<KeyViewType>( keys ), reducer );
-    Kokkos::fence();
+    exec_space.fence();
     return result;
 }
 
 //---------------------------------------------------------------------------//
 //! Sort an AoSoA over a subset of its range using the given Kokkos View of
 //! keys.
-template <class KeyViewType,
+template <class ExecutionSpace, class KeyViewType,
           class DeviceType = typename KeyViewType::device_type>
 BinningData<DeviceType>
-kokkosBinSort1d( KeyViewType keys, const int nbin, const bool sort_within_bins,
+kokkosBinSort1d( const ExecutionSpace& exec_space, KeyViewType keys,
+                 const int nbin, const bool sort_within_bins,
                  const std::size_t begin, const std::size_t end )
 {
     // Find the minimum and maximum key values.
-    auto key_bounds =
-        Impl::keyMinMax<KeyViewType, DeviceType>( keys, begin, end );
+    auto key_bounds = Impl::keyMinMax( exec_space, keys, begin, end );
 
     // Create a sorting comparator.
     Kokkos::BinOp1D<KeyViewType> comp( nbin, key_bounds.min_val,
                                        key_bounds.max_val );
 
     // BinSort
-    return kokkosBinSort<KeyViewType, decltype( comp ), DeviceType>(
-        keys, comp, sort_within_bins, begin, end );
+    return kokkosBinSort<ExecutionSpace, KeyViewType, decltype( comp ),
+                         DeviceType>( exec_space, keys, comp,
+                                      sort_within_bins, begin, end );
+}
+
+//---------------------------------------------------------------------------//
+//! Given binning data find the bin containing a local tuple id in the binned
+//! layout. The largest bin starting at or before the tuple is selected such
+//! that empty bins are skipped.
+template <class BinningDataType>
+KOKKOS_INLINE_FUNCTION int
+binOfTuple( const BinningDataType& bin_data,
+            const typename BinningDataType::size_type tuple_id )
+{
+    int lo = 0;
+    int hi = bin_data.numBin() - 1;
+    while ( lo < hi )
+    {
+        int mid = ( lo + hi + 1 ) / 2;
+        if ( bin_data.binOffset( mid ) <= tuple_id )
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+    return lo;
+}
+
+//---------------------------------------------------------------------------//
+//! Incrementally rebin from previous binning data using a comparator over the
+//! given Kokkos View of keys. Tuples that stay in their bin keep their
+//! relative order and tuples that changed bins are appended to their new bin.
+template <class ExecutionSpace, class KeyViewType, class Comparator,
+          class DeviceType>
+BinningData<DeviceType>
+kokkosRebin( const ExecutionSpace& exec_space,
+             const BinningData<DeviceType>& previous, KeyViewType keys,
+             Comparator comp, const bool previous_applied )
+{
+    using size_type = typename BinningData<DeviceType>::size_type;
+
+    auto begin = previous.rangeBegin();
+    auto end = previous.rangeEnd();
+    std::size_t num_tuple = end - begin;
+    int nbin = previous.numBin();
+
+    if ( comp.max_bins() != nbin )
+        throw std::runtime_error(
+            "Comparator bin count does not match previous binning" );
+
+    // Find the old and new bin of every tuple and update the bin counts of
+    // the tuples that moved.
+    Kokkos::View<int*, DeviceType> old_bin(
+        Kokkos::ViewAllocateWithoutInitializing( "old_bin" ), num_tuple );
+    Kokkos::View<int*, DeviceType> new_bin(
+        Kokkos::ViewAllocateWithoutInitializing( "new_bin" ), num_tuple );
+    Kokkos::View<int*, DeviceType> counts(
+        Kokkos::ViewAllocateWithoutInitializing( "bin_count" ), nbin );
+    Kokkos::parallel_for(
+        "Cabana::kokkosRebin::copy_counts",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, nbin ),
+        KOKKOS_LAMBDA( const int b ) { counts( b ) = previous.binSize( b ); } );
+    Kokkos::parallel_for(
+        "Cabana::kokkosRebin::find_movers",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_tuple ),
+        KOKKOS_LAMBDA( const size_type i ) {
+            size_type pid =
+                previous_applied ? i + begin : previous.permutation( i );
+            int ob = binOfTuple( previous, i );
+            int nb = comp.bin( keys, pid );
+            old_bin( i ) = ob;
+            new_bin( i ) = nb;
+            if ( nb != ob )
+            {
+                Kokkos::atomic_add( &counts( ob ), -1 );
+                Kokkos::atomic_add( &counts( nb ), 1 );
+            }
+        } );
+    exec_space.fence();
+
+    // Rank the tuples that stay in their bin.
+    Kokkos::View<size_type*, DeviceType> stay_rank(
+        Kokkos::ViewAllocateWithoutInitializing( "stay_rank" ),
+        num_tuple + 1 );
+    Kokkos::parallel_scan(
+        "Cabana::kokkosRebin::rank_stayers",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_tuple + 1 ),
+        KOKKOS_LAMBDA( const size_type i, size_type& update,
+                       const bool final_pass ) {
+            if ( final_pass )
+                stay_rank( i ) = update;
+            if ( i < num_tuple && old_bin( i ) == new_bin( i ) )
+                ++update;
+        } );
+    exec_space.fence();
+
+    // Compute the new bin offsets.
+    Kokkos::View<size_type*, DeviceType> offsets(
+        Kokkos::ViewAllocateWithoutInitializing( "bin_offsets" ), nbin );
+    Kokkos::parallel_scan(
+        "Cabana::kokkosRebin::offset_scan",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, nbin ),
+        KOKKOS_LAMBDA( const int b, size_type& update,
+                       const bool final_pass ) {
+            if ( final_pass )
+                offsets( b ) = update;
+            update += counts( b );
+        } );
+    exec_space.fence();
+
+    // Keep the stayers in order at the front of each bin and append the
+    // movers behind them.
+    Kokkos::View<int*, DeviceType> fill( "bin_fill", nbin );
+    Kokkos::View<size_type*, DeviceType> permute_vector(
+        Kokkos::ViewAllocateWithoutInitializing( "permute_vector" ),
+        num_tuple );
+    Kokkos::parallel_for(
+        "Cabana::kokkosRebin::fill_permutation",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_tuple ),
+        KOKKOS_LAMBDA( const size_type i ) {
+            size_type pid =
+                previous_applied ? i + begin : previous.permutation( i );
+            int ob = old_bin( i );
+            int nb = new_bin( i );
+            if ( nb == ob )
+            {
+                permute_vector(
+                    offsets( ob ) + stay_rank( i ) -
+                    stay_rank( previous.binOffset( ob ) ) ) = pid;
+            }
+            else
+            {
+                size_type first = previous.binOffset( nb );
+                size_type num_stay =
+                    stay_rank( first + previous.binSize( nb ) ) -
+                    stay_rank( first );
+                permute_vector( offsets( nb ) + num_stay +
+                                Kokkos::atomic_fetch_add( &fill( nb ), 1 ) ) =
+                    pid;
+            }
+        } );
+    exec_space.fence();
+
+    return BinningData<DeviceType>( begin, end, counts, offsets,
+                                    permute_vector );
 }
 
 //---------------------------------------------------------------------------//
 //! Copy the a 1D slice into a Kokkos view.
-template <class SliceType, class DeviceType = typename SliceType::device_type>
+template <class ExecutionSpace, class SliceType,
+          class DeviceType = typename SliceType::device_type>
 Kokkos::View<typename SliceType::value_type*, typename SliceType::device_type>
-copySliceToKeys( SliceType slice )
+copySliceToKeys( const ExecutionSpace& exec_space, SliceType slice )
 {
     using KeyViewType =
         Kokkos::View<typename SliceType::value_type*, DeviceType>;
     KeyViewType keys( Kokkos::ViewAllocateWithoutInitializing( "slice_keys" ),
                       slice.size() );
-    Kokkos::RangePolicy<typename DeviceType::execution_space> exec_policy(
-        0, slice.size() );
+    Kokkos::RangePolicy<ExecutionSpace> exec_policy( exec_space, 0,
+                                                     slice.size() );
     auto copy_op = KOKKOS_LAMBDA( const std::size_t i )
     {
         keys( i ) = slice( i );
     };
     Kokkos::parallel_for( "Cabana::copySliceToKeys::copy_op", exec_policy,
                           copy_op );
-    Kokkos::fence();
+    exec_space.fence();
     return keys;
 }
 
+//---------------------------------------------------------------------------//
+//! Get the permutation vector of a range of integer keys from a stable least
+//! significant digit radix sort.
+template <class ExecutionSpace, class KeyViewType, class DeviceType>
+Kokkos::View<typename DeviceType::memory_space::size_type*, DeviceType>
+radixPermutation( const ExecutionSpace& exec_space, KeyViewType keys,
+                  const std::size_t begin, const std::size_t end )
+{
+    using size_type = typename DeviceType::memory_space::size_type;
+    using key_type = typename KeyViewType::non_const_value_type;
+    static_assert( std::is_integral<key_type>::value,
+                   "Radix sort requires integer keys" );
+
+    std::size_t num_key = end - begin;
+
+    // Sort the key differences to the minimum key as unsigned digits and
+    // only sort the digits that are used.
+    std::uint64_t min_key = 0;
+    int num_pass = 0;
+    if ( num_key > 0 )
+    {
+        auto key_bounds = Impl::keyMinMax( exec_space, keys, begin, end );
+        min_key = static_cast<std::uint64_t>( key_bounds.min_val );
+        std::uint64_t key_range =
+            static_cast<std::uint64_t>( key_bounds.max_val ) - min_key;
+        while ( num_pass < 8 && ( key_range >> ( 8 * num_pass ) ) != 0 )
+            ++num_pass;
+    }
+
+    Kokkos::View<std::uint64_t*, DeviceType> digits(
+        Kokkos::ViewAllocateWithoutInitializing( "radix_digits" ), num_key );
+    Kokkos::View<std::uint64_t*, DeviceType> sorted_digits(
+        Kokkos::ViewAllocateWithoutInitializing( "radix_sorted_digits" ),
+        num_key );
+    Kokkos::View<size_type*, DeviceType> permute_vector(
+        Kokkos::ViewAllocateWithoutInitializing( "permute_vector" ), num_key );
+    Kokkos::View<size_type*, DeviceType> sorted_permute_vector(
+        Kokkos::ViewAllocateWithoutInitializing( "sorted_permute_vector" ),
+        num_key );
+    auto init_op = KOKKOS_LAMBDA( const std::size_t i )
+    {
+        digits( i ) = static_cast<std::uint64_t>( keys( i + begin ) ) - min_key;
+        permute_vector( i ) = i + begin;
+    };
+    Kokkos::parallel_for(
+        "Cabana::radixSort::init",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_key ),
+        init_op );
+
+    // Each block of keys is histogrammed and scattered by a single thread
+    // such that the sort is stable. Blocks hold at least as many keys as
+    // there are digit values to bound the histogram size.
+    const int num_digit = 256;
+    std::size_t num_block = exec_space.concurrency();
+    std::size_t max_block = ( num_key + num_digit - 1 ) / num_digit;
+    num_block = ( num_block < max_block ) ? num_block : max_block;
+    num_block = ( num_block > 0 ) ? num_block : 1;
+    std::size_t block_size = ( num_key + num_block - 1 ) / num_block;
+    Kokkos::View<size_type*, DeviceType> histogram(
+        Kokkos::ViewAllocateWithoutInitializing( "radix_histogram" ),
+        num_digit * num_block );
+    Kokkos::RangePolicy<ExecutionSpace> block_policy( exec_space, 0,
+                                                      num_block );
+
+    for ( int pass = 0; pass < num_pass; ++pass )
+    {
+        const int shift = 8 * pass;
+
+        // Count the digits of each block in digit-major order.
+        Kokkos::deep_copy( exec_space, histogram, 0 );
+        auto count_op = KOKKOS_LAMBDA( const std::size_t b )
+        {
+            std::size_t block_end = ( b + 1 ) * block_size;
+            block_end = ( block_end < num_key ) ? block_end : num_key;
+            for ( std::size_t i = b * block_size; i < block_end; ++i )
+                ++histogram( ( ( digits( i ) >> shift ) & 0xff ) * num_block +
+                             b );
+        };
+        Kokkos::parallel_for( "Cabana::radixSort::count", block_policy,
+                              count_op );
+
+        // Compute the output offset of each digit in each block.
+        auto offset_scan = KOKKOS_LAMBDA( const std::size_t i,
+                                          size_type& update,
+                                          const bool final_pass )
+        {
+            size_type count = histogram( i );
+            if ( final_pass )
+                histogram( i ) = update;
+            update += count;
+        };
+        Kokkos::parallel_scan(
+            "Cabana::radixSort::offset_scan",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                                 histogram.size() ),
+            offset_scan );
+
+        // Scatter the keys in order within each block.
+        auto scatter_op = KOKKOS_LAMBDA( const std::size_t b )
+        {
+            std::size_t block_end = ( b + 1 ) * block_size;
+            block_end = ( block_end < num_key ) ? block_end : num_key;
+            for ( std::size_t i = b * block_size; i < block_end; ++i )
+            {
+                size_type& offset = histogram(
+                    ( ( digits( i ) >> shift ) & 0xff ) * num_block + b );
+                sorted_digits( offset ) = digits( i );
+                sorted_permute_vector( offset ) = permute_vector( i );
+                ++offset;
+            }
+        };
+        Kokkos::parallel_for( "Cabana::radixSort::scatter", block_policy,
+                              scatter_op );
+        exec_space.fence();
+
+        std::swap( digits, sorted_digits );
+        std::swap( permute_vector, sorted_permute_vector );
+    }
+    exec_space.fence();
+    return permute_vector;
+}
+
+//---------------------------------------------------------------------------//
+//! Sort a range of integer keys with a stable least significant digit radix
+//! sort. The returned binning data has a single bin holding the range.
+template <class ExecutionSpace, class KeyViewType,
+          class DeviceType = typename KeyViewType::device_type>
+BinningData<DeviceType> radixSort( const ExecutionSpace& exec_space,
+                                   KeyViewType keys, const std::size_t begin,
+                                   const std::size_t end )
+{
+    Impl::ScopedProfileRegion region( "Cabana::sortByKey" );
+
+    using size_type = typename DeviceType::memory_space::size_type;
+    std::size_t num_key = end - begin;
+    auto permute_vector = radixPermutation<ExecutionSpace, KeyViewType,
+                                           DeviceType>( exec_space, keys,
+                                                        begin, end );
+
+    // The full range is a single bin.
+    Kokkos::View<int*, DeviceType> counts( "counts", 1 );
+    Kokkos::View<size_type*, DeviceType> offsets( "offsets", 1 );
+    Kokkos::deep_copy( exec_space, counts, static_cast<int>( num_key ) );
+    exec_space.fence();
+    return BinningData<DeviceType>( begin, end, counts, offsets,
+                                    permute_vector );
+}
+
+//---------------------------------------------------------------------------//
+//! Sort integer keys with the radix sort.
+template <class ExecutionSpace, class KeyViewType, class DeviceType>
+BinningData<DeviceType>
+sortByKeyImpl( const ExecutionSpace& exec_space, KeyViewType keys,
+               const std::size_t begin, const std::size_t end, std::true_type )
+{
+    return radixSort<ExecutionSpace, KeyViewType, DeviceType>(
+        exec_space, keys, begin, end );
+}
+
+//! Sort other keys with Kokkos BinSort.
+template <class ExecutionSpace, class KeyViewType, class DeviceType>
+BinningData<DeviceType>
+sortByKeyImpl( const ExecutionSpace& exec_space, KeyViewType keys,
+               const std::size_t begin, const std::size_t end,
+               std::false_type )
+{
+    int nbin = ( end - begin ) / 2;
+    return kokkosBinSort1d<ExecutionSpace, KeyViewType, DeviceType>(
+        exec_space, keys, nbin, true, begin, end );
+}
+
+//---------------------------------------------------------------------------//
+//! Spread the lower 21 bits of an integer such that there are two zero bits
+//! between each of them.
+KOKKOS_INLINE_FUNCTION
+std::uint64_t spreadBits3( std::uint64_t x )
+{
+    x &= 0x1fffff;
+    x = ( x | x << 32 ) & 0x1f00000000ffff;
+    x = ( x | x << 16 ) & 0x1f0000ff0000ff;
+    x = ( x | x << 8 ) & 0x100f00f00f00f00f;
+    x = ( x | x << 4 ) & 0x10c30c30c30c30c3;
+    x = ( x | x << 2 ) & 0x1249249249249249;
+    return x;
+}
+
+//---------------------------------------------------------------------------//
+//! Get the 63-bit Morton key of 21-bit integer coordinates.
+KOKKOS_INLINE_FUNCTION
+std::uint64_t mortonKey( const std::uint32_t i, const std::uint32_t j,
+                         const std::uint32_t k )
+{
+    return ( spreadBits3( i ) << 2 ) | ( spreadBits3( j ) << 1 ) |
+           spreadBits3( k );
+}
+
+//---------------------------------------------------------------------------//
+//! Get the 63-bit Hilbert key of 21-bit integer coordinates. The coordinates
+//! are transformed into the transposed Hilbert index (J. Skilling, AIP Conf.
+//! Proc. 707, 2004) and then interleaved.
+KOKKOS_INLINE_FUNCTION
+std::uint64_t hilbertKey( const std::uint32_t i, const std::uint32_t j,
+                          const std::uint32_t k )
+{
+    std::uint32_t x[3] = { i, j, k };
+    const std::uint32_t m = 1u << 20;
+
+    // Inverse undo excess work.
+    for ( std::uint32_t q = m; q > 1; q >>= 1 )
+    {
+        std::uint32_t p = q - 1;
+        for ( int d = 0; d < 3; ++d )
+        {
+            if ( x[d] & q )
+            {
+                x[0] ^= p;
+            }
+            else
+            {
+                std::uint32_t t = ( x[0] ^ x[d] ) & p;
+                x[0] ^= t;
+                x[d] ^= t;
+            }
+        }
+    }
+
+    // Gray encode.
+    x[1] ^= x[0];
+    x[2] ^= x[1];
+    std::uint32_t t = 0;
+    for ( std::uint32_t q = m; q > 1; q >>= 1 )
+        if ( x[2] & q )
+            t ^= q - 1;
+    for ( int d = 0; d < 3; ++d )
+        x[d] ^= t;
+
+    return mortonKey( x[0], x[1], x[2] );
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Impl
@@ -266,9 +668,8 @@ BinningData<DeviceType> sortByKeyWithComparator(
     typename std::enable_if<( Kokkos::is_view<KeyViewType>::value ),
                             int>::type* = 0 )
 {
-    auto bin_data = Impl::kokkosBinSort<KeyViewType, DeviceType>(
-        keys, comp, true, begin, end );
-    return bin_data.permuteVector();
+    return Impl::kokkosBinSort( typename DeviceType::execution_space(), keys,
+                                comp, true, begin, end );
 }
 
 //---------------------------------------------------------------------------//
@@ -295,8 +696,8 @@ BinningData<DeviceType> sortByKeyWithComparator(
     typename std::enable_if<( Kokkos::is_view<KeyViewType>::value ),
                             int>::type* = 0 )
 {
-    Impl::kokkosBinSort<KeyViewType, DeviceType>( keys, comp, true, 0,
-                                                  keys.extent( 0 ) );
+    return Impl::kokkosBinSort( typename DeviceType::execution_space(), keys,
+                                comp, true, 0, keys.extent( 0 ) );
 }
 
 //---------------------------------------------------------------------------//
@@ -328,8 +729,8 @@ BinningData<DeviceType> binByKeyWithComparator(
     typename std::enable_if<( Kokkos::is_view<KeyViewType>::value ),
                             int>::type* = 0 )
 {
-    return Impl::kokkosBinSort<KeyViewType, DeviceType>( keys, comp, false,
-                                                         begin, end );
+    return Impl::kokkosBinSort( typename DeviceType::execution_space(), keys,
+                                comp, false, begin, end );
 }
 
 //---------------------------------------------------------------------------//
@@ -356,8 +757,50 @@ BinningData<DeviceType> binByKeyWithComparator(
     typename std::enable_if<( Kokkos::is_view<KeyViewType>::value ),
                             int>::type* = 0 )
 {
-    return Impl::kokkosBinSort<KeyViewType, DeviceType>( keys, comp, false, 0,
-                                                         keys.extent( 0 ) );
+    return Impl::kokkosBinSort( typename DeviceType::execution_space(), keys,
+                                comp, false, 0, keys.extent( 0 ) );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Incrementally rebin an AoSoA from previous binning data using a
+  general comparator over the given Kokkos View of new keys.
+
+  Only tuples whose bin changed since the previous binning are moved. Tuples
+  that stay in their bin keep their relative order and the tuples that changed
+  bins are appended behind them in their new bin. This replaces a full bin
+  sort with a few linear passes when most tuples keep their bin.
+
+  \tparam KeyViewType The Kokkos::View type for keys.
+
+  \tparam Comparator Kokkos::BinSort compatible comparator type.
+
+  \param previous The previous binning data. The new binning covers the same
+  range.
+
+  \param keys The key values to use for binning, indexed by the current
+  position of each element in the AoSoA.
+
+  \param comp The comparator to use for binning. Must be compatible with
+  Kokkos::BinSort and produce the same number of bins as the previous binning.
+
+  \param previous_applied True if the AoSoA was permuted with the previous
+  binning data, in which case the elements of the range are already in
+  binned order. Otherwise the elements are still in the order the previous
+  binning data was computed for.
+
+  \return The binning data (e.g. bin sizes and offsets).
+*/
+template <class KeyViewType, class Comparator, class DeviceType>
+BinningData<DeviceType> rebinByKeyWithComparator(
+    const BinningData<DeviceType>& previous, KeyViewType keys, Comparator comp,
+    const bool previous_applied = false,
+    typename std::enable_if<( Kokkos::is_view<KeyViewType>::value ),
+                            int>::type* = 0 )
+{
+    Impl::ScopedProfileRegion region( "Cabana::rebinByKey" );
+    return Impl::kokkosRebin( typename DeviceType::execution_space(), previous,
+                              keys, comp, previous_applied );
 }
 
 //---------------------------------------------------------------------------//
@@ -365,6 +808,46 @@ BinningData<DeviceType> binByKeyWithComparator(
   \brief Sort an AoSoA over a subset of its range based on the associated key
   values.
 
+  \tparam ExecutionSpace The execution space type.
+
+  \tparam KeyViewType The Kokkos::View type for keys.
+
+  \param exec_space The execution space instance to sort on.
+
+  \param keys The key values to use for sorting. A key value is needed for
+  every element of the AoSoA.
+
+  \param begin The beginning index of the AoSoA range to sort.
+
+  \param end The end index of the AoSoA range to sort.
+
+  \return The permutation vector associated with the sorting.
+
+  Integer keys are sorted with a radix sort with as many passes as the range
+  of key values needs. Other keys are sorted with Kokkos BinSort. Only the
+  given instance is fenced.
+*/
+template <class ExecutionSpace, class KeyViewType,
+          class DeviceType = typename KeyViewType::device_type>
+BinningData<DeviceType>
+sortByKey( const ExecutionSpace& exec_space, KeyViewType keys,
+           const std::size_t begin, const std::size_t end,
+           typename std::enable_if<
+               ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+                 Kokkos::is_view<KeyViewType>::value ),
+               int>::type* = 0 )
+{
+    using is_integral_key =
+        std::is_integral<typename KeyViewType::non_const_value_type>;
+    return Impl::sortByKeyImpl<ExecutionSpace, KeyViewType, DeviceType>(
+        exec_space, keys, begin, end, is_integral_key() );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Sort an AoSoA over a subset of its range based on the associated key
+  values on the default execution space instance.
+
   \tparam KeyViewType The Kokkos::View type for keys.
 
   \param keys The key values to use for sorting. A key value is needed for
@@ -383,15 +866,44 @@ sortByKey( KeyViewType keys, const std::size_t begin, const std::size_t end,
            typename std::enable_if<( Kokkos::is_view<KeyViewType>::value ),
                                    int>::type* = 0 )
 {
-    int nbin = ( end - begin ) / 2;
-    return Impl::kokkosBinSort1d<KeyViewType, DeviceType>( keys, nbin, true,
-                                                           begin, end );
+    using execution_space = typename DeviceType::execution_space;
+    return sortByKey<execution_space, KeyViewType, DeviceType>(
+        execution_space(), keys, begin, end );
 }
 
 //---------------------------------------------------------------------------//
 /*!
   \brief Sort an entire AoSoA based on the associated key values.
 
+  \tparam ExecutionSpace The execution space type.
+
+  \tparam KeyViewType The Kokkos::View type for keys.
+
+  \param exec_space The execution space instance to sort on.
+
+  \param keys The key values to use for sorting. A key value is needed for
+  every element of the AoSoA.
+
+  \return The permutation vector associated with the sorting.
+*/
+template <class ExecutionSpace, class KeyViewType,
+          class DeviceType = typename KeyViewType::device_type>
+BinningData<DeviceType>
+sortByKey( const ExecutionSpace& exec_space, KeyViewType keys,
+           typename std::enable_if<
+               ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+                 Kokkos::is_view<KeyViewType>::value ),
+               int>::type* = 0 )
+{
+    return sortByKey<ExecutionSpace, KeyViewType, DeviceType>(
+        exec_space, keys, 0, keys.extent( 0 ) );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Sort an entire AoSoA based on the associated key values on the
+  default execution space instance.
+
   \tparam KeyViewType The Kokkos::View type for keys.
 
   \param keys The key values to use for sorting. A key value is needed for
@@ -416,6 +928,43 @@ sortByKey( KeyViewType keys,
   values and number of bins. The bins are evenly divided over the range of key
   values.
 
+  \tparam ExecutionSpace The execution space type.
+
+  \tparam KeyViewType The Kokkos::View type for keys.
+
+  \param exec_space The execution space instance to bin on.
+
+  \param keys The key values to use for binning. A key value is needed for
+  every element of the AoSoA.
+
+  \param nbin The number of bins to use for binning. The range of key values
+  will subdivided equally by the number of bins.
+
+  \param begin The beginning index of the AoSoA range to bin.
+
+  \param end The end index of the AoSoA range to bin.
+
+  \return The binning data (e.g. bin sizes and offsets).
+*/
+template <class ExecutionSpace, class KeyViewType,
+          class DeviceType = typename KeyViewType::device_type>
+BinningData<DeviceType>
+binByKey( const ExecutionSpace& exec_space, KeyViewType keys, const int nbin,
+          const std::size_t begin, const std::size_t end,
+          typename std::enable_if<
+              ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+                Kokkos::is_view<KeyViewType>::value ),
+              int>::type* = 0 )
+{
+    return Impl::kokkosBinSort1d<ExecutionSpace, KeyViewType, DeviceType>(
+        exec_space, keys, nbin, false, begin, end );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Bin an AoSoA over a subset of its range based on the associated key
+  values and number of bins on the default execution space instance.
+
   \tparam KeyViewType The Kokkos::View type for keys.
 
   \param keys The key values to use for binning. A key value is needed for
@@ -438,8 +987,9 @@ binByKey( KeyViewType keys, const int nbin, const std::size_t begin,
           typename std::enable_if<( Kokkos::is_view<KeyViewType>::value ),
                                   int>::type* = 0 )
 {
-    return Impl::kokkosBinSort1d<KeyViewType, DeviceType>( keys, nbin, false,
-                                                           begin, end );
+    using execution_space = typename DeviceType::execution_space;
+    return binByKey<execution_space, KeyViewType, DeviceType>(
+        execution_space(), keys, nbin, begin, end );
 }
 
 //---------------------------------------------------------------------------//
@@ -447,6 +997,38 @@ binByKey( KeyViewType keys, const int nbin, const std::size_t begin,
   \brief Bin an entire AoSoA based on the associated key values and number of
   bins. The bins are evenly divided over the range of key values.
 
+  \tparam ExecutionSpace The execution space type.
+
+  \tparam KeyViewType The Kokkos::View type for keys.
+
+  \param exec_space The execution space instance to bin on.
+
+  \param keys The key values to use for binning. A key value is needed for
+  every element of the AoSoA.
+
+  \param nbin The number of bins to use for binning. The range of key values
+  will subdivided equally by the number of bins.
+
+  \return The binning data (e.g. bin sizes and offsets).
+*/
+template <class ExecutionSpace, class KeyViewType,
+          class DeviceType = typename KeyViewType::device_type>
+BinningData<DeviceType>
+binByKey( const ExecutionSpace& exec_space, KeyViewType keys, const int nbin,
+          typename std::enable_if<
+              ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+                Kokkos::is_view<KeyViewType>::value ),
+              int>::type* = 0 )
+{
+    return binByKey<ExecutionSpace, KeyViewType, DeviceType>(
+        exec_space, keys, nbin, 0, keys.extent( 0 ) );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Bin an entire AoSoA based on the associated key values and number of
+  bins on the default execution space instance.
+
   \tparam KeyViewType The Kokkos::View type for keys.
 
   \param keys The key values to use for binning. A key value is needed for
@@ -464,8 +1046,8 @@ binByKey( KeyViewType keys, const int nbin,
           typename std::enable_if<( Kokkos::is_view<KeyViewType>::value ),
                                   int>::type* = 0 )
 {
-    return Impl::kokkosBinSort1d<KeyViewType, DeviceType>( keys, nbin, false, 0,
-                                                           keys.extent( 0 ) );
+    return binByKey<KeyViewType, DeviceType>( keys, nbin, 0,
+                                              keys.extent( 0 ) );
 }
 
 //---------------------------------------------------------------------------//
@@ -473,6 +1055,41 @@ binByKey( KeyViewType keys, const int nbin,
   \brief Sort an AoSoA over a subset of its range based on the associated
   slice of keys.
 
+  \tparam ExecutionSpace The execution space type.
+
+  \tparam SliceType Slice type for keys.
+
+  \param exec_space The execution space instance to sort on.
+
+  \param slice Slice of keys.
+
+  \param begin The beginning index of the AoSoA range to sort.
+
+  \param end The end index of the AoSoA range to sort.
+
+  \return The permutation vector associated with the sorting.
+*/
+template <class ExecutionSpace, class SliceType,
+          class DeviceType = typename SliceType::device_type>
+BinningData<DeviceType>
+sortByKey( const ExecutionSpace& exec_space, SliceType slice,
+           const std::size_t begin, const std::size_t end,
+           typename std::enable_if<
+               ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+                 is_slice<SliceType>::value ),
+               int>::type* = 0 )
+{
+    auto keys = Impl::copySliceToKeys<ExecutionSpace, SliceType, DeviceType>(
+        exec_space, slice );
+    return sortByKey<ExecutionSpace, decltype( keys ), DeviceType>(
+        exec_space, keys, begin, end );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Sort an AoSoA over a subset of its range based on the associated
+  slice of keys on the default execution space instance.
+
   \tparam SliceType Slice type for keys.
 
   \param slice Slice of keys.
@@ -488,14 +1105,43 @@ BinningData<DeviceType> sortByKey(
     SliceType slice, const std::size_t begin, const std::size_t end,
     typename std::enable_if<( is_slice<SliceType>::value ), int>::type* = 0 )
 {
-    auto keys = Impl::copySliceToKeys<SliceType, DeviceType>( slice );
-    return sortByKey<decltype( keys ), DeviceType>( keys, begin, end );
+    using execution_space = typename DeviceType::execution_space;
+    return sortByKey<execution_space, SliceType, DeviceType>(
+        execution_space(), slice, begin, end );
 }
 
 //---------------------------------------------------------------------------//
 /*!
   \brief Sort an entire AoSoA based on the associated slice of keys.
 
+  \tparam ExecutionSpace The execution space type.
+
+  \tparam SliceType Slice type for keys.
+
+  \param exec_space The execution space instance to sort on.
+
+  \param slice Slice of keys.
+
+  \return The permutation vector associated with the sorting.
+*/
+template <class ExecutionSpace, class SliceType,
+          class DeviceType = typename SliceType::device_type>
+BinningData<DeviceType>
+sortByKey( const ExecutionSpace& exec_space, SliceType slice,
+           typename std::enable_if<
+               ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+                 is_slice<SliceType>::value ),
+               int>::type* = 0 )
+{
+    return sortByKey<ExecutionSpace, SliceType, DeviceType>(
+        exec_space, slice, 0, slice.size() );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Sort an entire AoSoA based on the associated slice of keys on the
+  default execution space instance.
+
   \tparam SliceType Slice type for keys.
 
   \param slice Slice of keys.
@@ -515,6 +1161,44 @@ BinningData<DeviceType> sortByKey(
   \brief Bin an AoSoA over a subset of its range based on the associated
   slice of keys.
 
+  \tparam ExecutionSpace The execution space type.
+
+  \tparam SliceType Slice type for keys
+
+  \param exec_space The execution space instance to bin on.
+
+  \param slice Slice of keys.
+
+  \param nbin The number of bins to use for binning. The range of key values
+  will subdivided equally by the number of bins.
+
+  \param begin The beginning index of the AoSoA range to bin.
+
+  \param end The end index of the AoSoA range to bin.
+
+  \return The binning data (e.g. bin sizes and offsets).
+*/
+template <class ExecutionSpace, class SliceType,
+          class DeviceType = typename SliceType::device_type>
+BinningData<DeviceType>
+binByKey( const ExecutionSpace& exec_space, SliceType slice, const int nbin,
+          const std::size_t begin, const std::size_t end,
+          typename std::enable_if<
+              ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+                is_slice<SliceType>::value ),
+              int>::type* = 0 )
+{
+    auto keys = Impl::copySliceToKeys<ExecutionSpace, SliceType, DeviceType>(
+        exec_space, slice );
+    return binByKey<ExecutionSpace, decltype( keys ), DeviceType>(
+        exec_space, keys, nbin, begin, end );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Bin an AoSoA over a subset of its range based on the associated
+  slice of keys on the default execution space instance.
+
   \tparam SliceType Slice type for keys
 
   \param slice Slice of keys.
@@ -534,14 +1218,46 @@ BinningData<DeviceType> binByKey(
     const std::size_t end,
     typename std::enable_if<( is_slice<SliceType>::value ), int>::type* = 0 )
 {
-    auto keys = Impl::copySliceToKeys<SliceType, DeviceType>( slice );
-    return binByKey<decltype( keys ), DeviceType>( keys, nbin, begin, end );
+    using execution_space = typename DeviceType::execution_space;
+    return binByKey<execution_space, SliceType, DeviceType>(
+        execution_space(), slice, nbin, begin, end );
 }
 
 //---------------------------------------------------------------------------//
 /*!
   \brief Bin an entire AoSoA based on the associated slice of keys.
 
+  \tparam ExecutionSpace The execution space type.
+
+  \tparam SliceType Slice type for keys.
+
+  \param exec_space The execution space instance to bin on.
+
+  \param slice Slice of keys.
+
+  \param nbin The number of bins to use for binning. The range of key values
+  will subdivided equally by the number of bins.
+
+  \return The binning data (e.g. bin sizes and offsets).
+*/
+template <class ExecutionSpace, class SliceType,
+          class DeviceType = typename SliceType::device_type>
+BinningData<DeviceType>
+binByKey( const ExecutionSpace& exec_space, SliceType slice, const int nbin,
+          typename std::enable_if<
+              ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+                is_slice<SliceType>::value ),
+              int>::type* = 0 )
+{
+    return binByKey<ExecutionSpace, SliceType, DeviceType>(
+        exec_space, slice, nbin, 0, slice.size() );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Bin an entire AoSoA based on the associated slice of keys on the
+  default execution space instance.
+
   \tparam SliceType Slice type for keys.
 
   \param slice Slice of keys.
@@ -561,24 +1277,581 @@ BinningData<DeviceType> binByKey(
 
 //---------------------------------------------------------------------------//
 /*!
-  \brief Given binning data permute an AoSoA.
+  \brief Stably bin an AoSoA over a subset of its range by an outer and an
+  inner key, e.g. the cell and then the species of each particle.
 
-  \tparam BinningDataType The binning data type.
+  \tparam ExecutionSpace The execution space type.
 
-  \tparam AoSoA_t The AoSoA type.
+  \tparam OuterKeyViewType The Kokkos::View type for outer keys.
 
-  \param binning_data The binning data.
+  \tparam InnerKeyViewType The Kokkos::View type for inner keys.
 
-  \param aosoa The AoSoA to permute.
- */
-template <class BinningDataType, class AoSoA_t,
-          class DeviceType = typename BinningDataType::device_type>
-void permute(
-    const BinningDataType& binning_data, AoSoA_t& aosoa,
-    typename std::enable_if<( is_binning_data<BinningDataType>::value &&
-                              is_aosoa<AoSoA_t>::value ),
-                            int>::type* = 0 )
+  \param exec_space The execution space instance to bin on.
+
+  \param outer_keys The outer bin of every element of the AoSoA. Keys must be
+  integers in [0,num_outer).
+
+  \param num_outer The number of outer bins.
+
+  \param inner_keys The inner bin of every element of the AoSoA. Keys must be
+  integers in [0,num_inner).
+
+  \param num_inner The number of inner bins in every outer bin.
+
+  \param begin The beginning index of the AoSoA range to bin.
+
+  \param end The end index of the AoSoA range to bin.
+
+  \return The binning data with num_outer * num_inner nested bins. The bin of
+  outer key i and inner key j is i * num_inner + j such that the tuples of
+  outer bin i start at binOffset( i * num_inner ). Tuples keep their relative
+  order within a bin.
+
+  The composite keys are sorted with the stable radix sort.
+*/
+template <class ExecutionSpace, class OuterKeyViewType, class InnerKeyViewType,
+          class DeviceType = typename OuterKeyViewType::device_type>
+BinningData<DeviceType> binByNestedKeys(
+    const ExecutionSpace& exec_space, OuterKeyViewType outer_keys,
+    const int num_outer, InnerKeyViewType inner_keys, const int num_inner,
+    const std::size_t begin, const std::size_t end,
+    typename std::enable_if<
+        ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+          Kokkos::is_view<OuterKeyViewType>::value &&
+          Kokkos::is_view<InnerKeyViewType>::value ),
+        int>::type* = 0 )
+{
+    Impl::ScopedProfileRegion region( "Cabana::binByKey" );
+
+    using size_type = typename DeviceType::memory_space::size_type;
+    static_assert(
+        std::is_integral<
+            typename OuterKeyViewType::non_const_value_type>::value &&
+            std::is_integral<
+                typename InnerKeyViewType::non_const_value_type>::value,
+        "Nested binning requires integer keys" );
+
+    // Compute the composite keys and count the tuples in each bin.
+    std::size_t num_bin = static_cast<std::size_t>( num_outer ) * num_inner;
+    Kokkos::View<std::uint64_t*, DeviceType> keys(
+        Kokkos::ViewAllocateWithoutInitializing( "nested_keys" ), end );
+    Kokkos::View<int*, DeviceType> counts( "counts", num_bin );
+    auto key_op = KOKKOS_LAMBDA( const std::size_t i )
+    {
+        std::uint64_t key =
+            static_cast<std::uint64_t>( outer_keys( i ) ) * num_inner +
+            static_cast<std::uint64_t>( inner_keys( i ) );
+        keys( i ) = key;
+        Kokkos::atomic_increment( &counts( key ) );
+    };
+    Kokkos::parallel_for(
+        "Cabana::binByNestedKeys::keys",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, begin, end ), key_op );
+
+    // Compute the bin offsets.
+    Kokkos::View<size_type*, DeviceType> offsets(
+        Kokkos::ViewAllocateWithoutInitializing( "offsets" ), num_bin );
+    auto offset_scan = KOKKOS_LAMBDA( const std::size_t b, size_type& update,
+                                      const bool final_pass )
+    {
+        if ( final_pass )
+            offsets( b ) = update;
+        update += counts( b );
+    };
+    Kokkos::parallel_scan(
+        "Cabana::binByNestedKeys::offset_scan",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_bin ),
+        offset_scan );
+    exec_space.fence();
+
+    // Sort the composite keys.
+    auto permute_vector =
+        Impl::radixPermutation<ExecutionSpace, decltype( keys ), DeviceType>(
+            exec_space, keys, begin, end );
+    return BinningData<DeviceType>( begin, end, counts, offsets,
+                                    permute_vector );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Stably bin an entire AoSoA by an outer and an inner key.
+
+  \tparam ExecutionSpace The execution space type.
+
+  \tparam OuterKeyViewType The Kokkos::View type for outer keys.
+
+  \tparam InnerKeyViewType The Kokkos::View type for inner keys.
+
+  \param exec_space The execution space instance to bin on.
+
+  \param outer_keys The outer bin of every element of the AoSoA.
+
+  \param num_outer The number of outer bins.
+
+  \param inner_keys The inner bin of every element of the AoSoA.
+
+  \param num_inner The number of inner bins in every outer bin.
+
+  \return The binning data with num_outer * num_inner nested bins.
+*/
+template <class ExecutionSpace, class OuterKeyViewType, class InnerKeyViewType,
+          class DeviceType = typename OuterKeyViewType::device_type>
+BinningData<DeviceType> binByNestedKeys(
+    const ExecutionSpace& exec_space, OuterKeyViewType outer_keys,
+    const int num_outer, InnerKeyViewType inner_keys, const int num_inner,
+    typename std::enable_if<
+        ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+          Kokkos::is_view<OuterKeyViewType>::value &&
+          Kokkos::is_view<InnerKeyViewType>::value ),
+        int>::type* = 0 )
+{
+    return binByNestedKeys<ExecutionSpace, OuterKeyViewType, InnerKeyViewType,
+                           DeviceType>( exec_space, outer_keys, num_outer,
+                                        inner_keys, num_inner, 0,
+                                        outer_keys.extent( 0 ) );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Stably bin an AoSoA over a subset of its range by an outer and an
+  inner slice of keys.
+
+  \tparam ExecutionSpace The execution space type.
+
+  \tparam OuterSliceType Slice type for outer keys.
+
+  \tparam InnerSliceType Slice type for inner keys.
+
+  \param exec_space The execution space instance to bin on.
+
+  \param outer_slice Slice of outer keys in [0,num_outer).
+
+  \param num_outer The number of outer bins.
+
+  \param inner_slice Slice of inner keys in [0,num_inner).
+
+  \param num_inner The number of inner bins in every outer bin.
+
+  \param begin The beginning index of the AoSoA range to bin.
+
+  \param end The end index of the AoSoA range to bin.
+
+  \return The binning data with num_outer * num_inner nested bins.
+*/
+template <class ExecutionSpace, class OuterSliceType, class InnerSliceType,
+          class DeviceType = typename OuterSliceType::device_type>
+BinningData<DeviceType> binByNestedKeys(
+    const ExecutionSpace& exec_space, OuterSliceType outer_slice,
+    const int num_outer, InnerSliceType inner_slice, const int num_inner,
+    const std::size_t begin, const std::size_t end,
+    typename std::enable_if<
+        ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+          is_slice<OuterSliceType>::value && is_slice<InnerSliceType>::value ),
+        int>::type* = 0 )
+{
+    auto outer_keys =
+        Impl::copySliceToKeys<ExecutionSpace, OuterSliceType, DeviceType>(
+            exec_space, outer_slice );
+    auto inner_keys =
+        Impl::copySliceToKeys<ExecutionSpace, InnerSliceType, DeviceType>(
+            exec_space, inner_slice );
+    return binByNestedKeys<ExecutionSpace, decltype( outer_keys ),
+                           decltype( inner_keys ), DeviceType>(
+        exec_space, outer_keys, num_outer, inner_keys, num_inner, begin, end );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Stably bin an entire AoSoA by an outer and an inner slice of keys.
+
+  \tparam ExecutionSpace The execution space type.
+
+  \tparam OuterSliceType Slice type for outer keys.
+
+  \tparam InnerSliceType Slice type for inner keys.
+
+  \param exec_space The execution space instance to bin on.
+
+  \param outer_slice Slice of outer keys in [0,num_outer).
+
+  \param num_outer The number of outer bins.
+
+  \param inner_slice Slice of inner keys in [0,num_inner).
+
+  \param num_inner The number of inner bins in every outer bin.
+
+  \return The binning data with num_outer * num_inner nested bins.
+*/
+template <class ExecutionSpace, class OuterSliceType, class InnerSliceType,
+          class DeviceType = typename OuterSliceType::device_type>
+BinningData<DeviceType> binByNestedKeys(
+    const ExecutionSpace& exec_space, OuterSliceType outer_slice,
+    const int num_outer, InnerSliceType inner_slice, const int num_inner,
+    typename std::enable_if<
+        ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+          is_slice<OuterSliceType>::value && is_slice<InnerSliceType>::value ),
+        int>::type* = 0 )
+{
+    return binByNestedKeys<ExecutionSpace, OuterSliceType, InnerSliceType,
+                           DeviceType>( exec_space, outer_slice, num_outer,
+                                        inner_slice, num_inner, 0,
+                                        outer_slice.size() );
+}
+
+//---------------------------------------------------------------------------//
+//! Space-filling curve used to order particles.
+enum class SpaceFillingCurve
+{
+    Morton,
+    Hilbert
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Sort an AoSoA over a subset of its range along a space-filling curve
+  through the given positions.
+
+  \tparam ExecutionSpace The execution space type.
+
+  \tparam SliceType Slice type for positions.
+
+  \param exec_space The execution space instance to sort on.
+
+  \param positions Slice of positions.
+
+  \param begin The beginning index of the AoSoA range to sort.
+
+  \param end The end index of the AoSoA range to sort.
+
+  \param grid_min Minimum value of the sorting domain in each direction.
+
+  \param grid_max Maximum value of the sorting domain in each direction.
+
+  \param curve The space-filling curve to sort along.
+
+  \return The permutation vector associated with the sorting.
+
+  The domain is divided into 2^21 cells in each direction and each particle
+  gets the 63-bit curve key of its cell. Positions outside of the domain are
+  assigned to the closest cell.
+*/
+template <class ExecutionSpace, class SliceType,
+          class DeviceType = typename SliceType::device_type>
+BinningData<DeviceType> sortBySpaceFillingCurve(
+    const ExecutionSpace& exec_space, SliceType positions,
+    const std::size_t begin, const std::size_t end,
+    const typename SliceType::value_type grid_min[3],
+    const typename SliceType::value_type grid_max[3],
+    const SpaceFillingCurve curve = SpaceFillingCurve::Morton,
+    typename std::enable_if<
+        ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+          is_slice<SliceType>::value ),
+        int>::type* = 0 )
+{
+    // Compute the curve keys.
+    const double num_cell = 1 << 21;
+    double low[3];
+    double scale[3];
+    for ( int d = 0; d < 3; ++d )
+    {
+        low[d] = grid_min[d];
+        scale[d] = num_cell / ( grid_max[d] - grid_min[d] );
+    }
+    Kokkos::View<std::uint64_t*, DeviceType> keys(
+        Kokkos::ViewAllocateWithoutInitializing( "curve_keys" ),
+        positions.size() );
+    auto key_op = KOKKOS_LAMBDA( const std::size_t p )
+    {
+        std::uint32_t ijk[3];
+        for ( int d = 0; d < 3; ++d )
+        {
+            double x = ( positions( p, d ) - low[d] ) * scale[d];
+            x = ( x < 0.0 ) ? 0.0 : x;
+            x = ( x < num_cell - 1.0 ) ? x : num_cell - 1.0;
+            ijk[d] = static_cast<std::uint32_t>( x );
+        }
+        keys( p ) = ( SpaceFillingCurve::Hilbert == curve )
+                        ? Impl::hilbertKey( ijk[0], ijk[1], ijk[2] )
+                        : Impl::mortonKey( ijk[0], ijk[1], ijk[2] );
+    };
+    Kokkos::parallel_for(
+        "Cabana::sortBySpaceFillingCurve::keys",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, begin, end ), key_op );
+    exec_space.fence();
+
+    // Sort the keys.
+    return Impl::radixSort<ExecutionSpace, decltype( keys ), DeviceType>(
+        exec_space, keys, begin, end );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Sort an AoSoA over a subset of its range along a space-filling curve
+  through the given positions on the default execution space instance.
+
+  \tparam SliceType Slice type for positions.
+
+  \param positions Slice of positions.
+
+  \param begin The beginning index of the AoSoA range to sort.
+
+  \param end The end index of the AoSoA range to sort.
+
+  \param grid_min Minimum value of the sorting domain in each direction.
+
+  \param grid_max Maximum value of the sorting domain in each direction.
+
+  \param curve The space-filling curve to sort along.
+
+  \return The permutation vector associated with the sorting.
+*/
+template <class SliceType, class DeviceType = typename SliceType::device_type>
+BinningData<DeviceType> sortBySpaceFillingCurve(
+    SliceType positions, const std::size_t begin, const std::size_t end,
+    const typename SliceType::value_type grid_min[3],
+    const typename SliceType::value_type grid_max[3],
+    const SpaceFillingCurve curve = SpaceFillingCurve::Morton,
+    typename std::enable_if<( is_slice<SliceType>::value ), int>::type* = 0 )
+{
+    using execution_space = typename DeviceType::execution_space;
+    return sortBySpaceFillingCurve<execution_space, SliceType, DeviceType>(
+        execution_space(), positions, begin, end, grid_min, grid_max, curve );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Sort an entire AoSoA along a space-filling curve through the given
+  positions.
+
+  \tparam SliceType Slice type for positions.
+
+  \param positions Slice of positions.
+
+  \param grid_min Minimum value of the sorting domain in each direction.
+
+  \param grid_max Maximum value of the sorting domain in each direction.
+
+  \param curve The space-filling curve to sort along.
+
+  \return The permutation vector associated with the sorting.
+*/
+template <class SliceType, class DeviceType = typename SliceType::device_type>
+BinningData<DeviceType> sortBySpaceFillingCurve(
+    SliceType positions, const typename SliceType::value_type grid_min[3],
+    const typename SliceType::value_type grid_max[3],
+    const SpaceFillingCurve curve = SpaceFillingCurve::Morton,
+    typename std::enable_if<( is_slice<SliceType>::value ), int>::type* = 0 )
+{
+    return sortBySpaceFillingCurve<SliceType, DeviceType>(
+        positions, 0, positions.size(), grid_min, grid_max, curve );
+}
+
+//---------------------------------------------------------------------------//
+namespace Impl
+{
+//! \cond Impl
+//---------------------------------------------------------------------------//
+// Permute the components [comp_begin,comp_end) of a slice over the binning
+// range. Scratch is allocated only for the given components.
+template <class DeviceType, class ExecutionSpace, class BinningDataType,
+          class SliceType>
+void permuteSliceComponents( const ExecutionSpace& exec_space,
+                             const BinningDataType& binning_data,
+                             const SliceType& slice,
+                             const std::size_t comp_begin,
+                             const std::size_t comp_end )
 {
+    auto begin = binning_data.rangeBegin();
+    auto end = binning_data.rangeEnd();
+    std::size_t num_comp = comp_end - comp_begin;
+
+    // Get the raw slice data.
+    auto slice_data = slice.data();
+
+    Kokkos::View<typename SliceType::value_type**, DeviceType> scratch_array(
+        Kokkos::ViewAllocateWithoutInitializing( "scratch_array" ), end - begin,
+        num_comp );
+
+    auto permute_to_scratch = KOKKOS_LAMBDA( const std::size_t i )
+    {
+        auto permute_i = binning_data.permutation( i - begin );
+        auto s = SliceType::index_type::s( permute_i );
+        auto a = SliceType::index_type::a( permute_i );
+        std::size_t slice_offset = s * slice.stride( 0 ) + a;
+        for ( std::size_t n = 0; n < num_comp; ++n )
+            scratch_array( i - begin, n ) =
+                slice_data[slice_offset +
+                           SliceType::vector_length * ( n + comp_begin )];
+    };
+    Kokkos::parallel_for(
+        "Cabana::kokkosBinSort::permute_to_scratch",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, begin, end ),
+        permute_to_scratch );
+    exec_space.fence();
+
+    auto copy_back = KOKKOS_LAMBDA( const std::size_t i )
+    {
+        auto s = SliceType::index_type::s( i );
+        auto a = SliceType::index_type::a( i );
+        std::size_t slice_offset = s * slice.stride( 0 ) + a;
+        for ( std::size_t n = 0; n < num_comp; ++n )
+            slice_data[slice_offset +
+                       SliceType::vector_length * ( n + comp_begin )] =
+                scratch_array( i - begin, n );
+    };
+    Kokkos::parallel_for(
+        "Cabana::kokkosBinSort::copy_back",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, begin, end ),
+        copy_back );
+    exec_space.fence();
+}
+
+//---------------------------------------------------------------------------//
+// A list of slices, each with scratch for all of its components over the
+// binning range, which are moved together in a single pass over the
+// permutation.
+template <class DeviceType, class... SliceTypes>
+struct PermuteSliceList;
+
+template <class DeviceType>
+struct PermuteSliceList<DeviceType>
+{
+    PermuteSliceList( const std::size_t ) {}
+
+    KOKKOS_INLINE_FUNCTION
+    void gather( const std::size_t, const std::size_t ) const {}
+
+    KOKKOS_INLINE_FUNCTION
+    void scatter( const std::size_t, const std::size_t ) const {}
+};
+
+template <class DeviceType, class SliceType, class... SliceTypes>
+struct PermuteSliceList<DeviceType, SliceType, SliceTypes...>
+{
+    static_assert( is_slice<SliceType>::value,
+                   "Only slices may be permuted together" );
+
+    SliceType slice;
+    std::size_t num_comp;
+    Kokkos::View<typename SliceType::value_type**, DeviceType> scratch;
+    PermuteSliceList<DeviceType, SliceTypes...> rest;
+
+    PermuteSliceList( const std::size_t size, const SliceType& s,
+                      const SliceTypes&... slices )
+        : slice( s )
+        , num_comp( 1 )
+        , rest( size, slices... )
+    {
+        for ( std::size_t d = 2; d < slice.rank(); ++d )
+            num_comp *= slice.extent( d );
+        scratch = Kokkos::View<typename SliceType::value_type**, DeviceType>(
+            Kokkos::ViewAllocateWithoutInitializing( "scratch_array" ), size,
+            num_comp );
+    }
+
+    // Copy element src of every slice into scratch entry i.
+    KOKKOS_INLINE_FUNCTION
+    void gather( const std::size_t i, const std::size_t src ) const
+    {
+        auto s = SliceType::index_type::s( src );
+        auto a = SliceType::index_type::a( src );
+        std::size_t slice_offset = s * slice.stride( 0 ) + a;
+        auto slice_data = slice.data();
+        for ( std::size_t n = 0; n < num_comp; ++n )
+            scratch( i, n ) =
+                slice_data[slice_offset + SliceType::vector_length * n];
+        rest.gather( i, src );
+    }
+
+    // Copy scratch entry i into element dst of every slice.
+    KOKKOS_INLINE_FUNCTION
+    void scatter( const std::size_t i, const std::size_t dst ) const
+    {
+        auto s = SliceType::index_type::s( dst );
+        auto a = SliceType::index_type::a( dst );
+        std::size_t slice_offset = s * slice.stride( 0 ) + a;
+        auto slice_data = slice.data();
+        for ( std::size_t n = 0; n < num_comp; ++n )
+            slice_data[slice_offset + SliceType::vector_length * n] =
+                scratch( i, n );
+        rest.scatter( i, dst );
+    }
+};
+
+//---------------------------------------------------------------------------//
+// Permute a single AoSoA member in groups of components that fit in the
+// scratch limit.
+template <std::size_t M, class DeviceType, class BinningDataType,
+          class AoSoA_t>
+void permuteMember( const BinningDataType& binning_data, const AoSoA_t& aosoa,
+                    const std::size_t max_scratch_bytes )
+{
+    auto slice = Cabana::slice<M>( aosoa );
+    using value_type = typename decltype( slice )::value_type;
+
+    std::size_t num_comp = 1;
+    for ( std::size_t d = 2; d < slice.rank(); ++d )
+        num_comp *= slice.extent( d );
+
+    std::size_t comp_bytes = sizeof( value_type ) *
+                             ( binning_data.rangeEnd() -
+                               binning_data.rangeBegin() );
+    std::size_t comp_per_pass =
+        ( comp_bytes > 0 ) ? max_scratch_bytes / comp_bytes : num_comp;
+    comp_per_pass = std::max( comp_per_pass, std::size_t( 1 ) );
+
+    for ( std::size_t c = 0; c < num_comp; c += comp_per_pass )
+        permuteSliceComponents<DeviceType>(
+            typename DeviceType::execution_space(), binning_data, slice, c,
+            std::min( c + comp_per_pass, num_comp ) );
+}
+
+// Permute each member of an AoSoA in turn.
+template <class DeviceType, class BinningDataType, class AoSoA_t,
+          std::size_t... Ms>
+void permuteMembers( const BinningDataType& binning_data, const AoSoA_t& aosoa,
+                     const std::size_t max_scratch_bytes,
+                     std::index_sequence<Ms...> )
+{
+    (void)std::initializer_list<int>{ ( permuteMember<Ms, DeviceType>(
+                                            binning_data, aosoa,
+                                            max_scratch_bytes ),
+                                        0 )... };
+}
+
+//---------------------------------------------------------------------------//
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Given binning data permute an AoSoA.
+
+  \tparam ExecutionSpace The execution space type.
+
+  \tparam BinningDataType The binning data type.
+
+  \tparam AoSoA_t The AoSoA type.
+
+  \param exec_space The execution space instance to permute on.
+
+  \param binning_data The binning data.
+
+  \param aosoa The AoSoA to permute.
+ */
+template <class ExecutionSpace, class BinningDataType, class AoSoA_t,
+          class DeviceType = typename BinningDataType::device_type>
+void permute(
+    const ExecutionSpace& exec_space, const BinningDataType& binning_data,
+    AoSoA_t& aosoa,
+    typename std::enable_if<
+        ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+          is_binning_data<BinningDataType>::value &&
+          is_aosoa<AoSoA_t>::value ),
+        int>::type* = 0 )
+{
+    Impl::ScopedProfileRegion region( "Cabana::permute" );
+
     auto begin = binning_data.rangeBegin();
     auto end = binning_data.rangeEnd();
 
@@ -593,9 +1866,9 @@ void permute(
     };
     Kokkos::parallel_for(
         "Cabana::kokkosBinSort::permute_to_scratch",
-        Kokkos::RangePolicy<typename DeviceType::execution_space>( begin, end ),
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, begin, end ),
         permute_to_scratch );
-    Kokkos::fence();
+    exec_space.fence();
 
     auto copy_back = KOKKOS_LAMBDA( const std::size_t i )
     {
@@ -603,15 +1876,80 @@ void permute(
     };
     Kokkos::parallel_for(
         "Cabana::kokkosBinSort::copy_back",
-        Kokkos::RangePolicy<typename DeviceType::execution_space>( begin, end ),
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, begin, end ),
         copy_back );
-    Kokkos::fence();
+    exec_space.fence();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Given binning data permute an AoSoA on the default execution space
+  instance.
+
+  \tparam BinningDataType The binning data type.
+
+  \tparam AoSoA_t The AoSoA type.
+
+  \param binning_data The binning data.
+
+  \param aosoa The AoSoA to permute.
+ */
+template <class BinningDataType, class AoSoA_t,
+          class DeviceType = typename BinningDataType::device_type>
+void permute(
+    const BinningDataType& binning_data, AoSoA_t& aosoa,
+    typename std::enable_if<( is_binning_data<BinningDataType>::value &&
+                              is_aosoa<AoSoA_t>::value ),
+                            int>::type* = 0 )
+{
+    using execution_space = typename DeviceType::execution_space;
+    permute<execution_space, BinningDataType, AoSoA_t, DeviceType>(
+        execution_space(), binning_data, aosoa );
 }
 
 //---------------------------------------------------------------------------//
 /*!
   \brief Given binning data permute a slice.
 
+  \tparam ExecutionSpace The execution space type.
+
+  \tparam BinningDataType The binning data type.
+
+  \tparam SliceType The slice type.
+
+  \param exec_space The execution space instance to permute on.
+
+  \param binning_data The binning data.
+
+  \param slice The slice to permute.
+ */
+template <class ExecutionSpace, class BinningDataType, class SliceType,
+          class DeviceType = typename BinningDataType::device_type>
+void permute(
+    const ExecutionSpace& exec_space, const BinningDataType& binning_data,
+    SliceType& slice,
+    typename std::enable_if<
+        ( Kokkos::is_execution_space<ExecutionSpace>::value &&
+          is_binning_data<BinningDataType>::value &&
+          is_slice<SliceType>::value ),
+        int>::type* = 0 )
+{
+    Impl::ScopedProfileRegion region( "Cabana::permute" );
+
+    // Get the number of components in the slice.
+    std::size_t num_comp = 1;
+    for ( std::size_t d = 2; d < slice.rank(); ++d )
+        num_comp *= slice.extent( d );
+
+    Impl::permuteSliceComponents<DeviceType>( exec_space, binning_data, slice,
+                                              0, num_comp );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Given binning data permute a slice on the default execution space
+  instance.
+
   \tparam BinningDataType The binning data type.
 
   \tparam SliceType The slice type.
@@ -628,52 +1966,108 @@ void permute(
                               is_slice<SliceType>::value ),
                             int>::type* = 0 )
 {
+    using execution_space = typename DeviceType::execution_space;
+    permute<execution_space, BinningDataType, SliceType, DeviceType>(
+        execution_space(), binning_data, slice );
+}
 
-    auto begin = binning_data.rangeBegin();
-    auto end = binning_data.rangeEnd();
+//---------------------------------------------------------------------------//
+/*!
+  \brief Given binning data permute several slices together.
 
-    // Get the number of components in the slice.
-    std::size_t num_comp = 1;
-    for ( std::size_t d = 2; d < slice.rank(); ++d )
-        num_comp *= slice.extent( d );
+  The permutation is read once per element and all slices are moved in the
+  same pass rather than permuting each slice separately.
 
-    // Get the raw slice data.
-    auto slice_data = slice.data();
+  \tparam BinningDataType The binning data type.
 
-    Kokkos::View<typename SliceType::value_type**, DeviceType> scratch_array(
-        Kokkos::ViewAllocateWithoutInitializing( "scratch_array" ), end - begin,
-        num_comp );
+  \tparam SliceTypes The slice types.
+
+  \param binning_data The binning data.
+
+  \param slice_a The first slice to permute.
+
+  \param slice_b The second slice to permute.
+
+  \param slices The remaining slices to permute.
+ */
+template <class BinningDataType, class SliceTypeA, class SliceTypeB,
+          class... SliceTypes>
+typename std::enable_if<( is_binning_data<BinningDataType>::value &&
+                          is_slice<SliceTypeA>::value &&
+                          is_slice<SliceTypeB>::value ),
+                        void>::type
+permute( const BinningDataType& binning_data, SliceTypeA& slice_a,
+         SliceTypeB& slice_b, SliceTypes&... slices )
+{
+    Impl::ScopedProfileRegion region( "Cabana::permute" );
+
+    using device_type = typename BinningDataType::device_type;
+    using execution_space = typename device_type::execution_space;
+    execution_space exec_space;
+
+    auto begin = binning_data.rangeBegin();
+    auto end = binning_data.rangeEnd();
+
+    Impl::PermuteSliceList<device_type, SliceTypeA, SliceTypeB, SliceTypes...>
+        slice_list( end - begin, slice_a, slice_b, slices... );
 
     auto permute_to_scratch = KOKKOS_LAMBDA( const std::size_t i )
     {
-        auto permute_i = binning_data.permutation( i - begin );
-        auto s = SliceType::index_type::s( permute_i );
-        auto a = SliceType::index_type::a( permute_i );
-        std::size_t slice_offset = s * slice.stride( 0 ) + a;
-        for ( std::size_t n = 0; n < num_comp; ++n )
-            scratch_array( i - begin, n ) =
-                slice_data[slice_offset + SliceType::vector_length * n];
+        slice_list.gather( i - begin, binning_data.permutation( i - begin ) );
     };
     Kokkos::parallel_for(
         "Cabana::kokkosBinSort::permute_to_scratch",
-        Kokkos::RangePolicy<typename DeviceType::execution_space>( begin, end ),
+        Kokkos::RangePolicy<execution_space>( exec_space, begin, end ),
         permute_to_scratch );
-    Kokkos::fence();
+    exec_space.fence();
 
     auto copy_back = KOKKOS_LAMBDA( const std::size_t i )
     {
-        auto s = SliceType::index_type::s( i );
-        auto a = SliceType::index_type::a( i );
-        std::size_t slice_offset = s * slice.stride( 0 ) + a;
-        for ( std::size_t n = 0; n < num_comp; ++n )
-            slice_data[slice_offset + SliceType::vector_length * n] =
-                scratch_array( i - begin, n );
+        slice_list.scatter( i - begin, i );
     };
     Kokkos::parallel_for(
         "Cabana::kokkosBinSort::copy_back",
-        Kokkos::RangePolicy<typename DeviceType::execution_space>( begin, end ),
+        Kokkos::RangePolicy<execution_space>( exec_space, begin, end ),
         copy_back );
-    Kokkos::fence();
+    exec_space.fence();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Given binning data permute an AoSoA one member at a time with a
+  bounded scratch allocation.
+
+  Unlike permute(), which stages complete tuples for the whole binning range,
+  each member is permuted through scratch sized for as many of its components
+  as fit in \p max_scratch_bytes. The peak scratch size is therefore
+  independent of the number of members in the AoSoA. A single component of
+  the largest member over the binning range is always permuted at once, even
+  if it exceeds the requested limit.
+
+  \tparam BinningDataType The binning data type.
+
+  \tparam AoSoA_t The AoSoA type.
+
+  \param binning_data The binning data.
+
+  \param aosoa The AoSoA to permute.
+
+  \param max_scratch_bytes The maximum scratch allocation in bytes.
+ */
+template <class BinningDataType, class AoSoA_t,
+          class DeviceType = typename BinningDataType::device_type>
+void permuteMemberwise(
+    const BinningDataType& binning_data, AoSoA_t& aosoa,
+    const std::size_t max_scratch_bytes,
+    typename std::enable_if<( is_binning_data<BinningDataType>::value &&
+                              is_aosoa<AoSoA_t>::value ),
+                            int>::type* = 0 )
+{
+    Impl::ScopedProfileRegion region( "Cabana::permute" );
+
+    Impl::permuteMembers<DeviceType>(
+        binning_data, aosoa, max_scratch_bytes,
+        std::make_index_sequence<AoSoA_t::number_of_members>() );
 }
 
 //---------------------------------------------------------------------------//
@@ -0,0 +1,340 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_TaskGraph.hpp
+  \brief Dependency graph scheduling of timestep phases
+*/
+#ifndef CABANA_TASKGRAPH_HPP
+#define CABANA_TASKGRAPH_HPP
+
+#include <impl/Cabana_Profiling.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Cabana
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief Access of a task to a data object.
+
+  Objects are identified by the address of their data such that every slice,
+  view, or array of the same allocation is the same object. The members of an
+  AoSoA are distinct objects and an access to the AoSoA itself is the same
+  object as its first member.
+*/
+struct TaskAccess
+{
+    //! Address of the data of the object.
+    const void* key;
+    //! True if the task writes the object.
+    bool write;
+};
+
+namespace Impl
+{
+//! \cond Impl
+// Get the data address of objects with a data() member (slices, views,
+// AoSoAs).
+template <class T>
+auto taskDataKey( const T& t, int ) -> decltype( t.data(), (const void*)0 )
+{
+    return static_cast<const void*>( t.data() );
+}
+
+// Get the data address of objects with a view() member (Cajita arrays).
+template <class T>
+auto taskDataKey( const T& t, long )
+    -> decltype( t.view().data(), (const void*)0 )
+{
+    return static_cast<const void*>( t.view().data() );
+}
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+//! Declare that a task reads a data object.
+template <class T>
+TaskAccess readAccess( const T& t )
+{
+    return TaskAccess{ Impl::taskDataKey( t, 0 ), false };
+}
+
+//---------------------------------------------------------------------------//
+//! Declare that a task writes a data object.
+template <class T>
+TaskAccess writeAccess( const T& t )
+{
+    return TaskAccess{ Impl::taskDataKey( t, 0 ), true };
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Dependency graph of the operations of a timestep.
+
+  \tparam ExecutionSpace The execution space of the instances on which tasks
+  are launched.
+
+  Tasks are added in program order with the data objects they read and
+  write. A task depends on every earlier task writing an object it accesses
+  and on every earlier task reading an object it writes. Executing the graph
+  launches the tasks in the order they were added onto several execution
+  space instances such that independent tasks may run concurrently, and only
+  fences an instance when a task launched on another instance depends on its
+  work.
+
+  Kernel tasks enqueue their work on the given instance and must not fence
+  it. Communication tasks are split into a start and a finish, e.g. a
+  split-phase halo gather. The start is called as soon as the dependencies of
+  the task are complete, and the finish is deferred until a later task needs
+  the data or the graph completes. The work in between therefore overlaps
+  with the communication.
+
+  \code
+  Cabana::TaskGraph<ExecutionSpace> graph( { space_0, space_1 } );
+  Cabana::HaloRequest request;
+  graph.addComm(
+      "gather", [&]( const ExecutionSpace& )
+      { request = Cabana::gatherStart( halo, positions ); },
+      [&]() { request.finish(); }, { Cabana::writeAccess( positions ) } );
+  graph.add( "output", output_kernel,
+             { Cabana::readAccess( velocities ) } );
+  graph.add( "forces", force_kernel,
+             { Cabana::readAccess( positions ),
+               Cabana::writeAccess( forces ) } );
+  graph.execute();
+  \endcode
+
+  A graph may be executed any number of times.
+*/
+template <class ExecutionSpace>
+class TaskGraph
+{
+  public:
+    //! Execution space.
+    using execution_space = ExecutionSpace;
+
+    //! Task launch function. Enqueues the work of a task on an instance.
+    using launch_type = std::function<void( const execution_space& )>;
+
+    //! Communication finish function.
+    using finish_type = std::function<void()>;
+
+    /*!
+      \brief Constructor.
+
+      \param instances The execution space instances on which tasks are
+      launched.
+    */
+    TaskGraph( const std::vector<execution_space>& instances =
+                   std::vector<execution_space>( 1, execution_space() ) )
+        : _instances( instances )
+    {
+        if ( _instances.empty() )
+            throw std::runtime_error( "TaskGraph requires an instance" );
+    }
+
+    //! Get the number of tasks.
+    std::size_t numTask() const { return _tasks.size(); }
+
+    //! Get the number of execution space instances.
+    std::size_t numInstance() const { return _instances.size(); }
+
+    /*!
+      \brief Add a kernel task.
+
+      \param name The name of the task, used as its profiling region.
+
+      \param launch Function enqueueing the work of the task on the given
+      instance.
+
+      \param accesses The data objects accessed by the task.
+
+      \return The id of the task.
+    */
+    std::size_t add( const std::string& name, const launch_type& launch,
+                     std::initializer_list<TaskAccess> accesses )
+    {
+        return addTask( name, launch, finish_type(), accesses );
+    }
+
+    /*!
+      \brief Add a communication task.
+
+      \param name The name of the task, used as its profiling region.
+
+      \param start Function starting the communication. Packing may be
+      enqueued on the given instance.
+
+      \param finish Function completing the communication.
+
+      \param accesses The data objects accessed by the task.
+
+      \return The id of the task.
+    */
+    std::size_t addComm( const std::string& name, const launch_type& start,
+                         const finish_type& finish,
+                         std::initializer_list<TaskAccess> accesses )
+    {
+        if ( !finish )
+            throw std::runtime_error(
+                "Communication task requires a finish function" );
+        return addTask( name, start, finish, accesses );
+    }
+
+    //! Get the ids of the tasks a task depends on.
+    const std::vector<std::size_t>& dependencies( const std::size_t id ) const
+    {
+        return _tasks[id].dependencies;
+    }
+
+    //! Get the instance index a task is launched on.
+    std::size_t instance( const std::size_t id ) const
+    {
+        return _tasks[id].instance;
+    }
+
+    /*!
+      \brief Launch every task and wait for all of them to complete.
+    */
+    void execute()
+    {
+        Impl::ScopedProfileRegion region( "Cabana::TaskGraph::execute" );
+
+        const std::size_t num_task = _tasks.size();
+        const std::size_t num_instance = _instances.size();
+
+        // The last task launched on each instance and the last one known to
+        // be complete.
+        std::vector<std::size_t> launched( num_instance, 0 );
+        std::vector<std::size_t> complete( num_instance, 0 );
+        std::vector<std::size_t> position( num_task, 0 );
+        std::vector<bool> finished( num_task, true );
+
+        for ( std::size_t t = 0; t < num_task; ++t )
+        {
+            auto& task = _tasks[t];
+
+            // Complete the dependencies. Work on the same instance is
+            // ordered by the instance.
+            for ( auto d : task.dependencies )
+            {
+                const auto& dep = _tasks[d];
+                if ( !finished[d] )
+                    finishComm( d, finished );
+                else if ( dep.instance != task.instance &&
+                          complete[dep.instance] < position[d] )
+                {
+                    _instances[dep.instance].fence();
+                    complete[dep.instance] = launched[dep.instance];
+                }
+            }
+
+            // Launch. Communication is started on a complete instance as the
+            // data given to MPI must be ready.
+            Kokkos::Profiling::pushRegion( task.name );
+            if ( task.finish &&
+                 complete[task.instance] < launched[task.instance] )
+                _instances[task.instance].fence();
+            position[t] = ++launched[task.instance];
+            if ( task.finish )
+            {
+                task.launch( _instances[task.instance] );
+                _instances[task.instance].fence();
+                complete[task.instance] = launched[task.instance];
+                finished[t] = false;
+            }
+            else
+            {
+                task.launch( _instances[task.instance] );
+            }
+            Kokkos::Profiling::popRegion();
+        }
+
+        // Complete the remaining communication and work.
+        for ( std::size_t t = 0; t < num_task; ++t )
+            if ( !finished[t] )
+                finishComm( t, finished );
+        for ( auto& space : _instances )
+            space.fence();
+    }
+
+  private:
+    struct Task
+    {
+        std::string name;
+        launch_type launch;
+        finish_type finish;
+        std::vector<TaskAccess> accesses;
+        std::vector<std::size_t> dependencies;
+        std::size_t instance;
+    };
+
+    // Add a task and find its dependencies and instance.
+    std::size_t addTask( const std::string& name, const launch_type& launch,
+                         const finish_type& finish,
+                         std::initializer_list<TaskAccess> accesses )
+    {
+        Task task{ name, launch, finish, accesses, {}, 0 };
+
+        // Depend on earlier writers of any accessed object and on earlier
+        // readers of written objects.
+        for ( std::size_t t = 0; t < _tasks.size(); ++t )
+        {
+            bool depends = false;
+            for ( const auto& a : task.accesses )
+                for ( const auto& b : _tasks[t].accesses )
+                    if ( a.key == b.key && ( a.write || b.write ) )
+                        depends = true;
+            if ( depends )
+                task.dependencies.push_back( t );
+        }
+
+        // Launch after the latest dependency on its instance to avoid a
+        // fence. Independent tasks are distributed over the instances.
+        if ( !task.dependencies.empty() )
+            task.instance = _tasks[task.dependencies.back()].instance;
+        else
+            task.instance = _next_instance++ % _instances.size();
+
+        _tasks.push_back( std::move( task ) );
+        return _tasks.size() - 1;
+    }
+
+    // Finish a communication task.
+    void finishComm( const std::size_t t, std::vector<bool>& finished )
+    {
+        Kokkos::Profiling::pushRegion( _tasks[t].name );
+        _tasks[t].finish();
+        Kokkos::Profiling::popRegion();
+        finished[t] = true;
+    }
+
+  private:
+    std::vector<execution_space> _instances;
+    std::vector<Task> _tasks;
+    std::size_t _next_instance = 0;
+};
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cabana
+
+#endif // end CABANA_TASKGRAPH_HPP
@@ -16,13 +16,28 @@
 #ifndef CABANA_VERLETLIST_HPP
 #define CABANA_VERLETLIST_HPP
 
+#include <Cabana_HashedCellList.hpp>
 #include <Cabana_LinkedCellList.hpp>
 #include <Cabana_NeighborList.hpp>
 #include <Cabana_Parallel.hpp>
 #include <impl/Cabana_CartesianGrid.hpp>
+#include <impl/Cabana_Profiling.hpp>
 
 #include <Kokkos_Core.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 namespace Cabana
 {
 //---------------------------------------------------------------------------//
@@ -38,6 +53,45 @@ struct VerletLayout2D
 {
 };
 
+/*!
+  \brief Compressed neighbor list layout.
+
+  Neighbors are stored in CSR order as 16-bit differences to the particle
+  index. Neighbors outside of the 16-bit index window are stored separately
+  with their full index. This is most effective for spatially sorted
+  particles.
+*/
+struct VerletLayoutCompressed
+{
+};
+
+/*!
+  \brief Cluster-pair neighbor list layout.
+
+  Particles are spatially sorted into clusters of ClusterSize particles and
+  neighbors are stored per cluster as a list of neighbor clusters, each with a
+  bit mask of the interacting particle pairs. Supported cluster sizes are
+  4 and 8 such that the mask of a cluster pair fits in a single integer.
+
+  Clusters store the ids of their particles; the particle data is not
+  permuted. The layout reduces the size of the list but the neighbor
+  iteration still accesses the particles indirectly.
+*/
+template <std::size_t ClusterSize>
+struct VerletLayoutCluster
+{
+    static_assert( ClusterSize == 4 || ClusterSize == 8,
+                   "Cluster size must be 4 or 8" );
+
+    //! Number of particles per cluster.
+    static constexpr std::size_t cluster_size = ClusterSize;
+
+    //! Interaction mask type of a cluster pair.
+    using mask_type =
+        typename std::conditional<( ClusterSize * ClusterSize <= 32 ),
+                                  std::uint32_t, std::uint64_t>::type;
+};
+
 //---------------------------------------------------------------------------//
 // Verlet List Data.
 //---------------------------------------------------------------------------//
@@ -62,6 +116,13 @@ struct VerletListData<MemorySpace, VerletLayoutCSR>
     //! Neighbor list.
     Kokkos::View<int*, memory_space> neighbors;
 
+    //! Get the memory used by the neighbor data in bytes.
+    std::size_t memoryBytes() const
+    {
+        return Impl::viewBytes( counts ) + Impl::viewBytes( offsets ) +
+               Impl::viewBytes( neighbors );
+    }
+
     //! Add a neighbor to the list.
     KOKKOS_INLINE_FUNCTION
     void addNeighbor( const int pid, const int nid ) const
@@ -86,6 +147,12 @@ struct VerletListData<MemorySpace, VerletLayout2D>
     //! Neighbor list.
     Kokkos::View<int**, memory_space> neighbors;
 
+    //! Get the memory used by the neighbor data in bytes.
+    std::size_t memoryBytes() const
+    {
+        return Impl::viewBytes( counts ) + Impl::viewBytes( neighbors );
+    }
+
     //! Add a neighbor to the list.
     KOKKOS_INLINE_FUNCTION
     void addNeighbor( const int pid, const int nid ) const
@@ -96,6 +163,105 @@ struct VerletListData<MemorySpace, VerletLayout2D>
     }
 };
 
+//! Store the VerletList compressed neighbor data.
+template <class MemorySpace>
+struct VerletListData<MemorySpace, VerletLayoutCompressed>
+{
+    //! Kokkos memory space.
+    using memory_space = MemorySpace;
+    //! Default Kokkos device type.
+    using device_type [[deprecated]] = typename memory_space::device_type;
+
+    //! Delta value marking a neighbor stored with its full index.
+    static constexpr std::int16_t far_delta = -32768;
+
+    //! Number of neighbors per particle.
+    Kokkos::View<int*, memory_space> counts;
+
+    //! Offsets into the neighbor list.
+    Kokkos::View<int*, memory_space> offsets;
+
+    //! Neighbor index differences to the particle index.
+    Kokkos::View<std::int16_t*, memory_space> deltas;
+
+    //! Offsets into the far neighbor list. Particle p owns the far neighbors
+    //! in [far_offsets(p), far_offsets(p+1)).
+    Kokkos::View<int*, memory_space> far_offsets;
+
+    //! Position of each far neighbor in the neighbors of its particle.
+    Kokkos::View<int*, memory_space> far_slots;
+
+    //! Far neighbor list.
+    Kokkos::View<int*, memory_space> far_neighbors;
+
+    //! Get the memory used by the neighbor data in bytes.
+    std::size_t memoryBytes() const
+    {
+        return Impl::viewBytes( counts ) + Impl::viewBytes( offsets ) +
+               Impl::viewBytes( deltas ) + Impl::viewBytes( far_offsets ) +
+               Impl::viewBytes( far_slots ) + Impl::viewBytes( far_neighbors );
+    }
+
+    //! Get a neighbor of a particle.
+    KOKKOS_INLINE_FUNCTION
+    int getNeighbor( const int pid, const int n ) const
+    {
+        int delta = deltas( offsets( pid ) + n );
+        if ( delta != far_delta )
+            return pid + delta;
+        for ( int f = far_offsets( pid ); f < far_offsets( pid + 1 ); ++f )
+            if ( far_slots( f ) == n )
+                return far_neighbors( f );
+        return -1;
+    }
+};
+
+//! Store the VerletList cluster-pair neighbor data.
+template <class MemorySpace, std::size_t ClusterSize>
+struct VerletListData<MemorySpace, VerletLayoutCluster<ClusterSize>>
+{
+    //! Kokkos memory space.
+    using memory_space = MemorySpace;
+    //! Default Kokkos device type.
+    using device_type [[deprecated]] = typename memory_space::device_type;
+
+    //! Number of particles per cluster.
+    static constexpr std::size_t cluster_size = ClusterSize;
+
+    //! Interaction mask type of a cluster pair.
+    using mask_type = typename VerletLayoutCluster<ClusterSize>::mask_type;
+
+    //! Particle ids of each cluster. Particle a of cluster c is stored at
+    //! c * cluster_size + a. Unused entries of the last cluster are -1.
+    Kokkos::View<int*, memory_space> cluster_particles;
+
+    //! Number of neighbor clusters per cluster.
+    Kokkos::View<int*, memory_space> counts;
+
+    //! Offsets into the neighbor cluster list.
+    Kokkos::View<int*, memory_space> offsets;
+
+    //! Neighbor cluster list.
+    Kokkos::View<int*, memory_space> neighbors;
+
+    //! Interaction masks of the neighbor clusters. Bit a * cluster_size + b
+    //! is set if particle b of the neighbor cluster is a neighbor of
+    //! particle a of the cluster.
+    Kokkos::View<mask_type*, memory_space> masks;
+
+    //! Get the number of clusters.
+    KOKKOS_INLINE_FUNCTION
+    std::size_t numCluster() const { return counts.extent( 0 ); }
+
+    //! Get the memory used by the neighbor data in bytes.
+    std::size_t memoryBytes() const
+    {
+        return Impl::viewBytes( cluster_particles ) +
+               Impl::viewBytes( counts ) + Impl::viewBytes( offsets ) +
+               Impl::viewBytes( neighbors ) + Impl::viewBytes( masks );
+    }
+};
+
 //---------------------------------------------------------------------------//
 
 namespace Impl
@@ -151,30 +317,105 @@ class NeighborDiscriminator<HalfNeighborTag>
 
 //---------------------------------------------------------------------------//
 // Cell stencil.
-template <class Scalar>
+template <class Scalar, class MemorySpace = Kokkos::HostSpace>
 struct LinkedCellStencil
 {
     Scalar rsqr;
     CartesianGrid<double> grid;
-    int max_cells_dir;
+    int max_cells_dir[3];
     int max_cells;
-    int cell_range;
+    int cell_range[3];
+    bool periodic[3] = { false, false, false };
 
+    // Offsets of the stencil cells which may contain neighbors of the
+    // particles in the center cell.
+    Kokkos::View<int* [3], MemorySpace> offsets;
+
+    // Cubic cells of a size relative to the neighborhood radius.
     LinkedCellStencil( const Scalar neighborhood_radius,
                        const Scalar cell_size_ratio, const Scalar grid_min[3],
                        const Scalar grid_max[3] )
-        : rsqr( neighborhood_radius * neighborhood_radius )
     {
         Scalar dx = neighborhood_radius * cell_size_ratio;
+        const Scalar cell_size[3] = { dx, dx, dx };
+        init( neighborhood_radius, cell_size, grid_min, grid_max );
+    }
+
+    // Cells of a given size in each dimension.
+    LinkedCellStencil( const Scalar neighborhood_radius,
+                       const Scalar cell_size[3], const Scalar grid_min[3],
+                       const Scalar grid_max[3] )
+    {
+        init( neighborhood_radius, cell_size, grid_min, grid_max );
+    }
+
+    void init( const Scalar neighborhood_radius, const Scalar cell_size[3],
+               const Scalar grid_min[3], const Scalar grid_max[3] )
+    {
+        rsqr = neighborhood_radius * neighborhood_radius;
         grid = CartesianGrid<double>( grid_min[0], grid_min[1], grid_min[2],
-                                      grid_max[0], grid_max[1], grid_max[2], dx,
-                                      dx, dx );
-        cell_range = std::ceil( 1 / cell_size_ratio );
-        max_cells_dir = 2 * cell_range + 1;
-        max_cells = max_cells_dir * max_cells_dir * max_cells_dir;
+                                      grid_max[0], grid_max[1], grid_max[2],
+                                      cell_size[0], cell_size[1],
+                                      cell_size[2] );
+
+        // The stencil only spans the grid in dimensions with fewer cells
+        // than the cutoff reaches, such that a dimension with a single cell,
+        // e.g. the third dimension of a 2D problem, adds no stencil cells.
+        int range[3];
+        max_cells = 1;
+        for ( int d = 0; d < 3; ++d )
+        {
+            cell_range[d] = std::ceil( neighborhood_radius / cell_size[d] );
+            max_cells_dir[d] = 2 * cell_range[d] + 1;
+            range[d] = std::min( cell_range[d], grid.numBin( d ) - 1 );
+            max_cells *= 2 * range[d] + 1;
+        }
+
+        // Keep the cells within the cutoff of the center cell. The other
+        // cells of the box, such as its corners, are never reached from
+        // inside the center cell.
+        std::vector<std::array<int, 3>> kept;
+        for ( int i = -range[0]; i <= range[0]; ++i )
+            for ( int j = -range[1]; j <= range[1]; ++j )
+                for ( int k = -range[2]; k <= range[2]; ++k )
+                {
+                    const int ijk[3] = { i, j, k };
+                    double dsqr = 0.0;
+                    for ( int d = 0; d < 3; ++d )
+                    {
+                        double gap = std::max( std::abs( ijk[d] ) - 1, 0 ) *
+                                     cell_size[d];
+                        dsqr += gap * gap;
+                    }
+                    if ( dsqr <= rsqr )
+                        kept.push_back( { i, j, k } );
+                }
+        Kokkos::View<int* [3], Kokkos::HostSpace> host_offsets(
+            "stencil_offsets", kept.size() );
+        for ( std::size_t s = 0; s < kept.size(); ++s )
+            for ( int d = 0; d < 3; ++d )
+                host_offsets( s, d ) = kept[s][d];
+        offsets = Kokkos::create_mirror_view_and_copy( MemorySpace(),
+                                                       host_offsets );
+    }
+
+    // Set the periodic dimensions. The stencil then wraps around the grid in
+    // these dimensions. Every cell may only appear once in a stencil such
+    // that each neighbor is found through a single periodic image.
+    void setPeriodic( const bool is_periodic[3] )
+    {
+        for ( int d = 0; d < 3; ++d )
+        {
+            if ( is_periodic[d] && grid.numBin( d ) < max_cells_dir[d] )
+                throw std::runtime_error(
+                    "Periodic grid is too small for the cell stencil" );
+            periodic[d] = is_periodic[d];
+        }
     }
 
-    // Given a cell, get the index bounds of the cell stencil.
+    // Given a cell, get the index bounds of the cell stencil. In periodic
+    // dimensions the bounds may be outside of the grid and the cells are
+    // wrapped with wrapCell().
     KOKKOS_INLINE_FUNCTION
     void getCells( const int cell, int& imin, int& imax, int& jmin, int& jmax,
                    int& kmin, int& kmax ) const
@@ -182,17 +423,63 @@ struct LinkedCellStencil
         int i, j, k;
         grid.ijkBinIndex( cell, i, j, k );
 
-        kmin = ( k - cell_range > 0 ) ? k - cell_range : 0;
-        kmax =
-            ( k + cell_range + 1 < grid._nz ) ? k + cell_range + 1 : grid._nz;
+        kmin = ( k - cell_range[2] > 0 || periodic[2] ) ? k - cell_range[2]
+                                                        : 0;
+        kmax = ( k + cell_range[2] + 1 < grid._nz || periodic[2] )
+                   ? k + cell_range[2] + 1
+                   : grid._nz;
+
+        jmin = ( j - cell_range[1] > 0 || periodic[1] ) ? j - cell_range[1]
+                                                        : 0;
+        jmax = ( j + cell_range[1] + 1 < grid._ny || periodic[1] )
+                   ? j + cell_range[1] + 1
+                   : grid._ny;
+
+        imin = ( i - cell_range[0] > 0 || periodic[0] ) ? i - cell_range[0]
+                                                        : 0;
+        imax = ( i + cell_range[0] + 1 < grid._nx || periodic[0] )
+                   ? i + cell_range[0] + 1
+                   : grid._nx;
+    }
+
+    // Get the number of cells in the stencil of a cell.
+    KOKKOS_INLINE_FUNCTION
+    int numCell() const { return offsets.extent( 0 ); }
 
-        jmin = ( j - cell_range > 0 ) ? j - cell_range : 0;
-        jmax =
-            ( j + cell_range + 1 < grid._ny ) ? j + cell_range + 1 : grid._ny;
+    // Given the indices of a center cell get a cell of its stencil. Returns
+    // false if the cell is outside of the grid in a non-periodic dimension.
+    // In periodic dimensions the cell may be outside of the grid and is
+    // wrapped with wrapCell().
+    KOKKOS_INLINE_FUNCTION
+    bool getCell( const int ic, const int jc, const int kc, const int s,
+                  int& i, int& j, int& k ) const
+    {
+        i = ic + offsets( s, 0 );
+        j = jc + offsets( s, 1 );
+        k = kc + offsets( s, 2 );
+        return ( periodic[0] || ( i >= 0 && i < grid._nx ) ) &&
+               ( periodic[1] || ( j >= 0 && j < grid._ny ) ) &&
+               ( periodic[2] || ( k >= 0 && k < grid._nz ) );
+    }
 
-        imin = ( i - cell_range > 0 ) ? i - cell_range : 0;
-        imax =
-            ( i + cell_range + 1 < grid._nx ) ? i + cell_range + 1 : grid._nx;
+    // Given a stencil cell get the cell in the grid it is an image of and the
+    // shift from the positions in that cell to the image.
+    KOKKOS_INLINE_FUNCTION
+    void wrapCell( const int i, const int j, const int k, int& iw, int& jw,
+                   int& kw, Scalar shift[3] ) const
+    {
+        const int ijk[3] = { i, j, k };
+        int wrapped[3];
+        for ( int d = 0; d < 3; ++d )
+        {
+            int n = grid.numBin( d );
+            int image = ( ijk[d] < 0 ) ? -1 : ( ijk[d] >= n ) ? 1 : 0;
+            wrapped[d] = ijk[d] - image * n;
+            shift[d] = image * n * grid.cellSize( d );
+        }
+        iw = wrapped[0];
+        jw = wrapped[1];
+        kw = wrapped[2];
     }
 };
 
@@ -217,6 +504,18 @@ struct VerletListBuilder
     // Neighbor cutoff.
     PositionValueType rsqr;
 
+    // Squared per-particle neighbor cutoffs. If empty, all particles use the
+    // uniform cutoff.
+    Kokkos::View<double*, memory_space> radius_sqr;
+
+    // Mixed precision data. Positions relative to the grid origin are kept in
+    // float and the squared distance errors of these are bounded by the
+    // margin.
+    bool mixed_precision;
+    Kokkos::View<float* [3], memory_space> position_f;
+    double origin[3];
+    double rsqr_margin;
+
     // Positions.
     RandomAccessPositionSlice position;
     std::size_t pid_begin, pid_end;
@@ -225,8 +524,13 @@ struct VerletListBuilder
     BinningData<device> bin_data_1d;
     LinkedCellList<device> linked_cell_list;
 
+    // Whether the particles are binned in hashed cells without grid bounds
+    // instead of the linked cells of a grid.
+    bool hashed = false;
+    HashedCellList<device> hashed_cell_list;
+
     // Cell stencil.
-    LinkedCellStencil<PositionValueType> cell_stencil;
+    LinkedCellStencil<PositionValueType, memory_space> cell_stencil;
 
     // Check to count or refill.
     bool refill;
@@ -235,26 +539,75 @@ struct VerletListBuilder
     // Maximum neighbors per particle
     std::size_t max_n;
 
-    // Constructor.
-    VerletListBuilder( PositionSlice slice, const std::size_t begin,
-                       const std::size_t end,
+    // Particles to refill after a 2D list overflowed. If empty, all particles
+    // are filled.
+    Kokkos::View<int*, memory_space> redo;
+
+    // Whether an explicit ghost range was given. Only the owned and ghost
+    // particles are then candidate neighbors.
+    bool ghost_aware = false;
+
+    // Constructor. The particles are binned on the given instance. Without
+    // grid bounds the particles are binned in hashed cells.
+    VerletListBuilder( const execution_space& exec_space, PositionSlice slice,
+                       const std::size_t begin, const std::size_t end,
                        const PositionValueType neighborhood_radius,
                        const PositionValueType cell_size_ratio,
                        const PositionValueType grid_min[3],
                        const PositionValueType grid_max[3],
-                       const std::size_t max_neigh )
-        : pid_begin( begin )
+                       const std::size_t max_neigh,
+                       const bool periodic[3] = nullptr,
+                       Kokkos::View<double*, memory_space> radii_sqr = {},
+                       const bool mixed = false,
+                       const double cell_aspect[3] = nullptr,
+                       const std::size_t ghost_range[2] = nullptr )
+        : radius_sqr( radii_sqr )
+        , mixed_precision( mixed )
+        , pid_begin( begin )
         , pid_end( end )
-        , cell_stencil( neighborhood_radius, cell_size_ratio, grid_min,
-                        grid_max )
+        , cell_stencil( makeStencil( neighborhood_radius, cell_size_ratio,
+                                     cell_aspect, grid_min, grid_max ) )
         , max_n( max_neigh )
     {
         count = true;
         refill = false;
 
-        // Create the count view.
-        _data.counts =
-            Kokkos::View<int*, memory_space>( "num_neighbors", slice.size() );
+        hashed = ( grid_min == nullptr );
+        bool any_periodic = ( periodic != nullptr ) &&
+                            ( periodic[0] || periodic[1] || periodic[2] );
+        if ( hashed && ( any_periodic || mixed ) )
+            throw std::runtime_error( "Periodic grids and mixed precision "
+                                      "require grid bounds" );
+
+        // Wrap the cell stencil in periodic dimensions.
+        if ( periodic != nullptr )
+            cell_stencil.setPeriodic( periodic );
+
+        // Bin all particles unless a ghost range is given, in which case
+        // only the owned and ghost particles are binned.
+        std::size_t bin_begin = 0;
+        std::size_t bin_end = slice.size();
+        if ( ghost_range != nullptr )
+        {
+            ghost_aware = true;
+            bin_begin = begin;
+            bin_end = end;
+            if ( ghost_range[1] > ghost_range[0] )
+            {
+                if ( ghost_range[0] == end )
+                    bin_end = ghost_range[1];
+                else if ( ghost_range[1] == begin )
+                    bin_begin = ghost_range[0];
+                else
+                    throw std::runtime_error(
+                        "Ghost range must be adjacent to the owned range" );
+            }
+        }
+
+        // Create the count view. With a ghost range the particles after the
+        // owned range, usually the ghosts, have no list entries.
+        _data.counts = Kokkos::View<int*, memory_space>(
+            "num_neighbors", ghost_aware ? end : slice.size() );
 
         // Make a guess for the number of neighbors per particle for 2D lists.
         initCounts( LayoutTag() );
@@ -263,17 +616,241 @@ struct VerletListBuilder
         position = slice;
 
         // Bin the particles in the grid. Don't actually sort them but make a
-        // permutation vector. Note that we are binning all particles here and
-        // not just the requested range. This is because all particles are
-        // treated as candidates for neighbors.
-        double grid_size = cell_size_ratio * neighborhood_radius;
-        PositionValueType grid_delta[3] = { grid_size, grid_size, grid_size };
-        linked_cell_list =
-            LinkedCellList<device>( position, grid_delta, grid_min, grid_max );
-        bin_data_1d = linked_cell_list.binningData();
+        // permutation vector. Note that we are binning all candidate
+        // neighbors here and not just the requested range.
+        auto grid_delta =
+            cellSize( neighborhood_radius, cell_size_ratio, cell_aspect );
+        if ( hashed )
+        {
+            hashed_cell_list = HashedCellList<device>(
+                exec_space, position, bin_begin, bin_end, grid_delta.data() );
+            bin_data_1d = hashed_cell_list.binningData();
+        }
+        else
+        {
+            linked_cell_list = LinkedCellList<device>(
+                exec_space, position, bin_begin, bin_end, grid_delta.data(),
+                grid_min, grid_max );
+            bin_data_1d = linked_cell_list.binningData();
+        }
 
         // We will use the square of the distance for neighbor determination.
         rsqr = neighborhood_radius * neighborhood_radius;
+
+        if ( mixed_precision )
+            initMixedPrecision( exec_space, slice, neighborhood_radius,
+                                grid_min, grid_max );
+    }
+
+    // Get the cell size in each dimension. The cells are cubes unless an
+    // aspect ratio scaling each dimension is given.
+    static std::array<PositionValueType, 3>
+    cellSize( const PositionValueType neighborhood_radius,
+              const PositionValueType cell_size_ratio,
+              const double cell_aspect[3] )
+    {
+        std::array<PositionValueType, 3> cell_size;
+        for ( int d = 0; d < 3; ++d )
+        {
+            double aspect = ( cell_aspect != nullptr ) ? cell_aspect[d] : 1.0;
+            cell_size[d] = cell_size_ratio * neighborhood_radius * aspect;
+        }
+        return cell_size;
+    }
+
+    // Create the cell stencil. Hashed cells have no grid bounds and the
+    // stencil is created on a grid just spanning it, such that no stencil
+    // cells are cut off.
+    static LinkedCellStencil<PositionValueType, memory_space>
+    makeStencil( const PositionValueType neighborhood_radius,
+                 const PositionValueType cell_size_ratio,
+                 const double cell_aspect[3],
+                 const PositionValueType grid_min[3],
+                 const PositionValueType grid_max[3] )
+    {
+        auto cell_size =
+            cellSize( neighborhood_radius, cell_size_ratio, cell_aspect );
+        if ( grid_min != nullptr )
+            return LinkedCellStencil<PositionValueType, memory_space>(
+                neighborhood_radius, cell_size.data(), grid_min, grid_max );
+
+        PositionValueType low[3];
+        PositionValueType high[3];
+        for ( int d = 0; d < 3; ++d )
+        {
+            low[d] = 0.0;
+            high[d] = ( 2.0 * std::ceil( neighborhood_radius / cell_size[d] ) +
+                        1.0 ) *
+                      cell_size[d];
+        }
+        return LinkedCellStencil<PositionValueType, memory_space>(
+            neighborhood_radius, cell_size.data(), low, high );
+    }
+
+    // Get the cell of a particle binned in a given cell. The cells sharing a
+    // hashed bin may be 2^21 cells apart, so hashed cells are located from
+    // the particle.
+    KOKKOS_INLINE_FUNCTION
+    void particleCell( const int cell, const double x_p, const double y_p,
+                       const double z_p, std::int64_t ijk[3] ) const
+    {
+        if ( hashed )
+        {
+            hashed_cell_list.locatePoint( x_p, y_p, z_p, ijk[0], ijk[1],
+                                          ijk[2] );
+        }
+        else
+        {
+            int i, j, k;
+            cell_stencil.grid.ijkBinIndex( cell, i, j, k );
+            ijk[0] = i;
+            ijk[1] = j;
+            ijk[2] = k;
+        }
+    }
+
+    // Get the candidate neighbors in a cell of the stencil of a particle.
+    // Returns false if the cell is outside of the grid, beyond the cutoff of
+    // the particle, or an empty hashed cell. The shift is from the positions
+    // in the cell to its periodic image.
+    KOKKOS_INLINE_FUNCTION
+    bool stencilCell( const std::int64_t ijk[3], const int s, const double x_p,
+                      const double y_p, const double z_p,
+                      const double p_rsqr, std::size_t& n_offset, int& num_n,
+                      PositionValueType shift[3] ) const
+    {
+        if ( hashed )
+        {
+            std::int64_t i = ijk[0] + cell_stencil.offsets( s, 0 );
+            std::int64_t j = ijk[1] + cell_stencil.offsets( s, 1 );
+            std::int64_t k = ijk[2] + cell_stencil.offsets( s, 2 );
+            if ( hashed_cell_list.minDistanceToPoint( x_p, y_p, z_p, i, j,
+                                                      k ) > p_rsqr )
+                return false;
+            int cell = hashed_cell_list.findCell( i, j, k );
+            if ( cell < 0 )
+                return false;
+            for ( int d = 0; d < 3; ++d )
+                shift[d] = 0.0;
+            n_offset = hashed_cell_list.binOffset( cell );
+            num_n = hashed_cell_list.binSize( cell );
+            return true;
+        }
+
+        int i, j, k;
+        if ( !cell_stencil.getCell( ijk[0], ijk[1], ijk[2], s, i, j, k ) )
+            return false;
+        if ( cell_stencil.grid.minDistanceToPoint( x_p, y_p, z_p, i, j, k ) >
+             p_rsqr )
+            return false;
+
+        // Get the grid cell of a periodic image.
+        int iw, jw, kw;
+        cell_stencil.wrapCell( i, j, k, iw, jw, kw, shift );
+        n_offset = linked_cell_list.binOffset( iw, jw, kw );
+        num_n = linked_cell_list.binSize( iw, jw, kw );
+        return true;
+    }
+
+    // Store the positions relative to the grid origin in float and bound the
+    // error of the squared float distances. Coordinates, including periodic
+    // images, are within twice the grid extent of the origin.
+    void initMixedPrecision( const execution_space& exec_space,
+                             PositionSlice slice,
+                             const PositionValueType neighborhood_radius,
+                             const PositionValueType grid_min[3],
+                             const PositionValueType grid_max[3] )
+    {
+        double extent = 0.0;
+        for ( int d = 0; d < 3; ++d )
+        {
+            origin[d] = grid_min[d];
+            extent = std::max( extent,
+                               static_cast<double>( grid_max[d] ) - origin[d] );
+        }
+        double unit_round = 0.5 * std::numeric_limits<float>::epsilon();
+        double coord_err = 3.0 * 2.0 * extent * unit_round;
+        double r = neighborhood_radius;
+        rsqr_margin =
+            2.0 * ( 4.0 * r * coord_err + 4.0 * coord_err * coord_err +
+                    8.0 * unit_round * r * r );
+
+        position_f = Kokkos::View<float* [3], memory_space>(
+            Kokkos::ViewAllocateWithoutInitializing(
+                "Cabana::VerletList::position_f" ),
+            slice.size() );
+        auto x_f = position_f;
+        double o[3] = { origin[0], origin[1], origin[2] };
+        Kokkos::parallel_for(
+            "Cabana::VerletList::store_float_positions",
+            Kokkos::RangePolicy<execution_space>( exec_space, 0,
+                                                  slice.size() ),
+            KOKKOS_LAMBDA( const std::size_t p ) {
+                for ( int d = 0; d < 3; ++d )
+                    x_f( p, d ) = static_cast<float>( slice( p, d ) - o[d] );
+            } );
+        exec_space.fence();
+    }
+
+    // Check if a candidate could be a neighbor before checking the distance.
+    // With a ghost range, pairs of owned particles of a half list are
+    // ordered by index, which is cheaper than the coordinate order. Pairs
+    // with a ghost keep the coordinate order such that the neighboring rank
+    // owning the ghost agrees on which of the two stores the pair.
+    KOKKOS_INLINE_FUNCTION
+    bool isCandidate( const std::size_t pid, const double x_p,
+                      const double y_p, const double z_p,
+                      const std::size_t nid, const double x_n,
+                      const double y_n, const double z_n ) const
+    {
+        if ( std::is_same<AlgorithmTag, HalfNeighborTag>::value &&
+             ghost_aware && nid >= pid_begin && nid < pid_end )
+            return nid > pid;
+        return NeighborDiscriminator<AlgorithmTag>::isValid(
+            pid, x_p, y_p, z_p, nid, x_n, y_n, z_n );
+    }
+
+    // Squared neighbor cutoff of a particle. The stencil is sized for the
+    // largest cutoff and culled per particle with this value.
+    KOKKOS_INLINE_FUNCTION
+    double cutoffSquared( const std::size_t pid ) const
+    {
+        return ( radius_sqr.size() > 0 ) ? radius_sqr( pid ) : rsqr;
+    }
+
+    // Check if a candidate is within the cutoff of a particle. With mixed
+    // precision the distance is computed in float and only recomputed in
+    // double within the error margin of the cutoff. Only the candidate
+    // positions are stored in float; the float particle coordinates relative
+    // to the origin are recomputed for each candidate.
+    KOKKOS_INLINE_FUNCTION
+    bool withinCutoff( const std::size_t pid, const double x_p,
+                       const double y_p, const double z_p,
+                       const std::size_t nid ) const
+    {
+        double cutoff = cutoffSquared( pid );
+        if ( mixed_precision )
+        {
+            float dx = static_cast<float>( x_p - origin[0] ) -
+                      position_f( nid, 0 );
+            float dy = static_cast<float>( y_p - origin[1] ) -
+                      position_f( nid, 1 );
+            float dz = static_cast<float>( z_p - origin[2] ) -
+                      position_f( nid, 2 );
+            float dist_sqr = dx * dx + dy * dy + dz * dz;
+            if ( dist_sqr < static_cast<float>( cutoff - rsqr_margin ) )
+                return true;
+            if ( dist_sqr > static_cast<float>( cutoff + rsqr_margin ) )
+                return false;
+        }
+
+        // Calculate the distance between the particle and its candidate
+        // neighbor.
+        PositionValueType dx = x_p - position( nid, 0 );
+        PositionValueType dy = y_p - position( nid, 1 );
+        PositionValueType dz = z_p - position( nid, 2 );
+        PositionValueType dist_sqr = dx * dx + dy * dy + dz * dz;
+        return ( dist_sqr <= cutoff );
     }
 
     // Neighbor count team operator (only used for CSR lists).
@@ -294,10 +871,6 @@ struct VerletListBuilder
         // working on.
         int cell = team.league_rank();
 
-        // Get the stencil for this cell.
-        int imin, imax, jmin, jmax, kmin, kmax;
-        cell_stencil.getCells( cell, imin, imax, jmin, jmax, kmin, kmax );
-
         // Operate on the particles in the bin.
         std::size_t b_offset = bin_data_1d.binOffset( cell );
         Kokkos::parallel_for(
@@ -305,7 +878,7 @@ struct VerletListBuilder
             [&]( const int bi ) {
                 // Get the true particle id. The binned particle index is the
                 // league rank of the team.
-                std::size_t pid = linked_cell_list.permutation( bi + b_offset );
+                std::size_t pid = bin_data_1d.permutation( bi + b_offset );
 
                 if ( ( pid >= pid_begin ) && ( pid < pid_end ) )
                 {
@@ -313,33 +886,34 @@ struct VerletListBuilder
                     double x_p = position( pid, 0 );
                     double y_p = position( pid, 1 );
                     double z_p = position( pid, 2 );
+                    double p_rsqr = cutoffSquared( pid );
+                    std::int64_t ijk[3];
+                    particleCell( cell, x_p, y_p, z_p, ijk );
 
                     // Loop over the cell stencil.
                     int stencil_count = 0;
-                    for ( int i = imin; i < imax; ++i )
-                        for ( int j = jmin; j < jmax; ++j )
-                            for ( int k = kmin; k < kmax; ++k )
-                            {
-                                // See if we should actually check this box for
-                                // neighbors.
-                                if ( cell_stencil.grid.minDistanceToPoint(
-                                         x_p, y_p, z_p, i, j, k ) <= rsqr )
-                                {
-                                    std::size_t n_offset =
-                                        linked_cell_list.binOffset( i, j, k );
-                                    std::size_t num_n =
-                                        linked_cell_list.binSize( i, j, k );
-
-                                    // Check the particles in this bin to see if
-                                    // they are neighbors. If they are add to
-                                    // the count for this bin.
-                                    int cell_count = 0;
-                                    neighbor_reduce( team, pid, x_p, y_p, z_p,
-                                                     n_offset, num_n,
-                                                     cell_count, BuildOpTag() );
-                                    stencil_count += cell_count;
-                                }
-                            }
+                    for ( int s = 0; s < cell_stencil.numCell(); ++s )
+                    {
+                        // See if we should actually check this box for
+                        // neighbors.
+                        std::size_t n_offset;
+                        int num_n;
+                        PositionValueType shift[3];
+                        if ( stencilCell( ijk, s, x_p, y_p, z_p, p_rsqr,
+                                          n_offset, num_n, shift ) )
+                        {
+                            // Check the particles in this bin to see if they
+                            // are neighbors. If they are add to the count for
+                            // this bin. Images are compared by shifting the
+                            // particle.
+                            int cell_count = 0;
+                            neighbor_reduce( team, pid, x_p - shift[0],
+                                             y_p - shift[1], z_p - shift[2],
+                                             n_offset, num_n, cell_count,
+                                             BuildOpTag() );
+                            stencil_count += cell_count;
+                        }
+                    }
                     Kokkos::single( Kokkos::PerThread( team ), [&]() {
                         _data.counts( pid ) = stencil_count;
                     } );
@@ -381,7 +955,7 @@ struct VerletListBuilder
                           int& local_count ) const
     {
         //  Get the true id of the candidate  neighbor.
-        std::size_t nid = linked_cell_list.permutation( n_offset + n );
+        std::size_t nid = bin_data_1d.permutation( n_offset + n );
 
         // Cache the candidate neighbor particle coordinates.
         double x_n = position( nid, 0 );
@@ -389,18 +963,10 @@ struct VerletListBuilder
         double z_n = position( nid, 2 );
 
         // If this could be a valid neighbor, continue.
-        if ( NeighborDiscriminator<AlgorithmTag>::isValid(
-                 pid, x_p, y_p, z_p, nid, x_n, y_n, z_n ) )
+        if ( isCandidate( pid, x_p, y_p, z_p, nid, x_n, y_n, z_n ) )
         {
-            // Calculate the distance between the particle and its candidate
-            // neighbor.
-            PositionValueType dx = x_p - x_n;
-            PositionValueType dy = y_p - y_n;
-            PositionValueType dz = z_p - z_n;
-            PositionValueType dist_sqr = dx * dx + dy * dy + dz * dz;
-
             // If within the cutoff add to the count.
-            if ( dist_sqr <= rsqr )
+            if ( withinCutoff( pid, x_p, y_p, z_p, nid ) )
                 local_count += 1;
         }
     }
@@ -436,7 +1002,7 @@ struct VerletListBuilder
         }
     }
 
-    void processCounts( VerletLayoutCSR )
+    void processCounts( const execution_space& exec_space, VerletLayoutCSR )
     {
         // Allocate offsets.
         _data.offsets = Kokkos::View<int*, memory_space>(
@@ -449,10 +1015,10 @@ struct VerletListBuilder
         offset_op.offsets = _data.offsets;
         int total_num_neighbor;
         Kokkos::RangePolicy<execution_space> range_policy(
-            0, _data.counts.extent( 0 ) );
+            exec_space, 0, _data.counts.extent( 0 ) );
         Kokkos::parallel_scan( "Cabana::VerletListBuilder::offset_scan",
                                range_policy, offset_op, total_num_neighbor );
-        Kokkos::fence();
+        exec_space.fence();
 
         // Allocate the neighbor list.
         _data.neighbors = Kokkos::View<int*, memory_space>(
@@ -460,12 +1026,12 @@ struct VerletListBuilder
             total_num_neighbor );
 
         // Reset the counts. We count again when we fill.
-        Kokkos::deep_copy( _data.counts, 0 );
+        Kokkos::deep_copy( exec_space, _data.counts, 0 );
     }
 
     // Process 2D counts by computing the maximum number of neighbors and
     // reallocating the 2D data structure if needed.
-    void processCounts( VerletLayout2D )
+    void processCounts( const execution_space& exec_space, VerletLayout2D )
     {
         // Calculate the maximum number of neighbors.
         auto counts = _data.counts;
@@ -473,24 +1039,59 @@ struct VerletListBuilder
         Kokkos::Max<int> max_reduce( max_num_neighbor );
         Kokkos::parallel_reduce(
             "Cabana::VerletListBuilder::reduce_max",
-            Kokkos::RangePolicy<execution_space>( 0, _data.counts.size() ),
+            Kokkos::RangePolicy<execution_space>( exec_space, 0,
+                                                  _data.counts.size() ),
             KOKKOS_LAMBDA( const int i, int& value ) {
                 if ( counts( i ) > value )
                     value = counts( i );
             },
             max_reduce );
-        Kokkos::fence();
+        exec_space.fence();
 
-        // Reallocate the neighbor list if previous size is exceeded.
-        if ( count or ( std::size_t )
-                              max_num_neighbor > _data.neighbors.extent( 1 ) )
+        // Allocate the neighbor list after counting.
+        if ( count )
         {
             refill = true;
-            Kokkos::deep_copy( _data.counts, 0 );
+            Kokkos::deep_copy( exec_space, _data.counts, 0 );
             _data.neighbors = Kokkos::View<int**, memory_space>(
                 Kokkos::ViewAllocateWithoutInitializing( "neighbors" ),
                 _data.counts.size(), max_num_neighbor );
         }
+
+        // Reallocate the neighbor list if the previous size is exceeded. The
+        // neighbors of particles that fit are kept and only the particles
+        // that overflowed are refilled.
+        else if ( static_cast<std::size_t>( max_num_neighbor ) >
+                  _data.neighbors.extent( 1 ) )
+        {
+            refill = true;
+            auto old_neighbors = _data.neighbors;
+            std::size_t old_max = old_neighbors.extent( 1 );
+            Kokkos::View<int**, memory_space> neighbors(
+                Kokkos::ViewAllocateWithoutInitializing( "neighbors" ),
+                _data.counts.size(), max_num_neighbor );
+            redo = Kokkos::View<int*, memory_space>( "redo",
+                                                     _data.counts.size() );
+            auto redo_ids = redo;
+            Kokkos::parallel_for(
+                "Cabana::VerletListBuilder::copy_neighbors",
+                Kokkos::RangePolicy<execution_space>( exec_space, 0,
+                                                      _data.counts.size() ),
+                KOKKOS_LAMBDA( const int i ) {
+                    if ( static_cast<std::size_t>( counts( i ) ) > old_max )
+                    {
+                        redo_ids( i ) = 1;
+                        counts( i ) = 0;
+                    }
+                    else
+                    {
+                        for ( int n = 0; n < counts( i ); ++n )
+                            neighbors( i, n ) = old_neighbors( i, n );
+                    }
+                } );
+            exec_space.fence();
+            _data.neighbors = neighbors;
+        }
     }
 
     // Neighbor count team operator.
@@ -510,10 +1111,6 @@ struct VerletListBuilder
         // working on.
         int cell = team.league_rank();
 
-        // Get the stencil for this cell.
-        int imin, imax, jmin, jmax, kmin, kmax;
-        cell_stencil.getCells( cell, imin, imax, jmin, jmax, kmin, kmax );
-
         // Operate on the particles in the bin.
         std::size_t b_offset = bin_data_1d.binOffset( cell );
         Kokkos::parallel_for(
@@ -521,36 +1118,38 @@ struct VerletListBuilder
             [&]( const int bi ) {
                 // Get the true particle id. The binned particle index is the
                 // league rank of the team.
-                std::size_t pid = linked_cell_list.permutation( bi + b_offset );
+                std::size_t pid = bin_data_1d.permutation( bi + b_offset );
 
-                if ( ( pid >= pid_begin ) && ( pid < pid_end ) )
+                if ( ( pid >= pid_begin ) && ( pid < pid_end ) &&
+                     ( 0 == redo.size() || redo( pid ) ) )
                 {
                     // Cache the particle coordinates.
                     double x_p = position( pid, 0 );
                     double y_p = position( pid, 1 );
                     double z_p = position( pid, 2 );
+                    double p_rsqr = cutoffSquared( pid );
+                    std::int64_t ijk[3];
+                    particleCell( cell, x_p, y_p, z_p, ijk );
 
                     // Loop over the cell stencil.
-                    for ( int i = imin; i < imax; ++i )
-                        for ( int j = jmin; j < jmax; ++j )
-                            for ( int k = kmin; k < kmax; ++k )
-                            {
-                                // See if we should actually check this box for
-                                // neighbors.
-                                if ( cell_stencil.grid.minDistanceToPoint(
-                                         x_p, y_p, z_p, i, j, k ) <= rsqr )
-                                {
-                                    // Check the particles in this bin to see if
-                                    // they are neighbors.
-                                    std::size_t n_offset =
-                                        linked_cell_list.binOffset( i, j, k );
-                                    int num_n =
-                                        linked_cell_list.binSize( i, j, k );
-                                    neighbor_for( team, pid, x_p, y_p, z_p,
-                                                  n_offset, num_n,
-                                                  BuildOpTag() );
-                                }
-                            }
+                    for ( int s = 0; s < cell_stencil.numCell(); ++s )
+                    {
+                        // See if we should actually check this box for
+                        // neighbors.
+                        std::size_t n_offset;
+                        int num_n;
+                        PositionValueType shift[3];
+                        if ( stencilCell( ijk, s, x_p, y_p, z_p, p_rsqr,
+                                          n_offset, num_n, shift ) )
+                        {
+                            // Check the particles in this bin to see if they
+                            // are neighbors. Images are compared by shifting
+                            // the particle.
+                            neighbor_for( team, pid, x_p - shift[0],
+                                          y_p - shift[1], z_p - shift[2],
+                                          n_offset, num_n, BuildOpTag() );
+                        }
+                    }
                 }
             } );
     }
@@ -588,7 +1187,7 @@ struct VerletListBuilder
                           const int n ) const
     {
         //  Get the true id of the candidate neighbor.
-        std::size_t nid = linked_cell_list.permutation( n_offset + n );
+        std::size_t nid = bin_data_1d.permutation( n_offset + n );
 
         // Cache the candidate neighbor particle coordinates.
         double x_n = position( nid, 0 );
@@ -596,19 +1195,11 @@ struct VerletListBuilder
         double z_n = position( nid, 2 );
 
         // If this could be a valid neighbor, continue.
-        if ( NeighborDiscriminator<AlgorithmTag>::isValid(
-                 pid, x_p, y_p, z_p, nid, x_n, y_n, z_n ) )
+        if ( isCandidate( pid, x_p, y_p, z_p, nid, x_n, y_n, z_n ) )
         {
-            // Calculate the distance between the particle and its candidate
-            // neighbor.
-            PositionValueType dx = x_p - x_n;
-            PositionValueType dy = y_p - y_n;
-            PositionValueType dz = z_p - z_n;
-            PositionValueType dist_sqr = dx * dx + dy * dy + dz * dz;
-
             // If within the cutoff increment the neighbor count and add as a
             // neighbor at that index.
-            if ( dist_sqr <= rsqr )
+            if ( withinCutoff( pid, x_p, y_p, z_p, nid ) )
             {
                 _data.addNeighbor( pid, nid );
             }
@@ -617,61 +1208,550 @@ struct VerletListBuilder
 };
 
 //---------------------------------------------------------------------------//
-
-//! \endcond
-} // end namespace Impl
-
+// Verlet Cluster List Builder
 //---------------------------------------------------------------------------//
-/*!
-  \brief Neighbor list implementation based on binning particles on a 3d
-  Cartesian grid with cells of the same size as the interaction distance.
-
-  \tparam MemorySpace The Kokkos memory space for storing the neighbor list.
-
-  \tparam AlgorithmTag Tag indicating whether to build a full or half neighbor
-  list.
-
-  \tparam LayoutTag Tag indicating whether to use a CSR or 2D data layout.
-
-  \tparam BuildTag Tag indicating whether to use hierarchical team or team
-  vector parallelism when building neighbor lists.
-
-  Neighbor list implementation most appropriate for somewhat regularly
-  distributed particles due to the use of a Cartesian grid.
-*/
-template <class MemorySpace, class AlgorithmTag, class LayoutTag,
-          class BuildTag = TeamVectorOpTag>
-class VerletList
+template <class DeviceType, class PositionSlice, class AlgorithmTag,
+          std::size_t ClusterSize>
+struct VerletClusterListBuilder
 {
-  public:
-    static_assert( Kokkos::is_memory_space<MemorySpace>::value, "" );
+    // Types.
+    using device = DeviceType;
+    using PositionValueType = typename PositionSlice::value_type;
+    using RandomAccessPositionSlice =
+        typename PositionSlice::random_access_slice;
+    using memory_space = typename device::memory_space;
+    using execution_space = typename device::execution_space;
+    using data_type =
+        VerletListData<memory_space, VerletLayoutCluster<ClusterSize>>;
+    using mask_type = typename data_type::mask_type;
 
-    //! Kokkos memory space in which the neighbor list data resides.
-    using memory_space = MemorySpace;
+    // List data.
+    data_type _data;
 
-    //! Kokkos default execution space for this memory space.
-    using execution_space = typename memory_space::execution_space;
+    // Neighbor cutoff.
+    PositionValueType radius;
+    PositionValueType rsqr;
 
-    //! Kokkos device type with the default execution_space.
-    using device_type [[deprecated]] = typename memory_space::device_type;
+    // Positions.
+    RandomAccessPositionSlice position;
+    std::size_t pid_begin, pid_end;
+    std::size_t num_particle;
 
-    //! Verlet list data.
-    VerletListData<memory_space, LayoutTag> _data;
+    // Binning Data.
+    BinningData<device> bin_data_1d;
+    LinkedCellList<device> linked_cell_list;
+    CartesianGrid<double> grid;
 
-    /*!
-      \brief Default constructor.
-    */
-    VerletList() {}
+    // Cluster bounding boxes ordered as (min_x, min_y, min_z, max_x, max_y,
+    // max_z).
+    Kokkos::View<double* [6], memory_space> bounds;
+
+    // Constructor. The particles are binned on the given instance.
+    VerletClusterListBuilder( const execution_space& exec_space,
+                              PositionSlice slice, const std::size_t begin,
+                              const std::size_t end,
+                              const PositionValueType neighborhood_radius,
+                              const PositionValueType cell_size_ratio,
+                              const PositionValueType grid_min[3],
+                              const PositionValueType grid_max[3] )
+        : radius( neighborhood_radius )
+        , rsqr( neighborhood_radius * neighborhood_radius )
+        , pid_begin( begin )
+        , pid_end( end )
+        , num_particle( slice.size() )
+    {
+        // Get the positions with random access read-only memory.
+        position = slice;
 
-    /*!
-      \brief VerletList constructor. Given a list of particle positions and
-      a neighborhood radius calculate the neighbor list.
+        // Bin all particles in the grid. Consecutive binned particles form
+        // the clusters such that clusters are spatially compact.
+        double grid_size = cell_size_ratio * neighborhood_radius;
+        PositionValueType grid_delta[3] = { grid_size, grid_size, grid_size };
+        linked_cell_list = LinkedCellList<device>(
+            exec_space, position, grid_delta, grid_min, grid_max );
+        bin_data_1d = linked_cell_list.binningData();
+        grid = CartesianGrid<double>( grid_min[0], grid_min[1], grid_min[2],
+                                      grid_max[0], grid_max[1], grid_max[2],
+                                      grid_size, grid_size, grid_size );
+
+        // Allocate the cluster data.
+        std::size_t num_cluster =
+            ( num_particle + ClusterSize - 1 ) / ClusterSize;
+        _data.cluster_particles = Kokkos::View<int*, memory_space>(
+            Kokkos::ViewAllocateWithoutInitializing( "cluster_particles" ),
+            num_cluster * ClusterSize );
+        _data.counts = Kokkos::View<int*, memory_space>(
+            "num_neighbor_clusters", num_cluster );
+        _data.offsets = Kokkos::View<int*, memory_space>(
+            Kokkos::ViewAllocateWithoutInitializing(
+                "neighbor_cluster_offsets" ),
+            num_cluster );
+        bounds = Kokkos::View<double* [6], memory_space>(
+            Kokkos::ViewAllocateWithoutInitializing( "cluster_bounds" ),
+            num_cluster );
+    }
 
-      \param x The slice containing the particle positions
+    // Build the list.
+    void build( const execution_space& exec_space )
+    {
+        std::size_t num_cluster = _data.numCluster();
 
-      \param begin The beginning particle index to compute neighbors for.
+        Kokkos::parallel_for(
+            "Cabana::VerletList::create_clusters",
+            Kokkos::RangePolicy<execution_space, CreateClustersTag>(
+                exec_space, 0, num_cluster ),
+            *this );
 
-      \param end The end particle index to compute neighbors for.
+        Kokkos::parallel_for(
+            "Cabana::VerletList::count_neighbor_clusters",
+            Kokkos::RangePolicy<execution_space, CountNeighborsTag>(
+                exec_space, 0, num_cluster ),
+            *this );
+
+        // Calculate offsets from counts and the total number of neighbor
+        // clusters.
+        OffsetScanOp offset_op;
+        offset_op.counts = _data.counts;
+        offset_op.offsets = _data.offsets;
+        int total_num_neighbor;
+        Kokkos::parallel_scan(
+            "Cabana::VerletClusterListBuilder::offset_scan",
+            Kokkos::RangePolicy<execution_space>( exec_space, 0, num_cluster ),
+            offset_op, total_num_neighbor );
+        exec_space.fence();
+
+        // Allocate and fill the neighbor clusters.
+        _data.neighbors = Kokkos::View<int*, memory_space>(
+            Kokkos::ViewAllocateWithoutInitializing( "neighbor_clusters" ),
+            total_num_neighbor );
+        _data.masks = Kokkos::View<mask_type*, memory_space>(
+            Kokkos::ViewAllocateWithoutInitializing( "neighbor_masks" ),
+            total_num_neighbor );
+        Kokkos::parallel_for(
+            "Cabana::VerletList::fill_neighbor_clusters",
+            Kokkos::RangePolicy<execution_space, FillNeighborsTag>(
+                exec_space, 0, num_cluster ),
+            *this );
+        exec_space.fence();
+    }
+
+    // Cluster creation operator. Assign the binned particles to clusters and
+    // compute the cluster bounding boxes.
+    struct CreateClustersTag
+    {
+    };
+    KOKKOS_INLINE_FUNCTION
+    void operator()( const CreateClustersTag&, const int c ) const
+    {
+        // The first particle of a cluster always exists.
+        double xmin[3];
+        double xmax[3];
+        int first_pid = linked_cell_list.permutation( c * ClusterSize );
+        for ( int d = 0; d < 3; ++d )
+            xmin[d] = xmax[d] = position( first_pid, d );
+
+        for ( std::size_t a = 0; a < ClusterSize; ++a )
+        {
+            std::size_t b = c * ClusterSize + a;
+            int pid = -1;
+            if ( b < num_particle )
+            {
+                pid = linked_cell_list.permutation( b );
+                for ( int d = 0; d < 3; ++d )
+                {
+                    double x = position( pid, d );
+                    xmin[d] = ( x < xmin[d] ) ? x : xmin[d];
+                    xmax[d] = ( x > xmax[d] ) ? x : xmax[d];
+                }
+            }
+            _data.cluster_particles( b ) = pid;
+        }
+
+        for ( int d = 0; d < 3; ++d )
+        {
+            bounds( c, d ) = xmin[d];
+            bounds( c, d + 3 ) = xmax[d];
+        }
+    }
+
+    // Get the interaction mask of a cluster pair.
+    KOKKOS_INLINE_FUNCTION
+    mask_type pairMask( const int c, const int nc ) const
+    {
+        mask_type mask = 0;
+        for ( std::size_t a = 0; a < ClusterSize; ++a )
+        {
+            int pid = _data.cluster_particles( c * ClusterSize + a );
+            if ( pid < 0 || static_cast<std::size_t>( pid ) < pid_begin ||
+                 static_cast<std::size_t>( pid ) >= pid_end )
+                continue;
+
+            double x_p = position( pid, 0 );
+            double y_p = position( pid, 1 );
+            double z_p = position( pid, 2 );
+            for ( std::size_t b = 0; b < ClusterSize; ++b )
+            {
+                int nid = _data.cluster_particles( nc * ClusterSize + b );
+                if ( nid < 0 )
+                    continue;
+
+                double x_n = position( nid, 0 );
+                double y_n = position( nid, 1 );
+                double z_n = position( nid, 2 );
+                if ( NeighborDiscriminator<AlgorithmTag>::isValid(
+                         pid, x_p, y_p, z_p, nid, x_n, y_n, z_n ) )
+                {
+                    PositionValueType dx = x_p - x_n;
+                    PositionValueType dy = y_p - y_n;
+                    PositionValueType dz = z_p - z_n;
+                    PositionValueType dist_sqr = dx * dx + dy * dy + dz * dz;
+                    if ( dist_sqr <= rsqr )
+                        mask |= mask_type( 1 ) << ( a * ClusterSize + b );
+                }
+            }
+        }
+        return mask;
+    }
+
+    // Get the square of the minimum distance between two cluster bounding
+    // boxes.
+    KOKKOS_INLINE_FUNCTION
+    double boundsDistanceSquared( const int c, const int nc ) const
+    {
+        double dist_sqr = 0.0;
+        for ( int d = 0; d < 3; ++d )
+        {
+            double dx = 0.0;
+            if ( bounds( nc, d ) > bounds( c, d + 3 ) )
+                dx = bounds( nc, d ) - bounds( c, d + 3 );
+            else if ( bounds( c, d ) > bounds( nc, d + 3 ) )
+                dx = bounds( c, d ) - bounds( nc, d + 3 );
+            dist_sqr += dx * dx;
+        }
+        return dist_sqr;
+    }
+
+    // Visit all neighbor clusters of a cluster with a nonzero interaction
+    // mask. Candidates are the clusters holding particles in the cells that
+    // overlap the cluster bounding box extended by the cutoff. Cells are
+    // visited in cardinal order such that the cluster ranges of the cells are
+    // non-decreasing and each candidate is checked once.
+    template <class VisitorType>
+    KOKKOS_INLINE_FUNCTION void
+    visitNeighborClusters( const int c, const VisitorType& visitor ) const
+    {
+        int cmin[3];
+        int cmax[3];
+        grid.locatePoint( bounds( c, 0 ) - radius, bounds( c, 1 ) - radius,
+                          bounds( c, 2 ) - radius, cmin[0], cmin[1], cmin[2] );
+        grid.locatePoint( bounds( c, 3 ) + radius, bounds( c, 4 ) + radius,
+                          bounds( c, 5 ) + radius, cmax[0], cmax[1], cmax[2] );
+        for ( int d = 0; d < 3; ++d )
+        {
+            int num_cell = grid.numBin( d );
+            cmin[d] = ( cmin[d] < 0 ) ? 0 : cmin[d];
+            cmax[d] = ( cmax[d] < num_cell ) ? cmax[d] : num_cell - 1;
+        }
+
+        int last_cluster = -1;
+        for ( int i = cmin[0]; i <= cmax[0]; ++i )
+            for ( int j = cmin[1]; j <= cmax[1]; ++j )
+                for ( int k = cmin[2]; k <= cmax[2]; ++k )
+                {
+                    int cell = grid.cardinalCellIndex( i, j, k );
+                    int size = bin_data_1d.binSize( cell );
+                    if ( size == 0 )
+                        continue;
+
+                    int offset = bin_data_1d.binOffset( cell );
+                    int first = offset / ClusterSize;
+                    int last = ( offset + size - 1 ) / ClusterSize;
+                    first = ( first > last_cluster ) ? first : last_cluster + 1;
+                    for ( int nc = first; nc <= last; ++nc )
+                    {
+                        if ( boundsDistanceSquared( c, nc ) > rsqr )
+                            continue;
+                        mask_type mask = pairMask( c, nc );
+                        if ( mask != 0 )
+                            visitor( nc, mask );
+                    }
+                    last_cluster =
+                        ( last > last_cluster ) ? last : last_cluster;
+                }
+    }
+
+    // Check if any particle of a cluster is in the range to compute
+    // neighbors for.
+    KOKKOS_INLINE_FUNCTION
+    bool inRange( const int c ) const
+    {
+        for ( std::size_t a = 0; a < ClusterSize; ++a )
+        {
+            int pid = _data.cluster_particles( c * ClusterSize + a );
+            if ( pid >= 0 && static_cast<std::size_t>( pid ) >= pid_begin &&
+                 static_cast<std::size_t>( pid ) < pid_end )
+                return true;
+        }
+        return false;
+    }
+
+    // Neighbor cluster count operator.
+    struct CountNeighborsTag
+    {
+    };
+    KOKKOS_INLINE_FUNCTION
+    void operator()( const CountNeighborsTag&, const int c ) const
+    {
+        if ( !inRange( c ) )
+            return;
+        int count = 0;
+        visitNeighborClusters( c, [&]( const int, const mask_type ) {
+            ++count;
+        } );
+        _data.counts( c ) = count;
+    }
+
+    // Neighbor cluster fill operator.
+    struct FillNeighborsTag
+    {
+    };
+    KOKKOS_INLINE_FUNCTION
+    void operator()( const FillNeighborsTag&, const int c ) const
+    {
+        if ( !inRange( c ) )
+            return;
+        int n = _data.offsets( c );
+        visitNeighborClusters( c, [&]( const int nc, const mask_type mask ) {
+            _data.neighbors( n ) = nc;
+            _data.masks( n ) = mask;
+            ++n;
+        } );
+    }
+
+    // Offset scan over the neighbor cluster counts.
+    struct OffsetScanOp
+    {
+        Kokkos::View<int*, memory_space> counts;
+        Kokkos::View<int*, memory_space> offsets;
+        KOKKOS_INLINE_FUNCTION
+        void operator()( const int i, int& update, const bool final_pass ) const
+        {
+            if ( final_pass )
+                offsets( i ) = update;
+            update += counts( i );
+        }
+    };
+};
+
+//---------------------------------------------------------------------------//
+// Compress a CSR neighbor list into 16-bit neighbor index differences.
+template <class ExecutionSpace, class MemorySpace>
+VerletListData<MemorySpace, VerletLayoutCompressed>
+compressVerletList( const ExecutionSpace& exec_space,
+                    const VerletListData<MemorySpace, VerletLayoutCSR>& csr )
+{
+    using data_type = VerletListData<MemorySpace, VerletLayoutCompressed>;
+    data_type data;
+    data.counts = csr.counts;
+    data.offsets = csr.offsets;
+    data.deltas = Kokkos::View<std::int16_t*, MemorySpace>(
+        Kokkos::ViewAllocateWithoutInitializing( "neighbor_deltas" ),
+        csr.neighbors.extent( 0 ) );
+    std::size_t num_particle = csr.counts.extent( 0 );
+    data.far_offsets = Kokkos::View<int*, MemorySpace>(
+        Kokkos::ViewAllocateWithoutInitializing( "far_neighbor_offsets" ),
+        num_particle + 1 );
+    Kokkos::View<int*, MemorySpace> far_counts(
+        Kokkos::ViewAllocateWithoutInitializing( "far_neighbor_counts" ),
+        num_particle );
+
+    // Encode the neighbors and count those outside of the 16-bit window.
+    auto encode_func = KOKKOS_LAMBDA( const int p )
+    {
+        int num_far = 0;
+        for ( int n = 0; n < data.counts( p ); ++n )
+        {
+            int delta = csr.neighbors( data.offsets( p ) + n ) - p;
+            if ( delta > 32767 || delta <= data_type::far_delta )
+            {
+                data.deltas( data.offsets( p ) + n ) = data_type::far_delta;
+                ++num_far;
+            }
+            else
+            {
+                data.deltas( data.offsets( p ) + n ) = delta;
+            }
+        }
+        far_counts( p ) = num_far;
+    };
+    Kokkos::parallel_for(
+        "Cabana::VerletList::encode_neighbors",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_particle ),
+        encode_func );
+    exec_space.fence();
+
+    // Compute the far neighbor offsets.
+    auto offset_scan = KOKKOS_LAMBDA( const int p, int& update,
+                                      const bool final_pass )
+    {
+        if ( final_pass )
+            data.far_offsets( p ) = update;
+        if ( p < static_cast<int>( num_particle ) )
+            update += far_counts( p );
+    };
+    int num_far;
+    Kokkos::parallel_scan(
+        "Cabana::VerletList::far_neighbor_scan",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_particle + 1 ),
+        offset_scan, num_far );
+    exec_space.fence();
+
+    // Store the far neighbors with their full index.
+    data.far_slots = Kokkos::View<int*, MemorySpace>(
+        Kokkos::ViewAllocateWithoutInitializing( "far_neighbor_slots" ),
+        num_far );
+    data.far_neighbors = Kokkos::View<int*, MemorySpace>(
+        Kokkos::ViewAllocateWithoutInitializing( "far_neighbors" ), num_far );
+    if ( num_far > 0 )
+    {
+        auto far_func = KOKKOS_LAMBDA( const int p )
+        {
+            int f = data.far_offsets( p );
+            for ( int n = 0; n < data.counts( p ); ++n )
+            {
+                if ( data.deltas( data.offsets( p ) + n ) ==
+                     data_type::far_delta )
+                {
+                    data.far_slots( f ) = n;
+                    data.far_neighbors( f ) =
+                        csr.neighbors( data.offsets( p ) + n );
+                    ++f;
+                }
+            }
+        };
+        Kokkos::parallel_for(
+            "Cabana::VerletList::fill_far_neighbors",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_particle ),
+            far_func );
+        exec_space.fence();
+    }
+
+    return data;
+}
+
+//---------------------------------------------------------------------------//
+// Copy particle positions into a reference position snapshot.
+template <class ExecutionSpace, class PositionSlice, class ReferenceView>
+void copyReferencePositions( const ExecutionSpace& exec_space,
+                             const PositionSlice& x,
+                             const ReferenceView& reference )
+{
+    auto copy_func = KOKKOS_LAMBDA( const std::size_t p )
+    {
+        for ( int d = 0; d < 3; ++d )
+            reference( p, d ) = x( p, d );
+    };
+    Kokkos::parallel_for(
+        "Cabana::VerletList::copy_reference_positions",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, x.size() ),
+        copy_func );
+    exec_space.fence();
+}
+
+//---------------------------------------------------------------------------//
+// Get the largest squared distance any particle moved from its reference
+// position.
+template <class ExecutionSpace, class PositionSlice, class ReferenceView>
+double maxDisplacementSquared( const ExecutionSpace& exec_space,
+                               const PositionSlice& x,
+                               const ReferenceView& reference )
+{
+    double max_dist_sqr = 0.0;
+    auto displacement_func =
+        KOKKOS_LAMBDA( const std::size_t p, double& result )
+    {
+        double dist_sqr = 0.0;
+        for ( int d = 0; d < 3; ++d )
+        {
+            double dx = x( p, d ) - reference( p, d );
+            dist_sqr += dx * dx;
+        }
+        if ( dist_sqr > result )
+            result = dist_sqr;
+    };
+    Kokkos::parallel_reduce( "Cabana::VerletList::max_displacement",
+                             Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                                                  x.size() ),
+                             displacement_func,
+                             Kokkos::Max<double>( max_dist_sqr ) );
+    return max_dist_sqr;
+}
+
+//---------------------------------------------------------------------------//
+
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Neighbor list implementation based on binning particles on a 3d
+  Cartesian grid with cells of the same size as the interaction distance.
+
+  \tparam MemorySpace The Kokkos memory space for storing the neighbor list.
+
+  \tparam AlgorithmTag Tag indicating whether to build a full or half neighbor
+  list.
+
+  \tparam LayoutTag Tag indicating whether to use a CSR, 2D, compressed, or
+  cluster-pair data layout.
+
+  \tparam BuildTag Tag indicating whether to use hierarchical team or team
+  vector parallelism when building neighbor lists.
+
+  Neighbor list implementation most appropriate for somewhat regularly
+  distributed particles due to the use of a Cartesian grid.
+
+  The list keeps the parameters of the last build. This allows the list to
+  be used with a Verlet skin: build it with a neighborhood radius of the
+  interaction cutoff plus the skin and call updateIfNeeded() each step to
+  only rebuild once a particle has moved more than half the skin. The
+  positions of the particles at the build are only kept once
+  updateIfNeeded() was called, such that lists which are never updated do
+  not pay for the copy. The first update therefore always rebuilds.
+*/
+template <class MemorySpace, class AlgorithmTag, class LayoutTag,
+          class BuildTag = TeamVectorOpTag>
+class VerletList
+{
+  public:
+    static_assert( Kokkos::is_memory_space<MemorySpace>::value, "" );
+
+    //! Kokkos memory space in which the neighbor list data resides.
+    using memory_space = MemorySpace;
+
+    //! Kokkos default execution space for this memory space.
+    using execution_space = typename memory_space::execution_space;
+
+    //! Kokkos device type with the default execution_space.
+    using device_type [[deprecated]] = typename memory_space::device_type;
+
+    //! Verlet list data.
+    VerletListData<memory_space, LayoutTag> _data;
+
+    /*!
+      \brief Default constructor.
+    */
+    VerletList() {}
+
+    /*!
+      \brief VerletList constructor. Given a list of particle positions and
+      a neighborhood radius calculate the neighbor list.
+
+      \param x The slice containing the particle positions
+
+      \param begin The beginning particle index to compute neighbors for.
+
+      \param end The end particle index to compute neighbors for.
 
       \param neighborhood_radius The radius of the neighborhood. Particles
       within this radius are considered neighbors. This is effectively the
@@ -690,66 +1770,623 @@ class VerletList
 
       \param max_neigh Optional maximum number of neighbors per particle to
       pre-allocate the neighbor list. Potentially avoids recounting with 2D
-      layout only.
+      layout only. If not given, rebuilds of 2D lists use the allocation size
+      of the previous build.
+
+      Particles outside of the neighborhood radius will not be considered
+      neighbors. Only compute the neighbors of those that are within the given
+      range. All particles are candidates for being a neighbor, regardless of
+      whether or not they are in the range.
+    */
+    template <class PositionSlice>
+    VerletList( PositionSlice x, const std::size_t begin, const std::size_t end,
+                const typename PositionSlice::value_type neighborhood_radius,
+                const typename PositionSlice::value_type cell_size_ratio,
+                const typename PositionSlice::value_type grid_min[3],
+                const typename PositionSlice::value_type grid_max[3],
+                const std::size_t max_neigh = 0,
+                typename std::enable_if<( is_slice<PositionSlice>::value ),
+                                        int>::type* = 0 )
+    {
+        build( x, begin, end, neighborhood_radius, cell_size_ratio, grid_min,
+               grid_max, max_neigh );
+    };
+
+    /*!
+      \brief Given a list of particle positions and a neighborhood radius
+      calculate the neighbor list.
+    */
+    template <class PositionSlice>
+    void build( PositionSlice x, const std::size_t begin, const std::size_t end,
+                const typename PositionSlice::value_type neighborhood_radius,
+                const typename PositionSlice::value_type cell_size_ratio,
+                const typename PositionSlice::value_type grid_min[3],
+                const typename PositionSlice::value_type grid_max[3],
+                const std::size_t max_neigh = 0 )
+    {
+        // Use the default execution space.
+        build( execution_space{}, x, begin, end, neighborhood_radius,
+               cell_size_ratio, grid_min, grid_max, max_neigh );
+    }
+    /*!
+      \brief Given a list of particle positions and a neighborhood radius
+      calculate the neighbor list on the given execution space instance. Only
+      that instance is fenced.
+    */
+    template <class PositionSlice, class ExecutionSpace>
+    void build( const ExecutionSpace& exec_space, PositionSlice x,
+                const std::size_t begin, const std::size_t end,
+                const typename PositionSlice::value_type neighborhood_radius,
+                const typename PositionSlice::value_type cell_size_ratio,
+                const typename PositionSlice::value_type grid_min[3],
+                const typename PositionSlice::value_type grid_max[3],
+                const std::size_t max_neigh = 0 )
+    {
+        Impl::ScopedProfileRegion region( "Cabana::VerletList::build" );
+
+        _radius_sqr = Kokkos::View<double*, memory_space>();
+        buildList( exec_space, x, begin, end, neighborhood_radius,
+                   cell_size_ratio, grid_min, grid_max, max_neigh );
+    }
+
+    /*!
+      \brief VerletList constructor for an unbounded domain. Given a list of
+      particle positions and a neighborhood radius calculate the neighbor
+      list without grid bounds.
+
+      \param x The slice containing the particle positions
+
+      \param begin The beginning particle index to compute neighbors for.
+
+      \param end The end particle index to compute neighbors for.
+
+      \param neighborhood_radius The radius of the neighborhood. Particles
+      within this radius are considered neighbors.
+
+      \param cell_size_ratio The ratio of the cell size to the neighborhood
+      radius.
+
+      \param max_neigh Optional maximum number of neighbors per particle to
+      pre-allocate the neighbor list.
+
+      The particles are binned in a HashedCellList, such that the memory of
+      the cells scales with the number of occupied cells instead of the
+      bounding box of the particles. This suits open boundaries and sparse
+      particle clouds. Periodic grids, mixed precision, and the cluster-pair
+      layout need grid bounds and are not supported.
+    */
+    template <class PositionSlice>
+    VerletList( PositionSlice x, const std::size_t begin, const std::size_t end,
+                const typename PositionSlice::value_type neighborhood_radius,
+                const typename PositionSlice::value_type cell_size_ratio,
+                const std::size_t max_neigh = 0,
+                typename std::enable_if<( is_slice<PositionSlice>::value ),
+                                        int>::type* = 0 )
+    {
+        build( x, begin, end, neighborhood_radius, cell_size_ratio,
+               max_neigh );
+    };
+
+    /*!
+      \brief Given a list of particle positions and a neighborhood radius
+      calculate the neighbor list without grid bounds.
+    */
+    template <class PositionSlice>
+    void build( PositionSlice x, const std::size_t begin, const std::size_t end,
+                const typename PositionSlice::value_type neighborhood_radius,
+                const typename PositionSlice::value_type cell_size_ratio,
+                const std::size_t max_neigh = 0 )
+    {
+        // Use the default execution space.
+        build( execution_space{}, x, begin, end, neighborhood_radius,
+               cell_size_ratio, max_neigh );
+    }
+
+    /*!
+      \brief Given a list of particle positions and a neighborhood radius
+      calculate the neighbor list without grid bounds on the given execution
+      space instance. Only that instance is fenced.
+    */
+    template <class PositionSlice, class ExecutionSpace>
+    void build( const ExecutionSpace& exec_space, PositionSlice x,
+                const std::size_t begin, const std::size_t end,
+                const typename PositionSlice::value_type neighborhood_radius,
+                const typename PositionSlice::value_type cell_size_ratio,
+                const std::size_t max_neigh = 0 )
+    {
+        Impl::ScopedProfileRegion region( "Cabana::VerletList::build" );
+
+        _radius_sqr = Kokkos::View<double*, memory_space>();
+        buildList( exec_space, x, begin, end, neighborhood_radius,
+                   cell_size_ratio, nullptr, nullptr, max_neigh );
+    }
+
+    /*!
+      \brief VerletList constructor. Given a list of particle positions and
+      a neighborhood radius for each particle calculate the neighbor list.
+
+      \param x The slice containing the particle positions
+
+      \param radii The slice containing the neighborhood radius of each
+      particle. The neighbors of a particle are the particles within its own
+      radius. The list is therefore not symmetric and only full lists are
+      supported.
+
+      \param begin The beginning particle index to compute neighbors for.
+
+      \param end The end particle index to compute neighbors for.
+
+      \param cell_size_ratio The ratio of the cell size in the Cartesian grid
+      to the largest neighborhood radius.
+
+      \param grid_min The minimum value of the grid containing the particles
+      in each dimension.
+
+      \param grid_max The maximum value of the grid containing the particles
+      in each dimension.
+
+      \param max_neigh Optional maximum number of neighbors per particle to
+      pre-allocate the neighbor list.
+
+      The grid is sized for the largest radius and the cell stencil of each
+      particle is culled with its own radius, such that small particles only
+      search the cells they can reach.
+    */
+    template <class PositionSlice, class RadiusSlice>
+    VerletList( PositionSlice x, RadiusSlice radii, const std::size_t begin,
+                const std::size_t end,
+                const typename PositionSlice::value_type cell_size_ratio,
+                const typename PositionSlice::value_type grid_min[3],
+                const typename PositionSlice::value_type grid_max[3],
+                const std::size_t max_neigh = 0,
+                typename std::enable_if<( is_slice<PositionSlice>::value &&
+                                          is_slice<RadiusSlice>::value ),
+                                        int>::type* = 0 )
+    {
+        build( x, radii, begin, end, cell_size_ratio, grid_min, grid_max,
+               max_neigh );
+    };
+
+    /*!
+      \brief Given a list of particle positions and a neighborhood radius for
+      each particle calculate the neighbor list.
+    */
+    template <class PositionSlice, class RadiusSlice>
+    void build( PositionSlice x, RadiusSlice radii, const std::size_t begin,
+                const std::size_t end,
+                const typename PositionSlice::value_type cell_size_ratio,
+                const typename PositionSlice::value_type grid_min[3],
+                const typename PositionSlice::value_type grid_max[3],
+                const std::size_t max_neigh = 0,
+                typename std::enable_if<( is_slice<RadiusSlice>::value ),
+                                        int>::type* = 0 )
+    {
+        // Use the default execution space.
+        build( execution_space{}, x, radii, begin, end, cell_size_ratio,
+               grid_min, grid_max, max_neigh );
+    }
+
+    /*!
+      \brief Given a list of particle positions and a neighborhood radius for
+      each particle calculate the neighbor list on the given execution space
+      instance. Only that instance is fenced.
+    */
+    template <class PositionSlice, class RadiusSlice, class ExecutionSpace>
+    void build( const ExecutionSpace& exec_space, PositionSlice x,
+                RadiusSlice radii, const std::size_t begin,
+                const std::size_t end,
+                const typename PositionSlice::value_type cell_size_ratio,
+                const typename PositionSlice::value_type grid_min[3],
+                const typename PositionSlice::value_type grid_max[3],
+                const std::size_t max_neigh = 0,
+                typename std::enable_if<( is_slice<RadiusSlice>::value ),
+                                        int>::type* = 0 )
+    {
+        static_assert( std::is_same<AlgorithmTag, FullNeighborTag>::value,
+                       "Per-particle radii require a full neighbor list" );
+        static_assert( is_accessible_from<memory_space, ExecutionSpace>{}, "" );
+
+        Impl::ScopedProfileRegion region( "Cabana::VerletList::build" );
+
+        if ( radii.size() != x.size() )
+            throw std::runtime_error( "A radius is needed for every particle" );
+
+        // Store the squared radii and size the grid for the largest one.
+        _radius_sqr = Kokkos::View<double*, memory_space>(
+            Kokkos::ViewAllocateWithoutInitializing(
+                "Cabana::VerletList::radius_sqr" ),
+            radii.size() );
+        auto radius_sqr = _radius_sqr;
+        double max_radius = 0.0;
+        Kokkos::parallel_reduce(
+            "Cabana::VerletList::max_radius",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                                 radii.size() ),
+            KOKKOS_LAMBDA( const std::size_t p, double& result ) {
+                double r = radii( p );
+                radius_sqr( p ) = r * r;
+                if ( r > result )
+                    result = r;
+            },
+            Kokkos::Max<double>( max_radius ) );
+        exec_space.fence();
+
+        buildList( exec_space, x, begin, end, max_radius, cell_size_ratio,
+                   grid_min, grid_max, max_neigh );
+    }
+
+    /*!
+      \brief Set the dimensions in which the grid is periodic. Takes effect
+      at the next build.
+
+      \param periodic Whether the grid is periodic in each dimension.
+
+      In periodic dimensions the neighbors are found across the grid
+      boundaries through the periodic images of the particles, such that no
+      ghost copies of the particles are needed. All particles must be inside
+      the grid and the grid must span at least the full cell stencil in each
+      periodic dimension. This is not supported by the cluster-pair layout.
+    */
+    void setPeriodic( const std::array<bool, 3>& periodic )
+    {
+        _periodic = periodic;
+    }
+
+    /*!
+      \brief Get the dimensions in which the grid is periodic.
+    */
+    std::array<bool, 3> periodic() const { return _periodic; }
+
+    /*!
+      \brief Set the aspect ratio of the cells. Takes effect at the next
+      build.
+
+      \param aspect The factor scaling the cell size in each dimension. The
+      cells are cell_size_ratio * aspect[d] times the neighborhood radius in
+      dimension d.
+
+      Anisotropic cells fit the stencil to anisotropic particle
+      distributions, such as thin films. A dimension of the grid thinner than
+      its cell size, such as the third dimension of a 2D problem, has a single
+      cell and adds no cells to the stencil. This is not supported by the
+      cluster-pair layout.
+    */
+    void setCellAspect( const std::array<double, 3>& aspect )
+    {
+        for ( int d = 0; d < 3; ++d )
+            if ( !( aspect[d] > 0.0 ) )
+                throw std::runtime_error( "Cell aspect must be positive" );
+        _cell_aspect = aspect;
+    }
+
+    /*!
+      \brief Get the aspect ratio of the cells.
+    */
+    std::array<double, 3> cellAspect() const { return _cell_aspect; }
+
+    /*!
+      \brief Set the range of ghost particles. Takes effect at the next
+      build.
+
+      \param ghost_begin The beginning index of the ghost particles.
+
+      \param ghost_end The end index of the ghost particles.
+
+      The ghost range must directly follow or precede the owned range given
+      to the build, as for ghosts appended to the owned particles by a halo
+      gather. Only the owned and ghost particles are then candidate
+      neighbors, and the ghosts are candidates only. The list has no entries
+      for the particles after the owned range, so the ghosts do not take list
+      storage. Half lists order pairs of owned particles by index instead of
+      by coordinates. Pairs of an owned particle and a ghost keep the
+      coordinate order, such that each pair across a rank boundary is stored
+      by one rank. This is not supported by the cluster-pair layout.
+
+      Particles after the owned range have zero neighbors through the
+      NeighborList interface, so neighbor operations may still use a policy
+      over all particles.
+    */
+    void setGhostRange( const std::size_t ghost_begin,
+                        const std::size_t ghost_end )
+    {
+        if ( ghost_end < ghost_begin )
+            throw std::runtime_error( "Invalid ghost range" );
+        _ghost_range = { ghost_begin, ghost_end };
+        _has_ghost_range = true;
+    }
+
+    /*!
+      \brief Treat all particles as candidate neighbors again. Takes effect
+      at the next build.
+    */
+    void clearGhostRange() { _has_ghost_range = false; }
+
+    /*!
+      \brief Get whether a ghost range is set.
+    */
+    bool hasGhostRange() const { return _has_ghost_range; }
+
+    /*!
+      \brief Set whether candidate neighbors are checked in mixed precision.
+      Takes effect at the next build.
+
+      \param mixed_precision If true the candidate distances are computed in
+      single precision from positions relative to the grid origin. Only
+      candidates within the rounding error margin of the cutoff are checked
+      again in the precision of the positions such that the list is the same
+      as without mixed precision. This trades an extra copy of the positions
+      for faster candidate checks on devices with low double precision
+      throughput. This is ignored by the cluster-pair layout.
+    */
+    void setMixedPrecision( const bool mixed_precision )
+    {
+        _mixed_precision = mixed_precision;
+    }
+
+    /*!
+      \brief Get whether candidate neighbors are checked in mixed precision.
+    */
+    bool mixedPrecision() const { return _mixed_precision; }
+
+    /*!
+      \brief Get the statistics of the last build. The neighbor counts are
+      over the particles of the build range, or over the clusters of the
+      cluster-pair layout in which case they are neighbor cluster counts.
+    */
+    NeighborListStats stats() const
+    {
+        NeighborListStats stats;
+        auto counts = _data.counts;
+        std::size_t begin = statsBegin( LayoutTag() );
+        std::size_t end = statsEnd( LayoutTag() );
+        Impl::neighborCountStats(
+            execution_space{}, begin, end,
+            KOKKOS_LAMBDA( const std::size_t i ) {
+                return static_cast<std::size_t>( counts( i ) );
+            },
+            stats );
+        stats.memory_bytes = _data.memoryBytes();
+        stats.num_build = _num_build;
+        stats.num_refill = _num_refill;
+        return stats;
+    }
+
+    /*!
+      \brief Rebuild the neighbor list with the parameters of the last build
+      if any particle moved more than half the skin distance since then.
+
+      \param x The slice containing the particle positions. The number of
+      particles must not have changed since the last build. Use the overload
+      with a particle range otherwise.
 
-      Particles outside of the neighborhood radius will not be considered
-      neighbors. Only compute the neighbors of those that are within the given
-      range. All particles are candidates for being a neighbor, regardless of
-      whether or not they are in the range.
+      \param skin The skin distance. The list should have been built with a
+      neighborhood radius of the interaction cutoff plus this distance.
+
+      \return True if the list was rebuilt.
     */
     template <class PositionSlice>
-    VerletList( PositionSlice x, const std::size_t begin, const std::size_t end,
-                const typename PositionSlice::value_type neighborhood_radius,
-                const typename PositionSlice::value_type cell_size_ratio,
-                const typename PositionSlice::value_type grid_min[3],
-                const typename PositionSlice::value_type grid_max[3],
-                const std::size_t max_neigh = 0,
-                typename std::enable_if<( is_slice<PositionSlice>::value ),
-                                        int>::type* = 0 )
+    bool updateIfNeeded( PositionSlice x,
+                         const typename PositionSlice::value_type skin )
     {
-        build( x, begin, end, neighborhood_radius, cell_size_ratio, grid_min,
-               grid_max, max_neigh );
-    };
+        // Use the default execution space.
+        return updateIfNeeded( execution_space{}, x, skin );
+    }
 
     /*!
-      \brief Given a list of particle positions and a neighborhood radius
-      calculate the neighbor list.
+      \brief Rebuild the neighbor list with the parameters of the last build
+      if any particle moved more than half the skin distance since then.
+    */
+    template <class PositionSlice, class ExecutionSpace>
+    bool updateIfNeeded( const ExecutionSpace& exec_space, PositionSlice x,
+                         const typename PositionSlice::value_type skin )
+    {
+        if ( _built && x.size() != _num_particle )
+            throw std::runtime_error(
+                "The particle count changed since the last build. Pass the "
+                "particle range to VerletList::updateIfNeeded" );
+        return updateIfNeeded( exec_space, x, _begin, _end, skin );
+    }
+
+    /*!
+      \brief Rebuild the neighbor list for a particle range with the other
+      parameters of the last build if the number of particles or the range
+      changed, or if any particle moved more than half the skin distance
+      since then.
+
+      \param x The slice containing the particle positions.
+
+      \param begin The beginning particle index to compute neighbors for.
+
+      \param end The end particle index to compute neighbors for.
+
+      \param skin The skin distance. The list should have been built with a
+      neighborhood radius of the interaction cutoff plus this distance.
+
+      \return True if the list was rebuilt.
     */
     template <class PositionSlice>
-    void build( PositionSlice x, const std::size_t begin, const std::size_t end,
-                const typename PositionSlice::value_type neighborhood_radius,
-                const typename PositionSlice::value_type cell_size_ratio,
-                const typename PositionSlice::value_type grid_min[3],
-                const typename PositionSlice::value_type grid_max[3],
-                const std::size_t max_neigh = 0 )
+    bool updateIfNeeded( PositionSlice x, const std::size_t begin,
+                         const std::size_t end,
+                         const typename PositionSlice::value_type skin )
     {
         // Use the default execution space.
-        build( execution_space{}, x, begin, end, neighborhood_radius,
-               cell_size_ratio, grid_min, grid_max, max_neigh );
+        return updateIfNeeded( execution_space{}, x, begin, end, skin );
     }
+
     /*!
-      \brief Given a list of particle positions and a neighborhood radius
-      calculate the neighbor list.
+      \brief Rebuild the neighbor list for a particle range with the other
+      parameters of the last build if the number of particles or the range
+      changed, or if any particle moved more than half the skin distance
+      since then.
     */
     template <class PositionSlice, class ExecutionSpace>
-    void build( ExecutionSpace, PositionSlice x, const std::size_t begin,
-                const std::size_t end,
-                const typename PositionSlice::value_type neighborhood_radius,
-                const typename PositionSlice::value_type cell_size_ratio,
-                const typename PositionSlice::value_type grid_min[3],
-                const typename PositionSlice::value_type grid_max[3],
-                const std::size_t max_neigh = 0 )
+    bool updateIfNeeded( const ExecutionSpace& exec_space, PositionSlice x,
+                         const std::size_t begin, const std::size_t end,
+                         const typename PositionSlice::value_type skin )
+    {
+        static_assert( is_accessible_from<memory_space, ExecutionSpace>{}, "" );
+
+        Impl::ScopedProfileRegion region(
+            "Cabana::VerletList::updateIfNeeded" );
+
+        if ( !_built )
+            throw std::runtime_error(
+                "VerletList must be built before it is updated" );
+        if ( end < begin || end > x.size() )
+            throw std::runtime_error( "Invalid particle range" );
+
+        // Check if the particles changed or if any particle moved far enough
+        // that it may have a new neighbor inside the cutoff. Without
+        // reference positions of the last build the list is rebuilt to take
+        // them.
+        _track_displacement = true;
+        bool rebuild = x.size() != _num_particle || begin != _begin ||
+                       end != _end ||
+                       _reference_positions.extent( 0 ) != x.size();
+        if ( !rebuild )
+        {
+            double max_dist_sqr = Impl::maxDisplacementSquared(
+                exec_space, x, _reference_positions );
+            rebuild = 4.0 * max_dist_sqr > static_cast<double>( skin ) * skin;
+        }
+        if ( !rebuild )
+            return false;
+
+        // Per-particle radii of the last build are reused as well.
+        if ( _radius_sqr.size() > 0 && _radius_sqr.extent( 0 ) != x.size() )
+            throw std::runtime_error( "The particle count changed since the "
+                                      "last build with per-particle radii" );
+
+        // Rebuild with the parameters of the last build.
+        using value_type = typename PositionSlice::value_type;
+        value_type grid_min[3];
+        value_type grid_max[3];
+        for ( int d = 0; d < 3; ++d )
+        {
+            grid_min[d] = _grid_min[d];
+            grid_max[d] = _grid_max[d];
+        }
+        buildList( exec_space, x, begin, end, _neighborhood_radius,
+                   _cell_size_ratio, _hashed ? nullptr : grid_min,
+                   _hashed ? nullptr : grid_max, _max_neigh );
+        return true;
+    }
+
+  private:
+    // Build the list and store the parameters of the build. Without grid
+    // bounds the particles are binned in hashed cells.
+    template <class PositionSlice, class ExecutionSpace>
+    void
+    buildList( const ExecutionSpace& exec_space, PositionSlice x,
+               const std::size_t begin, const std::size_t end,
+               const typename PositionSlice::value_type neighborhood_radius,
+               const typename PositionSlice::value_type cell_size_ratio,
+               const typename PositionSlice::value_type grid_min[3],
+               const typename PositionSlice::value_type grid_max[3],
+               const std::size_t max_neigh )
     {
         static_assert( is_accessible_from<memory_space, ExecutionSpace>{}, "" );
 
+        // If no allocation size was given size the list from the previous
+        // build such that a steady-state rebuild only fills the list once.
+        std::size_t max_n =
+            ( max_neigh > 0 ) ? max_neigh : previousMaxNeighbor( LayoutTag() );
+
+        // Build the neighbor data for the layout.
+        buildData( exec_space, x, begin, end, neighborhood_radius,
+                   cell_size_ratio, grid_min, grid_max, max_n, LayoutTag() );
+
+        // Store the build parameters and, once the list is updated, the
+        // reference positions for lazy rebuilds.
+        _built = true;
+        ++_num_build;
+        _begin = begin;
+        _end = end;
+        _num_particle = x.size();
+        _neighborhood_radius = neighborhood_radius;
+        _cell_size_ratio = cell_size_ratio;
+        _hashed = ( grid_min == nullptr );
+        for ( int d = 0; d < 3 && !_hashed; ++d )
+        {
+            _grid_min[d] = grid_min[d];
+            _grid_max[d] = grid_max[d];
+        }
+        _max_neigh = max_neigh;
+        if ( _track_displacement )
+        {
+            if ( _reference_positions.extent( 0 ) != x.size() )
+                _reference_positions = Kokkos::View<double* [3], memory_space>(
+                    Kokkos::view_alloc(
+                        exec_space, Kokkos::WithoutInitializing,
+                        "Cabana::VerletList::reference_positions" ),
+                    x.size() );
+            Impl::copyReferencePositions( exec_space, x,
+                                          _reference_positions );
+        }
+        else
+        {
+            _reference_positions = Kokkos::View<double* [3], memory_space>();
+        }
+    }
+
+    // Build the CSR or 2D neighbor data with the per-particle builder.
+    template <class ExecutionSpace, class PositionSlice, class Layout>
+    void
+    buildData( const ExecutionSpace& exec_space, PositionSlice x,
+               const std::size_t begin, const std::size_t end,
+               const typename PositionSlice::value_type neighborhood_radius,
+               const typename PositionSlice::value_type cell_size_ratio,
+               const typename PositionSlice::value_type grid_min[3],
+               const typename PositionSlice::value_type grid_max[3],
+               const std::size_t max_n, Layout )
+    {
+        _data = buildParticleData( exec_space, x, begin, end,
+                                   neighborhood_radius, cell_size_ratio,
+                                   grid_min, grid_max, max_n, Layout() );
+    }
+
+    // Build the compressed neighbor data from a CSR list.
+    template <class ExecutionSpace, class PositionSlice>
+    void
+    buildData( const ExecutionSpace& exec_space, PositionSlice x,
+               const std::size_t begin, const std::size_t end,
+               const typename PositionSlice::value_type neighborhood_radius,
+               const typename PositionSlice::value_type cell_size_ratio,
+               const typename PositionSlice::value_type grid_min[3],
+               const typename PositionSlice::value_type grid_max[3],
+               const std::size_t max_n, VerletLayoutCompressed )
+    {
+        auto csr_data = buildParticleData(
+            exec_space, x, begin, end, neighborhood_radius,
+            cell_size_ratio, grid_min, grid_max, max_n, VerletLayoutCSR() );
+        _data = Impl::compressVerletList( exec_space, csr_data );
+    }
+
+    // Build CSR or 2D neighbor data with the per-particle builder.
+    template <class ExecutionSpace, class PositionSlice, class Layout>
+    VerletListData<memory_space, Layout> buildParticleData(
+        const ExecutionSpace& exec_space, PositionSlice x,
+        const std::size_t begin, const std::size_t end,
+        const typename PositionSlice::value_type neighborhood_radius,
+        const typename PositionSlice::value_type cell_size_ratio,
+        const typename PositionSlice::value_type grid_min[3],
+        const typename PositionSlice::value_type grid_max[3],
+        const std::size_t max_n, Layout )
+    {
         using device_type = Kokkos::Device<ExecutionSpace, memory_space>;
 
         // Create a builder functor.
         using builder_type =
             Impl::VerletListBuilder<device_type, PositionSlice, AlgorithmTag,
-                                    LayoutTag, BuildTag>;
-        builder_type builder( x, begin, end, neighborhood_radius,
-                              cell_size_ratio, grid_min, grid_max, max_neigh );
+                                    Layout, BuildTag>;
+        Kokkos::Profiling::pushRegion( "Cabana::VerletList::build::bin" );
+        builder_type builder( exec_space, x, begin, end, neighborhood_radius,
+                              cell_size_ratio, grid_min, grid_max, max_n,
+                              _periodic.data(), _radius_sqr,
+                              _mixed_precision, _cell_aspect.data(),
+                              _has_ghost_range ? _ghost_range.data()
+                                               : nullptr );
+        Kokkos::Profiling::popRegion();
 
         // For each particle in the range check each neighboring bin for
         // neighbor particles. Bins are at least the size of the neighborhood
@@ -759,40 +2396,179 @@ class VerletList
         // count and fill at the same time, unless the array size is exceeded,
         // at which point only counting is continued to reallocate and refill.
         typename builder_type::FillNeighborsPolicy fill_policy(
-            builder.bin_data_1d.numBin(), Kokkos::AUTO, 4 );
+            exec_space, builder.bin_data_1d.numBin(), Kokkos::AUTO, 4 );
+        Kokkos::Profiling::pushRegion( "Cabana::VerletList::build::count" );
         if ( builder.count )
         {
             typename builder_type::CountNeighborsPolicy count_policy(
-                builder.bin_data_1d.numBin(), Kokkos::AUTO, 4 );
+                exec_space, builder.bin_data_1d.numBin(), Kokkos::AUTO, 4 );
             Kokkos::parallel_for( "Cabana::VerletList::count_neighbors",
                                   count_policy, builder );
         }
         else
         {
-            builder.processCounts( LayoutTag() );
+            builder.processCounts( exec_space, Layout() );
             Kokkos::parallel_for( "Cabana::VerletList::fill_neighbors",
                                   fill_policy, builder );
         }
-        Kokkos::fence();
+        exec_space.fence();
+        Kokkos::Profiling::popRegion();
 
         // Process the counts by computing offsets and allocating the neighbor
         // list, if needed.
-        builder.processCounts( LayoutTag() );
+        Kokkos::Profiling::pushRegion( "Cabana::VerletList::build::scan" );
+        builder.processCounts( exec_space, Layout() );
+        Kokkos::Profiling::popRegion();
 
         // For each particle in the range fill (or refill) its part of the
         // neighbor list.
         if ( builder.count or builder.refill )
         {
+            Kokkos::Profiling::pushRegion( "Cabana::VerletList::build::fill" );
             Kokkos::parallel_for( "Cabana::VerletList::fill_neighbors",
                                   fill_policy, builder );
-            Kokkos::fence();
+            exec_space.fence();
+            Kokkos::Profiling::popRegion();
         }
+        if ( builder.refill )
+            ++_num_refill;
 
         // Get the data from the builder.
+        return builder._data;
+    }
+
+    // Build the cluster-pair neighbor data.
+    template <class ExecutionSpace, class PositionSlice,
+              std::size_t ClusterSize>
+    void
+    buildData( const ExecutionSpace& exec_space, PositionSlice x,
+               const std::size_t begin, const std::size_t end,
+               const typename PositionSlice::value_type neighborhood_radius,
+               const typename PositionSlice::value_type cell_size_ratio,
+               const typename PositionSlice::value_type grid_min[3],
+               const typename PositionSlice::value_type grid_max[3],
+               const std::size_t, VerletLayoutCluster<ClusterSize> )
+    {
+        if ( _periodic[0] || _periodic[1] || _periodic[2] )
+            throw std::runtime_error(
+                "Periodic grids are not supported by the cluster-pair layout" );
+        if ( _radius_sqr.size() > 0 )
+            throw std::runtime_error( "Per-particle radii are not supported "
+                                      "by the cluster-pair layout" );
+        if ( _cell_aspect[0] != 1.0 || _cell_aspect[1] != 1.0 ||
+             _cell_aspect[2] != 1.0 )
+            throw std::runtime_error( "Anisotropic cells are not supported "
+                                      "by the cluster-pair layout" );
+        if ( _has_ghost_range )
+            throw std::runtime_error( "Ghost ranges are not supported by the "
+                                      "cluster-pair layout" );
+        if ( grid_min == nullptr )
+            throw std::runtime_error( "Grid bounds are required by the "
+                                      "cluster-pair layout" );
+
+        using device_type = Kokkos::Device<ExecutionSpace, memory_space>;
+        Impl::VerletClusterListBuilder<device_type, PositionSlice, AlgorithmTag,
+                                       ClusterSize>
+            builder( exec_space, x, begin, end, neighborhood_radius,
+                     cell_size_ratio, grid_min, grid_max );
+        builder.build( exec_space );
         _data = builder._data;
     }
+
+    // Range of the neighbor counts used for the statistics.
+    template <class Layout>
+    std::size_t statsBegin( Layout ) const
+    {
+        return _begin;
+    }
+
+    template <class Layout>
+    std::size_t statsEnd( Layout ) const
+    {
+        return _built ? _end : _begin;
+    }
+
+    template <std::size_t ClusterSize>
+    std::size_t statsBegin( VerletLayoutCluster<ClusterSize> ) const
+    {
+        return 0;
+    }
+
+    template <std::size_t ClusterSize>
+    std::size_t statsEnd( VerletLayoutCluster<ClusterSize> ) const
+    {
+        return _data.numCluster();
+    }
+
+    // Allocation size for 2D lists reused from the previous build. All
+    // other layouts are always counted.
+    template <class Layout>
+    std::size_t previousMaxNeighbor( Layout ) const
+    {
+        return 0;
+    }
+
+    std::size_t previousMaxNeighbor( VerletLayout2D ) const
+    {
+        return _data.neighbors.extent( 1 );
+    }
+
+    // Parameters of the last build.
+    bool _built = false;
+    std::size_t _begin = 0;
+    std::size_t _end = 0;
+    std::size_t _num_particle = 0;
+    double _neighborhood_radius = 0.0;
+    double _cell_size_ratio = 0.0;
+    std::array<double, 3> _grid_min = { 0.0, 0.0, 0.0 };
+    std::array<double, 3> _grid_max = { 0.0, 0.0, 0.0 };
+    bool _hashed = false;
+    std::size_t _max_neigh = 0;
+
+    // Periodic dimensions of the grid.
+    std::array<bool, 3> _periodic = { false, false, false };
+
+    // Aspect ratio of the cells.
+    std::array<double, 3> _cell_aspect = { 1.0, 1.0, 1.0 };
+
+    // Range of the ghost particles, if set.
+    bool _has_ghost_range = false;
+    std::array<std::size_t, 2> _ghost_range = { 0, 0 };
+
+    // Squared per-particle radii of the last build, if any.
+    Kokkos::View<double*, memory_space> _radius_sqr;
+
+    // Check candidate neighbors in mixed precision.
+    bool _mixed_precision = false;
+
+    // Number of builds and of builds which overflowed and were refilled.
+    int _num_build = 0;
+    int _num_refill = 0;
+
+    // Particle positions at the last build.
+    Kokkos::View<double* [3], memory_space> _reference_positions;
+
+    // Keep the reference positions at each build, set by the first update.
+    bool _track_displacement = false;
 };
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief Get the statistics of the last build of a Verlet list.
+
+  \param list The neighbor list.
+
+  \return The neighbor counts, the memory of the neighbor data, and the
+  number of builds and refills.
+*/
+template <class MemorySpace, class AlgorithmTag, class LayoutTag,
+          class BuildTag>
+NeighborListStats neighborListStats(
+    const VerletList<MemorySpace, AlgorithmTag, LayoutTag, BuildTag>& list )
+{
+    return list.stats();
+}
+
 //---------------------------------------------------------------------------//
 // Neighbor list interface implementation.
 //---------------------------------------------------------------------------//
@@ -815,12 +2591,16 @@ class NeighborList<
         return list._data.neighbors.extent( 0 );
     }
 
-    //! Get the number of neighbors for a given particle index.
+    //! Get the number of neighbors for a given particle index. Particles
+    //! without list entries, such as the ghosts after the owned range of a
+    //! list built with a ghost range, have no neighbors.
     KOKKOS_INLINE_FUNCTION
     static std::size_t numNeighbor( const list_type& list,
                                     const std::size_t particle_index )
     {
-        return list._data.counts( particle_index );
+        return ( particle_index < list._data.counts.extent( 0 ) )
+                   ? list._data.counts( particle_index )
+                   : 0;
     }
 
     //! Get the id for a neighbor for a given particle index and the index of
@@ -855,12 +2635,16 @@ class NeighborList<
         return list._data.neighbors.extent( 1 );
     }
 
-    //! Get the number of neighbors for a given particle index.
+    //! Get the number of neighbors for a given particle index. Particles
+    //! without list entries, such as the ghosts after the owned range of a
+    //! list built with a ghost range, have no neighbors.
     KOKKOS_INLINE_FUNCTION
     static std::size_t numNeighbor( const list_type& list,
                                     const std::size_t particle_index )
     {
-        return list._data.counts( particle_index );
+        return ( particle_index < list._data.counts.extent( 0 ) )
+                   ? list._data.counts( particle_index )
+                   : 0;
     }
 
     //! Get the id for a neighbor for a given particle index and the index of
@@ -874,6 +2658,458 @@ class NeighborList<
     }
 };
 
+//---------------------------------------------------------------------------//
+//! Compressed VerletList NeighborList interface.
+template <class MemorySpace, class AlgorithmTag, class BuildTag>
+class NeighborList<
+    VerletList<MemorySpace, AlgorithmTag, VerletLayoutCompressed, BuildTag>>
+{
+  public:
+    //! Kokkos memory space.
+    using memory_space = MemorySpace;
+    //! Neighbor list type.
+    using list_type =
+        VerletList<MemorySpace, AlgorithmTag, VerletLayoutCompressed, BuildTag>;
+
+    //! Get the total number of neighbors (maximum size of CSR list).
+    KOKKOS_INLINE_FUNCTION
+    static std::size_t maxNeighbor( const list_type& list )
+    {
+        return list._data.deltas.extent( 0 );
+    }
+
+    //! Get the number of neighbors for a given particle index. Particles
+    //! without list entries, such as the ghosts after the owned range of a
+    //! list built with a ghost range, have no neighbors.
+    KOKKOS_INLINE_FUNCTION
+    static std::size_t numNeighbor( const list_type& list,
+                                    const std::size_t particle_index )
+    {
+        return ( particle_index < list._data.counts.extent( 0 ) )
+                   ? list._data.counts( particle_index )
+                   : 0;
+    }
+
+    //! Get the id for a neighbor for a given particle index and the index of
+    //! the neighbor relative to the particle.
+    KOKKOS_INLINE_FUNCTION
+    static std::size_t getNeighbor( const list_type& list,
+                                    const std::size_t particle_index,
+                                    const std::size_t neighbor_index )
+    {
+        return list._data.getNeighbor( particle_index, neighbor_index );
+    }
+};
+
+//---------------------------------------------------------------------------//
+// Cluster-pair neighbor parallel iteration.
+//---------------------------------------------------------------------------//
+/*!
+  \brief Execute functor in parallel according to the execution policy over
+  the particles of a cluster-pair list with thread-local serial loops over
+  particle first neighbors.
+
+  \param exec_policy The policy over which to execute the functor. Only
+  particles in the policy range are operated on.
+  \param functor The functor to execute in parallel
+  \param list The cluster-pair neighbor list.
+  \param FirstNeighborsTag Tag indicating operations over particle first
+  neighbors.
+  \param SerialOpTag Tag indicating a serial loop strategy over neighbors.
+  \param str Optional name for the functor.
+
+  Each thread operates on a cluster and loops over the neighbor clusters and
+  their interaction masks. The clusters store the ids of their particles and
+  the particles themselves are not reordered, so the functor is called once
+  per interacting pair with particle ids as in the other layouts. The
+  positions of a cluster are in general not contiguous in memory and the
+  loop over a cluster pair is not vectorized.
+*/
+template <class FunctorType, class MemorySpace, class AlgorithmTag,
+          std::size_t ClusterSize, class BuildTag, class... ExecParameters>
+inline void neighbor_parallel_for(
+    const Kokkos::RangePolicy<ExecParameters...>& exec_policy,
+    const FunctorType& functor,
+    const VerletList<MemorySpace, AlgorithmTag,
+                     VerletLayoutCluster<ClusterSize>, BuildTag>& list,
+    const FirstNeighborsTag, const SerialOpTag, const std::string& str = "" )
+{
+    using work_tag = typename Kokkos::RangePolicy<ExecParameters...>::work_tag;
+
+    using execution_space =
+        typename Kokkos::RangePolicy<ExecParameters...>::execution_space;
+
+    using index_type =
+        typename Kokkos::RangePolicy<ExecParameters...>::index_type;
+
+    using mask_type = typename VerletLayoutCluster<ClusterSize>::mask_type;
+
+    static_assert( is_accessible_from<MemorySpace, execution_space>{}, "" );
+
+    const index_type begin = exec_policy.begin();
+    const index_type end = exec_policy.end();
+    auto data = list._data;
+
+    using linear_policy_type = Kokkos::RangePolicy<execution_space, void, void>;
+    linear_policy_type linear_exec_policy( 0, data.numCluster() );
+
+    auto neigh_func = KOKKOS_LAMBDA( const index_type c )
+    {
+        for ( int n = 0; n < data.counts( c ); ++n )
+        {
+            const int nc = data.neighbors( data.offsets( c ) + n );
+            const mask_type mask = data.masks( data.offsets( c ) + n );
+            for ( std::size_t a = 0; a < ClusterSize; ++a )
+            {
+                const int i = data.cluster_particles( c * ClusterSize + a );
+                if ( i < 0 || static_cast<index_type>( i ) < begin ||
+                     static_cast<index_type>( i ) >= end )
+                    continue;
+                for ( std::size_t b = 0; b < ClusterSize; ++b )
+                    if ( ( mask >> ( a * ClusterSize + b ) ) & 1 )
+                        Impl::functorTagDispatch<work_tag>(
+                            functor, static_cast<index_type>( i ),
+                            static_cast<index_type>( data.cluster_particles(
+                                nc * ClusterSize + b ) ) );
+            }
+        }
+    };
+    if ( str.empty() )
+        Kokkos::parallel_for( linear_exec_policy, neigh_func );
+    else
+        Kokkos::parallel_for( str, linear_exec_policy, neigh_func );
+}
+
+/*!
+  \brief Execute functor in parallel according to the execution policy over
+  the particles of a cluster-pair list with team parallelism over the
+  particles of each cluster.
+
+  \param exec_policy The policy over which to execute the functor. Only
+  particles in the policy range are operated on.
+  \param functor The functor to execute in parallel
+  \param list The cluster-pair neighbor list.
+  \param FirstNeighborsTag Tag indicating operations over particle first
+  neighbors.
+  \param TeamOpTag Tag indicating a team parallel strategy over neighbors.
+  \param str Optional name for the functor.
+
+  Each team operates on a cluster with one thread per cluster particle such
+  that the threads of a team read the same neighbor cluster at once.
+*/
+template <class FunctorType, class MemorySpace, class AlgorithmTag,
+          std::size_t ClusterSize, class BuildTag, class... ExecParameters>
+inline void neighbor_parallel_for(
+    const Kokkos::RangePolicy<ExecParameters...>& exec_policy,
+    const FunctorType& functor,
+    const VerletList<MemorySpace, AlgorithmTag,
+                     VerletLayoutCluster<ClusterSize>, BuildTag>& list,
+    const FirstNeighborsTag, const TeamOpTag, const std::string& str = "" )
+{
+    using work_tag = typename Kokkos::RangePolicy<ExecParameters...>::work_tag;
+
+    using execution_space =
+        typename Kokkos::RangePolicy<ExecParameters...>::execution_space;
+
+    using mask_type = typename VerletLayoutCluster<ClusterSize>::mask_type;
+
+    static_assert( is_accessible_from<MemorySpace, execution_space>{}, "" );
+
+    auto data = list._data;
+
+    using kokkos_policy =
+        Kokkos::TeamPolicy<execution_space, Kokkos::Schedule<Kokkos::Dynamic>>;
+    kokkos_policy team_policy( data.numCluster(), Kokkos::AUTO );
+
+    using index_type = typename kokkos_policy::index_type;
+
+    const index_type begin = exec_policy.begin();
+    const index_type end = exec_policy.end();
+
+    auto neigh_func =
+        KOKKOS_LAMBDA( const typename kokkos_policy::member_type& team )
+    {
+        const index_type c = team.league_rank();
+        Kokkos::parallel_for(
+            Kokkos::TeamThreadRange( team, ClusterSize ),
+            [&]( const int a ) {
+                const int i = data.cluster_particles( c * ClusterSize + a );
+                if ( i < 0 || static_cast<index_type>( i ) < begin ||
+                     static_cast<index_type>( i ) >= end )
+                    return;
+                for ( int n = 0; n < data.counts( c ); ++n )
+                {
+                    const int nc = data.neighbors( data.offsets( c ) + n );
+                    const mask_type mask = data.masks( data.offsets( c ) + n );
+                    for ( std::size_t b = 0; b < ClusterSize; ++b )
+                        if ( ( mask >> ( a * ClusterSize + b ) ) & 1 )
+                            Impl::functorTagDispatch<work_tag>(
+                                functor, static_cast<index_type>( i ),
+                                static_cast<index_type>(
+                                    data.cluster_particles( nc * ClusterSize +
+                                                            b ) ) );
+                }
+            } );
+    };
+    if ( str.empty() )
+        Kokkos::parallel_for( team_policy, neigh_func );
+    else
+        Kokkos::parallel_for( str, team_policy, neigh_func );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create a CSR Verlet list from the pairs of an existing neighbor list
+  satisfying a predicate.
+
+  \tparam AlgorithmTag The algorithm tag of the filtered list. This should
+  match the pairs in the existing list.
+
+  \param exec_policy The policy over the particles to filter the neighbors
+  of. Particles before the policy range have no neighbors in the filtered
+  list.
+
+  \param list The neighbor list to filter.
+
+  \param pred The predicate. A pair of particle i and neighbor j is kept if
+  pred( i, j ) returns true. The predicate is evaluated on the execution
+  space instance of the policy and only that instance is fenced.
+
+  \return The filtered list. The neighbors of each particle keep their order
+  in the existing list.
+
+  The filtered list is built from the existing pairs without a new spatial
+  search, for example to extract the pairs within a shorter cutoff.
+*/
+template <class AlgorithmTag = FullNeighborTag, class NeighborListType,
+          class Predicate, class... ExecParameters>
+VerletList<typename NeighborList<NeighborListType>::memory_space,
+           AlgorithmTag, VerletLayoutCSR, TeamOpTag>
+neighbor_filter( const Kokkos::RangePolicy<ExecParameters...>& exec_policy,
+                 const NeighborListType& list, const Predicate& pred )
+{
+    using execution_space =
+        typename Kokkos::RangePolicy<ExecParameters...>::execution_space;
+
+    using memory_space = typename NeighborList<NeighborListType>::memory_space;
+
+    using list_type =
+        VerletList<memory_space, AlgorithmTag, VerletLayoutCSR, TeamOpTag>;
+
+    const std::size_t end = exec_policy.end();
+    execution_space exec_space = exec_policy.space();
+    Kokkos::RangePolicy<execution_space> policy( exec_space,
+                                                 exec_policy.begin(), end );
+
+    list_type filtered;
+    auto& data = filtered._data;
+    data.counts = Kokkos::View<int*, memory_space>( "counts", end );
+    data.offsets = Kokkos::View<int*, memory_space>(
+        Kokkos::ViewAllocateWithoutInitializing( "offsets" ), end );
+
+    // Count the kept pairs of each particle.
+    auto counts = data.counts;
+    auto count_op = KOKKOS_LAMBDA( const int i, const int j )
+    {
+        if ( pred( i, j ) )
+            ++counts( i );
+    };
+    neighbor_parallel_for( policy, count_op, list, FirstNeighborsTag(),
+                           SerialOpTag(), "Cabana::neighbor_filter::count" );
+
+    // Compute the offsets.
+    auto offsets = data.offsets;
+    int num_pair = 0;
+    Kokkos::parallel_scan(
+        "Cabana::neighbor_filter::offsets",
+        Kokkos::RangePolicy<execution_space>( exec_space, 0, end ),
+        KOKKOS_LAMBDA( const int i, int& update, const bool final_pass ) {
+            if ( final_pass )
+                offsets( i ) = update;
+            update += counts( i );
+        },
+        num_pair );
+
+    // Fill the kept pairs in order.
+    data.neighbors = Kokkos::View<int*, memory_space>(
+        Kokkos::ViewAllocateWithoutInitializing( "neighbors" ), num_pair );
+    auto neighbors = data.neighbors;
+    auto fill_op = KOKKOS_LAMBDA( const int i, const int j, int& update,
+                                  const bool final_pass )
+    {
+        if ( pred( i, j ) )
+        {
+            if ( final_pass )
+                neighbors( update ) = j;
+            ++update;
+        }
+    };
+    int num_fill = 0;
+    neighbor_parallel_scan( policy, fill_op, list, FirstNeighborsTag(),
+                            num_fill, "Cabana::neighbor_filter::fill" );
+    exec_space.fence();
+
+    return filtered;
+}
+
+//---------------------------------------------------------------------------//
+// Cell size ratio tuning.
+//---------------------------------------------------------------------------//
+//! \cond Impl
+namespace Impl
+{
+// Key of a tuned cell size ratio: the execution space name, the density
+// bucket and the shape bucket.
+using CellSizeRatioKey = std::tuple<std::string, int, std::array<int, 3>>;
+
+// Tuned cell size ratios of a list type.
+template <class ListType>
+std::map<CellSizeRatioKey, double>& cellSizeRatioCache()
+{
+    static std::map<CellSizeRatioKey, double> cache;
+    return cache;
+}
+
+// Get the density bucket of a particle distribution as the rounded base 2
+// logarithm of the mean number of particles per cube of the neighborhood
+// radius. Distributions within a factor of about 1.4 share a bucket.
+inline int cellSizeRatioDensityBucket( const std::size_t num_particle,
+                                       const double neighborhood_radius,
+                                       const double grid_min[3],
+                                       const double grid_max[3] )
+{
+    double volume = 1.0;
+    for ( int d = 0; d < 3; ++d )
+        volume *= grid_max[d] - grid_min[d];
+    double density = num_particle * neighborhood_radius * neighborhood_radius *
+                     neighborhood_radius / volume;
+    if ( !( density > 0.0 ) )
+        return std::numeric_limits<int>::min();
+    return static_cast<int>( std::lround( std::log2( density ) ) );
+}
+
+// Get the shape bucket of a grid as the rounded base 2 logarithm of its
+// extent in units of the neighborhood radius in each dimension. Grids of
+// the same density but different extents or aspect ratios have different
+// shape buckets.
+inline std::array<int, 3> cellSizeRatioShapeBucket(
+    const double neighborhood_radius, const double grid_min[3],
+    const double grid_max[3] )
+{
+    std::array<int, 3> bucket;
+    for ( int d = 0; d < 3; ++d )
+    {
+        double extent = ( grid_max[d] - grid_min[d] ) / neighborhood_radius;
+        bucket[d] = ( extent > 0.0 )
+                        ? static_cast<int>( std::lround( std::log2( extent ) ) )
+                        : std::numeric_limits<int>::min();
+    }
+    return bucket;
+}
+} // end namespace Impl
+//! \endcond
+
+/*!
+  \brief Find the cell size ratio with the fastest Verlet list build for a
+  particle distribution on the current hardware.
+
+  \tparam ListType The Verlet list type to tune for.
+
+  \param x The slice containing the particle positions
+
+  \param begin The beginning particle index to compute neighbors for.
+
+  \param end The end particle index to compute neighbors for.
+
+  \param neighborhood_radius The radius of the neighborhood.
+
+  \param grid_min The minimum value of the grid containing the particles
+  in each dimension.
+
+  \param grid_max The maximum value of the grid containing the particles
+  in each dimension.
+
+  \param ratios The candidate cell size ratios.
+
+  \param num_trial The number of timed builds per candidate ratio. The
+  fastest build of each candidate is compared.
+
+  \return The fastest cell size ratio.
+
+  The result is cached for the process by the execution space of the list
+  type, the density bucket of the distribution and the shape bucket of the
+  grid. The density bucket is the rounded base 2 logarithm of the mean
+  number of particles per cube of the neighborhood radius. The shape bucket
+  is the rounded base 2 logarithm of the grid extent in units of the
+  neighborhood radius in each dimension. Later calls for a distribution in
+  the same buckets return the cached ratio without building. The buckets do
+  not capture how the particles are distributed within the grid, so
+  strongly clustered distributions may need the cache cleared with
+  clearCellSizeRatioCache().
+*/
+template <class ListType, class PositionSlice>
+typename PositionSlice::value_type tuneCellSizeRatio(
+    PositionSlice x, const std::size_t begin, const std::size_t end,
+    const typename PositionSlice::value_type neighborhood_radius,
+    const typename PositionSlice::value_type grid_min[3],
+    const typename PositionSlice::value_type grid_max[3],
+    const std::vector<double>& ratios = { 1.0, 0.5, 1.0 / 3.0, 0.25 },
+    const int num_trial = 2 )
+{
+    if ( ratios.empty() )
+        throw std::runtime_error( "No candidate cell size ratios given" );
+
+    double lo[3] = { grid_min[0], grid_min[1], grid_min[2] };
+    double hi[3] = { grid_max[0], grid_max[1], grid_max[2] };
+    auto key = std::make_tuple(
+        std::string( ListType::execution_space::name() ),
+        Impl::cellSizeRatioDensityBucket( end - begin, neighborhood_radius, lo,
+                                          hi ),
+        Impl::cellSizeRatioShapeBucket( neighborhood_radius, lo, hi ) );
+    auto& cache = Impl::cellSizeRatioCache<ListType>();
+    auto cached = cache.find( key );
+    if ( cached != cache.end() )
+        return cached->second;
+
+    double best_ratio = ratios[0];
+    double best_time = std::numeric_limits<double>::max();
+    typename ListType::execution_space exec_space;
+    ListType list;
+    for ( const double ratio : ratios )
+    {
+        // Build once untimed such that allocations are warm.
+        list.build( x, begin, end, neighborhood_radius, ratio, grid_min,
+                    grid_max );
+        for ( int t = 0; t < num_trial; ++t )
+        {
+            Kokkos::Timer timer;
+            list.build( exec_space, x, begin, end, neighborhood_radius, ratio,
+                        grid_min, grid_max );
+            exec_space.fence();
+            double time = timer.seconds();
+            if ( time < best_time )
+            {
+                best_time = time;
+                best_ratio = ratio;
+            }
+        }
+    }
+
+    cache[key] = best_ratio;
+    return best_ratio;
+}
+
+/*!
+  \brief Clear the tuned cell size ratios of a Verlet list type.
+
+  \tparam ListType The Verlet list type.
+*/
+template <class ListType>
+void clearCellSizeRatioCache()
+{
+    Impl::cellSizeRatioCache<ListType>().clear();
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Cabana
@@ -14,6 +14,7 @@
 
 #include <Kokkos_Core.hpp>
 
+#include <algorithm>
 #include <limits>
 #include <type_traits>
 
@@ -58,13 +59,12 @@ class CartesianGrid
         , _max_y( max_y )
         , _max_z( max_z )
     {
-        _nx = cellsBetween( max_x, min_x, 1.0 / delta_x );
-        _ny = cellsBetween( max_y, min_y, 1.0 / delta_y );
-        _nz = cellsBetween( max_z, min_z, 1.0 / delta_z );
-
-        _dx = ( max_x - min_x ) / _nx;
-        _dy = ( max_y - min_y ) / _ny;
-        _dz = ( max_z - min_z ) / _nz;
+        // A dimension thinner than the cell size, such as the third
+        // dimension of a 2D problem, has a single cell of the requested
+        // size. This keeps the cell size finite for zero extents.
+        setNumCell( min_x, max_x, delta_x, _nx, _dx );
+        setNumCell( min_y, max_y, delta_y, _ny, _dy );
+        setNumCell( min_z, max_z, delta_z, _nz, _dz );
 
         _rdx = 1.0 / _dx;
         _rdy = 1.0 / _dy;
@@ -98,6 +98,20 @@ class CartesianGrid
             return -1;
     }
 
+    // Get the cell size in a given direction.
+    KOKKOS_INLINE_FUNCTION
+    Real cellSize( const int dim ) const
+    {
+        if ( 0 == dim )
+            return _dx;
+        else if ( 1 == dim )
+            return _dy;
+        else if ( 2 == dim )
+            return _dz;
+        else
+            return -1.0;
+    }
+
     // Given a position get the ijk indices of the cell in which
     KOKKOS_INLINE_FUNCTION
     void locatePoint( const Real xp, const Real yp, const Real zp, int& ic,
@@ -162,6 +176,22 @@ class CartesianGrid
 #endif
         return floor( ( max - min ) * rdelta );
     }
+
+    // Set the number of cells and the cell size in one dimension.
+    void setNumCell( const Real min, const Real max, const Real delta, int& n,
+                     Real& d ) const
+    {
+        n = cellsBetween( max, min, 1.0 / delta );
+        if ( n < 1 )
+        {
+            n = 1;
+            d = delta;
+        }
+        else
+        {
+            d = ( max - min ) / n;
+        }
+    }
 };
 
 //! \endcond
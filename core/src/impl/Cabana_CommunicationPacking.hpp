@@ -0,0 +1,220 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_CommunicationPacking.hpp
+  \brief Packing of multiple slices into fused communication buffers
+*/
+#ifndef CABANA_COMMUNICATIONPACKING_HPP
+#define CABANA_COMMUNICATIONPACKING_HPP
+
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+namespace Cabana
+{
+namespace Impl
+{
+//! \cond Impl
+//---------------------------------------------------------------------------//
+// Get the number of components in each element of a slice.
+template <class Slice_t>
+std::size_t sliceNumComp( const Slice_t& slice )
+{
+    std::size_t num_comp = 1;
+    for ( std::size_t d = 2; d < slice.rank(); ++d )
+        num_comp *= slice.extent( d );
+    return num_comp;
+}
+
+//---------------------------------------------------------------------------//
+// Byte layout of a fused record holding one element each of several
+// slices. Each slice element starts at an offset aligned to its value type
+// and the record size is padded such that consecutive records in a buffer
+// remain aligned.
+template <std::size_t N>
+struct FusedRecordLayout
+{
+    Kokkos::Array<std::size_t, N> offsets;
+    std::size_t bytes;
+};
+
+//---------------------------------------------------------------------------//
+// Create the fused record layout for a set of slices.
+template <class... Slices>
+FusedRecordLayout<sizeof...( Slices )>
+createFusedRecordLayout( const Slices&... slices )
+{
+    FusedRecordLayout<sizeof...( Slices )> layout;
+    std::size_t bytes = 0;
+    std::size_t max_align = 1;
+    std::size_t n = 0;
+    auto add_slice = [&]( const std::size_t num_comp,
+                          const std::size_t value_size ) {
+        bytes = value_size * ( ( bytes + value_size - 1 ) / value_size );
+        layout.offsets[n++] = bytes;
+        bytes += num_comp * value_size;
+        max_align = std::max( max_align, value_size );
+    };
+    (void)std::initializer_list<int>{ ( add_slice(
+                                      sliceNumComp( slices ),
+                                      sizeof( typename Slices::value_type ) ),
+                                  0 )... };
+    layout.bytes = max_align * ( ( bytes + max_align - 1 ) / max_align );
+    return layout;
+}
+
+//---------------------------------------------------------------------------//
+// Pack slice elements into a fused record buffer. Record i in the buffer gets
+// the slice element given by element_ids(i).
+template <class ExecutionSpace, class Slice_t, class IdView, class Buffer>
+void packFusedSlice( const Slice_t& slice, const IdView& element_ids,
+                     const Buffer& buffer, const std::size_t record_bytes,
+                     const std::size_t offset )
+{
+    using value_type = typename Slice_t::value_type;
+    std::size_t num_comp = sliceNumComp( slice );
+    auto slice_data = slice.data();
+    char* buffer_data = buffer.data();
+    auto pack_func = KOKKOS_LAMBDA( const std::size_t i )
+    {
+        auto s = Slice_t::index_type::s( element_ids( i ) );
+        auto a = Slice_t::index_type::a( element_ids( i ) );
+        std::size_t slice_offset = s * slice.stride( 0 ) + a;
+        value_type* record = reinterpret_cast<value_type*>(
+            buffer_data + i * record_bytes + offset );
+        for ( std::size_t n = 0; n < num_comp; ++n )
+            record[n] = slice_data[slice_offset + n * Slice_t::vector_length];
+    };
+    Kokkos::parallel_for( "Cabana::Impl::packFusedSlice",
+                          Kokkos::RangePolicy<ExecutionSpace>(
+                              0, element_ids.extent( 0 ) ),
+                          pack_func );
+}
+
+//---------------------------------------------------------------------------//
+// Unpack a fused record buffer into slice elements. Record i in the buffer is
+// written to slice element i + first_element.
+template <class ExecutionSpace, class Slice_t, class Buffer>
+void unpackFusedSlice( const Slice_t& slice, const std::size_t first_element,
+                       const std::size_t num_element, const Buffer& buffer,
+                       const std::size_t record_bytes,
+                       const std::size_t offset )
+{
+    using value_type = typename Slice_t::value_type;
+    std::size_t num_comp = sliceNumComp( slice );
+    auto slice_data = slice.data();
+    const char* buffer_data = buffer.data();
+    auto unpack_func = KOKKOS_LAMBDA( const std::size_t i )
+    {
+        std::size_t idx = i + first_element;
+        auto s = Slice_t::index_type::s( idx );
+        auto a = Slice_t::index_type::a( idx );
+        std::size_t slice_offset = s * slice.stride( 0 ) + a;
+        const value_type* record = reinterpret_cast<const value_type*>(
+            buffer_data + i * record_bytes + offset );
+        for ( std::size_t n = 0; n < num_comp; ++n )
+            slice_data[slice_offset + n * Slice_t::vector_length] = record[n];
+    };
+    Kokkos::parallel_for(
+        "Cabana::Impl::unpackFusedSlice",
+        Kokkos::RangePolicy<ExecutionSpace>( 0, num_element ), unpack_func );
+}
+
+//---------------------------------------------------------------------------//
+// Pack several slices into a fused record buffer.
+template <class ExecutionSpace, class IdView, class Buffer, std::size_t N,
+          std::size_t... Is, class... Slices>
+void packFusedSlicesImpl( const IdView& element_ids, const Buffer& buffer,
+                          const FusedRecordLayout<N>& layout,
+                          std::index_sequence<Is...>,
+                          const Slices&... slices )
+{
+    (void)std::initializer_list<int>{ (
+        packFusedSlice<ExecutionSpace>( slices, element_ids, buffer,
+                                        layout.bytes, layout.offsets[Is] ),
+        0 )... };
+    Kokkos::fence();
+}
+
+template <class ExecutionSpace, class IdView, class Buffer, std::size_t N,
+          class... Slices>
+void packFusedSlices( const IdView& element_ids, const Buffer& buffer,
+                      const FusedRecordLayout<N>& layout,
+                      const Slices&... slices )
+{
+    static_assert( N == sizeof...( Slices ),
+                   "Record layout does not match the number of slices" );
+    packFusedSlicesImpl<ExecutionSpace>( element_ids, buffer, layout,
+                                         std::make_index_sequence<N>(),
+                                         slices... );
+}
+
+//---------------------------------------------------------------------------//
+// Unpack a fused record buffer into several slices.
+template <class ExecutionSpace, class Buffer, std::size_t N, std::size_t... Is,
+          class... Slices>
+void unpackFusedSlicesImpl( const std::size_t first_element,
+                            const std::size_t num_element,
+                            const Buffer& buffer,
+                            const FusedRecordLayout<N>& layout,
+                            std::index_sequence<Is...>,
+                            const Slices&... slices )
+{
+    (void)std::initializer_list<int>{ (
+        unpackFusedSlice<ExecutionSpace>( slices, first_element, num_element,
+                                          buffer, layout.bytes,
+                                          layout.offsets[Is] ),
+        0 )... };
+    Kokkos::fence();
+}
+
+template <class ExecutionSpace, class Buffer, std::size_t N, class... Slices>
+void unpackFusedSlices( const std::size_t first_element,
+                        const std::size_t num_element, const Buffer& buffer,
+                        const FusedRecordLayout<N>& layout,
+                        const Slices&... slices )
+{
+    static_assert( N == sizeof...( Slices ),
+                   "Record layout does not match the number of slices" );
+    unpackFusedSlicesImpl<ExecutionSpace>( first_element, num_element, buffer,
+                                           layout,
+                                           std::make_index_sequence<N>(),
+                                           slices... );
+}
+
+//---------------------------------------------------------------------------//
+// Check if a type trait is true for all types in a parameter pack.
+template <template <class> class Trait, class... Types>
+struct AllOf;
+
+template <template <class> class Trait>
+struct AllOf<Trait> : public std::true_type
+{
+};
+
+template <template <class> class Trait, class T, class... Types>
+struct AllOf<Trait, T, Types...>
+    : public std::integral_constant<bool, Trait<T>::value &&
+                                              AllOf<Trait, Types...>::value>
+{
+};
+
+//---------------------------------------------------------------------------//
+//! \endcond
+} // end namespace Impl
+} // end namespace Cabana
+
+#endif // end CABANA_COMMUNICATIONPACKING_HPP
@@ -106,6 +106,30 @@ class PerformanceTraits<Kokkos::Experimental::OpenMPTarget>
 };
 #endif
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief Detect the preferred vector length for host execution spaces from
+  the SIMD instruction sets supported by the running CPU.
+
+  The vector length covers two registers of doubles: 16 for AVX-512, 8 for
+  AVX2 and 4 otherwise. If the instruction sets cannot be queried the
+  compile-time default is returned.
+*/
+inline int hostVectorLength( const int default_length )
+{
+#if ( defined( __GNUC__ ) || defined( __clang__ ) ) &&                         \
+    ( defined( __x86_64__ ) || defined( __i386__ ) )
+    __builtin_cpu_init();
+    if ( __builtin_cpu_supports( "avx512f" ) )
+        return 16;
+    if ( __builtin_cpu_supports( "avx2" ) )
+        return 8;
+    return 4;
+#else
+    return default_length;
+#endif
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Impl
@@ -0,0 +1,60 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cabana_Profiling.hpp
+  \brief Kokkos Tools profiling region utilities.
+
+  Cabana and Cajita operations are wrapped in Kokkos profiling regions named
+  after the operation (e.g. "Cabana::migrate", "Cajita::Halo::gather") with
+  nested regions for their phases (e.g. "Cabana::migrate::pack"). Time spent
+  blocked in MPI completion calls and barriers is always in a nested region
+  ending in "::wait" so tools can attribute it separately from the compute
+  phases.
+*/
+#ifndef CABANA_PROFILING_HPP
+#define CABANA_PROFILING_HPP
+
+#include <Kokkos_Core.hpp>
+
+#include <string>
+
+namespace Cabana
+{
+namespace Impl
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief Profiling region pushed on construction and popped on destruction
+  such that it is closed on every exit path of its scope.
+*/
+class ScopedProfileRegion
+{
+  public:
+    //! Push the region with the given name.
+    explicit ScopedProfileRegion( const std::string& name )
+    {
+        Kokkos::Profiling::pushRegion( name );
+    }
+
+    //! Pop the region.
+    ~ScopedProfileRegion() { Kokkos::Profiling::popRegion(); }
+
+    ScopedProfileRegion( const ScopedProfileRegion& ) = delete;
+    ScopedProfileRegion& operator=( const ScopedProfileRegion& ) = delete;
+};
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Impl
+} // end namespace Cabana
+
+#endif // end CABANA_PROFILING_HPP
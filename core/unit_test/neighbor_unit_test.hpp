@@ -431,6 +431,8 @@ void checkFirstNeighborParallelForLambda( const ListType& nlist,
     Kokkos::View<int*, memory_space> serial_result( "serial_result",
                                                     num_particle );
     Kokkos::View<int*, memory_space> team_result( "team_result", num_particle );
+    Kokkos::View<int*, memory_space> auto_result( "auto_result", num_particle );
+    Kokkos::View<int*, memory_space> pair_result( "pair_result", num_particle );
 
     // Test the list parallel operation by adding a value from each neighbor
     // to the particle and compare to counts.
@@ -442,6 +444,14 @@ void checkFirstNeighborParallelForLambda( const ListType& nlist,
     {
         Kokkos::atomic_add( &team_result( i ), n );
     };
+    auto auto_count_op = KOKKOS_LAMBDA( const int i, const int n )
+    {
+        Kokkos::atomic_add( &auto_result( i ), n );
+    };
+    auto pair_count_op = KOKKOS_LAMBDA( const int i, const int n )
+    {
+        Kokkos::atomic_add( &pair_result( i ), n );
+    };
     Kokkos::RangePolicy<TEST_EXECSPACE> policy( 0, num_particle );
     Cabana::neighbor_parallel_for( policy, serial_count_op, nlist,
                                    Cabana::FirstNeighborsTag(),
@@ -449,10 +459,64 @@ void checkFirstNeighborParallelForLambda( const ListType& nlist,
     Cabana::neighbor_parallel_for( policy, team_count_op, nlist,
                                    Cabana::FirstNeighborsTag(),
                                    Cabana::TeamOpTag(), "test_1st_team" );
+    Cabana::neighbor_parallel_for( policy, auto_count_op, nlist,
+                                   Cabana::FirstNeighborsTag(),
+                                   Cabana::AutoOpTag(), "test_1st_auto" );
+    Cabana::neighbor_parallel_for( policy, pair_count_op, nlist,
+                                   Cabana::FirstNeighborsTag(),
+                                   Cabana::PairOpTag(), "test_1st_pair" );
+    Kokkos::fence();
+
+    checkFirstNeighborParallelFor( N2_list_copy, serial_result, team_result,
+                                   1 );
+    checkFirstNeighborParallelFor( N2_list_copy, serial_result, auto_result,
+                                   1 );
+    checkFirstNeighborParallelFor( N2_list_copy, serial_result, pair_result,
+                                   1 );
+}
+
+//---------------------------------------------------------------------------//
+template <class ListType, class TestListType>
+void checkFusedFirstNeighborParallelFor( const ListType& nlist,
+                                         const TestListType& N2_list_copy,
+                                         const int num_particle )
+{
+    // Create Kokkos views for the write operation.
+    using memory_space = typename TEST_MEMSPACE::memory_space;
+    Kokkos::View<int*, memory_space> serial_result( "serial_result",
+                                                    num_particle );
+    Kokkos::View<int*, memory_space> team_result( "team_result", num_particle );
+    Kokkos::View<int*, memory_space> twice_result( "twice_result",
+                                                   num_particle );
+
+    // Evaluate two operations per neighbor in a single sweep.
+    auto serial_count_op = KOKKOS_LAMBDA( const int i, const int n )
+    {
+        Kokkos::atomic_add( &serial_result( i ), n );
+    };
+    auto team_count_op = KOKKOS_LAMBDA( const int i, const int n )
+    {
+        Kokkos::atomic_add( &team_result( i ), n );
+    };
+    auto twice_count_op = KOKKOS_LAMBDA( const int i, const int n )
+    {
+        Kokkos::atomic_add( &twice_result( i ), 2 * n );
+    };
+    Kokkos::RangePolicy<TEST_EXECSPACE> policy( 0, num_particle );
+    Cabana::neighbor_parallel_for(
+        policy, Cabana::fuseFunctors( serial_count_op, twice_count_op ), nlist,
+        Cabana::FirstNeighborsTag(), Cabana::SerialOpTag(),
+        "test_1st_fused_serial" );
+    Cabana::neighbor_parallel_for(
+        policy, Cabana::fuseFunctors( team_count_op, twice_count_op ), nlist,
+        Cabana::FirstNeighborsTag(), Cabana::TeamOpTag(),
+        "test_1st_fused_team" );
     Kokkos::fence();
 
     checkFirstNeighborParallelFor( N2_list_copy, serial_result, team_result,
                                    1 );
+    checkFirstNeighborParallelFor( N2_list_copy, twice_result, twice_result,
+                                   4 );
 }
 
 //---------------------------------------------------------------------------//
@@ -468,6 +532,7 @@ void checkSecondNeighborParallelForLambda( const ListType& nlist,
     Kokkos::View<int*, memory_space> team_result( "team_result", num_particle );
     Kokkos::View<int*, memory_space> vector_result( "vector_result",
                                                     num_particle );
+    Kokkos::View<int*, memory_space> auto_result( "auto_result", num_particle );
 
     // Test the list parallel operation by adding a value from each neighbor
     // to the particle and compare to counts.
@@ -477,6 +542,11 @@ void checkSecondNeighborParallelForLambda( const ListType& nlist,
         Kokkos::atomic_add( &serial_result( i ), j );
         Kokkos::atomic_add( &serial_result( i ), k );
     };
+    auto auto_count_op = KOKKOS_LAMBDA( const int i, const int j, const int k )
+    {
+        Kokkos::atomic_add( &auto_result( i ), j );
+        Kokkos::atomic_add( &auto_result( i ), k );
+    };
     auto team_count_op = KOKKOS_LAMBDA( const int i, const int j, const int k )
     {
         Kokkos::atomic_add( &team_result( i ), j );
@@ -498,10 +568,15 @@ void checkSecondNeighborParallelForLambda( const ListType& nlist,
     Cabana::neighbor_parallel_for(
         policy, vector_count_op, nlist, Cabana::SecondNeighborsTag(),
         Cabana::TeamVectorOpTag(), "test_2nd_vector" );
+    Cabana::neighbor_parallel_for( policy, auto_count_op, nlist,
+                                   Cabana::SecondNeighborsTag(),
+                                   Cabana::AutoOpTag(), "test_2nd_auto" );
     Kokkos::fence();
 
     checkSecondNeighborParallelFor( N2_list_copy, serial_result, team_result,
                                     vector_result, 1 );
+    checkSecondNeighborParallelFor( N2_list_copy, serial_result, team_result,
+                                    auto_result, 1 );
 }
 
 //---------------------------------------------------------------------------//
@@ -610,10 +685,16 @@ void checkFirstNeighborParallelReduceLambda( const ListType& nlist,
     Cabana::neighbor_parallel_reduce(
         policy, sum_op, nlist, Cabana::FirstNeighborsTag(), Cabana::TeamOpTag(),
         team_sum, "test_reduce_team" );
+    double pair_sum = 0;
+    Cabana::neighbor_parallel_reduce(
+        policy, sum_op, nlist, Cabana::FirstNeighborsTag(), Cabana::PairOpTag(),
+        pair_sum, "test_reduce_pair" );
     Kokkos::fence();
 
     checkFirstNeighborParallelReduce( N2_list_copy, aosoa, serial_sum, team_sum,
                                       1 );
+    checkFirstNeighborParallelReduce( N2_list_copy, aosoa, serial_sum, pair_sum,
+                                      1 );
 }
 
 //---------------------------------------------------------------------------//
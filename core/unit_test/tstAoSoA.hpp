@@ -11,6 +11,7 @@
 
 #include <Cabana_AoSoA.hpp>
 #include <Cabana_DeepCopy.hpp>
+#include <Cabana_Prefetch.hpp>
 #include <Cabana_Types.hpp>
 #include <impl/Cabana_Index.hpp>
 
@@ -18,6 +19,8 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 namespace Test
 {
 //---------------------------------------------------------------------------//
@@ -234,6 +237,59 @@ void testAoSoA()
     EXPECT_EQ( aosoa.arraySize( 2 ), int( 15 ) );
 }
 
+//---------------------------------------------------------------------------//
+// Capacity growth policy test.
+std::size_t testTripleGrowth( const std::size_t capacity, const std::size_t n )
+{
+    return std::max( n, 3 * capacity );
+}
+
+void testGrowthPolicy()
+{
+    // Manually set the inner array size.
+    const int vector_length = 16;
+
+    // Declare the AoSoA type.
+    using AoSoA_t = Cabana::AoSoA<Cabana::MemberTypes<double, int>,
+                                  TEST_MEMSPACE, vector_length>;
+
+    // The default policy allocates exactly what is needed.
+    AoSoA_t aosoa( "aosoa" );
+    EXPECT_EQ( aosoa.growthPolicy(), &Cabana::GrowthPolicy::exact );
+    aosoa.resize( 35 );
+    EXPECT_EQ( aosoa.capacity(), 48u );
+    aosoa.resize( 50 );
+    EXPECT_EQ( aosoa.capacity(), 64u );
+
+    // Doubling. Growth within the capacity does not reallocate.
+    aosoa.setGrowthPolicy( Cabana::GrowthPolicy::doubling );
+    aosoa.resize( 65 );
+    EXPECT_EQ( aosoa.capacity(), 128u );
+    auto data = aosoa.data();
+    aosoa.resize( 127 );
+    EXPECT_EQ( aosoa.capacity(), 128u );
+    EXPECT_EQ( aosoa.data(), data );
+
+    // A request beyond the grown capacity is allocated as requested.
+    aosoa.resize( 1000 );
+    EXPECT_EQ( aosoa.capacity(), 1008u );
+
+    // Factor of 1.5.
+    aosoa.setGrowthPolicy( Cabana::GrowthPolicy::oneAndHalf );
+    aosoa.resize( 1009 );
+    EXPECT_EQ( aosoa.capacity(), 1520u );
+
+    // User-defined policy.
+    aosoa.setGrowthPolicy( testTripleGrowth );
+    aosoa.resize( 1521 );
+    EXPECT_EQ( aosoa.capacity(), 4560u );
+    EXPECT_EQ( aosoa.size(), 1521u );
+
+    // Reserve is not affected by the policy.
+    aosoa.reserve( 4561 );
+    EXPECT_EQ( aosoa.capacity(), 4576u );
+}
+
 //---------------------------------------------------------------------------//
 // Raw data test.
 void testRawData()
@@ -592,6 +648,50 @@ void testUnmanaged()
     checkDataMembers( aosoa, fval, dval, ival, dim_1, dim_2, dim_3 );
 }
 
+//---------------------------------------------------------------------------//
+// Test prefetching and advice. These are only hints so the data must be
+// unchanged.
+void testPrefetch()
+{
+    using AoSoA_t =
+        Cabana::AoSoA<Cabana::MemberTypes<double[3], int>, TEST_MEMSPACE>;
+    int num_data = 357;
+    AoSoA_t aosoa( "aosoa", num_data );
+    auto slice_0 = Cabana::slice<0>( aosoa );
+    auto slice_1 = Cabana::slice<1>( aosoa );
+    Kokkos::parallel_for(
+        "fill", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_data ),
+        KOKKOS_LAMBDA( const int p ) {
+            for ( int d = 0; d < 3; ++d )
+                slice_0( p, d ) = p + d;
+            slice_1( p ) = p;
+        } );
+    Kokkos::fence();
+
+    Cabana::memAdvise( slice_0, Cabana::MemoryAdvice::ReadMostly,
+                       TEST_EXECSPACE() );
+    Cabana::memAdvise( aosoa, Cabana::MemoryAdvice::PreferredLocation,
+                       TEST_EXECSPACE() );
+    Cabana::prefetch( aosoa, TEST_EXECSPACE() );
+    Cabana::prefetch( slice_1, Kokkos::DefaultHostExecutionSpace() );
+    Kokkos::fence();
+    Cabana::clearMemAdvise( slice_0, Cabana::MemoryAdvice::ReadMostly,
+                            TEST_EXECSPACE() );
+    Cabana::clearMemAdvise( aosoa, Cabana::MemoryAdvice::PreferredLocation,
+                            TEST_EXECSPACE() );
+
+    auto mirror =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), aosoa );
+    auto mirror_0 = Cabana::slice<0>( mirror );
+    auto mirror_1 = Cabana::slice<1>( mirror );
+    for ( int p = 0; p < num_data; ++p )
+    {
+        for ( int d = 0; d < 3; ++d )
+            EXPECT_EQ( mirror_0( p, d ), p + d );
+        EXPECT_EQ( mirror_1( p ), p );
+    }
+}
+
 //---------------------------------------------------------------------------//
 // RUN TESTS
 //---------------------------------------------------------------------------//
@@ -609,6 +709,12 @@ TEST( TEST_CATEGORY, aosoa_access_test ) { testAccess(); }
 //---------------------------------------------------------------------------//
 TEST( TEST_CATEGORY, aosoa_unmanaged_test ) { testUnmanaged(); }
 
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, aosoa_growth_policy_test ) { testGrowthPolicy(); }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, aosoa_prefetch_test ) { testPrefetch(); }
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
@@ -0,0 +1,139 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_AppendBuffer.hpp>
+#include <Cabana_DeepCopy.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+void testAppend()
+{
+    // Create an AoSoA with some initial data.
+    using AoSoA_t =
+        Cabana::AoSoA<Cabana::MemberTypes<int, double[3]>, TEST_MEMSPACE>;
+    int num_data = 351;
+    AoSoA_t aosoa( "aosoa", num_data );
+    auto ids = Cabana::slice<0>( aosoa );
+    Kokkos::parallel_for(
+        "fill", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_data ),
+        KOKKOS_LAMBDA( const int p ) { ids( p ) = p; } );
+    Kokkos::fence();
+
+    // Every third existing element appends two new elements.
+    int num_append = 2 * ( ( num_data + 2 ) / 3 );
+    Cabana::AppendBuffer<AoSoA_t> buffer( aosoa, num_append );
+    Kokkos::parallel_for(
+        "append", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_data ),
+        KOKKOS_LAMBDA( const int p ) {
+            if ( p % 3 == 0 )
+            {
+                for ( int n = 0; n < 2; ++n )
+                {
+                    typename AoSoA_t::tuple_type tpl;
+                    Cabana::get<0>( tpl ) = num_data + 2 * p + n;
+                    for ( int d = 0; d < 3; ++d )
+                        Cabana::get<1>( tpl, d ) = p + 0.5 * d;
+                    buffer.append( tpl );
+                }
+            }
+        } );
+    Kokkos::fence();
+    EXPECT_EQ( buffer.available(), std::size_t( 0 ) );
+    EXPECT_EQ( buffer.commit( aosoa ), std::size_t( num_append ) );
+    EXPECT_EQ( aosoa.size(), std::size_t( num_data + num_append ) );
+
+    // Check the data.
+    auto mirror =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), aosoa );
+    auto ids_mirror = Cabana::slice<0>( mirror );
+    auto data_mirror = Cabana::slice<1>( mirror );
+    for ( int p = 0; p < num_data; ++p )
+        EXPECT_EQ( ids_mirror( p ), p );
+    std::vector<int> found;
+    for ( std::size_t p = num_data; p < mirror.size(); ++p )
+    {
+        int id = ids_mirror( p ) - num_data;
+        found.push_back( id );
+        for ( int d = 0; d < 3; ++d )
+            EXPECT_EQ( data_mirror( p, d ), id / 2 + 0.5 * d );
+    }
+    std::sort( found.begin(), found.end() );
+    std::vector<int> expected;
+    for ( int p = 0; p < num_data; p += 3 )
+    {
+        expected.push_back( 2 * p );
+        expected.push_back( 2 * p + 1 );
+    }
+    EXPECT_EQ( found, expected );
+}
+
+//---------------------------------------------------------------------------//
+void testAppendOverflow()
+{
+    using AoSoA_t = Cabana::AoSoA<Cabana::MemberTypes<int>, TEST_MEMSPACE>;
+    AoSoA_t aosoa( "aosoa", 10 );
+
+    // Claim more tuples than were reserved.
+    int max_append = 40;
+    Cabana::AppendBuffer<AoSoA_t> buffer( aosoa, max_append );
+    auto ids = Cabana::slice<0>( aosoa );
+    Kokkos::View<int, TEST_MEMSPACE> num_failed( "num_failed" );
+    Kokkos::parallel_for(
+        "claim", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, 20 ),
+        KOKKOS_LAMBDA( const int p ) {
+            auto first = buffer.claim( 3 );
+            if ( first < 0 )
+                Kokkos::atomic_increment( &num_failed() );
+            else
+                for ( int n = 0; n < 3; ++n )
+                    ids( first + n ) = p;
+        } );
+    Kokkos::fence();
+
+    // Only whole claims that fit are committed.
+    auto num_failed_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), num_failed );
+    EXPECT_EQ( num_failed_host(), 7 );
+    EXPECT_EQ( buffer.commit( aosoa ), std::size_t( 39 ) );
+    EXPECT_EQ( aosoa.size(), std::size_t( 49 ) );
+    EXPECT_EQ( buffer.available(), std::size_t( 1 ) );
+
+    // Each claimed range was written by a single producer.
+    auto mirror =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), aosoa );
+    auto ids_mirror = Cabana::slice<0>( mirror );
+    for ( std::size_t p = 10; p < mirror.size(); p += 3 )
+    {
+        EXPECT_EQ( ids_mirror( p ), ids_mirror( p + 1 ) );
+        EXPECT_EQ( ids_mirror( p ), ids_mirror( p + 2 ) );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, append_test ) { testAppend(); }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, append_overflow_test ) { testAppendOverflow(); }
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
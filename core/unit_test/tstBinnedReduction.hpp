@@ -0,0 +1,213 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_BinnedReduction.hpp>
+#include <Cabana_DeepCopy.hpp>
+#include <Cabana_Sort.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+// Check per-bin sums, minima, and maxima against a host reference.
+template <class ResultView>
+void checkBins( const std::vector<int>& keys, const std::vector<double>& values,
+                const int nbin, const ResultView& sum, const ResultView& min,
+                const ResultView& max )
+{
+    std::vector<double> sum_ref( nbin, 0.0 );
+    std::vector<double> min_ref( nbin, std::numeric_limits<double>::max() );
+    std::vector<double> max_ref( nbin, std::numeric_limits<double>::lowest() );
+    for ( std::size_t i = 0; i < keys.size(); ++i )
+    {
+        if ( keys[i] < 0 || keys[i] >= nbin )
+            continue;
+        sum_ref[keys[i]] += values[i];
+        min_ref[keys[i]] = std::min( min_ref[keys[i]], values[i] );
+        max_ref[keys[i]] = std::max( max_ref[keys[i]], values[i] );
+    }
+
+    auto sum_host = Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                         sum );
+    auto min_host = Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                         min );
+    auto max_host = Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                         max );
+    ASSERT_EQ( sum_host.extent( 0 ), static_cast<std::size_t>( nbin ) );
+    for ( int b = 0; b < nbin; ++b )
+    {
+        EXPECT_DOUBLE_EQ( sum_host( b ), sum_ref[b] );
+        EXPECT_DOUBLE_EQ( min_host( b ), min_ref[b] );
+        EXPECT_DOUBLE_EQ( max_host( b ), max_ref[b] );
+    }
+}
+
+//---------------------------------------------------------------------------//
+void keyReduceTest()
+{
+    // Keys with an empty bin and out of range keys.
+    int num_value = 200;
+    int nbin = 9;
+    std::vector<int> keys( num_value );
+    std::vector<double> values( num_value );
+    for ( int i = 0; i < num_value; ++i )
+    {
+        keys[i] = ( 7 * i ) % 11 - 1;
+        if ( 4 == keys[i] )
+            keys[i] = 3;
+        values[i] = 0.5 * i - 20.0;
+    }
+
+    Cabana::AoSoA<Cabana::MemberTypes<int, double>, Kokkos::HostSpace>
+        data_host( "data", num_value );
+    auto key_host = Cabana::slice<0>( data_host );
+    auto value_host = Cabana::slice<1>( data_host );
+    for ( int i = 0; i < num_value; ++i )
+    {
+        key_host( i ) = keys[i];
+        value_host( i ) = values[i];
+    }
+    auto data = Cabana::create_mirror_view_and_copy( TEST_MEMSPACE(),
+                                                     data_host );
+    auto key_slice = Cabana::slice<0>( data );
+    auto value_slice = Cabana::slice<1>( data );
+
+    // Unsorted keys.
+    auto sum = Cabana::binnedReduce( key_slice, nbin, value_slice,
+                                     Cabana::BinnedSum() );
+    auto min = Cabana::binnedReduce( key_slice, nbin, value_slice,
+                                     Cabana::BinnedMin() );
+    auto max = Cabana::binnedReduce( key_slice, nbin, value_slice,
+                                     Cabana::BinnedMax() );
+    checkBins( keys, values, nbin, sum, min, max );
+
+    // Sorted keys.
+    std::vector<int> order( num_value );
+    for ( int i = 0; i < num_value; ++i )
+        order[i] = i;
+    std::stable_sort( order.begin(), order.end(),
+                      [&]( int a, int b ) { return keys[a] < keys[b]; } );
+    std::vector<int> sorted_keys( num_value );
+    std::vector<double> sorted_values( num_value );
+    for ( int i = 0; i < num_value; ++i )
+    {
+        sorted_keys[i] = keys[order[i]];
+        sorted_values[i] = values[order[i]];
+        key_host( i ) = sorted_keys[i];
+        value_host( i ) = sorted_values[i];
+    }
+    Cabana::deep_copy( data, data_host );
+    sum = Cabana::binnedReduce( key_slice, nbin, value_slice,
+                                Cabana::BinnedSum(), true );
+    min = Cabana::binnedReduce( key_slice, nbin, value_slice,
+                                Cabana::BinnedMin(), true );
+    max = Cabana::binnedReduce( key_slice, nbin, value_slice,
+                                Cabana::BinnedMax(), true );
+    checkBins( sorted_keys, sorted_values, nbin, sum, min, max );
+}
+
+//---------------------------------------------------------------------------//
+void binningReduceTest()
+{
+    int num_value = 150;
+    Kokkos::View<double*, TEST_MEMSPACE> values( "values", num_value );
+    Kokkos::View<double*, TEST_MEMSPACE> positions( "positions", num_value );
+    Kokkos::parallel_for(
+        "fill", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_value ),
+        KOKKOS_LAMBDA( const int i ) {
+            positions( i ) = ( 13 * i ) % 37;
+            values( i ) = 1.5 * i;
+        } );
+    Kokkos::fence();
+
+    int nbin = 6;
+    auto bin_data = Cabana::binByKey( positions, nbin );
+
+    // Record the bin of each value from the binning itself.
+    Kokkos::View<int*, TEST_MEMSPACE> value_bins( "value_bins", num_value );
+    Kokkos::parallel_for(
+        "record_bins",
+        Kokkos::RangePolicy<TEST_EXECSPACE>( 0, bin_data.numBin() ),
+        KOKKOS_LAMBDA( const int b ) {
+            for ( int n = 0; n < bin_data.binSize( b ); ++n )
+                value_bins( bin_data.permutation( bin_data.binOffset( b ) +
+                                                  n ) ) = b;
+        } );
+    auto value_bins_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), value_bins );
+    auto values_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), values );
+    std::vector<int> keys( value_bins_host.data(),
+                           value_bins_host.data() + num_value );
+    std::vector<double> values_ref( values_host.data(),
+                                    values_host.data() + num_value );
+
+    auto sum = Cabana::binnedReduce( bin_data, values, Cabana::BinnedSum() );
+    auto min = Cabana::binnedReduce( bin_data, values, Cabana::BinnedMin() );
+    auto max = Cabana::binnedReduce( bin_data, values, Cabana::BinnedMax() );
+    checkBins( keys, values_ref, bin_data.numBin(), sum, min, max );
+
+    // The bin histogram matches the bin sizes.
+    auto counts = Cabana::histogram( bin_data );
+    auto counts_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), counts );
+    for ( int b = 0; b < bin_data.numBin(); ++b )
+        EXPECT_EQ( counts_host( b ),
+                   std::count( keys.begin(), keys.end(), b ) );
+}
+
+//---------------------------------------------------------------------------//
+void histogramTest()
+{
+    int num_value = 100;
+    Kokkos::View<double*, TEST_MEMSPACE> values( "values", num_value );
+    Kokkos::parallel_for(
+        "fill", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_value ),
+        KOKKOS_LAMBDA( const int i ) { values( i ) = 0.1 * i - 1.0; } );
+    Kokkos::fence();
+
+    // Values in [-1, 8.9]; count [0, 5] into 4 bins of width 1.25.
+    auto counts = Cabana::histogram( values, 4, 0.0, 5.0 );
+    auto counts_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), counts );
+    auto values_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), values );
+    std::vector<int> expected( 4, 0 );
+    for ( int i = 0; i < num_value; ++i )
+    {
+        double v = values_host( i );
+        if ( v >= 0.0 && v <= 5.0 )
+            ++expected[std::min( 3, static_cast<int>( v * ( 4 / 5.0 ) ) )];
+    }
+    for ( int b = 0; b < 4; ++b )
+        EXPECT_EQ( counts_host( b ), expected[b] );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, binned_key_reduce_test ) { keyReduceTest(); }
+
+TEST( TEST_CATEGORY, binned_binning_reduce_test ) { binningReduceTest(); }
+
+TEST( TEST_CATEGORY, histogram_test ) { histogramTest(); }
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
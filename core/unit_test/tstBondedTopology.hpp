@@ -0,0 +1,199 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_BondedTopology.hpp>
+#include <Cabana_DeepCopy.hpp>
+#include <Cabana_Distributor.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+using ParticleTypes = Cabana::MemberTypes<int>;
+using Particles_t = Cabana::AoSoA<ParticleTypes, TEST_MEMSPACE>;
+
+//---------------------------------------------------------------------------//
+// Set the particles of a rank with a ghost copy of the first particle of the
+// next rank.
+void createParticles( Particles_t& particles, const int owner_rank,
+                      const int next_rank, const int num_owned )
+{
+    Cabana::AoSoA<ParticleTypes, Kokkos::HostSpace> particles_host(
+        "particles_host", num_owned + 1 );
+    auto ids = Cabana::slice<0>( particles_host );
+    for ( int p = 0; p < num_owned; ++p )
+        ids( p ) = owner_rank * num_owned + p;
+    ids( num_owned ) = next_rank * num_owned;
+    particles.resize( num_owned + 1 );
+    Cabana::deep_copy( particles, particles_host );
+}
+
+//---------------------------------------------------------------------------//
+// Check that every resolved bond is visited with the local indices of its
+// particles and return the number of bonds visited.
+template <class BondListType>
+int checkBonds( const BondListType& bonds, const Particles_t& particles )
+{
+    auto ids = Cabana::slice<0>( particles );
+    auto bond_ids = Cabana::slice<0>( bonds.ids() );
+    Kokkos::View<int*, TEST_MEMSPACE> visited( "visited", bonds.size() );
+    auto check_op = KOKKOS_LAMBDA( const int b, const int i, const int j,
+                                   const int k )
+    {
+        visited( b ) = ( ids( i ) == bond_ids( b, 0 ) &&
+                         ids( j ) == bond_ids( b, 1 ) &&
+                         ids( k ) == bond_ids( b, 2 ) )
+                           ? 1
+                           : -1;
+    };
+    Kokkos::RangePolicy<TEST_EXECSPACE> policy( 0, bonds.size() );
+    Cabana::bond_parallel_for( policy, check_op, bonds, "test_bond_op" );
+    Kokkos::fence();
+
+    auto visited_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), visited );
+    int num_visited = 0;
+    for ( std::size_t b = 0; b < bonds.size(); ++b )
+    {
+        EXPECT_GE( visited_host( b ), 0 );
+        num_visited += visited_host( b );
+    }
+    return num_visited;
+}
+
+//---------------------------------------------------------------------------//
+void testBondedTopology( const bool use_topology )
+{
+    int my_rank = -1;
+    MPI_Comm_rank( MPI_COMM_WORLD, &my_rank );
+    int my_size = -1;
+    MPI_Comm_size( MPI_COMM_WORLD, &my_size );
+    int next_rank = ( my_rank + 1 ) % my_size;
+    int prev_rank = ( my_rank + my_size - 1 ) % my_size;
+
+    // Each rank owns a chain of particles with a ghost of the first particle
+    // of the next rank such that the chains form a ring.
+    int num_owned = 10;
+    Particles_t particles( "particles" );
+    createParticles( particles, my_rank, next_rank, num_owned );
+
+    // Create an angle for each particle of the chain with its two successors
+    // in the ring. The last two angles reach into the next rank and only the
+    // second to last can be resolved with the ghost.
+    Cabana::Angles<TEST_MEMSPACE> angles( "angles", num_owned );
+    auto angles_host = Cabana::create_mirror_view( Kokkos::HostSpace(),
+                                                   angles.ids() );
+    auto angle_ids_host = Cabana::slice<0>( angles_host );
+    int num_global = num_owned * my_size;
+    for ( int b = 0; b < num_owned; ++b )
+        for ( int n = 0; n < 3; ++n )
+            angle_ids_host( b, n ) =
+                ( my_rank * num_owned + b + n ) % num_global;
+    Cabana::deep_copy( angles.ids(), angles_host );
+    EXPECT_EQ( angles.numUnresolved(), angles.size() );
+
+    // Resolve the angles. With a single rank the ghost is a copy of an owned
+    // particle and every angle is resolved.
+    auto ids = Cabana::slice<0>( particles );
+    std::size_t num_unresolved = ( 1 == my_size ) ? 0 : 1;
+    EXPECT_EQ( angles.update( ids, num_owned, num_owned + 1 ),
+               num_unresolved );
+    EXPECT_EQ( angles.numUnresolved(), num_unresolved );
+    EXPECT_EQ( checkBonds( angles, particles ),
+               num_owned - static_cast<int>( num_unresolved ) );
+
+    // The owned copy of a particle takes precedence over its ghost.
+    auto indices_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), angles.indices() );
+    for ( int b = 0; b < num_owned - 2; ++b )
+        for ( int n = 0; n < 3; ++n )
+            EXPECT_EQ( indices_host( b, n ), b + n );
+    EXPECT_EQ( indices_host( num_owned - 2, 2 ),
+               ( 1 == my_size ) ? 0 : num_owned );
+
+    // Without the ghost the angles reaching into the next rank are not
+    // resolved.
+    std::size_t num_no_ghost = ( 1 == my_size ) ? 0 : 2;
+    EXPECT_EQ( angles.update( ids, num_owned, num_owned ), num_no_ghost );
+    EXPECT_EQ( checkBonds( angles, particles ),
+               num_owned - static_cast<int>( num_no_ghost ) );
+    angles.update( ids, num_owned, num_owned + 1 );
+
+    // Send every particle to the next rank. The angles follow their first
+    // particle.
+    Kokkos::View<int*, TEST_MEMSPACE> export_ranks( "export_ranks",
+                                                    num_owned );
+    Kokkos::deep_copy( export_ranks, next_rank );
+    std::vector<int> neighbor_ranks = { prev_rank, my_rank, next_rank };
+    std::sort( neighbor_ranks.begin(), neighbor_ranks.end() );
+    neighbor_ranks.erase(
+        std::unique( neighbor_ranks.begin(), neighbor_ranks.end() ),
+        neighbor_ranks.end() );
+    if ( use_topology )
+        angles.migrate( MPI_COMM_WORLD, export_ranks, neighbor_ranks );
+    else
+        angles.migrate( MPI_COMM_WORLD, export_ranks );
+    EXPECT_EQ( angles.size(), static_cast<std::size_t>( num_owned ) );
+    EXPECT_EQ( angles.numUnresolved(), angles.size() );
+    EXPECT_EQ( checkBonds( angles, particles ), 0 );
+
+    // Migrate the particles and the ghost of the next chain, which is now
+    // the first particle of this rank.
+    particles.resize( num_owned );
+    Cabana::Distributor<TEST_MEMSPACE> distributor( MPI_COMM_WORLD,
+                                                    export_ranks );
+    Cabana::migrate( distributor, particles );
+    createParticles( particles, prev_rank, my_rank, num_owned );
+
+    // The angles of the previous rank are now resolved here.
+    ids = Cabana::slice<0>( particles );
+    EXPECT_EQ( angles.update( ids, num_owned, num_owned + 1 ),
+               num_unresolved );
+    EXPECT_EQ( checkBonds( angles, particles ),
+               num_owned - static_cast<int>( num_unresolved ) );
+    angles_host = Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                       angles.ids() );
+    angle_ids_host = Cabana::slice<0>( angles_host );
+    for ( int b = 0; b < num_owned; ++b )
+        EXPECT_EQ( angle_ids_host( b, 0 ) / num_owned, prev_rank );
+
+    // Removing the first particle of an angle removes the angle.
+    Kokkos::deep_copy( Kokkos::subview( export_ranks, 0 ), -1 );
+    angles.migrate( MPI_COMM_WORLD, export_ranks );
+    int num_global_angles = 0;
+    int num_local_angles = angles.size();
+    MPI_Allreduce( &num_local_angles, &num_global_angles, 1, MPI_INT, MPI_SUM,
+                   MPI_COMM_WORLD );
+    EXPECT_EQ( num_global_angles, ( num_owned - 1 ) * my_size );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, bonded_topology_test ) { testBondedTopology( true ); }
+
+TEST( TEST_CATEGORY, bonded_topology_test_no_topo )
+{
+    testBondedTopology( false );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
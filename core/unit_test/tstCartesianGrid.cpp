@@ -56,4 +56,38 @@ TEST( cabana_cartesian_grid, grid_test )
     EXPECT_EQ( kc, 9 );
 }
 
+TEST( cabana_cartesian_grid, thin_grid_test )
+{
+    // A zero extent dimension and a dimension thinner than a cell.
+    double min[3] = { -1.0, -0.5, 0.3 };
+    double max[3] = { 2.5, -0.4, 0.3 };
+    double delta[3] = { 0.5, 0.25, 0.25 };
+
+    Cabana::Impl::CartesianGrid<double> grid( min[0], min[1], min[2], max[0],
+                                              max[1], max[2], delta[0],
+                                              delta[1], delta[2] );
+
+    int nx, ny, nz;
+    grid.numCells( nx, ny, nz );
+    EXPECT_EQ( nx, 7 );
+    EXPECT_EQ( ny, 1 );
+    EXPECT_EQ( nz, 1 );
+
+    // The thin dimensions have a single cell of the requested size.
+    EXPECT_DOUBLE_EQ( grid.cellSize( 1 ), 0.25 );
+    EXPECT_DOUBLE_EQ( grid.cellSize( 2 ), 0.25 );
+
+    double xp = 1.1;
+    double yp = -0.45;
+    double zp = 0.3;
+    int ic, jc, kc;
+    grid.locatePoint( xp, yp, zp, ic, jc, kc );
+    EXPECT_EQ( ic, 4 );
+    EXPECT_EQ( jc, 0 );
+    EXPECT_EQ( kc, 0 );
+
+    double min_dist = grid.minDistanceToPoint( xp, yp, zp, ic, jc, kc );
+    EXPECT_NEAR( min_dist, 0.0, 1.0e-12 );
+}
+
 } // end namespace Test
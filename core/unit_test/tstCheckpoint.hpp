@@ -0,0 +1,91 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_Checkpoint.hpp>
+#include <Cabana_DeepCopy.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+void checkpointTest()
+{
+    // Fill an AoSoA with a partially filled last block.
+    int num_data = 37;
+    using member_types = Cabana::MemberTypes<double[3], int, float[2][2]>;
+    Cabana::AoSoA<member_types, Kokkos::HostSpace, 8> data_host( "data",
+                                                                 num_data );
+    auto x_host = Cabana::slice<0>( data_host );
+    auto id_host = Cabana::slice<1>( data_host );
+    auto m_host = Cabana::slice<2>( data_host );
+    for ( int p = 0; p < num_data; ++p )
+    {
+        for ( int d = 0; d < 3; ++d )
+            x_host( p, d ) = 0.1 * p + d;
+        id_host( p ) = 2 * p + 1;
+        for ( int i = 0; i < 2; ++i )
+            for ( int j = 0; j < 2; ++j )
+                m_host( p, i, j ) = p * i - j;
+    }
+    auto data =
+        Cabana::create_mirror_view_and_copy( TEST_MEMSPACE(), data_host );
+
+    Cabana::checkpoint( data, "checkpoint_test.bin" );
+
+    // Restart into an AoSoA of a different size.
+    Cabana::AoSoA<member_types, TEST_MEMSPACE, 8> restart( "restart", 3 );
+    Cabana::restart( restart, "checkpoint_test.bin" );
+    EXPECT_EQ( restart.size(), data.size() );
+
+    auto restart_host =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), restart );
+    auto x_check = Cabana::slice<0>( restart_host );
+    auto id_check = Cabana::slice<1>( restart_host );
+    auto m_check = Cabana::slice<2>( restart_host );
+    for ( int p = 0; p < num_data; ++p )
+    {
+        for ( int d = 0; d < 3; ++d )
+            EXPECT_DOUBLE_EQ( x_check( p, d ), x_host( p, d ) );
+        EXPECT_EQ( id_check( p ), id_host( p ) );
+        for ( int i = 0; i < 2; ++i )
+            for ( int j = 0; j < 2; ++j )
+                EXPECT_FLOAT_EQ( m_check( p, i, j ), m_host( p, i, j ) );
+    }
+
+    // Restarting with a different vector length or different member types
+    // must fail.
+    Cabana::AoSoA<member_types, TEST_MEMSPACE, 16> wrong_length( "wrong" );
+    EXPECT_THROW( Cabana::restart( wrong_length, "checkpoint_test.bin" ),
+                  std::runtime_error );
+    using wrong_types = Cabana::MemberTypes<double[3], float, float[2][2]>;
+    Cabana::AoSoA<wrong_types, TEST_MEMSPACE, 8> wrong_members( "wrong" );
+    EXPECT_THROW( Cabana::restart( wrong_members, "checkpoint_test.bin" ),
+                  std::runtime_error );
+
+    // Missing files must fail.
+    EXPECT_THROW( Cabana::restart( restart, "no_such_checkpoint.bin" ),
+                  std::runtime_error );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, checkpoint_test ) { checkpointTest(); }
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
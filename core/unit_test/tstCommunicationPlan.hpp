@@ -576,6 +576,83 @@ void test7( const bool use_topology )
         EXPECT_EQ( n, host_steering( n ) );
 }
 
+//---------------------------------------------------------------------------//
+template <class AlgorithmTag>
+void testSteering( const int comm_size, AlgorithmTag tag )
+{
+    // Export every third element to no rank and the others cyclically with
+    // more elements sent to the low ranks.
+    int num_data = 1000;
+    Kokkos::View<int*, TEST_MEMSPACE> export_ranks( "export_ranks", num_data );
+    Kokkos::parallel_for(
+        "fill", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_data ),
+        KOKKOS_LAMBDA( const int n ) {
+            export_ranks( n ) = ( n % 3 == 0 ) ? -1 : ( n * n / 7 ) % comm_size;
+        } );
+    Kokkos::fence();
+
+    auto counts_and_ids = Cabana::Impl::countSendsAndCreateSteering(
+        export_ranks, comm_size, tag );
+    auto counts_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), counts_and_ids.first );
+    auto ids_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), counts_and_ids.second );
+    auto ranks_host = Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                           export_ranks );
+
+    // Check the counts and that the ids of each rank are unique and within
+    // its count.
+    std::vector<int> expected_counts( comm_size, 0 );
+    for ( int n = 0; n < num_data; ++n )
+        if ( ranks_host( n ) >= 0 )
+            ++expected_counts[ranks_host( n )];
+    std::vector<std::vector<int>> found( comm_size );
+    for ( int r = 0; r < comm_size; ++r )
+    {
+        EXPECT_EQ( counts_host( r ), expected_counts[r] );
+        found[r].assign( expected_counts[r], 0 );
+    }
+    for ( int n = 0; n < num_data; ++n )
+    {
+        int r = ranks_host( n );
+        if ( r >= 0 )
+        {
+            ASSERT_LT( ids_host( n ), found[r].size() );
+            ++found[r][ids_host( n )];
+        }
+    }
+    for ( int r = 0; r < comm_size; ++r )
+        for ( auto f : found[r] )
+            EXPECT_EQ( f, 1 );
+}
+
+//---------------------------------------------------------------------------//
+void testSteeringAlgorithms()
+{
+    for ( int comm_size : { 1, 5, 100 } )
+    {
+        testSteering( comm_size,
+                      Cabana::Impl::CountSendsAndCreateSteeringDuplicated() );
+        testSteering( comm_size,
+                      Cabana::Impl::CountSendsAndCreateSteeringAtomic() );
+        testSteering( comm_size,
+                      Cabana::Impl::CountSendsAndCreateSteeringSort() );
+    }
+
+    // Check the selection. Large concurrencies never use the duplicated
+    // algorithm.
+    using Choice = Cabana::Impl::CountSendsAndCreateSteeringChoice;
+    auto select = []( const int num_neighbor, const int concurrency ) {
+        return Cabana::Impl::selectCountSendsAndCreateSteering<TEST_EXECSPACE>(
+            num_neighbor, 100000, concurrency );
+    };
+    EXPECT_EQ( select( 27, 1 << 20 ), Choice::Atomic );
+    EXPECT_EQ( select( 1000, 1 << 20 ), Choice::Sort );
+    bool host_space = Kokkos::SpaceAccessibility<
+        Kokkos::HostSpace, TEST_EXECSPACE::memory_space>::accessible;
+    EXPECT_EQ( select( 1000, 1 ) == Choice::Duplicated, host_space );
+}
+
 //---------------------------------------------------------------------------//
 void testTopology()
 {
@@ -632,6 +709,8 @@ TEST( TEST_CATEGORY, comm_plan_test_7_no_topo ) { test7( false ); }
 
 TEST( TEST_CATEGORY, comm_plan_test_topology ) { testTopology(); }
 
+TEST( TEST_CATEGORY, comm_plan_test_steering ) { testSteeringAlgorithms(); }
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
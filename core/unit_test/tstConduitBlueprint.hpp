@@ -0,0 +1,96 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_ConduitBlueprint.hpp>
+#include <Cabana_DeepCopy.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <conduit.hpp>
+#include <conduit_blueprint.hpp>
+
+#include <gtest/gtest.h>
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+void particleMeshTest()
+{
+    // Fill particles spanning several SoA blocks.
+    int num_particle = 21;
+    using member_types = Cabana::MemberTypes<double[3], int, float[2][2]>;
+    Cabana::AoSoA<member_types, Kokkos::HostSpace, 4> particles_host(
+        "particles", num_particle );
+    auto x_host = Cabana::slice<0>( particles_host );
+    auto id_host = Cabana::slice<1>( particles_host );
+    auto m_host = Cabana::slice<2>( particles_host );
+    for ( int p = 0; p < num_particle; ++p )
+    {
+        for ( int d = 0; d < 3; ++d )
+            x_host( p, d ) = 0.5 * p + d;
+        id_host( p ) = 3 * p;
+        for ( int i = 0; i < 2; ++i )
+            for ( int j = 0; j < 2; ++j )
+                m_host( p, i, j ) = p + 2 * i + j;
+    }
+    auto particles =
+        Cabana::create_mirror_view_and_copy( TEST_MEMSPACE(), particles_host );
+    auto x = Cabana::slice<0>( particles, "positions" );
+    auto id = Cabana::slice<1>( particles, "ids" );
+    auto m = Cabana::slice<2>( particles, "matrix" );
+
+    // Publish on the host and check the mesh.
+    Cabana::Experimental::ConduitBlueprint::ParticleAdapter<Kokkos::HostSpace>
+        adapter;
+    conduit::Node mesh;
+    adapter.publish( mesh, num_particle, x, id, m );
+
+    conduit::Node info;
+    EXPECT_TRUE( conduit::blueprint::mesh::verify( mesh, info ) );
+    EXPECT_EQ( mesh["topologies/particles/elements/shape"].as_string(),
+               "point" );
+
+    const char* axes[3] = { "x", "y", "z" };
+    for ( int d = 0; d < 3; ++d )
+    {
+        const double* coords =
+            mesh[std::string( "coordsets/particles_coords/values/" ) +
+                 axes[d]]
+                .as_double_ptr();
+        for ( int p = 0; p < num_particle; ++p )
+            EXPECT_DOUBLE_EQ( coords[p], x_host( p, d ) );
+    }
+
+    const int* ids = mesh["fields/ids/values"].as_int_ptr();
+    for ( int p = 0; p < num_particle; ++p )
+        EXPECT_EQ( ids[p], id_host( p ) );
+
+    EXPECT_EQ( mesh["fields/matrix/values"].number_of_children(), 4 );
+    for ( int i = 0; i < 2; ++i )
+        for ( int j = 0; j < 2; ++j )
+        {
+            const float* values =
+                mesh["fields/matrix/values/" + std::to_string( i * 2 + j )]
+                    .as_float_ptr();
+            for ( int p = 0; p < num_particle; ++p )
+                EXPECT_FLOAT_EQ( values[p], m_host( p, i, j ) );
+        }
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, blueprint_particle_test ) { particleMeshTest(); }
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
@@ -133,6 +133,114 @@ void testDeepCopy()
 
     // Check values.
     checkDataMembers( dst_aosoa_2, fval, dval, ival, dim_1, dim_2, dim_3 );
+
+    // Deep copy asynchronously on an execution space instance.
+    TEST_EXECSPACE exec_space;
+    DstAoSoA_t dst_aosoa_3( "dst", num_data );
+    Cabana::deep_copy( exec_space, dst_aosoa_3, src_aosoa );
+    exec_space.fence();
+    checkDataMembers( dst_aosoa_3, fval, dval, ival, dim_1, dim_2, dim_3 );
+
+    // Deep copy asynchronously by slice.
+    DstAoSoA_t dst_aosoa_4( "dst", num_data );
+    auto async_slice_0 = Cabana::slice<0>( dst_aosoa_4 );
+    auto async_slice_1 = Cabana::slice<1>( dst_aosoa_4 );
+    auto async_slice_2 = Cabana::slice<2>( dst_aosoa_4 );
+    auto async_slice_3 = Cabana::slice<3>( dst_aosoa_4 );
+    Cabana::deep_copy( exec_space, async_slice_0, slice_0 );
+    Cabana::deep_copy( exec_space, async_slice_1, slice_1 );
+    Cabana::deep_copy( exec_space, async_slice_2, slice_2 );
+    Cabana::deep_copy( exec_space, async_slice_3, slice_3 );
+    exec_space.fence();
+    checkDataMembers( dst_aosoa_4, fval, dval, ival, dim_1, dim_2, dim_3 );
+}
+
+//---------------------------------------------------------------------------//
+// Check a ranged deep copy. Elements outside the range must be unchanged and
+// only the given members copied inside it.
+template <class AoSoA_t>
+void checkRangeDeepCopy( const AoSoA_t& dst, const int dst_begin,
+                         const int src_begin, const int count,
+                         const bool copy_ids )
+{
+    auto mirror =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), dst );
+    auto ids = Cabana::slice<0>( mirror );
+    auto data = Cabana::slice<1>( mirror );
+    for ( int i = 0; i < static_cast<int>( mirror.size() ); ++i )
+    {
+        bool in_range = ( i >= dst_begin && i < dst_begin + count );
+        int src_i = i - dst_begin + src_begin;
+        EXPECT_EQ( ids( i ), ( in_range && copy_ids ) ? src_i : -1 );
+        for ( int d = 0; d < 3; ++d )
+            EXPECT_EQ( data( i, d ), in_range ? src_i + 0.5 * d : -1.0 );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Perform a ranged deep copy test.
+template <class DstMemorySpace, class SrcMemorySpace, int DstVectorLength,
+          int SrcVectorLength>
+void testRangeDeepCopy()
+{
+    using DataTypes = Cabana::MemberTypes<int, double[3]>;
+    using DstAoSoA_t =
+        Cabana::AoSoA<DataTypes, DstMemorySpace, DstVectorLength>;
+    using SrcAoSoA_t =
+        Cabana::AoSoA<DataTypes, SrcMemorySpace, SrcVectorLength>;
+
+    int num_data = 357;
+    SrcAoSoA_t src_aosoa( "src", num_data );
+    auto src_ids = Cabana::slice<0>( src_aosoa );
+    auto src_data = Cabana::slice<1>( src_aosoa );
+    Kokkos::parallel_for(
+        "initialize",
+        Kokkos::RangePolicy<typename SrcMemorySpace::execution_space>(
+            0, num_data ),
+        KOKKOS_LAMBDA( const int i ) {
+            src_ids( i ) = i;
+            for ( int d = 0; d < 3; ++d )
+                src_data( i, d ) = i + 0.5 * d;
+        } );
+    Kokkos::fence();
+
+    DstAoSoA_t dst_aosoa( "dst", num_data );
+    auto dst_ids = Cabana::slice<0>( dst_aosoa );
+    auto dst_data = Cabana::slice<1>( dst_aosoa );
+
+    // Ranges starting at different struct positions, at the same struct
+    // position with whole structs in the middle, and within one struct.
+    int begins[3][3] = { { 13, 30, 200 }, { 19, 35, 250 }, { 70, 6, 5 } };
+    for ( int r = 0; r < 3; ++r )
+    {
+        int dst_begin = begins[r][0];
+        int src_begin = begins[r][1];
+        int count = begins[r][2];
+
+        // Copy all members.
+        Cabana::deep_copy( dst_ids, -1 );
+        Cabana::deep_copy( dst_data, -1.0 );
+        Cabana::deep_copy( dst_aosoa, dst_begin, src_aosoa, src_begin, count );
+        checkRangeDeepCopy( dst_aosoa, dst_begin, src_begin, count, true );
+
+        // Copy a subset of members.
+        Cabana::deep_copy( dst_ids, -1 );
+        Cabana::deep_copy( dst_data, -1.0 );
+        Cabana::deep_copy<1>( dst_aosoa, dst_begin, src_aosoa, src_begin,
+                              count );
+        checkRangeDeepCopy( dst_aosoa, dst_begin, src_begin, count, false );
+    }
+
+    // Copy a subset of members of the whole AoSoA.
+    Cabana::deep_copy( dst_ids, -1 );
+    Cabana::deep_copy( dst_data, -1.0 );
+    Cabana::deep_copy<1>( dst_aosoa, src_aosoa );
+    checkRangeDeepCopy( dst_aosoa, 0, 0, num_data, false );
+
+    // Out of bounds ranges throw.
+    EXPECT_THROW(
+        Cabana::deep_copy( dst_aosoa, num_data - 10, src_aosoa, 0, 11 ),
+        std::runtime_error );
 }
 
 //---------------------------------------------------------------------------//
@@ -288,6 +396,42 @@ void testAssign()
         EXPECT_EQ( host_slice_0( n, 1 ), fval );
         EXPECT_EQ( host_slice_1( n ), ival );
     }
+
+    // Assign asynchronously on an execution space instance.
+    TEST_EXECSPACE exec_space;
+    fval = 1.1;
+    ival = 3;
+    Cabana::get<0>( tp, 0 ) = fval;
+    Cabana::get<0>( tp, 1 ) = fval;
+    Cabana::get<1>( tp ) = ival;
+    Cabana::deep_copy( exec_space, aosoa, tp );
+    exec_space.fence();
+    host_aosoa =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), aosoa );
+    host_slice_0 = Cabana::slice<0>( host_aosoa );
+    host_slice_1 = Cabana::slice<1>( host_aosoa );
+    for ( int n = 0; n < num_data; ++n )
+    {
+        EXPECT_EQ( host_slice_0( n, 0 ), fval );
+        EXPECT_EQ( host_slice_0( n, 1 ), fval );
+        EXPECT_EQ( host_slice_1( n ), ival );
+    }
+
+    fval = 2.5;
+    ival = 7;
+    Cabana::deep_copy( exec_space, slice_0, fval );
+    Cabana::deep_copy( exec_space, slice_1, ival );
+    exec_space.fence();
+    host_aosoa =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), aosoa );
+    host_slice_0 = Cabana::slice<0>( host_aosoa );
+    host_slice_1 = Cabana::slice<1>( host_aosoa );
+    for ( int n = 0; n < num_data; ++n )
+    {
+        EXPECT_EQ( host_slice_0( n, 0 ), fval );
+        EXPECT_EQ( host_slice_0( n, 1 ), fval );
+        EXPECT_EQ( host_slice_1( n ), ival );
+    }
 }
 
 //---------------------------------------------------------------------------//
@@ -318,6 +462,15 @@ TEST( TEST_CATEGORY, deep_copy_from_host_different_layout_test )
     testDeepCopy<TEST_MEMSPACE, Kokkos::HostSpace, 16, 32>();
 }
 
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, deep_copy_range_test )
+{
+    testRangeDeepCopy<Kokkos::HostSpace, TEST_MEMSPACE, 16, 16>();
+    testRangeDeepCopy<TEST_MEMSPACE, Kokkos::HostSpace, 16, 16>();
+    testRangeDeepCopy<Kokkos::HostSpace, TEST_MEMSPACE, 16, 32>();
+    testRangeDeepCopy<TEST_MEMSPACE, Kokkos::HostSpace, 64, 8>();
+}
+
 //---------------------------------------------------------------------------//
 TEST( TEST_CATEGORY, mirror_test ) { testMirror(); }
 
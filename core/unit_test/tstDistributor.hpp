@@ -12,6 +12,7 @@
 #include <Cabana_AoSoA.hpp>
 #include <Cabana_DeepCopy.hpp>
 #include <Cabana_Distributor.hpp>
+#include <Cabana_GroupedAoSoA.hpp>
 #include <Cabana_Parallel.hpp>
 
 #include <Kokkos_Core.hpp>
@@ -166,6 +167,73 @@ void test2( const bool use_topology )
     }
 }
 
+//---------------------------------------------------------------------------//
+// Migrate a GroupedAoSoA between buffers and in-place. Every rank sends every
+// other piece of data to itself.
+void testGrouped()
+{
+    int my_rank = -1;
+    MPI_Comm_rank( MPI_COMM_WORLD, &my_rank );
+    int num_data = 10;
+    Kokkos::View<int*, Kokkos::HostSpace> export_ranks_host( "export_ranks",
+                                                             num_data );
+    for ( int n = 0; n < num_data; ++n )
+        export_ranks_host( n ) = ( 0 == n % 2 ) ? my_rank : -1;
+    auto export_ranks = Kokkos::create_mirror_view_and_copy(
+        TEST_MEMSPACE(), export_ranks_host );
+    Cabana::Distributor<TEST_MEMSPACE> distributor( MPI_COMM_WORLD,
+                                                    export_ranks );
+
+    // Make some data to migrate with a hot and a cold group.
+    using Hot = Cabana::MemberTypes<double[2]>;
+    using Cold = Cabana::MemberTypes<int, float>;
+    using AoSoA_t =
+        Cabana::GroupedAoSoA<Cabana::MemberGroups<Hot, Cold>, TEST_MEMSPACE>;
+    AoSoA_t data( "data", num_data );
+    auto slice_dbl = Cabana::slice<0>( data );
+    auto slice_int = Cabana::slice<1>( data );
+    auto slice_flt = Cabana::slice<2>( data );
+    auto fill_func = KOKKOS_LAMBDA( const int i )
+    {
+        slice_dbl( i, 0 ) = my_rank + i;
+        slice_dbl( i, 1 ) = my_rank + i + 0.5;
+        slice_int( i ) = my_rank + i;
+        slice_flt( i ) = my_rank + i + 0.25;
+    };
+    Kokkos::RangePolicy<TEST_EXECSPACE> range_policy( 0, num_data );
+    Kokkos::parallel_for( range_policy, fill_func );
+    Kokkos::fence();
+
+    // Check the migrated data of both groups.
+    auto steering = distributor.getExportSteering();
+    auto host_steering =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), steering );
+    auto check = [&]( const AoSoA_t& migrated ) {
+        EXPECT_EQ( migrated.size(), num_data / 2 );
+        auto hot_host = Cabana::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), migrated.group<0>() );
+        auto cold_host = Cabana::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), migrated.group<1>() );
+        auto dbl_host = Cabana::slice<0>( hot_host );
+        auto int_host = Cabana::slice<0>( cold_host );
+        auto flt_host = Cabana::slice<1>( cold_host );
+        for ( int i = 0; i < num_data / 2; ++i )
+        {
+            EXPECT_EQ( dbl_host( i, 0 ), my_rank + host_steering( i ) );
+            EXPECT_EQ( dbl_host( i, 1 ), my_rank + host_steering( i ) + 0.5 );
+            EXPECT_EQ( int_host( i ), my_rank + host_steering( i ) );
+            EXPECT_EQ( flt_host( i ), my_rank + host_steering( i ) + 0.25 );
+        }
+    };
+
+    // Migrate into a second container and in-place.
+    AoSoA_t data_dst( "data_dst", distributor.totalNumImport() );
+    Cabana::migrate( distributor, data, data_dst );
+    check( data_dst );
+    Cabana::migrate( distributor, data );
+    check( data );
+}
+
 //---------------------------------------------------------------------------//
 void test3( const bool use_topology )
 {
@@ -224,6 +292,12 @@ void test3( const bool use_topology )
     Cabana::migrate( *distributor, slice_int_src, slice_int_dst );
     Cabana::migrate( *distributor, slice_dbl_src, slice_dbl_dst );
 
+    // Migrate a slice again on an execution space instance.
+    AoSoA_t data_inst( "data_inst", num_data );
+    auto slice_dbl_inst = Cabana::slice<1>( data_inst );
+    Cabana::migrate( TEST_EXECSPACE(), *distributor, slice_dbl_src,
+                     slice_dbl_inst );
+
     // Exchange steering vectors with your inverse rank so we know what order
     // they sent us stuff in. We thread the creation of the steering vector so
     // its order is not deterministic.
@@ -248,6 +322,9 @@ void test3( const bool use_topology )
     Cabana::deep_copy( data_dst_host, data_dst );
     auto slice_int_dst_host = Cabana::slice<0>( data_dst_host );
     auto slice_dbl_dst_host = Cabana::slice<1>( data_dst_host );
+    auto data_inst_host =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), data_inst );
+    auto slice_dbl_inst_host = Cabana::slice<1>( data_inst_host );
     for ( int i = 0; i < num_data; ++i )
     {
         EXPECT_EQ( slice_int_dst_host( i ), inverse_rank + host_steering( i ) );
@@ -255,6 +332,10 @@ void test3( const bool use_topology )
                    inverse_rank + host_steering( i ) );
         EXPECT_EQ( slice_dbl_dst_host( i, 1 ),
                    inverse_rank + host_steering( i ) + 0.5 );
+        EXPECT_EQ( slice_dbl_inst_host( i, 0 ),
+                   inverse_rank + host_steering( i ) );
+        EXPECT_EQ( slice_dbl_inst_host( i, 1 ),
+                   inverse_rank + host_steering( i ) + 0.5 );
     }
 }
 
@@ -749,6 +830,400 @@ void test9( const bool use_topology )
     EXPECT_EQ( data.size(), 0 );
 }
 
+//---------------------------------------------------------------------------//
+void testMemberSubset( const bool use_topology )
+{
+    // Make a communication plan.
+    std::shared_ptr<Cabana::Distributor<TEST_MEMSPACE>> distributor;
+
+    // Get my rank.
+    int my_rank = -1;
+    MPI_Comm_rank( MPI_COMM_WORLD, &my_rank );
+
+    // Get the comm size.
+    int my_size = -1;
+    MPI_Comm_size( MPI_COMM_WORLD, &my_size );
+
+    // Every rank will keep its even elements and send its odd elements to
+    // the next rank.
+    int num_data = 10;
+    int next_rank = ( my_rank + 1 ) % my_size;
+    int prev_rank = ( my_rank + my_size - 1 ) % my_size;
+    Kokkos::View<int*, Kokkos::HostSpace> export_ranks_host( "export_ranks",
+                                                             num_data );
+    for ( int n = 0; n < num_data; ++n )
+        export_ranks_host( n ) = ( 0 == n % 2 ) ? my_rank : next_rank;
+    auto export_ranks = Kokkos::create_mirror_view_and_copy(
+        TEST_MEMSPACE(), export_ranks_host );
+    std::vector<int> neighbor_ranks = { prev_rank, my_rank, next_rank };
+
+    // Create the plan.
+    if ( use_topology )
+        distributor = std::make_shared<Cabana::Distributor<TEST_MEMSPACE>>(
+            MPI_COMM_WORLD, export_ranks, neighbor_ranks );
+    else
+        distributor = std::make_shared<Cabana::Distributor<TEST_MEMSPACE>>(
+            MPI_COMM_WORLD, export_ranks );
+
+    // Make some data to migrate.
+    using DataTypes = Cabana::MemberTypes<int, double[2], float>;
+    using AoSoA_t = Cabana::AoSoA<DataTypes, TEST_MEMSPACE>;
+    AoSoA_t data_src( "src", num_data );
+    auto slice_int_src = Cabana::slice<0>( data_src );
+    auto slice_dbl_src = Cabana::slice<1>( data_src );
+    auto slice_flt_src = Cabana::slice<2>( data_src );
+
+    // Fill the data.
+    auto fill_func = KOKKOS_LAMBDA( const int i )
+    {
+        slice_int_src( i ) = my_rank + i;
+        slice_dbl_src( i, 0 ) = my_rank + i;
+        slice_dbl_src( i, 1 ) = my_rank + i + 0.5;
+        slice_flt_src( i ) = my_rank + i + 0.25;
+    };
+    Kokkos::RangePolicy<TEST_EXECSPACE> range_policy( 0, num_data );
+    Kokkos::parallel_for( range_policy, fill_func );
+    Kokkos::fence();
+
+    // Create a second set of data to which we will migrate.
+    AoSoA_t data_dst( "dst", distributor->totalNumImport() );
+    auto slice_int_dst = Cabana::slice<0>( data_dst );
+    auto slice_dbl_dst = Cabana::slice<1>( data_dst );
+    auto slice_flt_dst = Cabana::slice<2>( data_dst );
+    Cabana::deep_copy( slice_int_dst, -1 );
+    Cabana::deep_copy( slice_dbl_dst, -1.0 );
+    Cabana::deep_copy( slice_flt_dst, -1.0 );
+
+    // Migrate only the double and integer members.
+    Cabana::migrate<1, 0>( *distributor, data_src, data_dst );
+
+    // Check the migration. The elements staying on this rank come first and
+    // have even ids. The elements received from the previous rank have odd
+    // ids.
+    Cabana::AoSoA<DataTypes, Kokkos::HostSpace> data_dst_host(
+        "data_dst_host", distributor->totalNumImport() );
+    auto slice_int_dst_host = Cabana::slice<0>( data_dst_host );
+    auto slice_dbl_dst_host = Cabana::slice<1>( data_dst_host );
+    auto slice_flt_dst_host = Cabana::slice<2>( data_dst_host );
+    Cabana::deep_copy( data_dst_host, data_dst );
+    EXPECT_EQ( distributor->totalNumImport(), num_data );
+    int num_stay = ( my_size > 1 ) ? num_data / 2 : num_data;
+    for ( int i = 0; i < num_data; ++i )
+    {
+        int src_rank = ( i < num_stay ) ? my_rank : prev_rank;
+        int src_id = slice_int_dst_host( i ) - src_rank;
+        if ( my_size > 1 )
+            EXPECT_EQ( src_id % 2, ( i < num_stay ) ? 0 : 1 );
+        EXPECT_EQ( slice_dbl_dst_host( i, 0 ), src_rank + src_id );
+        EXPECT_EQ( slice_dbl_dst_host( i, 1 ), src_rank + src_id + 0.5 );
+
+        // The float member was not migrated.
+        EXPECT_EQ( slice_flt_dst_host( i ), -1.0 );
+    }
+}
+
+//---------------------------------------------------------------------------//
+void testCollectiveBackend( const bool use_topology,
+                            const Cabana::CommBackend backend )
+{
+    // Make a communication plan.
+    std::shared_ptr<Cabana::Distributor<TEST_MEMSPACE>> distributor;
+
+    // Get my rank.
+    int my_rank = -1;
+    MPI_Comm_rank( MPI_COMM_WORLD, &my_rank );
+
+    // Get the comm size.
+    int my_size = -1;
+    MPI_Comm_size( MPI_COMM_WORLD, &my_size );
+
+    // Every rank will keep its even elements and send its odd elements to
+    // the next rank.
+    int num_data = 10;
+    int next_rank = ( my_rank + 1 ) % my_size;
+    int prev_rank = ( my_rank + my_size - 1 ) % my_size;
+    Kokkos::View<int*, Kokkos::HostSpace> export_ranks_host( "export_ranks",
+                                                             num_data );
+    for ( int n = 0; n < num_data; ++n )
+        export_ranks_host( n ) = ( 0 == n % 2 ) ? my_rank : next_rank;
+    auto export_ranks = Kokkos::create_mirror_view_and_copy(
+        TEST_MEMSPACE(), export_ranks_host );
+    std::vector<int> neighbor_ranks = { prev_rank, my_rank, next_rank };
+
+    // Create the plan and use the backend.
+    if ( use_topology )
+        distributor = std::make_shared<Cabana::Distributor<TEST_MEMSPACE>>(
+            MPI_COMM_WORLD, export_ranks, neighbor_ranks );
+    else
+        distributor = std::make_shared<Cabana::Distributor<TEST_MEMSPACE>>(
+            MPI_COMM_WORLD, export_ranks );
+    distributor->setBackend( backend );
+    EXPECT_TRUE( backend == distributor->backend() );
+
+    // Make some data to migrate.
+    using DataTypes = Cabana::MemberTypes<int, double[2]>;
+    using AoSoA_t = Cabana::AoSoA<DataTypes, TEST_MEMSPACE>;
+    AoSoA_t data_src( "src", num_data );
+    auto slice_int_src = Cabana::slice<0>( data_src );
+    auto slice_dbl_src = Cabana::slice<1>( data_src );
+
+    // Fill the data.
+    auto fill_func = KOKKOS_LAMBDA( const int i )
+    {
+        slice_int_src( i ) = my_rank + i;
+        slice_dbl_src( i, 0 ) = my_rank + i;
+        slice_dbl_src( i, 1 ) = my_rank + i + 0.5;
+    };
+    Kokkos::RangePolicy<TEST_EXECSPACE> range_policy( 0, num_data );
+    Kokkos::parallel_for( range_policy, fill_func );
+    Kokkos::fence();
+
+    // Migrate the AoSoA, a slice, and a subset of the members.
+    AoSoA_t data_dst( "dst", distributor->totalNumImport() );
+    Cabana::migrate( *distributor, data_src, data_dst );
+    AoSoA_t data_dst_2( "dst_2", distributor->totalNumImport() );
+    auto slice_int_dst_2 = Cabana::slice<0>( data_dst_2 );
+    Cabana::migrate( *distributor, slice_int_src, slice_int_dst_2 );
+    Cabana::migrate<1>( *distributor, data_src, data_dst_2 );
+
+    // Check the migration. The elements staying on this rank come first and
+    // have even ids.
+    EXPECT_EQ( distributor->totalNumImport(), num_data );
+    Cabana::AoSoA<DataTypes, Kokkos::HostSpace> data_dst_host(
+        "data_dst_host", num_data );
+    Cabana::AoSoA<DataTypes, Kokkos::HostSpace> data_dst_host_2(
+        "data_dst_host_2", num_data );
+    auto slice_int_dst_host = Cabana::slice<0>( data_dst_host );
+    auto slice_dbl_dst_host = Cabana::slice<1>( data_dst_host );
+    auto slice_int_dst_host_2 = Cabana::slice<0>( data_dst_host_2 );
+    auto slice_dbl_dst_host_2 = Cabana::slice<1>( data_dst_host_2 );
+    Cabana::deep_copy( data_dst_host, data_dst );
+    Cabana::deep_copy( data_dst_host_2, data_dst_2 );
+    int num_stay = ( my_size > 1 ) ? num_data / 2 : num_data;
+    for ( int i = 0; i < num_data; ++i )
+    {
+        int src_rank = ( i < num_stay ) ? my_rank : prev_rank;
+        int src_id = slice_int_dst_host( i ) - src_rank;
+        if ( my_size > 1 )
+            EXPECT_EQ( src_id % 2, ( i < num_stay ) ? 0 : 1 );
+        EXPECT_EQ( slice_dbl_dst_host( i, 0 ), src_rank + src_id );
+        EXPECT_EQ( slice_dbl_dst_host( i, 1 ), src_rank + src_id + 0.5 );
+        EXPECT_EQ( slice_int_dst_host_2( i ), slice_int_dst_host( i ) );
+        EXPECT_EQ( slice_dbl_dst_host_2( i, 0 ), slice_dbl_dst_host( i, 0 ) );
+        EXPECT_EQ( slice_dbl_dst_host_2( i, 1 ), slice_dbl_dst_host( i, 1 ) );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Migrate with the given export pattern and check the results.
+template <class ExportRankFunc>
+void checkUpdateMigrate( Cabana::Distributor<TEST_MEMSPACE>& distributor,
+                         const int num_data, const ExportRankFunc& export_rank )
+{
+    // Get my rank.
+    int my_rank = -1;
+    MPI_Comm_rank( MPI_COMM_WORLD, &my_rank );
+
+    // Get the comm size.
+    int my_size = -1;
+    MPI_Comm_size( MPI_COMM_WORLD, &my_size );
+
+    // Make a unique id for each element.
+    using DataTypes = Cabana::MemberTypes<int>;
+    Cabana::AoSoA<DataTypes, Kokkos::HostSpace> src_host( "src_host",
+                                                          num_data );
+    auto id_src_host = Cabana::slice<0>( src_host );
+    for ( int i = 0; i < num_data; ++i )
+        id_src_host( i ) = my_rank * num_data + i;
+    Cabana::AoSoA<DataTypes, TEST_MEMSPACE> src( "src", num_data );
+    Cabana::deep_copy( src, src_host );
+
+    // Migrate.
+    Cabana::AoSoA<DataTypes, TEST_MEMSPACE> dst(
+        "dst", distributor.totalNumImport() );
+    Cabana::migrate( distributor, src, dst );
+
+    // Check the number of imports and that every element was sent here.
+    int num_import = 0;
+    for ( int r = 0; r < my_size; ++r )
+        for ( int i = 0; i < num_data; ++i )
+            if ( export_rank( r, i ) == my_rank )
+                ++num_import;
+    EXPECT_EQ( distributor.totalNumImport(), num_import );
+    Cabana::AoSoA<DataTypes, Kokkos::HostSpace> dst_host(
+        "dst_host", distributor.totalNumImport() );
+    Cabana::deep_copy( dst_host, dst );
+    auto id_dst_host = Cabana::slice<0>( dst_host );
+    for ( std::size_t i = 0; i < dst_host.size(); ++i )
+    {
+        int src_rank = id_dst_host( i ) / num_data;
+        int src_id = id_dst_host( i ) % num_data;
+        EXPECT_EQ( export_rank( src_rank, src_id ), my_rank );
+    }
+}
+
+//---------------------------------------------------------------------------//
+void testUpdate( const bool use_topology )
+{
+    // Get my rank.
+    int my_rank = -1;
+    MPI_Comm_rank( MPI_COMM_WORLD, &my_rank );
+
+    // Get the comm size.
+    int my_size = -1;
+    MPI_Comm_size( MPI_COMM_WORLD, &my_size );
+
+    // Initially every rank will keep its even elements and send its odd
+    // elements to the next rank.
+    int num_data = 10;
+    auto pattern_1 = [=]( const int rank, const int i ) {
+        return ( 0 == i % 2 ) ? rank : ( rank + 1 ) % my_size;
+    };
+    Kokkos::View<int*, Kokkos::HostSpace> export_ranks_host( "export_ranks",
+                                                             num_data );
+    for ( int i = 0; i < num_data; ++i )
+        export_ranks_host( i ) = pattern_1( my_rank, i );
+    auto export_ranks = Kokkos::create_mirror_view_and_copy(
+        TEST_MEMSPACE(), export_ranks_host );
+    int next_rank = ( my_rank + 1 ) % my_size;
+    int prev_rank = ( my_rank + my_size - 1 ) % my_size;
+    std::vector<int> neighbor_ranks = { prev_rank, my_rank, next_rank };
+
+    // Create the plan.
+    std::shared_ptr<Cabana::Distributor<TEST_MEMSPACE>> distributor;
+    if ( use_topology )
+        distributor = std::make_shared<Cabana::Distributor<TEST_MEMSPACE>>(
+            MPI_COMM_WORLD, export_ranks, neighbor_ranks );
+    else
+        distributor = std::make_shared<Cabana::Distributor<TEST_MEMSPACE>>(
+            MPI_COMM_WORLD, export_ranks );
+    checkUpdateMigrate( *distributor, num_data, pattern_1 );
+    int num_neighbor = distributor->numNeighbor();
+
+    // Update with new counts on the same topology. Send the first three
+    // elements to the next rank and drop the last element.
+    auto pattern_2 = [=]( const int rank, const int i ) {
+        return ( i < 3 ) ? ( rank + 1 ) % my_size
+                         : ( ( num_data - 1 == i ) ? -1 : rank );
+    };
+    for ( int i = 0; i < num_data; ++i )
+        export_ranks_host( i ) = pattern_2( my_rank, i );
+    Kokkos::deep_copy( export_ranks, export_ranks_host );
+    distributor->update( export_ranks );
+    EXPECT_EQ( distributor->numNeighbor(), num_neighbor );
+    EXPECT_EQ( distributor->exportSize(), num_data );
+    checkUpdateMigrate( *distributor, num_data, pattern_2 );
+
+    // Update with a new topology. Send all elements to the rank two ahead.
+    auto pattern_3 = [=]( const int rank, const int ) {
+        return ( rank + 2 ) % my_size;
+    };
+    for ( int i = 0; i < num_data; ++i )
+        export_ranks_host( i ) = pattern_3( my_rank, i );
+    Kokkos::deep_copy( export_ranks, export_ranks_host );
+    distributor->update( export_ranks );
+    checkUpdateMigrate( *distributor, num_data, pattern_3 );
+}
+
+//---------------------------------------------------------------------------//
+void testMigrateInPlace( const bool use_topology,
+                         const Cabana::CommBackend backend )
+{
+    // Make a communication plan.
+    std::shared_ptr<Cabana::Distributor<TEST_MEMSPACE>> distributor;
+
+    // Get my rank.
+    int my_rank = -1;
+    MPI_Comm_rank( MPI_COMM_WORLD, &my_rank );
+
+    // Get the comm size.
+    int my_size = -1;
+    MPI_Comm_size( MPI_COMM_WORLD, &my_size );
+
+    // Every rank will keep its even elements and its last element, remove
+    // its first odd element, and send its other odd elements to the next
+    // rank. The last element is beyond the new size and must be moved.
+    int num_data = 10;
+    int next_rank = ( my_rank + 1 ) % my_size;
+    int prev_rank = ( my_rank + my_size - 1 ) % my_size;
+    Kokkos::View<int*, Kokkos::HostSpace> export_ranks_host( "export_ranks",
+                                                             num_data );
+    for ( int n = 0; n < num_data; ++n )
+    {
+        if ( 1 == n )
+            export_ranks_host( n ) = -1;
+        else if ( 0 == n % 2 || num_data - 1 == n )
+            export_ranks_host( n ) = my_rank;
+        else
+            export_ranks_host( n ) = next_rank;
+    }
+    auto export_ranks = Kokkos::create_mirror_view_and_copy(
+        TEST_MEMSPACE(), export_ranks_host );
+    std::vector<int> neighbor_ranks = { prev_rank, my_rank, next_rank };
+
+    // Create the plan.
+    if ( use_topology )
+        distributor = std::make_shared<Cabana::Distributor<TEST_MEMSPACE>>(
+            MPI_COMM_WORLD, export_ranks, neighbor_ranks );
+    else
+        distributor = std::make_shared<Cabana::Distributor<TEST_MEMSPACE>>(
+            MPI_COMM_WORLD, export_ranks );
+    distributor->setBackend( backend );
+
+    // Make some data to migrate.
+    using DataTypes = Cabana::MemberTypes<int, double[2]>;
+    using AoSoA_t = Cabana::AoSoA<DataTypes, TEST_MEMSPACE>;
+    AoSoA_t data( "data", num_data );
+    auto slice_int = Cabana::slice<0>( data );
+    auto slice_dbl = Cabana::slice<1>( data );
+
+    // Fill the data.
+    auto fill_func = KOKKOS_LAMBDA( const int i )
+    {
+        slice_int( i ) = my_rank + i;
+        slice_dbl( i, 0 ) = my_rank + i;
+        slice_dbl( i, 1 ) = my_rank + i + 0.5;
+    };
+    Kokkos::RangePolicy<TEST_EXECSPACE> range_policy( 0, num_data );
+    Kokkos::parallel_for( range_policy, fill_func );
+    Kokkos::fence();
+
+    // Do the migration in-place without moving the staying elements.
+    Cabana::migrateInPlace( TEST_EXECSPACE(), *distributor, data );
+
+    // Check the migration. Staying elements below the new size keep their
+    // position and every expected element is present.
+    int num_dst = num_data - 1;
+    EXPECT_EQ( data.size(), static_cast<std::size_t>( num_dst ) );
+    Cabana::AoSoA<DataTypes, Kokkos::HostSpace> data_host( "data_host",
+                                                           num_dst );
+    auto slice_int_host = Cabana::slice<0>( data_host );
+    auto slice_dbl_host = Cabana::slice<1>( data_host );
+    Cabana::deep_copy( data_host, data );
+    std::vector<int> expected;
+    std::vector<int> found;
+    for ( int n = 0; n < num_data; ++n )
+    {
+        if ( 1 == n )
+            continue;
+        else if ( 0 == n % 2 || num_data - 1 == n )
+            expected.push_back( my_rank + n );
+        else
+            expected.push_back( prev_rank + n );
+    }
+    for ( int i = 0; i < num_dst; ++i )
+    {
+        if ( 0 == i % 2 )
+            EXPECT_EQ( slice_int_host( i ), my_rank + i );
+        EXPECT_EQ( slice_dbl_host( i, 0 ), slice_int_host( i ) );
+        EXPECT_EQ( slice_dbl_host( i, 1 ), slice_int_host( i ) + 0.5 );
+        found.push_back( slice_int_host( i ) );
+    }
+    std::sort( expected.begin(), expected.end() );
+    std::sort( found.begin(), found.end() );
+    EXPECT_EQ( found, expected );
+}
+
 //---------------------------------------------------------------------------//
 // RUN TESTS
 //---------------------------------------------------------------------------//
@@ -788,6 +1263,56 @@ TEST( TEST_CATEGORY, distributor_test_8_no_topo ) { test8( false ); }
 
 TEST( TEST_CATEGORY, distributor_test_9_no_topo ) { test9( false ); }
 
+TEST( TEST_CATEGORY, distributor_test_member_subset )
+{
+    testMemberSubset( true );
+}
+
+TEST( TEST_CATEGORY, distributor_test_member_subset_no_topo )
+{
+    testMemberSubset( false );
+}
+
+TEST( TEST_CATEGORY, distributor_test_neighbor_collective )
+{
+    testCollectiveBackend( true, Cabana::CommBackend::NeighborCollective );
+}
+
+TEST( TEST_CATEGORY, distributor_test_neighbor_collective_no_topo )
+{
+    testCollectiveBackend( false, Cabana::CommBackend::NeighborCollective );
+}
+
+TEST( TEST_CATEGORY, distributor_test_node_shared )
+{
+    testCollectiveBackend( true, Cabana::CommBackend::NodeShared );
+}
+
+TEST( TEST_CATEGORY, distributor_test_node_shared_no_topo )
+{
+    testCollectiveBackend( false, Cabana::CommBackend::NodeShared );
+}
+
+TEST( TEST_CATEGORY, distributor_test_update ) { testUpdate( true ); }
+
+TEST( TEST_CATEGORY, distributor_test_update_no_topo ) { testUpdate( false ); }
+
+TEST( TEST_CATEGORY, distributor_test_grouped ) { testGrouped(); }
+
+TEST( TEST_CATEGORY, distributor_test_migrate_in_place )
+{
+    testMigrateInPlace( true, Cabana::CommBackend::PointToPoint );
+    testMigrateInPlace( true, Cabana::CommBackend::NeighborCollective );
+    testMigrateInPlace( true, Cabana::CommBackend::NodeShared );
+}
+
+TEST( TEST_CATEGORY, distributor_test_migrate_in_place_no_topo )
+{
+    testMigrateInPlace( false, Cabana::CommBackend::PointToPoint );
+    testMigrateInPlace( false, Cabana::CommBackend::NeighborCollective );
+    testMigrateInPlace( false, Cabana::CommBackend::NodeShared );
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
@@ -0,0 +1,201 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_DeepCopy.hpp>
+#include <Cabana_Distributor.hpp>
+#include <Cabana_GlobalIdMap.hpp>
+#include <Cabana_Halo.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+// Look up the local index of every given id.
+template <class IdMapType>
+std::vector<int> findAll( const IdMapType& id_map, const std::vector<int>& ids )
+{
+    Kokkos::View<int*, Kokkos::HostSpace, Kokkos::MemoryUnmanaged> ids_host(
+        ids.data(), ids.size() );
+    auto ids_dev =
+        Kokkos::create_mirror_view_and_copy( TEST_MEMSPACE(), ids_host );
+    Kokkos::View<int*, TEST_MEMSPACE> local( "local", ids.size() );
+    Kokkos::parallel_for(
+        "find", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, ids.size() ),
+        KOKKOS_LAMBDA( const int i ) {
+            local( i ) = id_map.find( ids_dev( i ) );
+        } );
+    auto local_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), local );
+    return std::vector<int>( local_host.data(),
+                             local_host.data() + local_host.size() );
+}
+
+//---------------------------------------------------------------------------//
+// Check that every local particle is found at its index.
+template <class IdMapType, class AoSoAType>
+void checkLocal( const IdMapType& id_map, const AoSoAType& particles,
+                 const std::size_t num_owned )
+{
+    auto particles_host =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), particles );
+    auto ids_host = Cabana::slice<0>( particles_host );
+    std::vector<int> ids( particles.size() );
+    for ( std::size_t p = 0; p < particles.size(); ++p )
+        ids[p] = ids_host( p );
+    auto local = findAll( id_map, ids );
+    for ( std::size_t p = 0; p < particles.size(); ++p )
+    {
+        // Ghosts with an owned copy are found at the owned copy.
+        if ( p < num_owned || local[p] >= static_cast<int>( num_owned ) )
+            EXPECT_EQ( local[p], static_cast<int>( p ) );
+        else
+            EXPECT_EQ( ids_host( local[p] ), ids_host( p ) );
+    }
+}
+
+//---------------------------------------------------------------------------//
+void testGlobalIdMap( const bool use_topology )
+{
+    int my_rank = -1;
+    MPI_Comm_rank( MPI_COMM_WORLD, &my_rank );
+    int my_size = -1;
+    MPI_Comm_size( MPI_COMM_WORLD, &my_size );
+    int next_rank = ( my_rank + 1 ) % my_size;
+    int prev_rank = ( my_rank + my_size - 1 ) % my_size;
+    std::vector<int> neighbor_ranks = { my_rank };
+    if ( my_size > 1 )
+        neighbor_ranks.push_back( next_rank );
+    if ( my_size > 2 )
+        neighbor_ranks.push_back( prev_rank );
+
+    // Create the particles.
+    int num_data = 10;
+    using AoSoA_t = Cabana::AoSoA<Cabana::MemberTypes<int>, TEST_MEMSPACE>;
+    AoSoA_t particles( "particles", num_data );
+    auto ids = Cabana::slice<0>( particles );
+    Kokkos::parallel_for(
+        "fill", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_data ),
+        KOKKOS_LAMBDA( const int p ) { ids( p ) = my_rank * num_data + p; } );
+
+    Cabana::GlobalIdMap<TEST_MEMSPACE> id_map;
+    id_map.build( ids, num_data, num_data );
+    EXPECT_EQ( id_map.numOwned(), static_cast<std::size_t>( num_data ) );
+    EXPECT_EQ( id_map.numGhost(), 0u );
+    checkLocal( id_map, particles, num_data );
+
+    // Keep the even particles, remove the last one, and send the rest to the
+    // next rank.
+    Kokkos::View<int*, TEST_MEMSPACE> export_ranks( "export_ranks",
+                                                    num_data );
+    Kokkos::parallel_for(
+        "ranks", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_data ),
+        KOKKOS_LAMBDA( const int p ) {
+            export_ranks( p ) =
+                ( p == num_data - 1 ) ? -1 : ( p % 2 ? next_rank : my_rank );
+        } );
+    std::shared_ptr<Cabana::Distributor<TEST_MEMSPACE>> distributor;
+    if ( use_topology )
+        distributor = std::make_shared<Cabana::Distributor<TEST_MEMSPACE>>(
+            MPI_COMM_WORLD, export_ranks, neighbor_ranks );
+    else
+        distributor = std::make_shared<Cabana::Distributor<TEST_MEMSPACE>>(
+            MPI_COMM_WORLD, export_ranks );
+    Cabana::migrate( *distributor, particles );
+    ids = Cabana::slice<0>( particles );
+    id_map.update( *distributor, ids );
+    int num_owned = num_data - 1;
+    EXPECT_EQ( particles.size(), static_cast<std::size_t>( num_owned ) );
+    EXPECT_EQ( id_map.numOwned(), static_cast<std::size_t>( num_owned ) );
+    checkLocal( id_map, particles, num_owned );
+
+    // The removed particle and the particles sent away are not found.
+    std::vector<int> departed = { my_rank * num_data + num_data - 1 };
+    if ( my_size > 1 )
+        for ( int p = 1; p < num_data - 1; p += 2 )
+            departed.push_back( my_rank * num_data + p );
+    for ( auto l : findAll( id_map, departed ) )
+        EXPECT_EQ( l, -1 );
+
+    // Ghost every owned particle on the next rank.
+    Kokkos::View<int*, TEST_MEMSPACE> halo_ids( "halo_ids", num_owned );
+    Kokkos::View<int*, TEST_MEMSPACE> halo_ranks( "halo_ranks", num_owned );
+    Kokkos::parallel_for(
+        "halo", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_owned ),
+        KOKKOS_LAMBDA( const int p ) {
+            halo_ids( p ) = p;
+            halo_ranks( p ) = next_rank;
+        } );
+    Cabana::Halo<TEST_MEMSPACE> halo( MPI_COMM_WORLD, num_owned, halo_ids,
+                                      halo_ranks, neighbor_ranks );
+    particles.resize( halo.numLocal() + halo.numGhost() );
+    Cabana::gather( halo, particles );
+    ids = Cabana::slice<0>( particles );
+    id_map.update( halo, ids );
+    EXPECT_EQ( id_map.numGhost(), static_cast<std::size_t>( num_owned ) );
+    checkLocal( id_map, particles, num_owned );
+
+    // Replace the ghosts with a single particle of the previous rank. The
+    // other ghosts are no longer found.
+    auto particles_host =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), particles );
+    auto ids_host = Cabana::slice<0>( particles_host );
+    std::vector<int> old_ghosts;
+    for ( int p = num_owned; p < 2 * num_owned; ++p )
+        old_ghosts.push_back( ids_host( p ) );
+    auto first = std::pair<int, int>( 0, 1 );
+    Cabana::Halo<TEST_MEMSPACE> small_halo(
+        MPI_COMM_WORLD, num_owned, Kokkos::subview( halo_ids, first ),
+        Kokkos::subview( halo_ranks, first ), neighbor_ranks );
+    particles.resize( small_halo.numLocal() + small_halo.numGhost() );
+    Cabana::gather( small_halo, particles );
+    ids = Cabana::slice<0>( particles );
+    id_map.update( small_halo, ids );
+    EXPECT_EQ( id_map.numGhost(), 1u );
+    checkLocal( id_map, particles, num_owned );
+    particles_host =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), particles );
+    ids_host = Cabana::slice<0>( particles_host );
+    auto local = findAll( id_map, old_ghosts );
+    for ( std::size_t g = 0; g < old_ghosts.size(); ++g )
+        if ( my_size > 1 && old_ghosts[g] != ids_host( num_owned ) )
+            EXPECT_EQ( local[g], -1 );
+
+    // Migrating again drops the ghosts.
+    particles.resize( num_owned );
+    Kokkos::View<int*, TEST_MEMSPACE> stay_ranks( "stay_ranks", num_owned );
+    Kokkos::deep_copy( stay_ranks, my_rank );
+    Cabana::Distributor<TEST_MEMSPACE> stay( MPI_COMM_WORLD, stay_ranks );
+    Cabana::migrate( stay, particles );
+    id_map.update( stay, Cabana::slice<0>( particles ) );
+    EXPECT_EQ( id_map.numGhost(), 0u );
+    checkLocal( id_map, particles, num_owned );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, global_id_map_test ) { testGlobalIdMap( true ); }
+
+TEST( TEST_CATEGORY, global_id_map_test_no_topo ) { testGlobalIdMap( false ); }
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
@@ -0,0 +1,125 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_DeepCopy.hpp>
+#include <Cabana_GlobalSort.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <limits>
+#include <vector>
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+void testGlobalSort( const int num_sample )
+{
+    int comm_rank = -1;
+    int comm_size = -1;
+    MPI_Comm_rank( MPI_COMM_WORLD, &comm_rank );
+    MPI_Comm_size( MPI_COMM_WORLD, &comm_size );
+
+    // Give the ranks different numbers of particles with non-uniform ids in
+    // reverse order. The second member follows the id.
+    int num_data = 100 + 37 * comm_rank;
+    using DataTypes = Cabana::MemberTypes<long, double>;
+    Cabana::AoSoA<DataTypes, TEST_MEMSPACE> aosoa( "aosoa", num_data );
+    auto id = Cabana::slice<0>( aosoa );
+    auto value = Cabana::slice<1>( aosoa );
+    Kokkos::parallel_for(
+        "fill", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_data ),
+        KOKKOS_LAMBDA( const int i ) {
+            long n = long( num_data - i ) * comm_size + comm_rank;
+            id( i ) = n * n;
+            value( i ) = 0.5 * id( i );
+        } );
+    Kokkos::fence();
+
+    long local_sum = 0;
+    for ( int i = 0; i < num_data; ++i )
+    {
+        long n = long( num_data - i ) * comm_size + comm_rank;
+        local_sum += n * n;
+    }
+
+    Cabana::globalSortByKey( MPI_COMM_WORLD, id, aosoa, num_sample );
+
+    // Check the local order and that the data moved with the ids.
+    auto aosoa_host =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), aosoa );
+    auto id_host = Cabana::slice<0>( aosoa_host );
+    auto value_host = Cabana::slice<1>( aosoa_host );
+    int num_local = aosoa_host.size();
+    long sum = 0;
+    for ( int i = 0; i < num_local; ++i )
+    {
+        if ( i > 0 )
+            EXPECT_LT( id_host( i - 1 ), id_host( i ) );
+        EXPECT_EQ( value_host( i ), 0.5 * id_host( i ) );
+        sum += id_host( i );
+    }
+
+    // Check that all ids are kept.
+    long global_sum = 0;
+    long expected_sum = 0;
+    MPI_Allreduce( &sum, &global_sum, 1, MPI_LONG, MPI_SUM, MPI_COMM_WORLD );
+    MPI_Allreduce( &local_sum, &expected_sum, 1, MPI_LONG, MPI_SUM,
+                   MPI_COMM_WORLD );
+    EXPECT_EQ( global_sum, expected_sum );
+
+    // Check that the id ranges increase with the rank.
+    long bounds[2] = { std::numeric_limits<long>::max(),
+                       std::numeric_limits<long>::min() };
+    if ( num_local > 0 )
+    {
+        bounds[0] = id_host( 0 );
+        bounds[1] = id_host( num_local - 1 );
+    }
+    std::vector<long> all_bounds( 2 * comm_size );
+    MPI_Allgather( bounds, 2, MPI_LONG, all_bounds.data(), 2, MPI_LONG,
+                   MPI_COMM_WORLD );
+    long max_below = std::numeric_limits<long>::min();
+    for ( int r = 0; r < comm_size; ++r )
+    {
+        if ( all_bounds[2 * r] <= all_bounds[2 * r + 1] )
+        {
+            EXPECT_GT( all_bounds[2 * r], max_below );
+            max_below = all_bounds[2 * r + 1];
+        }
+    }
+
+    // Check the balance. The count of every rank is off by at most a few
+    // sample spacings of every rank.
+    int total = 0;
+    MPI_Allreduce( &num_local, &total, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD );
+    int slack = 0;
+    for ( int r = 0; r < comm_size; ++r )
+        slack += 3 * ( ( 100 + 37 * r ) / num_sample + 1 );
+    EXPECT_LE( num_local, total / comm_size + slack );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, global_sort_test )
+{
+    testGlobalSort( 64 );
+    testGlobalSort( 1 );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
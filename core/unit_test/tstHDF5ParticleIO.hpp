@@ -0,0 +1,106 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_DeepCopy.hpp>
+#include <Cabana_HDF5ParticleIO.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+void writeReadTest( const bool collective, const hsize_t chunk_size )
+{
+    int my_rank = -1;
+    MPI_Comm_rank( MPI_COMM_WORLD, &my_rank );
+
+    // Give each rank a different number of particles.
+    int num_particle = 10 + 3 * my_rank;
+    using member_types = Cabana::MemberTypes<double[3], int, float[2][2]>;
+    Cabana::AoSoA<member_types, Kokkos::HostSpace> particles_host(
+        "particles", num_particle );
+    auto x_host = Cabana::slice<0>( particles_host, "positions" );
+    auto id_host = Cabana::slice<1>( particles_host, "ids" );
+    auto m_host = Cabana::slice<2>( particles_host, "matrix" );
+    for ( int p = 0; p < num_particle; ++p )
+    {
+        for ( int d = 0; d < 3; ++d )
+            x_host( p, d ) = my_rank + 0.1 * p + d;
+        id_host( p ) = 1000 * my_rank + p;
+        for ( int i = 0; i < 2; ++i )
+            for ( int j = 0; j < 2; ++j )
+                m_host( p, i, j ) = p * i - j + my_rank;
+    }
+    auto particles = Cabana::create_mirror_view_and_copy( TEST_MEMSPACE(),
+                                                          particles_host );
+    auto x = Cabana::slice<0>( particles, "positions" );
+    auto id = Cabana::slice<1>( particles, "ids" );
+    auto m = Cabana::slice<2>( particles, "matrix" );
+
+    Cabana::Experimental::HDF5ParticleOutput::HDF5Config h5_config;
+    h5_config.collective = collective;
+    h5_config.chunk_size = chunk_size;
+    Cabana::Experimental::HDF5ParticleOutput::writeTimeStep(
+        h5_config, "particles", MPI_COMM_WORLD, 3, 0.25, num_particle, x, id,
+        m );
+
+    // Read the fields back into a fresh AoSoA with the same distribution.
+    Cabana::AoSoA<member_types, TEST_MEMSPACE> restart( "restart",
+                                                        num_particle );
+    auto x_read = Cabana::slice<0>( restart );
+    auto id_read = Cabana::slice<1>( restart );
+    auto m_read = Cabana::slice<2>( restart );
+    double time = 0.0;
+    Cabana::Experimental::HDF5ParticleOutput::readTimeStep(
+        h5_config, "particles", MPI_COMM_WORLD, 3, num_particle, "positions",
+        time, x_read );
+    EXPECT_DOUBLE_EQ( time, 0.25 );
+    Cabana::Experimental::HDF5ParticleOutput::readTimeStep(
+        h5_config, "particles", MPI_COMM_WORLD, 3, num_particle, "ids", time,
+        id_read );
+    Cabana::Experimental::HDF5ParticleOutput::readTimeStep(
+        h5_config, "particles", MPI_COMM_WORLD, 3, num_particle, "matrix",
+        time, m_read );
+
+    auto restart_host =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), restart );
+    auto x_check = Cabana::slice<0>( restart_host );
+    auto id_check = Cabana::slice<1>( restart_host );
+    auto m_check = Cabana::slice<2>( restart_host );
+    for ( int p = 0; p < num_particle; ++p )
+    {
+        for ( int d = 0; d < 3; ++d )
+            EXPECT_DOUBLE_EQ( x_check( p, d ), x_host( p, d ) );
+        EXPECT_EQ( id_check( p ), id_host( p ) );
+        for ( int i = 0; i < 2; ++i )
+            for ( int j = 0; j < 2; ++j )
+                EXPECT_FLOAT_EQ( m_check( p, i, j ), m_host( p, i, j ) );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, hdf5_collective_test ) { writeReadTest( true, 0 ); }
+
+TEST( TEST_CATEGORY, hdf5_independent_chunked_test )
+{
+    writeReadTest( false, 8 );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
@@ -10,7 +10,10 @@
  ****************************************************************************/
 
 #include <Cabana_AoSoA.hpp>
+#include <Cabana_CommProgress.hpp>
+#include <Cabana_CommStatistics.hpp>
 #include <Cabana_DeepCopy.hpp>
+#include <Cabana_GroupedAoSoA.hpp>
 #include <Cabana_Halo.hpp>
 #include <Cabana_Parallel.hpp>
 
@@ -21,6 +24,7 @@
 #include <mpi.h>
 
 #include <memory>
+#include <sstream>
 #include <vector>
 
 namespace Test
@@ -405,6 +409,922 @@ void test2( const bool use_topology )
     }
 }
 
+//---------------------------------------------------------------------------//
+// test reuse of the persistent communication buffers
+void testBufferReuse()
+{
+    // Get my rank.
+    int my_rank = -1;
+    MPI_Comm_rank( MPI_COMM_WORLD, &my_rank );
+
+    // Get my size.
+    int my_size = -1;
+    MPI_Comm_size( MPI_COMM_WORLD, &my_size );
+
+    // Every rank will send its single data point as ghosts to all other
+    // ranks.
+    int num_local = 1;
+    Kokkos::View<int*, Kokkos::HostSpace> export_ranks_host( "export_ranks",
+                                                             my_size );
+    Kokkos::View<std::size_t*, TEST_MEMSPACE> export_ids( "export_ids",
+                                                          my_size );
+    Kokkos::deep_copy( export_ids, 0 );
+    for ( int n = 0; n < my_size; ++n )
+        export_ranks_host( n ) = n;
+    auto export_ranks = Kokkos::create_mirror_view_and_copy(
+        TEST_MEMSPACE(), export_ranks_host );
+    Cabana::Halo<TEST_MEMSPACE> halo( MPI_COMM_WORLD, num_local, export_ids,
+                                      export_ranks );
+
+    // No buffers are allocated until the first communication.
+    EXPECT_EQ( halo.buffers().sendCapacity(), 0 );
+    EXPECT_EQ( halo.buffers().recvCapacity(), 0 );
+
+    // Create data.
+    using DataTypes = Cabana::MemberTypes<int, double[2]>;
+    using AoSoA_t = Cabana::AoSoA<DataTypes, TEST_MEMSPACE>;
+    AoSoA_t data( "data", halo.numLocal() + halo.numGhost() );
+    auto slice_int = Cabana::slice<0>( data );
+    auto slice_dbl = Cabana::slice<1>( data );
+    Cabana::deep_copy( slice_int, my_rank + 1 );
+    Cabana::deep_copy( slice_dbl, my_rank + 1.5 );
+
+    // Gather the full AoSoA first. This is the largest message so the
+    // buffers should not be reallocated by the slice operations.
+    Cabana::gather( halo, data );
+    auto send_capacity = halo.buffers().sendCapacity();
+    auto recv_capacity = halo.buffers().recvCapacity();
+    auto send_ptr = halo.buffers().sendBuffer( 0 ).data();
+    auto recv_ptr = halo.buffers().recvBuffer( 0 ).data();
+    EXPECT_TRUE( send_capacity >= halo.totalNumExport() *
+                                      sizeof( AoSoA_t::tuple_type ) );
+    EXPECT_TRUE( recv_capacity >= halo.totalNumImport() *
+                                      sizeof( AoSoA_t::tuple_type ) );
+
+    // Perform repeated slice gathers and scatters with a copy of the halo
+    // which shares the buffers.
+    auto halo_copy = halo;
+    for ( int t = 0; t < 3; ++t )
+    {
+        Cabana::gather( halo_copy, slice_dbl );
+        Cabana::scatter( halo_copy, slice_int );
+        Cabana::gather( halo_copy, slice_int );
+    }
+    EXPECT_EQ( halo.buffers().sendCapacity(), send_capacity );
+    EXPECT_EQ( halo.buffers().recvCapacity(), recv_capacity );
+    EXPECT_EQ( halo.buffers().sendBuffer( 0 ).data(), send_ptr );
+    EXPECT_EQ( halo.buffers().recvBuffer( 0 ).data(), recv_ptr );
+
+    // Check the results. The local int value is scattered to once for each
+    // rank on every iteration.
+    Cabana::AoSoA<DataTypes, Kokkos::HostSpace> data_host(
+        "data_host", halo.numLocal() + halo.numGhost() );
+    auto slice_int_host = Cabana::slice<0>( data_host );
+    auto slice_dbl_host = Cabana::slice<1>( data_host );
+    Cabana::deep_copy( data_host, data );
+    int expected_int = my_rank + 1;
+    for ( int t = 0; t < 3; ++t )
+        expected_int *= ( my_size + 1 );
+    EXPECT_EQ( slice_int_host( 0 ), expected_int );
+    EXPECT_EQ( slice_dbl_host( 0, 0 ), my_rank + 1.5 );
+    EXPECT_EQ( slice_dbl_host( 0, 1 ), my_rank + 1.5 );
+
+    // Self sends are first in the ghosts.
+    EXPECT_EQ( slice_int_host( num_local ), expected_int );
+    EXPECT_EQ( slice_dbl_host( num_local, 0 ), my_rank + 1.5 );
+    EXPECT_EQ( slice_dbl_host( num_local, 1 ), my_rank + 1.5 );
+
+    // Releasing the buffers frees the memory.
+    halo.releaseBuffers();
+    EXPECT_EQ( halo_copy.buffers().sendCapacity(), 0 );
+    EXPECT_EQ( halo_copy.buffers().recvCapacity(), 0 );
+}
+
+//---------------------------------------------------------------------------//
+// test split-phase gathers
+void testSplitPhaseGather()
+{
+    // Get my rank.
+    int my_rank = -1;
+    MPI_Comm_rank( MPI_COMM_WORLD, &my_rank );
+
+    // Get my size.
+    int my_size = -1;
+    MPI_Comm_size( MPI_COMM_WORLD, &my_size );
+
+    // Every rank will send ghosts to all other ranks. Send one element to
+    // each rank including yourself.
+    int num_local = 2 * my_size;
+    Kokkos::View<int*, Kokkos::HostSpace> export_ranks_host( "export_ranks",
+                                                             my_size );
+    Kokkos::View<std::size_t*, Kokkos::HostSpace> export_ids_host( "export_ids",
+                                                                   my_size );
+    for ( int n = 0; n < my_size; ++n )
+    {
+        export_ranks_host( n ) = n;
+        export_ids_host( n ) = 2 * n + 1;
+    }
+    auto export_ranks = Kokkos::create_mirror_view_and_copy(
+        TEST_MEMSPACE(), export_ranks_host );
+    auto export_ids =
+        Kokkos::create_mirror_view_and_copy( TEST_MEMSPACE(), export_ids_host );
+    Cabana::Halo<TEST_MEMSPACE> halo( MPI_COMM_WORLD, num_local, export_ids,
+                                      export_ranks );
+
+    // Create data.
+    using DataTypes = Cabana::MemberTypes<int, double[2]>;
+    using AoSoA_t = Cabana::AoSoA<DataTypes, TEST_MEMSPACE>;
+    AoSoA_t data( "data", halo.numLocal() + halo.numGhost() );
+    auto slice_int = Cabana::slice<0>( data );
+    auto slice_dbl = Cabana::slice<1>( data );
+    Cabana::deep_copy( slice_int, -1 );
+    Cabana::deep_copy( slice_dbl, -1.0 );
+    auto fill_func = KOKKOS_LAMBDA( const int i )
+    {
+        slice_int( i ) = my_rank + 1;
+        slice_dbl( i, 0 ) = my_rank + 1;
+        slice_dbl( i, 1 ) = my_rank + 1.5;
+    };
+    Kokkos::RangePolicy<TEST_EXECSPACE> range_policy( 0, num_local );
+    Kokkos::parallel_for( range_policy, fill_func );
+    Kokkos::fence();
+
+    // Start two gathers at the same time. The second gather will not use the
+    // persistent buffers as they are in use by the first.
+    auto int_request = Cabana::gatherStart( halo, slice_int );
+    EXPECT_TRUE( int_request.active() );
+    EXPECT_TRUE( halo.buffers().locked() );
+    auto dbl_request = Cabana::gatherStart( halo, slice_dbl );
+    EXPECT_TRUE( dbl_request.active() );
+
+    // Ghosts are not updated until the gather is finished.
+    Cabana::AoSoA<DataTypes, Kokkos::HostSpace> data_host(
+        "data_host", halo.numLocal() + halo.numGhost() );
+    auto slice_int_host = Cabana::slice<0>( data_host );
+    auto slice_dbl_host = Cabana::slice<1>( data_host );
+    Cabana::deep_copy( data_host, data );
+    for ( int i = num_local; i < num_local + my_size; ++i )
+        EXPECT_EQ( slice_int_host( i ), -1 );
+
+    // Finish in the reverse order.
+    Cabana::gatherFinish( dbl_request );
+    EXPECT_FALSE( dbl_request.active() );
+    EXPECT_TRUE( halo.buffers().locked() );
+    int_request.finish();
+    EXPECT_FALSE( int_request.active() );
+    EXPECT_FALSE( halo.buffers().locked() );
+
+    // Check that we got one element from everyone.
+    Cabana::deep_copy( data_host, data );
+    for ( int i = num_local; i < num_local + my_size; ++i )
+    {
+        // Self sends are first.
+        int send_rank = i - num_local;
+        if ( send_rank == 0 )
+            send_rank = my_rank;
+        else if ( send_rank == my_rank )
+            send_rank = 0;
+        EXPECT_EQ( slice_int_host( i ), send_rank + 1 );
+        EXPECT_EQ( slice_dbl_host( i, 0 ), send_rank + 1 );
+        EXPECT_EQ( slice_dbl_host( i, 1 ), send_rank + 1.5 );
+    }
+
+    // Finishing twice is a no-op.
+    int_request.finish();
+
+    // A request which goes out of scope completes the gather.
+    Cabana::deep_copy( slice_int, my_rank + 2 );
+    {
+        auto request = Cabana::gatherStart( halo, data );
+    }
+    EXPECT_FALSE( halo.buffers().locked() );
+    Cabana::deep_copy( data_host, data );
+    for ( int i = num_local; i < num_local + my_size; ++i )
+    {
+        int send_rank = i - num_local;
+        if ( send_rank == 0 )
+            send_rank = my_rank;
+        else if ( send_rank == my_rank )
+            send_rank = 0;
+        EXPECT_EQ( slice_int_host( i ), send_rank + 2 );
+    }
+
+    // Gather on an execution space instance.
+    TEST_EXECSPACE exec_space;
+    Cabana::deep_copy( slice_int, my_rank + 3 );
+    Cabana::gather( exec_space, halo, slice_int );
+    Cabana::deep_copy( data_host, data );
+    for ( int i = num_local; i < num_local + my_size; ++i )
+    {
+        int send_rank = i - num_local;
+        if ( send_rank == 0 )
+            send_rank = my_rank;
+        else if ( send_rank == my_rank )
+            send_rank = 0;
+        EXPECT_EQ( slice_int_host( i ), send_rank + 3 );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// test gathering a subset of the AoSoA members
+void testMemberSubsetGather()
+{
+    // Get my rank.
+    int my_rank = -1;
+    MPI_Comm_rank( MPI_COMM_WORLD, &my_rank );
+
+    // Get my size.
+    int my_size = -1;
+    MPI_Comm_size( MPI_COMM_WORLD, &my_size );
+
+    // Every rank will send ghosts to all other ranks. Send one element to
+    // each rank including yourself.
+    int num_local = 2 * my_size;
+    Kokkos::View<int*, Kokkos::HostSpace> export_ranks_host( "export_ranks",
+                                                             my_size );
+    Kokkos::View<std::size_t*, Kokkos::HostSpace> export_ids_host( "export_ids",
+                                                                   my_size );
+    for ( int n = 0; n < my_size; ++n )
+    {
+        export_ranks_host( n ) = n;
+        export_ids_host( n ) = 2 * n + 1;
+    }
+    auto export_ranks = Kokkos::create_mirror_view_and_copy(
+        TEST_MEMSPACE(), export_ranks_host );
+    auto export_ids =
+        Kokkos::create_mirror_view_and_copy( TEST_MEMSPACE(), export_ids_host );
+    Cabana::Halo<TEST_MEMSPACE> halo( MPI_COMM_WORLD, num_local, export_ids,
+                                      export_ranks );
+
+    // Create data.
+    using DataTypes = Cabana::MemberTypes<int, double[2], float>;
+    using AoSoA_t = Cabana::AoSoA<DataTypes, TEST_MEMSPACE>;
+    AoSoA_t data( "data", halo.numLocal() + halo.numGhost() );
+    auto slice_int = Cabana::slice<0>( data );
+    auto slice_dbl = Cabana::slice<1>( data );
+    auto slice_flt = Cabana::slice<2>( data );
+    Cabana::deep_copy( slice_int, -1 );
+    Cabana::deep_copy( slice_dbl, -1.0 );
+    Cabana::deep_copy( slice_flt, -1.0 );
+    auto fill_func = KOKKOS_LAMBDA( const int i )
+    {
+        slice_int( i ) = my_rank + 1;
+        slice_dbl( i, 0 ) = my_rank + 1;
+        slice_dbl( i, 1 ) = my_rank + 1.5;
+        slice_flt( i ) = my_rank + 1.25;
+    };
+    Kokkos::RangePolicy<TEST_EXECSPACE> range_policy( 0, num_local );
+    Kokkos::parallel_for( range_policy, fill_func );
+    Kokkos::fence();
+
+    // Gather only the float and integer members.
+    Cabana::gather<2, 0>( halo, data );
+
+    // Check that only the gathered members were updated on the ghosts.
+    Cabana::AoSoA<DataTypes, Kokkos::HostSpace> data_host(
+        "data_host", halo.numLocal() + halo.numGhost() );
+    auto slice_int_host = Cabana::slice<0>( data_host );
+    auto slice_dbl_host = Cabana::slice<1>( data_host );
+    auto slice_flt_host = Cabana::slice<2>( data_host );
+    Cabana::deep_copy( data_host, data );
+    for ( int i = num_local; i < num_local + my_size; ++i )
+    {
+        // Self sends are first.
+        int send_rank = i - num_local;
+        if ( send_rank == 0 )
+            send_rank = my_rank;
+        else if ( send_rank == my_rank )
+            send_rank = 0;
+        EXPECT_EQ( slice_int_host( i ), send_rank + 1 );
+        EXPECT_EQ( slice_dbl_host( i, 0 ), -1.0 );
+        EXPECT_EQ( slice_dbl_host( i, 1 ), -1.0 );
+        EXPECT_EQ( slice_flt_host( i ), send_rank + 1.25 );
+    }
+
+    // Gather the remaining member with the split-phase interface.
+    auto request = Cabana::gatherStart<1>( halo, data );
+    request.finish();
+    Cabana::deep_copy( data_host, data );
+    for ( int i = num_local; i < num_local + my_size; ++i )
+    {
+        int send_rank = i - num_local;
+        if ( send_rank == 0 )
+            send_rank = my_rank;
+        else if ( send_rank == my_rank )
+            send_rank = 0;
+        EXPECT_EQ( slice_dbl_host( i, 0 ), send_rank + 1 );
+        EXPECT_EQ( slice_dbl_host( i, 1 ), send_rank + 1.5 );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// test update-only gathers into the existing ghost slots
+void testUpdateGhosts()
+{
+    // Get my rank.
+    int my_rank = -1;
+    MPI_Comm_rank( MPI_COMM_WORLD, &my_rank );
+
+    // Get my size.
+    int my_size = -1;
+    MPI_Comm_size( MPI_COMM_WORLD, &my_size );
+
+    // Every rank will send ghosts to all other ranks. Send one element to
+    // each rank including yourself.
+    int num_local = 2 * my_size;
+    Kokkos::View<int*, Kokkos::HostSpace> export_ranks_host( "export_ranks",
+                                                             my_size );
+    Kokkos::View<std::size_t*, Kokkos::HostSpace> export_ids_host( "export_ids",
+                                                                   my_size );
+    for ( int n = 0; n < my_size; ++n )
+    {
+        export_ranks_host( n ) = n;
+        export_ids_host( n ) = 2 * n + 1;
+    }
+    auto export_ranks = Kokkos::create_mirror_view_and_copy(
+        TEST_MEMSPACE(), export_ranks_host );
+    auto export_ids =
+        Kokkos::create_mirror_view_and_copy( TEST_MEMSPACE(), export_ids_host );
+    Cabana::Halo<TEST_MEMSPACE> halo( MPI_COMM_WORLD, num_local, export_ids,
+                                      export_ranks );
+
+    // Create data with an extra element after the ghosts.
+    using DataTypes = Cabana::MemberTypes<int, double[2], float>;
+    using AoSoA_t = Cabana::AoSoA<DataTypes, TEST_MEMSPACE>;
+    int num_total = halo.numLocal() + halo.numGhost();
+    AoSoA_t data( "data", num_total + 1 );
+    auto slice_int = Cabana::slice<0>( data );
+    auto slice_dbl = Cabana::slice<1>( data );
+    auto slice_flt = Cabana::slice<2>( data );
+    Cabana::deep_copy( slice_int, -1 );
+    Cabana::deep_copy( slice_dbl, -1.0 );
+    Cabana::deep_copy( slice_flt, -1.0 );
+    auto fill_func = KOKKOS_LAMBDA( const int i )
+    {
+        slice_int( i ) = my_rank + 1;
+        slice_dbl( i, 0 ) = my_rank + 1;
+        slice_dbl( i, 1 ) = my_rank + 1.5;
+        slice_flt( i ) = my_rank + 1.25;
+    };
+    Kokkos::RangePolicy<TEST_EXECSPACE> range_policy( 0, num_local );
+    Kokkos::parallel_for( range_policy, fill_func );
+    Kokkos::fence();
+
+    // Update only the doubles. The extra element is not touched.
+    Cabana::updateGhosts( halo, slice_dbl );
+
+    Cabana::AoSoA<DataTypes, Kokkos::HostSpace> data_host( "data_host",
+                                                           num_total + 1 );
+    auto slice_int_host = Cabana::slice<0>( data_host );
+    auto slice_dbl_host = Cabana::slice<1>( data_host );
+    auto slice_flt_host = Cabana::slice<2>( data_host );
+    auto check = [&]( const double shift, const bool all_members ) {
+        Cabana::deep_copy( data_host, data );
+        for ( int i = num_local; i < num_total; ++i )
+        {
+            // Self sends are first.
+            int send_rank = i - num_local;
+            if ( send_rank == 0 )
+                send_rank = my_rank;
+            else if ( send_rank == my_rank )
+                send_rank = 0;
+            EXPECT_EQ( slice_dbl_host( i, 0 ), send_rank + 1 + shift );
+            EXPECT_EQ( slice_dbl_host( i, 1 ), send_rank + 1.5 + shift );
+            EXPECT_EQ( slice_int_host( i ), all_members ? send_rank + 1 : -1 );
+            EXPECT_EQ( slice_flt_host( i ),
+                       all_members ? send_rank + 1.25 : -1.0 );
+        }
+        EXPECT_EQ( slice_int_host( num_total ), -1 );
+        EXPECT_EQ( slice_dbl_host( num_total, 0 ), -1.0 );
+        EXPECT_EQ( slice_flt_host( num_total ), -1.0 );
+    };
+    check( 0.0, false );
+
+    // Move the owned elements and update the ghosts with the split-phase
+    // interface.
+    auto move_func = KOKKOS_LAMBDA( const int i )
+    {
+        slice_dbl( i, 0 ) += 2.0;
+        slice_dbl( i, 1 ) += 2.0;
+    };
+    Kokkos::parallel_for( range_policy, move_func );
+    Kokkos::fence();
+    auto request = Cabana::updateGhostsStart( halo, slice_dbl );
+    request.finish();
+    check( 2.0, false );
+
+    // Update several members at once.
+    Kokkos::parallel_for( range_policy, move_func );
+    Kokkos::fence();
+    Cabana::updateGhosts<0, 1, 2>( halo, data );
+    check( 4.0, true );
+
+    // Containers without room for the ghosts are rejected.
+    AoSoA_t small( "small", num_total - 1 );
+    auto small_dbl = Cabana::slice<1>( small );
+    auto small_flt = Cabana::slice<2>( small );
+    EXPECT_THROW( Cabana::updateGhostsStart( halo, small_dbl ),
+                  std::runtime_error );
+    EXPECT_THROW( Cabana::updateGhostsStart( halo, slice_dbl, small_flt ),
+                  std::runtime_error );
+    EXPECT_THROW( ( Cabana::updateGhostsStart<0, 1>( halo, small ) ),
+                  std::runtime_error );
+}
+
+//---------------------------------------------------------------------------//
+// test fused gathers of multiple slices
+void testMultiSliceGather()
+{
+    // Get my rank.
+    int my_rank = -1;
+    MPI_Comm_rank( MPI_COMM_WORLD, &my_rank );
+
+    // Get my size.
+    int my_size = -1;
+    MPI_Comm_size( MPI_COMM_WORLD, &my_size );
+
+    // Every rank will send ghosts to all other ranks. Send one element to
+    // each rank including yourself.
+    int num_local = 2 * my_size;
+    Kokkos::View<int*, Kokkos::HostSpace> export_ranks_host( "export_ranks",
+                                                             my_size );
+    Kokkos::View<std::size_t*, Kokkos::HostSpace> export_ids_host( "export_ids",
+                                                                   my_size );
+    for ( int n = 0; n < my_size; ++n )
+    {
+        export_ranks_host( n ) = n;
+        export_ids_host( n ) = 2 * n + 1;
+    }
+    auto export_ranks = Kokkos::create_mirror_view_and_copy(
+        TEST_MEMSPACE(), export_ranks_host );
+    auto export_ids =
+        Kokkos::create_mirror_view_and_copy( TEST_MEMSPACE(), export_ids_host );
+    Cabana::Halo<TEST_MEMSPACE> halo( MPI_COMM_WORLD, num_local, export_ids,
+                                      export_ranks );
+
+    // Create data. Use slices of member types with different alignments.
+    using DataTypes = Cabana::MemberTypes<int, double[2], float[3][2]>;
+    using AoSoA_t = Cabana::AoSoA<DataTypes, TEST_MEMSPACE>;
+    AoSoA_t data( "data", halo.numLocal() + halo.numGhost() );
+    auto slice_int = Cabana::slice<0>( data );
+    auto slice_dbl = Cabana::slice<1>( data );
+    auto slice_flt = Cabana::slice<2>( data );
+    Cabana::deep_copy( slice_int, -1 );
+    Cabana::deep_copy( slice_dbl, -1.0 );
+    Cabana::deep_copy( slice_flt, -1.0 );
+    auto fill_func = KOKKOS_LAMBDA( const int i )
+    {
+        slice_int( i ) = my_rank + 1;
+        slice_dbl( i, 0 ) = my_rank + 1;
+        slice_dbl( i, 1 ) = my_rank + 1.5;
+        for ( int j = 0; j < 3; ++j )
+            for ( int k = 0; k < 2; ++k )
+                slice_flt( i, j, k ) = my_rank + j + 0.5 * k;
+    };
+    Kokkos::RangePolicy<TEST_EXECSPACE> range_policy( 0, num_local );
+    Kokkos::parallel_for( range_policy, fill_func );
+    Kokkos::fence();
+
+    // Gather all three slices at once in an order different than the
+    // members.
+    Cabana::gather( halo, slice_flt, slice_int, slice_dbl );
+
+    // Check the ghosts.
+    Cabana::AoSoA<DataTypes, Kokkos::HostSpace> data_host(
+        "data_host", halo.numLocal() + halo.numGhost() );
+    auto slice_int_host = Cabana::slice<0>( data_host );
+    auto slice_dbl_host = Cabana::slice<1>( data_host );
+    auto slice_flt_host = Cabana::slice<2>( data_host );
+    Cabana::deep_copy( data_host, data );
+    for ( int i = num_local; i < num_local + my_size; ++i )
+    {
+        // Self sends are first.
+        int send_rank = i - num_local;
+        if ( send_rank == 0 )
+            send_rank = my_rank;
+        else if ( send_rank == my_rank )
+            send_rank = 0;
+        EXPECT_EQ( slice_int_host( i ), send_rank + 1 );
+        EXPECT_EQ( slice_dbl_host( i, 0 ), send_rank + 1 );
+        EXPECT_EQ( slice_dbl_host( i, 1 ), send_rank + 1.5 );
+        for ( int j = 0; j < 3; ++j )
+            for ( int k = 0; k < 2; ++k )
+                EXPECT_EQ( slice_flt_host( i, j, k ), send_rank + j + 0.5 * k );
+    }
+
+    // Gather two slices with the split-phase interface.
+    Cabana::deep_copy( slice_int, my_rank + 2 );
+    Cabana::deep_copy( slice_dbl, my_rank + 2.5 );
+    auto request = Cabana::gatherStart( halo, slice_dbl, slice_int );
+    request.finish();
+    Cabana::deep_copy( data_host, data );
+    for ( int i = num_local; i < num_local + my_size; ++i )
+    {
+        int send_rank = i - num_local;
+        if ( send_rank == 0 )
+            send_rank = my_rank;
+        else if ( send_rank == my_rank )
+            send_rank = 0;
+        EXPECT_EQ( slice_int_host( i ), send_rank + 2 );
+        EXPECT_EQ( slice_dbl_host( i, 0 ), send_rank + 2.5 );
+        EXPECT_EQ( slice_dbl_host( i, 1 ), send_rank + 2.5 );
+    }
+}
+
+//---------------------------------------------------------------------------//
+void testGroupedGather()
+{
+    // Get my rank.
+    int my_rank = -1;
+    MPI_Comm_rank( MPI_COMM_WORLD, &my_rank );
+
+    // Get my size.
+    int my_size = -1;
+    MPI_Comm_size( MPI_COMM_WORLD, &my_size );
+
+    // Every rank will send ghosts to all other ranks. Send one element to
+    // each rank including yourself.
+    int num_local = 2 * my_size;
+    Kokkos::View<int*, Kokkos::HostSpace> export_ranks_host( "export_ranks",
+                                                             my_size );
+    Kokkos::View<std::size_t*, Kokkos::HostSpace> export_ids_host( "export_ids",
+                                                                   my_size );
+    for ( int n = 0; n < my_size; ++n )
+    {
+        export_ranks_host( n ) = n;
+        export_ids_host( n ) = 2 * n + 1;
+    }
+    auto export_ranks = Kokkos::create_mirror_view_and_copy(
+        TEST_MEMSPACE(), export_ranks_host );
+    auto export_ids =
+        Kokkos::create_mirror_view_and_copy( TEST_MEMSPACE(), export_ids_host );
+    Cabana::Halo<TEST_MEMSPACE> halo( MPI_COMM_WORLD, num_local, export_ids,
+                                      export_ranks );
+
+    // Create data with a hot and a cold group.
+    using Hot = Cabana::MemberTypes<double[2]>;
+    using Cold = Cabana::MemberTypes<int, float>;
+    using AoSoA_t =
+        Cabana::GroupedAoSoA<Cabana::MemberGroups<Hot, Cold>, TEST_MEMSPACE>;
+    AoSoA_t data( "data", halo.numLocal() + halo.numGhost() );
+    auto slice_dbl = Cabana::slice<0>( data );
+    auto slice_int = Cabana::slice<1>( data );
+    auto slice_flt = Cabana::slice<2>( data );
+    Cabana::deep_copy( slice_dbl, -1.0 );
+    Cabana::deep_copy( slice_int, -1 );
+    Cabana::deep_copy( slice_flt, -1.0 );
+    auto fill_func = KOKKOS_LAMBDA( const int i )
+    {
+        slice_dbl( i, 0 ) = my_rank + 1;
+        slice_dbl( i, 1 ) = my_rank + 1.5;
+        slice_int( i ) = my_rank + 1;
+        slice_flt( i ) = my_rank + 1.25;
+    };
+    Kokkos::RangePolicy<TEST_EXECSPACE> range_policy( 0, num_local );
+    Kokkos::parallel_for( range_policy, fill_func );
+    Kokkos::fence();
+
+    // Gather both groups.
+    Cabana::gather( halo, data );
+
+    // Check the ghosts of both groups.
+    auto hot_host = Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                         data.group<0>() );
+    auto cold_host = Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                          data.group<1>() );
+    auto dbl_host = Cabana::slice<0>( hot_host );
+    auto int_host = Cabana::slice<0>( cold_host );
+    auto flt_host = Cabana::slice<1>( cold_host );
+    for ( int i = num_local; i < num_local + my_size; ++i )
+    {
+        // Self sends are first.
+        int send_rank = i - num_local;
+        if ( send_rank == 0 )
+            send_rank = my_rank;
+        else if ( send_rank == my_rank )
+            send_rank = 0;
+        EXPECT_EQ( dbl_host( i, 0 ), send_rank + 1 );
+        EXPECT_EQ( dbl_host( i, 1 ), send_rank + 1.5 );
+        EXPECT_EQ( int_host( i ), send_rank + 1 );
+        EXPECT_EQ( flt_host( i ), send_rank + 1.25 );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// test gather and scatter with each transport and backend
+void testCommOptions( const Cabana::CommTransport transport,
+                      const Cabana::CommBackend backend )
+{
+    // Get my rank.
+    int my_rank = -1;
+    MPI_Comm_rank( MPI_COMM_WORLD, &my_rank );
+
+    // Get my size.
+    int my_size = -1;
+    MPI_Comm_size( MPI_COMM_WORLD, &my_size );
+
+    // Every rank will send its single data point as ghosts to all other
+    // ranks.
+    int num_local = 1;
+    Kokkos::View<int*, Kokkos::HostSpace> export_ranks_host( "export_ranks",
+                                                             my_size );
+    Kokkos::View<std::size_t*, TEST_MEMSPACE> export_ids( "export_ids",
+                                                          my_size );
+    Kokkos::deep_copy( export_ids, 0 );
+    for ( int n = 0; n < my_size; ++n )
+        export_ranks_host( n ) = n;
+    auto export_ranks = Kokkos::create_mirror_view_and_copy(
+        TEST_MEMSPACE(), export_ranks_host );
+    Cabana::Halo<TEST_MEMSPACE> halo( MPI_COMM_WORLD, num_local, export_ids,
+                                      export_ranks );
+
+    // Set the transport.
+    EXPECT_TRUE( Cabana::CommTransport::Automatic == halo.transport() );
+    EXPECT_EQ( halo.stagingThreshold(), 0 );
+    halo.setTransport( transport, 1024 );
+    EXPECT_TRUE( transport == halo.transport() );
+    EXPECT_EQ( halo.stagingThreshold(), 1024 );
+
+    // Set the backend.
+    EXPECT_TRUE( Cabana::CommBackend::PointToPoint == halo.backend() );
+    halo.setBackend( backend );
+    EXPECT_TRUE( backend == halo.backend() );
+
+    // This rank is recognized as a neighbor on the same node.
+    if ( Cabana::CommBackend::NodeShared == backend )
+    {
+        int my_node_rank = -1;
+        MPI_Comm_rank( halo.nodeComm(), &my_node_rank );
+        for ( int n = 0; n < halo.numNeighbor(); ++n )
+            if ( halo.neighborRank( n ) == my_rank )
+                EXPECT_EQ( halo.neighborNodeRank( n ), my_node_rank );
+            else
+                EXPECT_NE( halo.neighborNodeRank( n ), my_node_rank );
+    }
+
+    // Data in host memory is never staged. Shared memory windows are always
+    // staged through the host.
+    if ( Kokkos::SpaceAccessibility<Kokkos::HostSpace,
+                                    TEST_MEMSPACE>::accessible )
+        EXPECT_FALSE( halo.stageMessages( 0 ) );
+    else if ( Cabana::CommBackend::NodeShared == backend )
+        EXPECT_TRUE( halo.stageMessages( 0 ) );
+    else if ( Cabana::CommTransport::HostStaged == transport )
+        EXPECT_TRUE( halo.stageMessages( 0 ) );
+    else if ( Cabana::CommTransport::Direct == transport )
+        EXPECT_FALSE( halo.stageMessages( 0 ) );
+
+    // Create data.
+    using DataTypes = Cabana::MemberTypes<int, double[2]>;
+    using AoSoA_t = Cabana::AoSoA<DataTypes, TEST_MEMSPACE>;
+    AoSoA_t data( "data", halo.numLocal() + halo.numGhost() );
+    auto slice_int = Cabana::slice<0>( data );
+    auto slice_dbl = Cabana::slice<1>( data );
+    Cabana::deep_copy( slice_int, my_rank + 1 );
+    Cabana::deep_copy( slice_dbl, my_rank + 1.5 );
+
+    // Gather the AoSoA, a slice, and a set of slices, then scatter.
+    Cabana::gather( halo, data );
+    Cabana::gather( halo, slice_dbl );
+    Cabana::gather( halo, slice_int, slice_dbl );
+    Cabana::scatter( halo, slice_int );
+
+    // Check the results.
+    Cabana::AoSoA<DataTypes, Kokkos::HostSpace> data_host(
+        "data_host", halo.numLocal() + halo.numGhost() );
+    auto slice_int_host = Cabana::slice<0>( data_host );
+    auto slice_dbl_host = Cabana::slice<1>( data_host );
+    Cabana::deep_copy( data_host, data );
+    EXPECT_EQ( slice_int_host( 0 ), ( my_rank + 1 ) * ( my_size + 1 ) );
+    for ( int n = 0; n < my_size; ++n )
+    {
+        // Self sends are first in the ghosts.
+        int send_rank = n;
+        if ( 0 == n )
+            send_rank = my_rank;
+        else if ( my_rank == n )
+            send_rank = 0;
+        EXPECT_EQ( slice_int_host( num_local + n ), send_rank + 1 );
+        EXPECT_EQ( slice_dbl_host( num_local + n, 0 ), send_rank + 1.5 );
+        EXPECT_EQ( slice_dbl_host( num_local + n, 1 ), send_rank + 1.5 );
+    }
+}
+
+//---------------------------------------------------------------------------//
+void testReducedPrecision()
+{
+    // Get my rank.
+    int my_rank = -1;
+    MPI_Comm_rank( MPI_COMM_WORLD, &my_rank );
+
+    // Get my size.
+    int my_size = -1;
+    MPI_Comm_size( MPI_COMM_WORLD, &my_size );
+
+    // Every rank will send its single data point as ghosts to all other
+    // ranks.
+    int num_local = 1;
+    Kokkos::View<int*, Kokkos::HostSpace> export_ranks_host( "export_ranks",
+                                                             my_size );
+    Kokkos::View<std::size_t*, TEST_MEMSPACE> export_ids( "export_ids",
+                                                          my_size );
+    Kokkos::deep_copy( export_ids, 0 );
+    for ( int n = 0; n < my_size; ++n )
+        export_ranks_host( n ) = n;
+    auto export_ranks = Kokkos::create_mirror_view_and_copy(
+        TEST_MEMSPACE(), export_ranks_host );
+    Cabana::Halo<TEST_MEMSPACE> halo( MPI_COMM_WORLD, num_local, export_ids,
+                                      export_ranks );
+    EXPECT_TRUE( Cabana::CommPrecision::Full == halo.gatherPrecision() );
+    halo.setGatherPrecision( Cabana::CommPrecision::Reduced );
+    EXPECT_TRUE( Cabana::CommPrecision::Reduced == halo.gatherPrecision() );
+
+    // Create data with a double value that can not be represented exactly in
+    // single precision.
+    using DataTypes = Cabana::MemberTypes<int, double[2]>;
+    using AoSoA_t = Cabana::AoSoA<DataTypes, TEST_MEMSPACE>;
+    AoSoA_t data( "data", halo.numLocal() + halo.numGhost() );
+    auto slice_int = Cabana::slice<0>( data );
+    auto slice_dbl = Cabana::slice<1>( data );
+    Cabana::deep_copy( slice_int, my_rank + 1 );
+    Cabana::deep_copy( slice_dbl, my_rank + 0.1 );
+
+    // Gather the slices with reduced precision. The integers are sent
+    // unchanged.
+    Cabana::gather( halo, slice_int );
+    Cabana::gather( halo, slice_dbl );
+
+    // Check the results.
+    Cabana::AoSoA<DataTypes, Kokkos::HostSpace> data_host(
+        "data_host", halo.numLocal() + halo.numGhost() );
+    auto slice_int_host = Cabana::slice<0>( data_host );
+    auto slice_dbl_host = Cabana::slice<1>( data_host );
+    auto send_rank = [=]( const int n ) {
+        // Self sends are first in the ghosts.
+        if ( 0 == n )
+            return my_rank;
+        else if ( my_rank == n )
+            return 0;
+        return n;
+    };
+    Cabana::deep_copy( data_host, data );
+    EXPECT_EQ( slice_dbl_host( 0, 0 ), my_rank + 0.1 );
+    for ( int n = 0; n < my_size; ++n )
+    {
+        double reduced = static_cast<float>( send_rank( n ) + 0.1 );
+        EXPECT_EQ( slice_int_host( num_local + n ), send_rank( n ) + 1 );
+        EXPECT_EQ( slice_dbl_host( num_local + n, 0 ), reduced );
+        EXPECT_EQ( slice_dbl_host( num_local + n, 1 ), reduced );
+    }
+
+    // Gather again with full precision.
+    halo.setGatherPrecision( Cabana::CommPrecision::Full );
+    Cabana::gather( halo, slice_dbl );
+    Cabana::deep_copy( data_host, data );
+    for ( int n = 0; n < my_size; ++n )
+    {
+        EXPECT_EQ( slice_dbl_host( num_local + n, 0 ), send_rank( n ) + 0.1 );
+        EXPECT_EQ( slice_dbl_host( num_local + n, 1 ), send_rank( n ) + 0.1 );
+    }
+}
+
+//---------------------------------------------------------------------------//
+void testStatistics()
+{
+    // Get my rank.
+    int my_rank = -1;
+    MPI_Comm_rank( MPI_COMM_WORLD, &my_rank );
+
+    // Get my size.
+    int my_size = -1;
+    MPI_Comm_size( MPI_COMM_WORLD, &my_size );
+
+    // Every rank will send its single data point as ghosts to all other
+    // ranks.
+    int num_local = 1;
+    Kokkos::View<int*, Kokkos::HostSpace> export_ranks_host( "export_ranks",
+                                                             my_size );
+    Kokkos::View<std::size_t*, TEST_MEMSPACE> export_ids( "export_ids",
+                                                          my_size );
+    Kokkos::deep_copy( export_ids, 0 );
+    for ( int n = 0; n < my_size; ++n )
+        export_ranks_host( n ) = n;
+    auto export_ranks = Kokkos::create_mirror_view_and_copy(
+        TEST_MEMSPACE(), export_ranks_host );
+    Cabana::Halo<TEST_MEMSPACE> halo( MPI_COMM_WORLD, num_local, export_ids,
+                                      export_ranks );
+    EXPECT_FALSE( halo.statistics() );
+    auto stats = std::make_shared<Cabana::CommStatistics>();
+    halo.setStatistics( stats );
+    EXPECT_EQ( halo.statistics(), stats );
+
+    // Create data.
+    using DataTypes = Cabana::MemberTypes<int, double[2]>;
+    using AoSoA_t = Cabana::AoSoA<DataTypes, TEST_MEMSPACE>;
+    AoSoA_t data( "data", halo.numLocal() + halo.numGhost() );
+    auto slice_int = Cabana::slice<0>( data );
+    auto slice_dbl = Cabana::slice<1>( data );
+    Cabana::deep_copy( slice_int, my_rank + 1 );
+    Cabana::deep_copy( slice_dbl, my_rank + 1.5 );
+
+    // Gather the doubles and scatter the integers. One element is exchanged
+    // with each rank in each direction.
+    Cabana::gather( halo, slice_dbl );
+    Cabana::scatter( halo, slice_int );
+    std::size_t num_other = my_size - 1;
+    std::size_t element_bytes = sizeof( int ) + 2 * sizeof( double );
+    EXPECT_EQ( stats->numOperations(), 2 );
+    EXPECT_EQ( stats->numMessagesSent(), 2 * num_other );
+    EXPECT_EQ( stats->numMessagesReceived(), 2 * num_other );
+    EXPECT_EQ( stats->bytesSent(), num_other * element_bytes );
+    EXPECT_EQ( stats->bytesReceived(), num_other * element_bytes );
+    EXPECT_EQ( stats->bytesSelf(), element_bytes );
+    EXPECT_GE( stats->waitTime(), 0.0 );
+
+    // Every rank does the same amount of communication.
+    auto summary = stats->summarize( MPI_COMM_WORLD );
+    EXPECT_EQ( summary.num_operations.min, 2.0 );
+    EXPECT_EQ( summary.num_operations.max, 2.0 );
+    EXPECT_EQ( summary.num_operations.avg, 2.0 );
+    EXPECT_EQ( summary.bytes_sent.min, num_other * element_bytes );
+    EXPECT_EQ( summary.bytes_sent.max, num_other * element_bytes );
+    EXPECT_LE( summary.wait_time.min, summary.wait_time.max );
+
+    // Only the first rank writes the summary.
+    std::ostringstream report;
+    stats->report( report, MPI_COMM_WORLD );
+    EXPECT_EQ( 0 == my_rank, !report.str().empty() );
+
+    // Reset the counters.
+    stats->reset();
+    EXPECT_EQ( stats->numOperations(), 0 );
+    EXPECT_EQ( stats->bytesSent(), 0 );
+    EXPECT_EQ( stats->waitTime(), 0.0 );
+
+    // Detached statistics are not updated.
+    halo.setStatistics( nullptr );
+    Cabana::gather( halo, slice_dbl );
+    EXPECT_EQ( stats->numOperations(), 0 );
+}
+
+//---------------------------------------------------------------------------//
+// test split-phase gathers driven by a progress thread
+void testCommProgress()
+{
+    // Get my rank.
+    int my_rank = -1;
+    MPI_Comm_rank( MPI_COMM_WORLD, &my_rank );
+
+    // Get my size.
+    int my_size = -1;
+    MPI_Comm_size( MPI_COMM_WORLD, &my_size );
+
+    // Every rank will send its single data point as ghosts to all ranks.
+    int num_local = 1;
+    Kokkos::View<int*, Kokkos::HostSpace> export_ranks_host( "export_ranks",
+                                                             my_size );
+    for ( int n = 0; n < my_size; ++n )
+        export_ranks_host( n ) = n;
+    auto export_ranks = Kokkos::create_mirror_view_and_copy(
+        TEST_MEMSPACE(), export_ranks_host );
+    Kokkos::View<std::size_t*, TEST_MEMSPACE> export_ids( "export_ids",
+                                                          my_size );
+    Cabana::Halo<TEST_MEMSPACE> halo( MPI_COMM_WORLD, num_local, export_ids,
+                                      export_ranks );
+
+    // Attach the progress thread.
+    auto progress = std::make_shared<Cabana::CommProgress>();
+    EXPECT_EQ( progress->numActive(), 0u );
+    halo.setProgress( progress );
+    EXPECT_EQ( halo.progress(), progress );
+
+    // Create data.
+    Cabana::AoSoA<Cabana::MemberTypes<int>, TEST_MEMSPACE> data(
+        "data", halo.numLocal() + halo.numGhost() );
+    auto slice_int = Cabana::slice<0>( data );
+    Cabana::deep_copy( slice_int, my_rank + 1 );
+
+    // The gather is registered with the progress thread while it is in
+    // flight.
+    auto request = Cabana::gatherStart( halo, slice_int );
+    EXPECT_EQ( progress->numActive(), 1u );
+    Kokkos::parallel_for(
+        "compute", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, 1000 ),
+        KOKKOS_LAMBDA( const int ) {} );
+    Kokkos::fence();
+    request.finish();
+    EXPECT_EQ( progress->numActive(), 0u );
+
+    // Check that we got one element from everyone.
+    auto data_host =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), data );
+    auto slice_int_host = Cabana::slice<0>( data_host );
+    int sum = 0;
+    for ( int i = num_local; i < num_local + my_size; ++i )
+        sum += slice_int_host( i );
+    EXPECT_EQ( sum, my_size * ( my_size + 1 ) / 2 );
+}
+
 //---------------------------------------------------------------------------//
 // RUN TESTS
 //---------------------------------------------------------------------------//
@@ -416,6 +1336,67 @@ TEST( TEST_CATEGORY, halo_test_2 ) { test2( true ); }
 
 TEST( TEST_CATEGORY, halo_test_2_no_topo ) { test2( false ); }
 
+TEST( TEST_CATEGORY, halo_test_buffer_reuse ) { testBufferReuse(); }
+
+TEST( TEST_CATEGORY, halo_test_split_phase ) { testSplitPhaseGather(); }
+
+TEST( TEST_CATEGORY, halo_test_member_subset ) { testMemberSubsetGather(); }
+
+TEST( TEST_CATEGORY, halo_test_multi_slice ) { testMultiSliceGather(); }
+
+TEST( TEST_CATEGORY, halo_test_grouped ) { testGroupedGather(); }
+
+TEST( TEST_CATEGORY, halo_test_update_ghosts ) { testUpdateGhosts(); }
+
+TEST( TEST_CATEGORY, halo_test_transport_direct )
+{
+    testCommOptions( Cabana::CommTransport::Direct,
+                     Cabana::CommBackend::PointToPoint );
+}
+
+TEST( TEST_CATEGORY, halo_test_transport_host_staged )
+{
+    testCommOptions( Cabana::CommTransport::HostStaged,
+                     Cabana::CommBackend::PointToPoint );
+}
+
+TEST( TEST_CATEGORY, halo_test_transport_automatic )
+{
+    testCommOptions( Cabana::CommTransport::Automatic,
+                     Cabana::CommBackend::PointToPoint );
+}
+
+TEST( TEST_CATEGORY, halo_test_neighbor_collective )
+{
+    testCommOptions( Cabana::CommTransport::Automatic,
+                     Cabana::CommBackend::NeighborCollective );
+}
+
+TEST( TEST_CATEGORY, halo_test_neighbor_collective_host_staged )
+{
+    testCommOptions( Cabana::CommTransport::HostStaged,
+                     Cabana::CommBackend::NeighborCollective );
+}
+
+TEST( TEST_CATEGORY, halo_test_node_shared )
+{
+    testCommOptions( Cabana::CommTransport::Automatic,
+                     Cabana::CommBackend::NodeShared );
+}
+
+TEST( TEST_CATEGORY, halo_test_reduced_precision ) { testReducedPrecision(); }
+
+TEST( TEST_CATEGORY, halo_test_statistics ) { testStatistics(); }
+
+TEST( TEST_CATEGORY, halo_test_comm_progress )
+{
+    // A progress thread needs full MPI thread support. Set
+    // CABANA_TEST_MPI_THREAD_MULTIPLE in the environment to request it.
+    if ( !Cabana::CommProgress::threadSupport() )
+        GTEST_SKIP() << "MPI_THREAD_MULTIPLE not provided";
+    testCommProgress();
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
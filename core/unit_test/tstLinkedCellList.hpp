@@ -11,10 +11,16 @@
 
 #include <Cabana_AoSoA.hpp>
 #include <Cabana_DeepCopy.hpp>
+#include <Cabana_HashedCellList.hpp>
 #include <Cabana_LinkedCellList.hpp>
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
 namespace Test
 {
 struct LCLTestData
@@ -318,6 +324,246 @@ void testLinkedListSlice()
     }
 }
 
+//---------------------------------------------------------------------------//
+void testLinkedListReuse()
+{
+    LCLTestData test_data;
+    auto grid_delta = test_data.grid_delta;
+    auto grid_min = test_data.grid_min;
+    auto grid_max = test_data.grid_max;
+    auto pos = Cabana::slice<LCLTestData::Position>( test_data.aosoa );
+
+    // Bin all of the particles and then rebuild the same list with fewer and
+    // then with all particles again, reusing the list storage. The particles
+    // are reset before the last build to undo the first permutation.
+    Cabana::LinkedCellList<TEST_MEMSPACE> cell_list( pos, grid_delta, grid_min,
+                                                     grid_max );
+    {
+        auto begin = test_data.begin;
+        auto end = test_data.end;
+        cell_list.build( pos, begin, end );
+        Cabana::permute( cell_list, test_data.aosoa );
+
+        copyListToHost( test_data, cell_list );
+
+        checkBins( test_data, cell_list );
+        checkLinkedCell( test_data, begin, end, true );
+    }
+    {
+        test_data.createParticles();
+        cell_list.reserve( 2 * test_data.num_p );
+        cell_list.build( pos );
+        Cabana::permute( cell_list, test_data.aosoa );
+
+        copyListToHost( test_data, cell_list );
+
+        checkBins( test_data, cell_list );
+        checkLinkedCell( test_data, 0, test_data.num_p, true );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Check that two linked cell lists bin the same particles in each cell.
+void checkSameBinning( const Cabana::LinkedCellList<TEST_MEMSPACE> list_1,
+                       const Cabana::LinkedCellList<TEST_MEMSPACE> list_2,
+                       const int num_p )
+{
+    int ncell = list_1.totalBins();
+    Kokkos::View<int* [4], TEST_MEMSPACE> bins( "bins", ncell );
+    Kokkos::View<int* [2], TEST_MEMSPACE> permutes( "permutes", num_p );
+    Kokkos::parallel_for(
+        "copy bin data", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, ncell ),
+        KOKKOS_LAMBDA( const int c ) {
+            int i, j, k;
+            list_1.ijkBinIndex( c, i, j, k );
+            bins( c, 0 ) = list_1.binSize( i, j, k );
+            bins( c, 1 ) = list_1.binOffset( i, j, k );
+            bins( c, 2 ) = list_2.binSize( i, j, k );
+            bins( c, 3 ) = list_2.binOffset( i, j, k );
+        } );
+    Kokkos::parallel_for(
+        "copy permutation", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_p ),
+        KOKKOS_LAMBDA( const int p ) {
+            permutes( p, 0 ) = list_1.permutation( p );
+            permutes( p, 1 ) = list_2.permutation( p );
+        } );
+    Kokkos::fence();
+    auto bins_mirror =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), bins );
+    auto permutes_mirror =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), permutes );
+
+    // The order of the particles in a cell may differ.
+    for ( int c = 0; c < ncell; ++c )
+    {
+        EXPECT_EQ( bins_mirror( c, 0 ), bins_mirror( c, 2 ) );
+        EXPECT_EQ( bins_mirror( c, 1 ), bins_mirror( c, 3 ) );
+        std::vector<int> ids_1;
+        std::vector<int> ids_2;
+        for ( int n = 0; n < bins_mirror( c, 0 ); ++n )
+        {
+            ids_1.push_back( permutes_mirror( bins_mirror( c, 1 ) + n, 0 ) );
+            ids_2.push_back( permutes_mirror( bins_mirror( c, 1 ) + n, 1 ) );
+        }
+        std::sort( ids_1.begin(), ids_1.end() );
+        std::sort( ids_2.begin(), ids_2.end() );
+        EXPECT_EQ( ids_1, ids_2 );
+    }
+}
+
+//---------------------------------------------------------------------------//
+void testLinkedListUpdate()
+{
+    LCLTestData test_data;
+    auto grid_delta = test_data.grid_delta;
+    auto grid_min = test_data.grid_min;
+    auto grid_max = test_data.grid_max;
+    auto pos = Cabana::slice<LCLTestData::Position>( test_data.aosoa );
+    int num_p = test_data.num_p;
+
+    Cabana::LinkedCellList<TEST_MEMSPACE> cell_list( pos, grid_delta, grid_min,
+                                                     grid_max );
+
+    // Updating without moving particles does not change the binning.
+    cell_list.update( pos );
+    {
+        Cabana::LinkedCellList<TEST_MEMSPACE> ref_list( pos, grid_delta,
+                                                        grid_min, grid_max );
+        checkSameBinning( cell_list, ref_list, num_p );
+    }
+
+    // Move the first particles into the cells of their neighbors in x. The
+    // first cell is left empty and the sixth cell holds two particles.
+    auto dx = test_data.dx;
+    Kokkos::parallel_for(
+        "move particles", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, 5 ),
+        KOKKOS_LAMBDA( const int p ) { pos( p, 0 ) += dx; } );
+    Kokkos::fence();
+    cell_list.update( pos );
+    {
+        Cabana::LinkedCellList<TEST_MEMSPACE> ref_list( pos, grid_delta,
+                                                        grid_min, grid_max );
+        checkSameBinning( cell_list, ref_list, num_p );
+    }
+
+    // Move them back.
+    Kokkos::parallel_for(
+        "move particles", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, 5 ),
+        KOKKOS_LAMBDA( const int p ) { pos( p, 0 ) -= dx; } );
+    Kokkos::fence();
+    cell_list.update( pos );
+    {
+        Cabana::LinkedCellList<TEST_MEMSPACE> ref_list( pos, grid_delta,
+                                                        grid_min, grid_max );
+        checkSameBinning( cell_list, ref_list, num_p );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Check that every particle of a range is found in its hashed cell and that
+// the cells hold all particles of the range.
+void checkHashedCells( const Cabana::HashedCellList<TEST_MEMSPACE>& cell_list,
+                       const LCLTestData::aosoa_type& aosoa,
+                       const std::size_t begin, const std::size_t end )
+{
+    auto pos = Cabana::slice<LCLTestData::Position>( aosoa );
+    int num_error = 0;
+    Kokkos::parallel_reduce(
+        "check_cells", Kokkos::RangePolicy<TEST_EXECSPACE>( begin, end ),
+        KOKKOS_LAMBDA( const std::size_t p, int& error ) {
+            std::int64_t i, j, k;
+            cell_list.locatePoint( pos( p, 0 ), pos( p, 1 ), pos( p, 2 ), i, j,
+                                   k );
+            int cell = cell_list.findCell( i, j, k );
+            bool found = false;
+            if ( cell >= 0 )
+                for ( int n = 0; n < cell_list.binSize( cell ); ++n )
+                    if ( cell_list.permutation( cell_list.binOffset( cell ) +
+                                                n ) == p )
+                        found = true;
+            if ( !found )
+                ++error;
+        },
+        num_error );
+    EXPECT_EQ( num_error, 0 );
+
+    int num_binned = 0;
+    Kokkos::parallel_reduce(
+        "count_binned",
+        Kokkos::RangePolicy<TEST_EXECSPACE>( 0, cell_list.numCell() ),
+        KOKKOS_LAMBDA( const int c, int& count ) {
+            count += cell_list.binSize( c );
+        },
+        num_binned );
+    EXPECT_EQ( static_cast<std::size_t>( num_binned ), end - begin );
+}
+
+//---------------------------------------------------------------------------//
+void testHashedCellList()
+{
+    LCLTestData test_data;
+    auto grid_delta = test_data.grid_delta;
+    auto pos = Cabana::slice<LCLTestData::Position>( test_data.aosoa );
+    std::size_t num_p = test_data.num_p;
+
+    // Move the first particle far outside of the grid. Every particle is in
+    // its own cell.
+    Kokkos::parallel_for(
+        "escape", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, 1 ),
+        KOKKOS_LAMBDA( const int p ) {
+            pos( p, 0 ) = 1.0e12;
+            pos( p, 1 ) = -3.0e9;
+        } );
+    Kokkos::fence();
+
+    Cabana::HashedCellList<TEST_MEMSPACE> cell_list( pos, grid_delta );
+    EXPECT_EQ( static_cast<std::size_t>( cell_list.numCell() ), num_p );
+    checkHashedCells( cell_list, test_data.aosoa, 0, num_p );
+
+    // Cells outside of the particles are empty and cells 2^21 cells apart
+    // share a bin.
+    Kokkos::View<int[3], TEST_MEMSPACE> lookup( "lookup" );
+    Kokkos::parallel_for(
+        "lookup", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, 1 ),
+        KOKKOS_LAMBDA( const int ) {
+            lookup( 0 ) = cell_list.findCell( 10, 0, 0 );
+            lookup( 1 ) = cell_list.findCell( 3, 4, 5 );
+            lookup( 2 ) = cell_list.findCell( 3 + ( 1 << 21 ), 4, 5 );
+        } );
+    auto lookup_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), lookup );
+    EXPECT_EQ( lookup_host( 0 ), -1 );
+    EXPECT_GE( lookup_host( 1 ), 0 );
+    EXPECT_EQ( lookup_host( 1 ), lookup_host( 2 ) );
+
+    // Bin a subset and permute the particles by cell. Binning them again
+    // gives the identity permutation.
+    Cabana::HashedCellList<TEST_MEMSPACE> range_list(
+        TEST_EXECSPACE{}, pos, test_data.begin, test_data.end, grid_delta );
+    EXPECT_EQ( range_list.rangeBegin(), test_data.begin );
+    EXPECT_EQ( range_list.rangeEnd(), test_data.end );
+    checkHashedCells( range_list, test_data.aosoa, test_data.begin,
+                      test_data.end );
+    Cabana::permute( range_list, test_data.aosoa );
+    Cabana::HashedCellList<TEST_MEMSPACE> sorted_list(
+        pos, test_data.begin, test_data.end, grid_delta );
+    std::size_t begin = test_data.begin;
+    int num_moved = 0;
+    Kokkos::parallel_reduce(
+        "check_sorted",
+        Kokkos::RangePolicy<TEST_EXECSPACE>( 0, test_data.end - begin ),
+        KOKKOS_LAMBDA( const std::size_t n, int& count ) {
+            if ( sorted_list.permutation( n ) != begin + n )
+                ++count;
+        },
+        num_moved );
+    EXPECT_EQ( num_moved, 0 );
+
+    double bad_size[3] = { 1.0, 0.0, 1.0 };
+    EXPECT_THROW( Cabana::HashedCellList<TEST_MEMSPACE>( pos, bad_size ),
+                  std::runtime_error );
+}
+
 //---------------------------------------------------------------------------//
 // RUN TESTS
 //---------------------------------------------------------------------------//
@@ -326,6 +572,15 @@ TEST( TEST_CATEGORY, linked_list_test ) { testLinkedList(); }
 //---------------------------------------------------------------------------//
 TEST( TEST_CATEGORY, linked_list_slice_test ) { testLinkedListSlice(); }
 
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, linked_list_reuse_test ) { testLinkedListReuse(); }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, linked_list_update_test ) { testLinkedListUpdate(); }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, hashed_cell_list_test ) { testHashedCellList(); }
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
@@ -0,0 +1,93 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_MemoryTracker.hpp>
+#include <Cabana_Sort.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+namespace Test
+{
+#if KOKKOS_VERSION >= 30300
+//---------------------------------------------------------------------------//
+void testTrackSort()
+{
+    using DataTypes = Cabana::MemberTypes<double[3], int>;
+    using AoSoA_t = Cabana::AoSoA<DataTypes, TEST_MEMSPACE>;
+    int num_data = 1000;
+    AoSoA_t aosoa( "aosoa", num_data );
+    Kokkos::View<int*, TEST_MEMSPACE> keys( "keys", num_data );
+    Kokkos::parallel_for(
+        "fill", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_data ),
+        KOKKOS_LAMBDA( const int p ) { keys( p ) = num_data - p - 1; } );
+
+    // Allocations outside of Cabana operations are not tracked.
+    Cabana::MemoryTracker::start();
+    EXPECT_TRUE( Cabana::MemoryTracker::running() );
+    Kokkos::View<double*, TEST_MEMSPACE> user( "user", num_data );
+    EXPECT_EQ( Cabana::MemoryTracker::total().num_allocations, 0 );
+
+    {
+        // The binning data is owned by the sort and stays allocated while it
+        // is in use.
+        auto binning_data = Cabana::sortByKey( keys );
+        auto sort_usage = Cabana::MemoryTracker::categories();
+        ASSERT_EQ( sort_usage.count( "Cabana::sortByKey" ), 1 );
+        EXPECT_GT( sort_usage["Cabana::sortByKey"].current_bytes, 0 );
+        EXPECT_GE( sort_usage["Cabana::sortByKey"].peak_bytes,
+                   sort_usage["Cabana::sortByKey"].current_bytes );
+        EXPECT_FALSE( Cabana::MemoryTracker::labels( "Cabana::sortByKey" )
+                          .empty() );
+
+        // The permute scratch is freed when the permute completes.
+        Cabana::permute( binning_data, aosoa );
+        auto permute_usage = Cabana::MemoryTracker::categories();
+        ASSERT_EQ( permute_usage.count( "Cabana::permute" ), 1 );
+        EXPECT_EQ( permute_usage["Cabana::permute"].current_bytes, 0 );
+        EXPECT_GT( permute_usage["Cabana::permute"].peak_bytes, 0 );
+    }
+
+    // Memory freed outside of the operation is accounted for.
+    auto usage = Cabana::MemoryTracker::categories();
+    EXPECT_EQ( usage["Cabana::sortByKey"].current_bytes, 0 );
+    EXPECT_EQ( Cabana::MemoryTracker::total().current_bytes, 0 );
+    EXPECT_GT( Cabana::MemoryTracker::total().peak_bytes, 0 );
+
+    // Resetting the peaks sets them to the current usage.
+    Cabana::MemoryTracker::resetPeaks();
+    EXPECT_EQ( Cabana::MemoryTracker::total().peak_bytes, 0 );
+    EXPECT_EQ( Cabana::MemoryTracker::total().num_allocations, 0 );
+
+    std::ostringstream report;
+    Cabana::MemoryTracker::report( report );
+    EXPECT_NE( report.str().find( "Cabana::permute" ), std::string::npos );
+
+    // Nothing is tracked once stopped.
+    Cabana::MemoryTracker::stop();
+    EXPECT_FALSE( Cabana::MemoryTracker::running() );
+    Cabana::sortByKey( keys );
+    EXPECT_EQ( Cabana::MemoryTracker::total().num_allocations, 0 );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, memory_tracker_sort_test ) { testTrackSort(); }
+
+//---------------------------------------------------------------------------//
+#endif
+
+} // end namespace Test
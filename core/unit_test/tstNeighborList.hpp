@@ -10,6 +10,8 @@
  ****************************************************************************/
 
 #include <Cabana_AoSoA.hpp>
+#include <Cabana_DeepCopy.hpp>
+#include <Cabana_Graph.hpp>
 #include <Cabana_NeighborList.hpp>
 #include <Cabana_Parallel.hpp>
 #include <Cabana_VerletList.hpp>
@@ -20,6 +22,13 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
 namespace Test
 {
 //---------------------------------------------------------------------------//
@@ -100,6 +109,87 @@ void testLinkedCellStencil()
         EXPECT_EQ( kmin, 8 );
         EXPECT_EQ( kmax, 10 );
     }
+
+    // Cells out of reach of the center cell are pruned
+    {
+        double min[3] = { 0.0, 0.0, 0.0 };
+        double max[3] = { 10.0, 10.0, 10.0 };
+        double radius = 1.0;
+        double ratio = 0.25;
+        Cabana::Impl::LinkedCellStencil<double> stencil( radius, ratio, min,
+                                                         max );
+
+        // Of the 9^3 cells of the cube those with a squared gap of at most
+        // 16 cell sizes squared remain.
+        EXPECT_EQ( stencil.max_cells, 729 );
+        EXPECT_EQ( stencil.numCell(), 613 );
+        for ( int s = 0; s < stencil.numCell(); ++s )
+        {
+            double dsqr = 0.0;
+            for ( int d = 0; d < 3; ++d )
+            {
+                double gap =
+                    std::max( std::abs( stencil.offsets( s, d ) ) - 1, 0 ) *
+                    0.25;
+                dsqr += gap * gap;
+            }
+            EXPECT_LE( dsqr, 1.0 );
+        }
+
+        // Only the cells inside the grid remain next to a corner.
+        int num_inside = 0;
+        for ( int s = 0; s < stencil.numCell(); ++s )
+        {
+            int i, j, k;
+            if ( stencil.getCell( 0, 0, 0, s, i, j, k ) )
+            {
+                EXPECT_TRUE( i >= 0 && j >= 0 && k >= 0 );
+                ++num_inside;
+            }
+        }
+        EXPECT_LT( num_inside, stencil.numCell() );
+    }
+
+    // Anisotropic cells
+    {
+        double min[3] = { 0.0, 0.0, 0.0 };
+        double max[3] = { 10.0, 10.0, 10.0 };
+        double radius = 1.0;
+        double cell_size[3] = { 1.0, 2.0, 0.5 };
+        Cabana::Impl::LinkedCellStencil<double> stencil( radius, cell_size,
+                                                         min, max );
+        EXPECT_EQ( stencil.max_cells, 45 );
+
+        double xp = 4.5;
+        double yp = 5.5;
+        double zp = 3.5;
+        int ic, jc, kc;
+        stencil.grid.locatePoint( xp, yp, zp, ic, jc, kc );
+        int cell = stencil.grid.cardinalCellIndex( ic, jc, kc );
+        int imin, imax, jmin, jmax, kmin, kmax;
+        stencil.getCells( cell, imin, imax, jmin, jmax, kmin, kmax );
+        EXPECT_EQ( imin, 3 );
+        EXPECT_EQ( imax, 6 );
+        EXPECT_EQ( jmin, 1 );
+        EXPECT_EQ( jmax, 4 );
+        EXPECT_EQ( kmin, 5 );
+        EXPECT_EQ( kmax, 10 );
+    }
+
+    // A dimension thinner than a cell adds no stencil cells
+    {
+        double min[3] = { 0.0, 0.0, 0.0 };
+        double max[3] = { 10.0, 10.0, 0.5 };
+        double radius = 1.0;
+        double ratio = 1.0;
+        Cabana::Impl::LinkedCellStencil<double> stencil( radius, ratio, min,
+                                                         max );
+        EXPECT_EQ( stencil.grid.numBin( 2 ), 1 );
+        EXPECT_EQ( stencil.max_cells, 9 );
+        EXPECT_EQ( stencil.numCell(), 9 );
+        for ( int s = 0; s < stencil.numCell(); ++s )
+            EXPECT_EQ( stencil.offsets( s, 2 ), 0 );
+    }
 }
 
 //---------------------------------------------------------------------------//
@@ -156,6 +246,73 @@ void testVerletListFull()
     }
 }
 
+//---------------------------------------------------------------------------//
+// Rebuild a 2D list after the neighbor counts grew past its allocation. The
+// rebuild reuses the previous allocation size, so the particles that
+// overflow it are refilled in a larger list and the others are copied.
+template <class BuildTag>
+void testVerletList2DRebuildGrowth()
+{
+    NeighborListTestData test_data;
+    auto position = Cabana::slice<0>( test_data.aosoa );
+    using list_type =
+        Cabana::VerletList<TEST_MEMSPACE, Cabana::FullNeighborTag,
+                           Cabana::VerletLayout2D, BuildTag>;
+    list_type nlist( position, 0, position.size(), test_data.test_radius,
+                     test_data.cell_size_ratio, test_data.grid_min,
+                     test_data.grid_max );
+    checkFullNeighborList( nlist, test_data.N2_list_copy,
+                           test_data.num_particle );
+    int old_max = static_cast<int>(
+        Cabana::NeighborList<list_type>::maxNeighbor( nlist ) );
+
+    // Pack the first half of the particles into a corner of the box to raise
+    // their density. The other half keep their neighbor counts.
+    double box_min = test_data.box_min;
+    int num_packed = test_data.num_particle / 2;
+    Kokkos::parallel_for(
+        "pack_particles", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_packed ),
+        KOKKOS_LAMBDA( const int p ) {
+            for ( int d = 0; d < 3; ++d )
+                position( p, d ) =
+                    box_min + 0.25 * ( position( p, d ) - box_min );
+        } );
+    Kokkos::fence();
+    auto N2_list_copy = createTestListHostCopy(
+        computeFullNeighborList( position, test_data.test_radius ) );
+    int new_max = 0;
+    for ( int p = 0; p < test_data.num_particle; ++p )
+        new_max = std::max( new_max, N2_list_copy.counts( p ) );
+    EXPECT_GT( new_max, old_max );
+
+    // Rebuild and compare against the brute force list and a fresh build.
+    nlist.build( position, 0, position.size(), test_data.test_radius,
+                 test_data.cell_size_ratio, test_data.grid_min,
+                 test_data.grid_max );
+    checkFullNeighborList( nlist, N2_list_copy, test_data.num_particle );
+    list_type fresh( position, 0, position.size(), test_data.test_radius,
+                     test_data.cell_size_ratio, test_data.grid_min,
+                     test_data.grid_max );
+    EXPECT_EQ( Cabana::NeighborList<list_type>::maxNeighbor( nlist ),
+               Cabana::NeighborList<list_type>::maxNeighbor( fresh ) );
+    auto rebuilt_copy =
+        copyListToHost( nlist, test_data.num_particle, new_max );
+    auto fresh_copy = copyListToHost( fresh, test_data.num_particle, new_max );
+    for ( int p = 0; p < test_data.num_particle; ++p )
+    {
+        EXPECT_EQ( rebuilt_copy.counts( p ), fresh_copy.counts( p ) );
+        std::vector<int> rebuilt_neighbors( rebuilt_copy.counts( p ) );
+        std::vector<int> fresh_neighbors( fresh_copy.counts( p ) );
+        for ( int n = 0; n < rebuilt_copy.counts( p ); ++n )
+            rebuilt_neighbors[n] = rebuilt_copy.neighbors( p, n );
+        for ( int n = 0; n < fresh_copy.counts( p ); ++n )
+            fresh_neighbors[n] = fresh_copy.neighbors( p, n );
+        std::sort( rebuilt_neighbors.begin(), rebuilt_neighbors.end() );
+        std::sort( fresh_neighbors.begin(), fresh_neighbors.end() );
+        EXPECT_EQ( rebuilt_neighbors, fresh_neighbors );
+    }
+}
+
 //---------------------------------------------------------------------------//
 template <class LayoutTag, class BuildTag>
 void testVerletListHalf()
@@ -219,6 +376,966 @@ void testVerletListFullPartialRange()
                                        test_data.num_ignore );
 }
 
+//---------------------------------------------------------------------------//
+template <class LayoutTag, class BuildTag>
+void testVerletListSkin()
+{
+    // Create the AoSoA and fill with random particle positions.
+    NeighborListTestData test_data;
+    auto position = Cabana::slice<0>( test_data.aosoa );
+    double skin = 0.5;
+
+    // A list that was never built can not be updated.
+    Cabana::VerletList<TEST_MEMSPACE, Cabana::FullNeighborTag, LayoutTag,
+                       BuildTag>
+        nlist_empty;
+    EXPECT_THROW( nlist_empty.updateIfNeeded( position, skin ),
+                  std::runtime_error );
+
+    // Create the neighbor list.
+    Cabana::VerletList<TEST_MEMSPACE, Cabana::FullNeighborTag, LayoutTag,
+                       BuildTag>
+        nlist( position, 0, position.size(), test_data.test_radius,
+               test_data.cell_size_ratio, test_data.grid_min,
+               test_data.grid_max );
+
+    // The first update rebuilds to keep the reference positions.
+    EXPECT_TRUE( nlist.updateIfNeeded( position, skin ) );
+
+    // No particles moved.
+    EXPECT_FALSE( nlist.updateIfNeeded( position, skin ) );
+
+    // Move a particle less than half the skin.
+    auto small_move_func = KOKKOS_LAMBDA( const int p )
+    {
+        position( p, 0 ) += 0.1;
+    };
+    Kokkos::parallel_for( "small_move",
+                          Kokkos::RangePolicy<TEST_EXECSPACE>( 0, 1 ),
+                          small_move_func );
+    Kokkos::fence();
+    EXPECT_FALSE( nlist.updateIfNeeded( TEST_EXECSPACE{}, position, skin ) );
+
+    // Move the particle further than half the skin from where it was when the
+    // list was built, staying inside the grid.
+    auto large_move_func = KOKKOS_LAMBDA( const int p )
+    {
+        position( p, 0 ) += ( position( p, 0 ) > 0.0 ) ? -1.0 : 1.0;
+    };
+    Kokkos::parallel_for( "large_move",
+                          Kokkos::RangePolicy<TEST_EXECSPACE>( 0, 1 ),
+                          large_move_func );
+    Kokkos::fence();
+    EXPECT_TRUE( nlist.updateIfNeeded( position, skin ) );
+
+    // The rebuilt list matches the new positions.
+    auto N2_list = computeFullNeighborList( position, test_data.test_radius );
+    auto N2_list_copy = createTestListHostCopy( N2_list );
+    checkFullNeighborList( nlist, N2_list_copy, test_data.num_particle );
+
+    // The reference positions were reset by the rebuild.
+    EXPECT_FALSE( nlist.updateIfNeeded( position, skin ) );
+}
+
+//---------------------------------------------------------------------------//
+template <class LayoutTag, class BuildTag>
+void testVerletListSkinResize()
+{
+    // Create the AoSoA and fill with random particle positions. Keep a copy
+    // to grow the particles back.
+    NeighborListTestData test_data;
+    Cabana::AoSoA<Cabana::MemberTypes<double[3]>, TEST_MEMSPACE> original(
+        "original", test_data.num_particle );
+    Cabana::deep_copy( original, test_data.aosoa );
+    auto position = Cabana::slice<0>( test_data.aosoa );
+    double skin = 0.5;
+
+    // Create the neighbor list.
+    Cabana::VerletList<TEST_MEMSPACE, Cabana::FullNeighborTag, LayoutTag,
+                       BuildTag>
+        nlist( position, 0, position.size(), test_data.test_radius,
+               test_data.cell_size_ratio, test_data.grid_min,
+               test_data.grid_max );
+
+    // Shrink the particles. The particle range is needed for the update.
+    int num_shrunk = test_data.num_particle / 2;
+    test_data.aosoa.resize( num_shrunk );
+    position = Cabana::slice<0>( test_data.aosoa );
+    EXPECT_THROW( nlist.updateIfNeeded( position, skin ),
+                  std::runtime_error );
+    EXPECT_THROW( nlist.updateIfNeeded( position, 0, num_shrunk + 1, skin ),
+                  std::runtime_error );
+    EXPECT_TRUE( nlist.updateIfNeeded( position, 0, num_shrunk, skin ) );
+    {
+        auto N2_list =
+            computeFullNeighborList( position, test_data.test_radius );
+        auto N2_list_copy = createTestListHostCopy( N2_list );
+        checkFullNeighborList( nlist, N2_list_copy, num_shrunk );
+    }
+    EXPECT_FALSE( nlist.updateIfNeeded( position, skin ) );
+
+    // Grow the particles back such that the appended particles get
+    // neighbors.
+    test_data.aosoa.resize( test_data.num_particle );
+    Cabana::deep_copy( test_data.aosoa, original );
+    position = Cabana::slice<0>( test_data.aosoa );
+    EXPECT_TRUE( nlist.updateIfNeeded( TEST_EXECSPACE{}, position, 0,
+                                       position.size(), skin ) );
+    checkFullNeighborList( nlist, test_data.N2_list_copy,
+                           test_data.num_particle );
+    EXPECT_FALSE( nlist.updateIfNeeded( position, 0, position.size(), skin ) );
+}
+
+//---------------------------------------------------------------------------//
+void testVerletListCompressedFar()
+{
+    // Create particles along a line spaced further apart than the radius such
+    // that only the first and last particle neighbor each other. Their index
+    // difference is outside of the 16-bit window.
+    int num_particle = 40000;
+    double radius = 0.5;
+    Cabana::AoSoA<Cabana::MemberTypes<double[3]>, TEST_MEMSPACE> aosoa(
+        "aosoa", num_particle );
+    auto position = Cabana::slice<0>( aosoa );
+    auto init_func = KOKKOS_LAMBDA( const int p )
+    {
+        position( p, 0 ) = ( p == num_particle - 1 ) ? 0.25 : p + 0.5;
+        position( p, 1 ) = 0.5;
+        position( p, 2 ) = 0.5;
+    };
+    Kokkos::RangePolicy<TEST_EXECSPACE> policy( 0, num_particle );
+    Kokkos::parallel_for( "init_positions", policy, init_func );
+    Kokkos::fence();
+
+    double grid_min[3] = { 0.0, 0.0, 0.0 };
+    double grid_max[3] = { static_cast<double>( num_particle ), 1.0, 1.0 };
+    Cabana::VerletList<TEST_MEMSPACE, Cabana::FullNeighborTag,
+                       Cabana::VerletLayoutCompressed>
+        nlist( position, 0, num_particle, radius, 1.0, grid_min, grid_max );
+
+    auto list_copy = copyListToHost( nlist, num_particle, 1 );
+    for ( int p = 0; p < num_particle; ++p )
+    {
+        if ( p == 0 )
+        {
+            EXPECT_EQ( list_copy.counts( p ), 1 );
+            EXPECT_EQ( list_copy.neighbors( p, 0 ), num_particle - 1 );
+        }
+        else if ( p == num_particle - 1 )
+        {
+            EXPECT_EQ( list_copy.counts( p ), 1 );
+            EXPECT_EQ( list_copy.neighbors( p, 0 ), 0 );
+        }
+        else
+        {
+            EXPECT_EQ( list_copy.counts( p ), 0 );
+        }
+    }
+    EXPECT_EQ( nlist._data.far_neighbors.extent( 0 ), 2 );
+}
+
+//---------------------------------------------------------------------------//
+template <std::size_t ClusterSize>
+void testVerletListCluster()
+{
+    // Create the AoSoA and fill with random particle positions.
+    NeighborListTestData test_data;
+    auto position = Cabana::slice<0>( test_data.aosoa );
+
+    // Create a full cluster-pair list and check the neighbor parallel
+    // iteration against the N^2 list.
+    using layout_type = Cabana::VerletLayoutCluster<ClusterSize>;
+    Cabana::VerletList<TEST_MEMSPACE, Cabana::FullNeighborTag, layout_type>
+        full_list( position, 0, position.size(), test_data.test_radius,
+                   test_data.cell_size_ratio, test_data.grid_min,
+                   test_data.grid_max );
+    checkFirstNeighborParallelForLambda( full_list, test_data.N2_list_copy,
+                                         test_data.num_particle );
+
+    // Create a half cluster-pair list. Adding each pair in both directions
+    // recovers the full list result.
+    Cabana::VerletList<TEST_MEMSPACE, Cabana::HalfNeighborTag, layout_type>
+        half_list( position, 0, position.size(), test_data.test_radius,
+                   test_data.cell_size_ratio, test_data.grid_min,
+                   test_data.grid_max );
+    Kokkos::View<int*, TEST_MEMSPACE> serial_result( "serial_result",
+                                                     test_data.num_particle );
+    Kokkos::View<int*, TEST_MEMSPACE> team_result( "team_result",
+                                                   test_data.num_particle );
+    auto serial_op = KOKKOS_LAMBDA( const int i, const int n )
+    {
+        Kokkos::atomic_add( &serial_result( i ), n );
+        Kokkos::atomic_add( &serial_result( n ), i );
+    };
+    auto team_op = KOKKOS_LAMBDA( const int i, const int n )
+    {
+        Kokkos::atomic_add( &team_result( i ), n );
+        Kokkos::atomic_add( &team_result( n ), i );
+    };
+    Kokkos::RangePolicy<TEST_EXECSPACE> policy( 0, test_data.num_particle );
+    Cabana::neighbor_parallel_for( policy, serial_op, half_list,
+                                   Cabana::FirstNeighborsTag(),
+                                   Cabana::SerialOpTag() );
+    Cabana::neighbor_parallel_for( policy, team_op, half_list,
+                                   Cabana::FirstNeighborsTag(),
+                                   Cabana::TeamOpTag() );
+    Kokkos::fence();
+    checkFirstNeighborParallelFor( test_data.N2_list_copy, serial_result,
+                                   team_result, 1 );
+}
+
+//---------------------------------------------------------------------------//
+template <class LayoutTag>
+void testColoredNeighborParallelFor()
+{
+    // Create the AoSoA and fill with random particle positions.
+    NeighborListTestData test_data;
+    auto position = Cabana::slice<0>( test_data.aosoa );
+
+    // Create the half neighbor list.
+    using ListType = Cabana::VerletList<TEST_MEMSPACE, Cabana::HalfNeighborTag,
+                                        LayoutTag, Cabana::TeamOpTag>;
+    ListType nlist( position, 0, position.size(), test_data.test_radius,
+                    test_data.cell_size_ratio, test_data.grid_min,
+                    test_data.grid_max );
+
+    // Bin the particles.
+    double grid_size = test_data.cell_size_ratio * test_data.test_radius;
+    double grid_delta[3] = { grid_size, grid_size, grid_size };
+    Cabana::LinkedCellList<TEST_MEMSPACE> cells(
+        position, grid_delta, test_data.grid_min, test_data.grid_max );
+
+    // Add each pair in both directions without atomics. This recovers the
+    // full list result.
+    Kokkos::View<int*, TEST_MEMSPACE> result( "result",
+                                              test_data.num_particle );
+    auto sum_op = KOKKOS_LAMBDA( const int i, const int n )
+    {
+        result( i ) += n;
+        result( n ) += i;
+    };
+    Kokkos::RangePolicy<TEST_EXECSPACE> policy( TEST_EXECSPACE(), 0,
+                                                test_data.num_particle );
+    Cabana::neighbor_parallel_for( policy, sum_op, nlist, cells,
+                                   test_data.test_radius,
+                                   Cabana::FirstNeighborsTag(),
+                                   Cabana::SerialOpTag(), "test_1st_colored" );
+    Kokkos::fence();
+
+    checkFirstNeighborParallelFor( test_data.N2_list_copy, result, result, 1 );
+
+    // A periodic list is only colored if the color stride divides the number
+    // of cells in each periodic dimension.
+    nlist.setPeriodic( { true, false, false } );
+    nlist.build( position, 0, position.size(), test_data.test_radius,
+                 test_data.cell_size_ratio, test_data.grid_min,
+                 test_data.grid_max );
+    int stride =
+        2 * std::ceil( test_data.test_radius / cells.binWidth( 0 ) ) + 1;
+    if ( 0 != cells.numBin( 0 ) % stride )
+        EXPECT_THROW( Cabana::neighbor_parallel_for(
+                          policy, sum_op, nlist, cells, test_data.test_radius,
+                          Cabana::FirstNeighborsTag(), Cabana::SerialOpTag() ),
+                      std::runtime_error );
+}
+
+//---------------------------------------------------------------------------//
+void testPeriodicVerletList()
+{
+    // Create the AoSoA and fill with random particle positions.
+    NeighborListTestData test_data;
+    auto position = Cabana::slice<0>( test_data.aosoa );
+    int num_particle = test_data.num_particle;
+
+    // Build full and half lists with the grid periodic in all dimensions.
+    std::array<bool, 3> periodic = { true, true, true };
+    Cabana::VerletList<TEST_MEMSPACE, Cabana::FullNeighborTag,
+                       Cabana::VerletLayoutCSR, Cabana::TeamOpTag>
+        full_list;
+    full_list.setPeriodic( periodic );
+    full_list.build( position, 0, position.size(), test_data.test_radius,
+                     test_data.cell_size_ratio, test_data.grid_min,
+                     test_data.grid_max );
+    Cabana::VerletList<TEST_MEMSPACE, Cabana::HalfNeighborTag,
+                       Cabana::VerletLayout2D, Cabana::TeamOpTag>
+        half_list;
+    half_list.setPeriodic( periodic );
+    half_list.build( position, 0, position.size(), test_data.test_radius,
+                     test_data.cell_size_ratio, test_data.grid_min,
+                     test_data.grid_max );
+
+    // Compute the minimum image neighbors with a brute force search.
+    auto mirror = Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                       test_data.aosoa );
+    auto x = Cabana::slice<0>( mirror );
+    double length = test_data.box_max - test_data.box_min;
+    double rsqr = test_data.test_radius * test_data.test_radius;
+    std::vector<std::vector<int>> expected( num_particle );
+    int max_n = 0;
+    for ( int i = 0; i < num_particle; ++i )
+    {
+        for ( int j = 0; j < num_particle; ++j )
+        {
+            double dsqr = 0.0;
+            for ( int d = 0; d < 3; ++d )
+            {
+                double dx = x( i, d ) - x( j, d );
+                dx -= length * std::round( dx / length );
+                dsqr += dx * dx;
+            }
+            if ( i != j && dsqr <= rsqr )
+                expected[i].push_back( j );
+        }
+        max_n = std::max( max_n, static_cast<int>( expected[i].size() ) );
+    }
+
+    // Check the full list.
+    auto full_copy = copyListToHost( full_list, num_particle, max_n );
+    for ( int i = 0; i < num_particle; ++i )
+    {
+        EXPECT_EQ( full_copy.counts( i ),
+                   static_cast<int>( expected[i].size() ) );
+        std::vector<int> found;
+        for ( int n = 0; n < full_copy.counts( i ); ++n )
+            found.push_back( full_copy.neighbors( i, n ) );
+        std::sort( found.begin(), found.end() );
+        EXPECT_EQ( found, expected[i] );
+    }
+
+    // Every pair should appear exactly once in the half list.
+    auto half_copy = copyListToHost( half_list, num_particle, max_n );
+    std::vector<int> pair_count( num_particle * num_particle, 0 );
+    for ( int i = 0; i < num_particle; ++i )
+        for ( int n = 0; n < half_copy.counts( i ); ++n )
+        {
+            int j = half_copy.neighbors( i, n );
+            ++pair_count[std::min( i, j ) * num_particle + std::max( i, j )];
+        }
+    for ( int i = 0; i < num_particle; ++i )
+        for ( int j : expected[i] )
+            if ( i < j )
+                EXPECT_EQ( pair_count[i * num_particle + j], 1 );
+}
+
+//---------------------------------------------------------------------------//
+void testVariableRadiusVerletList()
+{
+    // Create the AoSoA and fill with random particle positions.
+    NeighborListTestData test_data;
+    auto position = Cabana::slice<0>( test_data.aosoa );
+    int num_particle = test_data.num_particle;
+
+    // Give every third particle the full radius and the others half of it.
+    double test_radius = test_data.test_radius;
+    Cabana::AoSoA<Cabana::MemberTypes<double>, TEST_MEMSPACE> radius_aosoa(
+        "radii", num_particle );
+    auto radii = Cabana::slice<0>( radius_aosoa );
+    Kokkos::parallel_for(
+        "radii", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_particle ),
+        KOKKOS_LAMBDA( const int p ) {
+            radii( p ) = ( p % 3 == 0 ) ? test_radius : 0.5 * test_radius;
+        } );
+    Kokkos::fence();
+
+    Cabana::VerletList<TEST_MEMSPACE, Cabana::FullNeighborTag,
+                       Cabana::VerletLayoutCSR, Cabana::TeamOpTag>
+        csr_list( position, radii, 0, position.size(),
+                  test_data.cell_size_ratio, test_data.grid_min,
+                  test_data.grid_max );
+    Cabana::VerletList<TEST_MEMSPACE, Cabana::FullNeighborTag,
+                       Cabana::VerletLayout2D, Cabana::TeamVectorOpTag>
+        list_2d( position, radii, 0, position.size(),
+                 test_data.cell_size_ratio, test_data.grid_min,
+                 test_data.grid_max );
+
+    // Compute the neighbors within each particle's own radius with a brute
+    // force search.
+    auto mirror = Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                       test_data.aosoa );
+    auto x = Cabana::slice<0>( mirror );
+    std::vector<std::vector<int>> expected( num_particle );
+    int max_n = 0;
+    for ( int i = 0; i < num_particle; ++i )
+    {
+        double r = ( i % 3 == 0 ) ? test_radius : 0.5 * test_radius;
+        for ( int j = 0; j < num_particle; ++j )
+        {
+            double dsqr = 0.0;
+            for ( int d = 0; d < 3; ++d )
+                dsqr += ( x( i, d ) - x( j, d ) ) * ( x( i, d ) - x( j, d ) );
+            if ( i != j && dsqr <= r * r )
+                expected[i].push_back( j );
+        }
+        max_n = std::max( max_n, static_cast<int>( expected[i].size() ) );
+    }
+
+    // Check both layouts.
+    auto csr_copy = copyListToHost( csr_list, num_particle, max_n );
+    auto copy_2d = copyListToHost( list_2d, num_particle, max_n );
+    for ( int i = 0; i < num_particle; ++i )
+    {
+        EXPECT_EQ( csr_copy.counts( i ),
+                   static_cast<int>( expected[i].size() ) );
+        EXPECT_EQ( copy_2d.counts( i ),
+                   static_cast<int>( expected[i].size() ) );
+        std::vector<int> csr_found;
+        std::vector<int> found_2d;
+        for ( int n = 0; n < csr_copy.counts( i ); ++n )
+            csr_found.push_back( csr_copy.neighbors( i, n ) );
+        for ( int n = 0; n < copy_2d.counts( i ); ++n )
+            found_2d.push_back( copy_2d.neighbors( i, n ) );
+        std::sort( csr_found.begin(), csr_found.end() );
+        std::sort( found_2d.begin(), found_2d.end() );
+        EXPECT_EQ( csr_found, expected[i] );
+        EXPECT_EQ( found_2d, expected[i] );
+    }
+}
+
+//---------------------------------------------------------------------------//
+void testMixedPrecisionVerletList()
+{
+    // Create the AoSoA and fill with random particle positions.
+    NeighborListTestData test_data;
+    auto position = Cabana::slice<0>( test_data.aosoa );
+
+    // Check a full CSR list.
+    {
+        Cabana::VerletList<TEST_MEMSPACE, Cabana::FullNeighborTag,
+                           Cabana::VerletLayoutCSR, Cabana::TeamVectorOpTag>
+            nlist;
+        nlist.setMixedPrecision( true );
+        EXPECT_TRUE( nlist.mixedPrecision() );
+        nlist.build( position, 0, position.size(), test_data.test_radius,
+                     test_data.cell_size_ratio, test_data.grid_min,
+                     test_data.grid_max );
+        checkFullNeighborList( nlist, test_data.N2_list_copy,
+                               test_data.num_particle );
+    }
+
+    // Check a half 2D list.
+    {
+        Cabana::VerletList<TEST_MEMSPACE, Cabana::HalfNeighborTag,
+                           Cabana::VerletLayout2D, Cabana::TeamOpTag>
+            nlist;
+        nlist.setMixedPrecision( true );
+        nlist.build( position, 0, position.size(), test_data.test_radius,
+                     test_data.cell_size_ratio, test_data.grid_min,
+                     test_data.grid_max );
+        checkHalfNeighborList( nlist, test_data.N2_list_copy,
+                               test_data.num_particle );
+    }
+}
+
+//---------------------------------------------------------------------------//
+void testNeighborListStats()
+{
+    // Create the AoSoA and fill with random particle positions.
+    NeighborListTestData test_data;
+    auto position = Cabana::slice<0>( test_data.aosoa );
+    int num_particle = test_data.num_particle;
+
+    // Compute the expected counts from the N^2 list.
+    std::size_t total = 0;
+    std::size_t max_n = 0;
+    for ( int p = 0; p < num_particle; ++p )
+    {
+        std::size_t n = test_data.N2_list_copy.counts( p );
+        total += n;
+        max_n = std::max( max_n, n );
+    }
+
+    // Build a 2D list with too little storage so that it is refilled.
+    Cabana::VerletList<TEST_MEMSPACE, Cabana::FullNeighborTag,
+                       Cabana::VerletLayout2D, Cabana::TeamOpTag>
+        nlist_2d( position, 0, position.size(), test_data.test_radius,
+                  test_data.cell_size_ratio, test_data.grid_min,
+                  test_data.grid_max, 1 );
+    auto stats_2d = Cabana::neighborListStats( nlist_2d );
+    EXPECT_EQ( stats_2d.num_particle, std::size_t( num_particle ) );
+    EXPECT_EQ( stats_2d.total_neighbor, total );
+    EXPECT_EQ( stats_2d.max_neighbor, max_n );
+    EXPECT_DOUBLE_EQ( stats_2d.mean_neighbor,
+                      static_cast<double>( total ) / num_particle );
+    EXPECT_GE( stats_2d.memory_bytes,
+               ( num_particle + num_particle * max_n ) * sizeof( int ) );
+    EXPECT_EQ( stats_2d.num_build, 1 );
+    EXPECT_EQ( stats_2d.num_refill, max_n > 1 ? 1 : 0 );
+
+    // Build a CSR list which is never refilled.
+    Cabana::VerletList<TEST_MEMSPACE, Cabana::FullNeighborTag,
+                       Cabana::VerletLayoutCSR, Cabana::TeamOpTag>
+        nlist_csr( position, 0, position.size(), test_data.test_radius,
+                   test_data.cell_size_ratio, test_data.grid_min,
+                   test_data.grid_max );
+    auto stats_csr = Cabana::neighborListStats( nlist_csr );
+    EXPECT_EQ( stats_csr.total_neighbor, total );
+    EXPECT_EQ( stats_csr.max_neighbor, max_n );
+    EXPECT_EQ( stats_csr.memory_bytes,
+               ( 2 * num_particle + total ) * sizeof( int ) );
+    EXPECT_EQ( stats_csr.num_refill, 0 );
+}
+
+//---------------------------------------------------------------------------//
+void testTuneCellSizeRatio()
+{
+    // Create the AoSoA and fill with random particle positions.
+    NeighborListTestData test_data;
+    auto position = Cabana::slice<0>( test_data.aosoa );
+
+    using ListType = Cabana::VerletList<TEST_MEMSPACE, Cabana::FullNeighborTag,
+                                        Cabana::VerletLayoutCSR,
+                                        Cabana::TeamOpTag>;
+    Cabana::clearCellSizeRatioCache<ListType>();
+
+    // The tuned ratio is one of the candidates.
+    std::vector<double> ratios = { 1.0, 0.5 };
+    double ratio = Cabana::tuneCellSizeRatio<ListType>(
+        position, 0, position.size(), test_data.test_radius,
+        test_data.grid_min, test_data.grid_max, ratios );
+    EXPECT_TRUE( ratio == 1.0 || ratio == 0.5 );
+
+    // The same distribution uses the cached ratio, even for other
+    // candidates.
+    double cached = Cabana::tuneCellSizeRatio<ListType>(
+        position, 0, position.size(), test_data.test_radius,
+        test_data.grid_min, test_data.grid_max, { 0.25 } );
+    EXPECT_EQ( cached, ratio );
+
+    // A grid of the same volume, and so density, but a different shape has
+    // a different key.
+    double grid_min[3] = { test_data.grid_min[0], test_data.grid_min[1],
+                           test_data.grid_min[2] };
+    double grid_max[3] = { test_data.grid_max[0], test_data.grid_max[1],
+                           test_data.grid_max[2] };
+    grid_max[0] += grid_max[0] - grid_min[0];
+    grid_max[1] -= 0.5 * ( grid_max[1] - grid_min[1] );
+    EXPECT_EQ( Cabana::Impl::cellSizeRatioDensityBucket(
+                   position.size(), test_data.test_radius, grid_min,
+                   grid_max ),
+               Cabana::Impl::cellSizeRatioDensityBucket(
+                   position.size(), test_data.test_radius,
+                   test_data.grid_min, test_data.grid_max ) );
+    EXPECT_NE( Cabana::Impl::cellSizeRatioShapeBucket( test_data.test_radius,
+                                                       grid_min, grid_max ),
+               Cabana::Impl::cellSizeRatioShapeBucket(
+                   test_data.test_radius, test_data.grid_min,
+                   test_data.grid_max ) );
+    Cabana::clearCellSizeRatioCache<ListType>();
+
+    // The list built with the tuned ratio is correct.
+    ListType nlist( position, 0, position.size(), test_data.test_radius,
+                    ratio, test_data.grid_min, test_data.grid_max );
+    checkFullNeighborList( nlist, test_data.N2_list_copy,
+                           test_data.num_particle );
+}
+
+//---------------------------------------------------------------------------//
+void testAnisotropicCells()
+{
+    // Create the AoSoA and fill with random particle positions.
+    NeighborListTestData test_data;
+    auto position = Cabana::slice<0>( test_data.aosoa );
+
+    // Build the list with cells of a different size in each dimension.
+    Cabana::VerletList<TEST_MEMSPACE, Cabana::FullNeighborTag,
+                       Cabana::VerletLayoutCSR, Cabana::TeamOpTag>
+        nlist;
+    nlist.setCellAspect( { 1.0, 2.0, 0.5 } );
+    EXPECT_EQ( nlist.cellAspect()[1], 2.0 );
+    nlist.build( position, 0, position.size(), test_data.test_radius,
+                 test_data.cell_size_ratio, test_data.grid_min,
+                 test_data.grid_max );
+    checkFullNeighborList( nlist, test_data.N2_list_copy,
+                           test_data.num_particle );
+
+    EXPECT_THROW( nlist.setCellAspect( { 1.0, 0.0, 1.0 } ),
+                  std::runtime_error );
+}
+
+//---------------------------------------------------------------------------//
+void testFlatGrid()
+{
+    // Create the AoSoA and flatten the particles onto a plane such that the
+    // grid has a zero extent in the third dimension.
+    NeighborListTestData test_data;
+    auto position = Cabana::slice<0>( test_data.aosoa );
+    Kokkos::parallel_for(
+        "flatten", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, position.size() ),
+        KOKKOS_LAMBDA( const int p ) { position( p, 2 ) = 0.0; } );
+    Kokkos::fence();
+    double grid_min[3] = { test_data.grid_min[0], test_data.grid_min[1],
+                           0.0 };
+    double grid_max[3] = { test_data.grid_max[0], test_data.grid_max[1],
+                           0.0 };
+
+    Cabana::VerletList<TEST_MEMSPACE, Cabana::FullNeighborTag,
+                       Cabana::VerletLayoutCSR, Cabana::TeamOpTag>
+        nlist( position, 0, position.size(), test_data.test_radius,
+               test_data.cell_size_ratio, grid_min, grid_max );
+
+    auto N2_list = computeFullNeighborList( position, test_data.test_radius );
+    auto N2_list_copy = createTestListHostCopy( N2_list );
+    checkFullNeighborList( nlist, N2_list_copy, test_data.num_particle );
+}
+
+//---------------------------------------------------------------------------//
+template <class AlgorithmTag>
+void testGhostRange()
+{
+    // Create the AoSoA and fill with random particle positions. The last
+    // particles are ghosts.
+    NeighborListTestData test_data;
+    auto position = Cabana::slice<0>( test_data.aosoa );
+    int num_owned = 200;
+
+    Cabana::VerletList<TEST_MEMSPACE, AlgorithmTag, Cabana::VerletLayoutCSR,
+                       Cabana::TeamOpTag>
+        nlist;
+    nlist.setGhostRange( num_owned, test_data.num_particle );
+    EXPECT_TRUE( nlist.hasGhostRange() );
+    nlist.build( position, 0, num_owned, test_data.test_radius,
+                 test_data.cell_size_ratio, test_data.grid_min,
+                 test_data.grid_max );
+    auto list_copy = copyListToHost(
+        nlist, num_owned, test_data.N2_list_copy.neighbors.extent( 1 ) );
+
+    // Owned particles have all owned and ghost neighbors. Half lists order
+    // owned pairs by index and pairs with a ghost by coordinates.
+    auto x = Cabana::slice<0>(
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                             test_data.aosoa ) );
+    bool half = std::is_same<AlgorithmTag, Cabana::HalfNeighborTag>::value;
+    for ( int p = 0; p < num_owned; ++p )
+    {
+        std::vector<int> expected;
+        for ( int n = 0; n < test_data.N2_list_copy.counts( p ); ++n )
+        {
+            int q = test_data.N2_list_copy.neighbors( p, n );
+            bool keep = true;
+            if ( half && q < num_owned )
+                keep = q > p;
+            else if ( half )
+                keep = Cabana::Impl::NeighborDiscriminator<
+                    Cabana::HalfNeighborTag>::isValid( p, x( p, 0 ), x( p, 1 ),
+                                                       x( p, 2 ), q, x( q, 0 ),
+                                                       x( q, 1 ), x( q, 2 ) );
+            if ( keep )
+                expected.push_back( q );
+        }
+        std::vector<int> computed;
+        for ( int n = 0; n < list_copy.counts( p ); ++n )
+            computed.push_back( list_copy.neighbors( p, n ) );
+        std::sort( expected.begin(), expected.end() );
+        std::sort( computed.begin(), computed.end() );
+        EXPECT_EQ( computed, expected );
+    }
+
+    // Ghosts have no neighbors for operations over all particles.
+    int num_ghost_neighbor = 0;
+    Kokkos::parallel_reduce(
+        "ghost_neighbors",
+        Kokkos::RangePolicy<TEST_EXECSPACE>( 0, test_data.num_particle ),
+        KOKKOS_LAMBDA( const int p, int& sum ) {
+            if ( p >= num_owned )
+                sum += Cabana::NeighborList<decltype( nlist )>::numNeighbor(
+                    nlist, p );
+        },
+        num_ghost_neighbor );
+    EXPECT_EQ( num_ghost_neighbor, 0 );
+
+    // The ghost range must be adjacent to the owned range.
+    nlist.setGhostRange( num_owned + 10, test_data.num_particle );
+    EXPECT_THROW( nlist.build( position, 0, num_owned, test_data.test_radius,
+                               test_data.cell_size_ratio, test_data.grid_min,
+                               test_data.grid_max ),
+                  std::runtime_error );
+}
+
+//---------------------------------------------------------------------------//
+template <class LayoutTag>
+void testHashedVerletList()
+{
+    // Create the AoSoA and fill with random particle positions.
+    NeighborListTestData test_data;
+    auto position = Cabana::slice<0>( test_data.aosoa );
+
+    // Build the lists without grid bounds.
+    Cabana::VerletList<TEST_MEMSPACE, Cabana::FullNeighborTag, LayoutTag,
+                       Cabana::TeamOpTag>
+        nlist_full( position, 0, position.size(), test_data.test_radius,
+                    test_data.cell_size_ratio );
+    checkFullNeighborList( nlist_full, test_data.N2_list_copy,
+                           test_data.num_particle );
+    Cabana::VerletList<TEST_MEMSPACE, Cabana::HalfNeighborTag, LayoutTag,
+                       Cabana::TeamVectorOpTag>
+        nlist_half( position, 0, position.size(), test_data.test_radius,
+                    test_data.cell_size_ratio, 2 );
+    checkHalfNeighborList( nlist_half, test_data.N2_list_copy,
+                           test_data.num_particle );
+
+    // Move a pair of neighbors far outside of the box and a particle 2^21
+    // cells away from another, such that their cells share a hashed bin.
+    double alias = ( 1 << 21 ) * test_data.test_radius *
+                   test_data.cell_size_ratio;
+    Kokkos::parallel_for(
+        "escape", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, 1 ),
+        KOKKOS_LAMBDA( const int ) {
+            for ( int d = 0; d < 3; ++d )
+            {
+                position( 0, d ) = 1.0e9 + 0.1 * d;
+                position( 1, d ) = 1.0e9 + 0.1 * d + 0.5;
+                position( 2, d ) = position( 3, d );
+            }
+            position( 2, 0 ) += alias;
+        } );
+    Kokkos::fence();
+    auto N2_list_copy = createTestListHostCopy(
+        computeFullNeighborList( position, test_data.test_radius ) );
+
+    nlist_full.build( TEST_EXECSPACE{}, position, 0, position.size(),
+                      test_data.test_radius, test_data.cell_size_ratio );
+    checkFullNeighborList( nlist_full, N2_list_copy, test_data.num_particle );
+    nlist_half.build( position, 0, position.size(), test_data.test_radius,
+                      test_data.cell_size_ratio );
+    checkHalfNeighborList( nlist_half, N2_list_copy, test_data.num_particle );
+
+    // Periodic grids require grid bounds.
+    nlist_full.setPeriodic( { true, false, false } );
+    EXPECT_THROW( nlist_full.build( position, 0, position.size(),
+                                    test_data.test_radius,
+                                    test_data.cell_size_ratio ),
+                  std::runtime_error );
+}
+
+//---------------------------------------------------------------------------//
+void testTiledNeighborParallelFor()
+{
+    // Create the AoSoA and fill with random particle positions.
+    NeighborListTestData test_data;
+    auto position = Cabana::slice<0>( test_data.aosoa );
+
+    // Bin and sort the particles.
+    double grid_size = test_data.cell_size_ratio * test_data.test_radius;
+    double grid_delta[3] = { grid_size, grid_size, grid_size };
+    Cabana::LinkedCellList<TEST_MEMSPACE> cells(
+        position, grid_delta, test_data.grid_min, test_data.grid_max );
+    Cabana::permute( cells, test_data.aosoa );
+
+    // Create a full N^2 neighbor list of the sorted particles to check
+    // against.
+    auto N2_list = computeFullNeighborList( position, test_data.test_radius );
+    auto N2_list_copy = createTestListHostCopy( N2_list );
+
+    // Sum the neighbor indices from the tiled positions.
+    using tile_type = Cabana::NeighborTile<decltype( position )>;
+    double rsqr = test_data.test_radius * test_data.test_radius;
+    Kokkos::View<int*, TEST_MEMSPACE> result( "result",
+                                              test_data.num_particle );
+    auto sum_op =
+        KOKKOS_LAMBDA( const int i, const int j, const tile_type& tile )
+    {
+        double dsqr = 0.0;
+        for ( int d = 0; d < 3; ++d )
+            dsqr += ( tile.access( i, d ) - tile.access( j, d ) ) *
+                    ( tile.access( i, d ) - tile.access( j, d ) );
+        if ( dsqr <= rsqr )
+            result( tile.particle( i ) ) += tile.particle( j );
+    };
+    Kokkos::RangePolicy<TEST_EXECSPACE> policy( 0, test_data.num_particle );
+    Cabana::neighbor_parallel_for( policy, sum_op, cells, test_data.test_radius,
+                                   position, Cabana::FirstNeighborsTag(),
+                                   Cabana::TiledOpTag(), "test_1st_tiled" );
+    Kokkos::fence();
+
+    checkFirstNeighborParallelFor( N2_list_copy, result, result, 1 );
+}
+
+//---------------------------------------------------------------------------//
+void testLinkedCellNeighborParallelFor()
+{
+    // Create the AoSoA and fill with random particle positions.
+    NeighborListTestData test_data;
+    auto position = Cabana::slice<0>( test_data.aosoa );
+
+    // Bin the particles without permuting them.
+    double grid_size = test_data.cell_size_ratio * test_data.test_radius;
+    double grid_delta[3] = { grid_size, grid_size, grid_size };
+    Cabana::LinkedCellList<TEST_MEMSPACE> cells(
+        position, grid_delta, test_data.grid_min, test_data.grid_max );
+
+    // Sum the neighbor indices found in the cells.
+    Kokkos::View<int*, TEST_MEMSPACE> serial_result( "serial_result",
+                                                     test_data.num_particle );
+    Kokkos::View<int*, TEST_MEMSPACE> team_result( "team_result",
+                                                   test_data.num_particle );
+    auto serial_op = KOKKOS_LAMBDA( const int i, const int j )
+    {
+        serial_result( i ) += j;
+    };
+    auto team_op = KOKKOS_LAMBDA( const int i, const int j )
+    {
+        Kokkos::atomic_add( &team_result( i ), j );
+    };
+    Kokkos::RangePolicy<TEST_EXECSPACE> policy( 0, test_data.num_particle );
+    Cabana::neighbor_parallel_for( policy, serial_op, cells,
+                                   test_data.test_radius, position,
+                                   Cabana::FirstNeighborsTag(),
+                                   Cabana::SerialOpTag(), "test_1st_cells" );
+    Cabana::neighbor_parallel_for( policy, team_op, cells,
+                                   test_data.test_radius, position,
+                                   Cabana::FirstNeighborsTag(),
+                                   Cabana::TeamOpTag(), "test_1st_cells_team" );
+    Kokkos::fence();
+
+    checkFirstNeighborParallelFor( test_data.N2_list_copy, serial_result,
+                                   team_result, 1 );
+}
+
+//---------------------------------------------------------------------------//
+void testCachedTripletParallelFor()
+{
+    // Create the AoSoA and fill with random particle positions.
+    NeighborListTestData test_data;
+    auto position = Cabana::slice<0>( test_data.aosoa );
+
+    // Create the neighbor list.
+    using ListType =
+        Cabana::VerletList<TEST_MEMSPACE, Cabana::FullNeighborTag,
+                           Cabana::VerletLayout2D, Cabana::TeamOpTag>;
+    ListType nlist( position, 0, position.size(), test_data.test_radius,
+                    test_data.cell_size_ratio, test_data.grid_min,
+                    test_data.grid_max );
+
+    // Sum the neighbor indices of each triplet and count the cached
+    // geometry which does not match the positions.
+    using cache_type = Cabana::NeighborPairCache<decltype( position )>;
+    Kokkos::View<int*, TEST_MEMSPACE> result( "result",
+                                              test_data.num_particle );
+    Kokkos::View<int, TEST_MEMSPACE> num_bad( "num_bad" );
+    auto triplet_op = KOKKOS_LAMBDA( const int i, const int j, const int k,
+                                     const cache_type& cache )
+    {
+        const int pair[2] = { j, k };
+        for ( int p = 0; p < 2; ++p )
+        {
+            const int n = pair[p];
+            double rsqr = 0.0;
+            for ( int d = 0; d < 3; ++d )
+            {
+                double dx =
+                    position( cache.neighbor( n ), d ) - position( i, d );
+                double error = dx - cache.displacement( n, d );
+                if ( error * error > 1e-20 )
+                    Kokkos::atomic_increment( &num_bad() );
+                rsqr += dx * dx;
+            }
+            double error = rsqr - cache.distance( n ) * cache.distance( n );
+            if ( error * error > 1e-20 )
+                Kokkos::atomic_increment( &num_bad() );
+            Kokkos::atomic_add( &result( i ), cache.neighbor( n ) );
+        }
+    };
+    Kokkos::RangePolicy<TEST_EXECSPACE> policy( 0, test_data.num_particle );
+    Cabana::neighbor_parallel_for( policy, triplet_op, nlist, position,
+                                   Cabana::SecondNeighborsTag(),
+                                   Cabana::TeamVectorOpTag(), "test_cached" );
+    Kokkos::fence();
+
+    checkSecondNeighborParallelFor( test_data.N2_list_copy, result, result,
+                                    result, 1 );
+    auto num_bad_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), num_bad );
+    EXPECT_EQ( num_bad_host(), 0 );
+}
+
+//---------------------------------------------------------------------------//
+void testNeighborFilter()
+{
+    // Create the AoSoA and fill with random particle positions.
+    NeighborListTestData test_data;
+    auto position = Cabana::slice<0>( test_data.aosoa );
+
+    // Create the neighbor list.
+    using ListType =
+        Cabana::VerletList<TEST_MEMSPACE, Cabana::FullNeighborTag,
+                           Cabana::VerletLayout2D, Cabana::TeamOpTag>;
+    ListType nlist( position, 0, position.size(), test_data.test_radius,
+                    test_data.cell_size_ratio, test_data.grid_min,
+                    test_data.grid_max );
+
+    // Keep the pairs within a shorter cutoff.
+    double short_radius = 0.6 * test_data.test_radius;
+    double rsqr = short_radius * short_radius;
+    auto pred = KOKKOS_LAMBDA( const int i, const int j )
+    {
+        double dsqr = 0.0;
+        for ( int d = 0; d < 3; ++d )
+            dsqr += ( position( i, d ) - position( j, d ) ) *
+                    ( position( i, d ) - position( j, d ) );
+        return dsqr <= rsqr;
+    };
+    Kokkos::RangePolicy<TEST_EXECSPACE> policy( 0, test_data.num_particle );
+    auto filtered = Cabana::neighbor_filter( policy, nlist, pred );
+
+    // Check against a full N^2 list with the shorter cutoff.
+    auto N2_list = computeFullNeighborList( position, short_radius );
+    auto N2_list_copy = createTestListHostCopy( N2_list );
+    checkFullNeighborList( filtered, N2_list_copy, test_data.num_particle );
+}
+
+//---------------------------------------------------------------------------//
+#if KOKKOS_VERSION >= 30300
+void testGraphNeighborParallelFor()
+{
+    // Create the AoSoA and fill with random particle positions.
+    NeighborListTestData test_data;
+    auto position = Cabana::slice<0>( test_data.aosoa );
+
+    // Create the neighbor list.
+    using ListType =
+        Cabana::VerletList<TEST_MEMSPACE, Cabana::FullNeighborTag,
+                           Cabana::VerletLayout2D, Cabana::TeamOpTag>;
+    ListType nlist( position, 0, position.size(), test_data.test_radius,
+                    test_data.cell_size_ratio, test_data.grid_min,
+                    test_data.grid_max );
+
+    // Record first and second neighbor kernels in a graph.
+    int num_particle = test_data.num_particle;
+    Kokkos::View<int*, TEST_MEMSPACE> first_result( "first_result",
+                                                    num_particle );
+    Kokkos::View<int*, TEST_MEMSPACE> second_result( "second_result",
+                                                     num_particle );
+    auto first_op = KOKKOS_LAMBDA( const int i, const int n )
+    {
+        first_result( i ) += n;
+    };
+    auto second_op = KOKKOS_LAMBDA( const int i, const int j, const int k )
+    {
+        second_result( i ) += j + k;
+    };
+    Kokkos::RangePolicy<TEST_EXECSPACE> policy( 0, num_particle );
+    auto graph = Kokkos::Experimental::create_graph(
+        TEST_EXECSPACE(), [&]( const auto& root ) {
+            auto first = Cabana::Experimental::then_neighbor_parallel_for(
+                root, policy, first_op, nlist, Cabana::FirstNeighborsTag(),
+                Cabana::SerialOpTag(), "test_graph_1st" );
+            Cabana::Experimental::then_neighbor_parallel_for(
+                first, policy, second_op, nlist, Cabana::SecondNeighborsTag(),
+                Cabana::SerialOpTag(), "test_graph_2nd" );
+        } );
+
+    // Replay the graph twice.
+    graph.submit();
+    graph.submit();
+    Kokkos::fence();
+
+    checkFirstNeighborParallelFor( test_data.N2_list_copy, first_result,
+                                   first_result, 2 );
+    checkSecondNeighborParallelFor( test_data.N2_list_copy, second_result,
+                                    second_result, second_result, 2 );
+}
+#endif
+
 //---------------------------------------------------------------------------//
 template <class LayoutTag>
 void testNeighborParallelFor()
@@ -240,6 +1357,9 @@ void testNeighborParallelFor()
     checkSecondNeighborParallelForLambda( nlist, test_data.N2_list_copy,
                                           test_data.num_particle );
 
+    checkFusedFirstNeighborParallelFor( nlist, test_data.N2_list_copy,
+                                        test_data.num_particle );
+
     checkSplitFirstNeighborParallelFor( nlist, test_data.N2_list_copy,
                                         test_data.num_particle );
 
@@ -305,6 +1425,13 @@ TEST( TEST_CATEGORY, verlet_list_full_test )
     testVerletListFull<Cabana::VerletLayout2D, Cabana::TeamVectorOpTag>();
 }
 
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, verlet_list_2d_rebuild_growth_test )
+{
+    testVerletList2DRebuildGrowth<Cabana::TeamOpTag>();
+    testVerletList2DRebuildGrowth<Cabana::TeamVectorOpTag>();
+}
+
 //---------------------------------------------------------------------------//
 TEST( TEST_CATEGORY, verlet_list_half_test )
 {
@@ -336,6 +1463,42 @@ TEST( TEST_CATEGORY, verlet_list_full_range_test )
                                    Cabana::TeamVectorOpTag>();
 }
 
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, verlet_list_skin_test )
+{
+#ifndef KOKKOS_ENABLE_OPENMPTARGET // FIXME_OPENMPTARGET
+    testVerletListSkin<Cabana::VerletLayoutCSR, Cabana::TeamOpTag>();
+#endif
+    testVerletListSkin<Cabana::VerletLayout2D, Cabana::TeamOpTag>();
+}
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, verlet_list_skin_resize_test )
+{
+#ifndef KOKKOS_ENABLE_OPENMPTARGET // FIXME_OPENMPTARGET
+    testVerletListSkinResize<Cabana::VerletLayoutCSR, Cabana::TeamOpTag>();
+#endif
+    testVerletListSkinResize<Cabana::VerletLayout2D, Cabana::TeamOpTag>();
+}
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, verlet_list_compressed_test )
+{
+#ifndef KOKKOS_ENABLE_OPENMPTARGET // FIXME_OPENMPTARGET
+    testVerletListFull<Cabana::VerletLayoutCompressed, Cabana::TeamOpTag>();
+    testVerletListHalf<Cabana::VerletLayoutCompressed, Cabana::TeamOpTag>();
+    testNeighborParallelFor<Cabana::VerletLayoutCompressed>();
+    testVerletListCompressedFar();
+#endif
+}
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, verlet_list_cluster_test )
+{
+    testVerletListCluster<4>();
+    testVerletListCluster<8>();
+}
+
 //---------------------------------------------------------------------------//
 TEST( TEST_CATEGORY, parallel_for_test )
 {
@@ -345,6 +1508,85 @@ TEST( TEST_CATEGORY, parallel_for_test )
     testNeighborParallelFor<Cabana::VerletLayout2D>();
 }
 
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, colored_parallel_for_test )
+{
+#ifndef KOKKOS_ENABLE_OPENMPTARGET // FIXME_OPENMPTARGET
+    testColoredNeighborParallelFor<Cabana::VerletLayoutCSR>();
+#endif
+    testColoredNeighborParallelFor<Cabana::VerletLayout2D>();
+}
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, periodic_verlet_list_test ) { testPeriodicVerletList(); }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, variable_radius_verlet_list_test )
+{
+    testVariableRadiusVerletList();
+}
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, mixed_precision_verlet_list_test )
+{
+    testMixedPrecisionVerletList();
+}
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, neighbor_list_stats_test ) { testNeighborListStats(); }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, tune_cell_size_ratio_test ) { testTuneCellSizeRatio(); }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, anisotropic_cells_test ) { testAnisotropicCells(); }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, flat_grid_test ) { testFlatGrid(); }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, ghost_range_test )
+{
+    testGhostRange<Cabana::FullNeighborTag>();
+    testGhostRange<Cabana::HalfNeighborTag>();
+}
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, hashed_verlet_list_test )
+{
+    testHashedVerletList<Cabana::VerletLayoutCSR>();
+    testHashedVerletList<Cabana::VerletLayout2D>();
+}
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, tiled_parallel_for_test )
+{
+    testTiledNeighborParallelFor();
+}
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, linked_cell_parallel_for_test )
+{
+    testLinkedCellNeighborParallelFor();
+}
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, cached_triplet_parallel_for_test )
+{
+    testCachedTripletParallelFor();
+}
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, neighbor_filter_test ) { testNeighborFilter(); }
+
+//---------------------------------------------------------------------------//
+#if KOKKOS_VERSION >= 30300
+TEST( TEST_CATEGORY, graph_parallel_for_test )
+{
+    testGraphNeighborParallelFor();
+}
+#endif
+
 //---------------------------------------------------------------------------//
 TEST( TEST_CATEGORY, parallel_reduce_test )
 {
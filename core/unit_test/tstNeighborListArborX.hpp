@@ -10,9 +10,11 @@
  ****************************************************************************/
 
 #include <Cabana_AoSoA.hpp>
+#include <Cabana_DeepCopy.hpp>
 #include <Cabana_Experimental_NeighborList.hpp>
 #include <Cabana_NeighborList.hpp>
 #include <Cabana_Parallel.hpp>
+#include <Cabana_VerletList.hpp>
 
 #include <Kokkos_Core.hpp>
 
@@ -20,6 +22,11 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
 namespace Test
 {
 //---------------------------------------------------------------------------//
@@ -187,6 +194,324 @@ void testArborXListFullPartialRange()
     }
 }
 
+//---------------------------------------------------------------------------//
+void testArborXListVariableRadius()
+{
+    // Create the AoSoA and fill with random particle positions.
+    NeighborListTestData test_data;
+    auto position = Cabana::slice<0>( test_data.aosoa );
+    int num_particle = test_data.num_particle;
+
+    using device_type = TEST_MEMSPACE; // sigh...
+
+    // Give every third particle the full radius and the others half of it.
+    double test_radius = test_data.test_radius;
+    Cabana::AoSoA<Cabana::MemberTypes<double>, TEST_MEMSPACE> radius_aosoa(
+        "radii", num_particle );
+    auto radii = Cabana::slice<0>( radius_aosoa );
+    Kokkos::parallel_for(
+        "radii", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_particle ),
+        KOKKOS_LAMBDA( const int p ) {
+            radii( p ) = ( p % 3 == 0 ) ? test_radius : 0.5 * test_radius;
+        } );
+    Kokkos::fence();
+
+    // Check against the Verlet list with the same radii.
+    Cabana::VerletList<TEST_MEMSPACE, Cabana::FullNeighborTag,
+                       Cabana::VerletLayout2D, Cabana::TeamOpTag>
+        verlet_list( position, radii, 0, position.size(),
+                     test_data.cell_size_ratio, test_data.grid_min,
+                     test_data.grid_max );
+    int max_n = 64;
+    auto expected = copyListToHost( verlet_list, num_particle, max_n );
+
+    auto const crs_list = Cabana::Experimental::makeNeighborList<device_type>(
+        Cabana::FullNeighborTag{}, position, 0, position.size(), radii );
+    auto const dense_list =
+        Cabana::Experimental::make2DNeighborList<device_type>(
+            Cabana::FullNeighborTag{}, position, 0, position.size(), radii );
+    auto crs_copy = copyListToHost( crs_list, num_particle, max_n );
+    auto dense_copy = copyListToHost( dense_list, num_particle, max_n );
+    for ( int i = 0; i < num_particle; ++i )
+    {
+        EXPECT_EQ( crs_copy.counts( i ), expected.counts( i ) );
+        EXPECT_EQ( dense_copy.counts( i ), expected.counts( i ) );
+        std::vector<int> expected_found;
+        std::vector<int> crs_found;
+        std::vector<int> dense_found;
+        for ( int n = 0; n < expected.counts( i ); ++n )
+            expected_found.push_back( expected.neighbors( i, n ) );
+        for ( int n = 0; n < crs_copy.counts( i ); ++n )
+            crs_found.push_back( crs_copy.neighbors( i, n ) );
+        for ( int n = 0; n < dense_copy.counts( i ); ++n )
+            dense_found.push_back( dense_copy.neighbors( i, n ) );
+        std::sort( expected_found.begin(), expected_found.end() );
+        std::sort( crs_found.begin(), crs_found.end() );
+        std::sort( dense_found.begin(), dense_found.end() );
+        EXPECT_EQ( crs_found, expected_found );
+        EXPECT_EQ( dense_found, expected_found );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Translate all particles such that the neighbors do not change.
+template <class SliceType>
+void translatePositions( SliceType position, const double shift )
+{
+    Kokkos::parallel_for(
+        "translate", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, position.size() ),
+        KOKKOS_LAMBDA( const int p ) {
+            for ( int d = 0; d < 3; ++d )
+                position( p, d ) += shift;
+        } );
+    Kokkos::fence();
+}
+
+//---------------------------------------------------------------------------//
+void testArborXPersistentList()
+{
+    // Create the AoSoA and fill with random particle positions.
+    NeighborListTestData test_data;
+    auto position = Cabana::slice<0>( test_data.aosoa );
+
+    using device_type = TEST_MEMSPACE; // sigh...
+
+    double skin = 0.1 * test_data.test_radius;
+    Cabana::Experimental::PersistentNeighborList<device_type,
+                                                 Cabana::FullNeighborTag>
+        nlist( Cabana::FullNeighborTag{}, test_data.test_radius, skin, 0, 2 );
+
+    // The first update builds the tree.
+    EXPECT_TRUE( nlist.update( position, 0, position.size() ) );
+    checkFullNeighborList( nlist.list(), test_data.N2_list_copy,
+                           test_data.num_particle );
+
+    // Small displacements reuse the tree.
+    translatePositions( position, 0.25 * skin );
+    EXPECT_FALSE( nlist.update( position, 0, position.size() ) );
+    checkFullNeighborList( nlist.list(), test_data.N2_list_copy,
+                           test_data.num_particle );
+    translatePositions( position, 0.25 * skin );
+    EXPECT_FALSE( nlist.update( position, 0, position.size() ) );
+    checkFullNeighborList( nlist.list(), test_data.N2_list_copy,
+                           test_data.num_particle );
+    EXPECT_EQ( nlist.numBuild(), 1 );
+
+    // Exceeding the skin rebuilds the tree.
+    translatePositions( position, skin );
+    EXPECT_TRUE( nlist.update( position, 0, position.size() ) );
+    checkFullNeighborList( nlist.list(), test_data.N2_list_copy,
+                           test_data.num_particle );
+    EXPECT_EQ( nlist.numBuild(), 2 );
+
+    // Check the half list with a rebuild interval.
+    Cabana::Experimental::PersistentNeighborList<device_type,
+                                                 Cabana::HalfNeighborTag>
+        half_list( Cabana::HalfNeighborTag{}, test_data.test_radius, skin, 1 );
+    EXPECT_TRUE( half_list.update( position, 0, position.size() ) );
+    EXPECT_FALSE( half_list.update( position, 0, position.size() ) );
+    EXPECT_TRUE( half_list.update( position, 0, position.size() ) );
+    checkHalfNeighborList( half_list.list(), test_data.N2_list_copy,
+                           test_data.num_particle );
+
+    // Check the statistics against the full list.
+    std::size_t total = 0;
+    for ( int p = 0; p < test_data.num_particle; ++p )
+        total += test_data.N2_list_copy.counts( p );
+    auto stats = Cabana::Experimental::neighborListStats( nlist );
+    EXPECT_EQ( stats.num_particle, std::size_t( test_data.num_particle ) );
+    EXPECT_EQ( stats.total_neighbor, total );
+    EXPECT_EQ( stats.num_build, 2 );
+    EXPECT_GT( stats.memory_bytes, std::size_t( 0 ) );
+    auto half_stats = Cabana::Experimental::neighborListStats( half_list );
+    EXPECT_EQ( 2 * half_stats.total_neighbor, total );
+}
+
+//---------------------------------------------------------------------------//
+// Check a contact list against the contacts of every particle.
+template <class ListType>
+void checkContactList( const ListType& list,
+                       const std::vector<std::vector<int>>& contacts,
+                       const int max_n, const bool half )
+{
+    int num_particle = contacts.size();
+    auto list_copy = copyListToHost( list, num_particle, max_n );
+    for ( int p = 0; p < num_particle; ++p )
+    {
+        std::vector<int> expected;
+        for ( auto q : contacts[p] )
+            if ( !half || q < p )
+                expected.push_back( q );
+        std::vector<int> computed;
+        for ( int n = 0; n < list_copy.counts( p ); ++n )
+            computed.push_back( list_copy.neighbors( p, n ) );
+        std::sort( expected.begin(), expected.end() );
+        std::sort( computed.begin(), computed.end() );
+        EXPECT_EQ( computed, expected );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Check the full and half contact lists in both layouts.
+template <class Shapes>
+void checkContactLists( const Shapes& shapes,
+                        const std::vector<std::vector<int>>& contacts,
+                        const int max_n )
+{
+    using device_type = TEST_MEMSPACE; // sigh...
+    checkContactList( Cabana::Experimental::makeContactList<device_type>(
+                          Cabana::FullNeighborTag{}, shapes, 0, shapes.size() ),
+                      contacts, max_n, false );
+    checkContactList( Cabana::Experimental::make2DContactList<device_type>(
+                          Cabana::FullNeighborTag{}, shapes, 0, shapes.size() ),
+                      contacts, max_n, false );
+    checkContactList( Cabana::Experimental::makeContactList<device_type>(
+                          Cabana::HalfNeighborTag{}, shapes, 0, shapes.size() ),
+                      contacts, max_n, true );
+    checkContactList(
+        Cabana::Experimental::make2DContactList<device_type>(
+            Cabana::HalfNeighborTag{}, shapes, 0, shapes.size(), 2 ),
+        contacts, max_n, true );
+}
+
+//---------------------------------------------------------------------------//
+void testArborXSphereContacts()
+{
+    // Create the AoSoA and fill with random particle positions.
+    NeighborListTestData test_data;
+    auto position = Cabana::slice<0>( test_data.aosoa );
+    int num_particle = test_data.num_particle;
+
+    // Give every third particle half of the test radius and the others a
+    // quarter of it such that all contacts are within the test radius.
+    double test_radius = test_data.test_radius;
+    Cabana::AoSoA<Cabana::MemberTypes<double>, TEST_MEMSPACE> radius_aosoa(
+        "radii", num_particle );
+    auto radii = Cabana::slice<0>( radius_aosoa );
+    auto radius = [=]( const int p ) {
+        return ( p % 3 == 0 ) ? 0.5 * test_radius : 0.25 * test_radius;
+    };
+    Kokkos::parallel_for(
+        "radii", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_particle ),
+        KOKKOS_LAMBDA( const int p ) {
+            radii( p ) =
+                ( p % 3 == 0 ) ? 0.5 * test_radius : 0.25 * test_radius;
+        } );
+    Kokkos::fence();
+
+    // Find the contacts by brute force.
+    auto host_aosoa = Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                           test_data.aosoa );
+    auto x = Cabana::slice<0>( host_aosoa );
+    std::vector<std::vector<int>> contacts( num_particle );
+    for ( int p = 0; p < num_particle; ++p )
+        for ( int q = 0; q < num_particle; ++q )
+        {
+            double dist_sqr = 0.0;
+            for ( int d = 0; d < 3; ++d )
+            {
+                double dx = x( p, d ) - x( q, d );
+                dist_sqr += dx * dx;
+            }
+            double r = radius( p ) + radius( q );
+            if ( p != q && dist_sqr <= r * r )
+                contacts[p].push_back( q );
+        }
+
+    auto shapes = Cabana::Experimental::makeSphereShapes( position, radii );
+    checkContactLists( shapes, contacts,
+                       test_data.N2_list_copy.neighbors.extent( 1 ) );
+}
+
+//---------------------------------------------------------------------------//
+void testArborXCapsuleContacts()
+{
+    // Pairs of capsules with radius 0.1 that are parallel and overlapping,
+    // crossed, touching at their ends, or with overlapping bounding boxes
+    // but apart.
+    std::vector<std::array<double, 6>> capsules = {
+        { 0.0, 0.0, 0.0, 1.0, 0.0, 0.0 },
+        { 0.0, 0.15, 0.0, 1.0, 0.0, 0.0 },
+        { 1.5, 0.0, 0.0, 0.0, 1.0, 0.0 },
+        { 3.0, 0.0, 0.0, M_SQRT1_2, M_SQRT1_2, 0.0 },
+        { 3.5, -0.5, 0.0, M_SQRT1_2, M_SQRT1_2, 0.0 },
+        { 0.0, 0.0, 5.0, 1.0, 0.0, 0.0 },
+        { 0.0, 0.0, 5.15, 0.0, 1.0, 0.0 },
+        { 0.0, 0.0, 10.0, 1.0, 0.0, 0.0 },
+        { 2.15, 0.0, 10.0, 1.0, 0.0, 0.0 } };
+    std::vector<std::vector<int>> contacts = { { 1 }, { 0 }, {}, {}, {},
+                                               { 6 }, { 5 }, { 8 }, { 7 } };
+    int num_capsule = capsules.size();
+
+    using member_types = Cabana::MemberTypes<double[3], double[3], double>;
+    Cabana::AoSoA<member_types, Kokkos::HostSpace> host_aosoa( "capsules",
+                                                                num_capsule );
+    auto host_x = Cabana::slice<0>( host_aosoa );
+    auto host_axis = Cabana::slice<1>( host_aosoa );
+    auto host_radius = Cabana::slice<2>( host_aosoa );
+    for ( int p = 0; p < num_capsule; ++p )
+    {
+        for ( int d = 0; d < 3; ++d )
+        {
+            host_x( p, d ) = capsules[p][d];
+            host_axis( p, d ) = capsules[p][d + 3];
+        }
+        host_radius( p ) = 0.1;
+    }
+    auto aosoa =
+        Cabana::create_mirror_view_and_copy( TEST_MEMSPACE(), host_aosoa );
+
+    checkContactLists( Cabana::Experimental::makeCapsuleShapes(
+                           Cabana::slice<0>( aosoa ), Cabana::slice<1>( aosoa ),
+                           Cabana::slice<2>( aosoa ) ),
+                       contacts, 4 );
+}
+
+//---------------------------------------------------------------------------//
+void testArborXBoxContacts()
+{
+    // Unit boxes which are aligned or rotated by 45 degrees about z. The
+    // corner of a rotated box penetrates an aligned box, a rotated box is
+    // above an aligned box, and a rotated box is apart from an aligned box
+    // although their bounding boxes overlap.
+    std::vector<std::array<double, 4>> boxes = { { 0.0, 0.0, 10.0, 0.0 },
+                                                 { 2.3, 0.0, 10.0, 1.0 },
+                                                 { 0.0, 0.0, 12.5, 1.0 },
+                                                 { 0.0, 0.0, 20.0, 0.0 },
+                                                 { 2.2, 2.2, 20.0, 1.0 } };
+    std::vector<std::vector<int>> contacts = { { 1 }, { 0 }, {}, {}, {} };
+    int num_box = boxes.size();
+
+    using member_types =
+        Cabana::MemberTypes<double[3], double[3], double[3][3]>;
+    Cabana::AoSoA<member_types, Kokkos::HostSpace> host_aosoa( "boxes",
+                                                                num_box );
+    auto host_x = Cabana::slice<0>( host_aosoa );
+    auto host_extent = Cabana::slice<1>( host_aosoa );
+    auto host_orientation = Cabana::slice<2>( host_aosoa );
+    for ( int p = 0; p < num_box; ++p )
+    {
+        double c = ( boxes[p][3] > 0.0 ) ? M_SQRT1_2 : 1.0;
+        double s = ( boxes[p][3] > 0.0 ) ? M_SQRT1_2 : 0.0;
+        double rotation[3][3] = {
+            { c, s, 0.0 }, { -s, c, 0.0 }, { 0.0, 0.0, 1.0 } };
+        for ( int d = 0; d < 3; ++d )
+        {
+            host_x( p, d ) = boxes[p][d];
+            host_extent( p, d ) = 1.0;
+            for ( int k = 0; k < 3; ++k )
+                host_orientation( p, d, k ) = rotation[d][k];
+        }
+    }
+    auto aosoa =
+        Cabana::create_mirror_view_and_copy( TEST_MEMSPACE(), host_aosoa );
+
+    checkContactLists( Cabana::Experimental::makeBoxShapes(
+                           Cabana::slice<0>( aosoa ), Cabana::slice<1>( aosoa ),
+                           Cabana::slice<2>( aosoa ) ),
+                       contacts, 4 );
+}
+
 //---------------------------------------------------------------------------//
 void testNeighborArborXParallelFor()
 {
@@ -319,6 +644,21 @@ TEST( TEST_CATEGORY, verlet_list_full_range_test )
     testArborXListFullPartialRange();
 }
 
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, variable_radius_test ) { testArborXListVariableRadius(); }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, persistent_list_test ) { testArborXPersistentList(); }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, sphere_contact_test ) { testArborXSphereContacts(); }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, capsule_contact_test ) { testArborXCapsuleContacts(); }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, box_contact_test ) { testArborXBoxContacts(); }
+
 //---------------------------------------------------------------------------//
 TEST( TEST_CATEGORY, parallel_for_test ) { testNeighborArborXParallelFor(); }
 
@@ -16,6 +16,10 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <initializer_list>
+#include <stdexcept>
+
 namespace Test
 {
 
@@ -246,11 +250,349 @@ void runTest2d()
                       ival / 2.0, dim_1, dim_2, dim_3 );
 }
 
+//---------------------------------------------------------------------------//
+// Batch operator computing y = 2 * x_0 + x_1 - y.
+template <class SliceTypeX, class SliceTypeY>
+class BatchOp
+{
+  public:
+    BatchOp( SliceTypeX x, SliceTypeY y )
+        : _x( x )
+        , _y( y )
+    {
+    }
+
+    KOKKOS_INLINE_FUNCTION void operator()( const int s, const int a_begin,
+                                            const int a_end ) const
+    {
+        auto x0 = Cabana::loadBatch( _x, s, 0 );
+        auto x1 = Cabana::loadBatch( _x, s, 1 );
+        auto y = Cabana::loadBatch( _y, s );
+        Cabana::storeBatch( _y, s, a_begin, a_end, 2.0 * x0 + x1 - y );
+    }
+
+  private:
+    SliceTypeX _x;
+    SliceTypeY _y;
+};
+
+//---------------------------------------------------------------------------//
+// Parallel for test with explicit batches over the array index.
+void runTestBatch()
+{
+    // Declare the AoSoA type.
+    using AoSoA_t =
+        Cabana::AoSoA<Cabana::MemberTypes<double[2], double>, TEST_MEMSPACE>;
+
+    // Create an AoSoA.
+    int num_data = 155;
+    AoSoA_t aosoa( "aosoa", num_data );
+    auto x = Cabana::slice<0>( aosoa );
+    auto y = Cabana::slice<1>( aosoa );
+    Kokkos::parallel_for(
+        "fill", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_data ),
+        KOKKOS_LAMBDA( const int p ) {
+            x( p, 0 ) = p;
+            x( p, 1 ) = 0.5 * p;
+            y( p ) = 1.0;
+        } );
+    Kokkos::fence();
+
+    // Run over a range which does not align with the structs.
+    int range_begin = 12;
+    int range_end = 135;
+    Cabana::SimdPolicy<AoSoA_t::vector_length, TEST_EXECSPACE> policy(
+        range_begin, range_end );
+    BatchOp<decltype( x ), decltype( y )> op( x, y );
+    Cabana::simd_parallel_for( policy, op, Cabana::SimdBatchTag(),
+                               "batch_test" );
+    Kokkos::fence();
+
+    // Check the results. Elements outside the range are unchanged.
+    auto mirror =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), aosoa );
+    auto y_mirror = Cabana::slice<1>( mirror );
+    for ( int p = 0; p < num_data; ++p )
+    {
+        if ( p < range_begin || p >= range_end )
+            EXPECT_DOUBLE_EQ( y_mirror( p ), 1.0 );
+        else
+            EXPECT_DOUBLE_EQ( y_mirror( p ), 2.5 * p - 1.0 );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Parallel reduce test with vectorized indexing.
+void runTestReduce()
+{
+    // Declare the AoSoA type.
+    using AoSoA_t =
+        Cabana::AoSoA<Cabana::MemberTypes<double[2], int>, TEST_MEMSPACE>;
+
+    // Create an AoSoA.
+    int num_data = 155;
+    AoSoA_t aosoa( "aosoa", num_data );
+    auto x = Cabana::slice<0>( aosoa );
+    auto n = Cabana::slice<1>( aosoa );
+    Kokkos::parallel_for(
+        "fill", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_data ),
+        KOKKOS_LAMBDA( const int p ) {
+            x( p, 0 ) = p;
+            x( p, 1 ) = -0.5 * p;
+            n( p ) = ( p * 7 ) % 61;
+        } );
+    Kokkos::fence();
+
+    // Sum over a range which does not align with the structs.
+    int range_begin = 12;
+    int range_end = 135;
+    Cabana::SimdPolicy<AoSoA_t::vector_length, TEST_EXECSPACE> policy(
+        range_begin, range_end );
+    double sum = 0.0;
+    Cabana::simd_parallel_reduce(
+        policy,
+        KOKKOS_LAMBDA( const int s, const int a, double& lsum ) {
+            lsum += x.access( s, a, 0 ) * x.access( s, a, 0 ) +
+                    x.access( s, a, 1 ) * x.access( s, a, 1 );
+        },
+        sum, "reduce_test_sum" );
+
+    // Take the maximum with a Kokkos reducer.
+    int max = 0;
+    Cabana::simd_parallel_reduce(
+        policy,
+        KOKKOS_LAMBDA( const int s, const int a, int& lmax ) {
+            if ( n.access( s, a ) > lmax )
+                lmax = n.access( s, a );
+        },
+        Kokkos::Max<int>( max ), "reduce_test_max" );
+
+    // Check the results.
+    double expected_sum = 0.0;
+    int expected_max = 0;
+    for ( int p = range_begin; p < range_end; ++p )
+    {
+        expected_sum += 1.25 * p * p;
+        expected_max = std::max( expected_max, ( p * 7 ) % 61 );
+    }
+    EXPECT_DOUBLE_EQ( sum, expected_sum );
+    EXPECT_EQ( max, expected_max );
+
+    // A single element.
+    Cabana::SimdPolicy<AoSoA_t::vector_length, TEST_EXECSPACE> single_policy(
+        16, 17 );
+    sum = 0.0;
+    Cabana::simd_parallel_reduce(
+        single_policy,
+        KOKKOS_LAMBDA( const int s, const int a, double& lsum ) {
+            lsum += x.access( s, a, 0 );
+        },
+        sum );
+    EXPECT_DOUBLE_EQ( sum, 16.0 );
+}
+
+//---------------------------------------------------------------------------//
+// Team operator staging x in scratch and using it in two passes to compute
+// y = |x|^2 + x_0.
+template <class PolicyType, class SliceTypeX, class SliceTypeY>
+class ScratchOp
+{
+  public:
+    ScratchOp( PolicyType policy, SliceTypeX x, SliceTypeY y )
+        : _policy( policy )
+        , _x( x )
+        , _y( y )
+    {
+    }
+
+    template <class TeamMember>
+    KOKKOS_INLINE_FUNCTION void operator()( const TeamMember& team,
+                                            const int s_begin,
+                                            const int s_end ) const
+    {
+        Cabana::ScratchSlice<SliceTypeX> x( team, _x, s_begin, s_end );
+        x.load( team );
+        team.team_barrier();
+
+        // First pass.
+        Kokkos::parallel_for(
+            Kokkos::TeamThreadRange( team, s_begin, s_end ),
+            [&]( const int s ) {
+                Kokkos::parallel_for(
+                    Kokkos::ThreadVectorRange( team, _policy.arrayBegin( s ),
+                                               _policy.arrayEnd( s ) ),
+                    [&]( const int a ) {
+                        double r2 = 0.0;
+                        for ( int d = 0; d < 3; ++d )
+                            r2 += x.access( s, a, d ) * x.access( s, a, d );
+                        _y.access( s, a ) = r2;
+                    } );
+            } );
+
+        // Second pass reusing the scratch data.
+        Kokkos::parallel_for(
+            Kokkos::TeamThreadRange( team, s_begin, s_end ),
+            [&]( const int s ) {
+                Kokkos::parallel_for(
+                    Kokkos::ThreadVectorRange( team, _policy.arrayBegin( s ),
+                                               _policy.arrayEnd( s ) ),
+                    [&]( const int a ) {
+                        _y.access( s, a ) += x.access( s, a, 0 );
+                    } );
+            } );
+    }
+
+  private:
+    PolicyType _policy;
+    SliceTypeX _x;
+    SliceTypeY _y;
+};
+
+//---------------------------------------------------------------------------//
+// Team parallel for test with scratch staging.
+void runTestTeamScratch()
+{
+    // Declare the AoSoA type.
+    using AoSoA_t =
+        Cabana::AoSoA<Cabana::MemberTypes<double[3], double>, TEST_MEMSPACE>;
+
+    // Create an AoSoA.
+    int num_data = 355;
+    AoSoA_t aosoa( "aosoa", num_data );
+    auto x = Cabana::slice<0>( aosoa );
+    auto y = Cabana::slice<1>( aosoa );
+    Kokkos::parallel_for(
+        "fill", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_data ),
+        KOKKOS_LAMBDA( const int p ) {
+            for ( int d = 0; d < 3; ++d )
+                x( p, d ) = p + d;
+            y( p ) = -1.0;
+        } );
+    Kokkos::fence();
+
+    // Run over a range which does not align with the structs.
+    int range_begin = 7;
+    int range_end = 341;
+    using policy_type =
+        Cabana::SimdPolicy<AoSoA_t::vector_length, TEST_EXECSPACE>;
+    policy_type policy( range_begin, range_end );
+    int structs_per_team = 3;
+    auto scratch_size = Cabana::ScratchSlice<decltype( x )>::scratchSize(
+        x, structs_per_team );
+    ScratchOp<policy_type, decltype( x ), decltype( y )> op( policy, x, y );
+    Cabana::simd_team_parallel_for( policy, structs_per_team, scratch_size, op,
+                                    "team_scratch_test" );
+    Kokkos::fence();
+
+    // Check the results. Elements outside the range are unchanged.
+    auto mirror =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), aosoa );
+    auto y_mirror = Cabana::slice<1>( mirror );
+    for ( int p = 0; p < num_data; ++p )
+    {
+        if ( p < range_begin || p >= range_end )
+            EXPECT_DOUBLE_EQ( y_mirror( p ), -1.0 );
+        else
+            EXPECT_DOUBLE_EQ( y_mirror( p ), p * p + ( p + 1.0 ) * ( p + 1 ) +
+                                                 ( p + 2.0 ) * ( p + 2 ) + p );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Parallel for test with a vector length selected at runtime.
+template <int VectorLength>
+void runTestVectorLength()
+{
+    // Data dimensions.
+    const int dim_1 = 3;
+    const int dim_2 = 2;
+    const int dim_3 = 4;
+
+    // Declare data types.
+    using DataTypes = Cabana::MemberTypes<float[dim_1][dim_2][dim_3], int,
+                                          double[dim_1], double[dim_1][dim_2]>;
+
+    // Declare the AoSoA type with the dispatched vector length.
+    using AoSoA_t = Cabana::AoSoA<DataTypes, TEST_MEMSPACE, VectorLength>;
+    int num_data = 155;
+    AoSoA_t aosoa( "aosoa", num_data );
+
+    // Loop in parallel.
+    using OpType = AssignmentOp<
+        AoSoA_t, typename AoSoA_t::template member_slice_type<0>,
+        typename AoSoA_t::template member_slice_type<1>,
+        typename AoSoA_t::template member_slice_type<2>,
+        typename AoSoA_t::template member_slice_type<3>>;
+    float fval = 3.4;
+    double dval = 1.23;
+    int ival = 1;
+    OpType func( aosoa, fval, dval, ival );
+    Cabana::SimdPolicy<VectorLength, TEST_EXECSPACE> policy( 0, num_data );
+    Cabana::simd_parallel_for( policy, func, "vector_length_test" );
+    Kokkos::fence();
+
+    // Check data members for proper initialization.
+    checkDataMembers( aosoa, 0, num_data, fval, dval, ival, dim_1, dim_2,
+                      dim_3 );
+}
+
+struct VectorLengthTestKernel
+{
+    int* called;
+
+    template <class VectorLength>
+    void operator()( VectorLength ) const
+    {
+        *called = VectorLength::value;
+        runTestVectorLength<VectorLength::value>();
+    }
+};
+
+void runTestVectorLengthDispatch()
+{
+    using list = Cabana::VectorLengthList<4, 8, 16, 32, 64>;
+
+    // The preferred vector length must be one of the instantiated lengths.
+    int vector_length = Cabana::preferredVectorLength<TEST_EXECSPACE>();
+    int called = 0;
+    Cabana::dispatchVectorLength( vector_length, list(),
+                                  VectorLengthTestKernel{ &called } );
+    EXPECT_EQ( called, vector_length );
+
+    // Every instantiated length runs.
+    for ( int v : { 4, 8, 16, 32, 64 } )
+    {
+        Cabana::dispatchVectorLength( v, list(),
+                                      VectorLengthTestKernel{ &called } );
+        EXPECT_EQ( called, v );
+    }
+
+    // Lengths which were not instantiated throw.
+    EXPECT_THROW( Cabana::dispatchVectorLength(
+                      2, list(), VectorLengthTestKernel{ &called } ),
+                  std::runtime_error );
+}
+
 //---------------------------------------------------------------------------//
 // RUN TESTS
 //---------------------------------------------------------------------------//
 TEST( TEST_CATEGORY, simd_parallel_for_test ) { runTest2d(); }
 
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, simd_batch_parallel_for_test ) { runTestBatch(); }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, simd_parallel_reduce_test ) { runTestReduce(); }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, simd_team_parallel_for_test ) { runTestTeamScratch(); }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, vector_length_dispatch_test )
+{
+    runTestVectorLengthDispatch();
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
@@ -0,0 +1,131 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_Checkpoint.hpp>
+#include <Cabana_DeepCopy.hpp>
+#include <Cabana_ParallelIO.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+void testLocalRange()
+{
+    int comm_rank = -1;
+    int comm_size = -1;
+    MPI_Comm_rank( MPI_COMM_WORLD, &comm_rank );
+    MPI_Comm_size( MPI_COMM_WORLD, &comm_size );
+
+    // The ranges tile the items in whole blocks.
+    for ( std::size_t num_global : { 0, 7, 100, 1027 } )
+    {
+        auto range = Cabana::IO::localRange( num_global, 16, MPI_COMM_WORLD );
+        EXPECT_LE( range.first, range.second );
+        if ( range.second < num_global )
+            EXPECT_EQ( range.second % 16, 0u );
+        unsigned long long num_local = range.second - range.first;
+        unsigned long long begin = 0;
+        MPI_Exscan( &num_local, &begin, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM,
+                    MPI_COMM_WORLD );
+        if ( 0 == comm_rank )
+            begin = 0;
+        EXPECT_EQ( range.first, begin );
+        unsigned long long total = 0;
+        MPI_Allreduce( &num_local, &total, 1, MPI_UNSIGNED_LONG_LONG,
+                       MPI_SUM, MPI_COMM_WORLD );
+        EXPECT_EQ( total, num_global );
+    }
+}
+
+//---------------------------------------------------------------------------//
+void testReadParticles( const Cabana::IO::ReadMethod method )
+{
+    int comm_rank = -1;
+    MPI_Comm_rank( MPI_COMM_WORLD, &comm_rank );
+
+    // Write all particles from the first rank.
+    using DataTypes = Cabana::MemberTypes<double, int[2]>;
+    using AoSoA_t = Cabana::AoSoA<DataTypes, TEST_MEMSPACE, 16>;
+    std::string path = "parallel_io_test.bin";
+    int num_global = 1027;
+    if ( 0 == comm_rank )
+    {
+        Cabana::AoSoA<DataTypes, Kokkos::HostSpace, 16> all( "all",
+                                                             num_global );
+        auto value = Cabana::slice<0>( all );
+        auto ids = Cabana::slice<1>( all );
+        for ( int p = 0; p < num_global; ++p )
+        {
+            value( p ) = 0.5 * p;
+            ids( p, 0 ) = p;
+            ids( p, 1 ) = -p;
+        }
+        Cabana::checkpoint( all, path );
+    }
+    MPI_Barrier( MPI_COMM_WORLD );
+
+    // Read the range of every rank.
+    AoSoA_t aosoa( "aosoa" );
+    Cabana::IO::readParticles( MPI_COMM_WORLD, path, aosoa, method );
+    auto range = Cabana::IO::localRange( num_global, 16, MPI_COMM_WORLD );
+    EXPECT_EQ( aosoa.size(), range.second - range.first );
+    auto host =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), aosoa );
+    auto value = Cabana::slice<0>( host );
+    auto ids = Cabana::slice<1>( host );
+    for ( std::size_t p = 0; p < host.size(); ++p )
+    {
+        int n = range.first + p;
+        EXPECT_EQ( value( p ), 0.5 * n );
+        EXPECT_EQ( ids( p, 0 ), n );
+        EXPECT_EQ( ids( p, 1 ), -n );
+    }
+
+    // Files of other layouts are rejected on all ranks.
+    Cabana::AoSoA<Cabana::MemberTypes<float>, TEST_MEMSPACE, 16> other(
+        "other" );
+    EXPECT_THROW(
+        Cabana::IO::readParticles( MPI_COMM_WORLD, path, other, method ),
+        std::runtime_error );
+
+    MPI_Barrier( MPI_COMM_WORLD );
+    if ( 0 == comm_rank )
+        std::remove( path.c_str() );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, local_range_test ) { testLocalRange(); }
+
+TEST( TEST_CATEGORY, read_mmap_test )
+{
+    testReadParticles( Cabana::IO::ReadMethod::MMap );
+}
+
+TEST( TEST_CATEGORY, read_mpiio_test )
+{
+    testReadParticles( Cabana::IO::ReadMethod::MPIIO );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
@@ -0,0 +1,186 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_DeepCopy.hpp>
+#include <Cabana_ParticleInit.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <set>
+#include <stdexcept>
+#include <tuple>
+
+namespace Test
+{
+using ParticleTypes = Cabana::MemberTypes<int, double[3]>;
+using ParticleAoSoA = Cabana::AoSoA<ParticleTypes, TEST_MEMSPACE>;
+
+//---------------------------------------------------------------------------//
+void testLattice()
+{
+    // Start with particles that should be kept.
+    ParticleAoSoA aosoa( "aosoa", 3 );
+    auto initial = Cabana::slice<1>( aosoa );
+    Cabana::deep_copy( initial, -1.0 );
+
+    // Create the lattice on two subdomains.
+    double origin[3] = { 0.0, 0.0, 0.0 };
+    double spacing[3] = { 0.5, 0.5, 1.0 };
+    double box_min[3] = { 0.0, 0.0, 0.0 };
+    double box_mid[3] = { 1.1, 1.0, 1.0 };
+    double box_max[3] = { 2.0, 1.0, 1.0 };
+    double mid_min[3] = { 1.1, 0.0, 0.0 };
+    auto num_0 = Cabana::createLatticeParticles<1>(
+        TEST_EXECSPACE(), aosoa, origin, spacing, box_min, box_mid );
+    auto num_1 = Cabana::createLatticeParticles<1>(
+        TEST_EXECSPACE(), aosoa, origin, spacing, mid_min, box_max );
+    EXPECT_EQ( num_0, 4u );
+    EXPECT_EQ( num_1, 4u );
+    EXPECT_EQ( aosoa.size(), 11u );
+
+    // Every lattice point is created once.
+    auto host =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), aosoa );
+    auto x = Cabana::slice<1>( host );
+    for ( int p = 0; p < 3; ++p )
+        EXPECT_EQ( x( p, 0 ), -1.0 );
+    std::set<std::tuple<int, int, int>> points;
+    for ( std::size_t p = 3; p < host.size(); ++p )
+    {
+        int ijk[3];
+        for ( int d = 0; d < 3; ++d )
+        {
+            double index = x( p, d ) / spacing[d] - 0.5;
+            ijk[d] = std::lround( index );
+            EXPECT_NEAR( index, ijk[d], 1.0e-12 );
+            EXPECT_GE( x( p, d ), box_min[d] );
+            EXPECT_LT( x( p, d ), box_max[d] );
+        }
+        points.insert( std::make_tuple( ijk[0], ijk[1], ijk[2] ) );
+    }
+    EXPECT_EQ( points.size(), 8u );
+
+    // Jittered points stay within their lattice cells.
+    ParticleAoSoA jittered( "jittered", 0 );
+    auto num_jitter = Cabana::createLatticeParticles<1>(
+        TEST_EXECSPACE(), jittered, origin, spacing, box_min, box_max, 1.0,
+        5 );
+    EXPECT_EQ( num_jitter, 8u );
+    auto jitter_host =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), jittered );
+    auto xj = Cabana::slice<1>( jitter_host );
+    for ( std::size_t p = 0; p < jitter_host.size(); ++p )
+        for ( int d = 0; d < 3; ++d )
+        {
+            EXPECT_GE( xj( p, d ), box_min[d] );
+            EXPECT_LE( xj( p, d ), box_max[d] );
+        }
+
+    // Invalid arguments.
+    EXPECT_THROW( Cabana::createLatticeParticles<1>( TEST_EXECSPACE(), aosoa,
+                                                     origin, spacing, box_min,
+                                                     box_max, 1.5 ),
+                  std::runtime_error );
+    double bad_spacing[3] = { 0.5, 0.0, 1.0 };
+    EXPECT_THROW( Cabana::createLatticeParticles<1>( TEST_EXECSPACE(), aosoa,
+                                                     origin, bad_spacing,
+                                                     box_min, box_max ),
+                  std::runtime_error );
+}
+
+//---------------------------------------------------------------------------//
+void testRandom()
+{
+    ParticleAoSoA aosoa( "aosoa", 0 );
+    double box_min[3] = { -1.0, 2.0, 0.0 };
+    double box_max[3] = { 1.0, 3.0, 0.5 };
+    Cabana::createRandomParticles<1>( TEST_EXECSPACE(), aosoa, 1000, box_min,
+                                      box_max, 3 );
+    EXPECT_EQ( aosoa.size(), 1000u );
+
+    auto host =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), aosoa );
+    auto x = Cabana::slice<1>( host );
+    double mean[3] = { 0.0, 0.0, 0.0 };
+    for ( std::size_t p = 0; p < host.size(); ++p )
+        for ( int d = 0; d < 3; ++d )
+        {
+            EXPECT_GE( x( p, d ), box_min[d] );
+            EXPECT_LT( x( p, d ), box_max[d] );
+            mean[d] += x( p, d ) / host.size();
+        }
+    for ( int d = 0; d < 3; ++d )
+        EXPECT_NEAR( mean[d], 0.5 * ( box_min[d] + box_max[d] ),
+                     0.1 * ( box_max[d] - box_min[d] ) );
+}
+
+//---------------------------------------------------------------------------//
+void testPoissonDisk()
+{
+    ParticleAoSoA aosoa( "aosoa", 2 );
+    auto initial = Cabana::slice<1>( aosoa );
+    Cabana::deep_copy( initial, 0.5 );
+
+    double box_min[3] = { 0.0, 0.0, 0.0 };
+    double box_max[3] = { 1.0, 1.0, 0.5 };
+    double min_dist = 0.1;
+    auto num_create = Cabana::createPoissonDiskParticles<1>(
+        TEST_EXECSPACE(), aosoa, 3000, box_min, box_max, min_dist, 7 );
+    EXPECT_GT( num_create, 0u );
+    EXPECT_EQ( aosoa.size(), 2 + num_create );
+
+    // The existing particles are kept in front and the created particles
+    // keep the minimum distance.
+    auto host =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), aosoa );
+    auto x = Cabana::slice<1>( host );
+    for ( int p = 0; p < 2; ++p )
+        for ( int d = 0; d < 3; ++d )
+            EXPECT_EQ( x( p, d ), 0.5 );
+    for ( std::size_t p = 2; p < host.size(); ++p )
+    {
+        for ( std::size_t q = 2; q < p; ++q )
+        {
+            double dist_sqr = 0.0;
+            for ( int d = 0; d < 3; ++d )
+                dist_sqr +=
+                    ( x( p, d ) - x( q, d ) ) * ( x( p, d ) - x( q, d ) );
+            EXPECT_GE( dist_sqr, min_dist * min_dist );
+        }
+    }
+
+    // Every candidate is within the minimum distance of a created particle,
+    // so with many candidates their spheres nearly cover the box.
+    double volume = 0.5;
+    double sphere = 4.0 / 3.0 * std::acos( -1.0 ) * std::pow( min_dist, 3 );
+    EXPECT_GT( num_create, 0.25 * volume / sphere );
+
+    EXPECT_THROW( Cabana::createPoissonDiskParticles<1>(
+                      TEST_EXECSPACE(), aosoa, 10, box_min, box_max, 0.0 ),
+                  std::runtime_error );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, lattice_test ) { testLattice(); }
+
+TEST( TEST_CATEGORY, random_test ) { testRandom(); }
+
+TEST( TEST_CATEGORY, poisson_disk_test ) { testPoissonDisk(); }
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
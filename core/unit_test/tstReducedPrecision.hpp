@@ -0,0 +1,127 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_DeepCopy.hpp>
+#include <Cabana_ReducedPrecision.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+// Check the conversions of the storage types on the host.
+void conversionTest()
+{
+    EXPECT_EQ( sizeof( Cabana::Half ), 2u );
+    EXPECT_EQ( sizeof( Cabana::BFloat16 ), 2u );
+    EXPECT_TRUE( Cabana::is_reduced_precision<Cabana::Half>::value );
+    EXPECT_TRUE( Cabana::is_reduced_precision<const Cabana::BFloat16>::value );
+    EXPECT_FALSE( Cabana::is_reduced_precision<float>::value );
+
+    // Exactly representable values.
+    for ( float v : { 0.0f, 0.5f, 1.0f, -2.0f, 1024.0f, 65504.0f } )
+    {
+        EXPECT_EQ( float( Cabana::Half( v ) ), v );
+        EXPECT_EQ( float( Cabana::BFloat16( v ) ), v == 65504.0f ? 65536.0f
+                                                                   : v );
+    }
+
+    // Rounding to the nearest representable value.
+    float third = 1.0f / 3.0f;
+    EXPECT_NEAR( float( Cabana::Half( third ) ), third,
+                 third * std::ldexp( 1.0f, -11 ) );
+    EXPECT_NEAR( float( Cabana::BFloat16( third ) ), third,
+                 third * std::ldexp( 1.0f, -8 ) );
+
+    // Ties round to even.
+    EXPECT_EQ( float( Cabana::Half( 1.0f + std::ldexp( 1.0f, -11 ) ) ), 1.0f );
+    EXPECT_EQ( float( Cabana::Half( 1.0f + 3.0f * std::ldexp( 1.0f, -11 ) ) ),
+               1.0f + std::ldexp( 1.0f, -9 ) );
+
+    // Half subnormals and underflow.
+    float min_sub = std::ldexp( 1.0f, -24 );
+    EXPECT_EQ( float( Cabana::Half( min_sub ) ), min_sub );
+    EXPECT_EQ( float( Cabana::Half( 3.0f * min_sub ) ), 3.0f * min_sub );
+    EXPECT_EQ( float( Cabana::Half( 0.25f * min_sub ) ), 0.0f );
+
+    // Half overflow. BFloat16 has the range of float.
+    float inf = std::numeric_limits<float>::infinity();
+    EXPECT_EQ( float( Cabana::Half( 1.0e5f ) ), inf );
+    EXPECT_EQ( float( Cabana::Half( -1.0e5f ) ), -inf );
+    EXPECT_NEAR( float( Cabana::BFloat16( 1.0e30f ) ), 1.0e30f,
+                 1.0e30f * std::ldexp( 1.0f, -8 ) );
+    EXPECT_EQ( float( Cabana::BFloat16( inf ) ), inf );
+    EXPECT_TRUE( std::isnan( float( Cabana::Half( std::nanf( "" ) ) ) ) );
+    EXPECT_TRUE( std::isnan( float( Cabana::BFloat16( std::nanf( "" ) ) ) ) );
+}
+
+//---------------------------------------------------------------------------//
+// Check reduced precision members of an AoSoA accessed through slices.
+void aosoaTest()
+{
+    using DataTypes =
+        Cabana::MemberTypes<double, Cabana::Half[3], Cabana::BFloat16>;
+    using AoSoA_t = Cabana::AoSoA<DataTypes, TEST_MEMSPACE, 16>;
+
+    // The reduced precision members take half the storage of float members.
+    using FloatTypes = Cabana::MemberTypes<double, float[3], float>;
+    EXPECT_EQ( sizeof( typename AoSoA_t::soa_type ),
+               sizeof( Cabana::SoA<FloatTypes, 16> ) - 16 * 4 * 2 );
+
+    // Fill the members in a kernel.
+    int num_data = 35;
+    AoSoA_t aosoa( "aosoa", num_data );
+    auto slice_0 = Cabana::slice<0>( aosoa );
+    auto slice_1 = Cabana::slice<1>( aosoa );
+    auto slice_2 = Cabana::slice<2>( aosoa );
+    Kokkos::parallel_for(
+        "fill", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_data ),
+        KOKKOS_LAMBDA( const int i ) {
+            slice_0( i ) = i;
+            for ( int d = 0; d < 3; ++d )
+                slice_1( i, d ) = 0.5 * i + d;
+            slice_2( i ) = -0.25 * i;
+            slice_2( i ) += 1.0f;
+            slice_1( i, 2 ) *= 2.0f;
+        } );
+
+    // Check the values on the host.
+    auto mirror =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), aosoa );
+    auto mirror_0 = Cabana::slice<0>( mirror );
+    auto mirror_1 = Cabana::slice<1>( mirror );
+    auto mirror_2 = Cabana::slice<2>( mirror );
+    for ( int i = 0; i < num_data; ++i )
+    {
+        EXPECT_EQ( mirror_0( i ), i );
+        EXPECT_EQ( float( mirror_1( i, 0 ) ), 0.5f * i );
+        EXPECT_EQ( float( mirror_1( i, 1 ) ), 0.5f * i + 1.0f );
+        EXPECT_EQ( float( mirror_1( i, 2 ) ), 2.0f * ( 0.5f * i + 2.0f ) );
+        EXPECT_EQ( float( mirror_2( i ) ), 1.0f - 0.25f * i );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, reduced_precision_conversion_test ) { conversionTest(); }
+
+TEST( TEST_CATEGORY, reduced_precision_aosoa_test ) { aosoaTest(); }
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
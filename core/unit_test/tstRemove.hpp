@@ -0,0 +1,131 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_DeepCopy.hpp>
+#include <Cabana_Remove.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+// Declare the AoSoA type.
+using RemoveAoSoA_t =
+    Cabana::AoSoA<Cabana::MemberTypes<int, double[3]>, TEST_MEMSPACE>;
+
+//---------------------------------------------------------------------------//
+// Create an AoSoA where every element has its index as an id.
+RemoveAoSoA_t createRemoveData( const int num_data )
+{
+    RemoveAoSoA_t aosoa( "aosoa", num_data );
+    auto ids = Cabana::slice<0>( aosoa );
+    auto data = Cabana::slice<1>( aosoa );
+    Kokkos::parallel_for(
+        "fill", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_data ),
+        KOKKOS_LAMBDA( const int p ) {
+            ids( p ) = p;
+            for ( int d = 0; d < 3; ++d )
+                data( p, d ) = p + 0.5 * d;
+        } );
+    Kokkos::fence();
+    return aosoa;
+}
+
+//---------------------------------------------------------------------------//
+// Check that the AoSoA holds exactly the elements whose id satisfies the
+// given condition with their data intact.
+template <class KeepFunc>
+void checkRemoveData( const RemoveAoSoA_t& aosoa, const int num_data,
+                      const KeepFunc& keep )
+{
+    auto mirror =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), aosoa );
+    auto ids = Cabana::slice<0>( mirror );
+    auto data = Cabana::slice<1>( mirror );
+
+    std::vector<int> expected;
+    for ( int p = 0; p < num_data; ++p )
+        if ( keep( p ) )
+            expected.push_back( p );
+
+    EXPECT_EQ( mirror.size(), expected.size() );
+
+    std::vector<int> found;
+    for ( std::size_t p = 0; p < mirror.size(); ++p )
+    {
+        found.push_back( ids( p ) );
+        for ( int d = 0; d < 3; ++d )
+            EXPECT_EQ( data( p, d ), ids( p ) + 0.5 * d );
+    }
+    std::sort( found.begin(), found.end() );
+    EXPECT_EQ( found, expected );
+}
+
+//---------------------------------------------------------------------------//
+void testCompact()
+{
+    int num_data = 1053;
+
+    // Keep every third element.
+    auto aosoa = createRemoveData( num_data );
+    Kokkos::View<int*, TEST_MEMSPACE> keep_mask( "keep_mask", num_data );
+    Kokkos::parallel_for(
+        "mask", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_data ),
+        KOKKOS_LAMBDA( const int p ) { keep_mask( p ) = ( p % 3 == 0 ); } );
+    Kokkos::fence();
+    Cabana::compact( aosoa, keep_mask );
+    checkRemoveData( aosoa, num_data,
+                     []( const int p ) { return p % 3 == 0; } );
+
+    // Keep everything.
+    aosoa = createRemoveData( num_data );
+    Kokkos::deep_copy( keep_mask, 1 );
+    Cabana::compact( aosoa, keep_mask );
+    checkRemoveData( aosoa, num_data, []( const int ) { return true; } );
+
+    // Keep nothing.
+    Kokkos::deep_copy( keep_mask, 0 );
+    Cabana::compact( aosoa, keep_mask );
+    EXPECT_EQ( aosoa.size(), std::size_t( 0 ) );
+}
+
+//---------------------------------------------------------------------------//
+void testRemoveIf()
+{
+    int num_data = 1053;
+
+    // Remove the elements with an id divisible by 4.
+    auto aosoa = createRemoveData( num_data );
+    auto ids = Cabana::slice<0>( aosoa );
+    Cabana::remove_if( aosoa, KOKKOS_LAMBDA( const std::size_t i ) {
+        return ids( i ) % 4 == 0;
+    } );
+    checkRemoveData( aosoa, num_data,
+                     []( const int p ) { return p % 4 != 0; } );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, compact_test ) { testCompact(); }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, remove_if_test ) { testRemoveIf(); }
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
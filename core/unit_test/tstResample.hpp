@@ -0,0 +1,148 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_DeepCopy.hpp>
+#include <Cabana_LinkedCellList.hpp>
+#include <Cabana_Resample.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+void testResample()
+{
+    // Two cells along x. The first holds 10 particles with decreasing
+    // weights and the second holds 2.
+    using DataTypes = Cabana::MemberTypes<double, double[3], double[3]>;
+    using AoSoA_t = Cabana::AoSoA<DataTypes, TEST_MEMSPACE>;
+    int num_data = 12;
+    AoSoA_t aosoa( "aosoa", num_data );
+    auto weight = Cabana::slice<0>( aosoa );
+    auto pos = Cabana::slice<1>( aosoa );
+    auto vel = Cabana::slice<2>( aosoa );
+    Kokkos::parallel_for(
+        "fill", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_data ),
+        KOKKOS_LAMBDA( const int p ) {
+            bool first = p < 10;
+            weight( p ) = first ? 10.0 - p : 3.0 + 2.0 * ( p - 10 );
+            pos( p, 0 ) = first ? 0.05 + 0.09 * p : 1.25 + 0.5 * ( p - 10 );
+            pos( p, 1 ) = 0.1 * ( p % 7 ) + 0.2;
+            pos( p, 2 ) = 0.5;
+            vel( p, 0 ) = 1.0 * p;
+            vel( p, 1 ) = -0.5 * p;
+            vel( p, 2 ) = 2.0;
+        } );
+    Kokkos::fence();
+
+    // Compute the conserved moments.
+    auto moments = [&]( const AoSoA_t& particles, double m[7] ) {
+        auto host = Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                         particles );
+        auto w = Cabana::slice<0>( host );
+        auto x = Cabana::slice<1>( host );
+        auto v = Cabana::slice<2>( host );
+        for ( int n = 0; n < 7; ++n )
+            m[n] = 0.0;
+        for ( std::size_t p = 0; p < host.size(); ++p )
+        {
+            m[0] += w( p );
+            for ( int d = 0; d < 3; ++d )
+            {
+                m[1 + d] += w( p ) * x( p, d );
+                m[4 + d] += w( p ) * v( p, d );
+            }
+        }
+    };
+    double before[7];
+    moments( aosoa, before );
+
+    double grid_delta[3] = { 1.0, 1.0, 1.0 };
+    double grid_min[3] = { 0.0, 0.0, 0.0 };
+    double grid_max[3] = { 2.0, 1.0, 1.0 };
+    Cabana::LinkedCellList<TEST_MEMSPACE> cell_list( pos, grid_delta,
+                                                     grid_min, grid_max );
+    auto counts_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), Cabana::cellCounts( cell_list ) );
+    EXPECT_EQ( counts_host( 0 ), 10 );
+    EXPECT_EQ( counts_host( 1 ), 2 );
+
+    // An empty range of counts is invalid.
+    Cabana::ConservingResampleRule<0, 1, 2> rule;
+    EXPECT_THROW( Cabana::resample( aosoa, cell_list, weight, 7, 6, rule ),
+                  std::runtime_error );
+
+    // Merge the 8 lightest particles of the first cell pairwise and split
+    // both particles of the second cell.
+    auto result = Cabana::resample( aosoa, cell_list, weight, 4, 6, rule );
+    EXPECT_EQ( result.num_merge, 4u );
+    EXPECT_EQ( result.num_split, 2u );
+    EXPECT_EQ( aosoa.size(), 10u );
+
+    double after[7];
+    moments( aosoa, after );
+    for ( int n = 0; n < 7; ++n )
+        EXPECT_NEAR( after[n], before[n],
+                     1.0e-12 * ( 1.0 + fabs( before[n] ) ) );
+
+    // Check the counts and weights of the cells.
+    pos = Cabana::slice<1>( aosoa );
+    Cabana::LinkedCellList<TEST_MEMSPACE> new_list( pos, grid_delta, grid_min,
+                                                    grid_max );
+    counts_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), Cabana::cellCounts( new_list ) );
+    EXPECT_EQ( counts_host( 0 ), 6 );
+    EXPECT_EQ( counts_host( 1 ), 4 );
+
+    auto host =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), aosoa );
+    auto w_host = Cabana::slice<0>( host );
+    auto x_host = Cabana::slice<1>( host );
+    std::vector<double> weights_0;
+    std::vector<double> weights_1;
+    for ( std::size_t p = 0; p < host.size(); ++p )
+    {
+        if ( x_host( p, 0 ) < 1.0 )
+            weights_0.push_back( w_host( p ) );
+        else
+            weights_1.push_back( w_host( p ) );
+    }
+    std::sort( weights_0.begin(), weights_0.end() );
+    std::sort( weights_1.begin(), weights_1.end() );
+    std::vector<double> expected_0 = { 3.0, 7.0, 9.0, 10.0, 11.0, 15.0 };
+    std::vector<double> expected_1 = { 1.5, 1.5, 2.5, 2.5 };
+    EXPECT_EQ( weights_0, expected_0 );
+    EXPECT_EQ( weights_1, expected_1 );
+
+    // Cells within the range are left unchanged.
+    result = Cabana::resample( aosoa, new_list, Cabana::slice<0>( aosoa ), 4,
+                               6, rule );
+    EXPECT_EQ( result.num_merge, 0u );
+    EXPECT_EQ( result.num_split, 0u );
+    EXPECT_EQ( aosoa.size(), 10u );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, resample_test ) { testResample(); }
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
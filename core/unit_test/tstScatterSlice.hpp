@@ -0,0 +1,94 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_DeepCopy.hpp>
+#include <Cabana_ScatterSlice.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+// Add contributions from every element into a few target elements and check
+// the sums.
+template <class Duplication>
+void testScatterSlice()
+{
+    using aosoa_type = Cabana::AoSoA<Cabana::MemberTypes<double, double[3]>,
+                                     TEST_MEMSPACE>;
+    int num_data = 1053;
+    int num_target = 7;
+    aosoa_type aosoa( "aosoa", num_data );
+    auto scalar = Cabana::slice<0>( aosoa );
+    auto vector = Cabana::slice<1>( aosoa );
+    Cabana::deep_copy( scalar, 1.0 );
+    Cabana::deep_copy( vector, 0.0 );
+
+    Cabana::ScatterSlice<decltype( scalar ), Duplication> scatter_scalar(
+        scalar );
+    Cabana::ScatterSlice<decltype( vector ), Duplication> scatter_vector(
+        vector );
+
+    // Contribute twice to check that contributions are reset in between.
+    for ( int n = 0; n < 2; ++n )
+    {
+        Kokkos::parallel_for(
+            "scatter", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_data ),
+            KOKKOS_LAMBDA( const int p ) {
+                auto s_access = scatter_scalar.access();
+                auto v_access = scatter_vector.access();
+                int t = p % num_target;
+                s_access( t ) += 1.0;
+                for ( int d = 0; d < 3; ++d )
+                    v_access( t, d ) += d + 1.0;
+            } );
+        Kokkos::fence();
+        scatter_scalar.contribute();
+        scatter_vector.contribute();
+    }
+
+    auto mirror =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), aosoa );
+    auto scalar_mirror = Cabana::slice<0>( mirror );
+    auto vector_mirror = Cabana::slice<1>( mirror );
+    for ( int p = 0; p < num_data; ++p )
+    {
+        double count = 0.0;
+        if ( p < num_target )
+            count = 2.0 * ( num_data / num_target +
+                            ( p < num_data % num_target ? 1 : 0 ) );
+        EXPECT_EQ( scalar_mirror( p ), 1.0 + count );
+        for ( int d = 0; d < 3; ++d )
+            EXPECT_EQ( vector_mirror( p, d ), count * ( d + 1.0 ) );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, scatter_slice_default_test )
+{
+    testScatterSlice<typename Kokkos::Impl::Experimental::DefaultDuplication<
+        TEST_EXECSPACE>::type>();
+}
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, scatter_slice_atomic_test )
+{
+    testScatterSlice<Kokkos::Experimental::ScatterNonDuplicated>();
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
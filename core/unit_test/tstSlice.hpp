@@ -339,6 +339,58 @@ void atomicAccessTest()
         EXPECT_EQ( mirror_slice( i ), num_data );
 }
 
+//---------------------------------------------------------------------------//
+// Strided view test.
+void stridedViewTest()
+{
+    const int vector_length = 16;
+    using DataTypes = Cabana::MemberTypes<double[3][2], int>;
+    using AoSoA_t = Cabana::AoSoA<DataTypes, TEST_MEMSPACE, vector_length>;
+    int num_data = 35;
+    AoSoA_t aosoa( "aosoa", num_data );
+    auto slice_0 = Cabana::slice<0>( aosoa );
+    auto slice_1 = Cabana::slice<1>( aosoa );
+
+    // Check the view layout.
+    auto view_0 = Cabana::stridedView( slice_0 );
+    auto view_1 = Cabana::stridedView( slice_1 );
+    EXPECT_EQ( view_0.rank, 4u );
+    EXPECT_EQ( view_1.rank, 2u );
+    EXPECT_EQ( view_0.extent( 0 ), aosoa.numSoA() );
+    EXPECT_EQ( view_0.extent( 1 ), std::size_t( vector_length ) );
+    EXPECT_EQ( view_0.extent( 2 ), 3u );
+    EXPECT_EQ( view_0.extent( 3 ), 2u );
+    for ( std::size_t d = 0; d < 4; ++d )
+        EXPECT_EQ( view_0.stride( d ), slice_0.stride( d ) );
+    EXPECT_EQ( view_1.stride( 0 ), slice_1.stride( 0 ) );
+    EXPECT_EQ( view_1.stride( 1 ), 1u );
+
+    // Write through the views and read through the slices.
+    Kokkos::parallel_for(
+        "assign", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_data ),
+        KOKKOS_LAMBDA( const int idx ) {
+            int s = idx / vector_length;
+            int a = idx % vector_length;
+            for ( int i = 0; i < 3; ++i )
+                for ( int j = 0; j < 2; ++j )
+                    view_0( s, a, i, j ) = idx + 0.1 * i + 0.01 * j;
+            view_1( s, a ) = idx;
+        } );
+    Kokkos::fence();
+
+    auto mirror =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), aosoa );
+    auto mirror_0 = Cabana::slice<0>( mirror );
+    auto mirror_1 = Cabana::slice<1>( mirror );
+    for ( int idx = 0; idx < num_data; ++idx )
+    {
+        for ( int i = 0; i < 3; ++i )
+            for ( int j = 0; j < 2; ++j )
+                EXPECT_EQ( mirror_0( idx, i, j ), idx + 0.1 * i + 0.01 * j );
+        EXPECT_EQ( mirror_1( idx ), idx );
+    }
+}
+
 //---------------------------------------------------------------------------//
 // RUN TESTS
 //---------------------------------------------------------------------------//
@@ -350,6 +402,9 @@ TEST( TEST_CATEGORY, random_access_test ) { randomAccessTest(); }
 //---------------------------------------------------------------------------//
 TEST( TEST_CATEGORY, atomic_access_test ) { atomicAccessTest(); }
 
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, strided_view_test ) { stridedViewTest(); }
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
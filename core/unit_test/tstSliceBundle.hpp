@@ -0,0 +1,111 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_DeepCopy.hpp>
+#include <Cabana_Parallel.hpp>
+#include <Cabana_SliceBundle.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+// Member tags.
+struct Position
+{
+};
+struct Mass
+{
+};
+struct Stress
+{
+};
+
+using BundleTypes = Cabana::MemberTypes<double[3], int, float[2][2], double>;
+using BundleAoSoA = Cabana::AoSoA<BundleTypes, TEST_MEMSPACE, 8>;
+
+//---------------------------------------------------------------------------//
+void bundleTest()
+{
+    int num_data = 35;
+    BundleAoSoA aosoa( "aosoa", num_data );
+
+    // Bundle a subset of the members in a different order.
+    auto bundle = Cabana::makeSliceBundle<Cabana::NamedMember<Stress, 2>,
+                                          Cabana::NamedMember<Position, 0>,
+                                          Cabana::NamedMember<Mass, 3>>(
+        aosoa );
+    using bundle_type = decltype( bundle );
+    static_assert( Cabana::is_slice_bundle<bundle_type>::value, "" );
+    static_assert( bundle_type::number_of_members == 3, "" );
+    static_assert( bundle_type::member_index<Position>::value == 0, "" );
+    static_assert( bundle_type::member_index<Stress>::value == 2, "" );
+    static_assert( bundle_type::member_index<Mass>::value == 3, "" );
+    EXPECT_EQ( bundle.size(), aosoa.size() );
+    EXPECT_EQ( bundle.numSoA(), aosoa.numSoA() );
+
+    // The bundle captures a single pointer and size regardless of the
+    // number of members.
+    static_assert( sizeof( bundle_type ) ==
+                       sizeof( void* ) + sizeof( bundle_type::size_type ),
+                   "" );
+
+    // Fill the members through the bundle by tuple index.
+    Kokkos::parallel_for(
+        "fill_bundle", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_data ),
+        KOKKOS_LAMBDA( const int i ) {
+            for ( int d = 0; d < 3; ++d )
+                bundle.get<Position>( i, d ) = i + d;
+            for ( int j = 0; j < 2; ++j )
+                for ( int k = 0; k < 2; ++k )
+                    bundle.get<Stress>( i, j, k ) = i * j + k;
+            bundle.get<Mass>( i ) = 0.5 * i;
+        } );
+
+    // Update a member through the bundle by SoA and array index.
+    Cabana::SimdPolicy<8, TEST_EXECSPACE> simd_policy( 0, num_data );
+    Cabana::simd_parallel_for(
+        simd_policy,
+        KOKKOS_LAMBDA( const int s, const int a ) {
+            bundle.access<Mass>( s, a ) +=
+                bundle.access<Position>( s, a, 2 );
+        },
+        "update_bundle" );
+    Kokkos::fence();
+
+    // Check the members through slices.
+    auto host =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), aosoa );
+    auto position = Cabana::slice<0>( host );
+    auto stress = Cabana::slice<2>( host );
+    auto mass = Cabana::slice<3>( host );
+    for ( int i = 0; i < num_data; ++i )
+    {
+        for ( int d = 0; d < 3; ++d )
+            EXPECT_EQ( position( i, d ), i + d );
+        for ( int j = 0; j < 2; ++j )
+            for ( int k = 0; k < 2; ++k )
+                EXPECT_EQ( stress( i, j, k ), i * j + k );
+        EXPECT_EQ( mass( i ), 0.5 * i + i + 2 );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, slice_bundle_test ) { bundleTest(); }
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
@@ -16,6 +16,10 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
 namespace Test
 {
 //---------------------------------------------------------------------------//
@@ -707,6 +711,218 @@ void testSortByKeySlice()
     }
 }
 
+//---------------------------------------------------------------------------//
+void testSortBySpaceFillingCurve( const Cabana::SpaceFillingCurve curve )
+{
+    // Create particles at the cell centers of a lattice in reverse order.
+    const int nx = 8;
+    const int num_data = nx * nx * nx;
+    Cabana::AoSoA<Cabana::MemberTypes<double[3]>, TEST_MEMSPACE> aosoa(
+        "aosoa", num_data );
+    auto x = Cabana::slice<0>( aosoa );
+    Kokkos::parallel_for(
+        "fill", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_data ),
+        KOKKOS_LAMBDA( const int p ) {
+            int c = num_data - p - 1;
+            x( p, 0 ) = c / ( nx * nx ) + 0.5;
+            x( p, 1 ) = ( c / nx ) % nx + 0.5;
+            x( p, 2 ) = c % nx + 0.5;
+        } );
+    Kokkos::fence();
+
+    // Sort the particles along the curve.
+    double grid_min[3] = { 0.0, 0.0, 0.0 };
+    double grid_max[3] = { nx, nx, nx };
+    auto binning_data =
+        Cabana::sortBySpaceFillingCurve( x, grid_min, grid_max, curve );
+    Cabana::permute( binning_data, aosoa );
+
+    // Check that the curve keys are increasing. Consecutive particles on the
+    // Hilbert curve are also neighboring lattice sites.
+    auto mirror =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), aosoa );
+    auto x_mirror = Cabana::slice<0>( mirror );
+    const double scale = ( 1 << 21 ) / static_cast<double>( nx );
+    std::uint64_t previous_key = 0;
+    for ( int p = 0; p < num_data; ++p )
+    {
+        std::uint32_t ijk[3];
+        for ( int d = 0; d < 3; ++d )
+            ijk[d] = static_cast<std::uint32_t>( x_mirror( p, d ) * scale );
+        std::uint64_t key =
+            ( Cabana::SpaceFillingCurve::Hilbert == curve )
+                ? Cabana::Impl::hilbertKey( ijk[0], ijk[1], ijk[2] )
+                : Cabana::Impl::mortonKey( ijk[0], ijk[1], ijk[2] );
+        if ( p > 0 )
+        {
+            EXPECT_LT( previous_key, key );
+            if ( Cabana::SpaceFillingCurve::Hilbert == curve )
+            {
+                double dist = 0.0;
+                for ( int d = 0; d < 3; ++d )
+                    dist += std::abs( x_mirror( p, d ) - x_mirror( p - 1, d ) );
+                EXPECT_DOUBLE_EQ( dist, 1.0 );
+            }
+        }
+        previous_key = key;
+    }
+}
+
+//---------------------------------------------------------------------------//
+void testRadixSort()
+{
+    // Create signed keys with duplicates in a reverse order.
+    int num_data = 3453;
+    Kokkos::View<long*, TEST_MEMSPACE> keys( "keys", num_data );
+    Kokkos::parallel_for(
+        "fill", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_data ),
+        KOKKOS_LAMBDA( const int p ) {
+            keys( p ) = 1000000 * ( ( num_data - p ) / 2 ) - 700000000;
+        } );
+    Kokkos::fence();
+
+    // Sort a subset of the keys.
+    int begin = 100;
+    int end = 3000;
+    auto binning_data =
+        Cabana::Impl::radixSort( TEST_EXECSPACE(), keys, begin, end );
+    EXPECT_EQ( binning_data.rangeBegin(), static_cast<std::size_t>( begin ) );
+    EXPECT_EQ( binning_data.rangeEnd(), static_cast<std::size_t>( end ) );
+
+    Kokkos::View<long*, TEST_MEMSPACE> sorted( "sorted", end - begin );
+    Kokkos::View<int*, TEST_MEMSPACE> permute( "permute", end - begin );
+    Kokkos::parallel_for(
+        "copy", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, end - begin ),
+        KOKKOS_LAMBDA( const int i ) {
+            permute( i ) = binning_data.permutation( i );
+            sorted( i ) = keys( permute( i ) );
+        } );
+    Kokkos::fence();
+    auto sorted_mirror =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), sorted );
+    auto permute_mirror =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), permute );
+
+    // Check that the keys are ordered and that the sort is stable.
+    for ( int i = 0; i < end - begin; ++i )
+    {
+        EXPECT_GE( permute_mirror( i ), begin );
+        EXPECT_LT( permute_mirror( i ), end );
+        if ( i > 0 )
+        {
+            EXPECT_LE( sorted_mirror( i - 1 ), sorted_mirror( i ) );
+            if ( sorted_mirror( i - 1 ) == sorted_mirror( i ) )
+                EXPECT_LT( permute_mirror( i - 1 ), permute_mirror( i ) );
+        }
+    }
+}
+
+//---------------------------------------------------------------------------//
+void testBinByNestedKeys()
+{
+    // Give the tuples a cell and a species.
+    int num_data = 3453;
+    int num_cell = 13;
+    int num_species = 4;
+    using DataTypes = Cabana::MemberTypes<int, int>;
+    Cabana::AoSoA<DataTypes, TEST_MEMSPACE> aosoa( "aosoa", num_data );
+    auto cell = Cabana::slice<0>( aosoa );
+    auto species = Cabana::slice<1>( aosoa );
+    Kokkos::parallel_for(
+        "fill", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_data ),
+        KOKKOS_LAMBDA( const int p ) {
+            cell( p ) = ( 7 * p ) % num_cell;
+            species( p ) = ( p / 3 ) % num_species;
+        } );
+    Kokkos::fence();
+
+    // Bin a subset of the tuples.
+    int begin = 100;
+    int end = 3000;
+    auto binning_data =
+        Cabana::binByNestedKeys( TEST_EXECSPACE(), cell, num_cell, species,
+                                 num_species, begin, end );
+    EXPECT_EQ( binning_data.numBin(), num_cell * num_species );
+    EXPECT_EQ( binning_data.rangeBegin(), static_cast<std::size_t>( begin ) );
+    EXPECT_EQ( binning_data.rangeEnd(), static_cast<std::size_t>( end ) );
+
+    int num_bin = num_cell * num_species;
+    Kokkos::View<int*, TEST_MEMSPACE> permute( "permute", end - begin );
+    Kokkos::View<int*, TEST_MEMSPACE> sizes( "sizes", num_bin );
+    Kokkos::View<int*, TEST_MEMSPACE> offsets( "offsets", num_bin );
+    Kokkos::parallel_for(
+        "copy", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, end - begin ),
+        KOKKOS_LAMBDA( const int i ) {
+            permute( i ) = binning_data.permutation( i );
+            if ( i < num_bin )
+            {
+                sizes( i ) = binning_data.binSize( i );
+                offsets( i ) = binning_data.binOffset( i );
+            }
+        } );
+    Kokkos::fence();
+    auto permute_mirror =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), permute );
+    auto sizes_mirror =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), sizes );
+    auto offsets_mirror =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), offsets );
+
+    // Check that the tuples are grouped by cell, then by species, and keep
+    // their order within a bin.
+    std::vector<int> expected_sizes( num_bin, 0 );
+    for ( int p = begin; p < end; ++p )
+        ++expected_sizes[( ( 7 * p ) % num_cell ) * num_species +
+                         ( p / 3 ) % num_species];
+    int offset = 0;
+    for ( int b = 0; b < num_bin; ++b )
+    {
+        EXPECT_EQ( sizes_mirror( b ), expected_sizes[b] );
+        EXPECT_EQ( offsets_mirror( b ), offset );
+        for ( int i = offset; i < offset + expected_sizes[b]; ++i )
+        {
+            int p = permute_mirror( i );
+            EXPECT_EQ( ( 7 * p ) % num_cell, b / num_species );
+            EXPECT_EQ( ( p / 3 ) % num_species, b % num_species );
+            if ( i > offset )
+                EXPECT_LT( permute_mirror( i - 1 ), p );
+        }
+        offset += expected_sizes[b];
+    }
+    EXPECT_EQ( offset, end - begin );
+}
+
+//---------------------------------------------------------------------------//
+template <class KeyType>
+void testSortByKeySkewed()
+{
+    // Create keys where a few of them are much larger than the rest.
+    int num_data = 3453;
+    Kokkos::View<KeyType*, TEST_MEMSPACE> keys( "keys", num_data );
+    Kokkos::parallel_for(
+        "fill", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_data ),
+        KOKKOS_LAMBDA( const int p ) {
+            KeyType reverse_index = num_data - p - 1;
+            keys( p ) = ( p % 7 == 0 ) ? KeyType( 1ull << 62 ) + reverse_index
+                                       : reverse_index;
+        } );
+    Kokkos::fence();
+
+    auto binning_data = Cabana::sortByKey( keys );
+
+    Kokkos::View<KeyType*, TEST_MEMSPACE> sorted( "sorted", num_data );
+    Kokkos::parallel_for(
+        "copy", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_data ),
+        KOKKOS_LAMBDA( const int i ) {
+            sorted( i ) = keys( binning_data.permutation( i ) );
+        } );
+    Kokkos::fence();
+    auto sorted_mirror =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), sorted );
+    for ( int i = 1; i < num_data; ++i )
+        EXPECT_LE( sorted_mirror( i - 1 ), sorted_mirror( i ) );
+}
+
 //---------------------------------------------------------------------------//
 // RUN TESTS
 //---------------------------------------------------------------------------//
@@ -736,6 +952,353 @@ TEST( TEST_CATEGORY, bin_by_member_data_only_test )
 //---------------------------------------------------------------------------//
 TEST( TEST_CATEGORY, sort_by_key_slice_test ) { testSortByKeySlice(); }
 
+//---------------------------------------------------------------------------//
+void testPermuteSlices()
+{
+    // Data dimensions.
+    const int dim_1 = 3;
+    const int dim_2 = 2;
+
+    // Declare data types.
+    using DataTypes =
+        Cabana::MemberTypes<float[dim_1], int, double[dim_1][dim_2]>;
+
+    // Declare the AoSoA type.
+    using AoSoA_t = Cabana::AoSoA<DataTypes, TEST_MEMSPACE>;
+
+    // Create an AoSoA.
+    int num_data = 3453;
+    AoSoA_t aosoa( "aosoa", num_data );
+
+    // Create a Kokkos view for the keys.
+    using KeyViewType = Kokkos::View<int*, typename AoSoA_t::memory_space>;
+    KeyViewType keys( "keys", num_data );
+
+    // Create the AoSoA data and keys in reverse order.
+    auto v0 = Cabana::slice<0>( aosoa );
+    auto v1 = Cabana::slice<1>( aosoa );
+    auto v2 = Cabana::slice<2>( aosoa );
+    Kokkos::parallel_for(
+        "fill", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, aosoa.size() ),
+        KOKKOS_LAMBDA( const int p ) {
+            int reverse_index = aosoa.size() - p - 1;
+
+            for ( int i = 0; i < dim_1; ++i )
+                v0( p, i ) = reverse_index + i;
+
+            v1( p ) = reverse_index;
+
+            for ( int i = 0; i < dim_1; ++i )
+                for ( int j = 0; j < dim_2; ++j )
+                    v2( p, i, j ) = reverse_index + i + j;
+
+            keys( p ) = reverse_index;
+        } );
+
+    // Sort slices 0 and 2 together by keys.
+    auto binning_data = Cabana::sortByKey( keys );
+    Cabana::permute( binning_data, v0, v2 );
+
+    // Check the result of the sort.
+    auto mirror =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), aosoa );
+    auto v0_mirror = Cabana::slice<0>( mirror );
+    auto v1_mirror = Cabana::slice<1>( mirror );
+    auto v2_mirror = Cabana::slice<2>( mirror );
+    for ( std::size_t p = 0; p < aosoa.size(); ++p )
+    {
+        int reverse_index = aosoa.size() - p - 1;
+
+        // The permuted slices should be reversed.
+        for ( int i = 0; i < dim_1; ++i )
+            EXPECT_EQ( v0_mirror( p, i ), p + i );
+
+        for ( int i = 0; i < dim_1; ++i )
+            for ( int j = 0; j < dim_2; ++j )
+                EXPECT_EQ( v2_mirror( p, i, j ), p + i + j );
+
+        // The other slice should be unchanged.
+        EXPECT_EQ( v1_mirror( p ), reverse_index );
+    }
+}
+
+//---------------------------------------------------------------------------//
+void testPermuteMemberwise( const std::size_t max_scratch_bytes )
+{
+    // Data dimensions.
+    const int dim_1 = 3;
+    const int dim_2 = 2;
+
+    // Declare data types.
+    using DataTypes =
+        Cabana::MemberTypes<float[dim_1], int, double[dim_1][dim_2]>;
+
+    // Declare the AoSoA type.
+    using AoSoA_t = Cabana::AoSoA<DataTypes, TEST_MEMSPACE>;
+
+    // Create an AoSoA.
+    int num_data = 3453;
+    AoSoA_t aosoa( "aosoa", num_data );
+
+    // Create a Kokkos view for the keys.
+    using KeyViewType = Kokkos::View<int*, typename AoSoA_t::memory_space>;
+    KeyViewType keys( "keys", num_data );
+
+    // Create the AoSoA data and keys in reverse order.
+    auto v0 = Cabana::slice<0>( aosoa );
+    auto v1 = Cabana::slice<1>( aosoa );
+    auto v2 = Cabana::slice<2>( aosoa );
+    Kokkos::parallel_for(
+        "fill", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, aosoa.size() ),
+        KOKKOS_LAMBDA( const int p ) {
+            int reverse_index = aosoa.size() - p - 1;
+
+            for ( int i = 0; i < dim_1; ++i )
+                v0( p, i ) = reverse_index + i;
+
+            v1( p ) = reverse_index;
+
+            for ( int i = 0; i < dim_1; ++i )
+                for ( int j = 0; j < dim_2; ++j )
+                    v2( p, i, j ) = reverse_index + i + j;
+
+            keys( p ) = reverse_index;
+        } );
+
+    // Sort the aosoa by keys one member at a time.
+    auto binning_data = Cabana::sortByKey( keys );
+    Cabana::permuteMemberwise( binning_data, aosoa, max_scratch_bytes );
+
+    // Check the result of the sort.
+    auto mirror =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), aosoa );
+    auto v0_mirror = Cabana::slice<0>( mirror );
+    auto v1_mirror = Cabana::slice<1>( mirror );
+    auto v2_mirror = Cabana::slice<2>( mirror );
+    for ( std::size_t p = 0; p < aosoa.size(); ++p )
+    {
+        for ( int i = 0; i < dim_1; ++i )
+            EXPECT_EQ( v0_mirror( p, i ), p + i );
+
+        EXPECT_EQ( v1_mirror( p ), p );
+
+        for ( int i = 0; i < dim_1; ++i )
+            for ( int j = 0; j < dim_2; ++j )
+                EXPECT_EQ( v2_mirror( p, i, j ), p + i + j );
+    }
+}
+
+//---------------------------------------------------------------------------//
+void testRebinByKey( const bool previous_applied )
+{
+    // Create scattered keys with a fixed range.
+    int num_data = 3453;
+    int key_range = 100;
+    using KeyViewType = Kokkos::View<int*, TEST_MEMSPACE>;
+    KeyViewType keys( "keys", num_data );
+    Kokkos::parallel_for(
+        "fill", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_data ),
+        KOKKOS_LAMBDA( const int p ) { keys( p ) = ( p * 37 ) % key_range; } );
+    Kokkos::fence();
+
+    // Bin the keys.
+    Kokkos::BinOp1D<KeyViewType> comp( 10, 0, key_range );
+    auto previous = Cabana::binByKeyWithComparator( keys, comp );
+
+    // Copy the previous binning so we can check against it.
+    Kokkos::View<std::size_t*, TEST_MEMSPACE> prev_permute( "prev_permute",
+                                                            num_data );
+    Kokkos::parallel_for(
+        "copy bin data", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_data ),
+        KOKKOS_LAMBDA( const int p ) {
+            prev_permute( p ) = previous.permutation( p );
+        } );
+    Kokkos::fence();
+    auto prev_permute_mirror = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), prev_permute );
+
+    // If the previous binning is applied, put the keys in binned order.
+    if ( previous_applied )
+    {
+        KeyViewType binned_keys( "binned_keys", num_data );
+        Kokkos::parallel_for(
+            "permute keys", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_data ),
+            KOKKOS_LAMBDA( const int p ) {
+                binned_keys( p ) = keys( previous.permutation( p ) );
+            } );
+        Kokkos::fence();
+        keys = binned_keys;
+    }
+
+    // Move every tenth element to a different bin.
+    Kokkos::parallel_for(
+        "move", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_data ),
+        KOKKOS_LAMBDA( const int p ) {
+            if ( p % 10 == 0 )
+                keys( p ) = ( keys( p ) + 25 ) % key_range;
+        } );
+    Kokkos::fence();
+
+    // Incrementally rebin.
+    auto bin_data =
+        Cabana::rebinByKeyWithComparator( previous, keys, comp,
+                                          previous_applied );
+    EXPECT_EQ( bin_data.numBin(), previous.numBin() );
+    EXPECT_EQ( bin_data.rangeBegin(), std::size_t( 0 ) );
+    EXPECT_EQ( bin_data.rangeEnd(), std::size_t( num_data ) );
+
+    // Copy the bin data so we can check it.
+    int nbin = bin_data.numBin();
+    Kokkos::View<std::size_t*, TEST_MEMSPACE> bin_permute( "bin_permute",
+                                                           num_data );
+    Kokkos::View<std::size_t*, TEST_MEMSPACE> bin_offset( "bin_offset", nbin );
+    Kokkos::View<int*, TEST_MEMSPACE> bin_size( "bin_size", nbin );
+    Kokkos::parallel_for(
+        "copy bin data", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_data ),
+        KOKKOS_LAMBDA( const int p ) {
+            bin_permute( p ) = bin_data.permutation( p );
+            if ( p < nbin )
+            {
+                bin_offset( p ) = bin_data.binOffset( p );
+                bin_size( p ) = bin_data.binSize( p );
+            }
+        } );
+    Kokkos::fence();
+    auto bin_permute_mirror =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), bin_permute );
+    auto bin_offset_mirror =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), bin_offset );
+    auto bin_size_mirror =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), bin_size );
+    auto keys_mirror =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), keys );
+
+    // Check that the bins are contiguous and every element is in the bin of
+    // its new key exactly once.
+    std::vector<int> found( num_data, 0 );
+    std::size_t offset = 0;
+    for ( int b = 0; b < nbin; ++b )
+    {
+        EXPECT_EQ( bin_offset_mirror( b ), offset );
+        for ( int n = 0; n < bin_size_mirror( b ); ++n )
+        {
+            auto pid = bin_permute_mirror( offset + n );
+            EXPECT_EQ( comp.bin( keys_mirror, pid ), b );
+            ++found[pid];
+        }
+        offset += bin_size_mirror( b );
+    }
+    EXPECT_EQ( offset, std::size_t( num_data ) );
+    for ( int p = 0; p < num_data; ++p )
+        EXPECT_EQ( found[p], 1 );
+
+    // Check that the elements which stayed in their bin kept their relative
+    // order.
+    std::vector<int> slot( num_data );
+    for ( int i = 0; i < num_data; ++i )
+        slot[bin_permute_mirror( i )] = i;
+    int last_slot = -1;
+    int last_bin = -1;
+    for ( int i = 0; i < num_data; ++i )
+    {
+        std::size_t pid = previous_applied ? i : prev_permute_mirror( i );
+        if ( pid % 10 == 0 )
+            continue;
+        int b = comp.bin( keys_mirror, pid );
+        if ( b == last_bin )
+            EXPECT_GT( slot[pid], last_slot );
+        last_bin = b;
+        last_slot = slot[pid];
+    }
+}
+
+//---------------------------------------------------------------------------//
+void testSortOnInstance()
+{
+    // Sort on an execution space instance rather than the default one.
+    TEST_EXECSPACE space;
+
+    using DataTypes = Cabana::MemberTypes<int, double, float>;
+    using AoSoA_t = Cabana::AoSoA<DataTypes, TEST_MEMSPACE>;
+    int num_data = 3453;
+    AoSoA_t aosoa( "aosoa", num_data );
+    auto v0 = Cabana::slice<0>( aosoa );
+    auto v1 = Cabana::slice<1>( aosoa );
+    auto v2 = Cabana::slice<2>( aosoa );
+    Kokkos::parallel_for(
+        "fill", Kokkos::RangePolicy<TEST_EXECSPACE>( space, 0, num_data ),
+        KOKKOS_LAMBDA( const int p ) {
+            v0( p ) = num_data - p - 1;
+            v1( p ) = num_data - p - 1;
+            v2( p ) = p;
+        } );
+
+    // Integer keys use the radix sort.
+    auto binning_data = Cabana::sortByKey( space, v0 );
+    Cabana::permute( space, binning_data, aosoa );
+
+    // Floating point keys use the bin sort. Only permute one slice.
+    binning_data = Cabana::sortByKey( space, v2, 0, num_data );
+    Cabana::permute( space, binning_data, v1 );
+    space.fence();
+
+    auto mirror =
+        Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(), aosoa );
+    auto v0_mirror = Cabana::slice<0>( mirror );
+    auto v1_mirror = Cabana::slice<1>( mirror );
+    auto v2_mirror = Cabana::slice<2>( mirror );
+    for ( int p = 0; p < num_data; ++p )
+    {
+        EXPECT_EQ( v0_mirror( p ), p );
+        EXPECT_EQ( v1_mirror( p ), num_data - p - 1 );
+        EXPECT_EQ( v2_mirror( p ), num_data - p - 1 );
+    }
+}
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, radix_sort_test ) { testRadixSort(); }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, bin_by_nested_keys_test ) { testBinByNestedKeys(); }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, permute_slices_test ) { testPermuteSlices(); }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, permute_memberwise_test )
+{
+    // One component per pass, two components per pass of the largest
+    // member, and whole members per pass.
+    testPermuteMemberwise( 0 );
+    testPermuteMemberwise( 2 * 3453 * sizeof( double ) );
+    testPermuteMemberwise( 1 << 30 );
+}
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, rebin_by_key_test )
+{
+    testRebinByKey( false );
+    testRebinByKey( true );
+}
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, sort_by_key_skewed_test )
+{
+    testSortByKeySkewed<std::uint64_t>();
+    testSortByKeySkewed<long>();
+    testSortByKeySkewed<double>();
+}
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, sort_by_space_filling_curve_test )
+{
+    testSortBySpaceFillingCurve( Cabana::SpaceFillingCurve::Morton );
+    testSortBySpaceFillingCurve( Cabana::SpaceFillingCurve::Hilbert );
+}
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, sort_on_instance_test ) { testSortOnInstance(); }
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
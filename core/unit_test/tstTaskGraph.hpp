@@ -0,0 +1,168 @@
+/****************************************************************************
+ * Copyright (c) 2018-2021 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_DeepCopy.hpp>
+#include <Cabana_TaskGraph.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+void testDependencies()
+{
+    using AoSoA_t = Cabana::AoSoA<Cabana::MemberTypes<double, double, int>,
+                                  TEST_MEMSPACE>;
+    AoSoA_t aosoa( "aosoa", 10 );
+    auto a = Cabana::slice<0>( aosoa );
+    auto b = Cabana::slice<1>( aosoa );
+    auto c = Cabana::slice<2>( aosoa );
+    Kokkos::View<double*, TEST_MEMSPACE> v( "v", 10 );
+
+    auto empty = []( const TEST_EXECSPACE& ) {};
+    Cabana::TaskGraph<TEST_EXECSPACE> graph(
+        { TEST_EXECSPACE(), TEST_EXECSPACE() } );
+    EXPECT_EQ( graph.numInstance(), 2u );
+
+    auto t0 = graph.add( "w_a", empty, { Cabana::writeAccess( a ) } );
+    auto t1 = graph.add( "w_b", empty, { Cabana::writeAccess( b ) } );
+    auto t2 =
+        graph.add( "r_a", empty,
+                   { Cabana::readAccess( a ), Cabana::writeAccess( v ) } );
+    auto t3 = graph.add( "r_a_2", empty, { Cabana::readAccess( a ) } );
+    auto t4 =
+        graph.add( "w_a_2", empty,
+                   { Cabana::writeAccess( a ), Cabana::readAccess( c ) } );
+    auto t5 = graph.add( "r_b_v", empty,
+                         { Cabana::readAccess( b ), Cabana::readAccess( v ) } );
+    EXPECT_EQ( graph.numTask(), 6u );
+
+    // Independent writes.
+    EXPECT_TRUE( graph.dependencies( t0 ).empty() );
+    EXPECT_TRUE( graph.dependencies( t1 ).empty() );
+    EXPECT_NE( graph.instance( t0 ), graph.instance( t1 ) );
+
+    // Read after write.
+    EXPECT_EQ( graph.dependencies( t2 ), std::vector<std::size_t>( { t0 } ) );
+    EXPECT_EQ( graph.instance( t2 ), graph.instance( t0 ) );
+
+    // Reads do not depend on each other.
+    EXPECT_EQ( graph.dependencies( t3 ), std::vector<std::size_t>( { t0 } ) );
+
+    // Write after read and write after write.
+    EXPECT_EQ( graph.dependencies( t4 ),
+               std::vector<std::size_t>( { t0, t2, t3 } ) );
+
+    // Several dependencies.
+    EXPECT_EQ( graph.dependencies( t5 ),
+               std::vector<std::size_t>( { t1, t2 } ) );
+}
+
+//---------------------------------------------------------------------------//
+void testExecute()
+{
+    int num_data = 1000;
+    Kokkos::View<double*, TEST_MEMSPACE> a( "a", num_data );
+    Kokkos::View<double*, TEST_MEMSPACE> b( "b", num_data );
+    Kokkos::View<double*, TEST_MEMSPACE> c( "c", num_data );
+    Kokkos::View<double*, TEST_MEMSPACE> d( "d", num_data );
+
+    // Kernels.
+    auto fill_a = KOKKOS_LAMBDA( const int i ) { a( i ) = i; };
+    auto fill_b = KOKKOS_LAMBDA( const int i ) { b( i ) = 2 * i; };
+    auto square_a = KOKKOS_LAMBDA( const int i ) { a( i ) *= a( i ); };
+    auto sum = KOKKOS_LAMBDA( const int i ) { d( i ) = a( i ) + c( i ); };
+    auto policy = [=]( const TEST_EXECSPACE& space ) {
+        return Kokkos::RangePolicy<TEST_EXECSPACE>( space, 0, num_data );
+    };
+
+    // Record the order of the communication calls.
+    std::vector<std::string> log;
+
+    Cabana::TaskGraph<TEST_EXECSPACE> graph(
+        { TEST_EXECSPACE(), TEST_EXECSPACE() } );
+    graph.add(
+        "fill_a",
+        [=]( const TEST_EXECSPACE& space ) {
+            Kokkos::parallel_for( "fill_a", policy( space ), fill_a );
+        },
+        { Cabana::writeAccess( a ) } );
+    graph.add(
+        "fill_b",
+        [=]( const TEST_EXECSPACE& space ) {
+            Kokkos::parallel_for( "fill_b", policy( space ), fill_b );
+        },
+        { Cabana::writeAccess( b ) } );
+
+    // Emulate a split-phase exchange of b into c.
+    graph.addComm(
+        "exchange",
+        [&]( const TEST_EXECSPACE& ) {
+            log.push_back( "start" );
+            Kokkos::deep_copy( c, b );
+        },
+        [&]() { log.push_back( "finish" ); },
+        { Cabana::readAccess( b ), Cabana::writeAccess( c ) } );
+
+    // Independent work overlaps the exchange.
+    graph.add(
+        "square_a",
+        [&]( const TEST_EXECSPACE& space ) {
+            log.push_back( "square_a" );
+            Kokkos::parallel_for( "square_a", policy( space ), square_a );
+        },
+        { Cabana::writeAccess( a ) } );
+
+    // Combine all results.
+    graph.add(
+        "sum",
+        [&]( const TEST_EXECSPACE& space ) {
+            log.push_back( "sum" );
+            Kokkos::parallel_for( "sum", policy( space ), sum );
+        },
+        { Cabana::readAccess( a ), Cabana::readAccess( c ),
+          Cabana::writeAccess( d ) } );
+
+    // Execute twice.
+    for ( int n = 0; n < 2; ++n )
+    {
+        log.clear();
+        Kokkos::deep_copy( d, 0.0 );
+        graph.execute();
+
+        // The exchange is finished just before its data is needed.
+        std::vector<std::string> expected = { "start", "square_a", "finish",
+                                              "sum" };
+        EXPECT_EQ( log, expected );
+
+        auto d_host =
+            Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), d );
+        for ( int i = 0; i < num_data; ++i )
+            EXPECT_EQ( d_host( i ), 1.0 * i * i + 2.0 * i );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, task_graph_dependencies_test ) { testDependencies(); }
+
+TEST( TEST_CATEGORY, task_graph_execute_test ) { testExecute(); }
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test